@@ -0,0 +1,51 @@
+#!/usr/bin/python
+##
+## license:BSD-3-Clause
+## copyright-holders:MAMEdev Team
+
+# Runs a set of systems with the netplay rollback benchmark, which rolls
+# back a fixed number of frames after every frame without a peer, and
+# reports how long re-emulating them takes compared to a frame's time.
+# For Python 3
+
+import os
+import re
+import subprocess
+import sys
+
+
+def benchmarkSystem(mame, system, depth, seconds, extra):
+    command = [mame, system, '-netplay_benchmark', str(depth), '-seconds_to_run', str(seconds), '-nothrottle', '-skip_gameinfo', '-noreadconfig', '-video', 'none', '-sound', 'none'] + extra
+    result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    for line in result.stdout.splitlines():
+        match = re.match(r'^Rollback: ([0-9]+) rollbacks, ([0-9.]+) frames average, ([0-9.]+) ms average, ([0-9.]+) ms worst, ([0-9.]+) ms per frame$', line)
+        if match:
+            return (int(match.group(1)), float(match.group(2)), float(match.group(3)), float(match.group(4)), float(match.group(5)))
+    sys.stderr.write('%s: no results\n' % system)
+    return None
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        sys.stderr.write('Usage:\n%s <mame executable> <system> [<system> ...] [-- <extra options>]\n' % sys.argv[0])
+        sys.exit(1)
+
+    arguments = sys.argv[2:]
+    extra = []
+    if '--' in arguments:
+        extra = arguments[arguments.index('--') + 1:]
+        arguments = arguments[:arguments.index('--')]
+
+    depth = int(os.environ.get('ROLLBACK_FRAMES', '7'))
+    seconds = int(os.environ.get('ROLLBACK_SECONDS', '20'))
+    failed = False
+    for system in arguments:
+        results = benchmarkSystem(sys.argv[1], system, depth, seconds, extra)
+        if results:
+            count, frames, average, worst, perframe = results
+            # at 60 Hz, a rollback has to fit in what's left of 16.7 ms after the real frame
+            sys.stdout.write('%s:\n' % system)
+            sys.stdout.write('    %d rollbacks of %.1f frames: %9.3f ms average %9.3f ms worst %9.3f ms per frame (%5.1f%% of 60 Hz)\n' % (count, frames, average, worst, perframe, average * 6.0))
+        else:
+            failed = True
+    sys.exit(1 if failed else 0)
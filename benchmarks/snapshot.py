@@ -0,0 +1,88 @@
+#!/usr/bin/python
+##
+## license:BSD-3-Clause
+## copyright-holders:MAMEdev Team
+
+# Runs a set of systems for a second and then measures how many states per
+# second can be saved and restored through the serialised buffer API and
+# the native snapshot API.
+# For Python 3
+
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+
+SCRIPT = '''
+local frames = 0
+local function measure(save, load, count)
+    local state = save()
+    local start = emu.osd_ticks()
+    for i = 1, count do
+        state = save()
+    end
+    local saved = emu.osd_ticks()
+    for i = 1, count do
+        load(state)
+    end
+    local loaded = emu.osd_ticks()
+    local rate = emu.osd_ticks_per_second()
+    return count * rate / (saved - start), count * rate / (loaded - saved), #state
+end
+emu.register_frame_done(function ()
+    frames = frames + 1
+    if frames ~= 60 then
+        return
+    end
+    local machine = manager.machine
+    local count = %d
+    print(string.format('BUFFER %%f %%f %%d', measure(function () return machine:buffer_save() end, function (s) machine:buffer_load(s) end, count)))
+    print(string.format('SNAPSHOT %%f %%f %%d', measure(function () return machine:snapshot_save() end, function (s) machine:snapshot_load(s) end, count)))
+    machine:exit()
+end)
+'''
+
+
+def benchmarkSystem(mame, system, count, extra):
+    with tempfile.TemporaryDirectory() as tmp:
+        path = os.path.join(tmp, 'snapshot.lua')
+        with open(path, 'w') as f:
+            f.write(SCRIPT % count)
+        command = [mame, system, '-autoboot_script', path, '-nothrottle', '-skip_gameinfo', '-noreadconfig', '-video', 'none', '-sound', 'none'] + extra
+        result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, universal_newlines=True)
+    results = { }
+    for line in result.stdout.splitlines():
+        match = re.match(r'^(BUFFER|SNAPSHOT) ([0-9.]+) ([0-9.]+) ([0-9]+)$', line)
+        if match:
+            results[match.group(1)] = (float(match.group(2)), float(match.group(3)), int(match.group(4)))
+    if len(results) != 2:
+        sys.stderr.write('%s: no results\n' % system)
+        return None
+    return results
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        sys.stderr.write('Usage:\n%s <mame executable> <system> [<system> ...] [-- <extra options>]\n' % sys.argv[0])
+        sys.exit(1)
+
+    arguments = sys.argv[2:]
+    extra = []
+    if '--' in arguments:
+        extra = arguments[arguments.index('--') + 1:]
+        arguments = arguments[:arguments.index('--')]
+
+    count = int(os.environ.get('SNAPSHOT_COUNT', '1000'))
+    failed = False
+    for system in arguments:
+        results = benchmarkSystem(sys.argv[1], system, count, extra)
+        if results:
+            sys.stdout.write('%s:\n' % system)
+            for name in ('BUFFER', 'SNAPSHOT'):
+                save, load, size = results[name]
+                sys.stdout.write('    %-8s %9d bytes %12.1f saves/s %12.1f loads/s\n' % (name.lower(), size, save, load))
+        else:
+            failed = True
+    sys.exit(1 if failed else 0)
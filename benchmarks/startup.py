@@ -0,0 +1,76 @@
+#!/usr/bin/python
+##
+## license:BSD-3-Clause
+## copyright-holders:MAMEdev Team
+
+# Runs MAME with -startupprofile for a set of systems and summarises where
+# the time between launching and the first frame goes.
+# For Python 3
+
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+
+def profileSystem(mame, system, runs, extra):
+    reports = []
+    for run in range(runs):
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, 'startup.json')
+            command = [mame, system, '-startupprofile', path, '-seconds_to_run', '1', '-nothrottle', '-skip_gameinfo', '-noreadconfig', '-video', 'none', '-sound', 'none'] + extra
+            subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+            if not os.path.exists(path):
+                sys.stderr.write('%s: no startup profile written\n' % system)
+                return None
+            with open(path) as f:
+                reports.append(json.load(f))
+    return reports
+
+
+def median(values):
+    values = sorted(values)
+    middle = len(values) // 2
+    return values[middle] if len(values) % 2 else (values[middle - 1] + values[middle]) / 2.0
+
+
+def summarise(system, reports, devices):
+    sys.stdout.write('%s: %.1f ms to first frame\n' % (system, median([r['first_frame_ms'] for r in reports])))
+    phases = {}
+    for report in reports:
+        for phase in report['phases']:
+            phases.setdefault(phase['name'], []).append(phase['duration_ms'])
+    for phase in reports[0]['phases']:
+        sys.stdout.write('    %-16s %9.1f ms\n' % (phase['name'], median(phases[phase['name']])))
+
+    # the slowest devices are usually the interesting ones
+    slowest = {}
+    for report in reports:
+        for device in report['devices']:
+            slowest.setdefault((device['tag'], device['action']), []).append(device['duration_ms'])
+    ranked = sorted(slowest.items(), key=lambda item: median(item[1]), reverse=True)
+    for (tag, action), times in ranked[:devices]:
+        sys.stdout.write('    %-5s %-30s %6.1f ms\n' % (action, tag, median(times)))
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        sys.stderr.write('Usage:\n%s <mame executable> <system> [<system> ...] [-- <extra options>]\n' % sys.argv[0])
+        sys.exit(1)
+
+    arguments = sys.argv[2:]
+    extra = []
+    if '--' in arguments:
+        extra = arguments[arguments.index('--') + 1:]
+        arguments = arguments[:arguments.index('--')]
+
+    runs = int(os.environ.get('STARTUP_RUNS', '3'))
+    failed = False
+    for system in arguments:
+        reports = profileSystem(sys.argv[1], system, runs, extra)
+        if reports:
+            summarise(system, reports, 10)
+        else:
+            failed = True
+    sys.exit(1 if failed else 0)
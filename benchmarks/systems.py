@@ -0,0 +1,192 @@
+#!/usr/bin/python
+##
+## license:BSD-3-Clause
+## copyright-holders:MAMEdev Team
+
+# Runs a set of reference systems headless for a fixed number of emulated
+# frames and reports emulated seconds per second of host time, with the
+# host time split by executing device (from -telemetry) and, for profiler
+# builds, by profiler category (from -profiletrace).  Results can be
+# saved as a baseline and later runs compared against it.  With --hashes,
+# each frame's screens and sound are hashed too (-framehash) and later
+# runs fail if the output isn't bit-exact (-framehashcheck), so an
+# optimisation shows both its speedup and that it changed nothing.
+# For Python 3
+
+import argparse
+import json
+import os
+import shlex
+import subprocess
+import sys
+import tempfile
+
+
+# name, command line, emulated frames
+SYSTEMS = (
+    ('cps2',    ['sfa3'],       3600),
+    ('segac2',  ['puyo'],       3600),      # Mega Drive derived hardware
+    ('naomi',   ['mvsc2'],      1800),
+    ('aleck64', ['mtetrisc'],   1800),      # Nintendo 64 derived hardware
+    ('pc',      ['ibm5170'],    1800)
+)
+
+# frames left out of the figures while the system starts up
+WARMUP_FRAMES = 60
+
+
+def readTelemetry(path):
+    emu_us = 0.0
+    host_us = 0.0
+    devices = { }
+    with open(path, 'r') as f:
+        for line in f:
+            record = json.loads(line)
+            if record['frame'] <= WARMUP_FRAMES:
+                continue
+            emu_us += record['emu_us']
+            host_us += record['host_us']
+            for tag, figures in record['devices'].items():
+                devices[tag] = devices.get(tag, 0.0) + figures['us']
+    return emu_us, host_us, devices
+
+
+def readProfile(path):
+    # events on the one traced thread nest properly, so charge each one's
+    # duration to its category and take it back from the enclosing event
+    with open(path, 'r') as f:
+        trace = json.load(f)
+    events = sorted((e for e in trace['traceEvents'] if e['ph'] == 'X'), key=lambda e: (e['ts'], -e['dur']))
+    categories = { }
+    stack = []
+    for event in events:
+        while stack and (event['ts'] >= (stack[-1]['ts'] + stack[-1]['dur'])):
+            stack.pop()
+        if stack:
+            parent = stack[-1]['cat']
+            categories[parent] = categories.get(parent, 0.0) - event['dur']
+        categories[event['cat']] = categories.get(event['cat'], 0.0) + event['dur']
+        stack.append(event)
+    return categories
+
+
+def benchmarkSystem(mame, name, system, frames, profile, extra, hashes, record):
+    with tempfile.TemporaryDirectory() as tmp:
+        telemetry = os.path.join(tmp, 'telemetry.jsonl')
+        trace = os.path.join(tmp, 'trace.json')
+        command = [mame] + system + [
+                '-batch', '-batchframes', str(frames), '-nothrottle',
+                '-telemetry', telemetry,
+                '-skip_gameinfo', '-noreadconfig', '-video', 'none', '-sound', 'none']
+        if profile:
+            command += ['-profiletrace', trace]
+        checking = False
+        if hashes:
+            reference = os.path.abspath(os.path.join(hashes, name + '.framehash'))
+            if record:
+                os.makedirs(hashes, exist_ok=True)
+                command += ['-framehash', reference]
+            elif os.path.exists(reference):
+                command += ['-framehashcheck', reference]
+                checking = True
+        result = subprocess.run(command + extra, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, universal_newlines=True)
+        if checking and (result.returncode != 0) and ('frame hash' in result.stderr.lower()):
+            sys.stderr.write('%s: output differs from the reference\n%s' % (name, result.stderr))
+            return { 'mismatch': True }
+        if (result.returncode != 0) or not os.path.exists(telemetry):
+            sys.stderr.write('%s: failed (exit code %d)\n%s' % (name, result.returncode, result.stderr))
+            return None
+        emu_us, host_us, devices = readTelemetry(telemetry)
+        if host_us <= 0.0:
+            sys.stderr.write('%s: no frames measured\n' % (name, ))
+            return None
+        results = {
+                'speed': emu_us / host_us,
+                'devices': dict((tag, us / host_us) for tag, us in devices.items()) }
+        if checking:
+            results['exact'] = True
+        if profile and os.path.exists(trace):
+            categories = readProfile(trace)
+            total = sum(categories.values())
+            if total > 0.0:
+                results['profile'] = dict((cat, us / total) for cat, us in categories.items())
+        return results
+
+
+def printResults(name, results, baseline):
+    line = '%-10s %8.2f emulated s/s' % (name, results['speed'])
+    if baseline:
+        line += '   %+7.1f%% against baseline %.2f' % ((results['speed'] / baseline['speed'] - 1.0) * 100.0, baseline['speed'])
+    if results.get('exact'):
+        line += '   output bit-exact'
+    sys.stdout.write(line + '\n')
+    for tag, share in sorted(results['devices'].items(), key=lambda i: -i[1]):
+        sys.stdout.write('    %5.1f%%  %s\n' % (share * 100.0, tag))
+    if 'profile' in results:
+        sys.stdout.write('  profile:\n')
+        for cat, share in sorted(results['profile'].items(), key=lambda i: -i[1]):
+            if share >= 0.001:
+                sys.stdout.write('    %5.1f%%  %s\n' % (share * 100.0, cat))
+
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Run reference systems headless and report emulation speed.')
+    parser.add_argument('mame', help='emulator executable')
+    parser.add_argument('systems', nargs='*', help='benchmark names to run (default: all of %s)' % ', '.join(s[0] for s in SYSTEMS))
+    parser.add_argument('--runs', type=int, default=1, help='runs per system, keeping the fastest')
+    parser.add_argument('--frames', type=int, help='override the number of emulated frames')
+    parser.add_argument('--profile', action='store_true', help='also break down time by profiler category (needs a PROFILER=1 build)')
+    parser.add_argument('--baseline', help='compare against this baseline file')
+    parser.add_argument('--tolerance', type=float, default=5.0, help='percentage slowdown against the baseline reported as a regression')
+    parser.add_argument('--save-baseline', dest='save', help='write the results to this baseline file')
+    parser.add_argument('--hashes', help='directory of per-frame output hashes, written with --save-baseline and checked otherwise')
+    parser.add_argument('--extra', default='', help='further options passed to the emulator, as one quoted string')
+    args = parser.parse_intermixed_args()
+    extra = shlex.split(args.extra)
+
+    selected = [s for s in SYSTEMS if (not args.systems) or (s[0] in args.systems)]
+    unknown = set(args.systems) - set(s[0] for s in SYSTEMS)
+    if unknown:
+        sys.stderr.write('Unknown benchmark(s): %s\n' % ', '.join(sorted(unknown)))
+        sys.exit(1)
+
+    baseline = { }
+    if args.baseline and os.path.exists(args.baseline):
+        with open(args.baseline, 'r') as f:
+            baseline = json.load(f)
+
+    failed = False
+    regressed = []
+    differed = []
+    measured = { }
+    for name, system, frames in selected:
+        best = None
+        mismatch = False
+        for run in range(args.runs):
+            results = benchmarkSystem(args.mame, name, system, args.frames or frames, args.profile, extra, args.hashes, bool(args.save))
+            if results and results.get('mismatch'):
+                mismatch = True
+                break
+            if results and ((best is None) or (results['speed'] > best['speed'])):
+                best = results
+        if mismatch:
+            differed.append(name)
+            continue
+        if not best:
+            failed = True
+            continue
+        measured[name] = best
+        printResults(name, best, baseline.get(name))
+        if (name in baseline) and (best['speed'] < baseline[name]['speed'] * (1.0 - args.tolerance / 100.0)):
+            regressed.append(name)
+
+    if args.save:
+        with open(args.save, 'w') as f:
+            json.dump(measured, f, indent='\t', sort_keys=True)
+            f.write('\n')
+
+    if differed:
+        sys.stdout.write('Output differs from the reference hashes: %s\n' % (', '.join(differed), ))
+    if regressed:
+        sys.stdout.write('Slower than baseline by more than %.1f%%: %s\n' % (args.tolerance, ', '.join(regressed)))
+    sys.exit(1 if (failed or differed or regressed) else 0)
@@ -30,6 +30,21 @@ public:
 	virtual void write_cs0(offs_t offset, uint16_t data, uint16_t mem_mask = 0xffff) = 0;
 	virtual void write_cs1(offs_t offset, uint16_t data, uint16_t mem_mask = 0xffff) = 0;
 
+	// block DMA transfers of up to the given number of words, returning how
+	// many were moved; the bus is wired-AND, so reads AND into the buffer
+	virtual uint32_t read_dma_block(uint8_t *buffer, uint32_t words)
+	{
+		uint16_t const data = read_dma();
+		buffer[0] &= uint8_t(data);
+		buffer[1] &= uint8_t(data >> 8);
+		return 1;
+	}
+	virtual uint32_t write_dma_block(const uint8_t *buffer, uint32_t words)
+	{
+		write_dma(buffer[0] | (buffer[1] << 8));
+		return 1;
+	}
+
 	virtual DECLARE_WRITE_LINE_MEMBER(write_dmack) = 0;
 	virtual DECLARE_WRITE_LINE_MEMBER(write_csel) = 0;
 	virtual DECLARE_WRITE_LINE_MEMBER(write_dasp) = 0;
@@ -581,6 +581,44 @@ uint16_t ata_hle_device::read_dma()
 	return result;
 }
 
+// a multi-word or ultra DMA transfer that's under way can move the rest of the buffer at once
+bool ata_hle_device::dma_block_ready()
+{
+	return m_dmack && m_dmarq && !m_8bit_data_transfers &&
+			(single_word_dma_mode() < 0) &&
+			!(m_status & IDE_STATUS_BSY) && (m_status & IDE_STATUS_DRQ) &&
+			(m_buffer_offset + 2) <= m_buffer_size;
+}
+
+uint32_t ata_hle_device::read_dma_block(uint8_t *buffer, uint32_t words)
+{
+	if (!device_selected())
+		return 0;
+
+	// anything unusual goes through the word at a time path and its logging
+	if (!dma_block_ready())
+	{
+		uint16_t const data = read_dma();
+		buffer[0] &= uint8_t(data);
+		buffer[1] &= uint8_t(data >> 8);
+		return 1;
+	}
+
+	uint32_t const count = std::min<uint32_t>(words, (m_buffer_size - m_buffer_offset) / 2);
+	uint8_t const *const src = &m_buffer[m_buffer_offset];
+	for (uint32_t i = 0; i < count * 2; i++)
+		buffer[i] &= src[i];
+	m_buffer_offset += count * 2;
+
+	if (m_buffer_offset >= m_buffer_size)
+	{
+		LOG(("%s:IDE completed DMA block read\n", machine().describe_context()));
+		read_buffer_empty();
+	}
+
+	return count;
+}
+
 uint16_t ata_hle_device::read_cs0(offs_t offset, uint16_t mem_mask)
 {
 	/* logit */
@@ -804,6 +842,30 @@ void ata_hle_device::write_dma( uint16_t data )
 	}
 }
 
+uint32_t ata_hle_device::write_dma_block(const uint8_t *buffer, uint32_t words)
+{
+	if (!device_selected())
+		return 0;
+
+	if (!dma_block_ready())
+	{
+		write_dma(buffer[0] | (buffer[1] << 8));
+		return 1;
+	}
+
+	uint32_t const count = std::min<uint32_t>(words, (m_buffer_size - m_buffer_offset) / 2);
+	std::copy_n(buffer, count * 2, &m_buffer[m_buffer_offset]);
+	m_buffer_offset += count * 2;
+
+	if (m_buffer_offset >= m_buffer_size)
+	{
+		LOG(("%s:IDE completed DMA block write\n", machine().describe_context()));
+		write_buffer_full();
+	}
+
+	return count;
+}
+
 void ata_hle_device::write_cs0(offs_t offset, uint16_t data, uint16_t mem_mask)
 {
 	/* logit */
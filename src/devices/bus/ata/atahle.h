@@ -25,6 +25,8 @@ public:
 	virtual void write_dma(uint16_t data) override;
 	virtual void write_cs0(offs_t offset, uint16_t data, uint16_t mem_mask = 0xffff) override;
 	virtual void write_cs1(offs_t offset, uint16_t data, uint16_t mem_mask = 0xffff) override;
+	virtual uint32_t read_dma_block(uint8_t *buffer, uint32_t words) override;
+	virtual uint32_t write_dma_block(const uint8_t *buffer, uint32_t words) override;
 	virtual DECLARE_WRITE_LINE_MEMBER(write_csel) override;
 	virtual DECLARE_WRITE_LINE_MEMBER(write_dasp) override;
 	virtual DECLARE_WRITE_LINE_MEMBER(write_dmack) override;
@@ -71,6 +73,7 @@ protected:
 
 	/// TODO: not sure this should be protected.
 	void read_buffer_empty();
+	bool dma_block_ready();
 
 	enum
 	{
@@ -138,6 +138,18 @@ uint16_t abstract_ata_interface_device::read_dma()
 	return result;
 }
 
+uint32_t abstract_ata_interface_device::read_dma_block(uint8_t *buffer, uint32_t words)
+{
+	// devices that aren't transferring leave the buffer alone, and an idle bus reads a word of ones
+	std::fill_n(buffer, words * 2, 0xff);
+	uint32_t count = 1;
+	for (auto & elem : m_slot)
+		if (elem->dev() != nullptr)
+			count = std::max(count, elem->dev()->read_dma_block(buffer, words));
+
+	return count;
+}
+
 uint16_t abstract_ata_interface_device::internal_read_cs0(offs_t offset, uint16_t mem_mask)
 {
 	uint16_t result = mem_mask;
@@ -179,6 +191,16 @@ void abstract_ata_interface_device::write_dma( uint16_t data )
 			elem->dev()->write_dma(data);
 }
 
+uint32_t abstract_ata_interface_device::write_dma_block(const uint8_t *buffer, uint32_t words)
+{
+	uint32_t count = 1;
+	for (auto & elem : m_slot)
+		if (elem->dev() != nullptr)
+			count = std::max(count, elem->dev()->write_dma_block(buffer, words));
+
+	return count;
+}
+
 void abstract_ata_interface_device::internal_write_cs0(offs_t offset, uint16_t data, uint16_t mem_mask)
 {
 //  logerror( "%s: write cs0 %04x %04x %04x\n", machine().describe_context(), offset, data, mem_mask );
@@ -59,6 +59,8 @@ public:
 
 	uint16_t read_dma();
 	void write_dma(uint16_t data);
+	uint32_t read_dma_block(uint8_t *buffer, uint32_t words);
+	uint32_t write_dma_block(const uint8_t *buffer, uint32_t words);
 	DECLARE_WRITE_LINE_MEMBER(write_dmack);
 
 protected:
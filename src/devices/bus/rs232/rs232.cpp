@@ -68,6 +68,7 @@ rs232_port_device::rs232_port_device(const machine_config &mconfig, device_type
 	m_cts_handler(*this),
 	m_rxc_handler(*this),
 	m_txc_handler(*this),
+	m_serial_peer(*this, finder_base::DUMMY_TAG),
 	m_dev(nullptr)
 {
 }
@@ -120,6 +121,13 @@ void rs232_port_device::device_start()
 	save_item(NAME(m_cts));
 	save_item(NAME(m_dce_rxc));
 	save_item(NAME(m_dce_txc));
+
+	device_serial_interface *const card(dynamic_cast<device_serial_interface *>(m_dev));
+	if (m_serial_peer && card)
+	{
+		m_serial_peer->set_byte_peer(card);
+		card->set_byte_peer(m_serial_peer.target());
+	}
 }
 
 WRITE_LINE_MEMBER( rs232_port_device::write_txd )
@@ -128,6 +128,10 @@ public:
 	auto rxc_handler() { return m_rxc_handler.bind(); }
 	auto txc_handler() { return m_txc_handler.bind(); }
 
+	// byte-oriented serial device on the host side that exchanges whole
+	// frames with a card that is also a serial device
+	template <typename T> void set_serial_peer(T &&tag) { m_serial_peer.set_tag(std::forward<T>(tag)); }
+
 	DECLARE_WRITE_LINE_MEMBER( write_txd );                 // DB25 pin  2  V.24 circuit 103   Transmitted data
 	DECLARE_WRITE_LINE_MEMBER( write_dtr );                 // DB25 pin 20  V.24 circuit 108/2 Data terminal ready
 	DECLARE_WRITE_LINE_MEMBER( write_rts );                 // DB25 pin  4  V.24 circuit 105   Request to send
@@ -170,6 +174,7 @@ protected:
 	devcb_write_line m_txc_handler;
 
 private:
+	optional_device<device_serial_interface> m_serial_peer;
 	device_rs232_port_interface *m_dev;
 };
 
@@ -107,6 +107,7 @@
 
 #include "emu.h"
 #include "adsp2100.h"
+#include "adsp2100fe.h"
 #include "2100dasm.h"
 
 
@@ -165,6 +166,13 @@ adsp21xx_device::adsp21xx_device(const machine_config &mconfig, device_type type
 		m_mstat_mask((m_chip_type >= CHIP_TYPE_ADSP2101) ? 0x7f : 0x0f),
 		m_imask_mask((m_chip_type >= CHIP_TYPE_ADSP2181) ? 0x3ff :
 					(m_chip_type >= CHIP_TYPE_ADSP2101) ? 0x3f : 0x0f),
+		m_enable_drc(false),
+		m_drc_flush(1),
+		m_drc_op(0),
+		m_drc_cond(0),
+		m_entry(nullptr),
+		m_nocode(nullptr),
+		m_out_of_cycles(nullptr),
 		m_sport_rx_cb(*this),
 		m_sport_tx_cb(*this),
 		m_timer_fired_cb(*this),
@@ -326,6 +334,20 @@ void adsp21xx_device::load_boot_data(uint8_t *srcdata, uint32_t *dstdata)
 		uint32_t opcode = (srcdata[i*4+0] << 16) | (srcdata[i*4+1] << 8) | srcdata[i*4+2];
 		dstdata[i] = opcode;
 	}
+
+	// this bypasses the address space, so anything compiled may be stale
+	m_drc_flush = 1;
+}
+
+
+//-------------------------------------------------
+//  enable_recompiler - use the recompiler rather
+//  than the interpreter, if allowed
+//-------------------------------------------------
+
+void adsp21xx_device::enable_recompiler()
+{
+	m_enable_drc = allow_drc();
 }
 
 
@@ -666,6 +688,9 @@ void adsp21xx_device::device_reset()
 	m_imask = 0;
 	for (int irq = 0; irq < 10; irq++)
 		m_irq_state[irq] = m_irq_latch[irq] = CLEAR_LINE;
+
+	// program memory is usually reloaded before a reset
+	m_drc_flush = 1;
 }
 
 
@@ -681,6 +706,9 @@ void adsp21xx_device::device_post_load()
 		// PMOVLAY
 		update_dmovlay();
 	}
+
+	// program memory was restored behind the recompiler's back
+	m_drc_flush = 1;
 }
 
 
@@ -1198,6 +1226,722 @@ void adsp21xx_device::execute_set_input(int inputnum, int state)
 }
 
 
+//-------------------------------------------------
+//  execute_op - execute a single instruction,
+//  with m_pc already advanced past it
+//-------------------------------------------------
+
+inline ATTR_FORCE_INLINE void adsp21xx_device::execute_op(uint32_t op)
+{
+	uint32_t temp;
+	switch ((op >> 16) & 0xff)
+	{
+		case 0x00:
+			// 00000000 00000000 00000000  NOP
+			break;
+		case 0x01:
+			// 00000001 0xxxxxxx xxxxxxxx  dst = IO(x)
+			// 00000001 1xxxxxxx xxxxxxxx  IO(x) = dst
+			// ADSP-218x only
+			if (m_chip_type >= CHIP_TYPE_ADSP2181)
+			{
+				if ((op & 0x008000) == 0x000000)
+					write_reg0(op & 15, io_read((op >> 4) & 0x7ff));
+				else
+					io_write((op >> 4) & 0x7ff, read_reg0(op & 15));
+			}
+			break;
+		case 0x02:
+			// 00000010 0000xxxx xxxxxxxx  modify flag out
+			// 00000010 10000000 00000000  idle
+			// 00000010 10000000 0000xxxx  idle (n)
+			if (op & 0x008000)
+			{
+				m_idle = 1;
+				m_icount = 0;
+			}
+			else
+			{
+				if (condition(op & 15))
+				{
+					if (op & 0x020) m_flagout = 0;
+					if (op & 0x010) m_flagout ^= 1;
+					if (m_chip_type >= CHIP_TYPE_ADSP2101)
+					{
+						if (op & 0x080) m_fl0 = 0;
+						if (op & 0x040) m_fl0 ^= 1;
+						if (op & 0x200) m_fl1 = 0;
+						if (op & 0x100) m_fl1 ^= 1;
+						if (op & 0x800) m_fl2 = 0;
+						if (op & 0x400) m_fl2 ^= 1;
+					}
+				}
+			}
+			break;
+		case 0x03:
+			// 00000011 xxxxxxxx xxxxxxxx  call or jump on flag in
+			if (op & 0x000002)
+			{
+				if (m_flagin)
+				{
+					if (op & 0x000001)
+						pc_stack_push();
+					m_pc = ((op >> 4) & 0x0fff) | ((op << 10) & 0x3000);
+				}
+			}
+			else
+			{
+				if (!m_flagin)
+				{
+					if (op & 0x000001)
+						pc_stack_push();
+					m_pc = ((op >> 4) & 0x0fff) | ((op << 10) & 0x3000);
+				}
+			}
+			break;
+		case 0x04:
+			// 00000100 00000000 000xxxxx  stack control
+			if (op & 0x000010) pc_stack_pop_val();
+			if (op & 0x000008) loop_stack_pop();
+			if (op & 0x000004) cntr_stack_pop();
+			if (op & 0x000002)
+			{
+				if (op & 0x000001) stat_stack_pop();
+				else stat_stack_push();
+			}
+			break;
+		case 0x05:
+			// 00000101 00000000 00000000  saturate MR
+			if (GET_MV)
+			{
+				if (m_core.mr.mrx.mr2.u & 0x80)
+					m_core.mr.mrx.mr2.u = 0xffff, m_core.mr.mrx.mr1.u = 0x8000, m_core.mr.mrx.mr0.u = 0x0000;
+				else
+					m_core.mr.mrx.mr2.u = 0x0000, m_core.mr.mrx.mr1.u = 0x7fff, m_core.mr.mrx.mr0.u = 0xffff;
+			}
+			break;
+		case 0x06:
+			// 00000110 000xxxxx 00000000  DIVS
+			{
+				int xop = (op >> 8) & 7;
+				int yop = (op >> 11) & 3;
+
+				xop = ALU_GETXREG_UNSIGNED(xop);
+				yop = ALU_GETYREG_UNSIGNED(yop);
+
+				temp = xop ^ yop;
+				m_astat = (m_astat & ~QFLAG) | ((temp >> 10) & QFLAG);
+				m_core.af.u = (yop << 1) | (m_core.ay0.u >> 15);
+				m_core.ay0.u = (m_core.ay0.u << 1) | (temp >> 15);
+			}
+			break;
+		case 0x07:
+			// 00000111 00010xxx 00000000  DIVQ
+			{
+				int xop = (op >> 8) & 7;
+				int res;
+
+				xop = ALU_GETXREG_UNSIGNED(xop);
+
+				if (GET_Q)
+					res = m_core.af.u + xop;
+				else
+					res = m_core.af.u - xop;
+
+				temp = res ^ xop;
+				m_astat = (m_astat & ~QFLAG) | ((temp >> 10) & QFLAG);
+				m_core.af.u = (res << 1) | (m_core.ay0.u >> 15);
+				m_core.ay0.u = (m_core.ay0.u << 1) | ((~temp >> 15) & 0x0001);
+			}
+			break;
+		case 0x08:
+			// 00001000 00000000 0000xxxx  reserved
+			break;
+		case 0x09:
+			// 00001001 00000000 000xxxxx  modify address register
+			temp = (op >> 2) & 4;
+			modify_address(temp + ((op >> 2) & 3), temp + (op & 3));
+			break;
+		case 0x0a:
+			// 00001010 00000000 000xxxxx  conditional return
+			if (condition(op & 15))
+			{
+				pc_stack_pop();
+
+				// RTI case
+				if (op & 0x000010)
+					stat_stack_pop();
+			}
+			break;
+		case 0x0b:
+			// 00001011 00000000 xxxxxxxx  conditional jump (indirect address)
+			if (condition(op & 15))
+			{
+				if (op & 0x000010)
+					pc_stack_push();
+				m_pc = m_i[4 + ((op >> 6) & 3)] & 0x3fff;
+			}
+			break;
+		case 0x0c:
+			// 00001100 xxxxxxxx xxxxxxxx  mode control
+			if (m_chip_type >= CHIP_TYPE_ADSP2101)
+			{
+				if (op & 0x000008) m_mstat = (m_mstat & ~MSTAT_GOMODE) | ((op << 5) & MSTAT_GOMODE);
+				if (op & 0x002000) m_mstat = (m_mstat & ~MSTAT_INTEGER) | ((op >> 8) & MSTAT_INTEGER);
+				if (op & 0x008000) m_mstat = (m_mstat & ~MSTAT_TIMER) | ((op >> 9) & MSTAT_TIMER);
+			}
+			if (op & 0x000020) m_mstat = (m_mstat & ~MSTAT_BANK) | ((op >> 4) & MSTAT_BANK);
+			if (op & 0x000080) m_mstat = (m_mstat & ~MSTAT_REVERSE) | ((op >> 5) & MSTAT_REVERSE);
+			if (op & 0x000200) m_mstat = (m_mstat & ~MSTAT_STICKYV) | ((op >> 6) & MSTAT_STICKYV);
+			if (op & 0x000800) m_mstat = (m_mstat & ~MSTAT_SATURATE) | ((op >> 7) & MSTAT_SATURATE);
+			update_mstat();
+			break;
+		case 0x0d:
+			// 00001101 0000xxxx xxxxxxxx  internal data move
+			switch ((op >> 8) & 15)
+			{
+				case 0x00:  write_reg0((op >> 4) & 15, read_reg0(op & 15)); break;
+				case 0x01:  write_reg0((op >> 4) & 15, read_reg1(op & 15)); break;
+				case 0x02:  write_reg0((op >> 4) & 15, read_reg2(op & 15)); break;
+				case 0x03:  write_reg0((op >> 4) & 15, read_reg3(op & 15)); break;
+				case 0x04:  write_reg1((op >> 4) & 15, read_reg0(op & 15)); break;
+				case 0x05:  write_reg1((op >> 4) & 15, read_reg1(op & 15)); break;
+				case 0x06:  write_reg1((op >> 4) & 15, read_reg2(op & 15)); break;
+				case 0x07:  write_reg1((op >> 4) & 15, read_reg3(op & 15)); break;
+				case 0x08:  write_reg2((op >> 4) & 15, read_reg0(op & 15)); break;
+				case 0x09:  write_reg2((op >> 4) & 15, read_reg1(op & 15)); break;
+				case 0x0a:  write_reg2((op >> 4) & 15, read_reg2(op & 15)); break;
+				case 0x0b:  write_reg2((op >> 4) & 15, read_reg3(op & 15)); break;
+				case 0x0c:  write_reg3((op >> 4) & 15, read_reg0(op & 15)); break;
+				case 0x0d:  write_reg3((op >> 4) & 15, read_reg1(op & 15)); break;
+				case 0x0e:  write_reg3((op >> 4) & 15, read_reg2(op & 15)); break;
+				case 0x0f:  write_reg3((op >> 4) & 15, read_reg3(op & 15)); break;
+			}
+			break;
+		case 0x0e:
+			// 00001110 0xxxxxxx xxxxxxxx  conditional shift
+			if (condition(op & 15)) shift_op(op);
+			break;
+		case 0x0f:
+			// 00001111 0xxxxxxx xxxxxxxx  shift immediate
+			shift_op_imm(op);
+			break;
+		case 0x10:
+			// 00010000 0xxxxxxx xxxxxxxx  shift with internal data register move
+			shift_op(op);
+			temp = read_reg0(op & 15);
+			write_reg0((op >> 4) & 15, temp);
+			break;
+		case 0x11:
+			// 00010001 xxxxxxxx xxxxxxxx  shift with pgm memory read/write
+			if (op & 0x8000)
+			{
+				pgm_write_dag2(op, read_reg0((op >> 4) & 15));
+				shift_op(op);
+			}
+			else
+			{
+				shift_op(op);
+				write_reg0((op >> 4) & 15, pgm_read_dag2(op));
+			}
+			break;
+		case 0x12:
+			// 00010010 xxxxxxxx xxxxxxxx  shift with data memory read/write DAG1
+			if (op & 0x8000)
+			{
+				data_write_dag1(op, read_reg0((op >> 4) & 15));
+				shift_op(op);
+			}
+			else
+			{
+				shift_op(op);
+				write_reg0((op >> 4) & 15, data_read_dag1(op));
+			}
+			break;
+		case 0x13:
+			// 00010011 xxxxxxxx xxxxxxxx  shift with data memory read/write DAG2
+			if (op & 0x8000)
+			{
+				data_write_dag2(op, read_reg0((op >> 4) & 15));
+				shift_op(op);
+			}
+			else
+			{
+				shift_op(op);
+				write_reg0((op >> 4) & 15, data_read_dag2(op));
+			}
+			break;
+		case 0x14: case 0x15: case 0x16: case 0x17:
+			// 000101xx xxxxxxxx xxxxxxxx  do until
+			loop_stack_push(op & 0x3ffff);
+			pc_stack_push();
+			break;
+		case 0x18: case 0x19: case 0x1a: case 0x1b:
+			// 000110xx xxxxxxxx xxxxxxxx  conditional jump (immediate addr)
+			if (condition(op & 15))
+			{
+				m_pc = (op >> 4) & 0x3fff;
+				// check for a busy loop
+				if (m_pc == m_ppc)
+					m_icount = 0;
+			}
+			break;
+		case 0x1c: case 0x1d: case 0x1e: case 0x1f:
+			// 000111xx xxxxxxxx xxxxxxxx  conditional call (immediate addr)
+			if (condition(op & 15))
+			{
+				pc_stack_push();
+				m_pc = (op >> 4) & 0x3fff;
+			}
+			break;
+		case 0x20: case 0x21:
+			// 0010000x xxxxxxxx xxxxxxxx  conditional MAC to MR
+			if (condition(op & 15))
+			{
+				if (m_chip_type >= CHIP_TYPE_ADSP2181 && (op & 0x0018f0) == 0x000010)
+					mac_op_mr_xop(op);
+				else
+					mac_op_mr(op);
+			}
+			break;
+		case 0x22: case 0x23:
+			// 0010001x xxxxxxxx xxxxxxxx  conditional ALU to AR
+			if (condition(op & 15))
+			{
+				if (m_chip_type >= CHIP_TYPE_ADSP2181 && (op & 0x000010) == 0x000010)
+					alu_op_ar_const(op);
+				else
+					alu_op_ar(op);
+			}
+			break;
+		case 0x24: case 0x25:
+			// 0010010x xxxxxxxx xxxxxxxx  conditional MAC to MF
+			if (condition(op & 15))
+			{
+				if (m_chip_type >= CHIP_TYPE_ADSP2181 && (op & 0x0018f0) == 0x000010)
+					mac_op_mf_xop(op);
+				else
+					mac_op_mf(op);
+			}
+			break;
+		case 0x26: case 0x27:
+			// 0010011x xxxxxxxx xxxxxxxx  conditional ALU to AF
+			if (condition(op & 15))
+			{
+				if (m_chip_type >= CHIP_TYPE_ADSP2181 && (op & 0x000010) == 0x000010)
+					alu_op_af_const(op);
+				else
+					alu_op_af(op);
+			}
+			break;
+		case 0x28: case 0x29:
+			// 0010100x xxxxxxxx xxxxxxxx  MAC to MR with internal data register move
+			temp = read_reg0(op & 15);
+			mac_op_mr(op);
+			write_reg0((op >> 4) & 15, temp);
+			break;
+		case 0x2a: case 0x2b:
+			// 0010101x xxxxxxxx xxxxxxxx  ALU to AR with internal data register move
+			if (m_chip_type >= CHIP_TYPE_ADSP2181 && (op & 0x0000ff) == 0x0000aa)
+				alu_op_none(op);
+			else
+			{
+				temp = read_reg0(op & 15);
+				alu_op_ar(op);
+				write_reg0((op >> 4) & 15, temp);
+			}
+			break;
+		case 0x2c: case 0x2d:
+			// 0010110x xxxxxxxx xxxxxxxx  MAC to MF with internal data register move
+			temp = read_reg0(op & 15);
+			mac_op_mf(op);
+			write_reg0((op >> 4) & 15, temp);
+			break;
+		case 0x2e: case 0x2f:
+			// 0010111x xxxxxxxx xxxxxxxx  ALU to AF with internal data register move
+			temp = read_reg0(op & 15);
+			alu_op_af(op);
+			write_reg0((op >> 4) & 15, temp);
+			break;
+		case 0x30: case 0x31: case 0x32: case 0x33:
+			// 001100xx xxxxxxxx xxxxxxxx  load non-data register immediate (group 0)
+			write_reg0(op & 15, (int32_t)(op << 14) >> 18);
+			break;
+		case 0x34: case 0x35: case 0x36: case 0x37:
+			// 001101xx xxxxxxxx xxxxxxxx  load non-data register immediate (group 1)
+			write_reg1(op & 15, (int32_t)(op << 14) >> 18);
+			break;
+		case 0x38: case 0x39: case 0x3a: case 0x3b:
+			// 001110xx xxxxxxxx xxxxxxxx  load non-data register immediate (group 2)
+			write_reg2(op & 15, (int32_t)(op << 14) >> 18);
+			break;
+		case 0x3c: case 0x3d: case 0x3e: case 0x3f:
+			// 001111xx xxxxxxxx xxxxxxxx  load non-data register immediate (group 3)
+			write_reg3(op & 15, (int32_t)(op << 14) >> 18);
+			break;
+		case 0x40: case 0x41: case 0x42: case 0x43: case 0x44: case 0x45: case 0x46: case 0x47:
+		case 0x48: case 0x49: case 0x4a: case 0x4b: case 0x4c: case 0x4d: case 0x4e: case 0x4f:
+			// 0100xxxx xxxxxxxx xxxxxxxx  load data register immediate
+			write_reg0(op & 15, (op >> 4) & 0xffff);
+			break;
+		case 0x50: case 0x51:
+			// 0101000x xxxxxxxx xxxxxxxx  MAC to MR with pgm memory read
+			mac_op_mr(op);
+			write_reg0((op >> 4) & 15, pgm_read_dag2(op));
+			break;
+		case 0x52: case 0x53:
+			// 0101001x xxxxxxxx xxxxxxxx  ALU to AR with pgm memory read
+			alu_op_ar(op);
+			write_reg0((op >> 4) & 15, pgm_read_dag2(op));
+			break;
+		case 0x54: case 0x55:
+			// 0101010x xxxxxxxx xxxxxxxx  MAC to MF with pgm memory read
+			mac_op_mf(op);
+			write_reg0((op >> 4) & 15, pgm_read_dag2(op));
+			break;
+		case 0x56: case 0x57:
+			// 0101011x xxxxxxxx xxxxxxxx  ALU to AF with pgm memory read
+			alu_op_af(op);
+			write_reg0((op >> 4) & 15, pgm_read_dag2(op));
+			break;
+		case 0x58: case 0x59:
+			// 0101100x xxxxxxxx xxxxxxxx  MAC to MR with pgm memory write
+			pgm_write_dag2(op, read_reg0((op >> 4) & 15));
+			mac_op_mr(op);
+			break;
+		case 0x5a: case 0x5b:
+			// 0101101x xxxxxxxx xxxxxxxx  ALU to AR with pgm memory write
+			pgm_write_dag2(op, read_reg0((op >> 4) & 15));
+			alu_op_ar(op);
+			break;
+		case 0x5c: case 0x5d:
+			// 0101110x xxxxxxxx xxxxxxxx  ALU to MR with pgm memory write
+			pgm_write_dag2(op, read_reg0((op >> 4) & 15));
+			mac_op_mf(op);
+			break;
+		case 0x5e: case 0x5f:
+			// 0101111x xxxxxxxx xxxxxxxx  ALU to MF with pgm memory write
+			pgm_write_dag2(op, read_reg0((op >> 4) & 15));
+			alu_op_af(op);
+			break;
+		case 0x60: case 0x61:
+			// 0110000x xxxxxxxx xxxxxxxx  MAC to MR with data memory read DAG1
+			mac_op_mr(op);
+			write_reg0((op >> 4) & 15, data_read_dag1(op));
+			break;
+		case 0x62: case 0x63:
+			// 0110001x xxxxxxxx xxxxxxxx  ALU to AR with data memory read DAG1
+			alu_op_ar(op);
+			write_reg0((op >> 4) & 15, data_read_dag1(op));
+			break;
+		case 0x64: case 0x65:
+			// 0110010x xxxxxxxx xxxxxxxx  MAC to MF with data memory read DAG1
+			mac_op_mf(op);
+			write_reg0((op >> 4) & 15, data_read_dag1(op));
+			break;
+		case 0x66: case 0x67:
+			// 0110011x xxxxxxxx xxxxxxxx  ALU to AF with data memory read DAG1
+			alu_op_af(op);
+			write_reg0((op >> 4) & 15, data_read_dag1(op));
+			break;
+		case 0x68: case 0x69:
+			// 0110100x xxxxxxxx xxxxxxxx  MAC to MR with data memory write DAG1
+			data_write_dag1(op, read_reg0((op >> 4) & 15));
+			mac_op_mr(op);
+			break;
+		case 0x6a: case 0x6b:
+			// 0110101x xxxxxxxx xxxxxxxx  ALU to AR with data memory write DAG1
+			data_write_dag1(op, read_reg0((op >> 4) & 15));
+			alu_op_ar(op);
+			break;
+		case 0x6c: case 0x6d:
+			// 0111110x xxxxxxxx xxxxxxxx  MAC to MF with data memory write DAG1
+			data_write_dag1(op, read_reg0((op >> 4) & 15));
+			mac_op_mf(op);
+			break;
+		case 0x6e: case 0x6f:
+			// 0111111x xxxxxxxx xxxxxxxx  ALU to AF with data memory write DAG1
+			data_write_dag1(op, read_reg0((op >> 4) & 15));
+			alu_op_af(op);
+			break;
+		case 0x70: case 0x71:
+			// 0111000x xxxxxxxx xxxxxxxx  MAC to MR with data memory read DAG2
+			mac_op_mr(op);
+			write_reg0((op >> 4) & 15, data_read_dag2(op));
+			break;
+		case 0x72: case 0x73:
+			// 0111001x xxxxxxxx xxxxxxxx  ALU to AR with data memory read DAG2
+			alu_op_ar(op);
+			write_reg0((op >> 4) & 15, data_read_dag2(op));
+			break;
+		case 0x74: case 0x75:
+			// 0111010x xxxxxxxx xxxxxxxx  MAC to MF with data memory read DAG2
+			mac_op_mf(op);
+			write_reg0((op >> 4) & 15, data_read_dag2(op));
+			break;
+		case 0x76: case 0x77:
+			// 0111011x xxxxxxxx xxxxxxxx  ALU to AF with data memory read DAG2
+			alu_op_af(op);
+			write_reg0((op >> 4) & 15, data_read_dag2(op));
+			break;
+		case 0x78: case 0x79:
+			// 0111100x xxxxxxxx xxxxxxxx  MAC to MR with data memory write DAG2
+			data_write_dag2(op, read_reg0((op >> 4) & 15));
+			mac_op_mr(op);
+			break;
+		case 0x7a: case 0x7b:
+			// 0111101x xxxxxxxx xxxxxxxx  ALU to AR with data memory write DAG2
+			data_write_dag2(op, read_reg0((op >> 4) & 15));
+			alu_op_ar(op);
+			break;
+		case 0x7c: case 0x7d:
+			// 0111110x xxxxxxxx xxxxxxxx  MAC to MF with data memory write DAG2
+			data_write_dag2(op, read_reg0((op >> 4) & 15));
+			mac_op_mf(op);
+			break;
+		case 0x7e: case 0x7f:
+			// 0111111x xxxxxxxx xxxxxxxx  ALU to AF with data memory write DAG2
+			data_write_dag2(op, read_reg0((op >> 4) & 15));
+			alu_op_af(op);
+			break;
+		case 0x80: case 0x81: case 0x82: case 0x83:
+			// 100000xx xxxxxxxx xxxxxxxx  read data memory (immediate addr) to reg group 0
+			write_reg0(op & 15, data_read((op >> 4) & 0x3fff));
+			break;
+		case 0x84: case 0x85: case 0x86: case 0x87:
+			// 100001xx xxxxxxxx xxxxxxxx  read data memory (immediate addr) to reg group 1
+			write_reg1(op & 15, data_read((op >> 4) & 0x3fff));
+			break;
+		case 0x88: case 0x89: case 0x8a: case 0x8b:
+			// 100010xx xxxxxxxx xxxxxxxx  read data memory (immediate addr) to reg group 2
+			write_reg2(op & 15, data_read((op >> 4) & 0x3fff));
+			break;
+		case 0x8c: case 0x8d: case 0x8e: case 0x8f:
+			// 100011xx xxxxxxxx xxxxxxxx  read data memory (immediate addr) to reg group 3
+			write_reg3(op & 15, data_read((op >> 4) & 0x3fff));
+			break;
+		case 0x90: case 0x91: case 0x92: case 0x93:
+			// 1001xxxx xxxxxxxx xxxxxxxx  write data memory (immediate addr) from reg group 0
+			data_write((op >> 4) & 0x3fff, read_reg0(op & 15));
+			break;
+		case 0x94: case 0x95: case 0x96: case 0x97:
+			// 1001xxxx xxxxxxxx xxxxxxxx  write data memory (immediate addr) from reg group 1
+			data_write((op >> 4) & 0x3fff, read_reg1(op & 15));
+			break;
+		case 0x98: case 0x99: case 0x9a: case 0x9b:
+			// 1001xxxx xxxxxxxx xxxxxxxx  write data memory (immediate addr) from reg group 2
+			data_write((op >> 4) & 0x3fff, read_reg2(op & 15));
+			break;
+		case 0x9c: case 0x9d: case 0x9e: case 0x9f:
+			// 1001xxxx xxxxxxxx xxxxxxxx  write data memory (immediate addr) from reg group 3
+			data_write((op >> 4) & 0x3fff, read_reg3(op & 15));
+			break;
+		case 0xa0: case 0xa1: case 0xa2: case 0xa3: case 0xa4: case 0xa5: case 0xa6: case 0xa7:
+		case 0xa8: case 0xa9: case 0xaa: case 0xab: case 0xac: case 0xad: case 0xae: case 0xaf:
+			// 1010xxxx xxxxxxxx xxxxxxxx  data memory write (immediate) DAG1
+			data_write_dag1(op, (op >> 4) & 0xffff);
+			break;
+		case 0xb0: case 0xb1: case 0xb2: case 0xb3: case 0xb4: case 0xb5: case 0xb6: case 0xb7:
+		case 0xb8: case 0xb9: case 0xba: case 0xbb: case 0xbc: case 0xbd: case 0xbe: case 0xbf:
+			// 1011xxxx xxxxxxxx xxxxxxxx  data memory write (immediate) DAG2
+			data_write_dag2(op, (op >> 4) & 0xffff);
+			break;
+		case 0xc0: case 0xc1:
+			// 1100000x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX0 & pgm read to AY0
+			mac_op_mr(op);
+			m_core.ax0.u = data_read_dag1(op);
+			m_core.ay0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xc2: case 0xc3:
+			// 1100001x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX0 & pgm read to AY0
+			alu_op_ar(op);
+			m_core.ax0.u = data_read_dag1(op);
+			m_core.ay0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xc4: case 0xc5:
+			// 1100010x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX1 & pgm read to AY0
+			mac_op_mr(op);
+			m_core.ax1.u = data_read_dag1(op);
+			m_core.ay0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xc6: case 0xc7:
+			// 1100011x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX1 & pgm read to AY0
+			alu_op_ar(op);
+			m_core.ax1.u = data_read_dag1(op);
+			m_core.ay0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xc8: case 0xc9:
+			// 1100100x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX0 & pgm read to AY0
+			mac_op_mr(op);
+			m_core.mx0.u = data_read_dag1(op);
+			m_core.ay0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xca: case 0xcb:
+			// 1100101x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX0 & pgm read to AY0
+			alu_op_ar(op);
+			m_core.mx0.u = data_read_dag1(op);
+			m_core.ay0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xcc: case 0xcd:
+			// 1100110x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX1 & pgm read to AY0
+			mac_op_mr(op);
+			m_core.mx1.u = data_read_dag1(op);
+			m_core.ay0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xce: case 0xcf:
+			// 1100111x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX1 & pgm read to AY0
+			alu_op_ar(op);
+			m_core.mx1.u = data_read_dag1(op);
+			m_core.ay0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xd0: case 0xd1:
+			// 1101000x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX0 & pgm read to AY1
+			mac_op_mr(op);
+			m_core.ax0.u = data_read_dag1(op);
+			m_core.ay1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xd2: case 0xd3:
+			// 1101001x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX0 & pgm read to AY1
+			alu_op_ar(op);
+			m_core.ax0.u = data_read_dag1(op);
+			m_core.ay1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xd4: case 0xd5:
+			// 1101010x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX1 & pgm read to AY1
+			mac_op_mr(op);
+			m_core.ax1.u = data_read_dag1(op);
+			m_core.ay1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xd6: case 0xd7:
+			// 1101011x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX1 & pgm read to AY1
+			alu_op_ar(op);
+			m_core.ax1.u = data_read_dag1(op);
+			m_core.ay1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xd8: case 0xd9:
+			// 1101100x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX0 & pgm read to AY1
+			mac_op_mr(op);
+			m_core.mx0.u = data_read_dag1(op);
+			m_core.ay1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xda: case 0xdb:
+			// 1101101x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX0 & pgm read to AY1
+			alu_op_ar(op);
+			m_core.mx0.u = data_read_dag1(op);
+			m_core.ay1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xdc: case 0xdd:
+			// 1101110x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX1 & pgm read to AY1
+			mac_op_mr(op);
+			m_core.mx1.u = data_read_dag1(op);
+			m_core.ay1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xde: case 0xdf:
+			// 1101111x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX1 & pgm read to AY1
+			alu_op_ar(op);
+			m_core.mx1.u = data_read_dag1(op);
+			m_core.ay1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xe0: case 0xe1:
+			// 1110000x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX0 & pgm read to MY0
+			mac_op_mr(op);
+			m_core.ax0.u = data_read_dag1(op);
+			m_core.my0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xe2: case 0xe3:
+			// 1110001x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX0 & pgm read to MY0
+			alu_op_ar(op);
+			m_core.ax0.u = data_read_dag1(op);
+			m_core.my0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xe4: case 0xe5:
+			// 1110010x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX1 & pgm read to MY0
+			mac_op_mr(op);
+			m_core.ax1.u = data_read_dag1(op);
+			m_core.my0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xe6: case 0xe7:
+			// 1110011x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX1 & pgm read to MY0
+			alu_op_ar(op);
+			m_core.ax1.u = data_read_dag1(op);
+			m_core.my0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xe8: case 0xe9:
+			// 1110100x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX0 & pgm read to MY0
+			mac_op_mr(op);
+			m_core.mx0.u = data_read_dag1(op);
+			m_core.my0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xea: case 0xeb:
+			// 1110101x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX0 & pgm read to MY0
+			alu_op_ar(op);
+			m_core.mx0.u = data_read_dag1(op);
+			m_core.my0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xec: case 0xed:
+			// 1110110x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX1 & pgm read to MY0
+			mac_op_mr(op);
+			m_core.mx1.u = data_read_dag1(op);
+			m_core.my0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xee: case 0xef:
+			// 1110111x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX1 & pgm read to MY0
+			alu_op_ar(op);
+			m_core.mx1.u = data_read_dag1(op);
+			m_core.my0.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xf0: case 0xf1:
+			// 1111000x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX0 & pgm read to MY1
+			mac_op_mr(op);
+			m_core.ax0.u = data_read_dag1(op);
+			m_core.my1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xf2: case 0xf3:
+			// 1111001x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX0 & pgm read to MY1
+			alu_op_ar(op);
+			m_core.ax0.u = data_read_dag1(op);
+			m_core.my1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xf4: case 0xf5:
+			// 1111010x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX1 & pgm read to MY1
+			mac_op_mr(op);
+			m_core.ax1.u = data_read_dag1(op);
+			m_core.my1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xf6: case 0xf7:
+			// 1111011x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX1 & pgm read to MY1
+			alu_op_ar(op);
+			m_core.ax1.u = data_read_dag1(op);
+			m_core.my1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xf8: case 0xf9:
+			// 1111100x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX0 & pgm read to MY1
+			mac_op_mr(op);
+			m_core.mx0.u = data_read_dag1(op);
+			m_core.my1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xfa: case 0xfb:
+			// 1111101x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX0 & pgm read to MY1
+			alu_op_ar(op);
+			m_core.mx0.u = data_read_dag1(op);
+			m_core.my1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xfc: case 0xfd:
+			// 1111110x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX1 & pgm read to MY1
+			mac_op_mr(op);
+			m_core.mx1.u = data_read_dag1(op);
+			m_core.my1.u = pgm_read_dag2(op >> 4);
+			break;
+		case 0xfe: case 0xff:
+			// 1111111x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX1 & pgm read to MY1
+			alu_op_ar(op);
+			m_core.mx1.u = data_read_dag1(op);
+			m_core.my1.u = pgm_read_dag2(op >> 4);
+			break;
+	}
+}
+
+
 void adsp21xx_device::execute_run()
 {
 	// Return if CPU is halted
@@ -1206,10 +1950,16 @@ void adsp21xx_device::execute_run()
 		return;
 	}
 
-	bool check_debugger = ((device_t::machine().debug_flags & DEBUG_FLAG_ENABLED) != 0);
-
 	check_irqs();
 
+	if (m_enable_drc)
+	{
+		execute_run_drc();
+		return;
+	}
+
+	bool check_debugger = ((device_t::machine().debug_flags & DEBUG_FLAG_ENABLED) != 0);
+
 	do
 	{
 		// debugging
@@ -1244,714 +1994,65 @@ void adsp21xx_device::execute_run()
 			}
 		}
 
-		// parse the instruction
-		uint32_t temp;
-		switch ((op >> 16) & 0xff)
-		{
-			case 0x00:
-				// 00000000 00000000 00000000  NOP
-				break;
-			case 0x01:
-				// 00000001 0xxxxxxx xxxxxxxx  dst = IO(x)
-				// 00000001 1xxxxxxx xxxxxxxx  IO(x) = dst
-				// ADSP-218x only
-				if (m_chip_type >= CHIP_TYPE_ADSP2181)
-				{
-					if ((op & 0x008000) == 0x000000)
-						write_reg0(op & 15, io_read((op >> 4) & 0x7ff));
-					else
-						io_write((op >> 4) & 0x7ff, read_reg0(op & 15));
-				}
-				break;
-			case 0x02:
-				// 00000010 0000xxxx xxxxxxxx  modify flag out
-				// 00000010 10000000 00000000  idle
-				// 00000010 10000000 0000xxxx  idle (n)
-				if (op & 0x008000)
-				{
-					m_idle = 1;
-					m_icount = 0;
-				}
-				else
-				{
-					if (condition(op & 15))
-					{
-						if (op & 0x020) m_flagout = 0;
-						if (op & 0x010) m_flagout ^= 1;
-						if (m_chip_type >= CHIP_TYPE_ADSP2101)
-						{
-							if (op & 0x080) m_fl0 = 0;
-							if (op & 0x040) m_fl0 ^= 1;
-							if (op & 0x200) m_fl1 = 0;
-							if (op & 0x100) m_fl1 ^= 1;
-							if (op & 0x800) m_fl2 = 0;
-							if (op & 0x400) m_fl2 ^= 1;
-						}
-					}
-				}
-				break;
-			case 0x03:
-				// 00000011 xxxxxxxx xxxxxxxx  call or jump on flag in
-				if (op & 0x000002)
-				{
-					if (m_flagin)
-					{
-						if (op & 0x000001)
-							pc_stack_push();
-						m_pc = ((op >> 4) & 0x0fff) | ((op << 10) & 0x3000);
-					}
-				}
-				else
-				{
-					if (!m_flagin)
-					{
-						if (op & 0x000001)
-							pc_stack_push();
-						m_pc = ((op >> 4) & 0x0fff) | ((op << 10) & 0x3000);
-					}
-				}
-				break;
-			case 0x04:
-				// 00000100 00000000 000xxxxx  stack control
-				if (op & 0x000010) pc_stack_pop_val();
-				if (op & 0x000008) loop_stack_pop();
-				if (op & 0x000004) cntr_stack_pop();
-				if (op & 0x000002)
-				{
-					if (op & 0x000001) stat_stack_pop();
-					else stat_stack_push();
-				}
-				break;
-			case 0x05:
-				// 00000101 00000000 00000000  saturate MR
-				if (GET_MV)
-				{
-					if (m_core.mr.mrx.mr2.u & 0x80)
-						m_core.mr.mrx.mr2.u = 0xffff, m_core.mr.mrx.mr1.u = 0x8000, m_core.mr.mrx.mr0.u = 0x0000;
-					else
-						m_core.mr.mrx.mr2.u = 0x0000, m_core.mr.mrx.mr1.u = 0x7fff, m_core.mr.mrx.mr0.u = 0xffff;
-				}
-				break;
-			case 0x06:
-				// 00000110 000xxxxx 00000000  DIVS
-				{
-					int xop = (op >> 8) & 7;
-					int yop = (op >> 11) & 3;
+		// execute it
+		execute_op(op);
 
-					xop = ALU_GETXREG_UNSIGNED(xop);
-					yop = ALU_GETYREG_UNSIGNED(yop);
+		m_icount--;
+	} while (m_icount > 0);
+}
 
-					temp = xop ^ yop;
-					m_astat = (m_astat & ~QFLAG) | ((temp >> 10) & QFLAG);
-					m_core.af.u = (yop << 1) | (m_core.ay0.u >> 15);
-					m_core.ay0.u = (m_core.ay0.u << 1) | (temp >> 15);
-				}
-				break;
-			case 0x07:
-				// 00000111 00010xxx 00000000  DIVQ
-				{
-					int xop = (op >> 8) & 7;
-					int res;
 
-					xop = ALU_GETXREG_UNSIGNED(xop);
+//-------------------------------------------------
+//  drc_execute_op - run m_drc_op through the
+//  interpreter for the recompiler; m_pc and m_ppc
+//  have already been set up
+//-------------------------------------------------
 
-					if (GET_Q)
-						res = m_core.af.u + xop;
-					else
-						res = m_core.af.u - xop;
+void adsp21xx_device::drc_execute_op()
+{
+	execute_op(m_drc_op);
+}
 
-					temp = res ^ xop;
-					m_astat = (m_astat & ~QFLAG) | ((temp >> 10) & QFLAG);
-					m_core.af.u = (res << 1) | (m_core.ay0.u >> 15);
-					m_core.ay0.u = (m_core.ay0.u << 1) | ((~temp >> 15) & 0x0001);
-				}
-				break;
-			case 0x08:
-				// 00001000 00000000 0000xxxx  reserved
-				break;
-			case 0x09:
-				// 00001001 00000000 000xxxxx  modify address register
-				temp = (op >> 2) & 4;
-				modify_address(temp + ((op >> 2) & 3), temp + (op & 3));
-				break;
-			case 0x0a:
-				// 00001010 00000000 000xxxxx  conditional return
-				if (condition(op & 15))
-				{
-					pc_stack_pop();
 
-					// RTI case
-					if (op & 0x000010)
-						stat_stack_pop();
-				}
-				break;
-			case 0x0b:
-				// 00001011 00000000 xxxxxxxx  conditional jump (indirect address)
-				if (condition(op & 15))
-				{
-					if (op & 0x000010)
-						pc_stack_push();
-					m_pc = m_i[4 + ((op >> 6) & 3)] & 0x3fff;
-				}
-				break;
-			case 0x0c:
-				// 00001100 xxxxxxxx xxxxxxxx  mode control
-				if (m_chip_type >= CHIP_TYPE_ADSP2101)
-				{
-					if (op & 0x000008) m_mstat = (m_mstat & ~MSTAT_GOMODE) | ((op << 5) & MSTAT_GOMODE);
-					if (op & 0x002000) m_mstat = (m_mstat & ~MSTAT_INTEGER) | ((op >> 8) & MSTAT_INTEGER);
-					if (op & 0x008000) m_mstat = (m_mstat & ~MSTAT_TIMER) | ((op >> 9) & MSTAT_TIMER);
-				}
-				if (op & 0x000020) m_mstat = (m_mstat & ~MSTAT_BANK) | ((op >> 4) & MSTAT_BANK);
-				if (op & 0x000080) m_mstat = (m_mstat & ~MSTAT_REVERSE) | ((op >> 5) & MSTAT_REVERSE);
-				if (op & 0x000200) m_mstat = (m_mstat & ~MSTAT_STICKYV) | ((op >> 6) & MSTAT_STICKYV);
-				if (op & 0x000800) m_mstat = (m_mstat & ~MSTAT_SATURATE) | ((op >> 7) & MSTAT_SATURATE);
-				update_mstat();
-				break;
-			case 0x0d:
-				// 00001101 0000xxxx xxxxxxxx  internal data move
-				switch ((op >> 8) & 15)
-				{
-					case 0x00:  write_reg0((op >> 4) & 15, read_reg0(op & 15)); break;
-					case 0x01:  write_reg0((op >> 4) & 15, read_reg1(op & 15)); break;
-					case 0x02:  write_reg0((op >> 4) & 15, read_reg2(op & 15)); break;
-					case 0x03:  write_reg0((op >> 4) & 15, read_reg3(op & 15)); break;
-					case 0x04:  write_reg1((op >> 4) & 15, read_reg0(op & 15)); break;
-					case 0x05:  write_reg1((op >> 4) & 15, read_reg1(op & 15)); break;
-					case 0x06:  write_reg1((op >> 4) & 15, read_reg2(op & 15)); break;
-					case 0x07:  write_reg1((op >> 4) & 15, read_reg3(op & 15)); break;
-					case 0x08:  write_reg2((op >> 4) & 15, read_reg0(op & 15)); break;
-					case 0x09:  write_reg2((op >> 4) & 15, read_reg1(op & 15)); break;
-					case 0x0a:  write_reg2((op >> 4) & 15, read_reg2(op & 15)); break;
-					case 0x0b:  write_reg2((op >> 4) & 15, read_reg3(op & 15)); break;
-					case 0x0c:  write_reg3((op >> 4) & 15, read_reg0(op & 15)); break;
-					case 0x0d:  write_reg3((op >> 4) & 15, read_reg1(op & 15)); break;
-					case 0x0e:  write_reg3((op >> 4) & 15, read_reg2(op & 15)); break;
-					case 0x0f:  write_reg3((op >> 4) & 15, read_reg3(op & 15)); break;
-				}
-				break;
-			case 0x0e:
-				// 00001110 0xxxxxxx xxxxxxxx  conditional shift
-				if (condition(op & 15)) shift_op(op);
-				break;
-			case 0x0f:
-				// 00001111 0xxxxxxx xxxxxxxx  shift immediate
-				shift_op_imm(op);
-				break;
-			case 0x10:
-				// 00010000 0xxxxxxx xxxxxxxx  shift with internal data register move
-				shift_op(op);
-				temp = read_reg0(op & 15);
-				write_reg0((op >> 4) & 15, temp);
-				break;
-			case 0x11:
-				// 00010001 xxxxxxxx xxxxxxxx  shift with pgm memory read/write
-				if (op & 0x8000)
-				{
-					pgm_write_dag2(op, read_reg0((op >> 4) & 15));
-					shift_op(op);
-				}
-				else
-				{
-					shift_op(op);
-					write_reg0((op >> 4) & 15, pgm_read_dag2(op));
-				}
-				break;
-			case 0x12:
-				// 00010010 xxxxxxxx xxxxxxxx  shift with data memory read/write DAG1
-				if (op & 0x8000)
-				{
-					data_write_dag1(op, read_reg0((op >> 4) & 15));
-					shift_op(op);
-				}
-				else
-				{
-					shift_op(op);
-					write_reg0((op >> 4) & 15, data_read_dag1(op));
-				}
-				break;
-			case 0x13:
-				// 00010011 xxxxxxxx xxxxxxxx  shift with data memory read/write DAG2
-				if (op & 0x8000)
-				{
-					data_write_dag2(op, read_reg0((op >> 4) & 15));
-					shift_op(op);
-				}
-				else
-				{
-					shift_op(op);
-					write_reg0((op >> 4) & 15, data_read_dag2(op));
-				}
-				break;
-			case 0x14: case 0x15: case 0x16: case 0x17:
-				// 000101xx xxxxxxxx xxxxxxxx  do until
-				loop_stack_push(op & 0x3ffff);
-				pc_stack_push();
-				break;
-			case 0x18: case 0x19: case 0x1a: case 0x1b:
-				// 000110xx xxxxxxxx xxxxxxxx  conditional jump (immediate addr)
-				if (condition(op & 15))
-				{
-					m_pc = (op >> 4) & 0x3fff;
-					// check for a busy loop
-					if (m_pc == m_ppc)
-						m_icount = 0;
-				}
-				break;
-			case 0x1c: case 0x1d: case 0x1e: case 0x1f:
-				// 000111xx xxxxxxxx xxxxxxxx  conditional call (immediate addr)
-				if (condition(op & 15))
-				{
-					pc_stack_push();
-					m_pc = (op >> 4) & 0x3fff;
-				}
-				break;
-			case 0x20: case 0x21:
-				// 0010000x xxxxxxxx xxxxxxxx  conditional MAC to MR
-				if (condition(op & 15))
-				{
-					if (m_chip_type >= CHIP_TYPE_ADSP2181 && (op & 0x0018f0) == 0x000010)
-						mac_op_mr_xop(op);
-					else
-						mac_op_mr(op);
-				}
-				break;
-			case 0x22: case 0x23:
-				// 0010001x xxxxxxxx xxxxxxxx  conditional ALU to AR
-				if (condition(op & 15))
-				{
-					if (m_chip_type >= CHIP_TYPE_ADSP2181 && (op & 0x000010) == 0x000010)
-						alu_op_ar_const(op);
-					else
-						alu_op_ar(op);
-				}
-				break;
-			case 0x24: case 0x25:
-				// 0010010x xxxxxxxx xxxxxxxx  conditional MAC to MF
-				if (condition(op & 15))
-				{
-					if (m_chip_type >= CHIP_TYPE_ADSP2181 && (op & 0x0018f0) == 0x000010)
-						mac_op_mf_xop(op);
-					else
-						mac_op_mf(op);
-				}
-				break;
-			case 0x26: case 0x27:
-				// 0010011x xxxxxxxx xxxxxxxx  conditional ALU to AF
-				if (condition(op & 15))
-				{
-					if (m_chip_type >= CHIP_TYPE_ADSP2181 && (op & 0x000010) == 0x000010)
-						alu_op_af_const(op);
-					else
-						alu_op_af(op);
-				}
-				break;
-			case 0x28: case 0x29:
-				// 0010100x xxxxxxxx xxxxxxxx  MAC to MR with internal data register move
-				temp = read_reg0(op & 15);
-				mac_op_mr(op);
-				write_reg0((op >> 4) & 15, temp);
-				break;
-			case 0x2a: case 0x2b:
-				// 0010101x xxxxxxxx xxxxxxxx  ALU to AR with internal data register move
-				if (m_chip_type >= CHIP_TYPE_ADSP2181 && (op & 0x0000ff) == 0x0000aa)
-					alu_op_none(op);
-				else
-				{
-					temp = read_reg0(op & 15);
-					alu_op_ar(op);
-					write_reg0((op >> 4) & 15, temp);
-				}
-				break;
-			case 0x2c: case 0x2d:
-				// 0010110x xxxxxxxx xxxxxxxx  MAC to MF with internal data register move
-				temp = read_reg0(op & 15);
-				mac_op_mf(op);
-				write_reg0((op >> 4) & 15, temp);
-				break;
-			case 0x2e: case 0x2f:
-				// 0010111x xxxxxxxx xxxxxxxx  ALU to AF with internal data register move
-				temp = read_reg0(op & 15);
-				alu_op_af(op);
-				write_reg0((op >> 4) & 15, temp);
-				break;
-			case 0x30: case 0x31: case 0x32: case 0x33:
-				// 001100xx xxxxxxxx xxxxxxxx  load non-data register immediate (group 0)
-				write_reg0(op & 15, (int32_t)(op << 14) >> 18);
-				break;
-			case 0x34: case 0x35: case 0x36: case 0x37:
-				// 001101xx xxxxxxxx xxxxxxxx  load non-data register immediate (group 1)
-				write_reg1(op & 15, (int32_t)(op << 14) >> 18);
-				break;
-			case 0x38: case 0x39: case 0x3a: case 0x3b:
-				// 001110xx xxxxxxxx xxxxxxxx  load non-data register immediate (group 2)
-				write_reg2(op & 15, (int32_t)(op << 14) >> 18);
-				break;
-			case 0x3c: case 0x3d: case 0x3e: case 0x3f:
-				// 001111xx xxxxxxxx xxxxxxxx  load non-data register immediate (group 3)
-				write_reg3(op & 15, (int32_t)(op << 14) >> 18);
-				break;
-			case 0x40: case 0x41: case 0x42: case 0x43: case 0x44: case 0x45: case 0x46: case 0x47:
-			case 0x48: case 0x49: case 0x4a: case 0x4b: case 0x4c: case 0x4d: case 0x4e: case 0x4f:
-				// 0100xxxx xxxxxxxx xxxxxxxx  load data register immediate
-				write_reg0(op & 15, (op >> 4) & 0xffff);
-				break;
-			case 0x50: case 0x51:
-				// 0101000x xxxxxxxx xxxxxxxx  MAC to MR with pgm memory read
-				mac_op_mr(op);
-				write_reg0((op >> 4) & 15, pgm_read_dag2(op));
-				break;
-			case 0x52: case 0x53:
-				// 0101001x xxxxxxxx xxxxxxxx  ALU to AR with pgm memory read
-				alu_op_ar(op);
-				write_reg0((op >> 4) & 15, pgm_read_dag2(op));
-				break;
-			case 0x54: case 0x55:
-				// 0101010x xxxxxxxx xxxxxxxx  MAC to MF with pgm memory read
-				mac_op_mf(op);
-				write_reg0((op >> 4) & 15, pgm_read_dag2(op));
-				break;
-			case 0x56: case 0x57:
-				// 0101011x xxxxxxxx xxxxxxxx  ALU to AF with pgm memory read
-				alu_op_af(op);
-				write_reg0((op >> 4) & 15, pgm_read_dag2(op));
-				break;
-			case 0x58: case 0x59:
-				// 0101100x xxxxxxxx xxxxxxxx  MAC to MR with pgm memory write
-				pgm_write_dag2(op, read_reg0((op >> 4) & 15));
-				mac_op_mr(op);
-				break;
-			case 0x5a: case 0x5b:
-				// 0101101x xxxxxxxx xxxxxxxx  ALU to AR with pgm memory write
-				pgm_write_dag2(op, read_reg0((op >> 4) & 15));
-				alu_op_ar(op);
-				break;
-			case 0x5c: case 0x5d:
-				// 0101110x xxxxxxxx xxxxxxxx  ALU to MR with pgm memory write
-				pgm_write_dag2(op, read_reg0((op >> 4) & 15));
-				mac_op_mf(op);
-				break;
-			case 0x5e: case 0x5f:
-				// 0101111x xxxxxxxx xxxxxxxx  ALU to MF with pgm memory write
-				pgm_write_dag2(op, read_reg0((op >> 4) & 15));
-				alu_op_af(op);
-				break;
-			case 0x60: case 0x61:
-				// 0110000x xxxxxxxx xxxxxxxx  MAC to MR with data memory read DAG1
-				mac_op_mr(op);
-				write_reg0((op >> 4) & 15, data_read_dag1(op));
-				break;
-			case 0x62: case 0x63:
-				// 0110001x xxxxxxxx xxxxxxxx  ALU to AR with data memory read DAG1
-				alu_op_ar(op);
-				write_reg0((op >> 4) & 15, data_read_dag1(op));
-				break;
-			case 0x64: case 0x65:
-				// 0110010x xxxxxxxx xxxxxxxx  MAC to MF with data memory read DAG1
-				mac_op_mf(op);
-				write_reg0((op >> 4) & 15, data_read_dag1(op));
-				break;
-			case 0x66: case 0x67:
-				// 0110011x xxxxxxxx xxxxxxxx  ALU to AF with data memory read DAG1
-				alu_op_af(op);
-				write_reg0((op >> 4) & 15, data_read_dag1(op));
-				break;
-			case 0x68: case 0x69:
-				// 0110100x xxxxxxxx xxxxxxxx  MAC to MR with data memory write DAG1
-				data_write_dag1(op, read_reg0((op >> 4) & 15));
-				mac_op_mr(op);
-				break;
-			case 0x6a: case 0x6b:
-				// 0110101x xxxxxxxx xxxxxxxx  ALU to AR with data memory write DAG1
-				data_write_dag1(op, read_reg0((op >> 4) & 15));
-				alu_op_ar(op);
-				break;
-			case 0x6c: case 0x6d:
-				// 0111110x xxxxxxxx xxxxxxxx  MAC to MF with data memory write DAG1
-				data_write_dag1(op, read_reg0((op >> 4) & 15));
-				mac_op_mf(op);
-				break;
-			case 0x6e: case 0x6f:
-				// 0111111x xxxxxxxx xxxxxxxx  ALU to AF with data memory write DAG1
-				data_write_dag1(op, read_reg0((op >> 4) & 15));
-				alu_op_af(op);
-				break;
-			case 0x70: case 0x71:
-				// 0111000x xxxxxxxx xxxxxxxx  MAC to MR with data memory read DAG2
-				mac_op_mr(op);
-				write_reg0((op >> 4) & 15, data_read_dag2(op));
-				break;
-			case 0x72: case 0x73:
-				// 0111001x xxxxxxxx xxxxxxxx  ALU to AR with data memory read DAG2
-				alu_op_ar(op);
-				write_reg0((op >> 4) & 15, data_read_dag2(op));
-				break;
-			case 0x74: case 0x75:
-				// 0111010x xxxxxxxx xxxxxxxx  MAC to MF with data memory read DAG2
-				mac_op_mf(op);
-				write_reg0((op >> 4) & 15, data_read_dag2(op));
-				break;
-			case 0x76: case 0x77:
-				// 0111011x xxxxxxxx xxxxxxxx  ALU to AF with data memory read DAG2
-				alu_op_af(op);
-				write_reg0((op >> 4) & 15, data_read_dag2(op));
-				break;
-			case 0x78: case 0x79:
-				// 0111100x xxxxxxxx xxxxxxxx  MAC to MR with data memory write DAG2
-				data_write_dag2(op, read_reg0((op >> 4) & 15));
-				mac_op_mr(op);
-				break;
-			case 0x7a: case 0x7b:
-				// 0111101x xxxxxxxx xxxxxxxx  ALU to AR with data memory write DAG2
-				data_write_dag2(op, read_reg0((op >> 4) & 15));
-				alu_op_ar(op);
-				break;
-			case 0x7c: case 0x7d:
-				// 0111110x xxxxxxxx xxxxxxxx  MAC to MF with data memory write DAG2
-				data_write_dag2(op, read_reg0((op >> 4) & 15));
-				mac_op_mf(op);
-				break;
-			case 0x7e: case 0x7f:
-				// 0111111x xxxxxxxx xxxxxxxx  ALU to AF with data memory write DAG2
-				data_write_dag2(op, read_reg0((op >> 4) & 15));
-				alu_op_af(op);
-				break;
-			case 0x80: case 0x81: case 0x82: case 0x83:
-				// 100000xx xxxxxxxx xxxxxxxx  read data memory (immediate addr) to reg group 0
-				write_reg0(op & 15, data_read((op >> 4) & 0x3fff));
-				break;
-			case 0x84: case 0x85: case 0x86: case 0x87:
-				// 100001xx xxxxxxxx xxxxxxxx  read data memory (immediate addr) to reg group 1
-				write_reg1(op & 15, data_read((op >> 4) & 0x3fff));
-				break;
-			case 0x88: case 0x89: case 0x8a: case 0x8b:
-				// 100010xx xxxxxxxx xxxxxxxx  read data memory (immediate addr) to reg group 2
-				write_reg2(op & 15, data_read((op >> 4) & 0x3fff));
-				break;
-			case 0x8c: case 0x8d: case 0x8e: case 0x8f:
-				// 100011xx xxxxxxxx xxxxxxxx  read data memory (immediate addr) to reg group 3
-				write_reg3(op & 15, data_read((op >> 4) & 0x3fff));
-				break;
-			case 0x90: case 0x91: case 0x92: case 0x93:
-				// 1001xxxx xxxxxxxx xxxxxxxx  write data memory (immediate addr) from reg group 0
-				data_write((op >> 4) & 0x3fff, read_reg0(op & 15));
-				break;
-			case 0x94: case 0x95: case 0x96: case 0x97:
-				// 1001xxxx xxxxxxxx xxxxxxxx  write data memory (immediate addr) from reg group 1
-				data_write((op >> 4) & 0x3fff, read_reg1(op & 15));
-				break;
-			case 0x98: case 0x99: case 0x9a: case 0x9b:
-				// 1001xxxx xxxxxxxx xxxxxxxx  write data memory (immediate addr) from reg group 2
-				data_write((op >> 4) & 0x3fff, read_reg2(op & 15));
-				break;
-			case 0x9c: case 0x9d: case 0x9e: case 0x9f:
-				// 1001xxxx xxxxxxxx xxxxxxxx  write data memory (immediate addr) from reg group 3
-				data_write((op >> 4) & 0x3fff, read_reg3(op & 15));
-				break;
-			case 0xa0: case 0xa1: case 0xa2: case 0xa3: case 0xa4: case 0xa5: case 0xa6: case 0xa7:
-			case 0xa8: case 0xa9: case 0xaa: case 0xab: case 0xac: case 0xad: case 0xae: case 0xaf:
-				// 1010xxxx xxxxxxxx xxxxxxxx  data memory write (immediate) DAG1
-				data_write_dag1(op, (op >> 4) & 0xffff);
-				break;
-			case 0xb0: case 0xb1: case 0xb2: case 0xb3: case 0xb4: case 0xb5: case 0xb6: case 0xb7:
-			case 0xb8: case 0xb9: case 0xba: case 0xbb: case 0xbc: case 0xbd: case 0xbe: case 0xbf:
-				// 1011xxxx xxxxxxxx xxxxxxxx  data memory write (immediate) DAG2
-				data_write_dag2(op, (op >> 4) & 0xffff);
-				break;
-			case 0xc0: case 0xc1:
-				// 1100000x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX0 & pgm read to AY0
-				mac_op_mr(op);
-				m_core.ax0.u = data_read_dag1(op);
-				m_core.ay0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xc2: case 0xc3:
-				// 1100001x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX0 & pgm read to AY0
-				alu_op_ar(op);
-				m_core.ax0.u = data_read_dag1(op);
-				m_core.ay0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xc4: case 0xc5:
-				// 1100010x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX1 & pgm read to AY0
-				mac_op_mr(op);
-				m_core.ax1.u = data_read_dag1(op);
-				m_core.ay0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xc6: case 0xc7:
-				// 1100011x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX1 & pgm read to AY0
-				alu_op_ar(op);
-				m_core.ax1.u = data_read_dag1(op);
-				m_core.ay0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xc8: case 0xc9:
-				// 1100100x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX0 & pgm read to AY0
-				mac_op_mr(op);
-				m_core.mx0.u = data_read_dag1(op);
-				m_core.ay0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xca: case 0xcb:
-				// 1100101x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX0 & pgm read to AY0
-				alu_op_ar(op);
-				m_core.mx0.u = data_read_dag1(op);
-				m_core.ay0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xcc: case 0xcd:
-				// 1100110x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX1 & pgm read to AY0
-				mac_op_mr(op);
-				m_core.mx1.u = data_read_dag1(op);
-				m_core.ay0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xce: case 0xcf:
-				// 1100111x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX1 & pgm read to AY0
-				alu_op_ar(op);
-				m_core.mx1.u = data_read_dag1(op);
-				m_core.ay0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xd0: case 0xd1:
-				// 1101000x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX0 & pgm read to AY1
-				mac_op_mr(op);
-				m_core.ax0.u = data_read_dag1(op);
-				m_core.ay1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xd2: case 0xd3:
-				// 1101001x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX0 & pgm read to AY1
-				alu_op_ar(op);
-				m_core.ax0.u = data_read_dag1(op);
-				m_core.ay1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xd4: case 0xd5:
-				// 1101010x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX1 & pgm read to AY1
-				mac_op_mr(op);
-				m_core.ax1.u = data_read_dag1(op);
-				m_core.ay1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xd6: case 0xd7:
-				// 1101011x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX1 & pgm read to AY1
-				alu_op_ar(op);
-				m_core.ax1.u = data_read_dag1(op);
-				m_core.ay1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xd8: case 0xd9:
-				// 1101100x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX0 & pgm read to AY1
-				mac_op_mr(op);
-				m_core.mx0.u = data_read_dag1(op);
-				m_core.ay1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xda: case 0xdb:
-				// 1101101x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX0 & pgm read to AY1
-				alu_op_ar(op);
-				m_core.mx0.u = data_read_dag1(op);
-				m_core.ay1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xdc: case 0xdd:
-				// 1101110x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX1 & pgm read to AY1
-				mac_op_mr(op);
-				m_core.mx1.u = data_read_dag1(op);
-				m_core.ay1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xde: case 0xdf:
-				// 1101111x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX1 & pgm read to AY1
-				alu_op_ar(op);
-				m_core.mx1.u = data_read_dag1(op);
-				m_core.ay1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xe0: case 0xe1:
-				// 1110000x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX0 & pgm read to MY0
-				mac_op_mr(op);
-				m_core.ax0.u = data_read_dag1(op);
-				m_core.my0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xe2: case 0xe3:
-				// 1110001x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX0 & pgm read to MY0
-				alu_op_ar(op);
-				m_core.ax0.u = data_read_dag1(op);
-				m_core.my0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xe4: case 0xe5:
-				// 1110010x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX1 & pgm read to MY0
-				mac_op_mr(op);
-				m_core.ax1.u = data_read_dag1(op);
-				m_core.my0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xe6: case 0xe7:
-				// 1110011x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX1 & pgm read to MY0
-				alu_op_ar(op);
-				m_core.ax1.u = data_read_dag1(op);
-				m_core.my0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xe8: case 0xe9:
-				// 1110100x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX0 & pgm read to MY0
-				mac_op_mr(op);
-				m_core.mx0.u = data_read_dag1(op);
-				m_core.my0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xea: case 0xeb:
-				// 1110101x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX0 & pgm read to MY0
-				alu_op_ar(op);
-				m_core.mx0.u = data_read_dag1(op);
-				m_core.my0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xec: case 0xed:
-				// 1110110x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX1 & pgm read to MY0
-				mac_op_mr(op);
-				m_core.mx1.u = data_read_dag1(op);
-				m_core.my0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xee: case 0xef:
-				// 1110111x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX1 & pgm read to MY0
-				alu_op_ar(op);
-				m_core.mx1.u = data_read_dag1(op);
-				m_core.my0.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xf0: case 0xf1:
-				// 1111000x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX0 & pgm read to MY1
-				mac_op_mr(op);
-				m_core.ax0.u = data_read_dag1(op);
-				m_core.my1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xf2: case 0xf3:
-				// 1111001x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX0 & pgm read to MY1
-				alu_op_ar(op);
-				m_core.ax0.u = data_read_dag1(op);
-				m_core.my1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xf4: case 0xf5:
-				// 1111010x xxxxxxxx xxxxxxxx  MAC to MR with data read to AX1 & pgm read to MY1
-				mac_op_mr(op);
-				m_core.ax1.u = data_read_dag1(op);
-				m_core.my1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xf6: case 0xf7:
-				// 1111011x xxxxxxxx xxxxxxxx  ALU to AR with data read to AX1 & pgm read to MY1
-				alu_op_ar(op);
-				m_core.ax1.u = data_read_dag1(op);
-				m_core.my1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xf8: case 0xf9:
-				// 1111100x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX0 & pgm read to MY1
-				mac_op_mr(op);
-				m_core.mx0.u = data_read_dag1(op);
-				m_core.my1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xfa: case 0xfb:
-				// 1111101x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX0 & pgm read to MY1
-				alu_op_ar(op);
-				m_core.mx0.u = data_read_dag1(op);
-				m_core.my1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xfc: case 0xfd:
-				// 1111110x xxxxxxxx xxxxxxxx  MAC to MR with data read to MX1 & pgm read to MY1
-				mac_op_mr(op);
-				m_core.mx1.u = data_read_dag1(op);
-				m_core.my1.u = pgm_read_dag2(op >> 4);
-				break;
-			case 0xfe: case 0xff:
-				// 1111111x xxxxxxxx xxxxxxxx  ALU to AR with data read to MX1 & pgm read to MY1
-				alu_op_ar(op);
-				m_core.mx1.u = data_read_dag1(op);
-				m_core.my1.u = pgm_read_dag2(op >> 4);
-				break;
-		}
+//-------------------------------------------------
+//  drc_loop_end - evaluate the loop condition at
+//  the end of a DO UNTIL loop for the recompiler;
+//  m_pc already holds the following address
+//-------------------------------------------------
 
-		m_icount--;
-	} while (m_icount > 0);
+void adsp21xx_device::drc_loop_end()
+{
+	// condition not met, keep looping
+	if (condition(m_loop_condition))
+		m_pc = pc_stack_top();
+
+	// condition met; pop the PC and loop stacks and fall through
+	else
+	{
+		loop_stack_pop();
+		pc_stack_pop_val();
+	}
+}
+
+
+//-------------------------------------------------
+//  drc_do_until - start a DO UNTIL loop for the
+//  recompiler
+//-------------------------------------------------
+
+void adsp21xx_device::drc_do_until()
+{
+	loop_stack_push(m_drc_op & 0x3ffff);
+	pc_stack_push();
+}
+
+
+//-------------------------------------------------
+//  drc_pc_stack_push - push m_pc for a call made
+//  by recompiled code
+//-------------------------------------------------
+
+void adsp21xx_device::drc_pc_stack_push()
+{
+	pc_stack_push();
 }
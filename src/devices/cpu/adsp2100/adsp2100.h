@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -180,10 +183,15 @@ enum
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+class adsp21xx_frontend;
+
+
 // ======================> adsp21xx_device
 
 class adsp21xx_device : public cpu_device
 {
+	friend class adsp21xx_frontend;
+
 public:
 	virtual ~adsp21xx_device();
 
@@ -198,6 +206,11 @@ public:
 	// Returns base address for circular dag
 	uint32_t get_ibase(int index) { return m_base[index]; }
 
+	// run generated code rather than the interpreter; program memory
+	// written through the address space or by load_boot_data() is
+	// tracked, so drivers that bank-switch it must not use this
+	void enable_recompiler();
+
 protected:
 	enum
 	{
@@ -294,6 +307,57 @@ protected:
 	virtual bool generate_irq(int which, int indx = 0) = 0;
 	virtual void check_irqs() = 0;
 
+	// execution
+	inline void execute_op(uint32_t op);
+	void drc_execute_op();
+	void drc_loop_end();
+	void drc_do_until();
+	void drc_pc_stack_push();
+
+	// recompiler
+	struct compiler_state
+	{
+		uint32_t        cycles;         // accumulated cycles
+		uml::code_label labelnum;       // index for local labels
+		bool            dynamic_next;   // this is a loop end, so m_pc holds the next address
+		bool            check_pc;       // m_pc may not hold the next address after this instruction
+	};
+
+	typedef void (adsp21xx_device::*compute_func)(int op);
+
+	static void cfunc_execute_op(void *param);
+	static void cfunc_loop_end(void *param);
+	static void cfunc_do_until(void *param);
+	static void cfunc_pc_stack_push(void *param);
+	static void cfunc_slow_condition(void *param);
+	template <compute_func Func> static void cfunc_compute(void *param);
+
+	void execute_run_drc();
+	void init_recompiler();
+	void flush_cache();
+	void compile_block(offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param);
+	void generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_loop_end(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_check_pc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_set_next_pc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_condition(drcuml_block &block, compiler_state &compiler, int condition, uml::code_label skip);
+	void generate_generic(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_compute(drcuml_block &block, uint32_t op, uml::c_function func);
+	void generate_read_reg0(drcuml_block &block, int regnum, uml::parameter dst);
+	void generate_write_reg0(drcuml_block &block, int regnum, uml::parameter src);
+	void generate_modify_address(drcuml_block &block, compiler_state &compiler, int ireg, int mreg);
+	void generate_data_read_dag(drcuml_block &block, compiler_state &compiler, int ireg, int mreg, uml::parameter dst);
+	void generate_data_write_dag(drcuml_block &block, compiler_state &compiler, int ireg, int mreg, uml::parameter src);
+	void generate_pgm_read_dag2(drcuml_block &block, compiler_state &compiler, int ireg, int mreg, uml::parameter dst);
+	void generate_pgm_write_dag2(drcuml_block &block, compiler_state &compiler, int ireg, int mreg, uml::parameter src);
+	void generate_code_write_check(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+
 	// internal state
 	static const int PC_STACK_DEPTH     = 16;
 	static const int CNTR_STACK_DEPTH   = 4;
@@ -421,6 +485,20 @@ protected:
 	int                 m_mstat_mask;
 	int                 m_imask_mask;
 
+	// recompiler state
+	bool                m_enable_drc;
+	uint32_t            m_drc_flush;        // compiled code may be stale
+	uint32_t            m_drc_op;           // opcode for C helpers
+	uint32_t            m_drc_cond;         // condition result from C helpers
+	std::unique_ptr<drc_cache> m_drccache;
+	std::unique_ptr<drcuml_state> m_drcuml;
+	std::unique_ptr<adsp21xx_frontend> m_drcfe;
+	uml::code_handle *  m_entry;            // entry point
+	uml::code_handle *  m_nocode;           // nocode exception handler
+	uml::code_handle *  m_out_of_cycles;    // out of cycles exception handler
+	memory_passthrough_handler m_drc_code_tap;
+	uint8_t             m_drc_code[0x4000]; // addresses with compiled code
+
 	// register maps
 	int16_t *             m_read0_ptr[16];
 	uint32_t *            m_read1_ptr[16];
@@ -0,0 +1,974 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    adsp2100drc.cpp
+
+    Universal machine language-based ADSP-21xx emulator.
+
+    Program sequencing (jumps, calls, DO UNTIL loops and the counter
+    test that ends them), condition codes, data register moves and
+    loads, direct memory accesses and the DAG address generators with
+    their modulo addressing are generated as UML.  The ALU, MAC and
+    shifter operations run the interpreter's own implementations through
+    C helpers, as do the remaining, rarer instructions, so the results
+    can't differ from the interpreter, which is still used unless the
+    driver calls enable_recompiler().
+
+    The core's state lives in the device rather than in memory allocated
+    near the cache, so generated code reaches it through LOAD and STORE
+    with fixed bases rather than direct memory operands.
+
+    Like the interpreter, interrupts are only taken at the start of a
+    timeslice or when a register write unmasks them.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "adsp2100.h"
+#include "adsp2100fe.h"
+
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+#include "cpu/drcumlsh.h"
+
+
+namespace {
+
+// size of the code cache
+constexpr u32 CACHE_SIZE                = 2 * 1024 * 1024;
+
+// compilation boundaries -- how far back/forward does the analysis extend?
+constexpr u32 COMPILE_BACKWARDS_BYTES   = 64;
+constexpr u32 COMPILE_FORWARDS_BYTES    = 512;
+constexpr u32 COMPILE_MAX_INSTRUCTIONS  = (COMPILE_BACKWARDS_BYTES + COMPILE_FORWARDS_BYTES) / 4;
+constexpr u32 COMPILE_MAX_SEQUENCE      = 64;
+
+// exit codes
+constexpr int EXECUTE_OUT_OF_CYCLES     = 0;
+constexpr int EXECUTE_MISSING_CODE      = 1;
+constexpr int EXECUTE_UNMAPPED_CODE     = 2;
+constexpr int EXECUTE_RESET_CACHE       = 3;
+
+// MSTAT bit selecting bit-reversed DAG1 addresses
+constexpr u32 MSTAT_REVERSE             = 0x02;
+
+} // anonymous namespace
+
+
+// map variables
+#define MAPVAR_PC                       uml::M0
+#define MAPVAR_CYCLES                   uml::M1
+
+
+
+/***************************************************************************
+    C HELPERS
+***************************************************************************/
+
+void adsp21xx_device::cfunc_execute_op(void *param)
+{
+	reinterpret_cast<adsp21xx_device *>(param)->drc_execute_op();
+}
+
+void adsp21xx_device::cfunc_loop_end(void *param)
+{
+	reinterpret_cast<adsp21xx_device *>(param)->drc_loop_end();
+}
+
+void adsp21xx_device::cfunc_do_until(void *param)
+{
+	reinterpret_cast<adsp21xx_device *>(param)->drc_do_until();
+}
+
+void adsp21xx_device::cfunc_pc_stack_push(void *param)
+{
+	reinterpret_cast<adsp21xx_device *>(param)->drc_pc_stack_push();
+}
+
+void adsp21xx_device::cfunc_slow_condition(void *param)
+{
+	adsp21xx_device &adsp = *reinterpret_cast<adsp21xx_device *>(param);
+	adsp.m_drc_cond = adsp.slow_condition();
+}
+
+template <adsp21xx_device::compute_func Func>
+void adsp21xx_device::cfunc_compute(void *param)
+{
+	adsp21xx_device &adsp = *reinterpret_cast<adsp21xx_device *>(param);
+	(adsp.*Func)(adsp.m_drc_op);
+}
+
+
+
+/***************************************************************************
+    CORE EXECUTION
+***************************************************************************/
+
+//-------------------------------------------------
+//  init_recompiler - set up the recompiler the
+//  first time it's used
+//-------------------------------------------------
+
+void adsp21xx_device::init_recompiler()
+{
+	m_drccache = std::make_unique<drc_cache>(CACHE_SIZE);
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_drccache, 0, 1, 14, 0);
+
+	// add UML symbols
+	m_drcuml->symbol_add(&m_pc, sizeof(m_pc), "pc");
+	m_drcuml->symbol_add(&m_icount, sizeof(m_icount), "icount");
+	m_drcuml->symbol_add(&m_astat, sizeof(m_astat), "astat");
+	m_drcuml->symbol_add(&m_mstat, sizeof(m_mstat), "mstat");
+	m_drcuml->symbol_add(&m_cntr, sizeof(m_cntr), "cntr");
+	for (int i = 0; i < 8; i++)
+	{
+		m_drcuml->symbol_add(&m_i[i], sizeof(m_i[i]), util::string_format("i%d", i).c_str());
+		m_drcuml->symbol_add(&m_m[i], sizeof(m_m[i]), util::string_format("m%d", i).c_str());
+		m_drcuml->symbol_add(&m_l[i], sizeof(m_l[i]), util::string_format("l%d", i).c_str());
+	}
+
+	m_drcfe = std::make_unique<adsp21xx_frontend>(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE);
+
+	// compiled code goes stale when it's overwritten
+	std::fill(std::begin(m_drc_code), std::end(m_drc_code), 0);
+	m_drc_code_tap = space(AS_PROGRAM).install_write_tap(
+			0, 0x3fff,
+			"adsp_drc_code_w",
+			[this] (offs_t offset, u32 &data, u32 mem_mask)
+			{
+				if (m_drc_code[offset & 0x3fff])
+					m_drc_flush = 1;
+			},
+			&m_drc_code_tap);
+
+	m_drc_flush = 1;
+}
+
+
+//-------------------------------------------------
+//  execute_run_drc - execute generated code until
+//  the timeslice runs out
+//-------------------------------------------------
+
+void adsp21xx_device::execute_run_drc()
+{
+	if (!m_drcuml)
+		init_recompiler();
+
+	// loops that were started elsewhere need their ends checked too
+	for (int i = 0; i < m_loop_sp; i++)
+		m_drcfe->add_loop_end(m_loop_stack[i] >> 4);
+
+	// reset the cache if dirty
+	if (m_drc_flush)
+		flush_cache();
+
+	// execute
+	int execute_result;
+	do
+	{
+		execute_result = m_drcuml->execute(*m_entry);
+
+		// if we need to recompile, do it
+		if (execute_result == EXECUTE_MISSING_CODE)
+			compile_block(m_pc);
+		else if (execute_result == EXECUTE_UNMAPPED_CODE)
+			fatalerror("Attempted to execute unmapped code at PC=%04X\n", m_pc);
+		else if (execute_result == EXECUTE_RESET_CACHE)
+			flush_cache();
+	} while (execute_result != EXECUTE_OUT_OF_CYCLES);
+}
+
+
+//-------------------------------------------------
+//  flush_cache - throw away all generated code
+//  and regenerate the static handlers
+//-------------------------------------------------
+
+void adsp21xx_device::flush_cache()
+{
+	// empty the transient cache contents
+	m_drcuml->reset();
+	std::fill(std::begin(m_drc_code), std::end(m_drc_code), 0);
+	m_drc_flush = 0;
+
+	try
+	{
+		// generate the entry point and exception handlers
+		static_generate_entry_point();
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Error generating ADSP-21xx static handlers\n");
+	}
+}
+
+
+//-------------------------------------------------
+//  compile_block - compile a block of code
+//  starting at the given PC
+//-------------------------------------------------
+
+void adsp21xx_device::compile_block(offs_t pc)
+{
+	// describe the block; a loop end found for the first time may have
+	// been compiled already without its check
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+	if (m_drc_flush)
+		flush_cache();
+
+	bool override = false;
+	for (;;)
+	{
+		try
+		{
+			compiler_state compiler = { 0, 1, false, false };
+			const opcode_desc *seqlast;
+
+			drcuml_block &block(m_drcuml->begin_block(COMPILE_MAX_INSTRUCTIONS * 64));
+
+			for (const opcode_desc *seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				// determine the last instruction in this sequence
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				// if we don't have a hash for this mode/pc, or if we are overriding all, add one
+				if (override || !m_drcuml->hash_exists(0, seqhead->pc))
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,seqhead->pc
+
+				// if we already have a hash, and this is the first sequence, assume that we
+				// are recompiling due to being out of sync and allow future overrides
+				else if (seqhead == desclist)
+				{
+					override = true;
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,seqhead->pc
+				}
+
+				// otherwise, redispatch to that fixed PC and skip the rest of the processing
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc
+					UML_HASHJMP(block, 0, seqhead->pc, *m_nocode);                          // hashjmp 0,seqhead->pc,nocode
+					continue;
+				}
+
+				// label this instruction, if it may be jumped to locally
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc
+
+				// iterate over instructions in the sequence and compile them
+				for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, compiler, curdesc);
+
+				// count off cycles and go to the next instruction
+				uint32_t const nextpc = (seqlast->pc + 1) & 0x3fff;
+				generate_update_cycles(block, compiler, nextpc);                            // <subtract cycles>
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, 0, nextpc, *m_nocode);                               // hashjmp 0,nextpc,nocode
+			}
+
+			block.end();
+			break;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			flush_cache();
+		}
+	}
+
+	// note what was compiled so writes to it can be caught
+	for (const opcode_desc *curdesc = desclist; curdesc != nullptr; curdesc = curdesc->next())
+		m_drc_code[curdesc->pc & 0x3fff] = 1;
+}
+
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+//-------------------------------------------------
+//  static_generate_entry_point - generate a
+//  static entry point
+//-------------------------------------------------
+
+void adsp21xx_device::static_generate_entry_point()
+{
+	drcuml_block &block(m_drcuml->begin_block(20));
+
+	// forward references
+	if (!m_nocode)
+		m_nocode = m_drcuml->handle_alloc("nocode");
+
+	if (!m_entry)
+		m_entry = m_drcuml->handle_alloc("entry");
+	UML_HANDLE(block, *m_entry);                                                            // handle  entry
+
+	// generate a hash jump via the current PC
+	UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[pc]
+	UML_HASHJMP(block, 0, I0, *m_nocode);                                                   // hashjmp 0,i0,nocode
+
+	block.end();
+}
+
+
+//-------------------------------------------------
+//  static_generate_nocode_handler - generate an
+//  exception handler for "out of code"
+//-------------------------------------------------
+
+void adsp21xx_device::static_generate_nocode_handler()
+{
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	UML_HANDLE(block, *m_nocode);                                                           // handle  nocode
+	UML_GETEXP(block, I0);                                                                  // getexp  i0
+	UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x1);                                   // store   [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                                  // exit    EXECUTE_MISSING_CODE
+
+	block.end();
+}
+
+
+//-------------------------------------------------
+//  static_generate_out_of_cycles - generate an
+//  out of cycles exception handler
+//-------------------------------------------------
+
+void adsp21xx_device::static_generate_out_of_cycles()
+{
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	if (!m_out_of_cycles)
+		m_out_of_cycles = m_drcuml->handle_alloc("out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                                    // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                                  // getexp  i0
+	UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x1);                                   // store   [pc],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                                 // exit    EXECUTE_OUT_OF_CYCLES
+
+	block.end();
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+//-------------------------------------------------
+//  generate_sequence_instruction - generate code
+//  for a single instruction in a sequence
+//-------------------------------------------------
+
+void adsp21xx_device::generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	// set the PC map variable
+	UML_MAPVAR(block, MAPVAR_PC, desc->pc);                                                 // mapvar  PC,desc->pc
+
+	// accumulate total cycles
+	compiler.cycles += desc->cycles;
+
+	// update the icount map variable
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                                      // mapvar  CYCLES,compiler.cycles
+
+	// if we are debugging, call the debugger
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x1);                         // store   [pc],desc->pc
+		UML_STORE(block, &m_ppc, 0, desc->pc, SIZE_DWORD, SCALE_x1);                        // store   [ppc],desc->pc
+		UML_DEBUG(block, desc->pc);                                                         // debug   desc->pc
+	}
+
+	// if we hit an unmapped address, fatal error
+	if (desc->flags & OPFLAG_COMPILER_UNMAPPED)
+	{
+		UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x1);                         // store   [pc],desc->pc
+		UML_EXIT(block, EXECUTE_UNMAPPED_CODE);                                             // exit    EXECUTE_UNMAPPED_CODE
+		return;
+	}
+
+	// the last instruction of a loop works out where to go before it runs
+	compiler.dynamic_next = m_drcfe->is_loop_end(desc->pc);
+	compiler.check_pc = compiler.dynamic_next;
+	if (compiler.dynamic_next)
+		generate_loop_end(block, compiler, desc);
+
+	// compile the instruction, running anything not handled through the interpreter
+	if (!generate_opcode(block, compiler, desc))
+		generate_generic(block, compiler, desc);
+
+	// code may have been overwritten
+	if (desc->flags & OPFLAG_WRITES_MEMORY)
+		generate_code_write_check(block, compiler, desc);
+
+	// leave if we're not going to the next instruction
+	if (compiler.check_pc)
+		generate_check_pc(block, compiler, desc);
+}
+
+
+//-------------------------------------------------
+//  generate_update_cycles - generate code to
+//  subtract cycles from the icount and generate
+//  an exception if out
+//-------------------------------------------------
+
+void adsp21xx_device::generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param)
+{
+	// account for cycles; like the interpreter, stop once the count isn't positive
+	if (compiler.cycles > 0)
+	{
+		UML_LOAD(block, I1, &m_icount, 0, SIZE_DWORD, SCALE_x1);                            // load    i1,[icount]
+		UML_SUB(block, I1, I1, MAPVAR_CYCLES);                                              // sub     i1,i1,cycles
+		UML_STORE(block, &m_icount, 0, I1, SIZE_DWORD, SCALE_x1);                           // store   [icount],i1
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                                // mapvar  cycles,0
+		UML_CMP(block, I1, 0);                                                              // cmp     i1,0
+		UML_EXHc(block, COND_LE, *m_out_of_cycles, param);                                  // exh     out_of_cycles,param
+	}
+	compiler.cycles = 0;
+}
+
+
+//-------------------------------------------------
+//  generate_branch - generate code to go to the
+//  target of an immediate jump or call
+//-------------------------------------------------
+
+void adsp21xx_device::generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	// the taken path accounts for its cycles separately from the fall through
+	compiler_state compiler_temp(compiler);
+	generate_update_cycles(block, compiler_temp, desc->targetpc);                           // <subtract cycles>
+
+	if (desc->flags & OPFLAG_INTRABLOCK_BRANCH)
+		UML_JMP(block, desc->targetpc | 0x80000000);                                        // jmp     targetpc | 0x80000000
+	else
+		UML_HASHJMP(block, 0, desc->targetpc, *m_nocode);                                   // hashjmp 0,targetpc,nocode
+}
+
+
+//-------------------------------------------------
+//  generate_loop_end - generate the DO UNTIL check
+//  for an instruction that ends a loop, leaving
+//  the next address in m_pc
+//-------------------------------------------------
+
+void adsp21xx_device::generate_loop_end(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uml::code_label const done = compiler.labelnum++;
+	uml::code_label const slow = compiler.labelnum++;
+
+	UML_STORE(block, &m_pc, 0, (desc->pc + 1) & 0x3fff, SIZE_DWORD, SCALE_x1);             // store   [pc],desc->pc + 1
+	UML_LOAD(block, I0, &m_loop, 0, SIZE_DWORD, SCALE_x1);                                   // load    i0,[loop]
+	UML_CMP(block, I0, desc->pc);                                                           // cmp     i0,desc->pc
+	UML_JMPc(block, COND_NE, done);                                                         // jne     done
+
+	// the usual counter test is done here while the count has further to go
+	UML_LOAD(block, I0, &m_loop_condition, 0, SIZE_DWORD, SCALE_x1);                        // load    i0,[loop_condition]
+	UML_CMP(block, I0, 14);                                                                 // cmp     i0,14
+	UML_JMPc(block, COND_NE, slow);                                                         // jne     slow
+	UML_LOAD(block, I0, &m_cntr, 0, SIZE_DWORD, SCALE_x1);                                  // load    i0,[cntr]
+	UML_CMP(block, I0, 1);                                                                  // cmp     i0,1
+	UML_JMPc(block, COND_LE, slow);                                                         // jle     slow
+	UML_LOAD(block, I1, &m_pc_sp, 0, SIZE_DWORD, SCALE_x1);                                 // load    i1,[pc_sp]
+	UML_CMP(block, I1, 0);                                                                  // cmp     i1,0
+	UML_JMPc(block, COND_LE, slow);                                                         // jle     slow
+	UML_SUB(block, I0, I0, 1);                                                              // sub     i0,i0,1
+	UML_STORE(block, &m_cntr, 0, I0, SIZE_DWORD, SCALE_x1);                                 // store   [cntr],i0
+	UML_SUB(block, I1, I1, 1);                                                              // sub     i1,i1,1
+	UML_LOAD(block, I0, m_pc_stack, I1, SIZE_DWORD, SCALE_x4);                              // load    i0,pc_stack,i1
+	UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x1);                                   // store   [pc],i0
+	UML_JMP(block, done);                                                                   // jmp     done
+
+	// other conditions, and the end of the count, go through the interpreter's rules
+	UML_LABEL(block, slow);                                                                 // slow:
+	UML_CALLC(block, cfunc_loop_end, this);                                                 // callc   cfunc_loop_end,this
+
+	UML_LABEL(block, done);                                                                 // done:
+}
+
+
+//-------------------------------------------------
+//  generate_check_pc - generate code to leave the
+//  block if m_pc isn't the next instruction
+//-------------------------------------------------
+
+void adsp21xx_device::generate_check_pc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uml::code_label const skip = compiler.labelnum++;
+
+	UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[pc]
+	UML_CMP(block, I0, (desc->pc + 1) & 0x3fff);                                            // cmp     i0,desc->pc + 1
+	UML_JMPc(block, COND_E, skip);                                                          // je      skip
+
+	compiler_state compiler_temp(compiler);
+	generate_update_cycles(block, compiler_temp, uml::I0);                                     // <subtract cycles>
+	UML_HASHJMP(block, 0, I0, *m_nocode);                                                   // hashjmp 0,i0,nocode
+
+	UML_LABEL(block, skip);                                                                 // skip:
+}
+
+
+//-------------------------------------------------
+//  generate_set_next_pc - make sure m_pc holds the
+//  address of the next instruction for helpers
+//-------------------------------------------------
+
+void adsp21xx_device::generate_set_next_pc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	// at the end of a loop it's already been worked out
+	if (!compiler.dynamic_next)
+		UML_STORE(block, &m_pc, 0, (desc->pc + 1) & 0x3fff, SIZE_DWORD, SCALE_x1);         // store   [pc],desc->pc + 1
+}
+
+
+//-------------------------------------------------
+//  generate_condition - generate code to skip to
+//  the given label if a condition isn't met
+//-------------------------------------------------
+
+void adsp21xx_device::generate_condition(drcuml_block &block, compiler_state &compiler, int condition, uml::code_label skip)
+{
+	// always
+	if (condition == 15)
+		return;
+
+	// counter expired has side effects on the counter stack
+	if (condition == 14)
+	{
+		UML_CALLC(block, cfunc_slow_condition, this);                                       // callc   cfunc_slow_condition,this
+		UML_LOAD(block, I0, &m_drc_cond, 0, SIZE_DWORD, SCALE_x1);                          // load    i0,[drc_cond]
+	}
+	else
+	{
+		UML_LOAD(block, I0, &m_astat, 0, SIZE_DWORD, SCALE_x1);                             // load    i0,[astat]
+		UML_LOAD(block, I0, &m_condition_table[condition << 8], I0, SIZE_BYTE, SCALE_x1);   // load    i0,condition_table,i0
+	}
+	UML_CMP(block, I0, 0);                                                                  // cmp     i0,0
+	UML_JMPc(block, COND_E, skip);                                                          // je      skip
+}
+
+
+//-------------------------------------------------
+//  generate_generic - generate code to run an
+//  instruction through the interpreter
+//-------------------------------------------------
+
+void adsp21xx_device::generate_generic(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	UML_STORE(block, &m_ppc, 0, desc->pc, SIZE_DWORD, SCALE_x1);                            // store   [ppc],desc->pc
+	generate_set_next_pc(block, compiler, desc);
+	UML_STORE(block, &m_drc_op, 0, desc->opptr.l[0], SIZE_DWORD, SCALE_x1);                 // store   [drc_op],op
+	UML_CALLC(block, cfunc_execute_op, this);                                               // callc   cfunc_execute_op,this
+
+	// it may have jumped, returned, or taken an interrupt
+	compiler.check_pc = true;
+}
+
+
+//-------------------------------------------------
+//  generate_compute - generate a call to one of
+//  the interpreter's ALU, MAC or shifter operations
+//-------------------------------------------------
+
+void adsp21xx_device::generate_compute(drcuml_block &block, uint32_t op, uml::c_function func)
+{
+	UML_STORE(block, &m_drc_op, 0, op, SIZE_DWORD, SCALE_x1);                               // store   [drc_op],op
+	UML_CALLC(block, func, this);                                                           // callc   func,this
+}
+
+
+//-------------------------------------------------
+//  generate_read_reg0 - generate code to read a
+//  group 0 (data) register, sign extended
+//-------------------------------------------------
+
+void adsp21xx_device::generate_read_reg0(drcuml_block &block, int regnum, uml::parameter dst)
+{
+	UML_LOADS(block, dst, m_read0_ptr[regnum], 0, SIZE_WORD, SCALE_x1);                     // loads   dst,[reg]
+}
+
+
+//-------------------------------------------------
+//  generate_write_reg0 - generate code to write a
+//  group 0 (data) register; uses I3
+//-------------------------------------------------
+
+void adsp21xx_device::generate_write_reg0(drcuml_block &block, int regnum, uml::parameter src)
+{
+	switch (regnum)
+	{
+		case 0x09:
+			// SE is only eight bits
+			UML_SEXT(block, I3, src, SIZE_BYTE);                                            // sext    i3,src,byte
+			UML_STORE(block, &m_core.se.s, 0, I3, SIZE_WORD, SCALE_x1);                     // store   [se],i3
+			break;
+
+		case 0x0c:
+			// MR1 also sign extends into MR2
+			UML_STORE(block, &m_core.mr.mrx.mr1.s, 0, src, SIZE_WORD, SCALE_x1);            // store   [mr1],src
+			UML_SEXT(block, I3, src, SIZE_WORD);                                            // sext    i3,src,word
+			UML_SAR(block, I3, I3, 15);                                                     // sar     i3,i3,15
+			UML_STORE(block, &m_core.mr.mrx.mr2.s, 0, I3, SIZE_WORD, SCALE_x1);             // store   [mr2],i3
+			break;
+
+		case 0x0d:
+			// MR2 is only eight bits
+			UML_SEXT(block, I3, src, SIZE_BYTE);                                            // sext    i3,src,byte
+			UML_STORE(block, &m_core.mr.mrx.mr2.s, 0, I3, SIZE_WORD, SCALE_x1);             // store   [mr2],i3
+			break;
+
+		default:
+			UML_STORE(block, m_read0_ptr[regnum], 0, src, SIZE_WORD, SCALE_x1);             // store   [reg],src
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  generate_modify_address - generate code to
+//  post-modify an index register with modulo
+//  addressing; uses I1-I3
+//-------------------------------------------------
+
+void adsp21xx_device::generate_modify_address(drcuml_block &block, compiler_state &compiler, int ireg, int mreg)
+{
+	uml::code_label const below = compiler.labelnum++;
+	uml::code_label const done = compiler.labelnum++;
+
+	UML_LOAD(block, I1, &m_i[ireg], 0, SIZE_DWORD, SCALE_x1);                               // load    i1,[i]
+	UML_LOAD(block, I2, &m_m[mreg], 0, SIZE_DWORD, SCALE_x1);                               // load    i2,[m]
+	UML_ADD(block, I1, I1, I2);                                                             // add     i1,i1,i2
+	UML_AND(block, I1, I1, 0x3fff);                                                         // and     i1,i1,0x3fff
+	UML_LOAD(block, I2, &m_base[ireg], 0, SIZE_DWORD, SCALE_x1);                            // load    i2,[base]
+	UML_LOAD(block, I3, &m_l[ireg], 0, SIZE_DWORD, SCALE_x1);                               // load    i3,[l]
+	UML_CMP(block, I1, I2);                                                                 // cmp     i1,i2
+	UML_JMPc(block, COND_B, below);                                                         // jb      below
+	UML_ADD(block, I2, I2, I3);                                                             // add     i2,i2,i3
+	UML_CMP(block, I1, I2);                                                                 // cmp     i1,i2
+	UML_JMPc(block, COND_B, done);                                                          // jb      done
+	UML_SUB(block, I1, I1, I3);                                                             // sub     i1,i1,i3
+	UML_JMP(block, done);                                                                   // jmp     done
+
+	UML_LABEL(block, below);                                                                // below:
+	UML_ADD(block, I1, I1, I3);                                                             // add     i1,i1,i3
+
+	UML_LABEL(block, done);                                                                 // done:
+	UML_STORE(block, &m_i[ireg], 0, I1, SIZE_DWORD, SCALE_x1);                              // store   [i],i1
+}
+
+
+//-------------------------------------------------
+//  generate_data_read_dag - generate code to read
+//  data memory through a DAG and post-modify the
+//  index register
+//-------------------------------------------------
+
+void adsp21xx_device::generate_data_read_dag(drcuml_block &block, compiler_state &compiler, int ireg, int mreg, uml::parameter dst)
+{
+	UML_LOAD(block, I1, &m_i[ireg], 0, SIZE_DWORD, SCALE_x1);                               // load    i1,[i]
+
+	// DAG1 can bit reverse addresses
+	if (ireg < 4)
+	{
+		uml::code_label const skip = compiler.labelnum++;
+		UML_LOAD(block, I2, &m_mstat, 0, SIZE_DWORD, SCALE_x1);                             // load    i2,[mstat]
+		UML_TEST(block, I2, MSTAT_REVERSE);                                                 // test    i2,MSTAT_REVERSE
+		UML_JMPc(block, COND_Z, skip);                                                      // jz      skip
+		UML_AND(block, I2, I1, 0x3fff);                                                     // and     i2,i1,0x3fff
+		UML_LOAD(block, I1, m_reverse_table, I2, SIZE_WORD, SCALE_x2);                      // load    i1,reverse_table,i2
+		UML_LABEL(block, skip);                                                             // skip:
+	}
+
+	UML_READ(block, dst, I1, SIZE_WORD, SPACE_DATA);                                        // read    dst,i1,word,data
+	generate_modify_address(block, compiler, ireg, mreg);
+}
+
+
+//-------------------------------------------------
+//  generate_data_write_dag - generate code to
+//  write data memory through a DAG and post-modify
+//  the index register
+//-------------------------------------------------
+
+void adsp21xx_device::generate_data_write_dag(drcuml_block &block, compiler_state &compiler, int ireg, int mreg, uml::parameter src)
+{
+	UML_LOAD(block, I1, &m_i[ireg], 0, SIZE_DWORD, SCALE_x1);                               // load    i1,[i]
+
+	// DAG1 can bit reverse addresses
+	if (ireg < 4)
+	{
+		uml::code_label const skip = compiler.labelnum++;
+		UML_LOAD(block, I2, &m_mstat, 0, SIZE_DWORD, SCALE_x1);                             // load    i2,[mstat]
+		UML_TEST(block, I2, MSTAT_REVERSE);                                                 // test    i2,MSTAT_REVERSE
+		UML_JMPc(block, COND_Z, skip);                                                      // jz      skip
+		UML_AND(block, I2, I1, 0x3fff);                                                     // and     i2,i1,0x3fff
+		UML_LOAD(block, I1, m_reverse_table, I2, SIZE_WORD, SCALE_x2);                      // load    i1,reverse_table,i2
+		UML_LABEL(block, skip);                                                             // skip:
+	}
+
+	UML_WRITE(block, I1, src, SIZE_WORD, SPACE_DATA);                                       // write   i1,src,word,data
+	generate_modify_address(block, compiler, ireg, mreg);
+}
+
+
+//-------------------------------------------------
+//  generate_pgm_read_dag2 - generate code to read
+//  program memory through DAG2, leaving the upper
+//  16 bits in dst and the low byte in PX
+//-------------------------------------------------
+
+void adsp21xx_device::generate_pgm_read_dag2(drcuml_block &block, compiler_state &compiler, int ireg, int mreg, uml::parameter dst)
+{
+	UML_LOAD(block, I1, &m_i[ireg], 0, SIZE_DWORD, SCALE_x1);                               // load    i1,[i]
+	UML_READ(block, dst, I1, SIZE_DWORD, SPACE_PROGRAM);                                    // read    dst,i1,dword,program
+	UML_STORE(block, &m_px, 0, dst, SIZE_BYTE, SCALE_x1);                                   // store   [px],dst
+	UML_SHR(block, dst, dst, 8);                                                            // shr     dst,dst,8
+	generate_modify_address(block, compiler, ireg, mreg);
+}
+
+
+//-------------------------------------------------
+//  generate_pgm_write_dag2 - generate code to
+//  write a register and PX to program memory
+//  through DAG2
+//-------------------------------------------------
+
+void adsp21xx_device::generate_pgm_write_dag2(drcuml_block &block, compiler_state &compiler, int ireg, int mreg, uml::parameter src)
+{
+	UML_LOAD(block, I2, &m_px, 0, SIZE_BYTE, SCALE_x1);                                     // load    i2,[px]
+	UML_SHL(block, I1, src, 8);                                                             // shl     i1,src,8
+	UML_OR(block, I1, I1, I2);                                                              // or      i1,i1,i2
+	UML_AND(block, I2, I1, 0xffffff);                                                       // and     i2,i1,0xffffff
+	UML_LOAD(block, I1, &m_i[ireg], 0, SIZE_DWORD, SCALE_x1);                               // load    i1,[i]
+	UML_WRITE(block, I1, I2, SIZE_DWORD, SPACE_PROGRAM);                                    // write   i1,i2,dword,program
+	generate_modify_address(block, compiler, ireg, mreg);
+}
+
+
+//-------------------------------------------------
+//  generate_code_write_check - generate code to
+//  leave the block if compiled code was overwritten
+//-------------------------------------------------
+
+void adsp21xx_device::generate_code_write_check(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uml::code_label const skip = compiler.labelnum++;
+
+	UML_LOAD(block, I1, &m_drc_flush, 0, SIZE_DWORD, SCALE_x1);                             // load    i1,[drc_flush]
+	UML_CMP(block, I1, 0);                                                                  // cmp     i1,0
+	UML_JMPc(block, COND_E, skip);                                                          // je      skip
+
+	// account for the cycles so far and have the cache flushed before going on
+	generate_set_next_pc(block, compiler, desc);
+	if (compiler.cycles > 0)
+	{
+		UML_LOAD(block, I1, &m_icount, 0, SIZE_DWORD, SCALE_x1);                            // load    i1,[icount]
+		UML_SUB(block, I1, I1, compiler.cycles);                                            // sub     i1,i1,cycles
+		UML_STORE(block, &m_icount, 0, I1, SIZE_DWORD, SCALE_x1);                           // store   [icount],i1
+	}
+	UML_EXIT(block, EXECUTE_RESET_CACHE);                                                   // exit    EXECUTE_RESET_CACHE
+
+	UML_LABEL(block, skip);                                                                 // skip:
+}
+
+
+//-------------------------------------------------
+//  generate_opcode - generate code for a specific
+//  opcode; returns false if the interpreter
+//  should run it instead
+//-------------------------------------------------
+
+bool adsp21xx_device::generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	// ALU/MAC operations selected by bits 17-18 of the multifunction instructions
+	static const uml::c_function s_compute[4] =
+	{
+		&cfunc_compute<&adsp21xx_device::mac_op_mr>,
+		&cfunc_compute<&adsp21xx_device::alu_op_ar>,
+		&cfunc_compute<&adsp21xx_device::mac_op_mf>,
+		&cfunc_compute<&adsp21xx_device::alu_op_af>
+	};
+
+	uint32_t const op = desc->opptr.l[0];
+	bool const is_2181 = m_chip_type >= CHIP_TYPE_ADSP2181;
+
+	switch ((op >> 16) & 0xff)
+	{
+		case 0x00:
+			// 00000000 00000000 00000000  NOP
+		case 0x08:
+			// 00001000 00000000 0000xxxx  reserved
+			return true;
+
+		case 0x09:
+			// 00001001 00000000 000xxxxx  modify address register
+			{
+				int const dag = (op >> 2) & 4;
+				generate_modify_address(block, compiler, dag + ((op >> 2) & 3), dag + (op & 3));
+			}
+			return true;
+
+		case 0x0d:
+			// 00001101 0000xxxx xxxxxxxx  internal data move
+			// only moves between data registers are done here
+			if (((op >> 8) & 15) != 0)
+				return false;
+			generate_read_reg0(block, op & 15, uml::I0);
+			generate_write_reg0(block, (op >> 4) & 15, uml::I0);
+			return true;
+
+		case 0x14: case 0x15: case 0x16: case 0x17:
+			// 000101xx xxxxxxxx xxxxxxxx  do until
+			generate_set_next_pc(block, compiler, desc);
+			UML_STORE(block, &m_drc_op, 0, op, SIZE_DWORD, SCALE_x1);                       // store   [drc_op],op
+			UML_CALLC(block, cfunc_do_until, this);                                         // callc   cfunc_do_until,this
+			return true;
+
+		case 0x18: case 0x19: case 0x1a: case 0x1b:
+			// 000110xx xxxxxxxx xxxxxxxx  conditional jump (immediate addr)
+			{
+				uml::code_label const skip = compiler.labelnum++;
+				generate_condition(block, compiler, op & 15, skip);
+
+				// check for a busy loop
+				if (desc->targetpc == desc->pc)
+					UML_STORE(block, &m_icount, 0, 0, SIZE_DWORD, SCALE_x1);                // store   [icount],0
+				generate_branch(block, compiler, desc);
+				UML_LABEL(block, skip);                                                     // skip:
+			}
+			return true;
+
+		case 0x1c: case 0x1d: case 0x1e: case 0x1f:
+			// 000111xx xxxxxxxx xxxxxxxx  conditional call (immediate addr)
+			{
+				uml::code_label const skip = compiler.labelnum++;
+				generate_condition(block, compiler, op & 15, skip);
+				generate_set_next_pc(block, compiler, desc);
+				UML_CALLC(block, cfunc_pc_stack_push, this);                                // callc   cfunc_pc_stack_push,this
+				generate_branch(block, compiler, desc);
+				UML_LABEL(block, skip);                                                     // skip:
+			}
+			return true;
+
+		case 0x20: case 0x21: case 0x22: case 0x23: case 0x24: case 0x25: case 0x26: case 0x27:
+			// 00100xxx xxxxxxxx xxxxxxxx  conditional ALU/MAC
+			{
+				uml::code_label const skip = compiler.labelnum++;
+				int const kind = (op >> 17) & 3;
+				uml::c_function func = s_compute[kind];
+				if (is_2181)
+				{
+					if ((kind == 0) && ((op & 0x0018f0) == 0x000010))
+						func = &cfunc_compute<&adsp21xx_device::mac_op_mr_xop>;
+					else if ((kind == 1) && (op & 0x000010))
+						func = &cfunc_compute<&adsp21xx_device::alu_op_ar_const>;
+					else if ((kind == 2) && ((op & 0x0018f0) == 0x000010))
+						func = &cfunc_compute<&adsp21xx_device::mac_op_mf_xop>;
+					else if ((kind == 3) && (op & 0x000010))
+						func = &cfunc_compute<&adsp21xx_device::alu_op_af_const>;
+				}
+				generate_condition(block, compiler, op & 15, skip);
+				generate_compute(block, op, func);
+				UML_LABEL(block, skip);                                                     // skip:
+			}
+			return true;
+
+		case 0x30: case 0x31: case 0x32: case 0x33:
+			// 001100xx xxxxxxxx xxxxxxxx  load non-data register immediate (group 0)
+			UML_MOV(block, I0, (int32_t)(op << 14) >> 18);                                  // mov     i0,imm
+			generate_write_reg0(block, op & 15, uml::I0);
+			return true;
+
+		case 0x40: case 0x41: case 0x42: case 0x43: case 0x44: case 0x45: case 0x46: case 0x47:
+		case 0x48: case 0x49: case 0x4a: case 0x4b: case 0x4c: case 0x4d: case 0x4e: case 0x4f:
+			// 0100xxxx xxxxxxxx xxxxxxxx  load data register immediate
+			UML_MOV(block, I0, (op >> 4) & 0xffff);                                         // mov     i0,imm
+			generate_write_reg0(block, op & 15, uml::I0);
+			return true;
+
+		case 0x50: case 0x51: case 0x52: case 0x53: case 0x54: case 0x55: case 0x56: case 0x57:
+			// 01010xxx xxxxxxxx xxxxxxxx  ALU/MAC with pgm memory read
+			generate_compute(block, op, s_compute[(op >> 17) & 3]);
+			generate_pgm_read_dag2(block, compiler, 4 + ((op >> 2) & 3), 4 + (op & 3), uml::I0);
+			generate_write_reg0(block, (op >> 4) & 15, uml::I0);
+			return true;
+
+		case 0x58: case 0x59: case 0x5a: case 0x5b: case 0x5c: case 0x5d: case 0x5e: case 0x5f:
+			// 01011xxx xxxxxxxx xxxxxxxx  ALU/MAC with pgm memory write
+			generate_read_reg0(block, (op >> 4) & 15, uml::I0);
+			generate_pgm_write_dag2(block, compiler, 4 + ((op >> 2) & 3), 4 + (op & 3), uml::I0);
+			generate_compute(block, op, s_compute[(op >> 17) & 3]);
+			return true;
+
+		case 0x60: case 0x61: case 0x62: case 0x63: case 0x64: case 0x65: case 0x66: case 0x67:
+		case 0x70: case 0x71: case 0x72: case 0x73: case 0x74: case 0x75: case 0x76: case 0x77:
+			// 011x0xxx xxxxxxxx xxxxxxxx  ALU/MAC with data memory read DAG1/DAG2
+			{
+				int const dag = (op >> 18) & 4;
+				generate_compute(block, op, s_compute[(op >> 17) & 3]);
+				generate_data_read_dag(block, compiler, dag + ((op >> 2) & 3), dag + (op & 3), uml::I0);
+				generate_write_reg0(block, (op >> 4) & 15, uml::I0);
+			}
+			return true;
+
+		case 0x68: case 0x69: case 0x6a: case 0x6b: case 0x6c: case 0x6d: case 0x6e: case 0x6f:
+		case 0x78: case 0x79: case 0x7a: case 0x7b: case 0x7c: case 0x7d: case 0x7e: case 0x7f:
+			// 011x1xxx xxxxxxxx xxxxxxxx  ALU/MAC with data memory write DAG1/DAG2
+			{
+				int const dag = (op >> 18) & 4;
+				generate_read_reg0(block, (op >> 4) & 15, uml::I0);
+				generate_data_write_dag(block, compiler, dag + ((op >> 2) & 3), dag + (op & 3), uml::I0);
+				generate_compute(block, op, s_compute[(op >> 17) & 3]);
+			}
+			return true;
+
+		case 0x80: case 0x81: case 0x82: case 0x83:
+			// 100000xx xxxxxxxx xxxxxxxx  read data memory (immediate addr) to reg group 0
+			UML_READ(block, I0, (op >> 4) & 0x3fff, SIZE_WORD, SPACE_DATA);                 // read    i0,addr,word,data
+			generate_write_reg0(block, op & 15, uml::I0);
+			return true;
+
+		case 0x90: case 0x91: case 0x92: case 0x93:
+			// 1001xxxx xxxxxxxx xxxxxxxx  write data memory (immediate addr) from reg group 0
+			generate_read_reg0(block, op & 15, uml::I0);
+			UML_WRITE(block, (op >> 4) & 0x3fff, I0, SIZE_WORD, SPACE_DATA);                // write   addr,i0,word,data
+			return true;
+
+		case 0xa0: case 0xa1: case 0xa2: case 0xa3: case 0xa4: case 0xa5: case 0xa6: case 0xa7:
+		case 0xa8: case 0xa9: case 0xaa: case 0xab: case 0xac: case 0xad: case 0xae: case 0xaf:
+		case 0xb0: case 0xb1: case 0xb2: case 0xb3: case 0xb4: case 0xb5: case 0xb6: case 0xb7:
+		case 0xb8: case 0xb9: case 0xba: case 0xbb: case 0xbc: case 0xbd: case 0xbe: case 0xbf:
+			// 101xxxxx xxxxxxxx xxxxxxxx  data memory write (immediate) DAG1/DAG2
+			{
+				int const dag = (op >> 18) & 4;
+				UML_MOV(block, I0, (op >> 4) & 0xffff);                                     // mov     i0,imm
+				generate_data_write_dag(block, compiler, dag + ((op >> 2) & 3), dag + (op & 3), uml::I0);
+			}
+			return true;
+
+		case 0xc0: case 0xc1: case 0xc2: case 0xc3: case 0xc4: case 0xc5: case 0xc6: case 0xc7:
+		case 0xc8: case 0xc9: case 0xca: case 0xcb: case 0xcc: case 0xcd: case 0xce: case 0xcf:
+		case 0xd0: case 0xd1: case 0xd2: case 0xd3: case 0xd4: case 0xd5: case 0xd6: case 0xd7:
+		case 0xd8: case 0xd9: case 0xda: case 0xdb: case 0xdc: case 0xdd: case 0xde: case 0xdf:
+		case 0xe0: case 0xe1: case 0xe2: case 0xe3: case 0xe4: case 0xe5: case 0xe6: case 0xe7:
+		case 0xe8: case 0xe9: case 0xea: case 0xeb: case 0xec: case 0xed: case 0xee: case 0xef:
+		case 0xf0: case 0xf1: case 0xf2: case 0xf3: case 0xf4: case 0xf5: case 0xf6: case 0xf7:
+		case 0xf8: case 0xf9: case 0xfa: case 0xfb: case 0xfc: case 0xfd: case 0xfe: case 0xff:
+			// 11xxxxxx xxxxxxxx xxxxxxxx  ALU/MAC with data read to AX0/AX1/MX0/MX1 & pgm read to AY0/AY1/MY0/MY1
+			generate_compute(block, op, s_compute[(op >> 17) & 1]);
+			generate_data_read_dag(block, compiler, (op >> 2) & 3, op & 3, uml::I0);
+			UML_STORE(block, m_read0_ptr[(op >> 18) & 3], 0, I0, SIZE_WORD, SCALE_x1);      // store   [xreg],i0
+			generate_pgm_read_dag2(block, compiler, 4 + ((op >> 6) & 3), 4 + ((op >> 4) & 3), uml::I0);
+			UML_STORE(block, m_read0_ptr[4 + ((op >> 20) & 3)], 0, I0, SIZE_WORD, SCALE_x1); // store   [yreg],i0
+			return true;
+	}
+
+	return false;
+}
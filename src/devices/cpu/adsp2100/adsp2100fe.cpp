@@ -0,0 +1,107 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    adsp2100fe.cpp
+
+    Front-end for ADSP-21xx recompiler
+
+***************************************************************************/
+
+#include "emu.h"
+#include "adsp2100fe.h"
+
+#include <algorithm>
+
+
+adsp21xx_frontend::adsp21xx_frontend(adsp21xx_device &adsp, uint32_t window_start, uint32_t window_end, uint32_t max_sequence)
+	: drc_frontend(adsp, window_start, window_end, max_sequence)
+	, m_adsp(adsp)
+{
+	std::fill(std::begin(m_loop_end), std::end(m_loop_end), 0);
+}
+
+
+//-------------------------------------------------
+//  add_loop_end - note the last instruction of a
+//  DO UNTIL loop; code compiled for it before now
+//  doesn't check for the loop, so it's thrown away
+//-------------------------------------------------
+
+void adsp21xx_frontend::add_loop_end(uint32_t pc)
+{
+	pc &= 0x3fff;
+	if (!m_loop_end[pc])
+	{
+		m_loop_end[pc] = 1;
+		if (m_adsp.m_drc_code[pc])
+			m_adsp.m_drc_flush = 1;
+	}
+}
+
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool adsp21xx_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	uint32_t const op = desc.opptr.l[0] = m_adsp.m_cache.read_dword(desc.physpc);
+
+	desc.length = 1;
+	desc.cycles = 1;
+
+	switch ((op >> 16) & 0xff)
+	{
+		case 0x02:
+			// idle gives up the rest of the timeslice
+			if (op & 0x008000)
+				desc.flags |= OPFLAG_END_SEQUENCE;
+			break;
+
+		case 0x03:
+			// call or jump on flag in
+			desc.targetpc = ((op >> 4) & 0x0fff) | ((op << 10) & 0x3000);
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			break;
+
+		case 0x0a:
+		case 0x0b:
+			// conditional return, conditional jump (indirect address)
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			if ((op & 15) == 15)
+				desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			else
+				desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			break;
+
+		case 0x11:
+			// shift with pgm memory write may overwrite code
+			if (op & 0x008000)
+				desc.flags |= OPFLAG_WRITES_MEMORY | OPFLAG_END_SEQUENCE;
+			break;
+
+		case 0x14: case 0x15: case 0x16: case 0x17:
+			// do until
+			add_loop_end((op >> 4) & 0x3fff);
+			break;
+
+		case 0x18: case 0x19: case 0x1a: case 0x1b:
+		case 0x1c: case 0x1d: case 0x1e: case 0x1f:
+			// conditional jump or call (immediate addr)
+			desc.targetpc = (op >> 4) & 0x3fff;
+			if ((op & 15) == 15)
+				desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			else
+				desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			break;
+
+		case 0x58: case 0x59: case 0x5a: case 0x5b: case 0x5c: case 0x5d: case 0x5e: case 0x5f:
+			// compute with pgm memory write may overwrite code
+			desc.flags |= OPFLAG_WRITES_MEMORY | OPFLAG_END_SEQUENCE;
+			break;
+	}
+
+	return true;
+}
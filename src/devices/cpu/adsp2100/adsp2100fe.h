@@ -0,0 +1,39 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    adsp2100fe.h
+
+    Front-end for ADSP-21xx recompiler
+
+***************************************************************************/
+
+#ifndef MAME_CPU_ADSP2100_ADSP2100FE_H
+#define MAME_CPU_ADSP2100_ADSP2100FE_H
+
+#pragma once
+
+#include "adsp2100.h"
+#include "cpu/drcfe.h"
+
+
+class adsp21xx_frontend : public drc_frontend
+{
+public:
+	adsp21xx_frontend(adsp21xx_device &adsp, uint32_t window_start, uint32_t window_end, uint32_t max_sequence);
+
+	// loop end addresses named by DO UNTIL instructions seen so far
+	bool is_loop_end(uint32_t pc) const { return m_loop_end[pc & 0x3fff] != 0; }
+	void add_loop_end(uint32_t pc);
+
+protected:
+	// required overrides
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	adsp21xx_device &m_adsp;
+
+	uint8_t m_loop_end[0x4000];
+};
+
+#endif // MAME_CPU_ADSP2100_ADSP2100FE_H
@@ -36,6 +36,7 @@ TODO:
 #include "arm7.h"
 #include "arm7core.h"   //include arm7 core
 #include "arm7help.h"
+#include "arm7fe.h"
 
 #define LOG_MMU             (1 << 0)
 #define LOG_DSP             (1 << 1)
@@ -93,6 +94,14 @@ arm7_cpu_device::arm7_cpu_device(const machine_config &mconfig, device_type type
 	, m_archFlags(archFlags)
 	, m_vectorbase(0)
 	, m_pc(0)
+	, m_enable_drc(false)
+	, m_drc_options(0)
+	, m_drc_flush(0)
+	, m_drc_op(0)
+	, m_entry(nullptr)
+	, m_nocode(nullptr)
+	, m_out_of_cycles(nullptr)
+	, m_redispatch(nullptr)
 {
 	std::fill(std::begin(m_r), std::end(m_r), 0);
 	uint32_t arch = ARM9_COPRO_ID_ARCH_V4;
@@ -113,6 +122,10 @@ arm7_cpu_device::arm7_cpu_device(const machine_config &mconfig, device_type type
 	m_actual_log = 0;
 }
 
+arm7_cpu_device::~arm7_cpu_device()
+{
+}
+
 
 arm7_be_cpu_device::arm7_be_cpu_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock)
 	: arm7_cpu_device(mconfig, ARM7_BE, tag, owner, clock, 4, ARCHFLAG_T, ENDIANNESS_BIG)
@@ -929,6 +942,7 @@ bool arm7_cpu_device::memory_translate(int spacenum, int intention, offs_t &addr
 void arm7_cpu_device::postload()
 {
 	update_reg_ptr();
+	m_drc_flush = 1;
 }
 
 void arm7_cpu_device::device_start()
@@ -1124,7 +1138,7 @@ void arm7_cpu_device::device_reset()
 	SwitchMode(eARM7_MODE_SVC);
 	m_r[eR15] = 0 | m_vectorbase;
 
-	m_impstate.cache_dirty = true;
+	m_drc_flush = 1;
 
 	for (auto &entry : m_dtlb_entries)
 	{
@@ -1239,335 +1253,354 @@ void arm7_cpu_device::execute_run()
 {
 	m_tlb_log = m_actual_log;
 
+	if (m_enable_drc)
+	{
+		execute_run_drc();
+	}
+	else
+	{
+		do
+		{
+			execute_one();
+		} while (m_icount > 0);
+	}
+
+	m_tlb_log = 0;
+}
+
+
+void arm7_cpu_device::execute_one()
+{
 	uint32_t insn;
 
-	do
-	{
-		uint32_t pc = GET_PC;
+	uint32_t pc = GET_PC;
 
 #if PRINT_HAPYFSH2
-		if (pc == 0xC0047374)
+	if (pc == 0xC0047374)
+	{
+		char substr_buf[4096];
+		uint16_t substr_idx = 0;
+		bool zero_prepend = false;
+		uint8_t digit_count = 0;
+		uint32_t string_addr = (m_r[eR0] & 0x0fffffff) | 0x30000000;
+		uint8_t charval = 0;
+		uint32_t reg_idx = eR1;
+		do
 		{
-			char substr_buf[4096];
-			uint16_t substr_idx = 0;
-			bool zero_prepend = false;
-			uint8_t digit_count = 0;
-			uint32_t string_addr = (m_r[eR0] & 0x0fffffff) | 0x30000000;
-			uint8_t charval = 0;
-			uint32_t reg_idx = eR1;
-			do
+			charval = m_program->read_byte(string_addr);
+			string_addr++;
+			if (charval >= 0x20 && charval < 0x7f)
 			{
-				charval = m_program->read_byte(string_addr);
-				string_addr++;
-				if (charval >= 0x20 && charval < 0x7f)
+				if (charval == '%')
 				{
-					if (charval == '%')
+					bool still_processing = true;
+					uint8_t nextval = m_program->read_byte(string_addr);
+					string_addr++;
+					switch (nextval)
+					{
+					case 0:
+						printf("%%");
+						charval = 0;
+						still_processing = false;
+						break;
+					case '%':
+						printf("%%");
+						still_processing = false;
+						break;
+					case '0':
+						zero_prepend = true;
+						break;
+					case '1':
+					case '2':
+					case '3':
+					case '4':
+					case '5':
+					case '6':
+					case '7':
+					case '8':
+					case '9':
+						digit_count = nextval - '0';
+						break;
+					case 'd':
+						printf("%d", (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx]);
+						still_processing = false;
+						reg_idx++;
+						break;
+					case 'l':
+					case 'u':
+						printf("%u", (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx]);
+						still_processing = false;
+						reg_idx++;
+						break;
+					case 'x':
+					case 'p':
+						printf("%x", (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx]);
+						still_processing = false;
+						reg_idx++;
+						break;
+					case 'o':
+						printf("%o", (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx]);
+						still_processing = false;
+						reg_idx++;
+						break;
+					case 's':
+					{
+						uint32_t val = (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx];
+						uint32_t substring_addr = (val & 0x0fffffff) | 0x30000000;
+						reg_idx++;
+						bool end_found = false;
+						while (!end_found)
+						{
+							substr_buf[substr_idx] = m_program->read_byte(substring_addr);
+							if (substr_buf[substr_idx] == 0)
+							{
+								end_found = true;
+							}
+							substring_addr++;
+							substr_idx++;
+						}
+						substr_idx = 0;
+						printf("%s", substr_buf);
+						still_processing = false;
+						break;
+					}
+					}
+					while (still_processing)
 					{
-						bool still_processing = true;
-						uint8_t nextval = m_program->read_byte(string_addr);
+						uint8_t nextval2 = m_program->read_byte(string_addr);
 						string_addr++;
-						switch (nextval)
+						if (nextval2 == 0)
 						{
-						case 0:
-							printf("%%");
+							printf("%c%c", (char)charval, (char)nextval);
 							charval = 0;
-							still_processing = false;
-							break;
-						case '%':
-							printf("%%");
-							still_processing = false;
-							break;
-						case '0':
-							zero_prepend = true;
-							break;
-						case '1':
-						case '2':
-						case '3':
-						case '4':
-						case '5':
-						case '6':
-						case '7':
-						case '8':
-						case '9':
-							digit_count = nextval - '0';
-							break;
-						case 'd':
-							printf("%d", (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx]);
-							still_processing = false;
-							reg_idx++;
-							break;
-						case 'l':
-						case 'u':
-							printf("%u", (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx]);
-							still_processing = false;
-							reg_idx++;
-							break;
-						case 'x':
-						case 'p':
-							printf("%x", (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx]);
-							still_processing = false;
-							reg_idx++;
-							break;
-						case 'o':
-							printf("%o", (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx]);
-							still_processing = false;
-							reg_idx++;
 							break;
-						case 's':
+						}
+						else if (nextval2 >= '1' && nextval2 <= '9')
+						{
+							digit_count = nextval2 - '0';
+						}
+						else if (nextval2 == 'd')
 						{
 							uint32_t val = (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx];
-							uint32_t substring_addr = (val & 0x0fffffff) | 0x30000000;
-							reg_idx++;
-							bool end_found = false;
-							while (!end_found)
+							switch (digit_count)
 							{
-								substr_buf[substr_idx] = m_program->read_byte(substring_addr);
-								if (substr_buf[substr_idx] == 0)
-								{
-									end_found = true;
-								}
-								substring_addr++;
-								substr_idx++;
+							case 1: if (zero_prepend) { printf("%01d", val); } else { printf("%1d", val); } break;
+							case 2: if (zero_prepend) { printf("%02d", val); } else { printf("%2d", val); } break;
+							case 3: if (zero_prepend) { printf("%03d", val); } else { printf("%3d", val); } break;
+							case 4: if (zero_prepend) { printf("%04d", val); } else { printf("%4d", val); } break;
+							case 5: if (zero_prepend) { printf("%05d", val); } else { printf("%5d", val); } break;
+							case 6: if (zero_prepend) { printf("%06d", val); } else { printf("%6d", val); } break;
+							case 7: if (zero_prepend) { printf("%07d", val); } else { printf("%7d", val); } break;
+							case 8: if (zero_prepend) { printf("%08d", val); } else { printf("%8d", val); } break;
+							case 9: if (zero_prepend) { printf("%09d", val); } else { printf("%9d", val); } break;
 							}
-							substr_idx = 0;
-							printf("%s", substr_buf);
+							reg_idx++;
 							still_processing = false;
-							break;
-						}
 						}
-						while (still_processing)
+						else if (nextval2 == 'u' || nextval2 == 'l')
 						{
-							uint8_t nextval2 = m_program->read_byte(string_addr);
-							string_addr++;
-							if (nextval2 == 0)
-							{
-								printf("%c%c", (char)charval, (char)nextval);
-								charval = 0;
-								break;
-							}
-							else if (nextval2 >= '1' && nextval2 <= '9')
-							{
-								digit_count = nextval2 - '0';
-							}
-							else if (nextval2 == 'd')
-							{
-								uint32_t val = (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx];
-								switch (digit_count)
-								{
-								case 1: if (zero_prepend) { printf("%01d", val); } else { printf("%1d", val); } break;
-								case 2: if (zero_prepend) { printf("%02d", val); } else { printf("%2d", val); } break;
-								case 3: if (zero_prepend) { printf("%03d", val); } else { printf("%3d", val); } break;
-								case 4: if (zero_prepend) { printf("%04d", val); } else { printf("%4d", val); } break;
-								case 5: if (zero_prepend) { printf("%05d", val); } else { printf("%5d", val); } break;
-								case 6: if (zero_prepend) { printf("%06d", val); } else { printf("%6d", val); } break;
-								case 7: if (zero_prepend) { printf("%07d", val); } else { printf("%7d", val); } break;
-								case 8: if (zero_prepend) { printf("%08d", val); } else { printf("%8d", val); } break;
-								case 9: if (zero_prepend) { printf("%09d", val); } else { printf("%9d", val); } break;
-								}
-								reg_idx++;
-								still_processing = false;
-							}
-							else if (nextval2 == 'u' || nextval2 == 'l')
-							{
-								uint32_t val = (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx];
-								switch (digit_count)
-								{
-								case 1: if (zero_prepend) { printf("%01u", val); } else { printf("%1u", val); } break;
-								case 2: if (zero_prepend) { printf("%02u", val); } else { printf("%2u", val); } break;
-								case 3: if (zero_prepend) { printf("%03u", val); } else { printf("%3u", val); } break;
-								case 4: if (zero_prepend) { printf("%04u", val); } else { printf("%4u", val); } break;
-								case 5: if (zero_prepend) { printf("%05u", val); } else { printf("%5u", val); } break;
-								case 6: if (zero_prepend) { printf("%06u", val); } else { printf("%6u", val); } break;
-								case 7: if (zero_prepend) { printf("%07u", val); } else { printf("%7u", val); } break;
-								case 8: if (zero_prepend) { printf("%08u", val); } else { printf("%8u", val); } break;
-								case 9: if (zero_prepend) { printf("%09u", val); } else { printf("%9u", val); } break;
-								}
-								reg_idx++;
-								still_processing = false;
-							}
-							else if (nextval2 == 'x')
+							uint32_t val = (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx];
+							switch (digit_count)
 							{
-								uint32_t val = (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx];
-								switch (digit_count)
-								{
-								case 1: if (zero_prepend) { printf("%01x", val); } else { printf("%1x", val); } break;
-								case 2: if (zero_prepend) { printf("%02x", val); } else { printf("%2x", val); } break;
-								case 3: if (zero_prepend) { printf("%03x", val); } else { printf("%3x", val); } break;
-								case 4: if (zero_prepend) { printf("%04x", val); } else { printf("%4x", val); } break;
-								case 5: if (zero_prepend) { printf("%05x", val); } else { printf("%5x", val); } break;
-								case 6: if (zero_prepend) { printf("%06x", val); } else { printf("%6x", val); } break;
-								case 7: if (zero_prepend) { printf("%07x", val); } else { printf("%7x", val); } break;
-								case 8: if (zero_prepend) { printf("%08x", val); } else { printf("%8x", val); } break;
-								case 9: if (zero_prepend) { printf("%09x", val); } else { printf("%9x", val); } break;
-								}
-								reg_idx++;
-								still_processing = false;
+							case 1: if (zero_prepend) { printf("%01u", val); } else { printf("%1u", val); } break;
+							case 2: if (zero_prepend) { printf("%02u", val); } else { printf("%2u", val); } break;
+							case 3: if (zero_prepend) { printf("%03u", val); } else { printf("%3u", val); } break;
+							case 4: if (zero_prepend) { printf("%04u", val); } else { printf("%4u", val); } break;
+							case 5: if (zero_prepend) { printf("%05u", val); } else { printf("%5u", val); } break;
+							case 6: if (zero_prepend) { printf("%06u", val); } else { printf("%6u", val); } break;
+							case 7: if (zero_prepend) { printf("%07u", val); } else { printf("%7u", val); } break;
+							case 8: if (zero_prepend) { printf("%08u", val); } else { printf("%8u", val); } break;
+							case 9: if (zero_prepend) { printf("%09u", val); } else { printf("%9u", val); } break;
 							}
-							else if (nextval2 == 'o')
+							reg_idx++;
+							still_processing = false;
+						}
+						else if (nextval2 == 'x')
+						{
+							uint32_t val = (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx];
+							switch (digit_count)
 							{
-								uint32_t val = (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx];
-								switch (digit_count)
-								{
-								case 1: if (zero_prepend) { printf("%01o", val); } else { printf("%1o", val); } break;
-								case 2: if (zero_prepend) { printf("%02o", val); } else { printf("%2o", val); } break;
-								case 3: if (zero_prepend) { printf("%03o", val); } else { printf("%3o", val); } break;
-								case 4: if (zero_prepend) { printf("%04o", val); } else { printf("%4o", val); } break;
-								case 5: if (zero_prepend) { printf("%05o", val); } else { printf("%5o", val); } break;
-								case 6: if (zero_prepend) { printf("%06o", val); } else { printf("%6o", val); } break;
-								case 7: if (zero_prepend) { printf("%07o", val); } else { printf("%7o", val); } break;
-								case 8: if (zero_prepend) { printf("%08o", val); } else { printf("%8o", val); } break;
-								case 9: if (zero_prepend) { printf("%09o", val); } else { printf("%9o", val); } break;
-								}
-								reg_idx++;
-								still_processing = false;
+							case 1: if (zero_prepend) { printf("%01x", val); } else { printf("%1x", val); } break;
+							case 2: if (zero_prepend) { printf("%02x", val); } else { printf("%2x", val); } break;
+							case 3: if (zero_prepend) { printf("%03x", val); } else { printf("%3x", val); } break;
+							case 4: if (zero_prepend) { printf("%04x", val); } else { printf("%4x", val); } break;
+							case 5: if (zero_prepend) { printf("%05x", val); } else { printf("%5x", val); } break;
+							case 6: if (zero_prepend) { printf("%06x", val); } else { printf("%6x", val); } break;
+							case 7: if (zero_prepend) { printf("%07x", val); } else { printf("%7x", val); } break;
+							case 8: if (zero_prepend) { printf("%08x", val); } else { printf("%8x", val); } break;
+							case 9: if (zero_prepend) { printf("%09x", val); } else { printf("%9x", val); } break;
 							}
-							else
+							reg_idx++;
+							still_processing = false;
+						}
+						else if (nextval2 == 'o')
+						{
+							uint32_t val = (reg_idx >= eR4) ? m_program->read_dword(((m_r[eR13_SVC] & 0x0fffffff) | 0x30000000) + (reg_idx - eR4)) : m_r[reg_idx];
+							switch (digit_count)
 							{
-								printf("%c%c", (char)charval, (char)nextval);
-								still_processing = false;
+							case 1: if (zero_prepend) { printf("%01o", val); } else { printf("%1o", val); } break;
+							case 2: if (zero_prepend) { printf("%02o", val); } else { printf("%2o", val); } break;
+							case 3: if (zero_prepend) { printf("%03o", val); } else { printf("%3o", val); } break;
+							case 4: if (zero_prepend) { printf("%04o", val); } else { printf("%4o", val); } break;
+							case 5: if (zero_prepend) { printf("%05o", val); } else { printf("%5o", val); } break;
+							case 6: if (zero_prepend) { printf("%06o", val); } else { printf("%6o", val); } break;
+							case 7: if (zero_prepend) { printf("%07o", val); } else { printf("%7o", val); } break;
+							case 8: if (zero_prepend) { printf("%08o", val); } else { printf("%8o", val); } break;
+							case 9: if (zero_prepend) { printf("%09o", val); } else { printf("%9o", val); } break;
 							}
+							reg_idx++;
+							still_processing = false;
+						}
+						else
+						{
+							printf("%c%c", (char)charval, (char)nextval);
+							still_processing = false;
 						}
-					}
-					else
-					{
-						printf("%c", (char)charval);
 					}
 				}
-			} while (charval != 0);
-			printf("\n");
-		}
+				else
+				{
+					printf("%c", (char)charval);
+				}
+			}
+		} while (charval != 0);
+		printf("\n");
+	}
 #endif
-		update_insn_prefetch(pc);
+	update_insn_prefetch(pc);
 
-		m_tlb_log = 0;
-		debugger_instruction_hook(pc);
-		m_tlb_log = m_actual_log;
+	m_tlb_log = 0;
+	debugger_instruction_hook(pc);
+	m_tlb_log = m_actual_log;
 
-		/* handle Thumb instructions if active */
-		if (T_IS_SET(m_r[eCPSR]))
-		{
-			offs_t raddr;
+	/* handle Thumb instructions if active */
+	if (T_IS_SET(m_r[eCPSR]))
+	{
+		offs_t raddr;
 
-			pc = m_r[eR15];
+		pc = m_r[eR15];
 
-			// "In Thumb state, bit [0] is undefined and must be ignored. Bits [31:1] contain the PC."
-			raddr = pc & (~1);
+		// "In Thumb state, bit [0] is undefined and must be ignored. Bits [31:1] contain the PC."
+		raddr = pc & (~1);
 
-			if (!insn_fetch_thumb(raddr, insn))
-			{
-				m_pendingAbtP = true;
-				update_irq_state();
-				goto skip_exec;
-			}
-			(this->*thumb_handler[(insn & 0xffc0) >> 6])(pc, insn);
-		}
-		else
+		if (!insn_fetch_thumb(raddr, insn))
 		{
-			offs_t raddr;
+			m_pendingAbtP = true;
+			update_irq_state();
+			goto skip_exec;
+		}
+		(this->*thumb_handler[(insn & 0xffc0) >> 6])(pc, insn);
+	}
+	else
+	{
+		offs_t raddr;
 
-			/* load 32 bit instruction */
+		/* load 32 bit instruction */
 
-			// "In ARM state, bits [1:0] of r15 are undefined and must be ignored. Bits [31:2] contain the PC."
-			raddr = pc & (~3);
+		// "In ARM state, bits [1:0] of r15 are undefined and must be ignored. Bits [31:2] contain the PC."
+		raddr = pc & (~3);
 
-			if (!insn_fetch_arm(raddr, insn))
-			{
+		if (!insn_fetch_arm(raddr, insn))
+		{
 #if PRINT_CE_KERNEL
-				if (raddr >= 0xf0000000)
-				{
-					print_ce_kernel_address(raddr - 0xf0000000);
-				}
-#endif
-				m_pendingAbtP = true;
-				update_irq_state();
-				goto skip_exec;
-			}
-
-			int op_offset = 0;
-			/* process condition codes for this instruction */
-			if ((insn >> INSN_COND_SHIFT) != COND_AL)
+			if (raddr >= 0xf0000000)
 			{
-				switch (insn >> INSN_COND_SHIFT)
-				{
-					case COND_EQ:
-						if (Z_IS_CLEAR(m_r[eCPSR]))
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_NE:
-						if (Z_IS_SET(m_r[eCPSR]))
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_CS:
-						if (C_IS_CLEAR(m_r[eCPSR]))
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_CC:
-						if (C_IS_SET(m_r[eCPSR]))
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_MI:
-						if (N_IS_CLEAR(m_r[eCPSR]))
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_PL:
-						if (N_IS_SET(m_r[eCPSR]))
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_VS:
-						if (V_IS_CLEAR(m_r[eCPSR]))
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_VC:
-						if (V_IS_SET(m_r[eCPSR]))
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_HI:
-						if (C_IS_CLEAR(m_r[eCPSR]) || Z_IS_SET(m_r[eCPSR]))
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_LS:
-						if (C_IS_SET(m_r[eCPSR]) && Z_IS_CLEAR(m_r[eCPSR]))
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_GE:
-						if (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)) /* Use x ^ (x >> ...) method */
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_LT:
-						if (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK))
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_GT:
-						if (Z_IS_SET(m_r[eCPSR]) || (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)))
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_LE:
-						if (Z_IS_CLEAR(m_r[eCPSR]) && (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK)))
-							{ UNEXECUTED();  goto skip_exec; }
-						break;
-					case COND_NV:
-						if (m_archRev < 5)
-						  { UNEXECUTED();  goto skip_exec; }
-						else
-							op_offset = 0x10;
-						break;
-				}
+				print_ce_kernel_address(raddr - 0xf0000000);
 			}
-			/*******************************************************************/
-			/* If we got here - condition satisfied, so decode the instruction */
-			/*******************************************************************/
-			(this->*ops_handler[((insn & 0xF000000) >> 24) + op_offset])(insn);
+#endif
+			m_pendingAbtP = true;
+			update_irq_state();
+			goto skip_exec;
 		}
 
+		execute_arm_insn(insn);
+	}
+
 skip_exec:
 
-		arm7_check_irq_state();
+	arm7_check_irq_state();
 
-		/* All instructions remove 3 cycles.. Others taking less / more will have adjusted this # prior to here */
-		m_icount -= 3;
-	} while (m_icount > 0);
+	/* All instructions remove 3 cycles.. Others taking less / more will have adjusted this # prior to here */
+	m_icount -= 3;
+}
 
-	m_tlb_log = 0;
+
+void arm7_cpu_device::execute_arm_insn(uint32_t insn)
+{
+	int op_offset = 0;
+	/* process condition codes for this instruction */
+	if ((insn >> INSN_COND_SHIFT) != COND_AL)
+	{
+		switch (insn >> INSN_COND_SHIFT)
+		{
+			case COND_EQ:
+				if (Z_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_NE:
+				if (Z_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_CS:
+				if (C_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_CC:
+				if (C_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_MI:
+				if (N_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_PL:
+				if (N_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_VS:
+				if (V_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_VC:
+				if (V_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_HI:
+				if (C_IS_CLEAR(m_r[eCPSR]) || Z_IS_SET(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_LS:
+				if (C_IS_SET(m_r[eCPSR]) && Z_IS_CLEAR(m_r[eCPSR]))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_GE:
+				if (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)) /* Use x ^ (x >> ...) method */
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_LT:
+				if (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_GT:
+				if (Z_IS_SET(m_r[eCPSR]) || (!(m_r[eCPSR] & N_MASK) != !(m_r[eCPSR] & V_MASK)))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_LE:
+				if (Z_IS_CLEAR(m_r[eCPSR]) && (!(m_r[eCPSR] & N_MASK) == !(m_r[eCPSR] & V_MASK)))
+					{ UNEXECUTED();  return; }
+				break;
+			case COND_NV:
+				if (m_archRev < 5)
+				  { UNEXECUTED();  return; }
+				else
+					op_offset = 0x10;
+				break;
+		}
+	}
+	/*******************************************************************/
+	/* If we got here - condition satisfied, so decode the instruction */
+	/*******************************************************************/
+	(this->*ops_handler[((insn & 0xF000000) >> 24) + op_offset])(insn);
 }
 
 
@@ -27,21 +27,16 @@
 
 #include "cpu/drcfe.h"
 #include "cpu/drcuml.h"
-#include "cpu/drcumlsh.h"
 
 
-#define ARM7_MAX_FASTRAM       4
-#define ARM7_MAX_HOTSPOTS      16
-
 /***************************************************************************
     COMPILER-SPECIFIC OPTIONS
 ***************************************************************************/
 
-#define ARM7DRC_STRICT_VERIFY      0x0001          /* verify all instructions */
-#define ARM7DRC_FLUSH_PC           0x0008          /* flush the PC value before each memory access */
+#define ARM7DRC_VALIDATE           0x0001          /* check generated instructions against the interpreter */
+
 
-#define ARM7DRC_COMPATIBLE_OPTIONS (ARM7DRC_STRICT_VERIFY | ARM7DRC_FLUSH_PC)
-#define ARM7DRC_FASTEST_OPTIONS    (0)
+class arm7_frontend;
 
 /****************************************************************************************************
  *  PUBLIC FUNCTIONS
@@ -49,12 +44,19 @@
 
 class arm7_cpu_device : public cpu_device, public arm7_disassembler::config
 {
+	friend class arm7_frontend;
+
 public:
 	// construction/destruction
 	arm7_cpu_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock);
+	virtual ~arm7_cpu_device();
 
 	void set_high_vectors() { m_vectorbase = 0xffff0000; }
 
+	// use the recompiler rather than the interpreter, and configure it
+	void enable_recompiler();
+	void arm7drc_set_options(uint32_t options) { m_drc_options = options; }
+
 protected:
 	enum
 	{
@@ -395,226 +397,67 @@ protected:
 	typedef void ( arm7_cpu_device::*arm7ops_ophandler )(uint32_t);
 	static const arm7ops_ophandler ops_handler[0x20];
 
-	//
-	// DRC
-	//
-
-	/* fast RAM info */
-	struct fast_ram_info
-	{
-		offs_t              start = 0;                  /* start of the RAM block */
-		offs_t              end = 0;                    /* end of the RAM block */
-		bool                readonly = false;           /* true if read-only */
-		void *              base = nullptr;             /* base in memory where the RAM lives */
-	};
-
-	struct hotspot_info
-	{
-		uint32_t             pc = 0;
-		uint32_t             opcode = 0;
-		uint32_t             cycles = 0;
-	};
+	void execute_one();
+	void execute_arm_insn(uint32_t insn);
 
-	/* internal compiler state */
+	// recompiler
 	struct compiler_state
 	{
-		compiler_state &operator=(compiler_state const &) = delete;
-
-		uint32_t         cycles = 0;                 /* accumulated cycles */
-		uint8_t          checkints = 0;              /* need to check interrupts before next instruction */
-		uint8_t          checksoftints = 0;          /* need to check software interrupts before next instruction */
-		uml::code_label  labelnum;                   /* index for local labels */
+		uint32_t cycles;                // accumulated cycles
+		uint32_t mode;                  // CPSR T and mode bits the block was compiled for
+		uint32_t bl_hi_pc;              // address of a preceding Thumb BL prefix, if generated
+		uml::code_label labelnum;       // index for local labels
 	};
 
-	/* ARM7 registers */
-	struct arm7imp_state
-	{
-		/* core state */
-		std::unique_ptr<drc_cache> cache;               /* pointer to the DRC code cache */
-		std::unique_ptr<drcuml_state> drcuml;           /* DRC UML generator state */
-		//arm7_frontend *     drcfe = nullptr;            /* pointer to the DRC front-end state */
-		uint32_t            drcoptions = 0;             /* configurable DRC options */
-
-		/* internal stuff */
-		uint8_t             cache_dirty = 0;            /* true if we need to flush the cache */
-		uint32_t            jmpdest = 0;                /* destination jump target */
-
-		/* parameters for subroutines */
-		uint64_t            numcycles = 0;              /* return value from gettotalcycles */
-		uint32_t            mode = 0;                   /* current global mode */
-		const char *        format = nullptr;           /* format string for print_debug */
-		uint32_t            arg0 = 0;                   /* print_debug argument 1 */
-		uint32_t            arg1 = 0;                   /* print_debug argument 2 */
-
-		/* register mappings */
-		uml::parameter      regmap[/*NUM_REGS*/37];     /* parameter to register mappings for all 16 integer registers */
-
-		/* subroutines */
-		uml::code_handle *  entry = nullptr;            /* entry point */
-		uml::code_handle *  nocode = nullptr;           /* nocode exception handler */
-		uml::code_handle *  out_of_cycles = nullptr;    /* out of cycles exception handler */
-		uml::code_handle *  tlb_translate = nullptr;    /* tlb translation handler */
-		uml::code_handle *  detect_fault = nullptr;     /* tlb fault detection handler */
-		uml::code_handle *  check_irq = nullptr;        /* irq check handler */
-		uml::code_handle *  read8 = nullptr;            /* read byte */
-		uml::code_handle *  write8 = nullptr;           /* write byte */
-		uml::code_handle *  read16 = nullptr;           /* read half */
-		uml::code_handle *  write16 = nullptr;          /* write half */
-		uml::code_handle *  read32 = nullptr;           /* read word */
-		uml::code_handle *  write32 = nullptr;          /* write word */
-
-		/* fast RAM */
-		uint32_t            fastram_select = 0;
-		fast_ram_info       fastram[ARM7_MAX_FASTRAM];
-
-		/* hotspots */
-		uint32_t            hotspot_select = 0;
-		hotspot_info        hotspot[ARM7_MAX_HOTSPOTS];
-	} m_impstate;
-
-	typedef void ( arm7_cpu_device::*arm7thumb_drcophandler)(drcuml_block &, compiler_state &, const opcode_desc *);
-	static const arm7thumb_drcophandler drcthumb_handler[0x40*0x10];
-
-	void drctg00_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* Shift left */
-	void drctg00_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* Shift right */
-	void drctg01_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg01_10(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg01_11(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* SUB Rd, Rs, Rn */
-	void drctg01_12(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* ADD Rd, Rs, #imm */
-	void drctg01_13(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* SUB Rd, Rs, #imm */
-	void drctg02_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg02_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg03_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* ADD Rd, #Offset8 */
-	void drctg03_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* SUB Rd, #Offset8 */
-	void drctg04_00_00(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* AND Rd, Rs */
-	void drctg04_00_01(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* EOR Rd, Rs */
-	void drctg04_00_02(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* LSL Rd, Rs */
-	void drctg04_00_03(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* LSR Rd, Rs */
-	void drctg04_00_04(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* ASR Rd, Rs */
-	void drctg04_00_05(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* ADC Rd, Rs */
-	void drctg04_00_06(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);  /* SBC Rd, Rs */
-	void drctg04_00_07(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* ROR Rd, Rs */
-	void drctg04_00_08(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* TST Rd, Rs */
-	void drctg04_00_09(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* NEG Rd, Rs */
-	void drctg04_00_0a(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* CMP Rd, Rs */
-	void drctg04_00_0b(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* CMN Rd, Rs - check flags, add dasm */
-	void drctg04_00_0c(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* ORR Rd, Rs */
-	void drctg04_00_0d(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* MUL Rd, Rs */
-	void drctg04_00_0e(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* BIC Rd, Rs */
-	void drctg04_00_0f(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* MVN Rd, Rs */
-	void drctg04_01_00(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg04_01_01(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* ADD Rd, HRs */
-	void drctg04_01_02(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* ADD HRd, Rs */
-	void drctg04_01_03(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* Add HRd, HRs */
-	void drctg04_01_10(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);  /* CMP Rd, Rs */
-	void drctg04_01_11(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* CMP Rd, Hs */
-	void drctg04_01_12(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* CMP Hd, Rs */
-	void drctg04_01_13(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* CMP Hd, Hs */
-	void drctg04_01_20(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* MOV Rd, Rs (undefined) */
-	void drctg04_01_21(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* MOV Rd, Hs */
-	void drctg04_01_22(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* MOV Hd, Rs */
-	void drctg04_01_23(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* MOV Hd, Hs */
-	void drctg04_01_30(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg04_01_31(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg04_01_32(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg04_01_33(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg04_0203(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg05_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);  /* STR Rd, [Rn, Rm] */
-	void drctg05_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);  /* STRH Rd, [Rn, Rm] */
-	void drctg05_2(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);  /* STRB Rd, [Rn, Rm] */
-	void drctg05_3(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);  /* LDSB Rd, [Rn, Rm] todo, add dasm */
-	void drctg05_4(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);  /* LDR Rd, [Rn, Rm] */
-	void drctg05_5(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);  /* LDRH Rd, [Rn, Rm] */
-	void drctg05_6(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);  /* LDRB Rd, [Rn, Rm] */
-	void drctg05_7(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);  /* LDSH Rd, [Rn, Rm] */
-	void drctg06_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* Store */
-	void drctg06_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* Load */
-	void drctg07_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* Store */
-	void drctg07_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);  /* Load */
-	void drctg08_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* Store */
-	void drctg08_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* Load */
-	void drctg09_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* Store */
-	void drctg09_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* Load */
-	void drctg0a_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);  /* ADD Rd, PC, #nn */
-	void drctg0a_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* ADD Rd, SP, #nn */
-	void drctg0b_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* ADD SP, #imm */
-	void drctg0b_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0b_2(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0b_3(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0b_4(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* PUSH {Rlist} */
-	void drctg0b_5(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* PUSH {Rlist}{LR} */
-	void drctg0b_6(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0b_7(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0b_8(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0b_9(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0b_a(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0b_b(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0b_c(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* POP {Rlist} */
-	void drctg0b_d(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* POP {Rlist}{PC} */
-	void drctg0b_e(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0b_f(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0c_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* Store */
-	void drctg0c_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* Load */
-	void drctg0d_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_EQ:
-	void drctg0d_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_NE:
-	void drctg0d_2(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_CS:
-	void drctg0d_3(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_CC:
-	void drctg0d_4(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_MI:
-	void drctg0d_5(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_PL:
-	void drctg0d_6(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_VS:
-	void drctg0d_7(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_VC:
-	void drctg0d_8(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_HI:
-	void drctg0d_9(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_LS:
-	void drctg0d_a(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_GE:
-	void drctg0d_b(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_LT:
-	void drctg0d_c(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_GT:
-	void drctg0d_d(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_LE:
-	void drctg0d_e(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // COND_AL:
-	void drctg0d_f(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); // SWI (this is sort of a "hole" in the opcode encoding)
-	void drctg0e_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0e_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0f_0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void drctg0f_1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc); /* BL */
+	static void cfunc_execute_arm(void *param);
+	static void cfunc_execute_thumb(void *param);
+	static void cfunc_validate_begin(void *param);
+	static void cfunc_validate_end(void *param);
 
-	void update_reg_ptr();
-	const int* m_reg_group;
-	void load_fast_iregs(drcuml_block &block);
-	void save_fast_iregs(drcuml_block &block);
-	void arm7_drc_init();
-	void arm7_drc_exit();
+	bool drc_code_pointer(offs_t pc, offs_t &physpc, uint32_t const *&ptr);
 	void execute_run_drc();
-	void arm7drc_set_options(uint32_t options);
-	void arm7drc_add_fastram(offs_t start, offs_t end, uint8_t readonly, void *base);
-	void arm7drc_add_hotspot(offs_t pc, uint32_t opcode, uint32_t cycles);
-	void code_flush_cache();
-	void code_compile_block(uint8_t mode, offs_t pc);
-	void cfunc_get_cycles();
-	void cfunc_unimplemented();
+	void init_recompiler();
+	void flush_cache();
+	void compile_block(uint32_t mode, offs_t pc);
 	void static_generate_entry_point();
-	void static_generate_check_irq();
 	void static_generate_nocode_handler();
 	void static_generate_out_of_cycles();
-	void static_generate_detect_fault(uml::code_handle **handleptr);
-	void static_generate_tlb_translate(uml::code_handle **handleptr);
-	void static_generate_memory_accessor(int size, bool istlb, bool iswrite, const char *name, uml::code_handle *&handleptr);
-	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param);
-	void generate_checksum_block(drcuml_block &block, compiler_state &compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void static_generate_redispatch();
+	void generate_checksum_block(drcuml_block &block, const opcode_desc *seqhead, const opcode_desc *seqlast);
 	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
-	void generate_delay_slot_and_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint8_t linkreg);
-
-	typedef bool ( arm7_cpu_device::*drcarm7ops_ophandler)(drcuml_block &, compiler_state &, const opcode_desc *, uint32_t);
-	static const drcarm7ops_ophandler drcops_handler[0x10];
-
-	void saturate_qbit_overflow(drcuml_block &block);
-	bool drcarm7ops_0123(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t op);
-	bool drcarm7ops_4567(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t op);
-	bool drcarm7ops_89(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t op);
-	bool drcarm7ops_ab(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t op);
-	bool drcarm7ops_cd(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t op);
-	bool drcarm7ops_e(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t op);
-	bool drcarm7ops_f(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t op);
-	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param);
+	void generate_jump(drcuml_block &block, compiler_state &compiler, uint32_t targetpc, bool intrablock);
+	void generate_dynamic_jump(drcuml_block &block, compiler_state &compiler);
+	void generate_leave(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_generic(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_native_begin(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t cycles);
+	void generate_native_end(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_condition(drcuml_block &block, uint32_t cond, uml::code_label skip);
+	void generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint32_t cond);
+	void generate_nzcv(drcuml_block &block, bool is_sub);
+	void generate_nz(drcuml_block &block, uml::parameter result);
+	bool generate_arm_alu(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_arm_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_thumb_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+
+	bool m_enable_drc;
+	uint32_t m_drc_options;
+	uint32_t m_drc_flush;           // compiled code may be stale
+	uint32_t m_drc_op;              // instruction for C helpers
+	uint32_t m_drc_nzcv_add[16];    // UML flags to NZCV after an addition
+	uint32_t m_drc_nzcv_sub[16];    // UML flags to NZCV after a subtraction
+	uint32_t m_drc_validate_regs[37]; // registers the interpreter left
+	uint32_t m_drc_validate_pc;     // instruction being checked
+	std::unique_ptr<drc_cache> m_drccache;
+	std::unique_ptr<drcuml_state> m_drcuml;
+	std::unique_ptr<arm7_frontend> m_drcfe;
+	uml::code_handle *m_entry;      // entry point
+	uml::code_handle *m_nocode;     // nocode exception handler
+	uml::code_handle *m_out_of_cycles; // out of cycles exception handler
+	uml::code_handle *m_redispatch; // hands back to execute_run_drc
 
+	void update_reg_ptr();
+	const int* m_reg_group;
 };
 
 
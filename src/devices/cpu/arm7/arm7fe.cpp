@@ -0,0 +1,172 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    arm7fe.cpp
+
+    Front-end for ARM7 recompiler
+
+***************************************************************************/
+
+#include "emu.h"
+#include "arm7fe.h"
+#include "arm7core.h"
+
+
+arm7_frontend::arm7_frontend(arm7_cpu_device &arm7, uint32_t window_start, uint32_t window_end, uint32_t max_sequence)
+	: drc_frontend(arm7, window_start, window_end, max_sequence)
+	, m_arm7(arm7)
+	, m_thumb(false)
+{
+}
+
+
+//-------------------------------------------------
+//  describe_code - describe a sequence of ARM or
+//  Thumb code
+//-------------------------------------------------
+
+const opcode_desc *arm7_frontend::describe_code(offs_t startpc, bool thumb)
+{
+	m_thumb = thumb;
+	return drc_frontend::describe_code(startpc);
+}
+
+
+//-------------------------------------------------
+//  describe_branch - fill in the details of a
+//  branch with a fixed target
+//-------------------------------------------------
+
+void arm7_frontend::describe_branch(opcode_desc &desc, uint32_t targetpc, bool conditional)
+{
+	desc.targetpc = targetpc;
+	if (conditional)
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+	else
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+}
+
+
+//-------------------------------------------------
+//  describe_dynamic_branch - note an instruction
+//  that writes the PC from a register or memory;
+//  only the unconditional ones end the sequence
+//-------------------------------------------------
+
+void arm7_frontend::describe_dynamic_branch(opcode_desc &desc, bool conditional)
+{
+	if (!conditional)
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+}
+
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool arm7_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	// cycles are counted by the code generated for each instruction, or by
+	// the interpreter for the ones left to it
+	desc.length = m_thumb ? 2 : 4;
+	desc.cycles = 0;
+
+	// code that can't be translated without a fault, or isn't in RAM or
+	// ROM, is fetched by the interpreter
+	offs_t physpc;
+	uint32_t const *opptr;
+	if (!m_arm7.drc_code_pointer(desc.pc, physpc, opptr))
+		return false;
+
+	desc.physpc = physpc;
+	uint32_t const word = desc.opptr.l[0] = *opptr;
+	if (m_thumb)
+		describe_thumb(desc, prev, (word >> ((desc.pc & 2) ? m_arm7.m_prefetch_word1_shift : m_arm7.m_prefetch_word0_shift)) & 0xffff);
+	else
+		describe_arm(desc, word);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  describe_arm - build a description of an ARM
+//  instruction
+//-------------------------------------------------
+
+void arm7_frontend::describe_arm(opcode_desc &desc, uint32_t op)
+{
+	desc.userdata0 = op;
+
+	uint32_t const cond = op >> INSN_COND_SHIFT;
+	bool const conditional = cond != COND_AL;
+	bool const writes_pc = (op & INSN_RD) == (15 << INSN_RD_SHIFT);
+
+	if (cond == COND_NV)
+		return;
+
+	if ((op & 0x0e000000) == 0x0a000000) // B, BL
+		describe_branch(desc, desc.pc + 8 + (uint32_t(int32_t(op << 8) >> 8) << 2), conditional);
+	else if ((op & 0x0ffffff0) == 0x012fff10 || (op & 0x0ffffff0) == 0x012fff30) // BX, BLX
+		describe_dynamic_branch(desc, conditional);
+	else if ((op & 0x0c000000) == 0x00000000 && writes_pc) // data processing to PC
+		describe_dynamic_branch(desc, conditional);
+	else if ((op & 0x0c100000) == 0x04100000 && writes_pc) // LDR PC
+		describe_dynamic_branch(desc, conditional);
+	else if ((op & 0x0e108000) == 0x08108000) // LDM with PC
+		describe_dynamic_branch(desc, conditional);
+	else if ((op & 0x0f000000) == 0x0f000000) // SWI
+		describe_dynamic_branch(desc, conditional);
+}
+
+
+//-------------------------------------------------
+//  describe_thumb - build a description of a
+//  Thumb instruction
+//-------------------------------------------------
+
+void arm7_frontend::describe_thumb(opcode_desc &desc, const opcode_desc *prev, uint32_t op)
+{
+	desc.userdata0 = op;
+
+	switch (op >> 11)
+	{
+	case 0x08: // hi register ADD, MOV to PC and BX/BLX
+		if ((op & 0x0400) && ((op & 0x0300) == 0x0300 || ((op & 0x0300) != 0x0100 && (op & 0x0087) == 0x0087)))
+			describe_dynamic_branch(desc, false);
+		break;
+
+	case 0x17: // POP {rlist, PC}
+		if ((op & 0x0700) == 0x0500)
+			describe_dynamic_branch(desc, false);
+		break;
+
+	case 0x1a: case 0x1b: // Bcond, SWI
+		if (((op & THUMB_COND_TYPE) >> THUMB_COND_TYPE_SHIFT) < COND_AL)
+			describe_branch(desc, desc.pc + 4 + (uint32_t(int8_t(op & 0xff)) << 1), true);
+		else
+			describe_dynamic_branch(desc, false);
+		break;
+
+	case 0x1c: // B
+		describe_branch(desc, desc.pc + 4 + (uint32_t(int32_t((op & THUMB_BRANCH_OFFS) << 21) >> 20)), false);
+		break;
+
+	case 0x1d: // BLX suffix
+		describe_dynamic_branch(desc, false);
+		break;
+
+	case 0x1f: // BL suffix; the target is only known following its prefix
+		if (prev != nullptr && prev->pc == desc.pc - 2 && (prev->userdata0 & 0xf800) == 0xf000)
+		{
+			uint32_t const lr = prev->pc + 4 + (uint32_t(int32_t((prev->userdata0 & THUMB_BLOP_OFFS) << 21) >> 9));
+			describe_branch(desc, lr + ((op & THUMB_BLOP_OFFS) << 1), false);
+		}
+		else
+		{
+			describe_dynamic_branch(desc, false);
+		}
+		break;
+	}
+}
@@ -0,0 +1,42 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    arm7fe.h
+
+    Front-end for ARM7 recompiler
+
+***************************************************************************/
+
+#ifndef MAME_CPU_ARM7_ARM7FE_H
+#define MAME_CPU_ARM7_ARM7FE_H
+
+#pragma once
+
+#include "arm7.h"
+#include "cpu/drcfe.h"
+
+
+class arm7_frontend : public drc_frontend
+{
+public:
+	arm7_frontend(arm7_cpu_device &arm7, uint32_t window_start, uint32_t window_end, uint32_t max_sequence);
+
+	// describe ARM or Thumb code; the two can't be mixed in a block
+	const opcode_desc *describe_code(offs_t startpc, bool thumb);
+
+protected:
+	// required overrides
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	void describe_arm(opcode_desc &desc, uint32_t op);
+	void describe_thumb(opcode_desc &desc, const opcode_desc *prev, uint32_t op);
+	void describe_branch(opcode_desc &desc, uint32_t targetpc, bool conditional);
+	void describe_dynamic_branch(opcode_desc &desc, bool conditional);
+
+	arm7_cpu_device &m_arm7;
+	bool m_thumb;
+};
+
+#endif // MAME_CPU_ARM7_ARM7FE_H
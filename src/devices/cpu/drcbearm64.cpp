@@ -0,0 +1,4215 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    drcbearm64.cpp
+
+    64-bit ARM (AArch64) back-end for the universal machine language.
+
+****************************************************************************
+
+    Future improvements/changes:
+
+    * Track which UML flags are live and avoid materialising the carry
+      for subtraction when nothing consumes it
+
+    * Use ADRP to reach data outside the 16MB window around the base
+      register instead of loading absolute addresses
+
+    * Fuse compare and conditional branch into CBZ/TBZ where possible
+
+****************************************************************************
+
+    ---------------------
+    ABI/conventions (AAPCS64)
+    ---------------------
+
+    Registers:
+        X0-X7      - volatile, integer function parameters/results
+        X8         - volatile, indirect result location
+        X9-X15     - volatile, temporaries
+        X16-X17    - volatile, intra-procedure-call scratch (IP0/IP1)
+        X18        - platform register, never touched
+        X19-X28    - non-volatile
+        X29        - frame pointer
+        X30        - link register
+        SP         - stack pointer, must stay 16-byte aligned
+
+        D0-D7      - volatile, FP function parameters/results
+        D8-D15     - non-volatile (low 64 bits only)
+        D16-D31    - volatile
+
+    Register usage:
+        X0-X3      - function call parameters
+        X9-X15     - temporaries
+        X16        - scratch for forming absolute addresses
+        X17        - scratch for immediates and flag manipulation
+        X19-X26    - UML I0-I7
+        X27        - base register (points to the near cache)
+        X28        - UML I8
+        X30        - return address, pushed by handle prologs
+
+        D0-D2      - floating point temporaries
+        D8-D15     - UML F0-F7
+
+    Everything else (I9, F8-F9, EXP, FMOD and the saved flags) lives in
+    the machine state in the near cache.
+
+****************************************************************************
+
+    Flags:
+
+    UML flags are kept in the host NZCV register between instructions.
+    N, Z and V map directly to S, Z and V.  The host C flag always holds
+    the UML carry in the x86 sense (set on borrow after a subtraction),
+    so it is inverted after SUB/SUBB/CMP when the carry is requested.
+    The unordered flag produced by FCMP shares the host V flag.
+
+****************************************************************************
+
+    Execution model:
+
+    The entry point saves the callee-saved registers, loads the base
+    register and FPCR state, records the stack pointer and branches to
+    the target code.  Code reached through HASHJMP runs with the stack
+    pointer reset to that saved value.  Handles are entered with BL and
+    begin with a prolog that pushes the link register, so the stack
+    stays 16-byte aligned and RET simply pops it.  The exit point
+    restores the stack pointer, FPCR and saved registers and returns
+    the value left in W0.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "drcbearm64.h"
+
+#include "debug/debugcpu.h"
+#include "emuopts.h"
+
+#include <cstddef>
+
+
+namespace drc {
+
+using namespace uml;
+
+using namespace asmjit;
+using namespace asmjit::a64;
+
+
+
+//**************************************************************************
+//  DEBUGGING
+//**************************************************************************
+
+#define LOG_HASHJMPS            (0)
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+const uint32_t PTYPE_M    = 1 << parameter::PTYPE_MEMORY;
+const uint32_t PTYPE_I    = 1 << parameter::PTYPE_IMMEDIATE;
+const uint32_t PTYPE_R    = 1 << parameter::PTYPE_INT_REGISTER;
+const uint32_t PTYPE_F    = 1 << parameter::PTYPE_FLOAT_REGISTER;
+const uint32_t PTYPE_V    = 1 << parameter::PTYPE_VECTOR_REGISTER;
+//const uint32_t PTYPE_MI   = PTYPE_M | PTYPE_I;
+//const uint32_t PTYPE_RI   = PTYPE_R | PTYPE_I;
+const uint32_t PTYPE_MR   = PTYPE_M | PTYPE_R;
+const uint32_t PTYPE_MRI  = PTYPE_M | PTYPE_R | PTYPE_I;
+const uint32_t PTYPE_MF   = PTYPE_M | PTYPE_F;
+const uint32_t PTYPE_MV   = PTYPE_M | PTYPE_V;
+
+const a64::Gp REG_PARAM1   = x0;
+const a64::Gp REG_PARAM2   = x1;
+const a64::Gp REG_PARAM3   = x2;
+const a64::Gp REG_PARAM4   = x3;
+
+const a64::Gp TEMP_REG1    = x9;
+const a64::Gp TEMP_REG2    = x10;
+const a64::Gp TEMP_REG3    = x11;
+const a64::Gp TEMP_REG4    = x12;
+const a64::Gp TEMP_REG5    = x13;
+const a64::Gp TEMP_REG6    = x14;
+
+const a64::Gp SCRATCH_REG1 = x16;
+const a64::Gp SCRATCH_REG2 = x17;
+
+const a64::Gp BASE_REG     = x27;
+
+const a64::Vec TEMPF_REG1  = d0;
+const a64::Vec TEMPF_REG2  = d1;
+const a64::Vec TEMPF_REG3  = d2;
+
+// NZCV bit positions
+const uint32_t NZCV_N = 1 << 31;
+const uint32_t NZCV_Z = 1 << 30;
+const uint32_t NZCV_C = 1 << 29;
+const uint32_t NZCV_V = 1 << 28;
+
+// FPCR rounding mode field
+const uint32_t FPCR_RMODE_SHIFT = 22;
+
+
+
+//**************************************************************************
+//  MACROS
+//**************************************************************************
+
+#define ARM_CONDITION(condition)        (condition_map[condition - uml::COND_Z])
+#define ARM_NOT_CONDITION(condition)    negateCond(condition_map[condition - uml::COND_Z])
+
+#define assert_no_condition(inst)       assert((inst).condition() == uml::COND_ALWAYS)
+#define assert_any_condition(inst)      assert((inst).condition() == uml::COND_ALWAYS || ((inst).condition() >= uml::COND_Z && (inst).condition() < uml::COND_MAX))
+#define assert_no_flags(inst)           assert((inst).flags() == 0)
+#define assert_flags(inst, valid)       assert(((inst).flags() & ~(valid)) == 0)
+
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+drcbe_arm64::opcode_generate_func drcbe_arm64::s_opcode_table[OP_MAX];
+
+// register mapping tables
+static const uint32_t int_register_map[REG_I_COUNT] =
+{
+	19, 20, 21, 22, 23, 24, 25, 26, 28
+};
+
+static const uint32_t float_register_map[REG_F_COUNT] =
+{
+	8, 9, 10, 11, 12, 13, 14, 15
+};
+
+// condition mapping table; COND_A and COND_BE need two tests and are handled separately
+static const CondCode condition_map[uml::COND_MAX - uml::COND_Z] =
+{
+	CondCode::kEQ,   // COND_Z = 0x80,    requires Z
+	CondCode::kNE,   // COND_NZ,          requires Z
+	CondCode::kMI,   // COND_S,           requires S
+	CondCode::kPL,   // COND_NS,          requires S
+	CondCode::kCS,   // COND_C,           requires C
+	CondCode::kCC,   // COND_NC,          requires C
+	CondCode::kVS,   // COND_V,           requires V
+	CondCode::kVC,   // COND_NV,          requires V
+	CondCode::kVS,   // COND_U,           requires U
+	CondCode::kVC,   // COND_NU,          requires U
+	CondCode::kNA,   // COND_A,           requires CZ
+	CondCode::kNA,   // COND_BE,          requires CZ
+	CondCode::kGT,   // COND_G,           requires SVZ
+	CondCode::kLE,   // COND_LE,          requires SVZ
+	CondCode::kLT,   // COND_L,           requires SV
+	CondCode::kGE,   // COND_GE,          requires SV
+};
+
+
+
+//**************************************************************************
+//  TABLES
+//**************************************************************************
+
+const drcbe_arm64::opcode_table_entry drcbe_arm64::s_opcode_table_source[] =
+{
+	// Compile-time opcodes
+	{ uml::OP_HANDLE,  &drcbe_arm64::op_handle },   // HANDLE  handle
+	{ uml::OP_HASH,    &drcbe_arm64::op_hash },     // HASH    mode,pc
+	{ uml::OP_LABEL,   &drcbe_arm64::op_label },    // LABEL   imm
+	{ uml::OP_COMMENT, &drcbe_arm64::op_comment },  // COMMENT string
+	{ uml::OP_MAPVAR,  &drcbe_arm64::op_mapvar },   // MAPVAR  mapvar,value
+
+	// Control Flow Operations
+	{ uml::OP_NOP,     &drcbe_arm64::op_nop },      // NOP
+	{ uml::OP_DEBUG,   &drcbe_arm64::op_debug },    // DEBUG   pc
+	{ uml::OP_EXIT,    &drcbe_arm64::op_exit },     // EXIT    src1[,c]
+	{ uml::OP_HASHJMP, &drcbe_arm64::op_hashjmp },  // HASHJMP mode,pc,handle
+	{ uml::OP_JMP,     &drcbe_arm64::op_jmp },      // JMP     imm[,c]
+	{ uml::OP_EXH,     &drcbe_arm64::op_exh },      // EXH     handle,param[,c]
+	{ uml::OP_CALLH,   &drcbe_arm64::op_callh },    // CALLH   handle[,c]
+	{ uml::OP_RET,     &drcbe_arm64::op_ret },      // RET     [c]
+	{ uml::OP_CALLC,   &drcbe_arm64::op_callc },    // CALLC   func,ptr[,c]
+	{ uml::OP_RECOVER, &drcbe_arm64::op_recover },  // RECOVER dst,mapvar
+
+	// Internal Register Operations
+	{ uml::OP_SETFMOD, &drcbe_arm64::op_setfmod },  // SETFMOD src
+	{ uml::OP_GETFMOD, &drcbe_arm64::op_getfmod },  // GETFMOD dst
+	{ uml::OP_GETEXP,  &drcbe_arm64::op_getexp },   // GETEXP  dst
+	{ uml::OP_GETFLGS, &drcbe_arm64::op_getflgs },  // GETFLGS dst[,f]
+	{ uml::OP_SAVE,    &drcbe_arm64::op_save },     // SAVE    dst
+	{ uml::OP_RESTORE, &drcbe_arm64::op_restore },  // RESTORE dst
+
+	// Integer Operations
+	{ uml::OP_LOAD,    &drcbe_arm64::op_load },     // LOAD    dst,base,index,size
+	{ uml::OP_LOADS,   &drcbe_arm64::op_loads },    // LOADS   dst,base,index,size
+	{ uml::OP_STORE,   &drcbe_arm64::op_store },    // STORE   base,index,src,size
+	{ uml::OP_READ,    &drcbe_arm64::op_read },     // READ    dst,src1,spacesize
+	{ uml::OP_READM,   &drcbe_arm64::op_readm },    // READM   dst,src1,mask,spacesize
+	{ uml::OP_WRITE,   &drcbe_arm64::op_write },    // WRITE   dst,src1,spacesize
+	{ uml::OP_WRITEM,  &drcbe_arm64::op_writem },   // WRITEM  dst,src1,spacesize
+	{ uml::OP_CARRY,   &drcbe_arm64::op_carry },    // CARRY   src,bitnum
+	{ uml::OP_SET,     &drcbe_arm64::op_set },      // SET     dst,c
+	{ uml::OP_MOV,     &drcbe_arm64::op_mov },      // MOV     dst,src[,c]
+	{ uml::OP_SEXT,    &drcbe_arm64::op_sext },     // SEXT    dst,src
+	{ uml::OP_ROLAND,  &drcbe_arm64::op_roland },   // ROLAND  dst,src1,src2,src3
+	{ uml::OP_ROLINS,  &drcbe_arm64::op_rolins },   // ROLINS  dst,src1,src2,src3
+	{ uml::OP_ADD,     &drcbe_arm64::op_add },      // ADD     dst,src1,src2[,f]
+	{ uml::OP_ADDC,    &drcbe_arm64::op_addc },     // ADDC    dst,src1,src2[,f]
+	{ uml::OP_SUB,     &drcbe_arm64::op_sub },      // SUB     dst,src1,src2[,f]
+	{ uml::OP_SUBB,    &drcbe_arm64::op_subc },     // SUBB    dst,src1,src2[,f]
+	{ uml::OP_CMP,     &drcbe_arm64::op_cmp },      // CMP     src1,src2[,f]
+	{ uml::OP_MULU,    &drcbe_arm64::op_mulu },     // MULU    dst,edst,src1,src2[,f]
+	{ uml::OP_MULS,    &drcbe_arm64::op_muls },     // MULS    dst,edst,src1,src2[,f]
+	{ uml::OP_DIVU,    &drcbe_arm64::op_divu },     // DIVU    dst,edst,src1,src2[,f]
+	{ uml::OP_DIVS,    &drcbe_arm64::op_divs },     // DIVS    dst,edst,src1,src2[,f]
+	{ uml::OP_AND,     &drcbe_arm64::op_and },      // AND     dst,src1,src2[,f]
+	{ uml::OP_TEST,    &drcbe_arm64::op_test },     // TEST    src1,src2[,f]
+	{ uml::OP_OR,      &drcbe_arm64::op_or },       // OR      dst,src1,src2[,f]
+	{ uml::OP_XOR,     &drcbe_arm64::op_xor },      // XOR     dst,src1,src2[,f]
+	{ uml::OP_LZCNT,   &drcbe_arm64::op_lzcnt },    // LZCNT   dst,src[,f]
+	{ uml::OP_TZCNT,   &drcbe_arm64::op_tzcnt },    // TZCNT   dst,src[,f]
+	{ uml::OP_BSWAP,   &drcbe_arm64::op_bswap },    // BSWAP   dst,src
+	{ uml::OP_SHL,     &drcbe_arm64::op_shift<uml::OP_SHL> },       // SHL     dst,src,count[,f]
+	{ uml::OP_SHR,     &drcbe_arm64::op_shift<uml::OP_SHR> },       // SHR     dst,src,count[,f]
+	{ uml::OP_SAR,     &drcbe_arm64::op_shift<uml::OP_SAR> },       // SAR     dst,src,count[,f]
+	{ uml::OP_ROL,     &drcbe_arm64::op_shift<uml::OP_ROL> },       // ROL     dst,src,count[,f]
+	{ uml::OP_ROLC,    &drcbe_arm64::op_rotc<uml::OP_ROLC> },       // ROLC    dst,src,count[,f]
+	{ uml::OP_ROR,     &drcbe_arm64::op_shift<uml::OP_ROR> },       // ROR     dst,src,count[,f]
+	{ uml::OP_RORC,    &drcbe_arm64::op_rotc<uml::OP_RORC> },       // RORC    dst,src,count[,f]
+
+	// Floating Point Operations
+	{ uml::OP_FLOAD,   &drcbe_arm64::op_fload },    // FLOAD   dst,base,index
+	{ uml::OP_FSTORE,  &drcbe_arm64::op_fstore },   // FSTORE  base,index,src
+	{ uml::OP_FREAD,   &drcbe_arm64::op_fread },    // FREAD   dst,space,src1
+	{ uml::OP_FWRITE,  &drcbe_arm64::op_fwrite },   // FWRITE  space,dst,src1
+	{ uml::OP_FMOV,    &drcbe_arm64::op_fmov },     // FMOV    dst,src1[,c]
+	{ uml::OP_FTOINT,  &drcbe_arm64::op_ftoint },   // FTOINT  dst,src1,size,round
+	{ uml::OP_FFRINT,  &drcbe_arm64::op_ffrint },   // FFRINT  dst,src1,size
+	{ uml::OP_FFRFLT,  &drcbe_arm64::op_ffrflt },   // FFRFLT  dst,src1,size
+	{ uml::OP_FRNDS,   &drcbe_arm64::op_frnds },    // FRNDS   dst,src1
+	{ uml::OP_FADD,    &drcbe_arm64::op_float_alu<a64::Inst::kIdFadd_v> },      // FADD    dst,src1,src2
+	{ uml::OP_FSUB,    &drcbe_arm64::op_float_alu<a64::Inst::kIdFsub_v> },      // FSUB    dst,src1,src2
+	{ uml::OP_FCMP,    &drcbe_arm64::op_fcmp },     // FCMP    src1,src2
+	{ uml::OP_FMUL,    &drcbe_arm64::op_float_alu<a64::Inst::kIdFmul_v> },      // FMUL    dst,src1,src2
+	{ uml::OP_FDIV,    &drcbe_arm64::op_float_alu<a64::Inst::kIdFdiv_v> },      // FDIV    dst,src1,src2
+	{ uml::OP_FNEG,    &drcbe_arm64::op_float_alu2<a64::Inst::kIdFneg_v> },     // FNEG    dst,src1
+	{ uml::OP_FABS,    &drcbe_arm64::op_float_alu2<a64::Inst::kIdFabs_v> },     // FABS    dst,src1
+	{ uml::OP_FSQRT,   &drcbe_arm64::op_float_alu2<a64::Inst::kIdFsqrt_v> },    // FSQRT   dst,src1
+	{ uml::OP_FRECIP,  &drcbe_arm64::op_frecip },   // FRECIP  dst,src1
+	{ uml::OP_FRSQRT,  &drcbe_arm64::op_frsqrt },   // FRSQRT  dst,src1
+	{ uml::OP_FCOPYI,  &drcbe_arm64::op_fcopyi },   // FCOPYI  dst,src
+	{ uml::OP_ICOPYF,  &drcbe_arm64::op_icopyf },   // ICOPYF  dst,src
+
+	// 128-bit vector operations
+	{ uml::OP_VMOV,    &drcbe_arm64::op_vmov },     // VMOV    dst,src
+	{ uml::OP_VADD,    &drcbe_arm64::op_vadd },     // VADD    dst,src1,src2,size
+	{ uml::OP_VSUB,    &drcbe_arm64::op_vsub },     // VSUB    dst,src1,src2,size
+	{ uml::OP_VADDS,   &drcbe_arm64::op_vadds },    // VADDS   dst,src1,src2,size
+	{ uml::OP_VSUBS,   &drcbe_arm64::op_vsubs },    // VSUBS   dst,src1,src2,size
+	{ uml::OP_VFADD,   &drcbe_arm64::op_vfadd },    // VFADD   dst,src1,src2
+	{ uml::OP_VFSUB,   &drcbe_arm64::op_vfsub },    // VFSUB   dst,src1,src2
+	{ uml::OP_VFMUL,   &drcbe_arm64::op_vfmul },    // VFMUL   dst,src1,src2
+	{ uml::OP_VFMIN,   &drcbe_arm64::op_vfmin },    // VFMIN   dst,src1,src2
+	{ uml::OP_VFMAX,   &drcbe_arm64::op_vfmax },    // VFMAX   dst,src1,src2
+	{ uml::OP_VSHUF,   &drcbe_arm64::op_vshuf }     // VSHUF   dst,src,lanes
+};
+
+namespace {
+
+class ThrowableErrorHandler : public ErrorHandler
+{
+public:
+	void handleError(Error err, const char *message, BaseEmitter *origin) override
+	{
+		throw emu_fatalerror("asmjit error %d: %s", err, message);
+	}
+};
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  select_register - return the 32- or 64-bit
+//  view of a register
+//-------------------------------------------------
+
+static inline a64::Gp select_register(a64::Gp const &reg, uint32_t regsize)
+{
+	return (regsize == 4) ? a64::Gp(reg.w()) : a64::Gp(reg.x());
+}
+
+static inline a64::Vec select_register(a64::Vec const &reg, uint32_t regsize)
+{
+	return (regsize == 4) ? a64::Vec(reg.s()) : a64::Vec(reg.d());
+}
+
+
+//-------------------------------------------------
+//  param_normalize - convert a full parameter
+//  into a reduced set
+//-------------------------------------------------
+
+drcbe_arm64::be_parameter::be_parameter(drcbe_arm64 &drcbe, const parameter &param, uint32_t allowed)
+{
+	int regnum;
+
+	switch (param.type())
+	{
+		// immediates pass through
+		case parameter::PTYPE_IMMEDIATE:
+			assert(allowed & PTYPE_I);
+			*this = param.immediate();
+			break;
+
+		// memory passes through
+		case parameter::PTYPE_MEMORY:
+			assert(allowed & PTYPE_M);
+			*this = make_memory(param.memory());
+			break;
+
+		// if a register maps to a register, keep it as a register; otherwise map it to memory
+		case parameter::PTYPE_INT_REGISTER:
+			assert(allowed & PTYPE_R);
+			assert(allowed & PTYPE_M);
+			regnum = int_register_map[param.ireg() - REG_I0];
+			if (regnum != 0)
+				*this = make_ireg(regnum);
+			else
+				*this = make_memory(&drcbe.m_state.r[param.ireg() - REG_I0]);
+			break;
+
+		// if a register maps to a register, keep it as a register; otherwise map it to memory
+		case parameter::PTYPE_FLOAT_REGISTER:
+			assert(allowed & PTYPE_F);
+			assert(allowed & PTYPE_M);
+			regnum = float_register_map[param.freg() - REG_F0];
+			if (regnum != 0)
+				*this = make_freg(regnum);
+			else
+				*this = make_memory(&drcbe.m_state.f[param.freg() - REG_F0]);
+			break;
+
+		// vector registers always live in memory
+		case parameter::PTYPE_VECTOR_REGISTER:
+			assert(allowed & PTYPE_V);
+			assert(allowed & PTYPE_M);
+			*this = make_memory(&drcbe.m_state.v[param.vreg() - REG_V0]);
+			break;
+
+		// everything else is unexpected
+		default:
+			fatalerror("Unexpected parameter type\n");
+	}
+}
+
+
+//-------------------------------------------------
+//  select_register - select a register to use,
+//  preferring the parameter's own register
+//-------------------------------------------------
+
+inline a64::Gp drcbe_arm64::be_parameter::select_register(a64::Gp const &defreg, uint32_t regsize) const
+{
+	if (m_type == PTYPE_INT_REGISTER)
+		return (regsize == 4) ? a64::Gp(w(m_value)) : a64::Gp(x(m_value));
+	return (regsize == 4) ? a64::Gp(defreg.w()) : a64::Gp(defreg.x());
+}
+
+inline a64::Vec drcbe_arm64::be_parameter::select_register(a64::Vec const &defreg, uint32_t regsize) const
+{
+	if (m_type == PTYPE_FLOAT_REGISTER)
+		return (regsize == 4) ? a64::Vec(s(m_value)) : a64::Vec(d(m_value));
+	return (regsize == 4) ? a64::Vec(defreg.s()) : a64::Vec(defreg.d());
+}
+
+
+//-------------------------------------------------
+//  is_valid_immediate_mask - return true if the
+//  value can be encoded as a logical immediate
+//-------------------------------------------------
+
+inline bool drcbe_arm64::is_valid_immediate_mask(uint64_t val, uint32_t bytes)
+{
+	if (bytes == 4)
+		val &= 0xffffffff;
+	return a64::Utils::isLogicalImm(val, bytes * 8);
+}
+
+
+//-------------------------------------------------
+//  is_valid_offset - return true if the offset
+//  can be encoded directly in a load or store
+//  of the given size
+//-------------------------------------------------
+
+static inline bool is_valid_offset(int64_t offset, uint32_t bytes)
+{
+	// unsigned offset scaled by the access size
+	if ((offset >= 0) && (offset < (int64_t(4096) * bytes)) && !(offset & (bytes - 1)))
+		return true;
+
+	// signed unscaled offset
+	return (offset >= -256) && (offset < 256);
+}
+
+
+//-------------------------------------------------
+//  get_mem_absolute - return a memory operand
+//  for the given address, using the base
+//  register where possible
+//-------------------------------------------------
+
+inline a64::Mem drcbe_arm64::get_mem_absolute(a64::Assembler &a, const void *ptr, uint32_t bytes) const
+{
+	int64_t const delta = reinterpret_cast<const uint8_t *>(ptr) - m_baseptr;
+
+	// direct offset from the base register
+	if (is_valid_offset(delta, bytes))
+		return a64::ptr(BASE_REG, int32_t(delta));
+
+	// within 16MB of the base register: add the upper bits and use the lower ones as an offset
+	if ((delta >= 0) && (delta < (1 << 24)))
+	{
+		int64_t const lower = delta & 0xfff;
+		a.add(SCRATCH_REG1, BASE_REG, delta & ~int64_t(0xfff));                         // add   scratch,base,upper
+		if (is_valid_offset(lower, bytes))
+			return a64::ptr(SCRATCH_REG1, int32_t(lower));
+		a.add(SCRATCH_REG1, SCRATCH_REG1, lower);                                       // add   scratch,scratch,lower
+		return a64::ptr(SCRATCH_REG1);
+	}
+
+	// everything else needs the full address
+	a.mov(SCRATCH_REG1, uintptr_t(ptr));                                                // mov   scratch,ptr
+	return a64::ptr(SCRATCH_REG1);
+}
+
+
+//-------------------------------------------------
+//  get_imm_relative - load the address of the
+//  given pointer into a register
+//-------------------------------------------------
+
+inline void drcbe_arm64::get_imm_relative(a64::Assembler &a, a64::Gp const &reg, uint64_t ptr) const
+{
+	int64_t const delta = int64_t(ptr - uint64_t(uintptr_t(m_baseptr)));
+	uint64_t const magnitude = (delta < 0) ? -uint64_t(delta) : uint64_t(delta);
+
+	if (magnitude < (1 << 24))
+	{
+		Inst::Id const opcode = (delta < 0) ? Inst::kIdSub : Inst::kIdAdd;
+		uint64_t const upper = magnitude & ~uint64_t(0xfff);
+		uint64_t const lower = magnitude & 0xfff;
+		if (upper)
+		{
+			a.emit(opcode, reg, BASE_REG, upper);                                       // add   reg,base,upper
+			if (lower)
+				a.emit(opcode, reg, reg, lower);                                        // add   reg,reg,lower
+		}
+		else
+		{
+			a.emit(opcode, reg, BASE_REG, lower);                                       // add   reg,base,lower
+		}
+	}
+	else
+	{
+		a.mov(reg, ptr);                                                                // mov   reg,ptr
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_ldr_mem/emit_str_mem - load or store a
+//  register from/to an absolute address
+//-------------------------------------------------
+
+inline void drcbe_arm64::emit_ldr_mem(a64::Assembler &a, a64::Gp const &reg, const void *ptr) const
+{
+	a.ldr(reg, get_mem_absolute(a, ptr, reg.isGpW() ? 4 : 8));
+}
+
+inline void drcbe_arm64::emit_ldrb_mem(a64::Assembler &a, a64::Gp const &reg, const void *ptr) const
+{
+	a.ldrb(reg.w(), get_mem_absolute(a, ptr, 1));
+}
+
+inline void drcbe_arm64::emit_ldrh_mem(a64::Assembler &a, a64::Gp const &reg, const void *ptr) const
+{
+	a.ldrh(reg.w(), get_mem_absolute(a, ptr, 2));
+}
+
+inline void drcbe_arm64::emit_str_mem(a64::Assembler &a, a64::Gp const &reg, const void *ptr) const
+{
+	a.str(reg, get_mem_absolute(a, ptr, reg.isGpW() ? 4 : 8));
+}
+
+inline void drcbe_arm64::emit_strb_mem(a64::Assembler &a, a64::Gp const &reg, const void *ptr) const
+{
+	a.strb(reg.w(), get_mem_absolute(a, ptr, 1));
+}
+
+inline void drcbe_arm64::emit_strh_mem(a64::Assembler &a, a64::Gp const &reg, const void *ptr) const
+{
+	a.strh(reg.w(), get_mem_absolute(a, ptr, 2));
+}
+
+inline void drcbe_arm64::emit_float_ldr_mem(a64::Assembler &a, a64::Vec const &reg, const void *ptr) const
+{
+	a.ldr(reg, get_mem_absolute(a, ptr, reg.isVecS() ? 4 : reg.isVecD() ? 8 : 16));
+}
+
+inline void drcbe_arm64::emit_float_str_mem(a64::Assembler &a, a64::Vec const &reg, const void *ptr) const
+{
+	a.str(reg, get_mem_absolute(a, ptr, reg.isVecS() ? 4 : reg.isVecD() ? 8 : 16));
+}
+
+
+//-------------------------------------------------
+//  call_arm_addr - generate a call either
+//  directly or via a register
+//-------------------------------------------------
+
+inline void drcbe_arm64::call_arm_addr(a64::Assembler &a, const void *target) const
+{
+	int64_t const offset = int64_t(uintptr_t(target)) - int64_t(a.code()->baseAddress() + a.offset());
+	if ((offset >= -(int64_t(1) << 27)) && (offset < (int64_t(1) << 27)))
+	{
+		a.bl(Imm(target));                                                              // bl    target
+	}
+	else
+	{
+		a.mov(SCRATCH_REG1, uintptr_t(target));                                         // mov   scratch,target
+		a.blr(SCRATCH_REG1);                                                            // blr   scratch
+	}
+}
+
+
+//-------------------------------------------------
+//  jmp_arm_addr - generate a jump either
+//  directly or via a register
+//-------------------------------------------------
+
+inline void drcbe_arm64::jmp_arm_addr(a64::Assembler &a, const void *target) const
+{
+	int64_t const offset = int64_t(uintptr_t(target)) - int64_t(a.code()->baseAddress() + a.offset());
+	if ((offset >= -(int64_t(1) << 27)) && (offset < (int64_t(1) << 27)))
+	{
+		a.b(Imm(target));                                                               // b     target
+	}
+	else
+	{
+		a.mov(SCRATCH_REG1, uintptr_t(target));                                         // mov   scratch,target
+		a.br(SCRATCH_REG1);                                                             // br    scratch
+	}
+}
+
+
+//-------------------------------------------------
+//  get_label - find or create the label for a
+//  UML code label
+//-------------------------------------------------
+
+inline Label drcbe_arm64::get_label(a64::Assembler &a, code_label const &label) const
+{
+	std::string labelName = util::string_format("PC$%x", label);
+	Label result = a.labelByName(labelName.c_str());
+	if (!result.isValid())
+		result = a.newNamedLabel(labelName.c_str());
+	return result;
+}
+
+
+//-------------------------------------------------
+//  emit_skip - branch to the given label if the
+//  condition is false
+//-------------------------------------------------
+
+void drcbe_arm64::emit_skip(a64::Assembler &a, condition_t cond, Label const &skip) const
+{
+	switch (cond)
+	{
+		case uml::COND_ALWAYS:
+			break;
+
+		// A is C clear and Z clear
+		case uml::COND_A:
+			a.b_cs(skip);                                                               // b.cs  skip
+			a.b_eq(skip);                                                               // b.eq  skip
+			break;
+
+		// BE is C set or Z set
+		case uml::COND_BE:
+		{
+			Label take = a.newLabel();
+			a.b_cs(take);                                                               // b.cs  take
+			a.b_ne(skip);                                                               // b.ne  skip
+			a.bind(take);                                                           // take:
+			break;
+		}
+
+		default:
+			a.b(ARM_NOT_CONDITION(cond), skip);                                         // b.!cc skip
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  emit_cset - set a register to 1 if the
+//  condition is true or 0 otherwise
+//-------------------------------------------------
+
+void drcbe_arm64::emit_cset(a64::Assembler &a, condition_t cond, a64::Gp const &reg) const
+{
+	switch (cond)
+	{
+		case uml::COND_ALWAYS:
+			a.mov(reg, 1);                                                              // mov   reg,1
+			break;
+
+		case uml::COND_A:
+			a.cset(reg, CondCode::kNE);                                                 // cset  reg,ne
+			a.csel(reg, reg, reg.isGpW() ? a64::Gp(wzr) : a64::Gp(xzr), CondCode::kCC); // csel  reg,reg,zr,cc
+			break;
+
+		case uml::COND_BE:
+			a.cset(reg, CondCode::kEQ);                                                 // cset  reg,eq
+			a.csinc(reg, reg, reg.isGpW() ? a64::Gp(wzr) : a64::Gp(xzr), CondCode::kCC); // csinc reg,reg,zr,cc
+			break;
+
+		default:
+			a.cset(reg, ARM_CONDITION(cond));                                           // cset  reg,cc
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  invert_carry - flip the host carry flag so it
+//  follows the UML (borrow) convention
+//-------------------------------------------------
+
+inline void drcbe_arm64::invert_carry(a64::Assembler &a) const
+{
+	a.mrs(SCRATCH_REG2, Imm(a64::Predicate::SysReg::kNZCV));                            // mrs   scratch,nzcv
+	a.eor(SCRATCH_REG2, SCRATCH_REG2, NZCV_C);                                          // eor   scratch,scratch,#C
+	a.msr(Imm(a64::Predicate::SysReg::kNZCV), SCRATCH_REG2);                            // msr   nzcv,scratch
+}
+
+
+//-------------------------------------------------
+//  load_carry - read the UML carry into bit 0 of
+//  a register
+//-------------------------------------------------
+
+inline void drcbe_arm64::load_carry(a64::Assembler &a, a64::Gp const &reg) const
+{
+	a.cset(reg, CondCode::kCS);                                                         // cset  reg,cs
+}
+
+
+//-------------------------------------------------
+//  store_carry_reg - set the host carry flag from
+//  bit 0 of a register, preserving N, Z and V
+//-------------------------------------------------
+
+inline void drcbe_arm64::store_carry_reg(a64::Assembler &a, a64::Gp const &reg) const
+{
+	a.mrs(SCRATCH_REG2, Imm(a64::Predicate::SysReg::kNZCV));                            // mrs   scratch,nzcv
+	a.bfi(SCRATCH_REG2, reg.x(), 29, 1);                                                // bfi   scratch,reg,29,1
+	a.msr(Imm(a64::Predicate::SysReg::kNZCV), SCRATCH_REG2);                            // msr   nzcv,scratch
+}
+
+
+//-------------------------------------------------
+//  store_nzcv - build the host flags from 0/1
+//  values for Z, N and V, with C cleared
+//-------------------------------------------------
+
+inline void drcbe_arm64::store_nzcv(a64::Assembler &a, a64::Gp const &z, a64::Gp const &n, a64::Gp const &v) const
+{
+	a.lsl(SCRATCH_REG2, n.x(), 31);                                                     // lsl   scratch,n,31
+	a.orr(SCRATCH_REG2, SCRATCH_REG2, z.x(), arm::lsl(30));                             // orr   scratch,scratch,z,lsl 30
+	a.orr(SCRATCH_REG2, SCRATCH_REG2, v.x(), arm::lsl(28));                             // orr   scratch,scratch,v,lsl 28
+	a.msr(Imm(a64::Predicate::SysReg::kNZCV), SCRATCH_REG2);                            // msr   nzcv,scratch
+}
+
+
+//-------------------------------------------------
+//  emit_fpcr_rounding - insert a UML rounding
+//  mode (0-3) into the FPCR rounding field
+//-------------------------------------------------
+
+inline void drcbe_arm64::emit_fpcr_rounding(a64::Assembler &a, a64::Gp const &fmodreg) const
+{
+	// UML order is trunc/round/ceil/floor; the FPCR order is nearest/+inf/-inf/zero
+	a.sub(TEMP_REG4.w(), fmodreg.w(), 1);                                               // sub   temp,fmod,1
+	a.mrs(SCRATCH_REG2, Imm(a64::Predicate::SysReg::kFPCR));                            // mrs   scratch,fpcr
+	a.bfi(SCRATCH_REG2, TEMP_REG4, FPCR_RMODE_SHIFT, 2);                                // bfi   scratch,temp,22,2
+	a.msr(Imm(a64::Predicate::SysReg::kFPCR), SCRATCH_REG2);                            // msr   fpcr,scratch
+}
+
+
+
+//**************************************************************************
+//  BACKEND CALLBACKS
+//**************************************************************************
+
+//-------------------------------------------------
+//  drcbe_arm64 - constructor
+//-------------------------------------------------
+
+drcbe_arm64::drcbe_arm64(drcuml_state &drcuml, device_t &device, drc_cache &cache, uint32_t flags, int modes, int addrbits, int ignorebits)
+	: drcbe_interface(drcuml, cache, device)
+	, m_hash(cache, modes, addrbits, ignorebits)
+	, m_map(cache, 0xaaaaaaaa5555)
+	, m_log_asmjit(nullptr)
+	, m_baseptr(cache.near())
+	, m_entry(nullptr)
+	, m_exit(nullptr)
+	, m_nocode(nullptr)
+	, m_near(*(near_state *)cache.alloc_near(sizeof(m_near)))
+{
+	// get pointers to C functions we need to call
+	using debugger_hook_func = void (*)(device_debug *, offs_t);
+	static const debugger_hook_func debugger_inst_hook = [] (device_debug *dbg, offs_t pc) { dbg->instruction_hook(pc); };
+	m_near.debug_cpu_instruction_hook = (void *)debugger_inst_hook;
+	if (LOG_HASHJMPS)
+	{
+		m_near.debug_log_hashjmp = (void *)debug_log_hashjmp;
+		m_near.debug_log_hashjmp_fail = (void *)debug_log_hashjmp_fail;
+	}
+	m_near.drcmap_get_value = (void *)&drc_map_variables::static_get_value;
+
+	// build the flags map
+	for (int entry = 0; entry < std::size(m_near.flagsmap); entry++)
+	{
+		uint8_t flags = 0;
+		if (entry & 0x1) flags |= FLAG_V | FLAG_U;
+		if (entry & 0x2) flags |= FLAG_C;
+		if (entry & 0x4) flags |= FLAG_Z;
+		if (entry & 0x8) flags |= FLAG_S;
+		m_near.flagsmap[entry] = flags;
+	}
+	for (int entry = 0; entry < std::size(m_near.flagsunmap); entry++)
+	{
+		uint32_t flags = 0;
+		if (entry & (FLAG_V | FLAG_U)) flags |= NZCV_V;
+		if (entry & FLAG_C) flags |= NZCV_C;
+		if (entry & FLAG_Z) flags |= NZCV_Z;
+		if (entry & FLAG_S) flags |= NZCV_N;
+		m_near.flagsunmap[entry] = flags;
+	}
+
+	// resolve the actual addresses of the address space handlers
+	auto const resolve_accessor =
+			[] (resolved_handler &handler, address_space &space, auto accessor)
+			{
+				if (MAME_DELEGATE_USE_TYPE == MAME_DELEGATE_TYPE_ITANIUM)
+				{
+					// the ARM variant of the ABI keeps the virtual flag in the adjustment
+					struct { uintptr_t ptr; ptrdiff_t adj; } equiv;
+					assert(sizeof(accessor) == sizeof(equiv));
+					*reinterpret_cast<decltype(accessor) *>(&equiv) = accessor;
+					bool const isvirtual = (MAME_ABI_CXX_ITANIUM_MFP_TYPE == MAME_ABI_CXX_ITANIUM_MFP_ARM) ? BIT(equiv.adj, 0) : BIT(equiv.ptr, 0);
+					ptrdiff_t const adj = (MAME_ABI_CXX_ITANIUM_MFP_TYPE == MAME_ABI_CXX_ITANIUM_MFP_ARM) ? (equiv.adj >> 1) : equiv.adj;
+					handler.obj = uintptr_t(reinterpret_cast<u8 *>(&space) + adj);
+					if (isvirtual)
+					{
+						uintptr_t const offset = (MAME_ABI_CXX_ITANIUM_MFP_TYPE == MAME_ABI_CXX_ITANIUM_MFP_ARM) ? equiv.ptr : (equiv.ptr - 1);
+						auto const vptr = *reinterpret_cast<u8 const *const *>(handler.obj) + offset;
+						handler.func = *reinterpret_cast<void *const *>(vptr);
+					}
+					else
+					{
+						handler.func = reinterpret_cast<void *>(equiv.ptr);
+					}
+				}
+
+				// MSVC member function pointers go through import thunks on ARM64 that
+				// aren't worth decoding, so those calls use the trampolines instead
+			};
+	m_resolved_accessors.resize(m_space.size());
+	for (int space = 0; m_space.size() > space; ++space)
+	{
+		if (m_space[space])
+		{
+			resolve_accessor(m_resolved_accessors[space].read_byte,         *m_space[space], static_cast<u8  (address_space::*)(offs_t)     >(&address_space::read_byte));
+			resolve_accessor(m_resolved_accessors[space].read_word,         *m_space[space], static_cast<u16 (address_space::*)(offs_t)     >(&address_space::read_word));
+			resolve_accessor(m_resolved_accessors[space].read_word_masked,  *m_space[space], static_cast<u16 (address_space::*)(offs_t, u16)>(&address_space::read_word));
+			resolve_accessor(m_resolved_accessors[space].read_dword,        *m_space[space], static_cast<u32 (address_space::*)(offs_t)     >(&address_space::read_dword));
+			resolve_accessor(m_resolved_accessors[space].read_dword_masked, *m_space[space], static_cast<u32 (address_space::*)(offs_t, u32)>(&address_space::read_dword));
+			resolve_accessor(m_resolved_accessors[space].read_qword,        *m_space[space], static_cast<u64 (address_space::*)(offs_t)     >(&address_space::read_qword));
+			resolve_accessor(m_resolved_accessors[space].read_qword_masked, *m_space[space], static_cast<u64 (address_space::*)(offs_t, u64)>(&address_space::read_qword));
+
+			resolve_accessor(m_resolved_accessors[space].write_byte,         *m_space[space], static_cast<void (address_space::*)(offs_t, u8)      >(&address_space::write_byte));
+			resolve_accessor(m_resolved_accessors[space].write_word,         *m_space[space], static_cast<void (address_space::*)(offs_t, u16)     >(&address_space::write_word));
+			resolve_accessor(m_resolved_accessors[space].write_word_masked,  *m_space[space], static_cast<void (address_space::*)(offs_t, u16, u16)>(&address_space::write_word));
+			resolve_accessor(m_resolved_accessors[space].write_dword,        *m_space[space], static_cast<void (address_space::*)(offs_t, u32)     >(&address_space::write_dword));
+			resolve_accessor(m_resolved_accessors[space].write_dword_masked, *m_space[space], static_cast<void (address_space::*)(offs_t, u32, u32)>(&address_space::write_dword));
+			resolve_accessor(m_resolved_accessors[space].write_qword,        *m_space[space], static_cast<void (address_space::*)(offs_t, u64)     >(&address_space::write_qword));
+			resolve_accessor(m_resolved_accessors[space].write_qword_masked, *m_space[space], static_cast<void (address_space::*)(offs_t, u64, u64)>(&address_space::write_qword));
+		}
+	}
+
+	// build the opcode table (static but it doesn't hurt to regenerate it)
+	for (auto & elem : s_opcode_table_source)
+		s_opcode_table[elem.opcode] = elem.func;
+
+	// create the log
+	if (device.machine().options().drc_log_native())
+		m_log_asmjit = fopen(std::string("drcbearm64_asmjit_").append(device.shortname()).append(".asm").c_str(), "w");
+}
+
+
+//-------------------------------------------------
+//  ~drcbe_arm64 - destructor
+//-------------------------------------------------
+
+drcbe_arm64::~drcbe_arm64()
+{
+	if (m_log_asmjit)
+		fclose(m_log_asmjit);
+}
+
+size_t drcbe_arm64::emit(CodeHolder &ch)
+{
+	Error err;
+
+	size_t const alignment = ch.baseAddress() - uint64_t(m_cache.top());
+	size_t const code_size = ch.codeSize();
+
+	// test if enough room remains in drc cache
+	drccodeptr *cachetop = m_cache.begin_codegen(alignment + code_size);
+	if (cachetop == nullptr)
+		return 0;
+
+	err = ch.copyFlattenedData(drccodeptr(ch.baseAddress()), code_size, CopySectionFlags::kPadTargetBuffer);
+	if (err)
+		throw emu_fatalerror("asmjit::CodeHolder::copyFlattenedData() error %d", err);
+
+	// update the drc cache and end codegen
+	*cachetop += alignment + code_size;
+	m_cache.end_codegen();
+
+	return code_size;
+}
+
+//-------------------------------------------------
+//  reset - reset back-end specific state
+//-------------------------------------------------
+
+void drcbe_arm64::reset()
+{
+	// generate a little bit of glue code to set up the environment
+	uint8_t *dst = (uint8_t *)(uint64_t(m_cache.top() + 15) & ~15);
+
+	CodeHolder ch;
+	ch.init(Environment(Arch::kAArch64), uint64_t(dst));
+
+	FileLogger logger(m_log_asmjit);
+	if (logger.file())
+	{
+		logger.setFlags(FormatFlags::kHexOffsets | FormatFlags::kHexImms | FormatFlags::kMachineCode);
+		logger.setIndentation(FormatIndentationGroup::kCode, 4);
+		ch.setLogger(&logger);
+	}
+
+	a64::Assembler a(&ch);
+	if (logger.file())
+		a.addDiagnosticOptions(DiagnosticOptions::kValidateIntermediate);
+
+	// generate an entry point
+	m_entry = (arm64_entry_point_func)dst;
+	a.bind(a.newNamedLabel("entry_point"));
+
+	// save the frame record and callee-saved registers
+	a.stp(x29, x30, a64::ptr_pre(sp, -160));                                            // stp   x29,x30,[sp,-160]!
+	a.mov(x29, sp);                                                                     // mov   x29,sp
+	a.stp(x19, x20, a64::ptr(sp, 16));                                                  // stp   x19,x20,[sp,16]
+	a.stp(x21, x22, a64::ptr(sp, 32));                                                  // stp   x21,x22,[sp,32]
+	a.stp(x23, x24, a64::ptr(sp, 48));                                                  // stp   x23,x24,[sp,48]
+	a.stp(x25, x26, a64::ptr(sp, 64));                                                  // stp   x25,x26,[sp,64]
+	a.stp(x27, x28, a64::ptr(sp, 80));                                                  // stp   x27,x28,[sp,80]
+	a.stp(d8, d9, a64::ptr(sp, 96));                                                    // stp   d8,d9,[sp,96]
+	a.stp(d10, d11, a64::ptr(sp, 112));                                                 // stp   d10,d11,[sp,112]
+	a.stp(d12, d13, a64::ptr(sp, 128));                                                 // stp   d12,d13,[sp,128]
+	a.stp(d14, d15, a64::ptr(sp, 144));                                                 // stp   d14,d15,[sp,144]
+
+	// set up the base register, save the host FPCR and remember the stack pointer
+	a.mov(BASE_REG, REG_PARAM1);                                                        // mov   base,param1
+	a.mrs(TEMP_REG1, Imm(a64::Predicate::SysReg::kFPCR));                               // mrs   temp,fpcr
+	emit_str_mem(a, TEMP_REG1, &m_near.fpcrsave);                                       // str   temp,[fpcrsave]
+	a.mov(TEMP_REG1, sp);                                                               // mov   temp,sp
+	emit_str_mem(a, TEMP_REG1, &m_near.hashstacksave);                                  // str   temp,[hashstacksave]
+	a.br(REG_PARAM2);                                                                   // br    param2
+
+	// generate an exit point
+	m_exit = dst + a.offset();
+	a.bind(a.newNamedLabel("exit_point"));
+	emit_ldr_mem(a, TEMP_REG1, &m_near.hashstacksave);                                  // ldr   temp,[hashstacksave]
+	a.mov(sp, TEMP_REG1);                                                               // mov   sp,temp
+	emit_ldr_mem(a, TEMP_REG1, &m_near.fpcrsave);                                       // ldr   temp,[fpcrsave]
+	a.msr(Imm(a64::Predicate::SysReg::kFPCR), TEMP_REG1);                               // msr   fpcr,temp
+	a.ldp(d14, d15, a64::ptr(sp, 144));                                                 // ldp   d14,d15,[sp,144]
+	a.ldp(d12, d13, a64::ptr(sp, 128));                                                 // ldp   d12,d13,[sp,128]
+	a.ldp(d10, d11, a64::ptr(sp, 112));                                                 // ldp   d10,d11,[sp,112]
+	a.ldp(d8, d9, a64::ptr(sp, 96));                                                    // ldp   d8,d9,[sp,96]
+	a.ldp(x27, x28, a64::ptr(sp, 80));                                                  // ldp   x27,x28,[sp,80]
+	a.ldp(x25, x26, a64::ptr(sp, 64));                                                  // ldp   x25,x26,[sp,64]
+	a.ldp(x23, x24, a64::ptr(sp, 48));                                                  // ldp   x23,x24,[sp,48]
+	a.ldp(x21, x22, a64::ptr(sp, 32));                                                  // ldp   x21,x22,[sp,32]
+	a.ldp(x19, x20, a64::ptr(sp, 16));                                                  // ldp   x19,x20,[sp,16]
+	a.ldp(x29, x30, a64::ptr_post(sp, 160));                                            // ldp   x29,x30,[sp],160
+	a.ret(x30);                                                                         // ret
+
+	// generate a no code point
+	m_nocode = dst + a.offset();
+	a.bind(a.newNamedLabel("nocode_point"));
+	a.ret(x30);                                                                         // ret
+
+	// emit the generated code
+	emit(ch);
+
+	// reset our hash tables
+	m_hash.reset();
+	m_hash.set_default_codeptr(m_nocode);
+}
+
+
+//-------------------------------------------------
+//  execute - execute a block of code referenced
+//  by the given handle
+//-------------------------------------------------
+
+int drcbe_arm64::execute(code_handle &entry)
+{
+	// call our entry point which will jump to the destination
+	m_cache.codegen_complete();
+	return (*m_entry)(m_baseptr, (uint8_t *)entry.codeptr());
+}
+
+
+//-------------------------------------------------
+//  generate - generate code
+//-------------------------------------------------
+
+void drcbe_arm64::generate(drcuml_block &block, const instruction *instlist, uint32_t numinst)
+{
+	// tell all of our utility objects that a block is beginning
+	m_hash.block_begin(block, instlist, numinst);
+	m_map.block_begin(block);
+
+	// compute the base by aligning the cache top to a cache line (assumed to be 64 bytes)
+	uint8_t *dst = (uint8_t *)(uint64_t(m_cache.top() + 63) & ~63);
+
+	CodeHolder ch;
+	ch.init(Environment(Arch::kAArch64), uint64_t(dst));
+	ThrowableErrorHandler e;
+	ch.setErrorHandler(&e);
+
+	FileLogger logger(m_log_asmjit);
+	if (logger.file())
+	{
+		logger.setFlags(FormatFlags::kHexOffsets | FormatFlags::kHexImms | FormatFlags::kMachineCode);
+		logger.setIndentation(FormatIndentationGroup::kCode, 4);
+		ch.setLogger(&logger);
+	}
+
+	a64::Assembler a(&ch);
+	if (logger.file())
+		a.addDiagnosticOptions(DiagnosticOptions::kValidateIntermediate);
+
+	// generate code
+	for (int inum = 0; inum < numinst; inum++)
+	{
+		const instruction &inst = instlist[inum];
+		assert(inst.opcode() < std::size(s_opcode_table));
+
+		// must remain in scope until output
+		std::string dasm;
+
+		// add a comment
+		if (logger.file())
+		{
+			dasm = inst.disasm(&m_drcuml);
+			a.setInlineComment(dasm.c_str());
+		}
+
+		// generate code
+		(this->*s_opcode_table[inst.opcode()])(a, inst);
+	}
+
+	// emit the generated code
+	if (!emit(ch))
+		block.abort();
+
+	// tell all of our utility objects that the block is finished
+	m_hash.block_end(block);
+	m_map.block_end(block);
+}
+
+
+//-------------------------------------------------
+//  hash_exists - return true if the given mode/pc
+//  exists in the hash table
+//-------------------------------------------------
+
+bool drcbe_arm64::hash_exists(uint32_t mode, uint32_t pc)
+{
+	return m_hash.code_exists(mode, pc);
+}
+
+
+//-------------------------------------------------
+//  hash_invalidate - stop the given mode/pc from
+//  reaching the code compiled for it
+//-------------------------------------------------
+
+void drcbe_arm64::hash_invalidate(uint32_t mode, uint32_t pc)
+{
+	m_hash.clear_codeptr(mode, pc);
+}
+
+
+//-------------------------------------------------
+//  get_info - return information about the
+//  back-end implementation
+//-------------------------------------------------
+
+void drcbe_arm64::get_info(drcbe_info &info)
+{
+	for (info.direct_iregs = 0; info.direct_iregs < REG_I_COUNT; info.direct_iregs++)
+		if (int_register_map[info.direct_iregs] == 0)
+			break;
+	for (info.direct_fregs = 0; info.direct_fregs < REG_F_COUNT; info.direct_fregs++)
+		if (float_register_map[info.direct_fregs] == 0)
+			break;
+}
+
+
+//-------------------------------------------------
+//  alu_op_param - apply a three-operand ALU
+//  operation with the given parameter as the
+//  second source
+//-------------------------------------------------
+
+void drcbe_arm64::alu_op_param(a64::Assembler &a, Inst::Id const opcode, a64::Gp const &dst, a64::Gp const &src, be_parameter const &param, bool logical) const
+{
+	uint32_t const regsize = dst.isGpW() ? 4 : 8;
+
+	if (param.is_immediate())
+	{
+		uint64_t const val = (regsize == 4) ? uint32_t(param.immediate()) : param.immediate();
+
+		if (logical ? is_valid_immediate_mask(val, regsize) : is_valid_immediate_addsub(val))
+		{
+			a.emit(opcode, dst, src, val);                                              // op    dst,src,val
+		}
+		else if (val == 0)
+		{
+			a.emit(opcode, dst, src, (regsize == 4) ? a64::Gp(wzr) : a64::Gp(xzr));     // op    dst,src,zr
+		}
+		else
+		{
+			a64::Gp const scratch = select_register(SCRATCH_REG2, regsize);
+			mov_r64_imm(a, scratch, val);                                               // mov   scratch,val
+			a.emit(opcode, dst, src, scratch);                                          // op    dst,src,scratch
+		}
+	}
+	else
+	{
+		a.emit(opcode, dst, src, get_reg_param(a, regsize, param, SCRATCH_REG2));       // op    dst,src,param
+	}
+}
+
+
+//-------------------------------------------------
+//  get_reg_param - return a register holding the
+//  value of a parameter, loading it into the
+//  default register if necessary
+//-------------------------------------------------
+
+a64::Gp drcbe_arm64::get_reg_param(a64::Assembler &a, uint32_t regsize, be_parameter const &param, a64::Gp const &defreg) const
+{
+	if (param.is_int_register())
+		return select_register(a64::Gp(x(param.ireg())), regsize);
+
+	a64::Gp const reg = select_register(defreg, regsize);
+	mov_reg_param(a, regsize, reg, param);
+	return reg;
+}
+
+
+//-------------------------------------------------
+//  mov_reg_param - move a parameter into a
+//  register
+//-------------------------------------------------
+
+void drcbe_arm64::mov_reg_param(a64::Assembler &a, uint32_t regsize, a64::Gp const &dst, be_parameter const &src) const
+{
+	a64::Gp const dstreg = select_register(dst, regsize);
+
+	if (src.is_immediate())
+		mov_r64_imm(a, dstreg, (regsize == 4) ? uint32_t(src.immediate()) : src.immediate());
+	else if (src.is_int_register() && (dstreg.id() != src.ireg()))
+		a.mov(dstreg, select_register(a64::Gp(x(src.ireg())), regsize));                // mov   dst,src
+	else if (src.is_memory())
+		emit_ldr_mem(a, dstreg, src.memory());                                          // ldr   dst,[src]
+}
+
+
+//-------------------------------------------------
+//  mov_param_reg - move a register into a
+//  parameter
+//-------------------------------------------------
+
+void drcbe_arm64::mov_param_reg(a64::Assembler &a, uint32_t regsize, be_parameter const &dst, a64::Gp const &src) const
+{
+	assert(!dst.is_immediate());
+
+	a64::Gp const srcreg = select_register(src, regsize);
+
+	if (dst.is_memory())
+		emit_str_mem(a, srcreg, dst.memory());                                          // str   src,[dst]
+	else if (dst.is_int_register() && (srcreg.id() != dst.ireg()))
+		a.mov(select_register(a64::Gp(x(dst.ireg())), regsize), srcreg);                // mov   dst,src
+}
+
+
+//-------------------------------------------------
+//  mov_param_param - move one parameter to
+//  another
+//-------------------------------------------------
+
+void drcbe_arm64::mov_param_param(a64::Assembler &a, uint32_t regsize, be_parameter const &dst, be_parameter const &src) const
+{
+	assert(!dst.is_immediate());
+
+	if (dst.is_int_register())
+	{
+		mov_reg_param(a, regsize, a64::Gp(x(dst.ireg())), src);
+	}
+	else if (src.is_int_register())
+	{
+		mov_param_reg(a, regsize, dst, a64::Gp(x(src.ireg())));
+	}
+	else if (src.is_immediate_value(0))
+	{
+		emit_str_mem(a, (regsize == 4) ? a64::Gp(wzr) : a64::Gp(xzr), dst.memory());   // str   zr,[dst]
+	}
+	else
+	{
+		mov_reg_param(a, regsize, TEMP_REG1, src);
+		mov_param_reg(a, regsize, dst, TEMP_REG1);
+	}
+}
+
+
+//-------------------------------------------------
+//  mov_mem_param - move a parameter into a
+//  memory location
+//-------------------------------------------------
+
+void drcbe_arm64::mov_mem_param(a64::Assembler &a, uint32_t regsize, void *dst, be_parameter const &src) const
+{
+	mov_param_param(a, regsize, be_parameter::make_memory(dst), src);
+}
+
+
+//-------------------------------------------------
+//  mov_r64_imm - load an immediate value into a
+//  register
+//-------------------------------------------------
+
+inline void drcbe_arm64::mov_r64_imm(a64::Assembler &a, a64::Gp const &reg, uint64_t const imm) const
+{
+	a.mov(reg, imm);                                                                    // mov   reg,imm
+}
+
+
+//-------------------------------------------------
+//  mov_float_reg_param - move a floating point
+//  parameter into a register
+//-------------------------------------------------
+
+void drcbe_arm64::mov_float_reg_param(a64::Assembler &a, uint32_t regsize, a64::Vec const &dst, be_parameter const &src) const
+{
+	assert(!src.is_immediate());
+
+	a64::Vec const dstreg = select_register(dst, regsize);
+
+	if (src.is_memory())
+		emit_float_ldr_mem(a, dstreg, src.memory());                                    // ldr   dst,[src]
+	else if (src.is_float_register() && (dstreg.id() != src.freg()))
+		a.fmov(dstreg, select_register(a64::Vec(d(src.freg())), regsize));              // fmov  dst,src
+}
+
+
+//-------------------------------------------------
+//  mov_float_param_reg - move a register into a
+//  floating point parameter
+//-------------------------------------------------
+
+void drcbe_arm64::mov_float_param_reg(a64::Assembler &a, uint32_t regsize, be_parameter const &dst, a64::Vec const &src) const
+{
+	assert(!dst.is_immediate());
+
+	a64::Vec const srcreg = select_register(src, regsize);
+
+	if (dst.is_memory())
+		emit_float_str_mem(a, srcreg, dst.memory());                                    // str   src,[dst]
+	else if (dst.is_float_register() && (srcreg.id() != dst.freg()))
+		a.fmov(select_register(a64::Vec(d(dst.freg())), regsize), srcreg);              // fmov  dst,src
+}
+
+
+//-------------------------------------------------
+//  mov_float_param_param - move one floating
+//  point parameter to another
+//-------------------------------------------------
+
+void drcbe_arm64::mov_float_param_param(a64::Assembler &a, uint32_t regsize, be_parameter const &dst, be_parameter const &src) const
+{
+	assert(!src.is_immediate());
+	assert(!dst.is_immediate());
+
+	if (dst.is_float_register())
+	{
+		mov_float_reg_param(a, regsize, a64::Vec(d(dst.freg())), src);
+	}
+	else if (src.is_float_register())
+	{
+		mov_float_param_reg(a, regsize, dst, a64::Vec(d(src.freg())));
+	}
+	else
+	{
+		// memory to memory is a plain bit copy
+		a64::Gp const temp = select_register(TEMP_REG1, regsize);
+		emit_ldr_mem(a, temp, src.memory());                                            // ldr   temp,[src]
+		emit_str_mem(a, temp, dst.memory());                                            // str   temp,[dst]
+	}
+}
+
+
+//-------------------------------------------------
+//  call_accessor - call an address space accessor
+//  with the parameters already in place, using
+//  the resolved member function if available
+//-------------------------------------------------
+
+void drcbe_arm64::call_accessor(a64::Assembler &a, resolved_handler const &resolved, const void *trampoline, int spacenum) const
+{
+	if (resolved.func)
+	{
+		mov_r64_imm(a, REG_PARAM1, resolved.obj);                                       // mov   param1,obj
+		call_arm_addr(a, resolved.func);                                                // bl    func
+	}
+	else
+	{
+		mov_r64_imm(a, REG_PARAM1, uintptr_t(m_space[spacenum]));                       // mov   param1,space
+		call_arm_addr(a, trampoline);                                                   // bl    trampoline
+	}
+}
+
+
+
+//**************************************************************************
+//  DEBUG HELPERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  debug_log_hashjmp - callback to handle
+//  logging of hashjmps
+//-------------------------------------------------
+
+void drcbe_arm64::debug_log_hashjmp(offs_t pc, int mode)
+{
+	printf("mode=%d PC=%08X\n", mode, pc);
+}
+
+
+//-------------------------------------------------
+//  debug_log_hashjmp - callback to handle
+//  logging of hashjmps
+//-------------------------------------------------
+
+void drcbe_arm64::debug_log_hashjmp_fail()
+{
+	printf("  (FAIL)\n");
+}
+
+
+
+/***************************************************************************
+    COMPILE-TIME OPCODES
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_handle - process a HANDLE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_handle(a64::Assembler &a, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 1);
+	assert(inst.param(0).is_code_handle());
+
+	// make a label for documentation
+	Label handle = a.newNamedLabel(inst.param(0).handle().string());
+	a.bind(handle);
+
+	// emit a jump around the prolog in case code falls through here
+	Label skip = a.newLabel();
+	a.b(skip);                                                                          // b     skip
+
+	// register the current pointer for the handle
+	inst.param(0).handle().set_codeptr(drccodeptr(a.code()->baseAddress() + a.offset()));
+
+	// by default, the handle points to prolog code that saves the return address
+	a.str(x30, a64::ptr_pre(sp, -16));                                                  // str   x30,[sp,-16]!
+	a.bind(skip);                                                                   // skip:
+}
+
+
+//-------------------------------------------------
+//  op_hash - process a HASH opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_hash(a64::Assembler &a, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 2);
+	assert(inst.param(0).is_immediate());
+	assert(inst.param(1).is_immediate());
+
+	// register the current pointer for the mode/PC
+	m_hash.set_codeptr(inst.param(0).immediate(), inst.param(1).immediate(), drccodeptr(a.code()->baseAddress() + a.offset()));
+}
+
+
+//-------------------------------------------------
+//  op_label - process a LABEL opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_label(a64::Assembler &a, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 1);
+	assert(inst.param(0).is_code_label());
+
+	// register the current pointer for the label
+	a.bind(get_label(a, inst.param(0).label()));
+}
+
+
+//-------------------------------------------------
+//  op_comment - process a COMMENT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_comment(a64::Assembler &a, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 1);
+	assert(inst.param(0).is_string());
+
+	// do nothing
+}
+
+
+//-------------------------------------------------
+//  op_mapvar - process a MAPVAR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_mapvar(a64::Assembler &a, const instruction &inst)
+{
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 2);
+	assert(inst.param(0).is_mapvar());
+	assert(inst.param(1).is_immediate());
+
+	// set the value of the specified mapvar
+	m_map.set_value(drccodeptr(a.code()->baseAddress() + a.offset()), inst.param(0).mapvar(), inst.param(1).immediate());
+}
+
+
+
+/***************************************************************************
+    CONTROL FLOW OPCODES
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_nop - process a NOP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_nop(a64::Assembler &a, const instruction &inst)
+{
+	// nothing
+}
+
+
+//-------------------------------------------------
+//  op_debug - process a DEBUG opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_debug(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	if ((m_device.machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		// normalize parameters
+		be_parameter pcp(*this, inst.param(0), PTYPE_MRI);
+
+		// test and branch
+		mov_r64_imm(a, TEMP_REG1, (uintptr_t)&m_device.machine().debug_flags);          // mov   temp,&debug_flags
+		a.ldr(TEMP_REG1.w(), a64::ptr(TEMP_REG1));                                      // ldr   temp,[temp]
+		a.tst(TEMP_REG1.w(), DEBUG_FLAG_CALL_HOOK);                                     // tst   temp,DEBUG_FLAG_CALL_HOOK
+		Label skip = a.newLabel();
+		a.b_eq(skip);                                                                   // b.eq  skip
+
+		// push the parameter
+		mov_r64_imm(a, REG_PARAM1, (uintptr_t)m_device.debug());                        // mov   param1,device.debug
+		mov_reg_param(a, 4, REG_PARAM2, pcp);                                           // mov   param2,pcp
+		call_arm_addr(a, m_near.debug_cpu_instruction_hook);                            // bl    debug_cpu_instruction_hook
+
+		a.bind(skip);                                                               // skip:
+	}
+}
+
+
+//-------------------------------------------------
+//  op_exit - process an EXIT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_exit(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter retp(*this, inst.param(0), PTYPE_MRI);
+
+	// skip if conditional
+	Label skip = a.newLabel();
+	emit_skip(a, inst.condition(), skip);
+
+	// load the parameter into W0 and leave
+	mov_reg_param(a, 4, REG_PARAM1, retp);                                              // mov   w0,retp
+	jmp_arm_addr(a, m_exit);                                                            // b     exit
+
+	a.bind(skip);                                                                   // skip:
+}
+
+
+//-------------------------------------------------
+//  op_hashjmp - process a HASHJMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_hashjmp(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter modep(*this, inst.param(0), PTYPE_MRI);
+	be_parameter pcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &exp = inst.param(2);
+	assert(exp.is_code_handle());
+
+	if (LOG_HASHJMPS)
+	{
+		mov_reg_param(a, 4, REG_PARAM1, pcp);
+		mov_reg_param(a, 4, REG_PARAM2, modep);
+		call_arm_addr(a, m_near.debug_log_hashjmp);
+	}
+
+	// reset the stack to where it was on entry
+	emit_ldr_mem(a, TEMP_REG1, &m_near.hashstacksave);                                  // ldr   temp,[hashstacksave]
+	a.mov(sp, TEMP_REG1);                                                               // mov   sp,temp
+
+	// the second level lookup is the same for every variable PC case
+	auto const lookup_variable_pc =
+			[this, &a, &pcp] (a64::Gp const &l1table)
+			{
+				a64::Gp const pcreg = get_reg_param(a, 4, pcp, TEMP_REG2);
+				a.lsr(TEMP_REG3.w(), pcreg, m_hash.l1shift());                          // lsr   l1,pc,l1shift
+				a.ldr(l1table, a64::ptr(l1table, TEMP_REG3, arm::lsl(3)));              // ldr   l2table,[l1table,l1*8]
+				if (m_hash.l2mask())
+				{
+					a.ubfx(TEMP_REG3.w(), pcreg, m_hash.l2shift(), population_count_32(m_hash.l2mask()));
+																						// ubfx  l2,pc,l2shift,l2bits
+					a.ldr(l1table, a64::ptr(l1table, TEMP_REG3, arm::lsl(3)));          // ldr   target,[l2table,l2*8]
+				}
+				else
+				{
+					a.ldr(l1table, a64::ptr(l1table));                                  // ldr   target,[l2table]
+				}
+			};
+
+	// fixed mode cases
+	if (modep.is_immediate() && m_hash.is_mode_populated(modep.immediate()))
+	{
+		// a straight immediate jump is direct, though we need the PC in the exception path
+		if (pcp.is_immediate())
+		{
+			uint32_t l1val = (pcp.immediate() >> m_hash.l1shift()) & m_hash.l1mask();
+			uint32_t l2val = (pcp.immediate() >> m_hash.l2shift()) & m_hash.l2mask();
+			emit_ldr_mem(a, TEMP_REG1, &m_hash.base()[modep.immediate()][l1val][l2val]);  // ldr   temp,hash[modep][l1val][l2val]
+		}
+
+		// a fixed mode but variable PC
+		else
+		{
+			get_imm_relative(a, TEMP_REG1, uintptr_t(m_hash.base()[modep.immediate()])); // mov   temp,hash[modep]
+			lookup_variable_pc(TEMP_REG1);
+		}
+	}
+	else
+	{
+		// variable mode
+		mov_reg_param(a, 4, TEMP_REG2, modep);                                          // mov   mode,modep
+		get_imm_relative(a, TEMP_REG1, uintptr_t(m_hash.base()));                       // mov   temp,hash
+		a.ldr(TEMP_REG1, a64::ptr(TEMP_REG1, TEMP_REG2, arm::lsl(3)));                  // ldr   temp,[temp,mode*8]
+
+		// fixed PC
+		if (pcp.is_immediate())
+		{
+			uint32_t l1val = (pcp.immediate() >> m_hash.l1shift()) & m_hash.l1mask();
+			uint32_t l2val = (pcp.immediate() >> m_hash.l2shift()) & m_hash.l2mask();
+			if (!is_valid_offset(l1val * 8, 8))
+			{
+				mov_r64_imm(a, TEMP_REG2, l1val * 8);                                   // mov   temp2,l1val*8
+				a.add(TEMP_REG1, TEMP_REG1, TEMP_REG2);                                 // add   temp,temp,temp2
+				l1val = 0;
+			}
+			a.ldr(TEMP_REG1, a64::ptr(TEMP_REG1, l1val * 8));                           // ldr   temp,[temp+l1val*8]
+			if (!is_valid_offset(l2val * 8, 8))
+			{
+				mov_r64_imm(a, TEMP_REG2, l2val * 8);                                   // mov   temp2,l2val*8
+				a.add(TEMP_REG1, TEMP_REG1, TEMP_REG2);                                 // add   temp,temp,temp2
+				l2val = 0;
+			}
+			a.ldr(TEMP_REG1, a64::ptr(TEMP_REG1, l2val * 8));                           // ldr   temp,[temp+l2val*8]
+		}
+
+		// variable PC
+		else
+		{
+			lookup_variable_pc(TEMP_REG1);
+		}
+	}
+	a.blr(TEMP_REG1);                                                                   // blr   temp
+
+	// in all cases, if there is no code, we return here to generate the exception
+	if (LOG_HASHJMPS)
+		call_arm_addr(a, m_near.debug_log_hashjmp_fail);
+
+	mov_mem_param(a, 4, &m_state.exp, pcp);                                             // str   pcp,[exp]
+	drccodeptr *const targetptr = exp.handle().codeptr_addr();
+	if (*targetptr != nullptr)
+	{
+		call_arm_addr(a, *targetptr);                                                   // bl    *targetptr
+	}
+	else
+	{
+		emit_ldr_mem(a, TEMP_REG1, targetptr);                                          // ldr   temp,[targetptr]
+		a.blr(TEMP_REG1);                                                               // blr   temp
+	}
+}
+
+
+//-------------------------------------------------
+//  op_jmp - process a JMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_jmp(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &labelp = inst.param(0);
+	assert(labelp.is_code_label());
+
+	Label jmptarget = get_label(a, labelp.label());
+
+	switch (inst.condition())
+	{
+		case uml::COND_ALWAYS:
+			a.b(jmptarget);                                                             // b     target
+			break;
+
+		case uml::COND_A:
+		{
+			Label skip = a.newLabel();
+			a.b_cs(skip);                                                               // b.cs  skip
+			a.b_ne(jmptarget);                                                          // b.ne  target
+			a.bind(skip);                                                           // skip:
+			break;
+		}
+
+		case uml::COND_BE:
+			a.b_cs(jmptarget);                                                          // b.cs  target
+			a.b_eq(jmptarget);                                                          // b.eq  target
+			break;
+
+		default:
+			a.b(ARM_CONDITION(inst.condition()), jmptarget);                            // b.cc  target
+			break;
+	}
+}
+
+
+//-------------------------------------------------
+//  op_exh - process an EXH opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_exh(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &handp = inst.param(0);
+	assert(handp.is_code_handle());
+	be_parameter exp(*this, inst.param(1), PTYPE_MRI);
+
+	// look up the handle target
+	drccodeptr *targetptr = handp.handle().codeptr_addr();
+
+	// perform the exception processing
+	Label no_exception = a.newLabel();
+	emit_skip(a, inst.condition(), no_exception);
+
+	mov_mem_param(a, 4, &m_state.exp, exp);                                             // str   exp,[exp]
+	if (*targetptr != nullptr)
+	{
+		call_arm_addr(a, *targetptr);                                                   // bl    *targetptr
+	}
+	else
+	{
+		emit_ldr_mem(a, TEMP_REG1, targetptr);                                          // ldr   temp,[targetptr]
+		a.blr(TEMP_REG1);                                                               // blr   temp
+	}
+
+	a.bind(no_exception);                                                           // no_exception:
+}
+
+
+//-------------------------------------------------
+//  op_callh - process a CALLH opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_callh(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &handp = inst.param(0);
+	assert(handp.is_code_handle());
+
+	// look up the handle target
+	drccodeptr *targetptr = handp.handle().codeptr_addr();
+
+	// skip if conditional
+	Label skip = a.newLabel();
+	emit_skip(a, inst.condition(), skip);
+
+	// jump through the handle; directly if a normal jump
+	if (*targetptr != nullptr)
+	{
+		call_arm_addr(a, *targetptr);                                                   // bl    *targetptr
+	}
+	else
+	{
+		emit_ldr_mem(a, TEMP_REG1, targetptr);                                          // ldr   temp,[targetptr]
+		a.blr(TEMP_REG1);                                                               // blr   temp
+	}
+
+	// resolve the conditional link
+	a.bind(skip);                                                                   // skip:
+}
+
+
+//-------------------------------------------------
+//  op_ret - process a RET opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ret(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+	assert(inst.numparams() == 0);
+
+	// skip if conditional
+	Label skip = a.newLabel();
+	emit_skip(a, inst.condition(), skip);
+
+	// return
+	a.ldr(x30, a64::ptr_post(sp, 16));                                                  // ldr   x30,[sp],16
+	a.ret(x30);                                                                         // ret
+
+	// resolve the conditional link
+	a.bind(skip);                                                                   // skip:
+}
+
+
+//-------------------------------------------------
+//  op_callc - process a CALLC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_callc(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	const parameter &funcp = inst.param(0);
+	assert(funcp.is_c_function());
+	be_parameter paramp(*this, inst.param(1), PTYPE_M);
+
+	// skip if conditional
+	Label skip = a.newLabel();
+	emit_skip(a, inst.condition(), skip);
+
+	// perform the call
+	get_imm_relative(a, REG_PARAM1, (uintptr_t)paramp.memory());                        // mov   param1,paramp
+	call_arm_addr(a, (const void *)(uintptr_t)funcp.cfunc());                           // bl    funcp
+
+	// resolve the conditional link
+	a.bind(skip);                                                                   // skip:
+}
+
+
+//-------------------------------------------------
+//  op_recover - process a RECOVER opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_recover(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+
+	// the return address saved by the outermost handle prolog sits just below the saved stack pointer
+	emit_ldr_mem(a, TEMP_REG1, &m_near.hashstacksave);                                  // ldr   temp,[hashstacksave]
+	a.ldr(REG_PARAM2, a64::ptr(TEMP_REG1, -16));                                        // ldr   param2,[temp-16]
+	a.sub(REG_PARAM2, REG_PARAM2, 4);                                                   // sub   param2,param2,4
+	get_imm_relative(a, REG_PARAM1, (uintptr_t)&m_map);                                 // mov   param1,m_map
+	a.mov(REG_PARAM3.w(), inst.param(1).mapvar());                                      // mov   param3,param[1].value
+	call_arm_addr(a, m_near.drcmap_get_value);                                          // bl    drcmap_get_value
+	mov_param_reg(a, 4, dstp, REG_PARAM1);                                              // mov   dstp,w0
+}
+
+
+
+/***************************************************************************
+    INTERNAL REGISTER OPCODES
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_setfmod - process a SETFMOD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_setfmod(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter srcp(*this, inst.param(0), PTYPE_MRI);
+
+	// immediate case
+	if (srcp.is_immediate())
+	{
+		mov_r64_imm(a, TEMP_REG1.w(), srcp.immediate() & 3);                            // mov   temp,srcp & 3
+	}
+
+	// register/memory case
+	else
+	{
+		mov_reg_param(a, 4, TEMP_REG1, srcp);                                           // mov   temp,srcp
+		a.and_(TEMP_REG1.w(), TEMP_REG1.w(), 3);                                        // and   temp,temp,3
+	}
+	emit_strb_mem(a, TEMP_REG1, &m_state.fmod);                                         // strb  temp,[fmod]
+	emit_fpcr_rounding(a, TEMP_REG1);
+}
+
+
+//-------------------------------------------------
+//  op_getfmod - process a GETFMOD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_getfmod(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+
+	// fetch the current mode and store to the destination
+	a64::Gp dstreg = dstp.select_register(TEMP_REG1, 4);
+	emit_ldrb_mem(a, dstreg, &m_state.fmod);                                            // ldrb  dstreg,[fmod]
+	mov_param_reg(a, 4, dstp, dstreg);                                                  // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_getexp - process a GETEXP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_getexp(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+
+	// fetch the exception parameter and store to the destination
+	a64::Gp dstreg = dstp.select_register(TEMP_REG1, 4);
+	emit_ldr_mem(a, dstreg, &m_state.exp);                                              // ldr   dstreg,[exp]
+	mov_param_reg(a, 4, dstp, dstreg);                                                  // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_getflgs - process a GETFLGS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_getflgs(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter maskp(*this, inst.param(1), PTYPE_I);
+
+	// pick a target register for the general case
+	a64::Gp dstreg = dstp.select_register(TEMP_REG1, 4);
+
+	// translate the host flags through the table and mask off what was asked for
+	a.mrs(TEMP_REG2, Imm(a64::Predicate::SysReg::kNZCV));                               // mrs   temp2,nzcv
+	a.lsr(TEMP_REG2, TEMP_REG2, 28);                                                    // lsr   temp2,temp2,28
+	get_imm_relative(a, TEMP_REG3, uintptr_t(&m_near.flagsmap[0]));                     // mov   temp3,flagsmap
+	a.ldrb(dstreg.w(), a64::ptr(TEMP_REG3, TEMP_REG2));                                 // ldrb  dstreg,[temp3+temp2]
+	alu_op_param(a, Inst::kIdAnd, dstreg, dstreg, maskp, true);                         // and   dstreg,dstreg,maskp
+
+	mov_param_reg(a, 4, dstp, dstreg);                                                  // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_save - process a SAVE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_save(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_M);
+
+	// copy live state to the destination
+	get_imm_relative(a, TEMP_REG1, uintptr_t(dstp.memory()));                           // mov   temp,dstp
+
+	// copy flags
+	a.mrs(TEMP_REG2, Imm(a64::Predicate::SysReg::kNZCV));                               // mrs   temp2,nzcv
+	a.lsr(TEMP_REG2, TEMP_REG2, 28);                                                    // lsr   temp2,temp2,28
+	get_imm_relative(a, TEMP_REG3, uintptr_t(&m_near.flagsmap[0]));                     // mov   temp3,flagsmap
+	a.ldrb(TEMP_REG2.w(), a64::ptr(TEMP_REG3, TEMP_REG2));                              // ldrb  temp2,[temp3+temp2]
+	a.strb(TEMP_REG2.w(), a64::ptr(TEMP_REG1, offsetof(drcuml_machine_state, flags)));  // strb  temp2,state->flags
+
+	// copy fmod and exp
+	emit_ldrb_mem(a, TEMP_REG2, &m_state.fmod);                                         // ldrb  temp2,[fmod]
+	a.strb(TEMP_REG2.w(), a64::ptr(TEMP_REG1, offsetof(drcuml_machine_state, fmod)));   // strb  temp2,state->fmod
+	emit_ldr_mem(a, TEMP_REG2.w(), &m_state.exp);                                       // ldr   temp2,[exp]
+	a.str(TEMP_REG2.w(), a64::ptr(TEMP_REG1, offsetof(drcuml_machine_state, exp)));     // str   temp2,state->exp
+
+	// copy integer registers
+	int regoffs = offsetof(drcuml_machine_state, r);
+	for (int regnum = 0; regnum < std::size(m_state.r); regnum++)
+	{
+		if (int_register_map[regnum] != 0)
+		{
+			a.str(x(int_register_map[regnum]), a64::ptr(TEMP_REG1, regoffs + 8 * regnum));
+		}
+		else
+		{
+			emit_ldr_mem(a, TEMP_REG2, &m_state.r[regnum].d);
+			a.str(TEMP_REG2, a64::ptr(TEMP_REG1, regoffs + 8 * regnum));
+		}
+	}
+
+	// copy FP registers
+	regoffs = offsetof(drcuml_machine_state, f);
+	for (int regnum = 0; regnum < std::size(m_state.f); regnum++)
+	{
+		if (float_register_map[regnum] != 0)
+		{
+			a.str(d(float_register_map[regnum]), a64::ptr(TEMP_REG1, regoffs + 8 * regnum));
+		}
+		else
+		{
+			emit_ldr_mem(a, TEMP_REG2, &m_state.f[regnum].d);
+			a.str(TEMP_REG2, a64::ptr(TEMP_REG1, regoffs + 8 * regnum));
+		}
+	}
+
+	// copy vector registers
+	regoffs = offsetof(drcuml_machine_state, v);
+	for (int regnum = 0; regnum < std::size(m_state.v); regnum++)
+	{
+		emit_float_ldr_mem(a, TEMPF_REG1.q(), &m_state.v[regnum]);
+		a.str(TEMPF_REG1.q(), a64::ptr(TEMP_REG1, regoffs + 16 * regnum));
+	}
+}
+
+
+//-------------------------------------------------
+//  op_restore - process a RESTORE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_restore(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+
+	// normalize parameters
+	be_parameter srcp(*this, inst.param(0), PTYPE_M);
+
+	// copy live state from the destination
+	get_imm_relative(a, TEMP_REG1, uintptr_t(srcp.memory()));                           // mov   temp,srcp
+
+	// copy integer registers
+	int regoffs = offsetof(drcuml_machine_state, r);
+	for (int regnum = 0; regnum < std::size(m_state.r); regnum++)
+	{
+		if (int_register_map[regnum] != 0)
+		{
+			a.ldr(x(int_register_map[regnum]), a64::ptr(TEMP_REG1, regoffs + 8 * regnum));
+		}
+		else
+		{
+			a.ldr(TEMP_REG2, a64::ptr(TEMP_REG1, regoffs + 8 * regnum));
+			emit_str_mem(a, TEMP_REG2, &m_state.r[regnum].d);
+		}
+	}
+
+	// copy FP registers
+	regoffs = offsetof(drcuml_machine_state, f);
+	for (int regnum = 0; regnum < std::size(m_state.f); regnum++)
+	{
+		if (float_register_map[regnum] != 0)
+		{
+			a.ldr(d(float_register_map[regnum]), a64::ptr(TEMP_REG1, regoffs + 8 * regnum));
+		}
+		else
+		{
+			a.ldr(TEMP_REG2, a64::ptr(TEMP_REG1, regoffs + 8 * regnum));
+			emit_str_mem(a, TEMP_REG2, &m_state.f[regnum].d);
+		}
+	}
+
+	// copy vector registers
+	regoffs = offsetof(drcuml_machine_state, v);
+	for (int regnum = 0; regnum < std::size(m_state.v); regnum++)
+	{
+		a.ldr(TEMPF_REG1.q(), a64::ptr(TEMP_REG1, regoffs + 16 * regnum));
+		emit_float_str_mem(a, TEMPF_REG1.q(), &m_state.v[regnum]);
+	}
+
+	// copy fmod and exp
+	a.ldrb(TEMP_REG2.w(), a64::ptr(TEMP_REG1, offsetof(drcuml_machine_state, fmod)));   // ldrb  temp2,state->fmod
+	a.and_(TEMP_REG2.w(), TEMP_REG2.w(), 3);                                            // and   temp2,temp2,3
+	emit_strb_mem(a, TEMP_REG2, &m_state.fmod);                                         // strb  temp2,[fmod]
+	emit_fpcr_rounding(a, TEMP_REG2);
+	a.ldr(TEMP_REG2.w(), a64::ptr(TEMP_REG1, offsetof(drcuml_machine_state, exp)));     // ldr   temp2,state->exp
+	emit_str_mem(a, TEMP_REG2.w(), &m_state.exp);                                       // str   temp2,[exp]
+
+	// copy flags
+	a.ldrb(TEMP_REG2.w(), a64::ptr(TEMP_REG1, offsetof(drcuml_machine_state, flags)));  // ldrb  temp2,state->flags
+	a.and_(TEMP_REG2.w(), TEMP_REG2.w(), 0x1f);                                         // and   temp2,temp2,0x1f
+	get_imm_relative(a, TEMP_REG3, uintptr_t(&m_near.flagsunmap[0]));                   // mov   temp3,flagsunmap
+	a.ldr(TEMP_REG2.w(), a64::ptr(TEMP_REG3, TEMP_REG2, arm::lsl(2)));                  // ldr   temp2,[temp3+temp2*4]
+	a.msr(Imm(a64::Predicate::SysReg::kNZCV), TEMP_REG2);                               // msr   nzcv,temp2
+}
+
+
+
+/***************************************************************************
+    INTEGER OPERATIONS
+***************************************************************************/
+
+//-------------------------------------------------
+//  get_indexed_mem - return a memory operand for
+//  a base address plus a scaled 32-bit index
+//-------------------------------------------------
+
+a64::Mem drcbe_arm64::get_indexed_mem(a64::Assembler &a, const void *base, be_parameter const &indp, uint32_t bytes, uint32_t scale) const
+{
+	// a constant index folds into the address
+	if (indp.is_immediate())
+		return get_mem_absolute(a, reinterpret_cast<const uint8_t *>(base) + (int64_t(int32_t(indp.immediate())) << scale), bytes);
+
+	// otherwise sign-extend the index and use register offset addressing
+	get_imm_relative(a, TEMP_REG2, uintptr_t(base));                                    // mov   temp2,base
+	a64::Gp const indreg = get_reg_param(a, 4, indp, TEMP_REG3);
+	a.sxtw(TEMP_REG3, indreg);                                                          // sxtw  temp3,indp
+	if ((scale == 0) || ((1U << scale) == bytes))
+		return a64::ptr(TEMP_REG2, TEMP_REG3, arm::lsl(scale));
+
+	a.add(TEMP_REG2, TEMP_REG2, TEMP_REG3, arm::lsl(scale));                            // add   temp2,temp2,temp3,lsl scale
+	return a64::ptr(TEMP_REG2);
+}
+
+
+//-------------------------------------------------
+//  op_load - process a LOAD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_load(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &scalesizep = inst.param(3);
+	assert(scalesizep.is_size_scale());
+	int const size = scalesizep.size();
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG1, inst.size());
+
+	a64::Mem const mem = get_indexed_mem(a, basep.memory(), indp, 1 << size, scalesizep.scale());
+	if (size == SIZE_BYTE)
+		a.ldrb(dstreg.w(), mem);                                                        // ldrb  dstreg,[basep + scale*indp]
+	else if (size == SIZE_WORD)
+		a.ldrh(dstreg.w(), mem);                                                        // ldrh  dstreg,[basep + scale*indp]
+	else if (size == SIZE_DWORD)
+		a.ldr(dstreg.w(), mem);                                                         // ldr   dstreg,[basep + scale*indp]
+	else if (size == SIZE_QWORD)
+		a.ldr(dstreg.x(), mem);                                                         // ldr   dstreg,[basep + scale*indp]
+
+	// store result
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_loads - process a LOADS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_loads(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &scalesizep = inst.param(3);
+	assert(scalesizep.is_size_scale());
+	int const size = scalesizep.size();
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG1, inst.size());
+
+	a64::Mem const mem = get_indexed_mem(a, basep.memory(), indp, 1 << size, scalesizep.scale());
+	if (size == SIZE_BYTE)
+		a.ldrsb(dstreg, mem);                                                           // ldrsb dstreg,[basep + scale*indp]
+	else if (size == SIZE_WORD)
+		a.ldrsh(dstreg, mem);                                                           // ldrsh dstreg,[basep + scale*indp]
+	else if ((size == SIZE_DWORD) && (inst.size() == 8))
+		a.ldrsw(dstreg, mem);                                                           // ldrsw dstreg,[basep + scale*indp]
+	else if (size == SIZE_DWORD)
+		a.ldr(dstreg, mem);                                                             // ldr   dstreg,[basep + scale*indp]
+	else if (size == SIZE_QWORD)
+		a.ldr(dstreg.x(), mem);                                                         // ldr   dstreg,[basep + scale*indp]
+
+	// store result
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_store - process a STORE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_store(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter basep(*this, inst.param(0), PTYPE_M);
+	be_parameter indp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &scalesizep = inst.param(3);
+	assert(scalesizep.is_size_scale());
+	int const size = scalesizep.size();
+
+	// get the source into a register, using the zero register for zero
+	uint32_t const regsize = (size == SIZE_QWORD) ? 8 : 4;
+	a64::Gp const srcreg = srcp.is_immediate_value(0)
+			? select_register(a64::Gp(xzr), regsize)
+			: get_reg_param(a, regsize, srcp, TEMP_REG1);
+
+	a64::Mem const mem = get_indexed_mem(a, basep.memory(), indp, 1 << size, scalesizep.scale());
+	if (size == SIZE_BYTE)
+		a.strb(srcreg.w(), mem);                                                        // strb  srcreg,[basep + scale*indp]
+	else if (size == SIZE_WORD)
+		a.strh(srcreg.w(), mem);                                                        // strh  srcreg,[basep + scale*indp]
+	else if (size == SIZE_DWORD)
+		a.str(srcreg.w(), mem);                                                         // str   srcreg,[basep + scale*indp]
+	else if (size == SIZE_QWORD)
+		a.str(srcreg.x(), mem);                                                         // str   srcreg,[basep + scale*indp]
+}
+
+
+//-------------------------------------------------
+//  op_read - process a READ opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_read(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter addrp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(2);
+	assert(spacesizep.is_size_space());
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG1, inst.size());
+
+	// set up a call to the read handler
+	auto const &trampolines = m_accessors[spacesizep.space()];
+	auto const &resolved = m_resolved_accessors[spacesizep.space()];
+	mov_reg_param(a, 4, REG_PARAM2, addrp);                                             // mov   param2,addrp
+	if (spacesizep.size() == SIZE_BYTE)
+	{
+		call_accessor(a, resolved.read_byte, (const void *)trampolines.read_byte, spacesizep.space());
+		a.and_(dstreg.w(), REG_PARAM1.w(), 0xff);                                       // and   dstreg,w0,0xff
+	}
+	else if (spacesizep.size() == SIZE_WORD)
+	{
+		call_accessor(a, resolved.read_word, (const void *)trampolines.read_word, spacesizep.space());
+		a.and_(dstreg.w(), REG_PARAM1.w(), 0xffff);                                     // and   dstreg,w0,0xffff
+	}
+	else if (spacesizep.size() == SIZE_DWORD)
+	{
+		call_accessor(a, resolved.read_dword, (const void *)trampolines.read_dword, spacesizep.space());
+		a.mov(dstreg.w(), REG_PARAM1.w());                                              // mov   dstreg,w0
+	}
+	else if (spacesizep.size() == SIZE_QWORD)
+	{
+		call_accessor(a, resolved.read_qword, (const void *)trampolines.read_qword, spacesizep.space());
+		a.mov(dstreg.x(), REG_PARAM1);                                                  // mov   dstreg,x0
+	}
+
+	// store result
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_readm - process a READM opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_readm(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter addrp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(3);
+	assert(spacesizep.is_size_space());
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG1, inst.size());
+
+	// set up a call to the read handler
+	auto const &trampolines = m_accessors[spacesizep.space()];
+	auto const &resolved = m_resolved_accessors[spacesizep.space()];
+	mov_reg_param(a, 4, REG_PARAM2, addrp);                                             // mov   param2,addrp
+	mov_reg_param(a, (spacesizep.size() == SIZE_QWORD) ? 8 : 4, REG_PARAM3, maskp);     // mov   param3,maskp
+	if (spacesizep.size() == SIZE_WORD)
+	{
+		call_accessor(a, resolved.read_word_masked, (const void *)trampolines.read_word_masked, spacesizep.space());
+		a.and_(dstreg.w(), REG_PARAM1.w(), 0xffff);                                     // and   dstreg,w0,0xffff
+	}
+	else if (spacesizep.size() == SIZE_DWORD)
+	{
+		call_accessor(a, resolved.read_dword_masked, (const void *)trampolines.read_dword_masked, spacesizep.space());
+		a.mov(dstreg.w(), REG_PARAM1.w());                                              // mov   dstreg,w0
+	}
+	else if (spacesizep.size() == SIZE_QWORD)
+	{
+		call_accessor(a, resolved.read_qword_masked, (const void *)trampolines.read_qword_masked, spacesizep.space());
+		a.mov(dstreg.x(), REG_PARAM1);                                                  // mov   dstreg,x0
+	}
+
+	// store result
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_write - process a WRITE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_write(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter addrp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(2);
+	assert(spacesizep.is_size_space());
+
+	// set up a call to the write handler
+	auto const &trampolines = m_accessors[spacesizep.space()];
+	auto const &resolved = m_resolved_accessors[spacesizep.space()];
+	mov_reg_param(a, 4, REG_PARAM2, addrp);                                             // mov   param2,addrp
+	mov_reg_param(a, (spacesizep.size() == SIZE_QWORD) ? 8 : 4, REG_PARAM3, srcp);      // mov   param3,srcp
+	if (spacesizep.size() == SIZE_BYTE)
+		call_accessor(a, resolved.write_byte, (const void *)trampolines.write_byte, spacesizep.space());
+	else if (spacesizep.size() == SIZE_WORD)
+		call_accessor(a, resolved.write_word, (const void *)trampolines.write_word, spacesizep.space());
+	else if (spacesizep.size() == SIZE_DWORD)
+		call_accessor(a, resolved.write_dword, (const void *)trampolines.write_dword, spacesizep.space());
+	else if (spacesizep.size() == SIZE_QWORD)
+		call_accessor(a, resolved.write_qword, (const void *)trampolines.write_qword, spacesizep.space());
+}
+
+
+//-------------------------------------------------
+//  op_writem - process a WRITEM opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_writem(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter addrp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(2), PTYPE_MRI);
+	const parameter &spacesizep = inst.param(3);
+	assert(spacesizep.is_size_space());
+
+	// set up a call to the write handler
+	auto const &trampolines = m_accessors[spacesizep.space()];
+	auto const &resolved = m_resolved_accessors[spacesizep.space()];
+	uint32_t const regsize = (spacesizep.size() == SIZE_QWORD) ? 8 : 4;
+	mov_reg_param(a, 4, REG_PARAM2, addrp);                                             // mov   param2,addrp
+	mov_reg_param(a, regsize, REG_PARAM3, srcp);                                        // mov   param3,srcp
+	mov_reg_param(a, regsize, REG_PARAM4, maskp);                                       // mov   param4,maskp
+	if (spacesizep.size() == SIZE_WORD)
+		call_accessor(a, resolved.write_word_masked, (const void *)trampolines.write_word_masked, spacesizep.space());
+	else if (spacesizep.size() == SIZE_DWORD)
+		call_accessor(a, resolved.write_dword_masked, (const void *)trampolines.write_dword_masked, spacesizep.space());
+	else if (spacesizep.size() == SIZE_QWORD)
+		call_accessor(a, resolved.write_qword_masked, (const void *)trampolines.write_qword_masked, spacesizep.space());
+}
+
+
+//-------------------------------------------------
+//  op_carry - process a CARRY opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_carry(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C);
+
+	// normalize parameters
+	be_parameter srcp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter bitp(*this, inst.param(1), PTYPE_MRI);
+
+	uint32_t const bits = inst.size() * 8;
+	a64::Gp const bitreg = select_register(TEMP_REG2, inst.size());
+
+	// extract the bit into bit 0 of a register and copy it to the host carry
+	a64::Gp const src = get_reg_param(a, inst.size(), srcp, TEMP_REG1);
+	if (bitp.is_immediate())
+	{
+		a.ubfx(bitreg, src, bitp.immediate() & (bits - 1), 1);                          // ubfx  bitreg,src,bitp,1
+	}
+	else
+	{
+		a64::Gp const shift = get_reg_param(a, inst.size(), bitp, TEMP_REG2);
+		a.lsrv(bitreg, src, shift);                                                     // lsrv  bitreg,src,bitp
+	}
+	store_carry_reg(a, bitreg);
+}
+
+
+//-------------------------------------------------
+//  op_set - process a SET opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_set(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG1, inst.size());
+
+	// set to 1 or 0 depending on the condition
+	emit_cset(a, inst.condition(), dstreg);
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_mov - process a MOV opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_mov(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+
+	// skip if conditional
+	Label skip = a.newLabel();
+	emit_skip(a, inst.condition(), skip);
+
+	mov_param_param(a, inst.size(), dstp, srcp);                                        // mov   dstp,srcp
+
+	// resolve the jump
+	a.bind(skip);                                                                   // skip:
+}
+
+
+//-------------------------------------------------
+//  op_sext - process a SEXT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_sext(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_S | FLAG_Z);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG1, inst.size());
+
+	// memory sources can be sign-extended as they are loaded
+	if (srcp.is_memory())
+	{
+		if (sizep.size() == SIZE_BYTE)
+			a.ldrsb(dstreg, get_mem_absolute(a, srcp.memory(), 1));                     // ldrsb dstreg,[srcp]
+		else if (sizep.size() == SIZE_WORD)
+			a.ldrsh(dstreg, get_mem_absolute(a, srcp.memory(), 2));                     // ldrsh dstreg,[srcp]
+		else if ((sizep.size() == SIZE_DWORD) && (inst.size() == 8))
+			a.ldrsw(dstreg, get_mem_absolute(a, srcp.memory(), 4));                     // ldrsw dstreg,[srcp]
+		else
+			emit_ldr_mem(a, dstreg, srcp.memory());                                     // ldr   dstreg,[srcp]
+	}
+	else
+	{
+		a64::Gp const src = get_reg_param(a, inst.size(), srcp, TEMP_REG1);
+		if (sizep.size() == SIZE_BYTE)
+			a.sxtb(dstreg, src.w());                                                    // sxtb  dstreg,src
+		else if (sizep.size() == SIZE_WORD)
+			a.sxth(dstreg, src.w());                                                    // sxth  dstreg,src
+		else if ((sizep.size() == SIZE_DWORD) && (inst.size() == 8))
+			a.sxtw(dstreg, src.w());                                                    // sxtw  dstreg,src
+		else if (dstreg.id() != src.id())
+			a.mov(dstreg, src);                                                         // mov   dstreg,src
+	}
+
+	// compute flags if requested
+	if (inst.flags())
+		a.tst(dstreg, dstreg);                                                          // tst   dstreg,dstreg
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_roland - process an ROLAND opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_roland(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_S | FLAG_Z);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(3), PTYPE_MRI);
+
+	uint32_t const bits = inst.size() * 8;
+	uint64_t const sizemask = (inst.size() == 4) ? 0xffffffffU : ~uint64_t(0);
+
+	// the mask is read after the destination is written, so don't clobber it
+	a64::Gp const dstreg = (dstp == maskp) ? select_register(TEMP_REG2, inst.size()) : dstp.select_register(TEMP_REG2, inst.size());
+	a64::Gp const src = get_reg_param(a, inst.size(), srcp, TEMP_REG1);
+
+	if (shiftp.is_immediate() && maskp.is_immediate())
+	{
+		uint32_t const shift = shiftp.immediate() & (bits - 1);
+		uint64_t const mask = maskp.immediate() & sizemask;
+
+		// extracting a field that doesn't wrap around is a bitfield extract
+		if (mask && !(mask & (mask + 1)) && shift && (population_count_64(mask) <= shift))
+		{
+			a.ubfx(dstreg, src, bits - shift, population_count_64(mask));               // ubfx  dstreg,src,bits-shift,width
+			if (inst.flags())
+				a.tst(dstreg, dstreg);                                                  // tst   dstreg,dstreg
+			mov_param_reg(a, inst.size(), dstp, dstreg);                                // mov   dstp,dstreg
+			return;
+		}
+	}
+
+	// rotate left by rotating right by the complement
+	if (shiftp.is_immediate())
+	{
+		uint32_t const shift = shiftp.immediate() & (bits - 1);
+		if (shift)
+			a.ror(dstreg, src, bits - shift);                                           // ror   dstreg,src,bits-shift
+		else if (dstreg.id() != src.id())
+			a.mov(dstreg, src);                                                         // mov   dstreg,src
+	}
+	else
+	{
+		a64::Gp const shift = get_reg_param(a, inst.size(), shiftp, TEMP_REG3);
+		a64::Gp const negshift = select_register(TEMP_REG3, inst.size());
+		a.neg(negshift, shift);                                                         // neg   negshift,shift
+		a.rorv(dstreg, src, negshift);                                                  // rorv  dstreg,src,negshift
+	}
+
+	// apply the mask, computing flags if requested
+	alu_op_param(a, inst.flags() ? Inst::kIdAnds : Inst::kIdAnd, dstreg, dstreg, maskp, true);
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_rolins - process an ROLINS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_rolins(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_S | FLAG_Z);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+	be_parameter maskp(*this, inst.param(3), PTYPE_MRI);
+
+	uint32_t const bits = inst.size() * 8;
+	uint64_t const sizemask = (inst.size() == 4) ? 0xffffffffU : ~uint64_t(0);
+
+	// the destination is also an input
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG2, inst.size());
+	mov_reg_param(a, inst.size(), dstreg, dstp);                                        // mov   dstreg,dstp
+	a64::Gp const src = get_reg_param(a, inst.size(), srcp, TEMP_REG1);
+
+	if (shiftp.is_immediate() && maskp.is_immediate())
+	{
+		uint32_t const shift = shiftp.immediate() & (bits - 1);
+		uint64_t const mask = maskp.immediate() & sizemask;
+
+		// inserting a field at the rotate position is a bitfield insert
+		if (mask && !((mask >> shift) & ((mask >> shift) + 1)) && ((mask >> shift) << shift) == mask)
+		{
+			a.bfi(dstreg, src, shift, population_count_64(mask));                       // bfi   dstreg,src,shift,width
+			if (inst.flags())
+				a.tst(dstreg, dstreg);                                                  // tst   dstreg,dstreg
+			mov_param_reg(a, inst.size(), dstp, dstreg);                                // mov   dstp,dstreg
+			return;
+		}
+	}
+
+	// rotate the source into a temporary
+	a64::Gp const rotreg = select_register(TEMP_REG1, inst.size());
+	if (shiftp.is_immediate())
+	{
+		uint32_t const shift = shiftp.immediate() & (bits - 1);
+		if (shift)
+			a.ror(rotreg, src, bits - shift);                                           // ror   rotreg,src,bits-shift
+		else if (rotreg.id() != src.id())
+			a.mov(rotreg, src);                                                         // mov   rotreg,src
+	}
+	else
+	{
+		a64::Gp const shift = get_reg_param(a, inst.size(), shiftp, TEMP_REG3);
+		a64::Gp const negshift = select_register(TEMP_REG3, inst.size());
+		a.neg(negshift, shift);                                                         // neg   negshift,shift
+		a.rorv(rotreg, src, negshift);                                                  // rorv  rotreg,src,negshift
+	}
+
+	// merge the masked bits into the destination
+	if (maskp.is_immediate() && is_valid_immediate_mask(maskp.immediate(), inst.size()) && is_valid_immediate_mask(~maskp.immediate(), inst.size()))
+	{
+		uint64_t const mask = maskp.immediate() & sizemask;
+		a.and_(rotreg, rotreg, mask);                                                   // and   rotreg,rotreg,mask
+		a.and_(dstreg, dstreg, ~mask & sizemask);                                       // and   dstreg,dstreg,~mask
+	}
+	else
+	{
+		a64::Gp const maskreg = get_reg_param(a, inst.size(), maskp, TEMP_REG3);
+		a.and_(rotreg, rotreg, maskreg);                                                // and   rotreg,rotreg,mask
+		a.bic(dstreg, dstreg, maskreg);                                                 // bic   dstreg,dstreg,mask
+	}
+	a.orr(dstreg, dstreg, rotreg);                                                      // orr   dstreg,dstreg,rotreg
+
+	// compute flags if requested
+	if (inst.flags())
+		a.tst(dstreg, dstreg);                                                          // tst   dstreg,dstreg
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_add - process a ADD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_add(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+	if (src1p.is_immediate() && !src2p.is_immediate())
+		std::swap(src1p, src2p);
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG3, inst.size());
+
+	a64::Gp const src1 = get_reg_param(a, inst.size(), src1p, TEMP_REG1);
+	alu_op_param(a, inst.flags() ? Inst::kIdAdds : Inst::kIdAdd, dstreg, src1, src2p, false);
+																						// add   dstreg,src1,src2p
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_addc - process a ADDC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_addc(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG3, inst.size());
+
+	// the host carry is the UML carry, so add with carry directly
+	a64::Gp const src1 = get_reg_param(a, inst.size(), src1p, TEMP_REG1);
+	a64::Gp const src2 = get_reg_param(a, inst.size(), src2p, TEMP_REG2);
+	a.emit(inst.flags() ? Inst::kIdAdcs : Inst::kIdAdc, dstreg, src1, src2);            // adc   dstreg,src1,src2
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_sub - process a SUB opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_sub(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG3, inst.size());
+
+	a64::Gp const src1 = get_reg_param(a, inst.size(), src1p, TEMP_REG1);
+	alu_op_param(a, inst.flags() ? Inst::kIdSubs : Inst::kIdSub, dstreg, src1, src2p, false);
+																						// sub   dstreg,src1,src2p
+	if (inst.flags() & FLAG_C)
+		invert_carry(a);
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_subc - process a SUBC opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_subc(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG3, inst.size());
+
+	// the host subtracts the inverse of its carry, so flip it on the way in (and out)
+	a64::Gp const src1 = get_reg_param(a, inst.size(), src1p, TEMP_REG1);
+	a64::Gp const src2 = get_reg_param(a, inst.size(), src2p, TEMP_REG2);
+	invert_carry(a);
+	a.emit(inst.flags() ? Inst::kIdSbcs : Inst::kIdSbc, dstreg, src1, src2);            // sbc   dstreg,src1,src2
+	if (inst.flags() & FLAG_C)
+		invert_carry(a);
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_cmp - process a CMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_cmp(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter src1p(*this, inst.param(0), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(1), PTYPE_MRI);
+
+	// compare by subtracting into the zero register
+	a64::Gp const src1 = get_reg_param(a, inst.size(), src1p, TEMP_REG1);
+	alu_op_param(a, Inst::kIdSubs, select_register(a64::Gp(xzr), inst.size()), src1, src2p, false);
+																						// cmp   src1,src2p
+	if (inst.flags() & FLAG_C)
+		invert_carry(a);
+}
+
+
+//-------------------------------------------------
+//  op_mulu - process a MULU opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_mulu(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	bool const compute_hi = (dstp != edstp);
+
+	a64::Gp const src1 = get_reg_param(a, inst.size(), src1p, TEMP_REG1);
+	a64::Gp const src2 = get_reg_param(a, inst.size(), src2p, TEMP_REG2);
+	a64::Gp const lo = TEMP_REG3;
+	a64::Gp const hi = TEMP_REG4;
+
+	if (inst.size() == 4)
+	{
+		// the whole product fits in a 64-bit register
+		a.umull(lo, src1, src2);                                                        // umull lo,src1,src2
+		if (compute_hi || inst.flags())
+			a.lsr(hi, lo, 32);                                                          // lsr   hi,lo,32
+	}
+	else
+	{
+		a.mul(lo, src1, src2);                                                          // mul   lo,src1,src2
+		if (compute_hi || inst.flags())
+			a.umulh(hi, src1, src2);                                                    // umulh hi,src1,src2
+	}
+
+	// store the high half first so the low half wins if they're the same
+	if (compute_hi)
+		mov_param_reg(a, inst.size(), edstp, hi);                                       // mov   edstp,hi
+	mov_param_reg(a, inst.size(), dstp, lo);                                            // mov   dstp,lo
+
+	// compute flags from the full product
+	if (inst.flags())
+	{
+		a64::Gp const n = TEMP_REG5;
+		a64::Gp const z = TEMP_REG6;
+		if (inst.size() == 4)
+		{
+			a.lsr(n, lo, 63);                                                           // lsr   n,lo,63
+			a.cmp(lo, 0);                                                               // cmp   lo,0
+		}
+		else
+		{
+			a.lsr(n, hi, 63);                                                           // lsr   n,hi,63
+			a.orr(z, lo, hi);                                                           // orr   z,lo,hi
+			a.cmp(z, 0);                                                                // cmp   z,0
+		}
+		a.cset(z, CondCode::kEQ);                                                       // cset  z,eq
+		a.cmp(hi, 0);                                                                   // cmp   hi,0
+		a.cset(hi, CondCode::kNE);                                                      // cset  v,ne
+		store_nzcv(a, z, n, hi);
+	}
+}
+
+
+//-------------------------------------------------
+//  op_muls - process a MULS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_muls(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	bool const compute_hi = (dstp != edstp);
+
+	a64::Gp const src1 = get_reg_param(a, inst.size(), src1p, TEMP_REG1);
+	a64::Gp const src2 = get_reg_param(a, inst.size(), src2p, TEMP_REG2);
+	a64::Gp const lo = TEMP_REG3;
+	a64::Gp const hi = TEMP_REG4;
+
+	if (inst.size() == 4)
+	{
+		// the whole product fits in a 64-bit register
+		a.smull(lo, src1, src2);                                                        // smull lo,src1,src2
+		if (compute_hi)
+			a.lsr(hi, lo, 32);                                                          // lsr   hi,lo,32
+	}
+	else
+	{
+		a.mul(lo, src1, src2);                                                          // mul   lo,src1,src2
+		if (compute_hi || inst.flags())
+			a.smulh(hi, src1, src2);                                                    // smulh hi,src1,src2
+	}
+
+	// store the high half first so the low half wins if they're the same
+	if (compute_hi)
+		mov_param_reg(a, inst.size(), edstp, hi);                                       // mov   edstp,hi
+	mov_param_reg(a, inst.size(), dstp, lo);                                            // mov   dstp,lo
+
+	// compute flags; overflow means the result doesn't fit in the low half
+	if (inst.flags())
+	{
+		a64::Gp const n = TEMP_REG5;
+		a64::Gp const z = TEMP_REG6;
+		if (inst.size() == 4)
+		{
+			a.sxtw(hi, lo.w());                                                         // sxtw  hi,lo
+			a.cmp(lo, hi);                                                              // cmp   lo,hi
+			a.cset(hi, CondCode::kNE);                                                  // cset  v,ne
+			a.tst(lo.w(), lo.w());                                                      // tst   lo,lo
+			a.cset(n, CondCode::kMI);                                                   // cset  n,mi
+			a.cset(z, CondCode::kEQ);                                                   // cset  z,eq
+		}
+		else
+		{
+			a.lsr(n, hi, 63);                                                           // lsr   n,hi,63
+			a.orr(z, lo, hi);                                                           // orr   z,lo,hi
+			a.cmp(z, 0);                                                                // cmp   z,0
+			a.cset(z, CondCode::kEQ);                                                   // cset  z,eq
+			a.cmp(hi, lo, arm::asr(63));                                                // cmp   hi,lo,asr 63
+			a.cset(hi, CondCode::kNE);                                                  // cset  v,ne
+		}
+		store_nzcv(a, z, n, hi);
+	}
+}
+
+
+//-------------------------------------------------
+//  op_divu - process a DIVU opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_divu(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	bool const compute_rem = (dstp != edstp);
+
+	a64::Gp const src1 = get_reg_param(a, inst.size(), src1p, TEMP_REG1);
+	a64::Gp const src2 = get_reg_param(a, inst.size(), src2p, TEMP_REG2);
+	a64::Gp const quo = select_register(TEMP_REG3, inst.size());
+	a64::Gp const rem = select_register(TEMP_REG4, inst.size());
+
+	// dividing by zero leaves the destinations alone and sets V
+	Label skipzero = a.newLabel();
+	Label done = a.newLabel();
+	a.cbz(src2, skipzero);                                                              // cbz   src2,skipzero
+
+	a.udiv(quo, src1, src2);                                                            // udiv  quo,src1,src2
+	if (compute_rem)
+	{
+		a.msub(rem, quo, src2, src1);                                                   // msub  rem,quo,src2,src1
+		mov_param_reg(a, inst.size(), edstp, rem);                                      // mov   edstp,rem
+	}
+	mov_param_reg(a, inst.size(), dstp, quo);                                           // mov   dstp,quo
+
+	if (inst.flags())
+	{
+		a.tst(quo, quo);                                                                // tst   quo,quo
+		a.b(done);                                                                      // b     done
+
+		a.bind(skipzero);                                                           // skipzero:
+		a.mov(SCRATCH_REG2, NZCV_V);                                                    // mov   scratch,#V
+		a.msr(Imm(a64::Predicate::SysReg::kNZCV), SCRATCH_REG2);                        // msr   nzcv,scratch
+		a.bind(done);                                                               // done:
+	}
+	else
+	{
+		a.bind(skipzero);                                                           // skipzero:
+	}
+}
+
+
+//-------------------------------------------------
+//  op_divs - process a DIVS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_divs(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_V | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter edstp(*this, inst.param(1), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(2), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(3), PTYPE_MRI);
+	bool const compute_rem = (dstp != edstp);
+
+	a64::Gp const src1 = get_reg_param(a, inst.size(), src1p, TEMP_REG1);
+	a64::Gp const src2 = get_reg_param(a, inst.size(), src2p, TEMP_REG2);
+	a64::Gp const quo = select_register(TEMP_REG3, inst.size());
+	a64::Gp const rem = select_register(TEMP_REG4, inst.size());
+
+	// dividing by zero leaves the destinations alone and sets V
+	Label skipzero = a.newLabel();
+	Label done = a.newLabel();
+	a.cbz(src2, skipzero);                                                              // cbz   src2,skipzero
+
+	a.sdiv(quo, src1, src2);                                                            // sdiv  quo,src1,src2
+	if (compute_rem)
+	{
+		a.msub(rem, quo, src2, src1);                                                   // msub  rem,quo,src2,src1
+		mov_param_reg(a, inst.size(), edstp, rem);                                      // mov   edstp,rem
+	}
+	mov_param_reg(a, inst.size(), dstp, quo);                                           // mov   dstp,quo
+
+	if (inst.flags())
+	{
+		a.tst(quo, quo);                                                                // tst   quo,quo
+		a.b(done);                                                                      // b     done
+
+		a.bind(skipzero);                                                           // skipzero:
+		a.mov(SCRATCH_REG2, NZCV_V);                                                    // mov   scratch,#V
+		a.msr(Imm(a64::Predicate::SysReg::kNZCV), SCRATCH_REG2);                        // msr   nzcv,scratch
+		a.bind(done);                                                               // done:
+	}
+	else
+	{
+		a.bind(skipzero);                                                           // skipzero:
+	}
+}
+
+
+//-------------------------------------------------
+//  op_and - process a AND opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_and(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+	if (src1p.is_immediate() && !src2p.is_immediate())
+		std::swap(src1p, src2p);
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG3, inst.size());
+
+	a64::Gp const src1 = get_reg_param(a, inst.size(), src1p, TEMP_REG1);
+	alu_op_param(a, inst.flags() ? Inst::kIdAnds : Inst::kIdAnd, dstreg, src1, src2p, true);
+																						// and   dstreg,src1,src2p
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_test - process a TEST opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_test(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter src1p(*this, inst.param(0), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(1), PTYPE_MRI);
+	if (src1p.is_immediate() && !src2p.is_immediate())
+		std::swap(src1p, src2p);
+
+	a64::Gp const src1 = get_reg_param(a, inst.size(), src1p, TEMP_REG1);
+	alu_op_param(a, Inst::kIdAnds, select_register(a64::Gp(xzr), inst.size()), src1, src2p, true);
+																						// tst   src1,src2p
+}
+
+
+//-------------------------------------------------
+//  op_or - process a OR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_or(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+	if (src1p.is_immediate() && !src2p.is_immediate())
+		std::swap(src1p, src2p);
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG3, inst.size());
+
+	a64::Gp const src1 = get_reg_param(a, inst.size(), src1p, TEMP_REG1);
+	alu_op_param(a, Inst::kIdOrr, dstreg, src1, src2p, true);                           // orr   dstreg,src1,src2p
+	if (inst.flags())
+		a.tst(dstreg, dstreg);                                                          // tst   dstreg,dstreg
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_xor - process a XOR opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_xor(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MRI);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
+	if (src1p.is_immediate() && !src2p.is_immediate())
+		std::swap(src1p, src2p);
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG3, inst.size());
+
+	a64::Gp const src1 = get_reg_param(a, inst.size(), src1p, TEMP_REG1);
+	alu_op_param(a, Inst::kIdEor, dstreg, src1, src2p, true);                           // eor   dstreg,src1,src2p
+	if (inst.flags())
+		a.tst(dstreg, dstreg);                                                          // tst   dstreg,dstreg
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_lzcnt - process a LZCNT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_lzcnt(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG2, inst.size());
+
+	a64::Gp const src = get_reg_param(a, inst.size(), srcp, TEMP_REG1);
+	a.clz(dstreg, src);                                                                 // clz   dstreg,src
+	if (inst.flags())
+		a.tst(dstreg, dstreg);                                                          // tst   dstreg,dstreg
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_tzcnt - process a TZCNT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_tzcnt(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG2, inst.size());
+
+	// count trailing zeroes by reversing the bits and counting leading zeroes
+	a64::Gp const src = get_reg_param(a, inst.size(), srcp, TEMP_REG1);
+	a64::Gp const rev = select_register(TEMP_REG3, inst.size());
+	a.rbit(rev, src);                                                                   // rbit  rev,src
+	a.clz(dstreg, rev);                                                                 // clz   dstreg,rev
+
+	// Z is set only when the source was zero
+	if (inst.flags())
+	{
+		a.eor(rev, dstreg, inst.size() * 8);                                            // eor   rev,dstreg,bits
+		a.tst(rev, rev);                                                                // tst   rev,rev
+	}
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_bswap - process a BSWAP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_bswap(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG2, inst.size());
+
+	a64::Gp const src = get_reg_param(a, inst.size(), srcp, TEMP_REG1);
+	a.rev(dstreg, src);                                                                 // rev   dstreg,src
+	if (inst.flags())
+		a.tst(dstreg, dstreg);                                                          // tst   dstreg,dstreg
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_shift - process a SHL/SHR/SAR/ROL/ROR
+//  opcode
+//-------------------------------------------------
+
+template <uml::opcode_t Opcode>
+void drcbe_arm64::op_shift(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+
+	uint32_t const bits = inst.size() * 8;
+
+	a64::Gp const src = get_reg_param(a, inst.size(), srcp, TEMP_REG1);
+
+	if (shiftp.is_immediate())
+	{
+		// pick a target register for the general case
+		a64::Gp const dstreg = dstp.select_register(TEMP_REG2, inst.size());
+		a64::Gp const carry = select_register(TEMP_REG3, inst.size());
+		uint32_t const shift = shiftp.immediate() & (bits - 1);
+
+		if (shift == 0)
+		{
+			// a zero count leaves the flags alone, except ROR which always sets S and Z
+			if (dstreg.id() != src.id())
+				a.mov(dstreg, src);                                                     // mov   dstreg,src
+			if ((Opcode == uml::OP_ROR) && inst.flags())
+				a.tst(dstreg, dstreg);                                                  // tst   dstreg,dstreg
+		}
+		else
+		{
+			// grab the last bit shifted out before the source can be overwritten
+			if (inst.flags())
+			{
+				if ((Opcode == uml::OP_SHL) || (Opcode == uml::OP_ROL))
+					a.ubfx(carry, src, bits - shift, 1);                                // ubfx  carry,src,bits-shift,1
+				else
+					a.ubfx(carry, src, shift - 1, 1);                                   // ubfx  carry,src,shift-1,1
+			}
+
+			if (Opcode == uml::OP_SHL)
+				a.lsl(dstreg, src, shift);                                              // lsl   dstreg,src,shift
+			else if (Opcode == uml::OP_SHR)
+				a.lsr(dstreg, src, shift);                                              // lsr   dstreg,src,shift
+			else if (Opcode == uml::OP_SAR)
+				a.asr(dstreg, src, shift);                                              // asr   dstreg,src,shift
+			else if (Opcode == uml::OP_ROL)
+				a.ror(dstreg, src, bits - shift);                                       // ror   dstreg,src,bits-shift
+			else
+				a.ror(dstreg, src, shift);                                              // ror   dstreg,src,shift
+
+			if (inst.flags())
+			{
+				a.tst(dstreg, dstreg);                                                  // tst   dstreg,dstreg
+				store_carry_reg(a, carry);
+			}
+		}
+
+		mov_param_reg(a, inst.size(), dstp, dstreg);                                    // mov   dstp,dstreg
+	}
+	else if (!inst.flags())
+	{
+		// pick a target register for the general case
+		a64::Gp const dstreg = dstp.select_register(TEMP_REG2, inst.size());
+		a64::Gp const shift = get_reg_param(a, inst.size(), shiftp, TEMP_REG3);
+
+		// variable shifts take the count modulo the register size
+		if (Opcode == uml::OP_SHL)
+		{
+			a.lslv(dstreg, src, shift);                                                 // lslv  dstreg,src,shift
+		}
+		else if (Opcode == uml::OP_SHR)
+		{
+			a.lsrv(dstreg, src, shift);                                                 // lsrv  dstreg,src,shift
+		}
+		else if (Opcode == uml::OP_SAR)
+		{
+			a.asrv(dstreg, src, shift);                                                 // asrv  dstreg,src,shift
+		}
+		else if (Opcode == uml::OP_ROL)
+		{
+			a64::Gp const negshift = select_register(TEMP_REG4, inst.size());
+			a.neg(negshift, shift);                                                     // neg   negshift,shift
+			a.rorv(dstreg, src, negshift);                                              // rorv  dstreg,src,negshift
+		}
+		else
+		{
+			a.rorv(dstreg, src, shift);                                                 // rorv  dstreg,src,shift
+		}
+
+		mov_param_reg(a, inst.size(), dstp, dstreg);                                    // mov   dstp,dstreg
+	}
+	else
+	{
+		// compute into a temporary so the source stays available for the carry
+		a64::Gp const result = select_register(TEMP_REG6, inst.size());
+		a64::Gp const count = select_register(TEMP_REG5, inst.size());
+		a64::Gp const carry = select_register(TEMP_REG4, inst.size());
+		a64::Gp const shift = get_reg_param(a, inst.size(), shiftp, TEMP_REG3);
+		a.and_(count, shift, bits - 1);                                                 // and   count,shift,bits-1
+
+		if (Opcode == uml::OP_SHL)
+			a.lslv(result, src, count);                                                 // lslv  result,src,count
+		else if (Opcode == uml::OP_SHR)
+			a.lsrv(result, src, count);                                                 // lsrv  result,src,count
+		else if (Opcode == uml::OP_SAR)
+			a.asrv(result, src, count);                                                 // asrv  result,src,count
+		else if (Opcode == uml::OP_ROL)
+		{
+			a.neg(carry, count);                                                        // neg   carry,count
+			a.rorv(result, src, carry);                                                 // rorv  result,src,carry
+		}
+		else
+			a.rorv(result, src, count);                                                 // rorv  result,src,count
+
+		// ROR sets S and Z even for a zero count; everything else leaves the flags alone
+		Label skip = a.newLabel();
+		if (Opcode == uml::OP_ROR)
+			a.tst(result, result);                                                      // tst   result,result
+		a.cbz(count, skip);                                                             // cbz   count,skip
+
+		if (Opcode == uml::OP_SHL)
+		{
+			a.mov(carry, bits);                                                         // mov   carry,bits
+			a.sub(carry, carry, count);                                                 // sub   carry,carry,count
+			a.lsrv(carry, src, carry);                                                  // lsrv  carry,src,carry
+		}
+		else if ((Opcode == uml::OP_SHR) || (Opcode == uml::OP_SAR))
+		{
+			a.sub(carry, count, 1);                                                     // sub   carry,count,1
+			a.lsrv(carry, src, carry);                                                  // lsrv  carry,src,carry
+		}
+		else if (Opcode == uml::OP_ROL)
+		{
+			a.mov(carry, result);                                                       // mov   carry,result
+		}
+		else
+		{
+			a.lsr(carry, result, bits - 1);                                             // lsr   carry,result,bits-1
+		}
+		if (Opcode != uml::OP_ROR)
+			a.tst(result, result);                                                      // tst   result,result
+		store_carry_reg(a, carry);
+
+		a.bind(skip);                                                               // skip:
+		mov_param_reg(a, inst.size(), dstp, result);                                    // mov   dstp,result
+	}
+}
+
+
+//-------------------------------------------------
+//  op_rotc - process a ROLC/RORC opcode
+//-------------------------------------------------
+
+template <uml::opcode_t Opcode>
+void drcbe_arm64::op_rotc(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_S);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter shiftp(*this, inst.param(2), PTYPE_MRI);
+
+	uint32_t const bits = inst.size() * 8;
+	a64::Gp const carryin = select_register(TEMP_REG4, inst.size());
+	a64::Gp const carry = select_register(TEMP_REG5, inst.size());
+	a64::Gp const result = select_register(TEMP_REG6, inst.size());
+	a64::Gp const temp = select_register(a64::Gp(x15), inst.size());
+
+	// the incoming carry has to be captured before anything else touches the flags
+	load_carry(a, carryin);                                                             // cset  carryin,cs
+	a64::Gp const src = get_reg_param(a, inst.size(), srcp, TEMP_REG1);
+
+	if (shiftp.is_immediate())
+	{
+		uint32_t const shift = shiftp.immediate() & (bits - 1);
+
+		if (shift == 0)
+		{
+			if (result.id() != src.id())
+				a.mov(result, src);                                                     // mov   result,src
+			if (inst.flags())
+				a.tst(result, result);                                                  // tst   result,result
+		}
+		else
+		{
+			// rotate through a (bits + 1)-bit value formed from the source and the carry
+			if (Opcode == uml::OP_ROLC)
+			{
+				if (inst.flags())
+					a.ubfx(carry, src, bits - shift, 1);                                // ubfx  carry,src,bits-shift,1
+				a.lsl(result, src, shift);                                              // lsl   result,src,shift
+				a.orr(result, result, carryin, arm::lsl(shift - 1));                    // orr   result,result,carryin,lsl shift-1
+				if (shift > 1)
+					a.orr(result, result, src, arm::lsr(bits + 1 - shift));             // orr   result,result,src,lsr bits+1-shift
+			}
+			else
+			{
+				if (inst.flags())
+					a.ubfx(carry, src, shift - 1, 1);                                   // ubfx  carry,src,shift-1,1
+				a.lsr(result, src, shift);                                              // lsr   result,src,shift
+				a.orr(result, result, carryin, arm::lsl(bits - shift));                 // orr   result,result,carryin,lsl bits-shift
+				if (shift > 1)
+					a.orr(result, result, src, arm::lsl(bits + 1 - shift));             // orr   result,result,src,lsl bits+1-shift
+			}
+
+			if (inst.flags())
+			{
+				a.tst(result, result);                                                  // tst   result,result
+				store_carry_reg(a, carry);
+			}
+		}
+	}
+	else
+	{
+		a64::Gp const shift = get_reg_param(a, inst.size(), shiftp, TEMP_REG3);
+		a64::Gp const count = select_register(TEMP_REG3, inst.size());
+		a.and_(count, shift, bits - 1);                                                 // and   count,shift,bits-1
+
+		Label zero = a.newLabel();
+		Label done = a.newLabel();
+		a.cbz(count, zero);                                                             // cbz   count,zero
+
+		if (Opcode == uml::OP_ROLC)
+		{
+			a.lslv(result, src, count);                                                 // lslv  result,src,count
+			a.sub(temp, count, 1);                                                      // sub   temp,count,1
+			a.lslv(temp, carryin, temp);                                                // lslv  temp,carryin,temp
+			a.orr(result, result, temp);                                                // orr   result,result,temp
+			a.mov(temp, bits);                                                          // mov   temp,bits
+			a.sub(temp, temp, count);                                                   // sub   temp,temp,count
+			a.lsrv(carry, src, temp);                                                   // lsrv  carry,src,temp
+			a.orr(result, result, carry, arm::lsr(1));                                  // orr   result,result,carry,lsr 1
+		}
+		else
+		{
+			a.lsrv(result, src, count);                                                 // lsrv  result,src,count
+			a.mov(temp, bits);                                                          // mov   temp,bits
+			a.sub(temp, temp, count);                                                   // sub   temp,temp,count
+			a.lslv(carry, carryin, temp);                                               // lslv  carry,carryin,temp
+			a.orr(result, result, carry);                                               // orr   result,result,carry
+			a.lslv(temp, src, temp);                                                    // lslv  temp,src,temp
+			a.orr(result, result, temp, arm::lsl(1));                                   // orr   result,result,temp,lsl 1
+			a.sub(temp, count, 1);                                                      // sub   temp,count,1
+			a.lsrv(carry, src, temp);                                                   // lsrv  carry,src,temp
+		}
+
+		if (inst.flags())
+		{
+			a.tst(result, result);                                                      // tst   result,result
+			store_carry_reg(a, carry);
+		}
+		a.b(done);                                                                      // b     done
+
+		a.bind(zero);                                                               // zero:
+		if (result.id() != src.id())
+			a.mov(result, src);                                                         // mov   result,src
+		if (inst.flags())
+			a.tst(result, result);                                                      // tst   result,result
+
+		a.bind(done);                                                               // done:
+	}
+
+	mov_param_reg(a, inst.size(), dstp, result);                                        // mov   dstp,result
+}
+
+
+
+/***************************************************************************
+    FLOATING POINT OPERATIONS
+***************************************************************************/
+
+//-------------------------------------------------
+//  op_fload - process a FLOAD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fload(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter basep(*this, inst.param(1), PTYPE_M);
+	be_parameter indp(*this, inst.param(2), PTYPE_MRI);
+
+	// pick a target register for the general case
+	a64::Vec const dstreg = dstp.select_register(TEMPF_REG1, inst.size());
+
+	a.ldr(dstreg, get_indexed_mem(a, basep.memory(), indp, inst.size(), (inst.size() == 4) ? 2 : 3));
+																						// ldr   dstreg,[basep + size*indp]
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_fstore - process a FSTORE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fstore(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter basep(*this, inst.param(0), PTYPE_M);
+	be_parameter indp(*this, inst.param(1), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(2), PTYPE_MF);
+
+	// pick a source register for the general case
+	a64::Vec const srcreg = srcp.select_register(TEMPF_REG1, inst.size());
+	mov_float_reg_param(a, inst.size(), srcreg, srcp);                                  // fmov  srcreg,srcp
+
+	a.str(srcreg, get_indexed_mem(a, basep.memory(), indp, inst.size(), (inst.size() == 4) ? 2 : 3));
+																						// str   srcreg,[basep + size*indp]
+}
+
+
+//-------------------------------------------------
+//  op_fread - process a FREAD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fread(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter addrp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &spacep = inst.param(2);
+	assert(spacep.is_size_space());
+	assert((1 << spacep.size()) == inst.size());
+
+	// set up a call to the read dword/qword handler
+	auto const &trampolines = m_accessors[spacep.space()];
+	auto const &resolved = m_resolved_accessors[spacep.space()];
+	mov_reg_param(a, 4, REG_PARAM2, addrp);                                             // mov   param2,addrp
+	if (inst.size() == 4)
+		call_accessor(a, resolved.read_dword, (const void *)trampolines.read_dword, spacep.space());
+	else if (inst.size() == 8)
+		call_accessor(a, resolved.read_qword, (const void *)trampolines.read_qword, spacep.space());
+
+	// store result
+	a64::Gp const result = select_register(REG_PARAM1, inst.size());
+	if (dstp.is_memory())
+		emit_str_mem(a, result, dstp.memory());                                         // str   result,[dstp]
+	else if (dstp.is_float_register())
+		a.fmov(select_register(a64::Vec(d(dstp.freg())), inst.size()), result);         // fmov  dstp,result
+}
+
+
+//-------------------------------------------------
+//  op_fwrite - process a FWRITE opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fwrite(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter addrp(*this, inst.param(0), PTYPE_MRI);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	const parameter &spacep = inst.param(2);
+	assert(spacep.is_size_space());
+	assert((1 << spacep.size()) == inst.size());
+
+	// the value goes to the handler as raw bits
+	a64::Gp const data = select_register(REG_PARAM3, inst.size());
+	mov_reg_param(a, 4, REG_PARAM2, addrp);                                             // mov   param2,addrp
+	if (srcp.is_memory())
+		emit_ldr_mem(a, data, srcp.memory());                                           // ldr   param3,[srcp]
+	else if (srcp.is_float_register())
+		a.fmov(data, select_register(a64::Vec(d(srcp.freg())), inst.size()));           // fmov  param3,srcp
+
+	// set up a call to the write dword/qword handler
+	auto const &trampolines = m_accessors[spacep.space()];
+	auto const &resolved = m_resolved_accessors[spacep.space()];
+	if (inst.size() == 4)
+		call_accessor(a, resolved.write_dword, (const void *)trampolines.write_dword, spacep.space());
+	else if (inst.size() == 8)
+		call_accessor(a, resolved.write_qword, (const void *)trampolines.write_qword, spacep.space());
+}
+
+
+//-------------------------------------------------
+//  op_fmov - process a FMOV opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fmov(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_any_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	// skip if conditional
+	Label skip = a.newLabel();
+	emit_skip(a, inst.condition(), skip);
+
+	mov_float_param_param(a, inst.size(), dstp, srcp);                                  // fmov  dstp,srcp
+
+	// resolve the jump
+	a.bind(skip);                                                                   // skip:
+}
+
+
+//-------------------------------------------------
+//  op_ftoint - process a FTOINT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ftoint(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+	const parameter &roundp = inst.param(3);
+	assert(roundp.is_rounding());
+
+	// pick target registers for the general case
+	uint32_t const dstsize = (sizep.size() == SIZE_DWORD) ? 4 : 8;
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG1, dstsize);
+	a64::Vec const srcreg = srcp.select_register(TEMPF_REG1, inst.size());
+	mov_float_reg_param(a, inst.size(), srcreg, srcp);                                  // fmov  srcreg,srcp
+
+	// explicit rounding modes have dedicated conversions
+	switch (roundp.rounding())
+	{
+	case ROUND_TRUNC:
+		a.fcvtzs(dstreg, srcreg);                                                       // fcvtzs dstreg,srcreg
+		break;
+	case ROUND_ROUND:
+		a.fcvtns(dstreg, srcreg);                                                       // fcvtns dstreg,srcreg
+		break;
+	case ROUND_CEIL:
+		a.fcvtps(dstreg, srcreg);                                                       // fcvtps dstreg,srcreg
+		break;
+	case ROUND_FLOOR:
+		a.fcvtms(dstreg, srcreg);                                                       // fcvtms dstreg,srcreg
+		break;
+	default:
+		// round using the current mode, then convert the now integral value
+		a.frinti(select_register(TEMPF_REG2, inst.size()), srcreg);                     // frinti temp,srcreg
+		a.fcvtzs(dstreg, select_register(TEMPF_REG2, inst.size()));                     // fcvtzs dstreg,temp
+		break;
+	}
+
+	mov_param_reg(a, dstsize, dstp, dstreg);                                            // mov   dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_ffrint - process a FFRINT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ffrint(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MRI);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+
+	// pick a target register for the general case
+	a64::Vec const dstreg = dstp.select_register(TEMPF_REG1, inst.size());
+	uint32_t const srcsize = (sizep.size() == SIZE_DWORD) ? 4 : 8;
+
+	a64::Gp const src = get_reg_param(a, srcsize, srcp, TEMP_REG1);
+	a.scvtf(dstreg, src);                                                               // scvtf dstreg,src
+
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_ffrflt - process a FFRFLT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_ffrflt(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+	const parameter &sizep = inst.param(2);
+	assert(sizep.is_size());
+
+	// pick registers for the general case
+	uint32_t const srcsize = (sizep.size() == SIZE_DWORD) ? 4 : 8;
+	a64::Vec const dstreg = dstp.select_register(TEMPF_REG1, inst.size());
+	a64::Vec const srcreg = srcp.select_register(TEMPF_REG2, srcsize);
+	mov_float_reg_param(a, srcsize, srcreg, srcp);                                      // fmov  srcreg,srcp
+
+	if (srcsize == inst.size())
+		a.fmov(dstreg, srcreg);                                                         // fmov  dstreg,srcreg
+	else
+		a.fcvt(dstreg, srcreg);                                                         // fcvt  dstreg,srcreg
+
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_frnds - process a FRNDS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_frnds(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	// pick a target register for the general case
+	a64::Vec const dstreg = dstp.select_register(TEMPF_REG1, 8);
+	mov_float_reg_param(a, 8, dstreg, srcp);                                            // fmov  dstreg,srcp
+
+	// round to single precision and back
+	a.fcvt(dstreg.s(), dstreg.d());                                                     // fcvt  dstreg.s,dstreg.d
+	a.fcvt(dstreg.d(), dstreg.s());                                                     // fcvt  dstreg.d,dstreg.s
+
+	mov_float_param_reg(a, 8, dstp, dstreg);                                            // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_float_alu - process a FADD/FSUB/FMUL/FDIV
+//  opcode
+//-------------------------------------------------
+
+template <a64::Inst::Id Opcode>
+void drcbe_arm64::op_float_alu(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MF);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MF);
+
+	// pick registers for the general case
+	a64::Vec const dstreg = dstp.select_register(TEMPF_REG3, inst.size());
+	a64::Vec const src1reg = src1p.select_register(TEMPF_REG1, inst.size());
+	a64::Vec const src2reg = src2p.select_register(TEMPF_REG2, inst.size());
+	mov_float_reg_param(a, inst.size(), src1reg, src1p);                                // fmov  src1reg,src1p
+	mov_float_reg_param(a, inst.size(), src2reg, src2p);                                // fmov  src2reg,src2p
+
+	a.emit(Opcode, dstreg, src1reg, src2reg);                                           // fop   dstreg,src1reg,src2reg
+
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_float_alu2 - process a FNEG/FABS/FSQRT
+//  opcode
+//-------------------------------------------------
+
+template <a64::Inst::Id Opcode>
+void drcbe_arm64::op_float_alu2(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	// pick registers for the general case
+	a64::Vec const dstreg = dstp.select_register(TEMPF_REG2, inst.size());
+	a64::Vec const srcreg = srcp.select_register(TEMPF_REG1, inst.size());
+	mov_float_reg_param(a, inst.size(), srcreg, srcp);                                  // fmov  srcreg,srcp
+
+	a.emit(Opcode, dstreg, srcreg);                                                     // fop   dstreg,srcreg
+
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_fcmp - process a FCMP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fcmp(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_flags(inst, FLAG_C | FLAG_Z | FLAG_U);
+
+	// normalize parameters
+	be_parameter src1p(*this, inst.param(0), PTYPE_MF);
+	be_parameter src2p(*this, inst.param(1), PTYPE_MF);
+
+	// pick registers for the general case
+	a64::Vec const src1reg = src1p.select_register(TEMPF_REG1, inst.size());
+	a64::Vec const src2reg = src2p.select_register(TEMPF_REG2, inst.size());
+	mov_float_reg_param(a, inst.size(), src1reg, src1p);                                // fmov  src1reg,src1p
+	mov_float_reg_param(a, inst.size(), src2reg, src2p);                                // fmov  src2reg,src2p
+
+	a.fcmp(src1reg, src2reg);                                                           // fcmp  src1reg,src2reg
+
+	// UML sets C and Z as well as U on an unordered result, like x86
+	if (inst.flags())
+	{
+		a.cset(TEMP_REG1, CondCode::kLT);                                               // cset  c,lt
+		a.cset(TEMP_REG2, CondCode::kEQ);                                               // cset  z,eq
+		a.cset(TEMP_REG3, CondCode::kVS);                                               // cset  u,vs
+		a.orr(TEMP_REG2, TEMP_REG2, TEMP_REG3);                                         // orr   z,z,u
+		a.lsl(SCRATCH_REG2, TEMP_REG1, 29);                                             // lsl   scratch,c,29
+		a.orr(SCRATCH_REG2, SCRATCH_REG2, TEMP_REG2, arm::lsl(30));                     // orr   scratch,scratch,z,lsl 30
+		a.orr(SCRATCH_REG2, SCRATCH_REG2, TEMP_REG3, arm::lsl(28));                     // orr   scratch,scratch,u,lsl 28
+		a.msr(Imm(a64::Predicate::SysReg::kNZCV), SCRATCH_REG2);                        // msr   nzcv,scratch
+	}
+}
+
+
+//-------------------------------------------------
+//  op_frecip - process a FRECIP opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_frecip(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	// pick registers for the general case
+	a64::Vec const dstreg = dstp.select_register(TEMPF_REG2, inst.size());
+	a64::Vec const srcreg = select_register(TEMPF_REG1, inst.size());
+	a64::Vec const onereg = select_register(TEMPF_REG3, inst.size());
+	mov_float_reg_param(a, inst.size(), srcreg, srcp);                                  // fmov  srcreg,srcp
+
+	// the estimate instructions aren't accurate enough, so divide
+	a.fmov(onereg, 1.0);                                                                // fmov  one,1.0
+	a.fdiv(dstreg, onereg, srcreg);                                                     // fdiv  dstreg,one,srcreg
+
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_frsqrt - process a FRSQRT opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_frsqrt(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	// pick registers for the general case
+	a64::Vec const dstreg = dstp.select_register(TEMPF_REG2, inst.size());
+	a64::Vec const srcreg = select_register(TEMPF_REG1, inst.size());
+	a64::Vec const onereg = select_register(TEMPF_REG3, inst.size());
+	mov_float_reg_param(a, inst.size(), srcreg, srcp);                                  // fmov  srcreg,srcp
+
+	a.fsqrt(srcreg, srcreg);                                                            // fsqrt srcreg,srcreg
+	a.fmov(onereg, 1.0);                                                                // fmov  one,1.0
+	a.fdiv(dstreg, onereg, srcreg);                                                     // fdiv  dstreg,one,srcreg
+
+	mov_float_param_reg(a, inst.size(), dstp, dstreg);                                  // fmov  dstp,dstreg
+}
+
+
+//-------------------------------------------------
+//  op_fcopyi - process a FCOPYI opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_fcopyi(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MF);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MR);
+
+	a64::Gp const src = get_reg_param(a, inst.size(), srcp, TEMP_REG1);
+	if (dstp.is_memory())
+		emit_str_mem(a, src, dstp.memory());                                            // str   src,[dstp]
+	else if (dstp.is_float_register())
+		a.fmov(select_register(a64::Vec(d(dstp.freg())), inst.size()), src);            // fmov  dstp,src
+}
+
+
+//-------------------------------------------------
+//  op_icopyf - process a ICOPYF opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_icopyf(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4 || inst.size() == 8);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MR);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MF);
+
+	// pick a target register for the general case
+	a64::Gp const dstreg = dstp.select_register(TEMP_REG1, inst.size());
+	if (srcp.is_memory())
+		emit_ldr_mem(a, dstreg, srcp.memory());                                         // ldr   dstreg,[srcp]
+	else if (srcp.is_float_register())
+		a.fmov(dstreg, select_register(a64::Vec(d(srcp.freg())), inst.size()));         // fmov  dstreg,srcp
+
+	mov_param_reg(a, inst.size(), dstp, dstreg);                                        // mov   dstp,dstreg
+}
+
+
+
+
+/***************************************************************************
+    VECTOR OPERATIONS
+***************************************************************************/
+
+//-------------------------------------------------
+//  select_lanes - view a vector register as lanes
+//  of the given size
+//-------------------------------------------------
+
+static inline a64::VecV select_lanes(a64::Vec const &reg, int size)
+{
+	switch (size)
+	{
+	case SIZE_BYTE:     return reg.b16();
+	case SIZE_WORD:     return reg.h8();
+	case SIZE_DWORD:    return reg.s4();
+	default:            return reg.d2();
+	}
+}
+
+
+//-------------------------------------------------
+//  vector_op - generate a lane-wise operation on
+//  two vectors, which always live in memory
+//-------------------------------------------------
+
+void drcbe_arm64::vector_op(a64::Assembler &a, const instruction &inst, a64::Inst::Id const opcode, int size)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MV);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MV);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MV);
+
+	emit_float_ldr_mem(a, TEMPF_REG1.q(), src1p.memory());                              // ldr   temp1,[src1p]
+	emit_float_ldr_mem(a, TEMPF_REG2.q(), src2p.memory());                              // ldr   temp2,[src2p]
+	a.emit(opcode, select_lanes(TEMPF_REG1, size), select_lanes(TEMPF_REG1, size), select_lanes(TEMPF_REG2, size));
+																						// op    temp1,temp1,temp2
+	emit_float_str_mem(a, TEMPF_REG1.q(), dstp.memory());                               // str   temp1,[dstp]
+}
+
+
+//-------------------------------------------------
+//  op_vmov - process a VMOV opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_vmov(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MV);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MV);
+
+	if (dstp.memory() != srcp.memory())
+	{
+		emit_float_ldr_mem(a, TEMPF_REG1.q(), srcp.memory());                           // ldr   temp1,[srcp]
+		emit_float_str_mem(a, TEMPF_REG1.q(), dstp.memory());                           // str   temp1,[dstp]
+	}
+}
+
+
+//-------------------------------------------------
+//  op_vadd - process a VADD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_vadd(a64::Assembler &a, const instruction &inst)
+{
+	vector_op(a, inst, a64::Inst::kIdAdd_v, inst.param(3).size());
+}
+
+
+//-------------------------------------------------
+//  op_vsub - process a VSUB opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_vsub(a64::Assembler &a, const instruction &inst)
+{
+	vector_op(a, inst, a64::Inst::kIdSub_v, inst.param(3).size());
+}
+
+
+//-------------------------------------------------
+//  op_vadds - process a VADDS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_vadds(a64::Assembler &a, const instruction &inst)
+{
+	assert(inst.param(3).size() <= SIZE_WORD);
+	vector_op(a, inst, a64::Inst::kIdSqadd_v, inst.param(3).size());
+}
+
+
+//-------------------------------------------------
+//  op_vsubs - process a VSUBS opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_vsubs(a64::Assembler &a, const instruction &inst)
+{
+	assert(inst.param(3).size() <= SIZE_WORD);
+	vector_op(a, inst, a64::Inst::kIdSqsub_v, inst.param(3).size());
+}
+
+
+//-------------------------------------------------
+//  op_vfadd - process a VFADD opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_vfadd(a64::Assembler &a, const instruction &inst)
+{
+	vector_op(a, inst, a64::Inst::kIdFadd_v, SIZE_DWORD);
+}
+
+
+//-------------------------------------------------
+//  op_vfsub - process a VFSUB opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_vfsub(a64::Assembler &a, const instruction &inst)
+{
+	vector_op(a, inst, a64::Inst::kIdFsub_v, SIZE_DWORD);
+}
+
+
+//-------------------------------------------------
+//  op_vfmul - process a VFMUL opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_vfmul(a64::Assembler &a, const instruction &inst)
+{
+	vector_op(a, inst, a64::Inst::kIdFmul_v, SIZE_DWORD);
+}
+
+
+//-------------------------------------------------
+//  op_vfmin - process a VFMIN opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_vfmin(a64::Assembler &a, const instruction &inst)
+{
+	vector_op(a, inst, a64::Inst::kIdFmin_v, SIZE_DWORD);
+}
+
+
+//-------------------------------------------------
+//  op_vfmax - process a VFMAX opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_vfmax(a64::Assembler &a, const instruction &inst)
+{
+	vector_op(a, inst, a64::Inst::kIdFmax_v, SIZE_DWORD);
+}
+
+
+//-------------------------------------------------
+//  op_vshuf - process a VSHUF opcode
+//-------------------------------------------------
+
+void drcbe_arm64::op_vshuf(a64::Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MV);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MV);
+	be_parameter lanesp(*this, inst.param(2), PTYPE_I);
+
+	// there's no immediate shuffle, so insert each lane in turn
+	emit_float_ldr_mem(a, TEMPF_REG1.q(), srcp.memory());                               // ldr   temp1,[srcp]
+	for (int lane = 0; lane < 4; lane++)
+		a.ins(TEMPF_REG2.s(lane), TEMPF_REG1.s((lanesp.immediate() >> (lane * 2)) & 3)); // ins   temp2.s[lane],temp1.s[sel]
+	emit_float_str_mem(a, TEMPF_REG2.q(), dstp.memory());                               // str   temp2,[dstp]
+}
+
+} // namespace drc
@@ -12,7 +12,11 @@
 #include "debug/debugcpu.h"
 #include "drcbec.h"
 
+#include <array>
 #include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
 
 using namespace uml;
 
@@ -124,7 +128,19 @@ enum
 	OP_FFRI4,
 	OP_FFRI8,
 	OP_FFRFS,
-	OP_FFRFD
+	OP_FFRFD,
+	OP_VADD1,
+	OP_VADD2,
+	OP_VADD4,
+	OP_VADD8,
+	OP_VSUB1,
+	OP_VSUB2,
+	OP_VSUB4,
+	OP_VSUB8,
+	OP_VADDS1,
+	OP_VADDS2,
+	OP_VSUBS1,
+	OP_VSUBS2
 };
 
 
@@ -157,6 +173,23 @@ enum
 #define OPCODE_FAIL_CONDITION(op,f) (((op) & s_condition_map[f]) == 0)
 #define OPCODE_GET_PWORDS(op)       ((op) >> 28)
 
+// threaded dispatch needs the labels as values extension; other compilers use the switch
+#if defined(__GNUC__) && !defined(DRCBEC_NO_THREADED_DISPATCH)
+#define DRCBEC_THREADED_DISPATCH    1
+#else
+#define DRCBEC_THREADED_DISPATCH    0
+#endif
+
+// each case in the execute loop is also a label that can be dispatched to directly
+#if DRCBEC_THREADED_DISPATCH
+#define OPCODE_CASE(op,size,cond)   case MAKE_OPCODE_SHORT(op, size, cond): handler_##op##_##size##_##cond
+#define OPCODE_DEFAULT              default: handler_invalid
+#define OPCODE_HANDLER(op,size,cond) { MAKE_OPCODE_SHORT(op, size, cond), &&handler_##op##_##size##_##cond }
+#else
+#define OPCODE_CASE(op,size,cond)   case MAKE_OPCODE_SHORT(op, size, cond)
+#define OPCODE_DEFAULT              default
+#endif
+
 // shorthand for accessing parameters in the instruction stream
 #define PARAM0                      (*inst[0].puint32)
 #define PARAM1                      (*inst[1].puint32)
@@ -183,22 +216,30 @@ enum
 #define FLAGS32_C_SUB(a,b)          ((uint32_t)(b) > (uint32_t)(a))
 #define FLAGS32_V_SUB(r,a,b)        (((((a) ^ (b)) & ((a) ^ (r))) >> 30) & FLAG_V)
 #define FLAGS32_V_ADD(r,a,b)        (((~((a) ^ (b)) & ((a) ^ (r))) >> 30) & FLAG_V)
+#define FLAGS32_C_ADDC(a,b,c)       (FLAGS32_C_ADD(a,b) || ((c) && ((uint32_t)~(a) == (uint32_t)(b))))
+#define FLAGS32_C_SUBB(a,b,c)       (FLAGS32_C_SUB(a,b) || ((c) && ((uint32_t)(b) == (uint32_t)(a))))
 
 // compute N and Z flags for 32-bit operations
 #define FLAGS32_NZ(v)               ((((v) >> 28) & FLAG_S) | (((uint32_t)(v) == 0) << 2))
 #define FLAGS32_NZCV_ADD(r,a,b)     (FLAGS32_NZ(r) | FLAGS32_C_ADD(a,b) | FLAGS32_V_ADD(r,a,b))
 #define FLAGS32_NZCV_SUB(r,a,b)     (FLAGS32_NZ(r) | FLAGS32_C_SUB(a,b) | FLAGS32_V_SUB(r,a,b))
+#define FLAGS32_NZCV_ADDC(r,a,b,c)  (FLAGS32_NZ(r) | FLAGS32_C_ADDC(a,b,c) | FLAGS32_V_ADD(r,a,b))
+#define FLAGS32_NZCV_SUBB(r,a,b,c)  (FLAGS32_NZ(r) | FLAGS32_C_SUBB(a,b,c) | FLAGS32_V_SUB(r,a,b))
 
 // compute C and V flags for 64-bit add/subtract
 #define FLAGS64_C_ADD(a,b)          ((uint64_t)~(a) < (uint64_t)(b))
 #define FLAGS64_C_SUB(a,b)          ((uint64_t)(b) > (uint64_t)(a))
 #define FLAGS64_V_SUB(r,a,b)        (((((a) ^ (b)) & ((a) ^ (r))) >> 62) & FLAG_V)
 #define FLAGS64_V_ADD(r,a,b)        (((~((a) ^ (b)) & ((a) ^ (r))) >> 62) & FLAG_V)
+#define FLAGS64_C_ADDC(a,b,c)       (FLAGS64_C_ADD(a,b) || ((c) && ((uint64_t)~(a) == (uint64_t)(b))))
+#define FLAGS64_C_SUBB(a,b,c)       (FLAGS64_C_SUB(a,b) || ((c) && ((uint64_t)(b) == (uint64_t)(a))))
 
 // compute N and Z flags for 64-bit operations
 #define FLAGS64_NZ(v)               ((((v) >> 60) & FLAG_S) | (((uint64_t)(v) == 0) << 2))
 #define FLAGS64_NZCV_ADD(r,a,b)     (FLAGS64_NZ(r) | FLAGS64_C_ADD(a,b) | FLAGS64_V_ADD(r,a,b))
 #define FLAGS64_NZCV_SUB(r,a,b)     (FLAGS64_NZ(r) | FLAGS64_C_SUB(a,b) | FLAGS64_V_SUB(r,a,b))
+#define FLAGS64_NZCV_ADDC(r,a,b,c)  (FLAGS64_NZ(r) | FLAGS64_C_ADDC(a,b,c) | FLAGS64_V_ADD(r,a,b))
+#define FLAGS64_NZCV_SUBB(r,a,b,c)  (FLAGS64_NZ(r) | FLAGS64_C_SUBB(a,b,c) | FLAGS64_V_SUB(r,a,b))
 
 
 
@@ -230,6 +271,19 @@ union drcbec_instruction
 };
 
 
+#if DRCBEC_THREADED_DISPATCH
+// the address of the execute loop handler for a short opcode
+struct dispatch_entry
+{
+	uint32_t            opcode;
+	void *              handler;
+};
+
+// handler addresses indexed by short opcode
+typedef std::array<void *, (OP_VSUBS2 + 1) << 2> dispatch_table;
+#endif
+
+
 
 //**************************************************************************
 //  GLOBAL VARIABLES
@@ -275,6 +329,59 @@ const uint32_t drcbe_c::s_condition_map[] =
 
 
 
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  vector_op - apply an operation to each lane of
+//  two vectors, which may overlap the result
+//-------------------------------------------------
+
+template <typename T, typename Op>
+static inline void vector_op(void *dst, const void *src1, const void *src2, Op &&op)
+{
+	T a[16 / sizeof(T)], b[16 / sizeof(T)];
+	memcpy(a, src1, 16);
+	memcpy(b, src2, 16);
+	for (int lane = 0; lane < std::size(a); lane++)
+		a[lane] = op(a[lane], b[lane]);
+	memcpy(dst, a, 16);
+}
+
+
+//-------------------------------------------------
+//  saturate - clamp a signed result to the range
+//  of a lane
+//-------------------------------------------------
+
+template <typename T>
+static inline T saturate(int32_t value)
+{
+	return T(std::clamp<int32_t>(value, std::numeric_limits<T>::min(), std::numeric_limits<T>::max()));
+}
+
+
+
+#if DRCBEC_THREADED_DISPATCH
+//-------------------------------------------------
+//  make_dispatch_table - build the table used to
+//  dispatch from a short opcode to its handler
+//-------------------------------------------------
+
+template <std::size_t N>
+static dispatch_table make_dispatch_table(const dispatch_entry (&handlers)[N], void *invalid)
+{
+	dispatch_table result;
+	result.fill(invalid);
+	for (const dispatch_entry &entry : handlers)
+		result[entry.opcode] = entry.handler;
+	return result;
+}
+#endif
+
+
+
 //**************************************************************************
 //  C BACKEND
 //**************************************************************************
@@ -420,6 +527,15 @@ void drcbe_c::generate(drcuml_block &block, const instruction *instlist, uint32_
 					opcode = (opcode_t)(OP_FFRI4 + (inst.param(2).size() - 2));
 				if (opcode == OP_FFRFLT)
 					opcode = (opcode_t)(OP_FFRFS + (inst.param(2).size() - 2));
+				if (opcode == OP_VADD)
+					opcode = (opcode_t)(OP_VADD1 + inst.param(3).size());
+				if (opcode == OP_VSUB)
+					opcode = (opcode_t)(OP_VSUB1 + inst.param(3).size());
+				assert(((opcode != OP_VADDS) && (opcode != OP_VSUBS)) || (inst.param(3).size() <= SIZE_WORD));
+				if (opcode == OP_VADDS)
+					opcode = (opcode_t)(OP_VADDS1 + inst.param(3).size());
+				if (opcode == OP_VSUBS)
+					opcode = (opcode_t)(OP_VSUBS1 + inst.param(3).size());
 
 				// count how many bytes of immediates we need
 				int immedbytes = 0;
@@ -470,6 +586,17 @@ bool drcbe_c::hash_exists(uint32_t mode, uint32_t pc)
 }
 
 
+//-------------------------------------------------
+//  hash_invalidate - stop the given mode/pc from
+//  reaching the code compiled for it
+//-------------------------------------------------
+
+void drcbe_c::hash_invalidate(uint32_t mode, uint32_t pc)
+{
+	m_hash.clear_codeptr(mode, pc);
+}
+
+
 //-------------------------------------------------
 //  get_info - return information about the
 //  back-end implementation
@@ -501,29 +628,152 @@ int drcbe_c::execute(code_handle &entry)
 	int shift;
 	uint8_t flags = 0;
 	uint8_t sp = 0;
+
+#if DRCBEC_THREADED_DISPATCH
+	// handler for each opcode, so dispatch is an indirect jump that can be copied to the end of every handler
+	static dispatch_entry const s_handlers[] =
+	{
+		OPCODE_HANDLER(OP_HANDLE, 4, 0), OPCODE_HANDLER(OP_HASH, 4, 0), OPCODE_HANDLER(OP_LABEL, 4, 0),
+		OPCODE_HANDLER(OP_COMMENT, 4, 0), OPCODE_HANDLER(OP_MAPVAR, 4, 0), OPCODE_HANDLER(OP_DEBUG, 4, 0),
+		OPCODE_HANDLER(OP_HASHJMP, 4, 0), OPCODE_HANDLER(OP_EXIT, 4, 1), OPCODE_HANDLER(OP_EXIT, 4, 0),
+		OPCODE_HANDLER(OP_JMP, 4, 1), OPCODE_HANDLER(OP_JMP, 4, 0), OPCODE_HANDLER(OP_CALLH, 4, 1),
+		OPCODE_HANDLER(OP_CALLH, 4, 0), OPCODE_HANDLER(OP_RET, 4, 1), OPCODE_HANDLER(OP_RET, 4, 0),
+		OPCODE_HANDLER(OP_EXH, 4, 1), OPCODE_HANDLER(OP_EXH, 4, 0), OPCODE_HANDLER(OP_CALLC, 4, 1),
+		OPCODE_HANDLER(OP_CALLC, 4, 0), OPCODE_HANDLER(OP_RECOVER, 4, 0), OPCODE_HANDLER(OP_SETFMOD, 4, 0),
+		OPCODE_HANDLER(OP_GETFMOD, 4, 0), OPCODE_HANDLER(OP_GETEXP, 4, 0), OPCODE_HANDLER(OP_GETFLGS, 4, 0),
+		OPCODE_HANDLER(OP_SAVE, 4, 0), OPCODE_HANDLER(OP_RESTORE, 4, 0), OPCODE_HANDLER(OP_RESTORE, 4, 1),
+		OPCODE_HANDLER(OP_LOAD1, 4, 0), OPCODE_HANDLER(OP_LOAD1x2, 4, 0), OPCODE_HANDLER(OP_LOAD1x4, 4, 0),
+		OPCODE_HANDLER(OP_LOAD1x8, 4, 0), OPCODE_HANDLER(OP_LOAD2x1, 4, 0), OPCODE_HANDLER(OP_LOAD2, 4, 0),
+		OPCODE_HANDLER(OP_LOAD2x4, 4, 0), OPCODE_HANDLER(OP_LOAD2x8, 4, 0), OPCODE_HANDLER(OP_LOAD4x1, 4, 0),
+		OPCODE_HANDLER(OP_LOAD4x2, 4, 0), OPCODE_HANDLER(OP_LOAD4, 4, 0), OPCODE_HANDLER(OP_LOAD4x8, 4, 0),
+		OPCODE_HANDLER(OP_LOADS1, 4, 0), OPCODE_HANDLER(OP_LOADS1x2, 4, 0), OPCODE_HANDLER(OP_LOADS1x4, 4, 0),
+		OPCODE_HANDLER(OP_LOADS1x8, 4, 0), OPCODE_HANDLER(OP_LOADS2x1, 4, 0), OPCODE_HANDLER(OP_LOADS2, 4, 0),
+		OPCODE_HANDLER(OP_LOADS2x4, 4, 0), OPCODE_HANDLER(OP_LOADS2x8, 4, 0), OPCODE_HANDLER(OP_LOADS4x1, 4, 0),
+		OPCODE_HANDLER(OP_LOADS4x2, 4, 0), OPCODE_HANDLER(OP_LOADS4, 4, 0), OPCODE_HANDLER(OP_LOADS4x8, 4, 0),
+		OPCODE_HANDLER(OP_STORE1, 4, 0), OPCODE_HANDLER(OP_STORE1x2, 4, 0), OPCODE_HANDLER(OP_STORE1x4, 4, 0),
+		OPCODE_HANDLER(OP_STORE1x8, 4, 0), OPCODE_HANDLER(OP_STORE2x1, 4, 0), OPCODE_HANDLER(OP_STORE2, 4, 0),
+		OPCODE_HANDLER(OP_STORE2x4, 4, 0), OPCODE_HANDLER(OP_STORE2x8, 4, 0), OPCODE_HANDLER(OP_STORE4x1, 4, 0),
+		OPCODE_HANDLER(OP_STORE4x2, 4, 0), OPCODE_HANDLER(OP_STORE4, 4, 0), OPCODE_HANDLER(OP_STORE4x8, 4, 0),
+		OPCODE_HANDLER(OP_READ1, 4, 0), OPCODE_HANDLER(OP_READ2, 4, 0), OPCODE_HANDLER(OP_READ4, 4, 0),
+		OPCODE_HANDLER(OP_READM2, 4, 0), OPCODE_HANDLER(OP_READM4, 4, 0), OPCODE_HANDLER(OP_WRITE1, 4, 0),
+		OPCODE_HANDLER(OP_WRITE2, 4, 0), OPCODE_HANDLER(OP_WRITE4, 4, 0), OPCODE_HANDLER(OP_WRITEM2, 4, 0),
+		OPCODE_HANDLER(OP_WRITEM4, 4, 0), OPCODE_HANDLER(OP_CARRY, 4, 1), OPCODE_HANDLER(OP_MOV, 4, 1),
+		OPCODE_HANDLER(OP_MOV, 4, 0), OPCODE_HANDLER(OP_SET, 4, 1), OPCODE_HANDLER(OP_SEXT1, 4, 0),
+		OPCODE_HANDLER(OP_SEXT1, 4, 1), OPCODE_HANDLER(OP_SEXT2, 4, 0), OPCODE_HANDLER(OP_SEXT2, 4, 1),
+		OPCODE_HANDLER(OP_ROLAND, 4, 0), OPCODE_HANDLER(OP_ROLAND, 4, 1), OPCODE_HANDLER(OP_ROLINS, 4, 0),
+		OPCODE_HANDLER(OP_ROLINS, 4, 1), OPCODE_HANDLER(OP_ADD, 4, 0), OPCODE_HANDLER(OP_ADD, 4, 1),
+		OPCODE_HANDLER(OP_ADDC, 4, 0), OPCODE_HANDLER(OP_ADDC, 4, 1), OPCODE_HANDLER(OP_SUB, 4, 0),
+		OPCODE_HANDLER(OP_SUB, 4, 1), OPCODE_HANDLER(OP_SUBB, 4, 0), OPCODE_HANDLER(OP_SUBB, 4, 1),
+		OPCODE_HANDLER(OP_CMP, 4, 1), OPCODE_HANDLER(OP_MULU, 4, 0), OPCODE_HANDLER(OP_MULU, 4, 1),
+		OPCODE_HANDLER(OP_MULS, 4, 0), OPCODE_HANDLER(OP_MULS, 4, 1), OPCODE_HANDLER(OP_DIVU, 4, 0),
+		OPCODE_HANDLER(OP_DIVU, 4, 1), OPCODE_HANDLER(OP_DIVS, 4, 0), OPCODE_HANDLER(OP_DIVS, 4, 1),
+		OPCODE_HANDLER(OP_AND, 4, 0), OPCODE_HANDLER(OP_AND, 4, 1), OPCODE_HANDLER(OP_TEST, 4, 1),
+		OPCODE_HANDLER(OP_OR, 4, 0), OPCODE_HANDLER(OP_OR, 4, 1), OPCODE_HANDLER(OP_XOR, 4, 0),
+		OPCODE_HANDLER(OP_XOR, 4, 1), OPCODE_HANDLER(OP_LZCNT, 4, 0), OPCODE_HANDLER(OP_LZCNT, 4, 1),
+		OPCODE_HANDLER(OP_TZCNT, 4, 0), OPCODE_HANDLER(OP_TZCNT, 4, 1), OPCODE_HANDLER(OP_BSWAP, 4, 0),
+		OPCODE_HANDLER(OP_BSWAP, 4, 1), OPCODE_HANDLER(OP_SHL, 4, 0), OPCODE_HANDLER(OP_SHL, 4, 1),
+		OPCODE_HANDLER(OP_SHR, 4, 0), OPCODE_HANDLER(OP_SHR, 4, 1), OPCODE_HANDLER(OP_SAR, 4, 0),
+		OPCODE_HANDLER(OP_SAR, 4, 1), OPCODE_HANDLER(OP_ROL, 4, 0), OPCODE_HANDLER(OP_ROL, 4, 1),
+		OPCODE_HANDLER(OP_ROLC, 4, 0), OPCODE_HANDLER(OP_ROLC, 4, 1), OPCODE_HANDLER(OP_ROR, 4, 0),
+		OPCODE_HANDLER(OP_ROR, 4, 1), OPCODE_HANDLER(OP_RORC, 4, 0), OPCODE_HANDLER(OP_RORC, 4, 1),
+		OPCODE_HANDLER(OP_LOAD1, 8, 0), OPCODE_HANDLER(OP_LOAD1x2, 8, 0), OPCODE_HANDLER(OP_LOAD1x4, 8, 0),
+		OPCODE_HANDLER(OP_LOAD1x8, 8, 0), OPCODE_HANDLER(OP_LOAD2x1, 8, 0), OPCODE_HANDLER(OP_LOAD2, 8, 0),
+		OPCODE_HANDLER(OP_LOAD2x4, 8, 0), OPCODE_HANDLER(OP_LOAD2x8, 8, 0), OPCODE_HANDLER(OP_LOAD4x1, 8, 0),
+		OPCODE_HANDLER(OP_LOAD4x2, 8, 0), OPCODE_HANDLER(OP_LOAD4, 8, 0), OPCODE_HANDLER(OP_LOAD4x8, 8, 0),
+		OPCODE_HANDLER(OP_LOAD8x1, 8, 0), OPCODE_HANDLER(OP_LOAD8x2, 8, 0), OPCODE_HANDLER(OP_LOAD8x4, 8, 0),
+		OPCODE_HANDLER(OP_LOAD8, 8, 0), OPCODE_HANDLER(OP_LOADS1, 8, 0), OPCODE_HANDLER(OP_LOADS1x2, 8, 0),
+		OPCODE_HANDLER(OP_LOADS1x4, 8, 0), OPCODE_HANDLER(OP_LOADS1x8, 8, 0), OPCODE_HANDLER(OP_LOADS2x1, 8, 0),
+		OPCODE_HANDLER(OP_LOADS2, 8, 0), OPCODE_HANDLER(OP_LOADS2x4, 8, 0), OPCODE_HANDLER(OP_LOADS2x8, 8, 0),
+		OPCODE_HANDLER(OP_LOADS4x1, 8, 0), OPCODE_HANDLER(OP_LOADS4x2, 8, 0), OPCODE_HANDLER(OP_LOADS4, 8, 0),
+		OPCODE_HANDLER(OP_LOADS4x8, 8, 0), OPCODE_HANDLER(OP_LOADS8x1, 8, 0), OPCODE_HANDLER(OP_LOADS8x2, 8, 0),
+		OPCODE_HANDLER(OP_LOADS8x4, 8, 0), OPCODE_HANDLER(OP_LOADS8, 8, 0), OPCODE_HANDLER(OP_STORE1, 8, 0),
+		OPCODE_HANDLER(OP_STORE1x2, 8, 0), OPCODE_HANDLER(OP_STORE1x4, 8, 0), OPCODE_HANDLER(OP_STORE1x8, 8, 0),
+		OPCODE_HANDLER(OP_STORE2x1, 8, 0), OPCODE_HANDLER(OP_STORE2, 8, 0), OPCODE_HANDLER(OP_STORE2x4, 8, 0),
+		OPCODE_HANDLER(OP_STORE2x8, 8, 0), OPCODE_HANDLER(OP_STORE4x1, 8, 0), OPCODE_HANDLER(OP_STORE4x2, 8, 0),
+		OPCODE_HANDLER(OP_STORE4, 8, 0), OPCODE_HANDLER(OP_STORE4x8, 8, 0), OPCODE_HANDLER(OP_STORE8x1, 8, 0),
+		OPCODE_HANDLER(OP_STORE8x2, 8, 0), OPCODE_HANDLER(OP_STORE8x4, 8, 0), OPCODE_HANDLER(OP_STORE8, 8, 0),
+		OPCODE_HANDLER(OP_READ1, 8, 0), OPCODE_HANDLER(OP_READ2, 8, 0), OPCODE_HANDLER(OP_READ4, 8, 0),
+		OPCODE_HANDLER(OP_READ8, 8, 0), OPCODE_HANDLER(OP_READM2, 8, 0), OPCODE_HANDLER(OP_READM4, 8, 0),
+		OPCODE_HANDLER(OP_READM8, 8, 0), OPCODE_HANDLER(OP_WRITE1, 8, 0), OPCODE_HANDLER(OP_WRITE2, 8, 0),
+		OPCODE_HANDLER(OP_WRITE4, 8, 0), OPCODE_HANDLER(OP_WRITE8, 8, 0), OPCODE_HANDLER(OP_WRITEM2, 8, 0),
+		OPCODE_HANDLER(OP_WRITEM4, 8, 0), OPCODE_HANDLER(OP_WRITEM8, 8, 0), OPCODE_HANDLER(OP_CARRY, 8, 1),
+		OPCODE_HANDLER(OP_MOV, 8, 1), OPCODE_HANDLER(OP_MOV, 8, 0), OPCODE_HANDLER(OP_SET, 8, 1),
+		OPCODE_HANDLER(OP_SEXT1, 8, 0), OPCODE_HANDLER(OP_SEXT1, 8, 1), OPCODE_HANDLER(OP_SEXT2, 8, 0),
+		OPCODE_HANDLER(OP_SEXT2, 8, 1), OPCODE_HANDLER(OP_SEXT4, 8, 0), OPCODE_HANDLER(OP_SEXT4, 8, 1),
+		OPCODE_HANDLER(OP_ROLAND, 8, 0), OPCODE_HANDLER(OP_ROLAND, 8, 1), OPCODE_HANDLER(OP_ROLINS, 8, 0),
+		OPCODE_HANDLER(OP_ROLINS, 8, 1), OPCODE_HANDLER(OP_ADD, 8, 0), OPCODE_HANDLER(OP_ADD, 8, 1),
+		OPCODE_HANDLER(OP_ADDC, 8, 0), OPCODE_HANDLER(OP_ADDC, 8, 1), OPCODE_HANDLER(OP_SUB, 8, 0),
+		OPCODE_HANDLER(OP_SUB, 8, 1), OPCODE_HANDLER(OP_SUBB, 8, 0), OPCODE_HANDLER(OP_SUBB, 8, 1),
+		OPCODE_HANDLER(OP_CMP, 8, 1), OPCODE_HANDLER(OP_MULU, 8, 0), OPCODE_HANDLER(OP_MULU, 8, 1),
+		OPCODE_HANDLER(OP_MULS, 8, 0), OPCODE_HANDLER(OP_MULS, 8, 1), OPCODE_HANDLER(OP_DIVU, 8, 0),
+		OPCODE_HANDLER(OP_DIVU, 8, 1), OPCODE_HANDLER(OP_DIVS, 8, 0), OPCODE_HANDLER(OP_DIVS, 8, 1),
+		OPCODE_HANDLER(OP_AND, 8, 0), OPCODE_HANDLER(OP_AND, 8, 1), OPCODE_HANDLER(OP_TEST, 8, 1),
+		OPCODE_HANDLER(OP_OR, 8, 0), OPCODE_HANDLER(OP_OR, 8, 1), OPCODE_HANDLER(OP_XOR, 8, 0),
+		OPCODE_HANDLER(OP_XOR, 8, 1), OPCODE_HANDLER(OP_LZCNT, 8, 0), OPCODE_HANDLER(OP_LZCNT, 8, 1),
+		OPCODE_HANDLER(OP_TZCNT, 8, 0), OPCODE_HANDLER(OP_TZCNT, 8, 1), OPCODE_HANDLER(OP_BSWAP, 8, 0),
+		OPCODE_HANDLER(OP_BSWAP, 8, 1), OPCODE_HANDLER(OP_SHL, 8, 0), OPCODE_HANDLER(OP_SHL, 8, 1),
+		OPCODE_HANDLER(OP_SHR, 8, 0), OPCODE_HANDLER(OP_SHR, 8, 1), OPCODE_HANDLER(OP_SAR, 8, 0),
+		OPCODE_HANDLER(OP_SAR, 8, 1), OPCODE_HANDLER(OP_ROL, 8, 0), OPCODE_HANDLER(OP_ROL, 8, 1),
+		OPCODE_HANDLER(OP_ROLC, 8, 0), OPCODE_HANDLER(OP_ROLC, 8, 1), OPCODE_HANDLER(OP_ROR, 8, 0),
+		OPCODE_HANDLER(OP_ROR, 8, 1), OPCODE_HANDLER(OP_RORC, 8, 0), OPCODE_HANDLER(OP_RORC, 8, 1),
+		OPCODE_HANDLER(OP_FLOAD, 4, 0), OPCODE_HANDLER(OP_FSTORE, 4, 0), OPCODE_HANDLER(OP_FREAD, 4, 0),
+		OPCODE_HANDLER(OP_FWRITE, 4, 0), OPCODE_HANDLER(OP_FMOV, 4, 1), OPCODE_HANDLER(OP_FMOV, 4, 0),
+		OPCODE_HANDLER(OP_FTOI4T, 4, 0), OPCODE_HANDLER(OP_FTOI4R, 4, 0), OPCODE_HANDLER(OP_FTOI4F, 4, 0),
+		OPCODE_HANDLER(OP_FTOI4C, 4, 0), OPCODE_HANDLER(OP_FTOI4, 4, 0), OPCODE_HANDLER(OP_FTOI8T, 4, 0),
+		OPCODE_HANDLER(OP_FTOI8R, 4, 0), OPCODE_HANDLER(OP_FTOI8F, 4, 0), OPCODE_HANDLER(OP_FTOI8C, 4, 0),
+		OPCODE_HANDLER(OP_FTOI8, 4, 0), OPCODE_HANDLER(OP_FFRI4, 4, 0), OPCODE_HANDLER(OP_FFRI8, 4, 0),
+		OPCODE_HANDLER(OP_FFRFD, 4, 0), OPCODE_HANDLER(OP_FADD, 4, 0), OPCODE_HANDLER(OP_FSUB, 4, 0),
+		OPCODE_HANDLER(OP_FCMP, 4, 1), OPCODE_HANDLER(OP_FMUL, 4, 0), OPCODE_HANDLER(OP_FDIV, 4, 0),
+		OPCODE_HANDLER(OP_FNEG, 4, 0), OPCODE_HANDLER(OP_FABS, 4, 0), OPCODE_HANDLER(OP_FSQRT, 4, 0),
+		OPCODE_HANDLER(OP_FRECIP, 4, 0), OPCODE_HANDLER(OP_FRSQRT, 4, 0), OPCODE_HANDLER(OP_FCOPYI, 4, 0),
+		OPCODE_HANDLER(OP_ICOPYF, 4, 0), OPCODE_HANDLER(OP_FLOAD, 8, 0), OPCODE_HANDLER(OP_FSTORE, 8, 0),
+		OPCODE_HANDLER(OP_FREAD, 8, 0), OPCODE_HANDLER(OP_FWRITE, 8, 0), OPCODE_HANDLER(OP_FMOV, 8, 1),
+		OPCODE_HANDLER(OP_FMOV, 8, 0), OPCODE_HANDLER(OP_FTOI4T, 8, 0), OPCODE_HANDLER(OP_FTOI4R, 8, 0),
+		OPCODE_HANDLER(OP_FTOI4F, 8, 0), OPCODE_HANDLER(OP_FTOI4C, 8, 0), OPCODE_HANDLER(OP_FTOI4, 8, 0),
+		OPCODE_HANDLER(OP_FTOI8T, 8, 0), OPCODE_HANDLER(OP_FTOI8R, 8, 0), OPCODE_HANDLER(OP_FTOI8F, 8, 0),
+		OPCODE_HANDLER(OP_FTOI8C, 8, 0), OPCODE_HANDLER(OP_FTOI8, 8, 0), OPCODE_HANDLER(OP_FFRI4, 8, 0),
+		OPCODE_HANDLER(OP_FFRI8, 8, 0), OPCODE_HANDLER(OP_FFRFS, 8, 0), OPCODE_HANDLER(OP_FRNDS, 8, 0),
+		OPCODE_HANDLER(OP_FADD, 8, 0), OPCODE_HANDLER(OP_FSUB, 8, 0), OPCODE_HANDLER(OP_FCMP, 8, 1),
+		OPCODE_HANDLER(OP_FMUL, 8, 0), OPCODE_HANDLER(OP_FDIV, 8, 0), OPCODE_HANDLER(OP_FNEG, 8, 0),
+		OPCODE_HANDLER(OP_FABS, 8, 0), OPCODE_HANDLER(OP_FSQRT, 8, 0), OPCODE_HANDLER(OP_FRECIP, 8, 0),
+		OPCODE_HANDLER(OP_FRSQRT, 8, 0), OPCODE_HANDLER(OP_FCOPYI, 8, 0), OPCODE_HANDLER(OP_ICOPYF, 8, 0),
+		OPCODE_HANDLER(OP_VMOV, 4, 0), OPCODE_HANDLER(OP_VADD1, 4, 0), OPCODE_HANDLER(OP_VADD2, 4, 0),
+		OPCODE_HANDLER(OP_VADD4, 4, 0), OPCODE_HANDLER(OP_VADD8, 4, 0), OPCODE_HANDLER(OP_VSUB1, 4, 0),
+		OPCODE_HANDLER(OP_VSUB2, 4, 0), OPCODE_HANDLER(OP_VSUB4, 4, 0), OPCODE_HANDLER(OP_VSUB8, 4, 0),
+		OPCODE_HANDLER(OP_VADDS1, 4, 0), OPCODE_HANDLER(OP_VADDS2, 4, 0), OPCODE_HANDLER(OP_VSUBS1, 4, 0),
+		OPCODE_HANDLER(OP_VSUBS2, 4, 0), OPCODE_HANDLER(OP_VFADD, 4, 0), OPCODE_HANDLER(OP_VFSUB, 4, 0),
+		OPCODE_HANDLER(OP_VFMUL, 4, 0), OPCODE_HANDLER(OP_VFMIN, 4, 0), OPCODE_HANDLER(OP_VFMAX, 4, 0),
+		OPCODE_HANDLER(OP_VSHUF, 4, 0),
+	};
+	static dispatch_table const s_dispatch = make_dispatch_table(s_handlers, &&handler_invalid);
+#endif
+
 	while (true)
 	{
 		uint32_t opcode = (inst++)->i;
 
+#if DRCBEC_THREADED_DISPATCH
+		goto *s_dispatch[OPCODE_GET_SHORT(opcode)];
+#endif
 		switch (OPCODE_GET_SHORT(opcode))
 		{
 			// ----------------------- Control Flow Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_HANDLE, 4, 0):    // HANDLE  handle
-			case MAKE_OPCODE_SHORT(OP_HASH, 4, 0):      // HASH    mode,pc
-			case MAKE_OPCODE_SHORT(OP_LABEL, 4, 0):     // LABEL   imm
-			case MAKE_OPCODE_SHORT(OP_COMMENT, 4, 0):   // COMMENT string
-			case MAKE_OPCODE_SHORT(OP_MAPVAR, 4, 0):    // MAPVAR  mapvar,value
+			OPCODE_CASE(OP_HANDLE, 4, 0):               // HANDLE  handle
+			OPCODE_CASE(OP_HASH, 4, 0):                 // HASH    mode,pc
+			OPCODE_CASE(OP_LABEL, 4, 0):                // LABEL   imm
+			OPCODE_CASE(OP_COMMENT, 4, 0):              // COMMENT string
+			OPCODE_CASE(OP_MAPVAR, 4, 0):               // MAPVAR  mapvar,value
 
 				// these opcodes should be processed at compile-time only
 				fatalerror("Unexpected opcode\n");
 
-			case MAKE_OPCODE_SHORT(OP_DEBUG, 4, 0):     // DEBUG   pc
+			OPCODE_CASE(OP_DEBUG, 4, 0):                // DEBUG   pc
 				if (m_device.machine().debug_flags & DEBUG_FLAG_CALL_HOOK)
 					m_device.debug()->instruction_hook(PARAM0);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_HASHJMP, 4, 0):   // HASHJMP mode,pc,handle
+			OPCODE_CASE(OP_HASHJMP, 4, 0):              // HASHJMP mode,pc,handle
 				sp = 0;
 				newinst = (const drcbec_instruction *)m_hash.get_codeptr(PARAM0, PARAM1);
 				if (newinst == nullptr)
@@ -537,31 +787,31 @@ int drcbe_c::execute(code_handle &entry)
 				inst = newinst;
 				continue;
 
-			case MAKE_OPCODE_SHORT(OP_EXIT, 4, 1):      // EXIT    src1[,c]
+			OPCODE_CASE(OP_EXIT, 4, 1):                 // EXIT    src1[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				[[fallthrough]];
 
-			case MAKE_OPCODE_SHORT(OP_EXIT, 4, 0):
+			OPCODE_CASE(OP_EXIT, 4, 0):
 				return PARAM0;
 
-			case MAKE_OPCODE_SHORT(OP_JMP, 4, 1):       // JMP     imm[,c]
+			OPCODE_CASE(OP_JMP, 4, 1):                  // JMP     imm[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				[[fallthrough]];
 
-			case MAKE_OPCODE_SHORT(OP_JMP, 4, 0):
+			OPCODE_CASE(OP_JMP, 4, 0):
 				newinst = inst[0].inst;
 				assert_in_cache(m_cache, newinst);
 				inst = newinst;
 				continue;
 
-			case MAKE_OPCODE_SHORT(OP_CALLH, 4, 1):     // CALLH   handle[,c]
+			OPCODE_CASE(OP_CALLH, 4, 1):                // CALLH   handle[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				[[fallthrough]];
 
-			case MAKE_OPCODE_SHORT(OP_CALLH, 4, 0):
+			OPCODE_CASE(OP_CALLH, 4, 0):
 				assert(sp < std::size(callstack));
 				newinst = (const drcbec_instruction *)inst[0].handle->codeptr();
 				assert_in_cache(m_cache, newinst);
@@ -569,24 +819,24 @@ int drcbe_c::execute(code_handle &entry)
 				inst = newinst;
 				continue;
 
-			case MAKE_OPCODE_SHORT(OP_RET, 4, 1):       // RET     [c]
+			OPCODE_CASE(OP_RET, 4, 1):                  // RET     [c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				[[fallthrough]];
 
-			case MAKE_OPCODE_SHORT(OP_RET, 4, 0):
+			OPCODE_CASE(OP_RET, 4, 0):
 				assert(sp > 0);
 				newinst = callstack[--sp];
 				assert_in_cache(m_cache, newinst);
 				inst = newinst;
 				continue;
 
-			case MAKE_OPCODE_SHORT(OP_EXH, 4, 1):       // EXH     handle,param[,c]
+			OPCODE_CASE(OP_EXH, 4, 1):                  // EXH     handle,param[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				[[fallthrough]];
 
-			case MAKE_OPCODE_SHORT(OP_EXH, 4, 0):
+			OPCODE_CASE(OP_EXH, 4, 0):
 				assert(sp < std::size(callstack));
 				newinst = (const drcbec_instruction *)inst[0].handle->codeptr();
 				assert_in_cache(m_cache, newinst);
@@ -595,16 +845,16 @@ int drcbe_c::execute(code_handle &entry)
 				inst = newinst;
 				continue;
 
-			case MAKE_OPCODE_SHORT(OP_CALLC, 4, 1):     // CALLC   func,ptr[,c]
+			OPCODE_CASE(OP_CALLC, 4, 1):                // CALLC   func,ptr[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				[[fallthrough]];
 
-			case MAKE_OPCODE_SHORT(OP_CALLC, 4, 0):
+			OPCODE_CASE(OP_CALLC, 4, 0):
 				(*inst[0].cfunc)(inst[1].v);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_RECOVER, 4, 0):   // RECOVER dst,mapvar
+			OPCODE_CASE(OP_RECOVER, 4, 0):              // RECOVER dst,mapvar
 				assert(sp > 0);
 				PARAM0 = m_map.get_value((drccodeptr)callstack[0], MAPVAR_M0 + PARAM1);
 				break;
@@ -612,29 +862,29 @@ int drcbe_c::execute(code_handle &entry)
 
 			// ----------------------- Internal Register Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_SETFMOD, 4, 0):   // SETFMOD src
+			OPCODE_CASE(OP_SETFMOD, 4, 0):              // SETFMOD src
 				m_state.fmod = PARAM0;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_GETFMOD, 4, 0):   // GETFMOD dst
+			OPCODE_CASE(OP_GETFMOD, 4, 0):              // GETFMOD dst
 				PARAM0 = m_state.fmod;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_GETEXP, 4, 0):    // GETEXP  dst
+			OPCODE_CASE(OP_GETEXP, 4, 0):               // GETEXP  dst
 				PARAM0 = m_state.exp;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_GETFLGS, 4, 0):   // GETFLGS dst[,f]
+			OPCODE_CASE(OP_GETFLGS, 4, 0):              // GETFLGS dst[,f]
 				PARAM0 = flags & PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SAVE, 4, 0):      // SAVE    dst
+			OPCODE_CASE(OP_SAVE, 4, 0):                 // SAVE    dst
 				*inst[0].state = m_state;
 				inst[0].state->flags = flags;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_RESTORE, 4, 0):   // RESTORE dst
-			case MAKE_OPCODE_SHORT(OP_RESTORE, 4, 1):   // RESTORE dst
+			OPCODE_CASE(OP_RESTORE, 4, 0):              // RESTORE dst
+			OPCODE_CASE(OP_RESTORE, 4, 1):              // RESTORE dst
 				m_state = *inst[0].state;
 				flags = inst[0].state->flags;
 				break;
@@ -642,320 +892,300 @@ int drcbe_c::execute(code_handle &entry)
 
 			// ----------------------- 32-Bit Integer Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1, 4, 0):     // LOAD    dst,base,index,BYTE
+			OPCODE_CASE(OP_LOAD1, 4, 0):                // LOAD    dst,base,index,BYTE
 				PARAM0 = inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x2, 4, 0):   // LOAD    dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_LOAD1x2, 4, 0):              // LOAD    dst,base,index,BYTE_x2
 				PARAM0 = *(uint8_t *)&inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x4, 4, 0):   // LOAD    dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_LOAD1x4, 4, 0):              // LOAD    dst,base,index,BYTE_x4
 				PARAM0 = *(uint8_t *)&inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x8, 4, 0):   // LOAD    dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_LOAD1x8, 4, 0):              // LOAD    dst,base,index,BYTE_x8
 				PARAM0 = *(uint8_t *)&inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x1, 4, 0):   // LOAD    dst,base,index,WORD_x1
+			OPCODE_CASE(OP_LOAD2x1, 4, 0):              // LOAD    dst,base,index,WORD_x1
 				PARAM0 = *(uint16_t *)&inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2, 4, 0):     // LOAD    dst,base,index,WORD
+			OPCODE_CASE(OP_LOAD2, 4, 0):                // LOAD    dst,base,index,WORD
 				PARAM0 = inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x4, 4, 0):   // LOAD    dst,base,index,WORD_x4
+			OPCODE_CASE(OP_LOAD2x4, 4, 0):              // LOAD    dst,base,index,WORD_x4
 				PARAM0 = *(uint16_t *)&inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x8, 4, 0):   // LOAD    dst,base,index,WORD_x8
+			OPCODE_CASE(OP_LOAD2x8, 4, 0):              // LOAD    dst,base,index,WORD_x8
 				PARAM0 = *(uint16_t *)&inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x1, 4, 0):   // LOAD    dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_LOAD4x1, 4, 0):              // LOAD    dst,base,index,DWORD_x1
 				PARAM0 = *(uint32_t *)&inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x2, 4, 0):   // LOAD    dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_LOAD4x2, 4, 0):              // LOAD    dst,base,index,DWORD_x2
 				PARAM0 = *(uint32_t *)&inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4, 4, 0):     // LOAD    dst,base,index,DWORD
+			OPCODE_CASE(OP_LOAD4, 4, 0):                // LOAD    dst,base,index,DWORD
 				PARAM0 = inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x8, 4, 0):   // LOAD    dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_LOAD4x8, 4, 0):              // LOAD    dst,base,index,DWORD_x8
 				PARAM0 = *(uint32_t *)&inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1, 4, 0):    // LOADS   dst,base,index,BYTE
+			OPCODE_CASE(OP_LOADS1, 4, 0):               // LOADS   dst,base,index,BYTE
 				PARAM0 = inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x2, 4, 0):  // LOADS   dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_LOADS1x2, 4, 0):             // LOADS   dst,base,index,BYTE_x2
 				PARAM0 = *(int8_t *)&inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x4, 4, 0):  // LOADS   dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_LOADS1x4, 4, 0):             // LOADS   dst,base,index,BYTE_x4
 				PARAM0 = *(int8_t *)&inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x8, 4, 0):  // LOADS   dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_LOADS1x8, 4, 0):             // LOADS   dst,base,index,BYTE_x8
 				PARAM0 = *(int8_t *)&inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x1, 4, 0):  // LOADS   dst,base,index,WORD_x1
+			OPCODE_CASE(OP_LOADS2x1, 4, 0):             // LOADS   dst,base,index,WORD_x1
 				PARAM0 = *(int16_t *)&inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2, 4, 0):    // LOADS   dst,base,index,WORD
+			OPCODE_CASE(OP_LOADS2, 4, 0):               // LOADS   dst,base,index,WORD
 				PARAM0 = inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x4, 4, 0):  // LOADS   dst,base,index,WORD_x4
+			OPCODE_CASE(OP_LOADS2x4, 4, 0):             // LOADS   dst,base,index,WORD_x4
 				PARAM0 = *(int16_t *)&inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x8, 4, 0):  // LOADS   dst,base,index,WORD_x8
+			OPCODE_CASE(OP_LOADS2x8, 4, 0):             // LOADS   dst,base,index,WORD_x8
 				PARAM0 = *(int16_t *)&inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x1, 4, 0):  // LOADS   dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_LOADS4x1, 4, 0):             // LOADS   dst,base,index,DWORD_x1
 				PARAM0 = *(int32_t *)&inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x2, 4, 0):  // LOADS   dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_LOADS4x2, 4, 0):             // LOADS   dst,base,index,DWORD_x2
 				PARAM0 = *(int32_t *)&inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4, 4, 0):    // LOADS   dst,base,index,DWORD
+			OPCODE_CASE(OP_LOADS4, 4, 0):               // LOADS   dst,base,index,DWORD
 				PARAM0 = inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x8, 4, 0):  // LOADS   dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_LOADS4x8, 4, 0):             // LOADS   dst,base,index,DWORD_x8
 				PARAM0 = *(int32_t *)&inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1, 4, 0):    // STORE   dst,base,index,BYTE
+			OPCODE_CASE(OP_STORE1, 4, 0):               // STORE   dst,base,index,BYTE
 				inst[0].puint8[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x2, 4, 0):  // STORE   dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_STORE1x2, 4, 0):             // STORE   dst,base,index,BYTE_x2
 				*(uint8_t *)&inst[0].puint16[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x4, 4, 0):  // STORE   dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_STORE1x4, 4, 0):             // STORE   dst,base,index,BYTE_x4
 				*(uint8_t *)&inst[0].puint32[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x8, 4, 0):  // STORE   dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_STORE1x8, 4, 0):             // STORE   dst,base,index,BYTE_x8
 				*(uint8_t *)&inst[0].puint64[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x1, 4, 0):  // STORE   dst,base,index,WORD_x1
+			OPCODE_CASE(OP_STORE2x1, 4, 0):             // STORE   dst,base,index,WORD_x1
 				*(uint16_t *)&inst[0].puint8[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2, 4, 0):    // STORE   dst,base,index,WORD
+			OPCODE_CASE(OP_STORE2, 4, 0):               // STORE   dst,base,index,WORD
 				inst[0].puint16[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x4, 4, 0):  // STORE   dst,base,index,WORD_x4
+			OPCODE_CASE(OP_STORE2x4, 4, 0):             // STORE   dst,base,index,WORD_x4
 				*(uint16_t *)&inst[0].puint32[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x8, 4, 0):  // STORE   dst,base,index,WORD_x8
+			OPCODE_CASE(OP_STORE2x8, 4, 0):             // STORE   dst,base,index,WORD_x8
 				*(uint16_t *)&inst[0].puint64[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x1, 4, 0):  // STORE   dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_STORE4x1, 4, 0):             // STORE   dst,base,index,DWORD_x1
 				*(uint32_t *)&inst[0].puint8[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x2, 4, 0):  // STORE   dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_STORE4x2, 4, 0):             // STORE   dst,base,index,DWORD_x2
 				*(uint32_t *)&inst[0].puint16[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4, 4, 0):    // STORE   dst,base,index,DWORD
+			OPCODE_CASE(OP_STORE4, 4, 0):               // STORE   dst,base,index,DWORD
 				inst[0].puint32[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x8, 4, 0):  // STORE   dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_STORE4x8, 4, 0):             // STORE   dst,base,index,DWORD_x8
 				*(uint32_t *)&inst[0].puint64[PARAM1] = PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ1, 4, 0):     // READ    dst,src1,space_BYTE
+			OPCODE_CASE(OP_READ1, 4, 0):                // READ    dst,src1,space_BYTE
 				PARAM0 = m_space[PARAM2]->read_byte(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ2, 4, 0):     // READ    dst,src1,space_WORD
+			OPCODE_CASE(OP_READ2, 4, 0):                // READ    dst,src1,space_WORD
 				PARAM0 = m_space[PARAM2]->read_word(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ4, 4, 0):     // READ    dst,src1,space_DWORD
+			OPCODE_CASE(OP_READ4, 4, 0):                // READ    dst,src1,space_DWORD
 				PARAM0 = m_space[PARAM2]->read_dword(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READM2, 4, 0):    // READM   dst,src1,mask,space_WORD
+			OPCODE_CASE(OP_READM2, 4, 0):               // READM   dst,src1,mask,space_WORD
 				PARAM0 = m_space[PARAM3]->read_word(PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READM4, 4, 0):    // READM   dst,src1,mask,space_DWORD
+			OPCODE_CASE(OP_READM4, 4, 0):               // READM   dst,src1,mask,space_DWORD
 				PARAM0 = m_space[PARAM3]->read_dword(PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE1, 4, 0):    // WRITE   dst,src1,space_BYTE
+			OPCODE_CASE(OP_WRITE1, 4, 0):               // WRITE   dst,src1,space_BYTE
 				m_space[PARAM2]->write_byte(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE2, 4, 0):    // WRITE   dst,src1,space_WORD
+			OPCODE_CASE(OP_WRITE2, 4, 0):               // WRITE   dst,src1,space_WORD
 				m_space[PARAM2]->write_word(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE4, 4, 0):    // WRITE   dst,src1,space_DWORD
+			OPCODE_CASE(OP_WRITE4, 4, 0):               // WRITE   dst,src1,space_DWORD
 				m_space[PARAM2]->write_dword(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM2, 4, 0):   // WRITEM  dst,src1,mask,space_WORD
+			OPCODE_CASE(OP_WRITEM2, 4, 0):              // WRITEM  dst,src1,mask,space_WORD
 				m_space[PARAM3]->write_word(PARAM0, PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM4, 4, 0):   // WRITEM  dst,src1,mask,space_DWORD
+			OPCODE_CASE(OP_WRITEM4, 4, 0):              // WRITEM  dst,src1,mask,space_DWORD
 				m_space[PARAM3]->write_dword(PARAM0, PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_CARRY, 4, 1):     // CARRY   src,bitnum
+			OPCODE_CASE(OP_CARRY, 4, 1):                // CARRY   src,bitnum
 				flags = (flags & ~FLAG_C) | ((PARAM0 >> (PARAM1 & 31)) & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MOV, 4, 1):       // MOV     dst,src[,c]
+			OPCODE_CASE(OP_MOV, 4, 1):                  // MOV     dst,src[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				[[fallthrough]];
 
-			case MAKE_OPCODE_SHORT(OP_MOV, 4, 0):
+			OPCODE_CASE(OP_MOV, 4, 0):
 				PARAM0 = PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SET, 4, 1):       // SET     dst,c
+			OPCODE_CASE(OP_SET, 4, 1):                  // SET     dst,c
 				PARAM0 = OPCODE_FAIL_CONDITION(opcode, flags) ? 0 : 1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT1, 4, 0):     // SEXT1   dst,src
+			OPCODE_CASE(OP_SEXT1, 4, 0):                // SEXT1   dst,src
 				PARAM0 = (int8_t)PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT1, 4, 1):
+			OPCODE_CASE(OP_SEXT1, 4, 1):
 				temp32 = (int8_t)PARAM1;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT2, 4, 0):     // SEXT2   dst,src
+			OPCODE_CASE(OP_SEXT2, 4, 0):                // SEXT2   dst,src
 				PARAM0 = (int16_t)PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT2, 4, 1):
+			OPCODE_CASE(OP_SEXT2, 4, 1):
 				temp32 = (int16_t)PARAM1;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLAND, 4, 0):    // ROLAND  dst,src,count,mask[,f]
+			OPCODE_CASE(OP_ROLAND, 4, 0):               // ROLAND  dst,src,count,mask[,f]
 				PARAM0 = rotl_32(PARAM1, PARAM2) & PARAM3;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLAND, 4, 1):
+			OPCODE_CASE(OP_ROLAND, 4, 1):
 				temp32 = rotl_32(PARAM1, PARAM2) & PARAM3;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLINS, 4, 0):    // ROLINS  dst,src,count,mask[,f]
+			OPCODE_CASE(OP_ROLINS, 4, 0):               // ROLINS  dst,src,count,mask[,f]
 				PARAM0 = (PARAM0 & ~PARAM3) | (rotl_32(PARAM1, PARAM2) & PARAM3);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLINS, 4, 1):
+			OPCODE_CASE(OP_ROLINS, 4, 1):
 				temp32 = (PARAM0 & ~PARAM3) | (rotl_32(PARAM1, PARAM2) & PARAM3);
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADD, 4, 0):       // ADD     dst,src1,src2[,f]
+			OPCODE_CASE(OP_ADD, 4, 0):                  // ADD     dst,src1,src2[,f]
 				PARAM0 = PARAM1 + PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADD, 4, 1):
+			OPCODE_CASE(OP_ADD, 4, 1):
 				temp32 = PARAM1 + PARAM2;
 				flags = FLAGS32_NZCV_ADD(temp32, PARAM1, PARAM2);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADDC, 4, 0):      // ADDC    dst,src1,src2[,f]
+			OPCODE_CASE(OP_ADDC, 4, 0):                 // ADDC    dst,src1,src2[,f]
 				PARAM0 = PARAM1 + PARAM2 + (flags & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADDC, 4, 1):
+			OPCODE_CASE(OP_ADDC, 4, 1):
 				temp32 = PARAM1 + PARAM2 + (flags & FLAG_C);
-				if (PARAM2 + 1 != 0)
-					flags = FLAGS32_NZCV_ADD(temp32, PARAM1, PARAM2 + (flags & FLAG_C));
-				else
-				{
-					if ((PARAM2 == 0xffffffff) && (flags & FLAG_C))
-					{
-						flags = FLAGS32_NZCV_ADD(temp32, PARAM1 + (flags & FLAG_C), PARAM2);
-						flags |= FLAG_C;
-					}
-					else
-						flags = FLAGS32_NZCV_ADD(temp32, PARAM1 + (flags & FLAG_C), PARAM2);
-				}
+				flags = FLAGS32_NZCV_ADDC(temp32, PARAM1, PARAM2, flags & FLAG_C);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUB, 4, 0):       // SUB     dst,src1,src2[,f]
+			OPCODE_CASE(OP_SUB, 4, 0):                  // SUB     dst,src1,src2[,f]
 				PARAM0 = PARAM1 - PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUB, 4, 1):
+			OPCODE_CASE(OP_SUB, 4, 1):
 				temp32 = PARAM1 - PARAM2;
 				flags = FLAGS32_NZCV_SUB(temp32, PARAM1, PARAM2);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUBB, 4, 0):      // SUBB    dst,src1,src2[,f]
+			OPCODE_CASE(OP_SUBB, 4, 0):                 // SUBB    dst,src1,src2[,f]
 				PARAM0 = PARAM1 - PARAM2 - (flags & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUBB, 4, 1):
+			OPCODE_CASE(OP_SUBB, 4, 1):
 				temp32 = PARAM1 - PARAM2 - (flags & FLAG_C);
-				temp64 = (uint64_t)PARAM1 - (uint64_t)PARAM2 - (uint64_t)(flags & FLAG_C);
-				if (PARAM2 + 1 != 0)
-					flags = FLAGS32_NZCV_SUB(temp32, PARAM1, PARAM2 + (flags & FLAG_C));
-				else
-				{
-					flags = FLAGS32_NZCV_SUB(temp32, PARAM1 - (flags & FLAG_C), PARAM2);
-					flags &= ~(FLAG_C | FLAG_V);
-					flags |= ((temp64>>32) & 1) ? FLAG_C : 0;
-					flags |= (((PARAM1) ^ (PARAM2)) & ((PARAM1) ^ (temp64)) & 0x80000000) ? FLAG_V : 0;
-				}
+				flags = FLAGS32_NZCV_SUBB(temp32, PARAM1, PARAM2, flags & FLAG_C);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_CMP, 4, 1):       // CMP     src1,src2[,f]
+			OPCODE_CASE(OP_CMP, 4, 1):                  // CMP     src1,src2[,f]
 				temp32 = PARAM0 - PARAM1;
 				flags = FLAGS32_NZCV_SUB(temp32, PARAM0, PARAM1);
 //                printf("CMP: %08x - %08x = flags %x\n", PARAM0, PARAM1, flags);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULU, 4, 0):      // MULU    dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_MULU, 4, 0):                 // MULU    dst,edst,src1,src2[,f]
 				temp64 = (uint64_t)(uint32_t)PARAM2 * (uint64_t)(uint32_t)PARAM3;
 				PARAM1 = temp64 >> 32;
 				PARAM0 = (uint32_t)temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULU, 4, 1):
+			OPCODE_CASE(OP_MULU, 4, 1):
 				temp64 = (uint64_t)(uint32_t)PARAM2 * (uint64_t)(uint32_t)PARAM3;
 				flags = FLAGS64_NZ(temp64);
 				PARAM1 = temp64 >> 32;
@@ -964,23 +1194,22 @@ int drcbe_c::execute(code_handle &entry)
 					flags |= FLAG_V;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULS, 4, 0):      // MULS    dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_MULS, 4, 0):                 // MULS    dst,edst,src1,src2[,f]
 				temp64 = (int64_t)(int32_t)PARAM2 * (int64_t)(int32_t)PARAM3;
 				PARAM1 = temp64 >> 32;
 				PARAM0 = (uint32_t)temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULS, 4, 1):
+			OPCODE_CASE(OP_MULS, 4, 1):
 				temp64 = (int64_t)(int32_t)PARAM2 * (int64_t)(int32_t)PARAM3;
-				temp32 = (int32_t)temp64;
-				flags = FLAGS32_NZ(temp32);
+				flags = FLAGS64_NZ(temp64);
 				PARAM1 = temp64 >> 32;
 				PARAM0 = (uint32_t)temp64;
 				if (temp64 != (int32_t)temp64)
 					flags |= FLAG_V;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVU, 4, 0):      // DIVU    dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_DIVU, 4, 0):                 // DIVU    dst,edst,src1,src2[,f]
 				if (PARAM3 != 0)
 				{
 					temp32 = (uint32_t)PARAM2 / (uint32_t)PARAM3;
@@ -989,7 +1218,7 @@ int drcbe_c::execute(code_handle &entry)
 				}
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVU, 4, 1):
+			OPCODE_CASE(OP_DIVU, 4, 1):
 				if (PARAM3 != 0)
 				{
 					temp32 = (uint32_t)PARAM2 / (uint32_t)PARAM3;
@@ -1001,7 +1230,7 @@ int drcbe_c::execute(code_handle &entry)
 					flags = FLAG_V;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVS, 4, 0):      // DIVS    dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_DIVS, 4, 0):                 // DIVS    dst,edst,src1,src2[,f]
 				if (PARAM3 != 0)
 				{
 					temp32 = (int32_t)PARAM2 / (int32_t)PARAM3;
@@ -1010,7 +1239,7 @@ int drcbe_c::execute(code_handle &entry)
 				}
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVS, 4, 1):
+			OPCODE_CASE(OP_DIVS, 4, 1):
 				if (PARAM3 != 0)
 				{
 					temp32 = (int32_t)PARAM2 / (int32_t)PARAM3;
@@ -1022,77 +1251,77 @@ int drcbe_c::execute(code_handle &entry)
 					flags = FLAG_V;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_AND, 4, 0):       // AND     dst,src1,src2[,f]
+			OPCODE_CASE(OP_AND, 4, 0):                  // AND     dst,src1,src2[,f]
 				PARAM0 = PARAM1 & PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_AND, 4, 1):
+			OPCODE_CASE(OP_AND, 4, 1):
 				temp32 = PARAM1 & PARAM2;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_TEST, 4, 1):      // TEST    src1,src2[,f]
+			OPCODE_CASE(OP_TEST, 4, 1):                 // TEST    src1,src2[,f]
 				temp32 = PARAM0 & PARAM1;
 				flags = FLAGS32_NZ(temp32);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_OR, 4, 0):        // OR      dst,src1,src2[,f]
+			OPCODE_CASE(OP_OR, 4, 0):                   // OR      dst,src1,src2[,f]
 				PARAM0 = PARAM1 | PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_OR, 4, 1):
+			OPCODE_CASE(OP_OR, 4, 1):
 				temp32 = PARAM1 | PARAM2;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_XOR, 4, 0):       // XOR     dst,src1,src2[,f]
+			OPCODE_CASE(OP_XOR, 4, 0):                  // XOR     dst,src1,src2[,f]
 				PARAM0 = PARAM1 ^ PARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_XOR, 4, 1):
+			OPCODE_CASE(OP_XOR, 4, 1):
 				temp32 = PARAM1 ^ PARAM2;
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LZCNT, 4, 0):     // LZCNT   dst,src
+			OPCODE_CASE(OP_LZCNT, 4, 0):                // LZCNT   dst,src
 				PARAM0 = count_leading_zeros_32(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LZCNT, 4, 1):
+			OPCODE_CASE(OP_LZCNT, 4, 1):
 				temp32 = count_leading_zeros_32(PARAM1);
 				flags = FLAGS32_NZ(temp32);
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_TZCNT, 4, 0):     // TZCNT   dst,src
+			OPCODE_CASE(OP_TZCNT, 4, 0):                // TZCNT   dst,src
 				PARAM0 = tzcount32(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_TZCNT, 4, 1):
+			OPCODE_CASE(OP_TZCNT, 4, 1):
 				temp32 = tzcount32(PARAM1);
 				flags = (temp32 == 32) ? FLAG_Z : 0;
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_BSWAP, 4, 0):     // BSWAP   dst,src
+			OPCODE_CASE(OP_BSWAP, 4, 0):                // BSWAP   dst,src
 				temp32 = PARAM1;
 				PARAM0 = swapendian_int32(temp32);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_BSWAP, 4, 1):
-				temp32 = PARAM1;
+			OPCODE_CASE(OP_BSWAP, 4, 1):
+				temp32 = swapendian_int32(PARAM1);
 				flags = FLAGS32_NZ(temp32);
-				PARAM0 = swapendian_int32(temp32);
+				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHL, 4, 0):       // SHL     dst,src,count[,f]
+			OPCODE_CASE(OP_SHL, 4, 0):                  // SHL     dst,src,count[,f]
 				PARAM0 = PARAM1 << (PARAM2 & 31);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHL, 4, 1):
+			OPCODE_CASE(OP_SHL, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = PARAM1 << shift;
 				if (shift != 0)
@@ -1103,11 +1332,11 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHR, 4, 0):       // SHR     dst,src,count[,f]
+			OPCODE_CASE(OP_SHR, 4, 0):                  // SHR     dst,src,count[,f]
 				PARAM0 = PARAM1 >> (PARAM2 & 31);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHR, 4, 1):
+			OPCODE_CASE(OP_SHR, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = PARAM1 >> shift;
 				if (shift != 0)
@@ -1118,11 +1347,11 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SAR, 4, 0):       // SAR     dst,src,count[,f]
+			OPCODE_CASE(OP_SAR, 4, 0):                  // SAR     dst,src,count[,f]
 				PARAM0 = (int32_t)PARAM1 >> (PARAM2 & 31);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SAR, 4, 1):
+			OPCODE_CASE(OP_SAR, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = (int32_t)PARAM1 >> shift;
 				if (shift != 0)
@@ -1133,11 +1362,11 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROL, 4, 0):       // ROL     dst,src,count[,f]
+			OPCODE_CASE(OP_ROL, 4, 0):                  // ROL     dst,src,count[,f]
 				PARAM0 = rotl_32(PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROL, 4, 1):
+			OPCODE_CASE(OP_ROL, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = rotl_32(PARAM1, shift);
 				if (shift != 0)
@@ -1148,7 +1377,7 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLC, 4, 0):      // ROLC    dst,src,count[,f]
+			OPCODE_CASE(OP_ROLC, 4, 0):                 // ROLC    dst,src,count[,f]
 				shift = PARAM2 & 31;
 				if (shift > 1)
 					PARAM0 = (PARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (PARAM1 >> (33 - shift));
@@ -1156,7 +1385,7 @@ int drcbe_c::execute(code_handle &entry)
 					PARAM0 = (PARAM1 << shift) | (flags & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLC, 4, 1):
+			OPCODE_CASE(OP_ROLC, 4, 1):
 				shift = PARAM2 & 31;
 				if (shift > 1)
 					temp32 = (PARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (PARAM1 >> (33 - shift));
@@ -1169,11 +1398,11 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROR, 4, 0):       // ROR     dst,src,count[,f]
+			OPCODE_CASE(OP_ROR, 4, 0):                  // ROR     dst,src,count[,f]
 				PARAM0 = rotr_32(PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROR, 4, 1):
+			OPCODE_CASE(OP_ROR, 4, 1):
 				shift = PARAM2 & 31;
 				temp32 = rotr_32(PARAM1, shift);
 				flags = FLAGS32_NZ(temp32);
@@ -1181,18 +1410,18 @@ int drcbe_c::execute(code_handle &entry)
 				PARAM0 = temp32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_RORC, 4, 0):      // RORC    dst,src,count[,f]
+			OPCODE_CASE(OP_RORC, 4, 0):                 // RORC    dst,src,count[,f]
 				shift = PARAM2 & 31;
 				if (shift > 1)
-					PARAM0 = (PARAM1 >> shift) | (((flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
+					PARAM0 = (PARAM1 >> shift) | ((((uint32_t)flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
 				else if (shift == 1)
 					PARAM0 = (PARAM1 >> shift) | ((flags & FLAG_C) << 31);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_RORC, 4, 1):
+			OPCODE_CASE(OP_RORC, 4, 1):
 				shift = PARAM2 & 31;
 				if (shift > 1)
-					temp32 = (PARAM1 >> shift) | (((flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
+					temp32 = (PARAM1 >> shift) | ((((uint32_t)flags & FLAG_C) << 31) >> (shift - 1)) | (PARAM1 << (33 - shift));
 				else if (shift == 1)
 					temp32 = (PARAM1 >> shift) | ((flags & FLAG_C) << 31);
 				else
@@ -1205,389 +1434,383 @@ int drcbe_c::execute(code_handle &entry)
 
 			// ----------------------- 64-Bit Integer Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1, 8, 0):     // DLOAD   dst,base,index,BYTE
+			OPCODE_CASE(OP_LOAD1, 8, 0):                // DLOAD   dst,base,index,BYTE
 				DPARAM0 = inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x2, 8, 0):   // DLOAD   dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_LOAD1x2, 8, 0):              // DLOAD   dst,base,index,BYTE_x2
 				DPARAM0 = *(uint8_t *)&inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x4, 8, 0):   // DLOAD   dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_LOAD1x4, 8, 0):              // DLOAD   dst,base,index,BYTE_x4
 				DPARAM0 = *(uint8_t *)&inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD1x8, 8, 0):   // DLOAD   dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_LOAD1x8, 8, 0):              // DLOAD   dst,base,index,BYTE_x8
 				DPARAM0 = *(uint8_t *)&inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x1, 8, 0):   // DLOAD   dst,base,index,WORD_x1
+			OPCODE_CASE(OP_LOAD2x1, 8, 0):              // DLOAD   dst,base,index,WORD_x1
 				DPARAM0 = *(uint16_t *)&inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2, 8, 0):     // DLOAD   dst,base,index,WORD
+			OPCODE_CASE(OP_LOAD2, 8, 0):                // DLOAD   dst,base,index,WORD
 				DPARAM0 = inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x4, 8, 0):   // DLOAD   dst,base,index,WORD_x4
+			OPCODE_CASE(OP_LOAD2x4, 8, 0):              // DLOAD   dst,base,index,WORD_x4
 				DPARAM0 = *(uint16_t *)&inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD2x8, 8, 0):   // DLOAD   dst,base,index,WORD_x8
+			OPCODE_CASE(OP_LOAD2x8, 8, 0):              // DLOAD   dst,base,index,WORD_x8
 				DPARAM0 = *(uint16_t *)&inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x1, 8, 0):   // DLOAD   dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_LOAD4x1, 8, 0):              // DLOAD   dst,base,index,DWORD_x1
 				DPARAM0 = *(uint32_t *)&inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x2, 8, 0):   // DLOAD   dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_LOAD4x2, 8, 0):              // DLOAD   dst,base,index,DWORD_x2
 				DPARAM0 = *(uint32_t *)&inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4, 8, 0):     // DLOAD   dst,base,index,DWORD
+			OPCODE_CASE(OP_LOAD4, 8, 0):                // DLOAD   dst,base,index,DWORD
 				DPARAM0 = inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD4x8, 8, 0):   // DLOAD   dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_LOAD4x8, 8, 0):              // DLOAD   dst,base,index,DWORD_x8
 				DPARAM0 = *(uint32_t *)&inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD8x1, 8, 0):   // DLOAD   dst,base,index,QWORD_x1
+			OPCODE_CASE(OP_LOAD8x1, 8, 0):              // DLOAD   dst,base,index,QWORD_x1
 				DPARAM0 = *(uint64_t *)&inst[1].puint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD8x2, 8, 0):   // DLOAD   dst,base,index,QWORD_x2
+			OPCODE_CASE(OP_LOAD8x2, 8, 0):              // DLOAD   dst,base,index,QWORD_x2
 				DPARAM0 = *(uint64_t *)&inst[1].puint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD8x4, 8, 0):   // DLOAD   dst,base,index,QWORD_x4
+			OPCODE_CASE(OP_LOAD8x4, 8, 0):              // DLOAD   dst,base,index,QWORD_x4
 				DPARAM0 = *(uint64_t *)&inst[1].puint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOAD8, 8, 0):     // DLOAD   dst,base,index,QWORD
+			OPCODE_CASE(OP_LOAD8, 8, 0):                // DLOAD   dst,base,index,QWORD
 				DPARAM0 = inst[1].puint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1, 8, 0):    // DLOADS  dst,base,index,BYTE
+			OPCODE_CASE(OP_LOADS1, 8, 0):               // DLOADS  dst,base,index,BYTE
 				DPARAM0 = inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x2, 8, 0):  // DLOADS  dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_LOADS1x2, 8, 0):             // DLOADS  dst,base,index,BYTE_x2
 				DPARAM0 = *(int8_t *)&inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x4, 8, 0):  // DLOADS  dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_LOADS1x4, 8, 0):             // DLOADS  dst,base,index,BYTE_x4
 				DPARAM0 = *(int8_t *)&inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS1x8, 8, 0):  // DLOADS  dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_LOADS1x8, 8, 0):             // DLOADS  dst,base,index,BYTE_x8
 				DPARAM0 = *(int8_t *)&inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x1, 8, 0):  // DLOADS  dst,base,index,WORD_x1
+			OPCODE_CASE(OP_LOADS2x1, 8, 0):             // DLOADS  dst,base,index,WORD_x1
 				DPARAM0 = *(int16_t *)&inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2, 8, 0):    // DLOADS  dst,base,index,WORD
+			OPCODE_CASE(OP_LOADS2, 8, 0):               // DLOADS  dst,base,index,WORD
 				DPARAM0 = inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x4, 8, 0):  // DLOADS  dst,base,index,WORD_x4
+			OPCODE_CASE(OP_LOADS2x4, 8, 0):             // DLOADS  dst,base,index,WORD_x4
 				DPARAM0 = *(int16_t *)&inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS2x8, 8, 0):  // DLOADS  dst,base,index,WORD_x8
+			OPCODE_CASE(OP_LOADS2x8, 8, 0):             // DLOADS  dst,base,index,WORD_x8
 				DPARAM0 = *(int16_t *)&inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x1, 8, 0):  // DLOADS  dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_LOADS4x1, 8, 0):             // DLOADS  dst,base,index,DWORD_x1
 				DPARAM0 = *(int32_t *)&inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x2, 8, 0):  // DLOADS  dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_LOADS4x2, 8, 0):             // DLOADS  dst,base,index,DWORD_x2
 				DPARAM0 = *(int32_t *)&inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4, 8, 0):    // DLOADS  dst,base,index,DWORD
+			OPCODE_CASE(OP_LOADS4, 8, 0):               // DLOADS  dst,base,index,DWORD
 				DPARAM0 = inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS4x8, 8, 0):  // DLOADS  dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_LOADS4x8, 8, 0):             // DLOADS  dst,base,index,DWORD_x8
 				DPARAM0 = *(int32_t *)&inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS8x1, 8, 0):  // DLOADS  dst,base,index,QWORD_x1
+			OPCODE_CASE(OP_LOADS8x1, 8, 0):             // DLOADS  dst,base,index,QWORD_x1
 				DPARAM0 = *(int64_t *)&inst[1].pint8[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS8x2, 8, 0):  // DLOADS  dst,base,index,QWORD_x2
+			OPCODE_CASE(OP_LOADS8x2, 8, 0):             // DLOADS  dst,base,index,QWORD_x2
 				DPARAM0 = *(int64_t *)&inst[1].pint16[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS8x4, 8, 0):  // DLOADS  dst,base,index,QWORD_x4
+			OPCODE_CASE(OP_LOADS8x4, 8, 0):             // DLOADS  dst,base,index,QWORD_x4
 				DPARAM0 = *(int64_t *)&inst[1].pint32[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LOADS8, 8, 0):    // DLOADS  dst,base,index,QWORD
+			OPCODE_CASE(OP_LOADS8, 8, 0):               // DLOADS  dst,base,index,QWORD
 				DPARAM0 = inst[1].pint64[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1, 8, 0):    // DSTORE  dst,base,index,BYTE
+			OPCODE_CASE(OP_STORE1, 8, 0):               // DSTORE  dst,base,index,BYTE
 				inst[0].puint8[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x2, 8, 0):  // DSTORE  dst,base,index,BYTE_x2
+			OPCODE_CASE(OP_STORE1x2, 8, 0):             // DSTORE  dst,base,index,BYTE_x2
 				*(uint8_t *)&inst[0].puint16[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x4, 8, 0):  // DSTORE  dst,base,index,BYTE_x4
+			OPCODE_CASE(OP_STORE1x4, 8, 0):             // DSTORE  dst,base,index,BYTE_x4
 				*(uint8_t *)&inst[0].puint32[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE1x8, 8, 0):  // DSTORE  dst,base,index,BYTE_x8
+			OPCODE_CASE(OP_STORE1x8, 8, 0):             // DSTORE  dst,base,index,BYTE_x8
 				*(uint8_t *)&inst[0].puint64[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x1, 8, 0):  // DSTORE  dst,base,index,WORD_x1
+			OPCODE_CASE(OP_STORE2x1, 8, 0):             // DSTORE  dst,base,index,WORD_x1
 				*(uint16_t *)&inst[0].puint8[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2, 8, 0):    // DSTORE  dst,base,index,WORD
+			OPCODE_CASE(OP_STORE2, 8, 0):               // DSTORE  dst,base,index,WORD
 				inst[0].puint16[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x4, 8, 0):  // DSTORE  dst,base,index,WORD_x4
+			OPCODE_CASE(OP_STORE2x4, 8, 0):             // DSTORE  dst,base,index,WORD_x4
 				*(uint16_t *)&inst[0].puint32[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE2x8, 8, 0):  // DSTORE  dst,base,index,WORD_x8
+			OPCODE_CASE(OP_STORE2x8, 8, 0):             // DSTORE  dst,base,index,WORD_x8
 				*(uint16_t *)&inst[0].puint64[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x1, 8, 0):  // DSTORE  dst,base,index,DWORD_x1
+			OPCODE_CASE(OP_STORE4x1, 8, 0):             // DSTORE  dst,base,index,DWORD_x1
 				*(uint32_t *)&inst[0].puint8[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x2, 8, 0):  // DSTORE  dst,base,index,DWORD_x2
+			OPCODE_CASE(OP_STORE4x2, 8, 0):             // DSTORE  dst,base,index,DWORD_x2
 				*(uint32_t *)&inst[0].puint16[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4, 8, 0):    // DSTORE  dst,base,index,DWORD
+			OPCODE_CASE(OP_STORE4, 8, 0):               // DSTORE  dst,base,index,DWORD
 				inst[0].puint32[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE4x8, 8, 0):  // DSTORE  dst,base,index,DWORD_x8
+			OPCODE_CASE(OP_STORE4x8, 8, 0):             // DSTORE  dst,base,index,DWORD_x8
 				*(uint32_t *)&inst[0].puint64[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE8x1, 8, 0):  // DSTORE  dst,base,index,QWORD_x1
+			OPCODE_CASE(OP_STORE8x1, 8, 0):             // DSTORE  dst,base,index,QWORD_x1
 				*(uint64_t *)&inst[0].puint8[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE8x2, 8, 0):  // DSTORE  dst,base,index,QWORD_x2
+			OPCODE_CASE(OP_STORE8x2, 8, 0):             // DSTORE  dst,base,index,QWORD_x2
 				*(uint64_t *)&inst[0].puint16[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE8x4, 8, 0):  // DSTORE  dst,base,index,QWORD_x4
+			OPCODE_CASE(OP_STORE8x4, 8, 0):             // DSTORE  dst,base,index,QWORD_x4
 				*(uint64_t *)&inst[0].puint32[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_STORE8, 8, 0):    // DSTORE  dst,base,index,QWORD
+			OPCODE_CASE(OP_STORE8, 8, 0):               // DSTORE  dst,base,index,QWORD
 				inst[0].puint64[PARAM1] = DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ1, 8, 0):     // DREAD   dst,src1,space_BYTE
+			OPCODE_CASE(OP_READ1, 8, 0):                // DREAD   dst,src1,space_BYTE
 				DPARAM0 = m_space[PARAM2]->read_byte(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ2, 8, 0):     // DREAD   dst,src1,space_WORD
+			OPCODE_CASE(OP_READ2, 8, 0):                // DREAD   dst,src1,space_WORD
 				DPARAM0 = m_space[PARAM2]->read_word(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ4, 8, 0):     // DREAD   dst,src1,space_DWORD
+			OPCODE_CASE(OP_READ4, 8, 0):                // DREAD   dst,src1,space_DWORD
 				DPARAM0 = m_space[PARAM2]->read_dword(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READ8, 8, 0):     // DREAD   dst,src1,space_QOWRD
+			OPCODE_CASE(OP_READ8, 8, 0):                // DREAD   dst,src1,space_QOWRD
 				DPARAM0 = m_space[PARAM2]->read_qword(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READM2, 8, 0):    // DREADM  dst,src1,mask,space_WORD
+			OPCODE_CASE(OP_READM2, 8, 0):               // DREADM  dst,src1,mask,space_WORD
 				DPARAM0 = m_space[PARAM3]->read_word(PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READM4, 8, 0):    // DREADM  dst,src1,mask,space_DWORD
+			OPCODE_CASE(OP_READM4, 8, 0):               // DREADM  dst,src1,mask,space_DWORD
 				DPARAM0 = m_space[PARAM3]->read_dword(PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_READM8, 8, 0):    // DREADM  dst,src1,mask,space_QWORD
+			OPCODE_CASE(OP_READM8, 8, 0):               // DREADM  dst,src1,mask,space_QWORD
 				DPARAM0 = m_space[PARAM3]->read_qword(PARAM1, PARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE1, 8, 0):    // DWRITE  dst,src1,space_BYTE
+			OPCODE_CASE(OP_WRITE1, 8, 0):               // DWRITE  dst,src1,space_BYTE
 				m_space[PARAM2]->write_byte(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE2, 8, 0):    // DWRITE  dst,src1,space_WORD
+			OPCODE_CASE(OP_WRITE2, 8, 0):               // DWRITE  dst,src1,space_WORD
 				m_space[PARAM2]->write_word(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE4, 8, 0):    // DWRITE  dst,src1,space_DWORD
+			OPCODE_CASE(OP_WRITE4, 8, 0):               // DWRITE  dst,src1,space_DWORD
 				m_space[PARAM2]->write_dword(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITE8, 8, 0):    // DWRITE  dst,src1,space_QWORD
+			OPCODE_CASE(OP_WRITE8, 8, 0):               // DWRITE  dst,src1,space_QWORD
 				m_space[PARAM2]->write_qword(PARAM0, DPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM2, 8, 0):   // DWRITEM dst,src1,mask,space_WORD
+			OPCODE_CASE(OP_WRITEM2, 8, 0):              // DWRITEM dst,src1,mask,space_WORD
 				m_space[PARAM3]->write_word(PARAM0, DPARAM1, DPARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM4, 8, 0):   // DWRITEM dst,src1,mask,space_DWORD
+			OPCODE_CASE(OP_WRITEM4, 8, 0):              // DWRITEM dst,src1,mask,space_DWORD
 				m_space[PARAM3]->write_dword(PARAM0, DPARAM1, DPARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_WRITEM8, 8, 0):   // DWRITEM dst,src1,mask,space_QWORD
+			OPCODE_CASE(OP_WRITEM8, 8, 0):              // DWRITEM dst,src1,mask,space_QWORD
 				m_space[PARAM3]->write_qword(PARAM0, DPARAM1, DPARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_CARRY, 8, 0):     // DCARRY  src,bitnum
+			OPCODE_CASE(OP_CARRY, 8, 1):                // DCARRY  src,bitnum
 				flags = (flags & ~FLAG_C) | ((DPARAM0 >> (DPARAM1 & 63)) & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MOV, 8, 1):       // DMOV    dst,src[,c]
+			OPCODE_CASE(OP_MOV, 8, 1):                  // DMOV    dst,src[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				[[fallthrough]];
 
-			case MAKE_OPCODE_SHORT(OP_MOV, 8, 0):
+			OPCODE_CASE(OP_MOV, 8, 0):
 				DPARAM0 = DPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SET, 8, 1):       // DSET    dst,c
+			OPCODE_CASE(OP_SET, 8, 1):                  // DSET    dst,c
 				DPARAM0 = OPCODE_FAIL_CONDITION(opcode, flags) ? 0 : 1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT1, 8, 0):     // DSEXT   dst,src,BYTE
+			OPCODE_CASE(OP_SEXT1, 8, 0):                // DSEXT   dst,src,BYTE
 				DPARAM0 = (int8_t)PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT1, 8, 1):
+			OPCODE_CASE(OP_SEXT1, 8, 1):
 				temp64 = (int8_t)PARAM1;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT2, 8, 0):     // DSEXT   dst,src,WORD
+			OPCODE_CASE(OP_SEXT2, 8, 0):                // DSEXT   dst,src,WORD
 				DPARAM0 = (int16_t)PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT2, 8, 1):
+			OPCODE_CASE(OP_SEXT2, 8, 1):
 				temp64 = (int16_t)PARAM1;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT4, 8, 0):     // DSEXT   dst,src,DWORD
+			OPCODE_CASE(OP_SEXT4, 8, 0):                // DSEXT   dst,src,DWORD
 				DPARAM0 = (int32_t)PARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SEXT4, 8, 1):
+			OPCODE_CASE(OP_SEXT4, 8, 1):
 				temp64 = (int32_t)PARAM1;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLAND, 8, 0):    // DROLAND dst,src,count,mask[,f]
+			OPCODE_CASE(OP_ROLAND, 8, 0):               // DROLAND dst,src,count,mask[,f]
 				DPARAM0 = rotl_64(DPARAM1, DPARAM2) & DPARAM3;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLAND, 8, 1):
+			OPCODE_CASE(OP_ROLAND, 8, 1):
 				temp64 = rotl_64(DPARAM1, DPARAM2) & DPARAM3;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLINS, 8, 0):    // DROLINS dst,src,count,mask[,f]
+			OPCODE_CASE(OP_ROLINS, 8, 0):               // DROLINS dst,src,count,mask[,f]
 				DPARAM0 = (DPARAM0 & ~DPARAM3) | (rotl_64(DPARAM1, DPARAM2) & DPARAM3);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLINS, 8, 1):
+			OPCODE_CASE(OP_ROLINS, 8, 1):
 				temp64 = (DPARAM0 & ~DPARAM3) | (rotl_64(DPARAM1, DPARAM2) & DPARAM3);
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADD, 8, 0):       // DADD    dst,src1,src2[,f]
+			OPCODE_CASE(OP_ADD, 8, 0):                  // DADD    dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 + DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADD, 8, 1):
+			OPCODE_CASE(OP_ADD, 8, 1):
 				temp64 = DPARAM1 + DPARAM2;
 				flags = FLAGS64_NZCV_ADD(temp64, DPARAM1, DPARAM2);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADDC, 8, 0):      // DADDC   dst,src1,src2[,f]
+			OPCODE_CASE(OP_ADDC, 8, 0):                 // DADDC   dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 + DPARAM2 + (flags & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ADDC, 8, 1):
+			OPCODE_CASE(OP_ADDC, 8, 1):
 				temp64 = DPARAM1 + DPARAM2 + (flags & FLAG_C);
-				if (DPARAM2 + 1 != 0)
-					flags = FLAGS64_NZCV_ADD(temp64, DPARAM1, DPARAM2 + (flags & FLAG_C));
-				else
-					flags = FLAGS64_NZCV_ADD(temp64, DPARAM1 + (flags & FLAG_C), DPARAM2);
+				flags = FLAGS64_NZCV_ADDC(temp64, DPARAM1, DPARAM2, flags & FLAG_C);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUB, 8, 0):       // DSUB    dst,src1,src2[,f]
+			OPCODE_CASE(OP_SUB, 8, 0):                  // DSUB    dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 - DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUB, 8, 1):
+			OPCODE_CASE(OP_SUB, 8, 1):
 				temp64 = DPARAM1 - DPARAM2;
 				flags = FLAGS64_NZCV_SUB(temp64, DPARAM1, DPARAM2);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUBB, 8, 0):      // DSUBB   dst,src1,src2[,f]
+			OPCODE_CASE(OP_SUBB, 8, 0):                 // DSUBB   dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 - DPARAM2 - (flags & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SUBB, 8, 1):
+			OPCODE_CASE(OP_SUBB, 8, 1):
 				temp64 = DPARAM1 - DPARAM2 - (flags & FLAG_C);
-				if (DPARAM2 + 1 != 0)
-					flags = FLAGS64_NZCV_SUB(temp64, DPARAM1, DPARAM2 + (flags & FLAG_C));
-				else
-					flags = FLAGS64_NZCV_SUB(temp64, DPARAM1 - (flags & FLAG_C), DPARAM2);
+				flags = FLAGS64_NZCV_SUBB(temp64, DPARAM1, DPARAM2, flags & FLAG_C);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_CMP, 8, 1):       // DCMP    src1,src2[,f]
+			OPCODE_CASE(OP_CMP, 8, 1):                  // DCMP    src1,src2[,f]
 				temp64 = DPARAM0 - DPARAM1;
 				flags = FLAGS64_NZCV_SUB(temp64, DPARAM0, DPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULU, 8, 0):      // DMULU   dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_MULU, 8, 0):                 // DMULU   dst,edst,src1,src2[,f]
 				dmulu(*inst[0].puint64, *inst[1].puint64, DPARAM2, DPARAM3, false);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULU, 8, 1):
+			OPCODE_CASE(OP_MULU, 8, 1):
 				flags = dmulu(*inst[0].puint64, *inst[1].puint64, DPARAM2, DPARAM3, true);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULS, 8, 0):      // DMULS   dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_MULS, 8, 0):                 // DMULS   dst,edst,src1,src2[,f]
 				dmuls(*inst[0].puint64, *inst[1].puint64, DPARAM2, DPARAM3, false);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_MULS, 8, 1):
+			OPCODE_CASE(OP_MULS, 8, 1):
 				flags = dmuls(*inst[0].puint64, *inst[1].puint64, DPARAM2, DPARAM3, true);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVU, 8, 0):      // DDIVU   dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_DIVU, 8, 0):                 // DDIVU   dst,edst,src1,src2[,f]
 				if (DPARAM3 != 0)
 				{
 					temp64 = (uint64_t)DPARAM2 / (uint64_t)DPARAM3;
@@ -1596,7 +1819,7 @@ int drcbe_c::execute(code_handle &entry)
 				}
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVU, 8, 1):
+			OPCODE_CASE(OP_DIVU, 8, 1):
 				if (DPARAM3 != 0)
 				{
 					temp64 = (uint64_t)DPARAM2 / (uint64_t)DPARAM3;
@@ -1608,7 +1831,7 @@ int drcbe_c::execute(code_handle &entry)
 					flags = FLAG_V;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVS, 8, 0):      // DDIVS   dst,edst,src1,src2[,f]
+			OPCODE_CASE(OP_DIVS, 8, 0):                 // DDIVS   dst,edst,src1,src2[,f]
 				if (DPARAM3 != 0)
 				{
 					temp64 = (int64_t)DPARAM2 / (int64_t)DPARAM3;
@@ -1617,7 +1840,7 @@ int drcbe_c::execute(code_handle &entry)
 				}
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_DIVS, 8, 1):
+			OPCODE_CASE(OP_DIVS, 8, 1):
 				if (DPARAM3 != 0)
 				{
 					temp64 = (int64_t)DPARAM2 / (int64_t)DPARAM3;
@@ -1629,77 +1852,77 @@ int drcbe_c::execute(code_handle &entry)
 					flags = FLAG_V;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_AND, 8, 0):       // DAND    dst,src1,src2[,f]
+			OPCODE_CASE(OP_AND, 8, 0):                  // DAND    dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 & DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_AND, 8, 1):
+			OPCODE_CASE(OP_AND, 8, 1):
 				temp64 = DPARAM1 & DPARAM2;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_TEST, 8, 1):      // DTEST   src1,src2[,f]
+			OPCODE_CASE(OP_TEST, 8, 1):                 // DTEST   src1,src2[,f]
 				temp64 = DPARAM0 & DPARAM1;
 				flags = FLAGS64_NZ(temp64);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_OR, 8, 0):        // DOR     dst,src1,src2[,f]
+			OPCODE_CASE(OP_OR, 8, 0):                   // DOR     dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 | DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_OR, 8, 1):
+			OPCODE_CASE(OP_OR, 8, 1):
 				temp64 = DPARAM1 | DPARAM2;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_XOR, 8, 0):       // DXOR    dst,src1,src2[,f]
+			OPCODE_CASE(OP_XOR, 8, 0):                  // DXOR    dst,src1,src2[,f]
 				DPARAM0 = DPARAM1 ^ DPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_XOR, 8, 1):
+			OPCODE_CASE(OP_XOR, 8, 1):
 				temp64 = DPARAM1 ^ DPARAM2;
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LZCNT, 8, 0):     // DLZCNT  dst,src
+			OPCODE_CASE(OP_LZCNT, 8, 0):                // DLZCNT  dst,src
 				DPARAM0 = count_leading_zeros_64(DPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_LZCNT, 8, 1):
+			OPCODE_CASE(OP_LZCNT, 8, 1):
 				temp64 = count_leading_zeros_64(DPARAM1);
 				flags = FLAGS64_NZ(temp64);
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_TZCNT, 8, 0):     // DTZCNT  dst,src
+			OPCODE_CASE(OP_TZCNT, 8, 0):                // DTZCNT  dst,src
 				DPARAM0 = tzcount64(DPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_TZCNT, 8, 1):
+			OPCODE_CASE(OP_TZCNT, 8, 1):
 				temp64 = tzcount64(DPARAM1);
 				flags = (temp64 == 64) ? FLAG_Z : 0;
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_BSWAP, 8, 0):     // DBSWAP  dst,src
+			OPCODE_CASE(OP_BSWAP, 8, 0):                // DBSWAP  dst,src
 				temp64 = DPARAM1;
 				DPARAM0 = swapendian_int64(temp64);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_BSWAP, 8, 1):
-				temp64 = DPARAM1;
+			OPCODE_CASE(OP_BSWAP, 8, 1):
+				temp64 = swapendian_int64(DPARAM1);
 				flags = FLAGS64_NZ(temp64);
-				DPARAM0 = swapendian_int64(temp64);
+				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHL, 8, 0):       // DSHL    dst,src,count[,f]
+			OPCODE_CASE(OP_SHL, 8, 0):                  // DSHL    dst,src,count[,f]
 				DPARAM0 = DPARAM1 << (DPARAM2 & 63);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHL, 8, 1):
+			OPCODE_CASE(OP_SHL, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = DPARAM1 << shift;
 				flags = FLAGS64_NZ(temp64);
@@ -1707,11 +1930,11 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHR, 8, 0):       // DSHR    dst,src,count[,f]
+			OPCODE_CASE(OP_SHR, 8, 0):                  // DSHR    dst,src,count[,f]
 				DPARAM0 = DPARAM1 >> (DPARAM2 & 63);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SHR, 8, 1):
+			OPCODE_CASE(OP_SHR, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = DPARAM1 >> shift;
 				flags = FLAGS64_NZ(temp64);
@@ -1719,23 +1942,23 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SAR, 8, 0):       // DSAR    dst,src,count[,f]
+			OPCODE_CASE(OP_SAR, 8, 0):                  // DSAR    dst,src,count[,f]
 				DPARAM0 = (int64_t)DPARAM1 >> (DPARAM2 & 63);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_SAR, 8, 1):
+			OPCODE_CASE(OP_SAR, 8, 1):
 				shift = DPARAM2 & 63;
-				temp64 = (int32_t)DPARAM1 >> shift;
+				temp64 = (int64_t)DPARAM1 >> shift;
 				flags = FLAGS64_NZ(temp64);
 				if (shift != 0) flags |= (DPARAM1 >> (shift - 1)) & FLAG_C;
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROL, 8, 0):       // DROL    dst,src,count[,f]
+			OPCODE_CASE(OP_ROL, 8, 0):                  // DROL    dst,src,count[,f]
 				DPARAM0 = rotl_64(DPARAM1, DPARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROL, 8, 1):
+			OPCODE_CASE(OP_ROL, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = rotl_64(DPARAM1, shift);
 				flags = FLAGS64_NZ(temp64);
@@ -1743,18 +1966,18 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLC, 8, 0):      // DROLC   dst,src,count[,f]
+			OPCODE_CASE(OP_ROLC, 8, 0):                 // DROLC   dst,src,count[,f]
 				shift = DPARAM2 & 63;
 				if (shift > 1)
-					DPARAM0 = (DPARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
+					DPARAM0 = (DPARAM1 << shift) | (((uint64_t)flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
 				else if (shift == 1)
 					DPARAM0 = (DPARAM1 << shift) | (flags & FLAG_C);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROLC, 8, 1):
+			OPCODE_CASE(OP_ROLC, 8, 1):
 				shift = DPARAM2 & 63;
 				if (shift > 1)
-					temp64 = (DPARAM1 << shift) | ((flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
+					temp64 = (DPARAM1 << shift) | (((uint64_t)flags & FLAG_C) << (shift - 1)) | (DPARAM1 >> (65 - shift));
 				else if (shift == 1)
 					temp64 = (DPARAM1 << shift) | (flags & FLAG_C);
 				else
@@ -1764,11 +1987,11 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROR, 8, 0):       // DROR    dst,src,count[,f]
+			OPCODE_CASE(OP_ROR, 8, 0):                  // DROR    dst,src,count[,f]
 				DPARAM0 = rotr_64(DPARAM1, DPARAM2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ROR, 8, 1):
+			OPCODE_CASE(OP_ROR, 8, 1):
 				shift = DPARAM2 & 63;
 				temp64 = rotr_64(DPARAM1, shift);
 				flags = FLAGS64_NZ(temp64);
@@ -1776,7 +1999,7 @@ int drcbe_c::execute(code_handle &entry)
 				DPARAM0 = temp64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_RORC, 8, 0):      // DRORC   dst,src,count[,f]
+			OPCODE_CASE(OP_RORC, 8, 0):                 // DRORC   dst,src,count[,f]
 				shift = DPARAM2 & 63;
 				if (shift > 1)
 					DPARAM0 = (DPARAM1 >> shift) | ((((uint64_t)flags & FLAG_C) << 63) >> (shift - 1)) | (DPARAM1 << (65 - shift));
@@ -1784,7 +2007,7 @@ int drcbe_c::execute(code_handle &entry)
 					DPARAM0 = (DPARAM1 >> shift) | (((uint64_t)flags & FLAG_C) << 63);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_RORC, 8, 1):
+			OPCODE_CASE(OP_RORC, 8, 1):
 				shift = DPARAM2 & 63;
 				if (shift > 1)
 					temp64 = (DPARAM1 >> shift) | ((((uint64_t)flags & FLAG_C) << 63) >> (shift - 1)) | (DPARAM1 << (65 - shift));
@@ -1800,294 +2023,378 @@ int drcbe_c::execute(code_handle &entry)
 
 			// ----------------------- 32-Bit Floating Point Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_FLOAD, 4, 0):     // FSLOAD  dst,base,index
+			OPCODE_CASE(OP_FLOAD, 4, 0):                // FSLOAD  dst,base,index
 				FSPARAM0 = inst[1].pfloat[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FSTORE, 4, 0):    // FSSTORE dst,base,index
+			OPCODE_CASE(OP_FSTORE, 4, 0):               // FSSTORE dst,base,index
 				inst[0].pfloat[PARAM1] = FSPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FREAD, 4, 0):     // FSREAD  dst,src1,space
+			OPCODE_CASE(OP_FREAD, 4, 0):                // FSREAD  dst,src1,space
 				PARAM0 = m_space[PARAM2]->read_dword(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FWRITE, 4, 0):    // FSWRITE dst,src1,space
+			OPCODE_CASE(OP_FWRITE, 4, 0):               // FSWRITE dst,src1,space
 				m_space[PARAM2]->write_dword(PARAM0, PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FMOV, 4, 1):      // FSMOV   dst,src[,c]
+			OPCODE_CASE(OP_FMOV, 4, 1):                 // FSMOV   dst,src[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				[[fallthrough]];
 
-			case MAKE_OPCODE_SHORT(OP_FMOV, 4, 0):
+			OPCODE_CASE(OP_FMOV, 4, 0):
 				FSPARAM0 = FSPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4T, 4, 0):    // FSTOI4T dst,src1
+			OPCODE_CASE(OP_FTOI4T, 4, 0):               // FSTOI4T dst,src1
 				if (FSPARAM1 >= 0)
 					*inst[0].pint32 = floor(FSPARAM1);
 				else
 					*inst[0].pint32 = ceil(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4R, 4, 0):    // FSTOI4R dst,src1
+			OPCODE_CASE(OP_FTOI4R, 4, 0):               // FSTOI4R dst,src1
 				if (FSPARAM1 >= 0)
 					*inst[0].pint32 = floor(FSPARAM1 + 0.5f);
 				else
 					*inst[0].pint32 = ceil(FSPARAM1 - 0.5f);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4F, 4, 0):    // FSTOI4F dst,src1
+			OPCODE_CASE(OP_FTOI4F, 4, 0):               // FSTOI4F dst,src1
 				*inst[0].pint32 = floor(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4C, 4, 0):    // FSTOI4C dst,src1
+			OPCODE_CASE(OP_FTOI4C, 4, 0):               // FSTOI4C dst,src1
 				*inst[0].pint32 = ceil(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4, 4, 0):     // FSTOI4  dst,src1
+			OPCODE_CASE(OP_FTOI4, 4, 0):                // FSTOI4  dst,src1
 				*inst[0].pint32 = FSPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8T, 4, 0):    // FSTOI8T dst,src1
+			OPCODE_CASE(OP_FTOI8T, 4, 0):               // FSTOI8T dst,src1
 				if (FSPARAM1 >= 0)
 					*inst[0].pint64 = floor(FSPARAM1);
 				else
 					*inst[0].pint64 = ceil(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8R, 4, 0):    // FSTOI8R dst,src1
+			OPCODE_CASE(OP_FTOI8R, 4, 0):               // FSTOI8R dst,src1
 				if (FSPARAM1 >= 0)
 					*inst[0].pint64 = floor(FSPARAM1 + 0.5f);
 				else
 					*inst[0].pint64 = ceil(FSPARAM1 - 0.5f);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8F, 4, 0):    // FSTOI8F dst,src1
+			OPCODE_CASE(OP_FTOI8F, 4, 0):               // FSTOI8F dst,src1
 				*inst[0].pint64 = floor(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8C, 4, 0):    // FSTOI8C dst,src1
+			OPCODE_CASE(OP_FTOI8C, 4, 0):               // FSTOI8C dst,src1
 				*inst[0].pint64 = ceil(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8, 4, 0):     // FSTOI8  dst,src1
+			OPCODE_CASE(OP_FTOI8, 4, 0):                // FSTOI8  dst,src1
 				*inst[0].pint64 = FSPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FFRI4, 4, 0):     // FSFRI4  dst,src1
+			OPCODE_CASE(OP_FFRI4, 4, 0):                // FSFRI4  dst,src1
 				FSPARAM0 = *inst[1].pint32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FFRI8, 4, 0):     // FSFRI8  dst,src1
+			OPCODE_CASE(OP_FFRI8, 4, 0):                // FSFRI8  dst,src1
 				FSPARAM0 = *inst[1].pint64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FFRFD, 4, 0):     // FSFRFD  dst,src1
+			OPCODE_CASE(OP_FFRFD, 4, 0):                // FSFRFD  dst,src1
 				FSPARAM0 = FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FADD, 4, 0):      // FSADD   dst,src1,src2
+			OPCODE_CASE(OP_FADD, 4, 0):                 // FSADD   dst,src1,src2
 				FSPARAM0 = FSPARAM1 + FSPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FSUB, 4, 0):      // FSSUB   dst,src1,src2
+			OPCODE_CASE(OP_FSUB, 4, 0):                 // FSSUB   dst,src1,src2
 				FSPARAM0 = FSPARAM1 - FSPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FCMP, 4, 1):      // FSCMP   src1,src2
+			OPCODE_CASE(OP_FCMP, 4, 1):                 // FSCMP   src1,src2
 				if (std::isnan(FSPARAM0) || std::isnan(FSPARAM1))
 					flags = FLAG_U;
 				else
 					flags = (FSPARAM0 < FSPARAM1) | ((FSPARAM0 == FSPARAM1) << 2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FMUL, 4, 0):      // FSMUL   dst,src1,src2
+			OPCODE_CASE(OP_FMUL, 4, 0):                 // FSMUL   dst,src1,src2
 				FSPARAM0 = FSPARAM1 * FSPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FDIV, 4, 0):      // FSDIV   dst,src1,src2
+			OPCODE_CASE(OP_FDIV, 4, 0):                 // FSDIV   dst,src1,src2
 				FSPARAM0 = FSPARAM1 / FSPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FNEG, 4, 0):      // FSNEG   dst,src1
+			OPCODE_CASE(OP_FNEG, 4, 0):                 // FSNEG   dst,src1
 				FSPARAM0 = -FSPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FABS, 4, 0):      // FSABS   dst,src1
+			OPCODE_CASE(OP_FABS, 4, 0):                 // FSABS   dst,src1
 				FSPARAM0 = fabs(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FSQRT, 4, 0):     // FSSQRT  dst,src1
+			OPCODE_CASE(OP_FSQRT, 4, 0):                // FSSQRT  dst,src1
 				FSPARAM0 = sqrt(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FRECIP, 4, 0):    // FSRECIP dst,src1
+			OPCODE_CASE(OP_FRECIP, 4, 0):               // FSRECIP dst,src1
 				FSPARAM0 = 1.0f / FSPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FRSQRT, 4, 0):    // FSRSQRT dst,src1
+			OPCODE_CASE(OP_FRSQRT, 4, 0):               // FSRSQRT dst,src1
 				FSPARAM0 = 1.0f / sqrtf(FSPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FCOPYI, 4, 0):    // FSCOPYI dst,src
+			OPCODE_CASE(OP_FCOPYI, 4, 0):               // FSCOPYI dst,src
 				FSPARAM0 = u2f(*inst[1].pint32);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ICOPYF, 4, 0):    // ICOPYFS dst,src
+			OPCODE_CASE(OP_ICOPYF, 4, 0):               // ICOPYFS dst,src
 				*inst[0].pint32 = f2u(FSPARAM1);
 				break;
 
 
 			// ----------------------- 64-Bit Floating Point Operations -----------------------
 
-			case MAKE_OPCODE_SHORT(OP_FLOAD, 8, 0):     // FDLOAD  dst,base,index
+			OPCODE_CASE(OP_FLOAD, 8, 0):                // FDLOAD  dst,base,index
 				FDPARAM0 = inst[1].pdouble[PARAM2];
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FSTORE, 8, 0):    // FDSTORE dst,base,index
+			OPCODE_CASE(OP_FSTORE, 8, 0):               // FDSTORE dst,base,index
 				inst[0].pdouble[PARAM1] = FDPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FREAD, 8, 0):     // FDREAD  dst,src1,space
+			OPCODE_CASE(OP_FREAD, 8, 0):                // FDREAD  dst,src1,space
 				DPARAM0 = m_space[PARAM2]->read_qword(PARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FWRITE, 8, 0):    // FDWRITE dst,src1,space
+			OPCODE_CASE(OP_FWRITE, 8, 0):               // FDWRITE dst,src1,space
 				m_space[PARAM2]->write_qword(PARAM0, DPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FMOV, 8, 1):      // FDMOV   dst,src[,c]
+			OPCODE_CASE(OP_FMOV, 8, 1):                 // FDMOV   dst,src[,c]
 				if (OPCODE_FAIL_CONDITION(opcode, flags))
 					break;
 				[[fallthrough]];
 
-			case MAKE_OPCODE_SHORT(OP_FMOV, 8, 0):
+			OPCODE_CASE(OP_FMOV, 8, 0):
 				FDPARAM0 = FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4T, 8, 0):    // FDTOI4T dst,src1
+			OPCODE_CASE(OP_FTOI4T, 8, 0):               // FDTOI4T dst,src1
 				if (FDPARAM1 >= 0)
 					*inst[0].pint32 = floor(FDPARAM1);
 				else
 					*inst[0].pint32 = ceil(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4R, 8, 0):    // FDTOI4R dst,src1
+			OPCODE_CASE(OP_FTOI4R, 8, 0):               // FDTOI4R dst,src1
 				if (FDPARAM1 >= 0)
 					*inst[0].pint32 = floor(FDPARAM1 + 0.5);
 				else
 					*inst[0].pint32 = ceil(FDPARAM1 - 0.5);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4F, 8, 0):    // FDTOI4F dst,src1
+			OPCODE_CASE(OP_FTOI4F, 8, 0):               // FDTOI4F dst,src1
 				*inst[0].pint32 = floor(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4C, 8, 0):    // FDTOI4C dst,src1
+			OPCODE_CASE(OP_FTOI4C, 8, 0):               // FDTOI4C dst,src1
 				*inst[0].pint32 = ceil(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI4, 8, 0):     // FDTOI4  dst,src1
+			OPCODE_CASE(OP_FTOI4, 8, 0):                // FDTOI4  dst,src1
 				*inst[0].pint32 = FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8T, 8, 0):    // FDTOI8T dst,src1
+			OPCODE_CASE(OP_FTOI8T, 8, 0):               // FDTOI8T dst,src1
 				if (FDPARAM1 >= 0)
 					*inst[0].pint64 = floor(FDPARAM1);
 				else
 					*inst[0].pint64 = ceil(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8R, 8, 0):    // FDTOI8R  dst,src1
+			OPCODE_CASE(OP_FTOI8R, 8, 0):               // FDTOI8R  dst,src1
 				if (FDPARAM1 >= 0)
 					*inst[0].pint64 = floor(FDPARAM1 + 0.5);
 				else
 					*inst[0].pint64 = ceil(FDPARAM1 - 0.5);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8F, 8, 0):    // FDTOI8F dst,src1
+			OPCODE_CASE(OP_FTOI8F, 8, 0):               // FDTOI8F dst,src1
 				*inst[0].pint64 = floor(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8C, 8, 0):    // FDTOI8C dst,src1
+			OPCODE_CASE(OP_FTOI8C, 8, 0):               // FDTOI8C dst,src1
 				*inst[0].pint64 = ceil(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FTOI8, 8, 0):     // FDTOI8  dst,src1
+			OPCODE_CASE(OP_FTOI8, 8, 0):                // FDTOI8  dst,src1
 				*inst[0].pint64 = FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FFRI4, 8, 0):     // FDFRI4  dst,src1
+			OPCODE_CASE(OP_FFRI4, 8, 0):                // FDFRI4  dst,src1
 				FDPARAM0 = *inst[1].pint32;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FFRI8, 8, 0):     // FDFRI8  dst,src1
+			OPCODE_CASE(OP_FFRI8, 8, 0):                // FDFRI8  dst,src1
 				FDPARAM0 = *inst[1].pint64;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FFRFS, 8, 0):     // FDFRFS  dst,src1
+			OPCODE_CASE(OP_FFRFS, 8, 0):                // FDFRFS  dst,src1
 				FDPARAM0 = FSPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FRNDS, 8, 0):     // FDRNDS  dst,src1
+			OPCODE_CASE(OP_FRNDS, 8, 0):                // FDRNDS  dst,src1
 				FDPARAM0 = (float)FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FADD, 8, 0):      // FDADD   dst,src1,src2
+			OPCODE_CASE(OP_FADD, 8, 0):                 // FDADD   dst,src1,src2
 				FDPARAM0 = FDPARAM1 + FDPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FSUB, 8, 0):      // FDSUB   dst,src1,src2
+			OPCODE_CASE(OP_FSUB, 8, 0):                 // FDSUB   dst,src1,src2
 				FDPARAM0 = FDPARAM1 - FDPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FCMP, 8, 1):      // FDCMP   src1,src2
+			OPCODE_CASE(OP_FCMP, 8, 1):                 // FDCMP   src1,src2
 				if (std::isnan(FDPARAM0) || std::isnan(FDPARAM1))
 					flags = FLAG_U;
 				else
 					flags = (FDPARAM0 < FDPARAM1) | ((FDPARAM0 == FDPARAM1) << 2);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FMUL, 8, 0):      // FDMUL   dst,src1,src2
+			OPCODE_CASE(OP_FMUL, 8, 0):                 // FDMUL   dst,src1,src2
 				FDPARAM0 = FDPARAM1 * FDPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FDIV, 8, 0):      // FDDIV   dst,src1,src2
+			OPCODE_CASE(OP_FDIV, 8, 0):                 // FDDIV   dst,src1,src2
 				FDPARAM0 = FDPARAM1 / FDPARAM2;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FNEG, 8, 0):      // FDNEG   dst,src1
+			OPCODE_CASE(OP_FNEG, 8, 0):                 // FDNEG   dst,src1
 				FDPARAM0 = -FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FABS, 8, 0):      // FDABS   dst,src1
+			OPCODE_CASE(OP_FABS, 8, 0):                 // FDABS   dst,src1
 				FDPARAM0 = fabs(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FSQRT, 8, 0):     // FDSQRT  dst,src1
+			OPCODE_CASE(OP_FSQRT, 8, 0):                // FDSQRT  dst,src1
 				FDPARAM0 = sqrt(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FRECIP, 8, 0):    // FDRECIP dst,src1
+			OPCODE_CASE(OP_FRECIP, 8, 0):               // FDRECIP dst,src1
 				FDPARAM0 = 1.0 / FDPARAM1;
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FRSQRT, 8, 0):    // FDRSQRT dst,src1
+			OPCODE_CASE(OP_FRSQRT, 8, 0):               // FDRSQRT dst,src1
 				FDPARAM0 = 1.0 / sqrt(FDPARAM1);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_FCOPYI, 8, 0):    // FDCOPYI dst,src
+			OPCODE_CASE(OP_FCOPYI, 8, 0):               // FDCOPYI dst,src
 				FDPARAM0 = u2d(*inst[1].pint64);
 				break;
 
-			case MAKE_OPCODE_SHORT(OP_ICOPYF, 8, 0):    // ICOPYFD dst,src
+			OPCODE_CASE(OP_ICOPYF, 8, 0):               // ICOPYFD dst,src
 				*inst[0].pint64 = d2u(FDPARAM1);
 				break;
 
-			default:
+			// ----------------------- 128-Bit Vector Operations -----------------------
+
+			OPCODE_CASE(OP_VMOV, 4, 0):                 // VMOV    dst,src
+				memmove(inst[0].v, inst[1].v, 16);
+				break;
+
+			OPCODE_CASE(OP_VADD1, 4, 0):                // VADD    dst,src1,src2,byte
+				vector_op<uint8_t>(inst[0].v, inst[1].v, inst[2].v, std::plus<uint8_t>());
+				break;
+
+			OPCODE_CASE(OP_VADD2, 4, 0):                // VADD    dst,src1,src2,word
+				vector_op<uint16_t>(inst[0].v, inst[1].v, inst[2].v, std::plus<uint16_t>());
+				break;
+
+			OPCODE_CASE(OP_VADD4, 4, 0):                // VADD    dst,src1,src2,dword
+				vector_op<uint32_t>(inst[0].v, inst[1].v, inst[2].v, std::plus<uint32_t>());
+				break;
+
+			OPCODE_CASE(OP_VADD8, 4, 0):                // VADD    dst,src1,src2,qword
+				vector_op<uint64_t>(inst[0].v, inst[1].v, inst[2].v, std::plus<uint64_t>());
+				break;
+
+			OPCODE_CASE(OP_VSUB1, 4, 0):                // VSUB    dst,src1,src2,byte
+				vector_op<uint8_t>(inst[0].v, inst[1].v, inst[2].v, std::minus<uint8_t>());
+				break;
+
+			OPCODE_CASE(OP_VSUB2, 4, 0):                // VSUB    dst,src1,src2,word
+				vector_op<uint16_t>(inst[0].v, inst[1].v, inst[2].v, std::minus<uint16_t>());
+				break;
+
+			OPCODE_CASE(OP_VSUB4, 4, 0):                // VSUB    dst,src1,src2,dword
+				vector_op<uint32_t>(inst[0].v, inst[1].v, inst[2].v, std::minus<uint32_t>());
+				break;
+
+			OPCODE_CASE(OP_VSUB8, 4, 0):                // VSUB    dst,src1,src2,qword
+				vector_op<uint64_t>(inst[0].v, inst[1].v, inst[2].v, std::minus<uint64_t>());
+				break;
+
+			OPCODE_CASE(OP_VADDS1, 4, 0):               // VADDS   dst,src1,src2,byte
+				vector_op<int8_t>(inst[0].v, inst[1].v, inst[2].v, [] (int8_t a, int8_t b) { return saturate<int8_t>(a + b); });
+				break;
+
+			OPCODE_CASE(OP_VADDS2, 4, 0):               // VADDS   dst,src1,src2,word
+				vector_op<int16_t>(inst[0].v, inst[1].v, inst[2].v, [] (int16_t a, int16_t b) { return saturate<int16_t>(a + b); });
+				break;
+
+			OPCODE_CASE(OP_VSUBS1, 4, 0):               // VSUBS   dst,src1,src2,byte
+				vector_op<int8_t>(inst[0].v, inst[1].v, inst[2].v, [] (int8_t a, int8_t b) { return saturate<int8_t>(a - b); });
+				break;
+
+			OPCODE_CASE(OP_VSUBS2, 4, 0):               // VSUBS   dst,src1,src2,word
+				vector_op<int16_t>(inst[0].v, inst[1].v, inst[2].v, [] (int16_t a, int16_t b) { return saturate<int16_t>(a - b); });
+				break;
+
+			OPCODE_CASE(OP_VFADD, 4, 0):                // VFADD   dst,src1,src2
+				vector_op<float>(inst[0].v, inst[1].v, inst[2].v, std::plus<float>());
+				break;
+
+			OPCODE_CASE(OP_VFSUB, 4, 0):                // VFSUB   dst,src1,src2
+				vector_op<float>(inst[0].v, inst[1].v, inst[2].v, std::minus<float>());
+				break;
+
+			OPCODE_CASE(OP_VFMUL, 4, 0):                // VFMUL   dst,src1,src2
+				vector_op<float>(inst[0].v, inst[1].v, inst[2].v, std::multiplies<float>());
+				break;
+
+			OPCODE_CASE(OP_VFMIN, 4, 0):                // VFMIN   dst,src1,src2
+				vector_op<float>(inst[0].v, inst[1].v, inst[2].v, [] (float a, float b) { return (a < b) ? a : b; });
+				break;
+
+			OPCODE_CASE(OP_VFMAX, 4, 0):                // VFMAX   dst,src1,src2
+				vector_op<float>(inst[0].v, inst[1].v, inst[2].v, [] (float a, float b) { return (a > b) ? a : b; });
+				break;
+
+			OPCODE_CASE(OP_VSHUF, 4, 0):                // VSHUF   dst,src,lanes
+				{
+					uint32_t src[4], result[4];
+					memcpy(src, inst[1].v, 16);
+					for (int lane = 0; lane < 4; lane++)
+						result[lane] = src[(PARAM2 >> (lane * 2)) & 3];
+					memcpy(inst[0].v, result, 16);
+				}
+				break;
+
+			OPCODE_DEFAULT:
 				fatalerror("Unexpected opcode!\n");
 		}
 
@@ -2143,6 +2450,11 @@ void drcbe_c::output_parameter(drcbec_instruction **dstptr, void **immedptr, int
 				(dst++)->pdouble = &m_state.f[param.freg() - REG_F0].d;
 			break;
 
+		// vector registers point to the whole vector register state
+		case parameter::PTYPE_VECTOR_REGISTER:
+			(dst++)->v = &m_state.v[param.vreg() - REG_V0];
+			break;
+
 		// convert mapvars to immediates
 		case parameter::PTYPE_MAPVAR:
 			temp_param = m_map.get_last_value(param.mapvar());
@@ -188,6 +188,24 @@ bool drc_hash_table::set_codeptr(uint32_t mode, uint32_t pc, drccodeptr code)
 }
 
 
+//-------------------------------------------------
+//  clear_codeptr - point the given mode/pc back
+//  at the missing code handler
+//-------------------------------------------------
+
+void drc_hash_table::clear_codeptr(uint32_t mode, uint32_t pc)
+{
+	// empty tables only ever hold the missing code handler
+	assert(mode < m_modes);
+	uint32_t l1 = (pc >> m_l1shift) & m_l1mask;
+	if ((m_base[mode] == m_emptyl1) || (m_base[mode][l1] == m_emptyl2))
+		return;
+
+	uint32_t l2 = (pc >> m_l2shift) & m_l2mask;
+	m_base[mode][l1][l2] = m_nocodeptr;
+}
+
+
 
 //**************************************************************************
 //  DRC MAP VARIABLES
@@ -207,11 +207,13 @@ const uint32_t PTYPE_M    = 1 << parameter::PTYPE_MEMORY;
 const uint32_t PTYPE_I    = 1 << parameter::PTYPE_IMMEDIATE;
 const uint32_t PTYPE_R    = 1 << parameter::PTYPE_INT_REGISTER;
 const uint32_t PTYPE_F    = 1 << parameter::PTYPE_FLOAT_REGISTER;
+const uint32_t PTYPE_V    = 1 << parameter::PTYPE_VECTOR_REGISTER;
 //const uint32_t PTYPE_MI   = PTYPE_M | PTYPE_I;
 //const uint32_t PTYPE_RI   = PTYPE_R | PTYPE_I;
 const uint32_t PTYPE_MR   = PTYPE_M | PTYPE_R;
 const uint32_t PTYPE_MRI  = PTYPE_M | PTYPE_R | PTYPE_I;
 const uint32_t PTYPE_MF   = PTYPE_M | PTYPE_F;
+const uint32_t PTYPE_MV   = PTYPE_M | PTYPE_V;
 
 #ifdef X64_WINDOWS_ABI
 
@@ -220,6 +222,10 @@ const Gp::Id REG_PARAM2    = Gp::kIdDx;
 const Gp::Id REG_PARAM3    = Gp::kIdR8;
 const Gp::Id REG_PARAM4    = Gp::kIdR9;
 
+// vector temporaries, clear of the float register map
+const Xmm VEC_TEMP1        = xmm0;
+const Xmm VEC_TEMP2        = xmm1;
+
 #else
 
 const Gp::Id REG_PARAM1    = Gp::kIdDi;
@@ -227,6 +233,10 @@ const Gp::Id REG_PARAM2    = Gp::kIdSi;
 const Gp::Id REG_PARAM3    = Gp::kIdDx;
 const Gp::Id REG_PARAM4    = Gp::kIdCx;
 
+// vector temporaries, clear of the float register map
+const Xmm VEC_TEMP1        = xmm0;
+const Xmm VEC_TEMP2        = xmm8;
+
 #endif
 
 
@@ -401,7 +411,20 @@ const drcbe_x64::opcode_table_entry drcbe_x64::s_opcode_table_source[] =
 	{ uml::OP_FRECIP,  &drcbe_x64::op_frecip },     // FRECIP  dst,src1
 	{ uml::OP_FRSQRT,  &drcbe_x64::op_frsqrt },     // FRSQRT  dst,src1
 	{ uml::OP_FCOPYI,  &drcbe_x64::op_fcopyi },     // FCOPYI  dst,src
-	{ uml::OP_ICOPYF,  &drcbe_x64::op_icopyf }      // ICOPYF  dst,src
+	{ uml::OP_ICOPYF,  &drcbe_x64::op_icopyf },     // ICOPYF  dst,src
+
+	// 128-bit vector operations
+	{ uml::OP_VMOV,    &drcbe_x64::op_vmov },       // VMOV    dst,src
+	{ uml::OP_VADD,    &drcbe_x64::op_vadd },       // VADD    dst,src1,src2,size
+	{ uml::OP_VSUB,    &drcbe_x64::op_vsub },       // VSUB    dst,src1,src2,size
+	{ uml::OP_VADDS,   &drcbe_x64::op_vadds },      // VADDS   dst,src1,src2,size
+	{ uml::OP_VSUBS,   &drcbe_x64::op_vsubs },      // VSUBS   dst,src1,src2,size
+	{ uml::OP_VFADD,   &drcbe_x64::op_vfadd },      // VFADD   dst,src1,src2
+	{ uml::OP_VFSUB,   &drcbe_x64::op_vfsub },      // VFSUB   dst,src1,src2
+	{ uml::OP_VFMUL,   &drcbe_x64::op_vfmul },      // VFMUL   dst,src1,src2
+	{ uml::OP_VFMIN,   &drcbe_x64::op_vfmin },      // VFMIN   dst,src1,src2
+	{ uml::OP_VFMAX,   &drcbe_x64::op_vfmax },      // VFMAX   dst,src1,src2
+	{ uml::OP_VSHUF,   &drcbe_x64::op_vshuf }       // VSHUF   dst,src,lanes
 };
 
 class ThrowableErrorHandler : public ErrorHandler
@@ -463,6 +486,13 @@ drcbe_x64::be_parameter::be_parameter(drcbe_x64 &drcbe, const parameter &param,
 				*this = make_memory(&drcbe.m_state.f[param.freg() - REG_F0]);
 			break;
 
+		// vector registers always live in memory
+		case parameter::PTYPE_VECTOR_REGISTER:
+			assert(allowed & PTYPE_V);
+			assert(allowed & PTYPE_M);
+			*this = make_memory(&drcbe.m_state.v[param.vreg() - REG_V0]);
+			break;
+
 		// everything else is unexpected
 		default:
 			fatalerror("Unexpected parameter type\n");
@@ -622,8 +652,10 @@ drcbe_x64::drcbe_x64(drcuml_state &drcuml, device_t &device, drc_cache &cache, u
 	, m_map(cache, 0xaaaaaaaa5555)
 	, m_log(nullptr)
 	, m_log_asmjit(nullptr)
-	, m_absmask32((uint32_t *)cache.alloc_near(16*2 + 15))
+	, m_absmask32((uint32_t *)cache.alloc_near(16*4 + 15))
 	, m_absmask64(nullptr)
+	, m_signmask32(nullptr)
+	, m_signmask64(nullptr)
 	, m_rbpvalue(cache.near() + 0x80)
 	, m_entry(nullptr)
 	, m_exit(nullptr)
@@ -642,11 +674,15 @@ drcbe_x64::drcbe_x64(drcuml_state &drcuml, device_t &device, drc_cache &cache, u
 	m_near.single1 = 1.0f;
 	m_near.double1 = 1.0;
 
-	// create absolute value masks that are aligned to SSE boundaries
+	// create absolute value and sign masks that are aligned to SSE boundaries
 	m_absmask32 = (uint32_t *)(((uintptr_t)m_absmask32 + 15) & ~15);
 	m_absmask32[0] = m_absmask32[1] = m_absmask32[2] = m_absmask32[3] = 0x7fffffff;
 	m_absmask64 = (uint64_t *)&m_absmask32[4];
 	m_absmask64[0] = m_absmask64[1] = 0x7fffffffffffffffU;
+	m_signmask32 = &m_absmask32[8];
+	m_signmask32[0] = m_signmask32[1] = m_signmask32[2] = m_signmask32[3] = 0x80000000;
+	m_signmask64 = (uint64_t *)&m_absmask32[12];
+	m_signmask64[0] = m_signmask64[1] = 0x8000000000000000U;
 
 	// get pointers to C functions we need to call
 	using debugger_hook_func = void (*)(device_debug *, offs_t);
@@ -912,9 +948,10 @@ void drcbe_x64::reset()
 		x86log_disasm_code_range(m_log, "nocode_point", m_nocode, dst + bytes);
 	}
 
-	// reset our hash tables
+	// reset our hash tables, which takes all chained blocks with it
 	m_hash.reset();
 	m_hash.set_default_codeptr(m_nocode);
+	m_chains.clear();
 }
 
 
@@ -940,6 +977,7 @@ void drcbe_x64::generate(drcuml_block &block, const instruction *instlist, uint3
 	// tell all of our utility objects that a block is beginning
 	m_hash.block_begin(block, instlist, numinst);
 	m_map.block_begin(block);
+	m_pending_chains.clear();
 
 	// compute the base by aligning the cache top to a cache line (assumed to be 64 bytes)
 	x86code *dst = (x86code *)(uint64_t(m_cache.top() + 63) & ~63);
@@ -1002,12 +1040,34 @@ void drcbe_x64::generate(drcuml_block &block, const instruction *instlist, uint3
 	if (m_log != nullptr)
 		x86log_disasm_code_range(m_log, (blockname.empty()) ? "Unknown block" : blockname.c_str(), dst, dst + bytes);
 
+	// now the code is in place, point direct calls at their current targets and remember them for later
+	for (auto const &chain : m_pending_chains)
+	{
+		chain_patch(chain.second, m_hash.get_codeptr(uint32_t(chain.first >> 32), uint32_t(chain.first)));
+		m_chains[chain.first].push_back(chain.second);
+	}
+	m_pending_chains.clear();
+
 	// tell all of our utility objects that the block is finished
 	m_hash.block_end(block);
 	m_map.block_end(block);
 }
 
 
+//-------------------------------------------------
+//  chain_patch - point a direct call (given by
+//  its return address) at a new target
+//-------------------------------------------------
+
+void drcbe_x64::chain_patch(x86code *site, drccodeptr target)
+{
+	int64_t const disp = target - site;
+	assert(int32_t(disp) == disp);
+	int32_t const rel32 = int32_t(disp);
+	memcpy(site - 4, &rel32, 4);
+}
+
+
 //-------------------------------------------------
 //  hash_exists - return true if the given mode/pc
 //  exists in the hash table
@@ -1019,6 +1079,46 @@ bool drcbe_x64::hash_exists(uint32_t mode, uint32_t pc)
 }
 
 
+//-------------------------------------------------
+//  hash_invalidate - stop the given mode/pc from
+//  reaching the code compiled for it
+//-------------------------------------------------
+
+void drcbe_x64::hash_invalidate(uint32_t mode, uint32_t pc)
+{
+	if (!m_hash.code_exists(mode, pc))
+		return;
+	m_hash.clear_codeptr(mode, pc);
+
+	// blocks chained to it go back through the missing code handler
+	auto const chains = m_chains.find(chain_key(mode, pc));
+	if (chains != m_chains.end())
+	{
+		for (x86code *site : chains->second)
+			chain_patch(site, m_nocode);
+	}
+}
+
+
+//-------------------------------------------------
+//  code_released - forget direct calls made from
+//  code that's about to be reused
+//-------------------------------------------------
+
+void drcbe_x64::code_released(drccodeptr base, uint32_t bytes)
+{
+	for (auto chains = m_chains.begin(); chains != m_chains.end(); )
+	{
+		std::vector<x86code *> &sites = chains->second;
+		sites.erase(std::remove_if(sites.begin(), sites.end(), [base, bytes] (x86code *site) { return (site > base) && (site <= (base + bytes)); }), sites.end());
+		if (sites.empty())
+			chains = m_chains.erase(chains);
+		else
+			++chains;
+	}
+}
+
+
 //-------------------------------------------------
 //  get_info - return information about the
 //  back-end implementation
@@ -1325,7 +1425,18 @@ void drcbe_x64::op_hash(Assembler &a, const instruction &inst)
 	assert(inst.param(1).is_immediate());
 
 	// register the current pointer for the mode/PC
-	m_hash.set_codeptr(inst.param(0).immediate(), inst.param(1).immediate(), drccodeptr(a.code()->baseAddress() + a.offset()));
+	uint32_t const mode = inst.param(0).immediate();
+	uint32_t const pc = inst.param(1).immediate();
+	drccodeptr const code = drccodeptr(a.code()->baseAddress() + a.offset());
+	m_hash.set_codeptr(mode, pc, code);
+
+	// re-point any blocks already chained to this mode/PC
+	auto const chains = m_chains.find(chain_key(mode, pc));
+	if (chains != m_chains.end())
+	{
+		for (x86code *site : chains->second)
+			chain_patch(site, code);
+	}
 }
 
 
@@ -1479,8 +1590,19 @@ void drcbe_x64::op_hashjmp(Assembler &a, const instruction &inst)
 	// load the stack base one word early so we end up at the right spot after our call below
 	a.mov(rsp, MABS(&m_near.hashstacksave));                                            // mov   rsp,[hashstacksave]
 
+	// a fixed mode and PC is chained with a direct call, which goes to the nocode handler until the target
+	// is compiled; it's pointed at the real target once the block is emitted, and again whenever that changes
+	x86code *const site = (x86code *)(a.code()->baseAddress() + a.offset() + 5);
+	drccodeptr const target = (modep.is_immediate() && pcp.is_immediate()) ? m_hash.get_codeptr(modep.immediate(), pcp.immediate()) : nullptr;
+	if (target && (int32_t(target - site) == (target - site)))
+	{
+		a.embedUInt8(0xe8);                                                             // call  target
+		a.embedInt32(int32_t(target - site));
+		m_pending_chains.emplace_back(chain_key(modep.immediate(), pcp.immediate()), site);
+	}
+
 	// fixed mode cases
-	if (modep.is_immediate() && m_hash.is_mode_populated(modep.immediate()))
+	else if (modep.is_immediate() && m_hash.is_mode_populated(modep.immediate()))
 	{
 		// a straight immediate jump is direct, though we need the PC in EAX in case of failure
 		if (pcp.is_immediate())
@@ -1995,6 +2117,14 @@ void drcbe_x64::op_save(Assembler &a, const instruction &inst)
 			a.mov(ptr(rcx, regoffs + 8 * regnum), rax);
 		}
 	}
+
+	// copy vector registers
+	regoffs = offsetof(drcuml_machine_state, v);
+	for (int regnum = 0; regnum < std::size(m_state.v); regnum++)
+	{
+		a.movups(VEC_TEMP1, MABS(&m_state.v[regnum]));
+		a.movups(ptr(rcx, regoffs + 16 * regnum), VEC_TEMP1);
+	}
 }
 
 
@@ -2040,6 +2170,14 @@ void drcbe_x64::op_restore(Assembler &a, const instruction &inst)
 		}
 	}
 
+	// copy vector registers
+	regoffs = offsetof(drcuml_machine_state, v);
+	for (int regnum = 0; regnum < std::size(m_state.v); regnum++)
+	{
+		a.movups(VEC_TEMP1, ptr(rcx, regoffs + 16 * regnum));
+		a.movups(MABS(&m_state.v[regnum]), VEC_TEMP1);
+	}
+
 	Mem fmod = MABS(&m_state.fmod);
 	fmod.setSize(1);
 
@@ -4062,12 +4200,16 @@ template <Inst::Id Opcode> void drcbe_x64::op_shift(Assembler &a, const uml::ins
 	be_parameter src2p(*this, inst.param(2), PTYPE_MRI);
 
 	const bool carry = (Opcode == Inst::kIdRcl) || (Opcode == Inst::kIdRcr);
+	const bool rotate = carry || (Opcode == Inst::kIdRol) || (Opcode == Inst::kIdRor);
+
+	// x86 rotates don't touch SF or ZF, so they have to be computed from the result
+	const bool zsflags = rotate && (inst.flags() & (FLAG_Z | FLAG_S));
 
 	// optimize immediate zero case
 	if (carry || inst.flags() || !src2p.is_immediate_value(0))
 	{
 		// dstp == src1p in memory
-		if (dstp.is_memory() && dstp == src1p)
+		if (dstp.is_memory() && dstp == src1p && !zsflags)
 			shift_op_param(a, Opcode, MABS(dstp.memory(), inst.size()), src2p);         // op   [dstp],src2p
 
 		// general case
@@ -4082,6 +4224,22 @@ template <Inst::Id Opcode> void drcbe_x64::op_shift(Assembler &a, const uml::ins
 				mov_reg_param(a, dstreg, src1p);                                        // mov   dstreg,src1p
 			shift_op_param(a, Opcode, dstreg, src2p);                                   // op    dstreg,src2p
 			mov_param_reg(a, dstp, dstreg);                                             // mov   dstp,dstreg
+
+			if (zsflags)
+			{
+				// keep the carry from the rotate and merge in SF and ZF
+				if (inst.flags() & FLAG_C)
+					a.pushfq();                                                         // pushf
+				a.test(dstreg, dstreg);                                                 // test  dstreg,dstreg
+				if (inst.flags() & FLAG_C)
+				{
+					a.pushfq();                                                         // pushf
+					a.pop(rax);                                                         // pop   rax
+					a.and_(qword_ptr(rsp), ~0xc4);                                      // and   [rsp],~0xc4
+					a.or_(ptr(rsp), rax);                                               // or    [rsp],rax
+					a.popfq();                                                          // popf
+				}
+			}
 		}
 	}
 }
@@ -4806,22 +4964,16 @@ void drcbe_x64::op_fneg(Assembler &a, const instruction &inst)
 	// 32-bit form
 	if (inst.size() == 4)
 	{
-		a.xorps(dstreg, dstreg);                                                        // xorps dstreg,dstreg
-		if (srcp.is_memory())
-			a.subss(dstreg, MABS(srcp.memory()));                                       // subss dstreg,[srcp]
-		else if (srcp.is_float_register())
-			a.subss(dstreg, Xmm(srcp.freg()));                                          // subss dstreg,srcp
+		movss_r128_p32(a, dstreg, srcp);                                                // movss dstreg,srcp
+		a.xorps(dstreg, MABS(m_signmask32));                                            // xorps dstreg,[signmask32]
 		movss_p32_r128(a, dstp, dstreg);                                                // movss dstp,dstreg
 	}
 
 	// 64-bit form
 	else if (inst.size() == 8)
 	{
-		a.xorpd(dstreg, dstreg);                                                        // xorpd dstreg,dstreg
-		if (srcp.is_memory())
-			a.subsd(dstreg, MABS(srcp.memory()));                                       // subsd dstreg,[srcp]
-		else if (srcp.is_float_register())
-			a.subsd(dstreg, Xmm(srcp.freg()));                                          // subsd dstreg,srcp
+		movsd_r128_p64(a, dstreg, srcp);                                                // movsd dstreg,srcp
+		a.xorpd(dstreg, MABS(m_signmask64));                                            // xorpd dstreg,[signmask64]
 		movsd_p64_r128(a, dstp, dstreg);                                                // movsd dstp,dstreg
 	}
 }
@@ -5161,4 +5313,175 @@ void drcbe_x64::op_icopyf(Assembler &a, const instruction &inst)
 	}
 }
 
+
+
+
+/***************************************************************************
+    VECTOR OPERATIONS
+***************************************************************************/
+
+//-------------------------------------------------
+//  vector_op - generate a lane-wise operation on
+//  two vectors; all operands are in memory, and
+//  unaligned loads and stores are used so front
+//  ends can point at their own state
+//-------------------------------------------------
+
+void drcbe_x64::vector_op(Assembler &a, const instruction &inst, Inst::Id const opcode)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MV);
+	be_parameter src1p(*this, inst.param(1), PTYPE_MV);
+	be_parameter src2p(*this, inst.param(2), PTYPE_MV);
+
+	a.movups(VEC_TEMP1, MABS(src1p.memory()));                                          // movups vtemp1,[src1p]
+	a.movups(VEC_TEMP2, MABS(src2p.memory()));                                          // movups vtemp2,[src2p]
+	a.emit(opcode, VEC_TEMP1, VEC_TEMP2);                                               // op     vtemp1,vtemp2
+	a.movups(MABS(dstp.memory()), VEC_TEMP1);                                           // movups [dstp],vtemp1
+}
+
+
+//-------------------------------------------------
+//  op_vmov - process a VMOV opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vmov(Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MV);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MV);
+
+	if (dstp.memory() != srcp.memory())
+	{
+		a.movups(VEC_TEMP1, MABS(srcp.memory()));                                       // movups vtemp1,[srcp]
+		a.movups(MABS(dstp.memory()), VEC_TEMP1);                                       // movups [dstp],vtemp1
+	}
+}
+
+
+//-------------------------------------------------
+//  op_vadd - process a VADD opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vadd(Assembler &a, const instruction &inst)
+{
+	static const Inst::Id s_opcodes[] = { Inst::kIdPaddb, Inst::kIdPaddw, Inst::kIdPaddd, Inst::kIdPaddq };
+	vector_op(a, inst, s_opcodes[inst.param(3).size()]);
+}
+
+
+//-------------------------------------------------
+//  op_vsub - process a VSUB opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vsub(Assembler &a, const instruction &inst)
+{
+	static const Inst::Id s_opcodes[] = { Inst::kIdPsubb, Inst::kIdPsubw, Inst::kIdPsubd, Inst::kIdPsubq };
+	vector_op(a, inst, s_opcodes[inst.param(3).size()]);
+}
+
+
+//-------------------------------------------------
+//  op_vadds - process a VADDS opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vadds(Assembler &a, const instruction &inst)
+{
+	assert(inst.param(3).size() <= SIZE_WORD);
+	vector_op(a, inst, (inst.param(3).size() == SIZE_BYTE) ? Inst::kIdPaddsb : Inst::kIdPaddsw);
+}
+
+
+//-------------------------------------------------
+//  op_vsubs - process a VSUBS opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vsubs(Assembler &a, const instruction &inst)
+{
+	assert(inst.param(3).size() <= SIZE_WORD);
+	vector_op(a, inst, (inst.param(3).size() == SIZE_BYTE) ? Inst::kIdPsubsb : Inst::kIdPsubsw);
+}
+
+
+//-------------------------------------------------
+//  op_vfadd - process a VFADD opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vfadd(Assembler &a, const instruction &inst)
+{
+	vector_op(a, inst, Inst::kIdAddps);
+}
+
+
+//-------------------------------------------------
+//  op_vfsub - process a VFSUB opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vfsub(Assembler &a, const instruction &inst)
+{
+	vector_op(a, inst, Inst::kIdSubps);
+}
+
+
+//-------------------------------------------------
+//  op_vfmul - process a VFMUL opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vfmul(Assembler &a, const instruction &inst)
+{
+	vector_op(a, inst, Inst::kIdMulps);
+}
+
+
+//-------------------------------------------------
+//  op_vfmin - process a VFMIN opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vfmin(Assembler &a, const instruction &inst)
+{
+	vector_op(a, inst, Inst::kIdMinps);
+}
+
+
+//-------------------------------------------------
+//  op_vfmax - process a VFMAX opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vfmax(Assembler &a, const instruction &inst)
+{
+	vector_op(a, inst, Inst::kIdMaxps);
+}
+
+
+//-------------------------------------------------
+//  op_vshuf - process a VSHUF opcode
+//-------------------------------------------------
+
+void drcbe_x64::op_vshuf(Assembler &a, const instruction &inst)
+{
+	// validate instruction
+	assert(inst.size() == 4);
+	assert_no_condition(inst);
+	assert_no_flags(inst);
+
+	// normalize parameters
+	be_parameter dstp(*this, inst.param(0), PTYPE_MV);
+	be_parameter srcp(*this, inst.param(1), PTYPE_MV);
+	be_parameter lanesp(*this, inst.param(2), PTYPE_I);
+
+	a.movups(VEC_TEMP1, MABS(srcp.memory()));                                           // movups vtemp1,[srcp]
+	a.pshufd(VEC_TEMP1, VEC_TEMP1, lanesp.immediate() & 0xff);                          // pshufd vtemp1,vtemp1,lanesp
+	a.movups(MABS(dstp.memory()), VEC_TEMP1);                                           // movups [dstp],vtemp1
+}
+
 } // namespace drc
@@ -18,6 +18,7 @@
 
 #include "asmjit/src/asmjit/asmjit.h"
 
+#include <unordered_map>
 #include <vector>
 
 
@@ -41,6 +42,8 @@ public:
 	virtual int execute(uml::code_handle &entry) override;
 	virtual void generate(drcuml_block &block, const uml::instruction *instlist, uint32_t numinst) override;
 	virtual bool hash_exists(uint32_t mode, uint32_t pc) override;
+	virtual void hash_invalidate(uint32_t mode, uint32_t pc) override;
+	virtual void code_released(drccodeptr base, uint32_t bytes) override;
 	virtual void get_info(drcbe_info &info) override;
 	virtual bool logging() const override { return m_log != nullptr; }
 
@@ -205,6 +208,18 @@ private:
 	void op_fcopyi(asmjit::x86::Assembler &a, const uml::instruction &inst);
 	void op_icopyf(asmjit::x86::Assembler &a, const uml::instruction &inst);
 
+	void op_vmov(asmjit::x86::Assembler &a, const uml::instruction &inst);
+	void op_vadd(asmjit::x86::Assembler &a, const uml::instruction &inst);
+	void op_vsub(asmjit::x86::Assembler &a, const uml::instruction &inst);
+	void op_vadds(asmjit::x86::Assembler &a, const uml::instruction &inst);
+	void op_vsubs(asmjit::x86::Assembler &a, const uml::instruction &inst);
+	void op_vfadd(asmjit::x86::Assembler &a, const uml::instruction &inst);
+	void op_vfsub(asmjit::x86::Assembler &a, const uml::instruction &inst);
+	void op_vfmul(asmjit::x86::Assembler &a, const uml::instruction &inst);
+	void op_vfmin(asmjit::x86::Assembler &a, const uml::instruction &inst);
+	void op_vfmax(asmjit::x86::Assembler &a, const uml::instruction &inst);
+	void op_vshuf(asmjit::x86::Assembler &a, const uml::instruction &inst);
+
 	// alu and shift operation helpers
 	static bool ones(u64 const value, unsigned const size) noexcept { return (size == 4) ? u32(value) == 0xffffffffU : value == 0xffffffff'ffffffffULL; }
 	void alu_op_param(asmjit::x86::Assembler &a, asmjit::x86::Inst::Id const opcode, asmjit::Operand const &dst, be_parameter const &param, std::function<bool(asmjit::x86::Assembler &a, asmjit::Operand const &dst, be_parameter const &src)> optimize = [](asmjit::x86::Assembler &a, asmjit::Operand dst, be_parameter const &src) { return false; });
@@ -219,6 +234,9 @@ private:
 	void movsx_r64_p32(asmjit::x86::Assembler &a, asmjit::x86::Gp const &reg, be_parameter const &param);
 	void mov_r64_imm(asmjit::x86::Assembler &a, asmjit::x86::Gp const &reg, uint64_t const imm);
 
+	// vector helpers
+	void vector_op(asmjit::x86::Assembler &a, const uml::instruction &inst, asmjit::x86::Inst::Id const opcode);
+
 	// floating-point helpers
 	void movss_r128_p32(asmjit::x86::Assembler &a, asmjit::x86::Xmm const &reg, be_parameter const &param);
 	void movss_p32_r128(asmjit::x86::Assembler &a, be_parameter const &param, asmjit::x86::Xmm const &reg);
@@ -227,6 +245,10 @@ private:
 
 	size_t emit(asmjit::CodeHolder &ch);
 
+	// direct block chaining helpers
+	static uint64_t chain_key(uint32_t mode, uint32_t pc) { return (uint64_t(mode) << 32) | pc; }
+	static void chain_patch(x86code *site, drccodeptr target);
+
 	// internal state
 	drc_hash_table          m_hash;                 // hash table state
 	drc_map_variables       m_map;                  // code map
@@ -235,12 +257,17 @@ private:
 
 	uint32_t *              m_absmask32;            // absolute value mask (32-bit)
 	uint64_t *              m_absmask64;            // absolute value mask (32-bit)
+	uint32_t *              m_signmask32;           // sign bit mask (32-bit)
+	uint64_t *              m_signmask64;           // sign bit mask (64-bit)
 	uint8_t *               m_rbpvalue;             // value of RBP
 
 	x86_entry_point_func    m_entry;                // entry point
 	x86code *               m_exit;                 // exit point
 	x86code *               m_nocode;               // nocode handler
 
+	std::unordered_map<uint64_t, std::vector<x86code *> > m_chains;         // direct calls to each mode/PC, by return address
+	std::vector<std::pair<uint64_t, x86code *> > m_pending_chains;         // direct calls in the block being generated
+
 	// state to live in the near cache
 	struct near_state
 	{
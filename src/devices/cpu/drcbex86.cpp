@@ -895,6 +895,17 @@ bool drcbe_x86::hash_exists(uint32_t mode, uint32_t pc)
 }
 
 
+//-------------------------------------------------
+//  hash_invalidate - stop the given mode/pc from
+//  reaching the code compiled for it
+//-------------------------------------------------
+
+void drcbe_x86::hash_invalidate(uint32_t mode, uint32_t pc)
+{
+	m_hash.clear_codeptr(mode, pc);
+}
+
+
 //-------------------------------------------------
 //  drcbex86_get_info - return information about
 //  the back-end implementation
@@ -49,7 +49,15 @@ drc_cache::drc_cache(size_t bytes) :
 	m_codegen(nullptr),
 	m_size(m_cache.size()),
 	m_executable(false),
-	m_rwx(false)
+	m_rwx(false),
+	m_block(false),
+	m_block_split(false),
+	m_block_start(nullptr),
+	m_block_end(nullptr),
+	m_reuse_base(nullptr),
+	m_reuse_top(nullptr),
+	m_reuse_limit(nullptr),
+	m_reuse_failed(false)
 {
 	// alignment and page size must be powers of two, cache must be page-aligned
 	assert(!(CACHE_ALIGNMENT & (CACHE_ALIGNMENT - 1)));
@@ -78,6 +86,11 @@ drc_cache::drc_cache(size_t bytes) :
 		osd_printf_verbose("drc_cache: Using W^X mode\n");
 		m_rwx = false;
 	}
+
+	// block dispatch jumps all over the cache, so huge pages save a lot of TLB misses;
+	// W^X mode changes protection a page at a time, which would only split them again
+	if (m_rwx && m_cache.advise_large_pages(0, m_size))
+		osd_printf_verbose("drc_cache: Using huge pages\n");
 }
 
 
@@ -99,9 +112,11 @@ void drc_cache::flush()
 {
 	// can't flush in the middle of codegen
 	assert(!m_codegen);
+	assert(!m_block);
 
 	// just reset the top back to the base and re-seed
 	m_top = m_base;
+	m_code_free.clear();
 	codegen_init();
 }
 
@@ -215,6 +230,44 @@ void drc_cache::dealloc(void *memory, size_t bytes)
 }
 
 
+//-------------------------------------------------
+//  dealloc_code - release the code generated for
+//  a block that can no longer be reached
+//-------------------------------------------------
+
+void drc_cache::dealloc_code(drccodeptr base, size_t bytes)
+{
+	assert(!m_codegen);
+	assert((base >= m_base) && ((base + bytes) <= m_top));
+	if (!bytes)
+		return;
+
+	// merge with the free extents on either side
+	auto next = m_code_free.lower_bound(base);
+	if ((next != m_code_free.end()) && (next->first == (base + bytes)))
+	{
+		bytes += next->second;
+		next = m_code_free.erase(next);
+	}
+	if (next != m_code_free.begin())
+	{
+		auto const prev = std::prev(next);
+		if ((prev->first + prev->second) == base)
+		{
+			base = prev->first;
+			bytes += prev->second;
+			m_code_free.erase(prev);
+		}
+	}
+
+	// space at the top of the cache just goes back to the bump allocator
+	if ((base + bytes) == m_top)
+		m_top = base;
+	else
+		m_code_free.emplace(base, bytes);
+}
+
+
 void drc_cache::codegen_init()
 {
 	if (m_executable)
@@ -248,13 +301,26 @@ drccodeptr *drc_cache::begin_codegen(uint32_t reserve_bytes)
 	assert(m_oob_list.empty());
 
 	// if no space, we just fail
-	if ((m_top + reserve_bytes) > m_limit)
+	drccodeptr &top = m_reuse_base ? m_reuse_top : m_top;
+	if ((top + reserve_bytes) > (m_reuse_base ? m_reuse_limit : m_limit))
+	{
+		m_reuse_failed = m_reuse_base != nullptr;
 		return nullptr;
+	}
+
+	// a block's code can only be released as a unit if nothing was allocated in between
+	if (m_block)
+	{
+		if (!m_block_start)
+			m_block_start = top;
+		else if (top != m_block_end)
+			m_block_split = true;
+	}
 
 	// otherwise, return a pointer to the cache top
 	codegen_init();
-	m_codegen = m_top;
-	return &m_top;
+	m_codegen = top;
+	return &top;
 }
 
 
@@ -265,22 +331,26 @@ drccodeptr *drc_cache::begin_codegen(uint32_t reserve_bytes)
 drccodeptr drc_cache::end_codegen()
 {
 	drccodeptr const result = m_codegen;
+	drccodeptr &top = m_reuse_base ? m_reuse_top : m_top;
 
 	// run the OOB handlers
 	while (!m_oob_list.empty())
 	{
 		// call the callback
-		m_oob_list.front().m_callback(&m_top, m_oob_list.front().m_param1, m_oob_list.front().m_param2);
-		assert((m_top - m_codegen) < CODEGEN_MAX_BYTES);
+		m_oob_list.front().m_callback(&top, m_oob_list.front().m_param1, m_oob_list.front().m_param2);
+		assert((top - m_codegen) < CODEGEN_MAX_BYTES);
 
 		// add it to the free list
 		m_oob_free.splice(m_oob_free.begin(), m_oob_list, m_oob_list.begin());
 	}
 
 	// update the cache top
-	osd::invalidate_instruction_cache(m_codegen, m_top - m_codegen);
-	m_top = ALIGN_PTR_UP(m_top, CACHE_ALIGNMENT);
+	osd::invalidate_instruction_cache(m_codegen, top - m_codegen);
+	top = ALIGN_PTR_UP(top, CACHE_ALIGNMENT);
+	assert(!m_reuse_base || (top <= m_reuse_limit));
 	m_codegen = nullptr;
+	if (m_block)
+		m_block_end = top;
 
 	return result;
 }
@@ -312,3 +382,64 @@ void drc_cache::request_oob_codegen(drc_oob_delegate &&callback, void *param1, v
 	oob->m_param1 = param1;
 	oob->m_param2 = param2;
 }
+
+
+//-------------------------------------------------
+//  begin_block - start generating a block whose
+//  code may be released later, refilling a free
+//  extent of at least the given size if there is
+//  one
+//-------------------------------------------------
+
+void drc_cache::begin_block(size_t reuse_bytes)
+{
+	assert(!m_codegen);
+	assert(!m_block);
+
+	m_block = true;
+	m_block_split = false;
+	m_block_start = nullptr;
+	m_block_end = nullptr;
+	m_reuse_failed = false;
+
+	// first fit is good enough, since freed blocks tend to be similar sizes
+	if (reuse_bytes)
+	{
+		auto const found = std::find_if(m_code_free.begin(), m_code_free.end(), [reuse_bytes] (auto const &extent) { return extent.second >= reuse_bytes; });
+		if (found != m_code_free.end())
+		{
+			m_reuse_base = m_reuse_top = found->first;
+			m_reuse_limit = found->first + found->second;
+			m_code_free.erase(found);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  end_block - finish generating a block, and
+//  return whether its code is a single extent
+//  that can be released
+//-------------------------------------------------
+
+bool drc_cache::end_block(drccodeptr &base, size_t &bytes)
+{
+	assert(!m_codegen);
+	assert(m_block);
+	m_block = false;
+
+	// hand back the part of a free extent that wasn't needed
+	if (m_reuse_base)
+	{
+		drccodeptr const limit = m_reuse_limit;
+		base = m_reuse_base;
+		bytes = m_reuse_top - m_reuse_base;
+		m_reuse_base = m_reuse_top = m_reuse_limit = nullptr;
+		dealloc_code(base + bytes, limit - (base + bytes));
+		return true;
+	}
+
+	base = m_block_start;
+	bytes = m_block_end - m_block_start;
+	return m_block_start && !m_block_split;
+}
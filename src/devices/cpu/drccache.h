@@ -14,6 +14,8 @@
 
 #include "modules/lib/osdlib.h"
 
+#include <map>
+
 
 //**************************************************************************
 //  MACROS
@@ -48,7 +50,7 @@ public:
 	// getters
 	drccodeptr near() const { return m_near; }
 	drccodeptr base() const { return m_base; }
-	drccodeptr top() const { return m_top; }
+	drccodeptr top() const { return m_reuse_base ? m_reuse_top : m_top; }
 
 	// pointer checking
 	bool contains_pointer(const void *ptr) const { return ((const drccodeptr)ptr >= m_near && (const drccodeptr)ptr < m_near + m_size); }
@@ -61,6 +63,7 @@ public:
 	void *alloc_near(size_t bytes);
 	void *alloc_temporary(size_t bytes);
 	void dealloc(void *memory, size_t bytes);
+	void dealloc_code(drccodeptr base, size_t bytes);
 
 	// codegen helpers
 	void codegen_init();
@@ -69,6 +72,11 @@ public:
 	drccodeptr end_codegen();
 	void request_oob_codegen(drc_oob_delegate &&callback, void *param1 = nullptr, void *param2 = nullptr);
 
+	// reclaimable block helpers
+	void begin_block(size_t reuse_bytes);
+	bool end_block(drccodeptr &base, size_t &bytes);
+	bool reuse_failed() const { return m_reuse_failed; }
+
 private:
 	// largest block of code that can be generated at once
 	static constexpr size_t CODEGEN_MAX_BYTES = 131072;
@@ -96,6 +104,17 @@ private:
 	bool                m_executable;       // whether cached code is currently executable
 	bool                m_rwx;              // whether pages can be simultaneously writable and executable
 
+	// code released by invalidated blocks
+	std::map<drccodeptr, size_t> m_code_free; // free code extents, by address
+	bool                m_block;            // whether a reclaimable block is being generated
+	bool                m_block_split;      // whether the current block's code isn't contiguous
+	drccodeptr          m_block_start;      // start of the current block's code
+	drccodeptr          m_block_end;        // end of the current block's code
+	drccodeptr          m_reuse_base;       // start of the free extent being refilled
+	drccodeptr          m_reuse_top;        // next byte to generate in the free extent
+	drccodeptr          m_reuse_limit;      // end of the free extent being refilled
+	bool                m_reuse_failed;     // whether codegen didn't fit in the free extent
+
 	// oob management
 	struct oob_handler
 	{
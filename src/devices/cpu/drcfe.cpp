@@ -154,6 +154,38 @@ const opcode_desc *drc_frontend::describe_code(offs_t startpc)
 }
 
 
+//-------------------------------------------------
+//  describe_hash - compute a hash of the PCs and
+//  opcode bytes of the block most recently
+//  described, including delay slots
+//-------------------------------------------------
+
+u64 drc_frontend::describe_hash() const
+{
+	// 64-bit FNV-1a
+	u64 hash = 0xcbf29ce484222325U;
+	auto const add = [&hash] (u8 const *data, unsigned length)
+	{
+		for (unsigned i = 0; i < length; i++)
+			hash = (hash ^ data[i]) * 0x00000100000001b3U;
+	};
+	auto const add_desc = [&add] (opcode_desc const &desc)
+	{
+		u8 const pc[4] = { u8(desc.pc), u8(desc.pc >> 8), u8(desc.pc >> 16), u8(desc.pc >> 24) };
+		add(pc, sizeof(pc));
+		add(desc.opptr.b, (std::min<unsigned>)(desc.length, sizeof(desc.opptr.b)));
+	};
+
+	for (opcode_desc const *desc = m_desc_live_list.first(); desc != nullptr; desc = desc->next())
+	{
+		add_desc(*desc);
+		for (opcode_desc const *delay = desc->delay.first(); delay != nullptr; delay = delay->next())
+			add_desc(*delay);
+	}
+	return hash;
+}
+
+
 //-------------------------------------------------
 //  describe_one - describe a single instruction,
 //  recursively describing opcodes in delay
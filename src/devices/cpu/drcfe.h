@@ -135,6 +135,8 @@ public:
 	opcode_desc const *describe_code(offs_t startpc);
 	// get last opcode of block
 	opcode_desc const *get_last() { return m_desc_live_list.last(); }
+	// hash the PCs and opcode bytes of the last described block
+	u64 describe_hash() const;
 
 protected:
 	// required overrides
@@ -11,7 +11,7 @@
     Future improvements/changes:
 
     * UML optimizer:
-        - constant folding
+        - register allocation across I-registers
 
     * Write a back-end validator:
         - checks all combinations of memory/register/immediate on all params
@@ -34,14 +34,32 @@
 #include "emu.h"
 #include "drcuml.h"
 
+#include "debug/debugbuf.h"
+#include "debug/debugcon.h"
+#include "debugger.h"
 #include "emuopts.h"
+#include "fileio.h"
 #include "drcbec.h"
 #ifdef NATIVE_DRC
+#if defined(__aarch64__) || defined(_M_ARM64)
+// the AArch64 back-end hasn't been run on hardware yet, so it has to be
+// asked for with USE_DRC_ARM64; otherwise fall back to the C back-end
+#ifdef USE_DRC_ARM64
+#include "drcbearm64.h"
+#else
+#undef NATIVE_DRC
+#endif
+#else
 #include "drcbex86.h"
 #include "drcbex64.h"
 #endif
+#endif
 
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
+#include <numeric>
+#include <sstream>
 
 
 
@@ -54,6 +72,20 @@
 
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// persistent block list file format
+constexpr char PERSIST_MAGIC[8] = { 'M', 'A', 'M', 'E', 'D', 'R', 'C', 'B' };
+constexpr u32 PERSIST_FORMAT = 1;
+constexpr u32 PERSIST_BLOCK_SIZE = 16;
+
+// number of block entry counters available between cache flushes
+constexpr u32 PROFILE_COUNTERS = 16384;
+
+
+
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
@@ -132,6 +164,9 @@ drcbe_interface::~drcbe_interface()
 //  DRCUML STATE
 //**************************************************************************
 
+std::vector<drcuml_state *> drcuml_state::s_profiled;
+
+
 //-------------------------------------------------
 //  drcuml_state - constructor
 //-------------------------------------------------
@@ -148,7 +183,36 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, u32 flags, int mo
 	, m_blocklist()
 	, m_handlelist()
 	, m_symlist()
+	, m_persist_version(0)
+	, m_code_tracking(false)
+	, m_code_page_shift(0)
+	, m_code_bytes_per_inst(0)
+	, m_profile_counters(nullptr)
+	, m_profile_flushes(0)
+	, m_profile_blocks(0)
+	, m_profile_bytes(0)
+	, m_profile_compile(0)
+	, m_profile_execute(0)
 {
+	if (device.machine().options().drc_profile())
+	{
+		// counters need to be reachable from generated code, so they live in the cache
+		m_profile_counters = reinterpret_cast<u64 *>(cache.alloc(PROFILE_COUNTERS * sizeof(u64)));
+		if (!m_profile_counters)
+		{
+			osd_printf_warning("%s: Not enough DRC cache space for profiling\n", device.tag());
+			return;
+		}
+		m_profile_slots.reserve(PROFILE_COUNTERS);
+
+		// the first state registers the debugger command for all of them
+		s_profiled.push_back(this);
+		if ((s_profiled.size() == 1) && (device.machine().debug_flags & DEBUG_FLAG_ENABLED))
+		{
+			using namespace std::placeholders;
+			device.machine().debugger().console().register_command("drcstats", CMDFLAG_NONE, 0, 1, std::bind(&drcuml_state::profile_command, this, _1));
+		}
+	}
 }
 
 
@@ -158,6 +222,9 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, u32 flags, int mo
 
 drcuml_state::~drcuml_state()
 {
+	auto const found = std::find(s_profiled.begin(), s_profiled.end(), this);
+	if (found != s_profiled.end())
+		s_profiled.erase(found);
 }
 
 
@@ -171,8 +238,17 @@ void drcuml_state::reset()
 	// if we error here, we are screwed
 	try
 	{
-		// flush the cache
+		// collect the entry counts before their blocks go away
+		profile_flush();
+		m_profile_flushes++;
+
+		// flush the cache, and everything tracked in it
 		m_cache.flush();
+		m_code_blocks.clear();
+		m_code_blocks_free.clear();
+		m_code_entries.clear();
+		m_code_pages.clear();
+		m_code_stale.clear();
 
 		// reset all handle code pointers
 		for (uml::code_handle &handle : m_handlelist)
@@ -207,6 +283,11 @@ void drcuml_state::reset()
 
 drcuml_block &drcuml_state::begin_block(uint32_t maxinst)
 {
+	// nothing can be running invalidated code while we're compiling
+	for (auto const &stale : m_code_stale)
+		code_release(stale.first, stale.second);
+	m_code_stale.clear();
+
 	// find an inactive block that matches our qualifications
 	drcuml_block *bestblock(nullptr);
 	for (drcuml_block &block : m_blocklist)
@@ -236,6 +317,469 @@ uml::code_handle *drcuml_state::handle_alloc(char const *name)
 }
 
 
+
+//**************************************************************************
+//  CODE TRACKING
+//**************************************************************************
+
+//-------------------------------------------------
+//  enable_code_tracking - keep track of the
+//  entry points and guest pages of each block,
+//  so blocks can be invalidated selectively and
+//  their code space reused
+//-------------------------------------------------
+
+void drcuml_state::enable_code_tracking(u8 pageshift)
+{
+	m_code_tracking = true;
+	m_code_page_shift = pageshift;
+}
+
+
+//-------------------------------------------------
+//  invalidate_code - stop any blocks compiled
+//  from the given range of guest code from being
+//  reached; returns true if there were any, in
+//  which case the caller should leave the current
+//  block as soon as possible since it may be one
+//  of them
+//-------------------------------------------------
+
+bool drcuml_state::invalidate_code(offs_t start, u32 length)
+{
+	if (!m_code_tracking || !length)
+		return false;
+
+	bool found = false;
+	offs_t const last = (start + length - 1) >> m_code_page_shift;
+	for (offs_t page = start >> m_code_page_shift; ; page++)
+	{
+		auto const blocks = m_code_pages.find(page);
+		if (blocks != m_code_pages.end())
+		{
+			// this may be called from generated code, so the space isn't reused until the next compile
+			std::vector<u32> const indices(std::move(blocks->second));
+			m_code_pages.erase(blocks);
+			for (u32 index : indices)
+				code_retire(index, true);
+			found = true;
+		}
+		if (page == last)
+			break;
+	}
+	return found;
+}
+
+
+//-------------------------------------------------
+//  code_generated - note a block that has just
+//  been generated; base is nullptr if its code
+//  can't be released
+//-------------------------------------------------
+
+void drcuml_state::code_generated(uml::instruction const *instlist, u32 numinst, std::vector<offs_t> const &pages, drccodeptr base, u32 bytes)
+{
+	// blocks with no entry points of their own are never tracked
+	std::vector<u64> entries;
+	for (u32 inum = 0; inum < numinst; inum++)
+	{
+		if (instlist[inum].opcode() == uml::OP_HASH)
+			entries.push_back((u64(instlist[inum].param(0).immediate()) << 32) | instlist[inum].param(1).immediate());
+	}
+	if (entries.empty())
+		base = nullptr;
+
+	// claim a slot for the new block
+	u32 index = ~u32(0);
+	if (base)
+	{
+		if (m_code_blocks_free.empty())
+		{
+			index = m_code_blocks.size();
+			m_code_blocks.emplace_back();
+		}
+		else
+		{
+			index = m_code_blocks_free.back();
+			m_code_blocks_free.pop_back();
+		}
+		m_code_bytes_per_inst = std::max(m_code_bytes_per_inst, (bytes + numinst - 1) / numinst);
+	}
+
+	// entry points move from older blocks to this one; an older block nothing reaches any more goes away
+	for (u64 entry : entries)
+	{
+		auto const found = m_code_entries.find(entry);
+		if (found != m_code_entries.end())
+		{
+			u32 const previous = found->second;
+			if (previous == index)
+				continue;
+			if (base)
+				found->second = index;
+			else
+				m_code_entries.erase(found);
+
+			std::vector<u64> &previous_entries = m_code_blocks[previous].entries;
+			previous_entries.erase(std::find(previous_entries.begin(), previous_entries.end(), entry));
+			if (previous_entries.empty())
+				code_retire(previous, false);
+		}
+		else if (base)
+		{
+			m_code_entries.emplace(entry, index);
+		}
+	}
+
+	// fill in the new block
+	if (base)
+	{
+		code_block &block = m_code_blocks[index];
+		block.entries = std::move(entries);
+		block.pages = pages;
+		block.base = base;
+		block.bytes = bytes;
+		for (offs_t page : block.pages)
+			m_code_pages[page].push_back(index);
+	}
+}
+
+
+//-------------------------------------------------
+//  code_retire - stop tracking a block, and
+//  release its code now or once it can't be
+//  running
+//-------------------------------------------------
+
+void drcuml_state::code_retire(u32 index, bool stale)
+{
+	code_block &block = m_code_blocks[index];
+
+	// point its remaining entries back at the missing code handler
+	for (u64 entry : block.entries)
+	{
+		m_beintf->hash_invalidate(u32(entry >> 32), u32(entry));
+		m_code_entries.erase(entry);
+	}
+
+	// forget about it on each of its pages
+	for (offs_t page : block.pages)
+	{
+		auto const blocks = m_code_pages.find(page);
+		if (blocks != m_code_pages.end())
+		{
+			blocks->second.erase(std::remove(blocks->second.begin(), blocks->second.end(), index), blocks->second.end());
+			if (blocks->second.empty())
+				m_code_pages.erase(blocks);
+		}
+	}
+
+	if (stale)
+		m_code_stale.emplace_back(block.base, block.bytes);
+	else
+		code_release(block.base, block.bytes);
+
+	block.entries.clear();
+	block.pages.clear();
+	m_code_blocks_free.push_back(index);
+}
+
+
+//-------------------------------------------------
+//  code_release - give code space back to the
+//  cache for reuse
+//-------------------------------------------------
+
+void drcuml_state::code_release(drccodeptr base, u32 bytes)
+{
+	m_beintf->code_released(base, bytes);
+	m_cache.dealloc_code(base, bytes);
+}
+
+
+//-------------------------------------------------
+//  persist_open - enable the persistent block
+//  list if a cache directory is configured, and
+//  load the blocks recorded by earlier sessions
+//-------------------------------------------------
+
+void drcuml_state::persist_open(u32 frontend_version)
+{
+	running_machine &machine = m_device.machine();
+	if (!*machine.options().drccache_directory())
+		return;
+
+	// one file per system and CPU
+	std::string tag(m_device.tag() + 1);
+	for (char &ch : tag)
+		if (ch == ':')
+			ch = '.';
+	m_persist_name = util::string_format("%s" PATH_SEPARATOR "%s.drc", machine.basename(), tag);
+	m_persist_version = frontend_version;
+
+	persist_load();
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&drcuml_state::persist_save, this));
+}
+
+
+//-------------------------------------------------
+//  persist_record - note that a block has been
+//  compiled, so it can be written on exit
+//-------------------------------------------------
+
+void drcuml_state::persist_record(u8 mode, offs_t pc, u64 hash)
+{
+	if (persist_enabled())
+		m_persist_blocks[persist_key(mode, pc)] = persist_block{ mode, pc, hash };
+}
+
+
+//-------------------------------------------------
+//  persist_load - read the persistent block list
+//  written by a previous session, discarding it
+//  if it was written by a different front-end
+//  or back-end
+//-------------------------------------------------
+
+void drcuml_state::persist_load()
+{
+	emu_file file(m_device.machine().options().drccache_directory(), OPEN_FLAG_READ);
+	if (file.open(m_persist_name))
+		return;
+
+	std::vector<u8> data(file.size());
+	if (file.read(data.data(), data.size()) != data.size())
+		return;
+	file.close();
+
+	// everything is little-endian
+	size_t offset = 0;
+	auto const get = [&data, &offset] (unsigned bytes) -> u64
+	{
+		u64 result = 0;
+		for (unsigned i = 0; i < bytes; i++)
+			result |= u64(data[offset + i]) << (i * 8);
+		offset += bytes;
+		return result;
+	};
+
+	// check the header against what we would have written
+	std::string const backend(m_device.machine().options().drc_use_c() ? "c" : "native");
+	size_t const headersize = sizeof(PERSIST_MAGIC) + 4 + 4 + 1 + backend.length() + 4;
+	if ((data.size() < headersize) || memcmp(data.data(), PERSIST_MAGIC, sizeof(PERSIST_MAGIC)))
+		return;
+	offset = sizeof(PERSIST_MAGIC);
+	if ((get(4) != PERSIST_FORMAT) || (get(4) != m_persist_version) || (get(1) != backend.length()))
+		return;
+	if (memcmp(&data[offset], backend.c_str(), backend.length()))
+		return;
+	offset += backend.length();
+	u32 const count = get(4);
+	if ((data.size() - offset) != (u64(count) * PERSIST_BLOCK_SIZE))
+		return;
+
+	// queue the blocks by page for prewarming, and keep them for the next save
+	for (u32 i = 0; i < count; i++)
+	{
+		persist_block block;
+		block.mode = get(4);
+		block.pc = get(4);
+		block.hash = get(8);
+		m_persist_blocks.emplace(persist_key(block.mode, block.pc), block);
+		m_persist_pending[block.pc >> 12].push_back(block);
+	}
+	osd_printf_verbose("%s: Loaded %u blocks from DRC block list\n", m_device.tag(), count);
+}
+
+
+//-------------------------------------------------
+//  persist_save - write the blocks compiled this
+//  session and those still waiting to be used
+//-------------------------------------------------
+
+void drcuml_state::persist_save()
+{
+	if (m_persist_blocks.empty())
+		return;
+
+	std::vector<u8> data;
+	auto const put = [&data] (u64 value, unsigned bytes)
+	{
+		for (unsigned i = 0; i < bytes; i++)
+			data.push_back(u8(value >> (i * 8)));
+	};
+
+	std::string const backend(m_device.machine().options().drc_use_c() ? "c" : "native");
+	data.insert(data.end(), std::begin(PERSIST_MAGIC), std::end(PERSIST_MAGIC));
+	put(PERSIST_FORMAT, 4);
+	put(m_persist_version, 4);
+	put(backend.length(), 1);
+	data.insert(data.end(), backend.begin(), backend.end());
+	put(m_persist_blocks.size(), 4);
+	for (auto const &entry : m_persist_blocks)
+	{
+		put(entry.second.mode, 4);
+		put(entry.second.pc, 4);
+		put(entry.second.hash, 8);
+	}
+
+	// write to a temporary file first so a partial list is never picked up
+	char const *const directory = m_device.machine().options().drccache_directory();
+	emu_file file(directory, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(util::string_format("%s.%d.tmp", m_persist_name, osd_getpid())))
+		return;
+	std::string const temppath(file.fullpath());
+	bool const written(file.write(data.data(), data.size()) == data.size());
+	file.close();
+
+	std::string const path(util::string_format("%s" PATH_SEPARATOR "%s", directory, m_persist_name));
+	if (!written || std::rename(temppath.c_str(), path.c_str()))
+		osd_file::remove(temppath);
+}
+
+
+//-------------------------------------------------
+//  profile_counter - assign an entry counter to
+//  a block entry point as it is compiled, or
+//  return nullptr if they have all been used
+//-------------------------------------------------
+
+u64 *drcuml_state::profile_counter(u32 mode, offs_t pc)
+{
+	u64 const key = persist_key(mode, pc);
+	auto const found = m_profile.emplace(key, profile_entry{ mode, pc, 0, 0, 0 }).first;
+	found->second.compiles++;
+
+	if (m_profile_slots.size() >= PROFILE_COUNTERS)
+		return nullptr;
+
+	u64 *const counter = &m_profile_counters[m_profile_slots.size()];
+	*counter = 0;
+	m_profile_slots.push_back(key);
+	return counter;
+}
+
+
+//-------------------------------------------------
+//  profile_generated - account for a block that
+//  has been generated, starting at the given HASH
+//  if it has one
+//-------------------------------------------------
+
+void drcuml_state::profile_generated(uml::instruction const *hash, u32 bytes, osd_ticks_t ticks)
+{
+	m_profile_blocks++;
+	m_profile_bytes += bytes;
+	m_profile_compile += ticks;
+
+	if (hash)
+	{
+		auto const found = m_profile.find(persist_key(hash->param(0).immediate(), hash->param(1).immediate()));
+		if (found != m_profile.end())
+			found->second.bytes += bytes;
+	}
+}
+
+
+//-------------------------------------------------
+//  profile_flush - fold the counters of blocks
+//  in the cache into the totals
+//-------------------------------------------------
+
+void drcuml_state::profile_flush()
+{
+	for (u32 slot = 0; slot < m_profile_slots.size(); slot++)
+		m_profile[m_profile_slots[slot]].entries += m_profile_counters[slot];
+	m_profile_slots.clear();
+}
+
+
+//-------------------------------------------------
+//  profile_format - print the totals and the most
+//  frequently entered blocks
+//-------------------------------------------------
+
+void drcuml_state::profile_format(std::ostream &stream, int count) const
+{
+	double const rate = double(osd_ticks_per_second());
+	util::stream_format(stream, "%s: %u flushes, %u blocks, %u bytes, %u recompiles, compile %.3fs, execute %.3fs\n",
+			m_device.tag(),
+			m_profile_flushes,
+			m_profile_blocks,
+			m_profile_bytes,
+			std::accumulate(m_profile.begin(), m_profile.end(), u64(0), [] (u64 total, auto const &entry) { return total + entry.second.compiles - 1; }),
+			double(m_profile_compile) / rate,
+			double(m_profile_execute) / rate);
+
+	// add in the live counters without disturbing them
+	std::vector<profile_entry> entries;
+	entries.reserve(m_profile.size());
+	for (auto const &entry : m_profile)
+		entries.push_back(entry.second);
+	std::unordered_map<u64, size_t> index;
+	for (size_t i = 0; i < entries.size(); i++)
+		index.emplace(persist_key(entries[i].mode, entries[i].pc), i);
+	for (u32 slot = 0; slot < m_profile_slots.size(); slot++)
+		entries[index[m_profile_slots[slot]]].entries += m_profile_counters[slot];
+
+	count = std::min<size_t>(count, entries.size());
+	std::partial_sort(entries.begin(), entries.begin() + count, entries.end(),
+			[] (profile_entry const &a, profile_entry const &b) { return a.entries > b.entries; });
+
+	std::unique_ptr<debug_disasm_buffer> buffer;
+	device_disasm_interface *dasm;
+	device_memory_interface *memory;
+	if (m_device.interface(dasm) && m_device.interface(memory) && memory->has_space(AS_PROGRAM))
+		buffer = std::make_unique<debug_disasm_buffer>(m_device);
+
+	util::stream_format(stream, "  mode  pc        entries       bytes   compiles  first instruction\n");
+	for (int i = 0; i < count; i++)
+	{
+		profile_entry const &entry = entries[i];
+		std::string instruction;
+		if (buffer)
+		{
+			offs_t next, size;
+			u32 info;
+			buffer->disassemble(entry.pc, instruction, next, size, info);
+		}
+		util::stream_format(stream, "  %4X  %08X  %12u  %8u  %8u  %s\n", entry.mode, entry.pc, entry.entries, entry.bytes, entry.compiles, instruction);
+	}
+}
+
+
+//-------------------------------------------------
+//  profile_report - describe every profiled state
+//-------------------------------------------------
+
+std::string drcuml_state::profile_report(int count)
+{
+	std::ostringstream stream;
+	for (drcuml_state const *state : s_profiled)
+		state->profile_format(stream, count);
+	return std::move(stream).str();
+}
+
+
+//-------------------------------------------------
+//  profile_command - debugger command to show the
+//  most frequently entered blocks
+//-------------------------------------------------
+
+void drcuml_state::profile_command(std::vector<std::string_view> const &params)
+{
+	debugger_console &console = m_device.machine().debugger().console();
+	u64 count = 20;
+	if (!params.empty() && !console.validate_number_parameter(params[0], count))
+		return;
+
+	std::istringstream lines(profile_report(count));
+	std::string line;
+	while (std::getline(lines, line))
+		console.printf("%s\n", line);
+}
+
+
 //-------------------------------------------------
 //  symbol_add - add a symbol to the internal
 //  symbol table
@@ -306,6 +850,7 @@ drcuml_block::drcuml_block(drcuml_state &drcuml, u32 maxinst)
 	, m_maxinst(maxinst * 3/2)
 	, m_inst(m_maxinst)
 	, m_inuse(false)
+	, m_start(0)
 {
 }
 
@@ -328,6 +873,9 @@ void drcuml_block::begin()
 	// set up the block information and return it
 	m_inuse = true;
 	m_nextinst = 0;
+	m_pages.clear();
+	if (m_drcuml.profiling())
+		m_start = osd_ticks();
 }
 
 
@@ -343,19 +891,101 @@ void drcuml_block::end()
 	// optimize the resulting code first
 	optimize();
 
+	// count entries to the block if we're profiling
+	bool const profiling = m_drcuml.profiling();
+	if (profiling)
+		profile();
+
 	// if we have a logfile, generate a disassembly of the block
 	if (m_drcuml.logging())
 		disassemble();
 
 	// generate the code via the back-end
 	m_drcuml.cache().codegen_init();
-	m_drcuml.generate(*this, &m_inst[0], m_nextinst);
+	u32 const bytes = generate();
+
+	if (profiling)
+	{
+		auto const hash = std::find_if(m_inst.begin(), m_inst.begin() + m_nextinst, [] (uml::instruction const &inst) { return inst.opcode() == uml::OP_HASH; });
+		m_drcuml.profile_generated((hash != m_inst.begin() + m_nextinst) ? &*hash : nullptr, bytes, osd_ticks() - m_start);
+	}
 
 	// block is no longer in use
 	m_inuse = false;
 }
 
 
+//-------------------------------------------------
+//  generate - generate code for the block via the
+//  back-end, reusing space released by other
+//  blocks if code is being tracked; returns the
+//  number of bytes generated
+//-------------------------------------------------
+
+u32 drcuml_block::generate()
+{
+	drc_cache &cache(m_drcuml.cache());
+	if (!m_drcuml.code_tracking())
+	{
+		drccodeptr const start = cache.top();
+		m_drcuml.generate(*this, &m_inst[0], m_nextinst);
+		return cache.top() - start;
+	}
+
+	// handles can reach a block without going through the hash table, so blocks with them stay put
+	bool const reclaimable = std::none_of(m_inst.begin(), m_inst.begin() + m_nextinst, [] (uml::instruction const &inst) { return inst.opcode() == uml::OP_HANDLE; });
+	u32 reuse = reclaimable ? m_drcuml.code_reuse_bytes(m_nextinst) : 0;
+	drccodeptr base;
+	size_t bytes;
+	while (true)
+	{
+		cache.begin_block(reuse);
+		try
+		{
+			m_drcuml.generate(*this, &m_inst[0], m_nextinst);
+			break;
+		}
+		catch (abort_compilation &)
+		{
+			// throw away anything generated; if it was just too big for the space being reused, try again at the top
+			bool const retry = cache.reuse_failed();
+			if (cache.end_block(base, bytes) && bytes)
+				m_drcuml.code_release(base, bytes);
+			if (!retry)
+				throw;
+			m_inuse = true;
+			reuse = 0;
+		}
+	}
+
+	bool const contiguous = cache.end_block(base, bytes);
+	m_drcuml.code_generated(&m_inst[0], m_nextinst, m_pages, (reclaimable && contiguous) ? base : nullptr, bytes);
+	return bytes;
+}
+
+
+//-------------------------------------------------
+//  add_code_range - note that the block was
+//  compiled from the given range of guest code
+//-------------------------------------------------
+
+void drcuml_block::add_code_range(offs_t start, u32 length)
+{
+	if (!m_drcuml.code_tracking() || !length)
+		return;
+
+	u8 const shift = m_drcuml.code_page_shift();
+	offs_t const last = (start + length - 1) >> shift;
+	for (offs_t page = start >> shift; ; page++)
+	{
+		if (std::find(m_pages.begin(), m_pages.end(), page) == m_pages.end())
+			m_pages.push_back(page);
+		if (page == last)
+			break;
+	}
+}
+
+
 //-------------------------------------------------
 //  abort - abort a code block in progress
 //-------------------------------------------------
@@ -387,6 +1017,37 @@ uml::instruction &drcuml_block::append()
 }
 
 
+//-------------------------------------------------
+//  profile - add a counter increment after each
+//  hash entry point in the block
+//-------------------------------------------------
+
+void drcuml_block::profile()
+{
+	// leave the block alone if there's no room for all the counters
+	u32 const hashes = std::count_if(m_inst.begin(), m_inst.begin() + m_nextinst, [] (uml::instruction const &inst) { return inst.opcode() == uml::OP_HASH; });
+	if (!hashes || ((m_nextinst + hashes) > m_maxinst))
+		return;
+
+	// work backwards, opening a gap after each HASH
+	u32 dst = m_nextinst + hashes;
+	for (u32 src = m_nextinst; src-- > 0; )
+	{
+		uml::instruction const &inst(m_inst[src]);
+		if (inst.opcode() == uml::OP_HASH)
+		{
+			u64 *const counter = m_drcuml.profile_counter(inst.param(0).immediate(), inst.param(1).immediate());
+			if (counter)
+				m_inst[--dst].dadd(uml::mem(counter), uml::mem(counter), 1);
+			else
+				m_inst[--dst].nop();
+		}
+		m_inst[--dst] = m_inst[src];
+	}
+	m_nextinst += hashes;
+}
+
+
 //-------------------------------------------------
 //  optimize - apply various optimizations to a
 //  block of code
@@ -395,6 +1056,8 @@ uml::instruction &drcuml_block::append()
 void drcuml_block::optimize()
 {
 	u32 mapvar[uml::MAPVAR_COUNT] = { 0 };
+	uml::ireg_constants known;
+	known.reset();
 
 	// iterate over instructions
 	for (int instnum = 0; instnum < m_nextinst; instnum++)
@@ -428,8 +1091,30 @@ void drcuml_block::optimize()
 				if (inst.param(pnum).is_mapvar())
 					inst.set_mapvar(pnum, mapvar[inst.param(pnum).mapvar() - uml::MAPVAR_M0]);
 
-		// now that flags are correct, simplify the instruction
+		// substitute known register values, then simplify now that flags are correct
+		uml::instruction const orig(inst);
+		inst.propagate_constants(known);
 		inst.simplify();
+
+		// back-ends don't handle every combination of immediates, so only keep the
+		// substitution if it folded away or only affected addresses and indices
+		switch (inst.opcode())
+		{
+		case uml::OP_MOV:
+		case uml::OP_NOP:
+		case uml::OP_LOAD:
+		case uml::OP_LOADS:
+		case uml::OP_STORE:
+		case uml::OP_READ:
+		case uml::OP_WRITE:
+			break;
+
+		default:
+			inst = orig;
+			inst.simplify();
+			break;
+		}
+		inst.track_constants(known);
 	}
 }
 
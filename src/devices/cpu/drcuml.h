@@ -18,6 +18,9 @@
 #include <iostream>
 #include <list>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 
@@ -61,11 +64,23 @@ union drcuml_freg
 };
 
 
+// a 128-bit vector register, as lanes of each size
+union drcuml_vreg
+{
+	u8                      b[16];                  // byte lanes
+	u16                     h[8];                   // word lanes
+	u32                     w[4];                   // dword lanes
+	u64                     d[2];                   // qword lanes
+	float                   s[4];                   // single-precision lanes
+};
+
+
 // the collected machine state of a system
 struct drcuml_machine_state
 {
 	drcuml_ireg             r[uml::REG_I_COUNT];    // integer registers
 	drcuml_freg             f[uml::REG_F_COUNT];    // floating-point registers
+	drcuml_vreg             v[uml::REG_V_COUNT];    // vector registers
 	u32                     exp;                    // exception parameter register
 	u8                      fmod;                   // fmod (floating-point mode) register
 	u8                      flags;                  // flags state
@@ -103,6 +118,9 @@ public:
 	uml::instruction &append();
 	template <typename Format, typename... Params> void append_comment(Format &&fmt, Params &&... args);
 
+	// note guest code the block was compiled from, for selective invalidation
+	void add_code_range(offs_t start, u32 length);
+
 	// this class is thrown if abort() is called
 	class abort_compilation : public emu_exception
 	{
@@ -113,6 +131,8 @@ public:
 private:
 	// internal helpers
 	void optimize();
+	u32 generate();
+	void profile();
 	void disassemble();
 	char const *get_comment_text(uml::instruction const &inst, std::string &comment);
 
@@ -121,7 +141,9 @@ private:
 	u32                             m_nextinst; // next instruction to fill in the cache
 	u32                             m_maxinst;  // maximum number of instructions
 	std::vector<uml::instruction>   m_inst;     // pointer to the instruction list
+	std::vector<offs_t>             m_pages;    // guest code pages the block was compiled from
 	bool                            m_inuse;    // this block is in use
+	osd_ticks_t                     m_start;    // time compilation started, when profiling
 };
 
 
@@ -137,8 +159,10 @@ public:
 	virtual int execute(uml::code_handle &entry) = 0;
 	virtual void generate(drcuml_block &block, uml::instruction const *instlist, u32 numinst) = 0;
 	virtual bool hash_exists(u32 mode, u32 pc) = 0;
+	virtual void hash_invalidate(u32 mode, u32 pc) = 0;
 	virtual void get_info(drcbe_info &info) = 0;
 	virtual bool logging() const { return false; }
+	virtual void code_released(drccodeptr base, u32 bytes) { }
 
 protected:
 	// base constructor
@@ -168,7 +192,7 @@ public:
 
 	// reset the state
 	void reset();
-	int execute(uml::code_handle &entry) { return m_beintf->execute(entry); }
+	int execute(uml::code_handle &entry);
 
 	// code generation
 	drcuml_block &begin_block(u32 maxinst);
@@ -176,11 +200,33 @@ public:
 	// back-end interface
 	void get_backend_info(drcbe_info &info) { m_beintf->get_info(info); }
 	bool hash_exists(u32 mode, u32 pc) { return m_beintf->hash_exists(mode, pc); }
+	void hash_invalidate(u32 mode, u32 pc) { m_beintf->hash_invalidate(mode, pc); }
 	void generate(drcuml_block &block, uml::instruction *instructions, u32 count) { m_beintf->generate(block, instructions, count); }
 
 	// handle management
 	uml::code_handle *handle_alloc(char const *name);
 
+	// selective invalidation of blocks compiled from modified code
+	void enable_code_tracking(u8 pageshift);
+	bool code_tracking() const { return m_code_tracking; }
+	u8 code_page_shift() const { return m_code_page_shift; }
+	bool invalidate_code(offs_t start, u32 length);
+	u32 code_reuse_bytes(u32 numinst) const { return numinst * m_code_bytes_per_inst; }
+	void code_generated(uml::instruction const *instlist, u32 numinst, std::vector<offs_t> const &pages, drccodeptr base, u32 bytes);
+	void code_release(drccodeptr base, u32 bytes);
+
+	// persistent block list
+	void persist_open(u32 frontend_version);
+	bool persist_enabled() const { return !m_persist_name.empty(); }
+	void persist_record(u8 mode, offs_t pc, u64 hash);
+	template <typename T> void persist_prewarm(offs_t pc, T &&compile);
+
+	// profiling
+	bool profiling() const { return bool(m_profile_counters); }
+	u64 *profile_counter(u32 mode, offs_t pc);
+	void profile_generated(uml::instruction const *hash, u32 bytes, osd_ticks_t ticks);
+	static std::string profile_report(int count);
+
 	// symbol management
 	void symbol_add(void *base, u32 length, char const *name);
 	char const *symbol_find(void *base, u32 *offset = nullptr);
@@ -220,6 +266,46 @@ private:
 		std::string m_name;     // name of the symbol
 	};
 
+	// a block recorded in the persistent block list
+	struct persist_block
+	{
+		u8          mode;       // mode the block was compiled in
+		offs_t      pc;         // starting PC
+		u64         hash;       // hash of the described guest code
+	};
+
+	// statistics for one block entry point, kept across flushes
+	struct profile_entry
+	{
+		u32         mode;       // mode the entry was compiled in
+		offs_t      pc;         // starting PC
+		u64         entries;    // times the entry point was reached
+		u64         bytes;      // bytes of native code generated for blocks starting here
+		u32         compiles;   // times the entry point was compiled
+	};
+
+	// a block whose code can be released once nothing reaches it
+	struct code_block
+	{
+		std::vector<u64>    entries;    // mode/PC entry points still pointing into the block
+		std::vector<offs_t> pages;      // guest code pages the block was compiled from
+		drccodeptr          base;       // start of the generated code
+		u32                 bytes;      // size of the generated code
+	};
+
+	// code tracking helpers
+	void code_retire(u32 index, bool stale);
+
+	// profiling helpers
+	void profile_flush();
+	void profile_command(std::vector<std::string_view> const &params);
+	void profile_format(std::ostream &stream, int count) const;
+
+	// persistent block list helpers
+	void persist_load();
+	void persist_save();
+	static u64 persist_key(u8 mode, offs_t pc) { return (u64(mode) << 32) | pc; }
+
 	// internal state
 	device_t &                              m_device;           // CPU device we are associated with
 	drc_cache &                             m_cache;            // pointer to the codegen cache
@@ -228,6 +314,34 @@ private:
 	std::list<drcuml_block>                 m_blocklist;        // list of active blocks
 	std::list<uml::code_handle>             m_handlelist;       // list of active handles
 	std::list<symbol>                       m_symlist;          // list of symbols
+
+	// persistent block list state
+	std::string                             m_persist_name;     // file name within the cache directory
+	u32                                     m_persist_version;  // front-end version the blocks were described with
+	std::unordered_map<u64, persist_block>  m_persist_blocks;   // blocks compiled or loaded this session
+	std::unordered_map<offs_t, std::vector<persist_block> > m_persist_pending; // loaded blocks not yet compiled, by page
+
+	// code tracking state
+	bool                                    m_code_tracking;    // whether blocks are tracked for invalidation
+	u8                                      m_code_page_shift;  // log2 of the guest page size
+	u32                                     m_code_bytes_per_inst; // most native code generated per UML instruction
+	std::vector<code_block>                 m_code_blocks;      // tracked blocks
+	std::vector<u32>                        m_code_blocks_free; // unused tracked block slots
+	std::unordered_map<u64, u32>            m_code_entries;     // tracked block for each mode/PC
+	std::unordered_map<offs_t, std::vector<u32> > m_code_pages; // tracked blocks compiled from each guest page
+	std::vector<std::pair<drccodeptr, u32> > m_code_stale;      // invalidated code that may still be running
+
+	// profiling state
+	u64 *                                   m_profile_counters; // entry counters (in cache), or nullptr if not profiling
+	std::vector<u64>                        m_profile_slots;    // entry point using each counter in use
+	std::unordered_map<u64, profile_entry>  m_profile;          // statistics by entry point
+	u32                                     m_profile_flushes;  // number of times the cache was flushed
+	u64                                     m_profile_blocks;   // number of blocks generated
+	u64                                     m_profile_bytes;    // total bytes of native code generated
+	osd_ticks_t                             m_profile_compile;  // time spent compiling
+	osd_ticks_t                             m_profile_execute;  // time spent executing generated code
+
+	static std::vector<drcuml_state *>      s_profiled;         // states with profiling enabled
 };
 
 
@@ -236,6 +350,52 @@ private:
 //  MEMBER TEMPLATES
 //**************************************************************************
 
+//-------------------------------------------------
+//  persist_prewarm - compile blocks loaded from
+//  the persistent block list that start on the
+//  same page as the given PC; the callback is
+//  given the mode, PC and hash, and must check
+//  the hash before compiling
+//-------------------------------------------------
+
+template <typename T>
+inline void drcuml_state::persist_prewarm(offs_t pc, T &&compile)
+{
+	if (m_persist_pending.empty())
+		return;
+
+	auto const found = m_persist_pending.find(pc >> 12);
+	if (found == m_persist_pending.end())
+		return;
+
+	// take the list first, as compiling may record more blocks
+	std::vector<persist_block> const blocks(std::move(found->second));
+	m_persist_pending.erase(found);
+	for (persist_block const &block : blocks)
+	{
+		if (!hash_exists(block.mode, block.pc) && !compile(block.mode, block.pc, block.hash))
+			m_persist_blocks.erase(persist_key(block.mode, block.pc));
+	}
+}
+
+
+//-------------------------------------------------
+//  execute - run generated code from the given
+//  entry point, timing it when profiling
+//-------------------------------------------------
+
+inline int drcuml_state::execute(uml::code_handle &entry)
+{
+	if (!profiling())
+		return m_beintf->execute(entry);
+
+	osd_ticks_t const start = osd_ticks();
+	int const result = m_beintf->execute(entry);
+	m_profile_execute += osd_ticks() - start;
+	return result;
+}
+
+
 //-------------------------------------------------
 //  comment - attach a comment to the current
 //  output location in the specified block
@@ -186,4 +186,18 @@
 #define UML_ICOPYFD(block, dst, src)                        do { using namespace uml; block.append().icopyfd(dst, src); } while (0)
 
 
+/* ----- 128-bit Vector Operations ----- */
+#define UML_VMOV(block, dst, src)                           do { using namespace uml; block.append().vmov(dst, src); } while (0)
+#define UML_VADD(block, dst, src1, src2, size)              do { using namespace uml; block.append().vadd(dst, src1, src2, size); } while (0)
+#define UML_VSUB(block, dst, src1, src2, size)              do { using namespace uml; block.append().vsub(dst, src1, src2, size); } while (0)
+#define UML_VADDS(block, dst, src1, src2, size)             do { using namespace uml; block.append().vadds(dst, src1, src2, size); } while (0)
+#define UML_VSUBS(block, dst, src1, src2, size)             do { using namespace uml; block.append().vsubs(dst, src1, src2, size); } while (0)
+#define UML_VFADD(block, dst, src1, src2)                   do { using namespace uml; block.append().vfadd(dst, src1, src2); } while (0)
+#define UML_VFSUB(block, dst, src1, src2)                   do { using namespace uml; block.append().vfsub(dst, src1, src2); } while (0)
+#define UML_VFMUL(block, dst, src1, src2)                   do { using namespace uml; block.append().vfmul(dst, src1, src2); } while (0)
+#define UML_VFMIN(block, dst, src1, src2)                   do { using namespace uml; block.append().vfmin(dst, src1, src2); } while (0)
+#define UML_VFMAX(block, dst, src1, src2)                   do { using namespace uml; block.append().vfmax(dst, src1, src2); } while (0)
+#define UML_VSHUF(block, dst, src, lanes)                   do { using namespace uml; block.append().vshuf(dst, src, lanes); } while (0)
+
+
 #endif // MAME_CPU_DRCUMLSH_H
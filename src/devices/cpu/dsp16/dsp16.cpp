@@ -120,10 +120,19 @@ WRITE_LINE_MEMBER(dsp16_device_base::exm_w)
 	{
 		m_exm_in = state ? 1U : 0U;
 		if (started())
+		{
 			external_memory_enable(*m_spaces[AS_PROGRAM], !m_exm_in);
+			if (m_recompiler)
+				m_recompiler->invalidate();
+		}
 	}
 }
 
+void dsp16_device_base::enable_recompiler()
+{
+	m_enable_drc = allow_drc();
+}
+
 /***********************************************************************
     high-level passive parallel I/O handlers
 ***********************************************************************/
@@ -185,7 +194,7 @@ dsp16_device_base::dsp16_device_base(
 			{ "exm", ENDIANNESS_BIG, 16, 16, -1 } }
 	, m_yaau_bits(yaau_bits)
 	, m_workram(*this, "workram"), m_spaces{ nullptr, nullptr, nullptr }, m_workram_mask(0U)
-	, m_drc_cache(CACHE_SIZE), m_core(nullptr, [] (core_state *core) { core->~core_state(); }), m_recompiler()
+	, m_drc_cache(CACHE_SIZE), m_core(nullptr, [] (core_state *core) { core->~core_state(); }), m_enable_drc(false), m_recompiler()
 	, m_cache_mode(cache::NONE), m_phase(phase::PURGE), m_int_enable{ 0U, 0U }, m_flags(FLAGS_NONE), m_cache_ptr(0U), m_cache_limit(0U), m_cache_iterations(0U)
 	, m_exm_in(1U), m_int_in(CLEAR_LINE), m_iack_out(1U)
 	, m_ick_in(1U), m_ild_in(CLEAR_LINE), m_do_out(1U), m_ock_in(1U), m_old_in(CLEAR_LINE), m_ose_out(1U)
@@ -232,9 +241,6 @@ void dsp16_device_base::device_start()
 	m_spaces[AS_PROGRAM]->cache(m_pcache);
 	m_workram_mask = u16((m_workram.bytes() >> 1) - 1);
 
-	if (allow_drc())
-		m_recompiler.reset(new recompiler(*this, 0)); // TODO: what are UML flags for?
-
 	state_add(STATE_GENPC, "PC", m_core->xaau_pc);
 	state_add(STATE_GENPCBASE, "CURPC", m_st_pcbase).noshow();
 	state_add(STATE_GENFLAGS, "GENFLAGS", m_st_genflags).mask(0x0fU).noshow().callexport().formatstr("%16s");
@@ -344,6 +350,13 @@ void dsp16_device_base::device_reset()
 	m_pio_pods_cnt = 0U;
 	m_st_pcbase = 0U;
 
+	// the recompiler hasn't been checked against the interpreter much, so
+	// it's only created when asked for
+	if (m_enable_drc && !m_recompiler)
+		m_recompiler.reset(new recompiler(*this, 0)); // TODO: what are UML flags for?
+	else if (m_recompiler)
+		m_recompiler->invalidate();
+
 	// interrupt reset outputs
 	if (!m_iack_out)
 	{
@@ -398,6 +411,26 @@ void dsp16_device_base::execute_run()
 			}
 		}
 	}
+	else if (m_recompiler)
+	{
+		while (m_core->icount_remaining())
+		{
+			switch (m_cache_mode)
+			{
+			case cache::NONE:
+				// recompiled code can only be entered at an instruction boundary
+				if ((phase::OP1 != m_phase) || (FLAGS_NONE != m_flags) || m_recompiler->execute_run())
+					execute_some_rom<false, false, true>();
+				break;
+			case cache::LOAD:
+				execute_some_rom<false, true>();
+				break;
+			case cache::EXECUTE:
+				execute_some_cache<false>();
+				break;
+			}
+		}
+	}
 	else
 	{
 		while (m_core->icount_remaining())
@@ -656,7 +689,7 @@ void dsp16_device_base::program_map(address_map &map)
     instruction execution
 ***********************************************************************/
 
-template <bool Debugger, bool Caching> inline void dsp16_device_base::execute_some_rom()
+template <bool Debugger, bool Caching, bool Recompiling> inline void dsp16_device_base::execute_some_rom()
 {
 	assert(bool(machine().debug_flags & DEBUG_FLAG_ENABLED) == Debugger);
 	for (bool mode_change = false; !mode_change && m_core->icount_remaining(); m_core->decrement_icount())
@@ -1143,6 +1176,10 @@ template <bool Debugger, bool Caching> inline void dsp16_device_base::execute_so
 
 		sio_step();
 		pio_step();
+
+		// hand back to the recompiler as soon as it can pick up from here
+		if (Recompiling && (phase::OP1 == m_phase) && (cache::NONE == m_cache_mode) && (FLAGS_NONE == m_flags))
+			mode_change = true;
 	}
 }
 
@@ -1499,7 +1536,7 @@ template <bool Debugger> void dsp16_device_base::yaau_write_z(u16 op)
     built-in peripherals
 ***********************************************************************/
 
-inline void dsp16_device_base::sio_step()
+void dsp16_device_base::sio_step()
 {
 	// step the serial I/O clock divider
 	if (m_sio_clk_div)
@@ -1526,7 +1563,7 @@ inline void dsp16_device_base::sio_step()
 	}
 }
 
-inline void dsp16_device_base::pio_step()
+void dsp16_device_base::pio_step()
 {
 	// udpate parallel input strobe
 	if (m_pio_pids_cnt)
@@ -1568,7 +1605,7 @@ inline void dsp16_device_base::pio_step()
     inline helpers
 ***********************************************************************/
 
-inline bool dsp16_device_base::op_interruptible(u16 op)
+bool dsp16_device_base::op_interruptible(u16 op)
 {
 	switch (op >> 11)
 	{
@@ -1625,7 +1662,7 @@ inline u16 &dsp16_device_base::set_xaau_pc_offset(u16 offset)
 	return m_core->xaau_pc;
 }
 
-inline s16 dsp16_device_base::get_r(u16 op)
+s16 dsp16_device_base::get_r(u16 op)
 {
 	switch (op_r(op))
 	{
@@ -1686,7 +1723,7 @@ inline s16 dsp16_device_base::get_r(u16 op)
 	}
 }
 
-inline void dsp16_device_base::set_r(u16 op, s16 value)
+void dsp16_device_base::set_r(u16 op, s16 value)
 {
 	switch (op_r(op))
 	{
@@ -1779,7 +1816,7 @@ s64 dsp16_device_base::dau_saturate(u16 a) const
 		return std::clamp<s64>(m_core->dau_a[a], std::numeric_limits<s32>::min(), std::numeric_limits<s32>::max());
 }
 
-inline bool dsp16_device_base::op_dau_con(u16 op, bool inc)
+bool dsp16_device_base::op_dau_con(u16 op, bool inc)
 {
 	bool result;
 	u16 const con(op_con(op));
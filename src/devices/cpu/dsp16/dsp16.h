@@ -22,6 +22,9 @@ class dsp16_device_base : public cpu_device, protected dsp16_disassembler::cpu
 public:
 	DECLARE_WRITE_LINE_MEMBER(exm_w);
 
+	// use the recompiler rather than the interpreter
+	void enable_recompiler();
+
 	// interrupt output callbacks
 	auto iack_cb() { return m_iack_cb.bind(); }
 
@@ -120,7 +123,7 @@ private:
 	// recompiler setup
 	enum : size_t
 	{
-		CACHE_SIZE = 1U * 1024 * 1024
+		CACHE_SIZE = 8U * 1024 * 1024
 	};
 
 	// masks for registers that aren't power-of-two sizes
@@ -184,7 +187,7 @@ private:
 	void program_map(address_map &map);
 
 	// instruction execution
-	template <bool Debugger, bool Caching> void execute_some_rom();
+	template <bool Debugger, bool Caching, bool Recompiling = false> void execute_some_rom();
 	template <bool Debugger> void execute_some_cache();
 	void overlap_rom_data_read();
 	void yaau_short_immediate_load(u16 op);
@@ -281,6 +284,7 @@ private:
 	// recompiler stuff
 	drc_cache                   m_drc_cache;
 	core_state_ptr              m_core;
+	bool                        m_enable_drc;
 	recompiler_ptr              m_recompiler;
 
 	// execution state
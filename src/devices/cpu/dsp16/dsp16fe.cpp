@@ -30,7 +30,8 @@ bool dsp16_device_base::frontend::describe(opcode_desc &desc, opcode_desc const
 	desc.length = 1U;
 	desc.cycles = 1U;
 
-	u16 const op(m_host.m_pcache.read_word(desc.physpc));
+	// keep the opcode for the code generator
+	u16 const op(desc.opptr.w[0] = m_host.m_pcache.read_word(desc.physpc));
 	switch (op >> 11)
 	{
 	case 0x00: // goto JA
@@ -39,7 +40,7 @@ bool dsp16_device_base::frontend::describe(opcode_desc &desc, opcode_desc const
 	case 0x11:
 		desc.cycles = 2U;
 		desc.targetpc = (desc.physpc & XAAU_I_EXT) | (op_ja(op) & XAAU_I_MASK);
-		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH;
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
 		if (BIT(op, 15))
 			flag_output_reg(desc, REG_BIT_XAAU_PR);
 		return true;
@@ -96,6 +97,7 @@ bool dsp16_device_base::frontend::describe(opcode_desc &desc, opcode_desc const
 	case 0x0a: // R = N
 		desc.length = 2U;
 		desc.cycles = 2U;
+		desc.opptr.w[1] = read_imm(desc);
 		if (op & 0x000fU) // reserved field?
 			desc.flags |= OPFLAG_INVALID_OPCODE;
 		describe_r(desc, op, false, true);
@@ -234,7 +236,7 @@ bool dsp16_device_base::frontend::describe_goto_b(opcode_desc &desc, u16 op)
 	if (op & 0x00ffU)
 		desc.flags |= OPFLAG_INVALID_OPCODE;
 	desc.targetpc = BRANCH_TARGET_DYNAMIC;
-	desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH;
+	desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
 	switch (op_b(op))
 	{
 	case 0x0: // return
@@ -264,7 +266,7 @@ bool dsp16_device_base::frontend::describe_goto_b(opcode_desc &desc, u16 op)
 bool dsp16_device_base::frontend::describe_if_con(opcode_desc &desc, u16 op)
 {
 	// look ahead and see if the next instruction can be predicated
-	u16 const next(read_imm(desc));
+	u16 const next(desc.opptr.w[1] = read_imm(desc));
 	switch (next >> 11)
 	{
 	case 0x00: // goto JA
@@ -277,7 +279,7 @@ bool dsp16_device_base::frontend::describe_if_con(opcode_desc &desc, u16 op)
 		{
 		case 0xe: // true
 			desc.targetpc = (desc.physpc & XAAU_I_EXT) | (op_ja(next) & XAAU_I_MASK);
-			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
 			if (BIT(next, 15))
 				flag_output_reg(desc, REG_BIT_XAAU_PR);
 			break;
@@ -294,7 +296,6 @@ bool dsp16_device_base::frontend::describe_if_con(opcode_desc &desc, u16 op)
 	case 0x18: // goto B
 		desc.cycles = 3U;
 		desc.length = 2U;
-		if (op_b(next) == 0x1)
 		switch (op_b(next))
 		{
 		case 0x0: // return
@@ -312,7 +313,7 @@ bool dsp16_device_base::frontend::describe_if_con(opcode_desc &desc, u16 op)
 		if (op_b(next) == 0x1) // can't predicate ireturn?
 		{
 			desc.targetpc = BRANCH_TARGET_DYNAMIC;
-			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_CAN_CHANGE_MODES; // FIXME: confirm appropriate flags
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES; // FIXME: confirm appropriate flags
 			flag_input_reg(desc, REG_BIT_XAAU_PI);
 		}
 		else
@@ -321,7 +322,7 @@ bool dsp16_device_base::frontend::describe_if_con(opcode_desc &desc, u16 op)
 			{
 			case 0xe: // true
 				desc.targetpc = BRANCH_TARGET_DYNAMIC;
-				desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH;
+				desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
 				switch (op_b(next))
 				{
 				case 0x0: // return
@@ -374,7 +375,7 @@ bool dsp16_device_base::frontend::describe_icall(opcode_desc &desc, u16 op)
 	{
 	case 0xe: // true
 		desc.targetpc = 0x0002U;
-		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_CAN_CHANGE_MODES; // FIXME: confirm appropriate flags
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE | OPFLAG_CAN_CHANGE_MODES; // FIXME: confirm appropriate flags
 		break;
 	case 0xf: // false
 		break;
@@ -407,142 +408,142 @@ bool dsp16_device_base::frontend::describe_do(opcode_desc &desc, u16 op)
 		case 0x04: // F1 ; Y = a1[l]
 		case 0x1c: // F1 ; Y = a0[l]
 			romcycles = cachecycles = 2U;
-			flag_input_reg(desc, BIT(op, 14) ? REG_BIT_DAU_A0 : REG_BIT_DAU_A1, REG_BIT_DAU_AUC);
-			describe_f1(desc, op);
-			describe_y(desc, op, false, true);
+			flag_input_reg(desc, BIT(next, 14) ? REG_BIT_DAU_A0 : REG_BIT_DAU_A1, REG_BIT_DAU_AUC);
+			describe_f1(desc, next);
+			describe_y(desc, next, false, true);
 			break;
 
 		case 0x05: // F1 ; Z : aT[l]
 			romcycles = cachecycles = 2U;
-			flag_input_reg(desc, op_d(op) ? REG_BIT_DAU_A0 : REG_BIT_DAU_A1, REG_BIT_DAU_AUC);
-			flag_output_reg(desc, op_d(op) ? REG_BIT_DAU_A0 : REG_BIT_DAU_A1, REG_BIT_DAU_PSW);
-			describe_f1(desc, op);
-			describe_z(desc, op);
+			flag_input_reg(desc, op_d(next) ? REG_BIT_DAU_A0 : REG_BIT_DAU_A1, REG_BIT_DAU_AUC);
+			flag_output_reg(desc, op_d(next) ? REG_BIT_DAU_A0 : REG_BIT_DAU_A1, REG_BIT_DAU_PSW);
+			describe_f1(desc, next);
+			describe_z(desc, next);
 			break;
 
 		case 0x06: // F1 ; Y
 			romcycles = cachecycles = 1U;
-			describe_f1(desc, op);
-			describe_y(desc, op, bool(m_host.machine().debug_flags & DEBUG_FLAG_ENABLED), false); // only read memory for watchpoints
+			describe_f1(desc, next);
+			describe_y(desc, next, bool(m_host.machine().debug_flags & DEBUG_FLAG_ENABLED), false); // only read memory for watchpoints
 			break;
 
 		case 0x07: // F1 ; aT[l] = Y
 			romcycles = cachecycles = 1U;
-			flag_output_reg(desc, op_d(op) ? REG_BIT_DAU_A0 : REG_BIT_DAU_A1, REG_BIT_DAU_PSW);
-			describe_f1(desc, op);
-			describe_y(desc, op, true, false);
+			flag_output_reg(desc, op_d(next) ? REG_BIT_DAU_A0 : REG_BIT_DAU_A1, REG_BIT_DAU_PSW);
+			describe_f1(desc, next);
+			describe_y(desc, next, true, false);
 			break;
 
 		case 0x08: // aT = R
 			romcycles = cachecycles = 2U;
-			if (op & 0x000fU) // reserved field?
+			if (next & 0x000fU) // reserved field?
 				desc.flags |= OPFLAG_INVALID_OPCODE;
-			flag_output_reg(desc, op_d(op) ? REG_BIT_DAU_A0 : REG_BIT_DAU_A1, REG_BIT_DAU_PSW);
-			describe_r(desc, op, true, false);
+			flag_output_reg(desc, op_d(next) ? REG_BIT_DAU_A0 : REG_BIT_DAU_A1, REG_BIT_DAU_PSW);
+			describe_r(desc, next, true, false);
 			break;
 
 		case 0x09: // R = a0
 		case 0x0b: // R = a1
 			romcycles = cachecycles = 2U;
-			if (op & 0x000fU) // reserved field?
+			if (next & 0x000fU) // reserved field?
 				desc.flags |= OPFLAG_INVALID_OPCODE;
-			flag_input_reg(desc, BIT(op, 12) ? REG_BIT_DAU_A1 : REG_BIT_DAU_A0, REG_BIT_DAU_AUC);
-			describe_r(desc, op, false, true);
+			flag_input_reg(desc, BIT(next, 12) ? REG_BIT_DAU_A1 : REG_BIT_DAU_A0, REG_BIT_DAU_AUC);
+			describe_r(desc, next, false, true);
 			break;
 
 		case 0x0c: // Y = R
 			romcycles = cachecycles = 2U;
-			if (op & 0x0400U) // reserved field?
+			if (next & 0x0400U) // reserved field?
 				desc.flags |= OPFLAG_INVALID_OPCODE;
-			describe_r(desc, op, true, false);
-			describe_y(desc, op, false, true);
+			describe_r(desc, next, true, false);
+			describe_y(desc, next, false, true);
 			break;
 
 		case 0x0d: // Z : R
 			romcycles = cachecycles = 2U;
-			describe_r(desc, op, true, true);
-			describe_z(desc, op);
+			describe_r(desc, next, true, true);
+			describe_z(desc, next);
 			break;
 
 		case 0x0f: // R = Y
 			romcycles = cachecycles = 2U;
-			if (op & 0x0400U) // reserved field?
+			if (next & 0x0400U) // reserved field?
 				desc.flags |= OPFLAG_INVALID_OPCODE;
-			describe_r(desc, op, false, true);
-			describe_y(desc, op, true, false);
+			describe_r(desc, next, false, true);
+			describe_y(desc, next, true, false);
 			break;
 
 		case 0x12: // ifc CON F2
 			romcycles = cachecycles = 1U;
 			flag_input_reg(desc, REG_BIT_DAU_C1);
 			flag_output_reg(desc, REG_BIT_DAU_C1, REG_BIT_DAU_C2);
-			describe_con(desc, op, false);
-			describe_f2(desc, op);
+			describe_con(desc, next, false);
+			describe_f2(desc, next);
 			break;
 
 		case 0x13: // if CON F2
 			romcycles = cachecycles = 1U;
-			describe_con(desc, op, true);
-			describe_f2(desc, op);
+			describe_con(desc, next, true);
+			describe_f2(desc, next);
 			break;
 
 		case 0x14: // F1 ; Y = y[l]
 			romcycles = cachecycles = 2U;
 			flag_input_reg(desc, REG_BIT_DAU_Y);
-			describe_f1(desc, op);
-			describe_y(desc, op, false, true);
+			describe_f1(desc, next);
+			describe_y(desc, next, false, true);
 			break;
 
 		case 0x15: // F1 ; Z : y[l]
 			romcycles = cachecycles = 2U;
 			flag_input_reg(desc, REG_BIT_DAU_Y);
 			flag_output_reg(desc, REG_BIT_DAU_Y);
-			describe_f1(desc, op);
-			describe_z(desc, op);
+			describe_f1(desc, next);
+			describe_z(desc, next);
 			break;
 
 		case 0x16: // F1 ; x = Y
 			romcycles = cachecycles = 1U;
 			flag_output_reg(desc, REG_BIT_DAU_X);
-			describe_f1(desc, op);
-			describe_y(desc, op, true, false);
+			describe_f1(desc, next);
+			describe_y(desc, next, true, false);
 			break;
 
 		case 0x17: // F1 ; y[l] = Y
 			romcycles = cachecycles = 1U;
 			flag_output_reg(desc, REG_BIT_DAU_Y);
-			describe_f1(desc, op);
-			describe_y(desc, op, true, false);
+			describe_f1(desc, next);
+			describe_y(desc, next, true, false);
 			break;
 
 		case 0x19: // F1 ; y = a0 ; x = *pt++[i]
 		case 0x1b: // F1 ; y = a1 ; x = *pt++[i]
 			romcycles = 2U;
 			cachecycles = 1U;
-			if (op & 0x000fU)
+			if (next & 0x000fU)
 				desc.flags |= OPFLAG_INVALID_OPCODE;
-			flag_input_reg(desc, BIT(op, 12) ? REG_BIT_DAU_A1 : REG_BIT_DAU_A0, REG_BIT_DAU_AUC);
+			flag_input_reg(desc, BIT(next, 12) ? REG_BIT_DAU_A1 : REG_BIT_DAU_A0, REG_BIT_DAU_AUC);
 			flag_output_reg(desc, REG_BIT_DAU_Y);
-			describe_f1(desc, op);
-			describe_x(desc, op);
+			describe_f1(desc, next);
+			describe_x(desc, next);
 			break;
 
 		case 0x1d: // F1 ; Z : y ; x = *pt++[i]
 			romcycles = cachecycles = 2U;
 			flag_input_reg(desc, REG_BIT_DAU_Y);
 			flag_output_reg(desc, REG_BIT_DAU_Y);
-			describe_f1(desc, op);
-			describe_x(desc, op);
-			describe_z(desc, op);
+			describe_f1(desc, next);
+			describe_x(desc, next);
+			describe_z(desc, next);
 			break;
 
 		case 0x1f: // F1 ; y = Y ; x = *pt++[i]
 			romcycles = 2U;
 			cachecycles = 1U;
 			flag_output_reg(desc, REG_BIT_DAU_Y);
-			describe_f1(desc, op);
-			describe_x(desc, op);
-			describe_y(desc, op, true, false);
+			describe_f1(desc, next);
+			describe_x(desc, next);
+			describe_y(desc, next, true, false);
 			break;
 
 		case 0x00: // goto JA
@@ -680,7 +681,8 @@ void dsp16_device_base::frontend::describe_con(opcode_desc &desc, u16 op, bool i
 		flag_input_reg(desc, REG_BIT_DAU_PSW);
 		break;
 	case 0x4: // heads/tails
-		throw emu_fatalerror("DSP16: unimplemented CON value %02X (PC = %04X)\n", con, desc.physpc);
+		desc.flags |= OPFLAG_INVALID_OPCODE; // unimplemented - leave it to the interpreter to complain if it's actually reached
+		break;
 	case 0x5: // c0ge/c0lt
 	case 0x6: // c1ge/c1lt
 		{
@@ -4,6 +4,15 @@
 
     WE|AT&T DSP16 series recompiler
 
+    Code is compiled separately for each IACK state (UML mode 1 is
+    normal operation, mode 0 is servicing an interrupt), so tracking PI
+    and checking for interrupts is resolved at translation time.
+    Anything that enters or leaves interrupt service mode, an
+    interrupt being taken, and redo K are left to the interpreter,
+    which hands back at the next instruction boundary.  The serial and
+    parallel ports are stepped every machine cycle, the same as the
+    interpreter, so peripheral timing is unchanged.
+
     There are a number of easy optimisations:
     * The RAM space is entirely internal, so the memory system can be
       bypassed if debugging is not enabled.
@@ -30,7 +39,7 @@
 
 #include "emu.h"
 #include "dsp16rc.h"
-#include "dsp16core.h"
+#include "dsp16core.ipp"
 
 #include "cpu/drcumlsh.h"
 
@@ -44,6 +53,12 @@ dsp16_device_base::recompiler::recompiler(dsp16_device_base &host, u32 flags)
 	, m_core(*host.m_core)
 	, m_frontend(host, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE)
 	, m_uml(host, host.m_drc_cache, flags, 2, 16, 0)
+	, m_entry(nullptr)
+	, m_nocode(nullptr)
+	, m_out_of_cycles(nullptr)
+	, m_arg_op(0U)
+	, m_arg_value(0U)
+	, m_cache_dirty(true)
 {
 	m_uml.symbol_add(&m_core.xaau_pc, sizeof(m_core.xaau_pc), "pc");
 	m_uml.symbol_add(&m_core.xaau_pt, sizeof(m_core.xaau_pt), "pt");
@@ -72,9 +87,1215 @@ dsp16_device_base::recompiler::recompiler(dsp16_device_base &host, u32 flags)
 	m_uml.symbol_add(&m_core.dau_psw, sizeof(m_core.dau_psw), "psw");
 	m_uml.symbol_add(&m_core.dau_temp, sizeof(m_core.dau_temp), "temp");
 
-	(void)m_host;
+	m_uml.symbol_add(&m_core.icount, sizeof(m_core.icount), "icount");
 }
 
 dsp16_device_base::recompiler::~recompiler()
 {
 }
+
+/***********************************************************************
+    execution
+***********************************************************************/
+
+bool dsp16_device_base::recompiler::execute_run()
+{
+	if (m_cache_dirty)
+		flush_cache();
+
+	for (;;)
+	{
+		switch (m_uml.execute(*m_entry))
+		{
+		case EXEC_OUT_OF_CYCLES:
+			synchronise();
+			return false;
+		case EXEC_INTERPRET:
+			synchronise();
+			return true;
+		case EXEC_MISSING_CODE:
+			compile_block(m_host.m_iack_out, m_core.xaau_pc);
+			break;
+		case EXEC_UNMAPPED_CODE:
+			throw emu_fatalerror("DSP16: attempted to execute unmapped code (PC = %04X)\n", m_core.xaau_pc);
+		case EXEC_RESET_CACHE:
+			flush_cache();
+			break;
+		}
+	}
+}
+
+void dsp16_device_base::recompiler::synchronise()
+{
+	// generated code always leaves at an instruction boundary with nothing pending
+	m_host.m_cache[m_host.m_cache_ptr = 0U] = m_host.m_pcache.read_word(m_core.xaau_pc);
+	m_host.m_st_pcbase = m_core.xaau_pc;
+}
+
+/***********************************************************************
+    helpers called from generated code
+***********************************************************************/
+
+void dsp16_device_base::recompiler::cfunc_sio_step(void *param)
+{
+	reinterpret_cast<recompiler *>(param)->m_host.sio_step();
+}
+
+void dsp16_device_base::recompiler::cfunc_pio_step(void *param)
+{
+	reinterpret_cast<recompiler *>(param)->m_host.pio_step();
+}
+
+void dsp16_device_base::recompiler::cfunc_get_r(void *param)
+{
+	recompiler &rc(*reinterpret_cast<recompiler *>(param));
+	rc.m_arg_value = rc.m_host.get_r(rc.m_arg_op);
+}
+
+void dsp16_device_base::recompiler::cfunc_set_r(void *param)
+{
+	recompiler &rc(*reinterpret_cast<recompiler *>(param));
+	rc.m_host.set_r(rc.m_arg_op, rc.m_arg_value);
+}
+
+void dsp16_device_base::recompiler::cfunc_dau_f1(void *param)
+{
+	recompiler &rc(*reinterpret_cast<recompiler *>(param));
+	rc.m_core.op_dau_ad(rc.m_arg_op) = rc.m_core.dau_f1(rc.m_arg_op);
+}
+
+void dsp16_device_base::recompiler::cfunc_dau_f1_y_a(void *param)
+{
+	recompiler &rc(*reinterpret_cast<recompiler *>(param));
+	core_state &core(rc.m_core);
+	u16 const op(rc.m_arg_op);
+	s64 const d(core.dau_f1(op));
+	core.dau_y = u32(u64(core.dau_a[BIT(op, 12)]));
+	core.op_dau_ad(op) = d;
+}
+
+void dsp16_device_base::recompiler::cfunc_dau_con_f2(void *param)
+{
+	recompiler &rc(*reinterpret_cast<recompiler *>(param));
+	core_state &core(rc.m_core);
+	u16 const op(rc.m_arg_op);
+	if (BIT(op, 11)) // if CON F2
+	{
+		if (rc.m_host.op_dau_con(op, true))
+			core.dau_f2(op);
+	}
+	else // ifc CON F2
+	{
+		bool const con(rc.m_host.op_dau_con(op, false));
+		++core.dau_c[1];
+		if (con)
+		{
+			core.dau_f2(op);
+			core.dau_c[2] = core.dau_c[1];
+		}
+	}
+}
+
+void dsp16_device_base::recompiler::cfunc_read_pt(void *param)
+{
+	recompiler &rc(*reinterpret_cast<recompiler *>(param));
+	rc.m_host.m_rom_data = rc.m_host.m_pcache.read_word(rc.m_core.xaau_pt);
+}
+
+/***********************************************************************
+    cache management
+***********************************************************************/
+
+void dsp16_device_base::recompiler::flush_cache()
+{
+	// empty the transient cache contents
+	m_uml.reset();
+	m_cache_dirty = false;
+
+	try
+	{
+		// generate the entry point and exception handlers
+		static_generate_entry_point();
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		throw emu_fatalerror("DSP16: error generating recompiler static handlers\n");
+	}
+}
+
+void dsp16_device_base::recompiler::compile_block(u8 mode, u16 pc)
+{
+	// describe the block
+	opcode_desc const *const desclist(m_frontend.describe_code(pc));
+
+	bool override(false);
+	for (;;)
+	{
+		try
+		{
+			compiler_state compiler{ mode, 0U, 1U, pc };
+			opcode_desc const *seqlast;
+
+			drcuml_block &block(m_uml.begin_block(COMPILE_MAX_INSTRUCTIONS * 256));
+
+			for (opcode_desc const *seqhead = desclist; seqhead; seqhead = seqlast->next())
+			{
+				// determine the last instruction in this sequence
+				for (seqlast = seqhead; seqlast; seqlast = seqlast->next())
+				{
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				}
+				assert(seqlast);
+
+				// if we don't have a hash for this mode/pc, or if we are overriding all, add one
+				if (override || !m_uml.hash_exists(mode, seqhead->pc))
+				{
+					UML_HASH(block, mode, seqhead->pc);                                             // hash    mode,seqhead->pc
+				}
+				else if (seqhead == desclist)
+				{
+					// if we already have a hash, and this is the first sequence, assume that we
+					// are recompiling due to being out of sync and allow future overrides
+					override = true;
+					UML_HASH(block, mode, seqhead->pc);                                             // hash    mode,seqhead->pc
+				}
+				else
+				{
+					// otherwise, redispatch to that fixed PC and skip the rest of the processing
+					UML_LABEL(block, seqhead->pc | 0x80000000);                                     // label   seqhead->pc
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);                               // hashjmp mode,seqhead->pc,nocode
+					continue;
+				}
+
+				// label this instruction, if it may be jumped to locally
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                                     // label   seqhead->pc
+
+				// iterate over instructions in the sequence and compile them
+				for (opcode_desc const *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					generate_sequence_instruction(block, compiler, *curdesc);
+
+					// the frontend doesn't know the PC wraps within a 4K page
+					u16 const nextpc(fallthrough_pc(*curdesc));
+					if ((curdesc != seqlast) && (curdesc->next()->pc != nextpc))
+					{
+						generate_update_cycles(block, compiler, nextpc);                                // <subtract cycles>
+						UML_HASHJMP(block, mode, nextpc, *m_nocode);                                // hashjmp mode,nextpc,nocode
+					}
+				}
+
+				// count off cycles and go to the next instruction
+				u16 const nextpc(fallthrough_pc(*seqlast));
+				generate_update_cycles(block, compiler, nextpc);                                        // <subtract cycles>
+				if (!seqlast->next() || (seqlast->next()->pc != nextpc))
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);                                    // hashjmp mode,nextpc,nocode
+			}
+
+			block.end();
+			return;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			flush_cache();
+		}
+	}
+}
+
+u16 dsp16_device_base::recompiler::fallthrough_pc(opcode_desc const &desc)
+{
+	u16 pc(desc.pc);
+	for (unsigned i = 0; desc.length > i; ++i)
+		pc = next_pc(pc);
+	return pc;
+}
+
+/***********************************************************************
+    static subroutines
+***********************************************************************/
+
+void dsp16_device_base::recompiler::static_generate_entry_point()
+{
+	drcuml_block &block(m_uml.begin_block(20));
+
+	// forward references
+	if (!m_nocode)
+		m_nocode = m_uml.handle_alloc("nocode");
+	if (!m_out_of_cycles)
+		m_out_of_cycles = m_uml.handle_alloc("out_of_cycles");
+
+	if (!m_entry)
+		m_entry = m_uml.handle_alloc("entry");
+	UML_HANDLE(block, *m_entry);                                                                    // handle  entry
+
+	// generate a hash jump via the current PC in the current IACK mode
+	UML_LOAD(block, I0, &m_core.xaau_pc, 0, SIZE_WORD, SCALE_x1);                                   // load    i0,[pc]
+	UML_LOAD(block, I1, &m_host.m_iack_out, 0, SIZE_BYTE, SCALE_x1);                                // load    i1,[iack_out]
+	UML_HASHJMP(block, I1, I0, *m_nocode);                                                          // hashjmp i1,i0,nocode
+
+	block.end();
+}
+
+void dsp16_device_base::recompiler::static_generate_nocode_handler()
+{
+	drcuml_block &block(m_uml.begin_block(10));
+
+	UML_HANDLE(block, *m_nocode);                                                                   // handle  nocode
+	UML_GETEXP(block, I0);                                                                          // getexp  i0
+	UML_STORE(block, &m_core.xaau_pc, 0, I0, SIZE_WORD, SCALE_x1);                                  // store   [pc],i0
+	UML_EXIT(block, EXEC_MISSING_CODE);                                                             // exit    EXEC_MISSING_CODE
+
+	block.end();
+}
+
+void dsp16_device_base::recompiler::static_generate_out_of_cycles()
+{
+	drcuml_block &block(m_uml.begin_block(10));
+
+	UML_HANDLE(block, *m_out_of_cycles);                                                            // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                                          // getexp  i0
+	UML_STORE(block, &m_core.xaau_pc, 0, I0, SIZE_WORD, SCALE_x1);                                  // store   [pc],i0
+	UML_EXIT(block, EXEC_OUT_OF_CYCLES);                                                            // exit    EXEC_OUT_OF_CYCLES
+
+	block.end();
+}
+
+/***********************************************************************
+    sequencing
+***********************************************************************/
+
+void dsp16_device_base::recompiler::generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param)
+{
+	// like the interpreter, stop once the count isn't positive
+	if (compiler.cycles)
+	{
+		UML_SUB(block, mem(&m_core.icount), mem(&m_core.icount), compiler.cycles);                  // sub     [icount],[icount],cycles
+		UML_EXHc(block, COND_LE, *m_out_of_cycles, param);                                          // exh     out_of_cycles,param
+	}
+	compiler.cycles = 0U;
+}
+
+void dsp16_device_base::recompiler::generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, opcode_desc const &desc)
+{
+	u16 const op(desc.opptr.w[0]);
+	compiler.pcbase = desc.pc;
+
+	// leave anything that changes modes, or isn't understood, to the interpreter
+	bool interpret(desc.flags & OPFLAG_INVALID_OPCODE);
+	switch (op >> 11)
+	{
+	case 0x0e: // redo K
+		interpret = interpret || !op_ni(op);
+		break;
+	case 0x18: // ireturn
+		interpret = interpret || (0x1 == op_b(op));
+		break;
+	case 0x1a: // icall, if CON ireturn
+		interpret = interpret || BIT(op, 10) || ((0x18 == (desc.opptr.w[1] >> 11)) && (0x1 == op_b(desc.opptr.w[1])));
+		break;
+	}
+	if (interpret)
+	{
+		generate_interpret(block, compiler, desc.pc);
+		return;
+	}
+
+	switch (op >> 11)
+	{
+	case 0x00: // goto JA
+	case 0x01:
+	case 0x10: // call JA
+	case 0x11:
+	case 0x18: // goto B
+		generate_begin_op(block, compiler, desc.pc, false);
+		generate_branch(block, compiler, desc, op, next_pc(desc.pc));
+		break;
+
+	case 0x0a: // R = N
+		generate_begin_op(block, compiler, desc.pc, compiler.mode);
+		generate_cycle(block, compiler);
+		generate_set_pc(block, compiler, next_pc(next_pc(desc.pc)));
+		UML_MOV(block, I0, desc.opptr.w[1]);                                                        // mov     i0,N
+		generate_set_r(block, compiler, op);
+		generate_cycle(block, compiler);
+		break;
+
+	case 0x0e: // do K { instr1...instrNI }
+		generate_begin_op(block, compiler, desc.pc, false);
+		generate_do(block, compiler, desc);
+		break;
+
+	case 0x1a: // if CON
+		{
+			// the condition takes a cycle of its own, and predicates the branch that follows
+			u16 const next(desc.opptr.w[1]);
+			u16 const branchpc(next_pc(desc.pc));
+			generate_begin_op(block, compiler, desc.pc, false);
+			generate_cycle(block, compiler);
+			compiler.pcbase = branchpc;
+			generate_begin_op(block, compiler, branchpc, false);
+			switch (op_con(op))
+			{
+			case 0xe: // true
+				generate_branch(block, compiler, desc, next, next_pc(branchpc));
+				break;
+			case 0xf: // false
+				generate_cycle(block, compiler);
+				generate_cycle(block, compiler);
+				break;
+			default:
+				{
+					// the peripherals can't see the DAU state, so the condition can be tested after stepping them
+					uml::code_label const skip(compiler.labelnum++);
+					generate_con(block, compiler, op, true, skip);
+					compiler_state taken(compiler);
+					generate_branch(block, taken, desc, next, next_pc(branchpc));
+					compiler.labelnum = taken.labelnum;
+					UML_LABEL(block, skip);                                                         // skip:
+					generate_cycle(block, compiler);
+					generate_cycle(block, compiler);
+				}
+			}
+		}
+		break;
+
+	default:
+		generate_begin_op(block, compiler, desc.pc, compiler.mode && op_interruptible(op));
+		generate_data_op(block, compiler, op, context::ROM);
+		generate_cycle(block, compiler);
+	}
+}
+
+void dsp16_device_base::recompiler::generate_interpret(drcuml_block &block, compiler_state &compiler, u16 pc)
+{
+	generate_update_cycles(block, compiler, pc);                                                    // <subtract cycles>
+	UML_STORE(block, &m_core.xaau_pc, 0, pc, SIZE_WORD, SCALE_x1);                                  // store   [pc],pc
+	UML_EXIT(block, EXEC_INTERPRET);                                                                // exit    EXEC_INTERPRET
+}
+
+void dsp16_device_base::recompiler::generate_interrupt_check(drcuml_block &block, compiler_state &compiler, u16 pc)
+{
+	// the interpreter takes care of servicing the interrupt
+	uml::code_label const take(compiler.labelnum++);
+	uml::code_label const skip(compiler.labelnum++);
+	UML_LOAD(block, I0, &m_host.m_int_enable[0], 0, SIZE_BYTE, SCALE_x1);                           // load    i0,[int_enable0]
+	UML_LOAD(block, I1, &m_host.m_pio_pioc, 0, SIZE_WORD, SCALE_x1);                                // load    i1,[pioc]
+	UML_AND(block, I1, I1, I0);                                                                     // and     i1,i1,i0
+	UML_TEST(block, I1, 0x001e);                                                                    // test    i1,0x001e
+	UML_JMPc(block, COND_NZ, take);                                                                 // jnz     take
+	UML_TEST(block, I0, 0x0001);                                                                    // test    i0,0x0001
+	UML_JMPc(block, COND_Z, skip);                                                                  // jz      skip
+	UML_LOAD(block, I1, &m_host.m_int_in, 0, SIZE_BYTE, SCALE_x1);                                  // load    i1,[int_in]
+	UML_CMP(block, I1, CLEAR_LINE);                                                                 // cmp     i1,CLEAR_LINE
+	UML_JMPc(block, COND_E, skip);                                                                  // je      skip
+	UML_LABEL(block, take);                                                                         // take:
+	compiler_state interrupt(compiler);
+	generate_interpret(block, interrupt, pc);
+	UML_LABEL(block, skip);                                                                         // skip:
+}
+
+void dsp16_device_base::recompiler::generate_begin_op(drcuml_block &block, compiler_state &compiler, u16 pc, bool check_interrupts)
+{
+	if (check_interrupts)
+		generate_interrupt_check(block, compiler, pc);
+	generate_int_enable(block);
+	generate_set_pc(block, compiler, next_pc(pc));
+}
+
+void dsp16_device_base::recompiler::generate_int_enable(drcuml_block &block)
+{
+	UML_LOAD(block, I0, &m_host.m_int_enable[1], 0, SIZE_BYTE, SCALE_x1);                           // load    i0,[int_enable1]
+	UML_STORE(block, &m_host.m_int_enable[0], 0, I0, SIZE_BYTE, SCALE_x1);                          // store   [int_enable0],i0
+}
+
+void dsp16_device_base::recompiler::generate_set_pc(drcuml_block &block, compiler_state &compiler, uml::parameter pc)
+{
+	// PI follows PC unless an interrupt is being serviced
+	UML_STORE(block, &m_core.xaau_pc, 0, pc, SIZE_WORD, SCALE_x1);                                  // store   [pc],pc
+	if (compiler.mode)
+		UML_STORE(block, &m_core.xaau_pi, 0, pc, SIZE_WORD, SCALE_x1);                              // store   [pi],pc
+}
+
+void dsp16_device_base::recompiler::generate_cycle(drcuml_block &block, compiler_state &compiler)
+{
+	uml::code_label const sio_clock(compiler.labelnum++);
+	uml::code_label const pio(compiler.labelnum++);
+	uml::code_label const done(compiler.labelnum++);
+
+	// the serial I/O clock divider usually just needs to count down
+	UML_LOAD(block, I0, &m_host.m_sio_clk_div, 0, SIZE_BYTE, SCALE_x1);                             // load    i0,[sio_clk_div]
+	UML_SUB(block, I0, I0, 1);                                                                      // sub     i0,i0,1
+	UML_JMPc(block, COND_C, sio_clock);                                                             // jc      sio_clock
+	UML_STORE(block, &m_host.m_sio_clk_div, 0, I0, SIZE_BYTE, SCALE_x1);                            // store   [sio_clk_div],i0
+	UML_JMP(block, pio);                                                                            // jmp     pio
+	UML_LABEL(block, sio_clock);                                                                    // sio_clock:
+	UML_CALLC(block, &cfunc_sio_step, this);                                                        // callc   sio_step,this
+
+	// the parallel I/O strobes only need attention while active
+	UML_LABEL(block, pio);                                                                          // pio:
+	UML_LOAD(block, I0, &m_host.m_pio_pids_cnt, 0, SIZE_BYTE, SCALE_x1);                            // load    i0,[pio_pids_cnt]
+	UML_LOAD(block, I1, &m_host.m_pio_pods_cnt, 0, SIZE_BYTE, SCALE_x1);                            // load    i1,[pio_pods_cnt]
+	UML_OR(block, I0, I0, I1);                                                                      // or      i0,i0,i1
+	UML_JMPc(block, COND_Z, done);                                                                  // jz      done
+	UML_CALLC(block, &cfunc_pio_step, this);                                                        // callc   pio_step,this
+	UML_LABEL(block, done);                                                                         // done:
+
+	++compiler.cycles;
+}
+
+void dsp16_device_base::recompiler::generate_branch(drcuml_block &block, compiler_state &compiler, opcode_desc const &desc, u16 op, u16 pc)
+{
+	// pc is the address following the branch instruction
+	switch (op >> 11)
+	{
+	case 0x00: // goto JA
+	case 0x01:
+	case 0x10: // call JA
+	case 0x11:
+		{
+			u16 const target((pc & XAAU_I_EXT) | op_ja(op));
+			if (BIT(op, 15))
+				UML_STORE(block, &m_core.xaau_pr, 0, pc, SIZE_WORD, SCALE_x1);                      // store   [pr],pc
+			generate_set_pc(block, compiler, target);
+			generate_cycle(block, compiler);
+			generate_cycle(block, compiler);
+			generate_update_cycles(block, compiler, target);                                        // <subtract cycles>
+			if (desc.flags & OPFLAG_INTRABLOCK_BRANCH)
+				UML_JMP(block, target | 0x80000000);                                                // jmp     target
+			else
+				UML_HASHJMP(block, compiler.mode, target, *m_nocode);                               // hashjmp mode,target,nocode
+		}
+		break;
+
+	case 0x18: // goto B
+		switch (op_b(op))
+		{
+		case 0x0: // return
+			UML_LOAD(block, I0, &m_core.xaau_pr, 0, SIZE_WORD, SCALE_x1);                           // load    i0,[pr]
+			break;
+		case 0x2: // goto pt
+			UML_LOAD(block, I0, &m_core.xaau_pt, 0, SIZE_WORD, SCALE_x1);                           // load    i0,[pt]
+			break;
+		case 0x3: // call pt
+			UML_STORE(block, &m_core.xaau_pr, 0, pc, SIZE_WORD, SCALE_x1);                          // store   [pr],pc
+			UML_LOAD(block, I0, &m_core.xaau_pt, 0, SIZE_WORD, SCALE_x1);                           // load    i0,[pt]
+			break;
+		}
+		generate_set_pc(block, compiler, uml::I0);
+		generate_cycle(block, compiler);
+		generate_cycle(block, compiler);
+		UML_LOAD(block, I0, &m_core.xaau_pc, 0, SIZE_WORD, SCALE_x1);                               // load    i0,[pc]
+		generate_update_cycles(block, compiler, uml::I0);                                              // <subtract cycles>
+		UML_HASHJMP(block, compiler.mode, I0, *m_nocode);                                           // hashjmp mode,i0,nocode
+		break;
+
+	default:
+		throw emu_fatalerror("DSP16: op %u isn't a branch (PC = %04X)\n", op >> 11, desc.pc);
+	}
+}
+
+void dsp16_device_base::recompiler::generate_con(drcuml_block &block, compiler_state &compiler, u16 op, bool inc, uml::code_label if_false)
+{
+	u16 const con(op_con(op));
+	bool const invert(BIT(con, 0));
+	switch (con >> 1)
+	{
+	case 0x0: // mi/pl
+	case 0x1: // eq/ne
+	case 0x2: // lvs/lvc
+	case 0x3: // mvs/mvc
+		UML_LOAD(block, I0, &m_core.dau_psw, 0, SIZE_WORD, SCALE_x1);                               // load    i0,[psw]
+		UML_TEST(block, I0, 0x8000 >> (con >> 1));                                                  // test    i0,flag
+		UML_JMPc(block, invert ? COND_NZ : COND_Z, if_false);                                       // jz/jnz  if_false
+		break;
+	case 0x5: // c0ge/c0lt
+	case 0x6: // c1ge/c1lt
+		{
+			u8 const c((con >> 1) - 0x05);
+			UML_LOADS(block, I0, &m_core.dau_c[0], c, SIZE_BYTE, SCALE_x1);                         // loads   i0,[c]
+			if (inc)
+			{
+				UML_ADD(block, I1, I0, 1);                                                          // add     i1,i0,1
+				UML_STORE(block, &m_core.dau_c[0], c, I1, SIZE_BYTE, SCALE_x1);                     // store   [c],i1
+			}
+			UML_CMP(block, I0, 0);                                                                  // cmp     i0,0
+			UML_JMPc(block, invert ? COND_GE : COND_L, if_false);                                   // jl/jge  if_false
+		}
+		break;
+	case 0x7: // true/false
+		if (invert)
+			UML_JMP(block, if_false);                                                               // jmp     if_false
+		break;
+	case 0x8: // gt/le
+		UML_LOAD(block, I0, &m_core.dau_psw, 0, SIZE_WORD, SCALE_x1);                               // load    i0,[psw]
+		UML_TEST(block, I0, 0xc000);                                                                // test    i0,0xc000
+		UML_JMPc(block, invert ? COND_Z : COND_NZ, if_false);                                       // jnz/jz  if_false
+		break;
+	default: // heads/tails and reserved values are left to the interpreter
+		throw emu_fatalerror("DSP16: unexpected CON value %02X in recompiler (PC = %04X)\n", con, compiler.pcbase);
+	}
+}
+
+void dsp16_device_base::recompiler::generate_do(drcuml_block &block, compiler_state &compiler, opcode_desc const &desc)
+{
+	u16 const op(desc.opptr.w[0]);
+	u16 const ni(op_ni(op));
+	u16 const k(op_k(op));
+	u16 pc[16], ops[16];
+	pc[0] = desc.pc;
+	ops[0] = op;
+	for (u16 i = 1; ni >= i; ++i)
+	{
+		pc[i] = next_pc(pc[i - 1]);
+		ops[i] = m_host.m_pcache.read_word(pc[i]);
+	}
+
+	// redo K runs in the interpreter, so it needs to find the block in the cache
+	for (u16 i = 1; ni >= i; ++i)
+		UML_STORE(block, &m_host.m_cache[0], i, ops[i], SIZE_WORD, SCALE_x2);                       // store   [cache+i],op
+	UML_STORE(block, &m_host.m_cache_limit, 0, ni, SIZE_BYTE, SCALE_x1);                            // store   [cache_limit],ni
+	UML_STORE(block, &m_host.m_cache_pcbase, 0, desc.pc, SIZE_WORD, SCALE_x1);                      // store   [cache_pcbase],desc.pc
+	generate_cycle(block, compiler);
+
+	// instructions run with normal timings as they're loaded, but can't be interrupted
+	for (u16 i = 1; ni >= i; ++i)
+	{
+		compiler.pcbase = pc[i];
+		generate_begin_op(block, compiler, pc[i], false);
+		bool const two_cycles(generate_data_op(block, compiler, ops[i], context::ROM));
+		if (ni == i)
+		{
+			// the last instruction loaded always takes two cycles to allow a data fetch to be overlapped
+			if (!two_cycles)
+				generate_cycle(block, compiler);
+			generate_overlap_read(block, ops[1]);
+		}
+		generate_cycle(block, compiler);
+	}
+
+	// all but the final iteration from the cache
+	if (2U < k)
+	{
+		uml::code_label const loop(compiler.labelnum++);
+		UML_STORE(block, &m_host.m_cache_iterations, 0, k - 2, SIZE_BYTE, SCALE_x1);                // store   [cache_iterations],k-2
+		UML_LABEL(block, loop);                                                                     // loop:
+		u32 const start(compiler.cycles);
+		for (u16 i = 1; ni >= i; ++i)
+		{
+			compiler.pcbase = pc[i];
+			generate_int_enable(block);
+			generate_data_op(block, compiler, ops[i], context::CACHE);
+			generate_overlap_read(block, ops[(ni == i) ? 1 : (i + 1)]);
+			generate_cycle(block, compiler);
+		}
+		UML_LOAD(block, I0, &m_host.m_cache_iterations, 0, SIZE_BYTE, SCALE_x1);                    // load    i0,[cache_iterations]
+		UML_SUB(block, I0, I0, 1);                                                                  // sub     i0,i0,1
+		UML_STORE(block, &m_host.m_cache_iterations, 0, I0, SIZE_BYTE, SCALE_x1);                   // store   [cache_iterations],i0
+		UML_CMP(block, I0, 0);                                                                      // cmp     i0,0
+		UML_JMPc(block, COND_NE, loop);                                                             // jne     loop
+		compiler.cycles = start + ((compiler.cycles - start) * (k - 2));
+	}
+
+	// the last instruction of the final iteration has normal timings again
+	for (u16 i = 1; ni >= i; ++i)
+	{
+		compiler.pcbase = pc[i];
+		generate_int_enable(block);
+		if (ni != i)
+		{
+			generate_data_op(block, compiler, ops[i], context::CACHE);
+			generate_overlap_read(block, ops[i + 1]);
+		}
+		else
+		{
+			generate_data_op(block, compiler, ops[i], context::CACHE_LAST);
+		}
+		generate_cycle(block, compiler);
+	}
+}
+
+bool dsp16_device_base::recompiler::generate_data_op(drcuml_block &block, compiler_state &compiler, u16 op, context ctx)
+{
+	// returns true if the instruction needed a second cycle, which has been generated
+	switch (op >> 11)
+	{
+	case 0x02: // R = M
+	case 0x03:
+		generate_short_immediate(block, op);
+		return false;
+
+	case 0x04: // F1 ; Y = a1[l]
+	case 0x1c: // F1 ; Y = a0[l]
+		generate_cycle(block, compiler);
+		generate_saturate(block, compiler, BIT(~op, 14));
+		if (op_x(op))
+			UML_DSHR(block, I0, I0, 16);                                                            // dshr    i0,i0,16
+		generate_yaau_write(block, compiler, op);
+		generate_f1(block, op);
+		return true;
+
+	case 0x05: // F1 ; Z : aT[l]
+		generate_f1(block, op);
+		generate_saturate(block, compiler, op_d(~op));
+		if (op_x(op))
+			UML_DSHR(block, I0, I0, 16);                                                            // dshr    i0,i0,16
+		UML_STORE(block, &m_core.dau_temp, 0, I0, SIZE_WORD, SCALE_x1);                             // store   [temp],i0
+		generate_yaau_read(block, compiler, op);
+		generate_set_atx(block, compiler, op);
+		generate_cycle(block, compiler);
+		generate_yaau_write_z(block, compiler, op);
+		return true;
+
+	case 0x06: // F1 ; Y
+		generate_f1(block, op);
+		if (op & 0x0003U)
+		{
+			UML_LOAD(block, I1, &m_core.yaau_r[0], (op >> 2) & 0x0003U, SIZE_WORD, SCALE_x2);       // load    i1,[rN]
+			generate_yaau_postmodify(block, compiler, op);
+		}
+		return false;
+
+	case 0x07: // F1 ; aT[l] = Y
+		generate_f1(block, op);
+		generate_yaau_read(block, compiler, op);
+		generate_set_atx(block, compiler, op);
+		return false;
+
+	case 0x08: // aT = R
+		generate_get_r(block, compiler, op);
+		generate_set_at(block, compiler, op_d(~op));
+		generate_cycle(block, compiler);
+		return true;
+
+	case 0x09: // R = a0
+	case 0x0b: // R = a1
+		generate_saturate(block, compiler, BIT(op, 12));
+		UML_DSHR(block, I0, I0, 16);                                                                // dshr    i0,i0,16
+		generate_set_r(block, compiler, op);
+		generate_cycle(block, compiler);
+		return true;
+
+	case 0x0c: // Y = R
+		generate_cycle(block, compiler);
+		generate_get_r(block, compiler, op);
+		generate_yaau_write(block, compiler, op);
+		return true;
+
+	case 0x0d: // Z : R
+		generate_get_r(block, compiler, op);
+		UML_STORE(block, &m_core.dau_temp, 0, I0, SIZE_WORD, SCALE_x1);                             // store   [temp],i0
+		generate_yaau_read(block, compiler, op);
+		generate_set_r(block, compiler, op);
+		generate_cycle(block, compiler);
+		generate_yaau_write_z(block, compiler, op);
+		return true;
+
+	case 0x0f: // R = Y
+		generate_yaau_read(block, compiler, op);
+		generate_set_r(block, compiler, op);
+		generate_cycle(block, compiler);
+		return true;
+
+	case 0x12: // ifc CON F2
+	case 0x13: // if CON F2
+		UML_STORE(block, &m_arg_op, 0, op, SIZE_WORD, SCALE_x1);                                    // store   [arg_op],op
+		UML_CALLC(block, &cfunc_dau_con_f2, this);                                                  // callc   dau_con_f2,this
+		return false;
+
+	case 0x14: // F1 ; Y = y[l]
+		generate_f1(block, op);
+		generate_cycle(block, compiler);
+		generate_get_y(block, op);
+		generate_yaau_write(block, compiler, op);
+		return true;
+
+	case 0x15: // F1 ; Z : y[l]
+		generate_f1(block, op);
+		generate_get_y(block, op);
+		UML_STORE(block, &m_core.dau_temp, 0, I0, SIZE_WORD, SCALE_x1);                             // store   [temp],i0
+		generate_yaau_read(block, compiler, op);
+		generate_set_y(block, compiler, op_x(op));
+		generate_cycle(block, compiler);
+		generate_yaau_write_z(block, compiler, op);
+		return true;
+
+	case 0x16: // F1 ; x = Y
+		generate_f1(block, op);
+		generate_yaau_read(block, compiler, op);
+		UML_STORE(block, &m_core.dau_x, 0, I0, SIZE_WORD, SCALE_x1);                                // store   [x],i0
+		return false;
+
+	case 0x17: // F1 ; y[l] = Y
+		generate_f1(block, op);
+		generate_yaau_read(block, compiler, op);
+		generate_set_y(block, compiler, op_x(op));
+		return false;
+
+	case 0x19: // F1 ; y = a0 ; x = *pt++[i]
+	case 0x1b: // F1 ; y = a1 ; x = *pt++[i]
+	case 0x1f: // F1 ; y = Y ; x = *pt++[i]
+		if (0x1f == (op >> 11))
+		{
+			generate_f1(block, op);
+			generate_yaau_read(block, compiler, op);
+			generate_set_y(block, compiler, op_x(op));
+		}
+		else
+		{
+			generate_f1_y_a(block, op);
+		}
+		if (context::CACHE == ctx)
+		{
+			// the data was fetched while the previous instruction executed
+			generate_increment_pt(block, op);
+			generate_load_x_rom(block);
+			return false;
+		}
+		else
+		{
+			UML_CALLC(block, &cfunc_read_pt, this);                                                 // callc   read_pt,this
+			generate_cycle(block, compiler);
+			generate_increment_pt(block, op);
+			generate_load_x_rom(block);
+			return true;
+		}
+
+	case 0x1d: // F1 ; Z : y ; x = *pt++[i]
+		generate_f1(block, op);
+		UML_SHR(block, I0, mem(&m_core.dau_y), 16);                                                 // shr     i0,[y],16
+		UML_STORE(block, &m_core.dau_temp, 0, I0, SIZE_WORD, SCALE_x1);                             // store   [temp],i0
+		generate_yaau_read(block, compiler, op);
+		generate_set_y(block, compiler, true);
+		UML_CALLC(block, &cfunc_read_pt, this);                                                     // callc   read_pt,this
+		generate_cycle(block, compiler);
+		generate_increment_pt(block, op);
+		generate_load_x_rom(block);
+		generate_yaau_write_z(block, compiler, op);
+		return true;
+
+	default:
+		throw emu_fatalerror("DSP16: unexpected op %u in recompiler (PC = %04X)\n", op >> 11, compiler.pcbase);
+	}
+}
+
+void dsp16_device_base::recompiler::generate_overlap_read(drcuml_block &block, u16 op)
+{
+	switch (op >> 11)
+	{
+	case 0x19: // F1 ; y = a0 ; x = *pt++[i]
+	case 0x1b: // F1 ; y = a1 ; x = *pt++[i]
+	case 0x1f: // F1 ; y = Y ; x = *pt++[i]
+		UML_CALLC(block, &cfunc_read_pt, this);                                                     // callc   read_pt,this
+		break;
+	}
+}
+
+/***********************************************************************
+    sub-operations
+***********************************************************************/
+
+void dsp16_device_base::recompiler::generate_short_immediate(drcuml_block &block, u16 op)
+{
+	u16 const r((op >> 9) & 0x0007U);
+	u16 const m(op & 0x01ff);
+	switch (r)
+	{
+	case 0x0: // j
+	case 0x1: // k
+		{
+			u16 const value(m | ((m & m_core.yaau_sign) ? ~m_core.yaau_mask : 0));
+			UML_STORE(block, r ? &m_core.yaau_k : &m_core.yaau_j, 0, value, SIZE_WORD, SCALE_x1);   // store   [j/k],value
+		}
+		break;
+	case 0x2: // rb
+		UML_STORE(block, &m_core.yaau_rb, 0, m, SIZE_WORD, SCALE_x1);                               // store   [rb],m
+		break;
+	case 0x3: // re
+		UML_STORE(block, &m_core.yaau_re, 0, m, SIZE_WORD, SCALE_x1);                               // store   [re],m
+		break;
+	case 0x4: // r0
+	case 0x5: // r1
+	case 0x6: // r2
+	case 0x7: // r3
+		UML_STORE(block, &m_core.yaau_r[0], r & 0x0003U, m, SIZE_WORD, SCALE_x2);                   // store   [rN],m
+		break;
+	}
+}
+
+void dsp16_device_base::recompiler::generate_get_r(drcuml_block &block, compiler_state &compiler, u16 op)
+{
+	// leaves the value in the low 16 bits of I0
+	u16 const r(op_r(op));
+	switch (r)
+	{
+	case 0x00: // r0 (u)
+	case 0x01: // r1 (u)
+	case 0x02: // r2 (u)
+	case 0x03: // r3 (u)
+		UML_LOAD(block, I0, &m_core.yaau_r[0], r, SIZE_WORD, SCALE_x2);                             // load    i0,[rN]
+		break;
+	case 0x04: // j (s)
+		UML_LOAD(block, I0, &m_core.yaau_j, 0, SIZE_WORD, SCALE_x1);                                // load    i0,[j]
+		break;
+	case 0x05: // k (s)
+		UML_LOAD(block, I0, &m_core.yaau_k, 0, SIZE_WORD, SCALE_x1);                                // load    i0,[k]
+		break;
+	case 0x06: // rb (u)
+		UML_LOAD(block, I0, &m_core.yaau_rb, 0, SIZE_WORD, SCALE_x1);                               // load    i0,[rb]
+		break;
+	case 0x07: // re (u)
+		UML_LOAD(block, I0, &m_core.yaau_re, 0, SIZE_WORD, SCALE_x1);                               // load    i0,[re]
+		break;
+	case 0x08: // pt
+		UML_LOAD(block, I0, &m_core.xaau_pt, 0, SIZE_WORD, SCALE_x1);                               // load    i0,[pt]
+		break;
+	case 0x09: // pr
+		UML_LOAD(block, I0, &m_core.xaau_pr, 0, SIZE_WORD, SCALE_x1);                               // load    i0,[pr]
+		break;
+	case 0x0a: // pi
+		UML_LOAD(block, I0, &m_core.xaau_pi, 0, SIZE_WORD, SCALE_x1);                               // load    i0,[pi]
+		break;
+	case 0x0b: // i (s)
+		UML_LOAD(block, I0, &m_core.xaau_i, 0, SIZE_WORD, SCALE_x1);                                // load    i0,[i]
+		break;
+	case 0x10: // x
+		UML_LOAD(block, I0, &m_core.dau_x, 0, SIZE_WORD, SCALE_x1);                                 // load    i0,[x]
+		break;
+	case 0x11: // y
+		UML_SHR(block, I0, mem(&m_core.dau_y), 16);                                                 // shr     i0,[y],16
+		break;
+	case 0x12: // yl
+		UML_AND(block, I0, mem(&m_core.dau_y), 0xffff);                                             // and     i0,[y],0xffff
+		break;
+	case 0x13: // auc (u)
+		UML_LOAD(block, I0, &m_core.dau_auc, 0, SIZE_BYTE, SCALE_x1);                               // load    i0,[auc]
+		break;
+	case 0x15: // c0 (s)
+	case 0x16: // c1 (s)
+	case 0x17: // c2 (s)
+		UML_LOADS(block, I0, &m_core.dau_c[0], r - 0x15, SIZE_BYTE, SCALE_x1);                      // loads   i0,[cN]
+		break;
+	default: // psw and peripherals
+		UML_STORE(block, &m_host.m_st_pcbase, 0, compiler.pcbase, SIZE_WORD, SCALE_x1);             // store   [st_pcbase],pcbase
+		UML_STORE(block, &m_arg_op, 0, op, SIZE_WORD, SCALE_x1);                                    // store   [arg_op],op
+		UML_CALLC(block, &cfunc_get_r, this);                                                       // callc   get_r,this
+		UML_LOAD(block, I0, &m_arg_value, 0, SIZE_WORD, SCALE_x1);                                  // load    i0,[arg_value]
+		break;
+	}
+}
+
+void dsp16_device_base::recompiler::generate_set_r(drcuml_block &block, compiler_state &compiler, u16 op)
+{
+	// takes the value from the low 16 bits of I0
+	u16 const r(op_r(op));
+	switch (r)
+	{
+	case 0x00: // r0 (u)
+	case 0x01: // r1 (u)
+	case 0x02: // r2 (u)
+	case 0x03: // r3 (u)
+		UML_AND(block, I0, I0, m_core.yaau_mask);                                                   // and     i0,i0,yaau_mask
+		UML_STORE(block, &m_core.yaau_r[0], r, I0, SIZE_WORD, SCALE_x2);                            // store   [rN],i0
+		break;
+	case 0x04: // j (s)
+	case 0x05: // k (s)
+		if (0xffffU != m_core.yaau_mask)
+		{
+			uml::code_label const positive(compiler.labelnum++);
+			UML_AND(block, I1, I0, m_core.yaau_mask);                                               // and     i1,i0,yaau_mask
+			UML_TEST(block, I0, m_core.yaau_sign);                                                  // test    i0,yaau_sign
+			UML_JMPc(block, COND_Z, positive);                                                      // jz      positive
+			UML_OR(block, I1, I1, u16(~m_core.yaau_mask));                                          // or      i1,i1,~yaau_mask
+			UML_LABEL(block, positive);                                                             // positive:
+			UML_STORE(block, (0x04 == r) ? &m_core.yaau_j : &m_core.yaau_k, 0, I1, SIZE_WORD, SCALE_x1); // store   [j/k],i1
+		}
+		else
+		{
+			UML_STORE(block, (0x04 == r) ? &m_core.yaau_j : &m_core.yaau_k, 0, I0, SIZE_WORD, SCALE_x1); // store   [j/k],i0
+		}
+		break;
+	case 0x06: // rb (u)
+	case 0x07: // re (u)
+		UML_AND(block, I0, I0, m_core.yaau_mask);                                                   // and     i0,i0,yaau_mask
+		UML_STORE(block, (0x06 == r) ? &m_core.yaau_rb : &m_core.yaau_re, 0, I0, SIZE_WORD, SCALE_x1); // store   [rb/re],i0
+		break;
+	case 0x08: // pt
+		UML_STORE(block, &m_core.xaau_pt, 0, I0, SIZE_WORD, SCALE_x1);                              // store   [pt],i0
+		break;
+	case 0x09: // pr
+		UML_STORE(block, &m_core.xaau_pr, 0, I0, SIZE_WORD, SCALE_x1);                              // store   [pr],i0
+		break;
+	case 0x0a: // pi
+		// FIXME: reset PRNG
+		if (!compiler.mode)
+			UML_STORE(block, &m_core.xaau_pi, 0, I0, SIZE_WORD, SCALE_x1);                          // store   [pi],i0
+		break;
+	case 0x0b: // i (s)
+		{
+			uml::code_label const positive(compiler.labelnum++);
+			UML_AND(block, I1, I0, XAAU_I_MASK);                                                    // and     i1,i0,XAAU_I_MASK
+			UML_TEST(block, I0, XAAU_I_SIGN);                                                       // test    i0,XAAU_I_SIGN
+			UML_JMPc(block, COND_Z, positive);                                                      // jz      positive
+			UML_OR(block, I1, I1, u16(XAAU_I_EXT));                                                 // or      i1,i1,XAAU_I_EXT
+			UML_LABEL(block, positive);                                                             // positive:
+			UML_STORE(block, &m_core.xaau_i, 0, I1, SIZE_WORD, SCALE_x1);                           // store   [i],i1
+		}
+		break;
+	case 0x10: // x
+		UML_STORE(block, &m_core.dau_x, 0, I0, SIZE_WORD, SCALE_x1);                                // store   [x],i0
+		break;
+	case 0x11: // y
+		generate_set_y(block, compiler, true);
+		break;
+	case 0x12: // yl
+		generate_set_y(block, compiler, false);
+		break;
+	case 0x13: // auc (u)
+		UML_AND(block, I0, I0, 0x007f);                                                             // and     i0,i0,0x7f
+		UML_STORE(block, &m_core.dau_auc, 0, I0, SIZE_BYTE, SCALE_x1);                              // store   [auc],i0
+		break;
+	case 0x15: // c0 (s)
+	case 0x16: // c1 (s)
+	case 0x17: // c2 (s)
+		UML_STORE(block, &m_core.dau_c[0], r - 0x15, I0, SIZE_BYTE, SCALE_x1);                      // store   [cN],i0
+		break;
+	default: // psw and peripherals
+		UML_STORE(block, &m_host.m_st_pcbase, 0, compiler.pcbase, SIZE_WORD, SCALE_x1);             // store   [st_pcbase],pcbase
+		UML_STORE(block, &m_arg_value, 0, I0, SIZE_WORD, SCALE_x1);                                 // store   [arg_value],i0
+		UML_STORE(block, &m_arg_op, 0, op, SIZE_WORD, SCALE_x1);                                    // store   [arg_op],op
+		UML_CALLC(block, &cfunc_set_r, this);                                                       // callc   set_r,this
+		break;
+	}
+}
+
+void dsp16_device_base::recompiler::generate_yaau_read(drcuml_block &block, compiler_state &compiler, u16 op)
+{
+	// leaves the value in I0
+	UML_LOAD(block, I1, &m_core.yaau_r[0], (op >> 2) & 0x0003U, SIZE_WORD, SCALE_x2);               // load    i1,[rN]
+	UML_AND(block, I2, I1, m_host.m_workram_mask);                                                  // and     i2,i1,workram_mask
+	UML_LOAD(block, I0, m_host.m_workram.target(), I2, SIZE_WORD, SCALE_x2);                        // load    i0,[workram+i2]
+	generate_yaau_postmodify(block, compiler, op);
+}
+
+void dsp16_device_base::recompiler::generate_yaau_write(drcuml_block &block, compiler_state &compiler, u16 op)
+{
+	// takes the value from I0
+	UML_LOAD(block, I1, &m_core.yaau_r[0], (op >> 2) & 0x0003U, SIZE_WORD, SCALE_x2);               // load    i1,[rN]
+	UML_AND(block, I2, I1, m_host.m_workram_mask);                                                  // and     i2,i1,workram_mask
+	UML_STORE(block, m_host.m_workram.target(), I2, I0, SIZE_WORD, SCALE_x2);                       // store   [workram+i2],i0
+	generate_yaau_postmodify(block, compiler, op);
+}
+
+void dsp16_device_base::recompiler::generate_yaau_write_z(drcuml_block &block, compiler_state &compiler, u16 op)
+{
+	u16 const n((op >> 2) & 0x0003U);
+	UML_LOAD(block, I1, &m_core.yaau_r[0], n, SIZE_WORD, SCALE_x2);                                 // load    i1,[rN]
+	UML_AND(block, I2, I1, m_host.m_workram_mask);                                                  // and     i2,i1,workram_mask
+	UML_LOAD(block, I0, &m_core.dau_temp, 0, SIZE_WORD, SCALE_x1);                                  // load    i0,[temp]
+	UML_STORE(block, m_host.m_workram.target(), I2, I0, SIZE_WORD, SCALE_x2);                       // store   [workram+i2],i0
+	switch (op & 0x0003U)
+	{
+	case 0x0: // *rNzp
+		generate_yaau_wrap(block, compiler);
+		break;
+	case 0x1: // *rNpz
+		return;
+	case 0x2: // *rNm2
+		UML_ADD(block, I1, I1, 2);                                                                  // add     i1,i1,2
+		break;
+	case 0x3: // *rNjk
+		UML_LOADS(block, I2, &m_core.yaau_k, 0, SIZE_WORD, SCALE_x1);                               // loads   i2,[k]
+		UML_ADD(block, I1, I1, I2);                                                                 // add     i1,i1,i2
+		break;
+	}
+	UML_AND(block, I1, I1, m_core.yaau_mask);                                                       // and     i1,i1,yaau_mask
+	UML_STORE(block, &m_core.yaau_r[0], n, I1, SIZE_WORD, SCALE_x2);                                // store   [rN],i1
+}
+
+void dsp16_device_base::recompiler::generate_yaau_postmodify(drcuml_block &block, compiler_state &compiler, u16 op)
+{
+	// takes the pointer value from I1 and preserves I0
+	switch (op & 0x0003U)
+	{
+	case 0x0: // *rN
+		return;
+	case 0x1: // *rN++
+		generate_yaau_wrap(block, compiler);
+		break;
+	case 0x2: // *rN--
+		UML_SUB(block, I1, I1, 1);                                                                  // sub     i1,i1,1
+		break;
+	case 0x3: // *rN++j
+		UML_LOADS(block, I2, &m_core.yaau_j, 0, SIZE_WORD, SCALE_x1);                               // loads   i2,[j]
+		UML_ADD(block, I1, I1, I2);                                                                 // add     i1,i1,i2
+		break;
+	}
+	UML_AND(block, I1, I1, m_core.yaau_mask);                                                       // and     i1,i1,yaau_mask
+	UML_STORE(block, &m_core.yaau_r[0], (op >> 2) & 0x0003U, I1, SIZE_WORD, SCALE_x2);              // store   [rN],i1
+}
+
+void dsp16_device_base::recompiler::generate_yaau_wrap(drcuml_block &block, compiler_state &compiler)
+{
+	// increment I1, or go back to RB if it's reached a non-zero RE
+	uml::code_label const increment(compiler.labelnum++);
+	uml::code_label const done(compiler.labelnum++);
+	UML_LOAD(block, I2, &m_core.yaau_re, 0, SIZE_WORD, SCALE_x1);                                   // load    i2,[re]
+	UML_CMP(block, I2, 0);                                                                          // cmp     i2,0
+	UML_JMPc(block, COND_E, increment);                                                             // je      increment
+	UML_CMP(block, I2, I1);                                                                         // cmp     i2,i1
+	UML_JMPc(block, COND_NE, increment);                                                            // jne     increment
+	UML_LOAD(block, I1, &m_core.yaau_rb, 0, SIZE_WORD, SCALE_x1);                                   // load    i1,[rb]
+	UML_JMP(block, done);                                                                           // jmp     done
+	UML_LABEL(block, increment);                                                                    // increment:
+	UML_ADD(block, I1, I1, 1);                                                                      // add     i1,i1,1
+	UML_LABEL(block, done);                                                                         // done:
+}
+
+void dsp16_device_base::recompiler::generate_f1(drcuml_block &block, u16 op)
+{
+	switch (op_f1(op))
+	{
+	case 0x2: // p = x*y
+		generate_multiply(block);
+		break;
+	case 0x6: // NOP
+		break;
+	default:
+		UML_STORE(block, &m_arg_op, 0, op, SIZE_WORD, SCALE_x1);                                    // store   [arg_op],op
+		UML_CALLC(block, &cfunc_dau_f1, this);                                                      // callc   dau_f1,this
+		break;
+	}
+}
+
+void dsp16_device_base::recompiler::generate_f1_y_a(drcuml_block &block, u16 op)
+{
+	// FIXME: is saturation applied when transferring a to y?
+	switch (op_f1(op))
+	{
+	case 0x2: // p = x*y
+		generate_multiply(block);
+		[[fallthrough]];
+	case 0x6: // NOP
+		UML_DMOV(block, I0, mem(&m_core.dau_a[BIT(op, 12)]));                                       // dmov    i0,[aS]
+		UML_MOV(block, mem(&m_core.dau_y), I0);                                                     // mov     [y],i0
+		break;
+	default:
+		UML_STORE(block, &m_arg_op, 0, op, SIZE_WORD, SCALE_x1);                                    // store   [arg_op],op
+		UML_CALLC(block, &cfunc_dau_f1_y_a, this);                                                  // callc   dau_f1_y_a,this
+		break;
+	}
+}
+
+void dsp16_device_base::recompiler::generate_multiply(drcuml_block &block)
+{
+	UML_LOADS(block, I0, &m_core.dau_x, 0, SIZE_WORD, SCALE_x1);                                    // loads   i0,[x]
+	UML_SAR(block, I1, mem(&m_core.dau_y), 16);                                                     // sar     i1,[y],16
+	UML_MULS(block, I0, I0, I0, I1);                                                                // muls    i0,i0,i0,i1
+	UML_MOV(block, mem(&m_core.dau_p), I0);                                                         // mov     [p],i0
+}
+
+void dsp16_device_base::recompiler::generate_saturate(drcuml_block &block, compiler_state &compiler, u16 a)
+{
+	// leaves the 64-bit value in I0
+	uml::code_label const done(compiler.labelnum++);
+	UML_DMOV(block, I0, mem(&m_core.dau_a[a]));                                                     // dmov    i0,[aN]
+	UML_LOAD(block, I1, &m_core.dau_auc, 0, SIZE_BYTE, SCALE_x1);                                   // load    i1,[auc]
+	UML_TEST(block, I1, 1 << (2 + a));                                                              // test    i1,sat
+	UML_JMPc(block, COND_NZ, done);                                                                 // jnz     done
+	UML_DCMP(block, I0, std::numeric_limits<s32>::max());                                           // dcmp    i0,max
+	UML_DMOVc(block, COND_G, I0, std::numeric_limits<s32>::max());                                  // dmov    i0,max,g
+	UML_DCMP(block, I0, u64(s64(std::numeric_limits<s32>::min())));                                 // dcmp    i0,min
+	UML_DMOVc(block, COND_L, I0, u64(s64(std::numeric_limits<s32>::min())));                        // dmov    i0,min,l
+	UML_LABEL(block, done);                                                                         // done:
+}
+
+void dsp16_device_base::recompiler::generate_set_atx(drcuml_block &block, compiler_state &compiler, u16 op)
+{
+	// takes the value from the low 16 bits of I0
+	u16 const t(op_d(~op));
+	if (op_x(op))
+	{
+		generate_set_at(block, compiler, t);
+	}
+	else
+	{
+		UML_DAND(block, I1, mem(&m_core.dau_a[t]), ~u64(0xffff));                                   // dand    i1,[aT],~0xffff
+		UML_DAND(block, I0, I0, 0xffff);                                                            // dand    i0,i0,0xffff
+		UML_DOR(block, mem(&m_core.dau_a[t]), I1, I0);                                              // dor     [aT],i1,i0
+	}
+}
+
+void dsp16_device_base::recompiler::generate_set_at(drcuml_block &block, compiler_state &compiler, u16 t)
+{
+	// takes the value from the low 16 bits of I0 - the low half is cleared unless the PSW says otherwise
+	uml::code_label const clear(compiler.labelnum++);
+	UML_SHL(block, I0, I0, 16);                                                                     // shl     i0,i0,16
+	UML_LOAD(block, I1, &m_core.dau_psw, 0, SIZE_WORD, SCALE_x1);                                   // load    i1,[psw]
+	UML_TEST(block, I1, 1 << (4 + t));                                                              // test    i1,clear
+	UML_JMPc(block, COND_Z, clear);                                                                 // jz      clear
+	UML_DMOV(block, I1, mem(&m_core.dau_a[t]));                                                     // dmov    i1,[aT]
+	UML_AND(block, I1, I1, 0xffff);                                                                 // and     i1,i1,0xffff
+	UML_OR(block, I0, I0, I1);                                                                      // or      i0,i0,i1
+	UML_LABEL(block, clear);                                                                        // clear:
+	UML_DSEXT(block, I0, I0, SIZE_DWORD);                                                           // dsext   i0,i0,dword
+	UML_DMOV(block, mem(&m_core.dau_a[t]), I0);                                                     // dmov    [aT],i0
+}
+
+void dsp16_device_base::recompiler::generate_get_y(drcuml_block &block, u16 op)
+{
+	// leaves the value in the low 16 bits of I0
+	if (op_x(op))
+		UML_SHR(block, I0, mem(&m_core.dau_y), 16);                                                 // shr     i0,[y],16
+	else
+		UML_AND(block, I0, mem(&m_core.dau_y), 0xffff);                                             // and     i0,[y],0xffff
+}
+
+void dsp16_device_base::recompiler::generate_set_y(drcuml_block &block, compiler_state &compiler, bool high)
+{
+	// takes the value from the low 16 bits of I0 - setting the high half clears the low half unless the AUC says otherwise
+	if (high)
+	{
+		uml::code_label const clear(compiler.labelnum++);
+		UML_SHL(block, I0, I0, 16);                                                                 // shl     i0,i0,16
+		UML_LOAD(block, I1, &m_core.dau_auc, 0, SIZE_BYTE, SCALE_x1);                               // load    i1,[auc]
+		UML_TEST(block, I1, 0x40);                                                                  // test    i1,0x40
+		UML_JMPc(block, COND_Z, clear);                                                             // jz      clear
+		UML_AND(block, I1, mem(&m_core.dau_y), 0xffff);                                             // and     i1,[y],0xffff
+		UML_OR(block, I0, I0, I1);                                                                  // or      i0,i0,i1
+		UML_LABEL(block, clear);                                                                    // clear:
+		UML_MOV(block, mem(&m_core.dau_y), I0);                                                     // mov     [y],i0
+	}
+	else
+	{
+		UML_AND(block, I1, mem(&m_core.dau_y), 0xffff0000);                                         // and     i1,[y],0xffff0000
+		UML_AND(block, I0, I0, 0xffff);                                                             // and     i0,i0,0xffff
+		UML_OR(block, mem(&m_core.dau_y), I1, I0);                                                  // or      [y],i1,i0
+	}
+}
+
+void dsp16_device_base::recompiler::generate_increment_pt(drcuml_block &block, u16 op)
+{
+	UML_LOAD(block, I0, &m_core.xaau_pt, 0, SIZE_WORD, SCALE_x1);                                   // load    i0,[pt]
+	if (op_x(op))
+	{
+		UML_LOADS(block, I1, &m_core.xaau_i, 0, SIZE_WORD, SCALE_x1);                               // loads   i1,[i]
+		UML_ADD(block, I1, I0, I1);                                                                 // add     i1,i0,i1
+	}
+	else
+	{
+		UML_ADD(block, I1, I0, 1);                                                                  // add     i1,i0,1
+	}
+	UML_AND(block, I1, I1, XAAU_I_MASK);                                                            // and     i1,i1,XAAU_I_MASK
+	UML_AND(block, I0, I0, u16(XAAU_I_EXT));                                                        // and     i0,i0,XAAU_I_EXT
+	UML_OR(block, I0, I0, I1);                                                                      // or      i0,i0,i1
+	UML_STORE(block, &m_core.xaau_pt, 0, I0, SIZE_WORD, SCALE_x1);                                  // store   [pt],i0
+}
+
+void dsp16_device_base::recompiler::generate_load_x_rom(drcuml_block &block)
+{
+	UML_LOAD(block, I0, &m_host.m_rom_data, 0, SIZE_WORD, SCALE_x1);                                // load    i0,[rom_data]
+	UML_STORE(block, &m_core.dau_x, 0, I0, SIZE_WORD, SCALE_x1);                                    // store   [x],i0
+}
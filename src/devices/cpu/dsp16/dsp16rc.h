@@ -23,13 +23,17 @@ public:
 	recompiler(dsp16_device_base &host, u32 flags);
 	~recompiler();
 
+	// execution - returns true if the interpreter needs to run the next instruction
+	bool execute_run();
+	void invalidate() { m_cache_dirty = true; }
+
 private:
-	// compilation boundaries
+	// compilation boundaries - the program space is word-addressed, so these are really in words
 	enum : u32
 	{
 		COMPILE_BACKWARDS_BYTES = 64,
 		COMPILE_FORWARDS_BYTES = 256,
-		COMPILE_MAX_INSTRUCTIONS = (COMPILE_BACKWARDS_BYTES / 2) + (COMPILE_FORWARDS_BYTES / 2),
+		COMPILE_MAX_INSTRUCTIONS = COMPILE_BACKWARDS_BYTES + COMPILE_FORWARDS_BYTES,
 		COMPILE_MAX_SEQUENCE = 64
 	};
 
@@ -39,14 +43,102 @@ private:
 		EXEC_OUT_OF_CYCLES,
 		EXEC_MISSING_CODE,
 		EXEC_UNMAPPED_CODE,
-		EXEC_RESET_CACHE
+		EXEC_RESET_CACHE,
+		EXEC_INTERPRET
+	};
+
+	// where an instruction is being executed from
+	enum class context
+	{
+		ROM,            // normal timings, including the instructions loaded into the cache
+		CACHE,          // overlapped data fetch, no instruction fetch
+		CACHE_LAST      // last instruction of the final iteration, normal timings
 	};
 
+	// state carried through a block - mode is IACK, so it's clear while servicing an interrupt
+	struct compiler_state
+	{
+		u8 mode;
+		u32 cycles;
+		uml::code_label labelnum;
+		u16 pcbase;
+	};
+
+	// helpers called from generated code
+	static void cfunc_sio_step(void *param);
+	static void cfunc_pio_step(void *param);
+	static void cfunc_get_r(void *param);
+	static void cfunc_set_r(void *param);
+	static void cfunc_dau_f1(void *param);
+	static void cfunc_dau_f1_y_a(void *param);
+	static void cfunc_dau_con_f2(void *param);
+	static void cfunc_read_pt(void *param);
+
+	// cache management
+	void flush_cache();
+	void compile_block(u8 mode, u16 pc);
+	void synchronise();
+
+	// static subroutines
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+
+	// sequencing
+	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param);
+	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, opcode_desc const &desc);
+	void generate_interpret(drcuml_block &block, compiler_state &compiler, u16 pc);
+	void generate_interrupt_check(drcuml_block &block, compiler_state &compiler, u16 pc);
+	void generate_begin_op(drcuml_block &block, compiler_state &compiler, u16 pc, bool check_interrupts);
+	void generate_int_enable(drcuml_block &block);
+	void generate_set_pc(drcuml_block &block, compiler_state &compiler, uml::parameter pc);
+	void generate_cycle(drcuml_block &block, compiler_state &compiler);
+	void generate_branch(drcuml_block &block, compiler_state &compiler, opcode_desc const &desc, u16 op, u16 pc);
+	void generate_con(drcuml_block &block, compiler_state &compiler, u16 op, bool inc, uml::code_label if_false);
+	void generate_do(drcuml_block &block, compiler_state &compiler, opcode_desc const &desc);
+	bool generate_data_op(drcuml_block &block, compiler_state &compiler, u16 op, context ctx);
+	void generate_overlap_read(drcuml_block &block, u16 op);
+
+	// sub-operations
+	void generate_short_immediate(drcuml_block &block, u16 op);
+	void generate_get_r(drcuml_block &block, compiler_state &compiler, u16 op);
+	void generate_set_r(drcuml_block &block, compiler_state &compiler, u16 op);
+	void generate_yaau_read(drcuml_block &block, compiler_state &compiler, u16 op);
+	void generate_yaau_write(drcuml_block &block, compiler_state &compiler, u16 op);
+	void generate_yaau_write_z(drcuml_block &block, compiler_state &compiler, u16 op);
+	void generate_yaau_postmodify(drcuml_block &block, compiler_state &compiler, u16 op);
+	void generate_yaau_wrap(drcuml_block &block, compiler_state &compiler);
+	void generate_f1(drcuml_block &block, u16 op);
+	void generate_f1_y_a(drcuml_block &block, u16 op);
+	void generate_multiply(drcuml_block &block);
+	void generate_saturate(drcuml_block &block, compiler_state &compiler, u16 a);
+	void generate_set_atx(drcuml_block &block, compiler_state &compiler, u16 op);
+	void generate_set_at(drcuml_block &block, compiler_state &compiler, u16 t);
+	void generate_get_y(drcuml_block &block, u16 op);
+	void generate_set_y(drcuml_block &block, compiler_state &compiler, bool high);
+	void generate_increment_pt(drcuml_block &block, u16 op);
+	void generate_load_x_rom(drcuml_block &block);
+
+	// XAAU address arithmetic
+	static constexpr u16 next_pc(u16 pc) { return (pc & XAAU_I_EXT) | ((pc + 1) & XAAU_I_MASK); }
+	static u16 fallthrough_pc(opcode_desc const &desc);
+
 	// host CPU device, frontend to describe instructions, and UML engine
 	dsp16_device_base   &m_host;
 	core_state          &m_core;
 	frontend            m_frontend;
 	drcuml_state        m_uml;
+
+	// subroutines
+	uml::code_handle    *m_entry;
+	uml::code_handle    *m_nocode;
+	uml::code_handle    *m_out_of_cycles;
+
+	// arguments and results for helpers
+	u16                 m_arg_op;
+	u16                 m_arg_value;
+
+	bool                m_cache_dirty;
 };
 
 #endif // MAME_CPU_DSP16_DSP16RC_H
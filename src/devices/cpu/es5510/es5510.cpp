@@ -43,6 +43,7 @@ constexpr int64_t SX64(int64_t x) { return (x & s64(0x0000800000000000U)) ? x |
 
 #define VERBOSE 0
 #define VERBOSE_EXEC 0
+#define CHECK_DECODED 0 // check each decoded instruction against its instruction word before running it
 
 static inline void ATTR_PRINTF(1,2) log_to_stderr(const char *format, ...) {
 	va_list ap;
@@ -165,6 +166,8 @@ es5510_device::es5510_device(const machine_config &mconfig, const char *tag, dev
 	, cmr(0)
 	, dol_count(0)
 	, instr(nullptr)
+	, decoded(nullptr)
+	, decoded_valid(false)
 	, dram(nullptr)
 	, dol_latch(0)
 	, dil_latch(0)
@@ -520,6 +523,7 @@ void es5510_device::host_w(offs_t offset, uint8_t data)
 #endif
 		if (data < 0xa0) {
 			instr[data] = instr_latch&0xffffffffffffU;
+			decoded_valid = false;
 		}
 		break;
 
@@ -530,6 +534,7 @@ void es5510_device::host_w(offs_t offset, uint8_t data)
 #endif
 		if (data < 0xa0) {
 			instr[data] = instr_latch;
+			decoded_valid = false;
 		}
 		write_reg(data, gpr_latch);
 		break;
@@ -570,6 +575,8 @@ void es5510_device::ser_w(int offset, int16_t data)
 void es5510_device::device_start() {
 	gpr = std::make_unique<int32_t[]>(0xc0);     // 24 bits, right justified
 	instr = std::make_unique<uint64_t[]>(160);    // 48 bits, right justified
+	decoded = std::make_unique<decoded_instr_t[]>(160);
+	decoded_valid = false;
 	dram = std::make_unique<int16_t[]>(DRAM_SIZE);   // there are up to 20 address bits (at least 16 expected), left justified within the 24 bits of a gpr or dadr; we preallocate all of it.
 	set_icountptr(icount);
 	state_add(STATE_GENPC,"GENPC", pc).noshow();
@@ -649,6 +656,7 @@ void es5510_device::device_reset() {
 	pc = 0x00;
 	std::fill(&gpr[0], &gpr[0xc0], 0);
 	std::fill(&instr[0], &instr[160], 0);
+	decoded_valid = false;
 	std::fill(&dram[0], &dram[DRAM_SIZE], 0);
 	state = STATE_RUNNING;
 	dil_latch = dol_latch = dadr_latch = gpr_latch = 0;
@@ -661,6 +669,43 @@ void es5510_device::device_reset() {
 	memset(&ram_pp, 0, sizeof(ram_t));
 }
 
+void es5510_device::device_post_load() {
+	decoded_valid = false;
+}
+
+void es5510_device::decode_instr(uint64_t word, decoded_instr_t &decoded) {
+	// clear the padding too, so decoded instructions can be compared with memcmp
+	memset(&decoded, 0, sizeof(decoded));
+
+	const ram_control_t &ramControl = RAM_CONTROL[(word >> 3) & 0x07];
+	decoded.ram_cycle = ramControl.cycle;
+	decoded.ram_access = ramControl.access;
+
+	const op_select_t &opSelect = OPERAND_SELECT[(word >> 8) & 0x0f];
+	decoded.alu_src = opSelect.alu_src;
+	decoded.alu_dst = opSelect.alu_dst;
+	decoded.mac_src = opSelect.mac_src;
+	decoded.mac_dst = opSelect.mac_dst;
+
+	decoded.aReg = (word >> 16) & 0xff;
+	decoded.bReg = (word >> 24) & 0xff;
+	decoded.cReg = (word >> 32) & 0xff;
+	decoded.dReg = (word >> 40) & 0xff;
+	decoded.alu_op = (word >> 12) & 0x0f;
+	decoded.alu_operands = ALU_OPS[decoded.alu_op].operands;
+
+	decoded.skippable = (word & (0x01 << 7)) != 0; // aka the 'SKIP' bit in the instruction word
+	decoded.accumulate = ((word >> 6) & 0x01) != 0;
+	decoded.update_ccr = !decoded.skippable || (decoded.alu_op == OP_CMP);
+}
+
+void es5510_device::decode_program() {
+	for (int i = 0; i < 160; i++) {
+		decode_instr(instr[i], decoded[i]);
+	}
+	decoded_valid = true;
+}
+
 device_memory_interface::space_config_vector es5510_device::memory_space_config() const
 {
 	return space_config_vector {
@@ -777,6 +822,11 @@ void es5510_device::list_program(void(p)(const char *, ...)) {
 }
 
 void es5510_device::execute_run() {
+	// the program only changes when the host writes to it
+	if (!decoded_valid) {
+		decode_program();
+	}
+
 	while (icount > 0) {
 		if (state == STATE_HALTED) {
 			// Currently halted, sample the HALT line
@@ -808,7 +858,15 @@ void es5510_device::execute_run() {
 
 			// *** T0, clock low
 			// --- Read instruction N
-			uint64_t instr = this->instr[pc];
+			const decoded_instr_t &op = decoded[pc];
+#if CHECK_DECODED
+			decoded_instr_t check;
+			decode_instr(instr[pc], check);
+			if (memcmp(&check, &op, sizeof(check)) != 0) {
+				logerror("%s",string_format("decoded instruction %02x is stale for %012x\n", pc, instr[pc]).c_str());
+				decode_program();
+			}
+#endif
 
 			// --- RAM cycle N-2 (if a Read cycle): data read from bus is stored in DIL
 			if (ram_pp.cycle != RAM_CYCLE_WRITE) {
@@ -821,13 +879,12 @@ void es5510_device::execute_run() {
 			}
 
 			// --- start of RAM cycle N
-			ram_control_t ramControl = RAM_CONTROL[((instr >> 3) & 0x07)];
-			ram.cycle = ramControl.cycle;
-			ram.io = ramControl.access == RAM_CONTROL_IO;
+			ram.cycle = op.ram_cycle;
+			ram.io = op.ram_access == RAM_CONTROL_IO;
 
 			// --- RAM cycle N: read offset N
 			int32_t offset = gpr[pc];
-			switch(ramControl.access) {
+			switch(op.ram_access) {
 			case RAM_CONTROL_DELAY:
 				ram.address = (((dbase + offset) % (dlength + memincrement)) & memmask) >> memshift;
 				LOG_EXEC((". Ram Control: Delay, base=%x, offset=%x, length=%x => address=%x\n", dbase >> memshift, offset >> memshift, (dlength + memincrement) >> memshift, ram.address));
@@ -852,11 +909,8 @@ void es5510_device::execute_run() {
 
 			LOG_EXEC(("- T1.1\n"));
 
-			uint8_t operandSelect = (uint8_t)((instr >> 8) & 0x0f);
-			const op_select_t &opSelect = OPERAND_SELECT[operandSelect];
 			bool skip;
-			bool skippable = (instr & (0x01 << 7)) != 0; // aka the 'SKIP' bit in the instruction word
-			if (skippable) {
+			if (op.skippable) {
 				bool skipConditionSatisfied = (ccr & cmr & FLAG_MASK) != 0;
 				if (isFlagSet(cmr, FLAG_NOT)) {
 					skipConditionSatisfied = !skipConditionSatisfied;
@@ -910,11 +964,11 @@ void es5510_device::execute_run() {
 
 			// --- Start of multiplier cycle N
 			LOG_EXEC((". start mulacc:\n"));
-			mulacc.cReg = (uint8_t)((instr >> 32) & 0xff);
-			mulacc.dReg = (uint8_t)((instr >> 40) & 0xff);
-			mulacc.src = opSelect.mac_src;
-			mulacc.dst = opSelect.mac_dst;
-			mulacc.accumulate = ((instr >> 6) & 0x01) != 0;
+			mulacc.cReg = op.cReg;
+			mulacc.dReg = op.dReg;
+			mulacc.src = op.mac_src;
+			mulacc.dst = op.mac_dst;
+			mulacc.accumulate = op.accumulate;
 			mulacc.write_result = !skip;
 
 			// --- Read Multiplier Operands N
@@ -952,20 +1006,19 @@ void es5510_device::execute_run() {
 
 			// --- Start of ALU cycle N
 			LOG_EXEC((". start ALU:\n"));
-			alu.aReg = (instr >> 16) & 0xff;
-			alu.bReg = (instr >> 24) & 0xff;
-			alu.op = (instr >> 12) & 0x0f;
-			alu.src = opSelect.alu_src;
-			alu.dst = opSelect.alu_dst;
+			alu.aReg = op.aReg;
+			alu.bReg = op.bReg;
+			alu.op = op.alu_op;
+			alu.src = op.alu_src;
+			alu.dst = op.alu_dst;
 			alu.write_result = !skip;
-			alu.update_ccr = !skippable || (alu.op == OP_CMP);
+			alu.update_ccr = op.update_ccr;
 
 			if (alu.op == 0xF) {
 				alu_operation_end();
 			} else {
 				// --- Read ALU Operands N
-				alu_op_t aluOp = ALU_OPS[alu.op];
-				if (aluOp.operands == 1) {
+				if (op.alu_operands == 1) {
 					if (alu.src == SRC_DST_REG) {
 						alu.bValue = read_reg(alu.bReg);
 					} else { // must be SRC_DST_DELAY
@@ -103,6 +103,26 @@ public:
 		bool write_result;
 	};
 
+	// an instruction word with its fields pulled out, so the program can be
+	// run without decoding every instruction on every sample
+	struct decoded_instr_t {
+		ram_cycle_t ram_cycle;
+		ram_control_access_t ram_access;
+		op_src_dst_t alu_src;
+		op_src_dst_t alu_dst;
+		op_src_dst_t mac_src;
+		op_src_dst_t mac_dst;
+		uint8_t aReg;
+		uint8_t bReg;
+		uint8_t cReg;
+		uint8_t dReg;
+		uint8_t alu_op;
+		uint8_t alu_operands;
+		bool skippable;
+		bool accumulate;
+		bool update_ccr;    // unless skipped
+	};
+
 	struct ram_t {
 		int32_t address;     // up to 20 bits, left-justified within the right 24 bits of the 32-bit word
 		bool io;           // I/O space, rather than delay line memory
@@ -117,7 +137,7 @@ public:
 	void list_program(void(p)(const char *, ...));
 
 	// for testing purposes
-	uint64_t &_instr(int pc) { return instr[pc % 160]; }
+	uint64_t &_instr(int pc) { decoded_valid = false; return instr[pc % 160]; }
 	int16_t &_dram(int addr) { return dram[addr & DRAM_MASK]; }
 
 	// publicly visible for testing purposes
@@ -128,6 +148,7 @@ public:
 protected:
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_post_load() override;
 	virtual space_config_vector memory_space_config() const override;
 	virtual uint64_t execute_clocks_to_cycles(uint64_t clocks) const noexcept override;
 	virtual uint64_t execute_cycles_to_clocks(uint64_t cycles) const noexcept override;
@@ -141,6 +162,9 @@ protected:
 	int32_t alu_operation(uint8_t op, int32_t aValue, int32_t bValue, uint8_t &flags);
 	void alu_operation_end();
 
+	static void decode_instr(uint64_t word, decoded_instr_t &decoded);
+	void decode_program();
+
 private:
 	int icount;
 	bool halt_asserted;
@@ -174,6 +198,8 @@ private:
 	int dol_count;
 
 	std::unique_ptr<uint64_t[]> instr;
+	std::unique_ptr<decoded_instr_t[]> decoded; // instr, decoded
+	bool decoded_valid;
 	std::unique_ptr<int16_t[]> dram;
 
 	// TODO : Masked address?
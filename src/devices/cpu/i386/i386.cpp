@@ -314,6 +314,7 @@ bool i386_device::translate_address(int pl, int type, uint32_t *address, uint32_
 void i386_device::CHANGE_PC(uint32_t pc)
 {
 	m_pc = i386_translate(CS, pc, -1 );
+	m_fetch_page = ~0;
 }
 
 void i386_device::NEAR_BRANCH(int32_t offs)
@@ -323,12 +324,31 @@ void i386_device::NEAR_BRANCH(int32_t offs)
 	m_pc += offs;
 }
 
+// instruction fetches mostly stay on one page, so keep its translation
+// until the TLB is flushed or CPL or paging changes
+bool i386_device::translate_fetch(uint32_t *address, uint32_t *error)
+{
+	uint32_t const page = (*address & 0xfffff000) | ((m_cr[0] >> 29) & 4) | m_CPL;
+	if (page == m_fetch_page)
+	{
+		*address = m_fetch_page_phys | (*address & 0xfff);
+		return true;
+	}
+
+	if(!translate_address(m_CPL,TRANSLATE_FETCH,address,error))
+		return false;
+
+	m_fetch_page = page;
+	m_fetch_page_phys = *address & 0xfffff000;
+	return true;
+}
+
 uint8_t i386_device::FETCH()
 {
 	uint8_t value;
 	uint32_t address = m_pc, error;
 
-	if(!translate_address(m_CPL,TRANSLATE_FETCH,&address,&error))
+	if(!translate_fetch(&address,&error))
 		PF_THROW(error);
 
 	value = mem_pr8(address & m_a20_mask);
@@ -349,7 +369,7 @@ uint16_t i386_device::FETCH16()
 		value = (FETCH() << 0);
 		value |= (FETCH() << 8);
 	} else {
-		if(!translate_address(m_CPL,TRANSLATE_FETCH,&address,&error))
+		if(!translate_fetch(&address,&error))
 			PF_THROW(error);
 		address &= m_a20_mask;
 		value = mem_pr16(address);
@@ -369,7 +389,7 @@ uint32_t i386_device::FETCH32()
 		value |= (FETCH() << 16);
 		value |= (FETCH() << 24);
 	} else {
-		if(!translate_address(m_CPL,TRANSLATE_FETCH,&address,&error))
+		if(!translate_fetch(&address,&error))
 			PF_THROW(error);
 
 		address &= m_a20_mask;
@@ -1919,6 +1939,9 @@ void i386_device::i386_common_init()
 
 	build_cycle_table();
 
+	m_fetch_page = ~0;
+	m_fetch_page_phys = 0;
+
 	for( i=0; i < 256; i++ ) {
 		int c=0;
 		for( j=0; j < 8; j++ ) {
@@ -2724,6 +2747,7 @@ void i386_device::i386_set_a20_line(int state)
 	}
 	// TODO: how does A20M and the tlb interact
 	vtlb_flush_dynamic();
+	m_fetch_page = ~0;
 }
 
 void i386_device::execute_run()
@@ -308,6 +308,8 @@ protected:
 	address_space *m_program;
 	address_space *m_io;
 	uint32_t m_a20_mask;
+	uint32_t m_fetch_page;      // linear page, CPL and paging bit of the last translated fetch, or ~0
+	uint32_t m_fetch_page_phys; // physical page that fetch translated to
 	memory_access<32, 1, 0, ENDIANNESS_LITTLE>::cache macache16;
 	memory_access<32, 2, 0, ENDIANNESS_LITTLE>::cache macache32;
 
@@ -401,6 +403,7 @@ protected:
 	bool translate_address(int pl, int type, uint32_t *address, uint32_t *error);
 	void CHANGE_PC(uint32_t pc);
 	inline void NEAR_BRANCH(int32_t offs);
+	inline bool translate_fetch(uint32_t *address, uint32_t *error);
 	inline uint8_t FETCH();
 	inline uint16_t FETCH16();
 	inline uint32_t FETCH32();
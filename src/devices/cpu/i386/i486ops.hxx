@@ -330,6 +330,7 @@ void i386_device::i486_group0F01_16()      // Opcode 0x0f 01
 				ea = GetEA(modrm,-1);
 				CYCLES(25); // TODO: add to cycles.h
 				vtlb_flush_address(ea);
+				m_fetch_page = ~0;
 				break;
 			}
 		default:
@@ -448,6 +449,7 @@ void i386_device::i486_group0F01_32()      // Opcode 0x0f 01
 				ea = GetEA(modrm,-1);
 				CYCLES(25); // TODO: add to cycles.h
 				vtlb_flush_address(ea);
+				m_fetch_page = ~0;
 				break;
 			}
 		default:
@@ -517,7 +519,10 @@ void i386_device::i486_mov_cr_r32()        // Opcode 0x0f 22
 		case 0:
 			CYCLES(CYCLES_MOV_REG_CR0);
 			if((oldcr ^ m_cr[cr]) & 0x80010000)
+			{
 				vtlb_flush_dynamic();
+				m_fetch_page = ~0;
+			}
 			if (PROTECTED_MODE != BIT(data, 0))
 				debugger_privilege_hook();
 			break;
@@ -525,6 +530,7 @@ void i386_device::i486_mov_cr_r32()        // Opcode 0x0f 22
 		case 3:
 			CYCLES(CYCLES_MOV_REG_CR3);
 			vtlb_flush_dynamic();
+			m_fetch_page = ~0;
 			break;
 		case 4: CYCLES(1); break; // TODO
 		default:
@@ -3,6 +3,7 @@
 #include "emu.h"
 #include "i960.h"
 #include "i960dis.h"
+#include "i960fe.h"
 
 #ifdef _MSC_VER
 /* logb prototype is different for MS Visual C */
@@ -19,6 +20,8 @@ i960_cpu_device::i960_cpu_device(const machine_config &mconfig, const char *tag,
 	, m_stalled(false), m_program_config("program", ENDIANNESS_LITTLE, 32, 32, 0)
 	, m_rcache_pos(0), m_SAT(0), m_PRCB(0), m_PC(0), m_AC(0), m_IP(0), m_PIP(0), m_ICR(0), m_immediate_irq(0)
 	, m_immediate_vector(0), m_immediate_pri(0), m_icount(0)
+	, m_enable_drc(false), m_drc_flush(0), m_drc_op(0)
+	, m_entry(nullptr), m_nocode(nullptr), m_out_of_cycles(nullptr), m_redispatch(nullptr)
 {
 	std::fill(std::begin(m_r), std::end(m_r), 0);
 	std::fill(std::begin(m_rcache_frame_addr), std::end(m_rcache_frame_addr), 0);
@@ -28,6 +31,10 @@ i960_cpu_device::i960_cpu_device(const machine_config &mconfig, const char *tag,
 		std::fill(std::begin(m_rcache[i]), std::end(m_rcache[i]), 0);
 }
 
+i960_cpu_device::~i960_cpu_device()
+{
+}
+
 
 device_memory_interface::space_config_vector i960_cpu_device::memory_space_config() const
 {
@@ -2183,28 +2190,35 @@ void i960_cpu_device::execute_op(uint32_t opcode)
 
 }
 
-void i960_cpu_device::execute_run()
+void i960_cpu_device::execute_one()
 {
-	uint32_t opcode;
+	m_PIP = m_IP;
+	debugger_instruction_hook(m_IP);
 
-	// delay checking irqs if we are in burst stall mode
-	if(m_stall_state.burst_mode == false)
-		check_irqs();
+	uint32_t const opcode = m_cache.read_dword(m_IP);
+	m_IP += 4;
 
-	while(m_icount > 0) {
-		m_PIP = m_IP;
-		debugger_instruction_hook(m_IP);
+	m_stalled = false;
 
-		opcode = m_cache.read_dword(m_IP);
-		m_IP += 4;
+	if(m_stall_state.burst_mode == true)
+		execute_burst_stall_op(opcode);
+	else
+		execute_op(opcode);
+}
 
-		m_stalled = false;
+void i960_cpu_device::execute_run()
+{
+	// delay checking irqs if we are in burst stall mode
+	if(m_stall_state.burst_mode == false)
+		check_irqs();
 
-		if(m_stall_state.burst_mode == true)
-			execute_burst_stall_op(opcode);
-		else
-			execute_op(opcode);
+	if(m_enable_drc) {
+		execute_run_drc();
+		return;
 	}
+
+	while(m_icount > 0)
+		execute_one();
 }
 
 void i960_cpu_device::execute_set_input(int irqline, int state)
@@ -2387,9 +2401,18 @@ void i960_cpu_device::device_reset()
 	m_r[I960_FP] = m_program.read_dword(m_PRCB+24);
 	m_r[I960_SP] = m_r[I960_FP] + 64;
 	m_rcache_pos = 0;
+
+	m_drc_flush = 1;
 }
 
 std::unique_ptr<util::disasm_interface> i960_cpu_device::create_disassembler()
 {
 	return std::make_unique<i960_disassembler>();
 }
+
+
+/***************************************************************************
+    RECOMPILER
+***************************************************************************/
+
+#include "i960drc.hxx"
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+
 
 enum
 {
@@ -63,13 +66,21 @@ enum
 };
 
 
+class i960_frontend;
+
 class i960_cpu_device :  public cpu_device
 {
+	friend class i960_frontend;
+
 public:
 	static constexpr uint16_t BURST = 0x0001;
 
 	// construction/destruction
 	i960_cpu_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock);
+	virtual ~i960_cpu_device();
+
+	// use the recompiler rather than the interpreter
+	void enable_recompiler();
 
 	void i960_stall()
 	{
@@ -172,6 +183,7 @@ private:
 	void bxx_s(uint32_t opcode, int mask);
 	void fxx(uint32_t opcode, int mask);
 	void test(uint32_t opcode, int mask);
+	void execute_one();
 	void execute_op(uint32_t opcode);
 	void execute_burst_stall_op(uint32_t opcode);
 	void take_interrupt(int vector, int lvl);
@@ -179,6 +191,55 @@ private:
 	void do_call(uint32_t adr, int type, uint32_t stack);
 	void do_ret_0();
 	void do_ret();
+
+	// recompiler
+	struct compiler_state
+	{
+		uint32_t cycles;                // accumulated cycles
+		uml::code_label labelnum;       // index for local labels
+	};
+
+	static void cfunc_execute_op(void *param);
+
+	uint32_t const *drc_code_pointer(offs_t pc, bool &ram);
+	void execute_run_drc();
+	void init_recompiler();
+	void flush_cache();
+	void compile_block(offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_redispatch();
+	void generate_checksum_block(drcuml_block &block, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param);
+	void generate_jump(drcuml_block &block, compiler_state &compiler, uint32_t targetpc, bool intrablock);
+	void generate_dynamic_jump(drcuml_block &block, compiler_state &compiler);
+	void generate_leave(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_generic(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_set_cc(drcuml_block &block, uml::parameter src1, uml::parameter src2, bool is_signed);
+	void generate_cond_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uml::parameter cc, uint32_t mask);
+	bool generate_ea(drcuml_block &block, const opcode_desc *desc);
+	bool generate_load(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uml::operand_size size, bool is_signed);
+	bool generate_store(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uml::operand_size size);
+	void generate_call(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_ret(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_get_fp(drcuml_block &block, uml::parameter dst, int reg, bool literal, bool is_double);
+	void generate_set_fp(drcuml_block &block, uint32_t op, uml::parameter src, bool is_double);
+	bool generate_fp_arith(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, bool is_double);
+	bool generate_reg_op(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+
+	bool m_enable_drc;
+	uint32_t m_drc_flush;           // compiled code may be stale
+	uint32_t m_drc_op;              // opcode for C helpers
+	std::unique_ptr<drc_cache> m_drccache;
+	std::unique_ptr<drcuml_state> m_drcuml;
+	std::unique_ptr<i960_frontend> m_drcfe;
+	uml::code_handle *m_entry;      // entry point
+	uml::code_handle *m_nocode;     // nocode exception handler
+	uml::code_handle *m_out_of_cycles; // out of cycles exception handler
+	uml::code_handle *m_redispatch; // hands back to execute_run_drc
 };
 
 
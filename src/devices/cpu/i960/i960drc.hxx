@@ -0,0 +1,1249 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    i960drc.hxx
+
+    Universal machine language-based i960KB emulator.
+
+    The REG format logic, arithmetic, shift, compare and move
+    instructions, the CTRL and COBR branches, call and ret, lda, the
+    single word loads and stores and the floating point add, subtract,
+    multiply and divide are generated as UML.  Everything else runs the
+    interpreter's own code for the instruction through a C helper, so
+    results can't differ from the interpreter, which is still used
+    unless the driver calls enable_recompiler().
+
+    Registers live in m_r as before, and call and ret move the local
+    registers to and from the same m_rcache frames the interpreter
+    uses; only spilling to or filling from the stack in memory, and
+    returns from anything but a local call, go through the helper.
+    Floating point registers are m_fp, and register pairs holding a
+    double are assembled and split up as integers so the layout of m_r
+    doesn't depend on the host.
+
+    A load or store the bus stalls is started again from the instruction,
+    as the interpreter does; the burst stall mode of ldl/ldt/ldq/stl/
+    stt/stq hands back to the interpreter until it's cleared.  Code that
+    can be written is compared against what was compiled each time a
+    sequence is entered.
+
+***************************************************************************/
+
+#include "cpu/drcumlsh.h"
+
+
+namespace {
+
+// size of the code cache
+constexpr u32 CACHE_SIZE                = 8 * 1024 * 1024;
+
+// compilation boundaries -- how far back/forward does the analysis extend?
+constexpr u32 COMPILE_BACKWARDS_BYTES   = 128;
+constexpr u32 COMPILE_FORWARDS_BYTES    = 512;
+constexpr u32 COMPILE_MAX_INSTRUCTIONS  = (COMPILE_BACKWARDS_BYTES / 4) + (COMPILE_FORWARDS_BYTES / 4);
+constexpr u32 COMPILE_MAX_SEQUENCE      = 64;
+
+// exit codes
+constexpr int EXECUTE_OUT_OF_CYCLES     = 0;
+constexpr int EXECUTE_MISSING_CODE      = 1;
+constexpr int EXECUTE_INTERPRET         = 2;
+constexpr int EXECUTE_REDISPATCH        = 3;
+
+// floating point literals other than fp0-fp3
+constexpr double FP_LITERAL_ZERO        = 0.0;
+constexpr double FP_LITERAL_ONE         = 1.0;
+
+} // anonymous namespace
+
+
+// map variables
+#define MAPVAR_PC                       uml::M0
+#define MAPVAR_CYCLES                   uml::M1
+
+
+
+/***************************************************************************
+    C HELPERS
+***************************************************************************/
+
+void i960_cpu_device::cfunc_execute_op(void *param)
+{
+	auto *const cpu = reinterpret_cast<i960_cpu_device *>(param);
+	cpu->execute_op(cpu->m_drc_op);
+}
+
+
+
+/***************************************************************************
+    CORE EXECUTION
+***************************************************************************/
+
+//-------------------------------------------------
+//  enable_recompiler - use the recompiler rather
+//  than the interpreter, if allowed
+//-------------------------------------------------
+
+void i960_cpu_device::enable_recompiler()
+{
+	m_enable_drc = allow_drc();
+}
+
+
+//-------------------------------------------------
+//  drc_code_pointer - find the memory an opcode
+//  is fetched from, or nullptr if it can't be
+//  read directly
+//-------------------------------------------------
+
+uint32_t const *i960_cpu_device::drc_code_pointer(offs_t pc, bool &ram)
+{
+	if (pc & 3)
+		return nullptr;
+
+	address_space &program = space(AS_PROGRAM);
+	auto const ptr = reinterpret_cast<uint32_t const *>(program.get_read_ptr(pc));
+	if (ptr == nullptr)
+		return nullptr;
+
+	// anything that can be written directly has to be checked
+	ram = program.get_write_ptr(pc) != nullptr;
+	return ptr;
+}
+
+
+//-------------------------------------------------
+//  init_recompiler - set up the recompiler the
+//  first time it's used
+//-------------------------------------------------
+
+void i960_cpu_device::init_recompiler()
+{
+	m_drccache = std::make_unique<drc_cache>(CACHE_SIZE);
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_drccache, 0, 1, 32, 2);
+
+	// add UML symbols
+	m_drcuml->symbol_add(&m_IP, sizeof(m_IP), "ip");
+	m_drcuml->symbol_add(&m_icount, sizeof(m_icount), "icount");
+	for (int i = 0; i < 16; i++)
+	{
+		m_drcuml->symbol_add(&m_r[i], sizeof(m_r[0]), util::string_format("r%d", i).c_str());
+		m_drcuml->symbol_add(&m_r[i + 16], sizeof(m_r[0]), util::string_format("g%d", i).c_str());
+	}
+	m_drcuml->symbol_add(&m_AC, sizeof(m_AC), "ac");
+	m_drcuml->symbol_add(&m_rcache_pos, sizeof(m_rcache_pos), "rcache_pos");
+
+	m_drcfe = std::make_unique<i960_frontend>(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE);
+
+	m_drc_flush = 1;
+}
+
+
+//-------------------------------------------------
+//  execute_run_drc - execute generated code until
+//  the timeslice runs out
+//-------------------------------------------------
+
+void i960_cpu_device::execute_run_drc()
+{
+	if (!m_drcuml)
+		init_recompiler();
+
+	while (m_icount > 0)
+	{
+		// a burst stall is finished off by the interpreter
+		if (m_stall_state.burst_mode || (m_IP & 3))
+		{
+			execute_one();
+			continue;
+		}
+
+		// reset the cache if dirty
+		if (m_drc_flush)
+			flush_cache();
+
+		int const execute_result = m_drcuml->execute(*m_entry);
+
+		// if we need to recompile, do it
+		if (execute_result == EXECUTE_MISSING_CODE)
+			compile_block(m_IP);
+		else if (execute_result == EXECUTE_INTERPRET)
+			execute_one();
+	}
+}
+
+
+//-------------------------------------------------
+//  flush_cache - throw away all generated code
+//  and regenerate the static handlers
+//-------------------------------------------------
+
+void i960_cpu_device::flush_cache()
+{
+	// empty the transient cache contents
+	m_drcuml->reset();
+	m_drc_flush = 0;
+
+	try
+	{
+		// generate the entry point and exception handlers
+		static_generate_entry_point();
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_redispatch();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Error generating i960 static handlers\n");
+	}
+}
+
+
+//-------------------------------------------------
+//  compile_block - compile a block of code
+//  starting at the given PC
+//-------------------------------------------------
+
+void i960_cpu_device::compile_block(offs_t pc)
+{
+	// describe the block
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+
+	bool override = false;
+	for (;;)
+	{
+		try
+		{
+			compiler_state compiler = { 0, 1 };
+			const opcode_desc *seqlast;
+
+			drcuml_block &block(m_drcuml->begin_block(COMPILE_MAX_INSTRUCTIONS * 128));
+
+			for (const opcode_desc *seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				// determine the last instruction in this sequence
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				// if we don't have a hash for this mode/pc, or if we are overriding all, add one
+				if (override || !m_drcuml->hash_exists(0, seqhead->pc))
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,seqhead->pc
+
+				// if we already have a hash, and this is the first sequence, assume that we
+				// are recompiling due to being out of sync and allow future overrides
+				else if (seqhead == desclist)
+				{
+					override = true;
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,seqhead->pc
+				}
+
+				// otherwise, redispatch to that fixed PC and skip the rest of the processing
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc
+					UML_HASHJMP(block, 0, seqhead->pc, *m_nocode);                          // hashjmp 0,seqhead->pc,nocode
+					continue;
+				}
+
+				// label this instruction, if it may be jumped to locally
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc
+
+				// make sure the code in RAM hasn't changed
+				generate_checksum_block(block, seqhead, seqlast);
+
+				// iterate over instructions in the sequence and compile them
+				for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, compiler, curdesc);
+
+				// count off cycles and go to the next instruction
+				uint32_t const nextpc = seqlast->pc + seqlast->length;
+				generate_update_cycles(block, compiler, nextpc);                            // <subtract cycles>
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, 0, nextpc, *m_nocode);                               // hashjmp 0,nextpc,nocode
+			}
+
+			block.end();
+			return;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			flush_cache();
+		}
+	}
+}
+
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+//-------------------------------------------------
+//  static_generate_entry_point - generate a
+//  static entry point
+//-------------------------------------------------
+
+void i960_cpu_device::static_generate_entry_point()
+{
+	drcuml_block &block(m_drcuml->begin_block(20));
+
+	// forward references
+	if (!m_nocode)
+		m_nocode = m_drcuml->handle_alloc("nocode");
+
+	if (!m_entry)
+		m_entry = m_drcuml->handle_alloc("entry");
+	UML_HANDLE(block, *m_entry);                                                            // handle  entry
+
+	// generate a hash jump via the current PC
+	UML_LOAD(block, I0, &m_IP, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[ip]
+	UML_HASHJMP(block, 0, I0, *m_nocode);                                                   // hashjmp 0,i0,nocode
+
+	block.end();
+}
+
+
+//-------------------------------------------------
+//  static_generate_nocode_handler - generate an
+//  exception handler for "out of code"
+//-------------------------------------------------
+
+void i960_cpu_device::static_generate_nocode_handler()
+{
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	UML_HANDLE(block, *m_nocode);                                                           // handle  nocode
+	UML_GETEXP(block, I0);                                                                  // getexp  i0
+	UML_STORE(block, &m_IP, 0, I0, SIZE_DWORD, SCALE_x1);                                   // store   [ip],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                                  // exit    EXECUTE_MISSING_CODE
+
+	block.end();
+}
+
+
+//-------------------------------------------------
+//  static_generate_out_of_cycles - generate an
+//  out of cycles exception handler
+//-------------------------------------------------
+
+void i960_cpu_device::static_generate_out_of_cycles()
+{
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	if (!m_out_of_cycles)
+		m_out_of_cycles = m_drcuml->handle_alloc("out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                                    // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                                  // getexp  i0
+	UML_STORE(block, &m_IP, 0, I0, SIZE_DWORD, SCALE_x1);                                   // store   [ip],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                                 // exit    EXECUTE_OUT_OF_CYCLES
+
+	block.end();
+}
+
+
+//-------------------------------------------------
+//  static_generate_redispatch - generate an
+//  exception handler that goes back to
+//  execute_run_drc to decide what runs next
+//-------------------------------------------------
+
+void i960_cpu_device::static_generate_redispatch()
+{
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	if (!m_redispatch)
+		m_redispatch = m_drcuml->handle_alloc("redispatch");
+	UML_HANDLE(block, *m_redispatch);                                                       // handle  redispatch
+	UML_GETEXP(block, I0);                                                                  // getexp  i0
+	UML_STORE(block, &m_IP, 0, I0, SIZE_DWORD, SCALE_x1);                                   // store   [ip],i0
+	UML_EXIT(block, EXECUTE_REDISPATCH);                                                    // exit    EXECUTE_REDISPATCH
+
+	block.end();
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+//-------------------------------------------------
+//  generate_checksum_block - generate code to
+//  recompile a sequence if any of its code in RAM
+//  has changed since it was compiled
+//-------------------------------------------------
+
+void i960_cpu_device::generate_checksum_block(drcuml_block &block, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	for (const opcode_desc *desc = seqhead; desc != seqlast->next(); desc = desc->next())
+	{
+		if (!(desc->userflags & i960_frontend::USERFLAG_CODE_IN_RAM))
+			continue;
+
+		for (int word = 0; word < desc->length / 4; word++)
+		{
+			bool ram;
+			uint32_t const *const opptr = drc_code_pointer(desc->physpc + word * 4, ram);
+			UML_LOAD(block, I0, opptr, 0, SIZE_DWORD, SCALE_x1);                            // load    i0,[opptr]
+			UML_CMP(block, I0, desc->opptr.l[word]);                                        // cmp     i0,op
+			UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                               // exne    nocode,seqhead->pc
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  generate_sequence_instruction - generate code
+//  for a single instruction in a sequence
+//-------------------------------------------------
+
+void i960_cpu_device::generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	// set the PC map variable
+	UML_MAPVAR(block, MAPVAR_PC, desc->pc);                                                 // mapvar  PC,desc->pc
+
+	// code that can't be compiled is fetched and run by the interpreter
+	if (desc->flags & OPFLAG_INVALID_OPCODE)
+	{
+		UML_MOV(block, I0, desc->pc);                                                       // mov     i0,desc->pc
+		generate_update_cycles(block, compiler, uml::I0);                                   // <subtract cycles>
+		UML_STORE(block, &m_IP, 0, I0, SIZE_DWORD, SCALE_x1);                               // store   [ip],i0
+		UML_EXIT(block, EXECUTE_INTERPRET);                                                 // exit    EXECUTE_INTERPRET
+		return;
+	}
+
+	// update the icount map variable
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                                      // mapvar  CYCLES,compiler.cycles
+
+	// if we are debugging, call the debugger
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		UML_STORE(block, &m_IP, 0, desc->pc, SIZE_DWORD, SCALE_x1);                         // store   [ip],desc->pc
+		UML_DEBUG(block, desc->pc);                                                         // debug   desc->pc
+	}
+
+	// compile the instruction, running anything not handled through the interpreter
+	if (!generate_opcode(block, compiler, desc))
+		generate_generic(block, compiler, desc);
+}
+
+
+//-------------------------------------------------
+//  generate_update_cycles - generate code to
+//  subtract cycles from the icount and generate
+//  an exception if out
+//-------------------------------------------------
+
+void i960_cpu_device::generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param)
+{
+	// account for cycles; like the interpreter, stop once the count isn't positive
+	if (compiler.cycles > 0)
+	{
+		UML_LOAD(block, I1, &m_icount, 0, SIZE_DWORD, SCALE_x1);                            // load    i1,[icount]
+		UML_SUB(block, I1, I1, compiler.cycles);                                            // sub     i1,i1,cycles
+		UML_STORE(block, &m_icount, 0, I1, SIZE_DWORD, SCALE_x1);                           // store   [icount],i1
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                                // mapvar  cycles,0
+		UML_CMP(block, I1, 0);                                                              // cmp     i1,0
+		UML_EXHc(block, COND_LE, *m_out_of_cycles, param);                                  // exh     out_of_cycles,param
+	}
+	compiler.cycles = 0;
+}
+
+
+//-------------------------------------------------
+//  generate_jump - generate code to go to a fixed
+//  address
+//-------------------------------------------------
+
+void i960_cpu_device::generate_jump(drcuml_block &block, compiler_state &compiler, uint32_t targetpc, bool intrablock)
+{
+	compiler_state compiler_temp(compiler);
+	generate_update_cycles(block, compiler_temp, targetpc);                                 // <subtract cycles>
+
+	if (intrablock)
+		UML_JMP(block, targetpc | 0x80000000);                                              // jmp     targetpc | 0x80000000
+	else
+		UML_HASHJMP(block, 0, targetpc, *m_nocode);                                         // hashjmp 0,targetpc,nocode
+}
+
+
+//-------------------------------------------------
+//  generate_dynamic_jump - generate code to go to
+//  the address in I0, going back to
+//  execute_run_drc if a burst stall is pending
+//  or the address is misaligned
+//-------------------------------------------------
+
+void i960_cpu_device::generate_dynamic_jump(drcuml_block &block, compiler_state &compiler)
+{
+	compiler_state compiler_temp(compiler);
+	generate_update_cycles(block, compiler_temp, uml::I0);                                  // <subtract cycles>
+
+	UML_LOAD(block, I1, &m_stall_state.burst_mode, 0, SIZE_BYTE, SCALE_x1);                 // load    i1,[burst_mode]
+	UML_CMP(block, I1, 0);                                                                  // cmp     i1,0
+	UML_EXHc(block, COND_NE, *m_redispatch, I0);                                            // exhne   redispatch,i0
+	UML_TEST(block, I0, 3);                                                                 // test    i0,3
+	UML_EXHc(block, COND_NZ, *m_redispatch, I0);                                            // exhnz   redispatch,i0
+	UML_HASHJMP(block, 0, I0, *m_nocode);                                                   // hashjmp 0,i0,nocode
+}
+
+
+//-------------------------------------------------
+//  generate_leave - generate code to carry on
+//  after a C helper, leaving the sequence if it
+//  didn't go to the next instruction
+//-------------------------------------------------
+
+void i960_cpu_device::generate_leave(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uml::code_label const leave = compiler.labelnum++;
+	uml::code_label const skip = compiler.labelnum++;
+
+	// a branch, an interrupt, a stall or a burst stall all show up in IP
+	UML_LOAD(block, I0, &m_IP, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[ip]
+	if (!(desc->flags & OPFLAG_END_SEQUENCE))
+	{
+		UML_CMP(block, I0, desc->pc + desc->length);                                        // cmp     i0,desc->pc + desc->length
+		UML_JMPc(block, COND_NE, leave);                                                    // jne     leave
+		UML_LOAD(block, I1, &m_stall_state.burst_mode, 0, SIZE_BYTE, SCALE_x1);             // load    i1,[burst_mode]
+		UML_CMP(block, I1, 0);                                                              // cmp     i1,0
+		UML_JMPc(block, COND_E, skip);                                                      // je      skip
+		UML_LABEL(block, leave);                                                            // leave:
+	}
+	generate_dynamic_jump(block, compiler);
+	UML_LABEL(block, skip);                                                                 // skip:
+}
+
+
+//-------------------------------------------------
+//  generate_generic - generate code to run an
+//  instruction through the interpreter
+//-------------------------------------------------
+
+void i960_cpu_device::generate_generic(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	// set things up the way execute_one() does; the interpreter counts the cycles
+	UML_STORE(block, &m_PIP, 0, desc->pc, SIZE_DWORD, SCALE_x1);                            // store   [pip],desc->pc
+	UML_STORE(block, &m_IP, 0, desc->pc + 4, SIZE_DWORD, SCALE_x1);                         // store   [ip],desc->pc + 4
+	UML_STORE(block, &m_stalled, 0, 0, SIZE_BYTE, SCALE_x1);                                // store   [stalled],0
+	UML_STORE(block, &m_drc_op, 0, desc->opptr.l[0], SIZE_DWORD, SCALE_x1);                 // store   [drc_op],op
+	UML_CALLC(block, cfunc_execute_op, this);                                               // callc   cfunc_execute_op,this
+
+	generate_leave(block, compiler, desc);
+}
+
+
+//-------------------------------------------------
+//  generate_set_cc - generate code to compare two
+//  values and set the condition code the way
+//  cmp_s/cmp_u do, leaving it in I0 as well
+//-------------------------------------------------
+
+void i960_cpu_device::generate_set_cc(drcuml_block &block, uml::parameter src1, uml::parameter src2, bool is_signed)
+{
+	UML_CMP(block, src1, src2);                                                             // cmp     src1,src2
+	UML_MOV(block, I0, 1);                                                                  // mov     i0,1
+	UML_MOVc(block, COND_E, I0, 2);                                                         // mov     i0,2,e
+	UML_MOVc(block, is_signed ? COND_L : COND_B, I0, 4);                                    // mov     i0,4,l/b
+	UML_AND(block, I1, mem(&m_AC), ~uint32_t(7));                                           // and     i1,[ac],~7
+	UML_OR(block, mem(&m_AC), I1, I0);                                                      // or      [ac],i1,i0
+}
+
+
+//-------------------------------------------------
+//  generate_cond_branch - generate code to take a
+//  branch if the condition code in cc matches
+//  mask
+//-------------------------------------------------
+
+void i960_cpu_device::generate_cond_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uml::parameter cc, uint32_t mask)
+{
+	uml::code_label const skip = compiler.labelnum++;
+
+	UML_TEST(block, cc, mask);                                                              // test    cc,mask
+	UML_JMPc(block, COND_Z, skip);                                                          // jz      skip
+	generate_jump(block, compiler, desc->targetpc, (desc->flags & OPFLAG_INTRABLOCK_BRANCH) != 0);
+	UML_LABEL(block, skip);                                                                 // skip:
+}
+
+
+//-------------------------------------------------
+//  generate_ea - generate code to put the
+//  effective address of a MEM format instruction
+//  in I0; returns false without generating
+//  anything for modes get_ea() doesn't handle
+//-------------------------------------------------
+
+bool i960_cpu_device::generate_ea(drcuml_block &block, const opcode_desc *desc)
+{
+	uint32_t const op = desc->opptr.l[0];
+	int const abase = (op >> 14) & 0x1f;
+
+	if (!(op & 0x00001000)) // MEMA
+	{
+		uint32_t const offset = op & 0x1fff;
+		if (!(op & 0x2000))
+			UML_MOV(block, I0, offset);                                                     // mov     i0,offset
+		else
+			UML_ADD(block, I0, mem(&m_r[abase]), offset);                                   // add     i0,[abase],offset
+		return true;
+	}
+
+	// MEMB
+	int const index = op & 0x1f;
+	int const scale = (op >> 7) & 0x7;
+	uint32_t const disp = desc->opptr.l[1];
+	switch ((op >> 10) & 0xf)
+	{
+	case 0x4:
+		UML_MOV(block, I0, mem(&m_r[abase]));                                               // mov     i0,[abase]
+		return true;
+
+	case 0x5:
+		// relative to the next instruction
+		UML_MOV(block, I0, desc->pc + 8 + disp);                                            // mov     i0,desc->pc + 8 + disp
+		return true;
+
+	case 0x7:
+		UML_SHL(block, I0, mem(&m_r[index]), scale);                                        // shl     i0,[index],scale
+		UML_ADD(block, I0, I0, mem(&m_r[abase]));                                           // add     i0,i0,[abase]
+		return true;
+
+	case 0xc:
+		UML_MOV(block, I0, disp);                                                           // mov     i0,disp
+		return true;
+
+	case 0xd:
+		UML_ADD(block, I0, mem(&m_r[abase]), disp);                                         // add     i0,[abase],disp
+		return true;
+
+	case 0xe:
+		UML_SHL(block, I0, mem(&m_r[index]), scale);                                        // shl     i0,[index],scale
+		UML_ADD(block, I0, I0, disp);                                                       // add     i0,i0,disp
+		return true;
+
+	case 0xf:
+		UML_SHL(block, I0, mem(&m_r[index]), scale);                                        // shl     i0,[index],scale
+		UML_ADD(block, I0, I0, mem(&m_r[abase]));                                           // add     i0,i0,[abase]
+		UML_ADD(block, I0, I0, disp);                                                       // add     i0,i0,disp
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+
+//-------------------------------------------------
+//  generate_load - generate code for a single
+//  register load, leaving misaligned addresses
+//  to the interpreter
+//-------------------------------------------------
+
+bool i960_cpu_device::generate_load(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uml::operand_size size, bool is_signed)
+{
+	uint32_t const op = desc->opptr.l[0];
+	uml::code_label const slow = compiler.labelnum++;
+	uml::code_label const ok = compiler.labelnum++;
+	uml::code_label const done = compiler.labelnum++;
+
+	if (!generate_ea(block, desc))
+		return false;
+	if (size != uml::SIZE_BYTE)
+	{
+		UML_TEST(block, I0, (size == uml::SIZE_WORD) ? 1 : 3);                              // test    i0,mask
+		UML_JMPc(block, COND_NZ, slow);                                                     // jnz     slow
+	}
+
+	// the bus can see where the CPU is, and stall it
+	UML_STORE(block, &m_PIP, 0, desc->pc, SIZE_DWORD, SCALE_x1);                            // store   [pip],desc->pc
+	UML_STORE(block, &m_IP, 0, desc->pc + desc->length, SIZE_DWORD, SCALE_x1);              // store   [ip],desc->pc + desc->length
+	UML_STORE(block, &m_stalled, 0, 0, SIZE_BYTE, SCALE_x1);                                // store   [stalled],0
+	UML_READ(block, I1, I0, size, SPACE_PROGRAM);                                           // read    i1,i0,size,program
+	UML_SUB(block, mem(&m_icount), mem(&m_icount), 4);                                      // sub     [icount],[icount],4
+
+	// a stalled load is started again
+	UML_LOAD(block, I2, &m_stalled, 0, SIZE_BYTE, SCALE_x1);                                // load    i2,[stalled]
+	UML_CMP(block, I2, 0);                                                                  // cmp     i2,0
+	UML_JMPc(block, COND_E, ok);                                                            // je      ok
+	generate_jump(block, compiler, desc->pc, false);
+	UML_LABEL(block, ok);                                                                   // ok:
+
+	if (is_signed)
+		UML_SEXT(block, I1, I1, size);                                                      // sext    i1,i1,size
+	UML_STORE(block, &m_r[(op >> 19) & 0x1f], 0, I1, SIZE_DWORD, SCALE_x1);                 // store   [dst],i1
+	UML_JMP(block, done);                                                                   // jmp     done
+
+	UML_LABEL(block, slow);                                                                 // slow:
+	generate_generic(block, compiler, desc);
+	UML_LABEL(block, done);                                                                 // done:
+	return true;
+}
+
+
+//-------------------------------------------------
+//  generate_store - generate code for a single
+//  register store, leaving misaligned addresses
+//  to the interpreter
+//-------------------------------------------------
+
+bool i960_cpu_device::generate_store(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uml::operand_size size)
+{
+	uint32_t const op = desc->opptr.l[0];
+	uml::code_label const slow = compiler.labelnum++;
+	uml::code_label const ok = compiler.labelnum++;
+	uml::code_label const done = compiler.labelnum++;
+
+	if (!generate_ea(block, desc))
+		return false;
+	if (size != uml::SIZE_BYTE)
+	{
+		UML_TEST(block, I0, (size == uml::SIZE_WORD) ? 1 : 3);                              // test    i0,mask
+		UML_JMPc(block, COND_NZ, slow);                                                     // jnz     slow
+	}
+
+	UML_STORE(block, &m_PIP, 0, desc->pc, SIZE_DWORD, SCALE_x1);                            // store   [pip],desc->pc
+	UML_STORE(block, &m_IP, 0, desc->pc + desc->length, SIZE_DWORD, SCALE_x1);              // store   [ip],desc->pc + desc->length
+	UML_STORE(block, &m_stalled, 0, 0, SIZE_BYTE, SCALE_x1);                                // store   [stalled],0
+	UML_WRITE(block, I0, mem(&m_r[(op >> 19) & 0x1f]), size, SPACE_PROGRAM);                // write   i0,[src],size,program
+	UML_SUB(block, mem(&m_icount), mem(&m_icount), 2);                                      // sub     [icount],[icount],2
+
+	// a stalled store is started again
+	UML_LOAD(block, I2, &m_stalled, 0, SIZE_BYTE, SCALE_x1);                                // load    i2,[stalled]
+	UML_CMP(block, I2, 0);                                                                  // cmp     i2,0
+	UML_JMPc(block, COND_E, ok);                                                            // je      ok
+	generate_jump(block, compiler, desc->pc, false);
+	UML_LABEL(block, ok);                                                                   // ok:
+	UML_JMP(block, done);                                                                   // jmp     done
+
+	UML_LABEL(block, slow);                                                                 // slow:
+	generate_generic(block, compiler, desc);
+	UML_LABEL(block, done);                                                                 // done:
+	return true;
+}
+
+
+//-------------------------------------------------
+//  generate_call - generate code for call, saving
+//  the local registers in the register cache
+//  like do_call; spilling the frame to memory is
+//  left to the interpreter
+//-------------------------------------------------
+
+void i960_cpu_device::generate_call(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uml::code_label const slow = compiler.labelnum++;
+
+	UML_LOAD(block, I0, &m_rcache_pos, 0, SIZE_DWORD, SCALE_x1);                            // load    i0,[rcache_pos]
+	UML_CMP(block, I0, I960_RCACHE_SIZE);                                                   // cmp     i0,I960_RCACHE_SIZE
+	UML_JMPc(block, COND_AE, slow);                                                         // jae     slow
+
+	// the new RIP is part of the saved frame
+	UML_STORE(block, &m_r[I960_RIP], 0, desc->pc + 4, SIZE_DWORD, SCALE_x1);                // store   [rip],desc->pc + 4
+	UML_SHL(block, I1, I0, 4);                                                              // shl     i1,i0,4
+	for (int i = 0; i < 0x10; i++)
+	{
+		UML_LOAD(block, I2, &m_r[i], 0, SIZE_DWORD, SCALE_x1);                              // load    i2,[r<i>]
+		UML_STORE(block, &m_rcache[0][i], I1, I2, SIZE_DWORD, SCALE_x4);                    // store   rcache[i],i1,i2
+	}
+	UML_AND(block, I2, mem(&m_r[I960_FP]), ~uint32_t(0x3f));                                // and     i2,[fp],~0x3f
+	UML_STORE(block, m_rcache_frame_addr, I0, I2, SIZE_DWORD, SCALE_x4);                    // store   rcache_frame_addr,i0,i2
+	UML_ADD(block, I0, I0, 1);                                                              // add     i0,i0,1
+	UML_STORE(block, &m_rcache_pos, 0, I0, SIZE_DWORD, SCALE_x1);                           // store   [rcache_pos],i0
+
+	// new frame
+	UML_AND(block, mem(&m_r[I960_PFP]), mem(&m_r[I960_FP]), ~uint32_t(7));                  // and     [pfp],[fp],~7
+	UML_ADD(block, I2, mem(&m_r[I960_SP]), 63);                                             // add     i2,[sp],63
+	UML_AND(block, I2, I2, ~uint32_t(63));                                                  // and     i2,i2,~63
+	UML_MOV(block, mem(&m_r[I960_FP]), I2);                                                 // mov     [fp],i2
+	UML_ADD(block, mem(&m_r[I960_SP]), I2, 64);                                             // add     [sp],i2,64
+
+	UML_SUB(block, mem(&m_icount), mem(&m_icount), 9);                                      // sub     [icount],[icount],9
+	generate_jump(block, compiler, desc->targetpc, (desc->flags & OPFLAG_INTRABLOCK_BRANCH) != 0);
+
+	UML_LABEL(block, slow);                                                                 // slow:
+	generate_generic(block, compiler, desc);
+}
+
+
+//-------------------------------------------------
+//  generate_ret - generate code for ret from a
+//  local call, restoring the local registers from
+//  the register cache like do_ret_0; anything
+//  else is left to the interpreter
+//-------------------------------------------------
+
+void i960_cpu_device::generate_ret(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uml::code_label const slow = compiler.labelnum++;
+
+	UML_LOAD(block, I0, &m_r[I960_PFP], 0, SIZE_DWORD, SCALE_x1);                           // load    i0,[pfp]
+	UML_TEST(block, I0, 7);                                                                 // test    i0,7
+	UML_JMPc(block, COND_NZ, slow);                                                         // jnz     slow
+	UML_LOAD(block, I1, &m_rcache_pos, 0, SIZE_DWORD, SCALE_x1);                            // load    i1,[rcache_pos]
+	UML_SUB(block, I1, I1, 1);                                                              // sub     i1,i1,1
+	UML_CMP(block, I1, I960_RCACHE_SIZE);                                                   // cmp     i1,I960_RCACHE_SIZE
+	UML_JMPc(block, COND_AE, slow);                                                         // jae     slow
+
+	UML_STORE(block, &m_rcache_pos, 0, I1, SIZE_DWORD, SCALE_x1);                           // store   [rcache_pos],i1
+	UML_AND(block, mem(&m_r[I960_FP]), I0, ~uint32_t(0x3f));                                // and     [fp],i0,~0x3f
+	UML_SHL(block, I1, I1, 4);                                                              // shl     i1,i1,4
+	for (int i = 0; i < 0x10; i++)
+	{
+		UML_LOAD(block, I2, &m_rcache[0][i], I1, SIZE_DWORD, SCALE_x4);                     // load    i2,rcache[i],i1
+		UML_STORE(block, &m_r[i], 0, I2, SIZE_DWORD, SCALE_x1);                             // store   [r<i>],i2
+	}
+
+	UML_SUB(block, mem(&m_icount), mem(&m_icount), 7);                                      // sub     [icount],[icount],7
+	UML_LOAD(block, I0, &m_r[I960_RIP], 0, SIZE_DWORD, SCALE_x1);                           // load    i0,[rip]
+	generate_dynamic_jump(block, compiler);
+
+	UML_LABEL(block, slow);                                                                 // slow:
+	generate_generic(block, compiler, desc);
+}
+
+
+//-------------------------------------------------
+//  generate_get_fp - generate code to load a
+//  floating point operand into dst as a double
+//-------------------------------------------------
+
+void i960_cpu_device::generate_get_fp(drcuml_block &block, uml::parameter dst, int reg, bool literal, bool is_double)
+{
+	if (literal)
+	{
+		if (reg < 4)
+			UML_FDMOV(block, dst, mem(&m_fp[reg]));                                         // fdmov   dst,[fp<reg>]
+		else
+			UML_FDMOV(block, dst, mem((reg == 0x16) ? &FP_LITERAL_ONE : &FP_LITERAL_ZERO)); // fdmov   dst,[literal]
+	}
+	else if (is_double)
+	{
+		reg &= 0x1e;
+		UML_DLOAD(block, I0, &m_r[reg], 0, SIZE_DWORD, SCALE_x1);                           // dload   i0,[r<reg>],dword
+		UML_DLOAD(block, I1, &m_r[reg + 1], 0, SIZE_DWORD, SCALE_x1);                       // dload   i1,[r<reg+1>],dword
+		UML_DSHL(block, I1, I1, 32);                                                        // dshl    i1,i1,32
+		UML_DOR(block, I0, I0, I1);                                                         // dor     i0,i0,i1
+		UML_FDCOPYI(block, dst, I0);                                                        // fdcopyi dst,i0
+	}
+	else
+	{
+		UML_FDFRFLT(block, dst, mem(&m_r[reg]), SIZE_DWORD);                                // fdfrflt dst,[r<reg>],dword
+	}
+}
+
+
+//-------------------------------------------------
+//  generate_set_fp - generate code to store a
+//  floating point result the way set_rif and
+//  set_rifl do
+//-------------------------------------------------
+
+void i960_cpu_device::generate_set_fp(drcuml_block &block, uint32_t op, uml::parameter src, bool is_double)
+{
+	if (op & 0x00002000)
+	{
+		UML_FDMOV(block, mem(&m_fp[(op >> 19) & 3]), src);                                  // fdmov   [fp<dst>],src
+	}
+	else if (is_double)
+	{
+		int const reg = (op >> 19) & 0x1e;
+		UML_ICOPYFD(block, I0, src);                                                        // icopyfd i0,src
+		UML_STORE(block, &m_r[reg], 0, I0, SIZE_DWORD, SCALE_x1);                           // store   [r<reg>],i0
+		UML_DSHR(block, I0, I0, 32);                                                        // dshr    i0,i0,32
+		UML_STORE(block, &m_r[reg + 1], 0, I0, SIZE_DWORD, SCALE_x1);                       // store   [r<reg+1>],i0
+	}
+	else
+	{
+		UML_FSFRFLT(block, mem(&m_r[(op >> 19) & 0x1f]), src, SIZE_QWORD);                  // fsfrflt [r<dst>],src,qword
+	}
+}
+
+
+//-------------------------------------------------
+//  generate_fp_arith - generate code for addr,
+//  subr, mulr and divr and their long forms,
+//  which the interpreter does in double precision
+//-------------------------------------------------
+
+bool i960_cpu_device::generate_fp_arith(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, bool is_double)
+{
+	uint32_t const op = desc->opptr.l[0];
+
+	// only fp0-fp3 can be written
+	if ((op & 0x00002000) && (op & 0x00e00000))
+		return false;
+
+	switch ((op >> 7) & 0xf)
+	{
+	case 0xb: compiler.cycles += is_double ? 77 : 35; break;
+	case 0xc: compiler.cycles += is_double ? 36 : 18; break;
+	case 0xd: compiler.cycles += is_double ? 13 : 10; break;
+	case 0xf: compiler.cycles += is_double ? 13 : 10; break;
+	default: return false;
+	}
+
+	generate_get_fp(block, uml::F0, op & 0x1f, (op & 0x00000800) != 0, is_double);
+	generate_get_fp(block, uml::F1, (op >> 14) & 0x1f, (op & 0x00001000) != 0, is_double);
+	switch ((op >> 7) & 0xf)
+	{
+	case 0xb: UML_FDDIV(block, F0, F1, F0); break;                                          // fddiv   f0,f1,f0
+	case 0xc: UML_FDMUL(block, F0, F1, F0); break;                                          // fdmul   f0,f1,f0
+	case 0xd: UML_FDSUB(block, F0, F1, F0); break;                                          // fdsub   f0,f1,f0
+	case 0xf: UML_FDADD(block, F0, F1, F0); break;                                          // fdadd   f0,f1,f0
+	}
+	generate_set_fp(block, op, uml::F0, is_double);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  generate_reg_op - generate code for a REG
+//  format integer instruction, or return false if
+//  it's left to the interpreter
+//-------------------------------------------------
+
+bool i960_cpu_device::generate_reg_op(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t const op = desc->opptr.l[0];
+	int const s1 = op & 0x1f;
+	int const s2 = (op >> 14) & 0x1f;
+	int const d = (op >> 19) & 0x1f;
+	uml::parameter const src1 = (op & 0x00000800) ? uml::parameter(s1) : uml::mem(&m_r[s1]);
+	uml::parameter const src2 = (op & 0x00001000) ? uml::parameter(s2) : uml::mem(&m_r[s2]);
+	uml::parameter const dst = uml::mem(&m_r[d]);
+	uint32_t const function = ((op >> 20) & 0xff0) | ((op >> 7) & 0xf);
+
+	// the bit an operand selects: 1 << (src1 & 31)
+	auto const bit = [&] () -> uml::parameter
+	{
+		if (op & 0x00000800)
+			return uml::parameter(1U << s1);
+		UML_AND(block, I0, src1, 31);                                                       // and     i0,src1,31
+		UML_SHL(block, I0, 1, I0);                                                          // shl     i0,1,i0
+		return uml::I0;
+	};
+
+	// set_ri() doesn't allow a literal destination
+	switch (function)
+	{
+	case 0x5a0: case 0x5a1: case 0x5ae:
+	case 0x5dc: case 0x5ec: case 0x5fc:
+		break;
+
+	default:
+		if (op & 0x00002000)
+			return false;
+		break;
+	}
+
+	switch (function)
+	{
+	case 0x580: // notbit
+		compiler.cycles += 2;
+		UML_XOR(block, dst, src2, bit());                                                   // xor     dst,src2,bit
+		return true;
+
+	case 0x581: // and
+		compiler.cycles += 1;
+		UML_AND(block, dst, src2, src1);                                                    // and     dst,src2,src1
+		return true;
+
+	case 0x582: // andnot
+		compiler.cycles += 1;
+		UML_XOR(block, I0, src1, ~uint32_t(0));                                             // xor     i0,src1,~0
+		UML_AND(block, dst, src2, I0);                                                      // and     dst,src2,i0
+		return true;
+
+	case 0x583: // setbit
+		compiler.cycles += 2;
+		UML_OR(block, dst, src2, bit());                                                    // or      dst,src2,bit
+		return true;
+
+	case 0x584: // notand
+		compiler.cycles += 1;
+		UML_XOR(block, I0, src2, ~uint32_t(0));                                             // xor     i0,src2,~0
+		UML_AND(block, dst, I0, src1);                                                      // and     dst,i0,src1
+		return true;
+
+	case 0x586: // xor
+		compiler.cycles += 1;
+		UML_XOR(block, dst, src2, src1);                                                    // xor     dst,src2,src1
+		return true;
+
+	case 0x587: // or
+		compiler.cycles += 1;
+		UML_OR(block, dst, src2, src1);                                                     // or      dst,src2,src1
+		return true;
+
+	case 0x588: // nor
+		compiler.cycles += 1;
+		UML_OR(block, I0, src2, src1);                                                      // or      i0,src2,src1
+		UML_XOR(block, dst, I0, ~uint32_t(0));                                              // xor     dst,i0,~0
+		return true;
+
+	case 0x589: // xnor
+		compiler.cycles += 1;
+		UML_XOR(block, I0, src2, src1);                                                     // xor     i0,src2,src1
+		UML_XOR(block, dst, I0, ~uint32_t(0));                                              // xor     dst,i0,~0
+		return true;
+
+	case 0x58a: // not
+		compiler.cycles += 1;
+		UML_XOR(block, dst, src1, ~uint32_t(0));                                            // xor     dst,src1,~0
+		return true;
+
+	case 0x58b: // ornot
+		compiler.cycles += 1;
+		UML_XOR(block, I0, src1, ~uint32_t(0));                                             // xor     i0,src1,~0
+		UML_OR(block, dst, src2, I0);                                                       // or      dst,src2,i0
+		return true;
+
+	case 0x58c: // clrbit
+		compiler.cycles += 2;
+		UML_XOR(block, I1, bit(), ~uint32_t(0));                                            // xor     i1,bit,~0
+		UML_AND(block, dst, src2, I1);                                                      // and     dst,src2,i1
+		return true;
+
+	case 0x58d: // notor
+		compiler.cycles += 1;
+		UML_XOR(block, I0, src2, ~uint32_t(0));                                             // xor     i0,src2,~0
+		UML_OR(block, dst, I0, src1);                                                       // or      dst,i0,src1
+		return true;
+
+	case 0x58e: // nand
+		compiler.cycles += 2;
+		UML_AND(block, I0, src2, src1);                                                     // and     i0,src2,src1
+		UML_XOR(block, dst, I0, ~uint32_t(0));                                              // xor     dst,i0,~0
+		return true;
+
+	case 0x590: // addo
+	case 0x591: // addi
+		compiler.cycles += 1;
+		UML_ADD(block, dst, src2, src1);                                                    // add     dst,src2,src1
+		return true;
+
+	case 0x592: // subo
+	case 0x593: // subi
+		compiler.cycles += 1;
+		UML_SUB(block, dst, src2, src1);                                                    // sub     dst,src2,src1
+		return true;
+
+	case 0x598: // shro
+		compiler.cycles += 1;
+		UML_SHR(block, dst, src2, src1);                                                    // shr     dst,src2,src1
+		return true;
+
+	case 0x59b: // shri
+		compiler.cycles += 1;
+		UML_SAR(block, dst, src2, src1);                                                    // sar     dst,src2,src1
+		return true;
+
+	case 0x59c: // shlo
+	case 0x59e: // shli
+		compiler.cycles += 1;
+		UML_SHL(block, dst, src2, src1);                                                    // shl     dst,src2,src1
+		return true;
+
+	case 0x59d: // rotate
+		compiler.cycles += 1;
+		UML_AND(block, I0, src1, 0x1f);                                                     // and     i0,src1,0x1f
+		UML_ROL(block, dst, src2, I0);                                                      // rol     dst,src2,i0
+		return true;
+
+	case 0x5a0: // cmpo
+	case 0x5a1: // cmpi
+		compiler.cycles += 1;
+		generate_set_cc(block, src1, src2, function == 0x5a1);
+		return true;
+
+	case 0x5a4: // cmpinco
+	case 0x5a5: // cmpinci
+		compiler.cycles += 2;
+		generate_set_cc(block, src1, src2, function == 0x5a5);
+		UML_ADD(block, dst, src2, 1);                                                       // add     dst,src2,1
+		return true;
+
+	case 0x5a6: // cmpdeco
+	case 0x5a7: // cmpdeci
+		compiler.cycles += 2;
+		generate_set_cc(block, src1, src2, function == 0x5a7);
+		UML_SUB(block, dst, src2, 1);                                                       // sub     dst,src2,1
+		return true;
+
+	case 0x5ae: // chkbit
+		compiler.cycles += 2;
+		if (op & 0x00000800)
+			UML_SHR(block, I0, src2, s1);                                                   // shr     i0,src2,src1
+		else
+		{
+			UML_AND(block, I1, src1, 0x1f);                                                 // and     i1,src1,0x1f
+			UML_SHR(block, I0, src2, I1);                                                   // shr     i0,src2,i1
+		}
+		UML_AND(block, I0, I0, 1);                                                          // and     i0,i0,1
+		UML_SHL(block, I0, I0, 1);                                                          // shl     i0,i0,1
+		UML_AND(block, I1, mem(&m_AC), ~uint32_t(7));                                       // and     i1,[ac],~7
+		UML_OR(block, mem(&m_AC), I1, I0);                                                  // or      [ac],i1,i0
+		return true;
+
+	case 0x5cc: // mov
+		compiler.cycles += 2;
+		UML_MOV(block, dst, src1);                                                          // mov     dst,src1
+		return true;
+
+	case 0x5dc: // movl
+	case 0x5ec: // movt
+	case 0x5fc: // movq
+		{
+			int const count = ((op >> 24) == 0x5d) ? 2 : ((op >> 24) == 0x5e) ? 3 : 4;
+			int const base = d & ((count == 2) ? 0x1e : 0x1c);
+			if (!(op & 0x00000800) && (s1 + count) > 0x20)
+				return false;
+
+			compiler.cycles += count;
+			if (op & 0x00000800)
+			{
+				for (int i = 0; i < count; i++)
+					UML_MOV(block, mem(&m_r[base + i]), s1);                                // mov     [dst+i],src1
+			}
+			else
+			{
+				uml::parameter const temp[4] = { uml::I0, uml::I1, uml::I2, uml::I3 };
+				for (int i = 0; i < count; i++)
+					UML_MOV(block, temp[i], mem(&m_r[s1 + i]));                             // mov     i<i>,[src1+i]
+				for (int i = 0; i < count; i++)
+					UML_MOV(block, mem(&m_r[base + i]), temp[i]);                           // mov     [dst+i],i<i>
+			}
+		}
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+
+//-------------------------------------------------
+//  generate_opcode - generate code for a specific
+//  opcode, or return false if it's left to the
+//  interpreter
+//-------------------------------------------------
+
+bool i960_cpu_device::generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t const op = desc->opptr.l[0];
+	int const opclass = op >> 24;
+	bool const intrablock = (desc->flags & OPFLAG_INTRABLOCK_BRANCH) != 0;
+
+	// the frontend doesn't give branches to misaligned addresses a target
+	bool const fixed_branch = (opclass >= 0x08 && opclass <= 0x17 && opclass != 0x0a) || (opclass >= 0x30 && opclass <= 0x3f);
+	if (fixed_branch && desc->targetpc == BRANCH_TARGET_DYNAMIC)
+		return false;
+
+	switch (opclass)
+	{
+	case 0x08: // b
+		compiler.cycles += 1;
+		generate_jump(block, compiler, desc->targetpc, intrablock);
+		return true;
+
+	case 0x09: // call
+		generate_call(block, compiler, desc);
+		return true;
+
+	case 0x0a: // ret
+		generate_ret(block, compiler, desc);
+		return true;
+
+	case 0x0b: // bal
+		compiler.cycles += 5;
+		UML_MOV(block, mem(&m_r[0x1e]), desc->pc + 4);                                      // mov     [g14],desc->pc + 4
+		generate_jump(block, compiler, desc->targetpc, intrablock);
+		return true;
+
+	case 0x10: // bno
+		compiler.cycles += 1;
+		UML_AND(block, I0, mem(&m_AC), 7);                                                  // and     i0,[ac],7
+		UML_SETc(block, COND_Z, I0);                                                        // set     i0,z
+		generate_cond_branch(block, compiler, desc, uml::I0, 1);
+		return true;
+
+	case 0x11: case 0x12: case 0x13: case 0x14: case 0x15: case 0x16: case 0x17: // bxx
+		compiler.cycles += 1;
+		generate_cond_branch(block, compiler, desc, uml::mem(&m_AC), opclass & 7);
+		return true;
+
+	case 0x20: // testno
+		compiler.cycles += 1;
+		UML_TEST(block, mem(&m_AC), 7);                                                     // test    [ac],7
+		UML_SETc(block, COND_Z, mem(&m_r[(op >> 19) & 0x1f]));                              // set     [dst],z
+		return true;
+
+	case 0x21: case 0x22: case 0x23: case 0x24: case 0x25: case 0x26: case 0x27: // testxx
+		compiler.cycles += 1;
+		UML_TEST(block, mem(&m_AC), opclass & 7);                                           // test    [ac],mask
+		UML_SETc(block, COND_NZ, mem(&m_r[(op >> 19) & 0x1f]));                             // set     [dst],nz
+		return true;
+
+	case 0x30: // bbc
+	case 0x37: // bbs
+		compiler.cycles += 4;
+		if (op & 0x00002000)
+			UML_SHR(block, I0, mem(&m_r[(op >> 14) & 0x1f]), (op >> 19) & 0x1f);            // shr     i0,src2,src1
+		else
+		{
+			UML_AND(block, I1, mem(&m_r[(op >> 19) & 0x1f]), 0x1f);                         // and     i1,src1,0x1f
+			UML_SHR(block, I0, mem(&m_r[(op >> 14) & 0x1f]), I1);                           // shr     i0,src2,i1
+		}
+		UML_AND(block, I0, I0, 1);                                                          // and     i0,i0,1
+		if (opclass == 0x30)
+			UML_XOR(block, I0, I0, 1);                                                      // xor     i0,i0,1
+		UML_SHL(block, I0, I0, 1);                                                          // shl     i0,i0,1
+		UML_AND(block, I1, mem(&m_AC), ~uint32_t(7));                                       // and     i1,[ac],~7
+		UML_OR(block, mem(&m_AC), I1, I0);                                                  // or      [ac],i1,i0
+		generate_cond_branch(block, compiler, desc, uml::I0, 2);
+		return true;
+
+	case 0x31: case 0x32: case 0x33: case 0x34: case 0x35: case 0x36: // cmpobxx
+	case 0x39: case 0x3a: case 0x3b: case 0x3c: case 0x3d: case 0x3e: // cmpibxx
+		compiler.cycles += 4;
+		generate_set_cc(block,
+				(op & 0x00002000) ? uml::parameter((op >> 19) & 0x1f) : uml::mem(&m_r[(op >> 19) & 0x1f]),
+				uml::mem(&m_r[(op >> 14) & 0x1f]),
+				opclass >= 0x38);
+		generate_cond_branch(block, compiler, desc, uml::I0, opclass & 7);
+		return true;
+
+	case 0x58: case 0x59: case 0x5a: case 0x5c: case 0x5d: case 0x5e: case 0x5f:
+		return generate_reg_op(block, compiler, desc);
+
+	case 0x78: // addr/subr/mulr/divr
+		return generate_fp_arith(block, compiler, desc, false);
+
+	case 0x79: // addrl/subrl/mulrl/divrl
+		return generate_fp_arith(block, compiler, desc, true);
+
+	case 0x80: return generate_load(block, compiler, desc, uml::SIZE_BYTE, false);         // ldob
+	case 0x88: return generate_load(block, compiler, desc, uml::SIZE_WORD, false);         // ldos
+	case 0x90: return generate_load(block, compiler, desc, uml::SIZE_DWORD, false);        // ld
+	case 0xc0: return generate_load(block, compiler, desc, uml::SIZE_BYTE, true);          // ldib
+	case 0xc8: return generate_load(block, compiler, desc, uml::SIZE_WORD, true);          // ldis
+
+	case 0x82: case 0xc2: return generate_store(block, compiler, desc, uml::SIZE_BYTE);    // stob/stib
+	case 0x8a: case 0xca: return generate_store(block, compiler, desc, uml::SIZE_WORD);    // stos/stis
+	case 0x92: return generate_store(block, compiler, desc, uml::SIZE_DWORD);              // st
+
+	case 0x8c: // lda
+		if (!generate_ea(block, desc))
+			return false;
+		compiler.cycles += 1;
+		UML_MOV(block, mem(&m_r[(op >> 19) & 0x1f]), I0);                                   // mov     [dst],i0
+		return true;
+
+	default:
+		return false;
+	}
+}
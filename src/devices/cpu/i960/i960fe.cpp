@@ -0,0 +1,123 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    i960fe.cpp
+
+    Front-end for i960 recompiler
+
+***************************************************************************/
+
+#include "emu.h"
+#include "i960fe.h"
+
+
+i960_frontend::i960_frontend(i960_cpu_device &i960, uint32_t window_start, uint32_t window_end, uint32_t max_sequence)
+	: drc_frontend(i960, window_start, window_end, max_sequence)
+	, m_i960(i960)
+{
+}
+
+
+//-------------------------------------------------
+//  describe_branch - fill in the details of a
+//  branch with a fixed target
+//-------------------------------------------------
+
+void i960_frontend::describe_branch(opcode_desc &desc, uint32_t targetpc, bool conditional)
+{
+	// a misaligned target is left to the interpreter
+	if (targetpc & 3)
+		return;
+
+	desc.targetpc = targetpc;
+	if (conditional)
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+	else
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+}
+
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool i960_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	// cycles are counted by the code generated for each instruction, or by
+	// the interpreter for the ones left to it
+	desc.length = 4;
+	desc.cycles = 0;
+
+	// only code in RAM or ROM is compiled, fetches from anywhere else are
+	// left to the interpreter; reading it directly has no side effects
+	bool ram;
+	uint32_t const *const opptr = m_i960.drc_code_pointer(desc.physpc, ram);
+	if (opptr == nullptr)
+		return false;
+
+	uint32_t const op = desc.opptr.l[0] = *opptr;
+	if (ram)
+		desc.userflags |= USERFLAG_CODE_IN_RAM;
+
+	// CTRL format displacements are relative to the instruction itself
+	uint32_t const ctrlpc = desc.pc + uint32_t(int32_t(op << 8) >> 8);
+	uint32_t const cobrpc = desc.pc + uint32_t(int32_t(op << 19) >> 19);
+
+	switch (op >> 24)
+	{
+	case 0x08: // b
+	case 0x09: // call
+	case 0x0b: // bal
+		describe_branch(desc, ctrlpc, false);
+		break;
+
+	case 0x0a: // ret
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		break;
+
+	case 0x10: // bno
+		describe_branch(desc, ctrlpc, true);
+		break;
+
+	case 0x11: case 0x12: case 0x13: case 0x14: case 0x15: case 0x16: case 0x17: // bxx
+		describe_branch(desc, ctrlpc & ~3, true);
+		break;
+
+	case 0x30: // bbc
+	case 0x37: // bbs
+		describe_branch(desc, cobrpc, true);
+		break;
+
+	case 0x31: case 0x32: case 0x33: case 0x34: case 0x35: case 0x36: // cmpobxx
+	case 0x39: case 0x3a: case 0x3b: case 0x3c: case 0x3d: case 0x3e: // cmpibxx
+		describe_branch(desc, cobrpc & ~3, true);
+		break;
+
+	case 0x84: // bx
+	case 0x85: // balx
+	case 0x86: // callx
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+		break;
+	}
+
+	// MEMB addressing modes with a displacement take a second word
+	if ((op >> 24) >= 0x80 && (op & 0x00001000))
+	{
+		int const mode = (op >> 10) & 0xf;
+		if (mode == 0x5 || mode >= 0xc)
+		{
+			uint32_t const *const dispptr = m_i960.drc_code_pointer(desc.physpc + 4, ram);
+			if (dispptr == nullptr)
+				return false;
+
+			desc.opptr.l[1] = *dispptr;
+			desc.length = 8;
+			if (ram)
+				desc.userflags |= USERFLAG_CODE_IN_RAM;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,38 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    i960fe.h
+
+    Front-end for i960 recompiler
+
+***************************************************************************/
+
+#ifndef MAME_CPU_I960_I960FE_H
+#define MAME_CPU_I960_I960FE_H
+
+#pragma once
+
+#include "i960.h"
+#include "cpu/drcfe.h"
+
+
+class i960_frontend : public drc_frontend
+{
+public:
+	// opcode_desc userflags
+	static constexpr uint32_t USERFLAG_CODE_IN_RAM = 0x00000001;   // opcode can be overwritten, so is checked before it's run
+
+	i960_frontend(i960_cpu_device &i960, uint32_t window_start, uint32_t window_end, uint32_t max_sequence);
+
+protected:
+	// required overrides
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	void describe_branch(opcode_desc &desc, uint32_t targetpc, bool conditional);
+
+	i960_cpu_device &m_i960;
+};
+
+#endif // MAME_CPU_I960_I960FE_H
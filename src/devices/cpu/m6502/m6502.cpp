@@ -30,7 +30,7 @@ m6502_device::m6502_device(const machine_config &mconfig, device_type type, cons
 	sync_w(*this),
 	program_config("program", ENDIANNESS_LITTLE, 8, 16),
 	sprogram_config("decrypted_opcodes", ENDIANNESS_LITTLE, 8, 16), PPC(0), NPC(0), PC(0), SP(0), TMP(0), TMP2(0), A(0), X(0), Y(0), P(0), IR(0), inst_state_base(0), mintf(nullptr),
-	inst_state(0), inst_substate(0), icount(0), nmi_state(false), irq_state(false), apu_irq_state(false), v_state(false), nmi_pending(false), irq_taken(false), sync(false), inhibit_interrupts(false), uses_custom_memory_interface(false)
+	inst_state(0), inst_substate(0), icount(0), bcount(0), nmi_state(false), irq_state(false), apu_irq_state(false), v_state(false), nmi_pending(false), irq_taken(false), sync(false), inhibit_interrupts(false), uses_custom_memory_interface(false)
 {
 }
 
@@ -398,6 +398,11 @@ void m6502_device::execute_run()
 	if(inst_substate)
 		do_exec_partial();
 
+	if(!(machine().debug_flags & DEBUG_FLAG_ENABLED)) {
+		do_exec_threaded();
+		return;
+	}
+
 	while(icount > 0) {
 		if(inst_state < 0xff00) {
 			PPC = NPC;
@@ -485,6 +490,9 @@ void m6502_device::state_string_export(const device_state_entry &entry, std::str
 
 void m6502_device::prefetch()
 {
+	// NPC still holds the start of the instruction that just finished
+	idle_loop_branch(NPC, PC, [this] () { return u64(A) | (u64(X) << 8) | (u64(Y) << 16) | (u64(P) << 24) | (u64(SP) << 32); });
+
 	sync = true;
 	sync_w(ASSERT_LINE);
 	NPC = PC;
@@ -598,6 +606,8 @@ void m6502_mcu_device::execute_run()
 		do_exec_partial();
 
 	while(icount > 0) {
+		if(!(machine().debug_flags & DEBUG_FLAG_ENABLED))
+			do_exec_threaded();
 		while(icount > bcount) {
 			if(inst_state < 0xff00) {
 				PPC = NPC;
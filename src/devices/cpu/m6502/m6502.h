@@ -137,8 +137,8 @@ protected:
 
 	uint8_t read(uint16_t adr) { return mintf->read(adr); }
 	uint8_t read_9(uint16_t adr) { return mintf->read_9(adr); }
-	void write(uint16_t adr, uint8_t val) { mintf->write(adr, val); }
-	void write_9(uint16_t adr, uint8_t val) { mintf->write_9(adr, val); }
+	void write(uint16_t adr, uint8_t val) { idle_loop_write(); mintf->write(adr, val); }
+	void write_9(uint16_t adr, uint8_t val) { idle_loop_write(); mintf->write_9(adr, val); }
 	uint8_t read_arg(uint16_t adr) { return mintf->read_arg(adr); }
 	uint8_t read_pc() { return mintf->read_arg(PC++); }
 	uint8_t read_pc_noinc() { return mintf->read_arg(PC); }
@@ -150,6 +150,7 @@ protected:
 	virtual offs_t pc_to_external(u16 pc); // For paged PCs
 	virtual void do_exec_full();
 	virtual void do_exec_partial();
+	virtual void do_exec_threaded(); // run whole instructions until icount drops to bcount
 
 	// inline helpers
 	static inline bool page_changing(uint16_t base, int delta) { return ((base + delta) ^ base) & 0xff00; }
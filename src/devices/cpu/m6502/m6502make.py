@@ -181,6 +181,47 @@ DO_EXEC_PARTIAL_EPILOG="""\
 }
 """
 
+DO_EXEC_THREADED_PROLOG="""\
+void %(device)s_device::do_exec_threaded()
+{
+#if defined(__GNUC__)
+\tstatic void *const targets[0x%(disasm_count)x] = {
+"""
+
+DO_EXEC_THREADED_DISPATCH="""\
+\t};
+
+next:
+\tif(icount <= bcount)
+\t\treturn;
+\tif(inst_state >= 0xff00) {
+\t\tdo_exec_full();
+\t\tgoto next;
+\t}
+\tPPC = NPC;
+\tinst_state = IR | inst_state_base;
+\tgoto *targets[inst_state];
+
+"""
+
+DO_EXEC_THREADED_NONE="""\
+none:
+\tdo_exec_full();
+\tgoto next;"""
+
+DO_EXEC_THREADED_EPILOG="""\
+#else
+\twhile(icount > bcount) {
+\t\tif(inst_state < 0xff00) {
+\t\t\tPPC = NPC;
+\t\t\tinst_state = IR | inst_state_base;
+\t\t}
+\t\tdo_exec_full();
+\t}
+#endif
+}
+"""
+
 DISASM_PROLOG="""\
 const %(device)s_disassembler::disasm_entry %(device)s_disassembler::disasm_entries[0x%(disasm_count)x] = {
 """
@@ -214,6 +255,17 @@ def save_tables(f, device, states):
             emit(f, "\tcase %s: %s_partial(); break;" % ("STATE_RESET", state))
     emit(f, DO_EXEC_PARTIAL_EPILOG % d)
 
+    emit(f, DO_EXEC_THREADED_PROLOG % d)
+    for n, state in enumerate(states[:-1]):
+        emit(f, "\t\t&&%s," % ("none" if state == "." else "op_%02x" % n))
+    emit(f, DO_EXEC_THREADED_DISPATCH % d)
+    for n, state in enumerate(states[:-1]):
+        if state == ".": continue
+        emit(f, "op_%02x:\n\t%s_full();\n\tgoto next;" % (n, state))
+    if "." in states[:-1]:
+        emit(f, DO_EXEC_THREADED_NONE % d)
+    emit(f, DO_EXEC_THREADED_EPILOG % d)
+
 def save_dasm(f, device, states):
     total_states = len(states)
 
@@ -44,11 +44,12 @@ protected:
 
 	virtual void read_dummy(uint16_t adr) { (void)mintf->read(adr); }
 	virtual uint8_t read_data(uint16_t adr) { return mintf->read(adr); }
-	virtual void write_data(uint16_t adr, uint8_t val) { mintf->write(adr, val); }
+	virtual void write_data(uint16_t adr, uint8_t val) { idle_loop_write(); mintf->write(adr, val); }
 
 	virtual std::unique_ptr<util::disasm_interface> create_disassembler() override;
 	virtual void do_exec_full() override;
 	virtual void do_exec_partial() override;
+	virtual void do_exec_threaded() override;
 	virtual void execute_set_input(int inputnum, int state) override;
 
 	m740_device(const machine_config &mconfig, device_type type, const char *tag, device_t *owner, uint32_t clock);
@@ -29,6 +29,7 @@ protected:
 
 	virtual void do_exec_full() override;
 	virtual void do_exec_partial() override;
+	virtual void do_exec_threaded() override;
 
 	virtual u16 get_irq_vector();
 
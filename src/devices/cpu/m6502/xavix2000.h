@@ -22,6 +22,7 @@ protected:
 	xavix2000_device(const machine_config &mconfig, device_type type, const char *tag, device_t *owner, uint32_t clock);
 	virtual void do_exec_full() override;
 	virtual void do_exec_partial() override;
+	virtual void do_exec_threaded() override;
 
 	virtual void device_start() override;
 	virtual void state_import(const device_state_entry &entry) override;
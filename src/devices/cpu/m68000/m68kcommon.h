@@ -287,6 +287,7 @@ protected:
 	std::function<void (offs_t, u8 )> m_write8;
 	std::function<void (offs_t, u16)> m_write16;
 	std::function<void (offs_t, u32)> m_write32;
+	bool m_direct16;                              // accesses go straight to the 16-bit bus, bypassing the callbacks
 
 	address_space *m_space, *m_ospace;
 
@@ -1322,6 +1322,7 @@ void m68000_base_device::init8(address_space &space, address_space &ospace)
 {
 	m_space = &space;
 	m_ospace = &ospace;
+	m_direct16 = false;
 	ospace.cache(m_oprogram8);
 	space.specific(m_program8);
 
@@ -1344,6 +1345,7 @@ void m68000_base_device::init16(address_space &space, address_space &ospace)
 	m_ospace = &ospace;
 	ospace.cache(m_oprogram16);
 	space.specific(m_program16);
+	m_direct16 = true;
 
 	m_readimm16 = [this](offs_t address) -> u16  { return m_oprogram16.read_word(address); };
 	m_read8   = [this](offs_t address) -> u8     { return m_program16.read_byte(address); };
@@ -1367,6 +1369,7 @@ void m68000_base_device::init32(address_space &space, address_space &ospace)
 {
 	m_space = &space;
 	m_ospace = &ospace;
+	m_direct16 = false;
 	ospace.cache(m_oprogram32);
 	space.specific(m_program32);
 
@@ -1426,6 +1429,7 @@ void m68000_base_device::init32mmu(address_space &space, address_space &ospace)
 {
 	m_space = &space;
 	m_ospace = &ospace;
+	m_direct16 = false;
 	ospace.cache(m_oprogram32);
 	space.specific(m_program32);
 
@@ -1596,6 +1600,7 @@ void m68000_base_device::init32hmmu(address_space &space, address_space &ospace)
 {
 	m_space = &space;
 	m_ospace = &ospace;
+	m_direct16 = false;
 	ospace.cache(m_oprogram32);
 	space.specific(m_program32);
 
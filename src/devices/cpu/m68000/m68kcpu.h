@@ -514,6 +514,7 @@ inline unsigned int m68k_read_pcrelative_32(unsigned int address)
  */
 inline void m68kx_write_memory_32_pd(unsigned int address, unsigned int value)
 {
+	idle_loop_write();
 	m_write16(address+2, value>>16);
 	m_write16(address, value&0xffff);
 }
@@ -534,6 +535,10 @@ inline void m68ki_ic_clear()
 
 inline u32 m68ki_ic_readimm16(u32 address)
 {
+	/* Plain 16-bit bus parts have no cache or MMU to go through */
+	if (m_direct16)
+		return m_oprogram16.read_word(address);
+
 	if (m_cacr & M68K_CACR_EI)
 	{
 		// 68020 series I-cache (MC68020 User's Manual, Section 4 - On-Chip Cache Memory)
@@ -656,6 +661,8 @@ inline u32 m68ki_read_8_fc(u32 address, u32 fc)
 	m_mmu_tmp_fc = fc;
 	m_mmu_tmp_rw = 1;
 	m_mmu_tmp_sz = M68K_SZ_BYTE;
+	if (m_direct16)
+		return m_program16.read_byte(address);
 	return m_read8(address);
 }
 inline u32 m68ki_read_16_fc(u32 address, u32 fc)
@@ -667,6 +674,8 @@ inline u32 m68ki_read_16_fc(u32 address, u32 fc)
 	m_mmu_tmp_fc = fc;
 	m_mmu_tmp_rw = 1;
 	m_mmu_tmp_sz = M68K_SZ_WORD;
+	if (m_direct16)
+		return m_program16.read_word(address);
 	return m_read16(address);
 }
 inline u32 m68ki_read_32_fc(u32 address, u32 fc)
@@ -678,6 +687,8 @@ inline u32 m68ki_read_32_fc(u32 address, u32 fc)
 	m_mmu_tmp_fc = fc;
 	m_mmu_tmp_rw = 1;
 	m_mmu_tmp_sz = M68K_SZ_LONG;
+	if (m_direct16)
+		return m_program16.read_dword(address);
 	return m_read32(address);
 }
 
@@ -686,7 +697,11 @@ inline void m68ki_write_8_fc(u32 address, u32 fc, u32 value)
 	m_mmu_tmp_fc = fc;
 	m_mmu_tmp_rw = 0;
 	m_mmu_tmp_sz = M68K_SZ_BYTE;
-	m_write8(address, value);
+	idle_loop_write();
+	if (m_direct16)
+		m_program16.write_word(address & ~1, value | (value << 8), address & 1 ? 0x00ff : 0xff00);
+	else
+		m_write8(address, value);
 }
 inline void m68ki_write_16_fc(u32 address, u32 fc, u32 value)
 {
@@ -697,7 +712,11 @@ inline void m68ki_write_16_fc(u32 address, u32 fc, u32 value)
 	m_mmu_tmp_fc = fc;
 	m_mmu_tmp_rw = 0;
 	m_mmu_tmp_sz = M68K_SZ_WORD;
-	m_write16(address, value);
+	idle_loop_write();
+	if (m_direct16)
+		m_program16.write_word(address, value);
+	else
+		m_write16(address, value);
 }
 inline void m68ki_write_32_fc(u32 address, u32 fc, u32 value)
 {
@@ -708,7 +727,11 @@ inline void m68ki_write_32_fc(u32 address, u32 fc, u32 value)
 	m_mmu_tmp_fc = fc;
 	m_mmu_tmp_rw = 0;
 	m_mmu_tmp_sz = M68K_SZ_LONG;
-	m_write32(address, value);
+	idle_loop_write();
+	if (m_direct16)
+		m_program16.write_dword(address, value);
+	else
+		m_write32(address, value);
 }
 
 /* Special call to simulate undocumented 68k behavior when move.l with a
@@ -725,6 +748,7 @@ inline void m68ki_write_32_pd_fc(u32 address, u32 fc, u32 value)
 	m_mmu_tmp_fc = fc;
 	m_mmu_tmp_rw = 0;
 	m_mmu_tmp_sz = M68K_SZ_LONG;
+	idle_loop_write();
 	m_write16(address+2, value>>16);
 	m_write16(address, value&0xffff);
 }
@@ -982,6 +1006,15 @@ inline void m68ki_jump_vector(u32 vector)
 }
 
 
+/* Hash of the state a polling loop could change, for idle loop detection */
+inline u64 m68ki_idle_loop_signature()
+{
+	u64 result = (u64(m_x_flag) << 32) ^ (u64(m_n_flag) << 24) ^ (u64(m_not_z_flag) << 16) ^ (u64(m_v_flag) << 8) ^ u64(m_c_flag);
+	for (u32 reg : m_dar)
+		result = (result ^ reg) * 0x100000001b3U;
+	return result;
+}
+
 /* Branch to a new memory location.
  * The 32-bit branch will call pc_changed if it was enabled in m68kconf.h.
  * So far I've found no problems with not calling pc_changed for 8 or 16
@@ -990,16 +1023,19 @@ inline void m68ki_jump_vector(u32 vector)
 inline void m68ki_branch_8(u32 offset)
 {
 	m_pc += MAKE_INT_8(offset);
+	idle_loop_branch(m_ppc, m_pc, [this] () { return m68ki_idle_loop_signature(); });
 }
 
 inline void m68ki_branch_16(u32 offset)
 {
 	m_pc += MAKE_INT_16(offset);
+	idle_loop_branch(m_ppc, m_pc, [this] () { return m68ki_idle_loop_signature(); });
 }
 
 inline void m68ki_branch_32(u32 offset)
 {
 	m_pc += offset;
+	idle_loop_branch(m_ppc, m_pc, [this] () { return m68ki_idle_loop_signature(); });
 }
 
 
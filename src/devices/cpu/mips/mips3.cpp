@@ -434,6 +434,7 @@ void mips3_device::device_start()
 	uint32_t flags = 0;
 	/* initialize the UML generator */
 	m_drcuml = std::make_unique<drcuml_state>(*this, m_drc_cache, flags, 8, 32, 2);
+	m_drcuml->enable_code_tracking(MIPS3_MIN_PAGE_SHIFT);
 
 	/* add symbols for our stuff */
 	m_drcuml->symbol_add(&m_core->pc, sizeof(m_core->pc), "pc");
@@ -480,6 +481,7 @@ void mips3_device::device_start()
 
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<mips3_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+	m_drcuml->persist_open(COMPILE_BLOCKLIST_VERSION);
 
 	/* allocate memory for cache-local state and initialize it */
 	memcpy(m_fpmode, fpmode_source, sizeof(fpmode_source));
@@ -5064,7 +5066,11 @@ void mips3_device::execute_run()
 			/* if we need to recompile, do it */
 			if (execute_result == EXECUTE_MISSING_CODE)
 			{
-				code_compile_block(m_core->mode, m_core->pc);
+				if (!code_interpret_cold(m_core->mode, m_core->pc))
+				{
+					code_compile_block(m_core->mode, m_core->pc);
+					code_prewarm_page(m_core->pc);
+				}
 			}
 			else if (execute_result == EXECUTE_UNMAPPED_CODE)
 			{
@@ -5093,227 +5099,232 @@ void mips3_device::execute_run()
 	/* core execution loop */
 	do
 	{
-		uint32_t op;
-		uint64_t temp64 = 0;
-		uint32_t temp;
+		execute_one();
+	} while (m_core->icount > 0 || m_nextpc != ~0);
 
-		/* debugging */
-		m_ppc = m_core->pc;
-		debugger_instruction_hook(m_core->pc);
+	m_core->icount -= m_interrupt_cycles;
+	m_interrupt_cycles = 0;
+}
 
-		/* instruction fetch */
-		if(!RWORD(m_core->pc, &op, true))
-		{
-			continue;
-		}
+void mips3_device::execute_one()
+{
+	uint32_t op;
+	uint64_t temp64 = 0;
+	uint32_t temp;
 
-		/* adjust for next PC */
-		if (m_nextpc != ~0)
-		{
-			/* Exceptions need to be able to see delayslot, since nextpc gets cleared before instruction execution */
-			m_delayslot = true;
-			m_core->pc = m_nextpc;
-			m_nextpc = ~0;
-		}
-		else
-		{
-			m_delayslot = false;
-			m_core->pc += 4;
-		}
-		/* parse the instruction */
-		const int switch_val = (op >> 26) & 0x3f;
+	/* debugging */
+	m_ppc = m_core->pc;
+	debugger_instruction_hook(m_core->pc);
 
-		switch (switch_val)
-		{
-			case 0x00:  /* SPECIAL */
-				handle_special(op);
-				break;
+	/* instruction fetch */
+	if(!RWORD(m_core->pc, &op, true))
+	{
+		return;
+	}
 
-			case 0x01:  /* REGIMM */
-				handle_regimm(op);
-				break;
+	/* adjust for next PC */
+	if (m_nextpc != ~0)
+	{
+		/* Exceptions need to be able to see delayslot, since nextpc gets cleared before instruction execution */
+		m_delayslot = true;
+		m_core->pc = m_nextpc;
+		m_nextpc = ~0;
+	}
+	else
+	{
+		m_delayslot = false;
+		m_core->pc += 4;
+	}
+	/* parse the instruction */
+	const int switch_val = (op >> 26) & 0x3f;
 
-			case 0x02:  /* J */         ABSPC(LIMMVAL);                                                         break;
-			case 0x03:  /* JAL */
-				ABSPCL(LIMMVAL,31);
-				break;
-			case 0x04:  /* BEQ */       if (RSVAL64 == RTVAL64) ADDPC(SIMMVAL);                                 break;
-			case 0x05:  /* BNE */       if (RSVAL64 != RTVAL64) ADDPC(SIMMVAL);                                 break;
-			case 0x06:  /* BLEZ */      if ((int64_t)RSVAL64 <= 0) ADDPC(SIMMVAL);                                break;
-			case 0x07:  /* BGTZ */      if ((int64_t)RSVAL64 > 0) ADDPC(SIMMVAL);                                 break;
-			case 0x08:  /* ADDI */
-				if (ENABLE_OVERFLOWS && RSVAL32 > ~SIMMVAL) generate_exception(EXCEPTION_OVERFLOW, 1);
-				else if (RTREG) RTVAL64 = (int32_t)(RSVAL32 + SIMMVAL);
-				break;
-			case 0x09:  /* ADDIU */     if (RTREG) RTVAL64 = (int32_t)(RSVAL32 + SIMMVAL);                        break;
-			case 0x0a:  /* SLTI */      if (RTREG) RTVAL64 = (int64_t)RSVAL64 < (int64_t)SIMMVAL;                   break;
-			case 0x0b:  /* SLTIU */     if (RTREG) RTVAL64 = (uint64_t)RSVAL64 < (uint64_t)SIMMVAL;                 break;
-			case 0x0c:  /* ANDI */      if (RTREG) RTVAL64 = RSVAL64 & UIMMVAL;                                 break;
-			case 0x0d:  /* ORI */       if (RTREG) RTVAL64 = RSVAL64 | UIMMVAL;                                 break;
-			case 0x0e:  /* XORI */      if (RTREG) RTVAL64 = RSVAL64 ^ UIMMVAL;                                 break;
-			case 0x0f:  /* LUI */       if (RTREG) RTVAL64 = (int32_t)(UIMMVAL << 16);                            break;
-			case 0x10:  /* COP0 */      handle_cop0(op);                                                        break;
-			case 0x11:  /* COP1 */
-				if (IS_FR0)
-					handle_cop1_fr0(op);
-				else
-					handle_cop1_fr1(op);
-				break;
-			case 0x12:  /* COP2 */      handle_cop2(op);                                                        break;
-			case 0x13:  /* COP1X - R5000 */
-				if (IS_FR0)
-					handle_cop1x_fr0(op);
-				else
-					handle_cop1x_fr1(op);
-				break;
-			case 0x14:  /* BEQL */      if (RSVAL64 == RTVAL64) ADDPC(SIMMVAL); else m_core->pc += 4;             break;
-			case 0x15:  /* BNEL */      if (RSVAL64 != RTVAL64) ADDPC(SIMMVAL); else m_core->pc += 4;             break;
-			case 0x16:  /* BLEZL */     if ((int64_t)RSVAL64 <= 0) ADDPC(SIMMVAL); else m_core->pc += 4;          break;
-			case 0x17:  /* BGTZL */     if ((int64_t)RSVAL64 > 0) ADDPC(SIMMVAL); else m_core->pc += 4;           break;
-			case 0x18:  /* DADDI */
-				if (ENABLE_OVERFLOWS && (int64_t)RSVAL64 > ~SIMMVAL) generate_exception(EXCEPTION_OVERFLOW, 1);
-				else if (RTREG) RTVAL64 = RSVAL64 + (int64_t)SIMMVAL;
-				break;
-			case 0x19:  /* DADDIU */    if (RTREG) RTVAL64 = RSVAL64 + (uint64_t)SIMMVAL;                         break;
-			case 0x1a:  /* LDL */       (this->*m_ldl)(op);                                                       break;
-			case 0x1b:  /* LDR */       (this->*m_ldr)(op);                                                       break;
-			case 0x1c:  /* IDT-specific opcodes: mad/madu/mul on R4640/4650, msub on RC32364 */
-				handle_idt(op);
-				break;
-			case 0x20:  /* LB */        if (RBYTE(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (int8_t)temp;       break;
-			case 0x21:  /* LH */        if (RHALF(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (int16_t)temp;      break;
-			case 0x22:  /* LWL */       (this->*m_lwl)(op);                                                       break;
-			case 0x23:  /* LW */        if (RWORD(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (int32_t)temp;      break;
-			case 0x24:  /* LBU */       if (RBYTE(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (uint8_t)temp;      break;
-			case 0x25:  /* LHU */       if (RHALF(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (uint16_t)temp;     break;
-			case 0x26:  /* LWR */       (this->*m_lwr)(op);                                                       break;
-			case 0x27:  /* LWU */       if (RWORD(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (uint32_t)temp;     break;
-			case 0x28:  /* SB */        WBYTE(SIMMVAL+RSVAL32, RTVAL32);                                          break;
-			case 0x29:  /* SH */        WHALF(SIMMVAL+RSVAL32, RTVAL32);                                          break;
-			case 0x2a:  /* SWL */       (this->*m_swl)(op);                                                       break;
-			case 0x2b:  /* SW */        WWORD(SIMMVAL+RSVAL32, RTVAL32);                                          break;
-			case 0x2c:  /* SDL */       (this->*m_sdl)(op);                                                       break;
-			case 0x2d:  /* SDR */       (this->*m_sdr)(op);                                                       break;
-			case 0x2e:  /* SWR */       (this->*m_swr)(op);                                                       break;
-			case 0x2f:  /* CACHE */     handle_cache(op);                                                         break;
-			case 0x30:  /* LL */
-				if (RWORD(SIMMVAL + RSVAL32, &temp) && RTREG)
-				{
-					// Should actually use physical address
-					m_core->cpr[0][COP0_LLAddr] = SIMMVAL + RSVAL32;
-					RTVAL64 = temp;
-					m_core->llbit = 1;
-					if LL_BREAK
-						machine().debug_break();
-				}
-				break;
-			case 0x31:  /* LWC1 */
-				if (!(SR & SR_COP1))
-				{
-					m_badcop_value = 1;
-					generate_exception(EXCEPTION_BADCOP, 1);
-					break;
-				}
-				if (RWORD(SIMMVAL+RSVAL32, &temp))
-					set_cop1_reg32(RTREG, temp);
-				break;
-			case 0x32:  /* LWC2 */      if (RWORD(SIMMVAL+RSVAL32, &temp)) set_cop2_reg(RTREG, temp);           break;
-			case 0x33:  /* PREF */      /* effective no-op */                                                   break;
-			case 0x34:  /* LLD */
-				if (RDOUBLE(SIMMVAL + RSVAL32, &temp64) && RTREG)
-				{
-					m_core->cpr[0][COP0_LLAddr] = SIMMVAL + RSVAL32;
-					RTVAL64 = temp64;
-					m_core->llbit = 1;
-					if LL_BREAK
-						machine().debug_break();
-				}
-				break;
-			case 0x35:  /* LDC1 */
-				if (!(SR & SR_COP1))
-				{
-					m_badcop_value = 1;
-					generate_exception(EXCEPTION_BADCOP, 1);
-					break;
-				}
-				if (RDOUBLE(SIMMVAL+RSVAL32, &temp64))
-					set_cop1_reg64(RTREG, temp64);
-				break;
-			case 0x36:  handle_ldc2(op); break;
-			case 0x37:  /* LD */        if (RDOUBLE(SIMMVAL+RSVAL32, &temp64) && RTREG) RTVAL64 = temp64;       break;
-			case 0x38:  /* SC */
-				if (RWORD(SIMMVAL + RSVAL32, &temp) && RTREG && m_core->llbit && m_core->cpr[0][COP0_LLAddr] == SIMMVAL + RSVAL32)
-				{
-					WWORD(SIMMVAL + RSVAL32, RTVAL32);
-					RTVAL64 = (uint32_t)1;
-				}
-				else
-					RTVAL64 = (uint32_t)0;
-				break;
-			case 0x39:  /* SWC1 */
-				if (!(SR & SR_COP1))
-				{
-					m_badcop_value = 1;
-					generate_exception(EXCEPTION_BADCOP, 1);
-					break;
-				}
-				WWORD(SIMMVAL+RSVAL32, get_cop1_reg32(RTREG));
+	switch (switch_val)
+	{
+		case 0x00:  /* SPECIAL */
+			handle_special(op);
+			break;
+
+		case 0x01:  /* REGIMM */
+			handle_regimm(op);
+			break;
+
+		case 0x02:  /* J */         ABSPC(LIMMVAL);                                                         break;
+		case 0x03:  /* JAL */
+			ABSPCL(LIMMVAL,31);
+			break;
+		case 0x04:  /* BEQ */       if (RSVAL64 == RTVAL64) ADDPC(SIMMVAL);                                 break;
+		case 0x05:  /* BNE */       if (RSVAL64 != RTVAL64) ADDPC(SIMMVAL);                                 break;
+		case 0x06:  /* BLEZ */      if ((int64_t)RSVAL64 <= 0) ADDPC(SIMMVAL);                                break;
+		case 0x07:  /* BGTZ */      if ((int64_t)RSVAL64 > 0) ADDPC(SIMMVAL);                                 break;
+		case 0x08:  /* ADDI */
+			if (ENABLE_OVERFLOWS && RSVAL32 > ~SIMMVAL) generate_exception(EXCEPTION_OVERFLOW, 1);
+			else if (RTREG) RTVAL64 = (int32_t)(RSVAL32 + SIMMVAL);
+			break;
+		case 0x09:  /* ADDIU */     if (RTREG) RTVAL64 = (int32_t)(RSVAL32 + SIMMVAL);                        break;
+		case 0x0a:  /* SLTI */      if (RTREG) RTVAL64 = (int64_t)RSVAL64 < (int64_t)SIMMVAL;                   break;
+		case 0x0b:  /* SLTIU */     if (RTREG) RTVAL64 = (uint64_t)RSVAL64 < (uint64_t)SIMMVAL;                 break;
+		case 0x0c:  /* ANDI */      if (RTREG) RTVAL64 = RSVAL64 & UIMMVAL;                                 break;
+		case 0x0d:  /* ORI */       if (RTREG) RTVAL64 = RSVAL64 | UIMMVAL;                                 break;
+		case 0x0e:  /* XORI */      if (RTREG) RTVAL64 = RSVAL64 ^ UIMMVAL;                                 break;
+		case 0x0f:  /* LUI */       if (RTREG) RTVAL64 = (int32_t)(UIMMVAL << 16);                            break;
+		case 0x10:  /* COP0 */      handle_cop0(op);                                                        break;
+		case 0x11:  /* COP1 */
+			if (IS_FR0)
+				handle_cop1_fr0(op);
+			else
+				handle_cop1_fr1(op);
+			break;
+		case 0x12:  /* COP2 */      handle_cop2(op);                                                        break;
+		case 0x13:  /* COP1X - R5000 */
+			if (IS_FR0)
+				handle_cop1x_fr0(op);
+			else
+				handle_cop1x_fr1(op);
+			break;
+		case 0x14:  /* BEQL */      if (RSVAL64 == RTVAL64) ADDPC(SIMMVAL); else m_core->pc += 4;             break;
+		case 0x15:  /* BNEL */      if (RSVAL64 != RTVAL64) ADDPC(SIMMVAL); else m_core->pc += 4;             break;
+		case 0x16:  /* BLEZL */     if ((int64_t)RSVAL64 <= 0) ADDPC(SIMMVAL); else m_core->pc += 4;          break;
+		case 0x17:  /* BGTZL */     if ((int64_t)RSVAL64 > 0) ADDPC(SIMMVAL); else m_core->pc += 4;           break;
+		case 0x18:  /* DADDI */
+			if (ENABLE_OVERFLOWS && (int64_t)RSVAL64 > ~SIMMVAL) generate_exception(EXCEPTION_OVERFLOW, 1);
+			else if (RTREG) RTVAL64 = RSVAL64 + (int64_t)SIMMVAL;
+			break;
+		case 0x19:  /* DADDIU */    if (RTREG) RTVAL64 = RSVAL64 + (uint64_t)SIMMVAL;                         break;
+		case 0x1a:  /* LDL */       (this->*m_ldl)(op);                                                       break;
+		case 0x1b:  /* LDR */       (this->*m_ldr)(op);                                                       break;
+		case 0x1c:  /* IDT-specific opcodes: mad/madu/mul on R4640/4650, msub on RC32364 */
+			handle_idt(op);
+			break;
+		case 0x20:  /* LB */        if (RBYTE(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (int8_t)temp;       break;
+		case 0x21:  /* LH */        if (RHALF(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (int16_t)temp;      break;
+		case 0x22:  /* LWL */       (this->*m_lwl)(op);                                                       break;
+		case 0x23:  /* LW */        if (RWORD(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (int32_t)temp;      break;
+		case 0x24:  /* LBU */       if (RBYTE(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (uint8_t)temp;      break;
+		case 0x25:  /* LHU */       if (RHALF(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (uint16_t)temp;     break;
+		case 0x26:  /* LWR */       (this->*m_lwr)(op);                                                       break;
+		case 0x27:  /* LWU */       if (RWORD(SIMMVAL+RSVAL32, &temp) && RTREG) RTVAL64 = (uint32_t)temp;     break;
+		case 0x28:  /* SB */        WBYTE(SIMMVAL+RSVAL32, RTVAL32);                                          break;
+		case 0x29:  /* SH */        WHALF(SIMMVAL+RSVAL32, RTVAL32);                                          break;
+		case 0x2a:  /* SWL */       (this->*m_swl)(op);                                                       break;
+		case 0x2b:  /* SW */        WWORD(SIMMVAL+RSVAL32, RTVAL32);                                          break;
+		case 0x2c:  /* SDL */       (this->*m_sdl)(op);                                                       break;
+		case 0x2d:  /* SDR */       (this->*m_sdr)(op);                                                       break;
+		case 0x2e:  /* SWR */       (this->*m_swr)(op);                                                       break;
+		case 0x2f:  /* CACHE */     handle_cache(op);                                                         break;
+		case 0x30:  /* LL */
+			if (RWORD(SIMMVAL + RSVAL32, &temp) && RTREG)
+			{
+				// Should actually use physical address
+				m_core->cpr[0][COP0_LLAddr] = SIMMVAL + RSVAL32;
+				RTVAL64 = temp;
+				m_core->llbit = 1;
+				if LL_BREAK
+					machine().debug_break();
+			}
+			break;
+		case 0x31:  /* LWC1 */
+			if (!(SR & SR_COP1))
+			{
+				m_badcop_value = 1;
+				generate_exception(EXCEPTION_BADCOP, 1);
 				break;
-			case 0x3a:  /* SWC2 */      WWORD(SIMMVAL+RSVAL32, get_cop2_reg(RTREG));                            break;
-			case 0x3b:  /* SWC3 */      invalid_instruction(op);                                                break;
-			case 0x3c:  /* SCD */
-				if (RDOUBLE(SIMMVAL+RSVAL32, &temp64) && RTREG && m_core->llbit && m_core->cpr[0][COP0_LLAddr] == SIMMVAL + RSVAL32)
-				{
-					WDOUBLE(SIMMVAL + RSVAL32, RTVAL64);
-					RTVAL64 = 1;
-				}
-				else
-					RTVAL64 = 0;
+			}
+			if (RWORD(SIMMVAL+RSVAL32, &temp))
+				set_cop1_reg32(RTREG, temp);
+			break;
+		case 0x32:  /* LWC2 */      if (RWORD(SIMMVAL+RSVAL32, &temp)) set_cop2_reg(RTREG, temp);           break;
+		case 0x33:  /* PREF */      /* effective no-op */                                                   break;
+		case 0x34:  /* LLD */
+			if (RDOUBLE(SIMMVAL + RSVAL32, &temp64) && RTREG)
+			{
+				m_core->cpr[0][COP0_LLAddr] = SIMMVAL + RSVAL32;
+				RTVAL64 = temp64;
+				m_core->llbit = 1;
+				if LL_BREAK
+					machine().debug_break();
+			}
+			break;
+		case 0x35:  /* LDC1 */
+			if (!(SR & SR_COP1))
+			{
+				m_badcop_value = 1;
+				generate_exception(EXCEPTION_BADCOP, 1);
 				break;
-			case 0x3d:  /* SDC1 */
-				if (!(SR & SR_COP1))
-				{
-					m_badcop_value = 1;
-					generate_exception(EXCEPTION_BADCOP, 1);
-					break;
-				}
-				WDOUBLE(SIMMVAL+RSVAL32, get_cop1_reg64(RTREG));
+			}
+			if (RDOUBLE(SIMMVAL+RSVAL32, &temp64))
+				set_cop1_reg64(RTREG, temp64);
+			break;
+		case 0x36:  handle_ldc2(op); break;
+		case 0x37:  /* LD */        if (RDOUBLE(SIMMVAL+RSVAL32, &temp64) && RTREG) RTVAL64 = temp64;       break;
+		case 0x38:  /* SC */
+			if (RWORD(SIMMVAL + RSVAL32, &temp) && RTREG && m_core->llbit && m_core->cpr[0][COP0_LLAddr] == SIMMVAL + RSVAL32)
+			{
+				WWORD(SIMMVAL + RSVAL32, RTVAL32);
+				RTVAL64 = (uint32_t)1;
+			}
+			else
+				RTVAL64 = (uint32_t)0;
+			break;
+		case 0x39:  /* SWC1 */
+			if (!(SR & SR_COP1))
+			{
+				m_badcop_value = 1;
+				generate_exception(EXCEPTION_BADCOP, 1);
 				break;
-			case 0x3e:  handle_sdc2(op); break;
-			case 0x3f:  /* SD */        WDOUBLE(SIMMVAL+RSVAL32, RTVAL64);                                      break;
-			default:
-				handle_extra_base(op);
+			}
+			WWORD(SIMMVAL+RSVAL32, get_cop1_reg32(RTREG));
+			break;
+		case 0x3a:  /* SWC2 */      WWORD(SIMMVAL+RSVAL32, get_cop2_reg(RTREG));                            break;
+		case 0x3b:  /* SWC3 */      invalid_instruction(op);                                                break;
+		case 0x3c:  /* SCD */
+			if (RDOUBLE(SIMMVAL+RSVAL32, &temp64) && RTREG && m_core->llbit && m_core->cpr[0][COP0_LLAddr] == SIMMVAL + RSVAL32)
+			{
+				WDOUBLE(SIMMVAL + RSVAL32, RTVAL64);
+				RTVAL64 = 1;
+			}
+			else
+				RTVAL64 = 0;
+			break;
+		case 0x3d:  /* SDC1 */
+			if (!(SR & SR_COP1))
+			{
+				m_badcop_value = 1;
+				generate_exception(EXCEPTION_BADCOP, 1);
 				break;
-		}
+			}
+			WDOUBLE(SIMMVAL+RSVAL32, get_cop1_reg64(RTREG));
+			break;
+		case 0x3e:  handle_sdc2(op); break;
+		case 0x3f:  /* SD */        WDOUBLE(SIMMVAL+RSVAL32, RTVAL64);                                      break;
+		default:
+			handle_extra_base(op);
+			break;
+	}
 
 #if ENABLE_EE_ELF_LOADER
-		bool had_delay = m_delayslot;
+	bool had_delay = m_delayslot;
 #endif
 
-		/* Clear this flag once instruction execution is finished, will interfere with interrupt exceptions otherwise */
-		m_delayslot = false;
-		m_core->icount--;
+	/* Clear this flag once instruction execution is finished, will interfere with interrupt exceptions otherwise */
+	m_delayslot = false;
+	m_core->icount--;
 
 #if ENABLE_O2_DPRINTF
-		if (m_core->pc == 0xbfc04d74)
-		{
-			do_o2_dprintf((uint32_t)m_core->r[4], (uint32_t)m_core->r[5], (uint32_t)m_core->r[6], (uint32_t)m_core->r[7], (uint32_t)m_core->r[29] + 16);
-		}
+	if (m_core->pc == 0xbfc04d74)
+	{
+		do_o2_dprintf((uint32_t)m_core->r[4], (uint32_t)m_core->r[5], (uint32_t)m_core->r[6], (uint32_t)m_core->r[7], (uint32_t)m_core->r[29] + 16);
+	}
 #endif
 
 #if ENABLE_EE_ELF_LOADER
-		static bool elf_loaded = false;
-		if (had_delay && m_core->pc < 0x80000000 && m_core->pc >= 0x00100000 && !elf_loaded)
-		{
-			load_elf();
-			m_core->icount = 0;
-			elf_loaded = true;
-		}
+	static bool elf_loaded = false;
+	if (had_delay && m_core->pc < 0x80000000 && m_core->pc >= 0x00100000 && !elf_loaded)
+	{
+		load_elf();
+		m_core->icount = 0;
+		elf_loaded = true;
+	}
 #endif
-	} while (m_core->icount > 0 || m_nextpc != ~0);
-
-	m_core->icount -= m_interrupt_cycles;
-	m_interrupt_cycles = 0;
 }
 
 
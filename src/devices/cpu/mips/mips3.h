@@ -480,6 +480,7 @@ protected:
 
 												/* internal stuff */
 	uint8_t         m_drc_cache_dirty;          /* true if we need to flush the cache */
+	uint8_t         m_cold_count[4096];         /* times each (hashed) PC was missed, for MIPS3DRC_INTERPRET_COLD */
 
 												/* tables */
 	uint8_t         m_fpmode[4];                /* FPU mode table */
@@ -520,6 +521,7 @@ protected:
 	void generate_exception(int exception, int backup);
 	void generate_tlb_exception(int exception, offs_t address);
 	virtual void check_irqs();
+	void execute_one();
 	virtual void handle_mult(uint32_t op);
 	virtual void handle_multu(uint32_t op);
 
@@ -596,6 +598,8 @@ private:
 	void save_fast_iregs(drcuml_block &block);
 	void code_flush_cache();
 	void code_compile_block(uint8_t mode, offs_t pc);
+	void code_prewarm_page(offs_t pc);
+	bool code_interpret_cold(uint8_t mode, offs_t pc);
 public:
 	void func_get_cycles();
 	void func_printf_exception();
@@ -603,6 +607,7 @@ public:
 	void func_printf_probe();
 	void func_debug_break();
 	void func_unimplemented();
+	void func_icache_invalidate();
 private:
 	/* internal compiler state */
 	struct compiler_state
@@ -978,6 +983,7 @@ COMPILER-SPECIFIC OPTIONS
 #define MIPS3DRC_CHECK_OVERFLOWS    0x0020          /* actually check overflows on add/sub instructions */
 #define MIPS3DRC_ACCURATE_DIVZERO   0x0040          /* load correct values into HI/LO on integer divide-by-zero */
 #define MIPS3DRC_EXTRA_INSTR_CHECK  0x0080          /* adds the last instruction value to all validation entry locations, used with STRICT_VERIFY */
+#define MIPS3DRC_INTERPRET_COLD     0x0100          /* interpret code the first time it is reached and only compile it once it is seen again */
 
 #define MIPS3DRC_COMPATIBLE_OPTIONS (MIPS3DRC_STRICT_VERIFY | MIPS3DRC_STRICT_COP1 | MIPS3DRC_STRICT_COP0 | MIPS3DRC_STRICT_COP2)
 #define MIPS3DRC_FASTEST_OPTIONS    (0)
@@ -37,6 +37,10 @@
 /* Set to 1 to activate and use MIPS3DRC_STRICT_VERIFY in the drc options */
 #define DEBUG_STRICT_VERIFY 0
 
+/* With MIPS3DRC_INTERPRET_COLD, how many misses are interpreted before compiling, and how far each may run */
+#define COLD_COMPILE_THRESHOLD  1
+#define COLD_MAX_INSTRUCTIONS   64
+
 
 /***************************************************************************
     MACROS
@@ -236,6 +240,7 @@ void mips3_device::code_flush_cache()
 
 	/* empty the transient cache contents */
 	m_drcuml->reset();
+	std::fill(std::begin(m_cold_count), std::end(m_cold_count), 0);
 
 	try
 	{
@@ -309,6 +314,10 @@ void mips3_device::code_compile_block(uint8_t mode, offs_t pc)
 	if (m_drcuml->logging() || m_drcuml->logging_native())
 		log_opcode_desc(desclist, 0);
 
+	/* note the block for the persistent block list */
+	if (m_drcuml->persist_enabled())
+		m_drcuml->persist_record(mode, pc, m_drcfe->describe_hash());
+
 	/* if we get an error back, flush the cache and try again */
 	bool succeeded = false;
 	while (!succeeded)
@@ -369,6 +378,7 @@ void mips3_device::code_compile_block(uint8_t mode, offs_t pc)
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
 				{
 					generate_sequence_instruction(block, compiler, curdesc);
+					block.add_code_range(curdesc->physpc, 4);
 				}
 
 				/* if we need to return to the start, do it */
@@ -407,6 +417,62 @@ void mips3_device::code_compile_block(uint8_t mode, offs_t pc)
 
 
 
+/*-------------------------------------------------
+    code_prewarm_page - compile any blocks from
+    the persistent block list that start on the
+    same page as the given PC
+-------------------------------------------------*/
+
+void mips3_device::code_prewarm_page(offs_t pc)
+{
+	m_drcuml->persist_prewarm(pc, [this] (uint8_t mode, offs_t blockpc, uint64_t hash)
+	{
+		/* only compile blocks whose code hasn't changed */
+		m_drcfe->describe_code(blockpc);
+		if (m_drcfe->describe_hash() != hash)
+			return false;
+		code_compile_block(mode, blockpc);
+		return true;
+	});
+}
+
+
+
+/*-------------------------------------------------
+    code_interpret_cold - run code that hasn't
+    been reached before through the interpreter
+    up to the end of its basic block; returns
+    false if it should be compiled instead
+-------------------------------------------------*/
+
+bool mips3_device::code_interpret_cold(uint8_t mode, offs_t pc)
+{
+	if (!(m_drcoptions & MIPS3DRC_INTERPRET_COLD) || m_core->icount <= 0)
+		return false;
+
+	/* compile once the PC has been missed often enough, collisions just make that happen sooner */
+	uint8_t &count = m_cold_count[((pc >> 2) ^ (mode << 9)) % std::size(m_cold_count)];
+	if (count >= COLD_COMPILE_THRESHOLD)
+		return false;
+	count++;
+
+	/* stop at the end of the basic block, when we reach compiled code or run out of cycles */
+	for (int remaining = COLD_MAX_INSTRUCTIONS; remaining > 0 || m_nextpc != ~0; remaining--)
+	{
+		offs_t const prevpc = m_core->pc;
+		execute_one();
+		if (m_nextpc != ~0)
+			continue;
+		uint32_t const sr = m_core->cpr[0][COP0_Status];
+		m_core->mode = ((sr & (SR_EXL | SR_ERL)) ? 0 : ((sr >> 2) & 0x06)) | ((sr >> 26) & 0x01);
+		if (m_core->pc != prevpc + 4 || m_core->icount <= 0 || m_drcuml->hash_exists(m_core->mode, m_core->pc))
+			break;
+	}
+	return true;
+}
+
+
+
 /***************************************************************************
     C FUNCTION CALLBACKS
 ***************************************************************************/
@@ -457,6 +523,25 @@ static void cfunc_get_cycles(void *param)
 }
 
 
+/*-------------------------------------------------
+    cfunc_icache_invalidate - drop any blocks
+    compiled from the page holding an instruction
+    cache line that was invalidated or refilled
+-------------------------------------------------*/
+
+void mips3_device::func_icache_invalidate()
+{
+	offs_t address = m_core->arg0;
+	if (memory_translate(AS_PROGRAM, TRANSLATE_FETCH, address))
+		m_drcuml->invalidate_code(address & ~31, 32);
+}
+
+static void cfunc_icache_invalidate(void *param)
+{
+	((mips3_device *)param)->func_icache_invalidate();
+}
+
+
 /*-------------------------------------------------
     cfunc_printf_exception - log any exceptions that
     aren't interrupts
@@ -1973,9 +2058,20 @@ bool mips3_device::generate_opcode(drcuml_block &block, compiler_state &compiler
 			return true;
 
 
-		/* ----- effective no-ops ----- */
+		/* ----- cache control ----- */
 
 		case 0x2f:  /* CACHE - MIPS II */
+			/* hit invalidate and fill of the primary instruction cache may mean code was changed */
+			if ((RTREG & 3) == 0 && ((RTREG >> 2) == 4 || (RTREG >> 2) == 5))
+			{
+				UML_ADD(block, mem(&m_core->arg0), R32(RSREG), SIMMVAL);               // add     [arg0],<rsreg>,SIMMVAL
+				UML_CALLC(block, cfunc_icache_invalidate, this);                          // callc   cfunc_icache_invalidate
+			}
+			return true;
+
+
+		/* ----- effective no-ops ----- */
+
 		case 0x33:  /* PREF - MIPS IV */
 			return true;
 
@@ -234,6 +234,7 @@ public:
 	void ppccom_tlb_fill();
 	void ppccom_update_fprf();
 	void ppccom_dcstore_callback();
+	void ppccom_execute_icbi();
 	void ppccom_execute_tlbie();
 	void ppccom_execute_tlbia();
 	void ppccom_execute_tlbl();
@@ -650,6 +651,7 @@ protected:
 	uint32_t compute_spr(uint32_t spr);
 	void code_flush_cache();
 	void code_compile_block(uint8_t mode, offs_t pc);
+	void code_prewarm_page(offs_t pc);
 	void static_generate_entry_point();
 	void static_generate_nocode_handler();
 	void static_generate_out_of_cycles();
@@ -850,6 +850,7 @@ void ppc_device::device_start()
 	uint32_t flags = 0;
 	/* initialize the UML generator */
 	m_drcuml = std::make_unique<drcuml_state>(*this, m_cache, flags, 8, 32, 2);
+	m_drcuml->enable_code_tracking(12);
 
 	/* add symbols for our stuff */
 	m_drcuml->symbol_add(&m_core->pc, sizeof(m_core->pc), "pc");
@@ -896,6 +897,7 @@ void ppc_device::device_start()
 
 	/* initialize the front-end helper */
 	m_drcfe = std::make_unique<frontend>(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+	m_drcuml->persist_open(COMPILE_BLOCKLIST_VERSION);
 
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 32; regnum++)
@@ -1219,6 +1221,20 @@ void ppc_device::ppccom_dcstore_callback()
 }
 
 
+/*-------------------------------------------------
+    ppccom_execute_icbi - execute an ICBI
+    instruction, dropping any blocks compiled from
+    the cache line's page
+-------------------------------------------------*/
+
+void ppc_device::ppccom_execute_icbi()
+{
+	offs_t address = m_core->param0 & ~(m_cache_line_size - 1);
+	if (ppccom_translate_address_internal(TRANSLATE_FETCH_DEBUG, address) <= 1)
+		m_drcuml->invalidate_code(address, m_cache_line_size);
+}
+
+
 /***************************************************************************
     TLB HANDLING
 ***************************************************************************/
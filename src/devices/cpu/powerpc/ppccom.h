@@ -40,6 +40,9 @@
 #define COMPILE_MAX_INSTRUCTIONS        ((COMPILE_BACKWARDS_BYTES/4) + (COMPILE_FORWARDS_BYTES/4))
 #define COMPILE_MAX_SEQUENCE            64
 
+/* persistent block lists -- bump when block descriptions change to discard old ones */
+#define COMPILE_BLOCKLIST_VERSION       1
+
 
 /* core parameters */
 #define POWERPC_MIN_PAGE_SHIFT      12
@@ -239,7 +239,10 @@ void ppc_device::execute_run()
 
 		/* if we need to recompile, do it */
 		if (execute_result == EXECUTE_MISSING_CODE)
+		{
 			code_compile_block(m_core->mode, m_core->pc);
+			code_prewarm_page(m_core->pc);
+		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_core->pc);
 		else if (execute_result == EXECUTE_RESET_CACHE)
@@ -388,6 +391,10 @@ void ppc_device::code_compile_block(uint8_t mode, offs_t pc)
 	if (m_drcuml->logging() || m_drcuml->logging_native())
 		log_opcode_desc(desclist, 0);
 
+	/* note the block for the persistent block list */
+	if (m_drcuml->persist_enabled())
+		m_drcuml->persist_record(mode, pc, m_drcfe->describe_hash());
+
 	bool succeeded = false;
 	while (!succeeded)
 	{
@@ -443,7 +450,10 @@ void ppc_device::code_compile_block(uint8_t mode, offs_t pc)
 
 				/* iterate over instructions in the sequence and compile them */
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
 					generate_sequence_instruction(block, &compiler, curdesc);                  // <instruction>
+					block.add_code_range(curdesc->physpc, 4);
+				}
 
 				/* if we need to return to the start, do it */
 				if (seqlast->flags & OPFLAG_RETURN_TO_START)
@@ -477,6 +487,26 @@ void ppc_device::code_compile_block(uint8_t mode, offs_t pc)
 }
 
 
+/*-------------------------------------------------
+    code_prewarm_page - compile any blocks from
+    the persistent block list that start on the
+    same page as the given PC
+-------------------------------------------------*/
+
+void ppc_device::code_prewarm_page(offs_t pc)
+{
+	m_drcuml->persist_prewarm(pc, [this] (uint8_t mode, offs_t blockpc, uint64_t hash)
+	{
+		/* only compile blocks whose code hasn't changed */
+		m_drcfe->describe_code(blockpc);
+		if (m_drcfe->describe_hash() != hash)
+			return false;
+		code_compile_block(mode, blockpc);
+		return true;
+	});
+}
+
+
 
 /***************************************************************************
     C FUNCTION CALLBACKS
@@ -597,6 +627,12 @@ static void cfunc_ppccom_dcstore_callback(void *param)
 	ppc->ppccom_dcstore_callback();
 }
 
+static void cfunc_ppccom_execute_icbi(void *param)
+{
+	ppc_device *ppc = (ppc_device *)param;
+	ppc->ppccom_execute_icbi();
+}
+
 static void cfunc_ppccom_execute_tlbie(void *param)
 {
 	ppc_device *ppc = (ppc_device *)param;
@@ -3245,10 +3281,15 @@ bool ppc_device::generate_instruction_1f(drcuml_block &block, compiler_state *co
 			UML_CALLC(block, (c_function)cfunc_ppccom_dcstore_callback, this);
 			return true;
 
+		case 0x3d6: /* ICBI */
+			UML_ADD(block, I0, R32Z(G_RA(op)), R32(G_RB(op)));                          // add     i0,ra,rb
+			UML_MOV(block, mem(&m_core->param0), I0);                                      // mov     [param0],i0
+			UML_CALLC(block, (c_function)cfunc_ppccom_execute_icbi, this);                 // callc   execute_icbi,ppc
+			return true;
+
 		case 0x056: /* DCBF */
 		case 0x0f6: /* DCBTST */
 		case 0x116: /* DCBT */
-		case 0x3d6: /* ICBI */
 		case 0x256: /* SYNC */
 		case 0x356: /* EIEIO */
 		case 0x1d6: /* DCBI */
@@ -72,6 +72,7 @@
 #include "sound/spu.h"
 
 #include "psxdefs.h"
+#include "psxfe.h"
 
 #define LOG_BIOSCALL ( 0 )
 
@@ -1335,6 +1336,9 @@ void psxcpu_device::update_address_masks()
 
 void psxcpu_device::update_scratchpad()
 {
+	// compiled code was found through the old mapping
+	m_drc_flush = 1;
+
 	if( ( m_biu & BIU_RAM ) == 0 )
 	{
 		m_program->install_readwrite_handler( 0x1f800000, 0x1f8003ff, read32smo_delegate(*this, FUNC(psxcpu_device::berr_r)), write32smo_delegate(*this, FUNC(psxcpu_device::berr_w)) );
@@ -1378,6 +1382,9 @@ void psxcpu_device::update_ram_config()
 	uint32_t ram_size = m_ram->size();
 	uint8_t *pointer = m_ram->pointer();
 
+	// compiled code was found through the old mapping
+	m_drc_flush = 1;
+
 	if( ram_size > window_size )
 	{
 		ram_size = window_size;
@@ -1413,6 +1420,9 @@ void psxcpu_device::update_rom_config()
 	uint32_t rom_size = m_rom->bytes();
 	uint8_t *pointer = m_rom->base();
 
+	// compiled code was found through the old mapping
+	m_drc_flush = 1;
+
 	if( rom_size > window_size )
 	{
 		rom_size = window_size;
@@ -1794,11 +1804,22 @@ psxcpu_device::psxcpu_device( const machine_config &mconfig, device_type type, c
 	m_cd_read_handler( *this ),
 	m_cd_write_handler( *this ),
 	m_ram( *this, "ram" ),
-	m_rom( *this, "rom" )
+	m_rom( *this, "rom" ),
+	m_enable_drc( false ),
+	m_drc_flush( 1 ),
+	m_drc_value( 0 ),
+	m_entry( nullptr ),
+	m_nocode( nullptr ),
+	m_out_of_cycles( nullptr ),
+	m_redispatch( nullptr )
 {
 	m_disable_rom_berr = false;
 }
 
+psxcpu_device::~psxcpu_device()
+{
+}
+
 cxd8530aq_device::cxd8530aq_device( const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock )
 	: psxcpu_device( mconfig, CXD8530AQ, tag, owner, clock)
 {
@@ -2334,1025 +2355,1044 @@ void psxcpu_device::execute_set_input( int inputnum, int state )
 
 void psxcpu_device::execute_run()
 {
+	// the recompiler hands back whatever it can't run itself
+	if( m_enable_drc && !LOG_BIOSCALL )
+	{
+		execute_run_drc();
+		if( m_icount <= 0 )
+		{
+			return;
+		}
+	}
+
 	do
 	{
-		if( LOG_BIOSCALL ) log_bioscall();
-		debugger_instruction_hook( m_pc );
+		execute_one();
+		m_icount--;
+	} while( m_icount > 0 );
+}
+
+void psxcpu_device::execute_one()
+{
+	if( LOG_BIOSCALL ) log_bioscall();
+	debugger_instruction_hook( m_pc );
 
-		int breakpoint = program_counter_breakpoint();
+	int breakpoint = program_counter_breakpoint();
 
-		if( ( m_pc & m_bad_word_address_mask ) != 0 )
+	if( ( m_pc & m_bad_word_address_mask ) != 0 )
+	{
+		load_bad_address( m_pc );
+	}
+	else if( breakpoint )
+	{
+		breakpoint_exception();
+	}
+	else
+	{
+		m_op = m_instruction.read_dword(m_pc);
+
+		if( m_berr )
 		{
-			load_bad_address( m_pc );
+			fetch_bus_error_exception();
 		}
-		else if( breakpoint )
+		else
 		{
-			breakpoint_exception();
+			execute_op();
 		}
-		else
+	}
+}
+
+void psxcpu_device::execute_op()
+{
+	switch( INS_OP( m_op ) )
+	{
+	case OP_SPECIAL:
+		switch( INS_FUNCT( m_op ) )
 		{
-			m_op = m_instruction.read_dword(m_pc);
+		case FUNCT_SLL:
+			load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] << INS_SHAMT( m_op ) );
+			break;
 
-			if( m_berr )
-			{
-				fetch_bus_error_exception();
-			}
-			else
-			{
-				switch( INS_OP( m_op ) )
-				{
-				case OP_SPECIAL:
-					switch( INS_FUNCT( m_op ) )
-					{
-					case FUNCT_SLL:
-						load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] << INS_SHAMT( m_op ) );
-						break;
+		case FUNCT_SRL:
+			load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] >> INS_SHAMT( m_op ) );
+			break;
 
-					case FUNCT_SRL:
-						load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] >> INS_SHAMT( m_op ) );
-						break;
+		case FUNCT_SRA:
+			load( INS_RD( m_op ), (int32_t)m_r[ INS_RT( m_op ) ] >> INS_SHAMT( m_op ) );
+			break;
 
-					case FUNCT_SRA:
-						load( INS_RD( m_op ), (int32_t)m_r[ INS_RT( m_op ) ] >> INS_SHAMT( m_op ) );
-						break;
+		case FUNCT_SLLV:
+			load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] << ( m_r[ INS_RS( m_op ) ] & 31 ) );
+			break;
 
-					case FUNCT_SLLV:
-						load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] << ( m_r[ INS_RS( m_op ) ] & 31 ) );
-						break;
+		case FUNCT_SRLV:
+			load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] >> ( m_r[ INS_RS( m_op ) ] & 31 ) );
+			break;
 
-					case FUNCT_SRLV:
-						load( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] >> ( m_r[ INS_RS( m_op ) ] & 31 ) );
-						break;
+		case FUNCT_SRAV:
+			load( INS_RD( m_op ), (int32_t)m_r[ INS_RT( m_op ) ] >> ( m_r[ INS_RS( m_op ) ] & 31 ) );
+			break;
 
-					case FUNCT_SRAV:
-						load( INS_RD( m_op ), (int32_t)m_r[ INS_RT( m_op ) ] >> ( m_r[ INS_RS( m_op ) ] & 31 ) );
-						break;
+		case FUNCT_JR:
+			branch( m_r[ INS_RS( m_op ) ] );
+			break;
 
-					case FUNCT_JR:
-						branch( m_r[ INS_RS( m_op ) ] );
-						break;
+		case FUNCT_JALR:
+			branch( m_r[ INS_RS( m_op ) ] );
+			if( INS_RD( m_op ) != 0 )
+			{
+				m_r[ INS_RD( m_op ) ] = m_pc + 4;
+			}
+			break;
 
-					case FUNCT_JALR:
-						branch( m_r[ INS_RS( m_op ) ] );
-						if( INS_RD( m_op ) != 0 )
-						{
-							m_r[ INS_RD( m_op ) ] = m_pc + 4;
-						}
-						break;
+		case FUNCT_SYSCALL:
+			if( LOG_BIOSCALL ) log_syscall();
+			exception( EXC_SYS );
+			break;
 
-					case FUNCT_SYSCALL:
-						if( LOG_BIOSCALL ) log_syscall();
-						exception( EXC_SYS );
-						break;
+		case FUNCT_BREAK:
+			exception( EXC_BP );
+			break;
 
-					case FUNCT_BREAK:
-						exception( EXC_BP );
-						break;
+		case FUNCT_MFHI:
+			load( INS_RD( m_op ), get_hi() );
+			break;
 
-					case FUNCT_MFHI:
-						load( INS_RD( m_op ), get_hi() );
-						break;
+		case FUNCT_MTHI:
+			funct_mthi();
+			advance_pc();
+			break;
 
-					case FUNCT_MTHI:
-						funct_mthi();
-						advance_pc();
-						break;
+		case FUNCT_MFLO:
+			load( INS_RD( m_op ), get_lo() );
+			break;
 
-					case FUNCT_MFLO:
-						load( INS_RD( m_op ), get_lo() );
-						break;
+		case FUNCT_MTLO:
+			funct_mtlo();
+			advance_pc();
+			break;
 
-					case FUNCT_MTLO:
-						funct_mtlo();
-						advance_pc();
-						break;
+		case FUNCT_MULT:
+			funct_mult();
+			advance_pc();
+			break;
 
-					case FUNCT_MULT:
-						funct_mult();
-						advance_pc();
-						break;
+		case FUNCT_MULTU:
+			funct_multu();
+			advance_pc();
+			break;
 
-					case FUNCT_MULTU:
-						funct_multu();
-						advance_pc();
-						break;
+		case FUNCT_DIV:
+			funct_div();
+			advance_pc();
+			break;
 
-					case FUNCT_DIV:
-						funct_div();
-						advance_pc();
-						break;
+		case FUNCT_DIVU:
+			funct_divu();
+			advance_pc();
+			break;
 
-					case FUNCT_DIVU:
-						funct_divu();
-						advance_pc();
-						break;
+		case FUNCT_ADD:
+			{
+				uint32_t result = m_r[ INS_RS( m_op ) ] + m_r[ INS_RT( m_op ) ];
+				if( (int32_t)( ~( m_r[ INS_RS( m_op ) ] ^ m_r[ INS_RT( m_op ) ] ) & ( m_r[ INS_RS( m_op ) ] ^ result ) ) < 0 )
+				{
+					exception( EXC_OVF );
+				}
+				else
+				{
+					load( INS_RD( m_op ), result );
+				}
+			}
+			break;
 
-					case FUNCT_ADD:
-						{
-							uint32_t result = m_r[ INS_RS( m_op ) ] + m_r[ INS_RT( m_op ) ];
-							if( (int32_t)( ~( m_r[ INS_RS( m_op ) ] ^ m_r[ INS_RT( m_op ) ] ) & ( m_r[ INS_RS( m_op ) ] ^ result ) ) < 0 )
-							{
-								exception( EXC_OVF );
-							}
-							else
-							{
-								load( INS_RD( m_op ), result );
-							}
-						}
-						break;
+		case FUNCT_ADDU:
+			load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] + m_r[ INS_RT( m_op ) ] );
+			break;
 
-					case FUNCT_ADDU:
-						load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] + m_r[ INS_RT( m_op ) ] );
-						break;
+		case FUNCT_SUB:
+			{
+				uint32_t result = m_r[ INS_RS( m_op ) ] - m_r[ INS_RT( m_op ) ];
+				if( (int32_t)( ( m_r[ INS_RS( m_op ) ] ^ m_r[ INS_RT( m_op ) ] ) & ( m_r[ INS_RS( m_op ) ] ^ result ) ) < 0 )
+				{
+					exception( EXC_OVF );
+				}
+				else
+				{
+					load( INS_RD( m_op ), result );
+				}
+			}
+			break;
 
-					case FUNCT_SUB:
-						{
-							uint32_t result = m_r[ INS_RS( m_op ) ] - m_r[ INS_RT( m_op ) ];
-							if( (int32_t)( ( m_r[ INS_RS( m_op ) ] ^ m_r[ INS_RT( m_op ) ] ) & ( m_r[ INS_RS( m_op ) ] ^ result ) ) < 0 )
-							{
-								exception( EXC_OVF );
-							}
-							else
-							{
-								load( INS_RD( m_op ), result );
-							}
-						}
-						break;
+		case FUNCT_SUBU:
+			load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] - m_r[ INS_RT( m_op ) ] );
+			break;
 
-					case FUNCT_SUBU:
-						load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] - m_r[ INS_RT( m_op ) ] );
-						break;
+		case FUNCT_AND:
+			load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] & m_r[ INS_RT( m_op ) ] );
+			break;
 
-					case FUNCT_AND:
-						load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] & m_r[ INS_RT( m_op ) ] );
-						break;
+		case FUNCT_OR:
+			load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] | m_r[ INS_RT( m_op ) ] );
+			break;
 
-					case FUNCT_OR:
-						load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] | m_r[ INS_RT( m_op ) ] );
-						break;
+		case FUNCT_XOR:
+			load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] ^ m_r[ INS_RT( m_op ) ] );
+			break;
 
-					case FUNCT_XOR:
-						load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] ^ m_r[ INS_RT( m_op ) ] );
-						break;
+		case FUNCT_NOR:
+			load( INS_RD( m_op ), ~( m_r[ INS_RS( m_op ) ] | m_r[ INS_RT( m_op ) ] ) );
+			break;
 
-					case FUNCT_NOR:
-						load( INS_RD( m_op ), ~( m_r[ INS_RS( m_op ) ] | m_r[ INS_RT( m_op ) ] ) );
-						break;
+		case FUNCT_SLT:
+			load( INS_RD( m_op ), (int32_t)m_r[ INS_RS( m_op ) ] < (int32_t)m_r[ INS_RT( m_op ) ] );
+			break;
 
-					case FUNCT_SLT:
-						load( INS_RD( m_op ), (int32_t)m_r[ INS_RS( m_op ) ] < (int32_t)m_r[ INS_RT( m_op ) ] );
-						break;
+		case FUNCT_SLTU:
+			load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] < m_r[ INS_RT( m_op ) ] );
+			break;
 
-					case FUNCT_SLTU:
-						load( INS_RD( m_op ), m_r[ INS_RS( m_op ) ] < m_r[ INS_RT( m_op ) ] );
-						break;
+		default:
+			exception( EXC_RI );
+			break;
+		}
+		break;
 
-					default:
-						exception( EXC_RI );
-						break;
-					}
-					break;
+	case OP_REGIMM:
+		switch( INS_RT_REGIMM( m_op ) )
+		{
+		case RT_BLTZ:
+			conditional_branch( (int32_t)m_r[ INS_RS( m_op ) ] < 0 );
 
-				case OP_REGIMM:
-					switch( INS_RT_REGIMM( m_op ) )
-					{
-					case RT_BLTZ:
-						conditional_branch( (int32_t)m_r[ INS_RS( m_op ) ] < 0 );
+			if( INS_RT( m_op ) == RT_BLTZAL )
+			{
+				m_r[ 31 ] = m_pc + 4;
+			}
+			break;
 
-						if( INS_RT( m_op ) == RT_BLTZAL )
-						{
-							m_r[ 31 ] = m_pc + 4;
-						}
-						break;
+		case RT_BGEZ:
+			conditional_branch( (int32_t)m_r[ INS_RS( m_op ) ] >= 0 );
 
-					case RT_BGEZ:
-						conditional_branch( (int32_t)m_r[ INS_RS( m_op ) ] >= 0 );
+			if( INS_RT( m_op ) == RT_BGEZAL )
+			{
+				m_r[ 31 ] = m_pc + 4;
+			}
+			break;
+		}
+		break;
 
-						if( INS_RT( m_op ) == RT_BGEZAL )
-						{
-							m_r[ 31 ] = m_pc + 4;
-						}
-						break;
-					}
-					break;
+	case OP_J:
+		unconditional_branch();
+		break;
 
-				case OP_J:
-					unconditional_branch();
-					break;
+	case OP_JAL:
+		unconditional_branch();
+		m_r[ 31 ] = m_pc + 4;
+		break;
 
-				case OP_JAL:
-					unconditional_branch();
-					m_r[ 31 ] = m_pc + 4;
-					break;
+	case OP_BEQ:
+		conditional_branch( m_r[ INS_RS( m_op ) ] == m_r[ INS_RT( m_op ) ] );
+		break;
 
-				case OP_BEQ:
-					conditional_branch( m_r[ INS_RS( m_op ) ] == m_r[ INS_RT( m_op ) ] );
-					break;
+	case OP_BNE:
+		conditional_branch( m_r[ INS_RS( m_op ) ] != m_r[ INS_RT( m_op ) ] );
+		break;
 
-				case OP_BNE:
-					conditional_branch( m_r[ INS_RS( m_op ) ] != m_r[ INS_RT( m_op ) ] );
-					break;
+	case OP_BLEZ:
+		conditional_branch( (int32_t)m_r[ INS_RS( m_op ) ] < 0 || m_r[ INS_RS( m_op ) ] == m_r[ INS_RT( m_op ) ] );
+		break;
 
-				case OP_BLEZ:
-					conditional_branch( (int32_t)m_r[ INS_RS( m_op ) ] < 0 || m_r[ INS_RS( m_op ) ] == m_r[ INS_RT( m_op ) ] );
-					break;
+	case OP_BGTZ:
+		conditional_branch( (int32_t)m_r[ INS_RS( m_op ) ] >= 0 && m_r[ INS_RS( m_op ) ] != m_r[ INS_RT( m_op ) ] );
+		break;
 
-				case OP_BGTZ:
-					conditional_branch( (int32_t)m_r[ INS_RS( m_op ) ] >= 0 && m_r[ INS_RS( m_op ) ] != m_r[ INS_RT( m_op ) ] );
-					break;
+	case OP_ADDI:
+		{
+			uint32_t immediate = PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+			uint32_t result = m_r[ INS_RS( m_op ) ] + immediate;
+			if( (int32_t)( ~( m_r[ INS_RS( m_op ) ] ^ immediate ) & ( m_r[ INS_RS( m_op ) ] ^ result ) ) < 0 )
+			{
+				exception( EXC_OVF );
+			}
+			else
+			{
+				load( INS_RT( m_op ), result );
+			}
+		}
+		break;
 
-				case OP_ADDI:
-					{
-						uint32_t immediate = PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-						uint32_t result = m_r[ INS_RS( m_op ) ] + immediate;
-						if( (int32_t)( ~( m_r[ INS_RS( m_op ) ] ^ immediate ) & ( m_r[ INS_RS( m_op ) ] ^ result ) ) < 0 )
-						{
-							exception( EXC_OVF );
-						}
-						else
-						{
-							load( INS_RT( m_op ), result );
-						}
-					}
-					break;
+	case OP_ADDIU:
+		load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) ) );
+		break;
 
-				case OP_ADDIU:
-					load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) ) );
-					break;
+	case OP_SLTI:
+		load( INS_RT( m_op ), (int32_t)m_r[ INS_RS( m_op ) ] < PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) ) );
+		break;
 
-				case OP_SLTI:
-					load( INS_RT( m_op ), (int32_t)m_r[ INS_RS( m_op ) ] < PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) ) );
-					break;
+	case OP_SLTIU:
+		load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] < (uint32_t)PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) ) );
+		break;
 
-				case OP_SLTIU:
-					load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] < (uint32_t)PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) ) );
-					break;
+	case OP_ANDI:
+		load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] & INS_IMMEDIATE( m_op ) );
+		break;
 
-				case OP_ANDI:
-					load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] & INS_IMMEDIATE( m_op ) );
-					break;
+	case OP_ORI:
+		load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] | INS_IMMEDIATE( m_op ) );
+		break;
 
-				case OP_ORI:
-					load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] | INS_IMMEDIATE( m_op ) );
-					break;
+	case OP_XORI:
+		load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] ^ INS_IMMEDIATE( m_op ) );
+		break;
 
-				case OP_XORI:
-					load( INS_RT( m_op ), m_r[ INS_RS( m_op ) ] ^ INS_IMMEDIATE( m_op ) );
-					break;
+	case OP_LUI:
+		load( INS_RT( m_op ), INS_IMMEDIATE( m_op ) << 16 );
+		break;
 
-				case OP_LUI:
-					load( INS_RT( m_op ), INS_IMMEDIATE( m_op ) << 16 );
-					break;
+	case OP_COP0:
+		switch( INS_RS( m_op ) )
+		{
+		case RS_MFC:
+			{
+				int reg = INS_RD( m_op );
 
-				case OP_COP0:
-					switch( INS_RS( m_op ) )
+				if( reg == CP0_INDEX ||
+					reg == CP0_RANDOM ||
+					reg == CP0_ENTRYLO ||
+					reg == CP0_CONTEXT ||
+					reg == CP0_ENTRYHI )
+				{
+					exception( EXC_RI );
+				}
+				else if( reg < 16 )
+				{
+					if( cop0_usable() )
 					{
-					case RS_MFC:
-						{
-							int reg = INS_RD( m_op );
-
-							if( reg == CP0_INDEX ||
-								reg == CP0_RANDOM ||
-								reg == CP0_ENTRYLO ||
-								reg == CP0_CONTEXT ||
-								reg == CP0_ENTRYHI )
-							{
-								exception( EXC_RI );
-							}
-							else if( reg < 16 )
-							{
-								if( cop0_usable() )
-								{
-									delayed_load( INS_RT( m_op ), m_cp0r[ reg ] );
-								}
-							}
-							else
-							{
-								advance_pc();
-							}
-						}
-						break;
+						delayed_load( INS_RT( m_op ), m_cp0r[ reg ] );
+					}
+				}
+				else
+				{
+					advance_pc();
+				}
+			}
+			break;
 
-					case RS_CFC:
-						exception( EXC_RI );
-						break;
+		case RS_CFC:
+			exception( EXC_RI );
+			break;
 
-					case RS_MTC:
-						{
-							int reg = INS_RD( m_op );
+		case RS_MTC:
+			{
+				int reg = INS_RD( m_op );
 
-							if( reg == CP0_INDEX ||
-								reg == CP0_RANDOM ||
-								reg == CP0_ENTRYLO ||
-								reg == CP0_CONTEXT ||
-								reg == CP0_ENTRYHI )
-							{
-								exception( EXC_RI );
-							}
-							else if( reg < 16 )
-							{
-								if( cop0_usable() )
-								{
-									uint32_t data = ( m_cp0r[ reg ] & ~mtc0_writemask[ reg ] ) |
-										( m_r[ INS_RT( m_op ) ] & mtc0_writemask[ reg ] );
-									advance_pc();
-
-									m_cp0r[ reg ] = data;
-									update_cop0( reg );
-								}
-							}
-							else
-							{
-								advance_pc();
-							}
-						}
-						break;
-
-					case RS_CTC:
-						exception( EXC_RI );
-						break;
+				if( reg == CP0_INDEX ||
+					reg == CP0_RANDOM ||
+					reg == CP0_ENTRYLO ||
+					reg == CP0_CONTEXT ||
+					reg == CP0_ENTRYHI )
+				{
+					exception( EXC_RI );
+				}
+				else if( reg < 16 )
+				{
+					if( cop0_usable() )
+					{
+						uint32_t data = ( m_cp0r[ reg ] & ~mtc0_writemask[ reg ] ) |
+							( m_r[ INS_RT( m_op ) ] & mtc0_writemask[ reg ] );
+						advance_pc();
 
-					case RS_BC:
-					case RS_BC_ALT:
-						switch( INS_BC( m_op ) )
-						{
-						case BC_BCF:
-							bc( 0, SR_CU0, 0 );
-							break;
+						m_cp0r[ reg ] = data;
+						update_cop0( reg );
+					}
+				}
+				else
+				{
+					advance_pc();
+				}
+			}
+			break;
 
-						case BC_BCT:
-							bc( 0, SR_CU0, 1 );
-							break;
-						}
-						break;
+		case RS_CTC:
+			exception( EXC_RI );
+			break;
 
-					default:
-						switch( INS_CO( m_op ) )
-						{
-						case 1:
-							switch( INS_CF( m_op ) )
-							{
-							case CF_TLBR:
-							case CF_TLBWI:
-							case CF_TLBWR:
-							case CF_TLBP:
-								exception( EXC_RI );
-								break;
-
-							case CF_RFE:
-								if( cop0_usable() )
-								{
-									advance_pc();
-									m_cp0r[ CP0_SR ] = ( m_cp0r[ CP0_SR ] & ~0xf ) | ( ( m_cp0r[ CP0_SR ] >> 2 ) & 0xf );
-									update_cop0( CP0_SR );
-								}
-								break;
+		case RS_BC:
+		case RS_BC_ALT:
+			switch( INS_BC( m_op ) )
+			{
+			case BC_BCF:
+				bc( 0, SR_CU0, 0 );
+				break;
 
-							default:
-								advance_pc();
-								break;
-							}
-							break;
+			case BC_BCT:
+				bc( 0, SR_CU0, 1 );
+				break;
+			}
+			break;
 
-						default:
-							advance_pc();
-							break;
-						}
-						break;
-					}
+		default:
+			switch( INS_CO( m_op ) )
+			{
+			case 1:
+				switch( INS_CF( m_op ) )
+				{
+				case CF_TLBR:
+				case CF_TLBWI:
+				case CF_TLBWR:
+				case CF_TLBP:
+					exception( EXC_RI );
 					break;
 
-				case OP_COP1:
-					if( ( m_cp0r[ CP0_SR ] & SR_CU1 ) == 0 )
+				case CF_RFE:
+					if( cop0_usable() )
 					{
-						exception( EXC_CPU );
+						advance_pc();
+						m_cp0r[ CP0_SR ] = ( m_cp0r[ CP0_SR ] & ~0xf ) | ( ( m_cp0r[ CP0_SR ] >> 2 ) & 0xf );
+						update_cop0( CP0_SR );
 					}
-					else
-					{
-						switch( INS_RS( m_op ) )
-						{
-						case RS_MFC:
-							delayed_load( INS_RT( m_op ), getcp1dr( INS_RD( m_op ) ) );
-							break;
-
-						case RS_CFC:
-							delayed_load( INS_RT( m_op ), getcp1cr( INS_RD( m_op ) ) );
-							break;
-
-						case RS_MTC:
-							setcp1dr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
-							advance_pc();
-							break;
-
-						case RS_CTC:
-							setcp1cr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
-							advance_pc();
-							break;
-
-						case RS_BC:
-						case RS_BC_ALT:
-							switch( INS_BC( m_op ) )
-							{
-							case BC_BCF:
-								bc( 1, SR_CU1, 0 );
-								break;
+					break;
 
-							case BC_BCT:
-								bc( 1, SR_CU1, 1 );
-								break;
-							}
-							break;
+				default:
+					advance_pc();
+					break;
+				}
+				break;
 
-						default:
-							advance_pc();
-							break;
-						}
-					}
+			default:
+				advance_pc();
+				break;
+			}
+			break;
+		}
+		break;
+
+	case OP_COP1:
+		if( ( m_cp0r[ CP0_SR ] & SR_CU1 ) == 0 )
+		{
+			exception( EXC_CPU );
+		}
+		else
+		{
+			switch( INS_RS( m_op ) )
+			{
+			case RS_MFC:
+				delayed_load( INS_RT( m_op ), getcp1dr( INS_RD( m_op ) ) );
+				break;
+
+			case RS_CFC:
+				delayed_load( INS_RT( m_op ), getcp1cr( INS_RD( m_op ) ) );
+				break;
+
+			case RS_MTC:
+				setcp1dr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
+				advance_pc();
+				break;
+
+			case RS_CTC:
+				setcp1cr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
+				advance_pc();
+				break;
+
+			case RS_BC:
+			case RS_BC_ALT:
+				switch( INS_BC( m_op ) )
+				{
+				case BC_BCF:
+					bc( 1, SR_CU1, 0 );
 					break;
 
-				case OP_COP2:
-					if( ( m_cp0r[ CP0_SR ] & SR_CU2 ) == 0 )
-					{
-						exception( EXC_CPU );
-					}
-					else
-					{
-						switch( INS_RS( m_op ) )
-						{
-						case RS_MFC:
-							delayed_load( INS_RT( m_op ), m_gte.getcp2dr( m_pc, INS_RD( m_op ) ) );
-							break;
-
-						case RS_CFC:
-							delayed_load( INS_RT( m_op ), m_gte.getcp2cr( m_pc, INS_RD( m_op ) ) );
-							break;
-
-						case RS_MTC:
-							m_gte.setcp2dr( m_pc, INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
-							advance_pc();
-							break;
-
-						case RS_CTC:
-							m_gte.setcp2cr( m_pc, INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
-							advance_pc();
-							break;
-
-						case RS_BC:
-						case RS_BC_ALT:
-							switch( INS_BC( m_op ) )
-							{
-							case BC_BCF:
-								bc( 2, SR_CU2, 0 );
-								break;
+				case BC_BCT:
+					bc( 1, SR_CU1, 1 );
+					break;
+				}
+				break;
 
-							case BC_BCT:
-								bc( 2, SR_CU2, 1 );
-								break;
-							}
-							break;
+			default:
+				advance_pc();
+				break;
+			}
+		}
+		break;
 
-						default:
-							switch( INS_CO( m_op ) )
-							{
-							case 1:
-								if( !m_gte.docop2( m_pc, INS_COFUN( m_op ) ) )
-								{
-									stop();
-								}
+	case OP_COP2:
+		if( ( m_cp0r[ CP0_SR ] & SR_CU2 ) == 0 )
+		{
+			exception( EXC_CPU );
+		}
+		else
+		{
+			switch( INS_RS( m_op ) )
+			{
+			case RS_MFC:
+				delayed_load( INS_RT( m_op ), m_gte.getcp2dr( m_pc, INS_RD( m_op ) ) );
+				break;
 
-								advance_pc();
-								break;
+			case RS_CFC:
+				delayed_load( INS_RT( m_op ), m_gte.getcp2cr( m_pc, INS_RD( m_op ) ) );
+				break;
 
-							default:
-								advance_pc();
-								break;
-							}
-							break;
-						}
-					}
+			case RS_MTC:
+				m_gte.setcp2dr( m_pc, INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
+				advance_pc();
+				break;
+
+			case RS_CTC:
+				m_gte.setcp2cr( m_pc, INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
+				advance_pc();
+				break;
+
+			case RS_BC:
+			case RS_BC_ALT:
+				switch( INS_BC( m_op ) )
+				{
+				case BC_BCF:
+					bc( 2, SR_CU2, 0 );
 					break;
 
-				case OP_COP3:
-					if( ( m_cp0r[ CP0_SR ] & SR_CU3 ) == 0 )
+				case BC_BCT:
+					bc( 2, SR_CU2, 1 );
+					break;
+				}
+				break;
+
+			default:
+				switch( INS_CO( m_op ) )
+				{
+				case 1:
+					if( !m_gte.docop2( m_pc, INS_COFUN( m_op ) ) )
 					{
-						exception( EXC_CPU );
+						stop();
 					}
-					else
-					{
-						switch( INS_RS( m_op ) )
-						{
-						case RS_MFC:
-							delayed_load( INS_RT( m_op ), getcp3dr( INS_RD( m_op ) ) );
-							break;
-
-						case RS_CFC:
-							delayed_load( INS_RT( m_op ), getcp3cr( INS_RD( m_op ) ) );
-							break;
-
-						case RS_MTC:
-							setcp3dr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
-							advance_pc();
-							break;
-
-						case RS_CTC:
-							setcp3cr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
-							advance_pc();
-							break;
-
-						case RS_BC:
-						case RS_BC_ALT:
-							switch( INS_BC( m_op ) )
-							{
-							case BC_BCF:
-								bc( 3, SR_CU3, 0 );
-								break;
 
-							case BC_BCT:
-								bc( 3, SR_CU3, 1 );
-								break;
-							}
-							break;
+					advance_pc();
+					break;
 
-						default:
-							advance_pc();
-							break;
-						}
-					}
+				default:
+					advance_pc();
 					break;
+				}
+				break;
+			}
+		}
+		break;
 
-				case OP_LB:
-					{
-						uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-						int breakpoint = load_data_address_breakpoint( address );
+	case OP_COP3:
+		if( ( m_cp0r[ CP0_SR ] & SR_CU3 ) == 0 )
+		{
+			exception( EXC_CPU );
+		}
+		else
+		{
+			switch( INS_RS( m_op ) )
+			{
+			case RS_MFC:
+				delayed_load( INS_RT( m_op ), getcp3dr( INS_RD( m_op ) ) );
+				break;
 
-						if( ( address & m_bad_byte_address_mask ) != 0 )
-						{
-							load_bad_address( address );
-						}
-						else if( breakpoint )
-						{
-							breakpoint_exception();
-						}
-						else
-						{
-							uint32_t data = PSXCPU_BYTE_EXTEND( readbyte( address ) );
+			case RS_CFC:
+				delayed_load( INS_RT( m_op ), getcp3cr( INS_RD( m_op ) ) );
+				break;
 
-							if( m_berr )
-							{
-								load_bus_error_exception();
-							}
-							else
-							{
-								delayed_load( INS_RT( m_op ), data );
-							}
-						}
-					}
-					break;
+			case RS_MTC:
+				setcp3dr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
+				advance_pc();
+				break;
 
-				case OP_LH:
-					{
-						uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-						int breakpoint = load_data_address_breakpoint( address );
+			case RS_CTC:
+				setcp3cr( INS_RD( m_op ), m_r[ INS_RT( m_op ) ] );
+				advance_pc();
+				break;
 
-						if( ( address & m_bad_half_address_mask ) != 0 )
-						{
-							load_bad_address( address );
-						}
-						else if( breakpoint )
-						{
-							breakpoint_exception();
-						}
-						else
-						{
-							uint32_t data = PSXCPU_WORD_EXTEND( readhalf( address ) );
+			case RS_BC:
+			case RS_BC_ALT:
+				switch( INS_BC( m_op ) )
+				{
+				case BC_BCF:
+					bc( 3, SR_CU3, 0 );
+					break;
 
-							if( m_berr )
-							{
-								load_bus_error_exception();
-							}
-							else
-							{
-								delayed_load( INS_RT( m_op ), data );
-							}
-						}
-					}
+				case BC_BCT:
+					bc( 3, SR_CU3, 1 );
 					break;
+				}
+				break;
 
-				case OP_LWL:
-					{
-						uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-						int load_type = address & 3;
-						int breakpoint;
+			default:
+				advance_pc();
+				break;
+			}
+		}
+		break;
 
-						address &= ~3;
-						breakpoint = load_data_address_breakpoint( address );
+	case OP_LB:
+		{
+			uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+			int breakpoint = load_data_address_breakpoint( address );
 
-						if( ( address & m_bad_byte_address_mask ) != 0 )
-						{
-							load_bad_address( address );
-						}
-						else if( breakpoint )
-						{
-							breakpoint_exception();
-						}
-						else
-						{
-							uint32_t data = get_register_from_pipeline( INS_RT( m_op ) );
+			if( ( address & m_bad_byte_address_mask ) != 0 )
+			{
+				load_bad_address( address );
+			}
+			else if( breakpoint )
+			{
+				breakpoint_exception();
+			}
+			else
+			{
+				uint32_t data = PSXCPU_BYTE_EXTEND( readbyte( address ) );
 
-							switch( load_type )
-							{
-							case 0:
-								data = ( data & 0x00ffffff ) | ( readword_masked( address, 0x000000ff ) << 24 );
-								break;
+				if( m_berr )
+				{
+					load_bus_error_exception();
+				}
+				else
+				{
+					delayed_load( INS_RT( m_op ), data );
+				}
+			}
+		}
+		break;
 
-							case 1:
-								data = ( data & 0x0000ffff ) | ( readword_masked( address, 0x0000ffff ) << 16 );
-								break;
+	case OP_LH:
+		{
+			uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+			int breakpoint = load_data_address_breakpoint( address );
 
-							case 2:
-								data = ( data & 0x000000ff ) | ( readword_masked( address, 0x00ffffff ) << 8 );
-								break;
+			if( ( address & m_bad_half_address_mask ) != 0 )
+			{
+				load_bad_address( address );
+			}
+			else if( breakpoint )
+			{
+				breakpoint_exception();
+			}
+			else
+			{
+				uint32_t data = PSXCPU_WORD_EXTEND( readhalf( address ) );
 
-							case 3:
-								data = readword( address );
-								break;
-							}
+				if( m_berr )
+				{
+					load_bus_error_exception();
+				}
+				else
+				{
+					delayed_load( INS_RT( m_op ), data );
+				}
+			}
+		}
+		break;
 
-							if( m_berr )
-							{
-								load_bus_error_exception();
-							}
-							else
-							{
-								delayed_load( INS_RT( m_op ), data );
-							}
-						}
-					}
-					break;
+	case OP_LWL:
+		{
+			uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+			int load_type = address & 3;
+			int breakpoint;
 
-				case OP_LW:
-					{
-						uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-						int breakpoint = load_data_address_breakpoint( address );
+			address &= ~3;
+			breakpoint = load_data_address_breakpoint( address );
 
-						if( ( address & m_bad_word_address_mask ) != 0 )
-						{
-							load_bad_address( address );
-						}
-						else if( breakpoint )
-						{
-							breakpoint_exception();
-						}
-						else
-						{
-							uint32_t data = readword( address );
+			if( ( address & m_bad_byte_address_mask ) != 0 )
+			{
+				load_bad_address( address );
+			}
+			else if( breakpoint )
+			{
+				breakpoint_exception();
+			}
+			else
+			{
+				uint32_t data = get_register_from_pipeline( INS_RT( m_op ) );
 
-							if( m_berr )
-							{
-								load_bus_error_exception();
-							}
-							else
-							{
-								delayed_load( INS_RT( m_op ), data );
-							}
-						}
-					}
+				switch( load_type )
+				{
+				case 0:
+					data = ( data & 0x00ffffff ) | ( readword_masked( address, 0x000000ff ) << 24 );
 					break;
 
-				case OP_LBU:
-					{
-						uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-						int breakpoint = load_data_address_breakpoint( address );
+				case 1:
+					data = ( data & 0x0000ffff ) | ( readword_masked( address, 0x0000ffff ) << 16 );
+					break;
 
-						if( ( address & m_bad_byte_address_mask ) != 0 )
-						{
-							load_bad_address( address );
-						}
-						else if( breakpoint )
-						{
-							breakpoint_exception();
-						}
-						else
-						{
-							uint32_t data = readbyte( address );
+				case 2:
+					data = ( data & 0x000000ff ) | ( readword_masked( address, 0x00ffffff ) << 8 );
+					break;
 
-							if( m_berr )
-							{
-								load_bus_error_exception();
-							}
-							else
-							{
-								delayed_load( INS_RT( m_op ), data );
-							}
-						}
-					}
+				case 3:
+					data = readword( address );
 					break;
+				}
 
-				case OP_LHU:
-					{
-						uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-						int breakpoint = load_data_address_breakpoint( address );
+				if( m_berr )
+				{
+					load_bus_error_exception();
+				}
+				else
+				{
+					delayed_load( INS_RT( m_op ), data );
+				}
+			}
+		}
+		break;
 
-						if( ( address & m_bad_half_address_mask ) != 0 )
-						{
-							load_bad_address( address );
-						}
-						else if( breakpoint )
-						{
-							breakpoint_exception();
-						}
-						else
-						{
-							uint32_t data = readhalf( address );
+	case OP_LW:
+		{
+			uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+			int breakpoint = load_data_address_breakpoint( address );
+
+			if( ( address & m_bad_word_address_mask ) != 0 )
+			{
+				load_bad_address( address );
+			}
+			else if( breakpoint )
+			{
+				breakpoint_exception();
+			}
+			else
+			{
+				uint32_t data = readword( address );
+
+				if( m_berr )
+				{
+					load_bus_error_exception();
+				}
+				else
+				{
+					delayed_load( INS_RT( m_op ), data );
+				}
+			}
+		}
+		break;
+
+	case OP_LBU:
+		{
+			uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+			int breakpoint = load_data_address_breakpoint( address );
 
-							if( m_berr )
-							{
-								load_bus_error_exception();
-							}
-							else
-							{
-								delayed_load( INS_RT( m_op ), data );
-							}
-						}
-					}
-					break;
+			if( ( address & m_bad_byte_address_mask ) != 0 )
+			{
+				load_bad_address( address );
+			}
+			else if( breakpoint )
+			{
+				breakpoint_exception();
+			}
+			else
+			{
+				uint32_t data = readbyte( address );
 
-				case OP_LWR:
-					{
-						uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-						int breakpoint = load_data_address_breakpoint( address );
+				if( m_berr )
+				{
+					load_bus_error_exception();
+				}
+				else
+				{
+					delayed_load( INS_RT( m_op ), data );
+				}
+			}
+		}
+		break;
 
-						if( ( address & m_bad_byte_address_mask ) != 0 )
-						{
-							load_bad_address( address );
-						}
-						else if( breakpoint )
-						{
-							breakpoint_exception();
-						}
-						else
-						{
-							uint32_t data = get_register_from_pipeline( INS_RT( m_op ) );
+	case OP_LHU:
+		{
+			uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+			int breakpoint = load_data_address_breakpoint( address );
 
-							switch( address & 3 )
-							{
-							case 0:
-								data = readword( address );
-								break;
+			if( ( address & m_bad_half_address_mask ) != 0 )
+			{
+				load_bad_address( address );
+			}
+			else if( breakpoint )
+			{
+				breakpoint_exception();
+			}
+			else
+			{
+				uint32_t data = readhalf( address );
 
-							case 1:
-								data = ( data & 0xff000000 ) | ( readword_masked( address, 0xffffff00 ) >> 8 );
-								break;
+				if( m_berr )
+				{
+					load_bus_error_exception();
+				}
+				else
+				{
+					delayed_load( INS_RT( m_op ), data );
+				}
+			}
+		}
+		break;
 
-							case 2:
-								data = ( data & 0xffff0000 ) | ( readword_masked( address, 0xffff0000 ) >> 16 );
-								break;
+	case OP_LWR:
+		{
+			uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+			int breakpoint = load_data_address_breakpoint( address );
 
-							case 3:
-								data = ( data & 0xffffff00 ) | ( readword_masked( address, 0xff000000 ) >> 24 );
-								break;
-							}
+			if( ( address & m_bad_byte_address_mask ) != 0 )
+			{
+				load_bad_address( address );
+			}
+			else if( breakpoint )
+			{
+				breakpoint_exception();
+			}
+			else
+			{
+				uint32_t data = get_register_from_pipeline( INS_RT( m_op ) );
 
-							if( m_berr )
-							{
-								load_bus_error_exception();
-							}
-							else
-							{
-								delayed_load( INS_RT( m_op ), data );
-							}
-						}
-					}
+				switch( address & 3 )
+				{
+				case 0:
+					data = readword( address );
 					break;
 
-				case OP_SB:
-					{
-						uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-						int breakpoint = store_data_address_breakpoint( address );
+				case 1:
+					data = ( data & 0xff000000 ) | ( readword_masked( address, 0xffffff00 ) >> 8 );
+					break;
 
-						if( ( address & m_bad_byte_address_mask ) != 0 )
-						{
-							store_bad_address( address );
-						}
-						else
-						{
-							int shift = 8 * ( address & 3 );
-							writeword_masked( address, m_r[ INS_RT( m_op ) ] << shift, 0xff << shift );
+				case 2:
+					data = ( data & 0xffff0000 ) | ( readword_masked( address, 0xffff0000 ) >> 16 );
+					break;
 
-							if( breakpoint )
-							{
-								breakpoint_exception();
-							}
-							else if( m_berr )
-							{
-								store_bus_error_exception();
-							}
-							else
-							{
-								advance_pc();
-							}
-						}
-					}
+				case 3:
+					data = ( data & 0xffffff00 ) | ( readword_masked( address, 0xff000000 ) >> 24 );
 					break;
+				}
 
-				case OP_SH:
-					{
-						uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-						int breakpoint = store_data_address_breakpoint( address );
+				if( m_berr )
+				{
+					load_bus_error_exception();
+				}
+				else
+				{
+					delayed_load( INS_RT( m_op ), data );
+				}
+			}
+		}
+		break;
 
-						if( ( address & m_bad_half_address_mask ) != 0 )
-						{
-							store_bad_address( address );
-						}
-						else
-						{
-							int shift = 8 * ( address & 2 );
-							writeword_masked( address, m_r[ INS_RT( m_op ) ] << shift, 0xffff << shift );
+	case OP_SB:
+		{
+			uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+			int breakpoint = store_data_address_breakpoint( address );
 
-							if( breakpoint )
-							{
-								breakpoint_exception();
-							}
-							else if( m_berr )
-							{
-								store_bus_error_exception();
-							}
-							else
-							{
-								advance_pc();
-							}
-						}
-					}
-					break;
+			if( ( address & m_bad_byte_address_mask ) != 0 )
+			{
+				store_bad_address( address );
+			}
+			else
+			{
+				int shift = 8 * ( address & 3 );
+				writeword_masked( address, m_r[ INS_RT( m_op ) ] << shift, 0xff << shift );
 
-				case OP_SWL:
-					{
-						uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-						int save_type = address & 3;
-						int breakpoint;
+				if( breakpoint )
+				{
+					breakpoint_exception();
+				}
+				else if( m_berr )
+				{
+					store_bus_error_exception();
+				}
+				else
+				{
+					advance_pc();
+				}
+			}
+		}
+		break;
 
-						address &= ~3;
-						breakpoint = store_data_address_breakpoint( address );
+	case OP_SH:
+		{
+			uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+			int breakpoint = store_data_address_breakpoint( address );
 
-						if( ( address & m_bad_byte_address_mask ) != 0 )
-						{
-							store_bad_address( address );
-						}
-						else
-						{
-							switch( save_type )
-							{
-							case 0:
-								writeword_masked( address, m_r[ INS_RT( m_op ) ] >> 24, 0x000000ff );
-								break;
+			if( ( address & m_bad_half_address_mask ) != 0 )
+			{
+				store_bad_address( address );
+			}
+			else
+			{
+				int shift = 8 * ( address & 2 );
+				writeword_masked( address, m_r[ INS_RT( m_op ) ] << shift, 0xffff << shift );
 
-							case 1:
-								writeword_masked( address, m_r[ INS_RT( m_op ) ] >> 16, 0x0000ffff );
-								break;
+				if( breakpoint )
+				{
+					breakpoint_exception();
+				}
+				else if( m_berr )
+				{
+					store_bus_error_exception();
+				}
+				else
+				{
+					advance_pc();
+				}
+			}
+		}
+		break;
 
-							case 2:
-								writeword_masked( address, m_r[ INS_RT( m_op ) ] >> 8, 0x00ffffff );
-								break;
+	case OP_SWL:
+		{
+			uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+			int save_type = address & 3;
+			int breakpoint;
 
-							case 3:
-								writeword( address, m_r[ INS_RT( m_op ) ] );
-								break;
-							}
+			address &= ~3;
+			breakpoint = store_data_address_breakpoint( address );
 
-							if( breakpoint )
-							{
-								breakpoint_exception();
-							}
-							else if( m_berr )
-							{
-								store_bus_error_exception();
-							}
-							else
-							{
-								advance_pc();
-							}
-						}
-					}
+			if( ( address & m_bad_byte_address_mask ) != 0 )
+			{
+				store_bad_address( address );
+			}
+			else
+			{
+				switch( save_type )
+				{
+				case 0:
+					writeword_masked( address, m_r[ INS_RT( m_op ) ] >> 24, 0x000000ff );
 					break;
 
-				case OP_SW:
-					{
-						uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-						int breakpoint = store_data_address_breakpoint( address );
+				case 1:
+					writeword_masked( address, m_r[ INS_RT( m_op ) ] >> 16, 0x0000ffff );
+					break;
 
-						if( ( address & m_bad_word_address_mask ) != 0 )
-						{
-							store_bad_address( address );
-						}
-						else
-						{
-							writeword( address, m_r[ INS_RT( m_op ) ] );
+				case 2:
+					writeword_masked( address, m_r[ INS_RT( m_op ) ] >> 8, 0x00ffffff );
+					break;
 
-							if( breakpoint )
-							{
-								breakpoint_exception();
-							}
-							else if( m_berr )
-							{
-								store_bus_error_exception();
-							}
-							else
-							{
-								advance_pc();
-							}
-						}
-					}
+				case 3:
+					writeword( address, m_r[ INS_RT( m_op ) ] );
 					break;
+				}
 
-				case OP_SWR:
-					{
-						uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
-						int breakpoint = store_data_address_breakpoint( address );
+				if( breakpoint )
+				{
+					breakpoint_exception();
+				}
+				else if( m_berr )
+				{
+					store_bus_error_exception();
+				}
+				else
+				{
+					advance_pc();
+				}
+			}
+		}
+		break;
 
-						if( ( address & m_bad_byte_address_mask ) != 0 )
-						{
-							store_bad_address( address );
-						}
-						else
-						{
-							switch( address & 3 )
-							{
-							case 0:
-								writeword( address, m_r[ INS_RT( m_op ) ] );
-								break;
+	case OP_SW:
+		{
+			uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+			int breakpoint = store_data_address_breakpoint( address );
 
-							case 1:
-								writeword_masked( address, m_r[ INS_RT( m_op ) ] << 8, 0xffffff00 );
-								break;
+			if( ( address & m_bad_word_address_mask ) != 0 )
+			{
+				store_bad_address( address );
+			}
+			else
+			{
+				writeword( address, m_r[ INS_RT( m_op ) ] );
 
-							case 2:
-								writeword_masked( address, m_r[ INS_RT( m_op ) ] << 16, 0xffff0000 );
-								break;
+				if( breakpoint )
+				{
+					breakpoint_exception();
+				}
+				else if( m_berr )
+				{
+					store_bus_error_exception();
+				}
+				else
+				{
+					advance_pc();
+				}
+			}
+		}
+		break;
 
-							case 3:
-								writeword_masked( address, m_r[ INS_RT( m_op ) ] << 24, 0xff000000 );
-								break;
-							}
+	case OP_SWR:
+		{
+			uint32_t address = m_r[ INS_RS( m_op ) ] + PSXCPU_WORD_EXTEND( INS_IMMEDIATE( m_op ) );
+			int breakpoint = store_data_address_breakpoint( address );
 
-							if( breakpoint )
-							{
-								breakpoint_exception();
-							}
-							else if( m_berr )
-							{
-								store_bus_error_exception();
-							}
-							else
-							{
-								advance_pc();
-							}
-						}
-					}
+			if( ( address & m_bad_byte_address_mask ) != 0 )
+			{
+				store_bad_address( address );
+			}
+			else
+			{
+				switch( address & 3 )
+				{
+				case 0:
+					writeword( address, m_r[ INS_RT( m_op ) ] );
 					break;
 
-				case OP_LWC0:
-					lwc( 0, SR_CU0 );
+				case 1:
+					writeword_masked( address, m_r[ INS_RT( m_op ) ] << 8, 0xffffff00 );
 					break;
 
-				case OP_LWC1:
-					lwc( 1, SR_CU1 );
+				case 2:
+					writeword_masked( address, m_r[ INS_RT( m_op ) ] << 16, 0xffff0000 );
 					break;
 
-				case OP_LWC2:
-					lwc( 2, SR_CU2 );
+				case 3:
+					writeword_masked( address, m_r[ INS_RT( m_op ) ] << 24, 0xff000000 );
 					break;
+				}
 
-				case OP_LWC3:
-					lwc( 3, SR_CU3 );
-					break;
+				if( breakpoint )
+				{
+					breakpoint_exception();
+				}
+				else if( m_berr )
+				{
+					store_bus_error_exception();
+				}
+				else
+				{
+					advance_pc();
+				}
+			}
+		}
+		break;
 
-				case OP_SWC0:
-					swc( 0, SR_CU0 );
-					break;
+	case OP_LWC0:
+		lwc( 0, SR_CU0 );
+		break;
 
-				case OP_SWC1:
-					swc( 1, SR_CU1 );
-					break;
+	case OP_LWC1:
+		lwc( 1, SR_CU1 );
+		break;
 
-				case OP_SWC2:
-					swc( 2, SR_CU2 );
-					break;
+	case OP_LWC2:
+		lwc( 2, SR_CU2 );
+		break;
 
-				case OP_SWC3:
-					swc( 3, SR_CU3 );
-					break;
+	case OP_LWC3:
+		lwc( 3, SR_CU3 );
+		break;
 
-				default:
-					logerror( "%08x: unknown opcode %08x\n", m_pc, m_op );
-					stop();
-					exception( EXC_RI );
-					break;
-				}
-			}
-		}
+	case OP_SWC0:
+		swc( 0, SR_CU0 );
+		break;
 
-		m_icount--;
-	} while( m_icount > 0 );
+	case OP_SWC1:
+		swc( 1, SR_CU1 );
+		break;
+
+	case OP_SWC2:
+		swc( 2, SR_CU2 );
+		break;
+
+	case OP_SWC3:
+		swc( 3, SR_CU3 );
+		break;
+
+	default:
+		logerror( "%08x: unknown opcode %08x\n", m_pc, m_op );
+		stop();
+		exception( EXC_RI );
+		break;
+	}
 }
 
 uint32_t psxcpu_device::getcp1dr( int reg )
@@ -3473,3 +3513,11 @@ void psxcpu_device::device_add_mconfig(machine_config &config)
 
 	RAM(config, "ram").set_default_value(0x00);
 }
+
+
+
+//**************************************************************************
+//  RECOMPILER
+//**************************************************************************
+
+#include "psxdrc.hxx"
@@ -13,6 +13,8 @@
 #pragma once
 
 #include "machine/ram.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
 #include "dma.h"
 #include "gte.h"
 #include "irq.h"
@@ -116,9 +118,15 @@ enum
 
 // ======================> psxcpu_device
 
+class psxcpu_frontend;
+
 class psxcpu_device : public cpu_device, psxcpu_disassembler::config
 {
+	friend class psxcpu_frontend;
+
 public:
+	virtual ~psxcpu_device();
+
 	// configuration helpers
 	auto gpu_read() { return m_gpu_read_handler.bind(); }
 	auto gpu_write() { return m_gpu_write_handler.bind(); }
@@ -163,6 +171,9 @@ public:
 	static psxcpu_device *getcpu( device_t &device, const char *cputag ) { return downcast<psxcpu_device *>( device.subdevice( cputag ) ); }
 	void set_disable_rom_berr(bool mode);
 
+	// use the recompiler rather than the interpreter, if allowed
+	void enable_recompiler();
+
 	void psxcpu_internal_map(address_map &map);
 protected:
 	static constexpr unsigned ICACHE_ENTRIES = 0x400;
@@ -259,6 +270,8 @@ protected:
 	uint32_t get_hi();
 	uint32_t get_lo();
 	int execute_unstoppable_instructions( int executeCop2 );
+	void execute_one();
+	void execute_op();
 	void update_address_masks();
 	void update_scratchpad();
 	void update_ram_config();
@@ -303,6 +316,44 @@ protected:
 
 	gte m_gte;
 
+	// recompiler
+	struct compiler_state
+	{
+		uint32_t        cycles;         // accumulated cycles
+		uml::code_label labelnum;       // index for local labels
+		uint32_t        delayr;         // what m_delayr holds before the next instruction, if known
+	};
+
+	static void cfunc_execute_op(void *param);
+	static void cfunc_load_complete(void *param);
+	static void cfunc_store_complete(void *param);
+
+	void drc_load_complete();
+	void drc_store_complete();
+	uint32_t const *drc_code_pointer(offs_t pc, bool &ram);
+	void execute_run_drc();
+	void init_recompiler();
+	void flush_cache();
+	void compile_block(offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_redispatch();
+	void generate_checksum_block(drcuml_block &block, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param);
+	void generate_jump(drcuml_block &block, compiler_state &compiler, uint32_t targetpc, bool intrablock);
+	void generate_dynamic_jump(drcuml_block &block, compiler_state &compiler);
+	void generate_leave(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_commit(drcuml_block &block, compiler_state &compiler, uint32_t cancel);
+	void generate_delayed_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_load(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_store(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_generic(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_get_reg(drcuml_block &block, uml::parameter dst, int reg);
+	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+
 	devcb_read32 m_gpu_read_handler;
 	devcb_write32 m_gpu_write_handler;
 	devcb_read16 m_spu_read_handler;
@@ -313,6 +364,18 @@ protected:
 	required_memory_region m_rom;
 	bool m_disable_rom_berr;
 
+	// recompiler state
+	bool m_enable_drc;
+	uint32_t m_drc_flush;           // compiled code may be stale
+	uint32_t m_drc_value;           // loaded value for C helpers
+	std::unique_ptr<drc_cache> m_drccache;
+	std::unique_ptr<drcuml_state> m_drcuml;
+	std::unique_ptr<psxcpu_frontend> m_drcfe;
+	uml::code_handle *m_entry;      // entry point
+	uml::code_handle *m_nocode;     // nocode exception handler
+	uml::code_handle *m_out_of_cycles; // out of cycles exception handler
+	uml::code_handle *m_redispatch; // hands back to execute_run_drc
+
 private:
 	// disassembler interface
 	virtual uint32_t pc() override { return m_pc; }
@@ -0,0 +1,1112 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    psxdrc.hxx
+
+    Universal machine language-based PlayStation CPU emulator.
+
+    Shifts, ALU operations without overflow traps, LUI, the branches and
+    jumps (with their delay slot generated inline) and the aligned
+    LB/LBU/LH/LHU/LW/SB/SH/SW are generated as UML.  Everything else,
+    including ADD/ADDI/SUB, the multiplier, LWL/LWR/SWL/SWR, the
+    coprocessors and the GTE, runs the interpreter's own code for the
+    instruction through a C helper, so results can't differ from the
+    interpreter, which is still used unless the driver calls
+    enable_recompiler().
+
+    The pipeline is kept where the interpreter keeps it: m_delayr and
+    m_delayv hold the pending load or branch at every instruction
+    boundary, so generated code and the interpreter can take over from
+    each other anywhere.  Where the previous instruction is known the
+    load delay is resolved at compile time, otherwise m_delayr is
+    checked.
+
+    User mode, cache isolation and the debug unit are left to the
+    interpreter, as are fetches from anywhere but RAM and ROM; COP0
+    instructions always return to execute_run_drc() so a change is seen
+    straight away.  Code in RAM is compared against what was compiled
+    each time a sequence is entered, so it doesn't matter whether it
+    was overwritten by the CPU or by DMA.
+
+***************************************************************************/
+
+#include "cpu/drcumlsh.h"
+
+
+namespace {
+
+// size of the code cache
+constexpr u32 CACHE_SIZE                = 8 * 1024 * 1024;
+
+// compilation boundaries -- how far back/forward does the analysis extend?
+constexpr u32 COMPILE_BACKWARDS_BYTES   = 128;
+constexpr u32 COMPILE_FORWARDS_BYTES    = 512;
+constexpr u32 COMPILE_MAX_INSTRUCTIONS  = (COMPILE_BACKWARDS_BYTES / 4) + (COMPILE_FORWARDS_BYTES / 4);
+constexpr u32 COMPILE_MAX_SEQUENCE      = 64;
+
+// exit codes
+constexpr int EXECUTE_OUT_OF_CYCLES     = 0;
+constexpr int EXECUTE_MISSING_CODE      = 1;
+constexpr int EXECUTE_INTERPRET         = 2;
+constexpr int EXECUTE_REDISPATCH        = 3;
+
+// m_delayr isn't known at compile time
+constexpr u32 DELAYR_UNKNOWN            = ~u32(0);
+
+// the previous instruction was a branch; m_delayr is PSXCPU_DELAYR_PC or
+// PSXCPU_DELAYR_NOTPC
+constexpr u32 DELAYR_BRANCH             = ~u32(1);
+
+} // anonymous namespace
+
+
+// map variables
+#define MAPVAR_PC                       uml::M0
+#define MAPVAR_CYCLES                   uml::M1
+
+
+
+/***************************************************************************
+    C HELPERS
+***************************************************************************/
+
+void psxcpu_device::cfunc_execute_op(void *param)
+{
+	reinterpret_cast<psxcpu_device *>(param)->execute_op();
+}
+
+void psxcpu_device::cfunc_load_complete(void *param)
+{
+	reinterpret_cast<psxcpu_device *>(param)->drc_load_complete();
+}
+
+void psxcpu_device::cfunc_store_complete(void *param)
+{
+	reinterpret_cast<psxcpu_device *>(param)->drc_store_complete();
+}
+
+
+//-------------------------------------------------
+//  drc_load_complete - finish a load that caused
+//  a bus error or let an interrupt in, the way
+//  the interpreter does
+//-------------------------------------------------
+
+void psxcpu_device::drc_load_complete()
+{
+	if( m_berr )
+	{
+		load_bus_error_exception();
+	}
+	else
+	{
+		delayed_load( INS_RT( m_op ), m_drc_value );
+	}
+}
+
+
+//-------------------------------------------------
+//  drc_store_complete - finish a store that
+//  caused a bus error or let an interrupt in
+//-------------------------------------------------
+
+void psxcpu_device::drc_store_complete()
+{
+	if( m_berr )
+	{
+		store_bus_error_exception();
+	}
+	else
+	{
+		advance_pc();
+	}
+}
+
+
+
+/***************************************************************************
+    CORE EXECUTION
+***************************************************************************/
+
+//-------------------------------------------------
+//  enable_recompiler - use the recompiler rather
+//  than the interpreter, if allowed
+//-------------------------------------------------
+
+void psxcpu_device::enable_recompiler()
+{
+	m_enable_drc = allow_drc();
+}
+
+
+//-------------------------------------------------
+//  drc_code_pointer - find the memory an opcode
+//  is fetched from, or nullptr if it isn't RAM or
+//  ROM
+//-------------------------------------------------
+
+uint32_t const *psxcpu_device::drc_code_pointer(offs_t pc, bool &ram)
+{
+	if( ( pc & 3 ) != 0 )
+		return nullptr;
+
+	auto const ptr = reinterpret_cast<uint32_t const *>(m_program->get_read_ptr(pc));
+	if( ptr == nullptr )
+		return nullptr;
+
+	uintptr_t const rom = uintptr_t(m_rom->base());
+	ram = uintptr_t(ptr) < rom || uintptr_t(ptr) >= rom + m_rom->bytes();
+	return ptr;
+}
+
+
+//-------------------------------------------------
+//  init_recompiler - set up the recompiler the
+//  first time it's used
+//-------------------------------------------------
+
+void psxcpu_device::init_recompiler()
+{
+	m_drccache = std::make_unique<drc_cache>(CACHE_SIZE);
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_drccache, 0, 1, 32, 2);
+
+	// add UML symbols
+	m_drcuml->symbol_add(&m_pc, sizeof(m_pc), "pc");
+	m_drcuml->symbol_add(&m_icount, sizeof(m_icount), "icount");
+	for (int i = 0; i < 32; i++)
+		m_drcuml->symbol_add(&m_r[i], sizeof(m_r[0]), util::string_format("r%d", i).c_str());
+	m_drcuml->symbol_add(&m_delayr, sizeof(m_delayr), "delayr");
+	m_drcuml->symbol_add(&m_delayv, sizeof(m_delayv), "delayv");
+
+	m_drcfe = std::make_unique<psxcpu_frontend>(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE);
+
+	m_drc_flush = 1;
+}
+
+
+//-------------------------------------------------
+//  execute_run_drc - execute generated code until
+//  the timeslice runs out or something comes up
+//  that's left to the interpreter
+//-------------------------------------------------
+
+void psxcpu_device::execute_run_drc()
+{
+	if (!m_drcuml)
+		init_recompiler();
+
+	while (m_icount > 0)
+	{
+		// the rest of the timeslice is interpreted in these modes
+		if ((m_cp0r[CP0_DCIC] & DCIC_DE) != 0 || (m_cp0r[CP0_SR] & (SR_KUC | SR_ISC)) != 0)
+			return;
+
+		// reset the cache if dirty
+		if (m_drc_flush)
+			flush_cache();
+
+		// generated code is never entered between a branch and its delay slot
+		if (m_delayr >= PSXCPU_DELAYR_PC || (m_pc & 3) != 0)
+		{
+			execute_one();
+			m_icount--;
+			continue;
+		}
+
+		int const execute_result = m_drcuml->execute(*m_entry);
+
+		// if we need to recompile, do it
+		if (execute_result == EXECUTE_MISSING_CODE)
+			compile_block(m_pc);
+		else if (execute_result == EXECUTE_INTERPRET)
+		{
+			execute_one();
+			m_icount--;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  flush_cache - throw away all generated code
+//  and regenerate the static handlers
+//-------------------------------------------------
+
+void psxcpu_device::flush_cache()
+{
+	// empty the transient cache contents
+	m_drcuml->reset();
+	m_drc_flush = 0;
+
+	try
+	{
+		// generate the entry point and exception handlers
+		static_generate_entry_point();
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+		static_generate_redispatch();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Error generating PSX CPU static handlers\n");
+	}
+}
+
+
+//-------------------------------------------------
+//  compile_block - compile a block of code
+//  starting at the given PC
+//-------------------------------------------------
+
+void psxcpu_device::compile_block(offs_t pc)
+{
+	// describe the block
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+
+	bool override = false;
+	for (;;)
+	{
+		try
+		{
+			compiler_state compiler = { 0, 1, DELAYR_UNKNOWN };
+			const opcode_desc *seqlast;
+
+			drcuml_block &block(m_drcuml->begin_block(COMPILE_MAX_INSTRUCTIONS * 128));
+
+			for (const opcode_desc *seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				// determine the last instruction in this sequence
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				// if we don't have a hash for this mode/pc, or if we are overriding all, add one
+				if (override || !m_drcuml->hash_exists(0, seqhead->pc))
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,seqhead->pc
+
+				// if we already have a hash, and this is the first sequence, assume that we
+				// are recompiling due to being out of sync and allow future overrides
+				else if (seqhead == desclist)
+				{
+					override = true;
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,seqhead->pc
+				}
+
+				// otherwise, redispatch to that fixed PC and skip the rest of the processing
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc
+					UML_HASHJMP(block, 0, seqhead->pc, *m_nocode);                          // hashjmp 0,seqhead->pc,nocode
+					continue;
+				}
+
+				// label this instruction, if it may be jumped to locally
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc
+
+				// make sure the code in RAM hasn't changed
+				generate_checksum_block(block, seqhead, seqlast);
+
+				// iterate over instructions in the sequence and compile them
+				compiler.delayr = DELAYR_UNKNOWN;
+				for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, compiler, curdesc);
+
+				// count off cycles and go to the next instruction, past any delay slot
+				uint32_t const nextpc = seqlast->pc + (seqlast->skipslots + 1) * 4;
+				generate_update_cycles(block, compiler, nextpc);                            // <subtract cycles>
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, 0, nextpc, *m_nocode);                               // hashjmp 0,nextpc,nocode
+			}
+
+			block.end();
+			return;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			flush_cache();
+		}
+	}
+}
+
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+//-------------------------------------------------
+//  static_generate_entry_point - generate a
+//  static entry point
+//-------------------------------------------------
+
+void psxcpu_device::static_generate_entry_point()
+{
+	drcuml_block &block(m_drcuml->begin_block(20));
+
+	// forward references
+	if (!m_nocode)
+		m_nocode = m_drcuml->handle_alloc("nocode");
+
+	if (!m_entry)
+		m_entry = m_drcuml->handle_alloc("entry");
+	UML_HANDLE(block, *m_entry);                                                            // handle  entry
+
+	// generate a hash jump via the current PC
+	UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[pc]
+	UML_HASHJMP(block, 0, I0, *m_nocode);                                                   // hashjmp 0,i0,nocode
+
+	block.end();
+}
+
+
+//-------------------------------------------------
+//  static_generate_nocode_handler - generate an
+//  exception handler for "out of code"
+//-------------------------------------------------
+
+void psxcpu_device::static_generate_nocode_handler()
+{
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	UML_HANDLE(block, *m_nocode);                                                           // handle  nocode
+	UML_GETEXP(block, I0);                                                                  // getexp  i0
+	UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x1);                                   // store   [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                                  // exit    EXECUTE_MISSING_CODE
+
+	block.end();
+}
+
+
+//-------------------------------------------------
+//  static_generate_out_of_cycles - generate an
+//  out of cycles exception handler
+//-------------------------------------------------
+
+void psxcpu_device::static_generate_out_of_cycles()
+{
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	if (!m_out_of_cycles)
+		m_out_of_cycles = m_drcuml->handle_alloc("out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                                    // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                                  // getexp  i0
+	UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x1);                                   // store   [pc],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                                 // exit    EXECUTE_OUT_OF_CYCLES
+
+	block.end();
+}
+
+
+//-------------------------------------------------
+//  static_generate_redispatch - generate an
+//  exception handler that goes back to
+//  execute_run_drc to decide what runs next
+//-------------------------------------------------
+
+void psxcpu_device::static_generate_redispatch()
+{
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	if (!m_redispatch)
+		m_redispatch = m_drcuml->handle_alloc("redispatch");
+	UML_HANDLE(block, *m_redispatch);                                                       // handle  redispatch
+	UML_GETEXP(block, I0);                                                                  // getexp  i0
+	UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x1);                                   // store   [pc],i0
+	UML_EXIT(block, EXECUTE_REDISPATCH);                                                    // exit    EXECUTE_REDISPATCH
+
+	block.end();
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+//-------------------------------------------------
+//  generate_checksum_block - generate code to
+//  recompile a sequence if any of its code in RAM
+//  has changed since it was compiled
+//-------------------------------------------------
+
+void psxcpu_device::generate_checksum_block(drcuml_block &block, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+	{
+		for (const opcode_desc *desc = curdesc; desc != nullptr; desc = (desc == curdesc) ? curdesc->delay.first() : desc->next())
+		{
+			if (!(desc->userflags & psxcpu_frontend::USERFLAG_CODE_IN_RAM))
+				continue;
+
+			bool ram;
+			uint32_t const *const opptr = drc_code_pointer(desc->physpc, ram);
+			UML_LOAD(block, I0, opptr, 0, SIZE_DWORD, SCALE_x1);                            // load    i0,[opptr]
+			UML_CMP(block, I0, desc->opptr.l[0]);                                           // cmp     i0,op
+			UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                               // exne    nocode,seqhead->pc
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  generate_sequence_instruction - generate code
+//  for a single instruction in a sequence
+//-------------------------------------------------
+
+void psxcpu_device::generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	// set the PC map variable
+	UML_MAPVAR(block, MAPVAR_PC, desc->pc);                                                 // mapvar  PC,desc->pc
+
+	// code that can't be compiled is fetched and run by the interpreter
+	if (desc->flags & OPFLAG_INVALID_OPCODE)
+	{
+		UML_MOV(block, I0, desc->pc);                                                       // mov     i0,desc->pc
+		generate_update_cycles(block, compiler, uml::I0);                                   // <subtract cycles>
+		UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x1);                               // store   [pc],i0
+		UML_EXIT(block, EXECUTE_INTERPRET);                                                 // exit    EXECUTE_INTERPRET
+		compiler.delayr = DELAYR_UNKNOWN;
+		return;
+	}
+
+	// accumulate total cycles
+	compiler.cycles += desc->cycles;
+
+	// update the icount map variable
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                                      // mapvar  CYCLES,compiler.cycles
+
+	// if we are debugging, call the debugger
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x1);                         // store   [pc],desc->pc
+		UML_DEBUG(block, desc->pc);                                                         // debug   desc->pc
+	}
+
+	// compile the instruction, running anything not handled through the interpreter
+	if (!generate_opcode(block, compiler, desc))
+		generate_generic(block, compiler, desc);
+}
+
+
+//-------------------------------------------------
+//  generate_update_cycles - generate code to
+//  subtract cycles from the icount and generate
+//  an exception if out
+//-------------------------------------------------
+
+void psxcpu_device::generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param)
+{
+	// account for cycles; like the interpreter, stop once the count isn't positive
+	if (compiler.cycles > 0)
+	{
+		UML_LOAD(block, I1, &m_icount, 0, SIZE_DWORD, SCALE_x1);                            // load    i1,[icount]
+		UML_SUB(block, I1, I1, compiler.cycles);                                            // sub     i1,i1,cycles
+		UML_STORE(block, &m_icount, 0, I1, SIZE_DWORD, SCALE_x1);                           // store   [icount],i1
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                                // mapvar  cycles,0
+		UML_CMP(block, I1, 0);                                                              // cmp     i1,0
+		UML_EXHc(block, COND_LE, *m_out_of_cycles, param);                                  // exh     out_of_cycles,param
+	}
+	compiler.cycles = 0;
+}
+
+
+//-------------------------------------------------
+//  generate_jump - generate code to go to a fixed
+//  address
+//-------------------------------------------------
+
+void psxcpu_device::generate_jump(drcuml_block &block, compiler_state &compiler, uint32_t targetpc, bool intrablock)
+{
+	compiler_state compiler_temp(compiler);
+	generate_update_cycles(block, compiler_temp, targetpc);                                 // <subtract cycles>
+
+	if (intrablock)
+		UML_JMP(block, targetpc | 0x80000000);                                              // jmp     targetpc | 0x80000000
+	else
+		UML_HASHJMP(block, 0, targetpc, *m_nocode);                                         // hashjmp 0,targetpc,nocode
+}
+
+
+//-------------------------------------------------
+//  generate_dynamic_jump - generate code to go to
+//  the address in I0, going back to
+//  execute_run_drc if there's a branch pending
+//  or the address is misaligned
+//-------------------------------------------------
+
+void psxcpu_device::generate_dynamic_jump(drcuml_block &block, compiler_state &compiler)
+{
+	compiler_state compiler_temp(compiler);
+	generate_update_cycles(block, compiler_temp, uml::I0);                                  // <subtract cycles>
+
+	UML_TEST(block, I0, 3);                                                                 // test    i0,3
+	UML_EXHc(block, COND_NZ, *m_redispatch, I0);                                            // exhnz   redispatch,i0
+	UML_LOAD(block, I1, &m_delayr, 0, SIZE_DWORD, SCALE_x1);                                // load    i1,[delayr]
+	UML_CMP(block, I1, PSXCPU_DELAYR_PC);                                                   // cmp     i1,PSXCPU_DELAYR_PC
+	UML_EXHc(block, COND_AE, *m_redispatch, I0);                                            // exhae   redispatch,i0
+	UML_HASHJMP(block, 0, I0, *m_nocode);                                                   // hashjmp 0,i0,nocode
+}
+
+
+//-------------------------------------------------
+//  generate_leave - generate code to carry on
+//  after a C helper, leaving the sequence if it
+//  didn't go to the next instruction
+//-------------------------------------------------
+
+void psxcpu_device::generate_leave(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uml::code_label const leave = compiler.labelnum++;
+	uml::code_label const skip = compiler.labelnum++;
+
+	// COP0 always goes back to execute_run_drc, in case the mode has changed
+	if (desc->flags & OPFLAG_CAN_CHANGE_MODES)
+	{
+		UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                // load    i0,[pc]
+		compiler_state compiler_temp(compiler);
+		generate_update_cycles(block, compiler_temp, uml::I0);                              // <subtract cycles>
+		UML_EXH(block, *m_redispatch, I0);                                                  // exh     redispatch,i0
+		return;
+	}
+
+	// the next instruction follows inline unless this is a delay slot
+	UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[pc]
+	if (!(desc->flags & OPFLAG_IN_DELAY_SLOT) && !(desc->flags & OPFLAG_END_SEQUENCE))
+	{
+		UML_LOAD(block, I1, &m_delayr, 0, SIZE_DWORD, SCALE_x1);                            // load    i1,[delayr]
+		UML_CMP(block, I1, PSXCPU_DELAYR_PC);                                               // cmp     i1,PSXCPU_DELAYR_PC
+		UML_JMPc(block, COND_AE, leave);                                                    // jae     leave
+		UML_CMP(block, I0, desc->pc + 4);                                                   // cmp     i0,desc->pc + 4
+		UML_JMPc(block, COND_E, skip);                                                      // je      skip
+		UML_LABEL(block, leave);                                                            // leave:
+	}
+	generate_dynamic_jump(block, compiler);
+	UML_LABEL(block, skip);                                                                 // skip:
+}
+
+
+//-------------------------------------------------
+//  generate_commit - generate code for the
+//  interpreter's advance_pc, which completes the
+//  load or branch started by the previous
+//  instruction; a register given in cancel is
+//  about to be loaded again, so isn't written
+//-------------------------------------------------
+
+void psxcpu_device::generate_commit(drcuml_block &block, compiler_state &compiler, uint32_t cancel)
+{
+	uint32_t const delayr = compiler.delayr;
+	compiler.delayr = 0;
+
+	if (delayr == DELAYR_UNKNOWN)
+	{
+		uml::code_label const skip = compiler.labelnum++;
+		uml::code_label const clear = compiler.labelnum++;
+
+		UML_LOAD(block, I2, &m_delayr, 0, SIZE_DWORD, SCALE_x1);                            // load    i2,[delayr]
+		UML_CMP(block, I2, 0);                                                              // cmp     i2,0
+		UML_JMPc(block, COND_E, skip);                                                      // je      skip
+		if (cancel != 0)
+		{
+			UML_CMP(block, I2, cancel);                                                     // cmp     i2,cancel
+			UML_JMPc(block, COND_E, clear);                                                 // je      clear
+		}
+		UML_LOAD(block, I3, &m_delayv, 0, SIZE_DWORD, SCALE_x1);                            // load    i3,[delayv]
+		UML_STORE(block, m_r, I2, I3, SIZE_DWORD, SCALE_x4);                                // store   r,i2,i3
+		UML_LABEL(block, clear);                                                            // clear:
+		UML_STORE(block, &m_delayr, 0, 0, SIZE_DWORD, SCALE_x1);                            // store   [delayr],0
+		UML_STORE(block, &m_delayv, 0, 0, SIZE_DWORD, SCALE_x1);                            // store   [delayv],0
+		UML_LABEL(block, skip);                                                             // skip:
+	}
+	else if (delayr == DELAYR_BRANCH)
+	{
+		// the branch itself is taken once the delay slot is done
+		UML_LOAD(block, I4, &m_delayr, 0, SIZE_DWORD, SCALE_x1);                            // load    i4,[delayr]
+		UML_LOAD(block, I5, &m_delayv, 0, SIZE_DWORD, SCALE_x1);                            // load    i5,[delayv]
+		UML_STORE(block, &m_delayr, 0, 0, SIZE_DWORD, SCALE_x1);                            // store   [delayr],0
+		UML_STORE(block, &m_delayv, 0, 0, SIZE_DWORD, SCALE_x1);                            // store   [delayv],0
+	}
+	else if (delayr != 0)
+	{
+		if (delayr != cancel)
+		{
+			UML_LOAD(block, I3, &m_delayv, 0, SIZE_DWORD, SCALE_x1);                        // load    i3,[delayv]
+			UML_STORE(block, &m_r[delayr], 0, I3, SIZE_DWORD, SCALE_x1);                    // store   [r],i3
+		}
+		UML_STORE(block, &m_delayr, 0, 0, SIZE_DWORD, SCALE_x1);                            // store   [delayr],0
+		UML_STORE(block, &m_delayv, 0, 0, SIZE_DWORD, SCALE_x1);                            // store   [delayv],0
+	}
+}
+
+
+//-------------------------------------------------
+//  generate_delayed_branch - generate the delay
+//  slot of a branch, then the branch, from the
+//  state left in I4 and I5
+//-------------------------------------------------
+
+void psxcpu_device::generate_delayed_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	compiler.delayr = DELAYR_BRANCH;
+	generate_sequence_instruction(block, compiler, desc->delay.first());
+
+	// a delay slot run by the interpreter has left already
+	if (compiler.delayr == DELAYR_UNKNOWN)
+		return;
+
+	uml::code_label const skip = compiler.labelnum++;
+	if (desc->flags & OPFLAG_IS_CONDITIONAL_BRANCH)
+	{
+		UML_CMP(block, I4, PSXCPU_DELAYR_PC);                                               // cmp     i4,PSXCPU_DELAYR_PC
+		UML_JMPc(block, COND_NE, skip);                                                     // jne     skip
+	}
+
+	if (desc->targetpc == BRANCH_TARGET_DYNAMIC)
+	{
+		UML_MOV(block, I0, I5);                                                             // mov     i0,i5
+		generate_dynamic_jump(block, compiler);
+	}
+	else
+		generate_jump(block, compiler, desc->targetpc, (desc->flags & OPFLAG_INTRABLOCK_BRANCH) != 0);
+
+	UML_LABEL(block, skip);                                                                 // skip:
+}
+
+
+//-------------------------------------------------
+//  generate_branch - generate code for a branch
+//  or jump, which sets up m_delayr and m_delayv
+//  like the interpreter
+//-------------------------------------------------
+
+void psxcpu_device::generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t const op = desc->opptr.l[0];
+	bool const conditional = (desc->flags & OPFLAG_IS_CONDITIONAL_BRANCH) != 0;
+
+	// the registers are read before the previous load completes
+	if (conditional)
+	{
+		generate_get_reg(block, uml::I0, INS_RS(op));
+		switch (INS_OP(op))
+		{
+		case OP_REGIMM:
+			UML_CMP(block, I0, 0);                                                          // cmp     i0,0
+			UML_SETc(block, BIT(op, 16) ? COND_GE : COND_L, I0);                            // set     i0,ge/l
+			break;
+
+		case OP_BEQ:
+		case OP_BNE:
+			generate_get_reg(block, uml::I1, INS_RT(op));
+			UML_CMP(block, I0, I1);                                                         // cmp     i0,i1
+			UML_SETc(block, (INS_OP(op) == OP_BEQ) ? COND_E : COND_NE, I0);                 // set     i0,e/ne
+			break;
+
+		case OP_BLEZ:
+			// rs < 0 || rs == rt
+			generate_get_reg(block, uml::I1, INS_RT(op));
+			UML_CMP(block, I0, I1);                                                         // cmp     i0,i1
+			UML_SETc(block, COND_E, I1);                                                    // set     i1,e
+			UML_SHR(block, I0, I0, 31);                                                     // shr     i0,i0,31
+			UML_OR(block, I0, I0, I1);                                                      // or      i0,i0,i1
+			break;
+
+		case OP_BGTZ:
+			// rs >= 0 && rs != rt
+			generate_get_reg(block, uml::I1, INS_RT(op));
+			UML_CMP(block, I0, I1);                                                         // cmp     i0,i1
+			UML_SETc(block, COND_NE, I1);                                                   // set     i1,ne
+			UML_SHR(block, I0, I0, 31);                                                     // shr     i0,i0,31
+			UML_XOR(block, I0, I0, 1);                                                      // xor     i0,i0,1
+			UML_AND(block, I0, I0, I1);                                                     // and     i0,i0,i1
+			break;
+		}
+	}
+	else if (desc->targetpc == BRANCH_TARGET_DYNAMIC)
+		generate_get_reg(block, uml::I0, INS_RS(op));
+
+	generate_commit(block, compiler, 0);
+
+	if (conditional)
+	{
+		// m_delayr = taken ? PC : NOTPC, m_delayv = taken ? target : 0
+		UML_SUB(block, I1, PSXCPU_DELAYR_NOTPC, I0);                                        // sub     i1,PSXCPU_DELAYR_NOTPC,i0
+		UML_STORE(block, &m_delayr, 0, I1, SIZE_DWORD, SCALE_x1);                           // store   [delayr],i1
+		UML_SUB(block, I1, 0, I0);                                                          // sub     i1,0,i0
+		UML_AND(block, I1, I1, desc->targetpc);                                             // and     i1,i1,targetpc
+		UML_STORE(block, &m_delayv, 0, I1, SIZE_DWORD, SCALE_x1);                           // store   [delayv],i1
+	}
+	else
+	{
+		UML_STORE(block, &m_delayr, 0, PSXCPU_DELAYR_PC, SIZE_DWORD, SCALE_x1);             // store   [delayr],PSXCPU_DELAYR_PC
+		if (desc->targetpc == BRANCH_TARGET_DYNAMIC)
+			UML_STORE(block, &m_delayv, 0, I0, SIZE_DWORD, SCALE_x1);                       // store   [delayv],i0
+		else
+			UML_STORE(block, &m_delayv, 0, desc->targetpc, SIZE_DWORD, SCALE_x1);           // store   [delayv],targetpc
+	}
+
+	// the return address
+	if (INS_OP(op) == OP_JAL || (INS_OP(op) == OP_REGIMM && (INS_RT(op) == RT_BLTZAL || INS_RT(op) == RT_BGEZAL)))
+		UML_STORE(block, &m_r[31], 0, desc->pc + 8, SIZE_DWORD, SCALE_x1);                  // store   [r31],desc->pc + 8
+	else if (INS_OP(op) == OP_SPECIAL && INS_FUNCT(op) == FUNCT_JALR && INS_RD(op) != 0)
+		UML_STORE(block, &m_r[INS_RD(op)], 0, desc->pc + 8, SIZE_DWORD, SCALE_x1);          // store   [rd],desc->pc + 8
+
+	generate_delayed_branch(block, compiler, desc);
+}
+
+
+//-------------------------------------------------
+//  generate_load - generate code for an aligned
+//  load, leaving bus errors and anything that
+//  lets an interrupt in to C helpers
+//-------------------------------------------------
+
+void psxcpu_device::generate_load(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t const op = desc->opptr.l[0];
+	uml::code_label const slow = compiler.labelnum++;
+	uml::code_label const tail = compiler.labelnum++;
+	uml::code_label const done = compiler.labelnum++;
+
+	uint32_t mask;
+	uml::operand_size size;
+	switch (INS_OP(op))
+	{
+	case OP_LB:
+	case OP_LBU:
+		mask = 0;
+		size = uml::SIZE_BYTE;
+		break;
+
+	case OP_LH:
+	case OP_LHU:
+		mask = 1;
+		size = uml::SIZE_WORD;
+		break;
+
+	default:
+		mask = 3;
+		size = uml::SIZE_DWORD;
+		break;
+	}
+
+	// the address; generated code only runs in kernel mode
+	generate_get_reg(block, uml::I0, INS_RS(op));
+	if (INS_IMMEDIATE(op) != 0)
+		UML_ADD(block, I0, I0, PSXCPU_WORD_EXTEND(INS_IMMEDIATE(op)));                      // add     i0,i0,simm
+	if (mask != 0)
+	{
+		UML_TEST(block, I0, mask);                                                          // test    i0,mask
+		UML_JMPc(block, COND_NZ, slow);                                                     // jnz     slow
+	}
+
+	UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x1);                             // store   [pc],desc->pc
+	UML_READ(block, I1, I0, size, SPACE_PROGRAM);                                           // read    i1,i0,size,program
+	if (INS_OP(op) == OP_LB)
+		UML_SEXT(block, I1, I1, SIZE_BYTE);                                                 // sext    i1,i1,byte
+	else if (INS_OP(op) == OP_LH)
+		UML_SEXT(block, I1, I1, SIZE_WORD);                                                 // sext    i1,i1,word
+
+	// a bus error, or an interrupt taken by a handler, is finished off by the interpreter
+	UML_LOAD(block, I2, &m_berr, 0, SIZE_DWORD, SCALE_x1);                                  // load    i2,[berr]
+	UML_CMP(block, I2, 0);                                                                  // cmp     i2,0
+	UML_JMPc(block, COND_NE, tail);                                                         // jne     tail
+	UML_LOAD(block, I2, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i2,[pc]
+	UML_CMP(block, I2, desc->pc);                                                           // cmp     i2,desc->pc
+	UML_JMPc(block, COND_NE, tail);                                                         // jne     tail
+
+	generate_commit(block, compiler, INS_RT(op));
+	UML_STORE(block, &m_delayr, 0, INS_RT(op), SIZE_DWORD, SCALE_x1);                       // store   [delayr],rt
+	UML_STORE(block, &m_delayv, 0, I1, SIZE_DWORD, SCALE_x1);                               // store   [delayv],i1
+	compiler.delayr = INS_RT(op);
+	UML_JMP(block, done);                                                                   // jmp     done
+
+	UML_LABEL(block, tail);                                                                 // tail:
+	UML_STORE(block, &m_op, 0, op, SIZE_DWORD, SCALE_x1);                                   // store   [op],op
+	UML_STORE(block, &m_drc_value, 0, I1, SIZE_DWORD, SCALE_x1);                            // store   [drc_value],i1
+	UML_CALLC(block, cfunc_load_complete, this);                                            // callc   cfunc_load_complete,this
+	UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[pc]
+	generate_dynamic_jump(block, compiler);
+
+	UML_LABEL(block, slow);                                                                 // slow:
+	UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x1);                             // store   [pc],desc->pc
+	UML_STORE(block, &m_op, 0, op, SIZE_DWORD, SCALE_x1);                                   // store   [op],op
+	UML_CALLC(block, cfunc_execute_op, this);                                               // callc   cfunc_execute_op,this
+	UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[pc]
+	generate_dynamic_jump(block, compiler);
+
+	UML_LABEL(block, done);                                                                 // done:
+}
+
+
+//-------------------------------------------------
+//  generate_store - generate code for an aligned
+//  store, leaving bus errors and anything that
+//  lets an interrupt in to C helpers
+//-------------------------------------------------
+
+void psxcpu_device::generate_store(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t const op = desc->opptr.l[0];
+	uml::code_label const slow = compiler.labelnum++;
+	uml::code_label const tail = compiler.labelnum++;
+	uml::code_label const done = compiler.labelnum++;
+
+	// the address; generated code only runs in kernel mode
+	generate_get_reg(block, uml::I0, INS_RS(op));
+	if (INS_IMMEDIATE(op) != 0)
+		UML_ADD(block, I0, I0, PSXCPU_WORD_EXTEND(INS_IMMEDIATE(op)));                      // add     i0,i0,simm
+	if (INS_OP(op) != OP_SB)
+	{
+		UML_TEST(block, I0, (INS_OP(op) == OP_SH) ? 1 : 3);                                 // test    i0,mask
+		UML_JMPc(block, COND_NZ, slow);                                                     // jnz     slow
+	}
+
+	UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x1);                             // store   [pc],desc->pc
+	generate_get_reg(block, uml::I1, INS_RT(op));
+	if (INS_OP(op) == OP_SW)
+		UML_WRITE(block, I0, I1, SIZE_DWORD, SPACE_PROGRAM);                                // write   i0,i1,dword,program
+	else
+	{
+		// bytes and halfwords are written as masked words, like writeword_masked
+		UML_AND(block, I2, I0, (INS_OP(op) == OP_SB) ? 3 : 2);                              // and     i2,i0,3/2
+		UML_SHL(block, I2, I2, 3);                                                          // shl     i2,i2,3
+		UML_SHL(block, I1, I1, I2);                                                         // shl     i1,i1,i2
+		UML_SHL(block, I3, (INS_OP(op) == OP_SB) ? 0xff : 0xffff, I2);                      // shl     i3,mask,i2
+		UML_WRITEM(block, I0, I1, I3, SIZE_DWORD, SPACE_PROGRAM);                           // writem  i0,i1,i3,dword,program
+	}
+
+	// a bus error, or an interrupt taken by a handler, is finished off by the interpreter
+	UML_LOAD(block, I2, &m_berr, 0, SIZE_DWORD, SCALE_x1);                                  // load    i2,[berr]
+	UML_CMP(block, I2, 0);                                                                  // cmp     i2,0
+	UML_JMPc(block, COND_NE, tail);                                                         // jne     tail
+	UML_LOAD(block, I2, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i2,[pc]
+	UML_CMP(block, I2, desc->pc);                                                           // cmp     i2,desc->pc
+	UML_JMPc(block, COND_NE, tail);                                                         // jne     tail
+
+	generate_commit(block, compiler, 0);
+	UML_JMP(block, done);                                                                   // jmp     done
+
+	UML_LABEL(block, tail);                                                                 // tail:
+	UML_STORE(block, &m_op, 0, op, SIZE_DWORD, SCALE_x1);                                   // store   [op],op
+	UML_CALLC(block, cfunc_store_complete, this);                                           // callc   cfunc_store_complete,this
+	UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[pc]
+	generate_dynamic_jump(block, compiler);
+
+	UML_LABEL(block, slow);                                                                 // slow:
+	UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x1);                             // store   [pc],desc->pc
+	UML_STORE(block, &m_op, 0, op, SIZE_DWORD, SCALE_x1);                                   // store   [op],op
+	UML_CALLC(block, cfunc_execute_op, this);                                               // callc   cfunc_execute_op,this
+	UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[pc]
+	generate_dynamic_jump(block, compiler);
+
+	UML_LABEL(block, done);                                                                 // done:
+}
+
+
+//-------------------------------------------------
+//  generate_generic - generate code to run an
+//  instruction through the interpreter
+//-------------------------------------------------
+
+void psxcpu_device::generate_generic(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x1);                             // store   [pc],desc->pc
+	UML_STORE(block, &m_op, 0, desc->opptr.l[0], SIZE_DWORD, SCALE_x1);                     // store   [op],op
+	UML_CALLC(block, cfunc_execute_op, this);                                               // callc   cfunc_execute_op,this
+
+	// it may have branched, left a load pending or taken an exception
+	compiler.delayr = DELAYR_UNKNOWN;
+	generate_leave(block, compiler, desc);
+}
+
+
+//-------------------------------------------------
+//  generate_get_reg - generate code to read a
+//  general purpose register
+//-------------------------------------------------
+
+void psxcpu_device::generate_get_reg(drcuml_block &block, uml::parameter dst, int reg)
+{
+	if (reg == 0)
+		UML_MOV(block, dst, 0);                                                             // mov     dst,0
+	else
+		UML_LOAD(block, dst, &m_r[reg], 0, SIZE_DWORD, SCALE_x1);                           // load    dst,[r]
+}
+
+
+//-------------------------------------------------
+//  generate_opcode - generate code for a specific
+//  opcode; returns false to have it run by the
+//  interpreter
+//-------------------------------------------------
+
+bool psxcpu_device::generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t const op = desc->opptr.l[0];
+	int const rs = INS_RS(op);
+	int const rt = INS_RT(op);
+	int dst;
+
+	if (desc->flags & OPFLAG_IS_BRANCH)
+	{
+		generate_branch(block, compiler, desc);
+		return true;
+	}
+
+	// work out the result in I0, like the interpreter's load()
+	switch (INS_OP(op))
+	{
+	case OP_SPECIAL:
+		dst = INS_RD(op);
+		switch (INS_FUNCT(op))
+		{
+		case FUNCT_SLL:
+		case FUNCT_SRL:
+		case FUNCT_SRA:
+			generate_get_reg(block, uml::I0, rt);
+			if (INS_FUNCT(op) == FUNCT_SLL)
+				UML_SHL(block, I0, I0, INS_SHAMT(op));                                      // shl     i0,i0,shamt
+			else if (INS_FUNCT(op) == FUNCT_SRL)
+				UML_SHR(block, I0, I0, INS_SHAMT(op));                                      // shr     i0,i0,shamt
+			else
+				UML_SAR(block, I0, I0, INS_SHAMT(op));                                      // sar     i0,i0,shamt
+			break;
+
+		case FUNCT_SLLV:
+		case FUNCT_SRLV:
+		case FUNCT_SRAV:
+			generate_get_reg(block, uml::I0, rt);
+			generate_get_reg(block, uml::I1, rs);
+			UML_AND(block, I1, I1, 31);                                                     // and     i1,i1,31
+			if (INS_FUNCT(op) == FUNCT_SLLV)
+				UML_SHL(block, I0, I0, I1);                                                 // shl     i0,i0,i1
+			else if (INS_FUNCT(op) == FUNCT_SRLV)
+				UML_SHR(block, I0, I0, I1);                                                 // shr     i0,i0,i1
+			else
+				UML_SAR(block, I0, I0, I1);                                                 // sar     i0,i0,i1
+			break;
+
+		case FUNCT_ADDU:
+		case FUNCT_SUBU:
+		case FUNCT_AND:
+		case FUNCT_OR:
+		case FUNCT_XOR:
+		case FUNCT_NOR:
+		case FUNCT_SLT:
+		case FUNCT_SLTU:
+			generate_get_reg(block, uml::I0, rs);
+			generate_get_reg(block, uml::I1, rt);
+			switch (INS_FUNCT(op))
+			{
+			case FUNCT_ADDU:
+				UML_ADD(block, I0, I0, I1);                                                 // add     i0,i0,i1
+				break;
+
+			case FUNCT_SUBU:
+				UML_SUB(block, I0, I0, I1);                                                 // sub     i0,i0,i1
+				break;
+
+			case FUNCT_AND:
+				UML_AND(block, I0, I0, I1);                                                 // and     i0,i0,i1
+				break;
+
+			case FUNCT_OR:
+				UML_OR(block, I0, I0, I1);                                                  // or      i0,i0,i1
+				break;
+
+			case FUNCT_XOR:
+				UML_XOR(block, I0, I0, I1);                                                 // xor     i0,i0,i1
+				break;
+
+			case FUNCT_NOR:
+				UML_OR(block, I0, I0, I1);                                                  // or      i0,i0,i1
+				UML_XOR(block, I0, I0, ~uint32_t(0));                                       // xor     i0,i0,~0
+				break;
+
+			case FUNCT_SLT:
+				UML_CMP(block, I0, I1);                                                     // cmp     i0,i1
+				UML_SETc(block, COND_L, I0);                                                // set     i0,l
+				break;
+
+			case FUNCT_SLTU:
+				UML_CMP(block, I0, I1);                                                     // cmp     i0,i1
+				UML_SETc(block, COND_B, I0);                                                // set     i0,b
+				break;
+			}
+			break;
+
+		default:
+			return false;
+		}
+		break;
+
+	case OP_ADDIU:
+	case OP_SLTI:
+	case OP_SLTIU:
+	case OP_ANDI:
+	case OP_ORI:
+	case OP_XORI:
+		dst = rt;
+		generate_get_reg(block, uml::I0, rs);
+		switch (INS_OP(op))
+		{
+		case OP_ADDIU:
+			UML_ADD(block, I0, I0, PSXCPU_WORD_EXTEND(INS_IMMEDIATE(op)));                  // add     i0,i0,simm
+			break;
+
+		case OP_SLTI:
+			UML_CMP(block, I0, PSXCPU_WORD_EXTEND(INS_IMMEDIATE(op)));                      // cmp     i0,simm
+			UML_SETc(block, COND_L, I0);                                                    // set     i0,l
+			break;
+
+		case OP_SLTIU:
+			UML_CMP(block, I0, PSXCPU_WORD_EXTEND(INS_IMMEDIATE(op)));                      // cmp     i0,simm
+			UML_SETc(block, COND_B, I0);                                                    // set     i0,b
+			break;
+
+		case OP_ANDI:
+			UML_AND(block, I0, I0, INS_IMMEDIATE(op));                                      // and     i0,i0,imm
+			break;
+
+		case OP_ORI:
+			UML_OR(block, I0, I0, INS_IMMEDIATE(op));                                       // or      i0,i0,imm
+			break;
+
+		case OP_XORI:
+			UML_XOR(block, I0, I0, INS_IMMEDIATE(op));                                      // xor     i0,i0,imm
+			break;
+		}
+		break;
+
+	case OP_LUI:
+		dst = rt;
+		UML_MOV(block, I0, INS_IMMEDIATE(op) << 16);                                        // mov     i0,imm << 16
+		break;
+
+	case OP_LB:
+	case OP_LBU:
+	case OP_LH:
+	case OP_LHU:
+	case OP_LW:
+		generate_load(block, compiler, desc);
+		return true;
+
+	case OP_SB:
+	case OP_SH:
+	case OP_SW:
+		generate_store(block, compiler, desc);
+		return true;
+
+	default:
+		return false;
+	}
+
+	generate_commit(block, compiler, 0);
+	if (dst != 0)
+		UML_STORE(block, &m_r[dst], 0, I0, SIZE_DWORD, SCALE_x1);                           // store   [rd],i0
+	return true;
+}
@@ -0,0 +1,113 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    psxfe.cpp
+
+    Front-end for PlayStation CPU recompiler
+
+***************************************************************************/
+
+#include "emu.h"
+#include "psxfe.h"
+
+#include "psxdefs.h"
+
+
+psxcpu_frontend::psxcpu_frontend(psxcpu_device &psx, uint32_t window_start, uint32_t window_end, uint32_t max_sequence)
+	: drc_frontend(psx, window_start, window_end, max_sequence)
+	, m_psx(psx)
+{
+}
+
+
+//-------------------------------------------------
+//  describe_branch - fill in the details of a
+//  branch or jump and its delay slot
+//-------------------------------------------------
+
+void psxcpu_frontend::describe_branch(opcode_desc &desc, uint32_t targetpc, bool conditional)
+{
+	// a branch in the delay slot of another one is left to the interpreter
+	if (desc.flags & OPFLAG_IN_DELAY_SLOT)
+		return;
+
+	desc.targetpc = targetpc;
+	if (conditional)
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+	else
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+	desc.delayslots = desc.skipslots = 1;
+}
+
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool psxcpu_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	desc.length = 4;
+	desc.cycles = 1;
+
+	// only code in RAM or ROM is compiled, fetches from anywhere else are
+	// left to the interpreter; reading it directly has no side effects
+	bool ram;
+	uint32_t const *const opptr = m_psx.drc_code_pointer(desc.physpc, ram);
+	if (opptr == nullptr)
+		return false;
+
+	uint32_t const op = desc.opptr.l[0] = *opptr;
+	if (ram)
+		desc.userflags |= USERFLAG_CODE_IN_RAM;
+
+	uint32_t const nextpc = desc.pc + 4;
+	uint32_t const branchpc = nextpc + (PSXCPU_WORD_EXTEND(INS_IMMEDIATE(op)) << 2);
+
+	switch (INS_OP(op))
+	{
+	case OP_SPECIAL:
+		switch (INS_FUNCT(op))
+		{
+		case FUNCT_JR:
+		case FUNCT_JALR:
+			describe_branch(desc, BRANCH_TARGET_DYNAMIC, false);
+			break;
+
+		case FUNCT_SYSCALL:
+		case FUNCT_BREAK:
+			desc.flags |= OPFLAG_WILL_CAUSE_EXCEPTION | OPFLAG_END_SEQUENCE;
+			break;
+		}
+		break;
+
+	case OP_REGIMM:
+		// every form branches, on bit 16 of the rt field
+		describe_branch(desc, branchpc, true);
+		break;
+
+	case OP_J:
+	case OP_JAL:
+		describe_branch(desc, (nextpc & 0xf0000000) + (INS_TARGET(op) << 2), false);
+		break;
+
+	case OP_BEQ:
+	case OP_BLEZ:
+		// both are always taken when rs and rt are the same register
+		describe_branch(desc, branchpc, INS_RS(op) != INS_RT(op));
+		break;
+
+	case OP_BNE:
+	case OP_BGTZ:
+		describe_branch(desc, branchpc, true);
+		break;
+
+	case OP_COP0:
+		// anything written to SR or DCIC can take away what the generated code relies on
+		desc.flags |= OPFLAG_CAN_CHANGE_MODES | OPFLAG_END_SEQUENCE;
+		break;
+	}
+
+	return true;
+}
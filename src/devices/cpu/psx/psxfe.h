@@ -0,0 +1,38 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    psxfe.h
+
+    Front-end for PlayStation CPU recompiler
+
+***************************************************************************/
+
+#ifndef MAME_CPU_PSX_PSXFE_H
+#define MAME_CPU_PSX_PSXFE_H
+
+#pragma once
+
+#include "psx.h"
+#include "cpu/drcfe.h"
+
+
+class psxcpu_frontend : public drc_frontend
+{
+public:
+	// opcode_desc userflags
+	static constexpr uint32_t USERFLAG_CODE_IN_RAM = 0x00000001;   // opcode can be overwritten, so is checked before it's run
+
+	psxcpu_frontend(psxcpu_device &psx, uint32_t window_start, uint32_t window_end, uint32_t max_sequence);
+
+protected:
+	// required overrides
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	void describe_branch(opcode_desc &desc, uint32_t targetpc, bool conditional);
+
+	psxcpu_device &m_psx;
+};
+
+#endif // MAME_CPU_PSX_PSXFE_H
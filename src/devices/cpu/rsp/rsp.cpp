@@ -13,6 +13,7 @@
 #include "rspdiv.h"
 
 #include "rsp_dasm.h"
+#include "rspfe.h"
 
 DEFINE_DEVICE_TYPE(RSP, rsp_device, "rsp", "Nintendo & SGI Reality Signal Processor RSP")
 
@@ -33,12 +34,12 @@ DEFINE_DEVICE_TYPE(RSP, rsp_device, "rsp", "Nintendo & SGI Reality Signal Proces
 #define UIMM16      ((uint16_t)(op))
 #define UIMM26      (op & 0x03ffffff)
 
-#define JUMP_ABS(addr)          { m_nextpc = (addr) << 2; }
-#define JUMP_ABS_L(addr,l)      { m_nextpc = (addr) << 2; m_r[l] = m_pc + 4; }
-#define JUMP_REL(offset)        { m_nextpc = m_pc + ((offset) << 2); }
-#define JUMP_REL_L(offset,l)    { m_nextpc = m_pc + ((offset) << 2); m_r[l] = m_pc + 4; }
-#define JUMP_PC(addr)           { m_nextpc = addr; }
-#define JUMP_PC_L(addr,l)       { m_nextpc = addr; m_r[l] = m_pc + 4; }
+#define JUMP_ABS(addr)          { m_rsp_state->nextpc = (addr) << 2; }
+#define JUMP_ABS_L(addr,l)      { m_rsp_state->nextpc = (addr) << 2; m_rsp_state->r[l] = m_rsp_state->pc + 4; }
+#define JUMP_REL(offset)        { m_rsp_state->nextpc = m_rsp_state->pc + ((offset) << 2); }
+#define JUMP_REL_L(offset,l)    { m_rsp_state->nextpc = m_rsp_state->pc + ((offset) << 2); m_rsp_state->r[l] = m_rsp_state->pc + 4; }
+#define JUMP_PC(addr)           { m_rsp_state->nextpc = addr; }
+#define JUMP_PC_L(addr,l)       { m_rsp_state->nextpc = addr; m_rsp_state->r[l] = m_rsp_state->pc + 4; }
 
 #define ROPCODE(pc)             m_icache.read_dword(pc & 0xfff)
 
@@ -113,11 +114,11 @@ rsp_device::rsp_device(const machine_config &mconfig, const char *tag, device_t
 	: cpu_device(mconfig, RSP, tag, owner, clock)
 	, m_imem_config("imem", ENDIANNESS_BIG, 32, 12)
 	, m_dmem_config("dmem", ENDIANNESS_BIG, 32, 12)
+	, m_drc_cache(CACHE_SIZE + sizeof(internal_rsp_state))
+	, m_rsp_state(nullptr)
 	, m_exec_output(nullptr)
-	, m_sr(0)
 	, m_step_count(0)
 	, m_ppc(0)
-	, m_nextpc(0xffff)
 	, m_debugger_temp(0)
 	, m_pc_temp(0)
 	, m_ppc_temp(0)
@@ -127,6 +128,19 @@ rsp_device::rsp_device(const machine_config &mconfig, const char *tag, device_t
 	, m_sp_reg_r_func(*this)
 	, m_sp_reg_w_func(*this)
 	, m_sp_set_status_func(*this)
+	, m_drcuml(nullptr)
+	, m_drcfe(nullptr)
+	, m_drcoptions(0)
+	, m_isdrc(false)
+	, m_entry(nullptr)
+	, m_nocode(nullptr)
+	, m_out_of_cycles(nullptr)
+	, m_read8(nullptr)
+	, m_write8(nullptr)
+	, m_read16(nullptr)
+	, m_write16(nullptr)
+	, m_read32(nullptr)
+	, m_write32(nullptr)
 {
 }
 
@@ -263,6 +277,10 @@ void rsp_device::resolve_cb()
 
 void rsp_device::device_start()
 {
+	/* allocate the core state from the full cache */
+	m_rsp_state = (internal_rsp_state *)m_drc_cache.alloc_near(sizeof(internal_rsp_state));
+	memset(m_rsp_state, 0, sizeof(internal_rsp_state));
+
 	if (LOG_INSTRUCTION_EXECUTION)
 		m_exec_output = fopen("rsp_execute.txt", "wt");
 
@@ -273,7 +291,7 @@ void rsp_device::device_start()
 	resolve_cb();
 
 	for (int regIdx = 0; regIdx < 32; regIdx++)
-		m_r[regIdx] = 0;
+		m_rsp_state->r[regIdx] = 0;
 
 	for(auto & elem : m_v)
 	{
@@ -299,46 +317,74 @@ void rsp_device::device_start()
 		elem.q = 0;
 	}
 
-	m_pc = 0;
-	m_nextpc = 0xffff;
-	m_sr = RSP_STATUS_HALT;
+	m_rsp_state->pc = 0;
+	m_rsp_state->nextpc = 0xffff;
+	m_rsp_state->sr = RSP_STATUS_HALT;
 	m_step_count = 0;
 
-	state_add( RSP_PC,      "PC", m_pc).callimport().callexport().formatstr("%08X");
-	state_add( RSP_R0,      "R0", m_r[0]).formatstr("%08X");
-	state_add( RSP_R1,      "R1", m_r[1]).formatstr("%08X");
-	state_add( RSP_R2,      "R2", m_r[2]).formatstr("%08X");
-	state_add( RSP_R3,      "R3", m_r[3]).formatstr("%08X");
-	state_add( RSP_R4,      "R4", m_r[4]).formatstr("%08X");
-	state_add( RSP_R5,      "R5", m_r[5]).formatstr("%08X");
-	state_add( RSP_R6,      "R6", m_r[6]).formatstr("%08X");
-	state_add( RSP_R7,      "R7", m_r[7]).formatstr("%08X");
-	state_add( RSP_R8,      "R8", m_r[8]).formatstr("%08X");
-	state_add( RSP_R9,      "R9", m_r[9]).formatstr("%08X");
-	state_add( RSP_R10,     "R10", m_r[10]).formatstr("%08X");
-	state_add( RSP_R11,     "R11", m_r[11]).formatstr("%08X");
-	state_add( RSP_R12,     "R12", m_r[12]).formatstr("%08X");
-	state_add( RSP_R13,     "R13", m_r[13]).formatstr("%08X");
-	state_add( RSP_R14,     "R14", m_r[14]).formatstr("%08X");
-	state_add( RSP_R15,     "R15", m_r[15]).formatstr("%08X");
-	state_add( RSP_R16,     "R16", m_r[16]).formatstr("%08X");
-	state_add( RSP_R17,     "R17", m_r[17]).formatstr("%08X");
-	state_add( RSP_R18,     "R18", m_r[18]).formatstr("%08X");
-	state_add( RSP_R19,     "R19", m_r[19]).formatstr("%08X");
-	state_add( RSP_R20,     "R20", m_r[20]).formatstr("%08X");
-	state_add( RSP_R21,     "R21", m_r[21]).formatstr("%08X");
-	state_add( RSP_R22,     "R22", m_r[22]).formatstr("%08X");
-	state_add( RSP_R23,     "R23", m_r[23]).formatstr("%08X");
-	state_add( RSP_R24,     "R24", m_r[24]).formatstr("%08X");
-	state_add( RSP_R25,     "R25", m_r[25]).formatstr("%08X");
-	state_add( RSP_R26,     "R26", m_r[26]).formatstr("%08X");
-	state_add( RSP_R27,     "R27", m_r[27]).formatstr("%08X");
-	state_add( RSP_R28,     "R28", m_r[28]).formatstr("%08X");
-	state_add( RSP_R29,     "R29", m_r[29]).formatstr("%08X");
-	state_add( RSP_R30,     "R30", m_r[30]).formatstr("%08X");
-	state_add( RSP_R31,     "R31", m_r[31]).formatstr("%08X");
-	state_add( RSP_SR,      "SR",  m_sr).formatstr("%08X");
-	state_add( RSP_NEXTPC,  "NPC", m_nextpc).callimport().callexport().formatstr("%04X");
+	/* initialize the UML generator */
+	uint32_t drc_flags = 0;
+	m_drcuml = std::make_unique<drcuml_state>(*this, m_drc_cache, drc_flags, 1, 12, 2);
+
+	/* add symbols for our stuff */
+	m_drcuml->symbol_add(&m_rsp_state->pc, sizeof(m_rsp_state->pc), "pc");
+	m_drcuml->symbol_add(&m_rsp_state->icount, sizeof(m_rsp_state->icount), "icount");
+	for (int regnum = 0; regnum < 32; regnum++)
+	{
+		char buf[10];
+		sprintf(buf, "r%d", regnum);
+		m_drcuml->symbol_add(&m_rsp_state->r[regnum], sizeof(m_rsp_state->r[regnum]), buf);
+	}
+	m_drcuml->symbol_add(&m_rsp_state->sr, sizeof(m_rsp_state->sr), "sr");
+	m_drcuml->symbol_add(&m_rsp_state->arg0, sizeof(m_rsp_state->arg0), "arg0");
+	m_drcuml->symbol_add(&m_rsp_state->jmpdest, sizeof(m_rsp_state->jmpdest), "jmpdest");
+
+	/* initialize the front-end helper */
+	m_drcfe = std::make_unique<rsp_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
+
+	/* compute the register parameters */
+	m_regmap[0] = uml::parameter(0);
+	for (int regnum = 1; regnum < 32; regnum++)
+		m_regmap[regnum] = uml::mem(&m_rsp_state->r[regnum]);
+
+	/* mark the cache dirty so it is updated on next execute */
+	m_rsp_state->cache_dirty = true;
+
+	state_add( RSP_PC,      "PC", m_rsp_state->pc).callimport().callexport().formatstr("%08X");
+	state_add( RSP_R0,      "R0", m_rsp_state->r[0]).formatstr("%08X");
+	state_add( RSP_R1,      "R1", m_rsp_state->r[1]).formatstr("%08X");
+	state_add( RSP_R2,      "R2", m_rsp_state->r[2]).formatstr("%08X");
+	state_add( RSP_R3,      "R3", m_rsp_state->r[3]).formatstr("%08X");
+	state_add( RSP_R4,      "R4", m_rsp_state->r[4]).formatstr("%08X");
+	state_add( RSP_R5,      "R5", m_rsp_state->r[5]).formatstr("%08X");
+	state_add( RSP_R6,      "R6", m_rsp_state->r[6]).formatstr("%08X");
+	state_add( RSP_R7,      "R7", m_rsp_state->r[7]).formatstr("%08X");
+	state_add( RSP_R8,      "R8", m_rsp_state->r[8]).formatstr("%08X");
+	state_add( RSP_R9,      "R9", m_rsp_state->r[9]).formatstr("%08X");
+	state_add( RSP_R10,     "R10", m_rsp_state->r[10]).formatstr("%08X");
+	state_add( RSP_R11,     "R11", m_rsp_state->r[11]).formatstr("%08X");
+	state_add( RSP_R12,     "R12", m_rsp_state->r[12]).formatstr("%08X");
+	state_add( RSP_R13,     "R13", m_rsp_state->r[13]).formatstr("%08X");
+	state_add( RSP_R14,     "R14", m_rsp_state->r[14]).formatstr("%08X");
+	state_add( RSP_R15,     "R15", m_rsp_state->r[15]).formatstr("%08X");
+	state_add( RSP_R16,     "R16", m_rsp_state->r[16]).formatstr("%08X");
+	state_add( RSP_R17,     "R17", m_rsp_state->r[17]).formatstr("%08X");
+	state_add( RSP_R18,     "R18", m_rsp_state->r[18]).formatstr("%08X");
+	state_add( RSP_R19,     "R19", m_rsp_state->r[19]).formatstr("%08X");
+	state_add( RSP_R20,     "R20", m_rsp_state->r[20]).formatstr("%08X");
+	state_add( RSP_R21,     "R21", m_rsp_state->r[21]).formatstr("%08X");
+	state_add( RSP_R22,     "R22", m_rsp_state->r[22]).formatstr("%08X");
+	state_add( RSP_R23,     "R23", m_rsp_state->r[23]).formatstr("%08X");
+	state_add( RSP_R24,     "R24", m_rsp_state->r[24]).formatstr("%08X");
+	state_add( RSP_R25,     "R25", m_rsp_state->r[25]).formatstr("%08X");
+	state_add( RSP_R26,     "R26", m_rsp_state->r[26]).formatstr("%08X");
+	state_add( RSP_R27,     "R27", m_rsp_state->r[27]).formatstr("%08X");
+	state_add( RSP_R28,     "R28", m_rsp_state->r[28]).formatstr("%08X");
+	state_add( RSP_R29,     "R29", m_rsp_state->r[29]).formatstr("%08X");
+	state_add( RSP_R30,     "R30", m_rsp_state->r[30]).formatstr("%08X");
+	state_add( RSP_R31,     "R31", m_rsp_state->r[31]).formatstr("%08X");
+	state_add( RSP_SR,      "SR",  m_rsp_state->sr).formatstr("%08X");
+	state_add( RSP_NEXTPC,  "NPC", m_rsp_state->nextpc).callimport().callexport().formatstr("%04X");
 	state_add( RSP_STEPCNT, "STEP",  m_step_count).formatstr("%08X");
 
 	state_add( RSP_V0,      "V0",  m_debugger_temp).formatstr("%39s");
@@ -374,11 +420,15 @@ void rsp_device::device_start()
 	state_add( RSP_V30,     "V30", m_debugger_temp).formatstr("%39s");
 	state_add( RSP_V31,     "V31", m_debugger_temp).formatstr("%39s");
 
-	state_add( STATE_GENPC, "GENPC", m_pc).noshow();
-	state_add( STATE_GENPCBASE, "CURPC", m_pc).noshow();
-	state_add( STATE_GENFLAGS, "GENFLAGS", m_r[31]).formatstr("%1s").noshow();
+	state_add( STATE_GENPC, "GENPC", m_rsp_state->pc).noshow();
+	state_add( STATE_GENPCBASE, "CURPC", m_rsp_state->pc).noshow();
+	state_add( STATE_GENFLAGS, "GENFLAGS", m_rsp_state->r[31]).formatstr("%1s").noshow();
+
+	set_icountptr(m_rsp_state->icount);
 
-	set_icountptr(m_icount);
+	// IMEM is restored along with the rest of the machine, so anything
+	// compiled from its old contents has to go
+	machine().save().register_postload(save_prepost_delegate(FUNC(rsp_device::rspdrc_flush_drc_cache), this));
 }
 
 void rsp_device::state_import(const device_state_entry &entry)
@@ -387,7 +437,7 @@ void rsp_device::state_import(const device_state_entry &entry)
 	{
 		case STATE_GENPC:
 		case RSP_PC:
-			m_pc = (uint16_t)m_pc_temp;
+			m_rsp_state->pc = (uint16_t)m_pc_temp;
 			break;
 
 		case STATE_GENPCBASE:
@@ -395,7 +445,7 @@ void rsp_device::state_import(const device_state_entry &entry)
 			break;
 
 		case RSP_NEXTPC:
-			m_nextpc = (uint16_t)m_nextpc_temp;
+			m_rsp_state->nextpc = (uint16_t)m_nextpc_temp;
 			break;
 	}
 }
@@ -407,7 +457,7 @@ void rsp_device::state_export(const device_state_entry &entry)
 	{
 		case STATE_GENPC:
 		case RSP_PC:
-			m_pc_temp = m_pc;
+			m_pc_temp = m_rsp_state->pc;
 			break;
 
 		case STATE_GENPCBASE:
@@ -415,7 +465,7 @@ void rsp_device::state_export(const device_state_entry &entry)
 			break;
 
 		case RSP_NEXTPC:
-			m_nextpc_temp = m_nextpc;
+			m_nextpc_temp = m_rsp_state->nextpc;
 			break;
 	}
 }
@@ -529,11 +579,15 @@ void rsp_device::device_stop()
 	if (m_exec_output)
 		fclose(m_exec_output);
 	m_exec_output = nullptr;
+
+	/* clean up the DRC */
+	m_drcfe = nullptr;
+	m_drcuml = nullptr;
 }
 
 void rsp_device::device_reset()
 {
-	m_nextpc = 0xffff;
+	m_rsp_state->nextpc = 0xffff;
 }
 
 uint16_t rsp_device::SATURATE_ACCUM(int accum, int slice, uint16_t negative, uint16_t positive)
@@ -2157,7 +2211,7 @@ void rsp_device::handle_cop2(uint32_t op)
 			int el = (op >> 7) & 0xf;
 			uint16_t b1 = VREG_B(RDREG, (el+0) & 0xf);
 			uint16_t b2 = VREG_B(RDREG, (el+1) & 0xf);
-			if (RTREG) m_r[RTREG] = (int32_t)(int16_t)((b1 << 8) | (b2));
+			if (RTREG) m_rsp_state->r[RTREG] = (int32_t)(int16_t)((b1 << 8) | (b2));
 			break;
 		}
 
@@ -2173,16 +2227,16 @@ void rsp_device::handle_cop2(uint32_t op)
 				switch (RDREG)
 				{
 					case 0:
-						m_r[RTREG] = (m_vzero << 8) | m_vcarry;
-						if (m_r[RTREG] & 0x8000) m_r[RTREG] |= 0xffff0000;
+						m_rsp_state->r[RTREG] = (m_vzero << 8) | m_vcarry;
+						if (m_rsp_state->r[RTREG] & 0x8000) m_rsp_state->r[RTREG] |= 0xffff0000;
 						break;
 					case 1:
-						m_r[RTREG] = (m_vclip2 << 8) | m_vcompare;
-						if (m_r[RTREG] & 0x8000) m_r[RTREG] |= 0xffff0000;
+						m_rsp_state->r[RTREG] = (m_vclip2 << 8) | m_vcompare;
+						if (m_rsp_state->r[RTREG] & 0x8000) m_rsp_state->r[RTREG] |= 0xffff0000;
 						break;
 					case 2:
 						// Anciliary clipping flags
-						m_r[RTREG] = m_vclip1;
+						m_rsp_state->r[RTREG] = m_vclip1;
 						break;
 				}
 			}
@@ -2197,8 +2251,8 @@ void rsp_device::handle_cop2(uint32_t op)
 			// ---------------------------------------------------
 
 			int el = (op >> 7) & 0xf;
-			W_VREG_B(RDREG, (el+0) & 0xf, (m_r[RTREG] >> 8) & 0xff);
-			W_VREG_B(RDREG, (el+1) & 0xf, (m_r[RTREG] >> 0) & 0xff);
+			W_VREG_B(RDREG, (el+0) & 0xf, (m_rsp_state->r[RTREG] >> 8) & 0xff);
+			W_VREG_B(RDREG, (el+1) & 0xf, (m_rsp_state->r[RTREG] >> 0) & 0xff);
 			break;
 		}
 
@@ -2212,17 +2266,17 @@ void rsp_device::handle_cop2(uint32_t op)
 			switch (RDREG)
 			{
 				case 0:
-					m_vcarry = (uint8_t)m_r[RTREG];
-					m_vzero = (uint8_t)(m_r[RTREG] >> 8);
+					m_vcarry = (uint8_t)m_rsp_state->r[RTREG];
+					m_vzero = (uint8_t)(m_rsp_state->r[RTREG] >> 8);
 					break;
 
 				case 1:
-					m_vcompare = (uint8_t)m_r[RTREG];
-					m_vclip2 = (uint8_t)(m_r[RTREG] >> 8);
+					m_vcompare = (uint8_t)m_rsp_state->r[RTREG];
+					m_vclip2 = (uint8_t)(m_rsp_state->r[RTREG] >> 8);
 					break;
 
 				case 2:
-					m_vclip1 = (uint8_t)m_r[RTREG];
+					m_vclip1 = (uint8_t)m_rsp_state->r[RTREG];
 					break;
 			}
 			break;
@@ -2258,7 +2312,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Load 1 byte to vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + offset : offset;
+			uint32_t ea = (base) ? m_rsp_state->r[base] + offset : offset;
 			VREG_B(dest, index) = read_dmem_byte(ea);
 			break;
 		}
@@ -2272,7 +2326,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads 2 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 2) : (offset * 2);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 2) : (offset * 2);
 
 			for (int i = index; i < index + 2; i++)
 			{
@@ -2291,7 +2345,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads 4 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 4) : (offset * 4);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 4) : (offset * 4);
 
 			for (int i = index; i < index + 4; i++)
 			{
@@ -2310,7 +2364,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads 8 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 8) : (offset * 8);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 8) : (offset * 8);
 
 			for (int i = index; i < index + 8; i++)
 			{
@@ -2329,7 +2383,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads up to 16 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 16) : (offset * 16);
 
 			int end = index + (16 - (ea & 0xf));
 			if (end > 16) end = 16;
@@ -2351,7 +2405,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Stores up to 16 bytes starting from right side until 16-byte boundary
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 16) : (offset * 16);
 
 			index = 16 - ((ea & 0xf) - index);
 			ea &= ~0xf;
@@ -2373,7 +2427,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads a byte as the upper 8 bits of each element
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 8) : (offset * 8);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 8) : (offset * 8);
 
 			for (int i = 0; i < 8; i++)
 			{
@@ -2391,7 +2445,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads a byte as the bits 14-7 of each element
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 8) : (offset * 8);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 8) : (offset * 8);
 
 			for (int i = 0; i < 8; i++)
 			{
@@ -2409,7 +2463,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads a byte as the bits 14-7 of each element, with 2-byte stride
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 16) : (offset * 16);
 
 			for (int i = 0; i < 8; i++)
 			{
@@ -2427,7 +2481,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			//
 			// Loads a byte as the bits 14-7 of upper or lower quad, with 4-byte stride
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 16) : (offset * 16);
 
 			// NOTE: Not sure what happens if 16-byte boundary is crossed
 
@@ -2458,7 +2512,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 			// Hardware testing has proven that the vector index is ignored when executing LWV.
 			// By contrast, SWV will function as intended when provided an index.
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 16) : (offset * 16);
 
 			for (int i = 0; i < 16; i++)
 			{
@@ -2486,7 +2540,7 @@ void rsp_device::handle_lwc2(uint32_t op)
 
 			if (index & 1)  fatalerror("RSP: LTV: index = %d\n", index);
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 16) : (offset * 16);
 			ea = ((ea + 8) & ~0xf) + (index & 1);
 
 			for (int32_t i = vs; i < ve; i++)
@@ -2532,7 +2586,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores 1 byte from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + offset : offset;
+			uint32_t ea = (base) ? m_rsp_state->r[base] + offset : offset;
 			write_dmem_byte(ea, VREG_B(dest, index));
 			break;
 		}
@@ -2546,7 +2600,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores 2 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 2) : (offset * 2);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 2) : (offset * 2);
 
 			for (int i = index; i < index + 2; i++)
 			{
@@ -2565,7 +2619,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores 4 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 4) : (offset * 4);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 4) : (offset * 4);
 
 			for (int i = index; i < index + 4; i++)
 			{
@@ -2584,7 +2638,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores 8 bytes starting from vector byte index
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 8) : (offset * 8);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 8) : (offset * 8);
 
 			for (int i = index; i < index + 8; i++)
 			{
@@ -2603,7 +2657,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores up to 16 bytes starting from vector byte index until 16-byte boundary
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 16) : (offset * 16);
 			int end = index + (16 - (ea & 0xf));
 
 			for (int i = index; i < end; i++)
@@ -2623,7 +2677,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores up to 16 bytes starting from right side until 16-byte boundary
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 16) : (offset * 16);
 
 			int end = index + (ea & 0xf);
 			int o = (16 - (ea & 0xf)) & 0xf;
@@ -2646,7 +2700,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores upper 8 bits of each element
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 8) : (offset * 8);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 8) : (offset * 8);
 
 			for (int i = index; i < index + 8; i++)
 			{
@@ -2672,7 +2726,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores bits 14-7 of each element
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 8) : (offset * 8);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 8) : (offset * 8);
 
 			for (int i = index; i < index + 8; i++)
 			{
@@ -2698,7 +2752,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			//
 			// Stores bits 14-7 of each element, with 2-byte stride
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 16) : (offset * 16);
 
 			for (int i = 0; i < 8; i++)
 			{
@@ -2722,7 +2776,7 @@ void rsp_device::handle_swc2(uint32_t op)
 
 			// FIXME: only works for index 0 and index 8
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 16) : (offset * 16);
 
 			int eaoffset = ea & 0xf;
 			ea &= ~0xf;
@@ -2747,7 +2801,7 @@ void rsp_device::handle_swc2(uint32_t op)
 			// Stores the full 128-bit vector starting from vector byte index and wrapping to index 0
 			// after byte index 15
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 16) : (offset * 16);
 
 			int eaoffset = ea & 0xf;
 			ea &= ~0xf;
@@ -2776,7 +2830,7 @@ void rsp_device::handle_swc2(uint32_t op)
 
 			int32_t element = 8 - (index >> 1);
 
-			uint32_t ea = (base) ? m_r[base] + (offset * 16) : (offset * 16);
+			uint32_t ea = (base) ? m_rsp_state->r[base] + (offset * 16) : (offset * 16);
 
 			int32_t eaoffset = (ea & 0xf) + (element * 2);
 			ea &= ~0xf;
@@ -2850,29 +2904,39 @@ void rsp_device::update_vector_op_deduction()
 
 void rsp_device::execute_run()
 {
-	if (m_sr & (RSP_STATUS_HALT | RSP_STATUS_BROKE))
+	if (m_rsp_state->sr & (RSP_STATUS_HALT | RSP_STATUS_BROKE))
 	{
 		m_ideduct = 0;
 		m_scalar_busy = false;
 		m_vector_busy = false;
 		m_paired_busy = false;
-		m_icount = std::min(m_icount, 0);
+		m_rsp_state->icount = std::min(m_rsp_state->icount, 0);
 	}
 
-	while (m_icount > 0)
+	// single-stepping and resuming part-way through a delay slot are left
+	// to the interpreter; compiled code always stops on a clean boundary
+	if (m_isdrc && !(m_rsp_state->sr & RSP_STATUS_SSTEP) && (m_rsp_state->nextpc == 0xffff))
+		execute_run_drc();
+	else
+		execute_interpreter();
+}
+
+void rsp_device::execute_interpreter()
+{
+	while (m_rsp_state->icount > 0)
 	{
-		m_ppc = m_pc;
-		debugger_instruction_hook(m_pc);
+		m_ppc = m_rsp_state->pc;
+		debugger_instruction_hook(m_rsp_state->pc);
 
-		uint32_t op = ROPCODE(m_pc);
-		if (m_nextpc != 0xffff)
+		uint32_t op = ROPCODE(m_rsp_state->pc);
+		if (m_rsp_state->nextpc != 0xffff)
 		{
-			m_pc = m_nextpc;
-			m_nextpc = 0xffff;
+			m_rsp_state->pc = m_rsp_state->nextpc;
+			m_rsp_state->nextpc = 0xffff;
 		}
 		else
 		{
-			m_pc += 4;
+			m_rsp_state->pc += 4;
 		}
 
 		switch (op >> 26)
@@ -2882,14 +2946,14 @@ void rsp_device::execute_run()
 				update_scalar_op_deduction();
 				switch (op & 0x3f)
 				{
-					case 0x00:  /* SLL */       if (RDREG) m_r[RDREG] = m_r[RTREG] << SHIFT; break;
-					case 0x02:  /* SRL */       if (RDREG) m_r[RDREG] = m_r[RTREG] >> SHIFT; break;
-					case 0x03:  /* SRA */       if (RDREG) m_r[RDREG] = (int32_t)m_r[RTREG] >> SHIFT; break;
-					case 0x04:  /* SLLV */      if (RDREG) m_r[RDREG] = m_r[RTREG] << (m_r[RSREG] & 0x1f); break;
-					case 0x06:  /* SRLV */      if (RDREG) m_r[RDREG] = m_r[RTREG] >> (m_r[RSREG] & 0x1f); break;
-					case 0x07:  /* SRAV */      if (RDREG) m_r[RDREG] = (int32_t)m_r[RTREG] >> (m_r[RSREG] & 0x1f); break;
-					case 0x08:  /* JR */        JUMP_PC(m_r[RSREG]); break;
-					case 0x09:  /* JALR */      JUMP_PC_L(m_r[RSREG], RDREG); break;
+					case 0x00:  /* SLL */       if (RDREG) m_rsp_state->r[RDREG] = m_rsp_state->r[RTREG] << SHIFT; break;
+					case 0x02:  /* SRL */       if (RDREG) m_rsp_state->r[RDREG] = m_rsp_state->r[RTREG] >> SHIFT; break;
+					case 0x03:  /* SRA */       if (RDREG) m_rsp_state->r[RDREG] = (int32_t)m_rsp_state->r[RTREG] >> SHIFT; break;
+					case 0x04:  /* SLLV */      if (RDREG) m_rsp_state->r[RDREG] = m_rsp_state->r[RTREG] << (m_rsp_state->r[RSREG] & 0x1f); break;
+					case 0x06:  /* SRLV */      if (RDREG) m_rsp_state->r[RDREG] = m_rsp_state->r[RTREG] >> (m_rsp_state->r[RSREG] & 0x1f); break;
+					case 0x07:  /* SRAV */      if (RDREG) m_rsp_state->r[RDREG] = (int32_t)m_rsp_state->r[RTREG] >> (m_rsp_state->r[RSREG] & 0x1f); break;
+					case 0x08:  /* JR */        JUMP_PC(m_rsp_state->r[RSREG]); break;
+					case 0x09:  /* JALR */      JUMP_PC_L(m_rsp_state->r[RSREG], RDREG); break;
 					case 0x0d:  /* BREAK */
 					{
 						m_ideduct = 1;
@@ -2897,19 +2961,19 @@ void rsp_device::execute_run()
 						m_vector_busy = false;
 						m_paired_busy = false;
 						m_sp_set_status_func(0, 0x3, 0xffffffff);
-						m_icount = std::min(m_icount, 1);
+						m_rsp_state->icount = std::min(m_rsp_state->icount, 1);
 						break;
 					}
-					case 0x20:  /* ADD */       if (RDREG) m_r[RDREG] = (int32_t)(m_r[RSREG] + m_r[RTREG]); break;
-					case 0x21:  /* ADDU */      if (RDREG) m_r[RDREG] = (int32_t)(m_r[RSREG] + m_r[RTREG]); break;
-					case 0x22:  /* SUB */       if (RDREG) m_r[RDREG] = (int32_t)(m_r[RSREG] - m_r[RTREG]); break;
-					case 0x23:  /* SUBU */      if (RDREG) m_r[RDREG] = (int32_t)(m_r[RSREG] - m_r[RTREG]); break;
-					case 0x24:  /* AND */       if (RDREG) m_r[RDREG] = m_r[RSREG] & m_r[RTREG]; break;
-					case 0x25:  /* OR */        if (RDREG) m_r[RDREG] = m_r[RSREG] | m_r[RTREG]; break;
-					case 0x26:  /* XOR */       if (RDREG) m_r[RDREG] = m_r[RSREG] ^ m_r[RTREG]; break;
-					case 0x27:  /* NOR */       if (RDREG) m_r[RDREG] = ~(m_r[RSREG] | m_r[RTREG]); break;
-					case 0x2a:  /* SLT */       if (RDREG) m_r[RDREG] = (int32_t)m_r[RSREG] < (int32_t)m_r[RTREG]; break;
-					case 0x2b:  /* SLTU */      if (RDREG) m_r[RDREG] = m_r[RSREG] < m_r[RTREG]; break;
+					case 0x20:  /* ADD */       if (RDREG) m_rsp_state->r[RDREG] = (int32_t)(m_rsp_state->r[RSREG] + m_rsp_state->r[RTREG]); break;
+					case 0x21:  /* ADDU */      if (RDREG) m_rsp_state->r[RDREG] = (int32_t)(m_rsp_state->r[RSREG] + m_rsp_state->r[RTREG]); break;
+					case 0x22:  /* SUB */       if (RDREG) m_rsp_state->r[RDREG] = (int32_t)(m_rsp_state->r[RSREG] - m_rsp_state->r[RTREG]); break;
+					case 0x23:  /* SUBU */      if (RDREG) m_rsp_state->r[RDREG] = (int32_t)(m_rsp_state->r[RSREG] - m_rsp_state->r[RTREG]); break;
+					case 0x24:  /* AND */       if (RDREG) m_rsp_state->r[RDREG] = m_rsp_state->r[RSREG] & m_rsp_state->r[RTREG]; break;
+					case 0x25:  /* OR */        if (RDREG) m_rsp_state->r[RDREG] = m_rsp_state->r[RSREG] | m_rsp_state->r[RTREG]; break;
+					case 0x26:  /* XOR */       if (RDREG) m_rsp_state->r[RDREG] = m_rsp_state->r[RSREG] ^ m_rsp_state->r[RTREG]; break;
+					case 0x27:  /* NOR */       if (RDREG) m_rsp_state->r[RDREG] = ~(m_rsp_state->r[RSREG] | m_rsp_state->r[RTREG]); break;
+					case 0x2a:  /* SLT */       if (RDREG) m_rsp_state->r[RDREG] = (int32_t)m_rsp_state->r[RSREG] < (int32_t)m_rsp_state->r[RTREG]; break;
+					case 0x2b:  /* SLTU */      if (RDREG) m_rsp_state->r[RDREG] = m_rsp_state->r[RSREG] < m_rsp_state->r[RTREG]; break;
 					default:    unimplemented_opcode(op); break;
 				}
 				break;
@@ -2920,10 +2984,10 @@ void rsp_device::execute_run()
 				update_scalar_op_deduction();
 				switch (RTREG)
 				{
-					case 0x00:  /* BLTZ */      if ((int32_t)m_r[RSREG] < 0) JUMP_REL(SIMM16); break;
-					case 0x01:  /* BGEZ */      if ((int32_t)m_r[RSREG] >= 0) JUMP_REL(SIMM16); break;
-					case 0x10:  /* BLTZAL */    if ((int32_t)m_r[RSREG] < 0) JUMP_REL_L(SIMM16, 31); break;
-					case 0x11:  /* BGEZAL */    if ((int32_t)m_r[RSREG] >= 0) JUMP_REL_L(SIMM16, 31); break;
+					case 0x00:  /* BLTZ */      if ((int32_t)m_rsp_state->r[RSREG] < 0) JUMP_REL(SIMM16); break;
+					case 0x01:  /* BGEZ */      if ((int32_t)m_rsp_state->r[RSREG] >= 0) JUMP_REL(SIMM16); break;
+					case 0x10:  /* BLTZAL */    if ((int32_t)m_rsp_state->r[RSREG] < 0) JUMP_REL_L(SIMM16, 31); break;
+					case 0x11:  /* BGEZAL */    if ((int32_t)m_rsp_state->r[RSREG] >= 0) JUMP_REL_L(SIMM16, 31); break;
 					default:    unimplemented_opcode(op); break;
 				}
 				break;
@@ -2931,26 +2995,26 @@ void rsp_device::execute_run()
 
 			case 0x02:  /* J */         update_scalar_op_deduction(); JUMP_ABS(UIMM26); break;
 			case 0x03:  /* JAL */       update_scalar_op_deduction(); JUMP_ABS_L(UIMM26, 31); break;
-			case 0x04:  /* BEQ */       update_scalar_op_deduction(); if (m_r[RSREG] == m_r[RTREG]) JUMP_REL(SIMM16); break;
-			case 0x05:  /* BNE */       update_scalar_op_deduction(); if (m_r[RSREG] != m_r[RTREG]) JUMP_REL(SIMM16); break;
-			case 0x06:  /* BLEZ */      update_scalar_op_deduction(); if ((int32_t)m_r[RSREG] <= 0) JUMP_REL(SIMM16); break;
-			case 0x07:  /* BGTZ */      update_scalar_op_deduction(); if ((int32_t)m_r[RSREG] > 0) JUMP_REL(SIMM16); break;
-			case 0x08:  /* ADDI */      update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = (int32_t)m_r[RSREG] + SIMM16; break;
-			case 0x09:  /* ADDIU */     update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = (int32_t)m_r[RSREG] + SIMM16; break;
-			case 0x0a:  /* SLTI */      update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = (int32_t)m_r[RSREG] < (int32_t)SIMM16; break;
-			case 0x0b:  /* SLTIU */     update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = m_r[RSREG] < UIMM16; break;
-			case 0x0c:  /* ANDI */      update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = m_r[RSREG] & UIMM16; break;
-			case 0x0d:  /* ORI */       update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = m_r[RSREG] | UIMM16; break;
-			case 0x0e:  /* XORI */      update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = m_r[RSREG] ^ UIMM16; break;
-			case 0x0f:  /* LUI */       update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = UIMM16 << 16; break;
+			case 0x04:  /* BEQ */       update_scalar_op_deduction(); if (m_rsp_state->r[RSREG] == m_rsp_state->r[RTREG]) JUMP_REL(SIMM16); break;
+			case 0x05:  /* BNE */       update_scalar_op_deduction(); if (m_rsp_state->r[RSREG] != m_rsp_state->r[RTREG]) JUMP_REL(SIMM16); break;
+			case 0x06:  /* BLEZ */      update_scalar_op_deduction(); if ((int32_t)m_rsp_state->r[RSREG] <= 0) JUMP_REL(SIMM16); break;
+			case 0x07:  /* BGTZ */      update_scalar_op_deduction(); if ((int32_t)m_rsp_state->r[RSREG] > 0) JUMP_REL(SIMM16); break;
+			case 0x08:  /* ADDI */      update_scalar_op_deduction(); if (RTREG) m_rsp_state->r[RTREG] = (int32_t)m_rsp_state->r[RSREG] + SIMM16; break;
+			case 0x09:  /* ADDIU */     update_scalar_op_deduction(); if (RTREG) m_rsp_state->r[RTREG] = (int32_t)m_rsp_state->r[RSREG] + SIMM16; break;
+			case 0x0a:  /* SLTI */      update_scalar_op_deduction(); if (RTREG) m_rsp_state->r[RTREG] = (int32_t)m_rsp_state->r[RSREG] < (int32_t)SIMM16; break;
+			case 0x0b:  /* SLTIU */     update_scalar_op_deduction(); if (RTREG) m_rsp_state->r[RTREG] = m_rsp_state->r[RSREG] < UIMM16; break;
+			case 0x0c:  /* ANDI */      update_scalar_op_deduction(); if (RTREG) m_rsp_state->r[RTREG] = m_rsp_state->r[RSREG] & UIMM16; break;
+			case 0x0d:  /* ORI */       update_scalar_op_deduction(); if (RTREG) m_rsp_state->r[RTREG] = m_rsp_state->r[RSREG] | UIMM16; break;
+			case 0x0e:  /* XORI */      update_scalar_op_deduction(); if (RTREG) m_rsp_state->r[RTREG] = m_rsp_state->r[RSREG] ^ UIMM16; break;
+			case 0x0f:  /* LUI */       update_scalar_op_deduction(); if (RTREG) m_rsp_state->r[RTREG] = UIMM16 << 16; break;
 
 			case 0x10:  /* COP0 */
 			{
 				update_scalar_op_deduction();
 				switch ((op >> 21) & 0x1f)
 				{
-					case 0x00:  /* MFC0 */      if (RTREG) m_r[RTREG] = get_cop0_reg(RDREG); break;
-					case 0x04:  /* MTC0 */      set_cop0_reg(RDREG, m_r[RTREG]); break;
+					case 0x00:  /* MFC0 */      if (RTREG) m_rsp_state->r[RTREG] = get_cop0_reg(RDREG); break;
+					case 0x04:  /* MTC0 */      set_cop0_reg(RDREG, m_rsp_state->r[RTREG]); break;
 					default:    unimplemented_opcode(op); break;
 				}
 				break;
@@ -2963,14 +3027,14 @@ void rsp_device::execute_run()
 				break;
 			}
 
-			case 0x20:  /* LB */        update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = (int32_t)(int8_t)read_dmem_byte(m_r[RSREG] + SIMM16); break;
-			case 0x21:  /* LH */        update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = (int32_t)(int16_t)read_dmem_word(m_r[RSREG] + SIMM16); break;
-			case 0x23:  /* LW */        update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = read_dmem_dword(m_r[RSREG] + SIMM16); break;
-			case 0x24:  /* LBU */       update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = read_dmem_byte(m_r[RSREG] + SIMM16); break;
-			case 0x25:  /* LHU */       update_scalar_op_deduction(); if (RTREG) m_r[RTREG] = read_dmem_word(m_r[RSREG] + SIMM16); break;
-			case 0x28:  /* SB */        update_scalar_op_deduction(); write_dmem_byte(m_r[RSREG] + SIMM16, m_r[RTREG]); break;
-			case 0x29:  /* SH */        update_scalar_op_deduction(); write_dmem_word(m_r[RSREG] + SIMM16, m_r[RTREG]); break;
-			case 0x2b:  /* SW */        update_scalar_op_deduction(); write_dmem_dword(m_r[RSREG] + SIMM16, m_r[RTREG]); break;
+			case 0x20:  /* LB */        update_scalar_op_deduction(); if (RTREG) m_rsp_state->r[RTREG] = (int32_t)(int8_t)read_dmem_byte(m_rsp_state->r[RSREG] + SIMM16); break;
+			case 0x21:  /* LH */        update_scalar_op_deduction(); if (RTREG) m_rsp_state->r[RTREG] = (int32_t)(int16_t)read_dmem_word(m_rsp_state->r[RSREG] + SIMM16); break;
+			case 0x23:  /* LW */        update_scalar_op_deduction(); if (RTREG) m_rsp_state->r[RTREG] = read_dmem_dword(m_rsp_state->r[RSREG] + SIMM16); break;
+			case 0x24:  /* LBU */       update_scalar_op_deduction(); if (RTREG) m_rsp_state->r[RTREG] = read_dmem_byte(m_rsp_state->r[RSREG] + SIMM16); break;
+			case 0x25:  /* LHU */       update_scalar_op_deduction(); if (RTREG) m_rsp_state->r[RTREG] = read_dmem_word(m_rsp_state->r[RSREG] + SIMM16); break;
+			case 0x28:  /* SB */        update_scalar_op_deduction(); write_dmem_byte(m_rsp_state->r[RSREG] + SIMM16, m_rsp_state->r[RTREG]); break;
+			case 0x29:  /* SH */        update_scalar_op_deduction(); write_dmem_word(m_rsp_state->r[RSREG] + SIMM16, m_rsp_state->r[RTREG]); break;
+			case 0x2b:  /* SW */        update_scalar_op_deduction(); write_dmem_dword(m_rsp_state->r[RSREG] + SIMM16, m_rsp_state->r[RTREG]); break;
 			case 0x32:  /* LWC2 */      update_scalar_op_deduction(); handle_lwc2(op); break;
 			case 0x3a:  /* SWC2 */      update_scalar_op_deduction(); handle_swc2(op); break;
 
@@ -3005,11 +3069,11 @@ void rsp_device::execute_run()
 
 			for (int i = 0; i < 32; i++)
 			{
-				if (m_r[i] != prev_regs[i])
+				if (m_rsp_state->r[i] != prev_regs[i])
 				{
-					fprintf(m_exec_output, "R%d: %08X ", i, m_r[i]);
+					fprintf(m_exec_output, "R%d: %08X ", i, m_rsp_state->r[i]);
 				}
-				prev_regs[i] = m_r[i];
+				prev_regs[i] = m_rsp_state->r[i];
 			}
 
 			for (int i = 0; i < 32; i++)
@@ -3027,10 +3091,10 @@ void rsp_device::execute_run()
 
 		}
 
-		//m_icount -= m_ideduct;
-		--m_icount;
+		//m_rsp_state->icount -= m_ideduct;
+		--m_rsp_state->icount;
 
-		if (m_sr & RSP_STATUS_SSTEP)
+		if (m_rsp_state->sr & RSP_STATUS_SSTEP)
 		{
 			if (m_step_count)
 			{
@@ -3038,17 +3102,17 @@ void rsp_device::execute_run()
 			}
 			else
 			{
-				m_sr |= RSP_STATUS_BROKE;
+				m_rsp_state->sr |= RSP_STATUS_BROKE;
 			}
 		}
 
-		if (m_sr & (RSP_STATUS_HALT | RSP_STATUS_BROKE))
+		if (m_rsp_state->sr & (RSP_STATUS_HALT | RSP_STATUS_BROKE))
 		{
 			m_ideduct = 0;
 			m_scalar_busy = false;
 			m_vector_busy = false;
 			m_paired_busy = false;
-			m_icount = std::min(m_icount, 0);
+			m_rsp_state->icount = std::min(m_rsp_state->icount, 0);
 		}
 	}
 }
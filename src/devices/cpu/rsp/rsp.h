@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+
 /***************************************************************************
     REGISTER ENUMERATION
 ***************************************************************************/
@@ -78,8 +81,21 @@ enum
 #define RSP_STATUS_SIGNAL6       0x2000
 #define RSP_STATUS_SIGNAL7       0x4000
 
+/***************************************************************************
+    COMPILER-SPECIFIC OPTIONS
+***************************************************************************/
+
+#define RSPDRC_STRICT_VERIFY    0x0001          /* verify all instructions */
+
+#define RSPDRC_COMPATIBLE_OPTIONS   (RSPDRC_STRICT_VERIFY)
+#define RSPDRC_FASTEST_OPTIONS      (0)
+
+class rsp_frontend;
+
 class rsp_device : public cpu_device
 {
+	friend class rsp_frontend;
+
 	class cop2;
 
 public:
@@ -94,6 +110,20 @@ public:
 	auto sp_reg_w() { return m_sp_reg_w_func.bind(); }
 	auto status_set() { return m_sp_set_status_func.bind(); }
 
+	// use the recompiler rather than the interpreter
+	void enable_recompiler();
+	void rspdrc_set_options(uint32_t options);
+	void rspdrc_flush_drc_cache();
+
+	// C function callbacks for the recompiler
+	void ccfunc_get_cop0_reg();
+	void ccfunc_set_cop0_reg();
+	void ccfunc_break();
+	void ccfunc_cop2();
+	void ccfunc_lwc2();
+	void ccfunc_swc2();
+	void ccfunc_unimplemented();
+
 protected:
 	// device-level overrides
 	virtual void device_start() override;
@@ -124,9 +154,23 @@ private:
 	address_space_config m_imem_config;
 	address_space_config m_dmem_config;
 
-	uint16_t m_pc;
-	uint32_t m_r[35];
-	int m_icount;
+	/* core state, allocated near the DRC cache so generated code can reach it */
+	struct internal_rsp_state
+	{
+		uint32_t pc;
+		uint32_t nextpc;
+		uint32_t r[35];
+		uint32_t sr;
+		int icount;
+
+		uint32_t arg0;
+		uint32_t jmpdest;
+		uint32_t cache_dirty;       /* set when IMEM changes; the code cache is flushed before the next block runs */
+	};
+
+	drc_cache m_drc_cache;
+	internal_rsp_state *m_rsp_state;
+
 	int m_ideduct;
 	bool m_scalar_busy;
 	bool m_vector_busy;
@@ -137,11 +181,9 @@ private:
 
 	FILE *m_exec_output;
 
-	uint32_t m_sr;
 	uint32_t m_step_count;
 
-	uint16_t m_ppc;
-	uint16_t m_nextpc;
+	uint32_t m_ppc;
 
 protected:
 	memory_access<12, 2, 0, ENDIANNESS_BIG>::cache m_icache;
@@ -210,6 +252,57 @@ private:
 
 	uint32_t          m_div_in;
 	uint32_t          m_div_out;
+
+	/* core execution */
+	void execute_interpreter();
+
+	/* internal compiler state */
+	struct compiler_state
+	{
+		compiler_state &operator=(compiler_state &) = delete;
+
+		uint32_t         cycles;                     /* accumulated cycles */
+		uint8_t          checkhalt;                  /* need to check for a halt at the next update */
+		uml::code_label  labelnum;                   /* index for local labels */
+	};
+
+	/* DRC state */
+	std::unique_ptr<drcuml_state>   m_drcuml;       /* DRC UML generator state */
+	std::unique_ptr<rsp_frontend>   m_drcfe;        /* pointer to the DRC front-end state */
+	uint32_t        m_drcoptions;                   /* configurable DRC options */
+	bool            m_isdrc;
+
+	uml::parameter  m_regmap[32];                   /* parameter to register mappings for all 32 integer registers */
+
+	uml::code_handle *  m_entry;                    /* entry point */
+	uml::code_handle *  m_nocode;                   /* nocode exception handler */
+	uml::code_handle *  m_out_of_cycles;            /* out of cycles exception handler */
+	uml::code_handle *  m_read8;                    /* read byte */
+	uml::code_handle *  m_write8;                   /* write byte */
+	uml::code_handle *  m_read16;                   /* read half */
+	uml::code_handle *  m_write16;                  /* write half */
+	uml::code_handle *  m_read32;                   /* read word */
+	uml::code_handle *  m_write32;                  /* write word */
+
+	void execute_run_drc();
+	void code_flush_cache();
+	void code_compile_block(offs_t pc);
+
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void static_generate_memory_accessor(int size, bool iswrite, const char *name, uml::code_handle *&handleptr);
+
+	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param, bool allow_exception);
+	void generate_checksum_block(drcuml_block &block, compiler_state &compiler, const opcode_desc *seqhead, const opcode_desc *seqlast);
+	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_delay_slot_and_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint8_t linkreg);
+	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_special(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_regimm(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_cop0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+
+	void log_add_disasm_comment(drcuml_block &block, uint32_t pc, uint32_t op);
 };
 
 DECLARE_DEVICE_TYPE(RSP, rsp_device)
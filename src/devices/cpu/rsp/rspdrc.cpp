@@ -0,0 +1,1132 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles, Ryan Holtz
+/***************************************************************************
+
+    rspdrc.cpp
+
+    Universal machine language-based Nintendo/SGI RSP emulator.
+
+****************************************************************************
+
+    The scalar unit is compiled directly; COP0 accesses and the whole of
+    the vector unit (COP2, LWC2 and SWC2) call back into the interpreter's
+    handlers, which keeps the two paths bit-for-bit identical.
+
+    Future improvements/changes:
+
+    * Lower the simpler vector ops (VAND/VOR/VXOR/VMRG and friends) to the
+      UML vector opcodes; this needs the accumulator kept as 16-bit lanes
+      rather than the current 64-bit-per-element layout
+
+    * Keep frequently used scalar registers in UML integer registers
+
+***************************************************************************/
+
+#include "emu.h"
+#include "rsp.h"
+#include "rspfe.h"
+#include "rspdefs.h"
+#include "rsp_dasm.h"
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+#include "cpu/drcumlsh.h"
+
+using namespace uml;
+
+
+/***************************************************************************
+    MACROS
+***************************************************************************/
+
+#define R32(reg)                m_regmap[reg]
+
+/* map variables */
+#define MAPVAR_PC               M0
+#define MAPVAR_CYCLES           M1
+
+/* exit codes */
+#define EXECUTE_OUT_OF_CYCLES   0
+#define EXECUTE_MISSING_CODE    1
+#define EXECUTE_UNMAPPED_CODE   2
+#define EXECUTE_RESET_CACHE     3
+
+
+
+/***************************************************************************
+    RECOMPILER CORE
+***************************************************************************/
+
+/*-------------------------------------------------
+    execute_run_drc - execute the RSP using the
+    recompiler
+-------------------------------------------------*/
+
+void rsp_device::execute_run_drc()
+{
+	int execute_result;
+
+	/* reset the cache if dirty */
+	if (m_rsp_state->cache_dirty)
+		code_flush_cache();
+	m_rsp_state->cache_dirty = false;
+
+	/* execute */
+	do
+	{
+		/* run as much as we can */
+		execute_result = m_drcuml->execute(*m_entry);
+
+		/* if we need to recompile, do it */
+		if (execute_result == EXECUTE_MISSING_CODE)
+		{
+			code_compile_block(m_rsp_state->pc);
+		}
+		else if (execute_result == EXECUTE_UNMAPPED_CODE)
+		{
+			fatalerror("Attempted to execute unmapped code at PC=%08X\n", m_rsp_state->pc);
+		}
+		else if (execute_result == EXECUTE_RESET_CACHE)
+		{
+			code_flush_cache();
+			m_rsp_state->cache_dirty = false;
+		}
+	} while (execute_result != EXECUTE_OUT_OF_CYCLES);
+}
+
+
+/*-------------------------------------------------
+    enable_recompiler - use the recompiler rather
+    than the interpreter, if allowed; it hasn't
+    been checked against the interpreter much, so
+    drivers have to ask for it
+-------------------------------------------------*/
+
+void rsp_device::enable_recompiler()
+{
+	m_isdrc = allow_drc();
+
+	// IMEM writes aren't tracked while interpreting
+	if (m_rsp_state)
+		m_rsp_state->cache_dirty = true;
+}
+
+
+/*-------------------------------------------------
+    rspdrc_set_options - configure DRC options
+-------------------------------------------------*/
+
+void rsp_device::rspdrc_set_options(uint32_t options)
+{
+	if (!allow_drc()) return;
+	m_drcoptions = options;
+}
+
+
+/*-------------------------------------------------
+    rspdrc_flush_drc_cache - outward-facing
+    accessor to flush the code cache; call this
+    whenever IMEM is written behind the RSP's back
+-------------------------------------------------*/
+
+void rsp_device::rspdrc_flush_drc_cache()
+{
+	if (!m_isdrc)
+		return;
+	m_rsp_state->cache_dirty = true;
+}
+
+
+
+/***************************************************************************
+    C FUNCTION CALLBACKS
+***************************************************************************/
+
+/*-------------------------------------------------
+    cfunc_* - C helpers called from generated
+    code; the opcode is passed in arg0
+-------------------------------------------------*/
+
+void rsp_device::ccfunc_get_cop0_reg()
+{
+	uint32_t const op = m_rsp_state->arg0;
+	m_rsp_state->r[RTREG] = get_cop0_reg(RDREG);
+}
+
+static void cfunc_get_cop0_reg(void *param)
+{
+	((rsp_device *)param)->ccfunc_get_cop0_reg();
+}
+
+void rsp_device::ccfunc_set_cop0_reg()
+{
+	uint32_t const op = m_rsp_state->arg0;
+	set_cop0_reg(RDREG, m_rsp_state->r[RTREG]);
+}
+
+static void cfunc_set_cop0_reg(void *param)
+{
+	((rsp_device *)param)->ccfunc_set_cop0_reg();
+}
+
+void rsp_device::ccfunc_break()
+{
+	m_ideduct = 1;
+	m_scalar_busy = false;
+	m_vector_busy = false;
+	m_paired_busy = false;
+	m_sp_set_status_func(0, 0x3, 0xffffffff);
+}
+
+static void cfunc_break(void *param)
+{
+	((rsp_device *)param)->ccfunc_break();
+}
+
+void rsp_device::ccfunc_cop2()
+{
+	update_vector_op_deduction();
+	handle_cop2(m_rsp_state->arg0);
+}
+
+static void cfunc_cop2(void *param)
+{
+	((rsp_device *)param)->ccfunc_cop2();
+}
+
+void rsp_device::ccfunc_lwc2()
+{
+	handle_lwc2(m_rsp_state->arg0);
+}
+
+static void cfunc_lwc2(void *param)
+{
+	((rsp_device *)param)->ccfunc_lwc2();
+}
+
+void rsp_device::ccfunc_swc2()
+{
+	handle_swc2(m_rsp_state->arg0);
+}
+
+static void cfunc_swc2(void *param)
+{
+	((rsp_device *)param)->ccfunc_swc2();
+}
+
+void rsp_device::ccfunc_unimplemented()
+{
+	m_ppc = m_rsp_state->pc;
+	unimplemented_opcode(m_rsp_state->arg0);
+}
+
+static void cfunc_unimplemented(void *param)
+{
+	((rsp_device *)param)->ccfunc_unimplemented();
+}
+
+
+
+/***************************************************************************
+    CACHE MANAGEMENT
+***************************************************************************/
+
+/*-------------------------------------------------
+    code_flush_cache - flush the cache and
+    regenerate static code
+-------------------------------------------------*/
+
+void rsp_device::code_flush_cache()
+{
+	/* empty the transient cache contents */
+	m_drcuml->reset();
+
+	try
+	{
+		/* generate the entry point and out-of-cycles handlers */
+		static_generate_entry_point();
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+
+		/* add subroutines for memory accesses */
+		static_generate_memory_accessor(1, false, "read8",   m_read8);
+		static_generate_memory_accessor(1, true,  "write8",  m_write8);
+		static_generate_memory_accessor(2, false, "read16",  m_read16);
+		static_generate_memory_accessor(2, true,  "write16", m_write16);
+		static_generate_memory_accessor(4, false, "read32",  m_read32);
+		static_generate_memory_accessor(4, true,  "write32", m_write32);
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Unable to generate static RSP code\n");
+	}
+}
+
+
+/*-------------------------------------------------
+    code_compile_block - compile a block of the
+    given mode at the specified pc
+-------------------------------------------------*/
+
+void rsp_device::code_compile_block(offs_t pc)
+{
+	compiler_state compiler = { 0 };
+	const opcode_desc *seqhead, *seqlast;
+	const opcode_desc *desclist;
+	bool override = false;
+
+	g_profiler.start(PROFILER_DRC_COMPILE);
+
+	/* get a description of this sequence */
+	desclist = m_drcfe->describe_code(pc);
+
+	/* if we get an error back, flush the cache and try again */
+	bool succeeded = false;
+	while (!succeeded)
+	{
+		try
+		{
+			/* start the block */
+			drcuml_block &block(m_drcuml->begin_block(4096));
+
+			/* loop until we get through all instruction sequences */
+			for (seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				const opcode_desc *curdesc;
+				uint32_t nextpc;
+
+				/* add a code log entry */
+				if (m_drcuml->logging())
+					block.append_comment("-------------------------");                     // comment
+
+				/* determine the last instruction in this sequence */
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
+				if (override || !m_drcuml->hash_exists(0, seqhead->pc))
+				{
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,pc
+				}
+				/* if we already have a hash, and this is the first sequence, assume that we */
+				/* are recompiling due to being out of sync and allow future overrides */
+				else if (seqhead == desclist)
+				{
+					override = true;
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,pc
+				}
+
+				/* otherwise, redispatch to that fixed PC and skip the rest of the processing */
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+					UML_HASHJMP(block, 0, seqhead->pc, *m_nocode);                          // hashjmp 0,seqhead->pc,nocode
+					continue;
+				}
+
+				/* IMEM writes flush the cache, so only validate when asked to */
+				if (m_drcoptions & RSPDRC_STRICT_VERIFY)
+					generate_checksum_block(block, compiler, seqhead, seqlast);
+
+				/* label this instruction, if it may be jumped to locally */
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
+				}
+
+				/* iterate over instructions in the sequence and compile them */
+				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
+					generate_sequence_instruction(block, compiler, curdesc);
+				}
+
+				/* if we need to return to the start, do it */
+				if (seqlast->flags & OPFLAG_RETURN_TO_START)
+					nextpc = pc;
+
+				/* otherwise we just go to the next instruction */
+				else
+					nextpc = (seqlast->pc + (seqlast->skipslots + 1) * 4) & 0xffc;
+
+				/* count off cycles and go there */
+				generate_update_cycles(block, compiler, nextpc, true);                      // <subtract cycles>
+
+				/* if the last instruction can change modes, use a variable mode; otherwise, assume the same mode */
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+				{
+					UML_HASHJMP(block, 0, nextpc, *m_nocode);                               // hashjmp 0,nextpc,nocode
+				}
+			}
+
+			/* end the sequence */
+			block.end();
+			g_profiler.stop();
+			succeeded = true;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			code_flush_cache();
+		}
+	}
+}
+
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+/*-------------------------------------------------
+    alloc_handle - allocate a handle if not
+    already allocated
+-------------------------------------------------*/
+
+static inline void alloc_handle(drcuml_state &drcuml, uml::code_handle *&handleptr, const char *name)
+{
+	if (!handleptr)
+		handleptr = drcuml.handle_alloc(name);
+}
+
+
+/*-------------------------------------------------
+    static_generate_entry_point - generate a
+    static entry point
+-------------------------------------------------*/
+
+void rsp_device::static_generate_entry_point()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(20));
+
+	/* forward references */
+	alloc_handle(*m_drcuml, m_nocode, "nocode");
+
+	alloc_handle(*m_drcuml, m_entry, "entry");
+	UML_HANDLE(block, *m_entry);                                                    // handle  entry
+
+	/* generate a hash jump via the current PC; the interpreter doesn't wrap it */
+	UML_AND(block, mem(&m_rsp_state->pc), mem(&m_rsp_state->pc), 0xffc);            // and     [pc],[pc],0xffc
+	UML_HASHJMP(block, 0, mem(&m_rsp_state->pc), *m_nocode);                        // hashjmp 0,[pc],nocode
+
+	block.end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_nocode_handler - generate an
+    exception handler for "out of code"
+-------------------------------------------------*/
+
+void rsp_device::static_generate_nocode_handler()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(*m_drcuml, m_nocode, "nocode");
+	UML_HANDLE(block, *m_nocode);                                                   // handle  nocode
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_rsp_state->pc), I0);                                      // mov     [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                          // exit    EXECUTE_MISSING_CODE
+
+	block.end();
+}
+
+
+/*-------------------------------------------------
+    static_generate_out_of_cycles - generate an
+    out of cycles exception handler
+-------------------------------------------------*/
+
+void rsp_device::static_generate_out_of_cycles()
+{
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	/* generate a hash jump via the current mode and PC */
+	alloc_handle(*m_drcuml, m_out_of_cycles, "out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                            // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                          // getexp  i0
+	UML_MOV(block, mem(&m_rsp_state->pc), I0);                                      // mov     <pc>,i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                         // exit    EXECUTE_OUT_OF_CYCLES
+
+	block.end();
+}
+
+
+/*------------------------------------------------------------------
+    static_generate_memory_accessor - generate a DMEM accessor;
+    the RSP allows unaligned accesses, which wrap within DMEM
+------------------------------------------------------------------*/
+
+void rsp_device::static_generate_memory_accessor(int size, bool iswrite, const char *name, uml::code_handle *&handleptr)
+{
+	/* on entry, address is in I0; data for writes is in I1 */
+	/* on exit, read result is in I0 */
+	/* routine trashes I0-I3 */
+	int const unaligned = 1;
+
+	/* begin generating */
+	drcuml_block &block(m_drcuml->begin_block(64));
+
+	/* add a global entry for this */
+	alloc_handle(*m_drcuml, handleptr, name);
+	UML_HANDLE(block, *handleptr);                                                  // handle  *handleptr
+	UML_AND(block, I0, I0, 0xfff);                                                  // and     i0,i0,0xfff
+
+	if (size == 1)
+	{
+		if (iswrite)
+			UML_WRITE(block, I0, I1, SIZE_BYTE, SPACE_DATA);                        // write   i0,i1,byte
+		else
+			UML_READ(block, I0, I0, SIZE_BYTE, SPACE_DATA);                         // read    i0,i0,byte
+		UML_RET(block);                                                             // ret
+	}
+	else
+	{
+		/* aligned accesses go straight through */
+		UML_TEST(block, I0, size - 1);                                              // test    i0,size-1
+		UML_JMPc(block, COND_NZ, unaligned);                                        // jmp     unaligned,nz
+		if (iswrite)
+			UML_WRITE(block, I0, I1, (size == 2) ? SIZE_WORD : SIZE_DWORD, SPACE_DATA); // write   i0,i1,size
+		else
+			UML_READ(block, I0, I0, (size == 2) ? SIZE_WORD : SIZE_DWORD, SPACE_DATA);  // read    i0,i0,size
+		UML_RET(block);                                                             // ret
+
+		/* unaligned accesses are split into big-endian bytes */
+		UML_LABEL(block, unaligned);                                                // unaligned:
+		if (iswrite)
+		{
+			for (int byte = 0; byte < size; byte++)
+			{
+				UML_SHR(block, I2, I1, (size - 1 - byte) * 8);                      // shr     i2,i1,shift
+				UML_WRITE(block, I0, I2, SIZE_BYTE, SPACE_DATA);                    // write   i0,i2,byte
+				if (byte != size - 1)
+				{
+					UML_ADD(block, I0, I0, 1);                                      // add     i0,i0,1
+					UML_AND(block, I0, I0, 0xfff);                                  // and     i0,i0,0xfff
+				}
+			}
+		}
+		else
+		{
+			UML_MOV(block, I3, 0);                                                  // mov     i3,0
+			for (int byte = 0; byte < size; byte++)
+			{
+				UML_READ(block, I2, I0, SIZE_BYTE, SPACE_DATA);                     // read    i2,i0,byte
+				UML_SHL(block, I3, I3, 8);                                          // shl     i3,i3,8
+				UML_OR(block, I3, I3, I2);                                          // or      i3,i3,i2
+				if (byte != size - 1)
+				{
+					UML_ADD(block, I0, I0, 1);                                      // add     i0,i0,1
+					UML_AND(block, I0, I0, 0xfff);                                  // and     i0,i0,0xfff
+				}
+			}
+			UML_MOV(block, I0, I3);                                                 // mov     i0,i3
+		}
+		UML_RET(block);                                                             // ret
+	}
+
+	block.end();
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+/*-------------------------------------------------
+    generate_update_cycles - generate code to
+    subtract cycles from the icount and generate
+    an exception if out; also stops after an
+    instruction that may have halted the RSP or
+    replaced IMEM
+-------------------------------------------------*/
+
+void rsp_device::generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param, bool allow_exception)
+{
+	/* account for cycles */
+	if (compiler.cycles > 0)
+	{
+		UML_SUB(block, mem(&m_rsp_state->icount), mem(&m_rsp_state->icount), MAPVAR_CYCLES); // sub     icount,icount,cycles
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                        // mapvar  cycles,0
+		if (allow_exception)
+			UML_EXHc(block, COND_S, *m_out_of_cycles, param);
+																					// exh     out_of_cycles,nextpc
+	}
+	compiler.cycles = 0;
+
+	/* check for a halt or new code if needed */
+	if (compiler.checkhalt)
+	{
+		uml::code_label skip;
+
+		compiler.checkhalt = false;
+		UML_TEST(block, mem(&m_rsp_state->sr), RSP_STATUS_HALT | RSP_STATUS_BROKE); // test    [sr],HALT | BROKE
+		UML_JMPc(block, COND_Z, skip = compiler.labelnum++);                        // jmp     skip,Z
+		UML_CMP(block, mem(&m_rsp_state->icount), 0);                               // cmp     icount,0
+		UML_MOVc(block, COND_G, mem(&m_rsp_state->icount), 0);                      // mov     icount,0,G
+		UML_EXH(block, *m_out_of_cycles, param);                                    // exh     out_of_cycles,nextpc
+		UML_LABEL(block, skip);                                                     // skip:
+
+		UML_TEST(block, mem(&m_rsp_state->cache_dirty), 1);                         // test    [cache_dirty],1
+		UML_JMPc(block, COND_Z, skip = compiler.labelnum++);                        // jmp     skip,Z
+		UML_MOV(block, mem(&m_rsp_state->pc), param);                               // mov     [pc],nextpc
+		UML_EXIT(block, EXECUTE_RESET_CACHE);                                       // exit    EXECUTE_RESET_CACHE
+		UML_LABEL(block, skip);                                                     // skip:
+	}
+}
+
+
+/*-------------------------------------------------
+    generate_checksum_block - generate code to
+    validate a sequence of opcodes
+-------------------------------------------------*/
+
+void rsp_device::generate_checksum_block(drcuml_block &block, compiler_state &compiler, const opcode_desc *seqhead, const opcode_desc *seqlast)
+{
+	const opcode_desc *curdesc;
+	if (m_drcuml->logging())
+		block.append_comment("[Validation for %08X]", seqhead->pc);                // comment
+
+	/* sum up every opcode in the sequence, including delay slots */
+	uint32_t sum = 0;
+	UML_MOV(block, I0, 0);                                                          // mov     i0,0
+	for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+	{
+		for (const opcode_desc *desc = curdesc; desc != nullptr; desc = (desc == curdesc) ? desc->delay.first() : nullptr)
+		{
+			if (desc->flags & OPFLAG_VIRTUAL_NOOP)
+				continue;
+			void *const base = space(AS_PROGRAM).get_read_ptr(desc->physpc);
+			if (base == nullptr)
+				continue;
+			UML_LOAD(block, I1, base, 0, SIZE_DWORD, SCALE_x4);                     // load    i1,base,dword
+			UML_ADD(block, I0, I0, I1);                                             // add     i0,i0,i1
+			sum += desc->opptr.l[0];
+		}
+	}
+	UML_CMP(block, I0, sum);                                                        // cmp     i0,sum
+	UML_EXHc(block, COND_NE, *m_nocode, seqhead->pc);                               // exne    nocode,seqhead->pc
+}
+
+
+/*-------------------------------------------------
+    generate_sequence_instruction - generate code
+    for a single instruction in a sequence
+-------------------------------------------------*/
+
+void rsp_device::generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	/* add an entry for the log */
+	if (m_drcuml->logging() && !(desc->flags & OPFLAG_VIRTUAL_NOOP))
+		log_add_disasm_comment(block, desc->pc, desc->opptr.l[0]);
+
+	/* set the PC map variable */
+	UML_MAPVAR(block, MAPVAR_PC, desc->pc);                                         // mapvar  PC,desc->pc
+
+	/* accumulate total cycles */
+	compiler.cycles += desc->cycles;
+
+	/* update the icount map variable */
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                             // mapvar  CYCLES,compiler.cycles
+
+	/* if we are debugging, call the debugger */
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		UML_MOV(block, mem(&m_rsp_state->pc), desc->pc);                            // mov     [pc],desc->pc
+		UML_DEBUG(block, desc->pc);                                                 // debug   desc->pc
+	}
+
+	/* if we hit an unmapped address, fatal error */
+	if (desc->flags & OPFLAG_COMPILER_UNMAPPED)
+	{
+		UML_MOV(block, mem(&m_rsp_state->pc), desc->pc);                            // mov     [pc],desc->pc
+		UML_EXIT(block, EXECUTE_UNMAPPED_CODE);                                     // exit    EXECUTE_UNMAPPED_CODE
+	}
+
+	/* otherwise, unless this is a virtual no-op, it's a regular instruction */
+	else if (!(desc->flags & OPFLAG_VIRTUAL_NOOP))
+	{
+		/* compile the instruction, or call the interpreter's error path */
+		if (!generate_opcode(block, compiler, desc))
+		{
+			UML_MOV(block, mem(&m_rsp_state->pc), desc->pc);                        // mov     [pc],desc->pc
+			UML_MOV(block, mem(&m_rsp_state->arg0), desc->opptr.l[0]);              // mov     [arg0],desc->opptr.l
+			UML_CALLC(block, cfunc_unimplemented, this);                            // callc   cfunc_unimplemented
+		}
+	}
+}
+
+
+/*------------------------------------------------------------------
+    generate_delay_slot_and_branch
+------------------------------------------------------------------*/
+
+void rsp_device::generate_delay_slot_and_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint8_t linkreg)
+{
+	compiler_state compiler_temp(compiler);
+	uint32_t op = desc->opptr.l[0];
+
+	/* fetch the target register if dynamic, in case it is modified by the delay slot */
+	if (desc->targetpc == BRANCH_TARGET_DYNAMIC)
+	{
+		UML_AND(block, mem(&m_rsp_state->jmpdest), R32(RSREG), 0xffc);              // and     [jmpdest],<rsreg>,0xffc
+	}
+
+	/* set the link if needed -- before the delay slot */
+	if (linkreg != 0)
+	{
+		UML_MOV(block, R32(linkreg), desc->pc + 8);                                 // mov     <linkreg>,desc->pc + 8
+	}
+
+	/* compile the delay slot using temporary compiler state */
+	assert(desc->delay.first() != nullptr);
+	generate_sequence_instruction(block, compiler_temp, desc->delay.first());       // <next instruction>
+
+	/* update the cycles and jump through the hash table to the target */
+	if (desc->targetpc != BRANCH_TARGET_DYNAMIC)
+	{
+		generate_update_cycles(block, compiler_temp, desc->targetpc, true);         // <subtract cycles>
+		if (desc->flags & OPFLAG_INTRABLOCK_BRANCH)
+			UML_JMP(block, desc->targetpc | 0x80000000);                            // jmp     desc->targetpc | 0x80000000
+		else
+			UML_HASHJMP(block, 0, desc->targetpc, *m_nocode);                       // hashjmp 0,desc->targetpc,nocode
+	}
+	else
+	{
+		generate_update_cycles(block, compiler_temp, mem(&m_rsp_state->jmpdest), true); // <subtract cycles>
+		UML_HASHJMP(block, 0, mem(&m_rsp_state->jmpdest), *m_nocode);               // hashjmp 0,<rsreg>,nocode
+	}
+
+	/* update the label */
+	compiler.labelnum = compiler_temp.labelnum;
+
+	/* reset the mapvar to the current cycles and account for skipped slots */
+	compiler.cycles += desc->skipslots;
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                             // mapvar  CYCLES,compiler.cycles
+}
+
+
+/*-------------------------------------------------
+    generate_opcode - generate code for a specific
+    opcode
+-------------------------------------------------*/
+
+bool rsp_device::generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t op = desc->opptr.l[0];
+	uint8_t opswitch = op >> 26;
+	uml::code_label skip;
+
+	switch (opswitch)
+	{
+		/* ----- sub-groups ----- */
+
+		case 0x00:  /* SPECIAL */
+			return generate_special(block, compiler, desc);
+
+		case 0x01:  /* REGIMM */
+			return generate_regimm(block, compiler, desc);
+
+		case 0x10:  /* COP0 */
+			return generate_cop0(block, compiler, desc);
+
+		case 0x12:  /* COP2 */
+			UML_MOV(block, mem(&m_rsp_state->arg0), op);                            // mov     [arg0],op
+			UML_CALLC(block, cfunc_cop2, this);                                     // callc   cfunc_cop2
+			return true;
+
+		/* ----- jumps and branches ----- */
+
+		case 0x02:  /* J */
+			generate_delay_slot_and_branch(block, compiler, desc, 0);               // <next instruction + hashjmp>
+			return true;
+
+		case 0x03:  /* JAL */
+			generate_delay_slot_and_branch(block, compiler, desc, 31);              // <next instruction + hashjmp>
+			return true;
+
+		case 0x04:  /* BEQ */
+			UML_CMP(block, R32(RSREG), R32(RTREG));                                 // cmp     <rsreg>,<rtreg>
+			UML_JMPc(block, COND_NE, skip = compiler.labelnum++);                   // jmp     skip,NE
+			generate_delay_slot_and_branch(block, compiler, desc, 0);               // <next instruction + hashjmp>
+			UML_LABEL(block, skip);                                                 // skip:
+			return true;
+
+		case 0x05:  /* BNE */
+			UML_CMP(block, R32(RSREG), R32(RTREG));                                 // cmp     <rsreg>,<rtreg>
+			UML_JMPc(block, COND_E, skip = compiler.labelnum++);                    // jmp     skip,E
+			generate_delay_slot_and_branch(block, compiler, desc, 0);               // <next instruction + hashjmp>
+			UML_LABEL(block, skip);                                                 // skip:
+			return true;
+
+		case 0x06:  /* BLEZ */
+			if (RSREG != 0)
+			{
+				UML_CMP(block, R32(RSREG), 0);                                      // cmp     <rsreg>,0
+				UML_JMPc(block, COND_G, skip = compiler.labelnum++);                // jmp     skip,G
+				generate_delay_slot_and_branch(block, compiler, desc, 0);           // <next instruction + hashjmp>
+				UML_LABEL(block, skip);                                             // skip:
+			}
+			else
+				generate_delay_slot_and_branch(block, compiler, desc, 0);           // <next instruction + hashjmp>
+			return true;
+
+		case 0x07:  /* BGTZ */
+			UML_CMP(block, R32(RSREG), 0);                                          // cmp     <rsreg>,0
+			UML_JMPc(block, COND_LE, skip = compiler.labelnum++);                   // jmp     skip,LE
+			generate_delay_slot_and_branch(block, compiler, desc, 0);               // <next instruction + hashjmp>
+			UML_LABEL(block, skip);                                                 // skip:
+			return true;
+
+
+		/* ----- immediate arithmetic ----- */
+
+		case 0x0f:  /* LUI */
+			if (RTREG != 0)
+				UML_MOV(block, R32(RTREG), UIMMVAL << 16);                          // mov     <rtreg>,UIMMVAL << 16
+			return true;
+
+		case 0x08:  /* ADDI */
+		case 0x09:  /* ADDIU */
+			if (RTREG != 0)
+				UML_ADD(block, R32(RTREG), R32(RSREG), SIMMVAL);                    // add     <rtreg>,<rsreg>,SIMMVAL
+			return true;
+
+		case 0x0a:  /* SLTI */
+			if (RTREG != 0)
+			{
+				UML_CMP(block, R32(RSREG), SIMMVAL);                                // cmp     <rsreg>,SIMMVAL
+				UML_SETc(block, COND_L, R32(RTREG));                                // set     <rtreg>,l
+			}
+			return true;
+
+		case 0x0b:  /* SLTIU */
+			/* the interpreter compares against the zero-extended immediate */
+			if (RTREG != 0)
+			{
+				UML_CMP(block, R32(RSREG), UIMMVAL);                                // cmp     <rsreg>,UIMMVAL
+				UML_SETc(block, COND_B, R32(RTREG));                                // set     <rtreg>,b
+			}
+			return true;
+
+		case 0x0c:  /* ANDI */
+			if (RTREG != 0)
+				UML_AND(block, R32(RTREG), R32(RSREG), UIMMVAL);                    // and     <rtreg>,<rsreg>,UIMMVAL
+			return true;
+
+		case 0x0d:  /* ORI */
+			if (RTREG != 0)
+				UML_OR(block, R32(RTREG), R32(RSREG), UIMMVAL);                     // or      <rtreg>,<rsreg>,UIMMVAL
+			return true;
+
+		case 0x0e:  /* XORI */
+			if (RTREG != 0)
+				UML_XOR(block, R32(RTREG), R32(RSREG), UIMMVAL);                    // xor     <rtreg>,<rsreg>,UIMMVAL
+			return true;
+
+
+		/* ----- memory load operations ----- */
+
+		case 0x20:  /* LB */
+			if (RTREG != 0)
+			{
+				UML_ADD(block, I0, R32(RSREG), SIMMVAL);                            // add     i0,<rsreg>,SIMMVAL
+				UML_CALLH(block, *m_read8);                                         // callh   read8
+				UML_SEXT(block, R32(RTREG), I0, SIZE_BYTE);                         // sext    <rtreg>,i0,byte
+			}
+			return true;
+
+		case 0x21:  /* LH */
+			if (RTREG != 0)
+			{
+				UML_ADD(block, I0, R32(RSREG), SIMMVAL);                            // add     i0,<rsreg>,SIMMVAL
+				UML_CALLH(block, *m_read16);                                        // callh   read16
+				UML_SEXT(block, R32(RTREG), I0, SIZE_WORD);                         // sext    <rtreg>,i0,word
+			}
+			return true;
+
+		case 0x23:  /* LW */
+			if (RTREG != 0)
+			{
+				UML_ADD(block, I0, R32(RSREG), SIMMVAL);                            // add     i0,<rsreg>,SIMMVAL
+				UML_CALLH(block, *m_read32);                                        // callh   read32
+				UML_MOV(block, R32(RTREG), I0);                                     // mov     <rtreg>,i0
+			}
+			return true;
+
+		case 0x24:  /* LBU */
+			if (RTREG != 0)
+			{
+				UML_ADD(block, I0, R32(RSREG), SIMMVAL);                            // add     i0,<rsreg>,SIMMVAL
+				UML_CALLH(block, *m_read8);                                         // callh   read8
+				UML_AND(block, R32(RTREG), I0, 0xff);                               // and     <rtreg>,i0,0xff
+			}
+			return true;
+
+		case 0x25:  /* LHU */
+			if (RTREG != 0)
+			{
+				UML_ADD(block, I0, R32(RSREG), SIMMVAL);                            // add     i0,<rsreg>,SIMMVAL
+				UML_CALLH(block, *m_read16);                                        // callh   read16
+				UML_AND(block, R32(RTREG), I0, 0xffff);                             // and     <rtreg>,i0,0xffff
+			}
+			return true;
+
+		case 0x32:  /* LWC2 */
+			UML_MOV(block, mem(&m_rsp_state->arg0), op);                            // mov     [arg0],op
+			UML_CALLC(block, cfunc_lwc2, this);                                     // callc   cfunc_lwc2
+			return true;
+
+
+		/* ----- memory store operations ----- */
+
+		case 0x28:  /* SB */
+			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                                // add     i0,<rsreg>,SIMMVAL
+			UML_MOV(block, I1, R32(RTREG));                                         // mov     i1,<rtreg>
+			UML_CALLH(block, *m_write8);                                            // callh   write8
+			return true;
+
+		case 0x29:  /* SH */
+			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                                // add     i0,<rsreg>,SIMMVAL
+			UML_MOV(block, I1, R32(RTREG));                                         // mov     i1,<rtreg>
+			UML_CALLH(block, *m_write16);                                           // callh   write16
+			return true;
+
+		case 0x2b:  /* SW */
+			UML_ADD(block, I0, R32(RSREG), SIMMVAL);                                // add     i0,<rsreg>,SIMMVAL
+			UML_MOV(block, I1, R32(RTREG));                                         // mov     i1,<rtreg>
+			UML_CALLH(block, *m_write32);                                           // callh   write32
+			return true;
+
+		case 0x3a:  /* SWC2 */
+			UML_MOV(block, mem(&m_rsp_state->arg0), op);                            // mov     [arg0],op
+			UML_CALLC(block, cfunc_swc2, this);                                     // callc   cfunc_swc2
+			return true;
+	}
+
+	return false;
+}
+
+
+/*-------------------------------------------------
+    generate_special - compile opcodes in the
+    'SPECIAL' group
+-------------------------------------------------*/
+
+bool rsp_device::generate_special(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t op = desc->opptr.l[0];
+	uint8_t opswitch = op & 63;
+
+	switch (opswitch)
+	{
+		/* ----- shift instructions ----- */
+
+		case 0x00:  /* SLL */
+			if (RDREG != 0)
+				UML_SHL(block, R32(RDREG), R32(RTREG), SHIFT);                      // shl     <rdreg>,<rtreg>,<shift>
+			return true;
+
+		case 0x02:  /* SRL */
+			if (RDREG != 0)
+				UML_SHR(block, R32(RDREG), R32(RTREG), SHIFT);                      // shr     <rdreg>,<rtreg>,<shift>
+			return true;
+
+		case 0x03:  /* SRA */
+			if (RDREG != 0)
+				UML_SAR(block, R32(RDREG), R32(RTREG), SHIFT);                      // sar     <rdreg>,<rtreg>,<shift>
+			return true;
+
+		case 0x04:  /* SLLV */
+			if (RDREG != 0)
+				UML_SHL(block, R32(RDREG), R32(RTREG), R32(RSREG));                 // shl     <rdreg>,<rtreg>,<rsreg>
+			return true;
+
+		case 0x06:  /* SRLV */
+			if (RDREG != 0)
+				UML_SHR(block, R32(RDREG), R32(RTREG), R32(RSREG));                 // shr     <rdreg>,<rtreg>,<rsreg>
+			return true;
+
+		case 0x07:  /* SRAV */
+			if (RDREG != 0)
+				UML_SAR(block, R32(RDREG), R32(RTREG), R32(RSREG));                 // sar     <rdreg>,<rtreg>,<rsreg>
+			return true;
+
+
+		/* ----- basic arithmetic ----- */
+
+		case 0x20:  /* ADD */
+		case 0x21:  /* ADDU */
+			if (RDREG != 0)
+				UML_ADD(block, R32(RDREG), R32(RSREG), R32(RTREG));                 // add     <rdreg>,<rsreg>,<rtreg>
+			return true;
+
+		case 0x22:  /* SUB */
+		case 0x23:  /* SUBU */
+			if (RDREG != 0)
+				UML_SUB(block, R32(RDREG), R32(RSREG), R32(RTREG));                 // sub     <rdreg>,<rsreg>,<rtreg>
+			return true;
+
+
+		/* ----- basic logical ops ----- */
+
+		case 0x24:  /* AND */
+			if (RDREG != 0)
+				UML_AND(block, R32(RDREG), R32(RSREG), R32(RTREG));                 // and     <rdreg>,<rsreg>,<rtreg>
+			return true;
+
+		case 0x25:  /* OR */
+			if (RDREG != 0)
+				UML_OR(block, R32(RDREG), R32(RSREG), R32(RTREG));                  // or      <rdreg>,<rsreg>,<rtreg>
+			return true;
+
+		case 0x26:  /* XOR */
+			if (RDREG != 0)
+				UML_XOR(block, R32(RDREG), R32(RSREG), R32(RTREG));                 // xor     <rdreg>,<rsreg>,<rtreg>
+			return true;
+
+		case 0x27:  /* NOR */
+			if (RDREG != 0)
+			{
+				UML_OR(block, I0, R32(RSREG), R32(RTREG));                          // or      i0,<rsreg>,<rtreg>
+				UML_XOR(block, R32(RDREG), I0, ~0);                                 // xor     <rdreg>,i0,~0
+			}
+			return true;
+
+
+		/* ----- basic comparisons ----- */
+
+		case 0x2a:  /* SLT */
+			if (RDREG != 0)
+			{
+				UML_CMP(block, R32(RSREG), R32(RTREG));                             // cmp     <rsreg>,<rtreg>
+				UML_SETc(block, COND_L, R32(RDREG));                                // set     <rdreg>,l
+			}
+			return true;
+
+		case 0x2b:  /* SLTU */
+			if (RDREG != 0)
+			{
+				UML_CMP(block, R32(RSREG), R32(RTREG));                             // cmp     <rsreg>,<rtreg>
+				UML_SETc(block, COND_B, R32(RDREG));                                // set     <rdreg>,b
+			}
+			return true;
+
+
+		/* ----- jumps and branches ----- */
+
+		case 0x08:  /* JR */
+			generate_delay_slot_and_branch(block, compiler, desc, 0);               // <next instruction + hashjmp>
+			return true;
+
+		case 0x09:  /* JALR */
+			generate_delay_slot_and_branch(block, compiler, desc, RDREG);           // <next instruction + hashjmp>
+			return true;
+
+
+		/* ----- system calls ----- */
+
+		case 0x0d:  /* BREAK */
+			UML_CALLC(block, cfunc_break, this);                                    // callc   cfunc_break
+			compiler.checkhalt = true;
+			return true;
+	}
+	return false;
+}
+
+
+/*-------------------------------------------------
+    generate_regimm - compile opcodes in the
+    'REGIMM' group
+-------------------------------------------------*/
+
+bool rsp_device::generate_regimm(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t op = desc->opptr.l[0];
+	uint8_t opswitch = RTREG;
+	uml::code_label skip;
+
+	switch (opswitch)
+	{
+		case 0x00:  /* BLTZ */
+		case 0x10:  /* BLTZAL */
+			if (RSREG != 0)
+			{
+				UML_CMP(block, R32(RSREG), 0);                                      // cmp     <rsreg>,0
+				UML_JMPc(block, COND_GE, skip = compiler.labelnum++);               // jmp     skip,GE
+				generate_delay_slot_and_branch(block, compiler, desc, (opswitch & 0x10) ? 31 : 0);
+																					// <next instruction + hashjmp>
+				UML_LABEL(block, skip);                                             // skip:
+			}
+			return true;
+
+		case 0x01:  /* BGEZ */
+		case 0x11:  /* BGEZAL */
+			if (RSREG != 0)
+			{
+				UML_CMP(block, R32(RSREG), 0);                                      // cmp     <rsreg>,0
+				UML_JMPc(block, COND_L, skip = compiler.labelnum++);                // jmp     skip,L
+				generate_delay_slot_and_branch(block, compiler, desc, (opswitch & 0x10) ? 31 : 0);
+																					// <next instruction + hashjmp>
+				UML_LABEL(block, skip);                                             // skip:
+			}
+			else
+				generate_delay_slot_and_branch(block, compiler, desc, (opswitch & 0x10) ? 31 : 0);
+																					// <next instruction + hashjmp>
+			return true;
+	}
+	return false;
+}
+
+
+/*-------------------------------------------------
+    generate_cop0 - compile COP0 opcodes; these
+    go through the SP and DP register callbacks
+-------------------------------------------------*/
+
+bool rsp_device::generate_cop0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t op = desc->opptr.l[0];
+	uint8_t opswitch = RSREG;
+
+	switch (opswitch)
+	{
+		case 0x00:  /* MFCz */
+			if (RTREG != 0)
+			{
+				UML_MOV(block, mem(&m_rsp_state->arg0), op);                        // mov     [arg0],op
+				UML_CALLC(block, cfunc_get_cop0_reg, this);                         // callc   cfunc_get_cop0_reg
+			}
+			return true;
+
+		case 0x04:  /* MTCz */
+			UML_MOV(block, mem(&m_rsp_state->arg0), op);                            // mov     [arg0],op
+			UML_CALLC(block, cfunc_set_cop0_reg, this);                             // callc   cfunc_set_cop0_reg
+			if (desc->flags & OPFLAG_CAN_CAUSE_EXCEPTION)
+				compiler.checkhalt = true;
+			return true;
+	}
+	return false;
+}
+
+
+/*-------------------------------------------------
+    log_add_disasm_comment - add a comment
+    including disassembly of an RSP instruction
+-------------------------------------------------*/
+
+void rsp_device::log_add_disasm_comment(drcuml_block &block, uint32_t pc, uint32_t op)
+{
+	if (m_drcuml->logging())
+	{
+		rsp_disassembler rspd;
+		std::ostringstream stream;
+		rspd.dasm_one(stream, pc, op);
+		const std::string stream_string = stream.str();
+		block.append_comment("%08X: %s", pc, stream_string.c_str());                // comment
+	}
+}
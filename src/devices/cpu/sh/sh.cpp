@@ -27,6 +27,7 @@ void sh_common_execution::device_start()
 	save_item(NAME(m_sh2_state->evec));
 	save_item(NAME(m_sh2_state->irqsr));
 	save_item(NAME(m_sh2_state->target));
+	save_item(NAME(m_sh2_state->drc_mode));
 	save_item(NAME(m_sh2_state->internal_irq_level));
 	save_item(NAME(m_sh2_state->sleep_mode));
 	save_item(NAME(m_sh2_state->icount));
@@ -47,6 +48,7 @@ void sh_common_execution::device_start()
 	m_sh2_state->evec = 0;
 	m_sh2_state->irqsr = 0;
 	m_sh2_state->target = 0;
+	m_sh2_state->drc_mode = 0;
 	m_sh2_state->internal_irq_level = 0;
 	m_sh2_state->icount = 0;
 	m_sh2_state->sleep_mode = 0;
@@ -99,7 +101,8 @@ void sh_common_execution::drc_start()
 
 	/* initialize the UML generator */
 	uint32_t flags = 0;
-	m_drcuml = std::make_unique<drcuml_state>(*this, m_cache, flags, 1, 32, 1);
+	m_drcuml = std::make_unique<drcuml_state>(*this, m_cache, flags, 4, 32, 1);
+	m_drcuml->enable_code_tracking(12);
 
 	/* add symbols for our stuff */
 	m_drcuml->symbol_add(&m_sh2_state->pc, sizeof(m_sh2_state->pc), "pc");
@@ -119,6 +122,7 @@ void sh_common_execution::drc_start()
 
 	/* initialize the front-end helper */
 	init_drc_frontend();
+	m_drcuml->persist_open(COMPILE_BLOCKLIST_VERSION);
 
 	/* compute the register parameters */
 	for (int regnum = 0; regnum < 16; regnum++)
@@ -2317,7 +2321,8 @@ void sh_common_execution::execute_run_drc()
 		/* if we need to recompile, do it */
 		if (execute_result == EXECUTE_MISSING_CODE)
 		{
-			code_compile_block(0, m_sh2_state->pc);
+			code_compile_block(m_sh2_state->drc_mode, m_sh2_state->pc);
+			code_prewarm_page(m_sh2_state->pc);
 		}
 		else if (execute_result == EXECUTE_UNMAPPED_CODE)
 		{
@@ -2345,12 +2350,19 @@ void sh_common_execution::code_compile_block(uint8_t mode, offs_t pc)
 
 	g_profiler.start(PROFILER_DRC_COMPILE);
 
+	/* FPU-dependent instructions are specialised for this mode */
+	compiler.mode = mode;
+
 	/* get a description of this sequence */
 	desclist = get_desclist(pc);
 
 	if (m_drcuml->logging() || m_drcuml->logging_native())
 		log_opcode_desc(desclist, 0);
 
+	/* note the block for the persistent block list */
+	if (m_drcuml->persist_enabled())
+		m_drcuml->persist_record(mode, pc, get_deschash());
+
 	bool succeeded = false;
 	while (!succeeded)
 	{
@@ -2391,11 +2403,13 @@ void sh_common_execution::code_compile_block(uint8_t mode, offs_t pc)
 				else
 				{
 					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc | 0x80000000
-					UML_HASHJMP(block, 0, seqhead->pc, *m_nocode);
+					UML_HASHJMP(block, mode, seqhead->pc, *m_nocode);
 																							// hashjmp <mode>,seqhead->pc,nocode
 					continue;
 				}
 
+				compiler.modechanged = false;
+
 				/* validate this code block if we're not pointing into ROM */
 				if (m_program->get_write_ptr(seqhead->physpc) != nullptr)
 					generate_checksum_block(block, compiler, seqhead, seqlast);
@@ -2426,10 +2440,14 @@ void sh_common_execution::code_compile_block(uint8_t mode, offs_t pc)
 				/* count off cycles and go there */
 				generate_update_cycles(block, compiler, nextpc, true);                // <subtract cycles>
 
-				/* SH2 has no modes */
-				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+				/* if the sequence may have changed modes, use a variable mode; otherwise, assume the same mode */
+				if (compiler.modechanged)
+				{
+					UML_HASHJMP(block, mem(&m_sh2_state->drc_mode), nextpc, *m_nocode);
+				}
+				else if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
 				{
-					UML_HASHJMP(block, 0, nextpc, *m_nocode);
+					UML_HASHJMP(block, mode, nextpc, *m_nocode);
 				}
 																							// hashjmp <mode>,nextpc,nocode
 			}
@@ -2447,6 +2465,26 @@ void sh_common_execution::code_compile_block(uint8_t mode, offs_t pc)
 }
 
 
+/*-------------------------------------------------
+    code_prewarm_page - compile any blocks from
+    the persistent block list that start on the
+    same page as the given PC
+-------------------------------------------------*/
+
+void sh_common_execution::code_prewarm_page(offs_t pc)
+{
+	m_drcuml->persist_prewarm(pc, [this] (uint8_t mode, offs_t blockpc, uint64_t hash)
+	{
+		/* only compile blocks whose code hasn't changed */
+		get_desclist(blockpc);
+		if (get_deschash() != hash)
+			return false;
+		code_compile_block(mode, blockpc);
+		return true;
+	});
+}
+
+
 /*-------------------------------------------------
     static_generate_nocode_handler - generate an
     exception handler for "out of code"
@@ -2613,6 +2651,10 @@ void sh_common_execution::generate_sequence_instruction(drcuml_block &block, com
 	/* otherwise, unless this is a virtual no-op, it's a regular instruction */
 	else if (!(desc->flags & OPFLAG_VIRTUAL_NOOP))
 	{
+		/* anything that jumps from here on can't assume the block's mode */
+		if (desc->flags & OPFLAG_CAN_CHANGE_MODES)
+			compiler.modechanged = true;
+
 		/* compile the instruction */
 		if (!generate_opcode(block, compiler, desc, ovrpc))
 		{
@@ -2636,8 +2678,9 @@ void sh_common_execution::generate_delay_slot(drcuml_block &block, compiler_stat
 	assert(desc->delay.first() != nullptr);
 	generate_sequence_instruction(block, compiler_temp, desc->delay.first(), ovrpc);              // <next instruction>
 
-	/* update the label */
+	/* update the label and note any mode change */
 	compiler.labelnum = compiler_temp.labelnum;
+	compiler.modechanged = compiler_temp.modechanged;
 }
 
 void sh_common_execution::func_unimplemented()
@@ -2859,7 +2902,7 @@ bool sh_common_execution::generate_opcode(drcuml_block &block, compiler_state &c
 			generate_delay_slot(block, compiler, desc, m_sh2_state->ea-2);
 
 			generate_update_cycles(block, compiler, m_sh2_state->ea, true);    // <subtract cycles>
-			UML_HASHJMP(block, 0, m_sh2_state->ea, *m_nocode);   // hashjmp m_sh2_state->ea
+			UML_HASHJMP(block, hash_mode(compiler), m_sh2_state->ea, *m_nocode);   // hashjmp m_sh2_state->ea
 			return true;
 
 		case 11:    // BSR
@@ -2873,7 +2916,7 @@ bool sh_common_execution::generate_opcode(drcuml_block &block, compiler_state &c
 			generate_delay_slot(block, compiler, desc, m_sh2_state->ea-2);
 
 			generate_update_cycles(block, compiler, m_sh2_state->ea, true);    // <subtract cycles>
-			UML_HASHJMP(block, 0, m_sh2_state->ea, *m_nocode);   // hashjmp m_sh2_state->ea
+			UML_HASHJMP(block, hash_mode(compiler), m_sh2_state->ea, *m_nocode);   // hashjmp m_sh2_state->ea
 			return true;
 
 		case 12:
@@ -3405,7 +3448,7 @@ bool sh_common_execution::generate_group_8(drcuml_block &block, compiler_state &
 		m_sh2_state->ea = (desc->pc + 2) + disp * 2 + 2;    // m_sh2_state->ea = destination
 
 		generate_update_cycles(block, compiler, m_sh2_state->ea, true);    // <subtract cycles>
-		UML_HASHJMP(block, 0, m_sh2_state->ea, *m_nocode);   // jmp m_sh2_state->ea
+		UML_HASHJMP(block, hash_mode(compiler), m_sh2_state->ea, *m_nocode);   // jmp m_sh2_state->ea
 
 		UML_LABEL(block, compiler.labelnum++);         // labelnum:
 		return true;
@@ -3418,7 +3461,7 @@ bool sh_common_execution::generate_group_8(drcuml_block &block, compiler_state &
 		m_sh2_state->ea = (desc->pc + 2) + disp * 2 + 2;        // m_sh2_state->ea = destination
 
 		generate_update_cycles(block, compiler, m_sh2_state->ea, true);    // <subtract cycles>
-		UML_HASHJMP(block, 0, m_sh2_state->ea, *m_nocode);   // jmp m_sh2_state->ea
+		UML_HASHJMP(block, hash_mode(compiler), m_sh2_state->ea, *m_nocode);   // jmp m_sh2_state->ea
 
 		UML_LABEL(block, compiler.labelnum++);         // labelnum:
 		return true;
@@ -3437,7 +3480,7 @@ bool sh_common_execution::generate_group_8(drcuml_block &block, compiler_state &
 			generate_delay_slot(block, compiler, desc, m_sh2_state->ea-2);
 
 			generate_update_cycles(block, compiler, m_sh2_state->ea, true);    // <subtract cycles>
-			UML_HASHJMP(block, 0, m_sh2_state->ea, *m_nocode);   // jmp m_sh2_state->ea
+			UML_HASHJMP(block, hash_mode(compiler), m_sh2_state->ea, *m_nocode);   // jmp m_sh2_state->ea
 
 			UML_LABEL(block, templabel);            // labelnum:
 			return true;
@@ -3458,7 +3501,7 @@ bool sh_common_execution::generate_group_8(drcuml_block &block, compiler_state &
 			generate_delay_slot(block, compiler, desc, m_sh2_state->ea-2); // delay slot only if the branch is taken
 
 			generate_update_cycles(block, compiler, m_sh2_state->ea, true);    // <subtract cycles>
-			UML_HASHJMP(block, 0, m_sh2_state->ea, *m_nocode);   // jmp m_sh2_state->ea
+			UML_HASHJMP(block, hash_mode(compiler), m_sh2_state->ea, *m_nocode);   // jmp m_sh2_state->ea
 
 			UML_LABEL(block, templabel);            // labelnum:
 			return true;
@@ -3486,7 +3529,7 @@ bool sh_common_execution::generate_group_12_TRAPA(drcuml_block &block, compiler_
 
 	UML_MOV(block, I0, mem(&m_sh2_state->ea));              // mov r0, ea
 	UML_CALLH(block, *m_read32);                 // read32
-	UML_HASHJMP(block, 0, I0, *m_nocode);        // jmp (r0)
+	UML_HASHJMP(block, hash_mode(compiler), I0, *m_nocode);        // jmp (r0)
 
 	return true;
 }
@@ -3657,7 +3700,7 @@ bool sh_common_execution::generate_group_0_RTE(drcuml_block &block, compiler_sta
 	compiler.checkints = true;
 	UML_MOV(block, mem(&m_sh2_state->ea), mem(&m_sh2_state->pc));       // mov ea, pc
 	generate_update_cycles(block, compiler, uml::mem(&m_sh2_state->ea), true);  // <subtract cycles>
-	UML_HASHJMP(block, 0, mem(&m_sh2_state->pc), *m_nocode); // and jump to the "resume PC"
+	UML_HASHJMP(block, hash_mode(compiler), mem(&m_sh2_state->pc), *m_nocode); // and jump to the "resume PC"
 
 	return true;
 }
@@ -3704,7 +3747,7 @@ bool sh_common_execution::generate_group_0(drcuml_block &block, compiler_state &
 			generate_delay_slot(block, compiler, desc, m_sh2_state->target);
 
 			generate_update_cycles(block, compiler, uml::mem(&m_sh2_state->target), true);  // <subtract cycles>
-			UML_HASHJMP(block, 0, mem(&m_sh2_state->target), *m_nocode); // jmp target
+			UML_HASHJMP(block, hash_mode(compiler), mem(&m_sh2_state->target), *m_nocode); // jmp target
 			return true;
 		}
 		break;
@@ -3770,7 +3813,7 @@ bool sh_common_execution::generate_group_0(drcuml_block &block, compiler_state &
 		generate_delay_slot(block, compiler, desc, m_sh2_state->target);
 
 		generate_update_cycles(block, compiler, uml::mem(&m_sh2_state->target), true);  // <subtract cycles>
-		UML_HASHJMP(block, 0, mem(&m_sh2_state->target), *m_nocode);
+		UML_HASHJMP(block, hash_mode(compiler), mem(&m_sh2_state->target), *m_nocode);
 		return true;
 
 	case 0x0c: // MOVBL0(Rm, Rn);
@@ -3868,7 +3911,7 @@ bool sh_common_execution::generate_group_0(drcuml_block &block, compiler_state &
 			generate_delay_slot(block, compiler, desc, m_sh2_state->target);
 
 			generate_update_cycles(block, compiler, uml::mem(&m_sh2_state->target), true);  // <subtract cycles>
-			UML_HASHJMP(block, 0, mem(&m_sh2_state->target), *m_nocode); // jmp target
+			UML_HASHJMP(block, hash_mode(compiler), mem(&m_sh2_state->target), *m_nocode); // jmp target
 			return true;
 		}
 		break;
@@ -4018,7 +4061,7 @@ bool sh_common_execution::generate_group_4(drcuml_block &block, compiler_state &
 		generate_delay_slot(block, compiler, desc, m_sh2_state->target-4);
 
 		generate_update_cycles(block, compiler, uml::mem(&m_sh2_state->target), true);  // <subtract cycles>
-		UML_HASHJMP(block, 0, mem(&m_sh2_state->target), *m_nocode); // and do the jump
+		UML_HASHJMP(block, hash_mode(compiler), mem(&m_sh2_state->target), *m_nocode); // and do the jump
 		return true;
 
 	case 0x0e: // LDCSR(Rn);
@@ -4233,7 +4276,7 @@ bool sh_common_execution::generate_group_4(drcuml_block &block, compiler_state &
 		generate_delay_slot(block, compiler, desc, m_sh2_state->target);
 
 		generate_update_cycles(block, compiler, uml::mem(&m_sh2_state->target), true);  // <subtract cycles>
-		UML_HASHJMP(block, 0, mem(&m_sh2_state->target), *m_nocode); // jmp (target)
+		UML_HASHJMP(block, hash_mode(compiler), mem(&m_sh2_state->target), *m_nocode); // jmp (target)
 		return true;
 
 	case 0x2e: // LDCVBR(Rn);
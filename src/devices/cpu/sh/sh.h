@@ -136,6 +136,7 @@ public:
 		uint32_t  evec;               // exception vector for DRC
 		uint32_t  irqsr;              // IRQ-time old SR for DRC
 		uint32_t  target;             // target for jmp/jsr/etc so the delay slot can't kill it
+		uint32_t  drc_mode;           // hash mode for the DRC (FPSCR.PR/SZ on SH-4, always 0 on SH-2)
 		int     internal_irq_level;
 		int     icount;
 		uint8_t   sleep_mode;
@@ -185,7 +186,10 @@ protected:
 		COMPILE_BACKWARDS_BYTES     = 64,
 		COMPILE_FORWARDS_BYTES      = 256,
 		COMPILE_MAX_INSTRUCTIONS    = (COMPILE_BACKWARDS_BYTES / 2) + (COMPILE_FORWARDS_BYTES / 2),
-		COMPILE_MAX_SEQUENCE        = 64
+		COMPILE_MAX_SEQUENCE        = 64,
+
+		// persistent block lists -- bump when block descriptions change to discard old ones
+		COMPILE_BLOCKLIST_VERSION   = 2
 	};
 
 	// size of the execution code cache
@@ -417,9 +421,14 @@ public:
 
 		uint32_t          cycles;                     /* accumulated cycles */
 		uint8_t           checkints;                  /* need to check interrupts before next instruction */
+		uint8_t           mode;                       /* mode the block is being compiled for */
+		uint8_t           modechanged;                /* an instruction in this sequence may have changed modes */
 		uml::code_label  labelnum;                   /* index for local labels */
 	};
 
+	// mode to hash jumps through: the block's own unless it may have changed under us
+	uml::parameter hash_mode(const compiler_state &compiler) const { return compiler.modechanged ? uml::mem(&m_sh2_state->drc_mode) : uml::parameter(compiler.mode); }
+
 	virtual void sh2_exception(const char *message, int irqline) { fatalerror("sh2_exception in base classs\n"); }
 
 	virtual void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param, bool allow_exception) = 0;
@@ -458,6 +467,7 @@ public:
 	virtual void static_generate_entry_point() = 0;
 	virtual void static_generate_memory_accessor(int size, int iswrite, const char *name, uml::code_handle *&handleptr) = 0;
 	virtual const opcode_desc* get_desclist(offs_t pc) = 0;
+	virtual u64 get_deschash() = 0;
 
 	uint32_t epc(const opcode_desc *desc);
 	void alloc_handle(uml::code_handle *&handleptr, const char *name);
@@ -475,6 +485,7 @@ public:
 	void code_flush_cache();
 	void execute_run_drc();
 	void code_compile_block(uint8_t mode, offs_t pc);
+	void code_prewarm_page(offs_t pc);
 
 
 protected:
@@ -871,6 +871,11 @@ const opcode_desc* sh2_device::get_desclist(offs_t pc)
 	return m_drcfe->describe_code(pc);
 }
 
+u64 sh2_device::get_deschash()
+{
+	return m_drcfe->describe_hash();
+}
+
 
 
 /*-------------------------------------------------
@@ -621,8 +621,7 @@ inline void sh34_base_device::LDSMFPSCR(const uint16_t opcode)
 	if ((s & PR) != (m_sh2_state->m_fpscr & PR))
 		sh4_swap_fp_couples();
 #endif
-	m_sh2_state->m_fpu_sz = (m_sh2_state->m_fpscr & SZ) ? 1 : 0;
-	m_sh2_state->m_fpu_pr = (m_sh2_state->m_fpscr & PR) ? 1 : 0;
+	sh4_update_fpu_mode();
 }
 
 /*  LDC.L   @Rm+,DBR */
@@ -678,8 +677,7 @@ inline void sh34_base_device::LDSFPSCR(const uint16_t opcode)
 	if ((s & PR) != (m_sh2_state->m_fpscr & PR))
 		sh4_swap_fp_couples();
 #endif
-	m_sh2_state->m_fpu_sz = (m_sh2_state->m_fpscr & SZ) ? 1 : 0;
-	m_sh2_state->m_fpu_pr = (m_sh2_state->m_fpscr & PR) ? 1 : 0;
+	sh4_update_fpu_mode();
 }
 
 /*  LDC     Rm,DBR */
@@ -1152,7 +1150,7 @@ void sh34_base_device::FRCHG()
 void sh34_base_device::FSCHG()
 {
 	m_sh2_state->m_fpscr ^= SZ;
-	m_sh2_state->m_fpu_sz = (m_sh2_state->m_fpscr & SZ) ? 1 : 0;
+	sh4_update_fpu_mode();
 }
 
 /* FTRC FRm,FPUL PR=0 1111mmmm00111101 */
@@ -1605,8 +1603,7 @@ void sh34_base_device::device_reset()
 	m_sh2_state->r[15] = RL(4);
 	m_sh2_state->sr = 0x700000f0;
 	m_sh2_state->m_fpscr = 0x00040001;
-	m_sh2_state->m_fpu_sz = (m_sh2_state->m_fpscr & SZ) ? 1 : 0;
-	m_sh2_state->m_fpu_pr = (m_sh2_state->m_fpscr & PR) ? 1 : 0;
+	sh4_update_fpu_mode();
 	m_sh2_state->m_fpul = 0;
 	m_sh2_state->m_dbr = 0;
 
@@ -2575,6 +2572,11 @@ const opcode_desc* sh4be_device::get_desclist(offs_t pc)
 	return m_drcfe->describe_code(pc);
 }
 
+u64 sh4be_device::get_deschash()
+{
+	return m_drcfe->describe_hash();
+}
+
 void sh4be_device::init_drc_frontend()
 {
 	m_drcfe = std::make_unique<sh4be_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
@@ -2586,6 +2588,11 @@ const opcode_desc* sh4_device::get_desclist(offs_t pc)
 	return m_drcfe->describe_code(pc);
 }
 
+u64 sh4_device::get_deschash()
+{
+	return m_drcfe->describe_hash();
+}
+
 void sh4_device::init_drc_frontend()
 {
 	m_drcfe = std::make_unique<sh4_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
@@ -2596,6 +2603,11 @@ const opcode_desc* sh3be_device::get_desclist(offs_t pc)
 	return m_drcfe->describe_code(pc);
 }
 
+u64 sh3be_device::get_deschash()
+{
+	return m_drcfe->describe_hash();
+}
+
 void sh3be_device::init_drc_frontend()
 {
 	m_drcfe = std::make_unique<sh4be_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
@@ -2606,6 +2618,11 @@ const opcode_desc* sh3_device::get_desclist(offs_t pc)
 	return m_drcfe->describe_code(pc);
 }
 
+u64 sh3_device::get_deschash()
+{
+	return m_drcfe->describe_hash();
+}
+
 void sh3_device::init_drc_frontend()
 {
 	m_drcfe = std::make_unique<sh4_frontend>(this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE);
@@ -2640,7 +2657,7 @@ void sh34_base_device::generate_update_cycles(drcuml_block &block, compiler_stat
 		/* generate a hash jump via the current mode and PC
 		   pc should be pointing to either the exception address
 		   or have been left on the next PC set above? */
-		UML_HASHJMP(block, 0, mem(&m_sh2_state->pc), *m_nocode);     // hashjmp <mode>,<pc>,nocode
+		UML_HASHJMP(block, hash_mode(compiler), mem(&m_sh2_state->pc), *m_nocode);     // hashjmp <mode>,<pc>,nocode
 	}
 
 	/* account for cycles */
@@ -2678,7 +2695,7 @@ void sh34_base_device::static_generate_entry_point()
 	load_fast_iregs(block);
 
 	/* generate a hash jump via the current mode and PC */
-	UML_HASHJMP(block, 0, mem(&m_sh2_state->pc), *m_nocode);     // hashjmp <mode>,<pc>,nocode
+	UML_HASHJMP(block, mem(&m_sh2_state->drc_mode), mem(&m_sh2_state->pc), *m_nocode); // hashjmp <mode>,<pc>,nocode
 
 	block.end();
 }
@@ -3023,7 +3040,7 @@ bool sh34_base_device::generate_group_0_RTE(drcuml_block &block, compiler_state
 
 	UML_MOV(block, mem(&m_sh2_state->pc), mem(&m_sh2_state->m_delay));
 	generate_update_cycles(block, compiler, uml::mem(&m_sh2_state->ea), true);  // <subtract cycles>
-	UML_HASHJMP(block, 0, mem(&m_sh2_state->pc), *m_nocode); // and jump to the "resume PC"
+	UML_HASHJMP(block, hash_mode(compiler), mem(&m_sh2_state->pc), *m_nocode); // and jump to the "resume PC"
 	return true;
 }
 
@@ -3037,7 +3054,7 @@ bool sh34_base_device::generate_group_12_TRAPA(drcuml_block &block, compiler_sta
 	UML_MOV(block, mem(&m_sh2_state->pc), desc->pc + 2); // copy the PC because we need to use it
 	UML_CALLC(block, cfunc_TRAPA, this);
 	load_fast_iregs(block);
-	UML_HASHJMP(block, 0, mem(&m_sh2_state->pc), *m_nocode);
+	UML_HASHJMP(block, hash_mode(compiler), mem(&m_sh2_state->pc), *m_nocode);
 	return true;
 }
 
@@ -3433,6 +3450,17 @@ bool sh34_base_device::generate_group_4_LDCDBR(drcuml_block &block, compiler_sta
 	return true;
 }
 
+// m_fr index of single-precision register n; on little-endian hosts the
+// halves of each pair are kept swapped while PR is set
+inline uint32_t sh34_base_device::fpu_index(const compiler_state &compiler, uint32_t n) const
+{
+#ifdef LSB_FIRST
+	return n ^ ((compiler.mode & MODE_PR) ? 1 : 0);
+#else
+	return n;
+#endif
+}
+
 bool sh34_base_device::generate_group_15(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
 	switch (opcode & 0x0f)
@@ -3461,107 +3489,59 @@ bool sh34_base_device::generate_group_15(drcuml_block &block, compiler_state &co
 }
 bool sh34_base_device::generate_group_15_FADD(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	UML_TEST(block, mem(&m_sh2_state->m_fpu_pr), 0);
-	UML_JMPc(block, COND_Z, compiler.labelnum);
-
-	UML_FDADD(block, FPD32(Rn), FPD32(Rn), FPD32(Rm));
-	UML_JMP(block, compiler.labelnum+1);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum:
-	UML_FSADD(block, FPS32(Rn), FPS32(Rn), FPS32(Rm));
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum+1:
-
+	if (compiler.mode & MODE_PR)
+		UML_FDADD(block, FPD32(Rn), FPD32(Rn), FPD32(Rm));
+	else
+		UML_FSADD(block, FPS32(Rn), FPS32(Rn), FPS32(Rm));
 	return true;
 }
 
 bool sh34_base_device::generate_group_15_FSUB(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	UML_TEST(block, mem(&m_sh2_state->m_fpu_pr), 0);
-	UML_JMPc(block, COND_Z, compiler.labelnum);
-
-	UML_FDSUB(block, FPD32(Rn), FPD32(Rn), FPD32(Rm));
-	UML_JMP(block, compiler.labelnum+1);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum:
-	UML_FSSUB(block, FPS32(Rn), FPS32(Rn), FPS32(Rm));
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum+1:
-
+	if (compiler.mode & MODE_PR)
+		UML_FDSUB(block, FPD32(Rn), FPD32(Rn), FPD32(Rm));
+	else
+		UML_FSSUB(block, FPS32(Rn), FPS32(Rn), FPS32(Rm));
 	return true;
 }
 
 bool sh34_base_device::generate_group_15_FMUL(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	UML_TEST(block, mem(&m_sh2_state->m_fpu_pr), 0);
-	UML_JMPc(block, COND_Z, compiler.labelnum);
-
-	UML_FDMUL(block, FPD32(Rn), FPD32(Rn), FPD32(Rm));
-	UML_JMP(block, compiler.labelnum+1);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum:
-	UML_FSMUL(block, FPS32(Rn), FPS32(Rn), FPS32(Rm));
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum+1:
-
+	if (compiler.mode & MODE_PR)
+		UML_FDMUL(block, FPD32(Rn), FPD32(Rn), FPD32(Rm));
+	else
+		UML_FSMUL(block, FPS32(Rn), FPS32(Rn), FPS32(Rm));
 	return true;
 }
 
 bool sh34_base_device::generate_group_15_FDIV(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	UML_TEST(block, mem(&m_sh2_state->m_fpu_pr), 0);
-	UML_JMPc(block, COND_Z, compiler.labelnum);
-
-	UML_FDDIV(block, FPD32(Rn), FPD32(Rn), FPD32(Rm));
-	UML_JMP(block, compiler.labelnum+1);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum:
-	UML_FSDIV(block, FPS32(Rn), FPS32(Rn), FPS32(Rm));
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum+1:
-
+	if (compiler.mode & MODE_PR)
+		UML_FDDIV(block, FPD32(Rn), FPD32(Rn), FPD32(Rm));
+	else
+		UML_FSDIV(block, FPS32(Rn), FPS32(Rn), FPS32(Rm));
 	return true;
 }
 
 bool sh34_base_device::generate_group_15_FCMP_EQ(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	UML_TEST(block, uml::mem(&m_sh2_state->m_fpu_pr), 0);
-	UML_JMPc(block, COND_Z, compiler.labelnum);
-
-	UML_FDCMP(block, FPD32(Rm & 14), FPD32(Rn & 14));
-	UML_SETc(block, COND_Z, I0);
-	UML_ROLINS(block, uml::mem(&m_sh2_state->sr), I0, T_SHIFT, SH_T);
-
-	UML_JMP(block, compiler.labelnum+1);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum:
-
-	UML_FSCMP(block, FPS32(Rm), FPS32(Rn));
+	if (compiler.mode & MODE_PR)
+		UML_FDCMP(block, FPD32(Rm & 14), FPD32(Rn & 14));
+	else
+		UML_FSCMP(block, FPS32(Rm), FPS32(Rn));
 	UML_SETc(block, COND_Z, I0);
 	UML_ROLINS(block, uml::mem(&m_sh2_state->sr), I0, T_SHIFT, SH_T);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum+1:
 	return true;
 }
 
 bool sh34_base_device::generate_group_15_FCMP_GT(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	UML_TEST(block, uml::mem(&m_sh2_state->m_fpu_pr), 0);
-	UML_JMPc(block, COND_Z, compiler.labelnum);
-
-	UML_FDCMP(block, FPD32(Rm & 14), FPD32(Rn & 14));
-	UML_SETc(block, COND_C, I0);
-	UML_ROLINS(block, uml::mem(&m_sh2_state->sr), I0, T_SHIFT, SH_T);
-
-	UML_JMP(block, compiler.labelnum+1);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum:
-
-	UML_FSCMP(block, FPS32(Rm), FPS32(Rn));
+	if (compiler.mode & MODE_PR)
+		UML_FDCMP(block, FPD32(Rm & 14), FPD32(Rn & 14));
+	else
+		UML_FSCMP(block, FPS32(Rm), FPS32(Rn));
 	UML_SETc(block, COND_C, I0);
 	UML_ROLINS(block, uml::mem(&m_sh2_state->sr), I0, T_SHIFT, SH_T);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum+1:
 	return true;
 }
 
@@ -3570,10 +3550,22 @@ static void cfunc_FMOVS0FR(void *param) { ((sh34_base_device *)param)->func_FMOV
 
 bool sh34_base_device::generate_group_15_FMOVS0FR(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	save_fast_iregs(block);
-	UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
-	UML_CALLC(block, cfunc_FMOVS0FR, this);
-	load_fast_iregs(block);
+	if (compiler.mode & MODE_SZ)
+	{
+		save_fast_iregs(block);
+		UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
+		UML_CALLC(block, cfunc_FMOVS0FR, this);
+		load_fast_iregs(block);
+		return true;
+	}
+
+	UML_ADD(block, I0, R32(0), R32(Rm));
+	SETEA(0);
+	UML_CALLH(block, *m_read32);
+	UML_MOV(block, mem(&m_sh2_state->m_fr[fpu_index(compiler, Rn)]), I0);
+
+	if (!in_delay_slot)
+		generate_update_cycles(block, compiler, desc->pc + 2, true);
 	return true;
 }
 
@@ -3582,10 +3574,22 @@ static void cfunc_FMOVFRS0(void *param) { ((sh34_base_device *)param)->func_FMOV
 
 bool sh34_base_device::generate_group_15_FMOVFRS0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	save_fast_iregs(block);
-	UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
-	UML_CALLC(block, cfunc_FMOVFRS0, this);
-	load_fast_iregs(block);
+	if (compiler.mode & MODE_SZ)
+	{
+		save_fast_iregs(block);
+		UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
+		UML_CALLC(block, cfunc_FMOVFRS0, this);
+		load_fast_iregs(block);
+		return true;
+	}
+
+	UML_ADD(block, I0, R32(0), R32(Rn));
+	SETEA(0);
+	UML_MOV(block, I1, mem(&m_sh2_state->m_fr[fpu_index(compiler, Rm)]));
+	UML_CALLH(block, *m_write32);
+
+	if (!in_delay_slot)
+		generate_update_cycles(block, compiler, desc->pc + 2, true);
 	return true;
 }
 
@@ -3594,10 +3598,22 @@ static void cfunc_FMOVMRFR(void *param) { ((sh34_base_device *)param)->func_FMOV
 
 bool sh34_base_device::generate_group_15_FMOVMRFR(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	save_fast_iregs(block);
-	UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
-	UML_CALLC(block, cfunc_FMOVMRFR, this);
-	load_fast_iregs(block);
+	if (compiler.mode & MODE_SZ)
+	{
+		save_fast_iregs(block);
+		UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
+		UML_CALLC(block, cfunc_FMOVMRFR, this);
+		load_fast_iregs(block);
+		return true;
+	}
+
+	UML_MOV(block, I0, R32(Rm));
+	SETEA(0);
+	UML_CALLH(block, *m_read32);
+	UML_MOV(block, mem(&m_sh2_state->m_fr[fpu_index(compiler, Rn)]), I0);
+
+	if (!in_delay_slot)
+		generate_update_cycles(block, compiler, desc->pc + 2, true);
 	return true;
 }
 
@@ -3606,10 +3622,23 @@ static void cfunc_FMOVMRIFR(void *param) { ((sh34_base_device *)param)->func_FMO
 
 bool sh34_base_device::generate_group_15_FMOVMRIFR(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	save_fast_iregs(block);
-	UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
-	UML_CALLC(block, cfunc_FMOVMRIFR, this);
-	load_fast_iregs(block);
+	if (compiler.mode & MODE_SZ)
+	{
+		save_fast_iregs(block);
+		UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
+		UML_CALLC(block, cfunc_FMOVMRIFR, this);
+		load_fast_iregs(block);
+		return true;
+	}
+
+	UML_MOV(block, I0, R32(Rm));
+	SETEA(0);
+	UML_CALLH(block, *m_read32);
+	UML_MOV(block, mem(&m_sh2_state->m_fr[fpu_index(compiler, Rn)]), I0);
+	UML_ADD(block, R32(Rm), R32(Rm), 4);
+
+	if (!in_delay_slot)
+		generate_update_cycles(block, compiler, desc->pc + 2, true);
 	return true;
 }
 
@@ -3618,10 +3647,22 @@ static void cfunc_FMOVFRMR(void *param) { ((sh34_base_device *)param)->func_FMOV
 
 bool sh34_base_device::generate_group_15_FMOVFRMR(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	save_fast_iregs(block);
-	UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
-	UML_CALLC(block, cfunc_FMOVFRMR, this);
-	load_fast_iregs(block);
+	if (compiler.mode & MODE_SZ)
+	{
+		save_fast_iregs(block);
+		UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
+		UML_CALLC(block, cfunc_FMOVFRMR, this);
+		load_fast_iregs(block);
+		return true;
+	}
+
+	UML_MOV(block, I0, R32(Rn));
+	SETEA(0);
+	UML_MOV(block, I1, mem(&m_sh2_state->m_fr[fpu_index(compiler, Rm)]));
+	UML_CALLH(block, *m_write32);
+
+	if (!in_delay_slot)
+		generate_update_cycles(block, compiler, desc->pc + 2, true);
 	return true;
 }
 
@@ -3630,34 +3671,49 @@ static void cfunc_FMOVFRMDR(void *param) { ((sh34_base_device *)param)->func_FMO
 
 bool sh34_base_device::generate_group_15_FMOVFRMDR(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	save_fast_iregs(block);
-	UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
-	UML_CALLC(block, cfunc_FMOVFRMDR, this);
-	load_fast_iregs(block);
+	if (compiler.mode & MODE_SZ)
+	{
+		save_fast_iregs(block);
+		UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
+		UML_CALLC(block, cfunc_FMOVFRMDR, this);
+		load_fast_iregs(block);
+		return true;
+	}
+
+	UML_SUB(block, R32(Rn), R32(Rn), 4);
+	UML_MOV(block, I0, R32(Rn));
+	SETEA(0);
+	UML_MOV(block, I1, mem(&m_sh2_state->m_fr[fpu_index(compiler, Rm)]));
+	UML_CALLH(block, *m_write32);
+
+	if (!in_delay_slot)
+		generate_update_cycles(block, compiler, desc->pc + 2, true);
 	return true;
 }
 
-void sh34_base_device::func_FMOVFR() { FMOVFR(m_sh2_state->arg0); }
-static void cfunc_FMOVFR(void *param) { ((sh34_base_device *)param)->func_FMOVFR(); };
-
 bool sh34_base_device::generate_group_15_FMOVFR(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	save_fast_iregs(block);
-	UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
-	UML_CALLC(block, cfunc_FMOVFR, this);
-	load_fast_iregs(block);
+	if (compiler.mode & MODE_SZ)
+	{
+		// DRm/XDm to DRn/XDn, both words at once
+		uint32_t *const src = (Rm & 1) ? &m_sh2_state->m_xf[Rm & 14] : &m_sh2_state->m_fr[Rm];
+		uint32_t *const dst = (Rn & 1) ? &m_sh2_state->m_xf[Rn & 14] : &m_sh2_state->m_fr[Rn];
+		UML_DMOV(block, mem(dst), mem(src));
+	}
+	else
+	{
+		UML_MOV(block, mem(&m_sh2_state->m_fr[fpu_index(compiler, Rn)]), mem(&m_sh2_state->m_fr[fpu_index(compiler, Rm)]));
+	}
 	return true;
 }
 
 bool sh34_base_device::generate_group_15_FMAC(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	UML_TEST(block, mem(&m_sh2_state->m_fpu_pr), 0);
-	UML_JMPc(block, COND_NZ, compiler.labelnum);
-
-	UML_FSMUL(block, F0, FPS32(0), FPS32(Rm));
-	UML_FSADD(block, FPS32(Rn), F0, FPS32(Rn));
-
-	UML_LABEL(block, compiler.labelnum++);
+	if (!(compiler.mode & MODE_PR))
+	{
+		UML_FSMUL(block, F0, FPS32(0), FPS32(Rm));
+		UML_FSADD(block, FPS32(Rn), F0, FPS32(Rn));
+	}
 	return true;
 }
 
@@ -3687,99 +3743,57 @@ bool sh34_base_device::generate_group_15_op1111_0x13(drcuml_block &block, compil
 
 bool sh34_base_device::generate_group_15_op1111_0x13_FSTS(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-#ifdef LSB_FIRST
-	UML_XOR(block, I0, Rn, uml::mem(&m_sh2_state->m_fpu_pr));
-	UML_STORE(block, m_sh2_state->m_fr, I0, uml::mem(&m_sh2_state->m_fpul), SIZE_DWORD, SCALE_x4);
-#else
-	UML_MOV(block, FPS32(Rn), uml::mem(&m_sh2_state->m_fpul));
-#endif
+	UML_MOV(block, mem(&m_sh2_state->m_fr[fpu_index(compiler, Rn)]), uml::mem(&m_sh2_state->m_fpul));
 	return true;
 }
 
-void sh34_base_device::func_FLDS() { FLDS(m_sh2_state->arg0); }
-static void cfunc_FLDS(void *param) { ((sh34_base_device *)param)->func_FLDS(); };
-
 bool sh34_base_device::generate_group_15_op1111_0x13_FLDS(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	save_fast_iregs(block);
-	UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
-	UML_CALLC(block, cfunc_FLDS, this);
-	load_fast_iregs(block);
+	UML_MOV(block, uml::mem(&m_sh2_state->m_fpul), mem(&m_sh2_state->m_fr[fpu_index(compiler, Rn)]));
 	return true;
 }
 
 bool sh34_base_device::generate_group_15_op1111_0x13_FLOAT(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	UML_TEST(block, uml::mem(&m_sh2_state->m_fpu_pr), 0);
-	UML_JMPc(block, COND_Z, compiler.labelnum);
-
-	UML_FDFRINT(block, FPD32(Rn & 14), uml::mem(&m_sh2_state->m_fpul), SIZE_DWORD);
-	UML_JMP(block, compiler.labelnum+1);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum:
-
-	UML_FSFRINT(block, FPS32(Rn), uml::mem(&m_sh2_state->m_fpul), SIZE_DWORD);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum+1:
-
+	if (compiler.mode & MODE_PR)
+		UML_FDFRINT(block, FPD32(Rn & 14), uml::mem(&m_sh2_state->m_fpul), SIZE_DWORD);
+	else
+		UML_FSFRINT(block, FPS32(Rn), uml::mem(&m_sh2_state->m_fpul), SIZE_DWORD);
 	return true;
 }
 
 bool sh34_base_device::generate_group_15_op1111_0x13_FTRC(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	UML_TEST(block, uml::mem(&m_sh2_state->m_fpu_pr), 0);
-	UML_JMPc(block, COND_Z, compiler.labelnum);
-
-	UML_FDTOINT(block, uml::mem(&m_sh2_state->m_fpul), FPD32(Rn & 14), SIZE_DWORD, ROUND_TRUNC);
-	UML_JMP(block, compiler.labelnum+1);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum:
-
-	UML_FSTOINT(block, uml::mem(&m_sh2_state->m_fpul), FPS32(Rn), SIZE_DWORD, ROUND_TRUNC);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum+1:
+	if (compiler.mode & MODE_PR)
+		UML_FDTOINT(block, uml::mem(&m_sh2_state->m_fpul), FPD32(Rn & 14), SIZE_DWORD, ROUND_TRUNC);
+	else
+		UML_FSTOINT(block, uml::mem(&m_sh2_state->m_fpul), FPS32(Rn), SIZE_DWORD, ROUND_TRUNC);
 	return true;
 }
 
 bool sh34_base_device::generate_group_15_op1111_0x13_FNEG(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	UML_MOV(block, I0, 0);
-
-	UML_TEST(block, mem(&m_sh2_state->m_fpu_pr), 0);
-	UML_JMPc(block, COND_Z, compiler.labelnum);
-
-	UML_FDFRINT(block, F1, I0, SIZE_DWORD);
-	UML_FDSUB(block, FPD32(Rn), F1, FPD32(Rn));
-
-	UML_JMP(block, compiler.labelnum+1);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum:
-
-	UML_FSFRINT(block, F1, I0, SIZE_DWORD);
-	UML_FSSUB(block, FPS32(Rn), F1, FPS32(Rn));
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum+1:
+	if (compiler.mode & MODE_PR)
+		UML_FDNEG(block, FPD32(Rn), FPD32(Rn));
+	else
+		UML_FSNEG(block, FPS32(Rn), FPS32(Rn));
 	return true;
 }
 
 bool sh34_base_device::generate_group_15_op1111_0x13_FABS(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	UML_TEST(block, mem(&m_sh2_state->m_fpu_pr), 0);
-	UML_JMPc(block, COND_Z, compiler.labelnum);
-
+	if (compiler.mode & MODE_PR)
+	{
 #ifdef LSB_FIRST
-	UML_AND(block, FPS32(((Rn&14)|1)), FPS32(((Rn&14)|1)), 0x7fffffff);
+		UML_AND(block, FPS32(((Rn&14)|1)), FPS32(((Rn&14)|1)), 0x7fffffff);
 #else
-	UML_AND(block, FPS32(Rn&14), FPS32(Rn&14), 0x7fffffff);
+		UML_AND(block, FPS32(Rn&14), FPS32(Rn&14), 0x7fffffff);
 #endif
-
-	UML_JMP(block, compiler.labelnum+1);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum:
-
-	UML_AND(block, FPS32(Rn), FPS32(Rn), 0x7fffffff);
-
-	UML_LABEL(block, compiler.labelnum++);  // labelnum+1:
+	}
+	else
+	{
+		UML_AND(block, FPS32(Rn), FPS32(Rn), 0x7fffffff);
+	}
 	return true;
 }
 
@@ -3809,25 +3823,13 @@ bool sh34_base_device::generate_group_15_op1111_0x13_FSRRA(drcuml_block &block,
 
 bool sh34_base_device::generate_group_15_op1111_0x13_FLDI0(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-#ifdef LSB_FIRST
-	UML_MOV(block, I0, Rn);
-	UML_XOR(block, I0, I0, uml::mem(&m_sh2_state->m_fpu_pr));
-	UML_STORE(block, m_sh2_state->m_fr, I0, 0, SIZE_DWORD, SCALE_x4);
-#else
-	UML_MOV(block, FP_RFS(Rn), 0);
-#endif
+	UML_MOV(block, mem(&m_sh2_state->m_fr[fpu_index(compiler, Rn)]), 0);
 	return true;
 }
 
 bool sh34_base_device::generate_group_15_op1111_0x13_FLDI1(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-#ifdef LSB_FIRST
-	UML_MOV(block, I0, Rn);
-	UML_XOR(block, I0, I0, uml::mem(&m_sh2_state->m_fpu_pr));
-	UML_STORE(block, m_sh2_state->m_fr, I0, 0x3F800000, SIZE_DWORD, SCALE_x4);
-#else
-	UML_MOV(block, FP_RFS(Rn), 0x3F800000);
-#endif
+	UML_MOV(block, mem(&m_sh2_state->m_fr[fpu_index(compiler, Rn)]), 0x3F800000);
 	return true;
 }
 
@@ -3855,15 +3857,18 @@ bool sh34_base_device::generate_group_15_op1111_0x13_FCNVDS(drcuml_block &block,
 	return true;
 }
 
-void sh34_base_device::func_FIPR() { FIPR(m_sh2_state->arg0); }
-static void cfunc_FIPR(void *param) { ((sh34_base_device *)param)->func_FIPR(); };
-
 bool sh34_base_device::generate_group_15_op1111_0x13_FIPR(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	save_fast_iregs(block);
-	UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
-	UML_CALLC(block, cfunc_FIPR, this);
-	load_fast_iregs(block);
+	// FR[n+3] = FVn . FVm
+	uint32_t const m = (Rn & 3) << 2;
+	uint32_t const n = Rn & 12;
+	UML_FSMUL(block, F0, FPS32(n + 0), FPS32(m + 0));
+	for (int a = 1; a < 4; a++)
+	{
+		UML_FSMUL(block, F1, FPS32(n + a), FPS32(m + a));
+		UML_FSADD(block, F0, F0, F1);
+	}
+	UML_FSMOV(block, FPS32(n + 3), F0);
 	return true;
 }
 
@@ -3900,6 +3905,7 @@ bool sh34_base_device::generate_group_15_op1111_0x13_op1111_0xf13_FSCHG(drcuml_b
 	UML_MOV(block, uml::mem(&m_sh2_state->m_fpscr), I0);
 	UML_TEST(block, I0, SZ);
 	UML_SETc(block, COND_NZ, uml::mem(&m_sh2_state->m_fpu_sz));
+	UML_XOR(block, uml::mem(&m_sh2_state->drc_mode), uml::mem(&m_sh2_state->drc_mode), MODE_SZ);
 	return true;
 }
 
@@ -3922,15 +3928,22 @@ bool sh34_base_device::generate_group_15_op1111_0x13_op1111_0xf13_FRCHG(drcuml_b
 	return true;
 }
 
-void sh34_base_device::func_FTRV() { FTRV(m_sh2_state->arg0); }
-static void cfunc_FTRV(void *param) { ((sh34_base_device *)param)->func_FTRV(); };
-
 bool sh34_base_device::generate_group_15_op1111_0x13_op1111_0xf13_FTRV(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc)
 {
-	save_fast_iregs(block);
-	UML_MOV(block, mem(&m_sh2_state->arg0), desc->opptr.w[0]);
-	UML_CALLC(block, cfunc_FTRV, this);
-	load_fast_iregs(block);
+	// FVn = XMTRX * FVn; the sums start from +0.0 like the interpreter's
+	uint32_t const n = Rn & 12;
+	UML_FSFRINT(block, F4, 0, SIZE_DWORD);
+	for (int i = 0; i < 4; i++)
+	{
+		UML_FSMOV(block, uml::freg(i), F4);
+		for (int j = 0; j < 4; j++)
+		{
+			UML_FSMUL(block, F5, uml::mem((float *)&m_sh2_state->m_xf[(j << 2) + i]), FPS32(n + j));
+			UML_FSADD(block, uml::freg(i), uml::freg(i), F5);
+		}
+	}
+	for (int i = 0; i < 4; i++)
+		UML_FSMOV(block, FPS32(n + i), uml::freg(i));
 	return true;
 }
 
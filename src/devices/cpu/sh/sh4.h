@@ -216,7 +216,6 @@ public:
 	void func_STSFPSCR();
 	void func_FLDI0();
 	void func_FLDI1();
-	void func_FMOVFR();
 	void func_FMOVFRS0();
 	void func_FTRC();
 	void func_FMOVMRFR();
@@ -230,12 +229,9 @@ public:
 	void func_FNEG();
 	void func_FMAC();
 	void func_FABS();
-	void func_FLDS();
-	void func_FTRV();
 	void func_FSTS();
 	void func_FSSCA();
 	void func_FCNVSD();
-	void func_FIPR();
 	void func_FSRRA();
 	void func_FSQRT();
 	void func_FCNVDS();
@@ -413,6 +409,7 @@ protected:
 	void sh4_change_register_bank(int to);
 	void sh4_swap_fp_registers();
 	void sh4_swap_fp_couples();
+	void sh4_update_fpu_mode();
 	void sh4_syncronize_register_bank(int to);
 	void sh4_default_exception_priorities();
 	void sh4_exception_recompute();
@@ -623,6 +620,8 @@ protected:
 	bool generate_group_4_LDCMDBR(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc);
 	bool generate_group_4_LDCDBR(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc);
 
+	uint32_t fpu_index(const compiler_state &compiler, uint32_t n) const;
+
 	bool generate_group_15_FADD(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc);
 	bool generate_group_15_FSUB(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc);
 	bool generate_group_15_FMUL(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc, uint16_t opcode, int in_delay_slot, uint32_t ovrpc);
@@ -732,6 +731,7 @@ public:
 	sh3_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock);
 	std::unique_ptr<sh4_frontend>      m_drcfe;                  /* pointer to the DRC front-end state */
 	virtual const opcode_desc* get_desclist(offs_t pc) override;
+	virtual u64 get_deschash() override;
 	virtual void init_drc_frontend() override;
 };
 
@@ -744,6 +744,7 @@ public:
 	sh3be_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock);
 	std::unique_ptr<sh4be_frontend>      m_drcfe;                  /* pointer to the DRC front-end state */
 	virtual const opcode_desc* get_desclist(offs_t pc) override;
+	virtual u64 get_deschash() override;
 	virtual void init_drc_frontend() override;
 
 protected:
@@ -759,6 +760,7 @@ public:
 	sh4_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock);
 	std::unique_ptr<sh4_frontend>      m_drcfe;                  /* pointer to the DRC front-end state */
 	virtual const opcode_desc* get_desclist(offs_t pc) override;
+	virtual u64 get_deschash() override;
 	virtual void init_drc_frontend() override;
 
 };
@@ -772,6 +774,7 @@ public:
 	sh4be_device(const machine_config &mconfig, const char *tag, device_t *owner, uint32_t clock);
 	std::unique_ptr<sh4be_frontend>      m_drcfe;                  /* pointer to the DRC front-end state */
 	virtual const opcode_desc* get_desclist(offs_t pc) override;
+	virtual u64 get_deschash() override;
 	virtual void init_drc_frontend() override;
 
 protected:
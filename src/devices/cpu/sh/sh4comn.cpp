@@ -261,6 +261,13 @@ void sh34_base_device::sh4_swap_fp_couples()
 	}
 }
 
+void sh34_base_device::sh4_update_fpu_mode()
+{
+	m_sh2_state->m_fpu_sz = (m_sh2_state->m_fpscr & SZ) ? 1 : 0;
+	m_sh2_state->m_fpu_pr = (m_sh2_state->m_fpscr & PR) ? 1 : 0;
+	m_sh2_state->drc_mode = (m_sh2_state->m_fpu_sz ? MODE_SZ : 0) | (m_sh2_state->m_fpu_pr ? MODE_PR : 0);
+}
+
 
 void sh34_base_device::sh4_change_register_bank(int to)
 {
@@ -64,6 +64,10 @@ enum
 #define SZ  0x00100000
 #define FR  0x00200000
 
+/* DRC hash modes, from FPSCR.PR and FPSCR.SZ */
+#define MODE_PR 0x01
+#define MODE_SZ 0x02
+
 #define REGFLAG_R(n)                    (1 << (n))
 
 /* additional register flags 1 */
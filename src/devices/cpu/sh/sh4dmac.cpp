@@ -126,6 +126,14 @@ int sh34_base_device::sh4_dma_transfer(int channel, int timermode, uint32_t chcr
 	case 8: // 64 bit
 		src &= ~7;
 		dst &= ~7;
+		if(incs == 1 && incd == 1 && m_program->data_width() == 64)
+		{
+			// plain block move, let the memory system do it in bulk
+			m_program->copy_block(src, dst, count);
+			src += count * 8;
+			dst += count * 8;
+			count = 0;
+		}
 		for(;count > 0; count --)
 		{
 			if(incs == 2)
@@ -160,6 +168,13 @@ int sh34_base_device::sh4_dma_transfer(int channel, int timermode, uint32_t chcr
 	case 32:
 		src &= ~31;
 		dst &= ~31;
+		if(incs == 1 && incd == 1 && m_program->data_width() == 64)
+		{
+			m_program->copy_block(src, dst, count * 4);
+			src += count * 32;
+			dst += count * 32;
+			count = 0;
+		}
 		for(;count > 0; count --)
 		{
 			if(incs == 2)
@@ -227,8 +227,11 @@ bool sh4_frontend::describe_group_4(opcode_desc &desc, const opcode_desc *prev,
 	case 0x56:  return true; // LDSMFPUL(opcode); break; // sh4 only
 	case 0x5a:  return true; // LDSFPUL(opcode); break; // sh4 only
 	case 0x62:  return true; // STSMFPSCR(opcode); break; // sh4 only
-	case 0x66:  return true; // LDSMFPSCR(opcode); break; // sh4 only
-	case 0x6a:  return true; // LDSFPSCR(opcode); break; // sh4 only
+	case 0x66:  // LDSMFPSCR(opcode); break; // sh4 only
+	case 0x6a:  // LDSFPSCR(opcode); break; // sh4 only
+		// blocks are compiled for a fixed PR/SZ, so go back through the hash table
+		desc.flags |= OPFLAG_CAN_CHANGE_MODES | OPFLAG_END_SEQUENCE;
+		return true;
 	case 0xf2:  return true; // STCMDBR(opcode); break; // sh4 only
 	case 0xf6:  return true; // LDCMDBR(opcode); break; // sh4 only
 	case 0xfa:  return true; // LDCDBR(opcode); break; // sh4 only
@@ -296,6 +299,7 @@ bool sh4_frontend::describe_op1111_0xf13(opcode_desc &desc, const opcode_desc *p
 			switch (opcode & 0xC00)
 			{
 			case 0x000:
+				desc.flags |= OPFLAG_CAN_CHANGE_MODES | OPFLAG_END_SEQUENCE;
 				return true; //FSCHG();
 				break;
 			case 0x800:
@@ -118,6 +118,7 @@ public:
 	void sharc_cfunc_unimplemented_compute();
 	void sharc_cfunc_unimplemented_shiftimm();
 	void sharc_cfunc_write_snoop();
+	void sharc_cfunc_code_write();
 
 	void enable_recompiler();
 
@@ -422,6 +423,8 @@ private:
 
 		uint32_t force_recompile;
 		uint32_t cache_dirty;
+		uint32_t code_write_address;
+		uint32_t code_write_temp;
 	};
 
 	sharc_internal_state* m_core;
@@ -466,6 +469,10 @@ private:
 
 	bool m_enable_drc;
 
+	// program memory pages holding compiled code; the UML state tracks the blocks on each
+	static constexpr int CODE_PAGE_SHIFT = 8;
+	uint8_t m_code_pages[1 << (24 - CODE_PAGE_SHIFT)];
+
 	inline void CHANGE_PC(uint32_t newpc);
 	inline void CHANGE_PC_DELAYED(uint32_t newpc);
 	void sharc_iop_delayed_w(uint32_t reg, uint32_t data, int cycles);
@@ -621,6 +628,7 @@ private:
 	void static_generate_nocode_handler();
 	void static_generate_out_of_cycles();
 	void static_generate_memory_accessor(MEM_ACCESSOR_TYPE type, const char *name, uml::code_handle *&handleptr);
+	void static_generate_code_write_check(drcuml_block &block);
 	void static_generate_exception(uint8_t exception, const char *name);
 	void static_generate_push_pc();
 	void static_generate_pop_pc();
@@ -14,6 +14,8 @@
 #include "cpu/drcuml.h"
 #include "cpu/drcumlsh.h"
 
+#include <algorithm>
+
 #define USE_SWAPDQ  0
 
 
@@ -165,6 +167,12 @@ static void cfunc_unimplemented_shiftimm(void *param)
 	sharc->sharc_cfunc_unimplemented_shiftimm();
 }
 
+static void cfunc_code_write(void *param)
+{
+	adsp21062_device *sharc = (adsp21062_device *)param;
+	sharc->sharc_cfunc_code_write();
+}
+
 void adsp21062_device::sharc_cfunc_unimplemented()
 {
 	uint64_t op = m_core->arg64;
@@ -183,6 +191,17 @@ void adsp21062_device::sharc_cfunc_unimplemented_shiftimm()
 	fatalerror("PC=%08X: Unimplemented shiftimm %04X%08X\n", m_core->pc, (uint32_t)(op >> 32), (uint32_t)(op));
 }
 
+void adsp21062_device::sharc_cfunc_code_write()
+{
+	// only blocks that include code on the written page are stale
+	uint32_t const page = (m_core->code_write_address >> CODE_PAGE_SHIFT) & (std::size(m_code_pages) - 1);
+	m_code_pages[page] = 0;
+	m_drcuml->invalidate_code(page << CODE_PAGE_SHIFT, 1U << CODE_PAGE_SHIFT);
+
+	// the block doing the write may be one of them, so leave it at the end of the sequence
+	m_core->force_recompile = 1;
+}
+
 void adsp21062_device::sharc_cfunc_pcstack_overflow()
 {
 	fatalerror("SHARC: PCStack overflow");
@@ -309,7 +328,7 @@ void adsp21062_device::static_generate_memory_accessor(MEM_ACCESSOR_TYPE type, c
 
 		case MEM_ACCESSOR_PM_WRITE48:
 			UML_DWRITE(block, I1, I0, SIZE_QWORD, SPACE_PROGRAM);
-			UML_MOV(block, mem(&m_core->force_recompile), 1);
+			static_generate_code_write_check(block);
 			break;
 
 		case MEM_ACCESSOR_PM_READ32:
@@ -318,7 +337,7 @@ void adsp21062_device::static_generate_memory_accessor(MEM_ACCESSOR_TYPE type, c
 
 		case MEM_ACCESSOR_PM_WRITE32:
 			UML_WRITE(block, I1, I0, SIZE_DWORD, SPACE_PROGRAM);
-			UML_MOV(block, mem(&m_core->force_recompile), 1);
+			static_generate_code_write_check(block);
 			break;
 
 		case MEM_ACCESSOR_DM_READ32:
@@ -335,6 +354,25 @@ void adsp21062_device::static_generate_memory_accessor(MEM_ACCESSOR_TYPE type, c
 	block.end();
 }
 
+void adsp21062_device::static_generate_code_write_check(drcuml_block &block)
+{
+	// I0 = data written (preserved)
+	// I1 = address written
+
+	uml::code_label skip = 1;
+
+	UML_MOV(block, mem(&m_core->code_write_temp), I0);                                 // mov     [code_write_temp],i0
+	UML_SHR(block, I0, I1, CODE_PAGE_SHIFT);                                           // shr     i0,i1,CODE_PAGE_SHIFT
+	UML_AND(block, I0, I0, std::size(m_code_pages) - 1);                               // and     i0,i0,pages - 1
+	UML_LOAD(block, I0, m_code_pages, I0, SIZE_BYTE, SCALE_x1);                        // load    i0,m_code_pages,i0,byte
+	UML_TEST(block, I0, I0);                                                           // test    i0,i0
+	UML_JMPc(block, COND_Z, skip);                                                     // jz      skip
+	UML_MOV(block, mem(&m_core->code_write_address), I1);                              // mov     [code_write_address],i1
+	UML_CALLC(block, cfunc_code_write, this);                                          // callc   cfunc_code_write
+	UML_LABEL(block, skip);                                                            // skip:
+	UML_MOV(block, I0, mem(&m_core->code_write_temp));                                 // mov     i0,[code_write_temp]
+}
+
 void adsp21062_device::static_generate_push_pc()
 {
 	// Push contents of I0 to PC stack
@@ -843,7 +881,9 @@ void adsp21062_device::compile_block(offs_t pc)
 
 				/* if we don't have a hash for this mode/pc, or if we are overriding all, add one */
 				if (override || m_drcuml->hash_exists(0, seqhead->pc))
+				{
 					UML_HASH(block, 0, seqhead->pc);                                        // hash    mode,pc
+				}
 
 																							/* if we already have a hash, and this is the first sequence, assume that we */
 																							/* are recompiling due to being out of sync and allow future overrides */
@@ -867,7 +907,10 @@ void adsp21062_device::compile_block(offs_t pc)
 
 				/* iterate over instructions in the sequence and compile them */
 				for (curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+				{
 					generate_sequence_instruction(block, compiler, curdesc, false);
+					block.add_code_range(curdesc->pc, 1);
+				}
 
 				/* if we need to return to the start, do it */
 				if (seqlast->flags & OPFLAG_RETURN_TO_START)
@@ -877,10 +920,10 @@ void adsp21062_device::compile_block(offs_t pc)
 					nextpc = seqlast->pc + (seqlast->skipslots + 1);
 
 
-				// force recompilation at end of block, if needed
+				// leave the block at the end of the sequence if code was written, as it may be stale
 				UML_CMP(block, mem(&m_core->force_recompile), 0);
 				UML_JMPc(block, COND_Z, compiler.labelnum);
-				UML_MOV(block, mem(&m_core->cache_dirty), 1);
+				UML_MOV(block, mem(&m_core->force_recompile), 0);
 				UML_MOV(block, mem(&m_core->icount), 0);
 				UML_LABEL(block, compiler.labelnum++);
 
@@ -900,6 +943,10 @@ void adsp21062_device::compile_block(offs_t pc)
 			flush_cache();
 		}
 	}
+
+	// writes to the pages the block covers need to be checked
+	for (const opcode_desc *curdesc = desclist; curdesc != nullptr; curdesc = curdesc->next())
+		m_code_pages[(curdesc->pc >> CODE_PAGE_SHIFT) & (std::size(m_code_pages) - 1)] = 1;
 }
 
 
@@ -907,6 +954,7 @@ void adsp21062_device::flush_cache()
 {
 	/* empty the transient cache contents */
 	m_drcuml->reset();
+	std::fill(std::begin(m_code_pages), std::end(m_code_pages), 0);
 
 	try
 	{
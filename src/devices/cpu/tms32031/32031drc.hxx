@@ -0,0 +1,1136 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    32031drc.hxx
+
+    Universal machine language-based TMS320C3x emulator.
+
+    Program flow (branches, calls, returns, decrement and branch, the
+    delayed forms with their three delay slots generated inline), the
+    condition codes, RPTB/RPTS repeats and the check made at the end of
+    a repeated block, integer and floating point loads and stores with
+    direct and the common indirect addressing modes are generated as
+    UML.  Conversions between registers and the packed 32-bit memory
+    format and short immediate floats are done inline or at compile
+    time; floating point arithmetic and everything else runs the
+    interpreter's own handlers through a C helper, so results can't
+    differ from the interpreter, which is still used unless the driver
+    calls enable_recompiler().
+
+    Like the interpreter, interrupts are only taken at the start of a
+    timeslice or when a register write unmasks them, and are held off
+    through delay slots and RPTS.  Timeslices started in low power mode
+    are interpreted, since every cycle costs sixteen there.
+
+***************************************************************************/
+
+#include "cpu/drcumlsh.h"
+
+
+namespace {
+
+// size of the code cache
+constexpr u32 CACHE_SIZE                = 4 * 1024 * 1024;
+
+// compilation boundaries -- how far back/forward does the analysis extend?
+constexpr u32 COMPILE_BACKWARDS_BYTES   = 128;
+constexpr u32 COMPILE_FORWARDS_BYTES    = 512;
+constexpr u32 COMPILE_MAX_INSTRUCTIONS  = (COMPILE_BACKWARDS_BYTES + COMPILE_FORWARDS_BYTES) / 4;
+constexpr u32 COMPILE_MAX_SEQUENCE      = 64;
+
+// exit codes
+constexpr int EXECUTE_OUT_OF_CYCLES     = 0;
+constexpr int EXECUTE_MISSING_CODE      = 1;
+constexpr int EXECUTE_UNMAPPED_CODE     = 2;
+constexpr int EXECUTE_RESET_CACHE       = 3;
+constexpr int EXECUTE_LOW_POWER         = 4;
+
+} // anonymous namespace
+
+
+// map variables
+#define MAPVAR_PC                       uml::M0
+#define MAPVAR_CYCLES                   uml::M1
+
+
+
+/***************************************************************************
+    C HELPERS
+***************************************************************************/
+
+void tms3203x_device::cfunc_execute_op(void *param)
+{
+	reinterpret_cast<tms3203x_device *>(param)->drc_execute_op();
+}
+
+void tms3203x_device::cfunc_end_delay(void *param)
+{
+	reinterpret_cast<tms3203x_device *>(param)->drc_end_delay();
+}
+
+
+//-------------------------------------------------
+//  drc_execute_op - run one instruction through
+//  the interpreter, with m_pc already advanced
+//-------------------------------------------------
+
+void tms3203x_device::drc_execute_op()
+{
+	uint32_t const op = m_drc_op;
+	(this->*s_tms32031ops[op >> 21])(op);
+
+	// a repeat may have been set up by writing the registers directly
+	if (IREG(TMR_ST) & RMFLAG)
+		m_drcfe->add_repeat_end(IREG(TMR_RE) + 1);
+}
+
+
+//-------------------------------------------------
+//  drc_end_delay - let interrupts through again
+//  once delay slots or a single instruction
+//  repeat are done
+//-------------------------------------------------
+
+void tms3203x_device::drc_end_delay()
+{
+	m_delayed = false;
+	if (m_irq_pending)
+	{
+		m_irq_pending = false;
+		check_irqs();
+	}
+}
+
+
+
+/***************************************************************************
+    CORE EXECUTION
+***************************************************************************/
+
+//-------------------------------------------------
+//  enable_recompiler - use the recompiler rather
+//  than the interpreter, if allowed
+//-------------------------------------------------
+
+void tms3203x_device::enable_recompiler()
+{
+	m_enable_drc = allow_drc();
+}
+
+
+//-------------------------------------------------
+//  init_recompiler - set up the recompiler the
+//  first time it's used
+//-------------------------------------------------
+
+void tms3203x_device::init_recompiler()
+{
+	m_drccache = std::make_unique<drc_cache>(CACHE_SIZE);
+	m_drcuml = std::make_unique<drcuml_state>(*this, *m_drccache, 0, 1, 24, 0);
+
+	// add UML symbols
+	m_drcuml->symbol_add(&m_pc, sizeof(m_pc), "pc");
+	m_drcuml->symbol_add(&m_icount, sizeof(m_icount), "icount");
+	for (int i = 0; i < 8; i++)
+	{
+		m_drcuml->symbol_add(&m_r[TMR_R0 + i], sizeof(m_r[0]), util::string_format("r%d", i).c_str());
+		m_drcuml->symbol_add(&m_r[TMR_AR0 + i], sizeof(m_r[0]), util::string_format("ar%d", i).c_str());
+	}
+	m_drcuml->symbol_add(&m_r[TMR_DP], sizeof(m_r[0]), "dp");
+	m_drcuml->symbol_add(&m_r[TMR_SP], sizeof(m_r[0]), "sp");
+	m_drcuml->symbol_add(&m_r[TMR_ST], sizeof(m_r[0]), "st");
+	m_drcuml->symbol_add(&m_r[TMR_RS], sizeof(m_r[0]), "rs");
+	m_drcuml->symbol_add(&m_r[TMR_RE], sizeof(m_r[0]), "re");
+	m_drcuml->symbol_add(&m_r[TMR_RC], sizeof(m_r[0]), "rc");
+
+	m_drcfe = std::make_unique<tms3203x_frontend>(*this, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, COMPILE_MAX_SEQUENCE);
+
+	// compiled code goes stale when it's overwritten
+	m_drc_code = std::make_unique<uint32_t []>(1 << (24 - 5));
+	m_drc_code_tap = space(AS_PROGRAM).install_write_tap(
+			0, 0xffffff,
+			"tms3203x_drc_code_w",
+			[this] (offs_t offset, u32 &data, u32 mem_mask)
+			{
+				offset &= 0xffffff;
+				if (BIT(m_drc_code[offset >> 5], offset & 31))
+					m_drc_flush = 1;
+			},
+			&m_drc_code_tap);
+
+	m_drc_flush = 1;
+}
+
+
+//-------------------------------------------------
+//  execute_run_drc - execute generated code until
+//  the timeslice runs out or low power mode is
+//  entered
+//-------------------------------------------------
+
+void tms3203x_device::execute_run_drc()
+{
+	if (!m_drcuml)
+		init_recompiler();
+
+	// a repeat started elsewhere needs its end checked too
+	if (IREG(TMR_ST) & RMFLAG)
+		m_drcfe->add_repeat_end(IREG(TMR_RE) + 1);
+
+	// reset the cache if dirty
+	if (m_drc_flush)
+		flush_cache();
+
+	// execute
+	int execute_result;
+	do
+	{
+		execute_result = m_drcuml->execute(*m_entry);
+
+		// if we need to recompile, do it
+		if (execute_result == EXECUTE_MISSING_CODE)
+			compile_block(m_pc);
+		else if (execute_result == EXECUTE_UNMAPPED_CODE)
+			fatalerror("Attempted to execute unmapped code at PC=%06X\n", m_pc);
+		else if (execute_result == EXECUTE_RESET_CACHE)
+			flush_cache();
+		else if (execute_result == EXECUTE_LOW_POWER)
+			return;
+	} while (execute_result != EXECUTE_OUT_OF_CYCLES);
+}
+
+
+//-------------------------------------------------
+//  flush_cache - throw away all generated code
+//  and regenerate the static handlers
+//-------------------------------------------------
+
+void tms3203x_device::flush_cache()
+{
+	// empty the transient cache contents
+	m_drcuml->reset();
+	std::fill_n(m_drc_code.get(), 1 << (24 - 5), 0);
+	m_drc_flush = 0;
+
+	try
+	{
+		// generate the entry point and exception handlers
+		static_generate_entry_point();
+		static_generate_nocode_handler();
+		static_generate_out_of_cycles();
+	}
+	catch (drcuml_block::abort_compilation &)
+	{
+		fatalerror("Error generating TMS3203x static handlers\n");
+	}
+}
+
+
+//-------------------------------------------------
+//  compile_block - compile a block of code
+//  starting at the given PC
+//-------------------------------------------------
+
+void tms3203x_device::compile_block(offs_t pc)
+{
+	// describe the block; a repeat end found for the first time may have
+	// been compiled already without its check
+	const opcode_desc *desclist = m_drcfe->describe_code(pc);
+	if (m_drc_flush)
+		flush_cache();
+
+	bool override = false;
+	for (;;)
+	{
+		try
+		{
+			compiler_state compiler = { 0, 1, false };
+			const opcode_desc *seqlast;
+
+			drcuml_block &block(m_drcuml->begin_block(COMPILE_MAX_INSTRUCTIONS * 64));
+
+			for (const opcode_desc *seqhead = desclist; seqhead != nullptr; seqhead = seqlast->next())
+			{
+				// determine the last instruction in this sequence
+				for (seqlast = seqhead; seqlast != nullptr; seqlast = seqlast->next())
+					if (seqlast->flags & OPFLAG_END_SEQUENCE)
+						break;
+				assert(seqlast != nullptr);
+
+				// if we don't have a hash for this mode/pc, or if we are overriding all, add one
+				if (override || !m_drcuml->hash_exists(0, seqhead->pc))
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,seqhead->pc
+
+				// if we already have a hash, and this is the first sequence, assume that we
+				// are recompiling due to being out of sync and allow future overrides
+				else if (seqhead == desclist)
+				{
+					override = true;
+					UML_HASH(block, 0, seqhead->pc);                                        // hash    0,seqhead->pc
+				}
+
+				// otherwise, redispatch to that fixed PC and skip the rest of the processing
+				else
+				{
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc
+					UML_HASHJMP(block, 0, seqhead->pc, *m_nocode);                          // hashjmp 0,seqhead->pc,nocode
+					continue;
+				}
+
+				// label this instruction, if it may be jumped to locally
+				if (seqhead->flags & OPFLAG_IS_BRANCH_TARGET)
+					UML_LABEL(block, seqhead->pc | 0x80000000);                             // label   seqhead->pc
+
+				// iterate over instructions in the sequence and compile them
+				for (const opcode_desc *curdesc = seqhead; curdesc != seqlast->next(); curdesc = curdesc->next())
+					generate_sequence_instruction(block, compiler, curdesc);
+
+				// count off cycles and go to the next instruction, past any delay slots
+				uint32_t const nextpc = (seqlast->pc + 1 + seqlast->skipslots) & 0xffffff;
+				generate_update_cycles(block, compiler, nextpc);                            // <subtract cycles>
+				if (seqlast->next() == nullptr || seqlast->next()->pc != nextpc)
+					UML_HASHJMP(block, 0, nextpc, *m_nocode);                               // hashjmp 0,nextpc,nocode
+			}
+
+			block.end();
+			break;
+		}
+		catch (drcuml_block::abort_compilation &)
+		{
+			flush_cache();
+		}
+	}
+
+	// note what was compiled so writes to it can be caught
+	for (const opcode_desc *curdesc = desclist; curdesc != nullptr; curdesc = curdesc->next())
+	{
+		m_drc_code[(curdesc->pc >> 5) & 0x7ffff] |= 1U << (curdesc->pc & 31);
+		for (const opcode_desc *slot = curdesc->delay.first(); slot != nullptr; slot = slot->next())
+			m_drc_code[(slot->pc >> 5) & 0x7ffff] |= 1U << (slot->pc & 31);
+	}
+}
+
+
+
+/***************************************************************************
+    STATIC CODEGEN
+***************************************************************************/
+
+//-------------------------------------------------
+//  static_generate_entry_point - generate a
+//  static entry point
+//-------------------------------------------------
+
+void tms3203x_device::static_generate_entry_point()
+{
+	drcuml_block &block(m_drcuml->begin_block(20));
+
+	// forward references
+	if (!m_nocode)
+		m_nocode = m_drcuml->handle_alloc("nocode");
+
+	if (!m_entry)
+		m_entry = m_drcuml->handle_alloc("entry");
+	UML_HANDLE(block, *m_entry);                                                            // handle  entry
+
+	// generate a hash jump via the current PC
+	UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[pc]
+	UML_AND(block, I0, I0, 0xffffff);                                                       // and     i0,i0,0xffffff
+	UML_HASHJMP(block, 0, I0, *m_nocode);                                                   // hashjmp 0,i0,nocode
+
+	block.end();
+}
+
+
+//-------------------------------------------------
+//  static_generate_nocode_handler - generate an
+//  exception handler for "out of code"
+//-------------------------------------------------
+
+void tms3203x_device::static_generate_nocode_handler()
+{
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	UML_HANDLE(block, *m_nocode);                                                           // handle  nocode
+	UML_GETEXP(block, I0);                                                                  // getexp  i0
+	UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x1);                                   // store   [pc],i0
+	UML_EXIT(block, EXECUTE_MISSING_CODE);                                                  // exit    EXECUTE_MISSING_CODE
+
+	block.end();
+}
+
+
+//-------------------------------------------------
+//  static_generate_out_of_cycles - generate an
+//  out of cycles exception handler
+//-------------------------------------------------
+
+void tms3203x_device::static_generate_out_of_cycles()
+{
+	drcuml_block &block(m_drcuml->begin_block(10));
+
+	if (!m_out_of_cycles)
+		m_out_of_cycles = m_drcuml->handle_alloc("out_of_cycles");
+	UML_HANDLE(block, *m_out_of_cycles);                                                    // handle  out_of_cycles
+	UML_GETEXP(block, I0);                                                                  // getexp  i0
+	UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x1);                                   // store   [pc],i0
+	UML_EXIT(block, EXECUTE_OUT_OF_CYCLES);                                                 // exit    EXECUTE_OUT_OF_CYCLES
+
+	block.end();
+}
+
+
+
+/***************************************************************************
+    CODE GENERATION
+***************************************************************************/
+
+//-------------------------------------------------
+//  generate_sequence_instruction - generate code
+//  for a single instruction in a sequence
+//-------------------------------------------------
+
+void tms3203x_device::generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	bool const in_delay_slot = (desc->flags & OPFLAG_IN_DELAY_SLOT) != 0;
+
+	// set the PC map variable
+	UML_MAPVAR(block, MAPVAR_PC, desc->pc);                                                 // mapvar  PC,desc->pc
+
+	// the end of a repeat is checked before the instruction after it, and
+	// costs nothing; like the interpreter, delay slots are exempt
+	if (!in_delay_slot && m_drcfe->is_repeat_end(desc->pc))
+		generate_repeat_end(block, compiler, desc);
+
+	// accumulate total cycles
+	compiler.cycles += desc->cycles;
+
+	// update the icount map variable
+	UML_MAPVAR(block, MAPVAR_CYCLES, compiler.cycles);                                      // mapvar  CYCLES,compiler.cycles
+
+	// if we are debugging, call the debugger
+	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) != 0)
+	{
+		UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x1);                         // store   [pc],desc->pc
+		UML_DEBUG(block, desc->pc);                                                         // debug   desc->pc
+	}
+
+	// if we hit an unmapped address, fatal error
+	if (desc->flags & OPFLAG_COMPILER_UNMAPPED)
+	{
+		UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x1);                         // store   [pc],desc->pc
+		UML_EXIT(block, EXECUTE_UNMAPPED_CODE);                                             // exit    EXECUTE_UNMAPPED_CODE
+		return;
+	}
+
+	// compile the instruction, running anything not handled through the interpreter
+	compiler.check_pc = false;
+	if (!generate_opcode(block, compiler, desc))
+		generate_generic(block, compiler, desc);
+
+	// leave if we're not going to the next instruction; delay slots
+	// always go on to the next one
+	if (compiler.check_pc && !in_delay_slot)
+		generate_check_pc(block, compiler, desc);
+}
+
+
+//-------------------------------------------------
+//  generate_update_cycles - generate code to
+//  subtract cycles from the icount and generate
+//  an exception if out
+//-------------------------------------------------
+
+void tms3203x_device::generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param)
+{
+	// account for cycles; like the interpreter, stop once the count isn't positive
+	if (compiler.cycles > 0)
+	{
+		UML_LOAD(block, I1, &m_icount, 0, SIZE_DWORD, SCALE_x1);                            // load    i1,[icount]
+		UML_SUB(block, I1, I1, compiler.cycles);                                            // sub     i1,i1,cycles
+		UML_STORE(block, &m_icount, 0, I1, SIZE_DWORD, SCALE_x1);                           // store   [icount],i1
+		UML_MAPVAR(block, MAPVAR_CYCLES, 0);                                                // mapvar  cycles,0
+		UML_CMP(block, I1, 0);                                                              // cmp     i1,0
+		UML_EXHc(block, COND_LE, *m_out_of_cycles, param);                                  // exh     out_of_cycles,param
+	}
+	compiler.cycles = 0;
+}
+
+
+//-------------------------------------------------
+//  generate_branch - generate code to go to the
+//  target of an immediate branch or call
+//-------------------------------------------------
+
+void tms3203x_device::generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	// the taken path accounts for its cycles separately from the fall
+	// through; branches that aren't delayed cost three more
+	compiler_state compiler_temp(compiler);
+	if (desc->delayslots == 0)
+		compiler_temp.cycles += 3;
+	generate_update_cycles(block, compiler_temp, desc->targetpc);                           // <subtract cycles>
+
+	if (desc->flags & OPFLAG_INTRABLOCK_BRANCH)
+		UML_JMP(block, desc->targetpc | 0x80000000);                                        // jmp     targetpc | 0x80000000
+	else
+		UML_HASHJMP(block, 0, desc->targetpc, *m_nocode);                                   // hashjmp 0,targetpc,nocode
+}
+
+
+//-------------------------------------------------
+//  generate_delayed_branch - generate the delay
+//  slots of a delayed branch, then the branch;
+//  conditional branches leave whether they're
+//  taken in m_drc_taken
+//-------------------------------------------------
+
+void tms3203x_device::generate_delayed_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	bool const conditional = (desc->flags & OPFLAG_IS_CONDITIONAL_BRANCH) != 0;
+	uint32_t const nextpc = (desc->pc + 4) & 0xffffff;
+	uml::code_label const noirq = compiler.labelnum++;
+	uml::code_label const skip = compiler.labelnum++;
+
+	// interrupts wait until the delay slots are done
+	UML_STORE(block, &m_delayed, 0, 1, SIZE_BYTE, SCALE_x1);                                // store   [delayed],1
+	for (const opcode_desc *slot = desc->delay.first(); slot != nullptr; slot = slot->next())
+		generate_sequence_instruction(block, compiler, slot);
+	UML_STORE(block, &m_delayed, 0, 0, SIZE_BYTE, SCALE_x1);                                // store   [delayed],0
+
+	// one that came in meanwhile is taken at the destination
+	UML_LOAD(block, I0, &m_irq_pending, 0, SIZE_BYTE, SCALE_x1);                            // load    i0,[irq_pending]
+	UML_CMP(block, I0, 0);                                                                  // cmp     i0,0
+	UML_JMPc(block, COND_E, noirq);                                                         // je      noirq
+	if (conditional)
+	{
+		UML_MOV(block, I0, nextpc);                                                         // mov     i0,nextpc
+		UML_LOAD(block, I1, &m_drc_taken, 0, SIZE_DWORD, SCALE_x1);                         // load    i1,[drc_taken]
+		UML_CMP(block, I1, 0);                                                              // cmp     i1,0
+		UML_MOVc(block, COND_NE, I0, desc->targetpc);                                       // mov     i0,targetpc,ne
+		UML_STORE(block, &m_pc, 0, I0, SIZE_DWORD, SCALE_x1);                               // store   [pc],i0
+	}
+	else
+		UML_STORE(block, &m_pc, 0, desc->targetpc, SIZE_DWORD, SCALE_x1);                   // store   [pc],targetpc
+	UML_CALLC(block, cfunc_end_delay, this);                                                // callc   cfunc_end_delay,this
+	UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[pc]
+	UML_AND(block, I0, I0, 0xffffff);                                                       // and     i0,i0,0xffffff
+	{
+		compiler_state compiler_temp(compiler);
+		generate_update_cycles(block, compiler_temp, uml::I0);                              // <subtract cycles>
+	}
+	UML_HASHJMP(block, 0, I0, *m_nocode);                                                   // hashjmp 0,i0,nocode
+	UML_LABEL(block, noirq);                                                                // noirq:
+
+	// otherwise go to the target, or fall through to the instruction after the slots
+	if (conditional)
+	{
+		UML_LOAD(block, I0, &m_drc_taken, 0, SIZE_DWORD, SCALE_x1);                         // load    i0,[drc_taken]
+		UML_CMP(block, I0, 0);                                                              // cmp     i0,0
+		UML_JMPc(block, COND_E, skip);                                                      // je      skip
+	}
+	generate_branch(block, compiler, desc);
+	UML_LABEL(block, skip);                                                                 // skip:
+}
+
+
+//-------------------------------------------------
+//  generate_repeat_end - generate the check made
+//  at the address after the end of a repeat
+//-------------------------------------------------
+
+void tms3203x_device::generate_repeat_end(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uml::code_label const skip = compiler.labelnum++;
+	uml::code_label const expired = compiler.labelnum++;
+
+	UML_LOAD(block, I0, &IREG(TMR_ST), 0, SIZE_DWORD, SCALE_x1);                            // load    i0,[st]
+	UML_TEST(block, I0, RMFLAG);                                                            // test    i0,RMFLAG
+	UML_JMPc(block, COND_Z, skip);                                                          // jz      skip
+	UML_LOAD(block, I1, &IREG(TMR_RE), 0, SIZE_DWORD, SCALE_x1);                            // load    i1,[re]
+	UML_ADD(block, I1, I1, 1);                                                              // add     i1,i1,1
+	UML_CMP(block, I1, desc->pc);                                                           // cmp     i1,desc->pc
+	UML_JMPc(block, COND_NE, skip);                                                         // jne     skip
+
+	// go round again while the count hasn't gone negative
+	UML_LOAD(block, I1, &IREG(TMR_RC), 0, SIZE_DWORD, SCALE_x1);                            // load    i1,[rc]
+	UML_SUB(block, I1, I1, 1);                                                              // sub     i1,i1,1
+	UML_STORE(block, &IREG(TMR_RC), 0, I1, SIZE_DWORD, SCALE_x1);                           // store   [rc],i1
+	UML_CMP(block, I1, 0);                                                                  // cmp     i1,0
+	UML_JMPc(block, COND_L, expired);                                                       // jl      expired
+	UML_LOAD(block, I0, &IREG(TMR_RS), 0, SIZE_DWORD, SCALE_x1);                            // load    i0,[rs]
+	UML_AND(block, I0, I0, 0xffffff);                                                       // and     i0,i0,0xffffff
+	{
+		compiler_state compiler_temp(compiler);
+		generate_update_cycles(block, compiler_temp, uml::I0);                              // <subtract cycles>
+	}
+	UML_HASHJMP(block, 0, I0, *m_nocode);                                                   // hashjmp 0,i0,nocode
+
+	// the repeat is over; an RPTS also lets interrupts through again
+	UML_LABEL(block, expired);                                                              // expired:
+	UML_AND(block, I0, I0, ~uint32_t(RMFLAG));                                                      // and     i0,i0,~RMFLAG
+	UML_STORE(block, &IREG(TMR_ST), 0, I0, SIZE_DWORD, SCALE_x1);                           // store   [st],i0
+	UML_LOAD(block, I0, &m_delayed, 0, SIZE_BYTE, SCALE_x1);                                // load    i0,[delayed]
+	UML_CMP(block, I0, 0);                                                                  // cmp     i0,0
+	UML_JMPc(block, COND_E, skip);                                                          // je      skip
+	UML_STORE(block, &m_pc, 0, desc->pc, SIZE_DWORD, SCALE_x1);                             // store   [pc],desc->pc
+	UML_CALLC(block, cfunc_end_delay, this);                                                // callc   cfunc_end_delay,this
+
+	// which may take an interrupt
+	UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[pc]
+	UML_CMP(block, I0, desc->pc);                                                           // cmp     i0,desc->pc
+	UML_JMPc(block, COND_E, skip);                                                          // je      skip
+	UML_AND(block, I0, I0, 0xffffff);                                                       // and     i0,i0,0xffffff
+	{
+		compiler_state compiler_temp(compiler);
+		generate_update_cycles(block, compiler_temp, uml::I0);                              // <subtract cycles>
+	}
+	UML_HASHJMP(block, 0, I0, *m_nocode);                                                   // hashjmp 0,i0,nocode
+
+	UML_LABEL(block, skip);                                                                 // skip:
+}
+
+
+//-------------------------------------------------
+//  generate_check_pc - generate code to leave the
+//  block if m_pc isn't the next instruction
+//-------------------------------------------------
+
+void tms3203x_device::generate_check_pc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uml::code_label const skip = compiler.labelnum++;
+
+	UML_LOAD(block, I0, &m_pc, 0, SIZE_DWORD, SCALE_x1);                                    // load    i0,[pc]
+	UML_CMP(block, I0, (desc->pc + 1) & 0xffffff);                                          // cmp     i0,desc->pc + 1
+	UML_JMPc(block, COND_E, skip);                                                          // je      skip
+
+	UML_AND(block, I0, I0, 0xffffff);                                                       // and     i0,i0,0xffffff
+	compiler_state compiler_temp(compiler);
+	generate_update_cycles(block, compiler_temp, uml::I0);                                  // <subtract cycles>
+	UML_HASHJMP(block, 0, I0, *m_nocode);                                                   // hashjmp 0,i0,nocode
+
+	UML_LABEL(block, skip);                                                                 // skip:
+}
+
+
+//-------------------------------------------------
+//  generate_condition - generate code to skip to
+//  the given label if a condition isn't met
+//-------------------------------------------------
+
+void tms3203x_device::generate_condition(drcuml_block &block, compiler_state &compiler, int condition, uml::code_label skip)
+{
+	// unconditional
+	condition &= 31;
+	if (condition == 0)
+		return;
+
+	UML_LOAD(block, I0, &IREG(TMR_ST), 0, SIZE_DWORD, SCALE_x1);                            // load    i0,[st]
+	UML_AND(block, I0, I0, LUFFLAG | LVFLAG | UFFLAG | NFLAG | ZFLAG | VFLAG | CFLAG);       // and     i0,i0,flags
+	UML_LOAD(block, I0, condition_table, I0, SIZE_DWORD, SCALE_x4);                       // load    i0,condition_table,i0
+	UML_TEST(block, I0, 1 << condition);                                                    // test    i0,1 << condition
+	UML_JMPc(block, COND_Z, skip);                                                          // jz      skip
+}
+
+
+//-------------------------------------------------
+//  generate_decrement_branch - generate the
+//  auxiliary register decrement for DBcond, then
+//  skip to the given label if it doesn't branch
+//-------------------------------------------------
+
+void tms3203x_device::generate_decrement_branch(drcuml_block &block, compiler_state &compiler, uint32_t op, uml::code_label skip)
+{
+	int const reg = TMR_AR0 + ((op >> 22) & 7);
+
+	// only the low 24 bits count down
+	UML_LOAD(block, I0, &IREG(reg), 0, SIZE_DWORD, SCALE_x1);                               // load    i0,[ar]
+	UML_SUB(block, I1, I0, 1);                                                              // sub     i1,i0,1
+	UML_AND(block, I1, I1, 0xffffff);                                                       // and     i1,i1,0xffffff
+	UML_AND(block, I0, I0, 0xff000000);                                                     // and     i0,i0,0xff000000
+	UML_OR(block, I0, I0, I1);                                                              // or      i0,i0,i1
+	UML_STORE(block, &IREG(reg), 0, I0, SIZE_DWORD, SCALE_x1);                              // store   [ar],i0
+	UML_TEST(block, I1, 0x800000);                                                          // test    i1,0x800000
+	UML_JMPc(block, COND_NZ, skip);                                                         // jnz     skip
+
+	generate_condition(block, compiler, op >> 16, skip);
+}
+
+
+//-------------------------------------------------
+//  generate_generic - generate code to run an
+//  instruction through the interpreter
+//-------------------------------------------------
+
+void tms3203x_device::generate_generic(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	UML_STORE(block, &m_pc, 0, (desc->pc + 1) & 0xffffff, SIZE_DWORD, SCALE_x1);           // store   [pc],desc->pc + 1
+	UML_STORE(block, &m_drc_op, 0, desc->opptr.l[0], SIZE_DWORD, SCALE_x1);                 // store   [drc_op],op
+	UML_CALLC(block, cfunc_execute_op, this);                                               // callc   cfunc_execute_op,this
+
+	// it may have branched, taken an interrupt, written code, or set up a repeat
+	compiler.check_pc = true;
+	generate_code_write_check(block, compiler, desc);
+}
+
+
+//-------------------------------------------------
+//  generate_indirect - generate code to leave an
+//  indirect address in I0 for the simple
+//  displacement modes; returns false for the
+//  others
+//-------------------------------------------------
+
+bool tms3203x_device::generate_indirect(drcuml_block &block, uint32_t op)
+{
+	int const reg = TMR_AR0 + ((op >> 8) & 7);
+	uint32_t const disp = op & 0xff;
+
+	switch ((op >> 11) & 31)
+	{
+		case 0x00:
+			// *+ARn(disp)
+			UML_LOAD(block, I0, &IREG(reg), 0, SIZE_DWORD, SCALE_x1);                       // load    i0,[ar]
+			UML_ADD(block, I0, I0, disp);                                                   // add     i0,i0,disp
+			return true;
+
+		case 0x01:
+			// *-ARn(disp)
+			UML_LOAD(block, I0, &IREG(reg), 0, SIZE_DWORD, SCALE_x1);                       // load    i0,[ar]
+			UML_SUB(block, I0, I0, disp);                                                   // sub     i0,i0,disp
+			return true;
+
+		case 0x02:
+			// *++ARn(disp)
+			UML_LOAD(block, I0, &IREG(reg), 0, SIZE_DWORD, SCALE_x1);                       // load    i0,[ar]
+			UML_ADD(block, I0, I0, disp);                                                   // add     i0,i0,disp
+			UML_STORE(block, &IREG(reg), 0, I0, SIZE_DWORD, SCALE_x1);                      // store   [ar],i0
+			return true;
+
+		case 0x03:
+			// *--ARn(disp)
+			UML_LOAD(block, I0, &IREG(reg), 0, SIZE_DWORD, SCALE_x1);                       // load    i0,[ar]
+			UML_SUB(block, I0, I0, disp);                                                   // sub     i0,i0,disp
+			UML_STORE(block, &IREG(reg), 0, I0, SIZE_DWORD, SCALE_x1);                      // store   [ar],i0
+			return true;
+
+		case 0x04:
+			// *ARn++(disp)
+			UML_LOAD(block, I0, &IREG(reg), 0, SIZE_DWORD, SCALE_x1);                       // load    i0,[ar]
+			UML_ADD(block, I1, I0, disp);                                                   // add     i1,i0,disp
+			UML_STORE(block, &IREG(reg), 0, I1, SIZE_DWORD, SCALE_x1);                      // store   [ar],i1
+			return true;
+
+		case 0x05:
+			// *ARn--(disp)
+			UML_LOAD(block, I0, &IREG(reg), 0, SIZE_DWORD, SCALE_x1);                       // load    i0,[ar]
+			UML_SUB(block, I1, I0, disp);                                                   // sub     i1,i0,disp
+			UML_STORE(block, &IREG(reg), 0, I1, SIZE_DWORD, SCALE_x1);                      // store   [ar],i1
+			return true;
+
+		default:
+			// the circular, index register and bit reversed modes are left to the interpreter
+			return false;
+	}
+}
+
+
+//-------------------------------------------------
+//  generate_direct - generate code to leave a
+//  direct address in I0
+//-------------------------------------------------
+
+static inline void generate_direct(drcuml_block &block, const uint32_t *dp, uint32_t op)
+{
+	UML_LOAD(block, I0, dp, 0, SIZE_DWORD, SCALE_x1);                                       // load    i0,[dp]
+	UML_AND(block, I0, I0, 0xff);                                                           // and     i0,i0,0xff
+	UML_SHL(block, I0, I0, 16);                                                             // shl     i0,i0,16
+	UML_OR(block, I0, I0, uint16_t(op));                                                    // or      i0,i0,op & 0xffff
+}
+
+
+//-------------------------------------------------
+//  generate_set_nz - generate code to set N and Z
+//  for an integer load, clearing V and UF
+//-------------------------------------------------
+
+void tms3203x_device::generate_set_nz(drcuml_block &block, uml::parameter src)
+{
+	UML_LOAD(block, I1, &IREG(TMR_ST), 0, SIZE_DWORD, SCALE_x1);                            // load    i1,[st]
+	UML_AND(block, I1, I1, ~uint32_t(NFLAG | ZFLAG | VFLAG | UFFLAG));                            // and     i1,i1,~(N|Z|V|UF)
+	if (src.is_immediate())
+	{
+		// known at compile time
+		uint32_t const value = src.immediate();
+		uint32_t const flags = ((value >> 28) & NFLAG) | ((value == 0) ? ZFLAG : 0);
+		if (flags != 0)
+			UML_OR(block, I1, I1, flags);                                                   // or      i1,i1,flags
+	}
+	else
+	{
+		UML_SHR(block, I2, src, 28);                                                        // shr     i2,src,28
+		UML_AND(block, I2, I2, NFLAG);                                                      // and     i2,i2,NFLAG
+		UML_OR(block, I1, I1, I2);                                                          // or      i1,i1,i2
+		UML_CMP(block, src, 0);                                                             // cmp     src,0
+		UML_SETc(block, COND_E, I2);                                                        // set     i2,e
+		UML_SHL(block, I2, I2, 2);                                                          // shl     i2,i2,2
+		UML_OR(block, I1, I1, I2);                                                          // or      i1,i1,i2
+	}
+	UML_STORE(block, &IREG(TMR_ST), 0, I1, SIZE_DWORD, SCALE_x1);                           // store   [st],i1
+}
+
+
+//-------------------------------------------------
+//  generate_set_nzf - generate code to set N and
+//  Z for a floating point load, clearing V and UF
+//-------------------------------------------------
+
+void tms3203x_device::generate_set_nzf(drcuml_block &block, int reg)
+{
+	UML_LOAD(block, I2, &IREG(TMR_ST), 0, SIZE_DWORD, SCALE_x1);                            // load    i2,[st]
+	UML_AND(block, I2, I2, ~uint32_t(NFLAG | ZFLAG | VFLAG | UFFLAG));                            // and     i2,i2,~(N|Z|V|UF)
+	UML_LOAD(block, I0, &m_r[reg].i32[0], 0, SIZE_DWORD, SCALE_x1);                         // load    i0,[reg.mantissa]
+	UML_SHR(block, I0, I0, 28);                                                             // shr     i0,i0,28
+	UML_AND(block, I0, I0, NFLAG);                                                          // and     i0,i0,NFLAG
+	UML_OR(block, I2, I2, I0);                                                              // or      i2,i2,i0
+
+	// zero is the smallest exponent
+	UML_LOAD(block, I0, &m_r[reg].i32[1], 0, SIZE_DWORD, SCALE_x1);                         // load    i0,[reg.exponent]
+	UML_AND(block, I0, I0, 0xff);                                                           // and     i0,i0,0xff
+	UML_CMP(block, I0, 0x80);                                                               // cmp     i0,0x80
+	UML_SETc(block, COND_E, I0);                                                            // set     i0,e
+	UML_SHL(block, I0, I0, 2);                                                              // shl     i0,i0,2
+	UML_OR(block, I2, I2, I0);                                                              // or      i2,i2,i0
+	UML_STORE(block, &IREG(TMR_ST), 0, I2, SIZE_DWORD, SCALE_x1);                           // store   [st],i2
+}
+
+
+//-------------------------------------------------
+//  generate_code_write_check - generate code to
+//  leave the block if compiled code was
+//  overwritten
+//-------------------------------------------------
+
+void tms3203x_device::generate_code_write_check(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	// delay slots can't be left part way; it'll be caught at the next check
+	if (desc->flags & OPFLAG_IN_DELAY_SLOT)
+		return;
+
+	uml::code_label const skip = compiler.labelnum++;
+
+	UML_LOAD(block, I1, &m_drc_flush, 0, SIZE_DWORD, SCALE_x1);                             // load    i1,[drc_flush]
+	UML_CMP(block, I1, 0);                                                                  // cmp     i1,0
+	UML_JMPc(block, COND_E, skip);                                                          // je      skip
+
+	// account for the cycles so far and have the cache flushed before going
+	// on; the interpreter has already set m_pc for anything it ran
+	if (!compiler.check_pc)
+		UML_STORE(block, &m_pc, 0, (desc->pc + 1) & 0xffffff, SIZE_DWORD, SCALE_x1);       // store   [pc],desc->pc + 1
+	if (compiler.cycles > 0)
+	{
+		UML_LOAD(block, I1, &m_icount, 0, SIZE_DWORD, SCALE_x1);                            // load    i1,[icount]
+		UML_SUB(block, I1, I1, compiler.cycles);                                            // sub     i1,i1,cycles
+		UML_STORE(block, &m_icount, 0, I1, SIZE_DWORD, SCALE_x1);                           // store   [icount],i1
+	}
+	UML_EXIT(block, EXECUTE_RESET_CACHE);                                                   // exit    EXECUTE_RESET_CACHE
+
+	UML_LABEL(block, skip);                                                                 // skip:
+}
+
+
+//-------------------------------------------------
+//  generate_opcode - generate code for a specific
+//  opcode; returns false if the interpreter
+//  should run it instead
+//-------------------------------------------------
+
+bool tms3203x_device::generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc)
+{
+	uint32_t const op = desc->opptr.l[0];
+	uint32_t const nextpc = (desc->pc + 1) & 0xffffff;
+
+	switch (op >> 21)
+	{
+		case 0x038:
+		{
+			// LDF Rn,Rn
+			int const dreg = (op >> 16) & 7;
+			UML_LOAD(block, I0, &m_r[op & 7].i32[0], 0, SIZE_DWORD, SCALE_x1);              // load    i0,[src.mantissa]
+			UML_LOAD(block, I1, &m_r[op & 7].i32[1], 0, SIZE_DWORD, SCALE_x1);              // load    i1,[src.exponent]
+			UML_STORE(block, &m_r[dreg].i32[0], 0, I0, SIZE_DWORD, SCALE_x1);               // store   [dst.mantissa],i0
+			UML_STORE(block, &m_r[dreg].i32[1], 0, I1, SIZE_DWORD, SCALE_x1);               // store   [dst.exponent],i1
+			generate_set_nzf(block, dreg);
+			return true;
+		}
+
+		case 0x039:
+		case 0x03a:
+		{
+			// LDF mem,Rn
+			int const dreg = (op >> 16) & 7;
+			if ((op >> 21) == 0x039)
+				generate_direct(block, &IREG(TMR_DP), op);
+			else if (!generate_indirect(block, op))
+				return false;
+			UML_READ(block, I0, I0, SIZE_DWORD, SPACE_PROGRAM);                             // read    i0,i0,dword
+
+			// the exponent is the top byte, the mantissa the rest
+			UML_SHL(block, I1, I0, 8);                                                      // shl     i1,i0,8
+			UML_STORE(block, &m_r[dreg].i32[0], 0, I1, SIZE_DWORD, SCALE_x1);               // store   [dst.mantissa],i1
+			UML_SAR(block, I1, I0, 24);                                                     // sar     i1,i0,24
+			UML_STORE(block, &m_r[dreg].i32[1], 0, I1, SIZE_DWORD, SCALE_x1);               // store   [dst.exponent],i1
+			generate_set_nzf(block, dreg);
+			return true;
+		}
+
+		case 0x03b:
+		{
+			// LDF imm,Rn: the short float is converted now
+			int const dreg = (op >> 16) & 7;
+			tmsreg value;
+			if (uint16_t(op) == 0x8000)
+			{
+				value.set_mantissa(0);
+				value.set_exponent(-128);
+			}
+			else
+			{
+				value.set_mantissa(op << 20);
+				value.set_exponent(int16_t(op) >> 12);
+			}
+			UML_STORE(block, &m_r[dreg].i32[0], 0, value.i32[0], SIZE_DWORD, SCALE_x1);     // store   [dst.mantissa],mantissa
+			UML_STORE(block, &m_r[dreg].i32[1], 0, value.i32[1], SIZE_DWORD, SCALE_x1);     // store   [dst.exponent],exponent
+
+			uint32_t const flags = ((value.mantissa() >> 28) & NFLAG) | ((value.exponent() == -128) ? ZFLAG : 0);
+			UML_LOAD(block, I0, &IREG(TMR_ST), 0, SIZE_DWORD, SCALE_x1);                    // load    i0,[st]
+			UML_AND(block, I0, I0, ~uint32_t(NFLAG | ZFLAG | VFLAG | UFFLAG));                    // and     i0,i0,~(N|Z|V|UF)
+			if (flags != 0)
+				UML_OR(block, I0, I0, flags);                                               // or      i0,i0,flags
+			UML_STORE(block, &IREG(TMR_ST), 0, I0, SIZE_DWORD, SCALE_x1);                   // store   [st],i0
+			return true;
+		}
+
+		case 0x040:
+		case 0x041:
+		case 0x042:
+		case 0x043:
+		{
+			// LDI: the registers from BK up have side effects
+			int const dreg = (op >> 16) & 31;
+			if (dreg >= TMR_BK)
+				return false;
+
+			uml::parameter src = uml::I0;
+			switch ((op >> 21) & 3)
+			{
+				case 0:
+					UML_LOAD(block, I0, &IREG(op & 31), 0, SIZE_DWORD, SCALE_x1);           // load    i0,[src]
+					break;
+				case 1:
+					generate_direct(block, &IREG(TMR_DP), op);
+					UML_READ(block, I0, I0, SIZE_DWORD, SPACE_PROGRAM);                     // read    i0,i0,dword
+					break;
+				case 2:
+					if (!generate_indirect(block, op))
+						return false;
+					UML_READ(block, I0, I0, SIZE_DWORD, SPACE_PROGRAM);                     // read    i0,i0,dword
+					break;
+				case 3:
+					src = uint32_t(int16_t(op));
+					break;
+			}
+			UML_STORE(block, &IREG(dreg), 0, src, SIZE_DWORD, SCALE_x1);                    // store   [dst],src
+			if (dreg < 8)
+				generate_set_nz(block, src);
+			return true;
+		}
+
+		case 0x084: case 0x085: case 0x086: case 0x087:
+			// LOPOWER hands the rest of the timeslice back to the interpreter
+			if (!BIT(op, 0))
+				return false;
+			generate_generic(block, compiler, desc);
+			if (compiler.cycles > 0)
+			{
+				UML_LOAD(block, I1, &m_icount, 0, SIZE_DWORD, SCALE_x1);                    // load    i1,[icount]
+				UML_SUB(block, I1, I1, compiler.cycles);                                    // sub     i1,i1,cycles
+				UML_STORE(block, &m_icount, 0, I1, SIZE_DWORD, SCALE_x1);                   // store   [icount],i1
+			}
+			compiler.cycles = 0;
+			UML_EXIT(block, EXECUTE_LOW_POWER);                                             // exit    EXECUTE_LOW_POWER
+			compiler.check_pc = false;
+			return true;
+
+		case 0x09c:
+		case 0x09f:
+			// RPTS Rn, RPTS imm: interrupts wait until the repeat is done
+			if ((op >> 21) == 0x09c)
+				UML_LOAD(block, I0, &IREG(op & 31), 0, SIZE_DWORD, SCALE_x1);               // load    i0,[src]
+			else
+				UML_MOV(block, I0, uint16_t(op));                                           // mov     i0,op & 0xffff
+			UML_STORE(block, &IREG(TMR_RC), 0, I0, SIZE_DWORD, SCALE_x1);                   // store   [rc],i0
+			UML_STORE(block, &IREG(TMR_RS), 0, nextpc, SIZE_DWORD, SCALE_x1);               // store   [rs],nextpc
+			UML_STORE(block, &IREG(TMR_RE), 0, nextpc, SIZE_DWORD, SCALE_x1);               // store   [re],nextpc
+			UML_LOAD(block, I0, &IREG(TMR_ST), 0, SIZE_DWORD, SCALE_x1);                    // load    i0,[st]
+			UML_OR(block, I0, I0, RMFLAG);                                                  // or      i0,i0,RMFLAG
+			UML_STORE(block, &IREG(TMR_ST), 0, I0, SIZE_DWORD, SCALE_x1);                   // store   [st],i0
+			UML_STORE(block, &m_delayed, 0, 1, SIZE_BYTE, SCALE_x1);                        // store   [delayed],1
+			compiler.cycles += 3;
+			return true;
+
+		case 0x0a1:
+		case 0x0a2:
+		{
+			// STF Rn,mem
+			int const sreg = (op >> 16) & 7;
+			if ((op >> 21) == 0x0a1)
+				generate_direct(block, &IREG(TMR_DP), op);
+			else if (!generate_indirect(block, op))
+				return false;
+			UML_LOAD(block, I1, &m_r[sreg].i32[1], 0, SIZE_DWORD, SCALE_x1);                // load    i1,[src.exponent]
+			UML_SHL(block, I1, I1, 24);                                                     // shl     i1,i1,24
+			UML_LOAD(block, I2, &m_r[sreg].i32[0], 0, SIZE_DWORD, SCALE_x1);                // load    i2,[src.mantissa]
+			UML_SHR(block, I2, I2, 8);                                                      // shr     i2,i2,8
+			UML_OR(block, I1, I1, I2);                                                      // or      i1,i1,i2
+			UML_WRITE(block, I0, I1, SIZE_DWORD, SPACE_PROGRAM);                            // write   i0,i1,dword
+			generate_code_write_check(block, compiler, desc);
+			return true;
+		}
+
+		case 0x0a9:
+		case 0x0aa:
+			// STI Rn,mem
+			if ((op >> 21) == 0x0a9)
+				generate_direct(block, &IREG(TMR_DP), op);
+			else if (!generate_indirect(block, op))
+				return false;
+			UML_LOAD(block, I1, &IREG((op >> 16) & 31), 0, SIZE_DWORD, SCALE_x1);          // load    i1,[src]
+			UML_WRITE(block, I0, I1, SIZE_DWORD, SPACE_PROGRAM);                            // write   i0,i1,dword
+			generate_code_write_check(block, compiler, desc);
+			return true;
+
+		case 0x300: case 0x301: case 0x302: case 0x303: case 0x304: case 0x305: case 0x306: case 0x307:
+			// BR
+			generate_branch(block, compiler, desc);
+			return true;
+
+		case 0x308: case 0x309: case 0x30a: case 0x30b: case 0x30c: case 0x30d: case 0x30e: case 0x30f:
+			// BRD
+			generate_delayed_branch(block, compiler, desc);
+			return true;
+
+		case 0x310: case 0x311: case 0x312: case 0x313: case 0x314: case 0x315: case 0x316: case 0x317:
+			// CALL
+			UML_LOAD(block, I0, &IREG(TMR_SP), 0, SIZE_DWORD, SCALE_x1);                    // load    i0,[sp]
+			UML_ADD(block, I0, I0, 1);                                                      // add     i0,i0,1
+			UML_STORE(block, &IREG(TMR_SP), 0, I0, SIZE_DWORD, SCALE_x1);                   // store   [sp],i0
+			UML_WRITE(block, I0, nextpc, SIZE_DWORD, SPACE_PROGRAM);                        // write   i0,nextpc,dword
+			generate_branch(block, compiler, desc);
+			return true;
+
+		case 0x320: case 0x321: case 0x322: case 0x323: case 0x324: case 0x325: case 0x326: case 0x327:
+			// RPTB
+			UML_STORE(block, &IREG(TMR_RS), 0, nextpc, SIZE_DWORD, SCALE_x1);               // store   [rs],nextpc
+			UML_STORE(block, &IREG(TMR_RE), 0, op & 0xffffff, SIZE_DWORD, SCALE_x1);        // store   [re],op & 0xffffff
+			UML_LOAD(block, I0, &IREG(TMR_ST), 0, SIZE_DWORD, SCALE_x1);                    // load    i0,[st]
+			UML_OR(block, I0, I0, RMFLAG);                                                  // or      i0,i0,RMFLAG
+			UML_STORE(block, &IREG(TMR_ST), 0, I0, SIZE_DWORD, SCALE_x1);                   // store   [st],i0
+			compiler.cycles += 3;
+			return true;
+
+		case 0x340:
+		{
+			// Bcond Rn
+			uml::code_label const skip = compiler.labelnum++;
+			generate_condition(block, compiler, op >> 16, skip);
+			UML_LOAD(block, I0, &IREG(op & 31), 0, SIZE_DWORD, SCALE_x1);                   // load    i0,[src]
+			UML_AND(block, I0, I0, 0xffffff);                                               // and     i0,i0,0xffffff
+			compiler_state compiler_temp(compiler);
+			compiler_temp.cycles += 3;
+			generate_update_cycles(block, compiler_temp, uml::I0);                          // <subtract cycles>
+			UML_HASHJMP(block, 0, I0, *m_nocode);                                           // hashjmp 0,i0,nocode
+			UML_LABEL(block, skip);                                                         // skip:
+			return true;
+		}
+
+		case 0x350:
+		{
+			// Bcond disp
+			uml::code_label const skip = compiler.labelnum++;
+			generate_condition(block, compiler, op >> 16, skip);
+			generate_branch(block, compiler, desc);
+			UML_LABEL(block, skip);                                                         // skip:
+			return true;
+		}
+
+		case 0x351:
+		{
+			// BcondD disp
+			uml::code_label const skip = compiler.labelnum++;
+			UML_STORE(block, &m_drc_taken, 0, 0, SIZE_DWORD, SCALE_x1);                     // store   [drc_taken],0
+			generate_condition(block, compiler, op >> 16, skip);
+			UML_STORE(block, &m_drc_taken, 0, 1, SIZE_DWORD, SCALE_x1);                     // store   [drc_taken],1
+			UML_LABEL(block, skip);                                                         // skip:
+			generate_delayed_branch(block, compiler, desc);
+			return true;
+		}
+
+		case 0x370: case 0x372: case 0x374: case 0x376: case 0x378: case 0x37a: case 0x37c: case 0x37e:
+		{
+			// DBcond ARn,disp
+			uml::code_label const skip = compiler.labelnum++;
+			generate_decrement_branch(block, compiler, op, skip);
+			generate_branch(block, compiler, desc);
+			UML_LABEL(block, skip);                                                         // skip:
+			return true;
+		}
+
+		case 0x371: case 0x373: case 0x375: case 0x377: case 0x379: case 0x37b: case 0x37d: case 0x37f:
+		{
+			// DBcondD ARn,disp
+			uml::code_label const skip = compiler.labelnum++;
+			UML_STORE(block, &m_drc_taken, 0, 0, SIZE_DWORD, SCALE_x1);                     // store   [drc_taken],0
+			generate_decrement_branch(block, compiler, op, skip);
+			UML_STORE(block, &m_drc_taken, 0, 1, SIZE_DWORD, SCALE_x1);                     // store   [drc_taken],1
+			UML_LABEL(block, skip);                                                         // skip:
+			generate_delayed_branch(block, compiler, desc);
+			return true;
+		}
+
+		case 0x390:
+		{
+			// CALLcond disp
+			uml::code_label const skip = compiler.labelnum++;
+			generate_condition(block, compiler, op >> 16, skip);
+			UML_LOAD(block, I0, &IREG(TMR_SP), 0, SIZE_DWORD, SCALE_x1);                    // load    i0,[sp]
+			UML_ADD(block, I0, I0, 1);                                                      // add     i0,i0,1
+			UML_STORE(block, &IREG(TMR_SP), 0, I0, SIZE_DWORD, SCALE_x1);                   // store   [sp],i0
+			UML_WRITE(block, I0, nextpc, SIZE_DWORD, SPACE_PROGRAM);                        // write   i0,nextpc,dword
+			generate_branch(block, compiler, desc);
+			UML_LABEL(block, skip);                                                         // skip:
+			return true;
+		}
+
+		case 0x3c4:
+		{
+			// RETScond
+			uml::code_label const skip = compiler.labelnum++;
+			generate_condition(block, compiler, op >> 16, skip);
+			UML_LOAD(block, I1, &IREG(TMR_SP), 0, SIZE_DWORD, SCALE_x1);                    // load    i1,[sp]
+			UML_READ(block, I0, I1, SIZE_DWORD, SPACE_PROGRAM);                             // read    i0,i1,dword
+			UML_SUB(block, I1, I1, 1);                                                      // sub     i1,i1,1
+			UML_STORE(block, &IREG(TMR_SP), 0, I1, SIZE_DWORD, SCALE_x1);                   // store   [sp],i1
+			UML_AND(block, I0, I0, 0xffffff);                                               // and     i0,i0,0xffffff
+			compiler_state compiler_temp(compiler);
+			compiler_temp.cycles += 3;
+			generate_update_cycles(block, compiler_temp, uml::I0);                          // <subtract cycles>
+			UML_HASHJMP(block, 0, I0, *m_nocode);                                           // hashjmp 0,i0,nocode
+			UML_LABEL(block, skip);                                                         // skip:
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -72,6 +72,7 @@
 
 #include "emu.h"
 #include "tms32031.h"
+#include "tms32031fe.h"
 #include "dis32031.h"
 
 
@@ -425,7 +426,14 @@ tms3203x_device::tms3203x_device(const machine_config &mconfig, device_type type
 		m_xf0_cb(*this),
 		m_xf1_cb(*this),
 		m_iack_cb(*this),
-		m_holda_cb(*this)
+		m_holda_cb(*this),
+		m_enable_drc(false),
+		m_drc_flush(1),
+		m_drc_op(0),
+		m_drc_taken(0),
+		m_entry(nullptr),
+		m_nocode(nullptr),
+		m_out_of_cycles(nullptr)
 {
 	// initialize remaining state
 	memset(&m_r, 0, sizeof(m_r));
@@ -623,6 +631,21 @@ void tms3203x_device::device_reset()
 
 	// reset internal stuff
 	m_delayed = m_irq_pending = m_is_idling = m_is_lopower = false;
+
+	// program memory is usually reloaded before a reset
+	m_drc_flush = 1;
+}
+
+
+//-------------------------------------------------
+//  device_post_load - called after loading a
+//  saved state
+//-------------------------------------------------
+
+void tms3203x_device::device_post_load()
+{
+	// program memory was restored behind the recompiler's back
+	m_drc_flush = 1;
 }
 
 
@@ -975,6 +998,11 @@ void tms3203x_device::execute_run()
 		return;
 	}
 
+	// generated code runs until the timeslice ends or low power mode is
+	// entered; the interpreter carries on from there
+	if (m_enable_drc && !m_is_lopower)
+		execute_run_drc();
+
 	// non-debug case
 	if ((machine().debug_flags & DEBUG_FLAG_ENABLED) == 0)
 	{
@@ -1068,3 +1096,11 @@ void tms3203x_device::primary_bus_control_w(offs_t offset, uint32_t data, uint32
 //**************************************************************************
 
 #include "32031ops.hxx"
+
+
+
+//**************************************************************************
+//  RECOMPILER
+//**************************************************************************
+
+#include "32031drc.hxx"
@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include "cpu/drcfe.h"
+#include "cpu/drcuml.h"
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -90,10 +93,15 @@ enum
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+class tms3203x_frontend;
+
+
 // ======================> tms3203x_device
 
 class tms3203x_device : public cpu_device
 {
+	friend class tms3203x_frontend;
+
 	struct tmsreg
 	{
 		// constructors
@@ -134,6 +142,11 @@ public:
 	static uint32_t float_to_fp(float fval);
 	static uint32_t double_to_fp(double dval);
 
+	// run generated code rather than the interpreter; program memory
+	// written through the address space is tracked, so drivers that
+	// write it behind the CPU's back must not use this
+	void enable_recompiler();
+
 protected:
 	enum
 	{
@@ -149,6 +162,7 @@ protected:
 	// device-level overrides
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_post_load() override;
 
 	virtual const tiny_rom_entry *device_rom_region() const override;
 
@@ -188,6 +202,41 @@ protected:
 	void burn_cycle(int cycle);
 	bool condition(int which);
 
+	// recompiler
+	struct compiler_state
+	{
+		uint32_t        cycles;         // accumulated cycles
+		uml::code_label labelnum;       // index for local labels
+		bool            check_pc;       // m_pc may not hold the next address after this instruction
+	};
+
+	static void cfunc_execute_op(void *param);
+	static void cfunc_end_delay(void *param);
+
+	void drc_execute_op();
+	void drc_end_delay();
+	void execute_run_drc();
+	void init_recompiler();
+	void flush_cache();
+	void compile_block(offs_t pc);
+	void static_generate_entry_point();
+	void static_generate_nocode_handler();
+	void static_generate_out_of_cycles();
+	void generate_sequence_instruction(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_update_cycles(drcuml_block &block, compiler_state &compiler, uml::parameter param);
+	void generate_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_delayed_branch(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_repeat_end(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_check_pc(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	void generate_condition(drcuml_block &block, compiler_state &compiler, int condition, uml::code_label skip);
+	void generate_decrement_branch(drcuml_block &block, compiler_state &compiler, uint32_t op, uml::code_label skip);
+	void generate_generic(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_indirect(drcuml_block &block, uint32_t op);
+	void generate_set_nz(drcuml_block &block, uml::parameter src);
+	void generate_set_nzf(drcuml_block &block, int reg);
+	void generate_code_write_check(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+	bool generate_opcode(drcuml_block &block, compiler_state &compiler, const opcode_desc *desc);
+
 	// floating point helpers
 	void int2float(tmsreg &srcdst);
 	void float2int(tmsreg &srcdst, bool setflags);
@@ -785,6 +834,20 @@ protected:
 	devcb_write8        m_iack_cb;
 	devcb_write_line    m_holda_cb;
 
+	// recompiler state
+	bool                m_enable_drc;
+	uint32_t            m_drc_flush;        // compiled code may be stale
+	uint32_t            m_drc_op;           // opcode for C helpers
+	uint32_t            m_drc_taken;        // the delayed branch being generated is taken
+	std::unique_ptr<drc_cache> m_drccache;
+	std::unique_ptr<drcuml_state> m_drcuml;
+	std::unique_ptr<tms3203x_frontend> m_drcfe;
+	uml::code_handle *  m_entry;            // entry point
+	uml::code_handle *  m_nocode;           // nocode exception handler
+	uml::code_handle *  m_out_of_cycles;    // out of cycles exception handler
+	memory_passthrough_handler m_drc_code_tap;
+	std::unique_ptr<uint32_t []> m_drc_code; // one bit per address with compiled code
+
 	// tables
 	static void (tms3203x_device::*const s_tms32031ops[])(uint32_t op);
 	static uint32_t (tms3203x_device::*const s_indirect_d[0x20])(uint32_t, uint8_t);
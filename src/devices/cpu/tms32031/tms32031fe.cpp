@@ -0,0 +1,155 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    tms32031fe.cpp
+
+    Front-end for TMS320C3x recompiler
+
+***************************************************************************/
+
+#include "emu.h"
+#include "tms32031fe.h"
+
+
+tms3203x_frontend::tms3203x_frontend(tms3203x_device &tms, uint32_t window_start, uint32_t window_end, uint32_t max_sequence)
+	: drc_frontend(tms, window_start, window_end, max_sequence)
+	, m_tms(tms)
+	, m_last_repeat_end(~0U)
+{
+}
+
+
+//-------------------------------------------------
+//  add_repeat_end - note the address after the
+//  last instruction of a repeat; code compiled
+//  for it before now doesn't check for the
+//  repeat, so it's thrown away
+//-------------------------------------------------
+
+void tms3203x_frontend::add_repeat_end(uint32_t pc)
+{
+	// the same repeat is usually set up over and over
+	pc &= 0xffffff;
+	if (pc == m_last_repeat_end)
+		return;
+	m_last_repeat_end = pc;
+
+	if (m_repeat_end.insert(pc).second)
+	{
+		if (m_tms.m_drc_code && BIT(m_tms.m_drc_code[pc >> 5], pc & 31))
+			m_tms.m_drc_flush = 1;
+	}
+}
+
+
+//-------------------------------------------------
+//  describe_branch - fill in the details of a
+//  branch, call or return
+//-------------------------------------------------
+
+void tms3203x_frontend::describe_branch(opcode_desc &desc, uint32_t op, uint32_t targetpc, bool delayed)
+{
+	desc.targetpc = targetpc;
+	if (((op >> 16) & 31) == 0)
+		desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+	else
+		desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+
+	// the three instructions after a delayed branch are generated along with it
+	if (delayed)
+		desc.delayslots = desc.skipslots = 3;
+}
+
+
+//-------------------------------------------------
+//  describe - build a description of a single
+//  instruction
+//-------------------------------------------------
+
+bool tms3203x_frontend::describe(opcode_desc &desc, const opcode_desc *prev)
+{
+	uint32_t const op = desc.opptr.l[0] = m_tms.m_cache.read_dword(desc.physpc);
+	uint32_t const nextpc = desc.pc + 1;
+
+	desc.length = 1;
+	desc.cycles = 1;
+
+	switch (op >> 21)
+	{
+		case 0x030: case 0x031: case 0x032: case 0x033:
+			// idle gives up the rest of the timeslice
+			desc.flags |= OPFLAG_END_SEQUENCE;
+			break;
+
+		case 0x084: case 0x085: case 0x086: case 0x087:
+			// low power mode is left to the interpreter
+			desc.flags |= OPFLAG_END_SEQUENCE;
+			break;
+
+		case 0x09c: case 0x09d: case 0x09e: case 0x09f:
+			// RPTS repeats the next instruction
+			add_repeat_end(nextpc + 1);
+			break;
+
+		case 0x300: case 0x301: case 0x302: case 0x303: case 0x304: case 0x305: case 0x306: case 0x307:
+		case 0x310: case 0x311: case 0x312: case 0x313: case 0x314: case 0x315: case 0x316: case 0x317:
+			// BR, CALL
+			desc.targetpc = op & 0xffffff;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			break;
+
+		case 0x308: case 0x309: case 0x30a: case 0x30b: case 0x30c: case 0x30d: case 0x30e: case 0x30f:
+			// BRD
+			desc.targetpc = op & 0xffffff;
+			desc.flags |= OPFLAG_IS_UNCONDITIONAL_BRANCH | OPFLAG_END_SEQUENCE;
+			desc.delayslots = desc.skipslots = 3;
+			break;
+
+		case 0x320: case 0x321: case 0x322: case 0x323: case 0x324: case 0x325: case 0x326: case 0x327:
+			// RPTB
+			add_repeat_end((op & 0xffffff) + 1);
+			break;
+
+		case 0x340: case 0x341:
+		case 0x380:
+		case 0x3a0:
+		case 0x3c0: case 0x3c4:
+			// Bcond(D), CALLcond, TRAPcond with a register; RETIcond, RETScond
+			describe_branch(desc, op, BRANCH_TARGET_DYNAMIC, false);
+			break;
+
+		case 0x360: case 0x362: case 0x364: case 0x366: case 0x368: case 0x36a: case 0x36c: case 0x36e:
+		case 0x361: case 0x363: case 0x365: case 0x367: case 0x369: case 0x36b: case 0x36d: case 0x36f:
+			// DBcond(D) with a register
+			desc.targetpc = BRANCH_TARGET_DYNAMIC;
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			break;
+
+		case 0x350:
+		case 0x390:
+			// Bcond, CALLcond with a displacement
+			describe_branch(desc, op, (nextpc + int16_t(op)) & 0xffffff, false);
+			break;
+
+		case 0x351:
+			// BcondD with a displacement
+			describe_branch(desc, op, (nextpc + 2 + int16_t(op)) & 0xffffff, true);
+			break;
+
+		case 0x370: case 0x372: case 0x374: case 0x376: case 0x378: case 0x37a: case 0x37c: case 0x37e:
+			// DBcond with a displacement; the count can always run out
+			desc.targetpc = (nextpc + int16_t(op)) & 0xffffff;
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			break;
+
+		case 0x371: case 0x373: case 0x375: case 0x377: case 0x379: case 0x37b: case 0x37d: case 0x37f:
+			// DBcondD with a displacement
+			desc.targetpc = (nextpc + 2 + int16_t(op)) & 0xffffff;
+			desc.flags |= OPFLAG_IS_CONDITIONAL_BRANCH;
+			desc.delayslots = desc.skipslots = 3;
+			break;
+	}
+
+	return true;
+}
@@ -0,0 +1,44 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    tms32031fe.h
+
+    Front-end for TMS320C3x recompiler
+
+***************************************************************************/
+
+#ifndef MAME_CPU_TMS32031_TMS32031FE_H
+#define MAME_CPU_TMS32031_TMS32031FE_H
+
+#pragma once
+
+#include "tms32031.h"
+#include "cpu/drcfe.h"
+
+#include <unordered_set>
+
+
+class tms3203x_frontend : public drc_frontend
+{
+public:
+	tms3203x_frontend(tms3203x_device &tms, uint32_t window_start, uint32_t window_end, uint32_t max_sequence);
+
+	// addresses following the end of a repeat block seen so far
+	bool is_repeat_end(uint32_t pc) const { return m_repeat_end.find(pc & 0xffffff) != m_repeat_end.end(); }
+	void add_repeat_end(uint32_t pc);
+
+protected:
+	// required overrides
+	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) override;
+
+private:
+	void describe_branch(opcode_desc &desc, uint32_t op, uint32_t targetpc, bool delayed);
+
+	tms3203x_device &m_tms;
+
+	std::unordered_set<uint32_t> m_repeat_end;
+	uint32_t m_last_repeat_end;
+};
+
+#endif // MAME_CPU_TMS32031_TMS32031FE_H
@@ -220,6 +220,38 @@ uint16_t tms340x0_device::memory_r(offs_t offset)
 	return TMS34010_RDMEM_WORD(offset);
 }
 
+/* Fill a run of words with the same value directly in host memory if it
+   is plain RAM; returns how many words were written, the caller handles
+   the rest */
+uint32_t tms340x0_device::fill_words_direct(offs_t offset, uint32_t words, uint16_t data)
+{
+	address_space &program = space(AS_PROGRAM);
+	uint32_t const unitbits = program.data_width();
+	uint32_t done = 0;
+
+	/* on a 32-bit bus, a leading odd word goes out normally */
+	if (offset & (unitbits - 1))
+	{
+		memory_w(offset, data);
+		offset += 16;
+		done++;
+	}
+
+	/* the whole run has to be in one contiguous block */
+	uint32_t const units = (words - done) * 16 / unitbits;
+	if (units == 0)
+		return done;
+	uint8_t *const base = reinterpret_cast<uint8_t *>(program.get_write_ptr(offset));
+	if (!base || reinterpret_cast<uint8_t *>(program.get_write_ptr(offset + (units - 1) * unitbits)) != base + (units - 1) * unitbits / 8)
+		return done;
+
+	if (unitbits == 16)
+		std::fill_n(reinterpret_cast<uint16_t *>(base), units, data);
+	else
+		std::fill_n(reinterpret_cast<uint32_t *>(base), units, (uint32_t(data) << 16) | data);
+	return done + units * unitbits / 16;
+}
+
 void tms340x0_device::shiftreg_w(offs_t offset, uint16_t data)
 {
 	//logerror("shiftreg_w %08x %04x\n", offset << 3, data);
@@ -1899,8 +1931,16 @@ void FUNCTION_NAME(tms340x0_device::fill)(int dst_is_linear)
 				(this->*word_write)(dwordaddr++ << 4, dstword);
 			}
 
+			/* plain replacing fills of full words can go straight to RAM */
+			words = 0;
+			if (!PIXEL_OP_REQUIRES_SOURCE && !TRANSPARENCY && full_words != 0 && word_write == &tms340x0_device::memory_w)
+			{
+				words = fill_words_direct(dwordaddr << 4, full_words, COLOR1());
+				dwordaddr += words;
+			}
+
 			/* loop over full words */
-			for (words = 0; words < full_words; words++)
+			for ( ; words < full_words; words++)
 			{
 				/* fetch the destination word (if necessary) */
 				if (PIXEL_OP_REQUIRES_SOURCE || TRANSPARENCY)
@@ -843,6 +843,7 @@ protected:
 	int compute_pixblt_b_cycles(int left_partials, int right_partials, int full_words, int rows, int op_timing, int bpp);
 	void memory_w(offs_t offset, uint16_t data);
 	uint16_t memory_r(offs_t offset);
+	uint32_t fill_words_direct(offs_t offset, uint32_t words, uint16_t data);
 	void shiftreg_w(offs_t offset, uint16_t data);
 	uint16_t shiftreg_r(offs_t offset);
 	uint16_t dummy_shiftreg_r(offs_t offset);
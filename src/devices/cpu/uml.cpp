@@ -108,6 +108,7 @@ using namespace uml;
 #define PTYPES_IMV      (PTYPES_IMM | PTYPES_MVAR)
 #define PTYPES_IANY     (PTYPES_IRM | PTYPES_IMV)
 #define PTYPES_FANY     (PTYPES_FRM)
+#define PTYPES_VRM      (PTYPES_VREG | PTYPES_MEM)
 
 
 
@@ -215,6 +216,19 @@ opcode_info const instruction::s_opcode_info_table[OP_MAX] =
 	OPINFO2(FRSQRT,  "f#rsqrt",  4|8, false, NONE, NONE, ALL,  PINFO(OUT, OP, FRM), PINFO(IN, OP, FANY))
 	OPINFO2(FCOPYI,  "f#copyi",  4|8, false, NONE, NONE, NONE, PINFO(OUT, OP, FRM), PINFO(IN, OP, IRM))
 	OPINFO2(ICOPYF,  "icopyf#",  4|8, false, NONE, NONE, NONE, PINFO(OUT, OP, IRM), PINFO(IN, OP, FRM))
+
+	// 128-bit vector operations
+	OPINFO2(VMOV,    "vmov",     4,   false, NONE, NONE, NONE, PINFO(OUT, OP, VRM), PINFO(IN, OP, VRM))
+	OPINFO4(VADD,    "vadd",     4,   false, NONE, NONE, NONE, PINFO(OUT, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, SIZE))
+	OPINFO4(VSUB,    "vsub",     4,   false, NONE, NONE, NONE, PINFO(OUT, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, SIZE))
+	OPINFO4(VADDS,   "vadds",    4,   false, NONE, NONE, NONE, PINFO(OUT, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, SIZE))
+	OPINFO4(VSUBS,   "vsubs",    4,   false, NONE, NONE, NONE, PINFO(OUT, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, SIZE))
+	OPINFO3(VFADD,   "vfadd",    4,   false, NONE, NONE, NONE, PINFO(OUT, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, VRM))
+	OPINFO3(VFSUB,   "vfsub",    4,   false, NONE, NONE, NONE, PINFO(OUT, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, VRM))
+	OPINFO3(VFMUL,   "vfmul",    4,   false, NONE, NONE, NONE, PINFO(OUT, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, VRM))
+	OPINFO3(VFMIN,   "vfmin",    4,   false, NONE, NONE, NONE, PINFO(OUT, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, VRM))
+	OPINFO3(VFMAX,   "vfmax",    4,   false, NONE, NONE, NONE, PINFO(OUT, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, VRM))
+	OPINFO3(VSHUF,   "vshuf",    4,   false, NONE, NONE, NONE, PINFO(OUT, OP, VRM), PINFO(IN, OP, VRM), PINFO(IN, OP, IMM))
 };
 
 
@@ -404,6 +418,12 @@ void uml::instruction::simplify()
 			}
 			break;
 
+		// CARRY: no-op if no flags needed
+		case OP_CARRY:
+			if (m_flags == 0)
+				nop();
+			break;
+
 		// SET: convert to MOV if constant condition
 		case OP_SET:
 			if (m_condition == COND_ALWAYS)
@@ -705,6 +725,81 @@ void uml::instruction::simplify()
 }
 
 
+//-------------------------------------------------
+//  propagate_constants - replace integer register
+//  inputs whose values are known with immediates
+//-------------------------------------------------
+
+void uml::instruction::propagate_constants(ireg_constants &known)
+{
+	static constexpr u64 sizemask[] = { 0, 0xff, 0xffff, 0, 0xffffffff, 0, 0, 0, 0xffffffffffffffffU };
+
+	opcode_info const &opinfo = s_opcode_info_table[m_opcode];
+	for (int pnum = 0; pnum < m_numparams; pnum++)
+	{
+		opcode_info::parameter_info const &pinfo = opinfo.param[pnum];
+		parameter const &param = m_param[pnum];
+		if (pinfo.output != PIO_IN || !(pinfo.typemask & PTYPES_IMM) || !param.is_int_register())
+			continue;
+
+		// only substitute values that were written at least as wide as they're read
+		u8 const size = (pinfo.size == PSIZE_OP) ? m_size : (pinfo.size == PSIZE_4) ? 4 : (pinfo.size == PSIZE_8) ? 8 : 0;
+		int const regnum = param.ireg() - REG_I0;
+		if (size != 0 && known.size[regnum] >= size)
+			m_param[pnum] = known.value[regnum] & sizemask[size];
+	}
+}
+
+
+//-------------------------------------------------
+//  track_constants - update known integer
+//  register values after an instruction
+//-------------------------------------------------
+
+void uml::instruction::track_constants(ireg_constants &known) const
+{
+	switch (m_opcode)
+	{
+	// anything can happen at entry points, after calls and after unconditional control flow
+	case OP_HANDLE:
+	case OP_HASH:
+	case OP_LABEL:
+	case OP_CALLH:
+	case OP_CALLC:
+	case OP_RESTORE:
+		known.reset();
+		return;
+
+	case OP_JMP:
+	case OP_EXH:
+	case OP_RET:
+	case OP_EXIT:
+	case OP_HASHJMP:
+		if (m_condition == COND_ALWAYS)
+			known.reset();
+		return;
+
+	default:
+		break;
+	}
+
+	// an unconditional move of an immediate gives us a known value
+	if (m_opcode == OP_MOV && m_condition == COND_ALWAYS && m_param[0].is_int_register() && m_param[1].is_immediate())
+	{
+		int const regnum = m_param[0].ireg() - REG_I0;
+		known.value[regnum] = m_param[1].immediate();
+		known.size[regnum] = m_size;
+		return;
+	}
+
+	// any other integer register outputs are no longer known
+	opcode_info const &opinfo = s_opcode_info_table[m_opcode];
+	for (int pnum = 0; pnum < m_numparams; pnum++)
+		if ((opinfo.param[pnum].output & PIO_OUT) && m_param[pnum].is_int_register())
+			known.size[m_param[pnum].ireg() - REG_I0] = 0;
+}
+
+
 //-------------------------------------------------
 //  validate - verify that the instruction created
 //  meets all requirements
@@ -911,6 +1006,11 @@ std::string uml::instruction::disasm(drcuml_state *drcuml) const
 			util::stream_format(buffer, "f%d", param.freg() - REG_F0);
 			break;
 
+		// vector registers
+		case parameter::PTYPE_VECTOR_REGISTER:
+			util::stream_format(buffer, "v%d", param.vreg() - REG_V0);
+			break;
+
 		// map variables
 		case parameter::PTYPE_MAPVAR:
 			util::stream_format(buffer, "m%d", param.mapvar() - MAPVAR_M0);
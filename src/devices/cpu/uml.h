@@ -221,6 +221,19 @@ namespace uml
 		OP_FCOPYI,                  // FCOPYI  dst,src
 		OP_ICOPYF,                  // ICOPYF  dst,src
 
+		// 128-bit vector operations
+		OP_VMOV,                    // VMOV    dst,src
+		OP_VADD,                    // VADD    dst,src1,src2,size
+		OP_VSUB,                    // VSUB    dst,src1,src2,size
+		OP_VADDS,                   // VADDS   dst,src1,src2,size
+		OP_VSUBS,                   // VSUBS   dst,src1,src2,size
+		OP_VFADD,                   // VFADD   dst,src1,src2
+		OP_VFSUB,                   // VFSUB   dst,src1,src2
+		OP_VFMUL,                   // VFMUL   dst,src1,src2
+		OP_VFMIN,                   // VFMIN   dst,src1,src2
+		OP_VFMAX,                   // VFMAX   dst,src1,src2
+		OP_VSHUF,                   // VSHUF   dst,src,lanes
+
 		OP_MAX
 	};
 
@@ -387,6 +400,15 @@ namespace uml
 		parameter_info      param[4];           // information about parameters
 	};
 
+	// integer register values known at a point in a block, for constant propagation
+	struct ireg_constants
+	{
+		void reset() { std::fill(std::begin(size), std::end(size), 0); }
+
+		u64                 value[REG_I_COUNT]; // known values
+		u8                  size[REG_I_COUNT];  // size the value was written with, or 0 if unknown
+	};
+
 	// a single UML instruction is encoded like this
 	class instruction
 	{
@@ -412,6 +434,8 @@ namespace uml
 		u8 output_flags() const;
 		u8 modified_flags() const;
 		void simplify();
+		void propagate_constants(ireg_constants &known);
+		void track_constants(ireg_constants &known) const;
 
 		// compile-time opcodes
 		void handle(code_handle &hand) { configure(OP_HANDLE, 4, hand); }
@@ -571,6 +595,20 @@ namespace uml
 		void fdcopyi(parameter dst, parameter src) { configure(OP_FCOPYI, 8, dst, src); }
 		void icopyfd(parameter dst, parameter src) { configure(OP_ICOPYF, 8, dst, src); }
 
+		// 128-bit vector operations; vectors are 16 bytes in memory holding lanes of the given size, or four
+		// single-precision lanes for the floating point forms, and saturating forms only take byte or word lanes
+		void vmov(parameter dst, parameter src) { configure(OP_VMOV, 4, dst, src); }
+		void vadd(parameter dst, parameter src1, parameter src2, operand_size size) { configure(OP_VADD, 4, dst, src1, src2, parameter::make_size(size)); }
+		void vsub(parameter dst, parameter src1, parameter src2, operand_size size) { configure(OP_VSUB, 4, dst, src1, src2, parameter::make_size(size)); }
+		void vadds(parameter dst, parameter src1, parameter src2, operand_size size) { configure(OP_VADDS, 4, dst, src1, src2, parameter::make_size(size)); }
+		void vsubs(parameter dst, parameter src1, parameter src2, operand_size size) { configure(OP_VSUBS, 4, dst, src1, src2, parameter::make_size(size)); }
+		void vfadd(parameter dst, parameter src1, parameter src2) { configure(OP_VFADD, 4, dst, src1, src2); }
+		void vfsub(parameter dst, parameter src1, parameter src2) { configure(OP_VFSUB, 4, dst, src1, src2); }
+		void vfmul(parameter dst, parameter src1, parameter src2) { configure(OP_VFMUL, 4, dst, src1, src2); }
+		void vfmin(parameter dst, parameter src1, parameter src2) { configure(OP_VFMIN, 4, dst, src1, src2); }
+		void vfmax(parameter dst, parameter src1, parameter src2) { configure(OP_VFMAX, 4, dst, src1, src2); }
+		void vshuf(parameter dst, parameter src, u32 lanes) { configure(OP_VSHUF, 4, dst, src, lanes); }
+
 		// constants
 		static constexpr int MAX_PARAMS = 4;
 
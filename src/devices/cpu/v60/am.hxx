@@ -13,6 +13,34 @@
 #include "am2.hxx" // ReadAMAddress
 #include "am3.hxx" // WriteAM
 
+/*
+  The mode byte alone selects the handler for every mode except the
+  group 6 (indexed) modes, which also need the second mode byte.  Flatten
+  the nested tables at startup so decoding an operand is one dispatch.
+*/
+
+void v60_device::build_am_decode(int kind, const am_func (&table)[2][8], const am_func (&g6)[8], const am_func (&g7)[32], const am_func (&g7a)[16], am_func group7, am_func group7a, am_func error4)
+{
+	for (int m = 0; m < 2; m++)
+	{
+		for (int val = 0; val < 256; val++)
+		{
+			am_func func = table[m][val >> 5];
+			if (func == group7)
+				func = g7[val & 0x1F];
+			m_amdecode[kind][m][val] = func;
+		}
+	}
+
+	for (int val2 = 0; val2 < 256; val2++)
+	{
+		am_func func = g6[val2 >> 5];
+		if (func == group7a)
+			func = (val2 & 0x10) ? g7a[val2 & 0xF] : error4;
+		m_amdecode_g6[kind][val2] = func;
+	}
+}
+
 /*
   Input:
   m_modadd
@@ -27,14 +55,14 @@ uint32_t v60_device::ReadAM()
 {
 	m_modm = m_modm?1:0;
 	m_modval = OpRead8(m_modadd);
-	return (this->*s_AMTable1[m_modm][m_modval >> 5])();
+	return (this->*m_amdecode[AM_READ][m_modm][m_modval])();
 }
 
 uint32_t v60_device::BitReadAM()
 {
 	m_modm = m_modm?1:0;
 	m_modval = OpRead8(m_modadd);
-	return (this->*s_BAMTable1[m_modm][m_modval >> 5])();
+	return (this->*m_amdecode[AM_BITREAD][m_modm][m_modval])();
 }
 
 
@@ -54,14 +82,14 @@ uint32_t v60_device::ReadAMAddress()
 {
 	m_modm = m_modm?1:0;
 	m_modval = OpRead8(m_modadd);
-	return (this->*s_AMTable2[m_modm][m_modval >> 5])();
+	return (this->*m_amdecode[AM_ADDRESS][m_modm][m_modval])();
 }
 
 uint32_t v60_device::BitReadAMAddress()
 {
 	m_modm = m_modm?1:0;
 	m_modval = OpRead8(m_modadd);
-	return (this->*s_BAMTable2[m_modm][m_modval >> 5])();
+	return (this->*m_amdecode[AM_BITADDRESS][m_modm][m_modval])();
 }
 
 /*
@@ -79,5 +107,5 @@ uint32_t v60_device::WriteAM()
 {
 	m_modm = m_modm?1:0;
 	m_modval = OpRead8(m_modadd);
-	return (this->*s_AMTable3[m_modm][m_modval >> 5])();
+	return (this->*m_amdecode[AM_WRITE][m_modm][m_modval])();
 }
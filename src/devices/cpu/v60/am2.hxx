@@ -1171,12 +1171,12 @@ const v60_device::am_func v60_device::s_BAMTable2_G6[8] =
 uint32_t v60_device::am2Group6()
 {
 	m_modval2 = OpRead8(m_modadd + 1);
-	return (this->*s_AMTable2_G6[m_modval2 >> 5])();
+	return (this->*m_amdecode_g6[AM_ADDRESS][m_modval2])();
 }
 uint32_t v60_device::bam2Group6()
 {
 	m_modval2 = OpRead8(m_modadd + 1);
-	return (this->*s_BAMTable2_G6[m_modval2 >> 5])();
+	return (this->*m_amdecode_g6[AM_BITADDRESS][m_modval2])();
 }
 
 uint32_t v60_device::am2Group7()
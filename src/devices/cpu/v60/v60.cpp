@@ -365,6 +365,12 @@ uint32_t v60_device::opUNHANDLED()
 
 void v60_device::device_start()
 {
+	build_am_decode(AM_READ, s_AMTable1, s_AMTable1_G6, s_AMTable1_G7, s_AMTable1_G7a, &v60_device::am1Group7, &v60_device::am1Group7a, &v60_device::am1Error4);
+	build_am_decode(AM_BITREAD, s_BAMTable1, s_BAMTable1_G6, s_BAMTable1_G7, s_BAMTable1_G7a, &v60_device::bam1Group7, &v60_device::bam1Group7a, &v60_device::bam1Error4);
+	build_am_decode(AM_ADDRESS, s_AMTable2, s_AMTable2_G6, s_AMTable2_G7, s_AMTable2_G7a, &v60_device::am2Group7, &v60_device::am2Group7a, &v60_device::am2Error4);
+	build_am_decode(AM_BITADDRESS, s_BAMTable2, s_BAMTable2_G6, s_BAMTable2_G7, s_BAMTable2_G7a, &v60_device::bam2Group7, &v60_device::bam2Group7a, &v60_device::bam2Error4);
+	build_am_decode(AM_WRITE, s_AMTable3, s_AMTable3_G6, s_AMTable3_G7, s_AMTable3_G7a, &v60_device::am3Group7, &v60_device::am3Group7a, &v60_device::am3Error4);
+
 	m_stall_io = 0;
 	m_irq_line = CLEAR_LINE;
 	m_nmi_line = CLEAR_LINE;
@@ -138,6 +138,19 @@ private:
 	static const am_func s_AMTable3_G7[32];
 	static const am_func s_AMTable3_G6[8];
 	static const am_func s_AMTable3[2][8];
+
+	// addressing mode decoders, indexed by the whole mode byte
+	enum
+	{
+		AM_READ = 0,
+		AM_BITREAD,
+		AM_ADDRESS,
+		AM_BITADDRESS,
+		AM_WRITE,
+		AM_KINDS
+	};
+	am_func m_amdecode[AM_KINDS][2][256];
+	am_func m_amdecode_g6[AM_KINDS][256];
 	static const am_func s_Op5FTable[32];
 	static const am_func s_Op5CTable[32];
 	static const op6_func s_OpC6Table[8];
@@ -449,6 +462,7 @@ private:
 	uint32_t am3Group7a();
 	uint32_t am3Group6();
 	uint32_t am3Group7();
+	void build_am_decode(int kind, const am_func (&table)[2][8], const am_func (&g6)[8], const am_func (&g7)[32], const am_func (&g7a)[16], am_func group7, am_func group7a, am_func error4);
 	uint32_t ReadAM();
 	uint32_t BitReadAM();
 	uint32_t ReadAMAddress();
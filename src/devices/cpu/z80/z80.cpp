@@ -454,6 +454,7 @@ inline uint8_t z80_device::in(uint16_t port)
  ***************************************************************/
 inline void z80_device::out(uint16_t port, uint8_t value)
 {
+	idle_loop_write();
 	m_io.write_byte(port, value);
 	T(4);
 }
@@ -491,6 +492,7 @@ void z80_device::wm(uint16_t addr, uint8_t value)
 {
 	// As we don't count changes between read and write, simply adjust to the end of requested.
 	if(m_icount_executing != MTM) T(m_icount_executing - MTM);
+	idle_loop_write();
 	m_data.write_byte(addr, value);
 	T(MTM);
 }
@@ -594,6 +596,16 @@ inline void z80_device::push(PAIR &r)
 	wm16_sp(r);
 }
 
+/***************************************************************
+ * IDLE_LOOP_SIGNATURE
+ ***************************************************************/
+inline u64 z80_device::idle_loop_signature() const
+{
+	const u64 main = (u64(AF) << 48) | (u64(BC) << 32) | (u64(DE) << 16) | u64(HL);
+	const u64 index = (u64(SP) << 32) | (u64(IX) << 16) | u64(IY);
+	return main ^ (index * 0x9e3779b97f4a7c15U);
+}
+
 /***************************************************************
  * JP
  ***************************************************************/
@@ -601,6 +613,7 @@ inline void z80_device::jp(void)
 {
 	PCD = arg16();
 	WZ = PCD;
+	idle_loop_branch(PRVPC, PCD, [this] () { return idle_loop_signature(); });
 }
 
 /***************************************************************
@@ -612,6 +625,7 @@ inline void z80_device::jp_cond(bool cond)
 	{
 		PCD = arg16();
 		WZ = PCD;
+		idle_loop_branch(PRVPC, PCD, [this] () { return idle_loop_signature(); });
 	}
 	else
 		WZ = arg16(); /* implicit do PC += 2 */
@@ -626,6 +640,7 @@ inline void z80_device::jr()
 	nomreq_addr(PCD-1, 5);
 	PC += a;                  /* so don't do PC += arg() */
 	WZ = PC;
+	idle_loop_branch(PRVPC, PCD, [this] () { return idle_loop_signature(); });
 }
 
 /***************************************************************
@@ -162,6 +162,7 @@ protected:
 	void eay();
 	void pop(PAIR &r);
 	void push(PAIR &r);
+	u64 idle_loop_signature() const;
 	void jp(void);
 	void jp_cond(bool cond);
 	void jr();
@@ -484,6 +484,8 @@ void floppy_image_device::device_start()
 	save_item(NAME(cache_start_time));
 	save_item(NAME(cache_end_time));
 	save_item(NAME(cache_index));
+	save_item(NAME(cache_next_index));
+	save_item(NAME(cache_next_base));
 	save_item(NAME(cache_entry));
 	save_item(NAME(cache_weak));
 	save_item(NAME(image_dirty));
@@ -1111,6 +1113,14 @@ uint32_t floppy_image_device::find_position(attotime &base, const attotime &when
 	base = revolution_start_time;
 	attotime delta = when - base;
 
+	// Skip whole revolutions at once after a long gap, the loops
+	// below only have to fix the rounding then
+	if(delta >= rev_time + rev_time) {
+		u32 turns = u32(delta.as_double() / rev_time.as_double()) - 1;
+		delta -= rev_time * turns;
+		base += rev_time * turns;
+	}
+
 	while(delta >= rev_time) {
 		delta -= rev_time;
 		base += rev_time;
@@ -1150,12 +1160,15 @@ void floppy_image_device::cache_fill_index(const std::vector<uint32_t> &buf, int
 	}
 
 	cache_end_time = position_to_time(base, buf[index] & floppy_image::TIME_MASK);
+	cache_next_index = index;
+	cache_next_base = base;
 }
 
 void floppy_image_device::cache_clear()
 {
 	cache_start_time = cache_end_time = cache_weak_start = attotime::zero;
-	cache_index = 0;
+	cache_index = cache_next_index = 0;
+	cache_next_base = attotime::zero;
 	cache_entry = 0;
 	cache_weak = false;
 }
@@ -1173,6 +1186,21 @@ void floppy_image_device::cache_fill(const attotime &when)
 		return;
 	}
 
+	// Reads are sequential most of the time and land in one of the
+	// cells following the current one, so try walking there before
+	// going through the position computation and the search
+	if(!cache_start_time.is_zero() && !cache_end_time.is_never() && when >= cache_end_time && cache_next_index < int(cells)) {
+		int index = cache_next_index;
+		attotime base = cache_next_base;
+		for(int i = 0; i != 8; i++) {
+			cache_fill_index(buf, index, base);
+			if(cache_end_time > when) {
+				cache_weakness_setup();
+				return;
+			}
+		}
+	}
+
 	attotime base;
 	uint32_t position = find_position(base, when);
 
@@ -231,7 +231,8 @@ protected:
 	/* Current floppy zone cache */
 	attotime cache_start_time, cache_end_time, cache_weak_start;
 	attotime amplifier_freakout_time;
-	int cache_index;
+	int cache_index, cache_next_index;
+	attotime cache_next_base;
 	u32 cache_entry;
 	bool cache_weak;
 
@@ -128,6 +128,13 @@ void harddisk_image_device::device_stop()
 	}
 }
 
+void harddisk_image_device::device_pre_save()
+{
+	// keep the image in step with the saved state
+	if (m_hard_disk_handle != nullptr)
+		m_hard_disk_handle->flush();
+}
+
 image_init_result harddisk_image_device::call_load()
 {
 	image_init_result our_result;
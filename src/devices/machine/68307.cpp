@@ -132,6 +132,7 @@ void m68307_cpu_device::init16_m68307(address_space &space)
 	m_space = &space;
 	space.cache(m_oprogram16);
 	space.specific(m_program16);
+	m_direct16 = false;
 
 	m_readimm16 = [this](offs_t address) -> u16 { /* m_m68307_currentcs = calc_cs(address); */ return m_oprogram16.read_word(address); };
 	m_read8   = [this](offs_t address) -> u8     { /* m_m68307_currentcs = calc_cs(address); */ return m_program16.read_byte(address); };
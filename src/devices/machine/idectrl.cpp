@@ -376,6 +376,40 @@ void bus_master_ide_controller_device::bmdma_w(offs_t offset, uint32_t data, uin
 	}
 }
 
+// move the buffer to and from memory a dword at a time where it's aligned
+void bus_master_ide_controller_device::dma_store(uint32_t bytes)
+{
+	bool const big = m_dma_space->endianness() == ENDIANNESS_BIG;
+	uint8_t const *data = m_dma_buffer;
+	for ( ; bytes && (m_dma_address & 3); bytes--)
+		m_dma_space->write_byte(m_dma_address++, *data++);
+	for ( ; bytes >= 4; bytes -= 4, data += 4, m_dma_address += 4)
+	{
+		if (big)
+			m_dma_space->write_dword(m_dma_address, (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3]);
+		else
+			m_dma_space->write_dword(m_dma_address, data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24));
+	}
+	for ( ; bytes; bytes--)
+		m_dma_space->write_byte(m_dma_address++, *data++);
+}
+
+void bus_master_ide_controller_device::dma_load(uint32_t bytes)
+{
+	bool const big = m_dma_space->endianness() == ENDIANNESS_BIG;
+	uint8_t *data = m_dma_buffer;
+	for ( ; bytes && (m_dma_address & 3); bytes--)
+		*data++ = m_dma_space->read_byte(m_dma_address++);
+	for ( ; bytes >= 4; bytes -= 4, data += 4, m_dma_address += 4)
+	{
+		uint32_t const d = m_dma_space->read_dword(m_dma_address);
+		for (int i = 0; i < 4; i++)
+			data[i] = d >> (big ? (24 - i * 8) : (i * 8));
+	}
+	for ( ; bytes; bytes--)
+		*data++ = m_dma_space->read_byte(m_dma_address++);
+}
+
 void bus_master_ide_controller_device::execute_dma()
 {
 	write_dmack(ASSERT_LINE);
@@ -404,26 +438,24 @@ void bus_master_ide_controller_device::execute_dma()
 			LOG("New DMA descriptor: address = %08X  bytes = %04X  last = %d time: %s\n", m_dma_address, m_dma_bytes_left, m_dma_last_buffer, machine().time().as_string());
 		}
 
+		uint32_t const words = std::min<uint32_t>(m_dma_bytes_left, sizeof(m_dma_buffer)) / 2;
+		uint32_t count;
 		if (m_bus_master_command & 8)
 		{
-			// read from ata bus
-			uint16_t data = read_dma();
-
-			// write to memory
-			m_dma_space->write_byte(m_dma_address++, data & 0xff);
-			m_dma_space->write_byte(m_dma_address++, data >> 8);
+			// read from ata bus and write to memory
+			count = read_dma_block(m_dma_buffer, words);
+			dma_store(count * 2);
 		}
 		else
 		{
-			// read from memory;
-			uint16_t data = m_dma_space->read_byte(m_dma_address++);
-			data |= m_dma_space->read_byte(m_dma_address++) << 8;
-
-			// write to ata bus
-			write_dma(data);
+			// read from memory and write to ata bus; anything the drive doesn't take is fetched again
+			offs_t const address = m_dma_address;
+			dma_load(words * 2);
+			count = write_dma_block(m_dma_buffer, words);
+			m_dma_address = address + count * 2;
 		}
 
-		m_dma_bytes_left -= 2;
+		m_dma_bytes_left -= count * 2;
 
 		if (m_dma_bytes_left == 0 && m_dma_last_buffer)
 		{
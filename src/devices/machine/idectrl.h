@@ -140,6 +140,8 @@ protected:
 
 private:
 	void execute_dma();
+	void dma_store(uint32_t bytes);
+	void dma_load(uint32_t bytes);
 
 	required_address_space m_dma_space;
 	uint8_t m_dma_address_xor;
@@ -153,6 +155,7 @@ private:
 	uint32_t m_bus_master_descriptor;
 	int m_irq;
 	int m_dmarq;
+	uint8_t m_dma_buffer[4096];
 };
 
 DECLARE_DEVICE_TYPE(BUS_MASTER_IDE_CONTROLLER, bus_master_ide_controller_device)
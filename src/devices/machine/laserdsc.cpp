@@ -49,6 +49,13 @@ const uint32_t VIRTUAL_LEAD_IN_TRACKS = (PROGRAM_MIN_RADIUS_IN_UM - LEAD_IN_MIN_
 const uint32_t MAX_TOTAL_TRACKS = 54000;
 const uint32_t VIRTUAL_LEAD_OUT_TRACKS = LEAD_OUT_MIN_SIZE_IN_UM * 1000 / NOMINAL_TRACK_PITCH_IN_NM;
 
+// decoded fields kept by the CHD, and frames decoded ahead in the direction the head is moving
+const uint32_t HUNK_CACHE_FIELDS = 32;
+const uint32_t LOOKAHEAD_FRAMES = 8;
+
+// moving further than this between two reads of the same field is a seek rather than a scan
+const int32_t MAX_SCAN_TRACKS = 256;
+
 
 
 //**************************************************************************
@@ -81,6 +88,7 @@ laserdisc_device::laserdisc_device(const machine_config &mconfig, device_type ty
 		m_readresult(),
 		m_chdtracks(0),
 		m_work_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO)),
+		m_lookahead_track{ -1, -1 },
 		m_audiosquelch(0),
 		m_videosquelch(0),
 		m_fieldnum(0),
@@ -339,6 +347,7 @@ void laserdisc_device::device_reset()
 	m_videosquelch = 1;
 	m_fieldnum = 0;
 	m_curtrack = 1;
+	m_lookahead_track[0] = m_lookahead_track[1] = -1;
 	m_attospertrack = 0;
 	m_sliderupdate = machine().time();
 }
@@ -749,6 +758,10 @@ void laserdisc_device::init_disc()
 		if (!interlaced)
 			throw emu_fatalerror("Laserdisc video must be interlaced!");
 
+		// fields are read as raw hunks through the CHD cache, which decodes ahead on worker threads
+		m_rawhunk.resize(m_disc->hunk_bytes());
+		m_disc->set_hunk_cache(HUNK_CACHE_FIELDS, LOOKAHEAD_FRAMES * 2);
+
 		// determine the maximum track and allocate a frame buffer
 		uint32_t totalhunks = m_disc->hunk_count();
 		m_chdtracks = totalhunks / 2;
@@ -1048,17 +1061,43 @@ void laserdisc_device::read_track_data()
 		m_metadata[m_fieldnum].line17 = m_metadata[m_fieldnum].line18 = m_metadata[m_fieldnum].line1718 = VBI_CODE_LEADIN;
 	}
 
-	// configure the codec and then read
+	// queue the read, then decode the fields we expect to need next
 	m_readresult = std::errc::no_such_file_or_directory;
 	if (m_disc && !m_videosquelch)
 	{
-		m_readresult = m_disc->codec_configure(CHD_CODEC_AVHUFF, AVHUFF_CODEC_DECOMPRESS_CONFIG, &m_avhuff_config);
-		if (!m_readresult)
-		{
-			m_queued_hunknum = readhunk;
-			m_readresult = chd_file::error::OPERATION_PENDING;
-			osd_work_item_queue(m_work_queue, read_async_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
-		}
+		m_queued_hunknum = readhunk;
+		m_readresult = chd_file::error::OPERATION_PENDING;
+		osd_work_item_queue(m_work_queue, read_async_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+		queue_lookahead(chdtrack);
+	}
+}
+
+
+//-------------------------------------------------
+//  queue_lookahead - ask the CHD to decode the
+//  frames ahead of the one just read, in the
+//  direction and at the rate the head is moving
+//-------------------------------------------------
+
+void laserdisc_device::queue_lookahead(int32_t chdtrack)
+{
+	// compare against the previous read of this field, so stills and steps look stationary
+	int32_t step = chdtrack - m_lookahead_track[m_fieldnum];
+	bool const seek = (m_lookahead_track[m_fieldnum] < 0) || (std::abs(step) > MAX_SCAN_TRACKS);
+	m_lookahead_track[m_fieldnum] = chdtrack;
+
+	// after a seek only the target field is decoded on demand; play normally continues forwards from there
+	if (seek)
+		step = 1;
+	else if (step == 0)
+		return;
+
+	for (int32_t frame = 1; frame <= int32_t(LOOKAHEAD_FRAMES); frame++)
+	{
+		int32_t const track = chdtrack + step * frame;
+		if ((track < 0) || (uint32_t(track) >= m_chdtracks))
+			break;
+		m_disc->prefetch(track * 2, 2);
 	}
 }
 
@@ -1071,11 +1110,64 @@ void laserdisc_device::read_track_data()
 void *laserdisc_device::read_async_static(void *param, int threadid)
 {
 	laserdisc_device &ld = *reinterpret_cast<laserdisc_device *>(param);
-	ld.m_readresult = ld.m_disc->read_hunk(ld.m_queued_hunknum, nullptr);
+	std::error_condition result = ld.m_disc->read_hunk(ld.m_queued_hunknum, &ld.m_rawhunk[0]);
+	if (!result)
+		result = ld.unpack_raw_field();
+	ld.m_readresult = result;
 	return nullptr;
 }
 
 
+//-------------------------------------------------
+//  unpack_raw_field - copy a field in the raw A/V
+//  layout into the configured video and audio
+//  targets
+//-------------------------------------------------
+
+std::error_condition laserdisc_device::unpack_raw_field()
+{
+	// the header is 'chav', metadata length, channels, then 16-bit samples, width and height
+	uint8_t const *const raw = &m_rawhunk[0];
+	if (m_rawhunk.size() < 12 || raw[0] != 'c' || raw[1] != 'h' || raw[2] != 'a' || raw[3] != 'v')
+		return chd_file::error::DECOMPRESSION_ERROR;
+	uint32_t const metasize = raw[4];
+	uint32_t const channels = raw[5];
+	uint32_t const samples = (raw[6] << 8) | raw[7];
+	uint32_t const width = (raw[8] << 8) | raw[9];
+	uint32_t const height = (raw[10] << 8) | raw[11];
+	if (avhuff_encoder::raw_data_size(raw) > m_rawhunk.size())
+		return chd_file::error::DECOMPRESSION_ERROR;
+
+	// verify against the target sizes like the codec does
+	if (m_avhuff_video.valid() && (m_avhuff_video.width() < width || m_avhuff_video.height() < height))
+		return chd_file::error::DECOMPRESSION_ERROR;
+	if (samples > m_avhuff_config.maxsamples)
+		return chd_file::error::DECOMPRESSION_ERROR;
+
+	// audio is big-endian, one channel after another
+	uint8_t const *src = raw + 12 + metasize;
+	for (uint32_t chnum = 0; chnum < channels; chnum++, src += samples * 2)
+	{
+		int16_t *const dest = (chnum < std::size(m_avhuff_config.audio)) ? m_avhuff_config.audio[chnum] : nullptr;
+		if (dest)
+			for (uint32_t sampnum = 0; sampnum < samples; sampnum++)
+				dest[sampnum] = int16_t((src[sampnum * 2] << 8) | src[sampnum * 2 + 1]);
+	}
+	*m_avhuff_config.actsamples = samples;
+
+	// video is big-endian YUY16
+	if (m_avhuff_video.valid())
+		for (uint32_t y = 0; y < height; y++, src += width * 2)
+		{
+			uint16_t *const dest = &m_avhuff_video.pix(y);
+			for (uint32_t x = 0; x < width; x++)
+				dest[x] = (src[x * 2] << 8) | src[x * 2 + 1];
+		}
+
+	return std::error_condition();
+}
+
+
 //-------------------------------------------------
 //  process_track_data - process data from a
 //  track after it has been read
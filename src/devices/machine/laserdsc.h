@@ -257,7 +257,9 @@ private:
 	void vblank_state_changed(screen_device &screen, bool vblank_state);
 	frame_data &current_frame();
 	void read_track_data();
+	void queue_lookahead(int32_t chdtrack);
 	static void *read_async_static(void *param, int threadid);
+	std::error_condition unpack_raw_field();
 	void process_track_data();
 	void config_load(config_type cfg_type, config_level cfg_level, util::xml::data_node const *parentnode);
 	void config_save(config_type cfg_type, util::xml::data_node *parentnode);
@@ -287,6 +289,8 @@ private:
 	// async operations
 	osd_work_queue *    m_work_queue;           // work queue
 	uint32_t            m_queued_hunknum;       // queued hunk
+	std::vector<uint8_t> m_rawhunk;             // raw A/V data for the queued hunk
+	int32_t             m_lookahead_track[2];   // CHD track of the last read of each field, for read-ahead
 
 	// core states
 	uint8_t             m_audiosquelch;         // audio squelch state: bit 0 = audio 1, bit 1 = audio 2
@@ -552,6 +552,15 @@ void ncr5390_device::step(bool timeout)
 			if (xfr_phase == S_PHASE_MSG_OUT && ((!dma_command && fifo_pos == 1) || (dma_command && tcounter == 1)))
 				scsi_bus->ctrl_w(scsi_refid, 0, S_ATN);
 
+			// hand all but the last byte in the fifo to the target at once when it can take
+			// them; drq is updated when the last one is sent
+			if (dma_command && xfr_phase == S_PHASE_DATA_OUT && fifo_pos > 1)
+			{
+				int const count = scsi_bus->data_out_block(scsi_refid, fifo, fifo_pos - 1);
+				fifo_pos -= count;
+				memmove(fifo, fifo + count, fifo_pos);
+			}
+
 			send_byte();
 			break;
 
@@ -562,6 +571,11 @@ void ncr5390_device::step(bool timeout)
 			if (fifo_pos == 16)
 				break;
 
+			// fill the fifo from the target at once when it can, leaving the last byte to the
+			// handshake, which also updates drq
+			if (dma_command && xfr_phase == S_PHASE_DATA_IN && !(status & S_TC0))
+				fifo_pos += scsi_bus->data_in_block(scsi_refid, fifo + fifo_pos, std::min<int>(15 - fifo_pos, tcounter - fifo_pos - 1));
+
 			// if it's the last message byte, ACK remains asserted, terminate with function_complete()
 			state = (xfr_phase == S_PHASE_MSG_IN && (!dma_command || tcounter == 1)) ? INIT_XFR_RECV_BYTE_NACK : INIT_XFR_RECV_BYTE_ACK;
 
@@ -125,6 +125,26 @@ void nscsi_bus_device::ctrl_wait(int refid, uint32_t lines, uint32_t mask)
 	dev[refid].wait_ctrl = (w & ~mask) | (lines & mask);
 }
 
+int nscsi_bus_device::data_in_block(int refid, uint8_t *buf, int len)
+{
+	if(len <= 0 || (ctrl & (nscsi_device::S_REQ|nscsi_device::S_ACK|nscsi_device::S_PHASE_MASK)) != (nscsi_device::S_REQ|nscsi_device::S_PHASE_DATA_IN))
+		return 0;
+	for(int i=0; i<devcnt; i++)
+		if(i != refid && (dev[i].ctrl & nscsi_device::S_REQ))
+			return dev[i].dev->scsi_data_in_block(buf, len);
+	return 0;
+}
+
+int nscsi_bus_device::data_out_block(int refid, const uint8_t *buf, int len)
+{
+	if(len <= 0 || (ctrl & (nscsi_device::S_REQ|nscsi_device::S_ACK|nscsi_device::S_PHASE_MASK)) != (nscsi_device::S_REQ|nscsi_device::S_PHASE_DATA_OUT))
+		return 0;
+	for(int i=0; i<devcnt; i++)
+		if(i != refid && (dev[i].ctrl & nscsi_device::S_REQ))
+			return dev[i].dev->scsi_data_out_block(buf, len);
+	return 0;
+}
+
 void nscsi_bus_device::device_resolve_objects()
 {
 	for(int i=0; i<16; i++) {
@@ -186,6 +206,16 @@ void nscsi_device::scsi_ctrl_changed()
 {
 }
 
+int nscsi_device::scsi_data_in_block(uint8_t *buf, int len)
+{
+	return 0;
+}
+
+int nscsi_device::scsi_data_out_block(const uint8_t *buf, int len)
+{
+	return 0;
+}
+
 void nscsi_device::device_start()
 {
 	save_item(NAME(scsi_id));
@@ -276,6 +306,47 @@ void nscsi_full_device::scsi_ctrl_changed()
 	step(false);
 }
 
+// The target is waiting for ACK on the byte it put on the bus.  Hand that
+// one and the ones following over, then put up the next as if they had
+// all been acknowledged.
+int nscsi_full_device::scsi_data_in_block(uint8_t *buf, int len)
+{
+	if((scsi_state & SUB_MASK) != (SEND_BYTE_T_WAIT_ACK_1 << SUB_SHIFT) || (scsi_bus->ctrl_r() & S_PHASE_MASK) != S_PHASE_DATA_IN)
+		return 0;
+
+	int count = std::min(len, data_buffer_size - data_buffer_pos);
+	if(count <= 0)
+		return 0;
+
+	buf[0] = scsi_bus->data_r();
+	for(int i=1; i<count; i++)
+		buf[i] = scsi_get_data(data_buffer_id, data_buffer_pos++);
+	if(data_buffer_pos == data_buffer_size-1)
+		scsi_state = TARGET_NEXT_CONTROL | (scsi_state & SUB_MASK);
+	scsi_bus->data_w(scsi_refid, scsi_get_data(data_buffer_id, data_buffer_pos++));
+	LOGMASKED(LOG_DATA, "data in block %d bytes\n", count);
+	return count;
+}
+
+// The target is requesting a byte.  Take as many as given up to, but not
+// including, the last of the phase and keep requesting.
+int nscsi_full_device::scsi_data_out_block(const uint8_t *buf, int len)
+{
+	if((scsi_state & SUB_MASK) != (RECV_BYTE_T_WAIT_ACK_1 << SUB_SHIFT) || (scsi_bus->ctrl_r() & S_PHASE_MASK) != S_PHASE_DATA_OUT)
+		return 0;
+
+	int count = std::min(len, data_buffer_size - 1 - data_buffer_pos);
+	if(count <= 0)
+		return 0;
+
+	for(int i=0; i<count; i++)
+		scsi_put_data(data_buffer_id, data_buffer_pos++, buf[i]);
+	if(data_buffer_pos == data_buffer_size-1)
+		scsi_state = TARGET_NEXT_CONTROL | (scsi_state & SUB_MASK);
+	LOGMASKED(LOG_DATA, "data out block %d bytes\n", count);
+	return count;
+}
+
 void nscsi_full_device::step(bool timeout)
 {
 	uint32_t ctrl = scsi_bus->ctrl_r();
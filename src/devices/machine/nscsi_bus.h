@@ -18,6 +18,13 @@ public:
 	void data_w(int refid, uint32_t lines);
 	void ctrl_wait(int refid, uint32_t lines, uint32_t mask);
 
+	// Move data phase bytes straight from or to the target requesting
+	// them, returns how many were moved.  The last byte of the phase is
+	// always left to the handshake, as is everything when the target
+	// doesn't support it.
+	int data_in_block(int refid, uint8_t *buf, int len);
+	int data_out_block(int refid, const uint8_t *buf, int len);
+
 	uint32_t ctrl_r() const;
 	uint32_t data_r() const;
 
@@ -129,6 +136,8 @@ public:
 
 	void connect_to_bus(nscsi_bus_device *bus, int refid, int default_scsi_id);
 	virtual void scsi_ctrl_changed();
+	virtual int scsi_data_in_block(uint8_t *buf, int len);
+	virtual int scsi_data_out_block(const uint8_t *buf, int len);
 
 protected:
 	nscsi_device(const machine_config &mconfig, device_type type, const char *tag, device_t *owner, uint32_t clock);
@@ -144,6 +153,8 @@ class nscsi_full_device : public nscsi_device, public nscsi_slot_card_interface
 {
 public:
 	virtual void scsi_ctrl_changed() override;
+	virtual int scsi_data_in_block(uint8_t *buf, int len) override;
+	virtual int scsi_data_out_block(const uint8_t *buf, int len) override;
 
 protected:
 	// SCSI status returns
@@ -843,6 +843,7 @@ void stvcd_device::cmd_play_disc()
 	}
 
 	LOG("Play Disc: start %x length %x\n", cd_curfad, fadstoplay);
+	cdrom->prefetch(((cd_stat == CD_STAT_SEEK) ? cd_fad_seek : cd_curfad) - 150, fadstoplay);
 
 	cr_standard_return(cd_stat);
 	hirqreg |= (CMOK);
@@ -1775,6 +1776,7 @@ void stvcd_device::cmd_read_file()
 	cd_stat = CD_STAT_PLAY|0x80;    // set "cd-rom" bit
 	cd_curfad = (curdir[file_id].firstfad + file_offset);
 	fadstoplay = file_size;
+	cdrom->prefetch(cd_curfad - 150, fadstoplay);
 	if(file_filter < MAX_FILTERS)
 		cddevice = &filters[file_filter];
 	else
@@ -180,6 +180,7 @@ void t10mmc::ExecCommand()
 			m_cur_subblock = 0;
 		}
 
+		m_cdrom->prefetch(m_lba, m_blocks);
 		abort_audio();
 
 		m_phase = SCSI_PHASE_DATAIN;
@@ -492,6 +493,7 @@ void t10mmc::ExecCommand()
 			m_cur_subblock = 0;
 		}
 
+		m_cdrom->prefetch(m_lba, m_blocks);
 		abort_audio();
 
 		m_phase = SCSI_PHASE_DATAIN;
@@ -923,6 +923,7 @@ void aica_device::w16(u32 addr,u16 val)
 		else if (addr < 0x3c00)
 		{
 			*((u16 *)(m_DSP.MPRO+(addr - 0x3400) / 2)) = val;
+			m_DSP.invalidate();
 
 			if (addr == 0x3bfe)
 			{
@@ -1236,32 +1237,60 @@ s32 aica_device::UpdateSlot(AICA_SLOT *slot)
 	return sample;
 }
 
+// generate up to a block of samples for one slot, adding them to the block's mix
+// (slots don't affect each other, and registers can't change during an update)
+void aica_device::RenderSlot(AICA_SLOT *slot, int samples)
+{
+	const int dsp_level = m_LPANTABLE[((TL(slot)) << 0x0) | ((IMXL(slot)) << 0xd)];
+	const u32 Enc = ((TL(slot)) << 0x0) | ((DIPAN(slot)) << 0x8) | ((DISDL(slot)) << 0xd);
+	const int left = m_LPANTABLE[Enc];
+	const int right = m_RPANTABLE[Enc];
+
+	const u32 sel = ISEL(slot);
+	s32 *const mixs = m_MixS[sel];
+	if (!BIT(m_MixSUsed, sel))
+	{
+		std::fill_n(mixs, samples, 0);
+		m_MixSUsed |= 1 << sel;
+	}
+
+	for (int s = 0; (s < samples) && slot->active; ++s)
+	{
+		const s32 sample = UpdateSlot(slot);
+		mixs[s] += (sample * dsp_level) >> (SHIFT - 2);
+		m_MixL[s] += (sample * left) >> SHIFT;
+		m_MixR[s] += (sample * right) >> SHIFT;
+	}
+}
+
 void aica_device::DoMasterSamples(std::vector<read_stream_view> const &inputs, write_stream_view &bufl, write_stream_view &bufr)
 {
 	int i;
 
 	for (int s = 0; s < bufl.samples(); ++s)
 	{
-		s32 smpl = 0, smpr = 0;
-
-		// mix slots' direct output
-		for (int sl = 0; sl < 64; ++sl)
+		// mix slots' direct output for the next block
+		const int block = s % MIX_BLOCK;
+		if (!block)
 		{
-			AICA_SLOT *slot = m_Slots + sl;
-			if (m_Slots[sl].active)
+			const int samples = std::min<int>(bufl.samples() - s, MIX_BLOCK);
+			std::fill_n(m_MixL, samples, 0);
+			std::fill_n(m_MixR, samples, 0);
+			m_MixSUsed = 0;
+			for (int sl = 0; sl < 64; ++sl)
 			{
-				s32 sample = UpdateSlot(slot);
-
-				u32 Enc = ((TL(slot)) << 0x0) | ((IMXL(slot)) << 0xd);
-				m_DSP.setsample((sample * m_LPANTABLE[Enc]) >> (SHIFT - 2), ISEL(slot), IMXL(slot));
-				Enc = ((TL(slot)) << 0x0) | ((DIPAN(slot)) << 0x8) | ((DISDL(slot)) << 0xd);
-				{
-					smpl += (sample * m_LPANTABLE[Enc]) >> SHIFT;
-					smpr += (sample * m_RPANTABLE[Enc]) >> SHIFT;
-				}
+				if (m_Slots[sl].active)
+					RenderSlot(m_Slots + sl, samples);
 			}
 		}
 
+		s32 smpl = m_MixL[block], smpr = m_MixR[block];
+		for (i = 0; i < 16; ++i)
+		{
+			if (BIT(m_MixSUsed, i))
+				m_DSP.setsample(m_MixS[i][block], i, 0);
+		}
+
 		// process the DSP
 		m_DSP.step();
 
@@ -1488,6 +1517,8 @@ void aica_device::device_post_load()
 {
 	for (int slot = 0; slot < 64; slot++)
 		Compute_LFO(&m_Slots[slot]);
+
+	m_DSP.invalidate();
 }
 
 //-------------------------------------------------
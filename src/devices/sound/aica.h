@@ -126,6 +126,7 @@ private:
 	u16 r16(u32 addr);
 	[[maybe_unused]] void TimersAddTicks(int ticks);
 	s32 UpdateSlot(AICA_SLOT *slot);
+	void RenderSlot(AICA_SLOT *slot, int samples);
 	void DoMasterSamples(std::vector<read_stream_view> const &inputs, write_stream_view &bufl, write_stream_view &bufr);
 	void exec_dma();
 
@@ -186,6 +187,12 @@ private:
 
 	AICADSP m_DSP;
 
+	// slot output is generated a block at a time, one slot after another
+	static constexpr int MIX_BLOCK = 64;
+	s32 m_MixL[MIX_BLOCK], m_MixR[MIX_BLOCK];   // direct output
+	s32 m_MixS[16][MIX_BLOCK];                  // DSP inputs
+	u16 m_MixSUsed;                             // DSP inputs written in this block
+
 	s32 m_EG_TABLE[0x400];
 	int m_PLFO_TRI[256],m_PLFO_SQR[256],m_PLFO_SAW[256],m_PLFO_NOI[256];
 	int m_ALFO_TRI[256],m_ALFO_SQR[256],m_ALFO_SAW[256],m_ALFO_NOI[256];
@@ -6,6 +6,33 @@
 
 #include <algorithm>
 
+// run the interpreter alongside the translated program and log any difference
+static constexpr bool VERIFY_TRANSLATION = false;
+
+// flags for a translated step
+enum : u32
+{
+	OP_IWT          = 1U << 0,
+	OP_INPUT_MEMVAL = 1U << 1,  // IWT replaces INPUTS as well
+	OP_X_INPUTS     = 1U << 2,  // XSEL
+	OP_B_ACC        = 1U << 3,  // BSEL
+	OP_ZERO         = 1U << 4,
+	OP_NEGB         = 1U << 5,
+	OP_YRL          = 1U << 6,
+	OP_CLAMP        = 1U << 7,  // SHIFT 0 or 1 saturate, 2 and 3 wrap
+	OP_SHIFT3       = 1U << 8,
+	OP_TWT          = 1U << 9,
+	OP_FRCL         = 1U << 10,
+	OP_MRD          = 1U << 11, // only set on odd steps, the only ones that access memory
+	OP_MWT          = 1U << 12, // likewise
+	OP_TABLE        = 1U << 13,
+	OP_ADREB        = 1U << 14,
+	OP_NXADR        = 1U << 15,
+	OP_NOFL         = 1U << 16,
+	OP_ADRL         = 1U << 17,
+	OP_EWT          = 1U << 18
+};
+
 static u16 PACK(s32 val)
 {
 	const int sign = (val >> 23) & 0x1;
@@ -59,6 +86,28 @@ void AICADSP::init()
 }
 
 void AICADSP::step()
+{
+	if (Stopped)
+		return;
+
+	if (Dirty)
+	{
+		Dirty = false;
+		Translated = translate();
+	}
+
+	auto const read = [this] (u32 addr) -> u16 { return cache.read_word(addr); };
+	auto const write = [this] (u32 addr, u16 data) { space.write_word(addr, data); };
+	if (!Translated)
+		interpret(read, write);
+	else if (VERIFY_TRANSLATION)
+		verify();
+	else
+		execute(read, write);
+}
+
+template <typename Read, typename Write>
+void AICADSP::interpret(Read &&read, Write &&write)
 {
 	s32 ACC=0;    //26 bit
 	s32 MEMVAL=0;
@@ -66,9 +115,6 @@ void AICADSP::step()
 	s32 Y_REG=0;      //24 bit
 	u32 ADRS_REG=0;  //13 bit
 
-	if (Stopped)
-		return;
-
 	std::fill(std::begin(EFREG), std::end(EFREG), 0);
 #if 0
 	int dump=0;
@@ -278,16 +324,16 @@ void AICADSP::step()
 			if (MRD && (step & 1)) //memory only allowed on odd? DoA inserts NOPs on even
 			{
 				if (NOFL)
-					MEMVAL = cache.read_word(ADDR) << 8;
+					MEMVAL = read(ADDR) << 8;
 				else
-					MEMVAL = UNPACK(cache.read_word(ADDR));
+					MEMVAL = UNPACK(read(ADDR));
 			}
 			if (MWT && (step&1))
 			{
 				if (NOFL)
-					space.write_word(ADDR, SHIFTED>>8);
+					write(ADDR, SHIFTED>>8);
 				else
-					space.write_word(ADDR, PACK(SHIFTED));
+					write(ADDR, PACK(SHIFTED));
 			}
 		}
 
@@ -309,6 +355,262 @@ void AICADSP::step()
 //      fclose(f);
 }
 
+// decode the program once rather than for every sample; fails if only the interpreter can run it
+bool AICADSP::translate()
+{
+	for (int step = 0; step < LastStep; ++step)
+	{
+		const u16 *IPtr = MPRO + step * 8;
+		Op &op = Program[step];
+
+		const u32 IRA   = (IPtr[2] >>  7) & 0x3F;
+		if (IRA > 0x31)
+			return false; // not valid, leave it to the interpreter
+
+		const u32 TWT   = (IPtr[0] >>  8) & 0x01;
+		const u32 XSEL  = (IPtr[2] >> 15) & 0x01;
+		const u32 IWT   = (IPtr[2] >>  6) & 0x01;
+		const u32 IWA   = (IPtr[2] >>  1) & 0x1F;
+		const u32 TABLE = (IPtr[4] >> 15) & 0x01;
+		const u32 MWT   = (IPtr[4] >> 14) & 0x01;
+		const u32 MRD   = (IPtr[4] >> 13) & 0x01;
+		const u32 EWT   = (IPtr[4] >> 12) & 0x01;
+		const u32 ADRL  = (IPtr[4] >>  7) & 0x01;
+		const u32 FRCL  = (IPtr[4] >>  6) & 0x01;
+		const u32 SHIFT = (IPtr[4] >>  4) & 0x03;
+		const u32 YRL   = (IPtr[4] >>  3) & 0x01;
+		const u32 NEGB  = (IPtr[4] >>  2) & 0x01;
+		const u32 ZERO  = (IPtr[4] >>  1) & 0x01;
+		const u32 BSEL  = (IPtr[4] >>  0) & 0x01;
+		const u32 NOFL  = (IPtr[6] >> 15) & 1;
+		const u32 ADREB = (IPtr[6] >>  8) & 0x1;
+		const u32 NXADR = (IPtr[6] >>  7) & 0x1;
+		const bool odd = step & 1;
+
+		op.TRA   = (IPtr[0] >>  9) & 0x7F;
+		op.TWA   = (IPtr[0] >>  1) & 0x7F;
+		op.IRA   = (IRA <= 0x1f) ? IRA : (IRA <= 0x2f) ? (IRA - 0x20) : (IRA - 0x30);
+		op.INSEL = (IRA <= 0x1f) ? 0 : (IRA <= 0x2f) ? 1 : 2;
+		op.IWA   = IWA;
+		op.EWA   = (IPtr[4] >>  8) & 0x0F;
+		op.MASA  = (IPtr[6] >>  9) & 0x1f;
+		op.YSEL  = (IPtr[2] >> 13) & 0x03;
+		op.SCALE = ((SHIFT == 1) || (SHIFT == 2)) ? 1 : 0;
+
+		op.flags = 0;
+		if (IWT)
+			op.flags |= OP_IWT | ((IRA == IWA) ? OP_INPUT_MEMVAL : 0);
+		if (XSEL)
+			op.flags |= OP_X_INPUTS;
+		if (BSEL)
+			op.flags |= OP_B_ACC;
+		if (ZERO)
+			op.flags |= OP_ZERO;
+		if (NEGB)
+			op.flags |= OP_NEGB;
+		if (YRL)
+			op.flags |= OP_YRL;
+		if (SHIFT < 2)
+			op.flags |= OP_CLAMP;
+		if (SHIFT == 3)
+			op.flags |= OP_SHIFT3;
+		if (TWT)
+			op.flags |= OP_TWT;
+		if (FRCL)
+			op.flags |= OP_FRCL;
+		if (MRD && odd)
+			op.flags |= OP_MRD;
+		if (MWT && odd)
+			op.flags |= OP_MWT;
+		if (TABLE)
+			op.flags |= OP_TABLE;
+		if (ADREB)
+			op.flags |= OP_ADREB;
+		if (NXADR)
+			op.flags |= OP_NXADR;
+		if (NOFL)
+			op.flags |= OP_NOFL;
+		if (ADRL)
+			op.flags |= OP_ADRL;
+		if (EWT)
+			op.flags |= OP_EWT;
+	}
+	return true;
+}
+
+// run the translated program; operands are selected without branching, and
+// the results are the same as the interpreter's
+template <typename Read, typename Write>
+void AICADSP::execute(Read &&read, Write &&write)
+{
+	s32 ACC=0;    //26 bit
+	s32 MEMVAL=0;
+	s32 FRC_REG=0;    //13 bit
+	s32 Y_REG=0;      //24 bit
+	u32 ADRS_REG=0;  //13 bit
+
+	std::fill(std::begin(EFREG), std::end(EFREG), 0);
+
+	for (int step = 0; step < LastStep; ++step)
+	{
+		const Op &op = Program[step];
+		const u32 flags = op.flags;
+
+		const s32 sources[3] = { MEMS[op.IRA & 0x1f], MIXS[op.IRA & 0x0f] << 4, EXTS[op.IRA & 0x01] << 8 };
+		s32 INPUTS = sources[op.INSEL]; // 24-bit
+		INPUTS <<= 8;
+		INPUTS >>= 8;
+
+		if (flags & OP_IWT)
+		{
+			MEMS[op.IWA] = MEMVAL;
+			if (flags & OP_INPUT_MEMVAL)
+				INPUTS = MEMVAL;
+		}
+
+		// the shifter works on the previous step's ACC
+		s32 SHIFTED = ACC << op.SCALE;    //24 bit
+		if (flags & OP_CLAMP)
+		{
+			SHIFTED = std::clamp<s32>(SHIFTED, -0x00800000, 0x007FFFFF);
+		}
+		else
+		{
+			SHIFTED <<= 8;
+			SHIFTED >>= 8;
+		}
+
+		s32 TEMPVAL = TEMP[(op.TRA + DEC) & 0x7F];
+		TEMPVAL <<= 8;
+		TEMPVAL >>= 8;
+		const s32 X = (flags & OP_X_INPUTS) ? INPUTS : TEMPVAL; // 24 bit
+		const s32 negate = (flags & OP_NEGB) ? -1 : 0;
+		s32 B = (flags & OP_B_ACC) ? ACC : TEMPVAL; // 26 bit
+		B = (flags & OP_ZERO) ? 0 : ((B ^ negate) - negate);
+
+		const s32 ysources[4] = { FRC_REG, COEF[step << 1] >> 3, (Y_REG >> 11) & 0x1FFF, (Y_REG >> 4) & 0x0FFF };
+		s32 Y = ysources[op.YSEL];  //13 bit
+		Y <<= 19;
+		Y >>= 19;
+
+		const s64 v = (((s64)X * (s64)Y) >> 12);
+		ACC = (int)v + B;
+
+		if (flags & OP_YRL)
+			Y_REG = INPUTS;
+
+		if (flags & OP_TWT)
+			TEMP[(op.TWA + DEC) & 0x7F] = SHIFTED;
+
+		if (flags & OP_FRCL)
+		{
+			if (flags & OP_SHIFT3)
+				FRC_REG = SHIFTED & 0x0FFF;
+			else
+				FRC_REG = (SHIFTED >> 11) & 0x1FFF;
+		}
+
+		if (flags & (OP_MRD | OP_MWT))
+		{
+			u32 ADDR = MADRS[op.MASA << 1];
+			if (!(flags & OP_TABLE))
+				ADDR += DEC;
+			if (flags & OP_ADREB)
+				ADDR += ADRS_REG & 0x0FFF;
+			if (flags & OP_NXADR)
+				ADDR++;
+			if (!(flags & OP_TABLE))
+				ADDR &= RBL - 1;
+			else
+				ADDR &= 0xFFFF;
+			ADDR += RBP << 10;
+			if (flags & OP_MRD)
+			{
+				if (flags & OP_NOFL)
+					MEMVAL = read(ADDR) << 8;
+				else
+					MEMVAL = UNPACK(read(ADDR));
+			}
+			if (flags & OP_MWT)
+			{
+				if (flags & OP_NOFL)
+					write(ADDR, SHIFTED>>8);
+				else
+					write(ADDR, PACK(SHIFTED));
+			}
+		}
+
+		if (flags & OP_ADRL)
+		{
+			if (flags & OP_SHIFT3)
+				ADRS_REG = (SHIFTED >> 12) & 0xFFF;
+			else
+				ADRS_REG = (INPUTS >> 16);
+		}
+
+		if (flags & OP_EWT)
+			EFREG[op.EWA] += SHIFTED >> 8;
+	}
+	--DEC;
+	std::fill(std::begin(MIXS), std::end(MIXS), 0);
+}
+
+// run the interpreter, then the translated program from the same state, and compare them
+void AICADSP::verify()
+{
+	struct write_record { u32 addr; u16 data; };
+	write_record expected[64], actual[64]; // memory is only written on odd steps
+	unsigned expected_count = 0, actual_count = 0;
+
+	const u32 saved_dec = DEC;
+	s32 saved_temp[128], saved_mems[32], saved_mixs[16];
+	std::copy(std::begin(TEMP), std::end(TEMP), saved_temp);
+	std::copy(std::begin(MEMS), std::end(MEMS), saved_mems);
+	std::copy(std::begin(MIXS), std::end(MIXS), saved_mixs);
+
+	// keep the interpreter's writes to itself, so both see the same memory
+	// (addresses can be odd here, and the bus ignores the low bit)
+	interpret(
+			[this, &expected, &expected_count] (u32 addr) -> u16
+			{
+				for (unsigned i = expected_count; i--; )
+				{
+					if ((expected[i].addr >> 1) == (addr >> 1))
+						return expected[i].data;
+				}
+				return cache.read_word(addr);
+			},
+			[&expected, &expected_count] (u32 addr, u16 data) { expected[expected_count++] = write_record{ addr, data }; });
+
+	const u32 expected_dec = DEC;
+	s32 expected_temp[128], expected_mems[32];
+	s16 expected_efreg[16];
+	std::copy(std::begin(TEMP), std::end(TEMP), expected_temp);
+	std::copy(std::begin(MEMS), std::end(MEMS), expected_mems);
+	std::copy(std::begin(EFREG), std::end(EFREG), expected_efreg);
+
+	DEC = saved_dec;
+	std::copy(std::begin(saved_temp), std::end(saved_temp), TEMP);
+	std::copy(std::begin(saved_mems), std::end(saved_mems), MEMS);
+	std::copy(std::begin(saved_mixs), std::end(saved_mixs), MIXS);
+	execute(
+			[this] (u32 addr) -> u16 { return cache.read_word(addr); },
+			[this, &actual, &actual_count] (u32 addr, u16 data)
+			{
+				actual[actual_count++] = write_record{ addr, data };
+				space.write_word(addr, data);
+			});
+
+	bool match = (DEC == expected_dec) && (actual_count == expected_count)
+			&& std::equal(std::begin(TEMP), std::end(TEMP), expected_temp)
+			&& std::equal(std::begin(MEMS), std::end(MEMS), expected_mems)
+			&& std::equal(std::begin(EFREG), std::end(EFREG), expected_efreg);
+	for (unsigned i = 0; match && (i < actual_count); i++)
+		match = (actual[i].addr == expected[i].addr) && (actual[i].data == expected[i].data);
+	if (!match)
+		space.space().device().logerror("AICADSP: translated program differs from the interpreter (DEC %04x)\n", saved_dec);
+}
+
 void AICADSP::setsample(s32 sample, u8 SEL, s32 MXL)
 {
 	//MIXS[SEL] += sample << (MXL + 1)/*7*/;
@@ -321,6 +623,7 @@ void AICADSP::start()
 {
 	int i;
 	Stopped = false;
+	Dirty = true;
 	for (i = 127; i >= 0; --i)
 	{
 		u16 *IPtr = MPRO + i * 8;
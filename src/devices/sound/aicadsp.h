@@ -12,6 +12,7 @@ struct AICADSP
 	void setsample(s32 sample, u8 SEL, s32 MXL);
 	void step();
 	void start();
+	void invalidate() { Dirty = true; }
 
 //Config
 	memory_access<23, 1, 0, ENDIANNESS_LITTLE>::cache cache;
@@ -37,6 +38,22 @@ struct AICADSP
 
 	bool Stopped;
 	int LastStep;
+
+//translated program, rebuilt from MPRO when it changes
+	struct Op
+	{
+		u32 flags;
+		u8 TRA, TWA, IRA, INSEL, IWA, EWA, MASA, YSEL, SCALE;
+	};
+	Op Program[128];
+	bool Dirty;       // MPRO changed since it was translated
+	bool Translated;  // Program can be used, otherwise MPRO is interpreted
+
+private:
+	bool translate();
+	template <typename Read, typename Write> void interpret(Read &&read, Write &&write);
+	template <typename Read, typename Write> void execute(Read &&read, Write &&write);
+	void verify();
 };
 
 #endif // MAME_SOUND_AICADSP_H
@@ -40,6 +40,7 @@
 
 #include "wavwrite.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstdarg>
 #include <iostream>
@@ -139,13 +140,26 @@ protected:
 
 	void check(discrete_task &dest_task);
 	void prepare_for_queue(int samples);
+	bool build_block_schedule();
+	inline void step_block(int samples);
 
 	std::vector<output_buffer>      m_buffers;
 	discrete_device &                   m_device;
 
 private:
+	struct block_node
+	{
+		discrete_step_interface *   node;
+		discrete_block_links        links;
+	};
+
 	std::atomic<int32_t>      m_threadid;
 	volatile int            m_samples = 0;
+
+	/* block schedule, nodes stepped one after the other over a slice */
+	bool                    m_use_blocks = false;
+	std::vector<block_node> m_block_list;
+	std::vector<std::unique_ptr<double []>> m_block_buffers;
 };
 
 
@@ -209,6 +223,12 @@ inline void discrete_task::step_nodes()
 		*outbuf.ptr++ = *outbuf.source;
 }
 
+inline void discrete_task::step_block(int samples)
+{
+	for (block_node &entry : m_block_list)
+		entry.node->step_block(*entry.node, entry.links, samples);
+}
+
 void *discrete_task::task_callback(void *param, int threadid)
 {
 	const auto &list = *reinterpret_cast<const discrete_sound_device::task_list_t *>(param);
@@ -246,6 +266,12 @@ bool discrete_task::process()
 	m_samples -= samples;
 	if (m_samples < 0)
 		throw emu_fatalerror("discrete_task::process: m_samples got negative");
+	if (m_use_blocks && m_device.block_stepping())
+	{
+		/* step node by node over the whole slice */
+		step_block(samples);
+		samples = 0;
+	}
 	while (samples > 0)
 	{
 		/* step */
@@ -338,6 +364,74 @@ void discrete_task::check(discrete_task &dest_task)
 	}
 }
 
+/*
+ * Build the block schedule of a task. Each node is stepped over a whole
+ * slice before the next one, its node inputs are pointed into buffers
+ * filled by the nodes feeding them. This only works if every node feeding
+ * a node is stepped before it in the same task: tasks exchanging samples
+ * with other tasks and nodes with feedback keep stepping sample by sample.
+ */
+bool discrete_task::build_block_schedule()
+{
+	m_block_list.clear();
+	m_block_buffers.clear();
+
+	if (!source_list.empty() || !m_buffers.empty())
+		return false;
+
+	for (discrete_step_interface *step_entry : step_list)
+	{
+		discrete_base_node *node = step_entry->self;
+		block_node entry{ step_entry, discrete_block_links() };
+
+		if (step_entry->step_block == nullptr)
+			break;
+
+		for (int inputnum = 0; inputnum < node->active_inputs(); inputnum++)
+		{
+			int inputnode_num = node->input_node(inputnum);
+			if (!IS_VALUE_A_NODE(inputnode_num))
+				continue;
+
+			/* nodes not stepping (inputs, ...) are read as they are */
+			discrete_step_interface *src_step;
+			if (!m_device.discrete_find_node(inputnode_num)->interface(src_step))
+				continue;
+
+			auto src = std::find_if(m_block_list.begin(), m_block_list.end(), [src_step] (const block_node &e) { return e.node == src_step; });
+			if (src == m_block_list.end())
+			{
+				m_device.discrete_log("discrete_task - NODE_%02d needs NODE_%02d before it is stepped, no block schedule", node->index(), NODE_INDEX(inputnode_num));
+				m_block_list.clear();
+				m_block_buffers.clear();
+				return false;
+			}
+
+			const double *live = node->m_input[inputnum];
+			double *buffer = nullptr;
+			for (const auto &out : src->links.outputs)
+				if (out.source == live)
+					buffer = out.buffer;
+			if (buffer == nullptr)
+			{
+				m_block_buffers.push_back(std::make_unique<double []>(MAX_SAMPLES_PER_TASK_SLICE));
+				buffer = m_block_buffers.back().get();
+				src->links.outputs.push_back(discrete_block_links::output{ live, buffer });
+			}
+			entry.links.inputs.push_back(discrete_block_links::input{ &node->m_input[inputnum], buffer, live });
+		}
+		m_block_list.push_back(std::move(entry));
+	}
+
+	if (m_block_list.size() != step_list.size())
+	{
+		m_block_list.clear();
+		m_block_buffers.clear();
+		return false;
+	}
+	return true;
+}
+
 /*************************************
  *
  *  Base node implementation
@@ -446,6 +540,7 @@ const double *discrete_device::node_output_ptr(int onode)
 
 	if (node != nullptr)
 	{
+		m_hidden_links = true;
 		return &(node->m_output[NODE_CHILD_NODE_NUM(onode)]);
 	}
 	else
@@ -819,6 +914,7 @@ discrete_device::discrete_device(const machine_config &mconfig, device_type type
 		m_indexed_node(nullptr),
 		m_disclogfile(nullptr),
 		m_queue(nullptr),
+		m_hidden_links(false),
 		m_profiling(0),
 		m_total_samples(0),
 		m_total_stream_updates(0)
@@ -889,8 +985,9 @@ void discrete_device::device_start()
 		node->resolve_input_nodes();
 	}
 
-	/* allocate a queue */
-	m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+	/* allocate a queue, a single task is run directly */
+	if (task_list.size() > 1)
+		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
 
 	/* Process nodes which have a start func */
 	for (const auto &node : m_node_list)
@@ -907,6 +1004,10 @@ void discrete_device::device_start()
 				dest_task->check(*task);
 		}
 	}
+
+	/* compile the tasks without links to other tasks into block schedules */
+	for (const auto &task : task_list)
+		task->m_use_blocks = task->build_block_schedule();
 }
 
 void discrete_device::device_stop()
@@ -1017,22 +1118,33 @@ void discrete_device::process(int samples)
 	if (samples == 0)
 		return;
 
-	/* Setup tasks */
-	for (const auto &task : task_list)
+	if (task_list.size() == 1)
 	{
-		/* unlock the thread */
-		task->unlock();
-
-		task->prepare_for_queue(samples);
+		/* nothing to wait for, no need to go through the work queue */
+		discrete_task &task = *task_list.front();
+		task.prepare_for_queue(samples);
+		while (task.process())
+			;
 	}
-
-	for (const auto &task : task_list)
+	else
 	{
-		/* Fire a work item for each task */
-		(void)task;
-		osd_work_item_queue(m_queue, discrete_task::task_callback, (void *)&task_list, WORK_ITEM_FLAG_AUTO_RELEASE);
+		/* Setup tasks */
+		for (const auto &task : task_list)
+		{
+			/* unlock the thread */
+			task->unlock();
+
+			task->prepare_for_queue(samples);
+		}
+
+		for (const auto &task : task_list)
+		{
+			/* Fire a work item for each task */
+			(void)task;
+			osd_work_item_queue(m_queue, discrete_task::task_callback, (void *)&task_list, WORK_ITEM_FLAG_AUTO_RELEASE);
+		}
+		osd_work_queue_wait(m_queue, osd_ticks_per_second()*10);
 	}
-	osd_work_queue_wait(m_queue, osd_ticks_per_second()*10);
 
 	if (m_profiling)
 	{
@@ -8,6 +8,7 @@
 #include "machine/rescap.h"
 
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 
@@ -4141,6 +4142,25 @@ struct discrete_block
  *
  *************************************/
 
+/* links of one node in a task stepped a block of samples at a time */
+struct discrete_block_links
+{
+	struct input
+	{
+		const double **     slot;       /* the node's input pointer */
+		const double *      buffer;     /* block buffer of the source */
+		const double *      live;       /* source output, restored after the block */
+	};
+	struct output
+	{
+		const double *      source;     /* node output */
+		double *            buffer;     /* block buffer filled from it */
+	};
+
+	std::vector<input>      inputs;
+	std::vector<output>     outputs;
+};
+
 class discrete_step_interface
 {
 public:
@@ -4149,6 +4169,9 @@ public:
 	virtual void step() = 0;
 	osd_ticks_t         run_time;
 	discrete_base_node *    self;
+
+	/* steps the node over a block of samples, set by discrete_node_factory */
+	void (*step_block)(discrete_step_interface &intf, const discrete_block_links &links, int samples) = nullptr;
 };
 
 class discrete_input_interface
@@ -4210,7 +4233,8 @@ public:
 	/* access to the discrete_logging facility */
 	void CLIB_DECL discrete_log(const char *text, ...) const ATTR_PRINTF(2,3);
 
-	/* get pointer to a info struct node ref */
+	/* get pointer to a info struct node ref, links obtained this way
+	   are invisible to the block scheduler and disable it */
 	const double *node_output_ptr(int onode);
 
 	/* FIXME: this is used by csv and wav logs - going forward, identifiers should be explicitly passed */
@@ -4222,6 +4246,9 @@ public:
 	/* are we profiling */
 	inline int profiling() { return m_profiling; }
 
+	/* may tasks step a block of samples node by node */
+	inline bool block_stepping() const { return !m_hidden_links && !m_profiling; }
+
 	inline int sample_rate() { return m_sample_rate; }
 	inline double sample_time() { return m_sample_time; }
 
@@ -4267,6 +4294,9 @@ private:
 	/* parallel tasks */
 	osd_work_queue *        m_queue;
 
+	/* nodes took output pointers with node_output_ptr */
+	bool                    m_hidden_links;
+
 	/* profiling */
 	int                     m_profiling;
 	uint64_t                  m_total_samples;
@@ -4412,8 +4442,27 @@ public:
 		std::unique_ptr<discrete_base_node> r = std::make_unique<C>();
 
 		r->init(&pdev, &block);
+		if constexpr (std::is_base_of_v<discrete_step_interface, C>)
+			static_cast<C &>(*r).step_block = &step_block;
 		return r;
 	}
+
+private:
+	/* node type specific block loop, calls C::step() directly */
+	static void step_block(discrete_step_interface &intf, const discrete_block_links &links, int samples)
+	{
+		C &node = static_cast<C &>(intf);
+		for (int sample = 0; sample < samples; sample++)
+		{
+			for (const auto &in : links.inputs)
+				*in.slot = in.buffer + sample;
+			node.C::step();
+			for (const auto &out : links.outputs)
+				out.buffer[sample] = *out.source;
+		}
+		for (const auto &in : links.inputs)
+			*in.slot = in.live;
+	}
 };
 
 /*************************************
@@ -289,6 +289,8 @@ void scsp_device::device_post_load()
 	for (int slot = 0; slot < 32; slot++)
 		Compute_LFO(&m_Slots[slot]);
 
+	m_DSP.Invalidate();
+
 	set_output_gain(0, MVOL() / 15.0);
 	set_output_gain(1, MVOL() / 15.0);
 }
@@ -984,6 +986,7 @@ void scsp_device::w16(u32 addr, u16 val)
 		else if (addr < 0xC00)
 		{
 			*((uint16_t *) (m_DSP.MPRO + (addr - 0x800) / 2)) = val;
+			m_DSP.Invalidate();
 
 			if (addr == 0xBF0)
 			{
@@ -1263,47 +1266,124 @@ inline s32 scsp_device::UpdateSlot(SCSP_SLOT *slot)
 	return sample;
 }
 
+// slots can only be generated one after another if none of them depend on
+// the others' output (FM) or on the order of random numbers (noise)
+bool scsp_device::CanRenderSlots() const
+{
+	if (SCSP_FM_DELAY)
+		return false;
+
+	for (int sl = 0; sl < 32; ++sl)
+	{
+		const SCSP_SLOT *slot = m_Slots + sl;
+		if (slot->active && (MDL(slot) || MDXSL(slot) || MDYSL(slot) || (SSCTL(slot) == 1)))
+			return false;
+	}
+	return true;
+}
+
+// generate up to a block of samples for one slot, adding them to the block's mix
+// and keeping its place in the FM ring buffer up to date
+void scsp_device::RenderSlot(SCSP_SLOT *slot, int samples)
+{
+	const int dsp_level = m_LPANTABLE[((TL(slot)) << 0x0) | ((IMXL(slot)) << 0xd)];
+	const u16 Enc = ((TL(slot)) << 0x0) | ((DIPAN(slot)) << 0x8) | ((DISDL(slot)) << 0xd);
+	const int left = m_LPANTABLE[Enc];
+	const int right = m_RPANTABLE[Enc];
+
+	const u32 sel = ISEL(slot);
+	s32 *const mixs = m_MixS[sel];
+	if (!BIT(m_MixSUsed, sel))
+	{
+		std::fill_n(mixs, samples, 0);
+		m_MixSUsed |= 1 << sel;
+	}
+
+	// 32 slots per sample, so the slot's place in the ring alternates between two entries
+	const int ringpos = m_BUFPTR + slot->slot;
+	for (int s = 0; (s < samples) && slot->active; ++s)
+	{
+		m_RBUFDST = m_RINGBUF + ((ringpos + (s << 5)) & 63);
+		const s32 sample = UpdateSlot(slot);
+		mixs[s] += (sample * dsp_level) >> (SHIFT - 2);
+		m_MixL[s] += (sample * left) >> SHIFT;
+		m_MixR[s] += (sample * right) >> SHIFT;
+	}
+}
+
 void scsp_device::DoMasterSamples(std::vector<read_stream_view> const &inputs, std::vector<write_stream_view> &outputs)
 {
 	auto &bufr = outputs[1];
 	auto &bufl = outputs[0];
 
+	int block = 0, blocksamples = 0;
 	for (int s = 0; s < bufl.samples(); ++s)
 	{
 		s32 smpl = 0, smpr = 0;
 
-		for (int sl = 0; sl < 32; ++sl)
+		if ((block < blocksamples) || CanRenderSlots())
 		{
+			// mix slots' direct output for the next block
+			if (block == blocksamples)
+			{
+				blocksamples = std::min<int>(bufl.samples() - s, MIX_BLOCK);
+				block = 0;
+				std::fill_n(m_MixL, blocksamples, 0);
+				std::fill_n(m_MixR, blocksamples, 0);
+				m_MixSUsed = 0;
+				for (int sl = 0; sl < 32; ++sl)
+				{
+					if (m_Slots[sl].active)
+						RenderSlot(m_Slots + sl, blocksamples);
+				}
+				m_BUFPTR = (m_BUFPTR + (blocksamples << 5)) & 63;
+			}
+
+			smpl = m_MixL[block];
+			smpr = m_MixR[block];
+			for (int i = 0; i < 16; ++i)
+			{
+				if (BIT(m_MixSUsed, i))
+					m_DSP.SetSample(m_MixS[i][block], i, 0);
+			}
+			++block;
+		}
+		else
+		{
+			// some slot uses FM or noise, so generate slots in order one sample at a time
+			for (int sl = 0; sl < 32; ++sl)
+			{
 #if SCSP_FM_DELAY
-			m_RBUFDST = m_DELAYBUF + m_DELAYPTR;
+				m_RBUFDST = m_DELAYBUF + m_DELAYPTR;
 #else
-			m_RBUFDST = m_RINGBUF + m_BUFPTR;
+				m_RBUFDST = m_RINGBUF + m_BUFPTR;
 #endif
-			if (m_Slots[sl].active)
-			{
-				SCSP_SLOT *slot = m_Slots + sl;
-				u16 Enc;
+				if (m_Slots[sl].active)
+				{
+					SCSP_SLOT *slot = m_Slots + sl;
+					u16 Enc;
 
-				s32 sample = UpdateSlot(slot);
+					s32 sample = UpdateSlot(slot);
 
-				Enc = ((TL(slot)) << 0x0) | ((IMXL(slot)) << 0xd);
-				m_DSP.SetSample((sample*m_LPANTABLE[Enc]) >> (SHIFT-2), ISEL(slot), IMXL(slot));
-				Enc = ((TL(slot)) << 0x0) | ((DIPAN(slot)) << 0x8) | ((DISDL(slot)) << 0xd);
-				{
-					smpl += (sample * m_LPANTABLE[Enc]) >> SHIFT;
-					smpr += (sample * m_RPANTABLE[Enc]) >> SHIFT;
+					Enc = ((TL(slot)) << 0x0) | ((IMXL(slot)) << 0xd);
+					m_DSP.SetSample((sample*m_LPANTABLE[Enc]) >> (SHIFT-2), ISEL(slot), IMXL(slot));
+					Enc = ((TL(slot)) << 0x0) | ((DIPAN(slot)) << 0x8) | ((DISDL(slot)) << 0xd);
+					{
+						smpl += (sample * m_LPANTABLE[Enc]) >> SHIFT;
+						smpr += (sample * m_RPANTABLE[Enc]) >> SHIFT;
+					}
 				}
-			}
 
 #if SCSP_FM_DELAY
-			m_RINGBUF[(m_BUFPTR + 64 - (SCSP_FM_DELAY - 1)) & 63] = m_DELAYBUF[(m_DELAYPTR + SCSP_FM_DELAY - (SCSP_FM_DELAY - 1)) % SCSP_FM_DELAY];
+				m_RINGBUF[(m_BUFPTR + 64 - (SCSP_FM_DELAY - 1)) & 63] = m_DELAYBUF[(m_DELAYPTR + SCSP_FM_DELAY - (SCSP_FM_DELAY - 1)) % SCSP_FM_DELAY];
 #endif
-			++m_BUFPTR;
-			m_BUFPTR &= 63;
+				++m_BUFPTR;
+				m_BUFPTR &= 63;
 #if SCSP_FM_DELAY
-			++m_DELAYPTR;
-			if (m_DELAYPTR > SCSP_FM_DELAY-1) m_DELAYPTR = 0;
+				++m_DELAYPTR;
+				if (m_DELAYPTR > SCSP_FM_DELAY-1) m_DELAYPTR = 0;
 #endif
+			}
 		}
 
 		m_DSP.Step();
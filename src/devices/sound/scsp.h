@@ -152,6 +152,12 @@ private:
 
 	s16 *m_RBUFDST;   //this points to where the sample will be stored in the RingBuf
 
+	// slot output is generated a block at a time, one slot after another, when no slot uses FM or noise
+	static constexpr int MIX_BLOCK = 64;
+	s32 m_MixL[MIX_BLOCK], m_MixR[MIX_BLOCK];   // direct output
+	s32 m_MixS[16][MIX_BLOCK];                  // DSP inputs
+	u16 m_MixSUsed;                             // DSP inputs written in this block
+
 	//LFO
 	int m_PLFO_TRI[256], m_PLFO_SQR[256], m_PLFO_SAW[256], m_PLFO_NOI[256];
 	int m_ALFO_TRI[256], m_ALFO_SQR[256], m_ALFO_SAW[256], m_ALFO_NOI[256];
@@ -182,6 +188,8 @@ private:
 	void w16(u32 addr, u16 val);
 	u16 r16(u32 addr);
 	inline s32 UpdateSlot(SCSP_SLOT *slot);
+	void RenderSlot(SCSP_SLOT *slot, int samples);
+	bool CanRenderSlots() const;
 	void DoMasterSamples(std::vector<read_stream_view> const &inputs, std::vector<write_stream_view> &outputs);
 
 	//LFO
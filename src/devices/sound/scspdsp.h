@@ -32,10 +32,27 @@ struct SCSPDSP
 	bool Stopped;
 	int LastStep;
 
+//translated program, rebuilt from MPRO when it changes
+	struct Op
+	{
+		u32 flags;
+		u8 TRA, TWA, IRA, INSEL, IWA, EWA, MASA, COEF, YSEL, SCALE;
+	};
+	Op Program[128];
+	bool Dirty;       // MPRO changed since it was translated
+	bool Translated;  // Program can be used, otherwise MPRO is interpreted
+
 	void Init();
 	void SetSample(s32 sample, s32 SEL, s32 MXL);
 	void Step();
 	void Start();
+	void Invalidate() { Dirty = true; }
+
+private:
+	bool Translate();
+	template <typename Read, typename Write> void Interpret(Read &&read, Write &&write);
+	template <typename Read, typename Write> void Execute(Read &&read, Write &&write);
+	void Verify();
 };
 
 #endif // MAME_SOUND_SCSPDSP_H
@@ -260,7 +260,9 @@ protected:
 		return m_chip;
 	}
 
-	// internal update helper
+	// internal update helper; the chip renders a block at a time, and each
+	// output is converted straight into the stream's buffer in contiguous
+	// runs rather than a sample at a time
 	void update_internal(std::vector<write_stream_view> &outputs, int output_shift = 0)
 	{
 		// local buffer to hold samples
@@ -270,6 +272,7 @@ protected:
 		// parameters
 		int const outcount = std::min(outputs.size(), std::size(output[0].data));
 		int const numsamples = outputs[0].samples();
+		constexpr stream_buffer::sample_t scale = 1.0 / 32768.0;
 
 		// generate the FM/ADPCM stream
 		for (int sampindex = 0; sampindex < numsamples; sampindex += MAX_SAMPLES)
@@ -279,8 +282,13 @@ protected:
 			for (int outnum = 0; outnum < outcount; outnum++)
 			{
 				int eff_outnum = (outnum + output_shift) % OUTPUTS;
-				for (int index = 0; index < cursamples; index++)
-					outputs[eff_outnum].put_int(sampindex + index, output[index].data[outnum], 32768);
+				typename ChipClass::output_data const *src = &output[0];
+				outputs[eff_outnum].for_each_run(sampindex, cursamples, [&src, outnum] (stream_buffer::sample_t *dest, s32 run)
+				{
+					for (s32 index = 0; index < run; index++)
+						dest[index] = stream_buffer::sample_t(src[index].data[outnum]) * scale;
+					src += run;
+				});
 			}
 		}
 	}
@@ -445,7 +445,11 @@ inline void epic12_device::gfx_draw(offs_t *addr)
 		tinted = true;
 
 	// surprisingly frequent, need to verify if it produces a worthwhile speedup tho.
-	if ((s_mode == 0 && s_alpha == 0x1f) && (d_mode == 4 && d_alpha == 0x1f))
+	// any source mode that passes the source through unchanged, combined with any
+	// destination mode that scales the destination to nothing, is an opaque copy
+	const bool src_unchanged = (s_mode == 0 && s_alpha == 0x1f) || s_mode == 3 || s_mode == 7;
+	const bool dst_discarded = (d_mode == 0 && d_alpha == 0x00) || (d_mode == 4 && d_alpha == 0x1f);
+	if (src_unchanged && dst_discarded)
 		blend = false;
 
 	if (tinted)
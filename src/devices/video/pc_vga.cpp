@@ -450,16 +450,38 @@ uint32_t vga_device::start_addr()
 void vga_device::vga_vh_text(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 {
 	int width=VGA_CH_WIDTH, height = (vga.crtc.maximum_scan_line) * (vga.crtc.scan_doubling + 1);
+	int const lines = std::min<int>(TEXT_LINES, bitmap.height());
+	int const columns = TEXT_COLUMNS;
+	int const font_rows = std::min(((height - 1) >> vga.crtc.scan_doubling) + 1, 32);
+	rectangle const &visarea = screen().visible_area();
 
 	if(vga.crtc.cursor_enable)
 		vga.cursor.visible = screen().frame_number() & 0x10;
 	else
 		vga.cursor.visible = 0;
 
+	// cells are kept drawn between frames and only redrawn when what they show changes
+	std::array<int, 12> const geometry = {
+			width, height, vga.crtc.scan_doubling, vga.crtc.preset_row_scan, TEXT_LINES, columns,
+			vga.crtc.cursor_scan_start, vga.crtc.cursor_scan_end,
+			visarea.left(), visarea.right(), visarea.top(), visarea.bottom() };
+	int const rows = (TEXT_LINES + vga.crtc.preset_row_scan + height - 1) / height;
+	if (m_text_bitmap.width() != bitmap.width() || m_text_bitmap.height() != bitmap.height())
+	{
+		m_text_bitmap.allocate(bitmap.width(), bitmap.height());
+		m_text_cells.clear();
+	}
+	if (geometry != m_text_geometry || m_text_cells.size() != size_t(std::max(rows, 0) * columns))
+	{
+		m_text_geometry = geometry;
+		m_text_cells.assign(std::max(rows, 0) * columns, text_cell());
+	}
+
+	text_cell *cell = m_text_cells.data();
 	for (int addr = vga.crtc.start_addr, line = -vga.crtc.preset_row_scan; line < TEXT_LINES;
 			line += height, addr += (offset()>>1))
 	{
-		for (int pos = addr, column=0; column<TEXT_COLUMNS; column++, pos++)
+		for (int pos = addr, column=0; column<columns; column++, pos++, cell++)
 		{
 			uint8_t ch   = vga.memory[(pos<<1) + 0];
 			uint8_t attr = vga.memory[(pos<<1) + 1];
@@ -471,52 +493,63 @@ void vga_device::vga_vh_text(bitmap_rgb32 &bitmap, const rectangle &cliprect)
 			uint8_t back_col = (attr & 0x70) >> 4;
 			back_col |= (vga.attribute.data[0x10]&8) ? 0 : ((attr & 0x80) >> 4);
 
-			for (int h = std::max(-line, 0); (h < height) && (line+h < std::min(TEXT_LINES, bitmap.height())); h++)
+			pen_t const fore = vga.pens[blink_en ? back_col : fore_col];
+			pen_t const back = vga.pens[back_col];
+			bool const copy_9column = TEXT_COPY_9COLUMN(ch);
+			bool const has_cursor = vga.cursor.visible && (pos == vga.crtc.cursor_addr);
+			pen_t const cursor = has_cursor ? vga.pens[attr&0xf] : 0;
+			uint8_t const *const font = &vga.memory[font_base];
+
+			if (cell->valid && cell->fore == fore && cell->back == back && cell->copy_9column == copy_9column &&
+					cell->has_cursor == has_cursor && cell->cursor == cursor && !memcmp(cell->font, font, font_rows))
+				continue;
+
+			cell->valid = true;
+			cell->fore = fore;
+			cell->back = back;
+			cell->copy_9column = copy_9column;
+			cell->has_cursor = has_cursor;
+			cell->cursor = cursor;
+			memcpy(cell->font, font, font_rows);
+
+			// only the part of the cell inside the visible area is drawn
+			int const x0 = std::max(column*width, visarea.left());
+			int const x1 = std::min(column*width + width - 1, visarea.right());
+			for (int h = std::max(-line, 0); (h < height) && (line+h < lines); h++)
 			{
-				uint32_t *const bitmapline = &bitmap.pix(line+h);
-				uint8_t bits = vga.memory[font_base+(h>>(vga.crtc.scan_doubling))];
-
-				int mask, w;
-				for (mask=0x80, w=0; (w<width)&&(w<8); w++, mask>>=1)
-				{
-					pen_t pen;
-					if (bits&mask)
-						pen = vga.pens[blink_en ? back_col : fore_col];
-					else
-						pen = vga.pens[back_col];
+				if (!visarea.contains(x0, line+h) || x0 > x1)
+					continue;
 
-					if(!screen().visible_area().contains(column*width+w, line+h))
-						continue;
-					bitmapline[column*width+w] = pen;
+				uint32_t *const bitmapline = &m_text_bitmap.pix(line+h);
+				uint8_t bits = font[h>>(vga.crtc.scan_doubling)];
 
-				}
-				if (w<width)
+				for (int x = x0; x <= x1; x++)
 				{
-					/* 9 column */
-					pen_t pen;
-					if (TEXT_COPY_9COLUMN(ch)&&(bits&1))
-						pen = vga.pens[blink_en ? back_col : fore_col];
-					else
-						pen = vga.pens[back_col];
-
-					if(!screen().visible_area().contains(column*width+w, line+h))
-						continue;
-					bitmapline[column*width+w] = pen;
+					int const w = x - column*width;
+					if (w < 8)
+						bitmapline[x] = BIT(bits, 7 - w) ? fore : back;
+					else // 9 column
+						bitmapline[x] = (copy_9column && (bits&1)) ? fore : back;
 				}
 			}
-			if (vga.cursor.visible&&(pos==vga.crtc.cursor_addr))
+			if (has_cursor)
 			{
 				for (int h=vga.crtc.cursor_scan_start;
 						(h<=vga.crtc.cursor_scan_end)&&(h<height)&&(line+h<TEXT_LINES);
 						h++)
 				{
-					if(!screen().visible_area().contains(column*width, line+h))
+					if(!visarea.contains(column*width, line+h))
 						continue;
-					bitmap.plot_box(column*width, line+h, width, 1, vga.pens[attr&0xf]);
+					m_text_bitmap.plot_box(column*width, line+h, width, 1, cursor);
 				}
 			}
 		}
 	}
+
+	rectangle clip(0, columns*width - 1, 0, lines - 1);
+	clip &= visarea;
+	clip &= cliprect;
+	copybitmap(bitmap, m_text_bitmap, 0, 0, 0, 0, clip);
 }
 
 void vga_device::vga_vh_ega(bitmap_rgb32 &bitmap,  const rectangle &cliprect)
@@ -1186,6 +1219,49 @@ uint32_t s3_vga_device::screen_update(screen_device &screen, bitmap_rgb32 &bitma
 
 /***************************************************************************/
 
+// all four planes at once, plane n in byte n of the result
+inline uint32_t vga_device::vga_latch_write_planes(uint8_t data)
+{
+	static constexpr uint32_t expand[16] = {
+			0x00000000, 0x000000ff, 0x0000ff00, 0x0000ffff, 0x00ff0000, 0x00ff00ff, 0x00ffff00, 0x00ffffff,
+			0xff000000, 0xff0000ff, 0xff00ff00, 0xff00ffff, 0xffff0000, 0xffff00ff, 0xffffff00, 0xffffffff };
+
+	uint32_t const latch = vga.gc.latch[0] | (vga.gc.latch[1] << 8) | (vga.gc.latch[2] << 16) | (uint32_t(vga.gc.latch[3]) << 24);
+	uint32_t const set_reset = expand[vga.gc.set_reset & 0x0f];
+	uint32_t mask = vga.gc.bit_mask * 0x01010101U;
+	uint32_t src = 0;
+
+	switch (vga.gc.write_mode & 3) {
+	case 0:
+		{
+			uint32_t const enable = expand[vga.gc.enable_set_reset & 0x0f];
+			src = ((rotate_right(data) * 0x01010101U) & ~enable) | (set_reset & enable);
+		}
+		break;
+	case 1:
+		return latch;
+	case 2:
+		src = expand[data & 0x0f];
+		break;
+	case 3:
+		src = set_reset;
+		mask = (rotate_right(data) & vga.gc.bit_mask) * 0x01010101U;
+		break;
+	}
+
+	switch (vga.gc.logical_op & 3)
+	{
+	case 0: /* NONE */
+		return (src & mask) | (latch & ~mask);
+	case 1: /* AND */
+		return (src | ~mask) & latch;
+	case 2: /* OR */
+		return (src & mask) | latch;
+	default: /* XOR */
+		return (src & mask) ^ latch;
+	}
+}
+
 inline uint8_t vga_device::vga_latch_write(int offs, uint8_t data)
 {
 	uint8_t res = 0;
@@ -2142,12 +2218,12 @@ void vga_device::mem_w(offs_t offset, uint8_t data)
 	}
 
 	{
-		uint8_t i;
+		uint32_t const planes = (vga.sequencer.data[4] & 4) ? vga_latch_write_planes(data) : (data * 0x01010101U);
 
-		for(i=0;i<4;i++)
+		for(int i=0;i<4;i++)
 		{
 			if(vga.sequencer.map_mask & 1 << i)
-				vga.memory[offset+i*0x10000] = (vga.sequencer.data[4] & 4) ? vga_latch_write(i,data) : data;
+				vga.memory[offset+i*0x10000] = planes >> (i * 8);
 		}
 		return;
 	}
@@ -87,6 +87,7 @@ protected:
 	virtual uint16_t offset();
 	virtual uint32_t start_addr();
 	inline uint8_t vga_latch_write(int offs, uint8_t data);
+	inline uint32_t vga_latch_write_planes(uint8_t data);
 	inline uint8_t rotate_right(uint8_t val) { return (val >> vga.gc.rotate_count) | (val << (8 - vga.gc.rotate_count)); }
 	inline uint8_t vga_logical_op(uint8_t data, uint8_t plane, uint8_t mask)
 	{
@@ -238,6 +239,19 @@ protected:
 	} vga;
 
 	emu_timer *m_vblank_timer;
+
+private:
+	// text mode character cells as last drawn into m_text_bitmap
+	struct text_cell
+	{
+		bool valid, copy_9column, has_cursor;
+		pen_t fore, back, cursor;
+		uint8_t font[32];
+	};
+
+	std::vector<text_cell> m_text_cells;
+	std::array<int, 12> m_text_geometry;
+	bitmap_rgb32 m_text_bitmap;
 };
 
 
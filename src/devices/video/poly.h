@@ -335,6 +335,9 @@ private:
 	static constexpr int SCANLINES_PER_BUCKET = 32;
 	static constexpr int TOTAL_BUCKETS        = (512 / SCANLINES_PER_BUCKET);
 
+	// number of pending work units that triggers queueing them
+	static constexpr u32 UNITS_PER_FLUSH      = TOTAL_BUCKETS * 4;
+
 	// primitive_info describes a single primitive
 	struct primitive_info
 	{
@@ -383,21 +386,52 @@ private:
 		return primitive;
 	}
 
-	// enqueue work items in contiguous chunks
-	void queue_items(u32 start)
+	// allocate a work unit and append it to its bucket
+	work_unit &unit_alloc(primitive_info &primitive, int32_t scanline, uint32_t count)
+	{
+		uint32_t bucketnum = (uint32_t(scanline) / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
+		uint32_t unit_index = m_unit.count();
+		work_unit &unit = m_unit.next();
+
+		// fill in the work unit basics
+		unit.primitive = &primitive;
+		unit.count_next = count;
+		unit.scanline = scanline;
+		unit.previtem = m_unit_bucket[bucketnum];
+		m_unit_bucket[bucketnum] = unit_index;
+
+		// units that haven't been queued yet are binned by bucket: only the
+		// first one is queued, and the rest are chained behind it so one
+		// work item renders the whole band in order
+		if (m_queue != nullptr)
+		{
+			if (m_bin_head[bucketnum] == 0xffffffff)
+				m_bin_head[bucketnum] = unit_index;
+			else
+				m_unit.byindex(unit.previtem).count_next |= unit_index << 8;
+		}
+		return unit;
+	}
+
+	// enqueue the binned work units once enough have accumulated
+	void queue_items(bool force = false)
 	{
 		// do nothing if no queue; items will be processed on the next wait
 		if (m_queue == nullptr)
 			return;
+		if (!force && (m_unit.count() - m_unit_queued < UNITS_PER_FLUSH))
+			return;
 
-		// enqueue the items in contiguous chunks
-		while (start < m_unit.count())
+		// enqueue one item per bucket
+		for (uint32_t &head : m_bin_head)
 		{
-			u32 chunk;
-			work_unit *base = m_unit.contiguous(start, m_unit.count() - start, chunk);
-			osd_work_item_queue_multiple(m_queue, work_item_callback, chunk, base, m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
-			start += chunk;
+			if (head != 0xffffffff)
+			{
+				osd_work_item_queue(m_queue, work_item_callback, &m_unit.byindex(head), WORK_ITEM_FLAG_AUTO_RELEASE);
+				head = 0xffffffff;
+			}
 		}
+		m_unit_queued = m_unit.count();
 	}
 
 	static void *work_item_callback(void *param, int threadid);
@@ -414,6 +448,8 @@ private:
 
 	// buckets
 	uint32_t m_unit_bucket[TOTAL_BUCKETS]; // buckets for tracking unit usage
+	uint32_t m_bin_head[TOTAL_BUCKETS];    // first unit in each bucket not yet queued
+	uint32_t m_unit_queued;                // number of units already queued
 
 	// statistics
 	uint32_t m_tiles;                       // number of tiles queued
@@ -464,6 +500,7 @@ private:
 template<typename BaseType, class ObjectType, int MaxParams, u8 Flags>
 poly_manager<BaseType, ObjectType, MaxParams, Flags>::poly_manager(running_machine &machine) :
 	m_queue(nullptr),
+	m_unit_queued(0),
 	m_tiles(0),
 	m_triangles(0),
 	m_polygons(0),
@@ -475,6 +512,7 @@ poly_manager<BaseType, ObjectType, MaxParams, Flags>::poly_manager(running_machi
 
 	// initialize the buckets to empty
 	std::fill_n(&m_unit_bucket[0], std::size(m_unit_bucket), 0xffffffff);
+	std::fill_n(&m_bin_head[0], std::size(m_bin_head), 0xffffffff);
 
 	// register our arrays for reset
 	register_poly_array(m_primitive);
@@ -656,9 +694,12 @@ void poly_manager<BaseType, ObjectType, MaxParams, Flags>::wait(char const *debu
 	osd_ticks_t time = get_profile_ticks();
 #endif
 
-	// wait for all pending work items to complete
+	// queue any binned units and wait for all pending work items to complete
 	if (m_queue != nullptr)
+	{
+		queue_items(true);
 		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
+	}
 
 	// if we don't have a queue, just run the whole list now
 	else
@@ -671,6 +712,7 @@ void poly_manager<BaseType, ObjectType, MaxParams, Flags>::wait(char const *debu
 
 	// clear the buckets
 	std::fill_n(&m_unit_bucket[0], std::size(m_unit_bucket), 0xffffffff);
+	m_unit_queued = 0;
 
 	// reset all the poly arrays
 	for (auto array : m_arrays)
@@ -750,23 +792,14 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_tile(recta
 
 	// compute the X extents for each scanline
 	int32_t pixels = 0;
-	uint32_t startunit = m_unit.count();
 	int32_t scaninc = 1;
 	for (int32_t curscan = v1yclip; curscan < v2yclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = (uint32_t(curscan) / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
-		uint32_t unit_index = m_unit.count();
-		work_unit &unit = m_unit.next();
-
 		// determine how much to advance to hit the next bucket
 		scaninc = SCANLINES_PER_BUCKET - uint32_t(curscan) % SCANLINES_PER_BUCKET;
 
-		// fill in the work unit basics
-		unit.primitive = &primitive;
-		unit.count_next = std::min(v2yclip - curscan, scaninc);
-		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
+		// allocate a work unit for this part of the primitive
+		work_unit &unit = unit_alloc(primitive, curscan, std::min(v2yclip - curscan, scaninc));
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -792,7 +825,7 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_tile(recta
 	}
 
 	// enqueue the work items
-	queue_items(startunit);
+	queue_items();
 
 	// return the total number of pixels in the triangle
 	m_tiles++;
@@ -891,23 +924,14 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_triangle(c
 
 	// compute the X extents for each scanline
 	int32_t pixels = 0;
-	uint32_t startunit = m_unit.count();
 	int32_t scaninc = 1;
 	for (int32_t curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = (uint32_t(curscan) / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
-		uint32_t unit_index = m_unit.count();
-		work_unit &unit = m_unit.next();
-
 		// determine how much to advance to hit the next bucket
 		scaninc = SCANLINES_PER_BUCKET - uint32_t(curscan) % SCANLINES_PER_BUCKET;
 
-		// fill in the work unit basics
-		unit.primitive = &primitive;
-		unit.count_next = std::min(v3yclip - curscan, scaninc);
-		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
+		// allocate a work unit for this part of the primitive
+		work_unit &unit = unit_alloc(primitive, curscan, std::min(v3yclip - curscan, scaninc));
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -955,7 +979,7 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_triangle(c
 	}
 
 	// enqueue the work items
-	queue_items(startunit);
+	queue_items();
 
 	// return the total number of pixels in the triangle
 	m_triangles++;
@@ -1023,23 +1047,14 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_extents(re
 
 	// compute the X extents for each scanline
 	int32_t pixels = 0;
-	uint32_t startunit = m_unit.count();
 	int32_t scaninc = 1;
 	for (int32_t curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = (uint32_t(curscan) / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
-		uint32_t unit_index = m_unit.count();
-		work_unit &unit = m_unit.next();
-
 		// determine how much to advance to hit the next bucket
 		scaninc = SCANLINES_PER_BUCKET - uint32_t(curscan) % SCANLINES_PER_BUCKET;
 
-		// fill in the work unit basics
-		unit.primitive = &primitive;
-		unit.count_next = std::min(v3yclip - curscan, scaninc);
-		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
+		// allocate a work unit for this part of the primitive
+		work_unit &unit = unit_alloc(primitive, curscan, std::min(v3yclip - curscan, scaninc));
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -1077,7 +1092,7 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_extents(re
 	}
 
 	// enqueue the work items
-	queue_items(startunit);
+	queue_items();
 
 	// return the total number of pixels in the object
 	m_triangles++;
@@ -1197,23 +1212,14 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_polygon(re
 
 	// compute the X extents for each scanline
 	int32_t pixels = 0;
-	uint32_t startunit = m_unit.count();
 	int32_t scaninc = 1;
 	for (int32_t curscan = minyclip; curscan < maxyclip; curscan += scaninc)
 	{
-		uint32_t bucketnum = (uint32_t(curscan) / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
-		uint32_t unit_index = m_unit.count();
-		work_unit &unit = m_unit.next();
-
 		// determine how much to advance to hit the next bucket
 		scaninc = SCANLINES_PER_BUCKET - uint32_t(curscan) % SCANLINES_PER_BUCKET;
 
-		// fill in the work unit basics
-		unit.primitive = &primitive;
-		unit.count_next = std::min(maxyclip - curscan, scaninc);
-		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
+		// allocate a work unit for this part of the primitive
+		work_unit &unit = unit_alloc(primitive, curscan, std::min(maxyclip - curscan, scaninc));
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -1274,7 +1280,7 @@ uint32_t poly_manager<BaseType, ObjectType, MaxParams, Flags>::render_polygon(re
 	}
 
 	// enqueue the work items
-	queue_items(startunit);
+	queue_items();
 
 	// return the total number of pixels in the polygon
 	m_polygons++;
@@ -1017,6 +1017,61 @@ void psxgpu_device::decode_tpage( uint32_t tpage )
 		break; \
 	}
 
+/* flat shaded spans have one colour all the way, so opaque ones without */
+/* mask bit checking are filled in one go */
+#define FLATFILL \
+	if( n_distance > ( (int32_t)n_drawarea_x2 - drawx ) + 1 ) \
+	{ \
+		n_distance = ( n_drawarea_x2 - drawx ) + 1; \
+	} \
+	uint16_t *p_vram = p_p_vram[ drawy ] + drawx; \
+	\
+	switch( n_cmd & 0x02 ) \
+	{ \
+	case 0x00: \
+		/* transparency off */ \
+		{ \
+			uint16_t n_flat = \
+				p_n_redshade[ MID_LEVEL | n_r.w.h ] | \
+				p_n_greenshade[ MID_LEVEL | n_g.w.h ] | \
+				p_n_blueshade[ MID_LEVEL | n_b.w.h ]; \
+			if( !m_check_stp ) \
+			{ \
+				if( n_distance > 0 ) \
+				{ \
+					std::fill_n( p_vram, n_distance, m_draw_stp ? uint16_t( n_flat | 0x8000 ) : n_flat ); \
+				} \
+			} \
+			else \
+			{ \
+				while( n_distance > 0 ) \
+				{ \
+					WRITE_PIXEL( n_flat ) \
+					p_vram++; \
+					n_distance--; \
+				} \
+			} \
+		} \
+		break; \
+	case 0x02: \
+		/* transparency on */ \
+		{ \
+			uint16_t n_fr = p_n_f[ MID_LEVEL | n_r.w.h ]; \
+			uint16_t n_fg = p_n_f[ MID_LEVEL | n_g.w.h ]; \
+			uint16_t n_fb = p_n_f[ MID_LEVEL | n_b.w.h ]; \
+			while( n_distance > 0 ) \
+			{ \
+				WRITE_PIXEL( \
+					p_n_redtrans[ n_fr | p_n_redb[ *( p_vram ) ] ] | \
+					p_n_greentrans[ n_fg | p_n_greenb[ *( p_vram ) ] ] | \
+					p_n_bluetrans[ n_fb | p_n_blueb[ *( p_vram ) ] ] ) \
+				p_vram++; \
+				n_distance--; \
+			} \
+		} \
+		break; \
+	}
+
 #define FLATTEXTUREDPOLYGONUPDATE \
 	n_u.d += n_du; \
 	n_v.d += n_dv;
@@ -1517,7 +1572,7 @@ void psxgpu_device::FlatPolygon( int n_points )
 				drawx = n_drawarea_x1;
 			}
 
-			SOLIDFILL( FLATPOLYGONUPDATE )
+			FLATFILL
 		}
 
 		n_cx1.d += n_dx1;
@@ -2279,22 +2334,27 @@ void psxgpu_device::FrameBufferRectangleDraw()
 	PAIR n_g; n_g.w.h = BGR_G( m_packet.FlatRectangle.n_bgr ); n_g.w.l = 0;
 	PAIR n_b; n_b.w.h = BGR_B( m_packet.FlatRectangle.n_bgr ); n_b.w.l = 0;
 
+	uint16_t n_fill =
+		p_n_redshade[ MID_LEVEL | n_r.w.h ] |
+		p_n_greenshade[ MID_LEVEL | n_g.w.h ] |
+		p_n_blueshade[ MID_LEVEL | n_b.w.h ];
+
 	int16_t n_y = COORD_Y( m_packet.FlatRectangle.n_coord );
 	int32_t n_h = SIZE_H( m_packet.FlatRectangle.n_size );
 
 	while( n_h > 0 )
 	{
-		int16_t n_x = COORD_X( m_packet.FlatRectangle.n_coord );
+		int16_t n_x = COORD_X( m_packet.FlatRectangle.n_coord ) & 1023;
 		int32_t n_distance = SIZE_W( m_packet.FlatRectangle.n_size );
+		uint16_t *p_vram = p_p_vram[ n_y & 1023 ];
 
+		/* fill up to the right edge, then wrap around */
 		while( n_distance > 0 )
 		{
-			p_p_vram[ n_y & 1023 ][ n_x & 1023 ] =
-				p_n_redshade[ MID_LEVEL | n_r.w.h ] |
-				p_n_greenshade[ MID_LEVEL | n_g.w.h ] |
-				p_n_blueshade[ MID_LEVEL | n_b.w.h ];
-			n_x++;
-			n_distance--;
+			int32_t n_run = std::min( n_distance, 1024 - n_x );
+			std::fill_n( p_vram + n_x, n_run, n_fill );
+			n_x = 0;
+			n_distance -= n_run;
 		}
 
 		n_y++;
@@ -2343,7 +2403,7 @@ void psxgpu_device::FlatRectangle()
 				drawx = n_drawarea_x1;
 			}
 
-			SOLIDFILL( FLATRECTANGEUPDATE )
+			FLATFILL
 		}
 
 		n_y++;
@@ -2392,7 +2452,7 @@ void psxgpu_device::FlatRectangle8x8()
 				drawx = n_drawarea_x1;
 			}
 
-			SOLIDFILL( FLATRECTANGEUPDATE )
+			FLATFILL
 		}
 
 		n_y++;
@@ -2441,7 +2501,7 @@ void psxgpu_device::FlatRectangle16x16()
 				drawx = n_drawarea_x1;
 			}
 
-			SOLIDFILL( FLATRECTANGEUPDATE )
+			FLATFILL
 		}
 
 		n_y++;
@@ -475,49 +475,51 @@ void snes_ppu_device::device_reset()
  * XNOR: ###...##...###     ...###..###...
  *****************************************/
 
-void snes_ppu_device::render_window(uint16_t layer_idx, uint8_t enable, uint8_t *output)
+static inline void window_span(uint8_t *output, uint8_t left, uint8_t right, uint8_t invert)
 {
-	layer_t &self = m_layer[layer_idx];
-	if (!enable || (!self.window1_enabled && !self.window2_enabled))
+	memset(output, invert, 256);
+	if (left <= right)
+		memset(&output[left], invert ^ 1, right - left + 1);
+}
+
+/* 1 inside the enabled windows as combined by the layer's logic, the
+   windows are spans so they're filled rather than tested per pixel */
+void snes_ppu_device::combine_windows(const layer_t &self, uint8_t *output)
+{
+	if (!self.window2_enabled)
 	{
-		memset(output, 0, 256);
+		window_span(output, m_window1_left, m_window1_right, self.window1_invert);
 		return;
 	}
 
-	if (self.window1_enabled && !self.window2_enabled)
+	if (!self.window1_enabled)
 	{
-		const uint8_t set = 1 ^ self.window1_invert;
-		const uint8_t clear = 1 - set;
-		for (uint16_t x = 0; x < 256; x++)
-		{
-			output[x] = (x >= m_window1_left && x <= m_window1_right) ? set : clear;
-		}
+		window_span(output, m_window2_left, m_window2_right, self.window2_invert);
 		return;
 	}
 
-	if (self.window2_enabled && !self.window1_enabled)
+	uint8_t two_mask[256];
+	window_span(output, m_window1_left, m_window1_right, self.window1_invert);
+	window_span(two_mask, m_window2_left, m_window2_right, self.window2_invert);
+	switch (self.wlog_mask)
 	{
-		const uint8_t set = 1 ^ self.window2_invert;
-		const uint8_t clear = 1 - set;
-		for (uint16_t x = 0; x < 256; x++)
-		{
-			output[x] = (x >= m_window2_left && x <= m_window2_right) ? set : clear;
-		}
-		return;
+		case 0: for (int x = 0; x < 256; x++) output[x] |= two_mask[x]; break;
+		case 1: for (int x = 0; x < 256; x++) output[x] &= two_mask[x]; break;
+		case 2: for (int x = 0; x < 256; x++) output[x] ^= two_mask[x]; break;
+		case 3: for (int x = 0; x < 256; x++) output[x] ^= two_mask[x] ^ 1; break;
 	}
+}
 
-	for (uint16_t x = 0; x < 256; x++)
+void snes_ppu_device::render_window(uint16_t layer_idx, uint8_t enable, uint8_t *output)
+{
+	layer_t &self = m_layer[layer_idx];
+	if (!enable || (!self.window1_enabled && !self.window2_enabled))
 	{
-		uint8_t one_mask = ((x >= m_window1_left && x <= m_window1_right) ? 1 : 0) ^ self.window1_invert;
-		uint8_t two_mask = ((x >= m_window2_left && x <= m_window2_right) ? 1 : 0) ^ self.window2_invert;
-		switch (self.wlog_mask)
-		{
-			case 0: output[x] = (one_mask | two_mask); break;
-			case 1: output[x] = (one_mask & two_mask); break;
-			case 2: output[x] = (one_mask ^ two_mask); break;
-			case 3: output[x] = 1 - (one_mask ^ two_mask); break;
-		}
+		memset(output, 0, 256);
+		return;
 	}
+
+	combine_windows(self, output);
 }
 
 /*************************************************************************************************
@@ -1189,46 +1191,10 @@ void snes_ppu_device::update_color_windowmasks( uint8_t mask, uint8_t *output )
 		return;
 	}
 
-	if (self.window1_enabled && !self.window2_enabled)
-	{
-		if (self.window1_invert)
-		{
-			set ^= 1;
-			clear ^= 1;
-		}
-		for (uint16_t x = 0; x < 256; x++)
-		{
-			output[x] = (x >= m_window1_left && x <= m_window1_right) ? set : clear;
-		}
-		return;
-	}
-
-	if (self.window2_enabled && !self.window1_enabled)
-	{
-		if (self.window2_invert)
-		{
-			set ^= 1;
-			clear ^= 1;
-		}
-		for (uint16_t x = 0; x < 256; x++)
-		{
-			output[x] = (x >= m_window2_left && x <= m_window2_right) ? set : clear;
-		}
-		return;
-	}
-
-	for (uint16_t x = 0; x < 256; x++)
-	{
-		uint8_t one_mask = ((x >= m_window1_left && x <= m_window1_right) ? 1 : 0) ^ self.window1_invert;
-		uint8_t two_mask = ((x >= m_window2_left && x <= m_window2_right) ? 1 : 0) ^ self.window2_invert;
-		switch (self.wlog_mask)
-		{
-			case 0: output[x] = (one_mask | two_mask) == 1 ? set : clear; break;
-			case 1: output[x] = (one_mask & two_mask) == 1 ? set : clear; break;
-			case 2: output[x] = (one_mask ^ two_mask) == 1 ? set : clear; break;
-			case 3: output[x] = (one_mask ^ two_mask) == 0 ? set : clear; break;
-		}
-	}
+	combine_windows(self, output);
+	if (!set)
+		for (int x = 0; x < 256; x++)
+			output[x] ^= 1;
 }
 
 /*********************************************
@@ -1318,6 +1284,24 @@ void snes_ppu_device::refresh_scanline( bitmap_rgb32 &bitmap, uint16_t curline )
 		/* Draw OAM */
 		update_objects(curline);
 
+		/* Apply color math, a line without any clipping or color math is simply the main (and sub) screen */
+		uint16_t main_line[SNES_SCR_WIDTH];
+		uint16_t sub_line[SNES_SCR_WIDTH];
+		if (!memchr(window_above, 0, SNES_SCR_WIDTH) && !memchr(window_below, 1, SNES_SCR_WIDTH))
+		{
+			memcpy(main_line, above->buffer, sizeof(main_line));
+			memcpy(sub_line, below->buffer, sizeof(sub_line));
+		}
+		else
+		{
+			for (int x = 0; x < SNES_SCR_WIDTH; x++)
+			{
+				if (hires)
+					sub_line[x] = pixel(x, below, above, window_above, window_below);
+				main_line[x] = pixel(x, above, below, window_above, window_below);
+			}
+		}
+
 		/* Draw the scanline to screen */
 		uint16_t prev = 0;
 
@@ -1327,28 +1311,28 @@ void snes_ppu_device::refresh_scanline( bitmap_rgb32 &bitmap, uint16_t curline )
 			/* in hires, the first pixel (of 512) is subscreen pixel, then the first mainscreen pixel follows, and so on... */
 			if (!hires)
 			{
-				const uint16_t c = luma[pixel(x, above, below, window_above, window_below)];
+				const uint16_t c = luma[main_line[x]];
 
 				bitmap.pix(0, x * 2 + 0) = indirect_color(c & 0x7fff);
 				bitmap.pix(0, x * 2 + 1) = indirect_color(c & 0x7fff);
 			}
 			else if (!blurring)
 			{
-				const uint16_t c0 = luma[pixel(x, below, above, window_above, window_below)];
-				const uint16_t c1 = luma[pixel(x, above, below, window_above, window_below)];
+				const uint16_t c0 = luma[sub_line[x]];
+				const uint16_t c1 = luma[main_line[x]];
 
 				bitmap.pix(0, x * 2 + 0) = indirect_color(c0 & 0x7fff);
 				bitmap.pix(0, x * 2 + 1) = indirect_color(c1 & 0x7fff);
 			}
 			else
 			{
-				uint16_t curr = luma[pixel(x, below, above, window_above, window_below)];
+				uint16_t curr = luma[sub_line[x]];
 
 				uint16_t c0 = (prev + curr - ((prev ^ curr) & 0x0421)) >> 1;
 				bitmap.pix(0, x * 2 + 0) = indirect_color(c0 & 0x7fff);
 
 				prev = curr;
-				curr = luma[pixel(x, above, below, window_above, window_below)];
+				curr = luma[main_line[x]];
 
 				uint16_t c1 = (prev + curr - ((prev ^ curr) & 0x0421)) >> 1;
 				bitmap.pix(0, x * 2 + 1) = indirect_color(c1 & 0x7fff);
@@ -1361,7 +1345,7 @@ void snes_ppu_device::refresh_scanline( bitmap_rgb32 &bitmap, uint16_t curline )
 	g_profiler.stop();
 }
 
-uint16_t snes_ppu_device::pixel(uint16_t x, SNES_SCANLINE *above, SNES_SCANLINE *below, uint8_t *window_above, uint8_t *window_below)
+inline uint16_t snes_ppu_device::pixel(uint16_t x, SNES_SCANLINE *above, SNES_SCANLINE *below, uint8_t *window_above, uint8_t *window_below)
 {
 	if (!window_above[x]) above->buffer[x] = 0;
 	if (!window_below[x]) return above->buffer[x];
@@ -283,12 +283,13 @@ protected:
 	void update_mode_7(uint16_t curline);
 	void draw_screens(uint16_t curline);
 	void render_window(uint16_t layer_idx, uint8_t enable, uint8_t *output);
+	void combine_windows(const layer_t &self, uint8_t *output);
 	inline void plot_above(uint16_t x, uint8_t source, uint8_t priority, uint16_t color, int blend_exception = 0);
 	inline void plot_below(uint16_t x, uint8_t source, uint8_t priority, uint16_t color, int blend_exception = 0);
 	void update_color_windowmasks(uint8_t mask, uint8_t *output);
 	void update_video_mode(void);
 	void cache_background();
-	uint16_t pixel(uint16_t x, SNES_SCANLINE *above, SNES_SCANLINE *below, uint8_t *window_above, uint8_t *window_below);
+	inline uint16_t pixel(uint16_t x, SNES_SCANLINE *above, SNES_SCANLINE *below, uint8_t *window_above, uint8_t *window_below);
 	uint16_t direct_color(uint16_t palette, uint16_t group);
 	inline uint16_t blend(uint16_t x, uint16_t y, bool halve);
 
@@ -155,3 +155,125 @@ sparse_dirty_rect *sparse_dirty_bitmap::first_dirty_rect(const rectangle &clipre
 	m_rect_list_bounds = cliprect;
 	return m_rect_list.empty() ? nullptr : m_rect_list.first();
 }
+
+
+
+//-------------------------------------------------
+//  fill_span -- fill a span with a single value
+//-------------------------------------------------
+
+void sprite_line_buffer::fill_span(int32_t x, int32_t count, uint16_t value)
+{
+	int32_t skip;
+	if (clip(x, count, skip))
+		std::fill_n(&m_buffer[x], count, value);
+}
+
+
+//-------------------------------------------------
+//  draw_span -- draw a span of pens, one per
+//  pixel, skipping the transparent pen
+//-------------------------------------------------
+
+void sprite_line_buffer::draw_span(int32_t x, const uint8_t *pens, int32_t count, uint16_t color, uint8_t transpen, bool flipx)
+{
+	int32_t const total = count;
+	int32_t skip;
+	if (!clip(x, count, skip))
+		return;
+
+	uint16_t *const dest = &m_buffer[x];
+	if (!flipx)
+	{
+		pens += skip;
+		for (int32_t i = 0; i < count; i++)
+			if (pens[i] != transpen)
+				dest[i] = color | pens[i];
+	}
+	else
+	{
+		pens += total - 1 - skip;
+		for (int32_t i = 0; i < count; i++)
+			if (pens[-i] != transpen)
+				dest[i] = color | pens[-i];
+	}
+}
+
+
+//-------------------------------------------------
+//  shadow_span -- set bits in the pixels of a
+//  span that have already been drawn
+//-------------------------------------------------
+
+void sprite_line_buffer::shadow_span(int32_t x, int32_t count, uint16_t bits)
+{
+	int32_t skip;
+	if (!clip(x, count, skip))
+		return;
+
+	uint16_t *const dest = &m_buffer[x];
+	for (int32_t i = 0; i < count; i++)
+		if (dest[i] != EMPTY)
+			dest[i] |= bits;
+}
+
+
+//-------------------------------------------------
+//  copy_row -- copy the drawn pixels of a row
+//  into a bitmap row
+//-------------------------------------------------
+
+void sprite_line_buffer::copy_row(uint16_t *dest, const uint16_t *src, int32_t min_x, int32_t max_x, uint16_t palbase)
+{
+	for (int32_t x = min_x; x <= max_x; x++)
+	{
+		// most of a line is usually empty; step over it four pixels at a time
+		if (x + 3 <= max_x)
+		{
+			uint64_t quad;
+			memcpy(&quad, &src[x], sizeof(quad));
+			if (quad == ~uint64_t(0))
+			{
+				x += 3;
+				continue;
+			}
+		}
+
+		uint16_t const pix = src[x];
+		if (pix != EMPTY)
+			dest[x] = palbase + pix;
+	}
+}
+
+
+//-------------------------------------------------
+//  mix_row -- mix the drawn pixels of a row into
+//  a bitmap row against the screen priority
+//-------------------------------------------------
+
+void sprite_line_buffer::mix_row(uint16_t *dest, const uint16_t *src, const uint8_t *pri, int32_t min_x, int32_t max_x, const mix_params &params)
+{
+	for (int32_t x = min_x; x <= max_x; x++)
+	{
+		// most of a line is usually empty; step over it four pixels at a time
+		if (x + 3 <= max_x)
+		{
+			uint64_t quad;
+			memcpy(&quad, &src[x], sizeof(quad));
+			if (quad == ~uint64_t(0))
+			{
+				x += 3;
+				continue;
+			}
+		}
+
+		uint16_t const pix = src[x];
+		if (pix != EMPTY && (1 << ((pix >> params.prishift) & params.primask)) > pri[x])
+		{
+			if ((pix & params.shadowmask) == params.shadowvalue)
+				dest[x] += params.shadowoffset;
+			else
+				dest[x] = params.palbase | (pix & params.colormask);
+		}
+	}
+}
@@ -71,6 +71,70 @@ private:
 };
 
 
+// ======================> sprite_line_buffer
+
+// one scanline of sprite pixels, using the same ~0 "nothing drawn" value as
+// the sprite_device bitmaps; spans are clipped to the buffer, so callers can
+// pass unclipped screen coordinates
+class sprite_line_buffer
+{
+public:
+	static constexpr uint16_t EMPTY = 0xffff;
+
+	// how a line of sprite pixels is mixed over a line of tilemap pixels:
+	// a sprite pixel is drawn where (1 << priority) beats the screen priority,
+	// and either replaces the pen underneath or shadows it
+	struct mix_params
+	{
+		uint16_t    palbase;        // ORed into the pen of drawn pixels
+		uint16_t    colormask;      // bits of the sprite pixel that form the pen
+		uint8_t     prishift;       // priority is (pixel >> prishift) & primask
+		uint8_t     primask;
+		uint16_t    shadowmask;     // pixels where (pixel & shadowmask) == shadowvalue
+		uint16_t    shadowvalue;    // add shadowoffset to the pen underneath instead
+		uint16_t    shadowoffset;
+	};
+
+	// construction/destruction
+	sprite_line_buffer(int32_t width = 0) { resize(width); }
+
+	// getters
+	int32_t width() const { return int32_t(m_buffer.size()); }
+	uint16_t *line() { return &m_buffer[0]; }
+	const uint16_t *line() const { return &m_buffer[0]; }
+
+	// sizing and clearing
+	void resize(int32_t width) { m_buffer.resize(std::max(width, 1)); clear(); }
+	void clear() { std::fill(m_buffer.begin(), m_buffer.end(), EMPTY); }
+
+	// span drawing
+	void fill_span(int32_t x, int32_t count, uint16_t value);
+	void draw_span(int32_t x, const uint8_t *pens, int32_t count, uint16_t color, uint8_t transpen, bool flipx = false);
+	void shadow_span(int32_t x, int32_t count, uint16_t bits);
+
+	// flushing into a bitmap row
+	void flush(bitmap_ind16 &bitmap, int32_t y, int32_t min_x, int32_t max_x, uint16_t palbase) const { copy_row(&bitmap.pix(y), line(), min_x, max_x, palbase); }
+	void flush(bitmap_ind16 &bitmap, const bitmap_ind8 &priority, int32_t y, int32_t min_x, int32_t max_x, const mix_params &params) const { mix_row(&bitmap.pix(y), line(), &priority.pix(y), min_x, max_x, params); }
+
+	// the same operations on rows of a full sprite bitmap
+	static void copy_row(uint16_t *dest, const uint16_t *src, int32_t min_x, int32_t max_x, uint16_t palbase);
+	static void mix_row(uint16_t *dest, const uint16_t *src, const uint8_t *pri, int32_t min_x, int32_t max_x, const mix_params &params);
+
+private:
+	// clip a span to the buffer, returning the number of leading pixels dropped
+	bool clip(int32_t &x, int32_t &count, int32_t &skip) const
+	{
+		skip = (x < 0) ? -x : 0;
+		x += skip;
+		count = std::min(count - skip, width() - x);
+		return count > 0;
+	}
+
+	// internal state
+	std::vector<uint16_t>   m_buffer;
+};
+
+
 // ======================> sprite_device
 
 template<typename _SpriteRAMType, class _BitmapType>
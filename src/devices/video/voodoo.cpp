@@ -1037,6 +1037,7 @@ void voodoo_1_device::device_start()
 void voodoo_1_device::device_stop()
 {
 	m_renderer->wait("device_stop");
+	m_renderer->dump_rasterizer_stats();
 }
 
 
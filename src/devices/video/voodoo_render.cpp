@@ -1241,6 +1241,7 @@ voodoo_renderer::voodoo_renderer(running_machine &machine, u16 tmu_config, const
 	m_tmu1_reg(tmu1_regs),
 	m_rgb565(rgb565),
 	m_fogdelta_mask(0xff),
+	m_generic_configs(0),
 	m_thread_stats(WORK_MAX_THREADS)
 {
 	// empty the hash table
@@ -1257,7 +1258,7 @@ voodoo_renderer::voodoo_renderer(running_machine &machine, u16 tmu_config, const
 	// create entries for the generic rasterizers as well
 	rasterizer_params dummy_params;
 	for (int index = 0; index < std::size(m_generic_rasterizer); index++)
-		m_generic_rasterizer[index] = add_rasterizer(dummy_params, generic_rasterizer(index), true);
+		m_generic_rasterizer[index] = add_rasterizer(dummy_params, generic_rasterizer(index), true, false);
 }
 
 
@@ -1347,9 +1348,13 @@ u32 voodoo_renderer::enqueue_triangle(poly_data &poly, vertex_t const *vert)
 	// determine the index of the generic rasterizer
 	if (info == nullptr)
 	{
-		// add a new one if we're logging usage
-		if (LOG_RASTERIZERS)
+		// give each new configuration its own entry so it is found by the
+		// lookup next time and its usage can be reported
+		if (LOG_RASTERIZERS || m_generic_configs < MAX_GENERIC_CONFIGS)
+		{
 			info = add_rasterizer(poly.raster, generic_rasterizer(poly.raster.generic()), true);
+			m_generic_configs++;
+		}
 		else
 			info = m_generic_rasterizer[poly.raster.generic()];
 	}
@@ -2512,7 +2517,7 @@ voodoo_renderer::rasterizer_mfp voodoo_renderer::generic_rasterizer(u8 texmask)
 //  hash table
 //-------------------------------------------------
 
-rasterizer_info *voodoo_renderer::add_rasterizer(rasterizer_params const &params, rasterizer_mfp rasterizer, bool is_generic)
+rasterizer_info *voodoo_renderer::add_rasterizer(rasterizer_params const &params, rasterizer_mfp rasterizer, bool is_generic, bool hashed)
 {
 	rasterizer_info &info = m_rasterizer_list.emplace_back();
 
@@ -2528,7 +2533,7 @@ rasterizer_info *voodoo_renderer::add_rasterizer(rasterizer_params const &params
 
 	// hook us into the hash table
 	u32 hash = info.fullhash % RASTER_HASH_SIZE;
-	if (!is_generic || LOG_RASTERIZERS)
+	if (hashed)
 	{
 		info.next = m_raster_hash[hash];
 		m_raster_hash[hash] = &info;
@@ -2570,33 +2575,34 @@ rasterizer_info *voodoo_renderer::add_rasterizer(rasterizer_params const &params
 
 void voodoo_renderer::dump_rasterizer_stats()
 {
-	if (!LOG_RASTERIZERS)
-		return;
-
 	static u8 display_index;
 	rasterizer_info *cur, *best;
 	int hash;
 
-	osd_printf_info("----\n");
+	if (LOG_RASTERIZERS)
+		osd_printf_info("----\n");
+	else if (m_generic_configs != 0)
+		osd_printf_verbose("Voodoo: most used configurations without a static rasterizer:\n");
 	display_index++;
 
-	// loop until we've displayed everything
-	while (1)
+	// loop until we've displayed everything, or the top few if we're
+	// just reporting generic fallbacks
+	for (int count = 0; LOG_RASTERIZERS || count < 32; count++)
 	{
 		best = nullptr;
 
 		// find the highest entry
 		for (hash = 0; hash < RASTER_HASH_SIZE; hash++)
 			for (cur = m_raster_hash[hash]; cur != nullptr; cur = cur->next)
-				if (cur->display != display_index && (best == nullptr || cur->scanlines > best->scanlines))
+				if ((LOG_RASTERIZERS || cur->is_generic) && cur->display != display_index && (best == nullptr || cur->scanlines > best->scanlines))
 					best = cur;
 
 		// if we're done, we're done
 		if (best == nullptr || best->scanlines == 0)
 			break;
 
-		// print it
-		osd_printf_info("%s RASTERIZER( 0x%02X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X ) // %8d %10d\n",
+		// print it in a form that can be pasted into the table below
+		std::string const line = util::string_format("%s RASTERIZER( 0x%02X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X, 0x%08X ) // %8d %10d\n",
 			best->is_generic ? "   " : "// ",
 			best->params.generic(),
 			best->params.fbzcp().raw(),
@@ -2607,6 +2613,10 @@ void voodoo_renderer::dump_rasterizer_stats()
 			best->params.texmode1().raw(),
 			best->polys,
 			best->scanlines);
+		if (LOG_RASTERIZERS)
+			osd_printf_info("%s", line);
+		else
+			osd_printf_verbose("%s", line);
 
 		// reset
 		best->display = display_index;
@@ -495,6 +495,7 @@ struct thread_stats_block
 class voodoo_renderer : public voodoo_poly_manager
 {
 	static constexpr u32 RASTER_HASH_SIZE = 97; // size of the rasterizer hash table
+	static constexpr u32 MAX_GENERIC_CONFIGS = 1024; // maximum number of tracked configurations without a static rasterizer
 
 public:
 	using rasterizer_mfp = void (voodoo_renderer::*)(int32_t, const extent_t &, const poly_data &, int);
@@ -568,7 +569,8 @@ public:
 	rasterizer_palette &alloc_palette(int which) { return m_palettes.next(which); }
 	rasterizer_palette &last_palette(int which) { return m_palettes.last(which); }
 
-	// dump rasterizer statistics if enabled
+	// dump rasterizer statistics; without LOG_RASTERIZERS only configurations
+	// that fell back to a generic rasterizer are shown, as verbose output
 	void dump_rasterizer_stats();
 
 private:
@@ -589,7 +591,7 @@ private:
 
 	// helpers
 	static rasterizer_mfp generic_rasterizer(u8 texmask);
-	voodoo::rasterizer_info *add_rasterizer(voodoo::rasterizer_params const &params, rasterizer_mfp rasterizer, bool is_generic);
+	voodoo::rasterizer_info *add_rasterizer(voodoo::rasterizer_params const &params, rasterizer_mfp rasterizer, bool is_generic, bool hashed = true);
 
 	// internal state
 	u8 m_bilinear_mask;         // mask for bilinear resolution (0xf0 for V1, 0xff for V2)
@@ -607,6 +609,7 @@ private:
 	poly_array<voodoo::rasterizer_palette, 8> m_palettes;
 	voodoo::rasterizer_info *m_raster_hash[RASTER_HASH_SIZE]; // hash table of rasterizers
 	voodoo::rasterizer_info *m_generic_rasterizer[16];
+	u32 m_generic_configs;      // number of configurations added with a generic rasterizer
 	std::list<voodoo::rasterizer_info> m_rasterizer_list;
 	std::vector<thread_stats_block> m_thread_stats;
 };
@@ -38,6 +38,22 @@ attotime &attotime::operator*=(u32 factor)
 	if (factor == 0)
 		return *this = zero;
 
+#if defined(__SIZEOF_INT128__)
+	// scale the attoseconds in one go and carry whole seconds across
+	if (m_seconds >= 0)
+	{
+		unsigned __int128 const attos = (unsigned __int128)u64(m_attoseconds) * factor;
+		u64 const carry = u64(attos / u64(ATTOSECONDS_PER_SECOND));
+		u64 const secs = mulu_32x32(m_seconds, factor) + carry;
+		if (secs >= ATTOTIME_MAX_SECONDS)
+			return *this = never;
+
+		m_seconds = secs;
+		m_attoseconds = attoseconds_t(u64(attos) - (carry * u64(ATTOSECONDS_PER_SECOND)));
+		return *this;
+	}
+#endif
+
 	// split attoseconds into upper and lower halves which fit into 32 bits
 	u32 attolo;
 	u32 attohi = divu_64x32_rem(m_attoseconds, ATTOSECONDS_PER_SECOND_SQRT, attolo);
@@ -78,14 +94,25 @@ attotime &attotime::operator/=(u32 factor)
 	if (factor == 0)
 		return *this;
 
+#if !defined(__SIZEOF_INT128__)
 	// split attoseconds into upper and lower halves which fit into 32 bits
 	u32 attolo;
 	u32 attohi = divu_64x32_rem(m_attoseconds, ATTOSECONDS_PER_SECOND_SQRT, attolo);
+#endif
 
 	// divide the seconds and get the remainder
 	u32 remainder;
 	m_seconds = divu_64x32_rem(m_seconds, factor, remainder);
 
+#if defined(__SIZEOF_INT128__)
+	// combine the attoseconds with the remainder and divide that in one go
+	unsigned __int128 const attos = (unsigned __int128)remainder * u64(ATTOSECONDS_PER_SECOND) + u64(m_attoseconds);
+	u64 const quotient = u64(attos / factor);
+	remainder = u32(u64(attos) - (quotient * factor));
+
+	// round based on the remainder
+	m_attoseconds = attoseconds_t(quotient);
+#else
 	// combine the upper half of attoseconds with the remainder and divide that
 	u64 temp = s64(attohi) + mulu_32x32(remainder, ATTOSECONDS_PER_SECOND_SQRT);
 	u32 reshi = divu_64x32_rem(temp, factor, remainder);
@@ -96,6 +123,7 @@ attotime &attotime::operator/=(u32 factor)
 
 	// round based on the remainder
 	m_attoseconds = (attoseconds_t)reslo + mulu_32x32(reshi, ATTOSECONDS_PER_SECOND_SQRT);
+#endif
 	if (remainder >= factor / 2)
 		if (++m_attoseconds >= ATTOSECONDS_PER_SECOND)
 		{
@@ -341,7 +341,12 @@ inline constexpr attoseconds_t attotime::as_attoseconds() const noexcept
 /** as_ticks - convert to ticks at @p frequency */
 inline u64 attotime::as_ticks(u32 frequency) const
 {
+#if defined(__SIZEOF_INT128__)
+	// one wide multiply and divide rather than scaling in base 10^9
+	u32 fracticks = u32((unsigned __int128)u64(m_attoseconds) * frequency / u64(ATTOSECONDS_PER_SECOND));
+#else
 	u32 fracticks = (attotime(0, m_attoseconds) * frequency).m_seconds;
+#endif
 	return mulu_32x32(m_seconds, frequency) + fracticks;
 }
 
@@ -28,10 +28,12 @@
 #include "softlist.h"
 
 #include "corestr.h"
+#include "ioprocsfilter.h"
 
 #include <algorithm>
 #include <cctype>
 #include <fstream>
+#include <limits>
 #include <sstream>
 
 
@@ -210,6 +212,11 @@ debugger_commands::debugger_commands(running_machine& machine, debugger_cpu& cpu
 	m_console.register_command("gni",       CMDFLAG_NONE, 0, 1, std::bind(&debugger_commands::execute_go_next_instruction, this, _1));
 	m_console.register_command("next",      CMDFLAG_NONE, 0, 0, std::bind(&debugger_commands::execute_next, this, _1));
 	m_console.register_command("n",         CMDFLAG_NONE, 0, 0, std::bind(&debugger_commands::execute_next, this, _1));
+	m_console.register_command("reverse",   CMDFLAG_NONE, 0, 1, std::bind(&debugger_commands::execute_reverse, this, _1));
+	m_console.register_command("rstep",     CMDFLAG_NONE, 0, 1, std::bind(&debugger_commands::execute_reverse_step, this, _1));
+	m_console.register_command("rs",        CMDFLAG_NONE, 0, 1, std::bind(&debugger_commands::execute_reverse_step, this, _1));
+	m_console.register_command("rgo",       CMDFLAG_NONE, 0, 0, std::bind(&debugger_commands::execute_reverse_go, this, _1));
+	m_console.register_command("rg",        CMDFLAG_NONE, 0, 0, std::bind(&debugger_commands::execute_reverse_go, this, _1));
 	m_console.register_command("focus",     CMDFLAG_NONE, 1, 1, std::bind(&debugger_commands::execute_focus, this, _1));
 	m_console.register_command("ignore",    CMDFLAG_NONE, 0, MAX_COMMAND_PARAMS, std::bind(&debugger_commands::execute_ignore, this, _1));
 	m_console.register_command("observe",   CMDFLAG_NONE, 0, MAX_COMMAND_PARAMS, std::bind(&debugger_commands::execute_observe, this, _1));
@@ -345,6 +352,7 @@ debugger_commands::debugger_commands(running_machine& machine, debugger_cpu& cpu
 	m_console.register_command("mapi",      CMDFLAG_NONE, 1, 1, std::bind(&debugger_commands::execute_map, this, AS_IO, _1));
 	m_console.register_command("mapo",      CMDFLAG_NONE, 1, 1, std::bind(&debugger_commands::execute_map, this, AS_OPCODES, _1));
 	m_console.register_command("memdump",   CMDFLAG_NONE, 0, 2, std::bind(&debugger_commands::execute_memdump, this, _1));
+	m_console.register_command("memstats",  CMDFLAG_NONE, 1, 3, std::bind(&debugger_commands::execute_memstats, this, _1));
 
 	m_console.register_command("symlist",   CMDFLAG_NONE, 0, 1, std::bind(&debugger_commands::execute_symlist, this, _1));
 
@@ -364,6 +372,9 @@ debugger_commands::debugger_commands(running_machine& machine, debugger_cpu& cpu
 		m_console.source_script(name);
 
 	m_cheat.space = nullptr;
+
+	// access counters must let go of their taps before the address spaces go away
+	m_machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate([this] () { m_memstats.clear(); }));
 }
 
 
@@ -944,6 +955,78 @@ void debugger_commands::execute_next(const std::vector<std::string_view> &params
 }
 
 
+/*-------------------------------------------------
+    execute_reverse - execute the reverse command
+-------------------------------------------------*/
+
+void debugger_commands::execute_reverse(const std::vector<std::string_view> &params)
+{
+	debugger_cpu &cpu = m_machine.debugger().cpu();
+
+	// no parameter: show the state
+	if (params.empty())
+	{
+		if (cpu.reverse_interval())
+			m_console.printf("Reverse execution snapshots every %d instructions, at position %d\n", cpu.reverse_interval(), cpu.reverse_position());
+		else
+			m_console.printf("Reverse execution is off\n");
+		return;
+	}
+
+	u64 interval;
+	if (!m_console.validate_number_parameter(params[0], interval))
+		return;
+	if (interval > std::numeric_limits<u32>::max())
+	{
+		m_console.printf("Snapshot interval too large\n");
+		return;
+	}
+
+	if (!cpu.set_reverse_interval(u32(interval)))
+		m_console.printf("Reverse execution needs rewind states, enable the rewind option\n");
+	else if (interval)
+		m_console.printf("Reverse execution snapshots every %d instructions\n", interval);
+	else
+		m_console.printf("Reverse execution disabled\n");
+}
+
+
+/*-------------------------------------------------
+    execute_reverse_step - execute the rstep
+    command
+-------------------------------------------------*/
+
+void debugger_commands::execute_reverse_step(const std::vector<std::string_view> &params)
+{
+	debugger_cpu &cpu = m_machine.debugger().cpu();
+
+	// if we have a parameter, use it
+	u64 steps = 1;
+	if (params.size() > 0 && !m_console.validate_number_parameter(params[0], steps))
+		return;
+
+	if (!cpu.reverse_interval())
+		m_console.printf("Reverse execution is off, use the reverse command to enable it\n");
+	else if (!cpu.reverse_step(steps))
+		m_console.printf("No reverse execution snapshot that far back\n");
+}
+
+
+/*-------------------------------------------------
+    execute_reverse_go - execute the rgo command
+-------------------------------------------------*/
+
+void debugger_commands::execute_reverse_go(const std::vector<std::string_view> &params)
+{
+	debugger_cpu &cpu = m_machine.debugger().cpu();
+
+	if (!cpu.reverse_interval())
+		m_console.printf("Reverse execution is off, use the reverse command to enable it\n");
+	else if (!cpu.reverse_go())
+		m_console.printf("No reverse execution snapshot before the current position\n");
+}
+
+
 /*-------------------------------------------------
     execute_focus - execute the focus command
 -------------------------------------------------*/
@@ -3429,6 +3512,7 @@ void debugger_commands::execute_trace(const std::vector<std::string_view> &param
 	std::string_view action;
 	bool detect_loops = true;
 	bool logerror = false;
+	bool binary = false;
 	std::string filename(params[0]);
 
 	// replace macros
@@ -3451,6 +3535,8 @@ void debugger_commands::execute_trace(const std::vector<std::string_view> &param
 				detect_loops = false;
 			else if (util::streqlower(flag, "logerror"sv))
 				logerror = true;
+			else if (util::streqlower(flag, "binary"sv))
+				binary = true;
 			else
 			{
 				m_console.printf("Invalid flag '%s'\n", flag);
@@ -3461,9 +3547,35 @@ void debugger_commands::execute_trace(const std::vector<std::string_view> &param
 	if (params.size() > 3 && !m_console.validate_command_parameter(action = params[3]))
 		return;
 
+	// binary traces are written through a zlib stream, which can't be
+	// appended to
+	using namespace std::literals;
+	if (binary && !util::streqlower(filename, "off"sv))
+	{
+		if ((filename[0] == '>') && (filename[1] == '>'))
+		{
+			m_console.printf("Binary traces can't be appended to\n");
+			return;
+		}
+
+		util::core_file::ptr file;
+		std::error_condition const filerr = util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, file);
+		util::write_stream::ptr stream;
+		if (!filerr)
+			stream = util::zlib_write(std::move(file), 1, 65536);
+		if (!stream)
+		{
+			m_console.printf("Error opening file '%s'\n", params[0]);
+			return;
+		}
+
+		cpu->debug()->trace(std::move(stream), trace_over, logerror, action);
+		m_console.printf("Tracing CPU '%s' to binary file %s\n", cpu->tag(), filename);
+		return;
+	}
+
 	// open the file
 	std::unique_ptr<std::ofstream> f;
-	using namespace std::literals;
 	if (!util::streqlower(filename, "off"sv))
 	{
 		std::ios_base::openmode mode = std::ios_base::out;
@@ -3849,6 +3961,81 @@ void debugger_commands::execute_memdump(const std::vector<std::string_view> &par
 }
 
 
+/*-------------------------------------------------
+    execute_memstats - execute the memstats
+    command
+-------------------------------------------------*/
+
+void debugger_commands::execute_memstats(const std::vector<std::string_view> &params)
+{
+	address_space *space;
+	if (!m_console.validate_device_space_parameter((params.size() > 1) ? params[1] : std::string_view(), AS_PROGRAM, space))
+		return;
+
+	u64 count = 16;
+	if ((params.size() > 2) && !m_console.validate_number_parameter(params[2], count))
+		return;
+
+	auto const found = m_memstats.find(space);
+	if (params[0] == "on")
+	{
+		if (found != m_memstats.end())
+		{
+			m_console.printf("Already counting accesses to %s space of %s\n", space->name(), space->device().tag());
+			return;
+		}
+		m_memstats.emplace(space, std::make_unique<memory_access_stats>(*space));
+		m_console.printf("Counting accesses to %s space of %s\n", space->name(), space->device().tag());
+		return;
+	}
+
+	if (found == m_memstats.end())
+	{
+		m_console.printf("Not counting accesses to %s space of %s\n", space->name(), space->device().tag());
+		return;
+	}
+
+	memory_access_stats &stats = *found->second;
+	if (params[0] == "off")
+	{
+		m_memstats.erase(found);
+		m_console.printf("Stopped counting accesses to %s space of %s\n", space->name(), space->device().tag());
+	}
+	else if (params[0] == "clear")
+	{
+		stats.reset();
+		m_console.printf("Cleared access counts for %s space of %s\n", space->name(), space->device().tag());
+	}
+	else if (params[0] == "list")
+	{
+		int const nc = space->addrchars();
+		m_console.printf("%s space of %s: %d reads, %d writes\n", space->name(), space->device().tag(), stats.reads(), stats.writes());
+
+		m_console.printf("Handlers:\n");
+		u64 shown = 0;
+		for (memory_access_stats::handler_stats const &handler : stats.handlers())
+		{
+			if (shown++ == count)
+				break;
+			m_console.printf("  %0*X-%0*X %12d %12d  %s\n", nc, handler.start, nc, handler.end, handler.reads, handler.writes, handler.name);
+		}
+
+		m_console.printf("Pages:\n");
+		shown = 0;
+		for (memory_access_stats::page_stats const &page : stats.pages())
+		{
+			if (shown++ == count)
+				break;
+			m_console.printf("  %0*X-%0*X %12d %12d\n", nc, page.start, nc, page.end, page.reads, page.writes);
+		}
+	}
+	else
+	{
+		m_console.printf("Invalid action '%s', expected on, off, clear or list\n", params[0]);
+	}
+}
+
+
 /*-------------------------------------------------
     execute_symlist - execute the symlist command
 -------------------------------------------------*/
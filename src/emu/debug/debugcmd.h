@@ -15,7 +15,10 @@
 
 #include "debugcpu.h"
 #include "debugcon.h"
+#include "memstats.h"
 
+#include <map>
+#include <memory>
 #include <string_view>
 
 
@@ -103,6 +106,9 @@ private:
 	void execute_suspend(const std::vector<std::string_view> &params);
 	void execute_resume(const std::vector<std::string_view> &params);
 	void execute_next(const std::vector<std::string_view> &params);
+	void execute_reverse(const std::vector<std::string_view> &params);
+	void execute_reverse_step(const std::vector<std::string_view> &params);
+	void execute_reverse_go(const std::vector<std::string_view> &params);
 	void execute_cpulist(const std::vector<std::string_view> &params);
 	void execute_time(const std::vector<std::string_view> &params);
 	void execute_comment_add(const std::vector<std::string_view> &params);
@@ -152,6 +158,7 @@ private:
 	void execute_source(const std::vector<std::string_view> &params);
 	void execute_map(int spacenum, const std::vector<std::string_view> &params);
 	void execute_memdump(const std::vector<std::string_view> &params);
+	void execute_memstats(const std::vector<std::string_view> &params);
 	void execute_symlist(const std::vector<std::string_view> &params);
 	void execute_softreset(const std::vector<std::string_view> &params);
 	void execute_hardreset(const std::vector<std::string_view> &params);
@@ -167,6 +174,8 @@ private:
 	std::unique_ptr<global_entry []> m_global_array;
 	cheat_system m_cheat;
 
+	std::map<address_space *, std::unique_ptr<memory_access_stats> > m_memstats;
+
 	static const size_t MAX_GLOBALS;
 };
 
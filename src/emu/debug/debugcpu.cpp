@@ -53,6 +53,18 @@ debugger_cpu::debugger_cpu(running_machine &machine)
 	, m_wpsize(0)
 	, m_last_periodic_update_time(0)
 	, m_comments_loaded(false)
+	, m_reverse_interval(0)
+	, m_reverse_position(0)
+	, m_reverse_base(0)
+	, m_reverse_next_snapshot(0)
+	, m_reverse_state(reverse_state::NONE)
+	, m_reverse_next(reverse_state::NONE)
+	, m_reverse_seek(0)
+	, m_reverse_target(0)
+	, m_reverse_start(0)
+	, m_reverse_origin(0)
+	, m_reverse_hit(0)
+	, m_reverse_message(nullptr)
 {
 	m_tempvar = make_unique_clear<u64[]>(NUM_TEMP_VARIABLES);
 
@@ -409,6 +421,275 @@ void debugger_cpu::halt_on_next_instruction(device_t *device, util::format_argum
 	}
 }
 
+
+//**************************************************************************
+//  REVERSE EXECUTION
+//**************************************************************************
+
+// Every instruction hook of an observed CPU advances the position.  At the
+// end of a timeslice, once the position has moved on by the interval, a
+// rewind state tagged with the position is captured.  Going back restores
+// the newest state before the wanted position at the end of the current
+// timeslice and replays from there, relying on the emulation being
+// deterministic.  The digital inputs latched at each frame are logged while
+// running and substituted for the live inputs while replaying.
+
+//-------------------------------------------------
+//  set_reverse_interval - start or stop taking
+//  snapshots every given number of instructions
+//-------------------------------------------------
+
+bool debugger_cpu::set_reverse_interval(u32 interval)
+{
+	// snapshots are rewind states
+	if (interval && !m_machine.save().rewind()->enabled())
+		return false;
+
+	// instructions haven't been counted while we were off, so older snapshots can't be used
+	if (interval && !m_reverse_interval)
+	{
+		m_reverse_base = m_reverse_position;
+		m_reverse_next_snapshot = m_reverse_position;
+	}
+	if (!interval)
+	{
+		m_reverse_inputs.clear();
+		m_reverse_snapshots.clear();
+	}
+	m_reverse_interval = interval;
+	m_reverse_state = reverse_state::NONE;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  reverse_step - go back the given number of
+//  instructions
+//-------------------------------------------------
+
+bool debugger_cpu::reverse_step(u64 count)
+{
+	if (!count || (count >= m_reverse_position) || !reverse_available(m_reverse_position - count))
+		return false;
+
+	reverse_start(m_reverse_position - count, reverse_state::REPLAY, m_reverse_position - count, nullptr);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  reverse_go - go back to the last breakpoint or
+//  watchpoint hit before the current position
+//-------------------------------------------------
+
+bool debugger_cpu::reverse_go()
+{
+	if (!reverse_available(m_reverse_position))
+		return false;
+
+	// scan forward from the snapshot for hits, then replay to the last one
+	m_reverse_origin = m_reverse_position;
+	m_reverse_hit = 0;
+	reverse_start(m_reverse_position, reverse_state::SCAN, m_reverse_position, nullptr);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  reverse_hook - count an instruction, returns
+//  false if the rest of the instruction hook
+//  should be skipped because we're replaying
+//-------------------------------------------------
+
+bool debugger_cpu::reverse_hook()
+{
+	switch (m_reverse_state)
+	{
+	case reverse_state::NONE:
+		m_reverse_position++;
+		return true;
+
+	case reverse_state::PENDING:
+		// the rest of the timeslice runs before the snapshot is restored, it doesn't count
+		return false;
+
+	case reverse_state::REPLAY:
+	case reverse_state::SCAN:
+		m_reverse_position++;
+
+		// a user break gives up
+		if (m_execution_state == exec_state::STOPPED)
+		{
+			m_reverse_state = reverse_state::NONE;
+			m_machine.debugger().console().printf("Reverse execution interrupted at position %d\n", m_reverse_position);
+			return true;
+		}
+		if (m_reverse_position < m_reverse_target)
+			return false;
+
+		if (m_reverse_state == reverse_state::REPLAY)
+		{
+			m_reverse_state = reverse_state::NONE;
+			m_execution_state = exec_state::STOPPED;
+			if (m_reverse_message)
+				m_machine.debugger().console().printf("%s (position %d)\n", m_reverse_message, m_reverse_position);
+			return true;
+		}
+
+		// end of a scan: replay to the last hit, or look further back
+		if (m_reverse_hit)
+			reverse_start(m_reverse_hit, reverse_state::REPLAY, m_reverse_hit, "Stopped at the previous breakpoint or watchpoint hit");
+		else if (reverse_available(m_reverse_start))
+			reverse_start(m_reverse_start, reverse_state::SCAN, m_reverse_start, nullptr);
+		else if (m_reverse_position == m_reverse_origin)
+		{
+			m_reverse_state = reverse_state::NONE;
+			m_execution_state = exec_state::STOPPED;
+			m_machine.debugger().console().printf("No earlier breakpoint or watchpoint hit\n");
+			return true;
+		}
+		else
+			reverse_start(m_reverse_origin, reverse_state::REPLAY, m_reverse_origin, "No earlier breakpoint or watchpoint hit");
+		return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  reverse_hit - note a breakpoint or watchpoint
+//  hit while scanning; after is true when the stop
+//  would come at the next instruction
+//-------------------------------------------------
+
+void debugger_cpu::reverse_hit(bool after)
+{
+	const u64 stop = m_reverse_position + (after ? 1 : 0);
+	if (stop < m_reverse_target)
+		m_reverse_hit = stop;
+}
+
+
+//-------------------------------------------------
+//  end_of_timeslice - take a snapshot, or restore
+//  one for a pending reverse operation
+//-------------------------------------------------
+
+void debugger_cpu::end_of_timeslice()
+{
+	if (!m_reverse_interval || !m_machine.scheduler().can_save())
+		return;
+
+	rewinder &rewind = *m_machine.save().rewind();
+	if (m_reverse_state == reverse_state::PENDING)
+	{
+		u64 found;
+		if (!rewind.seek(m_reverse_seek, found))
+		{
+			m_reverse_state = reverse_state::NONE;
+			m_execution_state = exec_state::STOPPED;
+			m_machine.debugger().console().printf("Unable to restore reverse execution snapshot, see error.log for details\n");
+			return;
+		}
+
+		m_reverse_position = found;
+		m_reverse_start = found;
+		m_reverse_next_snapshot = found + m_reverse_interval;
+		m_reverse_state = m_reverse_next;
+		m_execution_state = exec_state::RUNNING;
+		m_breakcpu = nullptr;
+
+		// clear all PC & memory tracks, like the rewind command
+		for (device_t &device : device_enumerator(m_machine.root_device()))
+		{
+			device.debug()->track_pc_data_clear();
+			device.debug()->track_mem_data_clear();
+		}
+	}
+	else if ((m_reverse_state == reverse_state::NONE) && (m_reverse_position >= m_reverse_next_snapshot))
+	{
+		// the states after one restored by a replay are still good, so only take new ones when running
+		rewind.capture(m_reverse_position);
+		m_reverse_next_snapshot = m_reverse_position + m_reverse_interval;
+		m_reverse_snapshots.emplace_back(m_reverse_position, m_machine.time());
+
+		// inputs from before the oldest snapshot we can still restore will never be replayed
+		while (!m_reverse_snapshots.empty() && !reverse_available(m_reverse_snapshots.front().first + 1))
+			m_reverse_snapshots.pop_front();
+		if (!m_reverse_snapshots.empty())
+			m_reverse_inputs.erase(m_reverse_inputs.begin(), m_reverse_inputs.lower_bound(m_reverse_snapshots.front().second));
+	}
+}
+
+
+//-------------------------------------------------
+//  reverse_input - log the digital inputs latched
+//  for a frame, or substitute the logged ones
+//  while replaying
+//-------------------------------------------------
+
+void debugger_cpu::reverse_input()
+{
+	if (!m_reverse_interval)
+		return;
+
+	// frames come at the same times when replaying, so that's what identifies them
+	attotime const now = m_machine.time();
+	if ((m_reverse_state == reverse_state::REPLAY) || (m_reverse_state == reverse_state::SCAN))
+	{
+		auto const found = m_reverse_inputs.find(now);
+		if (found != m_reverse_inputs.end())
+		{
+			auto value = found->second.begin();
+			for (auto &port : m_machine.ioport().ports())
+			{
+				if (found->second.end() == value)
+					break;
+				port.second->live().digital = *value++;
+			}
+		}
+	}
+	else if (m_reverse_state == reverse_state::NONE)
+	{
+		std::vector<ioport_value> &inputs = m_reverse_inputs[now];
+		inputs.clear();
+		for (auto &port : m_machine.ioport().ports())
+			inputs.emplace_back(port.second->live().digital);
+	}
+}
+
+
+//-------------------------------------------------
+//  reverse_available - check for a usable snapshot
+//  before the given position
+//-------------------------------------------------
+
+bool debugger_cpu::reverse_available(u64 position) const
+{
+	const u64 found = m_machine.save().rewind()->state_before(position);
+	return (found != rewinder::NO_POSITION) && (found >= m_reverse_base);
+}
+
+
+//-------------------------------------------------
+//  reverse_start - restore a snapshot at the end
+//  of this timeslice, then continue with the next
+//  reverse operation
+//-------------------------------------------------
+
+void debugger_cpu::reverse_start(u64 seek, reverse_state next, u64 target, const char *message)
+{
+	m_reverse_seek = seek;
+	m_reverse_next = next;
+	m_reverse_target = target;
+	m_reverse_message = message;
+	m_reverse_state = reverse_state::PENDING;
+
+	reset_transient_flags();
+	m_machine.scheduler().abort_timeslice();
+	m_execution_state = exec_state::RUNNING;
+}
+
 //**************************************************************************
 //  DEVICE DEBUG
 //**************************************************************************
@@ -438,6 +719,7 @@ device_debug::device_debug(device_t &device)
 	, m_pc_history_index(0)
 	, m_pc_history_valid(0)
 	, m_bplist()
+	, m_bp_filter{ 0 }
 	, m_rplist()
 	, m_eplist()
 	, m_triggered_breakpoint(nullptr)
@@ -462,9 +744,11 @@ device_debug::device_debug(device_t &device)
 	if (m_memory) {
 		int count = m_memory->max_space_count();
 		m_phw.resize(count);
+		m_wptaps.resize(count);
 		for (int i=0; i != count; i++)
 			if (m_memory->has_space(i)) {
 				address_space &space = m_memory->space(i);
+				m_wptaps[i] = std::make_unique<debug_watchpoint_taps>(space);
 				m_notifiers.emplace_back(space.add_change_notifier([this, &space] (read_or_write mode) { reinstall(space, mode); }));
 			}
 			else
@@ -564,6 +848,8 @@ void device_debug::write_tracking(address_space &space, offs_t address, u64 data
 void device_debug::reinstall(address_space &space, read_or_write mode)
 {
 	int id = space.spacenum();
+	if (m_wptaps[id])
+		m_wptaps[id]->install(mode);
 	if (u32(mode) & u32(read_or_write::WRITE))
 	{
 		m_phw[id].remove();
@@ -754,6 +1040,15 @@ void device_debug::instruction_hook(offs_t curpc)
 	// note that we are in the debugger code
 	debugcpu.set_within_instruction(true);
 
+	// follow reverse execution; replays only stop once they reach their target
+	if ((debugcpu.reverse_interval() != 0) && !debugcpu.reverse_hook())
+	{
+		if (debugcpu.reverse_scanning() && ((m_flags & DEBUG_FLAG_LIVE_BP) != 0))
+			breakpoint_check(curpc);
+		debugcpu.set_within_instruction(false);
+		return;
+	}
+
 	// update the history
 	m_pc_history[m_pc_history_index] = curpc;
 	m_pc_history_index = (m_pc_history_index + 1) % std::size(m_pc_history);
@@ -1261,6 +1556,7 @@ int device_debug::watchpoint_set(address_space &space, read_or_write type, offs_
 	// allocate a new one
 	u32 id = m_device.machine().debugger().cpu().get_watchpoint_index();
 	m_wplist[space.spacenum()].emplace_back(std::make_unique<debug_watchpoint>(this, *m_symtable, id, space, type, address, length, condition, action));
+	watchpoint_update(space);
 
 	return id;
 }
@@ -1279,7 +1575,9 @@ bool device_debug::watchpoint_clear(int index)
 		for (auto wpi = wpl.begin(); wpi != wpl.end(); wpi++)
 			if ((*wpi)->index() == index)
 			{
+				address_space &space = (*wpi)->space();
 				wpl.erase(wpi);
+				watchpoint_update(space);
 				return true;
 			}
 	}
@@ -1296,7 +1594,14 @@ bool device_debug::watchpoint_clear(int index)
 void device_debug::watchpoint_clear_all()
 {
 	for (auto &wpl : m_wplist)
-		wpl.clear();
+	{
+		if (!wpl.empty())
+		{
+			address_space &space = wpl.front()->space();
+			wpl.clear();
+			watchpoint_update(space);
+		}
+	}
 }
 
 
@@ -1330,8 +1635,27 @@ void device_debug::watchpoint_enable_all(bool enable)
 {
 	// apply the enable to all watchpoints we own
 	for (auto &wpl : m_wplist)
+	{
 		for (auto &wp : wpl)
-			wp->setEnabled(enable);
+			wp->m_enabled = enable;
+		if (!wpl.empty())
+			watchpoint_update(wpl.front()->space());
+	}
+}
+
+
+//-------------------------------------------------
+//  watchpoint_update - rebuild the merged taps
+//  after the watchpoints of a space changed
+//-------------------------------------------------
+
+void device_debug::watchpoint_update(address_space &space)
+{
+	int const spacenum = space.spacenum();
+	if (spacenum >= int(m_wplist.size()))
+		m_wplist.resize(spacenum + 1);
+	if (m_wptaps[spacenum])
+		m_wptaps[spacenum]->update(m_wplist[spacenum]);
 }
 
 
@@ -1710,6 +2034,16 @@ void device_debug::trace(std::unique_ptr<std::ostream> &&file, bool trace_over,
 		m_trace = std::make_unique<tracer>(*this, std::move(file), trace_over, detect_loops, logerror, action);
 }
 
+void device_debug::trace(std::unique_ptr<util::write_stream> &&file, bool trace_over, bool logerror, std::string_view action)
+{
+	// delete any existing tracers
+	m_trace = nullptr;
+
+	// if we have a new stream, make a new binary tracer
+	if (file != nullptr)
+		m_trace = std::make_unique<tracer>(*this, std::move(file), trace_over, logerror, action);
+}
+
 
 //-------------------------------------------------
 //  compute_debug_flags - compute the global
@@ -1742,6 +2076,10 @@ void device_debug::compute_debug_flags()
 	if (m_trace != nullptr)
 		machine.debug_flags |= DEBUG_FLAG_CALL_HOOK;
 
+	// reverse execution counts every instruction
+	if (debugcpu.reverse_interval() != 0)
+		machine.debug_flags |= DEBUG_FLAG_CALL_HOOK;
+
 	// if we are stopping at a particular time and that time is within the current timeslice, we need to be called
 	if ((m_flags & DEBUG_FLAG_STOP_TIME) && m_endexectime <= m_stoptime)
 		machine.debug_flags |= DEBUG_FLAG_CALL_HOOK;
@@ -1833,6 +2171,15 @@ void device_debug::breakpoint_update_flags()
 			break;
 		}
 
+	// rebuild the address filter; disabled breakpoints are included as
+	// they can be enabled without coming through here
+	std::fill(std::begin(m_bp_filter), std::end(m_bp_filter), 0);
+	for (auto &bpp : m_bplist)
+	{
+		offs_t const bit = bpp.first % BP_FILTER_BITS;
+		m_bp_filter[bit / 64] |= u64(1) << (bit % 64);
+	}
+
 	if (!(m_flags & DEBUG_FLAG_LIVE_BP))
 	{
 		// see if there are any enabled registerpoints
@@ -1861,13 +2208,21 @@ void device_debug::breakpoint_check(offs_t pc)
 {
 	debugger_cpu& debugcpu = m_device.machine().debugger().cpu();
 
-	// see if we match
-	auto bpitp = m_bplist.equal_range(pc);
+	// see if we match, skipping the lookup if no breakpoint can be here
+	offs_t const bit = pc % BP_FILTER_BITS;
+	auto bpitp = BIT(m_bp_filter[bit / 64], bit % 64) ? m_bplist.equal_range(pc) : std::make_pair(m_bplist.end(), m_bplist.end());
 	for (auto bpit = bpitp.first; bpit != bpitp.second; ++bpit)
 	{
 		debug_breakpoint &bp = *bpit->second;
 		if (bp.hit(pc))
 		{
+			// a reverse execution scan only notes it down
+			if (debugcpu.reverse_scanning())
+			{
+				debugcpu.reverse_hit(false);
+				break;
+			}
+
 			// halt in the debugger by default
 			debugcpu.set_execution_stopped();
 
@@ -1890,6 +2245,13 @@ void device_debug::breakpoint_check(offs_t pc)
 	{
 		if (rp.hit())
 		{
+			// a reverse execution scan only notes it down
+			if (debugcpu.reverse_scanning())
+			{
+				debugcpu.reverse_hit(false);
+				break;
+			}
+
 			// halt in the debugger by default
 			debugcpu.set_execution_stopped();
 
@@ -1933,6 +2295,28 @@ device_debug::tracer::tracer(device_debug &debug, std::unique_ptr<std::ostream>
 	memset(m_history, 0, sizeof(m_history));
 }
 
+device_debug::tracer::tracer(device_debug &debug, std::unique_ptr<util::write_stream> &&file, bool trace_over, bool logerror, std::string_view action)
+	: m_debug(debug)
+	, m_binfile(std::move(file))
+	, m_action(action)
+	, m_detect_loops(false)
+	, m_logerror(logerror)
+	, m_loops(0)
+	, m_nextdex(0)
+	, m_trace_over(trace_over)
+	, m_trace_over_target(~0)
+{
+	memset(m_history, 0, sizeof(m_history));
+
+	// binary traces start with a signature, the format version and the
+	// width of the program address space for formatting PCs
+	int addrbits = 32;
+	if (m_debug.m_memory && m_debug.m_memory->has_space(AS_PROGRAM))
+		addrbits = m_debug.m_memory->space(AS_PROGRAM).logaddr_width();
+	m_binbuffer.reserve(BINARY_BUFFER_SIZE);
+	m_binbuffer.insert(m_binbuffer.end(), { u8('M'), u8('T'), u8('R'), u8('C'), u8(1), u8(addrbits), u8(0), u8(0) });
+}
+
 
 //-------------------------------------------------
 //  ~tracer - destructor
@@ -1941,10 +2325,32 @@ device_debug::tracer::tracer(device_debug &debug, std::unique_ptr<std::ostream>
 device_debug::tracer::~tracer()
 {
 	// make sure we close the file if we can
+	if (m_binfile)
+	{
+		binary_write();
+		m_binfile->finalize();
+	}
+	m_binfile.reset();
 	m_file.reset();
 }
 
 
+//-------------------------------------------------
+//  binary_write - write out pending binary trace
+//  records
+//-------------------------------------------------
+
+void device_debug::tracer::binary_write()
+{
+	if (!m_binbuffer.empty())
+	{
+		std::size_t written;
+		m_binfile->write(&m_binbuffer[0], m_binbuffer.size(), written);
+		m_binbuffer.clear();
+	}
+}
+
+
 //-------------------------------------------------
 //  update - log to the tracefile the data for a
 //  given instruction
@@ -1986,13 +2392,29 @@ void device_debug::tracer::update(offs_t pc)
 		m_debug.m_device.machine().debugger().console().execute_command(m_action, false);
 
 	debug_disasm_buffer buffer(m_debug.device());
-	std::string instruction;
-	offs_t next_pc, size;
 	u32 dasmresult;
-	buffer.disassemble(pc, instruction, next_pc, size, dasmresult);
+	if (m_binfile)
+	{
+		// binary traces only record the PC and opcodes, unidasm -trace
+		// disassembles them later
+		dasmresult = buffer.disassemble_info(pc);
+		std::size_t const start = m_binbuffer.size();
+		m_binbuffer.insert(m_binbuffer.end(), { u8('I'), u8(pc), u8(pc >> 8), u8(pc >> 16), u8(pc >> 24), u8(0) });
+		buffer.data_get(pc, dasmresult & util::disasm_interface::LENGTHMASK, true, m_binbuffer);
+		m_binbuffer[start + 5] = u8(std::min<std::size_t>(m_binbuffer.size() - start - 6, 255));
+		m_binbuffer.resize(start + 6 + m_binbuffer[start + 5]);
+		if (m_binbuffer.size() >= BINARY_BUFFER_SIZE)
+			binary_write();
+	}
+	else
+	{
+		std::string instruction;
+		offs_t next_pc, size;
+		buffer.disassemble(pc, instruction, next_pc, size, dasmresult);
 
-	// output the result
-	util::stream_format(*m_file, "%s: %s\n", buffer.pc_to_string(pc), instruction);
+		// output the result
+		util::stream_format(*m_file, "%s: %s\n", buffer.pc_to_string(pc), instruction);
+	}
 
 	// do we need to step the trace over this instruction?
 	if (m_trace_over && (dasmresult & util::disasm_interface::SUPPORTED) != 0 && (dasmresult & util::disasm_interface::STEP_OVER) != 0)
@@ -2010,7 +2432,8 @@ void device_debug::tracer::update(offs_t pc)
 	// log this PC
 	m_nextdex = (m_nextdex + 1) % TRACE_LOOPS;
 	m_history[m_nextdex] = pc;
-	m_file->flush();
+	if (m_file)
+		m_file->flush();
 }
 
 
@@ -2020,6 +2443,18 @@ void device_debug::tracer::update(offs_t pc)
 
 void device_debug::tracer::vprintf(util::format_argument_pack<std::ostream> const &args)
 {
+	if (m_binfile)
+	{
+		// text goes in a record of its own in binary traces
+		std::string const text = util::string_format(args);
+		u32 const length = text.length();
+		m_binbuffer.insert(m_binbuffer.end(), { u8('T'), u8(length), u8(length >> 8), u8(length >> 16), u8(length >> 24) });
+		m_binbuffer.insert(m_binbuffer.end(), text.begin(), text.end());
+		if (m_binbuffer.size() >= BINARY_BUFFER_SIZE)
+			binary_write();
+		return;
+	}
+
 	// pass through to the file
 	util::stream_format(*m_file, args);
 	m_file->flush();
@@ -2033,7 +2468,15 @@ void device_debug::tracer::vprintf(util::format_argument_pack<std::ostream> cons
 
 void device_debug::tracer::flush()
 {
-	m_file->flush();
+	if (m_binfile)
+	{
+		binary_write();
+		m_binfile->flush();
+	}
+	else
+	{
+		m_file->flush();
+	}
 }
 
 
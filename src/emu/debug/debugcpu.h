@@ -13,8 +13,11 @@
 
 #pragma once
 
+#include <deque>
+#include <map>
 #include <set>
 #include <utility>
+#include <vector>
 
 
 //**************************************************************************
@@ -103,6 +106,7 @@ public:
 	void watchpoint_clear_all();
 	bool watchpoint_enable(int index, bool enable = true);
 	void watchpoint_enable_all(bool enable = true);
+	void watchpoint_update(address_space &space);
 	void set_triggered_watchpoint(debug_watchpoint *wp) { m_triggered_watchpoint = wp; }
 	debug_watchpoint *triggered_watchpoint() { debug_watchpoint *ret = m_triggered_watchpoint; m_triggered_watchpoint = nullptr; return ret; }
 
@@ -150,6 +154,7 @@ public:
 
 	// tracing
 	void trace(std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action);
+	void trace(std::unique_ptr<util::write_stream> &&file, bool trace_over, bool logerror, std::string_view action);
 	template <typename Format, typename... Params> void trace_printf(Format &&fmt, Params &&...args)
 	{
 		if (m_trace != nullptr)
@@ -160,6 +165,7 @@ public:
 	void reset_transient_flag() { m_flags &= ~DEBUG_FLAG_TRANSIENT; }
 
 	static const int HISTORY_SIZE = 256;
+	static const int BP_FILTER_BITS = 4096;
 
 	// debugger_cpu helpers
 	void compute_debug_flags();
@@ -212,7 +218,9 @@ private:
 
 	// breakpoints and watchpoints
 	std::multimap<offs_t, std::unique_ptr<debug_breakpoint>> m_bplist;     // list of breakpoints
+	u64                     m_bp_filter[BP_FILTER_BITS / 64];              // breakpoint addresses modulo BP_FILTER_BITS
 	std::vector<std::vector<std::unique_ptr<debug_watchpoint>>> m_wplist;  // watchpoint lists for each address space
+	std::vector<std::unique_ptr<debug_watchpoint_taps>> m_wptaps;          // merged watchpoint taps for each address space
 	std::forward_list<debug_registerpoint> m_rplist;                       // list of registerpoints
 	std::multimap<offs_t, std::unique_ptr<debug_exceptionpoint>> m_eplist; // list of exception points
 
@@ -224,6 +232,7 @@ private:
 	{
 	public:
 		tracer(device_debug &debug, std::unique_ptr<std::ostream> &&file, bool trace_over, bool detect_loops, bool logerror, std::string_view action);
+		tracer(device_debug &debug, std::unique_ptr<util::write_stream> &&file, bool trace_over, bool logerror, std::string_view action);
 		~tracer();
 
 		void update(offs_t pc);
@@ -233,9 +242,14 @@ private:
 
 	private:
 		static const int TRACE_LOOPS = 64;
+		static const std::size_t BINARY_BUFFER_SIZE = 65536;
+
+		void binary_write();
 
 		device_debug &      m_debug;                    // reference to our owner
 		std::unique_ptr<std::ostream> m_file;           // tracing file for this CPU
+		std::unique_ptr<util::write_stream> m_binfile;  // binary tracing stream for this CPU
+		std::vector<u8>     m_binbuffer;                // binary records waiting to be written
 		std::string         m_action;                   // action to perform during a trace
 		offs_t              m_history[TRACE_LOOPS];     // history of recent PCs
 		bool                m_detect_loops;             // whether or not we should detect loops
@@ -409,11 +423,38 @@ public:
 	void ensure_comments_loaded();
 	void reset_transient_flags();
 
+	/* ----- reverse execution ----- */
+
+	// instructions between snapshots, 0 if reverse execution is off
+	u32 reverse_interval() const { return m_reverse_interval; }
+	u64 reverse_position() const { return m_reverse_position; }
+	bool set_reverse_interval(u32 interval);
+
+	// go back to an earlier position by restoring a snapshot and replaying
+	bool reverse_step(u64 count);
+	bool reverse_go();
+
+	// hooks for device_debug and the points
+	bool reverse_hook();
+	bool reverse_replaying() const { return (m_reverse_state == reverse_state::PENDING) || (m_reverse_state == reverse_state::REPLAY); }
+	bool reverse_scanning() const { return m_reverse_state == reverse_state::SCAN; }
+	void reverse_hit(bool after);
+
+	// called by the machine between timeslices
+	void end_of_timeslice();
+
+	// called by the input manager once it has latched a frame's inputs
+	void reverse_input();
+
 private:
 	static const size_t NUM_TEMP_VARIABLES;
 
+	enum class reverse_state { NONE, PENDING, REPLAY, SCAN };
+
 	// internal helpers
 	void on_vblank(screen_device &device, bool vblank_state);
+	bool reverse_available(u64 position) const;
+	void reverse_start(u64 seek, reverse_state next, u64 target, const char *message);
 
 	running_machine&    m_machine;
 
@@ -442,6 +483,22 @@ private:
 	osd_ticks_t m_last_periodic_update_time;
 
 	bool        m_comments_loaded;
+
+	// reverse execution
+	u32           m_reverse_interval;       // instructions between snapshots
+	u64           m_reverse_position;       // observed instructions executed so far
+	u64           m_reverse_base;           // position when reverse execution was last enabled
+	u64           m_reverse_next_snapshot;  // position after which the next snapshot is taken
+	reverse_state m_reverse_state;          // what we're doing
+	reverse_state m_reverse_next;           // what to do once the pending snapshot is restored
+	u64           m_reverse_seek;           // restore the newest snapshot before this position
+	u64           m_reverse_target;         // position a replay or scan runs to
+	u64           m_reverse_start;          // position of the restored snapshot
+	u64           m_reverse_origin;         // position reverse_go started from
+	u64           m_reverse_hit;            // stop position of the last hit found by a scan, 0 if none
+	const char *  m_reverse_message;        // printed when a replay reaches its target
+	std::map<attotime, std::vector<ioport_value> > m_reverse_inputs;  // digital inputs latched at each frame
+	std::deque<std::pair<u64, attotime> > m_reverse_snapshots;          // position and time of each snapshot taken
 };
 
 #endif // MAME_EMU_DEBUG_DEBUGCPU_H
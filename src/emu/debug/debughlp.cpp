@@ -123,6 +123,7 @@ const help_item f_static_help_list[] =
 		"  mapi <address>[:<space>] -- map logical I/O address to physical address and bank\n"
 		"  mapo <address>[:<space>] -- map logical opcode address to physical address and bank\n"
 		"  memdump [<filename>,[<root>]] -- dump current memory maps to <filename>\n"
+		"  memstats {on|off|clear|list}[,<CPU>[:<space>][,<count>]] -- count accesses per handler and 4 KB page\n"
 	},
 	{
 		"execution",
@@ -142,6 +143,9 @@ const help_item f_static_help_list[] =
 		"  gt[ime] <milliseconds> -- resumes execution until the given delay has elapsed\n"
 		"  gv[blank] -- resumes execution, setting temp breakpoint on the next VBLANK (F8)\n"
 		"  n[ext] -- executes until the next CPU switch (F6)\n"
+		"  reverse [<interval>] -- takes snapshots every <interval> instructions for reverse execution, 0 to stop\n"
+		"  rs[tep] [<count>=1] -- steps back <count> instructions\n"
+		"  rg[o] -- goes back to the previous breakpoint or watchpoint hit\n"
 		"  focus <CPU> -- focuses debugger only on <CPU>\n"
 		"  ignore [<CPU>[,<CPU>[,...]]] -- stops debugging on <CPU>\n"
 		"  observe [<CPU>[,<CPU>[,...]]] -- resumes debugging on <CPU>\n"
@@ -1089,6 +1093,66 @@ const help_item f_static_help_list[] =
 		"n\n"
 		"  Resume execution, stopping when a different CPU that is not ignored is scheduled.\n"
 	},
+	{
+		"reverse",
+		"\n"
+		"  reverse [<interval>]\n"
+		"\n"
+		"The reverse command sets up reverse execution for the rstep and rgo commands.  While it is "
+		"on, every instruction executed by a CPU that is not ignored is counted, and a rewind state "
+		"is captured at the end of the first timeslice after every <interval> instructions.  Going "
+		"back restores the newest of these snapshots before the wanted point and executes forward "
+		"again from there, so smaller intervals make reverse commands faster at the cost of more "
+		"snapshots.  The snapshots share the rewind buffer, so the rewind option must be enabled and "
+		"the rewind capacity limits how far back you can go.  An <interval> of 0 turns reverse "
+		"execution off.  Without a parameter, the current interval and instruction count are shown.\n"
+		"\n"
+		"Replays assume the emulation is deterministic.  The digital inputs of each frame are logged "
+		"while running and played back while replaying; analog inputs are read again, so don't change "
+		"them while a reverse command runs.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"reverse 100000\n"
+		"  Capture a snapshot every 100000 instructions.\n"
+		"\n"
+		"reverse 0\n"
+		"  Turn reverse execution off.\n"
+	},
+	{
+		"rstep",
+		"\n"
+		"  rs[tep] [<count>=1]\n"
+		"\n"
+		"Steps back <count> instructions, counting instructions on all CPUs that are not ignored, "
+		"by restoring a reverse execution snapshot and executing forward to the instruction.  "
+		"Breakpoints and watchpoints are not checked while replaying.  Reverse execution must be "
+		"enabled with the reverse command.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"rs\n"
+		"  Go back to before the previous instruction.\n"
+		"\n"
+		"rstep 100\n"
+		"  Go back 100 instructions.\n"
+	},
+	{
+		"rgo",
+		"\n"
+		"  rg[o]\n"
+		"\n"
+		"Goes back to the previous point execution would have stopped at because of a breakpoint, "
+		"watchpoint or registerpoint.  The execution since the newest reverse execution snapshot is "
+		"replayed without stopping, noting the hits, and then replayed again to the last one; if "
+		"there were none, older snapshots are tried.  Conditions are evaluated, but actions are not "
+		"run while replaying.  Reverse execution must be enabled with the reverse command.\n"
+		"\n"
+		"Example:\n"
+		"\n"
+		"rg\n"
+		"  Go back to the last breakpoint or watchpoint hit.\n"
+	},
 	{
 		"focus",
 		"\n"
@@ -1149,7 +1213,7 @@ const help_item f_static_help_list[] =
 	{
 		"trace",
 		"\n"
-		"  trace {<filename>|off}[,<CPU>[,[noloop|logerror][,<action>]]]\n"
+		"  trace {<filename>|off}[,<CPU>[,[noloop|logerror|binary][,<action>]]]\n"
 		"\n"
 		"Starts or stops tracing of the execution of the specified <CPU>, or the currently visible "
 		"CPU if no CPU is specified.  To enable tracing, specify the trace log file name in the "
@@ -1157,11 +1221,15 @@ const help_item f_static_help_list[] =
 		"parameter.  If the **<filename>** begins with two right angle brackets (>>), it is treated "
 		"as a directive to open the file for appending rather than overwriting.\n"
 		"\n"
-		"The optional third parameter is a flags field.  The supported flags are 'noloop' and "
-		"'logerror'.  Multiple flags must be separated by | (pipe) characters.  By default, loops "
-		"are detected and condensed to a single line.  If the 'noloop' flag is specified, loops "
-		"will not be detected and every instruction will be logged as executed.  If the 'logerror' "
-		"flag is specified, error log output will be included in the trace log.\n"
+		"The optional third parameter is a flags field.  The supported flags are 'noloop', "
+		"'logerror' and 'binary'.  Multiple flags must be separated by | (pipe) characters.  By "
+		"default, loops are detected and condensed to a single line.  If the 'noloop' flag is "
+		"specified, loops will not be detected and every instruction will be logged as executed.  "
+		"If the 'logerror' flag is specified, error log output will be included in the trace log.  "
+		"If the 'binary' flag is specified, the PC and opcodes of every instruction are written to "
+		"a compressed binary file instead of disassembling them as they are executed; use "
+		"'unidasm <filename> -arch <architecture> -trace' to render it as text.  Binary traces "
+		"can't be appended to.\n"
 		"\n"
 		"The optional <action> parameter is a debugger command to execute before each trace message "
 		"is logged.  Generally, this will include a 'tracelog' or 'tracesym' command to include "
@@ -1189,6 +1257,10 @@ const help_item f_static_help_list[] =
 		"  Begin tracing the execution of CPU #0, logging output (along with logerror output) to "
 		"starswep.tr, with loop detection disabled.\n"
 		"\n"
+		"trace 3dboard.trb,maincpu,binary\n"
+		"  Begin tracing the execution of the CPU ':maincpu', logging PCs and opcodes to the "
+		"binary trace file 3dboard.trb.\n"
+		"\n"
 		"trace >>pigskin.tr\n"
 		"  Begin tracing execution of the currently visible CPU, appending log output to "
 		"pigskin.tr.\n"
@@ -1203,7 +1275,7 @@ const help_item f_static_help_list[] =
 	{
 		"traceover",
 		"\n"
-		"  traceover {<filename>|off}[,<CPU>[,[noloop|logerror][,<action>]]]\n"
+		"  traceover {<filename>|off}[,<CPU>[,[noloop|logerror|binary][,<action>]]]\n"
 		"\n"
 		"Starts or stops tracing for execution of the specified **<CPU>**, or the currently visible "
 		"CPU if no CPU is specified.  When a subroutine call is encountered, tracing will skip over "
@@ -1704,6 +1776,29 @@ const help_item f_static_help_list[] =
 		"memdump mylog.log,1\n"
 		"  Dumps memory maps for the CPU 1 and all its child devices to the file mylog.log.\n"
 	},
+	{
+		"memstats",
+		"\n"
+		"  memstats {on|off|clear|list}[,<CPU>[:<space>][,<count>]]\n"
+		"\n"
+		"Counts reads and writes to an address space, per handler and per 4 KB page.  The address "
+		"space defaults to the program space of the currently visible CPU.  'on' starts counting, "
+		"'off' stops counting and discards the counts, and 'clear' resets them.  'list' shows the "
+		"<count> busiest handlers and pages (16 if omitted), which is useful for finding I/O "
+		"handlers that would be better off as memory banks.  Counting has no cost until it is "
+		"turned on.  Accesses made by the debugger itself are not counted.\n"
+		"\n"
+		"Examples:\n"
+		"\n"
+		"memstats on\n"
+		"  Starts counting accesses to the program space of the visible CPU.\n"
+		"\n"
+		"memstats list,audiocpu,32\n"
+		"  Shows the 32 busiest handlers and pages in the program space of the CPU ':audiocpu'.\n"
+		"\n"
+		"memstats off,maincpu:io\n"
+		"  Stops counting accesses to the I/O space of the CPU ':maincpu'.\n"
+	},
 	{
 		"comlist",
 		"\n"
@@ -101,6 +101,60 @@ enum
 	TVL_EXECUTEFUNC
 };
 
+// program_step operations that aren't operators
+enum
+{
+	PGM_NUMBER = TVL_EXECUTEFUNC + 1,
+	PGM_SYMBOL,
+	PGM_MEMORY,
+	PGM_MEMORY_IMM,         // read memory at the address in m_value
+	PGM_STORE_SYMBOL,       // assign the right operand to a symbol
+	PGM_STORE_MEMORY,       // assign the right operand to memory at the left operand
+	PGM_STORE_MEMORY_IMM    // assign the right operand to memory at the address in m_value
+};
+
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+//-------------------------------------------------
+//  apply_operator - evaluate an operator that
+//  only takes rvals (unary operators ignore t2)
+//-------------------------------------------------
+
+inline u64 apply_operator(u8 op, u64 t1, u64 t2)
+{
+	switch (op)
+	{
+	case TVL_COMPLEMENT:        return !t1;
+	case TVL_NOT:               return ~t1;
+	case TVL_UPLUS:             return t1;
+	case TVL_UMINUS:            return -t1;
+	case TVL_MULTIPLY:          return t1 * t2;
+	case TVL_DIVIDE:            return t1 / t2;
+	case TVL_MODULO:            return t1 % t2;
+	case TVL_ADD:               return t1 + t2;
+	case TVL_SUBTRACT:          return t1 - t2;
+	case TVL_LSHIFT:            return t1 << t2;
+	case TVL_RSHIFT:            return t1 >> t2;
+	case TVL_LESS:              return t1 < t2;
+	case TVL_LESSOREQUAL:       return t1 <= t2;
+	case TVL_GREATER:           return t1 > t2;
+	case TVL_GREATEROREQUAL:    return t1 >= t2;
+	case TVL_EQUAL:             return t1 == t2;
+	case TVL_NOTEQUAL:          return t1 != t2;
+	case TVL_BAND:              return t1 & t2;
+	case TVL_BXOR:              return t1 ^ t2;
+	case TVL_BOR:               return t1 | t2;
+	case TVL_LAND:              return t1 && t2;
+	case TVL_LOR:               return t1 || t2;
+	case TVL_COMMA:             return t2;
+	default:                    return 0;
+	}
+}
+
 
 
 //**************************************************************************
@@ -534,6 +588,177 @@ void symbol_table::write_memory(address_space &space, offs_t address, u64 data,
 }
 
 
+//-------------------------------------------------
+//  bind_memory - look up the address space for
+//  an access at a fixed address; returns false
+//  if it can't be bound and has to go through
+//  memory_value/set_memory_value
+//-------------------------------------------------
+
+bool symbol_table::bind_memory(memory_binding &binding, const char *name, expression_space spacenum, u32 address, int size)
+{
+	binding = memory_binding();
+
+	bool logical = true;
+	int space;
+	switch (spacenum)
+	{
+	case EXPSPACE_PROGRAM_PHYSICAL:
+	case EXPSPACE_DATA_PHYSICAL:
+	case EXPSPACE_IO_PHYSICAL:
+	case EXPSPACE_OPCODE_PHYSICAL:
+		spacenum = expression_space(spacenum - (EXPSPACE_PROGRAM_PHYSICAL - EXPSPACE_PROGRAM_LOGICAL));
+		logical = false;
+		[[fallthrough]];
+	case EXPSPACE_PROGRAM_LOGICAL:
+	case EXPSPACE_DATA_LOGICAL:
+	case EXPSPACE_IO_LOGICAL:
+	case EXPSPACE_OPCODE_LOGICAL:
+		space = AS_PROGRAM + (spacenum - EXPSPACE_PROGRAM_LOGICAL);
+		break;
+
+	default:
+		return false;
+	}
+
+	device_memory_interface *memory = m_memintf;
+	expression_get_space(name, space, memory);
+	if (!memory)
+		return false;
+
+	binding.space = &memory->space(space);
+	binding.address = address;
+	binding.size = size;
+	binding.logical = logical;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  bound_memory_value - read 1,2,4 or 8 bytes
+//  through a memory binding
+//-------------------------------------------------
+
+u64 symbol_table::bound_memory_value(memory_binding &binding, bool disable_se)
+{
+	address_space &space = *binding.space;
+	offs_t address = binding.address;
+	if (binding.logical)
+	{
+		address &= space.logaddrmask();
+		if (!space.device().memory().translate(space.spacenum(), TRANSLATE_READ_DEBUG, address))
+			return ~u64(0) >> (64 - 8 * binding.size);
+	}
+
+	if ((binding.read_generation != space.direct_generation(read_or_write::READ)) || (binding.read_address != address))
+		resolve_binding(binding, address, read_or_write::READ);
+
+	// plain memory can be read without going through the handlers
+	if (binding.read[0])
+	{
+		u64 result = 0;
+		if (space.endianness() == ENDIANNESS_LITTLE)
+		{
+			for (int i = binding.size - 1; 0 <= i; i--)
+				result = (result << 8) | *binding.read[i];
+		}
+		else
+		{
+			for (int i = 0; binding.size > i; i++)
+				result = (result << 8) | *binding.read[i];
+		}
+		return result;
+	}
+
+	auto dis = m_machine.disable_side_effects(disable_se);
+	return read_memory(space, address, binding.size, false);
+}
+
+
+//-------------------------------------------------
+//  set_bound_memory_value - write 1,2,4 or 8
+//  bytes through a memory binding
+//-------------------------------------------------
+
+void symbol_table::set_bound_memory_value(memory_binding &binding, u64 data, bool disable_se)
+{
+	address_space &space = *binding.space;
+	offs_t address = binding.address;
+	if (binding.logical)
+	{
+		address &= space.logaddrmask();
+		if (!space.device().memory().translate(space.spacenum(), TRANSLATE_WRITE_DEBUG, address))
+			return;
+	}
+
+	if ((binding.write_generation != space.direct_generation(read_or_write::WRITE)) || (binding.write_address != address))
+		resolve_binding(binding, address, read_or_write::WRITE);
+
+	// plain memory can be written without going through the handlers
+	if (binding.write[0])
+	{
+		if (space.endianness() == ENDIANNESS_LITTLE)
+		{
+			for (int i = 0; binding.size > i; i++, data >>= 8)
+				*binding.write[i] = u8(data);
+		}
+		else
+		{
+			for (int i = binding.size - 1; 0 <= i; i--, data >>= 8)
+				*binding.write[i] = u8(data);
+		}
+		notify_memory_modified();
+		return;
+	}
+
+	auto dis = m_machine.disable_side_effects(disable_se);
+	write_memory(space, address, data, binding.size, false);
+}
+
+
+//-------------------------------------------------
+//  resolve_binding - find host pointers for the
+//  bytes of a bound access at a translated
+//  address
+//-------------------------------------------------
+
+void symbol_table::resolve_binding(memory_binding &binding, offs_t address, read_or_write mode)
+{
+	address_space &space = *binding.space;
+	u8 **const bytes = (mode == read_or_write::READ) ? binding.read : binding.write;
+	offs_t const lowmask = space.data_width() / 8 - 1;
+	offs_t const byteaddress = space.address_to_byte(address);
+
+	// every byte has to be plain memory, otherwise the handlers are used
+	for (int i = 0; binding.size > i; i++)
+	{
+		offs_t const curaddress = byteaddress + i;
+		u8 *const base = reinterpret_cast<u8 *>(space.get_direct_ptr(space.byte_to_address(curaddress & ~lowmask), mode));
+		if (!base)
+		{
+			bytes[0] = nullptr;
+			break;
+		}
+		if (space.endianness() == ENDIANNESS_LITTLE)
+			bytes[i] = &base[BYTE8_XOR_LE(curaddress) & lowmask];
+		else
+			bytes[i] = &base[BYTE8_XOR_BE(curaddress) & lowmask];
+	}
+
+	// the generation has to be sampled after the lookup, which may create the page table
+	if (mode == read_or_write::READ)
+	{
+		binding.read_address = address;
+		binding.read_generation = space.direct_generation(mode);
+	}
+	else
+	{
+		binding.write_address = address;
+		binding.write_generation = space.direct_generation(mode);
+	}
+}
+
+
 //-------------------------------------------------
 //  expression_get_space - return a space
 //  based on a case insensitive tag search
@@ -1050,12 +1275,16 @@ void parsed_expression::parse(std::string_view expression)
 	m_original_string.assign(expression);
 	m_tokenlist.clear();
 	m_stringlist.clear();
+	m_program.clear();
 
 	// first parse the tokens into the token array in order
 	parse_string_into_tokens();
 
 	// convert the infix order to postfix order
 	infix_to_postfix();
+
+	// compile it if we can
+	compile();
 }
 
 
@@ -1068,6 +1297,7 @@ void parsed_expression::copy(const parsed_expression &src)
 	m_symtable = src.m_symtable;
 	m_default_base = src.m_default_base;
 	m_original_string.assign(src.m_original_string);
+	m_program.clear();
 	if (!m_original_string.empty())
 		parse_string_into_tokens();
 }
@@ -2141,6 +2371,372 @@ u64 parsed_expression::execute_tokens()
 }
 
 
+//-------------------------------------------------
+//  compile - turn the postfix sequence into a
+//  program over fixed stack slots, folding
+//  constant subexpressions; expressions that
+//  increment, decrement, call functions or don't
+//  validate are left to execute_tokens
+//-------------------------------------------------
+
+void parsed_expression::compile()
+{
+	// symbols and memory are read when their slot is consumed, so they
+	// are read in the same order as with execute_tokens; memory at a
+	// constant address keeps the address in the slot info instead
+	enum slot_kind { SLOT_VALUE, SLOT_CONSTANT, SLOT_SYMBOL, SLOT_MEMORY, SLOT_MEMORY_IMM };
+	struct slot_info { slot_kind kind; const parse_token *token; int offset; u64 address; };
+
+	std::vector<program_step> program;
+	std::vector<slot_info> stack;
+	m_program.clear();
+	m_bindings.clear();
+
+	auto const emit =
+			[&program] (u8 op, std::size_t slot, int offset, u64 value = 0, const parse_token *token = nullptr, u8 assign = 0)
+			{
+				program.emplace_back(program_step{ op, u8(slot), offset, value, token, assign, -1 });
+			};
+	auto const resolve =
+			[&stack, &emit] (std::size_t slot)
+			{
+				slot_info &info = stack[slot];
+				if (SLOT_SYMBOL == info.kind)
+					emit(PGM_SYMBOL, slot, info.offset, 0, info.token);
+				else if (SLOT_MEMORY == info.kind)
+					emit(PGM_MEMORY, slot, info.offset, 0, info.token);
+				else if (SLOT_MEMORY_IMM == info.kind)
+					emit(PGM_MEMORY_IMM, slot, info.offset, info.address, info.token);
+				else
+					return;
+				info.kind = SLOT_VALUE;
+			};
+	auto const is_constant =
+			[&program, &stack] (std::size_t slot, std::size_t back)
+			{
+				// a constant's step is always at the end of the program
+				return (SLOT_CONSTANT == stack[slot].kind) &&
+						(program.size() >= back) &&
+						(PGM_NUMBER == program[program.size() - back].m_op) &&
+						(slot == program[program.size() - back].m_slot);
+			};
+
+	for (const parse_token &token : m_tokenlist)
+	{
+		// numbers and symbols take a new slot
+		if (token.is_number() || token.is_symbol())
+		{
+			if (stack.size() >= MAX_PROGRAM_STACK)
+				return;
+			if (token.is_number())
+			{
+				emit(PGM_NUMBER, stack.size(), token.offset(), token.value());
+				stack.emplace_back(slot_info{ SLOT_CONSTANT, nullptr, token.offset(), 0 });
+			}
+			else if (!token.symbol().is_function())
+			{
+				stack.emplace_back(slot_info{ SLOT_SYMBOL, &token, token.offset(), 0 });
+			}
+			else
+			{
+				return;
+			}
+			continue;
+		}
+		else if (!token.is_operator())
+		{
+			return;
+		}
+
+		u8 const op = token.optype();
+		switch (op)
+		{
+		case TVL_COMPLEMENT:
+		case TVL_NOT:
+		case TVL_UPLUS:
+		case TVL_UMINUS:
+		case TVL_MEMORYAT:
+			{
+				if (stack.empty())
+					return;
+				std::size_t const slot = stack.size() - 1;
+				resolve(slot);
+				slot_info &t1 = stack[slot];
+				if (TVL_MEMORYAT == op)
+				{
+					if (is_constant(slot, 1))
+					{
+						t1.kind = SLOT_MEMORY_IMM;
+						t1.address = program.back().m_value;
+						program.pop_back();
+					}
+					else
+					{
+						t1.kind = SLOT_MEMORY;
+					}
+					t1.token = &token;
+				}
+				else if (is_constant(slot, 1))
+				{
+					program.back().m_value = apply_operator(op, program.back().m_value, 0);
+				}
+				else
+				{
+					emit(op, slot, t1.offset);
+					t1.kind = SLOT_VALUE;
+				}
+			}
+			break;
+
+		case TVL_COMMA:
+			if (token.is_function_separator())
+				return;
+			[[fallthrough]];
+		case TVL_MULTIPLY:
+		case TVL_DIVIDE:
+		case TVL_MODULO:
+		case TVL_ADD:
+		case TVL_SUBTRACT:
+		case TVL_LSHIFT:
+		case TVL_RSHIFT:
+		case TVL_LESS:
+		case TVL_LESSOREQUAL:
+		case TVL_GREATER:
+		case TVL_GREATEROREQUAL:
+		case TVL_EQUAL:
+		case TVL_NOTEQUAL:
+		case TVL_BAND:
+		case TVL_BXOR:
+		case TVL_BOR:
+		case TVL_LAND:
+		case TVL_LOR:
+			{
+				if (stack.size() < 2)
+					return;
+				std::size_t const slot = stack.size() - 2;
+				resolve(slot + 1);
+				resolve(slot);
+				slot_info &t1 = stack[slot];
+				slot_info const &t2 = stack[slot + 1];
+				bool const divide = (TVL_DIVIDE == op) || (TVL_MODULO == op);
+				if (is_constant(slot, 2) && is_constant(slot + 1, 1) && (!divide || program.back().m_value))
+				{
+					u64 const value = apply_operator(op, program[program.size() - 2].m_value, program.back().m_value);
+					program.pop_back();
+					program.back().m_value = value;
+				}
+				else
+				{
+					emit(op, slot, t2.offset);
+					t1.kind = SLOT_VALUE;
+				}
+				t1.offset = (TVL_COMMA == op) ? t2.offset : std::min(t1.offset, t2.offset);
+				stack.pop_back();
+			}
+			break;
+
+		case TVL_ASSIGN:
+		case TVL_ASSIGNMULTIPLY:
+		case TVL_ASSIGNDIVIDE:
+		case TVL_ASSIGNMODULO:
+		case TVL_ASSIGNADD:
+		case TVL_ASSIGNSUBTRACT:
+		case TVL_ASSIGNLSHIFT:
+		case TVL_ASSIGNRSHIFT:
+		case TVL_ASSIGNBAND:
+		case TVL_ASSIGNBXOR:
+		case TVL_ASSIGNBOR:
+			{
+				if (stack.size() < 2)
+					return;
+				std::size_t const slot = stack.size() - 2;
+
+				// the right operand is read before the target, as with execute_tokens
+				resolve(slot + 1);
+				slot_info &t1 = stack[slot];
+				slot_info const &t2 = stack[slot + 1];
+				u8 assign = 0;
+				switch (op)
+				{
+				case TVL_ASSIGNMULTIPLY:    assign = TVL_MULTIPLY;  break;
+				case TVL_ASSIGNDIVIDE:      assign = TVL_DIVIDE;    break;
+				case TVL_ASSIGNMODULO:      assign = TVL_MODULO;    break;
+				case TVL_ASSIGNADD:         assign = TVL_ADD;       break;
+				case TVL_ASSIGNSUBTRACT:    assign = TVL_SUBTRACT;  break;
+				case TVL_ASSIGNLSHIFT:      assign = TVL_LSHIFT;    break;
+				case TVL_ASSIGNRSHIFT:      assign = TVL_RSHIFT;    break;
+				case TVL_ASSIGNBAND:        assign = TVL_BAND;      break;
+				case TVL_ASSIGNBXOR:        assign = TVL_BXOR;      break;
+				case TVL_ASSIGNBOR:         assign = TVL_BOR;       break;
+				}
+				int const offset = (TVL_ASSIGN == op) ? t2.offset : std::min(t1.offset, t2.offset);
+				if ((SLOT_SYMBOL == t1.kind) && t1.token->symbol().is_lval())
+					emit(PGM_STORE_SYMBOL, slot, t2.offset, 0, t1.token, assign);
+				else if (SLOT_MEMORY == t1.kind)
+					emit(PGM_STORE_MEMORY, slot, t2.offset, 0, t1.token, assign);
+				else if (SLOT_MEMORY_IMM == t1.kind)
+					emit(PGM_STORE_MEMORY_IMM, slot, t2.offset, t1.address, t1.token, assign);
+				else
+					return;
+				t1.kind = SLOT_VALUE;
+				t1.offset = offset;
+				stack.pop_back();
+			}
+			break;
+
+		default:
+			return;
+		}
+	}
+
+	// the result has to be the only thing left
+	if (stack.size() != 1)
+		return;
+	resolve(0);
+	m_program = std::move(program);
+}
+
+
+//-------------------------------------------------
+//  is_constant - true if the expression was
+//  compiled down to a single constant
+//-------------------------------------------------
+
+bool parsed_expression::is_constant() const
+{
+	return (m_program.size() == 1) && (PGM_NUMBER == m_program[0].m_op);
+}
+
+
+//-------------------------------------------------
+//  bind - look up the address spaces of memory
+//  accesses at fixed addresses once, so they
+//  aren't searched for by name every time the
+//  expression is executed; call again after the
+//  devices the symbol table refers to change
+//-------------------------------------------------
+
+void parsed_expression::bind()
+{
+	symbol_table &symtable = m_symtable.get();
+	m_bindings.clear();
+	for (program_step &step : m_program)
+	{
+		step.m_binding = -1;
+		if ((PGM_MEMORY_IMM == step.m_op) || (PGM_STORE_MEMORY_IMM == step.m_op))
+		{
+			const parse_token &token = *step.m_token;
+			symbol_table::memory_binding binding;
+			if (symtable.bind_memory(binding, token.memory_source(), token.memory_space(), u32(step.m_value), 1 << token.memory_size()))
+			{
+				step.m_binding = int(m_bindings.size());
+				m_bindings.emplace_back(binding);
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  execute_program - execute a compiled
+//  expression
+//-------------------------------------------------
+
+u64 parsed_expression::execute_program()
+{
+	symbol_table &symtable = m_symtable.get();
+	u64 stack[MAX_PROGRAM_STACK];
+	for (const program_step &step : m_program)
+	{
+		u64 *const operand = &stack[step.m_slot];
+		switch (step.m_op)
+		{
+		case PGM_NUMBER:
+			operand[0] = step.m_value;
+			break;
+
+		case PGM_SYMBOL:
+			operand[0] = step.m_token->symbol().value();
+			break;
+
+		case PGM_MEMORY:
+			{
+				const parse_token &token = *step.m_token;
+				operand[0] = symtable.memory_value(token.memory_source(), token.memory_space(), u32(operand[0]), 1 << token.memory_size(), token.memory_side_effects());
+			}
+			break;
+
+		case PGM_MEMORY_IMM:
+			{
+				const parse_token &token = *step.m_token;
+				if (std::size_t(step.m_binding) < m_bindings.size())
+					operand[0] = symtable.bound_memory_value(m_bindings[step.m_binding], token.memory_side_effects());
+				else
+					operand[0] = symtable.memory_value(token.memory_source(), token.memory_space(), u32(step.m_value), 1 << token.memory_size(), token.memory_side_effects());
+			}
+			break;
+
+		case PGM_STORE_SYMBOL:
+			{
+				symbol_entry &symbol = step.m_token->symbol();
+				u64 value = operand[1];
+				if (step.m_assign)
+				{
+					if (!value && ((TVL_DIVIDE == step.m_assign) || (TVL_MODULO == step.m_assign)))
+						throw expression_error(expression_error::DIVIDE_BY_ZERO, step.m_offset);
+					value = apply_operator(step.m_assign, symbol.value(), value);
+				}
+				symbol.set_value(value);
+				operand[0] = value;
+			}
+			break;
+
+		case PGM_STORE_MEMORY:
+		case PGM_STORE_MEMORY_IMM:
+			{
+				const parse_token &token = *step.m_token;
+				symbol_table::memory_binding *const binding = ((PGM_STORE_MEMORY_IMM == step.m_op) && (std::size_t(step.m_binding) < m_bindings.size())) ? &m_bindings[step.m_binding] : nullptr;
+				u32 const address = (PGM_STORE_MEMORY_IMM == step.m_op) ? u32(step.m_value) : u32(operand[0]);
+				int const size = 1 << token.memory_size();
+				u64 value = operand[1];
+				if (step.m_assign)
+				{
+					if (!value && ((TVL_DIVIDE == step.m_assign) || (TVL_MODULO == step.m_assign)))
+						throw expression_error(expression_error::DIVIDE_BY_ZERO, step.m_offset);
+					u64 const current = binding
+							? symtable.bound_memory_value(*binding, token.memory_side_effects())
+							: symtable.memory_value(token.memory_source(), token.memory_space(), address, size, token.memory_side_effects());
+					value = apply_operator(step.m_assign, current, value);
+				}
+				if (binding)
+					symtable.set_bound_memory_value(*binding, value, token.memory_side_effects());
+				else
+					symtable.set_memory_value(token.memory_source(), token.memory_space(), address, size, value, token.memory_side_effects());
+				operand[0] = value;
+			}
+			break;
+
+		case TVL_COMPLEMENT:
+		case TVL_NOT:
+		case TVL_UPLUS:
+		case TVL_UMINUS:
+			operand[0] = apply_operator(step.m_op, operand[0], 0);
+			break;
+
+		case TVL_DIVIDE:
+		case TVL_MODULO:
+			if (!operand[1])
+				throw expression_error(expression_error::DIVIDE_BY_ZERO, step.m_offset);
+			[[fallthrough]];
+		default:
+			operand[0] = apply_operator(step.m_op, operand[0], operand[1]);
+			break;
+		}
+	}
+	return stack[0];
+}
+
+
 
 //**************************************************************************
 //  PARSE TOKEN
@@ -20,6 +20,7 @@
 #include <list>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 
 
@@ -169,6 +170,23 @@ public:
 		READ_WRITE
 	};
 
+	// a memory access at a fixed address with the address space looked up
+	// ahead of time; plain memory is accessed through host pointers, which
+	// are resolved on first use and again whenever the memory map changes
+	struct memory_binding
+	{
+		address_space *     space = nullptr;            // space being accessed
+		offs_t              address = 0;                // address as written in the expression
+		int                 size = 0;                   // bytes accessed
+		bool                logical = false;            // address needs translating
+		offs_t              read_address = 0;           // translated address the read pointers are for
+		offs_t              write_address = 0;          // translated address the write pointers are for
+		u32                 read_generation = ~u32(0);  // direct page generation the read pointers are for
+		u32                 write_generation = ~u32(0); // direct page generation the write pointers are for
+		u8 *                read[8] = { };              // host address of each byte, lowest address first (read[0] = nullptr if not plain memory)
+		u8 *                write[8] = { };             // same for writes
+	};
+
 	// construction/destruction
 	symbol_table(running_machine &machine, symbol_table *parent = nullptr, device_t *device = nullptr);
 
@@ -198,6 +216,9 @@ public:
 	void set_memory_value(const char *name, expression_space space, u32 offset, int size, u64 value, bool disable_se);
 	u64 read_memory(address_space &space, offs_t address, int size, bool apply_translation);
 	void write_memory(address_space &space, offs_t address, u64 data, int size, bool apply_translation);
+	bool bind_memory(memory_binding &binding, const char *name, expression_space space, u32 offset, int size);
+	u64 bound_memory_value(memory_binding &binding, bool disable_se);
+	void set_bound_memory_value(memory_binding &binding, u64 value, bool disable_se);
 
 private:
 	// memory helpers
@@ -205,6 +226,7 @@ private:
 	u64 read_memory_region(const char *rgntag, offs_t address, int size);
 	void write_program_direct(address_space &space, int opcode, offs_t address, int size, u64 data);
 	void write_memory_region(const char *rgntag, offs_t address, int size, u64 data);
+	void resolve_binding(memory_binding &binding, offs_t address, read_or_write mode);
 	expression_error expression_get_space(const char *tag, int &spacenum, device_memory_interface *&memory);
 	void notify_memory_modified();
 
@@ -240,12 +262,14 @@ public:
 	symbol_table &symbols() const { return m_symtable.get(); }
 
 	// setters
-	void set_symbols(symbol_table &symtable) { m_symtable = std::reference_wrapper<symbol_table>(symtable); }
+	void set_symbols(symbol_table &symtable) { m_symtable = std::reference_wrapper<symbol_table>(symtable); m_bindings.clear(); }
 	void set_default_base(int base) { assert(base == 8 || base == 10 || base == 16); m_default_base = base; }
 
 	// execution
 	void parse(std::string_view string);
-	u64 execute() { return execute_tokens(); }
+	u64 execute() { return m_program.empty() ? execute_tokens() : execute_program(); }
+	bool is_constant() const;
+	void bind();
 
 private:
 	// a single token
@@ -307,6 +331,7 @@ private:
 		expression_space memory_space() const { assert(m_type == OPERATOR || m_type == MEMORY); return expression_space((m_flags & TIN_MEMORY_SPACE_MASK) >> TIN_MEMORY_SPACE_SHIFT); }
 		int memory_size() const { assert(m_type == OPERATOR || m_type == MEMORY); return (m_flags & TIN_MEMORY_SIZE_MASK) >> TIN_MEMORY_SIZE_SHIFT; }
 		bool memory_side_effects() const { assert(m_type == OPERATOR || m_type == MEMORY); return (m_flags & TIN_SIDE_EFFECT_MASK) >> TIN_SIDE_EFFECT_SHIFT; }
+		const char *memory_source() const { assert(m_type == OPERATOR || m_type == MEMORY); return m_string; }
 
 		// setters
 		parse_token &set_offset(int offset) { m_offset = offset; return *this; }
@@ -340,6 +365,19 @@ private:
 		symbol_entry *          m_symbol;           // symbol pointer
 	};
 
+	// a single step of a compiled expression; operands live in fixed
+	// stack slots, so the program needs no run-time stack checks
+	struct program_step
+	{
+		u8                  m_op;               // operator or program-specific operation
+		u8                  m_slot;             // slot of the (left) operand and result
+		int                 m_offset;           // offset within the string
+		u64                 m_value;            // immediate value or address
+		const parse_token * m_token;            // token for symbol/memory accesses
+		u8                  m_assign;           // operator of a compound assignment (0 = plain assignment)
+		int                 m_binding;          // index of the memory binding (-1 = none)
+	};
+
 	// internal helpers
 	void copy(const parsed_expression &src);
 	void print_tokens();
@@ -361,9 +399,12 @@ private:
 	void pop_token_rval(parse_token &token);
 	u64 execute_tokens();
 	void execute_function(parse_token &token);
+	void compile();
+	u64 execute_program();
 
 	// constants
 	static const int MAX_FUNCTION_PARAMS = 16;
+	static const int MAX_PROGRAM_STACK = 32;
 
 	// internal state
 	std::reference_wrapper<symbol_table> m_symtable;    // symbol table
@@ -372,6 +413,8 @@ private:
 	std::list<parse_token> m_tokenlist;                 // token list
 	std::list<std::string> m_stringlist;                // string list
 	std::deque<parse_token> m_token_stack;              // token stack (used during execution)
+	std::vector<program_step> m_program;                // compiled program (empty if not compilable)
+	std::vector<symbol_table::memory_binding> m_bindings; // fixed memory accesses resolved by bind()
 };
 
 #endif // MAME_EMU_DEBUG_EXPRESS_H
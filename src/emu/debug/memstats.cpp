@@ -0,0 +1,273 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    memstats.cpp
+
+    Per-handler and per-page memory access counting.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "memstats.h"
+
+#include <algorithm>
+
+
+namespace {
+
+// taps wrap the handler they sit in front of and prefix its name with
+// "(tap) ", so peel those off to get back to the real handler
+std::string underlying_name(std::string const &name)
+{
+	std::string::size_type pos = 0;
+	while ((name.length() > pos) && (name[pos] == '('))
+	{
+		std::string::size_type const close = name.find(") ", pos);
+		if (close == std::string::npos)
+			break;
+		pos = close + 2;
+	}
+	return name.substr(pos);
+}
+
+
+// an entry is live if every view it sits in has the right slot selected
+bool entry_active(memory_entry const &entry)
+{
+	for (memory_entry_context const &c : entry.context)
+	{
+		std::optional<int> const current = c.view->entry();
+		if (c.disabled ? bool(current) : (!current || (*current != c.slot)))
+			return false;
+	}
+	return true;
+}
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  MEMORY ACCESS STATISTICS
+//**************************************************************************
+
+//-------------------------------------------------
+//  memory_access_stats - constructor
+//-------------------------------------------------
+
+memory_access_stats::memory_access_stats(address_space &space)
+	: m_space(space)
+	, m_installing(false)
+	, m_ranges_dirty(true)
+	, m_reads(0)
+	, m_writes(0)
+{
+	install(read_or_write::READWRITE);
+
+	// installing anything over our taps removes them, so put them back
+	m_notifier = m_space.add_change_notifier(
+			[this] (read_or_write mode)
+			{
+				m_ranges_dirty = true;
+				install(mode);
+			});
+}
+
+
+//-------------------------------------------------
+//  ~memory_access_stats - destructor
+//-------------------------------------------------
+
+memory_access_stats::~memory_access_stats()
+{
+	m_notifier.reset();
+	m_phr.remove();
+	m_phw.remove();
+}
+
+
+//-------------------------------------------------
+//  reset - clear all counts
+//-------------------------------------------------
+
+void memory_access_stats::reset()
+{
+	m_reads = m_writes = 0;
+	m_unattributed = counts();
+	for (auto &entry : m_handler_totals)
+		entry.second = counts();
+	m_pages.clear();
+}
+
+
+//-------------------------------------------------
+//  handlers - per-handler counts, busiest first
+//-------------------------------------------------
+
+std::vector<memory_access_stats::handler_stats> memory_access_stats::handlers() const
+{
+	std::vector<handler_stats> result;
+	for (auto const &entry : m_handler_totals)
+		if (entry.second.reads || entry.second.writes)
+			result.emplace_back(handler_stats{ std::get<0>(entry.first), std::get<1>(entry.first), std::get<2>(entry.first), entry.second.reads, entry.second.writes });
+	if (m_unattributed.reads || m_unattributed.writes)
+		result.emplace_back(handler_stats{ 0, m_space.addrmask(), "(unknown)", m_unattributed.reads, m_unattributed.writes });
+
+	std::stable_sort(
+			result.begin(),
+			result.end(),
+			[] (handler_stats const &a, handler_stats const &b) { return (a.reads + a.writes) > (b.reads + b.writes); });
+	return result;
+}
+
+
+//-------------------------------------------------
+//  pages - per-page counts, busiest first
+//-------------------------------------------------
+
+std::vector<memory_access_stats::page_stats> memory_access_stats::pages() const
+{
+	std::vector<page_stats> result;
+	result.reserve(m_pages.size());
+	for (auto const &entry : m_pages)
+	{
+		offs_t const bytestart = offs_t(entry.first) << PAGE_SHIFT;
+		offs_t const byteend = bytestart + ((offs_t(1) << PAGE_SHIFT) - 1);
+		offs_t const start = m_space.byte_to_address(bytestart) & m_space.addrmask();
+		offs_t const end = std::min(m_space.byte_to_address_end(byteend), m_space.addrmask());
+		result.emplace_back(page_stats{ start, end, entry.second.reads, entry.second.writes });
+	}
+
+	std::sort(
+			result.begin(),
+			result.end(),
+			[] (page_stats const &a, page_stats const &b)
+			{
+				u64 const atotal = a.reads + a.writes, btotal = b.reads + b.writes;
+				return (atotal != btotal) ? (atotal > btotal) : (a.start < b.start);
+			});
+	return result;
+}
+
+
+//-------------------------------------------------
+//  install_taps - install taps for one data width
+//-------------------------------------------------
+
+template <typename T>
+void memory_access_stats::install_taps(read_or_write mode)
+{
+	if (u32(mode) & u32(read_or_write::READ))
+		m_phr = m_space.install_read_tap(
+				0, m_space.addrmask(), "memstats",
+				[this] (offs_t offset, T &data, T mem_mask) { count(read_or_write::READ, offset); },
+				&m_phr);
+	if (u32(mode) & u32(read_or_write::WRITE))
+		m_phw = m_space.install_write_tap(
+				0, m_space.addrmask(), "memstats",
+				[this] (offs_t offset, T &data, T mem_mask) { count(read_or_write::WRITE, offset); },
+				&m_phw);
+}
+
+
+//-------------------------------------------------
+//  install - (re)install the counting taps
+//-------------------------------------------------
+
+void memory_access_stats::install(read_or_write mode)
+{
+	if (m_installing)
+		return;
+	m_installing = true;
+	if (u32(mode) & u32(read_or_write::READ))
+		m_phr.remove();
+	if (u32(mode) & u32(read_or_write::WRITE))
+		m_phw.remove();
+	switch (m_space.data_width())
+	{
+	case  8: install_taps<u8>(mode);  break;
+	case 16: install_taps<u16>(mode); break;
+	case 32: install_taps<u32>(mode); break;
+	case 64: install_taps<u64>(mode); break;
+	}
+	m_installing = false;
+}
+
+
+//-------------------------------------------------
+//  refresh_ranges - rebuild the handler lookup
+//  tables from the current memory map
+//-------------------------------------------------
+
+void memory_access_stats::refresh_ranges()
+{
+	std::vector<memory_entry> entries[2];
+	m_space.dump_maps(entries[0], entries[1]);
+
+	for (int mode = 0; mode < 2; mode++)
+	{
+		std::vector<range> &ranges = mode ? m_write_ranges : m_read_ranges;
+		ranges.clear();
+		for (memory_entry const &entry : entries[mode])
+		{
+			if (entry_active(entry))
+			{
+				counts &totals = m_handler_totals[handler_key(entry.start, entry.end, underlying_name(entry.entry->name()))];
+				ranges.emplace_back(range{ entry.start, entry.end, &totals });
+			}
+		}
+		std::sort(
+				ranges.begin(),
+				ranges.end(),
+				[] (range const &a, range const &b) { return a.start < b.start; });
+	}
+	m_ranges_dirty = false;
+}
+
+
+//-------------------------------------------------
+//  handler_counts - find the counters for the
+//  handler covering an address
+//-------------------------------------------------
+
+memory_access_stats::counts &memory_access_stats::handler_counts(std::vector<range> const &ranges, offs_t address)
+{
+	auto const found = std::upper_bound(
+			ranges.begin(),
+			ranges.end(),
+			address,
+			[] (offs_t addr, range const &r) { return addr < r.start; });
+	if ((found == ranges.begin()) || (std::prev(found)->end < address))
+		return m_unattributed;
+	return *std::prev(found)->totals;
+}
+
+
+//-------------------------------------------------
+//  count - record one access
+//-------------------------------------------------
+
+void memory_access_stats::count(read_or_write type, offs_t address)
+{
+	// debugger peeks aren't the program's accesses
+	if (m_space.device().machine().side_effects_disabled())
+		return;
+
+	if (m_ranges_dirty)
+		refresh_ranges();
+
+	counts &page = m_pages[m_space.address_to_byte(address) >> PAGE_SHIFT];
+	if (type == read_or_write::READ)
+	{
+		m_reads++;
+		page.reads++;
+		handler_counts(m_read_ranges, address).reads++;
+	}
+	else
+	{
+		m_writes++;
+		page.writes++;
+		handler_counts(m_write_ranges, address).writes++;
+	}
+}
@@ -0,0 +1,92 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    memstats.h
+
+    Per-handler and per-page memory access counting.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_DEBUG_MEMSTATS_H
+#define MAME_EMU_DEBUG_MEMSTATS_H
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> memory_access_stats
+
+// counts accesses to an address space using passthrough taps, so it costs
+// nothing until it is created and is removed with it
+class memory_access_stats
+{
+public:
+	// 4 KB pages, measured in bytes whatever the space's address shift
+	static constexpr int PAGE_SHIFT = 12;
+
+	struct handler_stats
+	{
+		offs_t start, end;
+		std::string name;
+		u64 reads, writes;
+	};
+
+	struct page_stats
+	{
+		offs_t start, end;
+		u64 reads, writes;
+	};
+
+	// construction/destruction
+	memory_access_stats(address_space &space);
+	~memory_access_stats();
+
+	// getters
+	address_space &space() const { return m_space; }
+	u64 reads() const { return m_reads; }
+	u64 writes() const { return m_writes; }
+
+	// results, busiest first
+	std::vector<handler_stats> handlers() const;
+	std::vector<page_stats> pages() const;
+
+	// forget everything counted so far
+	void reset();
+
+private:
+	struct counts { u64 reads = 0, writes = 0; };
+	struct range { offs_t start, end; counts *totals; };
+	using handler_key = std::tuple<offs_t, offs_t, std::string>;
+
+	template <typename T> void install_taps(read_or_write mode);
+	void install(read_or_write mode);
+	void refresh_ranges();
+	counts &handler_counts(std::vector<range> const &ranges, offs_t address);
+	void count(read_or_write type, offs_t address);
+
+	address_space &                         m_space;
+	memory_passthrough_handler              m_phr;              // read tap
+	memory_passthrough_handler              m_phw;              // write tap
+	util::notifier_subscription             m_notifier;         // address map change notifier
+	bool                                    m_installing;       // guards against reentry from the notifier
+	bool                                    m_ranges_dirty;     // handler ranges need to be rebuilt
+	u64                                     m_reads;
+	u64                                     m_writes;
+	std::map<handler_key, counts>           m_handler_totals;   // keyed by range and handler name
+	std::vector<range>                      m_read_ranges;      // active read handlers, sorted by start
+	std::vector<range>                      m_write_ranges;     // active write handlers, sorted by start
+	counts                                  m_unattributed;
+	std::unordered_map<offs_t, counts>      m_pages;            // keyed by byte address >> PAGE_SHIFT
+};
+
+#endif // MAME_EMU_DEBUG_MEMSTATS_H
@@ -90,8 +90,6 @@ debug_watchpoint::debug_watchpoint(
 		const char *condition,
 		std::string_view action) :
 	m_debugInterface(debugInterface),
-	m_phr(nullptr),
-	m_phw(nullptr),
 	m_space(space),
 	m_index(index),
 	m_enabled(true),
@@ -99,8 +97,7 @@ debug_watchpoint::debug_watchpoint(
 	m_address(address & space.addrmask()),
 	m_length(length),
 	m_condition(symbols, condition ? condition : "1"),
-	m_action(action),
-	m_installing(false)
+	m_action(action)
 {
 	std::fill(std::begin(m_start_address), std::end(m_start_address), 0);
 	std::fill(std::begin(m_end_address), std::end(m_end_address), 0);
@@ -171,22 +168,6 @@ debug_watchpoint::debug_watchpoint(
 		}
 	}
 
-	install(read_or_write::READWRITE);
-	m_notifier = m_space.add_change_notifier(
-			[this] (read_or_write mode)
-			{
-				if (m_enabled)
-				{
-					install(mode);
-				}
-			});
-}
-
-debug_watchpoint::~debug_watchpoint()
-{
-	m_notifier.reset();
-	m_phr.remove();
-	m_phw.remove();
 }
 
 void debug_watchpoint::setEnabled(bool value)
@@ -194,128 +175,17 @@ void debug_watchpoint::setEnabled(bool value)
 	if (m_enabled != value)
 	{
 		m_enabled = value;
-		if (m_enabled)
-			install(read_or_write::READWRITE);
-		else
-		{
-			m_installing = true;
-			m_phr.remove();
-			m_phw.remove();
-			m_installing = false;
-		}
+		m_debugInterface->watchpoint_update(m_space);
 	}
 }
 
-void debug_watchpoint::install(read_or_write mode)
-{
-	if (m_installing)
-		return;
-	m_installing = true;
-	if (u32(mode) & u32(read_or_write::READ))
-		m_phr.remove();
-	if (u32(mode) & u32(read_or_write::WRITE))
-		m_phw.remove();
-	std::string name = util::string_format("wp@%x", m_address);
-	switch (m_space.data_width())
-	{
-	case  8:
-		if (u32(m_type) & u32(mode) & u32(read_or_write::READ))
-			m_phr = m_space.install_read_tap(
-					m_start_address[0], m_end_address[0], name,
-					[this](offs_t offset, u8 &data, u8 mem_mask) {
-						triggered(read_or_write::READ, offset, data, mem_mask);
-					},
-					&m_phr);
-		if (u32(m_type) & u32(mode) & u32(read_or_write::WRITE))
-			m_phw = m_space.install_write_tap(
-					m_start_address[0], m_end_address[0], name,
-					[this](offs_t offset, u8 &data, u8 mem_mask) {
-						triggered(read_or_write::WRITE, offset, data, mem_mask);
-					},
-					&m_phw);
-		break;
-
-	case 16:
-		for (int i=0; i != 3; i++)
-			if (m_masks[i])
-			{
-				u16 mask = m_masks[i];
-				if (u32(m_type) & u32(mode) & u32(read_or_write::READ))
-					m_phr = m_space.install_read_tap(
-							m_start_address[i], m_end_address[i], name,
-							[this, mask](offs_t offset, u16 &data, u16 mem_mask) {
-								if (mem_mask & mask)
-									triggered(read_or_write::READ, offset, data, mem_mask);
-							},
-							&m_phr);
-				if (u32(m_type) & u32(mode) & u32(read_or_write::WRITE))
-					m_phw = m_space.install_write_tap(
-							m_start_address[i], m_end_address[i], name,
-							[this, mask](offs_t offset, u16 &data, u16 mem_mask) {
-								if (mem_mask & mask)
-									triggered(read_or_write::WRITE, offset, data, mem_mask);
-							},
-							&m_phw);
-			}
-		break;
-
-	case 32:
-		for (int i=0; i != 3; i++)
-			if (m_masks[i])
-			{
-				u32 mask = m_masks[i];
-				if (u32(m_type) & u32(mode) & u32(read_or_write::READ))
-					m_phr = m_space.install_read_tap(
-							m_start_address[i], m_end_address[i], name,
-							[this, mask](offs_t offset, u32 &data, u32 mem_mask) {
-								if (mem_mask & mask)
-									triggered(read_or_write::READ, offset, data, mem_mask);
-							},
-							&m_phr);
-				if (u32(m_type) & u32(mode) & u32(read_or_write::WRITE))
-					m_phw = m_space.install_write_tap(
-							m_start_address[i], m_end_address[i], name,
-							[this, mask](offs_t offset, u32 &data, u32 mem_mask) {
-								if (mem_mask & mask)
-									triggered(read_or_write::WRITE, offset, data, mem_mask);
-								},
-								&m_phw);
-			}
-		break;
-
-	case 64:
-		for (int i=0; i != 3; i++)
-			if (m_masks[i])
-			{
-				u64 mask = m_masks[i];
-				if (u32(m_type) & u32(mode) & u32(read_or_write::READ))
-					m_phr = m_space.install_read_tap(
-							m_start_address[i], m_end_address[i], name,
-							[this, mask](offs_t offset, u64 &data, u64 mem_mask) {
-								if (mem_mask & mask)
-									triggered(read_or_write::READ, offset, data, mem_mask);
-							},
-							&m_phr);
-				if (u32(m_type) & u32(mode) & u32(read_or_write::WRITE))
-					m_phw = m_space.install_write_tap(m_start_address[i], m_end_address[i], name,
-							[this, mask](offs_t offset, u64 &data, u64 mem_mask) {
-								if (mem_mask & mask)
-									triggered(read_or_write::WRITE, offset, data, mem_mask);
-							},
-							&m_phw);
-			}
-		break;
-	}
-	m_installing = false;
-}
-
 void debug_watchpoint::triggered(read_or_write type, offs_t address, u64 data, u64 mem_mask)
 {
 	running_machine &machine = m_debugInterface->device().machine();
 	debugger_manager &debug = machine.debugger();
 
-	// if we're within debugger code, don't trigger
-	if (debug.cpu().within_instruction_hook() || machine.side_effects_disabled())
+	// if we're within debugger code or replaying for reverse execution, don't trigger
+	if (debug.cpu().within_instruction_hook() || machine.side_effects_disabled() || debug.cpu().reverse_replaying())
 		return;
 
 	// adjust address, size & value_to_write based on mem_mask.
@@ -373,6 +243,14 @@ void debug_watchpoint::triggered(read_or_write type, offs_t address, u64 data, u
 		}
 	}
 
+	// a reverse execution scan only notes it down
+	if (debug.cpu().reverse_scanning())
+	{
+		debug.cpu().reverse_hit(true);
+		debug.cpu().set_within_instruction(false);
+		return;
+	}
+
 	// halt in the debugger by default
 	bool was_stopped = debug.cpu().is_stopped();
 	debug.cpu().set_execution_stopped();
@@ -423,6 +301,172 @@ void debug_watchpoint::triggered(read_or_write type, offs_t address, u64 data, u
 	debug.cpu().set_within_instruction(false);
 }
 
+//**************************************************************************
+//  DEBUG WATCHPOINT TAPS
+//**************************************************************************
+
+//-------------------------------------------------
+//  debug_watchpoint_taps - constructor
+//-------------------------------------------------
+
+debug_watchpoint_taps::debug_watchpoint_taps(address_space &space) :
+	m_space(space),
+	m_phr(nullptr),
+	m_phw(nullptr),
+	m_generation(0),
+	m_installing(false)
+{
+}
+
+debug_watchpoint_taps::~debug_watchpoint_taps()
+{
+	m_phr.remove();
+	m_phw.remove();
+}
+
+
+//-------------------------------------------------
+//  update - split the ranges of the enabled
+//  watchpoints into disjoint segments, each with
+//  the list of watchpoints covering it
+//-------------------------------------------------
+
+void debug_watchpoint_taps::update(const std::vector<std::unique_ptr<debug_watchpoint>> &wplist)
+{
+	struct watched
+	{
+		offs_t start;
+		offs_t end;
+		hit target;
+	};
+
+	for (int side = 0; side < 2; side++)
+	{
+		read_or_write const type = side ? read_or_write::WRITE : read_or_write::READ;
+		std::vector<watched> ranges;
+		std::vector<u64> bounds;
+		for (auto &wp : wplist)
+			if (wp->enabled() && (u32(wp->type()) & u32(type)))
+				for (int i = 0; i != 3; i++)
+					if (wp->m_masks[i])
+					{
+						ranges.emplace_back(watched{ wp->m_start_address[i], wp->m_end_address[i], hit{ wp.get(), wp->m_masks[i] } });
+						bounds.emplace_back(wp->m_start_address[i]);
+						bounds.emplace_back(u64(wp->m_end_address[i]) + 1);
+					}
+		std::sort(bounds.begin(), bounds.end());
+		bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+		m_segments[side].clear();
+		m_hits[side].clear();
+		for (std::size_t b = 1; b < bounds.size(); b++)
+		{
+			segment seg{ offs_t(bounds[b - 1]), offs_t(bounds[b] - 1), u32(m_hits[side].size()), 0 };
+			for (watched const &r : ranges)
+				if (r.start <= seg.start && r.end >= seg.end)
+				{
+					m_hits[side].emplace_back(r.target);
+					seg.count++;
+				}
+			if (seg.count)
+				m_segments[side].emplace_back(seg);
+		}
+	}
+
+	m_generation++;
+	install(read_or_write::READWRITE);
+}
+
+
+//-------------------------------------------------
+//  install - (re)install the taps over the
+//  watched segments
+//-------------------------------------------------
+
+void debug_watchpoint_taps::install(read_or_write mode)
+{
+	if (m_installing)
+		return;
+	m_installing = true;
+	if (u32(mode) & u32(read_or_write::READ))
+		m_phr.remove();
+	if (u32(mode) & u32(read_or_write::WRITE))
+		m_phw.remove();
+	switch (m_space.data_width())
+	{
+	case  8: install_taps<u8>(mode);  break;
+	case 16: install_taps<u16>(mode); break;
+	case 32: install_taps<u32>(mode); break;
+	case 64: install_taps<u64>(mode); break;
+	}
+	m_installing = false;
+}
+
+template <typename T>
+void debug_watchpoint_taps::install_taps(read_or_write mode)
+{
+	for (int side = 0; side < 2; side++)
+	{
+		if (!(u32(mode) & u32(side ? read_or_write::WRITE : read_or_write::READ)))
+			continue;
+
+		// adjacent segments share one tap, the lookup sorts them out
+		std::vector<segment> const &segments = m_segments[side];
+		for (std::size_t i = 0; i < segments.size(); )
+		{
+			offs_t const start = segments[i].start;
+			offs_t end = segments[i].end;
+			for (i++; (i < segments.size()) && (segments[i].start == end + 1); i++)
+				end = segments[i].end;
+
+			if (side)
+				m_phw = m_space.install_write_tap(
+						start, end, "watchpoints",
+						[this] (offs_t offset, T &data, T mem_mask) { check<T>(1, offset, data, mem_mask); },
+						&m_phw);
+			else
+				m_phr = m_space.install_read_tap(
+						start, end, "watchpoints",
+						[this] (offs_t offset, T &data, T mem_mask) { check<T>(0, offset, data, mem_mask); },
+						&m_phr);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  check - trigger the watchpoints covering an
+//  access
+//-------------------------------------------------
+
+template <typename T>
+void debug_watchpoint_taps::check(int side, offs_t offset, T data, T mem_mask)
+{
+	std::vector<segment> const &segments = m_segments[side];
+	auto const found = std::upper_bound(
+			segments.begin(),
+			segments.end(),
+			offset,
+			[] (offs_t addr, segment const &s) { return addr < s.start; });
+	if ((found == segments.begin()) || (std::prev(found)->end < offset))
+		return;
+
+	segment const &seg = *std::prev(found);
+	u32 const generation = m_generation;
+	for (u32 i = 0; i < seg.count; i++)
+	{
+		hit const &h = m_hits[side][seg.first + i];
+		if ((sizeof(T) == 1) || (mem_mask & h.mask))
+		{
+			h.wp->triggered(side ? read_or_write::WRITE : read_or_write::READ, offset, data, mem_mask);
+
+			// an action may have changed the watchpoints
+			if (m_generation != generation)
+				break;
+		}
+	}
+}
+
 //**************************************************************************
 //  DEBUG REGISTERPOINT
 //**************************************************************************
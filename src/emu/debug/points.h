@@ -65,6 +65,7 @@ private:
 class debug_watchpoint
 {
 	friend class device_debug;
+	friend class debug_watchpoint_taps;
 
 public:
 	// construction/destruction
@@ -78,7 +79,6 @@ public:
 					offs_t length,
 					const char *condition = nullptr,
 					std::string_view action = {});
-	~debug_watchpoint();
 
 	// getters
 	const device_debug *debugInterface() const { return m_debugInterface; }
@@ -98,12 +98,9 @@ public:
 	bool hit(int type, offs_t address, int size);
 
 private:
-	void install(read_or_write mode);
 	void triggered(read_or_write type, offs_t address, u64 data, u64 mem_mask);
 
 	device_debug * m_debugInterface;                 // the interface we were created from
-	memory_passthrough_handler m_phr;                // passthrough handler reference, read access
-	memory_passthrough_handler m_phw;                // passthrough handler reference, write access
 	address_space &      m_space;                    // address space
 	int                  m_index;                    // user reported index
 	bool                 m_enabled;                  // enabled?
@@ -112,12 +109,56 @@ private:
 	offs_t               m_length;                   // length of watch area
 	parsed_expression    m_condition;                // condition
 	std::string          m_action;                   // action
-	util::notifier_subscription m_notifier;          // address map change notifier ID
 
 	offs_t               m_start_address[3];         // the start addresses of the checks to install
 	offs_t               m_end_address[3];           // the end addresses
 	u64                  m_masks[3];                 // the access masks
-	bool                 m_installing;               // prevent recursive multiple installs
+};
+
+// ======================> debug_watchpoint_taps
+
+// all watchpoints of one address space share a single pair of taps
+// that only cover the watched ranges, and find the watchpoints hit
+// by an access in a table of disjoint address segments
+
+class debug_watchpoint_taps
+{
+public:
+	// construction/destruction
+	debug_watchpoint_taps(address_space &space);
+	~debug_watchpoint_taps();
+
+	// rebuild the segment tables from a watchpoint list and reinstall
+	void update(const std::vector<std::unique_ptr<debug_watchpoint>> &wplist);
+
+	// reinstall after an address map change
+	void install(read_or_write mode);
+
+private:
+	struct hit
+	{
+		debug_watchpoint *  wp;                      // watchpoint to check
+		u64                 mask;                    // the access mask
+	};
+
+	struct segment
+	{
+		offs_t              start;                   // first address
+		offs_t              end;                     // last address
+		u32                 first;                   // first entry in the hit table
+		u32                 count;                   // number of entries in the hit table
+	};
+
+	template <typename T> void install_taps(read_or_write mode);
+	template <typename T> void check(int side, offs_t offset, T data, T mem_mask);
+
+	address_space &         m_space;                 // address space
+	memory_passthrough_handler m_phr;                // passthrough handler reference, read access
+	memory_passthrough_handler m_phw;                // passthrough handler reference, write access
+	std::vector<segment>    m_segments[2];           // sorted disjoint segments, read and write
+	std::vector<hit>        m_hits[2];               // watchpoints for each segment, read and write
+	u32                     m_generation;            // bumped whenever the tables are rebuilt
+	bool                    m_installing;            // prevent recursive multiple installs
 };
 
 // ======================> debug_registerpoint
@@ -15,13 +15,18 @@
 #include "debug/debugcmd.h"
 #include "debug/debugcon.h"
 #include "debug/debugvw.h"
+#include <algorithm>
 #include <cctype>
+#include <mutex>
+#include <vector>
 
 /***************************************************************************
     GLOBAL VARIABLES
 ***************************************************************************/
 
-static running_machine *g_machine = nullptr;
+// several machines may be running on separate threads
+static std::mutex g_machines_mutex;
+static std::vector<running_machine *> g_machines;
 static bool g_atexit_registered = false;
 
 
@@ -66,12 +71,14 @@ debugger_manager::debugger_manager(running_machine &machine)
 	m_console = std::make_unique<debugger_console>(machine);
 	m_commands = std::make_unique<debugger_commands>(machine, cpu(), console());
 
-	g_machine = &machine;
-
 	/* register an atexit handler if we haven't yet */
-	if (!g_atexit_registered)
-		atexit(debugger_flush_all_traces_on_abnormal_exit);
-	g_atexit_registered = true;
+	{
+		std::lock_guard<std::mutex> lock(g_machines_mutex);
+		g_machines.push_back(&machine);
+		if (!g_atexit_registered)
+			atexit(debugger_flush_all_traces_on_abnormal_exit);
+		g_atexit_registered = true;
+	}
 
 	/* initialize osd debugger features */
 	machine.osd().init_debugger();
@@ -83,7 +90,8 @@ debugger_manager::debugger_manager(running_machine &machine)
 
 debugger_manager::~debugger_manager()
 {
-	g_machine = nullptr;
+	std::lock_guard<std::mutex> lock(g_machines_mutex);
+	g_machines.erase(std::remove(g_machines.begin(), g_machines.end(), &m_machine), g_machines.end());
 }
 
 /*-------------------------------------------------
@@ -105,8 +113,7 @@ void debugger_manager::refresh_display()
 
 void debugger_flush_all_traces_on_abnormal_exit()
 {
-	if(g_machine != nullptr)
-	{
-		g_machine->debugger().cpu().flush_traces();
-	}
+	std::lock_guard<std::mutex> lock(g_machines_mutex);
+	for (running_machine *machine : g_machines)
+		machine->debugger().cpu().flush_traces();
 }
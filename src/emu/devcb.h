@@ -330,6 +330,14 @@ class devcb_read : public devcb_read_base
 private:
 	using func_t = std::function<Result (offs_t, std::make_unsigned_t<Result>)>;
 
+	// a single delegate of this type with no transform is called directly
+	using direct_delegate = std::conditional_t<
+			(DefaultMask == 1U) && std::is_same_v<Result, int>,
+			read_line_delegate,
+			device_delegate<Result (offs_t, std::make_unsigned_t<Result>)> >;
+
+	template <typename Delegate> class delegate_builder; // workaround for MSVC
+
 	class creator
 	{
 	public:
@@ -338,6 +346,7 @@ private:
 		virtual ~creator() { }
 		virtual void validity_check(validity_checker &valid) const = 0;
 		virtual func_t create() = 0;
+		virtual bool create_direct(direct_delegate &result) { return false; }
 
 		std::make_unsigned_t<Result> mask() const { return m_mask; }
 
@@ -362,6 +371,14 @@ private:
 			return result;
 		}
 
+		virtual bool create_direct(direct_delegate &result) override
+		{
+			if constexpr (std::is_same_v<T, delegate_builder<direct_delegate> >)
+				return m_builder.build_direct(result);
+			else
+				return false;
+		}
+
 	private:
 		T m_builder;
 	};
@@ -613,6 +630,24 @@ private:
 					{ return (devcb_read::invoke_read<Result>(cb, offset, mem_mask & mask) ^ exor) & mask; });
 		}
 
+		bool build_direct(direct_delegate &result)
+		{
+			assert(this->m_consumed);
+			if constexpr (std::is_same_v<Delegate, direct_delegate>)
+			{
+				if (this->need_exor() || (DefaultMask != this->mask()))
+					return false;
+				this->built();
+				m_delegate.resolve();
+				result = m_delegate;
+				return true;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
 	private:
 		delegate_builder(delegate_builder const &) = delete;
 		delegate_builder &operator=(delegate_builder const &) = delete;
@@ -814,7 +849,9 @@ private:
 		bool m_used = false;
 	};
 
-	std::vector<func_t> m_functions;
+	direct_delegate m_delegate;
+	func_t m_function;
+	bool m_direct = false;
 	std::vector<typename creator::ptr> m_creators;
 
 public:
@@ -844,13 +881,14 @@ public:
 	Result operator()(offs_t offset, std::make_unsigned_t<Result> mem_mask = DefaultMask);
 	Result operator()();
 
-	bool isnull() const { return m_functions.empty() && m_creators.empty(); }
-	explicit operator bool() const { return !m_functions.empty(); }
+	bool isnull() const { return !m_direct && !m_function && m_creators.empty(); }
+	explicit operator bool() const { return m_direct || m_function; }
 };
 
 template <typename Result, std::make_unsigned_t<Result> DefaultMask>
 devcb_read<Result, DefaultMask>::devcb_read(device_t &owner)
 	: devcb_read_base(owner)
+	, m_delegate(owner)
 {
 }
 
@@ -863,14 +901,14 @@ typename devcb_read<Result, DefaultMask>::binder devcb_read<Result, DefaultMask>
 template <typename Result, std::make_unsigned_t<Result> DefaultMask>
 void devcb_read<Result, DefaultMask>::reset()
 {
-	assert(m_functions.empty());
+	assert(!*this);
 	m_creators.clear();
 }
 
 template <typename Result, std::make_unsigned_t<Result> DefaultMask>
 void devcb_read<Result, DefaultMask>::validity_check(validity_checker &valid) const
 {
-	assert(m_functions.empty());
+	assert(!*this);
 	for (typename std::vector<typename creator::ptr>::const_iterator i = m_creators.begin(); m_creators.end() != i; ++i)
 	{
 		(*i)->validity_check(valid);
@@ -887,10 +925,30 @@ void devcb_read<Result, DefaultMask>::validity_check(validity_checker &valid) co
 template <typename Result, std::make_unsigned_t<Result> DefaultMask>
 void devcb_read<Result, DefaultMask>::resolve()
 {
-	assert(m_functions.empty());
-	m_functions.reserve(m_creators.size());
-	for (typename creator::ptr const &c : m_creators)
-		m_functions.emplace_back(c->create());
+	assert(!*this);
+	if (1U == m_creators.size())
+	{
+		// a lone delegate is called directly, anything else gets one function
+		m_direct = m_creators.front()->create_direct(m_delegate);
+		if (!m_direct)
+			m_function = m_creators.front()->create();
+	}
+	else if (!m_creators.empty())
+	{
+		std::vector<func_t> functions;
+		functions.reserve(m_creators.size());
+		for (typename creator::ptr const &c : m_creators)
+			functions.emplace_back(c->create());
+		m_function =
+				[functions = std::move(functions)] (offs_t offset, std::make_unsigned_t<Result> mem_mask)
+				{
+					auto it(functions.begin());
+					std::make_unsigned_t<Result> result((*it)(offset, mem_mask));
+					while (functions.end() != ++it)
+						result |= (*it)(offset, mem_mask);
+					return Result(result);
+				};
+	}
 	m_creators.clear();
 }
 
@@ -898,23 +956,22 @@ template <typename Result, std::make_unsigned_t<Result> DefaultMask>
 void devcb_read<Result, DefaultMask>::resolve_safe(Result dflt)
 {
 	resolve();
-	if (m_functions.empty())
-		m_functions.emplace_back([dflt] (offs_t offset, std::make_unsigned_t<Result> mem_mask) { return dflt; });
+	if (!*this)
+		m_function = [dflt] (offs_t offset, std::make_unsigned_t<Result> mem_mask) { return dflt; };
 }
 
 template <typename Result, std::make_unsigned_t<Result> DefaultMask>
-Result devcb_read<Result, DefaultMask>::operator()(offs_t offset, std::make_unsigned_t<Result> mem_mask)
+inline Result devcb_read<Result, DefaultMask>::operator()(offs_t offset, std::make_unsigned_t<Result> mem_mask)
 {
-	assert(m_creators.empty() && !m_functions.empty());
-	typename std::vector<func_t>::const_iterator it(m_functions.begin());
-	std::make_unsigned_t<Result> result((*it)(offset, mem_mask));
-	while (m_functions.end() != ++it)
-		result |= (*it)(offset, mem_mask);
-	return result;
+	assert(m_creators.empty() && *this);
+	if (m_direct)
+		return devcb_read::invoke_read<Result>(m_delegate, offset, mem_mask & DefaultMask) & DefaultMask;
+	else
+		return m_function(offset, mem_mask);
 }
 
 template <typename Result, std::make_unsigned_t<Result> DefaultMask>
-Result devcb_read<Result, DefaultMask>::operator()()
+inline Result devcb_read<Result, DefaultMask>::operator()()
 {
 	return this->operator()(0U, DefaultMask);
 }
@@ -931,6 +988,14 @@ class devcb_write : public devcb_write_base
 private:
 	using func_t = std::function<void (offs_t, Input, std::make_unsigned_t<Input>)>;
 
+	// a single delegate of this type with no transform is called directly
+	using direct_delegate = std::conditional_t<
+			(DefaultMask == 1U) && std::is_same_v<Input, int>,
+			write_line_delegate,
+			device_delegate<void (offs_t, Input, std::make_unsigned_t<Input>)> >;
+
+	template <typename Delegate> class delegate_builder; // workaround for MSVC
+
 	class creator
 	{
 	public:
@@ -939,6 +1004,7 @@ private:
 		virtual ~creator() { }
 		virtual void validity_check(validity_checker &valid) const = 0;
 		virtual func_t create() = 0;
+		virtual bool create_direct(direct_delegate &result) { return false; }
 	};
 
 	template <typename T>
@@ -954,6 +1020,14 @@ private:
 			return [cb = m_builder.build()] (offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask) { cb(offset, data, mem_mask); };
 		}
 
+		virtual bool create_direct(direct_delegate &result) override
+		{
+			if constexpr (std::is_same_v<T, delegate_builder<direct_delegate> >)
+				return m_builder.build_direct(result);
+			else
+				return false;
+		}
+
 	private:
 		T m_builder;
 	};
@@ -1354,6 +1428,24 @@ private:
 					[cb = std::move(m_delegate), exor = this->exor(), mask = this->mask()] (offs_t offset, input_t data, std::make_unsigned_t<input_t> mem_mask)
 					{ devcb_write::invoke_write<Input>(cb, offset, (data ^ exor) & mask, mem_mask & mask); };
 		}
+
+		bool build_direct(direct_delegate &result)
+		{
+			assert(this->m_consumed);
+			if constexpr (std::is_same_v<Delegate, direct_delegate>)
+			{
+				if (this->need_exor() || (DefaultMask != this->mask()))
+					return false;
+				this->built();
+				m_delegate.resolve();
+				result = m_delegate;
+				return true;
+			}
+			else
+			{
+				return false;
+			}
+		}
 	};
 
 	class inputline_builder : public builder_base, public transform_base<mask_t<Input, int>, inputline_builder>
@@ -2283,7 +2375,9 @@ private:
 		bool m_used = false;
 	};
 
-	std::vector<func_t> m_functions;
+	direct_delegate m_delegate;
+	func_t m_function;
+	bool m_direct = false;
 	std::vector<typename creator::ptr> m_creators;
 
 public:
@@ -2313,13 +2407,14 @@ public:
 	void operator()(offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask = DefaultMask);
 	void operator()(Input data);
 
-	bool isnull() const { return m_functions.empty() && m_creators.empty(); }
-	explicit operator bool() const { return !m_functions.empty(); }
+	bool isnull() const { return !m_direct && !m_function && m_creators.empty(); }
+	explicit operator bool() const { return m_direct || m_function; }
 };
 
 template <typename Input, std::make_unsigned_t<Input> DefaultMask>
 devcb_write<Input, DefaultMask>::devcb_write(device_t &owner)
 	: devcb_write_base(owner)
+	, m_delegate(owner)
 {
 }
 
@@ -2332,14 +2427,14 @@ typename devcb_write<Input, DefaultMask>::binder devcb_write<Input, DefaultMask>
 template <typename Input, std::make_unsigned_t<Input> DefaultMask>
 void devcb_write<Input, DefaultMask>::reset()
 {
-	assert(m_functions.empty());
+	assert(!*this);
 	m_creators.clear();
 }
 
 template <typename Input, std::make_unsigned_t<Input> DefaultMask>
 void devcb_write<Input, DefaultMask>::validity_check(validity_checker &valid) const
 {
-	assert(m_functions.empty());
+	assert(!*this);
 	for (typename creator::ptr const &c : m_creators)
 		c->validity_check(valid);
 }
@@ -2347,10 +2442,27 @@ void devcb_write<Input, DefaultMask>::validity_check(validity_checker &valid) co
 template <typename Input, std::make_unsigned_t<Input> DefaultMask>
 void devcb_write<Input, DefaultMask>::resolve()
 {
-	assert(m_functions.empty());
-	m_functions.reserve(m_creators.size());
-	for (typename creator::ptr const &c : m_creators)
-		m_functions.emplace_back(c->create());
+	assert(!*this);
+	if (1U == m_creators.size())
+	{
+		// a lone delegate is called directly, anything else gets one function
+		m_direct = m_creators.front()->create_direct(m_delegate);
+		if (!m_direct)
+			m_function = m_creators.front()->create();
+	}
+	else if (!m_creators.empty())
+	{
+		std::vector<func_t> functions;
+		functions.reserve(m_creators.size());
+		for (typename creator::ptr const &c : m_creators)
+			functions.emplace_back(c->create());
+		m_function =
+				[functions = std::move(functions)] (offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask)
+				{
+					for (func_t const &f : functions)
+						f(offset, data, mem_mask);
+				};
+	}
 	m_creators.clear();
 }
 
@@ -2358,22 +2470,22 @@ template <typename Input, std::make_unsigned_t<Input> DefaultMask>
 void devcb_write<Input, DefaultMask>::resolve_safe()
 {
 	resolve();
-	if (m_functions.empty())
-		m_functions.emplace_back([] (offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask) { });
+	if (!*this)
+		m_function = [] (offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask) { };
 }
 
 template <typename Input, std::make_unsigned_t<Input> DefaultMask>
-void devcb_write<Input, DefaultMask>::operator()(offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask)
+inline void devcb_write<Input, DefaultMask>::operator()(offs_t offset, Input data, std::make_unsigned_t<Input> mem_mask)
 {
-	assert(m_creators.empty() && !m_functions.empty());
-	typename std::vector<func_t>::const_iterator it(m_functions.begin());
-	(*it)(offset, data, mem_mask);
-	while (m_functions.end() != ++it)
-		(*it)(offset, data, mem_mask);
+	assert(m_creators.empty() && *this);
+	if (m_direct)
+		devcb_write::invoke_write<Input>(m_delegate, offset, data & DefaultMask, mem_mask & DefaultMask);
+	else
+		m_function(offset, data, mem_mask);
 }
 
 template <typename Input, std::make_unsigned_t<Input> DefaultMask>
-void devcb_write<Input, DefaultMask>::operator()(Input data)
+inline void devcb_write<Input, DefaultMask>::operator()(Input data)
 {
 	this->operator()(0U, data, DefaultMask);
 }
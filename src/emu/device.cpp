@@ -344,15 +344,21 @@ void device_t::reset()
 	for (device_interface &intf : interfaces())
 		intf.interface_pre_reset();
 
-	// reset the device
+	// reset the device, timing it if we're profiling startup
+	startup_profiler &profile(machine().manager().startup_profile());
+	osd_ticks_t const start(profile.active() ? osd_ticks() : 0);
 	device_reset();
+	osd_ticks_t const elapsed(profile.active() ? (osd_ticks() - start) : 0);
 
 	// reset all child devices
 	for (device_t &child : subdevices())
 		child.reset();
 
 	// now allow for some post-child reset action
+	osd_ticks_t const after(profile.active() ? osd_ticks() : 0);
 	device_reset_after_children();
+	if (profile.active())
+		profile.device(*this, "reset", elapsed + (osd_ticks() - after));
 
 	// let the interfaces do their post-work
 	for (device_interface &intf : interfaces())
@@ -10,6 +10,7 @@
 
 #include "emu.h"
 #include "debugger.h"
+#include "emuopts.h"
 #include "screen.h"
 
 
@@ -46,6 +47,7 @@ device_execute_interface::device_execute_interface(const machine_config &mconfig
 	: device_interface(device, "execute")
 	, m_scheduler(nullptr)
 	, m_disabled(false)
+	, m_execution_domain(0)
 	, m_vblank_interrupt(device)
 	, m_vblank_interrupt_screen(nullptr)
 	, m_timed_interrupt(device)
@@ -64,11 +66,17 @@ device_execute_interface::device_execute_interface(const machine_config &mconfig
 	, m_trigger(0)
 	, m_inttrigger(0)
 	, m_totalcycles(0)
+	, m_host_ticks(0)
 	, m_divisor(0)
 	, m_divshift(0)
 	, m_cycles_per_second(0)
 	, m_attoseconds_per_cycle(0)
 	, m_spin_end_timer(nullptr)
+	, m_idle_detect(false)
+	, m_idle_pc(0)
+	, m_idle_signature(0)
+	, m_idle_count(0)
+	, m_idle_skips(0)
 {
 	memset(&m_localtime, 0, sizeof(m_localtime));
 
@@ -103,6 +111,8 @@ void device_execute_interface::abort_timeslice() noexcept
 	if (m_icountptr != nullptr)
 	{
 		int delta = *m_icountptr;
+		if (UNEXPECTED(m_scheduler->m_trace))
+			m_scheduler->trace(device_scheduler::trace_event::ABORT, m_profiler - PROFILER_DEVICE_FIRST, local_time(), u64(delta));
 		m_cycles_stolen += delta;
 		m_cycles_running -= delta;
 		*m_icountptr -= delta;
@@ -110,6 +120,35 @@ void device_execute_interface::abort_timeslice() noexcept
 }
 
 
+//-------------------------------------------------
+//  idle_loop_iteration - called on each short
+//  backward branch; once the same branch has been
+//  taken several times with no change in register
+//  state and no writes in between, the loop can
+//  only be left by an outside event, so skip to
+//  the end of the timeslice
+//-------------------------------------------------
+
+void device_execute_interface::idle_loop_iteration(offs_t pc, u64 signature) noexcept
+{
+	if ((pc != m_idle_pc) || (signature != m_idle_signature))
+	{
+		m_idle_pc = pc;
+		m_idle_signature = signature;
+		m_idle_count = 1;
+	}
+	else if (++m_idle_count >= IDLE_LOOP_ITERATIONS)
+	{
+		m_idle_count = 0;
+		if (executing() && (*m_icountptr > 0))
+		{
+			m_idle_skips++;
+			eat_cycles(*m_icountptr);
+		}
+	}
+}
+
+
 //-------------------------------------------------
 //  suspend_resume_changed
 //-------------------------------------------------
@@ -374,6 +413,9 @@ void device_execute_interface::interface_pre_start()
 {
 	m_scheduler = &device().machine().scheduler();
 
+	// idle loop detection changes timing, so it is opt-in and kept out of the debugger's way
+	m_idle_detect = device().machine().options().idle_detect() && !debugger_enabled();
+
 	// bind delegates
 	m_vblank_interrupt.resolve();
 	m_timed_interrupt.resolve();
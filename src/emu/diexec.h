@@ -103,6 +103,7 @@ public:
 
 	// configuration access
 	bool disabled() const { return m_disabled; }
+	int execution_domain() const { return m_execution_domain; }
 	u64 clocks_to_cycles(u64 clocks) const { return execute_clocks_to_cycles(clocks); }
 	u64 cycles_to_clocks(u64 cycles) const { return execute_cycles_to_clocks(cycles); }
 	u32 min_cycles() const { return execute_min_cycles(); }
@@ -116,6 +117,12 @@ public:
 	// inline configuration helpers
 	void set_disable() { m_disabled = true; }
 
+	// devices sharing a non-zero execution domain may run on a worker thread
+	// concurrently with other domains; only use this for devices that
+	// communicate with the rest of the system through latches or other
+	// synchronize()-based mechanisms
+	void set_execution_domain(int domain) { m_execution_domain = domain; }
+
 	template <typename... T> void set_vblank_int(const char *tag, T &&... args)
 	{
 		m_vblank_interrupt.set(std::forward<T>(args)...);
@@ -185,6 +192,7 @@ public:
 	// time and cycle accounting
 	attotime local_time() const noexcept;
 	u64 total_cycles() const noexcept;
+	osd_ticks_t host_ticks() const noexcept { return m_host_ticks; }
 
 	// required operation overrides
 	void run() { execute_run(); }
@@ -221,6 +229,18 @@ protected:
 	// for use by devcpu for now...
 	int current_input_state(unsigned i) const { return m_input[i].m_curstate; }
 	void set_icountptr(int &icount) { assert(!m_icountptr); m_icountptr = &icount; }
+
+	// idle loop detection; call on taken branches with a signature of the
+	// registers that a polling loop could change
+	template <typename T> void idle_loop_branch(offs_t pc, offs_t target, T &&signature)
+	{
+		if (UNEXPECTED(m_idle_detect) && (target <= pc) && ((pc - target) <= IDLE_LOOP_MAX_BYTES))
+			idle_loop_iteration(pc, signature());
+	}
+
+	// idle loop detection; call on memory and I/O writes, since a loop that
+	// stores anything isn't idle even when its registers repeat
+	void idle_loop_write() noexcept { m_idle_count = 0; }
 	IRQ_CALLBACK_MEMBER(standard_irq_callback_member);
 	int standard_irq_callback(int irqline);
 
@@ -272,6 +292,11 @@ private:
 		TIMER_CALLBACK_MEMBER(empty_event_queue);
 	};
 
+	// idle loop detection
+	static constexpr offs_t IDLE_LOOP_MAX_BYTES = 16;   // longest loop body considered
+	static constexpr u32 IDLE_LOOP_ITERATIONS = 4;      // identical iterations before skipping
+	void idle_loop_iteration(offs_t pc, u64 signature) noexcept;
+
 	// internal debugger hooks
 	void debugger_start_cpu_hook(const attotime &endtime)
 	{
@@ -289,6 +314,7 @@ private:
 
 	// configuration
 	bool                    m_disabled;                 // disabled from executing?
+	int                     m_execution_domain;         // execution domain (0 = main thread only)
 	device_interrupt_delegate m_vblank_interrupt;       // for interrupts tied to VBLANK
 	const char *            m_vblank_interrupt_screen;  // the screen that causes the VBLANK interrupt
 	device_interrupt_delegate m_timed_interrupt;        // for interrupts not tied to VBLANK
@@ -318,6 +344,7 @@ private:
 
 	// clock and timing information
 	u64                     m_totalcycles;              // total device cycles executed
+	osd_ticks_t             m_host_ticks;               // host time spent executing, while the scheduler measures it
 	attotime                m_localtime;                // local time, relative to the timer system's global time
 	s32                     m_divisor;                  // 32-bit attoseconds_per_cycle divisor
 	u8                      m_divshift;                 // right shift amount to fit the divisor into 32 bits
@@ -325,6 +352,13 @@ private:
 	attoseconds_t           m_attoseconds_per_cycle;    // attoseconds per adjusted clock cycle
 
 	emu_timer *             m_spin_end_timer;           // timer for triggering the end of spin_until_time
+
+	// idle loop detection
+	bool                    m_idle_detect;              // idle loop detection enabled
+	offs_t                  m_idle_pc;                  // address of the last backward branch
+	u64                     m_idle_signature;           // register signature at the last backward branch
+	u32                     m_idle_count;               // number of identical iterations seen
+	u64                     m_idle_skips;               // number of timeslices cut short
 	emu_timer *             m_pulse_end_timers[MAX_INPUT_LINES]; // timer for ending input-line pulses
 
 	// callbacks
@@ -340,6 +374,7 @@ private:
 
 public:
 	attotime minimum_quantum_time() const { return attotime(0, minimum_quantum()); }
+	u64 idle_skips() const { return m_idle_skips; }
 };
 
 // iterator
@@ -11,6 +11,12 @@
 #include "emu.h"
 #include "validity.h"
 
+#include "romload.h"
+
+#include "hashing.h"
+
+#include "../osd/modules/lib/osdlib.h"
+
 
 //**************************************************************************
 //  DEVICE GFX INTERFACE
@@ -270,6 +276,64 @@ void device_gfx_interface::decode_gfx(const gfx_decode_entry *gfxdecodeinfo)
 }
 
 
+//-------------------------------------------------
+//  predecode_gfx - decode every element now
+//  rather than as it's first drawn, sharing the
+//  results for ROM graphics through the derived
+//  data cache
+//-------------------------------------------------
+
+void device_gfx_interface::predecode_gfx()
+{
+	for (u8 curgfx = 0; curgfx < MAX_GFX_ELEMENTS; curgfx++)
+	{
+		gfx_element *const gfx = m_gfx[curgfx].get();
+		if (!gfx || gfx->is_raw() || !gfx->elements())
+			continue;
+
+		// only graphics still decoding from the ROM region they were configured with can be cached
+		memory_region *region = nullptr;
+		u32 start = 0;
+		u8 entries = 0;
+		while (m_gfxdecodeinfo && (entries < MAX_GFX_ELEMENTS) && m_gfxdecodeinfo[entries].gfxlayout != nullptr)
+			entries++;
+		if (curgfx < entries)
+		{
+			const gfx_decode_entry &info = m_gfxdecodeinfo[curgfx];
+			if (info.memory_region && !GFXENTRY_ISRAM(info.flags))
+			{
+				device_t &basedevice = GFXENTRY_ISDEVICE(info.flags) ? device() : *device().owner();
+				region = basedevice.memregion(info.memory_region);
+				start = info.start;
+			}
+		}
+		if (region && ((start >= region->bytes()) || (gfx->source() != (region->base() + start))))
+			region = nullptr;
+
+		auto const decode = [gfx] (u32 begin, u32 end) { gfx->decode_range(begin, end); };
+		if (region)
+		{
+			// drivers often rearrange or decrypt graphics ROMs after loading, so key on what's there now
+			util::sha1_creator sha1;
+			sha1.append(region->base() + start, region->bytes() - start);
+			util::sha1_t const digest = sha1.finish();
+			std::vector<u32> params = gfx->layout_signature();
+			size_t const signature = params.size();
+			params.resize(signature + (sizeof(digest.m_raw) / sizeof(u32)));
+			memcpy(&params[signature], digest.m_raw, sizeof(digest.m_raw));
+
+			auto mapping = device().machine().rom_load().map_derived("gfxdecode", 1, { }, &params[0], params.size() * sizeof(params[0]), gfx->decoded_data(), gfx->decoded_bytes(), gfx->elements(), decode);
+			if (mapping)
+				gfx->set_decoded(std::move(mapping));
+		}
+		else
+		{
+			rom_load_manager::compute_derived(gfx->elements(), decode);
+		}
+	}
+}
+
+
 //-------------------------------------------------
 //  interface_validity_check - validate graphics
 //  decoding configuration
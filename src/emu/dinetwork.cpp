@@ -101,6 +101,13 @@ TIMER_CALLBACK_MEMBER(device_network_interface::recv_complete)
 		m_dev->start();
 }
 
+TIMER_CALLBACK_MEMBER(device_network_interface::netdev_receive_ready)
+{
+	// posted by the netdev's receive thread
+	if (m_dev)
+		m_dev->receive_ready();
+}
+
 void device_network_interface::set_promisc(bool promisc)
 {
 	m_promisc = promisc;
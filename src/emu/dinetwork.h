@@ -7,6 +7,8 @@ class osd_netdev;
 
 class device_network_interface : public device_interface
 {
+	friend class osd_netdev;
+
 public:
 	device_network_interface(const machine_config &mconfig, device_t &device, u32 bandwidth, u32 mtu = 1500);
 	virtual ~device_network_interface();
@@ -36,6 +38,7 @@ public:
 protected:
 	TIMER_CALLBACK_MEMBER(send_complete);
 	TIMER_CALLBACK_MEMBER(recv_complete);
+	TIMER_CALLBACK_MEMBER(netdev_receive_ready);
 
 	bool m_promisc;
 	char m_mac[6];
@@ -38,6 +38,8 @@ device_serial_interface::device_serial_interface(const machine_config &mconfig,
 	m_tra_bit_count(0),
 	m_rcv_clock(nullptr),
 	m_tra_clock(nullptr),
+	m_tra_frame(nullptr),
+	m_byte_peer(nullptr),
 	m_rcv_rate(attotime::never),
 	m_tra_rate(attotime::never),
 	m_rcv_line(0),
@@ -71,6 +73,8 @@ void device_serial_interface::interface_pre_start()
 		m_rcv_clock = device().machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(device_serial_interface::rcv_clock), this));
 	if (!m_tra_clock)
 		m_tra_clock = device().machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(device_serial_interface::tra_clock), this));
+	if (!m_tra_frame)
+		m_tra_frame = device().machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(device_serial_interface::tra_frame), this));
 	m_rcv_clock_state = false;
 	m_tra_clock_state = false;
 }
@@ -111,6 +115,7 @@ void device_serial_interface::set_tra_rate(const attotime &rate)
 	m_tra_rate = rate/2;
 	transmit_register_reset();
 	m_tra_clock->adjust(attotime::never);
+	m_tra_frame->adjust(attotime::never);
 }
 
 void device_serial_interface::tra_edge()
@@ -369,9 +374,6 @@ void device_serial_interface::transmit_register_setup(u8 data_byte)
 	int i;
 	u8 transmit_data;
 
-	if(m_tra_clock && !m_tra_rate.is_never())
-		m_tra_clock->adjust(m_tra_rate, 0, m_tra_rate);
-
 	m_tra_bit_count_transmitted = 0;
 	m_tra_bit_count = 0;
 	m_tra_flags &=~TRANSMIT_REGISTER_EMPTY;
@@ -397,35 +399,87 @@ void device_serial_interface::transmit_register_setup(u8 data_byte)
 
 	/* parity */
 	if (m_df_parity!=PARITY_NONE)
-	{
-		/* odd or even parity */
-		u8 parity = 0;
-		switch (m_df_parity)
-		{
-		case PARITY_ODD:
-
-			/* get parity */
-			/* if parity = 0, data has even parity - i.e. there is an even number of one bits in the data */
-			/* if parity = 1, data has odd parity - i.e. there is an odd number of one bits in the data */
-			parity = serial_helper_get_parity(data_byte) ^ 1;
-			break;
-		case PARITY_EVEN:
-			parity = serial_helper_get_parity(data_byte);
-			break;
-		case PARITY_MARK:
-			parity = 1;
-			break;
-		case PARITY_SPACE:
-			parity = 0;
-			break;
-		}
-		transmit_register_add_bit(parity);
-	}
+		transmit_register_add_bit(parity_bit(data_byte));
 
 	/* stop bit(s) + 1 extra bit as delay between bytes, needed to get 1 stop bit to work.  */
 	if (m_df_stop_bit_count)  // no stop bits for synchronous
 		for (i=0; i<=m_df_stop_bit_count; i++)   // ToDo - see if the hack on this line is still needed (was added 2016-04-10)
 			transmit_register_add_bit(1);
+
+	/* a listening byte-oriented peer gets the whole frame in one event once it would have been sent */
+	if (byte_peer_ready())
+		m_tra_frame->adjust(m_tra_rate * (2 * m_tra_bit_count), data_byte);
+	else if(m_tra_clock && !m_tra_rate.is_never())
+		m_tra_clock->adjust(m_tra_rate, 0, m_tra_rate);
+}
+
+
+/* get the parity bit for a byte in the current data frame format */
+u8 device_serial_interface::parity_bit(u8 data_byte) const
+{
+	switch (m_df_parity)
+	{
+	case PARITY_ODD:
+		/* if parity = 0, data has even parity - i.e. there is an even number of one bits in the data */
+		/* if parity = 1, data has odd parity - i.e. there is an odd number of one bits in the data */
+		return m_serial_parity_table[data_byte] ^ 1;
+	case PARITY_EVEN:
+		return m_serial_parity_table[data_byte];
+	case PARITY_MARK:
+		return 1;
+	case PARITY_SPACE:
+	default:
+		return 0;
+	}
+}
+
+
+/* can the next frame go straight to the peer's receiver? */
+bool device_serial_interface::byte_peer_ready() const
+{
+	device_serial_interface const *const peer(m_byte_peer);
+	return peer &&
+			m_df_start_bit_count && m_df_stop_bit_count && !m_tra_rate.is_never() &&
+			(peer->m_rcv_rate == m_tra_rate) &&
+			(peer->m_df_start_bit_count == m_df_start_bit_count) &&
+			(peer->m_df_word_length == m_df_word_length) &&
+			(peer->m_df_parity == m_df_parity) &&
+			(peer->m_df_stop_bit_count == m_df_stop_bit_count) &&
+			(peer->m_rcv_flags & RECEIVE_REGISTER_WAITING_FOR_START_BIT);
+}
+
+
+/* the frame has been on the line for as long as it would take to send */
+TIMER_CALLBACK_MEMBER(device_serial_interface::tra_frame)
+{
+	LOGMASKED(LOG_TX, "Transmitted frame 0x%02x to peer\n", param);
+	m_byte_peer->receive_frame(u8(param));
+
+	m_tra_bit_count_transmitted = m_tra_bit_count;
+	m_tra_flags |= TRANSMIT_REGISTER_EMPTY;
+	tra_complete();
+}
+
+
+/* load the receive register as if the data, parity and stop bits had been shifted in */
+void device_serial_interface::receive_frame(u8 data_byte)
+{
+	LOGMASKED(LOG_RX, "Received frame 0x%02x from peer\n", data_byte);
+
+	u32 frame = data_byte & ~(~0U << m_df_word_length);
+	unsigned bits = m_df_word_length;
+	if (m_df_parity != PARITY_NONE)
+		frame |= u32(parity_bit(data_byte)) << bits++;
+	frame |= ~(~0U << m_df_stop_bit_count) << bits;
+
+	assert(m_rcv_bit_count > 0 && m_rcv_bit_count <= 16);
+	m_rcv_register_data = u16(frame << (16 - m_rcv_bit_count));
+	m_rcv_bit_count_received = 0;
+	m_rcv_framing_error = false;
+	m_rcv_parity_error = false;
+	m_rcv_flags &= ~RECEIVE_REGISTER_SYNCHRONISED;
+	m_rcv_flags |= RECEIVE_REGISTER_WAITING_FOR_START_BIT | RECEIVE_REGISTER_FULL;
+	rcv_complete();
 }
 
 
@@ -81,6 +81,10 @@ public:
 	DECLARE_WRITE_LINE_MEMBER(rx_clock_w);
 	DECLARE_WRITE_LINE_MEMBER(clock_w);
 
+	// deliver whole frames to a byte-oriented peer when both ends agree on
+	// the data format and rate, rather than clocking them through the lines
+	void set_byte_peer(device_serial_interface *peer) { m_byte_peer = peer; }
+
 protected:
 	void set_data_frame(int start_bit_count, int data_bit_count, parity_t parity, stop_bits_t stop_bits);
 
@@ -131,6 +135,7 @@ protected:
 private:
 	TIMER_CALLBACK_MEMBER(rcv_clock) { rx_clock_w(!m_rcv_clock_state); }
 	TIMER_CALLBACK_MEMBER(tra_clock) { tx_clock_w(!m_tra_clock_state); }
+	TIMER_CALLBACK_MEMBER(tra_frame);
 
 	u8 m_serial_parity_table[256];
 
@@ -171,6 +176,8 @@ private:
 
 	emu_timer *m_rcv_clock;
 	emu_timer *m_tra_clock;
+	emu_timer *m_tra_frame;
+	device_serial_interface *m_byte_peer;
 	attotime m_rcv_rate;
 	attotime m_tra_rate;
 	u8 m_rcv_line;
@@ -179,6 +186,10 @@ private:
 
 	void tra_edge();
 	void rcv_edge();
+
+	u8 parity_bit(u8 data_byte) const;
+	bool byte_peer_ready() const;
+	void receive_frame(u8 data_byte);
 };
 
 
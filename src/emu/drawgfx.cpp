@@ -11,6 +11,8 @@
 #include "emu.h"
 #include "drawgfxt.ipp"
 
+#include "../osd/modules/lib/osdlib.h"
+
 
 /***************************************************************************
     INLINE FUNCTIONS
@@ -95,6 +97,7 @@ gfx_element::gfx_element(device_palette_interface *palette, u8 *base, u16 width,
 		m_dirtyseq(1),
 		m_gfxdata(base),
 		m_layout_is_raw(true),
+		m_layout_is_packed(false),
 		m_layout_planes(0),
 		m_layout_xormask(0),
 		m_layout_charincrement(0)
@@ -120,6 +123,7 @@ gfx_element::gfx_element(device_palette_interface *palette, const gfx_layout &gl
 		m_dirtyseq(1),
 		m_gfxdata(nullptr),
 		m_layout_is_raw(false),
+		m_layout_is_packed(false),
 		m_layout_planes(0),
 		m_layout_xormask(xormask),
 		m_layout_charincrement(0)
@@ -129,6 +133,15 @@ gfx_element::gfx_element(device_palette_interface *palette, const gfx_layout &gl
 }
 
 
+//-------------------------------------------------
+//  ~gfx_element - destructor
+//-------------------------------------------------
+
+gfx_element::~gfx_element()
+{
+}
+
+
 //-------------------------------------------------
 //  set_layout - set the layout for a gfx_element
 //-------------------------------------------------
@@ -157,6 +170,8 @@ void gfx_element::set_layout(const gfx_layout &gl, const u8 *srcdata)
 		m_layout_xoffset.clear();
 		m_layout_yoffset.clear();
 		m_gfxdata_allocated.clear();
+		m_gfxdata_mapping.reset();
+		m_layout_is_packed = false;
 
 		// modulos are determined for us by the layout
 		m_line_modulo = gl.yoffs(0) / 8;
@@ -182,11 +197,21 @@ void gfx_element::set_layout(const gfx_layout &gl, const u8 *srcdata)
 		for (int x = 0; x < m_width; x++)
 			m_layout_xoffset[x] = gl.xoffs(x);
 
+		// when the planes of each pixel are adjacent bits in one byte, pixels can be extracted whole
+		m_layout_is_packed = (m_layout_planes != 0) && !(8 % m_layout_planes) && !(m_layout_charincrement % m_layout_planes) && !(m_layout_planeoffset[0] % m_layout_planes);
+		for (int p = 1; m_layout_is_packed && (p < m_layout_planes); p++)
+			m_layout_is_packed = m_layout_planeoffset[p] == (m_layout_planeoffset[0] + p);
+		for (int y = 0; m_layout_is_packed && (y < m_height); y++)
+			m_layout_is_packed = !(m_layout_yoffset[y] % m_layout_planes);
+		for (int x = 0; m_layout_is_packed && (x < m_width); x++)
+			m_layout_is_packed = !(m_layout_xoffset[x] % m_layout_planes);
+
 		// we get to pick our own modulos
 		m_line_modulo = m_origwidth;
 		m_char_modulo = m_line_modulo * m_origheight;
 
 		// allocate memory for the data
+		m_gfxdata_mapping.reset();
 		m_gfxdata_allocated.resize(m_total_elements * m_char_modulo);
 		m_gfxdata = &m_gfxdata_allocated[0];
 	}
@@ -258,6 +283,7 @@ void gfx_element::set_source_and_total(const u8 *source, u32 total)
 	else
 	{
 		// allocate memory for the data
+		m_gfxdata_mapping.reset();
 		m_gfxdata_allocated.resize(m_total_elements * m_char_modulo);
 		m_gfxdata = &m_gfxdata_allocated[0];
 	}
@@ -288,8 +314,31 @@ void gfx_element::set_source_clip(u32 xoffs, u32 width, u32 yoffs, u32 height)
 
 void gfx_element::decode(u32 code)
 {
+	// packed pixels can be extracted whole, as long as the XOR mask doesn't reorder bits within bytes
+	if (m_layout_is_packed && !(m_layout_xormask & 7))
+	{
+		u8 *decode_base = m_gfxdata + code * m_char_modulo;
+		unsigned const shift = 8 - m_layout_planes;
+		u8 const mask = make_bitmask<u8>(m_layout_planes);
+		unsigned const charoffs = code * m_layout_charincrement + m_layout_planeoffset[0];
+
+		// iterate over rows
+		for (int y = 0; y < m_origheight; y++)
+		{
+			unsigned const yoffs = charoffs + m_layout_yoffset[y];
+			u8 *dp = decode_base + y * m_line_modulo;
+
+			// iterate over columns
+			for (int x = 0; x < m_origwidth; x++)
+			{
+				unsigned const bitnum = (yoffs + m_layout_xoffset[x]) ^ m_layout_xormask;
+				dp[x] = (m_srcdata[bitnum / 8] >> (shift - (bitnum % 8))) & mask;
+			}
+		}
+	}
+
 	// don't decode GFX_RAW
-	if (!m_layout_is_raw)
+	else if (!m_layout_is_raw)
 	{
 		// zap the data to 0
 		u8 *decode_base = m_gfxdata + code * m_char_modulo;
@@ -318,6 +367,20 @@ void gfx_element::decode(u32 code)
 	}
 
 	// (re)compute pen usage
+	update_pen_usage(code);
+
+	// no longer dirty
+	m_dirty[code] = 0;
+}
+
+
+//-------------------------------------------------
+//  update_pen_usage - compute the pens used by a
+//  decoded character
+//-------------------------------------------------
+
+void gfx_element::update_pen_usage(u32 code)
+{
 	if (code < m_pen_usage.size())
 	{
 		// iterate over data, creating a bitmask of live pens
@@ -333,9 +396,56 @@ void gfx_element::decode(u32 code)
 		// store the final result
 		m_pen_usage[code] = usage;
 	}
+}
 
-	// no longer dirty
-	m_dirty[code] = 0;
+
+//-------------------------------------------------
+//  decode_range - decode a range of characters
+//  before they're used
+//-------------------------------------------------
+
+void gfx_element::decode_range(u32 start, u32 end)
+{
+	for (u32 code = start; (code < end) && (code < elements()); code++)
+		decode(code);
+}
+
+
+//-------------------------------------------------
+//  layout_signature - get everything besides the
+//  source data that determines decoded pixels
+//-------------------------------------------------
+
+std::vector<u32> gfx_element::layout_signature() const
+{
+	std::vector<u32> result{ m_origwidth, m_origheight, m_total_elements, m_layout_planes, m_layout_charincrement, m_layout_xormask };
+	result.insert(result.end(), m_layout_planeoffset.begin(), m_layout_planeoffset.end());
+	result.insert(result.end(), m_layout_xoffset.begin(), m_layout_xoffset.end());
+	result.insert(result.end(), m_layout_yoffset.begin(), m_layout_yoffset.end());
+	return result;
+}
+
+
+//-------------------------------------------------
+//  set_decoded - use a mapping of all characters
+//  in place of decoding them
+//-------------------------------------------------
+
+void gfx_element::set_decoded(std::unique_ptr<osd::file_mapping> &&mapping)
+{
+	assert(!m_layout_is_raw);
+	assert(mapping->size() == decoded_bytes());
+
+	m_gfxdata_mapping = std::move(mapping);
+	m_gfxdata = reinterpret_cast<u8 *>(m_gfxdata_mapping->get());
+	std::vector<u8>().swap(m_gfxdata_allocated);
+
+	// pen usage isn't part of the mapped data
+	for (u32 code = 0; code < elements(); code++)
+	{
+		update_pen_usage(code);
+		m_dirty[code] = 0;
+	}
 }
 
 
@@ -354,7 +464,7 @@ void gfx_element::opaque(bitmap_ind16 &dest, const rectangle &cliprect,
 {
 	color = colorbase() + granularity() * (color % colors());
 	code %= elements();
-	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, [color](u16 &destp, const u8 &srcp) { PIXEL_OP_REBASE_OPAQUE(destp, srcp); });
+	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, drawgfx_rebase_opaque_op{ color });
 }
 
 void gfx_element::opaque(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -395,7 +505,7 @@ void gfx_element::transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, [trans_pen, color](u16 &destp, const u8 &srcp) { PIXEL_OP_REBASE_TRANSPEN(destp, srcp); });
+	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, drawgfx_rebase_transpen_op{ trans_pen, color });
 }
 
 void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -422,7 +532,7 @@ void gfx_element::transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, [trans_pen, paldata](u32 &destp, const u8 &srcp) { PIXEL_OP_REMAP_TRANSPEN(destp, srcp); });
+	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, drawgfx_remap_transpen_op{ trans_pen, paldata });
 }
 
 
@@ -442,7 +552,7 @@ void gfx_element::transpen_raw(bitmap_ind16 &dest, const rectangle &cliprect,
 		return;
 
 	// render
-	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, [trans_pen, color](u16 &destp, const u8 &srcp) { PIXEL_OP_REBASE_TRANSPEN(destp, srcp); });
+	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, drawgfx_rebase_transpen_op{ trans_pen, color });
 }
 
 void gfx_element::transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -599,7 +709,7 @@ void gfx_element::zoom_opaque(bitmap_ind16 &dest, const rectangle &cliprect,
 	// render
 	color = colorbase() + granularity() * (color % colors());
 	code %= elements();
-	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, [color](u16 &destp, const u8 &srcp) { PIXEL_OP_REBASE_OPAQUE(destp, srcp); });
+	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_rebase_opaque_op{ color });
 }
 
 void gfx_element::zoom_opaque(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -650,7 +760,7 @@ void gfx_element::zoom_transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, [trans_pen, color](u16 &destp, const u8 &srcp) { PIXEL_OP_REBASE_TRANSPEN(destp, srcp); });
+	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_rebase_transpen_op{ trans_pen, color });
 }
 
 void gfx_element::zoom_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -681,7 +791,7 @@ void gfx_element::zoom_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, [trans_pen, paldata](u32 &destp, const u8 &srcp) { PIXEL_OP_REMAP_TRANSPEN(destp, srcp); });
+	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_remap_transpen_op{ trans_pen, paldata });
 }
 
 
@@ -705,7 +815,7 @@ void gfx_element::zoom_transpen_raw(bitmap_ind16 &dest, const rectangle &cliprec
 		return;
 
 	// render
-	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, [trans_pen, color](u16 &destp, const u8 &srcp) { PIXEL_OP_REBASE_TRANSPEN(destp, srcp); });
+	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, drawgfx_rebase_transpen_op{ trans_pen, color });
 }
 
 void gfx_element::zoom_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -936,7 +1046,7 @@ void gfx_element::prio_transpen(bitmap_ind16 &dest, const rectangle &cliprect,
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, priority, [pmask, trans_pen, color](u16 &destp, u8 &pri, const u8 &srcp) { PIXEL_OP_REBASE_TRANSPEN_PRIORITY(destp, pri, srcp); });
+	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, priority, drawgfx_rebase_transpen_priority_op{ pmask, trans_pen, color });
 }
 
 void gfx_element::prio_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -966,7 +1076,7 @@ void gfx_element::prio_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, priority, [pmask, trans_pen, paldata](u32 &destp, u8 &pri, const u8 &srcp) { PIXEL_OP_REMAP_TRANSPEN_PRIORITY(destp, pri, srcp); });
+	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, priority, drawgfx_remap_transpen_priority_op{ pmask, trans_pen, paldata });
 }
 
 
@@ -989,7 +1099,7 @@ void gfx_element::prio_transpen_raw(bitmap_ind16 &dest, const rectangle &cliprec
 	pmask |= 1 << 31;
 
 	// render
-	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, priority, [pmask, trans_pen, color](u16 &destp, u8 &pri, const u8 &srcp) { PIXEL_OP_REBASE_TRANSPEN_PRIORITY(destp, pri, srcp); });
+	drawgfx_core(dest, cliprect, code, flipx, flipy, destx, desty, priority, drawgfx_rebase_transpen_priority_op{ pmask, trans_pen, color });
 }
 
 void gfx_element::prio_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1229,7 +1339,7 @@ void gfx_element::prio_zoom_transpen(bitmap_ind16 &dest, const rectangle &clipre
 
 	// render
 	color = colorbase() + granularity() * (color % colors());
-	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, priority, [pmask, trans_pen, color](u16 &destp, u8 &pri, const u8 &srcp) { PIXEL_OP_REBASE_TRANSPEN_PRIORITY(destp, pri, srcp); });
+	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_rebase_transpen_priority_op{ pmask, trans_pen, color });
 }
 
 void gfx_element::prio_zoom_transpen(bitmap_rgb32 &dest, const rectangle &cliprect,
@@ -1264,7 +1374,7 @@ void gfx_element::prio_zoom_transpen(bitmap_rgb32 &dest, const rectangle &clipre
 
 	// render
 	const pen_t *paldata = m_palette->pens() + colorbase() + granularity() * (color % colors());
-	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, priority, [pmask, trans_pen, paldata](u32 &destp, u8 &pri, const u8 &srcp) { PIXEL_OP_REMAP_TRANSPEN_PRIORITY(destp, pri, srcp); });
+	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_remap_transpen_priority_op{ pmask, trans_pen, paldata });
 }
 
 
@@ -1293,7 +1403,7 @@ void gfx_element::prio_zoom_transpen_raw(bitmap_ind16 &dest, const rectangle &cl
 	pmask |= 1 << 31;
 
 	// render
-	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, priority, [pmask, trans_pen, color](u16 &destp, u8 &pri, const u8 &srcp) { PIXEL_OP_REBASE_TRANSPEN_PRIORITY(destp, pri, srcp); });
+	drawgfxzoom_core(dest, cliprect, code, flipx, flipy, destx, desty, scalex, scaley, priority, drawgfx_rebase_transpen_priority_op{ pmask, trans_pen, color });
 }
 
 void gfx_element::prio_zoom_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect,
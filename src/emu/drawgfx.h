@@ -145,6 +145,8 @@ enum
     TYPE DEFINITIONS
 ***************************************************************************/
 
+namespace osd { class file_mapping; }
+
 class gfx_element
 {
 public:
@@ -154,6 +156,7 @@ public:
 #endif
 	gfx_element(device_palette_interface *palette, const gfx_layout &gl, const u8 *srcdata, u32 xormask, u32 total_colors, u32 color_base);
 	gfx_element(device_palette_interface *palette, u8 *base, u16 width, u16 height, u32 rowbytes, u32 total_colors, u32 color_base, u32 color_granularity);
+	~gfx_element();
 
 	// getters
 	device_palette_interface &palette() const { return *m_palette; }
@@ -167,6 +170,8 @@ public:
 	u32 rowbytes() const { return m_line_modulo; }
 	bool has_pen_usage() const { return !m_pen_usage.empty(); }
 	bool has_palette() const { return m_palette; }
+	bool is_raw() const { return m_layout_is_raw; }
+	const u8 *source() const { return m_srcdata; }
 
 	// used by tilemaps
 	u32 dirtyseq() const { return m_dirtyseq; }
@@ -201,6 +206,17 @@ public:
 		return m_pen_usage[code];
 	}
 
+	// decode elements ahead of use; disjoint ranges can be decoded on different threads
+	void decode_range(u32 start, u32 end);
+
+	// everything apart from the source data that determines the decoded pixels
+	std::vector<u32> layout_signature() const;
+
+	// decoded pixel storage, which can be replaced with a mapping of data decoded earlier
+	u8 *decoded_data() { return m_gfxdata; }
+	size_t decoded_bytes() const { return size_t(m_total_elements) * m_char_modulo; }
+	void set_decoded(std::unique_ptr<osd::file_mapping> &&mapping);
+
 	// ----- core graphics drawing -----
 
 	// core drawgfx implementation
@@ -282,6 +298,7 @@ public:
 private:
 	// internal helpers
 	void decode(u32 code);
+	void update_pen_usage(u32 code);
 
 	// internal state
 	device_palette_interface *m_palette;    // palette used for drawing (optional when used as a pure decoder)
@@ -307,10 +324,12 @@ private:
 
 	u8 *            m_gfxdata;              // pointer to decoded pixel data, 8bpp
 	std::vector<u8> m_gfxdata_allocated;    // allocated decoded pixel data, 8bpp
+	std::unique_ptr<osd::file_mapping> m_gfxdata_mapping; // mapped decoded pixel data, 8bpp
 	std::vector<u8> m_dirty;                // dirty array for detecting chars that need decoding
 	std::vector<u32>  m_pen_usage;      // bitmask of pens that are used (pens 0-31 only)
 
 	bool            m_layout_is_raw;        // raw layout?
+	bool            m_layout_is_packed;     // planes adjacent and every pixel within a byte?
 	u8              m_layout_planes;        // bit planes in the layout
 	u32             m_layout_xormask;       // xor mask applied to each bit offset
 	u32             m_layout_charincrement; // per-character increment in source data
@@ -11,13 +11,17 @@
 #include "emu.h"
 #include "drivenum.h"
 
-#include "corestr.h"
+#include "emuopts.h"
 #include "softlist_dev.h"
+
+#include "corestr.h"
 #include "unicode.h"
 
 #include <algorithm>
+#include <numeric>
 
 #include <cctype>
+#include <cstring>
 
 
 
@@ -53,6 +57,21 @@ int driver_list::find(const char *name)
 }
 
 
+//-------------------------------------------------
+//  same_source - get the drivers defined in the
+//  same source file as the given driver
+//-------------------------------------------------
+
+std::pair<int const *, int const *> driver_list::same_source(std::size_t index)
+{
+	assert(index < s_driver_count);
+
+	index_tables const &tables(indexes());
+	std::pair<unsigned, unsigned> const &range(tables.source_range[index]);
+	return std::make_pair(tables.by_source.data() + range.first, tables.by_source.data() + range.second);
+}
+
+
 //-------------------------------------------------
 //  matches - true if we match, taking into
 //  account wildcards in the wildstring
@@ -69,6 +88,67 @@ bool driver_list::matches(const char *wildstring, const char *string)
 }
 
 
+//-------------------------------------------------
+//  index_tables - build lookup tables for
+//  parents, compatible systems and source files
+//-------------------------------------------------
+
+driver_list::index_tables::index_tables()
+	: parent(s_driver_count)
+	, compatible(s_driver_count)
+	, by_source(s_driver_count)
+	, source_range(s_driver_count)
+{
+	for (std::size_t index = 0; index < s_driver_count; index++)
+	{
+		parent[index] = find(s_drivers_sorted[index]->parent);
+		compatible[index] = find(s_drivers_sorted[index]->compatible_with);
+	}
+
+	// group drivers by source file, keeping each group in index order
+	auto const source_less = [] (int a, int b) { return std::strcmp(s_drivers_sorted[a]->type.source(), s_drivers_sorted[b]->type.source()) < 0; };
+	std::iota(by_source.begin(), by_source.end(), 0);
+	std::stable_sort(by_source.begin(), by_source.end(), source_less);
+	for (auto start = by_source.begin(); by_source.end() != start; )
+	{
+		auto const end = std::find_if(std::next(start), by_source.end(), [&source_less, start] (int index) { return source_less(*start, index); });
+		std::pair<unsigned, unsigned> const range(std::distance(by_source.begin(), start), std::distance(by_source.begin(), end));
+		std::for_each(start, end, [this, &range] (int index) { source_range[index] = range; });
+		start = end;
+	}
+}
+
+
+//-------------------------------------------------
+//  indexes - get the lookup tables, building
+//  them on first use
+//-------------------------------------------------
+
+driver_list::index_tables const &driver_list::indexes()
+{
+	static index_tables const tables;
+	return tables;
+}
+
+
+//-------------------------------------------------
+//  prefix_range - get the range of drivers with
+//  names starting with the given prefix
+//-------------------------------------------------
+
+std::pair<std::size_t, std::size_t> driver_list::prefix_range(std::string_view prefix)
+{
+	// the list is sorted case-insensitively, so matching names are contiguous
+	game_driver const *const *const begin = s_drivers_sorted;
+	game_driver const *const *const end = begin + s_driver_count;
+	auto const before = [prefix] (game_driver const *driver, std::string_view) { return core_strnicmp(driver->name, prefix.data(), prefix.length()) < 0; };
+	auto const after = [prefix] (std::string_view, game_driver const *driver) { return core_strnicmp(driver->name, prefix.data(), prefix.length()) > 0; };
+	game_driver const *const *const first = std::lower_bound(begin, end, prefix, before);
+	game_driver const *const *const last = std::upper_bound(first, end, prefix, after);
+	return std::make_pair(std::size_t(std::distance(begin, first)), std::size_t(std::distance(begin, last)));
+}
+
+
 
 //**************************************************************************
 //  DRIVER ENUMERATOR
@@ -122,10 +202,10 @@ std::shared_ptr<machine_config> const &driver_enumerator::config(std::size_t ind
 {
 	assert(index < s_driver_count);
 
-	// if we don't have it cached, add it
+	// if we don't have it cached, get it from the options, which may have built it recently
 	std::shared_ptr<machine_config> &config = m_config[index];
 	if (!config)
-		config = std::make_shared<machine_config>(*s_drivers_sorted[index], options);
+		config = options.shared_config(*s_drivers_sorted[index]);
 
 	return config;
 }
@@ -141,8 +221,16 @@ std::size_t driver_enumerator::filter(const char *filterstring)
 	// reset the count
 	exclude_all();
 
-	// match name against each driver in the list
-	for (std::size_t index = 0; index < s_driver_count; index++)
+	// only names starting with the part before the first wildcard can match
+	std::pair<std::size_t, std::size_t> range(0, s_driver_count);
+	if (filterstring)
+	{
+		std::string_view const str(filterstring);
+		range = prefix_range(str.substr(0, str.find_first_of("*?")));
+	}
+
+	// match name against each candidate driver
+	for (std::size_t index = range.first; index < range.second; index++)
 		if (matches(filterstring, s_drivers_sorted[index]->name))
 			include(index);
 
@@ -160,10 +248,10 @@ std::size_t driver_enumerator::filter(const game_driver &driver)
 	// reset the count
 	exclude_all();
 
-	// match name against each driver in the list
-	for (std::size_t index = 0; index < s_driver_count; index++)
-		if (s_drivers_sorted[index] == &driver)
-			include(index);
+	// names are unique, so look it up directly
+	int const index = find(driver);
+	if ((index >= 0) && (s_drivers_sorted[index] == &driver))
+		include(index);
 
 	return m_filtered_count;
 }
@@ -262,7 +350,7 @@ void driver_enumerator::find_approximate_matches(std::string const &string, std:
 		std::vector<std::pair<double, int> > penalty;
 		penalty.reserve(count);
 		std::u32string const search(ustr_from_utf8(normalize_unicode(string, unicode_normalization_form::D, true)));
-		std::string composed;
+		search_strings const &strings(search_data());
 		std::u32string candidate;
 
 		// scan the entire drivers array
@@ -281,8 +369,7 @@ void driver_enumerator::find_approximate_matches(std::string const &string, std:
 				// if it's not a perfect match, try the description
 				if (curpenalty)
 				{
-					candidate = ustr_from_utf8(normalize_unicode(drv.type.fullname(), unicode_normalization_form::D, true));
-					double p(util::edit_distance(search, candidate));
+					double p(util::edit_distance(search, strings.description[index]));
 					if (p < curpenalty)
 						curpenalty = p;
 				}
@@ -290,11 +377,7 @@ void driver_enumerator::find_approximate_matches(std::string const &string, std:
 				// also check "<manufacturer> <description>"
 				if (curpenalty)
 				{
-					composed.assign(drv.manufacturer);
-					composed.append(1, ' ');
-					composed.append(drv.type.fullname());
-					candidate = ustr_from_utf8(normalize_unicode(composed, unicode_normalization_form::D, true));
-					double p(util::edit_distance(search, candidate));
+					double p(util::edit_distance(search, strings.manufacturer[index]));
 					if (p < curpenalty)
 						curpenalty = p;
 				}
@@ -327,6 +410,41 @@ void driver_enumerator::find_approximate_matches(std::string const &string, std:
 }
 
 
+//-------------------------------------------------
+//  search_strings - normalise descriptions for
+//  approximate matching
+//-------------------------------------------------
+
+driver_enumerator::search_strings::search_strings()
+	: description(s_driver_count)
+	, manufacturer(s_driver_count)
+{
+	std::string composed;
+	for (std::size_t index = 0; index < s_driver_count; index++)
+	{
+		game_driver const &drv(*s_drivers_sorted[index]);
+		description[index] = ustr_from_utf8(normalize_unicode(drv.type.fullname(), unicode_normalization_form::D, true));
+
+		composed.assign(drv.manufacturer);
+		composed.append(1, ' ');
+		composed.append(drv.type.fullname());
+		manufacturer[index] = ustr_from_utf8(normalize_unicode(composed, unicode_normalization_form::D, true));
+	}
+}
+
+
+//-------------------------------------------------
+//  search_data - get normalised descriptions,
+//  building them on first use
+//-------------------------------------------------
+
+driver_enumerator::search_strings const &driver_enumerator::search_data()
+{
+	static search_strings const strings;
+	return strings;
+}
+
+
 //-------------------------------------------------
 //  release_current - release bulky memory
 //  structures from the current entry because
@@ -18,6 +18,10 @@
 #include <algorithm>
 #include <cassert>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 
 //**************************************************************************
@@ -48,9 +52,10 @@ public:
 
 	// any item by index
 	static const game_driver &driver(std::size_t index) { assert(index < total()); return *s_drivers_sorted[index]; }
-	static int clone(std::size_t index) { return find(driver(index).parent); }
-	static int non_bios_clone(std::size_t index) { int const result = find(driver(index).parent); return ((result >= 0) && !(driver(result).flags & MACHINE_IS_BIOS_ROOT)) ? result : -1; }
-	static int compatible_with(std::size_t index) { return find(driver(index).compatible_with); }
+	static int clone(std::size_t index) { assert(index < total()); return indexes().parent[index]; }
+	static int non_bios_clone(std::size_t index) { int const result = clone(index); return ((result >= 0) && !(driver(result).flags & MACHINE_IS_BIOS_ROOT)) ? result : -1; }
+	static int compatible_with(std::size_t index) { assert(index < total()); return indexes().compatible[index]; }
+	static std::pair<int const *, int const *> same_source(std::size_t index);
 
 	// any item by driver
 	static int clone(const game_driver &driver) { int const index = find(driver); assert(index >= 0); return clone(index); }
@@ -65,6 +70,20 @@ public:
 	static bool matches(const char *wildstring, const char *string);
 
 protected:
+	// lookup tables built the first time they're needed
+	struct index_tables
+	{
+		index_tables();
+
+		std::vector<int>                                parent;         // index of each driver's parent, or -1
+		std::vector<int>                                compatible;     // index of each driver's compatible system, or -1
+		std::vector<int>                                by_source;      // driver indices grouped by source file
+		std::vector<std::pair<unsigned, unsigned> >     source_range;   // each driver's group within by_source
+	};
+
+	static index_tables const &indexes();
+	static std::pair<std::size_t, std::size_t> prefix_range(std::string_view prefix);
+
 	static std::size_t const            s_driver_count;
 	static game_driver const * const    s_drivers_sorted[];
 };
@@ -126,6 +145,17 @@ public:
 private:
 	static constexpr std::size_t CONFIG_CACHE_COUNT = 100;
 
+	// normalised descriptions for approximate matching, built the first time they're needed
+	struct search_strings
+	{
+		search_strings();
+
+		std::vector<std::u32string>     description;    // normalised description
+		std::vector<std::u32string>     manufacturer;   // normalised "<manufacturer> <description>"
+	};
+
+	static search_strings const &search_data();
+
 	typedef util::lru_cache_map<std::size_t, std::shared_ptr<machine_config> > machine_config_cache;
 
 	// internal helpers
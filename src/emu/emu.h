@@ -21,11 +21,13 @@
 // get forward declarations before anything else
 #include "emufwd.h"
 
+#include <atomic>
 #include <list>
 #include <forward_list>
 #include <vector>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 
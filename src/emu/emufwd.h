@@ -47,6 +47,9 @@ class osd_midi_device;
 // declared in aviio.h
 class avi_file;
 
+// declared in bitmap.h
+class bitmap_pool;
+
 // declared in chd.h
 class chd_file;
 
@@ -98,6 +101,7 @@ class symbol_table;
 // declared in debug/points.h
 class debug_breakpoint;
 class debug_watchpoint;
+class debug_watchpoint_taps;
 class debug_registerpoint;
 class debug_exceptionpoint;
 
@@ -163,6 +167,12 @@ class emu_file;
 // declared in http.h
 class http_manager;
 
+// declared in httpscreen.h
+class http_screen_streamer;
+
+// declared in netplay.h
+class netplay_manager;
+
 // declared in gamedrv.h
 class game_driver;
 
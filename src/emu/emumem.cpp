@@ -14,6 +14,8 @@
 #include "emuopts.h"
 #include "debug/debugcpu.h"
 
+#include "../osd/modules/lib/osdlib.h"
+
 #include "emumem_mud.h"
 #include "emumem_hea.h"
 #include "emumem_hem.h"
@@ -43,6 +45,12 @@ template <typename Format, typename... Params> static void VPRINTF(Format &&, Pa
 
 #define VALIDATE_REFCOUNTS 0
 
+// smallest RAM block worth giving its own pages with -mappedram
+static constexpr size_t MAPPED_RAM_THRESHOLD = 64 * 1024;
+
+// smallest region or RAM block worth backing with huge pages
+static constexpr size_t LARGE_PAGE_THRESHOLD = 4 * 1024 * 1024;
+
 offs_t handler_entry::dispatch_entry(offs_t address) const
 {
 	fatalerror("dispatch_entry called on non-dispatching class\n");
@@ -102,6 +110,10 @@ void handler_entry::enumerate_references(handler_entry::reflist &refs) const
 {
 }
 
+void handler_entry::set_dirty_tracking(bool enable)
+{
+}
+
 template<int Width, int AddrShift> const handler_entry_read<Width, AddrShift> *const *handler_entry_read<Width, AddrShift>::get_dispatch() const
 {
 	fatalerror("get_dispatch called on non-dispatching class\n");
@@ -147,6 +159,11 @@ template<int Width, int AddrShift> void *handler_entry_read<Width, AddrShift>::g
 	return nullptr;
 }
 
+template<int Width, int AddrShift> void *handler_entry_read<Width, AddrShift>::get_direct_ptr(offs_t start, offs_t end) const
+{
+	return nullptr;
+}
+
 template<int Width, int AddrShift> handler_entry_read<Width, AddrShift> *handler_entry_read<Width, AddrShift>::dup()
 {
 	ref();
@@ -209,6 +226,11 @@ template<int Width, int AddrShift> void *handler_entry_write<Width, AddrShift>::
 	return nullptr;
 }
 
+template<int Width, int AddrShift> void *handler_entry_write<Width, AddrShift>::get_direct_ptr(offs_t start, offs_t end) const
+{
+	return nullptr;
+}
+
 template<int Width, int AddrShift> handler_entry_write<Width, AddrShift> *handler_entry_write<Width, AddrShift>::dup()
 {
 	ref();
@@ -253,6 +275,48 @@ template class handler_entry_write<3, -1>;
 template class handler_entry_write<3, -2>;
 template class handler_entry_write<3, -3>;
 
+//**************************************************************************
+//  DIRECT PAGE TABLE
+//**************************************************************************
+
+//-------------------------------------------------
+//  memory_direct_pages - constructor
+//-------------------------------------------------
+
+emu::detail::memory_direct_pages::memory_direct_pages(offs_t addrmask, int addrwidth, int nativeshift)
+	: m_read_generation(1)
+	, m_write_generation(1)
+{
+	// aim for 1K pages, but keep wide spaces down to 16K entries
+	m_shift = std::max(nativeshift, (addrwidth > 24) ? (addrwidth - 14) : std::min(addrwidth, 10));
+	m_page_mask = make_bitmask<offs_t>(m_shift);
+	m_pages.resize(size_t(addrmask >> m_shift) + 1, page{ nullptr, nullptr, 0, 0 });
+}
+
+
+//-------------------------------------------------
+//  invalidate - forget resolved pages after the
+//  map has changed
+//-------------------------------------------------
+
+void emu::detail::memory_direct_pages::invalidate(read_or_write mode)
+{
+	// if a generation wraps, clear everything so old entries can't match by accident
+	if((u32(mode) & u32(read_or_write::READ)) && !++m_read_generation)
+	{
+		for(page &p : m_pages)
+			p.read_generation = 0;
+		m_read_generation = 1;
+	}
+	if((u32(mode) & u32(read_or_write::WRITE)) && !++m_write_generation)
+	{
+		for(page &p : m_pages)
+			p.write_generation = 0;
+		m_write_generation = 1;
+	}
+}
+
+
 //**************************************************************************
 //  MEMORY MANAGER
 //**************************************************************************
@@ -309,8 +373,22 @@ void memory_manager::initialize()
 
 void *memory_manager::allocate_memory(device_t &dev, int spacenum, std::string name, u8 width, size_t bytes)
 {
-	void *const ptr = m_datablocks.emplace_back(malloc(bytes)).get();
-	memset(ptr, 0, bytes);
+	// large blocks can come straight from the OS, already zeroed, so pages
+	// nobody writes cost nothing and survive fork() copy-on-write
+	// very large ones are randomly accessed enough for huge pages to pay off
+	void *ptr = nullptr;
+	bool const large = (bytes >= LARGE_PAGE_THRESHOLD) && machine().options().large_pages();
+	if (large || ((bytes >= MAPPED_RAM_THRESHOLD) && machine().options().mapped_ram()))
+	{
+		auto mapping = std::make_unique<osd::private_mapping>(bytes, large);
+		if (*mapping)
+			ptr = m_mappedblocks.emplace_back(std::move(mapping))->get();
+	}
+	if (!ptr)
+	{
+		ptr = m_datablocks.emplace_back(malloc(bytes)).get();
+		memset(ptr, 0, bytes);
+	}
 	machine().save().save_memory(&dev, "memory", dev.tag(), spacenum, name.c_str(), ptr, width/8, u32(bytes) / (width/8));
 	return ptr;
 }
@@ -378,7 +456,7 @@ memory_share *memory_manager::share_alloc(device_t &dev, std::string name, u8 wi
 	void *ptr = allocate_memory(dev, 0, name, width, bytes);
 
 	// allocate the region
-	return m_sharelist.emplace(name, std::make_unique<memory_share>(name, width, bytes, endianness, ptr)).first->second.get();
+	return m_sharelist.emplace(name, std::make_unique<memory_share>(*this, name, width, bytes, endianness, ptr)).first->second.get();
 }
 
 
@@ -422,6 +500,51 @@ memory_bank *memory_manager::bank_find(std::string name)
 }
 
 
+//-------------------------------------------------
+//  dirty_share - find the tracked share holding
+//  a pointer, if any
+//-------------------------------------------------
+
+memory_share *memory_manager::dirty_share(const void *ptr) const
+{
+	for (memory_share *share : m_dirty_shares)
+		if (share->contains(ptr))
+			return share;
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  update_dirty_tracking - have every write
+//  handler re-check whether it feeds a tracked
+//  share
+//-------------------------------------------------
+
+void memory_manager::update_dirty_tracking()
+{
+	bool const enable = dirty_tracking();
+	std::vector<memory_entry> entries[2];
+	for (device_memory_interface &memory : memory_interface_enumerator(machine().root_device()))
+	{
+		for (int spacenum = 0; spacenum != memory.max_space_count(); spacenum++)
+		{
+			if (memory.has_space(spacenum))
+			{
+				address_space &space = memory.space(spacenum);
+				space.dump_maps(entries[0], entries[1]);
+				for (memory_entry &entry : entries[1])
+					entry.entry->set_dirty_tracking(enable);
+				entries[0].clear();
+				entries[1].clear();
+
+				// tracked memory must not be written through direct pages
+				space.invalidate_caches(read_or_write::WRITE);
+			}
+		}
+	}
+}
+
+
 //**************************************************************************
 //  ADDRESS SPACE CONFIG
 //**************************************************************************
@@ -1037,14 +1160,115 @@ void memory_bank::configure_entries(int startentry, int numentries, void *base,
 memory_region::memory_region(running_machine &machine, std::string name, u32 length, u8 width, endianness_t endian)
 	: m_machine(machine),
 		m_name(std::move(name)),
-		m_buffer(length),
+		m_base(nullptr),
+		m_length(length),
 		m_endianness(endian),
 		m_bitwidth(width * 8),
 		m_bytewidth(width)
 {
 	assert(width == 1 || width == 2 || width == 4 || width == 8);
+
+	// big ROMs are read all over the place, so try to keep them in huge pages
+	if ((length >= LARGE_PAGE_THRESHOLD) && machine.options().large_pages())
+	{
+		auto memory = std::make_unique<osd::private_mapping>(length, true);
+		if (*memory)
+		{
+			m_memory = std::move(memory);
+			m_base = reinterpret_cast<u8 *>(m_memory->get());
+		}
+	}
+	if (!m_base && length)
+	{
+		m_buffer.resize(length);
+		m_base = &m_buffer[0];
+	}
+}
+
+
+//-------------------------------------------------
+//  ~memory_region - destructor
+//-------------------------------------------------
+
+memory_region::~memory_region()
+{
+}
+
+
+//-------------------------------------------------
+//  map_file - back the region with a
+//  copy-on-write mapping of a file, so identical
+//  contents can be shared between processes
+//-------------------------------------------------
+
+bool memory_region::map_file(const std::string &path)
+{
+	auto mapping = std::make_unique<osd::file_mapping>(path, m_length);
+	if (!*mapping)
+		return false;
+
+	// release the private buffer
+	m_mapping = std::move(mapping);
+	m_base = reinterpret_cast<u8 *>(m_mapping->get());
+	std::vector<u8>().swap(m_buffer);
+	m_memory.reset();
+	return true;
+}
+
+//-------------------------------------------------
+//  set_dirty_tracking - start or stop recording
+//  which pages are written
+//-------------------------------------------------
+
+void memory_share::set_dirty_tracking(bool enable)
+{
+	if (enable == dirty_tracking())
+		return;
+
+	auto &shares = m_manager.m_dirty_shares;
+	if (enable)
+	{
+		m_dirty.resize(page_count(), 0);
+		shares.push_back(this);
+	}
+	else
+	{
+		std::vector<u8>().swap(m_dirty);
+		shares.erase(std::find(shares.begin(), shares.end(), this));
+	}
+	m_manager.update_dirty_tracking();
 }
 
+
+//-------------------------------------------------
+//  dirty_pages - list the pages written since
+//  the last clear
+//-------------------------------------------------
+
+std::vector<size_t> memory_share::dirty_pages() const
+{
+	std::vector<size_t> result;
+	for (size_t page = 0; page < m_dirty.size(); page++)
+		if (m_dirty[page])
+			result.push_back(page);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  mark_dirty - record a write made directly to
+//  the backing memory
+//-------------------------------------------------
+
+void memory_share::mark_dirty(size_t offset, size_t bytes)
+{
+	if (m_dirty.empty() || !bytes || (offset >= m_bytes))
+		return;
+	size_t const last = std::min(offset + bytes, m_bytes) - 1;
+	std::fill(m_dirty.begin() + (offset >> DIRTY_PAGE_SHIFT), m_dirty.begin() + (last >> DIRTY_PAGE_SHIFT) + 1, 1);
+}
+
+
 std::string memory_share::compare(u8 width, size_t bytes, endianness_t endianness) const
 {
 	if (width != m_bitwidth)
@@ -56,6 +56,8 @@ enum class read_or_write
 //  FORWARD DECLARATIONS
 //**************************************************************************
 
+namespace osd { class file_mapping; class private_mapping; }
+
 class handler_entry;
 template<int Width, int AddrShift> class handler_entry_read_passthrough;
 template<int Width, int AddrShift> class handler_entry_write_passthrough;
@@ -560,6 +562,9 @@ public:
 	virtual void enumerate_references(handler_entry::reflist &refs) const;
 	u32 get_refcount() const { return m_refcount; }
 
+	// Start or stop recording writes in the dirty page maps of the memory manager's tracked shares
+	virtual void set_dirty_tracking(bool enable);
+
 	virtual void select_a(int slot);
 	virtual void select_u(int slot);
 
@@ -607,13 +612,20 @@ public:
 		u8 ukey;
 	};
 
-	handler_entry_read(address_space *space, u32 flags) : handler_entry(space, flags) {}
+	// leaf handlers that know their own type install a read function that skips the vtable
+	using read_function = uX (*)(const handler_entry_read<Width, AddrShift> &, offs_t, uX);
+
+	handler_entry_read(address_space *space, u32 flags) : handler_entry(space, flags), m_read_function(&virtual_read) {}
 	~handler_entry_read() {}
 
+	// what the dispatch tables and caches call
+	uX call_read(offs_t offset, uX mem_mask) const { return m_read_function(*this, offset, mem_mask); }
+
 	virtual uX read(offs_t offset, uX mem_mask) const = 0;
 	virtual std::pair<uX, u16> read_flags(offs_t offset, uX mem_mask) const = 0;
 	virtual u16 lookup_flags(offs_t offset, uX mem_mask) const = 0;
 	virtual void *get_ptr(offs_t offset) const;
+	virtual void *get_direct_ptr(offs_t start, offs_t end) const;
 	virtual void lookup(offs_t address, offs_t &start, offs_t &end, handler_entry_read<Width, AddrShift> *&handler) const;
 
 	inline void populate(offs_t start, offs_t end, offs_t mirror, handler_entry_read<Width, AddrShift> *handler) {
@@ -662,6 +674,12 @@ public:
 
 	virtual void init_handlers(offs_t start_entry, offs_t end_entry, u32 lowbits, offs_t ostart, offs_t oend, handler_entry_read<Width, AddrShift> **dispatch, handler_entry::range *ranges);
 	virtual handler_entry_read<Width, AddrShift> *dup();
+
+protected:
+	read_function m_read_function;
+
+private:
+	static uX virtual_read(const handler_entry_read<Width, AddrShift> &handler, offs_t offset, uX mem_mask) { return handler.read(offset, mem_mask); }
 };
 
 // =====================-> The parent class of all write handlers
@@ -681,13 +699,20 @@ public:
 		u8 ukey;
 	};
 
-	handler_entry_write(address_space *space, u32 flags) : handler_entry(space, flags) {}
+	// leaf handlers that know their own type install a write function that skips the vtable
+	using write_function = void (*)(const handler_entry_write<Width, AddrShift> &, offs_t, uX, uX);
+
+	handler_entry_write(address_space *space, u32 flags) : handler_entry(space, flags), m_write_function(&virtual_write) {}
 	virtual ~handler_entry_write() {}
 
+	// what the dispatch tables and caches call
+	void call_write(offs_t offset, uX data, uX mem_mask) const { m_write_function(*this, offset, data, mem_mask); }
+
 	virtual void write(offs_t offset, uX data, uX mem_mask) const = 0;
 	virtual u16 write_flags(offs_t offset, uX data, uX mem_mask) const = 0;
 	virtual u16 lookup_flags(offs_t offset, uX mem_mask) const = 0;
 	virtual void *get_ptr(offs_t offset) const;
+	virtual void *get_direct_ptr(offs_t start, offs_t end) const;
 	virtual void lookup(offs_t address, offs_t &start, offs_t &end, handler_entry_write<Width, AddrShift> *&handler) const;
 
 	inline void populate(offs_t start, offs_t end, offs_t mirror, handler_entry_write<Width, AddrShift> *handler) {
@@ -737,6 +762,12 @@ public:
 
 	virtual void init_handlers(offs_t start_entry, offs_t end_entry, u32 lowbits, offs_t ostart, offs_t oend, handler_entry_write<Width, AddrShift> **dispatch, handler_entry::range *ranges);
 	virtual handler_entry_write<Width, AddrShift> *dup();
+
+protected:
+	write_function m_write_function;
+
+private:
+	static void virtual_write(const handler_entry_write<Width, AddrShift> &handler, offs_t offset, uX data, uX mem_mask) { handler.write(offset, data, mem_mask); }
 };
 
 // =====================-> Passthrough handler management structure
@@ -1567,14 +1598,14 @@ template<int Width, int AddrShift, endianness_t Endian, int TargetWidth, bool Al
 template<int Level, int Width, int AddrShift> typename emu::detail::handler_entry_size<Width>::uX dispatch_read(offs_t mask, offs_t offset, typename emu::detail::handler_entry_size<Width>::uX mem_mask, const handler_entry_read<Width, AddrShift> *const *dispatch)
 {
 	static constexpr u32 LowBits  = emu::detail::handler_entry_dispatch_level_to_lowbits(Level, Width, AddrShift);
-	return dispatch[(offset & mask) >> LowBits]->read(offset, mem_mask);
+	return dispatch[(offset & mask) >> LowBits]->call_read(offset, mem_mask);
 }
 
 
 template<int Level, int Width, int AddrShift> void dispatch_write(offs_t mask, offs_t offset, typename emu::detail::handler_entry_size<Width>::uX data, typename emu::detail::handler_entry_size<Width>::uX mem_mask, const handler_entry_write<Width, AddrShift> *const *dispatch)
 {
 	static constexpr u32 LowBits  = emu::detail::handler_entry_dispatch_level_to_lowbits(Level, Width, AddrShift);
-	return dispatch[(offset & mask) >> LowBits]->write(offset, data, mem_mask);
+	return dispatch[(offset & mask) >> LowBits]->call_write(offset, data, mem_mask);
 }
 
 
@@ -1605,6 +1636,47 @@ template<int Level, int Width, int AddrShift> u16 dispatch_lookup_write_flags(of
 }
 
 
+// ======================> memory_direct_pages
+
+// memory_direct_pages holds host pointers for the pages of a space that are
+// backed entirely by plain RAM or ROM, so memory_access_specific can skip the
+// dispatch tree for them; pages are resolved on first access and forgotten
+// whenever the map changes or a view is switched
+
+namespace emu::detail {
+
+class memory_direct_pages
+{
+public:
+	struct page
+	{
+		void *  read;
+		void *  write;
+		u32     read_generation;
+		u32     write_generation;
+	};
+
+	memory_direct_pages(offs_t addrmask, int addrwidth, int nativeshift);
+
+	int shift() const { return m_shift; }
+	offs_t page_mask() const { return m_page_mask; }
+	u32 read_generation() const { return m_read_generation; }
+	u32 write_generation() const { return m_write_generation; }
+	page &page_for(offs_t address) { return m_pages[address >> m_shift]; }
+
+	void invalidate(read_or_write mode);
+
+private:
+	std::vector<page>   m_pages;
+	int                 m_shift;
+	offs_t              m_page_mask;
+	u32                 m_read_generation;
+	u32                 m_write_generation;
+};
+
+} // namespace emu::detail
+
+
 // ======================> memory_access_specific
 
 // memory_access_specific does uncached but faster accesses by shortcutting the address_space virtual call
@@ -1625,7 +1697,8 @@ public:
 		: m_space(nullptr),
 		  m_addrmask(0),
 		  m_dispatch_read(nullptr),
-		  m_dispatch_write(nullptr)
+		  m_dispatch_write(nullptr),
+		  m_direct(nullptr)
 	{
 	}
 
@@ -1668,6 +1741,10 @@ public:
 	void write_qword_unaligned(offs_t address, u64 data) { memory_write_generic<Width, AddrShift, Endian, 3, false>(wop(), address, data, 0xffffffffffffffffU); }
 	void write_qword_unaligned(offs_t address, u64 data, u64 mask) { memory_write_generic<Width, AddrShift, Endian, 3, false>(wop(), address, data, mask); }
 
+	void read_block(offs_t address, NativeType *buffer, offs_t count);
+	void write_block(offs_t address, const NativeType *buffer, offs_t count);
+	void copy_block(offs_t source, offs_t dest, offs_t count);
+
 
 	std::pair<u8,  u16> read_byte_flags(offs_t address) { if constexpr(Width == 0) return read_native_flags(address & ~NATIVE_MASK); else return memory_read_generic_flags<Width, AddrShift, Endian, 0, true>(ropf(), address, 0xff); }
 	std::pair<u16, u16> read_word_flags(offs_t address) { if constexpr(Width == 1) return read_native_flags(address & ~NATIVE_MASK); else return memory_read_generic_flags<Width, AddrShift, Endian, 1, true>(ropf(), address, 0xffff); }
@@ -1733,14 +1810,33 @@ private:
 	const handler_entry_read<Width, AddrShift> *const *m_dispatch_read;
 	const handler_entry_write<Width, AddrShift> *const *m_dispatch_write;
 
+	memory_direct_pages *       m_direct;                  // host pointers for plain memory pages
+
 	NativeType read_native(offs_t address, NativeType mask = ~NativeType(0)) {
-		return dispatch_read<Level, Width, AddrShift>(offs_t(-1), address & m_addrmask, mask, m_dispatch_read);
+		address &= m_addrmask;
+		memory_direct_pages::page &page = m_direct->page_for(address);
+		if(page.read_generation != m_direct->read_generation())
+			resolve_direct(address, read_or_write::READ);
+		if(page.read)
+			return static_cast<const NativeType *>(page.read)[(address & m_direct->page_mask()) >> (Width + AddrShift)];
+		return dispatch_read<Level, Width, AddrShift>(offs_t(-1), address, mask, m_dispatch_read);
 	}
 
 	void write_native(offs_t address, NativeType data, NativeType mask = ~NativeType(0)) {
-		dispatch_write<Level, Width, AddrShift>(offs_t(-1), address & m_addrmask, data, mask, m_dispatch_write);
+		address &= m_addrmask;
+		memory_direct_pages::page &page = m_direct->page_for(address);
+		if(page.write_generation != m_direct->write_generation())
+			resolve_direct(address, read_or_write::WRITE);
+		if(page.write) {
+			NativeType &dest = static_cast<NativeType *>(page.write)[(address & m_direct->page_mask()) >> (Width + AddrShift)];
+			dest = (dest & ~mask) | (data & mask);
+			return;
+		}
+		dispatch_write<Level, Width, AddrShift>(offs_t(-1), address, data, mask, m_dispatch_write);
 	}
 
+	void resolve_direct(offs_t address, read_or_write mode);
+
 	std::pair<NativeType, u16> read_native_flags(offs_t address, NativeType mask = ~NativeType(0)) {
 		return dispatch_read_flags<Level, Width, AddrShift>(offs_t(-1), address & m_addrmask, mask, m_dispatch_read);
 	}
@@ -2301,6 +2397,7 @@ class address_space : public address_space_installer
 	friend class memory_block;
 	template<int Width, int AddrShift> friend class handler_entry_read_unmapped;
 	template<int Width, int AddrShift> friend class handler_entry_write_unmapped;
+	template<int Level, int Width, int AddrShift, endianness_t Endian> friend class emu::detail::memory_access_specific;
 
 protected:
 	// construction/destruction
@@ -2309,6 +2406,8 @@ protected:
 public:
 	virtual ~address_space();
 
+	memory_manager &manager() const { return m_manager; }
+
 	// getters
 	device_t &device() const { return m_device; }
 	const char *name() const { return m_name; }
@@ -2338,6 +2437,8 @@ public:
 			fatalerror("Requesting spefific() with endianness %s while the config says %s\n",
 					   util::endian_to_string_view(Endian), util::endian_to_string_view(m_config.endianness()));
 
+		if(!m_direct)
+			m_direct = std::make_unique<emu::detail::memory_direct_pages>(m_addrmask, m_config.addr_width(), std::max(Width + AddrShift, 0));
 		v.set(this, get_specific_info());
 	}
 
@@ -2345,6 +2446,8 @@ public:
 	template <typename T> util::notifier_subscription add_change_notifier(T &&n) { return add_change_notifier(delegate<void (read_or_write)>(std::forward<T>(n))); }
 
 	void invalidate_caches(read_or_write mode) {
+		if(m_direct)
+			m_direct->invalidate(mode);
 		if(u32(mode) & ~m_in_notification) {
 			u32 old = m_in_notification;
 			m_in_notification |= u32(mode);
@@ -2372,6 +2475,11 @@ public:
 	virtual void *get_read_ptr(offs_t address) const = 0;
 	virtual void *get_write_ptr(offs_t address) const = 0;
 
+	// host address of the native word holding an address if it is plain
+	// memory, otherwise nullptr; valid while direct_generation is unchanged
+	void *get_direct_ptr(offs_t address, read_or_write mode);
+	u32 direct_generation(read_or_write mode) const { return !m_direct ? 0 : (mode == read_or_write::READ) ? m_direct->read_generation() : m_direct->write_generation(); }
+
 	// read accessors
 	virtual u8 read_byte(offs_t address) = 0;
 	virtual u16 read_word(offs_t address) = 0;
@@ -2402,6 +2510,13 @@ public:
 	virtual void write_qword_unaligned(offs_t address, u64 data) = 0;
 	virtual void write_qword_unaligned(offs_t address, u64 data, u64 mask) = 0;
 
+	// block accessors; count is in native words and buffers hold native
+	// words in host order, so a DMA engine can move whole ranges at once
+	// and memory-backed ranges are copied without going through handlers
+	virtual void read_block(offs_t address, void *buffer, offs_t count) = 0;
+	virtual void write_block(offs_t address, const void *buffer, offs_t count) = 0;
+	virtual void copy_block(offs_t source, offs_t dest, offs_t count) = 0;
+
 	// setup
 	void prepare_map();
 	void prepare_device_map(address_map &map);
@@ -2419,6 +2534,7 @@ protected:
 	// internal helpers
 	virtual std::pair<void *, void *> get_cache_info() = 0;
 	virtual std::pair<const void *, const void *> get_specific_info() = 0;
+	virtual void resolve_direct_page(offs_t address, read_or_write mode) = 0;
 
 	void prepare_map_generic(address_map &map, bool allow_alloc);
 
@@ -2440,6 +2556,8 @@ protected:
 
 	util::notifier<read_or_write> m_notifiers;  // notifier list for address map change
 	u32                     m_in_notification;  // notification(s) currently being done
+
+	std::unique_ptr<emu::detail::memory_direct_pages> m_direct; // plain memory pages for specific accessors
 };
 
 
@@ -2485,8 +2603,9 @@ class memory_share
 {
 public:
 	// construction/destruction
-	memory_share(std::string name, u8 width, size_t bytes, endianness_t endianness, void *ptr)
-		: m_name(name),
+	memory_share(memory_manager &manager, std::string name, u8 width, size_t bytes, endianness_t endianness, void *ptr)
+		: m_manager(manager),
+		  m_name(name),
 		  m_ptr(ptr),
 		  m_bytes(bytes),
 		  m_endianness(endianness),
@@ -2504,8 +2623,25 @@ public:
 
 	std::string compare(u8 width, size_t bytes, endianness_t endianness) const;
 
+	// dirty page tracking; writes through address space handlers are
+	// recorded automatically, code writing through ptr() has to call
+	// mark_dirty itself
+	static constexpr int DIRTY_PAGE_SHIFT = 12;
+	void set_dirty_tracking(bool enable);
+	bool dirty_tracking() const { return !m_dirty.empty(); }
+	size_t page_count() const { return (m_bytes + (size_t(1) << DIRTY_PAGE_SHIFT) - 1) >> DIRTY_PAGE_SHIFT; }
+	bool page_dirty(size_t page) const { return !m_dirty.empty() && m_dirty[page]; }
+	std::vector<size_t> dirty_pages() const;
+	void clear_dirty() { std::fill(m_dirty.begin(), m_dirty.end(), 0); }
+	void mark_dirty(size_t offset, size_t bytes);
+
+	bool contains(const void *ptr) const { return (ptr >= m_ptr) && (ptr < static_cast<const u8 *>(m_ptr) + m_bytes); }
+	void mark_dirty(const void *ptr) { m_dirty[size_t(static_cast<const u8 *>(ptr) - static_cast<const u8 *>(m_ptr)) >> DIRTY_PAGE_SHIFT] = 1; }
+
 private:
 	// internal state
+	memory_manager &        m_manager;              // manager that owns the share
+	std::vector<u8>         m_dirty;                // one byte per page, nonzero when written since the last clear
 	std::string             m_name;                 // share name
 	void *                  m_ptr;                  // pointer to the memory backing the region
 	size_t                  m_bytes;                // size of the shared region in bytes
@@ -2525,13 +2661,18 @@ class memory_region
 public:
 	// construction/destruction
 	memory_region(running_machine &machine, std::string name, u32 length, u8 width, endianness_t endian);
+	~memory_region();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
-	u8 *base() { return (m_buffer.size() > 0) ? &m_buffer[0] : nullptr; }
-	u8 *end() { return base() + m_buffer.size(); }
-	u32 bytes() const { return m_buffer.size(); }
+	u8 *base() { return m_base; }
+	u8 *end() { return base() + m_length; }
+	u32 bytes() const { return m_length; }
 	const std::string &name() const { return m_name; }
+	bool mapped() const { return bool(m_mapping); }
+
+	// replace the contents with a copy-on-write mapping of a file of the same length
+	bool map_file(const std::string &path);
 
 	// flag expansion
 	endianness_t endianness() const { return m_endianness; }
@@ -2539,7 +2680,7 @@ public:
 	u8 bytewidth() const { return m_bytewidth; }
 
 	// data access
-	u8 &as_u8(offs_t offset = 0) { return m_buffer[offset]; }
+	u8 &as_u8(offs_t offset = 0) { return m_base[offset]; }
 	u16 &as_u16(offs_t offset = 0) { return reinterpret_cast<u16 *>(base())[offset]; }
 	u32 &as_u32(offs_t offset = 0) { return reinterpret_cast<u32 *>(base())[offset]; }
 	u64 &as_u64(offs_t offset = 0) { return reinterpret_cast<u64 *>(base())[offset]; }
@@ -2549,6 +2690,10 @@ private:
 	running_machine &       m_machine;
 	std::string             m_name;
 	std::vector<u8>         m_buffer;
+	std::unique_ptr<osd::private_mapping> m_memory;
+	std::unique_ptr<osd::file_mapping> m_mapping;
+	u8 *                    m_base;
+	u32                     m_length;
 	endianness_t            m_endianness;
 	u8                      m_bitwidth;
 	u8                      m_bytewidth;
@@ -2614,6 +2759,8 @@ private:
 	device_t &                                      m_device;
 	std::string                                     m_name;
 	std::map<int, int>                              m_entry_mapping;
+	std::vector<int>                                m_slot_ids;         // dense slot -> id table when slots are close together, -1 for unknown
+	int                                             m_slot_base;        // slot number of m_slot_ids[0]
 	std::vector<std::unique_ptr<memory_view_entry>> m_entries;
 	const address_space_config *                    m_config;
 	offs_t                                          m_addrstart;
@@ -2629,6 +2776,7 @@ private:
 	std::pair<handler_entry *, handler_entry *> make_handlers(address_space &space, offs_t addrstart, offs_t addrend);
 	void make_subdispatch(std::string context);
 	int id_to_slot(int id) const;
+	int slot_to_id(int slot) const;
 	void register_state();
 };
 
@@ -2636,6 +2784,7 @@ private:
 
 // ======================> memory_manager
 
+
 // holds internal state for the memory system
 class memory_manager
 {
@@ -2673,22 +2822,34 @@ public:
 	memory_region *region_find(std::string name);
 	void region_free(std::string name);
 
+	// dirty page tracking
+	bool dirty_tracking() const { return !m_dirty_shares.empty(); }
+	memory_share *dirty_share(const void *ptr) const;
+	void mark_dirty(const void *ptr) const { memory_share *const share = dirty_share(ptr); if (share) share->mark_dirty(ptr); }
+
 private:
+	friend class memory_share;
+
 	struct stdlib_deleter { void operator()(void *p) const { free(p); } };
 
 	// internal state
 	running_machine &           m_machine;              // reference to the machine
 
 	std::vector<std::unique_ptr<void, stdlib_deleter>>               m_datablocks;           // list of memory blocks to free on exit
+	std::vector<std::unique_ptr<osd::private_mapping>>               m_mappedblocks;         // list of page-mapped memory blocks to unmap on exit
 	std::unordered_map<std::string, std::unique_ptr<memory_bank>>    m_banklist;             // map of banks
 	std::unordered_map<std::string, std::unique_ptr<memory_share>>   m_sharelist;            // map of shares
 	std::unordered_map<std::string, std::unique_ptr<memory_region>>  m_regionlist;           // map of memory regions
+	std::vector<memory_share *>                                      m_dirty_shares;         // shares with dirty page tracking enabled
 
 	// Allocate the address spaces
 	void allocate(device_memory_interface &memory);
 
 	// Allocate some ram and register it for saving
 	void *allocate_memory(device_t &dev, int spacenum, std::string name, u8 width, size_t bytes);
+
+	// Tell every write handler that the set of tracked shares changed
+	void update_dirty_tracking();
 };
 
 
@@ -2732,7 +2893,7 @@ read_native(offs_t address, typename emu::detail::handler_entry_size<Width>::uX
 {
 	address &= m_addrmask;
 	check_address_r(address);
-	return m_cache_r->read(address, mask);
+	return m_cache_r->call_read(address, mask);
 }
 
 template<int Width, int AddrShift, endianness_t Endian>
@@ -2741,7 +2902,7 @@ write_native(offs_t address, typename emu::detail::handler_entry_size<Width>::uX
 {
 	address &= m_addrmask;
 	check_address_w(address);
-	m_cache_w->write(address, data, mask);
+	m_cache_w->call_write(address, data, mask);
 }
 
 inline void emu::detail::memory_passthrough_handler_impl::remove()
@@ -2758,6 +2919,36 @@ set(address_space *space, std::pair<const void *, const void *> rw)
 	m_addrmask = space->addrmask();
 	m_dispatch_read  = (const handler_entry_read <Width, AddrShift> *const *)(rw.first);
 	m_dispatch_write = (const handler_entry_write<Width, AddrShift> *const *)(rw.second);
+	m_direct = space->m_direct.get();
+}
+
+
+template<int Level, int Width, int AddrShift, endianness_t Endian>
+void emu::detail::memory_access_specific<Level, Width, AddrShift, Endian>::
+resolve_direct(offs_t address, read_or_write mode)
+{
+	m_space->resolve_direct_page(address, mode);
+}
+
+template<int Level, int Width, int AddrShift, endianness_t Endian>
+void emu::detail::memory_access_specific<Level, Width, AddrShift, Endian>::
+read_block(offs_t address, NativeType *buffer, offs_t count)
+{
+	m_space->read_block(address, buffer, count);
+}
+
+template<int Level, int Width, int AddrShift, endianness_t Endian>
+void emu::detail::memory_access_specific<Level, Width, AddrShift, Endian>::
+write_block(offs_t address, const NativeType *buffer, offs_t count)
+{
+	m_space->write_block(address, buffer, count);
+}
+
+template<int Level, int Width, int AddrShift, endianness_t Endian>
+void emu::detail::memory_access_specific<Level, Width, AddrShift, Endian>::
+copy_block(offs_t source, offs_t dest, offs_t count)
+{
+	m_space->copy_block(source, dest, count);
 }
 
 
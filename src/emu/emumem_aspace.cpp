@@ -121,6 +121,7 @@ class address_space_specific : public address_space
 	static constexpr u32 NATIVE_STEP = AddrShift >= 0 ? NATIVE_BYTES << iabs(AddrShift) : NATIVE_BYTES >> iabs(AddrShift);
 	static constexpr u32 NATIVE_MASK = NATIVE_STEP - 1;
 	static constexpr u32 NATIVE_BITS = 8 * NATIVE_BYTES;
+	static constexpr offs_t COPY_CHUNK = 256 / NATIVE_BYTES;
 
 	static constexpr offs_t offset_to_byte(offs_t offset) { return AddrShift < 0 ? offset << iabs(AddrShift) : offset >> iabs(AddrShift); }
 
@@ -366,6 +367,26 @@ public:
 		return rw;
 	}
 
+	void resolve_direct_page(offs_t address, read_or_write mode) override {
+		emu::detail::memory_direct_pages::page &page = m_direct->page_for(address);
+		offs_t const start = address & ~m_direct->page_mask();
+		offs_t const end = std::min<offs_t>(start | m_direct->page_mask(), m_addrmask);
+
+		// a page can only be used directly if a single plain memory handler covers all of it
+		offs_t hstart, hend;
+		if(mode == read_or_write::READ) {
+			handler_entry_read<Width, AddrShift> *handler;
+			m_root_read->lookup(start, hstart, hend, handler);
+			page.read = ((hstart <= start) && (hend >= end)) ? handler->get_direct_ptr(start, end) : nullptr;
+			page.read_generation = m_direct->read_generation();
+		} else {
+			handler_entry_write<Width, AddrShift> *handler;
+			m_root_write->lookup(start, hstart, hend, handler);
+			page.write = ((hstart <= start) && (hend >= end)) ? handler->get_direct_ptr(start, end) : nullptr;
+			page.write_generation = m_direct->write_generation();
+		}
+	}
+
 	void delayed_ref(handler_entry *e) {
 		e->ref();
 		m_delayed_unrefs.insert(e);
@@ -454,6 +475,72 @@ public:
 	auto rop()   { return [this](offs_t offset, NativeType mask) -> NativeType { return read_native(offset, mask); }; }
 	auto wop()   { return [this](offs_t offset, NativeType data, NativeType mask) -> void { write_native(offset, data, mask); }; }
 
+	// block reads and writes resolve the handler once per range it covers
+	// and copy directly when it is plain memory
+	void read_block(offs_t address, void *buffer, offs_t count) override
+	{
+		uX *dest = static_cast<uX *>(buffer);
+		address &= ~NATIVE_MASK;
+		while(count) {
+			address &= m_addrmask;
+			offs_t start, end;
+			handler_entry_read<Width, AddrShift> *handler;
+			m_root_read->lookup(address, start, end, handler);
+			offs_t const chunk = std::min<offs_t>(count, ((end - address) / NATIVE_STEP) + 1);
+			uX const *const src = static_cast<uX const *>(handler->get_direct_ptr(address, address + (chunk - 1) * NATIVE_STEP + NATIVE_MASK));
+			if(src)
+				std::copy_n(src, chunk, dest);
+			else
+				for(offs_t i = 0; i != chunk; i++)
+					dest[i] = handler->call_read(address + i * NATIVE_STEP, uX(0xffffffffffffffffU));
+			dest += chunk;
+			count -= chunk;
+			address += chunk * NATIVE_STEP;
+		}
+	}
+
+	void write_block(offs_t address, const void *buffer, offs_t count) override
+	{
+		uX const *src = static_cast<uX const *>(buffer);
+		address &= ~NATIVE_MASK;
+		while(count) {
+			address &= m_addrmask;
+			offs_t start, end;
+			handler_entry_write<Width, AddrShift> *handler;
+			m_root_write->lookup(address, start, end, handler);
+			offs_t const chunk = std::min<offs_t>(count, ((end - address) / NATIVE_STEP) + 1);
+			uX *const dest = static_cast<uX *>(handler->get_direct_ptr(address, address + (chunk - 1) * NATIVE_STEP + NATIVE_MASK));
+			if(dest)
+				std::copy_n(src, chunk, dest);
+			else
+				for(offs_t i = 0; i != chunk; i++)
+					handler->call_write(address + i * NATIVE_STEP, src[i], uX(0xffffffffffffffffU));
+			src += chunk;
+			count -= chunk;
+			address += chunk * NATIVE_STEP;
+		}
+	}
+
+	void copy_block(offs_t source, offs_t dest, offs_t count) override
+	{
+		// forward copies where the destination is just ahead of the
+		// source repeat a pattern, so never read past what was written
+		source &= m_addrmask & ~NATIVE_MASK;
+		dest &= m_addrmask & ~NATIVE_MASK;
+		offs_t const distance = ((dest - source) & m_addrmask) / NATIVE_STEP;
+		offs_t const limit = (distance && (distance < COPY_CHUNK)) ? distance : COPY_CHUNK;
+
+		uX buffer[COPY_CHUNK];
+		while(count) {
+			offs_t const chunk = std::min(count, limit);
+			read_block(source, buffer, chunk);
+			write_block(dest, buffer, chunk);
+			count -= chunk;
+			source += chunk * NATIVE_STEP;
+			dest += chunk * NATIVE_STEP;
+		}
+	}
+
 	// virtual access to these functions
 	u8 read_byte(offs_t address) override { if constexpr(Width == 0) return read_native(address & ~NATIVE_MASK); else return memory_read_generic<Width, AddrShift, Endian, 0, true>(rop(), address, 0xff); }
 	u16 read_word(offs_t address) override { if constexpr(Width == 1) return read_native(address & ~NATIVE_MASK); else return memory_read_generic<Width, AddrShift, Endian, 1, true>(rop(), address, 0xffff); }
@@ -1249,3 +1336,30 @@ util::notifier_subscription address_space::add_change_notifier(delegate<void (re
 {
 	return m_notifiers.subscribe(std::move(n));
 }
+
+void *address_space::get_direct_ptr(offs_t address, read_or_write mode)
+{
+	int width = 0;
+	while((8 << width) < data_width())
+		width++;
+	int const nativeshift = width + addr_shift();
+	if(nativeshift < 0)
+		return nullptr;
+
+	// same page table as the specific accessors, resolved the same way
+	if(!m_direct)
+		m_direct = std::make_unique<emu::detail::memory_direct_pages>(m_addrmask, m_config.addr_width(), nativeshift);
+	address &= m_addrmask;
+	emu::detail::memory_direct_pages::page &page = m_direct->page_for(address);
+	void *base;
+	if(mode == read_or_write::READ) {
+		if(page.read_generation != m_direct->read_generation())
+			resolve_direct_page(address, mode);
+		base = page.read;
+	} else {
+		if(page.write_generation != m_direct->write_generation())
+			resolve_direct_page(address, mode);
+		base = page.write;
+	}
+	return base ? static_cast<u8 *>(base) + (((address & m_direct->page_mask()) >> nativeshift) << width) : nullptr;
+}
@@ -70,6 +70,11 @@ template<int Width, int AddrShift, typename READ> typename emu::detail::handler_
 	return read_impl<READ>(offset, mem_mask);
 }
 
+template<int Width, int AddrShift, typename READ> typename emu::detail::handler_entry_size<Width>::uX handler_entry_read_delegate<Width, AddrShift, READ>::direct_read(const handler_entry_read<Width, AddrShift> &handler, offs_t offset, uX mem_mask)
+{
+	return static_cast<const handler_entry_read_delegate<Width, AddrShift, READ> &>(handler).template read_impl<READ>(offset, mem_mask);
+}
+
 template<int Width, int AddrShift, typename READ> std::pair<typename emu::detail::handler_entry_size<Width>::uX, u16> handler_entry_read_delegate<Width, AddrShift, READ>::read_flags(offs_t offset, uX mem_mask) const
 {
 	return std::pair<uX, u16>(read_impl<READ>(offset, mem_mask), this->m_flags);
@@ -150,6 +155,11 @@ template<int Width, int AddrShift, typename WRITE> void handler_entry_write_dele
 	write_impl<WRITE>(offset, data, mem_mask);
 }
 
+template<int Width, int AddrShift, typename WRITE> void handler_entry_write_delegate<Width, AddrShift, WRITE>::direct_write(const handler_entry_write<Width, AddrShift> &handler, offs_t offset, uX data, uX mem_mask)
+{
+	static_cast<const handler_entry_write_delegate<Width, AddrShift, WRITE> &>(handler).template write_impl<WRITE>(offset, data, mem_mask);
+}
+
 template<int Width, int AddrShift, typename WRITE> u16 handler_entry_write_delegate<Width, AddrShift, WRITE>::write_flags(offs_t offset, uX data, uX mem_mask) const
 {
 	write_impl<WRITE>(offset, data, mem_mask);
@@ -14,7 +14,7 @@ template<int Width, int AddrShift, typename READ> class handler_entry_read_deleg
 public:
 	using uX = typename emu::detail::handler_entry_size<Width>::uX;
 
-	handler_entry_read_delegate(address_space *space, u16 flags, const READ &delegate) : handler_entry_read_address<Width, AddrShift>(space, flags), m_delegate(delegate) {}
+	handler_entry_read_delegate(address_space *space, u16 flags, const READ &delegate) : handler_entry_read_address<Width, AddrShift>(space, flags), m_delegate(delegate) { this->m_read_function = &direct_read; }
 	~handler_entry_read_delegate() = default;
 
 	uX read(offs_t offset, uX mem_mask) const override;
@@ -24,6 +24,8 @@ public:
 	std::string name() const override;
 
 private:
+	static uX direct_read(const handler_entry_read<Width, AddrShift> &handler, offs_t offset, uX mem_mask);
+
 	READ m_delegate;
 
 	template<typename R>
@@ -74,7 +76,7 @@ template<int Width, int AddrShift, typename WRITE> class handler_entry_write_del
 public:
 	using uX = typename emu::detail::handler_entry_size<Width>::uX;
 
-	handler_entry_write_delegate(address_space *space, u16 flags, const WRITE &delegate) : handler_entry_write_address<Width, AddrShift>(space, flags), m_delegate(delegate) {}
+	handler_entry_write_delegate(address_space *space, u16 flags, const WRITE &delegate) : handler_entry_write_address<Width, AddrShift>(space, flags), m_delegate(delegate) { this->m_write_function = &direct_write; }
 	~handler_entry_write_delegate() = default;
 
 	void write(offs_t offset, uX data, uX mem_mask) const override;
@@ -84,6 +86,8 @@ public:
 	std::string name() const override;
 
 private:
+	static void direct_write(const handler_entry_write<Width, AddrShift> &handler, offs_t offset, uX data, uX mem_mask);
+
 	WRITE m_delegate;
 
 	template<typename W>
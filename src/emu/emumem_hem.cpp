@@ -25,6 +25,14 @@ template<int Width, int AddrShift> void *handler_entry_read_memory<Width, AddrSh
 	return m_base + (((offset - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift));
 }
 
+template<int Width, int AddrShift> void *handler_entry_read_memory<Width, AddrShift>::get_direct_ptr(offs_t start, offs_t end) const
+{
+	// only usable if no mirroring happens inside the range
+	offs_t const first = ((start - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift);
+	offs_t const last = ((end - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift);
+	return ((last - first) == ((end - start) >> (Width + AddrShift))) ? m_base + first : nullptr;
+}
+
 template<int Width, int AddrShift> std::string handler_entry_read_memory<Width, AddrShift>::name() const
 {
 	return util::string_format("memory@%x", this->m_address_base);
@@ -35,12 +43,16 @@ template<int Width, int AddrShift> void handler_entry_write_memory<Width, AddrSh
 {
 	offs_t off = ((offset - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift);
 	m_base[off] = (m_base[off] & ~mem_mask) | (data & mem_mask);
+	if(m_dirty_share)
+		m_dirty_share->mark_dirty(m_base + off);
 }
 
 template<int Width, int AddrShift> u16 handler_entry_write_memory<Width, AddrShift>::write_flags(offs_t offset, uX data, uX mem_mask) const
 {
 	offs_t off = ((offset - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift);
 	m_base[off] = (m_base[off] & ~mem_mask) | (data & mem_mask);
+	if(m_dirty_share)
+		m_dirty_share->mark_dirty(m_base + off);
 	return this->m_flags;
 }
 
@@ -51,20 +63,53 @@ template<int Width, int AddrShift> u16 handler_entry_write_memory<Width, AddrShi
 
 template<> void handler_entry_write_memory<0, 0>::write(offs_t offset, u8 data, u8 mem_mask) const
 {
-	m_base[(offset - this->m_address_base) & this->m_address_mask] = data;
+	offs_t off = (offset - this->m_address_base) & this->m_address_mask;
+	m_base[off] = data;
+	if(m_dirty_share)
+		m_dirty_share->mark_dirty(m_base + off);
 }
 
 template<> u16 handler_entry_write_memory<0, 0>::write_flags(offs_t offset, u8 data, u8 mem_mask) const
 {
-	m_base[(offset - this->m_address_base) & this->m_address_mask] = data;
+	offs_t off = (offset - this->m_address_base) & this->m_address_mask;
+	m_base[off] = data;
+	if(m_dirty_share)
+		m_dirty_share->mark_dirty(m_base + off);
 	return this->m_flags;
 }
 
+template<int Width, int AddrShift> typename emu::detail::handler_entry_size<Width>::uX handler_entry_read_memory<Width, AddrShift>::direct_read(const handler_entry_read<Width, AddrShift> &handler, offs_t offset, uX mem_mask)
+{
+	return static_cast<const handler_entry_read_memory<Width, AddrShift> &>(handler).handler_entry_read_memory::read(offset, mem_mask);
+}
+
+template<int Width, int AddrShift> void handler_entry_write_memory<Width, AddrShift>::direct_write(const handler_entry_write<Width, AddrShift> &handler, offs_t offset, uX data, uX mem_mask)
+{
+	static_cast<const handler_entry_write_memory<Width, AddrShift> &>(handler).handler_entry_write_memory::write(offset, data, mem_mask);
+}
+
 template<int Width, int AddrShift> void *handler_entry_write_memory<Width, AddrShift>::get_ptr(offs_t offset) const
 {
 	return m_base + (((offset - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift));
 }
 
+template<int Width, int AddrShift> void *handler_entry_write_memory<Width, AddrShift>::get_direct_ptr(offs_t start, offs_t end) const
+{
+	// tracked writes have to come through here
+	if(m_dirty_share)
+		return nullptr;
+
+	// only usable if no mirroring happens inside the range
+	offs_t const first = ((start - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift);
+	offs_t const last = ((end - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift);
+	return ((last - first) == ((end - start) >> (Width + AddrShift))) ? m_base + first : nullptr;
+}
+
+template<int Width, int AddrShift> void handler_entry_write_memory<Width, AddrShift>::set_dirty_tracking(bool enable)
+{
+	m_dirty_share = enable ? this->m_space->manager().dirty_share(m_base) : nullptr;
+}
+
 template<int Width, int AddrShift> std::string handler_entry_write_memory<Width, AddrShift>::name() const
 {
 	return util::string_format("memory@%x", this->m_address_base);
@@ -104,12 +149,16 @@ template<int Width, int AddrShift> void handler_entry_write_memory_bank<Width, A
 {
 	offs_t off = ((offset - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift);
 	static_cast<uX *>(m_bank.base())[off] = (static_cast<uX *>(m_bank.base())[off] & ~mem_mask) | (data & mem_mask);
+	if(m_track_dirty)
+		this->m_space->manager().mark_dirty(static_cast<uX *>(m_bank.base()) + off);
 }
 
 template<int Width, int AddrShift> u16 handler_entry_write_memory_bank<Width, AddrShift>::write_flags(offs_t offset, uX data, uX mem_mask) const
 {
 	offs_t off = ((offset - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift);
 	static_cast<uX *>(m_bank.base())[off] = (static_cast<uX *>(m_bank.base())[off] & ~mem_mask) | (data & mem_mask);
+	if(m_track_dirty)
+		this->m_space->manager().mark_dirty(static_cast<uX *>(m_bank.base()) + off);
 	return this->m_flags;
 }
 
@@ -120,12 +169,18 @@ template<int Width, int AddrShift> u16 handler_entry_write_memory_bank<Width, Ad
 
 template<> void handler_entry_write_memory_bank<0, 0>::write(offs_t offset, u8 data, u8 mem_mask) const
 {
-	static_cast<uX *>(m_bank.base())[(offset - this->m_address_base) & this->m_address_mask] = data;
+	offs_t off = (offset - this->m_address_base) & this->m_address_mask;
+	static_cast<uX *>(m_bank.base())[off] = data;
+	if(m_track_dirty)
+		this->m_space->manager().mark_dirty(static_cast<uX *>(m_bank.base()) + off);
 }
 
 template<> u16 handler_entry_write_memory_bank<0, 0>::write_flags(offs_t offset, u8 data, u8 mem_mask) const
 {
-	static_cast<uX *>(m_bank.base())[(offset - this->m_address_base) & this->m_address_mask] = data;
+	offs_t off = (offset - this->m_address_base) & this->m_address_mask;
+	static_cast<uX *>(m_bank.base())[off] = data;
+	if(m_track_dirty)
+		this->m_space->manager().mark_dirty(static_cast<uX *>(m_bank.base()) + off);
 	return this->m_flags;
 }
 
@@ -134,6 +189,11 @@ template<int Width, int AddrShift> void *handler_entry_write_memory_bank<Width,
 	return static_cast<uX *>(m_bank.base()) + (((offset - this->m_address_base) & this->m_address_mask) >> (Width + AddrShift));
 }
 
+template<int Width, int AddrShift> void handler_entry_write_memory_bank<Width, AddrShift>::set_dirty_tracking(bool enable)
+{
+	m_track_dirty = enable;
+}
+
 template<int Width, int AddrShift> std::string handler_entry_write_memory_bank<Width, AddrShift>::name() const
 {
 	return m_bank.name();
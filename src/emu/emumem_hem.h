@@ -14,17 +14,20 @@ template<int Width, int AddrShift> class handler_entry_read_memory : public hand
 public:
 	using uX = typename emu::detail::handler_entry_size<Width>::uX;
 
-	handler_entry_read_memory(address_space *space, u16 flags, void *base) : handler_entry_read_address<Width, AddrShift>(space, flags), m_base(reinterpret_cast<uX *>(base)) {}
+	handler_entry_read_memory(address_space *space, u16 flags, void *base) : handler_entry_read_address<Width, AddrShift>(space, flags), m_base(reinterpret_cast<uX *>(base)) { this->m_read_function = &direct_read; }
 	~handler_entry_read_memory() = default;
 
 	uX read(offs_t offset, uX mem_mask) const override;
 	std::pair<uX, u16> read_flags(offs_t offset, uX mem_mask) const override;
 	u16 lookup_flags(offs_t offset, uX mem_mask) const override;
 	void *get_ptr(offs_t offset) const override;
+	void *get_direct_ptr(offs_t start, offs_t end) const override;
 
 	std::string name() const override;
 
 private:
+	static uX direct_read(const handler_entry_read<Width, AddrShift> &handler, offs_t offset, uX mem_mask);
+
 	uX *m_base;
 };
 
@@ -33,18 +36,28 @@ template<int Width, int AddrShift> class handler_entry_write_memory : public han
 public:
 	using uX = typename emu::detail::handler_entry_size<Width>::uX;
 
-	handler_entry_write_memory(address_space *space, u16 flags, void *base) : handler_entry_write_address<Width, AddrShift>(space, flags), m_base(reinterpret_cast<uX *>(base)) {}
+	handler_entry_write_memory(address_space *space, u16 flags, void *base) : handler_entry_write_address<Width, AddrShift>(space, flags), m_base(reinterpret_cast<uX *>(base)), m_dirty_share(nullptr)
+	{
+		this->m_write_function = &direct_write;
+		if (space->manager().dirty_tracking())
+			set_dirty_tracking(true);
+	}
 	~handler_entry_write_memory() = default;
 
 	void write(offs_t offset, uX data, uX mem_mask) const override;
 	u16 write_flags(offs_t offset, uX data, uX mem_mask) const override;
 	u16 lookup_flags(offs_t offset, uX mem_mask) const override;
 	void *get_ptr(offs_t offset) const override;
+	void *get_direct_ptr(offs_t start, offs_t end) const override;
+	void set_dirty_tracking(bool enable) override;
 
 	std::string name() const override;
 
 private:
+	static void direct_write(const handler_entry_write<Width, AddrShift> &handler, offs_t offset, uX data, uX mem_mask);
+
 	uX *m_base;
+	memory_share *m_dirty_share;
 };
 
 
@@ -76,18 +89,20 @@ template<int Width, int AddrShift> class handler_entry_write_memory_bank : publi
 public:
 	using uX = typename emu::detail::handler_entry_size<Width>::uX;
 
-	handler_entry_write_memory_bank(address_space *space, u16 flags, memory_bank &bank) : handler_entry_write_address<Width, AddrShift>(space, flags), m_bank(bank) {}
+	handler_entry_write_memory_bank(address_space *space, u16 flags, memory_bank &bank) : handler_entry_write_address<Width, AddrShift>(space, flags), m_bank(bank), m_track_dirty(space->manager().dirty_tracking()) {}
 	~handler_entry_write_memory_bank() = default;
 
 	void write(offs_t offset, uX data, uX mem_mask) const override;
 	u16 write_flags(offs_t offset, uX data, uX mem_mask) const override;
 	u16 lookup_flags(offs_t offset, uX mem_mask) const override;
 	void *get_ptr(offs_t offset) const override;
+	void set_dirty_tracking(bool enable) override;
 
 	std::string name() const override;
 
 private:
 	memory_bank &m_bank;
+	bool m_track_dirty;     // the bank may be switched into a tracked share at any time
 };
 
 #endif // MAME_EMU_EMUMEM_HEM_H
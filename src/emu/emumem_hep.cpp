@@ -50,6 +50,12 @@ template<int Width, int AddrShift> void handler_entry_write_passthrough<Width, A
 		np->detach(handlers);
 }
 
+template<int Width, int AddrShift> void handler_entry_write_passthrough<Width, AddrShift>::set_dirty_tracking(bool enable)
+{
+	if(m_next)
+		m_next->set_dirty_tracking(enable);
+}
+
 template class handler_entry_read_passthrough<0,  1>;
 template class handler_entry_read_passthrough<0,  0>;
 template class handler_entry_read_passthrough<1,  3>;
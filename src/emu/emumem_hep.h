@@ -39,6 +39,7 @@ public:
 	handler_entry_write<Width, AddrShift> *get_subhandler() const { return m_next; }
 
 	void detach(const std::unordered_set<handler_entry *> &handlers) override;
+	void set_dirty_tracking(bool enable) override;
 
 protected:
 	emu::detail::memory_passthrough_handler_impl &m_mph;
@@ -250,6 +250,12 @@ template<int Width, int AddrShift> void handler_entry_write_units<Width, AddrShi
 		refs.add(m_subunit_infos[i].m_handler);
 }
 
+template<int Width, int AddrShift> void handler_entry_write_units<Width, AddrShift>::set_dirty_tracking(bool enable)
+{
+	for(u32 i=0; i != m_subunits; i++)
+		m_subunit_infos[i].m_handler->set_dirty_tracking(enable);
+}
+
 template<int Width, int AddrShift> void handler_entry_write_units<Width, AddrShift>::fill(const memory_units_descriptor<Width, AddrShift> &descriptor, const std::vector<typename memory_units_descriptor<Width, AddrShift>::entry> &entries)
 {
 	handler_entry *handler = descriptor.get_subunit_handler();
@@ -69,6 +69,7 @@ public:
 	std::string name() const override;
 
 	void enumerate_references(handler_entry::reflist &refs) const override;
+	void set_dirty_tracking(bool enable) override;
 	handler_entry_write<Width, AddrShift> *dup() override;
 
 private:
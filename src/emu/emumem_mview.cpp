@@ -484,6 +484,17 @@ memory_view::memory_view_entry &memory_view::operator[](int slot)
 		m_entries.resize(id+1);
 		m_entries[id].reset(e);
 		m_entry_mapping[slot] = id;
+
+		// keep a flat table for select() unless the slots are very sparse
+		int const first = m_entry_mapping.begin()->first;
+		int const last = m_entry_mapping.rbegin()->first;
+		m_slot_ids.clear();
+		if (s64(last) - first < 256) {
+			m_slot_base = first;
+			m_slot_ids.resize(last - first + 1, -1);
+			for (auto const &p : m_entry_mapping)
+				m_slot_ids[p.first - first] = p.second;
+		}
 		if (m_handler_read) {
 			m_handler_read->select_u(id);
 			m_handler_write->select_u(id);
@@ -630,7 +641,7 @@ std::string memory_view::memory_view_entry::key() const
 }
 
 
-memory_view::memory_view(device_t &device, std::string name) : m_device(device), m_name(name), m_config(nullptr), m_addrstart(0), m_addrend(0), m_space(nullptr), m_handler_read(nullptr), m_handler_write(nullptr), m_cur_id(-1), m_cur_slot(-1)
+memory_view::memory_view(device_t &device, std::string name) : m_device(device), m_name(name), m_slot_base(0), m_config(nullptr), m_addrstart(0), m_addrend(0), m_space(nullptr), m_handler_read(nullptr), m_handler_write(nullptr), m_cur_id(-1), m_cur_slot(-1)
 {
 	device.view_register(this);
 }
@@ -647,11 +658,21 @@ void memory_view::register_state()
 {
 	m_device.machine().save().save_item(&m_device, "view", m_device.subtag(m_name).c_str(), 0, NAME(m_cur_slot));
 	m_device.machine().save().save_item(&m_device, "view", m_device.subtag(m_name).c_str(), 0, NAME(m_cur_id));
-	m_device.machine().save().register_postload(save_prepost_delegate(NAME([this]() { m_handler_read->select_a(m_cur_id); m_handler_write->select_a(m_cur_id); })));
+	m_device.machine().save().register_postload(save_prepost_delegate(NAME([this]() {
+		m_handler_read->select_a(m_cur_id);
+		m_handler_write->select_a(m_cur_id);
+		if(m_space)
+			m_space->invalidate_caches(read_or_write::READWRITE);
+	})));
 }
 
 void memory_view::disable()
 {
+	// drivers often rewrite the same bank register value, and the
+	// cache invalidation is the expensive part of a switch
+	if(m_cur_id == -1)
+		return;
+
 	m_cur_slot = -1;
 	m_cur_id = -1;
 	m_handler_read->select_a(-1);
@@ -663,12 +684,17 @@ void memory_view::disable()
 
 void memory_view::select(int slot)
 {
-	auto i = m_entry_mapping.find(slot);
-	if (i == m_entry_mapping.end())
+	int const id = slot_to_id(slot);
+	if (id == -1)
 		fatalerror("memory_view %s: select of unknown slot %d", m_name, slot);
 
+	// each entry's dispatch tables are built up front, so switching is
+	// just a pointer swap and there is nothing to do for the current one
+	if (id == m_cur_id)
+		return;
+
 	m_cur_slot = slot;
-	m_cur_id = i->second;
+	m_cur_id = id;
 	m_handler_read->select_a(m_cur_id);
 	m_handler_write->select_a(m_cur_id);
 
@@ -676,6 +702,16 @@ void memory_view::select(int slot)
 		m_space->invalidate_caches(read_or_write::READWRITE);
 }
 
+int memory_view::slot_to_id(int slot) const
+{
+	if (!m_slot_ids.empty()) {
+		u32 const index = u32(slot - m_slot_base);
+		return (index < m_slot_ids.size()) ? m_slot_ids[index] : -1;
+	}
+	auto i = m_entry_mapping.find(slot);
+	return (i != m_entry_mapping.end()) ? i->second : -1;
+}
+
 int memory_view::id_to_slot(int id) const
 {
 	for(const auto &p : m_entry_mapping)
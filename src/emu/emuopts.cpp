@@ -17,6 +17,7 @@
 #include "corestr.h"
 #include "path.h"
 
+#include <algorithm>
 #include <stack>
 
 
@@ -61,6 +62,12 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DIFF_DIRECTORY,                             "diff",      core_options::option_type::STRING,     "directory to save hard drive image difference files" },
 	{ OPTION_COMMENT_DIRECTORY,                          "comments",  core_options::option_type::STRING,     "directory to save debugger comments" },
 	{ OPTION_SHARE_DIRECTORY,                            "share",     core_options::option_type::STRING,     "directory to share with emulated machines" },
+	{ OPTION_ROMCACHE_DIRECTORY,                         "",          core_options::option_type::STRING,     "directory to cache decompressed ROMs in, to avoid unpacking archives on every start" },
+	{ OPTION_SHAREDROM_DIRECTORY,                        "",          core_options::option_type::STRING,     "directory to cache loaded ROM regions in, so they can be memory-mapped and shared between instances" },
+	{ OPTION_AUDITCACHE_DIRECTORY,                       "",          core_options::option_type::STRING,     "directory to keep media audit results in, so unchanged files are not hashed again" },
+	{ OPTION_SOFTLISTCACHE_DIRECTORY,                    "",          core_options::option_type::STRING,     "directory to keep compiled software lists in, so unchanged XML files are not parsed again" },
+	{ OPTION_DRCCACHE_DIRECTORY,                         "",          core_options::option_type::STRING,     "directory to keep lists of recompiled code blocks in, so they can be compiled ahead of use next time" },
+	{ OPTION_DERIVEDCACHE_DIRECTORY,                     "",          core_options::option_type::STRING,     "directory to keep data decrypted from ROMs in, so it isn't decrypted again on every start" },
 
 	// state/playback options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE STATE/PLAYBACK OPTIONS" },
@@ -71,27 +78,45 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_PLAYBACK ";pb",                             nullptr,     core_options::option_type::STRING,     "playback an input file" },
 	{ OPTION_RECORD ";rec",                              nullptr,     core_options::option_type::STRING,     "record an input file" },
 	{ OPTION_EXIT_AFTER_PLAYBACK,                        "0",         core_options::option_type::BOOLEAN,    "close the program at the end of playback" },
+	{ OPTION_PLAYBACK_OFFSET,                            "0",         core_options::option_type::INTEGER,    "start playback from the last keyframe at or before this many seconds of emulated time" },
+	{ OPTION_RECORD_KEYFRAMES,                           "0",         core_options::option_type::INTEGER,    "minutes of emulated time between save state keyframes in input recordings (0 = none)" },
 
 	{ OPTION_MNGWRITE,                                   nullptr,     core_options::option_type::STRING,     "optional filename to write a MNG movie of the current session" },
 	{ OPTION_AVIWRITE,                                   nullptr,     core_options::option_type::STRING,     "optional filename to write an AVI movie of the current session" },
-	{ OPTION_WAVWRITE,                                   nullptr,     core_options::option_type::STRING,     "optional filename to write a WAV file of the current session" },
+	{ OPTION_WAVWRITE,                                   nullptr,     core_options::option_type::STRING,     "optional filename to write a WAV file (or FLAC file if it ends in .flac) of the current session" },
 	{ OPTION_SNAPNAME,                                   "%g/%i",     core_options::option_type::STRING,     "override of the default snapshot/movie naming; %g == gamename, %i == index" },
 	{ OPTION_SNAPSIZE,                                   "auto",      core_options::option_type::STRING,     "specify snapshot/movie resolution (<width>x<height>) or 'auto' to use minimal size " },
 	{ OPTION_SNAPVIEW,                                   "auto",      core_options::option_type::STRING,     "snapshot/movie view - 'auto' for default, or 'native' for per-screen pixel-aspect views" },
 	{ OPTION_SNAPBILINEAR,                               "1",         core_options::option_type::BOOLEAN,    "specify if the snapshot/movie should have bilinear filtering applied" },
 	{ OPTION_STATENAME,                                  "%g",        core_options::option_type::STRING,     "override of the default state subfolder naming; %g == gamename" },
 	{ OPTION_BURNIN,                                     "0",         core_options::option_type::BOOLEAN,    "create burn-in snapshots for each screen" },
+	{ OPTION_EXPORT,                                     nullptr,     core_options::option_type::STRING,     "name of a shared memory object to publish every frame's screens and memory ranges to" },
+	{ OPTION_EXPORT_MEMORY,                              nullptr,     core_options::option_type::STRING,     "comma-separated memory ranges to export, as <tag>:<space>:<start>-<end> in hexadecimal" },
+	{ OPTION_EXPORT_SLOTS "(1-64)",                      "4",         core_options::option_type::INTEGER,    "number of frames the shared memory export ring holds" },
+	{ OPTION_EXPORT_LOCKSTEP,                            "0",         core_options::option_type::BOOLEAN,    "wait for the export consumer to acknowledge each frame before continuing" },
 
 	// performance options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE PERFORMANCE OPTIONS" },
 	{ OPTION_AUTOFRAMESKIP ";afs",                       "0",         core_options::option_type::BOOLEAN,    "enable automatic frameskip adjustment to maintain emulation speed" },
 	{ OPTION_FRAMESKIP ";fs(0-10)",                      "0",         core_options::option_type::INTEGER,    "set frameskip to fixed value, 0-10 (upper limit with autoframeskip)" },
 	{ OPTION_SECONDS_TO_RUN ";str",                      "0",         core_options::option_type::INTEGER,    "number of emulated seconds to run before automatically exiting" },
+	{ OPTION_BATCH,                                      "0",         core_options::option_type::BOOLEAN,    "run headless as fast as possible: no drawing, user interface, throttling or sound output" },
+	{ OPTION_BATCH_FRAMES,                               "0",         core_options::option_type::INTEGER,    "number of frames to run before automatically exiting (0 for no limit)" },
 	{ OPTION_THROTTLE,                                   "1",         core_options::option_type::BOOLEAN,    "throttle emulation to keep system running in sync with real time" },
 	{ OPTION_SLEEP,                                      "1",         core_options::option_type::BOOLEAN,    "enable sleeping, which gives time back to other applications when idle" },
 	{ OPTION_SPEED "(0.01-100)",                         "1.0",       core_options::option_type::FLOAT,      "controls the speed of gameplay, relative to realtime; smaller numbers are slower" },
 	{ OPTION_REFRESHSPEED ";rs",                         "0",         core_options::option_type::BOOLEAN,    "automatically adjust emulation speed to keep the emulated refresh rate slower than the host screen" },
 	{ OPTION_LOWLATENCY ";lolat",                        "0",         core_options::option_type::BOOLEAN,    "draws new frame before throttling to reduce input latency" },
+	{ OPTION_RUNAHEAD "(0-8)",                           "0",         core_options::option_type::INTEGER,    "number of frames to emulate ahead of the displayed one using save states, hiding the system's own input lag" },
+	{ OPTION_RENDER_THREAD,                              "0",         core_options::option_type::BOOLEAN,    "build each frame's render primitives on a separate thread while emulation continues, adding a frame of latency" },
+	{ OPTION_IDLEDETECT ";idle",                         "0",         core_options::option_type::BOOLEAN,    "skip to the end of the timeslice when a CPU is spinning in an idle loop" },
+	{ OPTION_MAPPED_RAM,                                 "0",         core_options::option_type::BOOLEAN,    "allocate large RAM areas as page-aligned private mappings, shared copy-on-write after fork()" },
+	{ OPTION_LARGE_PAGES,                                "1",         core_options::option_type::BOOLEAN,    "back large ROM regions and RAM areas with huge pages where the OS allows it" },
+	{ OPTION_PREDECODE_GFX,                              "0",         core_options::option_type::BOOLEAN,    "decode all graphics at startup on every processor instead of as they are first drawn" },
+	{ OPTION_TELEMETRY,                                  nullptr,     core_options::option_type::STRING,     "write per-frame performance figures to the specified file, as JSON lines or as CSV if it ends in .csv" },
+	{ OPTION_TELEMETRY_OUTPUTS,                          "0",         core_options::option_type::BOOLEAN,    "publish per-frame performance figures as telemetry_* outputs" },
+	{ OPTION_FRAMEHASH,                                  nullptr,     core_options::option_type::STRING,     "write a hash of each frame's screens and sound to the specified file" },
+	{ OPTION_FRAMEHASH_CHECK,                            nullptr,     core_options::option_type::STRING,     "check the hash of each frame's screens and sound against the specified file, failing on the first difference" },
 
 	// render options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE RENDER OPTIONS" },
@@ -143,6 +168,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_VOLUME ";vol",                              "0",         core_options::option_type::INTEGER,    "sound volume in decibels (-32 min, 0 max)" },
 	{ OPTION_COMPRESSOR,                                 "1",         core_options::option_type::BOOLEAN,    "enable compressor for sound" },
 	{ OPTION_SPEAKER_REPORT "(0-4)",                     "0",         core_options::option_type::INTEGER,    "print report of speaker ouput maxima (0=none, or 1-4 for more detail)" },
+	{ OPTION_SOUND_THREADS,                              "0",         core_options::option_type::BOOLEAN,    "generate independent sound streams on worker threads at the end of each update" },
 
 	// input options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE INPUT OPTIONS" },
@@ -162,6 +188,8 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_NATURAL_KEYBOARD ";nat",                    "0",         core_options::option_type::BOOLEAN,    "specifies whether to use a natural keyboard or not" },
 	{ OPTION_JOYSTICK_CONTRADICTORY ";joy_contradictory","0",         core_options::option_type::BOOLEAN,    "enable contradictory direction digital joystick input at the same time" },
 	{ OPTION_COIN_IMPULSE,                               "0",         core_options::option_type::INTEGER,    "set coin impulse time (n<0 disable impulse, n==0 obey driver, 0<n set time n)" },
+	{ OPTION_INPUT_POLLS "(1-16)",                       "1",         core_options::option_type::INTEGER,    "number of times to poll input devices during each emulated frame" },
+	{ OPTION_INPUT_POLL_ON_READ,                         "0",         core_options::option_type::BOOLEAN,    "also poll input devices when the emulated system reads an input port, at most once per poll interval" },
 
 	// input autoenable options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE INPUT AUTOMATIC ENABLE OPTIONS" },
@@ -183,6 +211,9 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_UPDATEINPAUSE,                              "0",         core_options::option_type::BOOLEAN,    "keep calling video updates while in pause" },
 	{ OPTION_DEBUGSCRIPT,                                nullptr,     core_options::option_type::STRING,     "script for debugger" },
 	{ OPTION_DEBUGLOG,                                   "0",         core_options::option_type::BOOLEAN,    "write debug console output to debug.log" },
+	{ OPTION_SCHEDTRACE,                                 nullptr,     core_options::option_type::STRING,     "record scheduler activity to the specified binary trace file" },
+	{ OPTION_STARTUPPROFILE,                             nullptr,     core_options::option_type::STRING,     "write a JSON report of the time taken by each startup phase and device to the specified file" },
+	{ OPTION_PROFILETRACE,                               nullptr,     core_options::option_type::STRING,     "write a Chrome trace of profiled scopes and per-frame histograms to the specified file (needs a profiler build)" },
 
 	// comm options
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "CORE COMM OPTIONS" },
@@ -198,6 +229,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_DRC_USE_C,                                  "0",         core_options::option_type::BOOLEAN,    "force DRC to use C backend" },
 	{ OPTION_DRC_LOG_UML,                                "0",         core_options::option_type::BOOLEAN,    "write DRC UML disassembly log" },
 	{ OPTION_DRC_LOG_NATIVE,                             "0",         core_options::option_type::BOOLEAN,    "write DRC native disassembly log" },
+	{ OPTION_DRC_PROFILE,                                "0",         core_options::option_type::BOOLEAN,    "collect DRC block entry counts and compile statistics" },
 	{ OPTION_BIOS,                                       nullptr,     core_options::option_type::STRING,     "select the system BIOS to use" },
 	{ OPTION_CHEAT ";c",                                 "0",         core_options::option_type::BOOLEAN,    "enable cheat subsystem" },
 	{ OPTION_SKIP_GAMEINFO,                              "0",         core_options::option_type::BOOLEAN,    "skip displaying the system information screen at startup" },
@@ -208,6 +240,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_UI_MOUSE,                                   "1",         core_options::option_type::BOOLEAN,    "display UI mouse cursor" },
 	{ OPTION_LANGUAGE ";lang",                           "",          core_options::option_type::STRING,     "set UI display language" },
 	{ OPTION_NVRAM_SAVE ";nvwrite",                      "1",         core_options::option_type::BOOLEAN,    "save NVRAM data on exit" },
+	{ OPTION_ROMCACHE_SIZE,                              "1024",      core_options::option_type::INTEGER,    "maximum size of the decompressed ROM cache in megabytes" },
 
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "SCRIPTING OPTIONS" },
 	{ OPTION_AUTOBOOT_COMMAND ";ab",                     nullptr,     core_options::option_type::STRING,     "command to execute after machine boot" },
@@ -217,12 +250,21 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_PLUGINS,                                    "1",         core_options::option_type::BOOLEAN,    "enable Lua plugin support" },
 	{ OPTION_PLUGIN,                                     nullptr,     core_options::option_type::STRING,     "list of plugins to enable" },
 	{ OPTION_NO_PLUGIN,                                  nullptr,     core_options::option_type::STRING,     "list of plugins to disable" },
+	{ OPTION_NATIVE_PLUGIN,                              nullptr,     core_options::option_type::STRING,     "list of native plugin libraries to load, separated by semicolons" },
 
 	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "HTTP SERVER OPTIONS" },
 	{ OPTION_HTTP,                                       "0",         core_options::option_type::BOOLEAN,    "enable HTTP server" },
 	{ OPTION_HTTP_PORT,                                  "8080",      core_options::option_type::INTEGER,    "HTTP server port" },
 	{ OPTION_HTTP_ROOT,                                  "web",       core_options::option_type::STRING,     "HTTP server document root" },
 
+	{ nullptr,                                           nullptr,     core_options::option_type::HEADER,     "NETPLAY OPTIONS" },
+	{ OPTION_NETPLAY_PORT "(0-65535)",                   "0",         core_options::option_type::INTEGER,    "local UDP port for rollback netplay (0 = disabled)" },
+	{ OPTION_NETPLAY_PEER,                               "",          core_options::option_type::STRING,     "host:port of the other player; leave empty to wait for the peer to connect" },
+	{ OPTION_NETPLAY_PLAYER "(0-1)",                     "0",         core_options::option_type::INTEGER,    "inputs this instance supplies: 0 for everything but player 2, 1 for player 2" },
+	{ OPTION_NETPLAY_DELAY "(0-8)",                      "1",         core_options::option_type::INTEGER,    "frames of delay added to local input to reduce rollbacks" },
+	{ OPTION_NETPLAY_ROLLBACK "(1-15)",                  "8",         core_options::option_type::INTEGER,    "maximum number of frames to roll back before waiting for the peer" },
+	{ OPTION_NETPLAY_BENCHMARK "(0-15)",                 "0",         core_options::option_type::INTEGER,    "without a peer, roll back this many frames every frame and report the cost" },
+
 	{ nullptr }
 };
 
@@ -433,6 +475,7 @@ emu_options::emu_options(option_support support)
 	, m_sleep(true)
 	, m_refresh_speed(false)
 	, m_ui(UI_CABINET)
+	, m_shared_config_generation(0)
 {
 	// add entries
 	if (support == option_support::FULL || support == option_support::GENERAL_AND_SYSTEM)
@@ -519,6 +562,9 @@ void emu_options::set_system_name(std::string &&new_system_name)
 
 void emu_options::update_slot_and_image_options()
 {
+	// configurations built before this may have the wrong devices
+	configs_changed();
+
 	bool changed;
 	do
 	{
@@ -540,6 +586,60 @@ void emu_options::update_slot_and_image_options()
 }
 
 
+//-------------------------------------------------
+//  shared_config - get a machine configuration
+//  for a driver, reusing a recently built one if
+//  slot and image options haven't changed since
+//-------------------------------------------------
+
+std::shared_ptr<machine_config> emu_options::shared_config(const game_driver &driver)
+{
+	constexpr std::size_t SHARED_CONFIG_COUNT = 32;
+
+	u64 generation;
+	{
+		std::lock_guard<std::mutex> lock(m_shared_config_mutex);
+		auto const found(std::find_if(
+				m_shared_configs.begin(),
+				m_shared_configs.end(),
+				[&driver] (std::shared_ptr<machine_config> const &config) { return &config->gamedrv() == &driver; }));
+		if (m_shared_configs.end() != found)
+		{
+			std::rotate(m_shared_configs.begin(), found, std::next(found));
+			return m_shared_configs.front();
+		}
+		generation = m_shared_config_generation;
+	}
+
+	// build it outside the lock - it's slow, and may look at options
+	auto result(std::make_shared<machine_config>(driver, *this));
+
+	// don't keep it if the options changed while it was being built
+	std::lock_guard<std::mutex> lock(m_shared_config_mutex);
+	if (generation == m_shared_config_generation)
+	{
+		if (m_shared_configs.size() >= SHARED_CONFIG_COUNT)
+			m_shared_configs.pop_back();
+		m_shared_configs.emplace(m_shared_configs.begin(), result);
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  configs_changed - forget shared machine
+//  configurations when slot or image options
+//  change
+//-------------------------------------------------
+
+void emu_options::configs_changed()
+{
+	std::lock_guard<std::mutex> lock(m_shared_config_mutex);
+	m_shared_configs.clear();
+	m_shared_config_generation++;
+}
+
+
 //-------------------------------------------------
 //  add_and_remove_slot_options - add any missing
 //  and/or purge extraneous slot options
@@ -1152,6 +1252,7 @@ void slot_option::specify(std::string &&text, bool peg_priority)
 	conditionally_peg_priority(m_entry, peg_priority);
 
 	// we may have changed
+	m_host.configs_changed();
 	possibly_changed(old_value);
 }
 
@@ -1184,6 +1285,7 @@ void slot_option::specify(std::string_view text, bool peg_priority)
 	conditionally_peg_priority(m_entry, peg_priority);
 
 	// we may have changed
+	m_host.configs_changed();
 	possibly_changed(old_value);
 }
 
@@ -1199,6 +1301,7 @@ void slot_option::set_default_card_software(std::string &&s)
 
 	// update the default card software
 	m_default_card_software = std::move(s);
+	m_host.configs_changed();
 
 	// we may have changed
 	possibly_changed(old_value);
@@ -1271,6 +1374,7 @@ void image_option::specify(std::string_view value, bool peg_priority)
 	if (value != m_value)
 	{
 		m_value = value;
+		m_host.configs_changed();
 		m_host.reevaluate_default_card_software();
 	}
 	conditionally_peg_priority(m_entry, peg_priority);
@@ -1281,6 +1385,7 @@ void image_option::specify(std::string &&value, bool peg_priority)
 	if (value != m_value)
 	{
 		m_value = std::move(value);
+		m_host.configs_changed();
 		m_host.reevaluate_default_card_software();
 	}
 	conditionally_peg_priority(m_entry, peg_priority);
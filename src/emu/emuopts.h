@@ -15,6 +15,10 @@
 
 #include "options.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #define OPTION_PRIORITY_CMDLINE     OPTION_PRIORITY_HIGH + 1
 // core options
 #define OPTION_SYSTEMNAME           core_options::unadorned(0)
@@ -48,6 +52,12 @@
 #define OPTION_DIFF_DIRECTORY       "diff_directory"
 #define OPTION_COMMENT_DIRECTORY    "comment_directory"
 #define OPTION_SHARE_DIRECTORY      "share_directory"
+#define OPTION_SHAREDROM_DIRECTORY  "sharedrom_directory"
+#define OPTION_ROMCACHE_DIRECTORY   "romcache_directory"
+#define OPTION_AUDITCACHE_DIRECTORY "auditcache_directory"
+#define OPTION_SOFTLISTCACHE_DIRECTORY "softlistcache_directory"
+#define OPTION_DRCCACHE_DIRECTORY   "drccache_directory"
+#define OPTION_DERIVEDCACHE_DIRECTORY "derivedcache_directory"
 
 // core state/playback options
 #define OPTION_STATE                "state"
@@ -57,6 +67,8 @@
 #define OPTION_PLAYBACK             "playback"
 #define OPTION_RECORD               "record"
 #define OPTION_EXIT_AFTER_PLAYBACK  "exit_after_playback"
+#define OPTION_PLAYBACK_OFFSET      "playback_offset"
+#define OPTION_RECORD_KEYFRAMES     "record_keyframes"
 #define OPTION_MNGWRITE             "mngwrite"
 #define OPTION_AVIWRITE             "aviwrite"
 #define OPTION_WAVWRITE             "wavwrite"
@@ -66,16 +78,32 @@
 #define OPTION_SNAPBILINEAR         "snapbilinear"
 #define OPTION_STATENAME            "statename"
 #define OPTION_BURNIN               "burnin"
+#define OPTION_EXPORT               "export"
+#define OPTION_EXPORT_MEMORY        "exportmem"
+#define OPTION_EXPORT_SLOTS         "exportslots"
+#define OPTION_EXPORT_LOCKSTEP      "exportlockstep"
 
 // core performance options
 #define OPTION_AUTOFRAMESKIP        "autoframeskip"
 #define OPTION_FRAMESKIP            "frameskip"
 #define OPTION_SECONDS_TO_RUN       "seconds_to_run"
+#define OPTION_BATCH                "batch"
+#define OPTION_BATCH_FRAMES         "batchframes"
 #define OPTION_THROTTLE             "throttle"
 #define OPTION_SLEEP                "sleep"
 #define OPTION_SPEED                "speed"
 #define OPTION_REFRESHSPEED         "refreshspeed"
 #define OPTION_LOWLATENCY           "lowlatency"
+#define OPTION_RUNAHEAD             "runahead"
+#define OPTION_RENDER_THREAD        "renderthread"
+#define OPTION_IDLEDETECT           "idledetect"
+#define OPTION_MAPPED_RAM           "mappedram"
+#define OPTION_LARGE_PAGES          "largepages"
+#define OPTION_PREDECODE_GFX        "predecodegfx"
+#define OPTION_TELEMETRY            "telemetry"
+#define OPTION_TELEMETRY_OUTPUTS    "telemetryoutputs"
+#define OPTION_FRAMEHASH            "framehash"
+#define OPTION_FRAMEHASH_CHECK      "framehashcheck"
 
 // core render options
 #define OPTION_KEEPASPECT           "keepaspect"
@@ -121,6 +149,7 @@
 #define OPTION_VOLUME               "volume"
 #define OPTION_COMPRESSOR           "compressor"
 #define OPTION_SPEAKER_REPORT       "speaker_report"
+#define OPTION_SOUND_THREADS        "sound_threads"
 
 // core input options
 #define OPTION_COIN_LOCKOUT         "coin_lockout"
@@ -139,6 +168,8 @@
 #define OPTION_NATURAL_KEYBOARD     "natural"
 #define OPTION_JOYSTICK_CONTRADICTORY   "joystick_contradictory"
 #define OPTION_COIN_IMPULSE         "coin_impulse"
+#define OPTION_INPUT_POLLS          "inputpolls"
+#define OPTION_INPUT_POLL_ON_READ   "inputpollonread"
 
 // input autoenable options
 #define OPTION_PADDLE_DEVICE        "paddle_device"
@@ -158,12 +189,16 @@
 #define OPTION_UPDATEINPAUSE        "update_in_pause"
 #define OPTION_DEBUGSCRIPT          "debugscript"
 #define OPTION_DEBUGLOG             "debuglog"
+#define OPTION_SCHEDTRACE           "schedtrace"
+#define OPTION_STARTUPPROFILE       "startupprofile"
+#define OPTION_PROFILETRACE         "profiletrace"
 
 // core misc options
 #define OPTION_DRC                  "drc"
 #define OPTION_DRC_USE_C            "drc_use_c"
 #define OPTION_DRC_LOG_UML          "drc_log_uml"
 #define OPTION_DRC_LOG_NATIVE       "drc_log_native"
+#define OPTION_DRC_PROFILE          "drc_profile"
 #define OPTION_BIOS                 "bios"
 #define OPTION_CHEAT                "cheat"
 #define OPTION_SKIP_GAMEINFO        "skip_gameinfo"
@@ -171,6 +206,7 @@
 #define OPTION_UI                   "ui"
 #define OPTION_RAMSIZE              "ramsize"
 #define OPTION_NVRAM_SAVE           "nvram_save"
+#define OPTION_ROMCACHE_SIZE        "romcache_size"
 
 // core comm options
 #define OPTION_COMM_LOCAL_HOST      "comm_localhost"
@@ -190,6 +226,7 @@
 #define OPTION_PLUGINS              "plugins"
 #define OPTION_PLUGIN               "plugin"
 #define OPTION_NO_PLUGIN            "noplugin"
+#define OPTION_NATIVE_PLUGIN        "native_plugin"
 
 #define OPTION_LANGUAGE             "language"
 
@@ -197,12 +234,20 @@
 #define OPTION_HTTP_PORT            "http_port"
 #define OPTION_HTTP_ROOT            "http_root"
 
+#define OPTION_NETPLAY_PORT         "netplay_port"
+#define OPTION_NETPLAY_PEER         "netplay_peer"
+#define OPTION_NETPLAY_PLAYER       "netplay_player"
+#define OPTION_NETPLAY_DELAY        "netplay_delay"
+#define OPTION_NETPLAY_ROLLBACK     "netplay_rollback"
+#define OPTION_NETPLAY_BENCHMARK    "netplay_benchmark"
+
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
 
 class game_driver;
 class device_slot_interface;
+class machine_config;
 class emu_options;
 
 class slot_option
@@ -333,6 +378,12 @@ public:
 	const char *diff_directory() const { return value(OPTION_DIFF_DIRECTORY); }
 	const char *comment_directory() const { return value(OPTION_COMMENT_DIRECTORY); }
 	const char *share_directory() const { return value(OPTION_SHARE_DIRECTORY); }
+	const char *sharedrom_directory() const { return value(OPTION_SHAREDROM_DIRECTORY); }
+	const char *romcache_directory() const { return value(OPTION_ROMCACHE_DIRECTORY); }
+	const char *auditcache_directory() const { return value(OPTION_AUDITCACHE_DIRECTORY); }
+	const char *softlistcache_directory() const { return value(OPTION_SOFTLISTCACHE_DIRECTORY); }
+	const char *drccache_directory() const { return value(OPTION_DRCCACHE_DIRECTORY); }
+	const char *derivedcache_directory() const { return value(OPTION_DERIVEDCACHE_DIRECTORY); }
 
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
@@ -342,6 +393,8 @@ public:
 	const char *playback() const { return value(OPTION_PLAYBACK); }
 	const char *record() const { return value(OPTION_RECORD); }
 	bool exit_after_playback() const { return bool_value(OPTION_EXIT_AFTER_PLAYBACK); }
+	int playback_offset() const { return int_value(OPTION_PLAYBACK_OFFSET); }
+	int record_keyframes() const { return int_value(OPTION_RECORD_KEYFRAMES); }
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
 	const char *avi_write() const { return value(OPTION_AVIWRITE); }
 	const char *wav_write() const { return value(OPTION_WAVWRITE); }
@@ -351,16 +404,32 @@ public:
 	bool snap_bilinear() const { return bool_value(OPTION_SNAPBILINEAR); }
 	const char *state_name() const { return value(OPTION_STATENAME); }
 	bool burnin() const { return bool_value(OPTION_BURNIN); }
+	const char *export_name() const { return value(OPTION_EXPORT); }
+	const char *export_memory() const { return value(OPTION_EXPORT_MEMORY); }
+	int export_slots() const { return int_value(OPTION_EXPORT_SLOTS); }
+	bool export_lockstep() const { return bool_value(OPTION_EXPORT_LOCKSTEP); }
 
 	// core performance options
 	bool auto_frameskip() const { return bool_value(OPTION_AUTOFRAMESKIP); }
 	int frameskip() const { return int_value(OPTION_FRAMESKIP); }
 	int seconds_to_run() const { return int_value(OPTION_SECONDS_TO_RUN); }
+	bool batch() const { return bool_value(OPTION_BATCH); }
+	int batch_frames() const { return int_value(OPTION_BATCH_FRAMES); }
 	bool throttle() const { return bool_value(OPTION_THROTTLE); }
 	bool sleep() const { return m_sleep; }
 	float speed() const { return float_value(OPTION_SPEED); }
 	bool refresh_speed() const { return m_refresh_speed; }
 	bool low_latency() const { return bool_value(OPTION_LOWLATENCY); }
+	int runahead() const { return int_value(OPTION_RUNAHEAD); }
+	bool render_thread() const { return bool_value(OPTION_RENDER_THREAD); }
+	bool idle_detect() const { return bool_value(OPTION_IDLEDETECT); }
+	bool mapped_ram() const { return bool_value(OPTION_MAPPED_RAM); }
+	bool large_pages() const { return bool_value(OPTION_LARGE_PAGES); }
+	bool predecode_gfx() const { return bool_value(OPTION_PREDECODE_GFX); }
+	const char *telemetry() const { return value(OPTION_TELEMETRY); }
+	bool telemetry_outputs() const { return bool_value(OPTION_TELEMETRY_OUTPUTS); }
+	const char *frame_hash() const { return value(OPTION_FRAMEHASH); }
+	const char *frame_hash_check() const { return value(OPTION_FRAMEHASH_CHECK); }
 
 	// core render options
 	bool keep_aspect() const { return bool_value(OPTION_KEEPASPECT); }
@@ -406,6 +475,7 @@ public:
 	int volume() const { return int_value(OPTION_VOLUME); }
 	bool compressor() const { return bool_value(OPTION_COMPRESSOR); }
 	int speaker_report() const { return int_value(OPTION_SPEAKER_REPORT); }
+	bool sound_threads() const { return bool_value(OPTION_SOUND_THREADS); }
 
 	// core input options
 	bool coin_lockout() const { return bool_value(OPTION_COIN_LOCKOUT); }
@@ -432,6 +502,8 @@ public:
 	bool natural_keyboard() const { return bool_value(OPTION_NATURAL_KEYBOARD); }
 	bool joystick_contradictory() const { return m_joystick_contradictory; }
 	int coin_impulse() const { return m_coin_impulse; }
+	int input_polls() const { return int_value(OPTION_INPUT_POLLS); }
+	bool input_poll_on_read() const { return bool_value(OPTION_INPUT_POLL_ON_READ); }
 
 	// core debugging options
 	bool log() const { return bool_value(OPTION_LOG); }
@@ -441,12 +513,16 @@ public:
 	const char *debug_script() const { return value(OPTION_DEBUGSCRIPT); }
 	bool update_in_pause() const { return bool_value(OPTION_UPDATEINPAUSE); }
 	bool debuglog() const { return bool_value(OPTION_DEBUGLOG); }
+	const char *sched_trace() const { return value(OPTION_SCHEDTRACE); }
+	const char *startup_profile() const { return value(OPTION_STARTUPPROFILE); }
+	const char *profile_trace() const { return value(OPTION_PROFILETRACE); }
 
 	// core misc options
 	bool drc() const { return bool_value(OPTION_DRC); }
 	bool drc_use_c() const { return bool_value(OPTION_DRC_USE_C); }
 	bool drc_log_uml() const { return bool_value(OPTION_DRC_LOG_UML); }
 	bool drc_log_native() const { return bool_value(OPTION_DRC_LOG_NATIVE); }
+	bool drc_profile() const { return bool_value(OPTION_DRC_PROFILE); }
 	const char *bios() const { return value(OPTION_BIOS); }
 	bool cheat() const { return bool_value(OPTION_CHEAT); }
 	bool skip_gameinfo() const { return bool_value(OPTION_SKIP_GAMEINFO); }
@@ -454,6 +530,7 @@ public:
 	ui_option ui() const { return m_ui; }
 	const char *ram_size() const { return value(OPTION_RAMSIZE); }
 	bool nvram_save() const { return bool_value(OPTION_NVRAM_SAVE); }
+	int romcache_size() const { return int_value(OPTION_ROMCACHE_SIZE); }
 
 	// core comm options
 	const char *comm_localhost() const { return value(OPTION_COMM_LOCAL_HOST); }
@@ -476,6 +553,7 @@ public:
 
 	const char *plugin() const { return value(OPTION_PLUGIN); }
 	const char *no_plugin() const { return value(OPTION_NO_PLUGIN); }
+	const char *native_plugin() const { return value(OPTION_NATIVE_PLUGIN); }
 
 	const char *language() const { return value(OPTION_LANGUAGE); }
 
@@ -484,6 +562,14 @@ public:
 	short http_port() const { return int_value(OPTION_HTTP_PORT); }
 	const char *http_root() const { return value(OPTION_HTTP_ROOT); }
 
+	// rollback netplay options
+	int netplay_port() const { return int_value(OPTION_NETPLAY_PORT); }
+	const char *netplay_peer() const { return value(OPTION_NETPLAY_PEER); }
+	int netplay_player() const { return int_value(OPTION_NETPLAY_PLAYER); }
+	int netplay_delay() const { return int_value(OPTION_NETPLAY_DELAY); }
+	int netplay_rollback() const { return int_value(OPTION_NETPLAY_ROLLBACK); }
+	int netplay_benchmark() const { return int_value(OPTION_NETPLAY_BENCHMARK); }
+
 	// slots and devices - the values for these are stored outside of the core_options
 	// structure
 	const ::slot_option &slot_option(const std::string &device_name) const;
@@ -495,6 +581,9 @@ public:
 	::image_option &image_option(const std::string &device_name);
 	bool has_image_option(const std::string &device_name) const { return m_image_options.find(device_name) != m_image_options.end(); }
 
+	// machine configurations built with these options, shared between driver enumerators
+	std::shared_ptr<machine_config> shared_config(const game_driver &driver);
+
 protected:
 	virtual void command_argument_processed() override;
 
@@ -512,6 +601,7 @@ private:
 	bool add_and_remove_image_options();
 	void reevaluate_default_card_software();
 	std::string get_default_card_software(device_slot_interface &slot);
+	void configs_changed();
 
 	// static list of options entries
 	static const options_entry                          s_option_entries[];
@@ -537,6 +627,11 @@ private:
 
 	// special option; the software set name that we did specify
 	std::string                                         m_software_name;
+
+	// recently built machine configurations, most recent first; dropped when slot or image options change
+	std::mutex                                          m_shared_config_mutex;
+	std::vector<std::shared_ptr<machine_config> >       m_shared_configs;
+	uint64_t                                            m_shared_config_generation;
 };
 
 // takes an existing emu_options and adds system specific options
@@ -11,14 +11,139 @@
 #include "emu.h"
 #include "fileio.h"
 
+#include "util/corestr.h"
 #include "util/path.h"
 #include "util/unzip.h"
 
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
 //#define VERBOSE 1
 #define LOG_OUTPUT_FUNC osd_printf_verbose
 #include "logmacro.h"
 
 
+
+//**************************************************************************
+//  DIRECTORY CACHE
+//**************************************************************************
+
+namespace {
+
+// remembers what's in the directories we search so candidates that can't
+// exist don't cost a failed open each, which is slow on network shares
+class directory_cache
+{
+public:
+	static directory_cache &instance()
+	{
+		static directory_cache cache;
+		return cache;
+	}
+
+	// false if the file is definitely absent; names are compared without
+	// regard to case, so a true result may still fail to open
+	bool may_exist(std::string_view path)
+	{
+		std::string dir, leaf;
+		if (!split(path, dir, leaf))
+			return true;
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		listing const &found(lookup(dir));
+		if (found.exists && !found.listed)
+			return true;
+		return found.names.find(strmakelower(leaf)) != found.names.end();
+	}
+
+	// forget the directory containing a file we created or removed
+	void invalidate(std::string_view path)
+	{
+		std::string dir, leaf;
+		if (split(path, dir, leaf))
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_listings.erase(dir);
+		}
+	}
+
+private:
+	// how long a listing is trusted before checking the directory's modification time
+	static constexpr std::chrono::seconds REVALIDATE_INTERVAL{ 1 };
+
+	// how long a listing is used at all; modification times are too coarse on
+	// some file systems to catch every change, so misses can't be trusted forever
+	static constexpr std::chrono::seconds EXPIRE_INTERVAL{ 30 };
+
+	struct listing
+	{
+		bool                                    exists = false;
+		bool                                    listed = false;
+		std::chrono::system_clock::time_point   modified;
+		std::uint64_t                           size = 0;
+		std::chrono::steady_clock::time_point   read;
+		std::chrono::steady_clock::time_point   checked;
+		std::unordered_set<std::string>         names;
+	};
+
+	static bool split(std::string_view path, std::string &dir, std::string &leaf)
+	{
+		auto const dirsepiter(std::find_if(path.rbegin(), path.rend(), util::is_directory_separator));
+		if (dirsepiter == path.rend())
+			return false;
+		std::string_view::size_type const dirsep(std::distance(path.begin(), dirsepiter.base()) - 1);
+		if (((path.length() - 1) == dirsep) || (dirsep && (':' == path[dirsep - 1])))
+			return false; // no filename, or a drive-relative path we can't list reliably
+		dir.assign(path.substr(0, dirsep ? dirsep : 1));
+		leaf.assign(path.substr(dirsep + 1));
+		return true;
+	}
+
+	listing const &lookup(std::string const &dir)
+	{
+		auto const now(std::chrono::steady_clock::now());
+		auto const inserted(m_listings.try_emplace(dir));
+		listing &result(inserted.first->second);
+		if (!inserted.second && ((now - result.checked) < REVALIDATE_INTERVAL))
+			return result;
+		result.checked = now;
+
+		// directory modification times and sizes change when entries are added
+		// or removed, but the time may not tick over for a quick change
+		std::unique_ptr<osd::directory::entry> const info(osd_stat(dir));
+		bool const exists(info && (osd::directory::entry::entry_type::DIR == info->type));
+		if (!inserted.second && ((now - result.read) < EXPIRE_INTERVAL) && (exists == result.exists) && (!exists || ((info->last_modified == result.modified) && (info->size == result.size))))
+			return result;
+
+		LOG("emu_file: reading directory listing '%s'\n", dir);
+		result.exists = exists;
+		result.listed = false;
+		result.read = now;
+		result.names.clear();
+		if (exists)
+		{
+			result.modified = info->last_modified;
+			result.size = info->size;
+		}
+		osd::directory::ptr const listing(exists ? osd::directory::open(dir) : nullptr);
+		if (listing)
+		{
+			result.listed = true;
+			for (osd::directory::entry const *entry = listing->read(); entry; entry = listing->read())
+				result.names.emplace(strmakelower(entry->name));
+		}
+		return result;
+	}
+
+	std::mutex                                  m_mutex;
+	std::unordered_map<std::string, listing>    m_listings;
+};
+
+} // anonymous namespace
+
+
 template path_iterator::path_iterator(char *&, int);
 template path_iterator::path_iterator(char * const &, int);
 template path_iterator::path_iterator(char const *&, int);
@@ -278,6 +403,11 @@ util::hash_collection &emu_file::hashes(std::string_view types)
 		m_hashes.compute(&m_zipdata[0], m_zipdata.size(), needed.c_str());
 		return m_hashes;
 	}
+	else if (m_zipview)
+	{
+		m_hashes.compute(reinterpret_cast<u8 const *>(m_zipview.get()), m_ziplength, needed.c_str());
+		return m_hashes;
+	}
 
 	std::uint64_t length;
 	if (m_file->length(length))
@@ -377,12 +507,18 @@ std::error_condition emu_file::open_next()
 		}
 		m_fullpath.append(m_filename);
 
-		// attempt to open the file directly
-		LOG("emu_file: attempting to open '%s' directly\n", m_fullpath);
-		filerr = util::core_file::open(m_fullpath, m_openflags, m_file);
+		// attempt to open the file directly, unless we know it's not there
+		bool const readonly((m_openflags & (OPEN_FLAG_READ | OPEN_FLAG_WRITE)) == OPEN_FLAG_READ);
+		if (!readonly || directory_cache::instance().may_exist(m_fullpath))
+		{
+			LOG("emu_file: attempting to open '%s' directly\n", m_fullpath);
+			filerr = util::core_file::open(m_fullpath, m_openflags, m_file);
+			if (!filerr && (m_openflags & OPEN_FLAG_CREATE))
+				directory_cache::instance().invalidate(m_fullpath);
+		}
 
 		// if we're opening for read-only we have other options
-		if (filerr && ((m_openflags & (OPEN_FLAG_READ | OPEN_FLAG_WRITE)) == OPEN_FLAG_READ))
+		if (filerr && readonly)
 		{
 			LOG("emu_file: attempting to open '%s' from archives\n", m_fullpath);
 			filerr = attempt_zipped();
@@ -408,6 +544,34 @@ std::error_condition emu_file::open_ram(const void *data, u32 length)
 }
 
 
+//-------------------------------------------------
+//  write_replacing - write a file so nothing else
+//  ever sees it partially written, replacing any
+//  existing file with the same name
+//-------------------------------------------------
+
+std::error_condition emu_file::write_replacing(const std::string &searchpath, std::string_view name, const std::function<bool (emu_file &)> &write)
+{
+	// write to a temporary file in the same directory first
+	std::string const suffix(util::string_format(".%d.tmp", osd_getpid()));
+	emu_file file(searchpath, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	std::error_condition filerr(file.open(std::string(name) + suffix));
+	if (filerr)
+		return filerr;
+	std::string const temppath(file.fullpath());
+	bool const written(write(file));
+	file.close();
+
+	// then move it into place, or clean up if anything went wrong
+	std::string const path(temppath.substr(0, temppath.length() - suffix.length()));
+	filerr = written ? osd_file::rename(temppath, path) : std::errc::io_error;
+	if (filerr)
+		osd_file::remove(temppath);
+	directory_cache::instance().invalidate(path);
+	return filerr;
+}
+
+
 //-------------------------------------------------
 //  close - close a file and free all data; also
 //  remove the file if requested
@@ -420,9 +584,15 @@ void emu_file::close()
 	m_file.reset();
 
 	m_zipdata.clear();
+	m_zipview.reset();
+	m_archivepath.clear();
+	m_archivemember.clear();
 
 	if (m_remove_on_close)
+	{
 		osd_file::remove(m_fullpath);
+		directory_cache::instance().invalidate(m_fullpath);
+	}
 	m_remove_on_close = false;
 
 	// reset our hashes and path as well
@@ -739,9 +909,11 @@ std::error_condition emu_file::attempt_zipped()
 			m_fullpath.append(suffixes[i]);
 			LOG("emu_file: looking for '%s' in archive '%s'\n", filename, m_fullpath);
 
-			// attempt to open the archive file
+			// attempt to open the archive file, unless we know it's not there
 			util::archive_file::ptr zip;
-			std::error_condition ziperr = open_funcs[i](m_fullpath, zip);
+			std::error_condition ziperr = std::errc::no_such_file_or_directory;
+			if (directory_cache::instance().may_exist(m_fullpath))
+				ziperr = open_funcs[i](m_fullpath, zip);
 
 			// chop the archive suffix back off the filename before continuing
 			m_fullpath = m_fullpath.substr(0, dirsep);
@@ -774,6 +946,8 @@ std::error_condition emu_file::attempt_zipped()
 			{
 				m_zipfile = std::move(zip);
 				m_ziplength = m_zipfile->current_uncompressed_length();
+				m_archivepath = m_fullpath + suffixes[i];
+				m_archivemember = m_zipfile->current_name();
 
 				// build a hash with just the CRC
 				m_hashes.reset();
@@ -798,8 +972,22 @@ std::error_condition emu_file::load_zipped_file()
 {
 	assert(m_file == nullptr);
 	assert(m_zipdata.empty());
+	assert(!m_zipview);
 	assert(m_zipfile);
 
+	// stored files in a mapped archive can be used in place
+	if (!m_zipfile->view(m_zipview))
+	{
+		std::error_condition const filerr = util::core_file::open_ram(m_zipview.get(), m_ziplength, m_openflags, m_file);
+		if (filerr)
+		{
+			m_zipview.reset();
+			return filerr;
+		}
+		m_zipfile.reset();
+		return std::error_condition();
+	}
+
 	// allocate some memory
 	m_zipdata.resize(m_ziplength);
 
@@ -16,7 +16,9 @@
 #include "corefile.h"
 #include "hash.h"
 
+#include <functional>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <system_error>
 #include <type_traits>
@@ -149,6 +151,9 @@ public:
 	const char *filename() const { return m_filename.c_str(); }
 	const char *fullpath() const { return m_fullpath.c_str(); }
 	u32 openflags() const { return m_openflags; }
+	bool archived() const { return m_zipfile || !m_zipdata.empty() || m_zipview; }
+	const char *archive_path() const { return m_archivepath.c_str(); }
+	const std::string &archive_member() const { return m_archivemember; }
 	util::hash_collection &hashes(std::string_view types);
 
 	// setters
@@ -191,6 +196,9 @@ public:
 	// buffers
 	void flush();
 
+	// write a file under a temporary name, then move it over any existing file once it's complete
+	static std::error_condition write_replacing(const std::string &searchpath, std::string_view name, const std::function<bool (emu_file &)> &write);
+
 private:
 	emu_file(u32 openflags, empty_t);
 	emu_file(path_iterator &&searchpath, u32 openflags);
@@ -230,7 +238,10 @@ private:
 
 	std::unique_ptr<util::archive_file> m_zipfile;  // ZIP file pointer
 	std::vector<u8>         m_zipdata;              // ZIP file data
+	std::shared_ptr<void const> m_zipview;          // ZIP file data used in place
 	u64                     m_ziplength;            // ZIP file length
+	std::string             m_archivepath;          // path of the archive the file was found in
+	std::string             m_archivemember;        // name of the file within the archive
 
 	bool                    m_remove_on_close;      // flag: remove the file when closing
 	int                     m_restrict_to_mediapath; // flag: restrict to paths inside the media-path
@@ -0,0 +1,421 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    frameexport.cpp
+
+    Publishes finished frames and memory ranges to shared memory.
+
+    The shared memory layout is described in frameexport_abi.h, which
+    is all a consumer needs.  Each slot is a complete snapshot of one
+    frame; consumers detect torn reads with the slot sequence number.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "frameexport.h"
+
+#include "screen.h"
+
+#include "corestr.h"
+
+#include "../osd/modules/lib/osdlib.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+
+namespace {
+
+// round up so every block in a slot starts on its own cache line
+constexpr u64 align_up(u64 value)
+{
+	return (value + 63) & ~u64(63);
+}
+
+void copy_tag(char (&dest)[MAME_EXPORT_TAG_LENGTH], char const *tag)
+{
+	std::strncpy(dest, tag, MAME_EXPORT_TAG_LENGTH - 1);
+	dest[MAME_EXPORT_TAG_LENGTH - 1] = '\0';
+}
+
+// volatile stores with release semantics, seen by another process
+inline void publish_value(volatile u64 &dest, u64 value)
+{
+	std::atomic_thread_fence(std::memory_order_release);
+	dest = value;
+}
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  FRAME EXPORT
+//**************************************************************************
+
+//-------------------------------------------------
+//  frame_export - constructor
+//-------------------------------------------------
+
+frame_export::frame_export(running_machine &machine, bool lockstep)
+	: m_machine(machine)
+	, m_lockstep(lockstep)
+	, m_header(nullptr)
+	, m_slot_count(0)
+	, m_slot_offset(0)
+	, m_slot_size(0)
+	, m_sequence(0)
+	, m_stalls(0)
+	, m_stall_ticks(0)
+	, m_dropped(0)
+	, m_ack_lost(false)
+	, m_lost_ack(0)
+{
+}
+
+
+//-------------------------------------------------
+//  ~frame_export - destructor
+//-------------------------------------------------
+
+frame_export::~frame_export()
+{
+	if (m_stalls)
+	{
+		osd_printf_verbose("Frame export: waited for the consumer %u times, %.3f ms in total\n",
+				m_stalls,
+				1000.0 * double(m_stall_ticks) / double(osd_ticks_per_second()));
+	}
+	if (m_dropped)
+		osd_printf_verbose("Frame export: %u frames were not acknowledged by the consumer\n", m_dropped);
+}
+
+
+//-------------------------------------------------
+//  name - name of the shared memory object
+//-------------------------------------------------
+
+std::string const &frame_export::name() const
+{
+	return m_mapping->name();
+}
+
+
+//-------------------------------------------------
+//  create - set up an export; returns nullptr
+//  after reporting the problem on failure
+//-------------------------------------------------
+
+frame_export::ptr frame_export::create(running_machine &machine, std::string const &name, char const *ranges, unsigned slots, bool lockstep)
+{
+	ptr result(new frame_export(machine, lockstep));
+
+	for (screen_device &screen : screen_device_enumerator(machine.root_device()))
+	{
+		// the visible area never exceeds the total size the screen starts with
+		u64 const pixels(u64(screen.width()) * u64(screen.height()));
+		result->m_screens.push_back(export_screen{ &screen, u32(std::min<u64>(pixels, 0xffffffffU)), 0 });
+	}
+
+	if (!result->parse_ranges(ranges) || !result->allocate(name, slots))
+		return nullptr;
+
+	osd_printf_verbose("Frame export: publishing %u screen(s) and %u range(s) to \"%s\" (%u slots of %u bytes)\n",
+			result->m_screens.size(),
+			result->m_ranges.size(),
+			result->name(),
+			result->m_slot_count,
+			result->m_slot_size);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  parse_ranges - parse a comma-separated list
+//  of <tag>:<space>:<start>-<end> ranges, with
+//  hexadecimal byte addresses
+//-------------------------------------------------
+
+bool frame_export::parse_ranges(char const *spec)
+{
+	std::string const all(spec ? spec : "");
+	std::string::size_type pos(0);
+	while (pos < all.length())
+	{
+		std::string::size_type const comma(all.find(',', pos));
+		std::string const item(strtrimspace(all.substr(pos, (comma == std::string::npos) ? std::string::npos : (comma - pos))));
+		pos = (comma == std::string::npos) ? all.length() : (comma + 1);
+		if (item.empty())
+			continue;
+
+		// the device tag may contain colons itself, so split from the right
+		std::string::size_type const rangesep(item.rfind(':'));
+		std::string::size_type const spacesep((rangesep == std::string::npos || !rangesep) ? std::string::npos : item.rfind(':', rangesep - 1));
+		std::string::size_type const dash((rangesep == std::string::npos) ? std::string::npos : item.find('-', rangesep));
+		if ((spacesep == std::string::npos) || (dash == std::string::npos))
+		{
+			osd_printf_error("Frame export: invalid memory range \"%s\", expected <tag>:<space>:<start>-<end>\n", item);
+			return false;
+		}
+		std::string const tag(item.substr(0, spacesep));
+		std::string const spacename(item.substr(spacesep + 1, rangesep - spacesep - 1));
+		std::string const startstr(item.substr(rangesep + 1, dash - rangesep - 1));
+		std::string const endstr(item.substr(dash + 1));
+
+		// find the device and the space
+		device_t *const device(m_machine.root_device().subdevice(tag));
+		device_memory_interface *memory;
+		if (!device || !device->interface(memory))
+		{
+			osd_printf_error("Frame export: \"%s\" is not a device with address spaces\n", tag);
+			return false;
+		}
+		address_space *space(nullptr);
+		for (int i = 0; !space && (i < memory->max_space_count()); i++)
+		{
+			if (memory->has_space(i) && (spacename == memory->space(i).name()))
+				space = &memory->space(i);
+		}
+		if (!space)
+		{
+			osd_printf_error("Frame export: device \"%s\" has no %s space\n", tag, spacename);
+			return false;
+		}
+		if (space->addr_shift())
+		{
+			osd_printf_error("Frame export: %s space of \"%s\" is not byte-addressed\n", spacename, tag);
+			return false;
+		}
+
+		// parse the bounds
+		char *startend, *endend;
+		u64 const start(std::strtoull(startstr.c_str(), &startend, 16));
+		u64 const end(std::strtoull(endstr.c_str(), &endend, 16));
+		if (startstr.empty() || endstr.empty() || *startend || *endend || (end < start) || (end > space->addrmask()))
+		{
+			osd_printf_error("Frame export: invalid address range \"%s\" for %s space of \"%s\"\n", item.substr(rangesep + 1), spacename, tag);
+			return false;
+		}
+
+		m_ranges.push_back(export_range{ space, offs_t(start), end - start + 1, 0 });
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  allocate - lay out the slots and create the
+//  shared memory object
+//-------------------------------------------------
+
+bool frame_export::allocate(std::string const &name, unsigned slots)
+{
+	// descriptors follow the header, slots follow the descriptors
+	u64 const descriptors(
+			sizeof(mame_export_header) +
+			(sizeof(mame_export_screen) * m_screens.size()) +
+			(sizeof(mame_export_range) * m_ranges.size()));
+	m_slot_offset = align_up(descriptors);
+
+	// each slot has its own header and screen sizes, then the data
+	u64 slot(align_up(sizeof(mame_export_slot) + (sizeof(u32) * 2 * m_screens.size())));
+	for (export_screen &screen : m_screens)
+	{
+		screen.offset = slot;
+		slot = align_up(slot + (u64(screen.max_pixels) * sizeof(u32)));
+	}
+	for (export_range &range : m_ranges)
+	{
+		range.offset = slot;
+		slot = align_up(slot + range.length);
+	}
+	m_slot_size = slot;
+	m_slot_count = std::clamp(slots, 1U, 64U);
+
+	u64 const total(m_slot_offset + (m_slot_size * m_slot_count));
+	if (total > std::numeric_limits<std::size_t>::max())
+	{
+		osd_printf_error("Frame export: %u slots of %u bytes are too large\n", m_slot_count, m_slot_size);
+		return false;
+	}
+	m_mapping = std::make_unique<osd::shared_mapping>(name, std::size_t(total));
+	if (!*m_mapping)
+	{
+		osd_printf_error("Frame export: unable to create shared memory \"%s\"\n", name);
+		return false;
+	}
+
+	// fill in the descriptors; the memory starts out zeroed, so the sequence is 0
+	u8 *const base(reinterpret_cast<u8 *>(m_mapping->get()));
+	m_header = reinterpret_cast<mame_export_header *>(base);
+	m_header->version = MAME_EXPORT_VERSION;
+	m_header->screen_count = u32(m_screens.size());
+	m_header->range_count = u32(m_ranges.size());
+	m_header->slot_count = m_slot_count;
+	m_header->lockstep = m_lockstep ? 1 : 0;
+	m_header->slot_offset = m_slot_offset;
+	m_header->slot_size = m_slot_size;
+	copy_tag(m_header->system, m_machine.system().name);
+
+	mame_export_screen *const screens(reinterpret_cast<mame_export_screen *>(m_header + 1));
+	for (std::size_t i = 0; i < m_screens.size(); i++)
+	{
+		copy_tag(screens[i].tag, m_screens[i].device->tag());
+		screens[i].max_pixels = m_screens[i].max_pixels;
+		screens[i].offset = m_screens[i].offset;
+	}
+
+	mame_export_range *const ranges(reinterpret_cast<mame_export_range *>(screens + m_screens.size()));
+	for (std::size_t i = 0; i < m_ranges.size(); i++)
+	{
+		copy_tag(ranges[i].tag, m_ranges[i].space->device().tag());
+		ranges[i].spacenum = u32(m_ranges[i].space->spacenum());
+		ranges[i].start = m_ranges[i].start;
+		ranges[i].length = m_ranges[i].length;
+		ranges[i].offset = m_ranges[i].offset;
+	}
+
+	// consumers check the magic number last
+	std::atomic_thread_fence(std::memory_order_release);
+	m_header->magic = MAME_EXPORT_MAGIC;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  copy_range - copy an address range without
+//  side effects, directly when it is plain RAM
+//-------------------------------------------------
+
+void frame_export::copy_range(export_range const &range, u8 *dest) const
+{
+	address_space &space(*range.space);
+	offs_t const last(range.start + offs_t(range.length - 1));
+
+	// memory in host order maps byte addresses straight to the backing store
+	if ((space.data_width() == 8) || (space.endianness() == ENDIANNESS_NATIVE))
+	{
+		u8 const *const first(reinterpret_cast<u8 const *>(space.get_read_ptr(range.start)));
+		if (first && (reinterpret_cast<u8 const *>(space.get_read_ptr(last)) == (first + range.length - 1)))
+		{
+			std::memcpy(dest, first, range.length);
+			return;
+		}
+	}
+
+	// otherwise go through the handlers
+	auto dis(m_machine.disable_side_effects());
+	for (u64 i = 0; i < range.length; i++)
+		dest[i] = space.read_byte(range.start + offs_t(i));
+}
+
+
+//-------------------------------------------------
+//  publish - copy the current frame into the
+//  next slot and make it visible
+//-------------------------------------------------
+
+void frame_export::publish()
+{
+	u64 const sequence(m_sequence + 1);
+	u8 *const base(reinterpret_cast<u8 *>(m_mapping->get()) + m_slot_offset + (m_slot_size * ((sequence - 1) % m_slot_count)));
+	mame_export_slot &slot(*reinterpret_cast<mame_export_slot *>(base));
+	u32 *const widths(reinterpret_cast<u32 *>(&slot + 1));
+	u32 *const heights(widths + m_screens.size());
+
+	// invalidate the slot before overwriting it
+	publish_value(slot.sequence, 0);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	attotime const now(m_machine.time());
+	slot.frame = m_screens.empty() ? 0 : m_screens.front().device->frame_number();
+	slot.time_seconds = now.seconds();
+	slot.time_attoseconds = now.attoseconds();
+
+	for (std::size_t i = 0; i < m_screens.size(); i++)
+	{
+		export_screen const &screen(m_screens[i]);
+		rectangle const &visarea(screen.device->visible_area());
+		u64 const pixels(u64(visarea.width()) * u64(visarea.height()));
+		if (!visarea.empty() && (pixels <= screen.max_pixels))
+		{
+			screen.device->pixels(reinterpret_cast<u32 *>(base + screen.offset));
+			widths[i] = visarea.width();
+			heights[i] = visarea.height();
+		}
+		else
+		{
+			widths[i] = heights[i] = 0;
+		}
+	}
+
+	for (export_range const &range : m_ranges)
+		copy_range(range, base + range.offset);
+
+	// complete the slot, then advertise it
+	publish_value(slot.sequence, sequence);
+	publish_value(m_header->sequence, sequence);
+	m_sequence = sequence;
+
+	if (m_lockstep)
+		wait_for_ack();
+}
+
+
+//-------------------------------------------------
+//  wait_for_ack - in lockstep mode, hold the
+//  emulation until the consumer is done with
+//  the frame just published, or give up on it
+//-------------------------------------------------
+
+void frame_export::wait_for_ack()
+{
+	volatile u64 const &ack(m_header->ack);
+	if (ack >= m_sequence)
+		return;
+
+	// a consumer that stopped answering doesn't hold the emulation again until it acknowledges something
+	if (m_ack_lost)
+	{
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (ack == m_lost_ack)
+		{
+			m_dropped++;
+			return;
+		}
+		m_ack_lost = false;
+	}
+
+	// spin briefly since a fast consumer answers within microseconds, then give the time away
+	osd_ticks_t const start(osd_ticks());
+	osd_ticks_t const timeout(osd_ticks_per_second() * ACK_TIMEOUT_SECONDS);
+	for (unsigned spins = 0; ack < m_sequence; spins++)
+	{
+		if (spins < 1000)
+		{
+			std::atomic_thread_fence(std::memory_order_acquire);
+		}
+		else if (m_machine.scheduled_event_pending() || ((osd_ticks() - start) >= timeout))
+		{
+			// drop the frame rather than hanging an exit or a machine whose consumer has gone
+			if (!m_machine.scheduled_event_pending())
+				osd_printf_warning("Frame export: consumer did not acknowledge frame %u, continuing without it\n", m_sequence);
+			m_ack_lost = true;
+			m_lost_ack = ack;
+			m_dropped++;
+			break;
+		}
+		else
+		{
+			osd_sleep(osd_ticks_per_second() / 10000);
+		}
+	}
+	std::atomic_thread_fence(std::memory_order_acquire);
+
+	m_stalls++;
+	m_stall_ticks += osd_ticks() - start;
+}
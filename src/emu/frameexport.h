@@ -0,0 +1,99 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    frameexport.h
+
+    Publishes finished frames and memory ranges to shared memory.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_FRAMEEXPORT_H
+#define MAME_EMU_FRAMEEXPORT_H
+
+#pragma once
+
+#include "frameexport_abi.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace osd { class shared_mapping; }
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> frame_export
+
+class frame_export
+{
+public:
+	typedef std::unique_ptr<frame_export> ptr;
+
+	// dtor
+	~frame_export();
+
+	// accessors
+	std::string const &name() const;
+	u64 sequence() const { return m_sequence; }
+
+	// copy the current screens and ranges into the next slot, then wait for the consumer in lockstep mode
+	void publish();
+
+	// statics
+	static ptr create(running_machine &machine, std::string const &name, char const *ranges, unsigned slots, bool lockstep);
+
+private:
+	// how long to wait for the consumer before dropping a frame
+	static constexpr unsigned ACK_TIMEOUT_SECONDS = 1;
+
+	// a screen and where its pixels live in each slot
+	struct export_screen
+	{
+		screen_device *     device;         // screen to capture
+		u32                 max_pixels;     // capacity of the pixel area
+		u64                 offset;         // offset of the pixels within a slot
+	};
+
+	// an address range and where its contents live in each slot
+	struct export_range
+	{
+		address_space *     space;          // space to read from
+		offs_t              start;          // first byte address
+		u64                 length;         // number of bytes
+		u64                 offset;         // offset of the contents within a slot
+	};
+
+	// ctor
+	frame_export(running_machine &machine, bool lockstep);
+	frame_export(frame_export const &) = delete;
+	frame_export &operator=(frame_export const &) = delete;
+
+	// internal helpers
+	bool parse_ranges(char const *spec);
+	bool allocate(std::string const &name, unsigned slots);
+	void copy_range(export_range const &range, u8 *dest) const;
+	void wait_for_ack();
+
+	running_machine &   m_machine;
+	bool const          m_lockstep;         // wait for the consumer after each frame
+	std::unique_ptr<osd::shared_mapping> m_mapping; // the shared memory object
+	mame_export_header *m_header;           // start of the shared memory
+	std::vector<export_screen> m_screens;
+	std::vector<export_range> m_ranges;
+	u32                 m_slot_count;       // number of slots in the ring
+	u64                 m_slot_offset;      // offset of the first slot
+	u64                 m_slot_size;        // bytes per slot
+	u64                 m_sequence;         // last frame published
+	u32                 m_stalls;           // frames the emulation waited for the consumer
+	osd_ticks_t         m_stall_ticks;      // total time spent waiting
+	u32                 m_dropped;          // frames the consumer didn't acknowledge in time
+	bool                m_ack_lost;         // the consumer stopped acknowledging frames
+	u64                 m_lost_ack;         // last acknowledgement before it stopped
+};
+
+#endif // MAME_EMU_FRAMEEXPORT_H
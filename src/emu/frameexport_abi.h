@@ -0,0 +1,111 @@
+/* license:BSD-3-Clause
+   copyright-holders:MAMEdev Team */
+/***************************************************************************
+
+    frameexport_abi.h
+
+    Layout of the shared memory frame export (-export), for consumers.
+
+    This header is plain C and depends on nothing else in MAME, so it
+    can be copied into other projects.  The shared memory object is
+    named by the -export option (POSIX shm_open name with a leading
+    slash, Windows named file mapping).
+
+    The object starts with a mame_export_header, followed by one
+    mame_export_screen for each screen and one mame_export_range for
+    each exported memory range.  Then come slot_count slots of
+    slot_size bytes each, the first at slot_offset.  Each slot starts
+    with a mame_export_slot whose width/height arrays have one entry
+    per screen, followed by the screen pixels and range contents at the
+    offsets given in the descriptors (relative to the start of the
+    slot).  Pixels are 32-bit xRGB in host byte order, rows packed
+    without padding.
+
+    Frame n (counting from 1) is written to slot (n - 1) % slot_count.
+    To read a frame:
+
+        1. load header->sequence (acquire); this is the newest frame
+        2. load slot->sequence (acquire) and check it matches
+        3. copy what you need out of the slot
+        4. load slot->sequence again (acquire); if it has changed the
+           slot was overwritten while you were reading, try again
+
+    In lockstep mode the emulation stops after publishing each frame
+    until the consumer stores that frame's sequence number (or
+    MAME_EXPORT_RELEASE to let it run freely) to header->ack.  Anything
+    the consumer needs to do between frames, such as poking memory
+    through the debugger or Lua, can be done before acknowledging.
+    If no acknowledgement arrives within a second, or the emulation is
+    exiting or resetting, the frame is dropped and the emulation runs
+    freely until the consumer acknowledges a frame again.
+
+***************************************************************************/
+
+#ifndef MAME_EMU_FRAMEEXPORT_ABI_H
+#define MAME_EMU_FRAMEEXPORT_ABI_H
+
+#pragma once
+
+#include <stdint.h>
+
+#define MAME_EXPORT_MAGIC       0x5058454dU     /* "MEXP" in little-endian order */
+#define MAME_EXPORT_VERSION     1U
+#define MAME_EXPORT_RELEASE     (~(uint64_t)0)  /* ack value that ends lockstep */
+#define MAME_EXPORT_TAG_LENGTH  48
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* fixed header at the start of the object */
+typedef struct mame_export_header
+{
+	uint32_t magic;                 /* MAME_EXPORT_MAGIC */
+	uint32_t version;               /* MAME_EXPORT_VERSION */
+	uint32_t screen_count;          /* number of mame_export_screen descriptors */
+	uint32_t range_count;           /* number of mame_export_range descriptors */
+	uint32_t slot_count;            /* number of slots in the ring */
+	uint32_t lockstep;              /* non-zero if the emulation waits for ack */
+	uint64_t slot_offset;           /* offset of the first slot from the start of the object */
+	uint64_t slot_size;             /* bytes per slot */
+	volatile uint64_t sequence;     /* newest complete frame, 0 before the first */
+	volatile uint64_t ack;          /* written by the consumer in lockstep mode */
+	char system[MAME_EXPORT_TAG_LENGTH]; /* short name of the emulated system */
+} mame_export_header;
+
+/* one per screen, following the header */
+typedef struct mame_export_screen
+{
+	char tag[MAME_EXPORT_TAG_LENGTH];   /* screen device tag */
+	uint32_t max_pixels;            /* capacity of the pixel area */
+	uint32_t reserved;
+	uint64_t offset;                /* offset of the pixels from the start of a slot */
+} mame_export_screen;
+
+/* one per memory range, following the screen descriptors */
+typedef struct mame_export_range
+{
+	char tag[MAME_EXPORT_TAG_LENGTH];   /* device tag */
+	uint32_t spacenum;              /* address space index */
+	uint32_t reserved;
+	uint64_t start;                 /* first address */
+	uint64_t length;                /* exported bytes */
+	uint64_t offset;                /* offset of the contents from the start of a slot */
+} mame_export_range;
+
+/* start of each slot */
+typedef struct mame_export_slot
+{
+	volatile uint64_t sequence;     /* frame in this slot, 0 while it is being written */
+	uint64_t frame;                 /* screen frame number of the first screen */
+	int64_t time_seconds;           /* emulated time when the frame was published */
+	int64_t time_attoseconds;
+	/* followed by uint32_t width[screen_count] and uint32_t height[screen_count];
+	   a zero size means the screen did not fit this frame */
+} mame_export_slot;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MAME_EMU_FRAMEEXPORT_ABI_H */
@@ -0,0 +1,241 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    framehash.cpp
+
+    Per-frame output hashing for regression checks (-framehash,
+    -framehashcheck).
+
+    Each finished frame gets a CRC-32 of the visible area of every screen,
+    as the RGB values that would be shown, and a CRC-32 of the mixed
+    sound generated since the previous frame, both taken over
+    little-endian data so reference files can be shared between hosts
+    with the same floating point behaviour.  Hashes are written one frame
+    per line, and a run can be checked against a file written earlier:
+    the first frame that differs is reported as an error and the machine
+    exits once all frames have been compared (or at the first mismatch),
+    with a summary of how long the run took.
+
+    For the output to be reproducible the run has to use the same options
+    and inputs each time: with no -playback file, inputs stay at their
+    defaults and the base time used for real-time clocks is fixed.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "framehash.h"
+
+#include "fileio.h"
+#include "screen.h"
+
+#include "corestr.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+
+
+//**************************************************************************
+//  FRAME HASHER
+//**************************************************************************
+
+//-------------------------------------------------
+//  frame_hasher - constructor
+//-------------------------------------------------
+
+frame_hasher::frame_hasher(running_machine &machine)
+	: m_machine(machine)
+	, m_samples(0)
+	, m_frames(0)
+	, m_mismatches(0)
+	, m_first_mismatch(0)
+	, m_start_ticks(0)
+	, m_start_emutime(attotime::zero)
+{
+}
+
+
+//-------------------------------------------------
+//  ~frame_hasher - destructor
+//-------------------------------------------------
+
+frame_hasher::~frame_hasher()
+{
+	if (m_file)
+		osd_printf_verbose("Frame hash: wrote %u frames\n", m_frames);
+}
+
+
+//-------------------------------------------------
+//  create - start hashing frames; returns nullptr
+//  after reporting the problem on failure
+//-------------------------------------------------
+
+frame_hasher::ptr frame_hasher::create(running_machine &machine, std::string_view record, std::string_view check)
+{
+	ptr result(new frame_hasher(machine));
+
+	// read the reference first so the same file can be checked and rewritten
+	if (!check.empty() && !result->load_reference(check))
+		return nullptr;
+
+	if (!record.empty())
+	{
+		result->m_file = std::make_unique<emu_file>(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		std::error_condition const filerr(result->m_file->open(record));
+		if (filerr)
+		{
+			osd_printf_error("Error opening frame hash file %s (%s)\n", record, filerr.message());
+			return nullptr;
+		}
+		result->m_file->printf("# framehash %s\n", machine.system().name);
+	}
+
+	result->m_start_ticks = osd_ticks();
+	result->m_start_emutime = machine.time();
+	return result;
+}
+
+
+//-------------------------------------------------
+//  load_reference - read hashes to check against
+//-------------------------------------------------
+
+bool frame_hasher::load_reference(std::string_view filename)
+{
+	emu_file file(OPEN_FLAG_READ);
+	std::error_condition const filerr(file.open(filename));
+	if (filerr)
+	{
+		osd_printf_error("Error opening frame hash reference %s (%s)\n", filename, filerr.message());
+		return false;
+	}
+
+	char buffer[256];
+	unsigned linenum(0);
+	while (file.gets(buffer, std::size(buffer)))
+	{
+		linenum++;
+		std::string_view const line(strtrimspace(std::string_view(buffer)));
+		if (line.empty() || (line[0] == '#'))
+			continue;
+
+		frame_record entry;
+		char *end;
+		entry.frame = std::strtoull(buffer, &end, 10);
+		char video[9], audio[9];
+		unsigned samples;
+		if ((end == buffer) || (std::sscanf(end, " %8s %8s %u", video, audio, &samples) != 3) || !entry.video.from_string(video) || !entry.audio.from_string(audio))
+		{
+			osd_printf_error("Error reading frame hash reference %s: line %u is malformed\n", filename, linenum);
+			return false;
+		}
+		entry.samples = samples;
+		m_reference.emplace_back(entry);
+	}
+
+	osd_printf_verbose("Frame hash: checking against %u frames from %s\n", m_reference.size(), filename);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  add_sound - accumulate mixed sound samples
+//-------------------------------------------------
+
+void frame_hasher::add_sound(const s16 *sound, int numsamples)
+{
+	for (int i = 0; i < numsamples * 2; i++)
+	{
+		u16 const sample(little_endianize_int16(u16(sound[i])));
+		m_audio.append(&sample, sizeof(sample));
+	}
+	m_samples += numsamples;
+}
+
+
+//-------------------------------------------------
+//  frame - hash the frame that just finished
+//-------------------------------------------------
+
+void frame_hasher::frame()
+{
+	frame_record entry;
+	entry.frame = ++m_frames;
+	entry.audio = m_audio.finish();
+	entry.samples = m_samples;
+	m_audio.reset();
+	m_samples = 0;
+
+	// the size of each screen is part of the output too
+	util::crc32_creator video;
+	for (screen_device &screen : screen_device_enumerator(m_machine.root_device()))
+	{
+		rectangle const &visarea(screen.visible_area());
+		u32 const size[2] = { little_endianize_int32(u32(visarea.width())), little_endianize_int32(u32(visarea.height())) };
+		video.append(size, sizeof(size));
+		if (visarea.empty())
+			continue;
+
+		std::size_t const pixels(std::size_t(visarea.width()) * std::size_t(visarea.height()));
+		if (m_pixels.size() < pixels)
+			m_pixels.resize(pixels);
+		screen.pixels(&m_pixels[0]);
+		for (std::size_t i = 0; i < pixels; i++)
+			m_pixels[i] = little_endianize_int32(m_pixels[i]);
+		video.append(&m_pixels[0], pixels * sizeof(u32));
+	}
+	entry.video = video.finish();
+
+	if (m_file)
+		m_file->printf("%u %s %s %u\n", entry.frame, entry.video.as_string(), entry.audio.as_string(), entry.samples);
+
+	if (!m_reference.empty() && (m_frames <= m_reference.size()))
+	{
+		frame_record const &expected(m_reference[m_frames - 1]);
+		if ((expected.frame != entry.frame) || (expected.video != entry.video) || (expected.audio != entry.audio) || (expected.samples != entry.samples))
+		{
+			if (!m_mismatches++)
+			{
+				m_first_mismatch = m_frames;
+				osd_printf_error("Frame hash: frame %u differs from the reference (video %s, expected %s; audio %s/%u, expected %s/%u)\n",
+						m_frames,
+						entry.video.as_string(), expected.video.as_string(),
+						entry.audio.as_string(), entry.samples, expected.audio.as_string(), expected.samples);
+
+				// there's no need to keep going unless the hashes are also being written
+				if (!m_file)
+					m_machine.schedule_exit();
+			}
+		}
+		else if ((m_frames == m_reference.size()) && !m_file)
+		{
+			// everything in the reference has been compared
+			m_machine.schedule_exit();
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  finish - summarise the run and report whether
+//  it matched the reference
+//-------------------------------------------------
+
+std::string frame_hasher::finish()
+{
+	double const host(double(osd_ticks() - m_start_ticks) / double(osd_ticks_per_second()));
+	double const emulated((m_machine.time() - m_start_emutime).as_double());
+	osd_printf_info("Frame hash: %u frames, %.3f emulated seconds in %.3f host seconds (%.2f%%)\n",
+			m_frames, emulated, host, host ? (emulated * 100.0 / host) : 0.0);
+
+	if (m_reference.empty())
+		return std::string();
+	else if (m_mismatches)
+		return util::string_format("%u frame(s) differ from the frame hash reference, starting at frame %u", m_mismatches, m_first_mismatch);
+	else if (m_frames < m_reference.size())
+		return util::string_format("Only %u of %u reference frames were produced", m_frames, m_reference.size());
+	osd_printf_info("Frame hash: all %u reference frames matched\n", m_reference.size());
+	return std::string();
+}
@@ -0,0 +1,82 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    framehash.h
+
+    Per-frame output hashing for regression checks (-framehash,
+    -framehashcheck).
+
+***************************************************************************/
+
+#ifndef MAME_EMU_FRAMEHASH_H
+#define MAME_EMU_FRAMEHASH_H
+
+#pragma once
+
+#include "hashing.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> frame_hasher
+
+class frame_hasher
+{
+public:
+	typedef std::unique_ptr<frame_hasher> ptr;
+
+	// dtor
+	~frame_hasher();
+
+	// mixed sound generated since the last frame
+	void add_sound(const s16 *sound, int numsamples);
+
+	// hash the frame that just finished
+	void frame();
+
+	// report the outcome; returns an empty string on success
+	std::string finish();
+
+	// statics
+	static ptr create(running_machine &machine, std::string_view record, std::string_view check);
+
+private:
+	// hashes for one frame
+	struct frame_record
+	{
+		u64                 frame;
+		util::crc32_t       video;
+		util::crc32_t       audio;
+		u32                 samples;
+	};
+
+	// ctor
+	frame_hasher(running_machine &machine);
+	frame_hasher(frame_hasher const &) = delete;
+	frame_hasher &operator=(frame_hasher const &) = delete;
+
+	// internal helpers
+	bool load_reference(std::string_view filename);
+
+	running_machine &   m_machine;
+	std::unique_ptr<emu_file> m_file;       // hashes being written, null if only checking
+	std::vector<frame_record> m_reference;  // hashes being checked against
+	std::vector<u32>    m_pixels;           // scratch buffer for screen contents
+	util::crc32_creator m_audio;            // sound since the last frame
+	u32                 m_samples;          // sample frames since the last frame
+	u64                 m_frames;           // frames hashed
+	u64                 m_mismatches;       // frames that differed from the reference
+	u64                 m_first_mismatch;   // first frame that differed, 0 if none
+	osd_ticks_t         m_start_ticks;      // host time hashing started
+	attotime            m_start_emutime;    // emulated time hashing started
+};
+
+#endif // MAME_EMU_FRAMEHASH_H
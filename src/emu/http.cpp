@@ -192,14 +192,17 @@ public:
 };
 
 /** An HTTP response. */
-struct http_response_impl : public http_manager::http_response {
+struct http_response_impl : public http_manager::http_response, public std::enable_shared_from_this<http_response_impl> {
 	std::shared_ptr<webpp::Response> m_response;
+	std::shared_ptr<asio::io_context> m_io_context;
 	int m_status;
 	std::string m_content_type;
 	std::stringstream m_headers;
 	std::stringstream m_body;
+	bool m_deferred = false;
 
-	http_response_impl(std::shared_ptr<webpp::Response> response) : m_response(std::move(response)) { }
+	http_response_impl(std::shared_ptr<webpp::Response> response, std::shared_ptr<asio::io_context> io_context)
+		: m_response(std::move(response)), m_io_context(std::move(io_context)) { }
 
 	virtual ~http_response_impl() = default;
 
@@ -224,6 +227,19 @@ struct http_response_impl : public http_manager::http_response {
 		m_body << body;
 	}
 
+	/** Keeps the response open after the handler returns, so it can be filled in later. */
+	virtual void defer() {
+		m_deferred = true;
+	}
+
+	/** Sends a deferred response from the server thread; the last reference to the underlying response writes it out. */
+	virtual void complete() {
+		asio::post(*m_io_context, [self = shared_from_this()] () {
+			self->send();
+			self->m_response.reset();
+		});
+	}
+
 	/** Sends the response to the client. */
 	void send() {
 		m_response->type(m_content_type);
@@ -266,6 +282,17 @@ struct websocket_connection_impl : public http_manager::websocket_connection {
 		}
 	}
 
+	/** Sends a message and reports when it has gone out, so the sender can avoid queueing up more than the client reads. */
+	virtual void send_message(const void *payload, std::size_t length, int opcode, std::function<void(bool)> sent) {
+		if (auto connection = m_connection.lock()) {
+			std::shared_ptr<webpp::ws_server::SendStream> message_stream = std::make_shared<webpp::ws_server::SendStream>();
+			message_stream->write(reinterpret_cast<const char *>(payload), length);
+			m_wsserver->send(connection, message_stream, [sent = std::move(sent)] (const std::error_code &ec) { if (sent) sent(!ec); }, opcode | 0x80);
+		} else if (sent) {
+			sent(false);
+		}
+	}
+
 	/** Closes this open Websocket connection. */
 	virtual void close() {
 		if (auto connection = m_connection.lock()) {
@@ -361,13 +388,14 @@ http_manager::~http_manager()
 		m_server_thread.join();
 }
 
-static void on_get(http_manager::http_handler handler, std::shared_ptr<webpp::Response> response, std::shared_ptr<webpp::Request> request) {
+static void on_get(http_manager::http_handler handler, std::shared_ptr<asio::io_context> io_context, std::shared_ptr<webpp::Response> response, std::shared_ptr<webpp::Request> request) {
 	auto request_impl = std::make_shared<http_request_impl>(request);
-	auto response_impl = std::make_shared<http_response_impl>(response);
+	auto response_impl = std::make_shared<http_response_impl>(std::move(response), std::move(io_context));
 
 	handler(request_impl, response_impl);
 
-	response_impl->send();
+	if (!response_impl->m_deferred)
+		response_impl->send();
 }
 
 void http_manager::on_open(http_manager::websocket_endpoint_ptr endpoint, std::shared_ptr<webpp::Connection> connection) {
@@ -509,7 +537,7 @@ void http_manager::add_http_handler(const std::string &path, http_manager::http_
 	if (!m_active) return;
 
 	using namespace std::placeholders;
-	m_server->on_get(path, std::bind(on_get, handler, _1, _2));
+	m_server->on_get(path, std::bind(on_get, handler, m_io_context, _1, _2));
 
 	std::lock_guard<std::mutex> lock(m_handlers_mutex);
 	m_handlers.emplace(path, handler);
@@ -79,6 +79,12 @@ public:
 
 		/** Appends something to the body to be sent to the client. */
 		virtual void append_body(const std::string &body) = 0;
+
+		/** Keeps the response open after the handler returns, so it can be filled in later. */
+		virtual void defer() = 0;
+
+		/** Sends a deferred response. May be called from any thread, but only once. */
+		virtual void complete() = 0;
 	};
 	typedef std::shared_ptr<http_response> http_response_ptr;
 
@@ -88,6 +94,9 @@ public:
 		/** Sends a message to the client that is connected on the other end of this Websocket connection. */
 		virtual void send_message(const std::string &payload, int opcode) = 0;
 
+		/** Sends a message, calling sent on the server thread once it has been written (true) or has failed (false). */
+		virtual void send_message(const void *payload, std::size_t length, int opcode, std::function<void(bool)> sent) = 0;
+
 		/** Closes this open Websocket connection. */
 		virtual void close() = 0;
 
@@ -0,0 +1,598 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    httpscreen.cpp
+
+    Screen snapshots and streaming for the HTTP server.
+
+    The emulation thread only copies the visible area of each screen
+    into a triple-buffered frame at the end of a frame, and only while
+    somebody is asking for frames.  Encoding and sending happens on a
+    thread of its own, so slow clients or expensive encodings never
+    hold up the emulation.
+
+    Endpoints:
+
+        GET /api/screen/png, /api/screen/jpeg, /api/screen/raw
+        GET /api/screen/<n>/png etc. for screens other than the first
+            Returns the next frame.  The response is completed by the
+            encoder thread, so the server thread never waits for the
+            emulation.  If no frame arrives within a couple of seconds,
+            e.g. while stopped in the debugger, it fails with 503.
+
+        WebSocket /api/screen/stream
+            Sends every frame as a binary message.  Text messages
+            made of space-separated settings change the stream:
+            format=jpeg|png|raw, screen=<n>, quality=<1-100>.  A
+            client that hasn't received the previous frame yet skips
+            frames instead of queueing them up.
+
+    Raw frames are a little-endian header of width (32 bits), height
+    (32 bits) and frame number (64 bits), followed by 32-bit xRGB
+    pixels in host byte order.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "httpscreen.h"
+
+#include "screen.h"
+
+#include "ioprocs.h"
+#include "png.h"
+
+#include "jpeglib.h"
+#include "jerror.h"
+
+#include <algorithm>
+#include <chrono>
+#include <csetjmp>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+
+namespace {
+
+// how long an HTTP snapshot can wait for the emulation to finish a frame
+constexpr auto SNAPSHOT_TIMEOUT = std::chrono::seconds(2);
+
+
+class string_write : public util::random_write
+{
+public:
+	string_write(std::string &data) : m_data(data) { }
+
+	virtual std::error_condition finalize() noexcept override { return std::error_condition(); }
+	virtual std::error_condition flush() noexcept override { return std::error_condition(); }
+
+	virtual std::error_condition write(void const *buffer, std::size_t length, std::size_t &actual) noexcept override
+	{
+		std::error_condition const err(write_at(m_position, buffer, length, actual));
+		m_position += actual;
+		return err;
+	}
+
+	virtual std::error_condition write_at(std::uint64_t offset, void const *buffer, std::size_t length, std::size_t &actual) noexcept override
+	{
+		actual = 0;
+		try
+		{
+			if (m_data.size() < (offset + length))
+				m_data.resize(offset + length);
+			std::memcpy(&m_data[offset], buffer, length);
+			actual = length;
+			return std::error_condition();
+		}
+		catch (...)
+		{
+			return std::errc::not_enough_memory;
+		}
+	}
+
+	virtual std::error_condition seek(std::int64_t offset, int whence) noexcept override
+	{
+		std::int64_t const base((SEEK_SET == whence) ? 0 : (SEEK_CUR == whence) ? std::int64_t(m_position) : std::int64_t(m_data.size()));
+		if ((base + offset) < 0)
+			return std::errc::invalid_argument;
+		m_position = std::uint64_t(base + offset);
+		return std::error_condition();
+	}
+
+	virtual std::error_condition tell(std::uint64_t &result) noexcept override { result = m_position; return std::error_condition(); }
+	virtual std::error_condition length(std::uint64_t &result) noexcept override { result = m_data.size(); return std::error_condition(); }
+
+private:
+	std::string &m_data;
+	std::uint64_t m_position = 0;
+};
+
+
+struct jpeg_setjmp_error_mgr : public jpeg_error_mgr
+{
+	jpeg_setjmp_error_mgr()
+	{
+		jpeg_std_error(this);
+		error_exit = [] (j_common_ptr cinfo) { std::longjmp(static_cast<jpeg_setjmp_error_mgr *>(cinfo->err)->m_jump_buffer, 1); };
+	}
+
+	std::jmp_buf m_jump_buffer;
+};
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  HTTP SCREEN STREAMER
+//**************************************************************************
+
+//-------------------------------------------------
+//  http_screen_streamer - constructor
+//-------------------------------------------------
+
+http_screen_streamer::http_screen_streamer(running_machine &machine)
+	: m_machine(machine)
+	, m_screen_count(screen_device_enumerator(machine.root_device()).count())
+	, m_write(0)
+	, m_ready(1)
+	, m_read(2)
+	, m_fresh(false)
+	, m_sequence(0)
+	, m_demand(0)
+	, m_stop(false)
+{
+	machine.add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&http_screen_streamer::frame_notify, this));
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&http_screen_streamer::exit, this));
+
+	m_thread = std::thread([this] () { encoder_loop(); });
+}
+
+
+//-------------------------------------------------
+//  ~http_screen_streamer - destructor
+//-------------------------------------------------
+
+http_screen_streamer::~http_screen_streamer()
+{
+	exit();
+}
+
+
+//-------------------------------------------------
+//  exit - stop the encoder and detach from the
+//  server, which outlives the machine
+//-------------------------------------------------
+
+void http_screen_streamer::exit()
+{
+	if (m_endpoint)
+	{
+		m_endpoint->on_open = nullptr;
+		m_endpoint->on_message = nullptr;
+		m_endpoint->on_close = nullptr;
+		m_endpoint->on_error = nullptr;
+		m_machine.manager().http()->remove_endpoint("/api/screen/stream");
+		m_endpoint.reset();
+	}
+
+	std::vector<std::shared_ptr<client> > clients;
+	std::deque<request> requests;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+		clients.swap(m_clients);
+		requests.swap(m_requests);
+	}
+	m_wake.notify_all();
+	if (m_thread.joinable())
+		m_thread.join();
+
+	for (auto &req : requests)
+		complete(req, 503);
+	for (auto &c : clients)
+		c->connection->close();
+}
+
+
+//-------------------------------------------------
+//  export_http_api - register the snapshot and
+//  stream endpoints
+//-------------------------------------------------
+
+void http_screen_streamer::export_http_api()
+{
+	http_manager &http(*m_machine.manager().http());
+	static char const *const names[] = { "raw", "png", "jpeg" };
+	for (unsigned fmt = 0; fmt < std::size(names); fmt++)
+	{
+		for (unsigned screen = 0; screen < std::max(m_screen_count, 1U); screen++)
+		{
+			std::string const path(screen
+					? util::string_format("/api/screen/%u/%s", screen, names[fmt])
+					: util::string_format("/api/screen/%s", names[fmt]));
+			http.add_http_handler(
+					path,
+					[this, fmt, screen] (http_manager::http_request_ptr request, http_manager::http_response_ptr response)
+					{
+						snapshot(response, format(fmt), screen);
+					});
+		}
+	}
+
+	m_endpoint = http.add_endpoint(
+			"/api/screen/stream",
+			[this] (http_manager::websocket_connection_ptr connection) { stream_open(connection); },
+			[this] (http_manager::websocket_connection_ptr connection, std::string const &payload, int opcode) { stream_message(connection, payload); },
+			[this] (http_manager::websocket_connection_ptr connection, int status, std::string const &reason) { stream_close(connection); },
+			[this] (http_manager::websocket_connection_ptr connection, std::error_code const &error_code) { stream_close(connection); });
+}
+
+
+//-------------------------------------------------
+//  frame_notify - copy the finished screens if
+//  anybody is waiting for them
+//-------------------------------------------------
+
+void http_screen_streamer::frame_notify()
+{
+	if (!m_demand.load(std::memory_order_relaxed) || !m_screen_count)
+		return;
+
+	// the buffer being written is never seen by the encoder, so no lock is needed here
+	frame &target(m_frames[m_write]);
+	target.sequence = ++m_sequence;
+	target.screens.resize(m_screen_count);
+	unsigned index(0);
+	for (screen_device &screen : screen_device_enumerator(m_machine.root_device()))
+	{
+		screen_image &image(target.screens[index++]);
+		rectangle const &visarea(screen.visible_area());
+		image.width = visarea.width();
+		image.height = visarea.height();
+		image.pixels.resize(std::size_t(image.width) * image.height);
+		if (!image.pixels.empty())
+			screen.pixels(&image.pixels[0]);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::swap(m_write, m_ready);
+		m_fresh = true;
+	}
+	m_wake.notify_one();
+}
+
+
+//-------------------------------------------------
+//  encoder_loop - encode and send frames as they
+//  become available
+//-------------------------------------------------
+
+void http_screen_streamer::encoder_loop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (!m_stop)
+	{
+		// wake up for a new frame, or when the oldest snapshot request expires
+		if (m_requests.empty())
+			m_wake.wait(lock, [this] () { return m_stop || m_fresh; });
+		else
+			m_wake.wait_until(lock, m_requests.front().deadline, [this] () { return m_stop || m_fresh; });
+		if (m_stop)
+			break;
+
+		if (!m_fresh)
+		{
+			// the emulation isn't producing frames, so fail the requests that have waited too long
+			auto const now(std::chrono::steady_clock::now());
+			std::deque<request> expired;
+			while (!m_requests.empty() && (m_requests.front().deadline <= now))
+			{
+				expired.push_back(std::move(m_requests.front()));
+				m_requests.pop_front();
+				m_demand--;
+			}
+			lock.unlock();
+			for (auto &req : expired)
+				complete(req, 503);
+			lock.lock();
+			continue;
+		}
+
+		// take the latest frame, then work out who wants it
+		std::swap(m_read, m_ready);
+		m_fresh = false;
+		frame const &current(m_frames[m_read]);
+
+		std::deque<request> requests;
+		requests.swap(m_requests);
+		std::vector<std::shared_ptr<client> > clients;
+		for (auto &c : m_clients)
+		{
+			if (!c->busy && (c->last_sent < current.sequence))
+			{
+				c->busy = true;
+				c->last_sent = current.sequence;
+				clients.push_back(c);
+			}
+		}
+		lock.unlock();
+
+		// encode each combination once per frame
+		struct encoded { format fmt; unsigned screen; int quality; std::string data; bool ok; };
+		std::vector<encoded> cache;
+		auto const get =
+			[&cache, &current] (format fmt, unsigned screen, int quality) -> encoded const &
+			{
+				for (encoded const &e : cache)
+					if ((e.fmt == fmt) && (e.screen == screen) && ((fmt != format::JPEG) || (e.quality == quality)))
+						return e;
+				encoded &e(cache.emplace_back(encoded{ fmt, screen, quality, std::string(), false }));
+				if (screen < current.screens.size())
+					e.ok = encode(current.screens[screen], current.sequence, fmt, quality, e.data);
+				return e;
+			};
+
+		for (auto &req : requests)
+		{
+			encoded const &e(get(req.fmt, req.screen, 85));
+			if (e.ok)
+				complete(req, 200, req.fmt, e.data);
+			else
+				complete(req, 500);
+			m_demand--;
+		}
+
+		for (auto &c : clients)
+		{
+			encoded const &e(get(c->fmt, c->screen, c->quality));
+			if (!e.ok)
+			{
+				std::lock_guard<std::mutex> clientlock(m_mutex);
+				c->busy = false;
+				continue;
+			}
+			std::weak_ptr<client> weak(c);
+			c->connection->send_message(
+					e.data.data(),
+					e.data.size(),
+					0x02,
+					[this, weak] (bool sent)
+					{
+						if (auto const c = weak.lock())
+						{
+							std::lock_guard<std::mutex> clientlock(m_mutex);
+							c->busy = false;
+						}
+					});
+		}
+
+		lock.lock();
+	}
+}
+
+
+//-------------------------------------------------
+//  encode - encode a screen in the given format
+//-------------------------------------------------
+
+bool http_screen_streamer::encode(screen_image const &image, u64 sequence, format fmt, int quality, std::string &result)
+{
+	if (!image.width || !image.height)
+		return false;
+
+	switch (fmt)
+	{
+	case format::RAW:
+		{
+			u8 header[16];
+			for (unsigned i = 0; i < 4; i++)
+			{
+				header[i] = u8(image.width >> (8 * i));
+				header[4 + i] = u8(image.height >> (8 * i));
+			}
+			for (unsigned i = 0; i < 8; i++)
+				header[8 + i] = u8(sequence >> (8 * i));
+			result.reserve(sizeof(header) + (image.pixels.size() * sizeof(u32)));
+			result.assign(reinterpret_cast<char const *>(header), sizeof(header));
+			result.append(reinterpret_cast<char const *>(&image.pixels[0]), image.pixels.size() * sizeof(u32));
+		}
+		return true;
+	case format::PNG:
+		return encode_png(image, result);
+	case format::JPEG:
+		return encode_jpeg(image, quality, result);
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  encode_png - encode a screen as PNG
+//-------------------------------------------------
+
+bool http_screen_streamer::encode_png(screen_image const &image, std::string &result)
+{
+	// the bitmap only wraps the pixels, it never writes to them
+	bitmap_rgb32 const bitmap(const_cast<u32 *>(&image.pixels[0]), image.width, image.height, image.width);
+	string_write file(result);
+	util::png_info pnginfo;
+	return !util::png_write_bitmap(file, &pnginfo, bitmap, 0, nullptr);
+}
+
+
+//-------------------------------------------------
+//  encode_jpeg - encode a screen as baseline
+//  JPEG
+//-------------------------------------------------
+
+bool http_screen_streamer::encode_jpeg(screen_image const &image, int quality, std::string &result)
+{
+	jpeg_compress_struct cinfo;
+	jpeg_setjmp_error_mgr jerr;
+	unsigned char *buffer(nullptr);
+	unsigned long size(0);
+	std::vector<JSAMPLE> row(std::size_t(image.width) * 3);
+
+	cinfo.err = &jerr;
+	if (setjmp(jerr.m_jump_buffer))
+	{
+		jpeg_destroy_compress(&cinfo);
+		std::free(buffer);
+		return false;
+	}
+
+	jpeg_create_compress(&cinfo);
+	jpeg_mem_dest(&cinfo, &buffer, &size);
+	cinfo.image_width = image.width;
+	cinfo.image_height = image.height;
+	cinfo.input_components = 3;
+	cinfo.in_color_space = JCS_RGB;
+	jpeg_set_defaults(&cinfo);
+	jpeg_set_quality(&cinfo, std::clamp(quality, 1, 100), TRUE);
+	jpeg_start_compress(&cinfo, TRUE);
+
+	u32 const *src(&image.pixels[0]);
+	while (cinfo.next_scanline < cinfo.image_height)
+	{
+		JSAMPLE *dst(&row[0]);
+		for (u32 x = 0; x < image.width; x++)
+		{
+			rgb_t const pixel(*src++);
+			*dst++ = pixel.r();
+			*dst++ = pixel.g();
+			*dst++ = pixel.b();
+		}
+		JSAMPROW rows[1] = { &row[0] };
+		jpeg_write_scanlines(&cinfo, rows, 1);
+	}
+
+	jpeg_finish_compress(&cinfo);
+	result.assign(reinterpret_cast<char const *>(buffer), size);
+	jpeg_destroy_compress(&cinfo);
+	std::free(buffer);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  complete - finish a deferred snapshot response
+//-------------------------------------------------
+
+void http_screen_streamer::complete(request &req, int status, format fmt, std::string const &data)
+{
+	static char const *const types[] = { "application/octet-stream", "image/png", "image/jpeg" };
+	req.response->set_status(status);
+	if (status == 200)
+	{
+		req.response->set_content_type(types[unsigned(fmt)]);
+		req.response->set_body(data);
+	}
+	req.response->complete();
+}
+
+
+//-------------------------------------------------
+//  snapshot - queue an HTTP request for the next
+//  frame, called on the server thread
+//-------------------------------------------------
+
+void http_screen_streamer::snapshot(http_manager::http_response_ptr response, format fmt, unsigned screen)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (m_stop)
+	{
+		response->set_status(503);
+		return;
+	}
+
+	// the encoder thread sends the response, so the server thread can go back to serving other clients
+	response->defer();
+	m_requests.push_back(request{ std::move(response), fmt, screen, std::chrono::steady_clock::now() + SNAPSHOT_TIMEOUT });
+	m_demand++;
+	if (m_requests.size() == 1)
+		m_wake.notify_one();
+}
+
+
+//-------------------------------------------------
+//  stream_open - start streaming to a new
+//  WebSocket client
+//-------------------------------------------------
+
+void http_screen_streamer::stream_open(http_manager::websocket_connection_ptr connection)
+{
+	auto const c(std::make_shared<client>());
+	c->connection = connection;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_stop)
+	{
+		m_clients.push_back(c);
+		m_demand++;
+	}
+}
+
+
+//-------------------------------------------------
+//  stream_message - change stream settings
+//-------------------------------------------------
+
+void http_screen_streamer::stream_message(http_manager::websocket_connection_ptr connection, std::string const &payload)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (auto &c : m_clients)
+	{
+		if (c->connection != connection)
+			continue;
+
+		std::string::size_type pos(0);
+		while (pos < payload.length())
+		{
+			std::string::size_type const end(std::min(payload.find(' ', pos), payload.length()));
+			std::string const item(payload.substr(pos, end - pos));
+			pos = end + 1;
+
+			std::string::size_type const eq(item.find('='));
+			if (eq == std::string::npos)
+				continue;
+			std::string const key(item.substr(0, eq));
+			std::string const value(item.substr(eq + 1));
+			if (key == "format")
+			{
+				if (value == "raw")
+					c->fmt = format::RAW;
+				else if (value == "png")
+					c->fmt = format::PNG;
+				else if ((value == "jpeg") || (value == "jpg"))
+					c->fmt = format::JPEG;
+			}
+			else if (key == "screen")
+			{
+				c->screen = unsigned(std::strtoul(value.c_str(), nullptr, 10));
+			}
+			else if (key == "quality")
+			{
+				c->quality = std::clamp(std::atoi(value.c_str()), 1, 100);
+			}
+		}
+		break;
+	}
+}
+
+
+//-------------------------------------------------
+//  stream_close - forget a WebSocket client
+//-------------------------------------------------
+
+void http_screen_streamer::stream_close(http_manager::websocket_connection_ptr connection)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto const found(std::find_if(m_clients.begin(), m_clients.end(), [&connection] (auto const &c) { return c->connection == connection; }));
+	if (found != m_clients.end())
+	{
+		m_clients.erase(found);
+		m_demand--;
+	}
+}
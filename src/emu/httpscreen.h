@@ -0,0 +1,127 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    httpscreen.h
+
+    Screen snapshots and streaming for the HTTP server.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef MAME_EMU_HTTPSCREEN_H
+#define MAME_EMU_HTTPSCREEN_H
+
+#include "http.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> http_screen_streamer
+
+class http_screen_streamer
+{
+public:
+	// construction/destruction
+	http_screen_streamer(running_machine &machine);
+	~http_screen_streamer();
+
+	// register the endpoints; the HTTP manager drops handlers whenever a machine starts running
+	void export_http_api();
+
+private:
+	// encodings offered to clients
+	enum class format
+	{
+		RAW,
+		PNG,
+		JPEG
+	};
+
+	// the visible area of one screen as xRGB pixels
+	struct screen_image
+	{
+		u32                 width = 0;
+		u32                 height = 0;
+		std::vector<u32>    pixels;
+	};
+
+	// all screens at the end of one frame
+	struct frame
+	{
+		u64                 sequence = 0;       // frame counter, 0 if never filled
+		std::vector<screen_image> screens;
+	};
+
+	// a WebSocket client receiving a stream
+	struct client
+	{
+		http_manager::websocket_connection_ptr connection;
+		format              fmt = format::JPEG;
+		unsigned            screen = 0;
+		int                 quality = 75;
+		bool                busy = false;       // a frame is still being sent
+		u64                 last_sent = 0;      // sequence number of the last frame sent
+	};
+
+	// an HTTP snapshot request waiting for the next frame
+	struct request
+	{
+		http_manager::http_response_ptr response; // deferred until a frame arrives or the deadline passes
+		format              fmt;
+		unsigned            screen;
+		std::chrono::steady_clock::time_point deadline;
+	};
+
+	// notifiers
+	void frame_notify();
+	void exit();
+
+	// encoder thread
+	void encoder_loop();
+	static bool encode(screen_image const &image, u64 sequence, format fmt, int quality, std::string &result);
+	static bool encode_png(screen_image const &image, std::string &result);
+	static bool encode_jpeg(screen_image const &image, int quality, std::string &result);
+	static void complete(request &req, int status, format fmt = format::RAW, std::string const &data = std::string());
+
+	// HTTP and WebSocket handlers
+	void snapshot(http_manager::http_response_ptr response, format fmt, unsigned screen);
+	void stream_open(http_manager::websocket_connection_ptr connection);
+	void stream_message(http_manager::websocket_connection_ptr connection, std::string const &payload);
+	void stream_close(http_manager::websocket_connection_ptr connection);
+
+	running_machine &   m_machine;
+	unsigned const      m_screen_count;
+
+	// triple buffer: the emulation fills one frame, the encoder reads another, the third is the latest complete one
+	frame               m_frames[3];
+	unsigned            m_write;                // only touched by the emulation thread
+	unsigned            m_ready;                // protected by m_mutex
+	unsigned            m_read;                 // only touched by the encoder thread
+	bool                m_fresh;                // m_ready holds a frame the encoder hasn't taken yet
+	u64                 m_sequence;             // last frame captured
+	std::atomic<unsigned> m_demand;             // clients and requests waiting for frames
+
+	std::mutex          m_mutex;
+	std::condition_variable m_wake;
+	bool                m_stop;
+	std::vector<std::shared_ptr<client>> m_clients;
+	std::deque<request> m_requests;
+	http_manager::websocket_endpoint_ptr m_endpoint;
+	std::thread         m_thread;
+};
+
+#endif // MAME_EMU_HTTPSCREEN_H
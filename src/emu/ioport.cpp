@@ -96,9 +96,13 @@
 #include "fileio.h"
 #include "xmlfile.h"
 #include "profiler.h"
+#include "screen.h"
 #include "ui/uimain.h"
 #include "inputdev.h"
 #include "natkeyboard.h"
+#include "netplay.h"
+#include "debugger.h"
+#include "debug/debugcpu.h"
 
 #include "util/corestr.h"
 #include "util/ioprocsfilter.h"
@@ -109,6 +113,7 @@
 
 #include <cctype>
 #include <ctime>
+#include <sstream>
 
 
 namespace {
@@ -349,8 +354,9 @@ class inp_header
 {
 public:
 	// parameters
-	static constexpr unsigned MAJVERSION = 3;
+	static constexpr unsigned MAJVERSION = 4;
 	static constexpr unsigned MINVERSION = 0;
+	static constexpr unsigned LEGACY_MAJVERSION = 3;    // single zlib stream, full values every frame
 
 	bool read(emu_file &f)
 	{
@@ -385,6 +391,14 @@ public:
 	{
 		return m_data[OFFS_MINVERSION];
 	}
+	unsigned get_polls() const
+	{
+		return m_data[OFFS_POLLS] ? m_data[OFFS_POLLS] : 1;
+	}
+	bool get_poll_on_read() const
+	{
+		return BIT(m_data[OFFS_POLLFLAGS], 0);
+	}
 	std::string get_sysname() const
 	{
 		return get_string<OFFS_SYSNAME, OFFS_APPDESC>();
@@ -414,6 +428,11 @@ public:
 		m_data[OFFS_MAJVERSION] = MAJVERSION;
 		m_data[OFFS_MINVERSION] = MINVERSION;
 	}
+	void set_polls(unsigned polls, bool on_read)
+	{
+		m_data[OFFS_POLLS] = u8(polls);
+		m_data[OFFS_POLLFLAGS] = on_read ? 0x01 : 0x00;
+	}
 	void set_sysname(std::string const &name)
 	{
 		set_string<OFFS_SYSNAME, OFFS_APPDESC>(name);
@@ -441,7 +460,8 @@ private:
 	static constexpr std::size_t    OFFS_BASETIME    = 0x08;    // 0x08 bytes (little-endian binary integer)
 	static constexpr std::size_t    OFFS_MAJVERSION  = 0x10;    // 0x01 bytes (binary integer)
 	static constexpr std::size_t    OFFS_MINVERSION  = 0x11;    // 0x01 bytes (binary integer)
-																// 0x02 bytes reserved
+	static constexpr std::size_t    OFFS_POLLS       = 0x12;    // 0x01 bytes (binary integer, 0 = once per frame; since 3.1)
+	static constexpr std::size_t    OFFS_POLLFLAGS   = 0x13;    // 0x01 bytes (bit 0 = poll on read; since 3.1)
 	static constexpr std::size_t    OFFS_SYSNAME     = 0x14;    // 0x0c bytes (ASCII)
 	static constexpr std::size_t    OFFS_APPDESC     = 0x20;    // 0x20 bytes (ASCII)
 	static constexpr std::size_t    OFFS_END         = 0x40;
@@ -451,6 +471,51 @@ private:
 	u8                              m_data[OFFS_END];
 };
 
+
+// ======================> inp_chunk_header
+
+// version 4 files are a sequence of chunks following the file header:
+//  - FRAMES: zlib-compressed input updates, starting with a full copy of the ports
+//  - KEYFRAME: emulated time, then a zlib-compressed save state taken just before the FRAMES chunk that follows
+//  - INDEX: offset and time of every keyframe, followed by a trailer at the very end of the file
+// a chunk with zero length was still being written when recording stopped and extends to the end of the file
+class inp_chunk_header
+{
+public:
+	static constexpr u32 FRAMES   = 0x534d5246; // "FRMS"
+	static constexpr u32 KEYFRAME = 0x4659454b; // "KEYF"
+	static constexpr u32 INDEX    = 0x58444e49; // "INDX"
+
+	static constexpr std::size_t SIZE = 0x18;
+	static constexpr std::size_t TIME_SIZE = 0x10;          // seconds, attoseconds
+	static constexpr std::size_t INDEX_ENTRY_SIZE = 0x18;   // chunk offset, seconds, attoseconds
+	static constexpr std::size_t TRAILER_SIZE = 0x10;       // index chunk offset, magic
+
+	static u8 const TRAILER_MAGIC[8];
+
+	inp_chunk_header(u32 type = 0) { std::fill(std::begin(m_data), std::end(m_data), 0); put_u32(m_data + 0x00, type); }
+
+	bool read(emu_file &f) { return f.read(m_data, sizeof(m_data)) == sizeof(m_data); }
+	bool write(emu_file &f) const { return f.write(m_data, sizeof(m_data)) == sizeof(m_data); }
+
+	u32 get_type() const { return get_u32(m_data + 0x00); }
+	u64 get_length() const { return get_u64(m_data + 0x08); }   // bytes following the header
+	u64 get_count() const { return get_u64(m_data + 0x10); }    // records, uncompressed state size or index entries
+
+	void set_length(u64 length) { put_u64(m_data + 0x08, length); }
+	void set_count(u64 count) { put_u64(m_data + 0x10, count); }
+
+	static u32 get_u32(u8 const *src) { return u32(src[0]) | (u32(src[1]) << 8) | (u32(src[2]) << 16) | (u32(src[3]) << 24); }
+	static u64 get_u64(u8 const *src) { return u64(get_u32(src)) | (u64(get_u32(src + 4)) << 32); }
+	static void put_u32(u8 *dest, u32 value) { for (int i = 0; i < 4; i++) dest[i] = u8(value >> (i * 8)); }
+	static void put_u64(u8 *dest, u64 value) { put_u32(dest, u32(value)); put_u32(dest + 4, u32(value >> 32)); }
+	static attotime get_time(u8 const *src) { return attotime(seconds_t(s64(get_u64(src))), attoseconds_t(get_u64(src + 8))); }
+	static void put_time(u8 *dest, attotime const &time) { put_u64(dest, u64(s64(time.seconds()))); put_u64(dest + 8, u64(time.attoseconds())); }
+
+private:
+	u8 m_data[SIZE];
+};
+
 } // anonymous namespace
 
 
@@ -459,6 +524,7 @@ const char *const ioport_manager::seqtypestrings[] = { "standard", "increment",
 
 
 u8 const inp_header::MAGIC[inp_header::OFFS_BASETIME - inp_header::OFFS_MAGIC] = { 'M', 'A', 'M', 'E', 'I', 'N', 'P', 0 };
+u8 const inp_chunk_header::TRAILER_MAGIC[8] = { 'M', 'A', 'M', 'E', 'I', 'D', 'X', 0 };
 
 
 
@@ -1646,6 +1712,9 @@ ioport_value ioport_port::read()
 	if (!manager().safe_to_read())
 		throw emu_fatalerror("Input ports cannot be read at init time!");
 
+	// pick up input that arrived since the last update
+	manager().read_poll();
+
 	// start with the digital state
 	ioport_value result = m_live->digital;
 
@@ -1846,8 +1915,24 @@ ioport_manager::ioport_manager(running_machine &machine)
 	, m_safe_to_read(false)
 	, m_last_frame_time(attotime::zero)
 	, m_last_delta_nsec(0)
+	, m_polls_per_frame(1)
+	, m_poll_on_read(false)
+	, m_updating(false)
+	, m_poll_interval(attotime::never)
+	, m_poll_timer(nullptr)
 	, m_playback_accumulated_speed(0)
 	, m_playback_accumulated_frames(0)
+	, m_playback_legacy(false)
+	, m_playback_next(0)
+	, m_playback_records(0)
+	, m_playback_seek(0)
+	, m_playback_cursor(0)
+	, m_record_chunk(0)
+	, m_record_count(0)
+	, m_record_cursor(0)
+	, m_keyframe_interval(attotime::never)
+	, m_next_keyframe(attotime::never)
+	, m_keyframe_pending(false)
 	, m_deselected_card_config()
 {
 	for (auto &entries : m_type_to_entry)
@@ -1866,6 +1951,11 @@ time_t ioport_manager::initialize()
 	machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&ioport_manager::exit, this));
 	machine().add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&ioport_manager::frame_update_callback, this));
 
+	// sub-frame polling; playback overrides this with the settings it was recorded with
+	m_polls_per_frame = std::clamp(machine().options().input_polls(), 1, 16);
+	m_poll_on_read = machine().options().input_poll_on_read();
+	m_poll_timer = machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(ioport_manager::poll_callback), this));
+
 	// initialize the default port info from the OSD
 	init_port_types();
 
@@ -2184,7 +2274,66 @@ void ioport_manager::frame_update_callback()
 {
 	// if we're paused, don't do anything
 	if (!machine().paused())
+	{
 		frame_update();
+
+		// spread the remaining updates for this frame evenly over the primary screen's frame period
+		screen_device *const screen = screen_device_enumerator(machine().root_device()).first();
+		if (screen && ((m_polls_per_frame > 1) || m_poll_on_read))
+		{
+			m_poll_interval = attotime(0, screen->frame_period().as_attoseconds() / m_polls_per_frame);
+			if (m_polls_per_frame > 1)
+				m_poll_timer->adjust(m_poll_interval, 1);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  poll_callback - timer callback for updating
+//  input between frames
+//-------------------------------------------------
+
+TIMER_CALLBACK_MEMBER(ioport_manager::poll_callback)
+{
+	poll();
+
+	// the last update of the frame comes from the frame callback
+	if (unsigned(param + 1) < m_polls_per_frame)
+		m_poll_timer->adjust(m_poll_interval, param + 1);
+}
+
+
+//-------------------------------------------------
+//  poll_if_due - update input when an emulated
+//  device reads a port, if at least one poll
+//  interval has passed since the last update
+//-------------------------------------------------
+
+void ioport_manager::poll_if_due()
+{
+	// only reads made by emulated devices count, so that recordings stay deterministic
+	if (m_updating || !m_safe_to_read || machine().paused() || !machine().scheduler().currently_executing())
+		return;
+	if ((machine().time() - m_last_frame_time) < m_poll_interval)
+		return;
+
+	poll();
+}
+
+
+//-------------------------------------------------
+//  poll - fetch new input from the OSD and update
+//  the ports between frames
+//-------------------------------------------------
+
+void ioport_manager::poll()
+{
+	if (machine().paused())
+		return;
+
+	machine().osd().input_update();
+	frame_update();
 }
 
 
@@ -2196,6 +2345,7 @@ void ioport_manager::frame_update_callback()
 void ioport_manager::frame_update()
 {
 	g_profiler.start(PROFILER_INPUT);
+	m_updating = true;
 
 	// record/playback information about the current frame
 	attotime curtime = machine().time();
@@ -2222,21 +2372,46 @@ void ioport_manager::frame_update()
 	{
 		port.second->frame_update();
 
-		// handle playback/record
+		// handle playback
 		playback_port(*port.second.get());
+	}
+
+	// let rollback netplay substitute the inputs agreed with its peer
+	if (machine().netplay())
+		machine().netplay()->frame_input();
+
+	// let the debugger log the inputs, or substitute the logged ones when replaying for reverse execution
+	if (machine().debug_flags & DEBUG_FLAG_ENABLED)
+		machine().debugger().cpu().reverse_input();
+
+	for (auto &port : m_portlist)
+	{
+		// handle record
 		record_port(*port.second.get());
 
 		// call device line write handlers
-		ioport_value newvalue = port.second->read();
-		for (dynamic_field &dynfield : port.second->live().writelist)
-			if (dynfield.field().type() != IPT_OUTPUT)
-				dynfield.write(newvalue);
+		update_port_writes(*port.second);
 	}
 
+	m_updating = false;
 	g_profiler.stop();
 }
 
 
+//-------------------------------------------------
+//  update_port_writes - call the device line
+//  write handlers with a port's current value
+//-------------------------------------------------
+
+void ioport_manager::update_port_writes(ioport_port &port)
+{
+	ioport_value const newvalue = port.read();
+	for (dynamic_field &dynfield : port.live().writelist)
+		if (dynfield.field().type() != IPT_OUTPUT)
+			dynfield.write(newvalue);
+}
+
+
 //-------------------------------------------------
 //  frame_interpolate - interpolate between two
 //  values based on the time between frames
@@ -2909,6 +3084,63 @@ bool ioport_manager::playback_read<bool>(bool &result)
 }
 
 
+//-------------------------------------------------
+//  playback_varint - read a variable-length
+//  integer from the current chunk
+//-------------------------------------------------
+
+bool ioport_manager::playback_varint(u64 &result)
+{
+	result = 0;
+	for (unsigned shift = 0; 64 > shift; shift += 7)
+	{
+		// protect against nullptr handles if previous reads fail
+		if (!m_playback_stream)
+			return false;
+
+		// read the next seven bits; if we fail, end playback
+		u8 byte;
+		size_t read;
+		m_playback_stream->read(&byte, 1, read);
+		if (1 != read)
+		{
+			playback_end("End of file");
+			return false;
+		}
+
+		result |= u64(byte & 0x7f) << shift;
+		if (!BIT(byte, 7))
+			return true;
+	}
+
+	playback_end("Input file is corrupt");
+	return false;
+}
+
+
+//-------------------------------------------------
+//  playback_field - read the next field of an
+//  input update
+//-------------------------------------------------
+
+template<typename Type>
+Type ioport_manager::playback_field(Type &result)
+{
+	// version 3 files store every field in full
+	if (m_playback_legacy)
+		return playback_read(result);
+
+	// otherwise it's the zigzag-encoded difference from the same field in the previous update
+	if (m_playback_cursor >= m_playback_last.size())
+		m_playback_last.push_back(0);
+	s64 &last = m_playback_last[m_playback_cursor++];
+	u64 delta;
+	if (playback_varint(delta))
+		last += s64((delta >> 1) ^ (0 - (delta & 1)));
+	return result = Type(last);
+}
+
+
 //-------------------------------------------------
 //  playback_init - initialize INP playback
 //-------------------------------------------------
@@ -2938,8 +3170,9 @@ time_t ioport_manager::playback_init()
 		fatalerror("Input file is corrupt or invalid (missing header)\n");
 	if (!header.check_magic())
 		fatalerror("Input file invalid or in an older, unsupported format\n");
-	if (header.get_majversion() != inp_header::MAJVERSION)
+	if ((header.get_majversion() != inp_header::MAJVERSION) && (header.get_majversion() != inp_header::LEGACY_MAJVERSION))
 		fatalerror("Input file format version mismatch\n");
+	m_playback_legacy = header.get_majversion() == inp_header::LEGACY_MAJVERSION;
 
 	// output info to console
 	osd_printf_info("Input file: %s\n", filename);
@@ -2953,12 +3186,200 @@ time_t ioport_manager::playback_init()
 	if (sysname != machine().system().name)
 		osd_printf_info("Input file is for machine '%s', not for current machine '%s'\n", sysname, machine().system().name);
 
-	// enable compression
-	m_playback_stream = util::zlib_read(*m_playback_file, 16386);
+	// input must be updated at the same points it was recorded at
+	m_polls_per_frame = header.get_polls();
+	m_poll_on_read = header.get_poll_on_read();
+	if ((m_polls_per_frame > 1) || m_poll_on_read)
+		osd_printf_info("Recorded with %u input polls per frame%s\n", m_polls_per_frame, m_poll_on_read ? " and polling on read" : "");
+
+	// version 3 files are a single compressed stream that can only be played from the start
+	int const offset = machine().options().playback_offset();
+	if (m_playback_legacy)
+	{
+		if (offset > 0)
+			osd_printf_warning("Input file has no keyframes, playing back from the start\n");
+		m_playback_stream = util::zlib_read(*m_playback_file, 16386);
+		return basetime;
+	}
+
+	// if an offset was requested, start from the last keyframe before it once the machine is running
+	if (offset > 0)
+	{
+		std::vector<std::pair<u64, attotime> > keyframes;
+		playback_find_keyframes(keyframes);
+		for (auto const &keyframe : keyframes)
+			if (keyframe.second <= attotime::from_seconds(offset))
+				m_playback_seek = keyframe.first;
+		if (m_playback_seek)
+			return basetime;
+		osd_printf_warning("Input file has no keyframe before %d seconds, playing back from the start\n", offset);
+	}
+
+	// otherwise start with the first chunk
+	m_playback_next = m_playback_file->tell();
+	if (!playback_next_chunk())
+		fatalerror("Input file is corrupt or invalid (no input data)\n");
 	return basetime;
 }
 
 
+//-------------------------------------------------
+//  playback_find_keyframes - list the offsets and
+//  times of the keyframes in the playback file
+//-------------------------------------------------
+
+void ioport_manager::playback_find_keyframes(std::vector<std::pair<u64, attotime> > &keyframes)
+{
+	emu_file &file = *m_playback_file;
+	u64 const start = file.tell();
+	u64 const size = file.size();
+
+	// a complete recording ends with an index
+	u8 trailer[inp_chunk_header::TRAILER_SIZE];
+	inp_chunk_header chunk;
+	if ((size >= (start + sizeof(trailer))) &&
+			!file.seek(size - sizeof(trailer), SEEK_SET) &&
+			(file.read(trailer, sizeof(trailer)) == sizeof(trailer)) &&
+			!std::memcmp(trailer + 8, inp_chunk_header::TRAILER_MAGIC, sizeof(inp_chunk_header::TRAILER_MAGIC)) &&
+			!file.seek(inp_chunk_header::get_u64(trailer), SEEK_SET) &&
+			chunk.read(file) &&
+			(chunk.get_type() == inp_chunk_header::INDEX))
+	{
+		for (u64 i = 0; chunk.get_count() > i; i++)
+		{
+			u8 entry[inp_chunk_header::INDEX_ENTRY_SIZE];
+			if (file.read(entry, sizeof(entry)) != sizeof(entry))
+				break;
+			keyframes.emplace_back(inp_chunk_header::get_u64(entry), inp_chunk_header::get_time(entry + 8));
+		}
+	}
+	else
+	{
+		// otherwise walk the chunks as far as the recording got
+		u64 offset = start;
+		while (!file.seek(offset, SEEK_SET) && chunk.read(file) && chunk.get_length())
+		{
+			if (chunk.get_type() == inp_chunk_header::KEYFRAME)
+			{
+				u8 time[inp_chunk_header::TIME_SIZE];
+				if (file.read(time, sizeof(time)) != sizeof(time))
+					break;
+				keyframes.emplace_back(offset, inp_chunk_header::get_time(time));
+			}
+			offset += inp_chunk_header::SIZE + chunk.get_length();
+		}
+	}
+
+	file.seek(start, SEEK_SET);
+}
+
+
+//-------------------------------------------------
+//  playback_seek - start playback from the
+//  keyframe selected by -playback_offset
+//-------------------------------------------------
+
+void ioport_manager::playback_seek()
+{
+	// only applies if we're waiting to start
+	if (!m_playback_file || !m_playback_seek)
+		return;
+
+	if (!machine().scheduler().can_save())
+		fatalerror("Unable to start playback from a keyframe due to pending anonymous timers\n");
+
+	// read the keyframe header and time
+	inp_chunk_header chunk;
+	u8 time[inp_chunk_header::TIME_SIZE];
+	if (m_playback_file->seek(m_playback_seek, SEEK_SET) ||
+			!chunk.read(*m_playback_file) ||
+			(chunk.get_type() != inp_chunk_header::KEYFRAME) ||
+			(m_playback_file->read(time, sizeof(time)) != sizeof(time)))
+		fatalerror("Input file is corrupt (invalid keyframe)\n");
+
+	// decompress the save state
+	std::string state(chunk.get_count(), '\0');
+	{
+		util::read_stream::ptr stream = util::zlib_read(*m_playback_file, 16384);
+		size_t total = 0;
+		while (stream && (state.size() > total))
+		{
+			size_t read;
+			stream->read(&state[total], state.size() - total, read);
+			if (!read)
+				break;
+			total += read;
+		}
+		if (state.size() != total)
+			fatalerror("Input file is corrupt (truncated keyframe)\n");
+	}
+
+	// load it
+	std::istringstream str(state);
+	save_error const saverr = machine().save().read_stream(str);
+	if (STATERR_NONE != saverr)
+		fatalerror("Unable to load input file keyframe (error %d)\n", int(saverr));
+	osd_printf_info("Playback starting from keyframe at %s seconds\n", inp_chunk_header::get_time(time).as_string(3));
+
+	// the frames chunk that follows restores the input state
+	m_playback_next = m_playback_seek + inp_chunk_header::SIZE + chunk.get_length();
+	m_playback_seek = 0;
+	if (!playback_next_chunk())
+		fatalerror("Input file is corrupt (no input data after keyframe)\n");
+}
+
+
+//-------------------------------------------------
+//  playback_next_chunk - skip to the next frames
+//  chunk and apply the input state it starts with
+//-------------------------------------------------
+
+bool ioport_manager::playback_next_chunk()
+{
+	m_playback_stream.reset();
+	while (m_playback_file && (~u64(0) != m_playback_next))
+	{
+		inp_chunk_header chunk;
+		if (m_playback_file->seek(m_playback_next, SEEK_SET) || !chunk.read(*m_playback_file))
+			return false;
+
+		// a zero length means recording stopped while this chunk was being written
+		u64 const length = chunk.get_length();
+		m_playback_next = length ? (m_playback_next + inp_chunk_header::SIZE + length) : ~u64(0);
+
+		// keyframes are only needed when seeking, and the index comes after the last chunk
+		if (chunk.get_type() == inp_chunk_header::KEYFRAME)
+			continue;
+		if (chunk.get_type() != inp_chunk_header::FRAMES)
+			return false;
+
+		m_playback_stream = util::zlib_read(*m_playback_file, 16384);
+		m_playback_records = length ? chunk.get_count() : ~u64(0);
+
+		// the chunk starts over with a full copy of the input state
+		m_playback_last.clear();
+		m_playback_cursor = 0;
+		u64 delta_nsec;
+		seconds_t seconds_temp;
+		attoseconds_t attoseconds_temp;
+		u32 speed_temp;
+		playback_varint(delta_nsec);
+		playback_field(seconds_temp);
+		playback_field(attoseconds_temp);
+		playback_field(speed_temp);
+		for (auto &port : m_portlist)
+			playback_port(*port.second.get());
+		if (!m_playback_stream)
+			return false;
+
+		m_last_delta_nsec = attoseconds_t(delta_nsec);
+		m_last_frame_time = attotime(seconds_temp, attoseconds_temp);
+		return true;
+	}
+	return false;
+}
+
+
 //-------------------------------------------------
 //  playback_end - end INP playback
 //-------------------------------------------------
@@ -2966,11 +3387,12 @@ time_t ioport_manager::playback_init()
 void ioport_manager::playback_end(const char *message)
 {
 	// only applies if we have a live file
-	if (m_playback_stream)
+	if (m_playback_file)
 	{
 		// close the file
 		m_playback_stream.reset();
 		m_playback_file.reset();
+		m_playback_seek = 0;
 
 		// pop a message
 		if (message != nullptr)
@@ -2999,21 +3421,37 @@ void ioport_manager::playback_end(const char *message)
 
 void ioport_manager::playback_frame(const attotime &curtime)
 {
+	// nothing to do until playback has started
+	if (!m_playback_file || m_playback_seek)
+		return;
+
+	// move on to the next chunk when this one is used up
+	if (!m_playback_legacy)
+	{
+		if (!m_playback_records && !playback_next_chunk())
+		{
+			playback_end("End of file");
+			return;
+		}
+		m_playback_records--;
+		m_playback_cursor = 0;
+	}
+
 	// if playing back, fetch the information and verify
 	if (m_playback_stream)
 	{
 		// first the absolute time
 		seconds_t seconds_temp;
 		attoseconds_t attoseconds_temp;
-		playback_read(seconds_temp);
-		playback_read(attoseconds_temp);
+		playback_field(seconds_temp);
+		playback_field(attoseconds_temp);
 		attotime readtime(seconds_temp, attoseconds_temp);
 		if (readtime != curtime)
 			playback_end("Out of sync");
 
 		// then the speed
 		u32 curspeed;
-		m_playback_accumulated_speed += playback_read(curspeed);
+		m_playback_accumulated_speed += playback_field(curspeed);
 		m_playback_accumulated_frames++;
 	}
 }
@@ -3029,54 +3467,82 @@ void ioport_manager::playback_port(ioport_port &port)
 	if (m_playback_stream)
 	{
 		// read the default value and the digital state
-		playback_read(port.live().defvalue);
-		playback_read(port.live().digital);
+		playback_field(port.live().defvalue);
+		playback_field(port.live().digital);
 
 		// loop over analog ports and save their data
 		for (analog_field &analog : port.live().analoglist)
 		{
 			// read current and previous values
-			playback_read(analog.m_accum);
-			playback_read(analog.m_previous);
+			playback_field(analog.m_accum);
+			playback_field(analog.m_previous);
 
 			// read configuration information
-			playback_read(analog.m_sensitivity);
-			playback_read(analog.m_reverse);
+			playback_field(analog.m_sensitivity);
+			playback_field(analog.m_reverse);
 		}
 	}
 }
 
 
+
+//**************************************************************************
+//  INPUT RECORDING
+//**************************************************************************
+
 //-------------------------------------------------
-//  record_write - write a value to the record file
+//  record_varint - append a variable-length
+//  integer to the current update
 //-------------------------------------------------
 
-template<typename Type>
-void ioport_manager::record_write(Type value)
+void ioport_manager::record_varint(u64 value)
 {
-	// protect against nullptr handles if previous reads fail
-	if (!m_record_stream)
-		return;
+	while (0x80 <= value)
+	{
+		m_record_buffer.push_back(u8(value | 0x80));
+		value >>= 7;
+	}
+	m_record_buffer.push_back(u8(value));
+}
 
-	// normalize byte order
-	if (sizeof(value) == 8)
-		value = little_endianize_int64(value);
-	else if (sizeof(value) == 4)
-		value = little_endianize_int32(value);
-	else if (sizeof(value) == 2)
-		value = little_endianize_int16(value);
-
-	// write the value; if we fail, end recording
-	size_t written;
-	if (m_record_stream->write(&value, sizeof(value), written) || (sizeof(value) != written))
-		record_end("Out of space");
+
+//-------------------------------------------------
+//  record_field - append the next field of an
+//  input update
+//-------------------------------------------------
+
+template<typename Type>
+void ioport_manager::record_field(Type value)
+{
+	// store the zigzag-encoded difference from the same field in the previous update
+	if (m_record_cursor >= m_record_last.size())
+		m_record_last.push_back(0);
+	s64 &last = m_record_last[m_record_cursor++];
+	s64 const delta = s64(value) - last;
+	last = s64(value);
+	record_varint((u64(delta) << 1) ^ u64(delta >> 63));
 }
 
-template<>
-void ioport_manager::record_write<bool>(bool value)
+
+//-------------------------------------------------
+//  record_flush - compress the encoded update
+//-------------------------------------------------
+
+void ioport_manager::record_flush()
 {
-	u8 byte = u8(value);
-	record_write(byte);
+	if (m_record_stream && !m_record_buffer.empty())
+	{
+		// write the update; if we fail, end recording
+		size_t written;
+		if (m_record_stream->write(&m_record_buffer[0], m_record_buffer.size(), written) || (m_record_buffer.size() != written))
+		{
+			m_record_buffer.clear();
+			m_record_stream.reset();
+			record_end("Out of space");
+			return;
+		}
+	}
+	m_record_buffer.clear();
 }
 
 
@@ -3106,14 +3572,147 @@ void ioport_manager::record_init()
 	header.set_magic();
 	header.set_basetime(systime.time);
 	header.set_version();
+	header.set_polls(m_polls_per_frame, m_poll_on_read);
 	header.set_sysname(machine().system().name);
 	header.set_appdesc(util::string_format("%s %s", emulator_info::get_appname(), emulator_info::get_build_version()));
 
 	// write it
 	header.write(*m_record_file);
 
+	// keyframes are save states, so the system has to support them
+	int const keyframes = machine().options().record_keyframes();
+	if (keyframes > 0)
+	{
+		if (machine().system().flags & MACHINE_SUPPORTS_SAVE)
+		{
+			m_keyframe_interval = attotime::from_seconds(keyframes * 60);
+			m_next_keyframe = m_keyframe_interval;
+		}
+		else
+		{
+			osd_printf_warning("Input recording keyframes disabled, this system does not support save states\n");
+		}
+	}
+
+	// start the first chunk
+	record_chunk_begin();
+}
+
+
+//-------------------------------------------------
+//  record_chunk_begin - start a frames chunk with
+//  a full copy of the current input state
+//-------------------------------------------------
+
+void ioport_manager::record_chunk_begin()
+{
+	// the header is filled in when the chunk is complete; a zero length marks it as still open
+	m_record_chunk = m_record_file->tell();
+	if (!inp_chunk_header(inp_chunk_header::FRAMES).write(*m_record_file))
+	{
+		record_end("Out of space");
+		return;
+	}
+
 	// enable compression
 	m_record_stream = util::zlib_write(*m_record_file, 6, 16384);
+	m_record_count = 0;
+
+	// start over from zero so the chunk can be played without the ones before it
+	m_record_last.clear();
+	m_record_cursor = 0;
+	record_varint(u64(m_last_delta_nsec));
+	record_field(m_last_frame_time.seconds());
+	record_field(m_last_frame_time.attoseconds());
+	record_field(u32(0));
+	for (auto &port : m_portlist)
+		record_port(*port.second.get());
+}
+
+
+//-------------------------------------------------
+//  record_chunk_end - finish the open frames
+//  chunk and fill in its header
+//-------------------------------------------------
+
+void ioport_manager::record_chunk_end()
+{
+	record_flush();
+	if (!m_record_stream)
+		return;
+
+	std::error_condition const err = m_record_stream->finalize();
+	m_record_stream.reset();
+
+	u64 const end = m_record_file->tell();
+	inp_chunk_header chunk(inp_chunk_header::FRAMES);
+	chunk.set_length(end - m_record_chunk - inp_chunk_header::SIZE);
+	chunk.set_count(m_record_count);
+	if (err || m_record_file->seek(m_record_chunk, SEEK_SET) || !chunk.write(*m_record_file) || m_record_file->seek(end, SEEK_SET))
+		record_end("Out of space");
+}
+
+
+//-------------------------------------------------
+//  record_keyframe - write a save state so
+//  playback can start from this point
+//-------------------------------------------------
+
+void ioport_manager::record_keyframe()
+{
+	if (!m_record_stream)
+	{
+		m_keyframe_pending = false;
+		return;
+	}
+
+	// try again after the next timeslice if there are anonymous timers
+	if (!machine().scheduler().can_save())
+		return;
+	m_keyframe_pending = false;
+	attotime const now = machine().time();
+	m_next_keyframe = now + m_keyframe_interval;
+
+	// capture the state first so a failure leaves the recording as it was
+	std::ostringstream str;
+	save_error const saverr = machine().save().write_stream(str);
+	if (STATERR_NONE != saverr)
+	{
+		osd_printf_warning("Unable to save input recording keyframe (error %d)\n", int(saverr));
+		return;
+	}
+	std::string const state = str.str();
+
+	// close the current frames chunk
+	record_chunk_end();
+	if (!m_record_file)
+		return;
+
+	// write the keyframe: time, then the compressed state
+	u64 const offset = m_record_file->tell();
+	u8 time[inp_chunk_header::TIME_SIZE];
+	inp_chunk_header::put_time(time, now);
+	bool ok = inp_chunk_header(inp_chunk_header::KEYFRAME).write(*m_record_file) && (m_record_file->write(time, sizeof(time)) == sizeof(time));
+	if (ok)
+	{
+		util::write_stream::ptr stream = util::zlib_write(*m_record_file, 6, 16384);
+		size_t written;
+		ok = stream && !stream->write(state.data(), state.size(), written) && (state.size() == written) && !stream->finalize();
+	}
+
+	u64 const end = m_record_file->tell();
+	inp_chunk_header chunk(inp_chunk_header::KEYFRAME);
+	chunk.set_length(end - offset - inp_chunk_header::SIZE);
+	chunk.set_count(state.size());
+	if (!ok || m_record_file->seek(offset, SEEK_SET) || !chunk.write(*m_record_file) || m_record_file->seek(end, SEEK_SET))
+	{
+		record_end("Out of space");
+		return;
+	}
+	m_record_index.emplace_back(offset, now);
+
+	// carry on in a new frames chunk
+	record_chunk_begin();
 }
 
 
@@ -3124,11 +3723,34 @@ void ioport_manager::record_init()
 void ioport_manager::record_end(const char *message)
 {
 	// only applies if we have a live file
-	if (m_record_stream)
+	if (m_record_file)
 	{
+		// finish the last chunk, then write the index and the trailer pointing at it
+		record_chunk_end();
+		if (!m_record_file)
+			return;
+
+		u64 const offset = m_record_file->tell();
+		inp_chunk_header chunk(inp_chunk_header::INDEX);
+		chunk.set_length(m_record_index.size() * inp_chunk_header::INDEX_ENTRY_SIZE);
+		chunk.set_count(m_record_index.size());
+		chunk.write(*m_record_file);
+		for (auto const &keyframe : m_record_index)
+		{
+			u8 entry[inp_chunk_header::INDEX_ENTRY_SIZE];
+			inp_chunk_header::put_u64(entry, keyframe.first);
+			inp_chunk_header::put_time(entry + 8, keyframe.second);
+			m_record_file->write(entry, sizeof(entry));
+		}
+		u8 trailer[inp_chunk_header::TRAILER_SIZE];
+		inp_chunk_header::put_u64(trailer, offset);
+		std::memcpy(trailer + 8, inp_chunk_header::TRAILER_MAGIC, sizeof(inp_chunk_header::TRAILER_MAGIC));
+		m_record_file->write(trailer, sizeof(trailer));
+
 		// close the file
-		m_record_stream.reset(); // TODO: check for errors flushing the last compressed block before doing this
 		m_record_file.reset();
+		m_record_index.clear();
+		m_keyframe_pending = false;
 
 		// pop a message
 		if (message != nullptr)
@@ -3147,12 +3769,23 @@ void ioport_manager::record_frame(const attotime &curtime)
 	// if recording, record information about the current frame
 	if (m_record_stream)
 	{
+		// the previous update is complete
+		record_flush();
+		if (!m_record_stream)
+			return;
+		m_record_cursor = 0;
+		m_record_count++;
+
 		// first the absolute time
-		record_write(curtime.seconds());
-		record_write(curtime.attoseconds());
+		record_field(curtime.seconds());
+		record_field(curtime.attoseconds());
 
 		// then the current speed
-		record_write(u32(machine().video().speed_percent() * double(1 << 20)));
+		record_field(u32(machine().video().speed_percent() * double(1 << 20)));
+
+		// take a keyframe at the end of the timeslice if one is due
+		if (curtime >= m_next_keyframe)
+			m_keyframe_pending = true;
 	}
 }
 
@@ -3167,19 +3800,19 @@ void ioport_manager::record_port(ioport_port &port)
 	if (m_record_stream)
 	{
 		// store the default value and digital state
-		record_write(port.live().defvalue);
-		record_write(port.live().digital);
+		record_field(port.live().defvalue);
+		record_field(port.live().digital);
 
 		// loop over analog ports and save their data
 		for (analog_field &analog : port.live().analoglist)
 		{
 			// store current and previous values
-			record_write(analog.m_accum);
-			record_write(analog.m_previous);
+			record_field(analog.m_accum);
+			record_field(analog.m_previous);
 
 			// store configuration information
-			record_write(analog.m_sensitivity);
-			record_write(analog.m_reverse);
+			record_field(analog.m_sensitivity);
+			record_field(analog.m_reverse);
 		}
 	}
 }
@@ -25,6 +25,7 @@
 #include <ctime>
 #include <list>
 #include <memory>
+#include <utility>
 #include <vector>
 
 
@@ -1267,6 +1268,18 @@ public:
 	running_machine &machine() const noexcept { return m_machine; }
 	const ioport_list &ports() const noexcept { return m_portlist; }
 	bool safe_to_read() const noexcept { return m_safe_to_read; }
+	unsigned polls_per_frame() const noexcept { return m_polls_per_frame; }
+	bool poll_on_read() const noexcept { return m_poll_on_read; }
+
+	// poll input devices early if the emulated system is reading a port and enough time has passed
+	void read_poll() { if (m_poll_on_read) poll_if_due(); }
+
+	// input recording keyframes can only be taken between timeslices
+	void end_of_timeslice() { if (m_keyframe_pending) record_keyframe(); }
+	void playback_seek();
+
+	// call the device line write handlers after a port's digital inputs were replaced
+	void update_port_writes(ioport_port &port);
 
 	// type helpers
 	const std::vector<input_type_entry> &types() const noexcept { return m_typelist; }
@@ -1292,6 +1305,9 @@ private:
 
 	void frame_update_callback();
 	void frame_update();
+	void poll_callback(s32 param);
+	void poll_if_due();
+	void poll();
 
 	ioport_port *port(const std::string &tag) const { auto search = m_portlist.find(tag); if (search != m_portlist.end()) return search->second.get(); else return nullptr; }
 	void exit();
@@ -1310,13 +1326,22 @@ private:
 	void save_game_inputs(util::xml::data_node &parentnode);
 
 	template<typename Type> Type playback_read(Type &result);
+	template<typename Type> Type playback_field(Type &result);
+	bool playback_varint(u64 &result);
 	time_t playback_init();
+	void playback_find_keyframes(std::vector<std::pair<u64, attotime> > &keyframes);
+	bool playback_next_chunk();
 	void playback_end(const char *message = nullptr);
 	void playback_frame(const attotime &curtime);
 	void playback_port(ioport_port &port);
 
-	template<typename Type> void record_write(Type value);
+	template<typename Type> void record_field(Type value);
+	void record_varint(u64 value);
+	void record_flush();
 	void record_init();
+	void record_chunk_begin();
+	void record_chunk_end();
+	void record_keyframe();
 	void record_end(const char *message = nullptr);
 	void record_frame(const attotime &curtime);
 	void record_port(ioport_port &port);
@@ -1337,6 +1362,13 @@ private:
 	attotime                m_last_frame_time;      // time of the last frame callback
 	attoseconds_t           m_last_delta_nsec;      // nanoseconds that passed since the previous callback
 
+	// sub-frame polling
+	unsigned                m_polls_per_frame;      // number of input updates per emulated frame
+	bool                    m_poll_on_read;         // also update when the emulated system reads a port
+	bool                    m_updating;             // inside frame_update, don't recurse from port reads
+	attotime                m_poll_interval;        // emulated time between input updates
+	emu_timer *             m_poll_timer;           // timer for updates between frames
+
 	// playback/record information
 	std::unique_ptr<emu_file> m_record_file;        // recording file (nullptr if not recording)
 	std::unique_ptr<emu_file> m_playback_file;      // playback file (nullptr if not recording)
@@ -1345,6 +1377,25 @@ private:
 	u64                     m_playback_accumulated_speed; // accumulated speed during playback
 	u32                     m_playback_accumulated_frames; // accumulated frames during playback
 
+	// chunked playback state
+	bool                    m_playback_legacy;      // playing a version 3 file without chunks
+	u64                     m_playback_next;        // file offset of the chunk after the current one
+	u64                     m_playback_records;     // updates left in the current chunk
+	u64                     m_playback_seek;        // offset of the keyframe to start from, or 0
+	std::vector<s64>        m_playback_last;        // previous value of each field, for delta decoding
+	unsigned                m_playback_cursor;      // next field to decode
+
+	// chunked recording state
+	u64                     m_record_chunk;         // file offset of the open frames chunk
+	u64                     m_record_count;         // updates written to the open frames chunk
+	std::vector<u8>         m_record_buffer;        // encoded update not yet compressed
+	std::vector<s64>        m_record_last;          // previous value of each field, for delta encoding
+	unsigned                m_record_cursor;        // next field to encode
+	attotime                m_keyframe_interval;    // emulated time between keyframes, or never
+	attotime                m_next_keyframe;        // when the next keyframe is due
+	bool                    m_keyframe_pending;     // a keyframe is due at the end of this timeslice
+	std::vector<std::pair<u64, attotime> > m_record_index; // offset and time of each keyframe written
+
 	// storage for inactive configuration
 	std::unique_ptr<util::xml::file> m_deselected_card_config;
 };
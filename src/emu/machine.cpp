@@ -19,8 +19,10 @@
 #include "emuopts.h"
 #include "fileio.h"
 #include "http.h"
+#include "httpscreen.h"
 #include "image.h"
 #include "natkeyboard.h"
+#include "netplay.h"
 #include "network.h"
 #include "render.h"
 #include "romload.h"
@@ -45,6 +47,19 @@
 
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+namespace {
+
+// base time for real-time clocks when hashing output without a playback file (2000-01-01 00:00:00 UTC)
+constexpr time_t FRAMEHASH_BASE_TIME = 946684800;
+
+} // anonymous namespace
+
+
+
 //**************************************************************************
 //  RUNNING MACHINE
 //**************************************************************************
@@ -76,6 +91,8 @@ running_machine::running_machine(const machine_config &_config, machine_manager
 		m_saveload_schedule(saveload_schedule::NONE),
 		m_saveload_schedule_time(attotime::zero),
 		m_saveload_searchpath(nullptr),
+		m_runahead_frames(0),
+		m_runahead_remaining(0),
 
 		m_save(*this),
 		m_memory(*this),
@@ -148,6 +165,8 @@ void running_machine::start()
 	m_ui_input = std::make_unique<ui_input_manager>(*this);
 
 	// init the osd layer
+	startup_profiler &profile(m_manager.startup_profile());
+	profile.phase("osd init");
 	m_manager.osd().init(*this);
 
 	// create the video manager
@@ -158,11 +177,14 @@ void running_machine::start()
 	::time(&m_base_time);
 
 	// initialize the input system and input ports for the game
+	profile.phase("input");
 	// this must be done before memory_init in order to allow specifying
 	// callbacks based on input port tags
 	time_t newbase = m_ioport.initialize();
 	if (newbase != 0)
 		m_base_time = newbase;
+	else if (*options().frame_hash() || *options().frame_hash_check())
+		m_base_time = FRAMEHASH_BASE_TIME;
 
 	// initialize natural keyboard support after ports have been initialized
 	m_natkeyboard = std::make_unique<natural_keyboard>(*this);
@@ -179,15 +201,19 @@ void running_machine::start()
 	// needs rom bases), and finally initialize CPUs (which needs
 	// complete address spaces).  These operations must proceed in this
 	// order
+	profile.phase("roms");
 	m_rom_load = std::make_unique<rom_load_manager>(*this);
+	profile.phase("memory");
 	m_memory.initialize();
 
 	// save the random seed or save states might be broken in drivers that use the rand() method
 	save().save_item(NAME(m_rand_seed));
 
 	// initialize image devices
+	profile.phase("images");
 	m_image = std::make_unique<image_manager>(*this);
 	m_tilemap = std::make_unique<tilemap_manager>(*this);
+	m_bitmaps = std::make_unique<bitmap_pool>();
 	m_crosshair = std::make_unique<crosshair_manager>(*this);
 	m_network = std::make_unique<network_manager>(*this);
 
@@ -208,12 +234,26 @@ void running_machine::start()
 	add_notifier(MACHINE_NOTIFY_RESET, machine_notify_delegate(&running_machine::reset_all_devices, this));
 	add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&running_machine::stop_all_devices, this));
 	save().register_presave(save_prepost_delegate(FUNC(running_machine::presave_all_devices), this));
+	profile.phase("devices");
 	start_all_devices();
+	profile.phase("late init");
+
+	// decode graphics now rather than when they're first drawn if requested
+	if (options().predecode_gfx())
+	{
+		for (device_gfx_interface &gfx : gfx_interface_enumerator(root_device()))
+			gfx.predecode_gfx();
+	}
 	save().register_postload(save_prepost_delegate(FUNC(running_machine::postload_all_devices), this));
 
 	// save outputs created before start time
 	output().register_save();
 
+	// start tracing the scheduler if requested
+	const char *const schedtrace = options().sched_trace();
+	if (schedtrace[0] != 0)
+		m_scheduler.start_trace(schedtrace);
+
 	m_render->resolve_tags();
 
 	// load cheat files
@@ -228,6 +268,24 @@ void running_machine::start()
 	if (filename[0] != 0 && !m_video->is_recording())
 		m_video->begin_recording(filename, movie_recording::format::AVI);
 
+	// serve screen snapshots and streams if the web server is running
+	if (m_manager.http()->is_active())
+		m_http_screens = std::make_unique<http_screen_streamer>(*this);
+
+	// start publishing frames to shared memory if requested
+	const char *const exportname = options().export_name();
+	if (exportname[0] != 0 && !m_video->begin_export(exportname))
+		throw emu_fatalerror("Unable to start the shared memory export \"%s\"", exportname);
+
+	// report per-frame performance figures if requested
+	const char *const telemetryname = options().telemetry();
+	if ((telemetryname[0] != 0 || options().telemetry_outputs()) && !m_video->begin_telemetry(telemetryname, options().telemetry_outputs()))
+		throw emu_fatalerror("Unable to start writing telemetry to \"%s\"", telemetryname);
+
+	// hash each frame's output if requested
+	if ((*options().frame_hash() || *options().frame_hash_check()) && !m_video->begin_framehash(options().frame_hash(), options().frame_hash_check()))
+		throw emu_fatalerror("Unable to start frame hashing");
+
 	// if we're coming in with a savegame request, process it now
 	const char *savegame = options().state();
 	if (savegame[0] != 0)
@@ -281,6 +339,7 @@ int running_machine::run(bool quiet)
 		start();
 
 		// load the configuration settings
+		manager().startup_profile().phase("settings");
 		manager().before_load_settings(*this);
 		m_configuration->load_settings();
 
@@ -303,17 +362,61 @@ int running_machine::run(bool quiet)
 
 		// initialize ui lists
 		// display the startup screens
+		manager().startup_profile().phase("ui");
 		manager().ui_initialize(*this);
 
 		// perform a soft reset -- this takes us to the running phase
+		manager().startup_profile().phase("reset");
 		soft_reset();
+		manager().startup_profile().phase("first frame");
 
 		// handle initial load
 		if (m_saveload_schedule != saveload_schedule::NONE)
 			handle_saveload();
 
+		// start input playback from a keyframe if requested
+		m_ioport.playback_seek();
+
+		// run-ahead needs working save states and is meaningless under the debugger
+		m_runahead_frames = std::clamp(options().runahead(), 0, 8);
+		if (m_runahead_frames && ((debug_flags & DEBUG_FLAG_ENABLED) || !(m_system.flags & MACHINE_SUPPORTS_SAVE)))
+		{
+			osd_printf_warning("Run-ahead disabled, it needs save state support and can't be used with the debugger\n");
+			m_runahead_frames = 0;
+		}
+		if (m_runahead_frames && (m_video->is_exporting() || m_video->batch() || m_video->is_hashing()))
+		{
+			osd_printf_warning("Run-ahead disabled, exported, hashed and batch frames have to be the ones actually emulated\n");
+			m_runahead_frames = 0;
+		}
+		if (m_runahead_frames)
+			m_runahead_state.resize(m_save.snapshot_size());
+
+		// rollback netplay has the same needs and takes the place of run-ahead
+		if (netplay_manager::requested(options()))
+		{
+			if ((debug_flags & DEBUG_FLAG_ENABLED) || !(m_system.flags & MACHINE_SUPPORTS_SAVE))
+				throw emu_fatalerror("Netplay needs save state support and can't be used with the debugger");
+			if (m_runahead_frames)
+			{
+				osd_printf_warning("Run-ahead disabled, netplay rolls back instead\n");
+				m_runahead_frames = 0;
+			}
+			m_netplay = std::make_unique<netplay_manager>(*this);
+		}
+
 		export_http_api();
 
+		// trace profiled scopes if requested
+		if (*options().profile_trace())
+		{
+#if defined(MAME_PROFILER)
+			g_profiler.start_capture();
+#else
+			osd_printf_warning("Profiler trace requested, but this build has no profiler\n");
+#endif
+		}
+
 #if defined(__EMSCRIPTEN__)
 		// break out to our async javascript loop and halt
 		emscripten_set_running_machine(this);
@@ -331,6 +434,19 @@ int running_machine::run(bool quiet)
 			else
 				m_video->frame_update();
 
+			// step through run-ahead frames
+			if (m_runahead_frames)
+				update_runahead();
+			else if (m_netplay)
+				m_netplay->update();
+
+			// let the debugger take or restore its reverse execution snapshots
+			if (debug_flags & DEBUG_FLAG_ENABLED)
+				m_debugger->cpu().end_of_timeslice();
+
+			// let input recording take its keyframes
+			m_ioport.end_of_timeslice();
+
 			// handle save/load
 			if (m_saveload_schedule != saveload_schedule::NONE)
 				handle_saveload();
@@ -338,6 +454,9 @@ int running_machine::run(bool quiet)
 			g_profiler.stop();
 		}
 		m_manager.http()->clear();
+		m_netplay.reset();
+		if (g_profiler.capturing())
+			g_profiler.stop_capture(*this, options().profile_trace());
 
 		// and out via the exit phase
 		m_current_phase = machine_phase::EXIT;
@@ -347,6 +466,11 @@ int running_machine::run(bool quiet)
 		if (options().nvram_save())
 			nvram_save();
 		m_configuration->save_settings();
+
+		// fail the run if the output differed from the reference
+		std::string const mismatch(m_video->end_framehash());
+		if (!mismatch.empty())
+			throw emu_fatalerror(EMU_ERR_FATALERROR, "%s", mismatch);
 	}
 	catch (emu_fatalerror &fatal)
 	{
@@ -850,6 +974,69 @@ void running_machine::call_notifiers(machine_notification which)
 }
 
 
+//-------------------------------------------------
+//  update_runahead - after each real frame,
+//  capture the state, emulate the configured
+//  number of frames ahead with the same input,
+//  show the last one and restore the state
+//-------------------------------------------------
+
+void running_machine::update_runahead()
+{
+	video_manager::runahead_phase const phase = m_video->runahead();
+	bool const speculative = (phase == video_manager::runahead_phase::AHEAD) || (phase == video_manager::runahead_phase::LAST);
+
+	// anything that needs the real state has to wait until it's back
+	bool const interrupted = m_paused || m_exit_pending || m_hard_reset_pending || (m_saveload_schedule != saveload_schedule::NONE);
+	if (interrupted)
+	{
+		if (speculative && (m_save.load_snapshot(m_runahead_state.data(), m_runahead_state.size()) != STATERR_NONE))
+			throw emu_fatalerror("running_machine::update_runahead: unable to restore run-ahead state");
+		m_video->frame_completed();
+		if (phase != video_manager::runahead_phase::NONE)
+		{
+			m_video->set_runahead(video_manager::runahead_phase::NONE);
+			sound().set_output_suppressed(false);
+		}
+		return;
+	}
+
+	if (!m_video->frame_completed())
+		return;
+
+	switch (phase)
+	{
+	case video_manager::runahead_phase::NONE:
+		m_video->set_runahead(video_manager::runahead_phase::HIDDEN);
+		break;
+
+	case video_manager::runahead_phase::HIDDEN:
+		// if the state can't be captured right now, show the next real frame instead
+		if (!m_scheduler.can_save() || (m_save.save_snapshot(m_runahead_state.data(), m_runahead_state.size()) != STATERR_NONE))
+		{
+			m_video->set_runahead(video_manager::runahead_phase::NONE);
+			break;
+		}
+		m_runahead_remaining = m_runahead_frames;
+		sound().set_output_suppressed(true);
+		m_video->set_runahead((m_runahead_remaining > 1) ? video_manager::runahead_phase::AHEAD : video_manager::runahead_phase::LAST);
+		break;
+
+	case video_manager::runahead_phase::AHEAD:
+		if (--m_runahead_remaining == 1)
+			m_video->set_runahead(video_manager::runahead_phase::LAST);
+		break;
+
+	case video_manager::runahead_phase::LAST:
+		if (m_save.load_snapshot(m_runahead_state.data(), m_runahead_state.size()) != STATERR_NONE)
+			throw emu_fatalerror("running_machine::update_runahead: unable to restore run-ahead state");
+		sound().set_output_suppressed(false);
+		m_video->set_runahead(video_manager::runahead_phase::HIDDEN);
+		break;
+	}
+}
+
+
 //-------------------------------------------------
 //  handle_saveload - attempt to perform a save
 //  or load
@@ -1010,7 +1197,11 @@ void running_machine::start_all_devices()
 
 					// now start the device
 					osd_printf_verbose("Starting %s '%s'\n", device.name(), device.tag());
+					startup_profiler &profile(m_manager.startup_profile());
+					osd_ticks_t const start(profile.active() ? osd_ticks() : 0);
 					device.start();
+					if (profile.active())
+						profile.device(device, "start", osd_ticks() - start);
 				}
 				catch (device_missing_dependencies const &)
 				{
@@ -1231,6 +1422,9 @@ void running_machine::export_http_api()
 			response->set_content_type("application/json");
 			response->set_body(s.GetString());
 		});
+
+		if (m_http_screens)
+			m_http_screens->export_http_api();
 	}
 }
 
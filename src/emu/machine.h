@@ -137,9 +137,11 @@ public:
 	image_manager &image() const { assert(m_image != nullptr); return *m_image; }
 	rom_load_manager &rom_load() const { assert(m_rom_load != nullptr); return *m_rom_load; }
 	tilemap_manager &tilemap() const { assert(m_tilemap != nullptr); return *m_tilemap; }
+	bitmap_pool &bitmaps() const { assert(m_bitmaps != nullptr); return *m_bitmaps; }
 	debug_view_manager &debug_view() const { assert(m_debug_view != nullptr); return *m_debug_view; }
 	debugger_manager &debugger() const { assert(m_debugger != nullptr); return *m_debugger; }
 	natural_keyboard &natkeyboard() noexcept { assert(m_natkeyboard != nullptr); return *m_natkeyboard; }
+	netplay_manager *netplay() const { return m_netplay.get(); }
 	template <class DriverClass> DriverClass *driver_data() const { return &downcast<DriverClass &>(root_device()); }
 	machine_phase phase() const { return m_current_phase; }
 	bool paused() const { return m_paused || (m_current_phase != machine_phase::RUNNING); }
@@ -248,6 +250,7 @@ private:
 	void start();
 	void set_saveload_filename(std::string &&filename);
 	void handle_saveload();
+	void update_runahead();
 	void soft_reset(s32 param = 0);
 	std::string nvram_filename(device_t &device) const;
 	void nvram_load();
@@ -277,6 +280,7 @@ private:
 	ui_manager *m_ui;                                  // internal data from ui.cpp
 	std::unique_ptr<ui_input_manager> m_ui_input;      // internal data from uiinput.cpp
 	std::unique_ptr<tilemap_manager> m_tilemap;        // internal data from tilemap.cpp
+	std::unique_ptr<bitmap_pool> m_bitmaps;            // recycled temporary bitmaps
 	std::unique_ptr<debug_view_manager> m_debug_view;  // internal data from debugvw.cpp
 	std::unique_ptr<network_manager> m_network;        // internal data from network.cpp
 	std::unique_ptr<bookkeeping_manager> m_bookkeeping;// internal data from bookkeeping.cpp
@@ -287,6 +291,8 @@ private:
 	std::unique_ptr<rom_load_manager> m_rom_load;      // internal data from romload.cpp
 	std::unique_ptr<debugger_manager> m_debugger;      // internal data from debugger.cpp
 	std::unique_ptr<natural_keyboard> m_natkeyboard;   // internal data from natkeyboard.cpp
+	std::unique_ptr<http_screen_streamer> m_http_screens; // internal data from httpscreen.cpp
+	std::unique_ptr<netplay_manager> m_netplay;        // internal data from netplay.cpp
 
 	// system state
 	machine_phase           m_current_phase;        // current execution phase
@@ -316,6 +322,11 @@ private:
 	std::string             m_saveload_pending_file;
 	const char *            m_saveload_searchpath;
 
+	// run-ahead
+	u32                     m_runahead_frames;      // number of speculative frames per real frame (0 = off)
+	u32                     m_runahead_remaining;   // speculative frames left in the current run
+	std::vector<u8>         m_runahead_state;       // state captured after the last real frame
+
 	// notifier callbacks
 	struct notifier_callback_item
 	{
@@ -10,8 +10,12 @@
 
 #include "emu.h"
 #include "emuopts.h"
+#include "fileio.h"
 #include "http.h"
 
+#include <locale>
+#include <sstream>
+
 machine_manager::machine_manager(emu_options& options, osd_interface& osd)
   : m_osd(osd),
 	m_options(options),
@@ -33,3 +37,91 @@ http_manager *machine_manager::http()
 {
   return m_http.get();
 }
+
+
+//-------------------------------------------------
+//  startup_profiler - constructor
+//-------------------------------------------------
+
+startup_profiler::startup_profiler()
+	: m_origin(osd_ticks()),
+	m_finished(false)
+{
+	m_phases.push_back(phase_entry{ "options", m_origin });
+}
+
+
+//-------------------------------------------------
+//  phase - end the current phase and start the
+//  named one
+//-------------------------------------------------
+
+void startup_profiler::phase(const char *name)
+{
+	if (!m_finished)
+		m_phases.push_back(phase_entry{ name, osd_ticks() });
+}
+
+
+//-------------------------------------------------
+//  device - record the time spent in a device's
+//  start or reset handler
+//-------------------------------------------------
+
+void startup_profiler::device(const device_t &device, const char *action, osd_ticks_t ticks)
+{
+	if (active())
+		m_devices.push_back(device_entry{ device.tag(), device.shortname(), action, ticks });
+}
+
+
+//-------------------------------------------------
+//  finish - the first frame has been presented,
+//  write the report if one was requested
+//-------------------------------------------------
+
+void startup_profiler::finish(const char *system)
+{
+	if (m_finished)
+		return;
+	m_finished = true;
+	osd_ticks_t const end(osd_ticks());
+	if (m_filename.empty())
+		return;
+
+	double const scale(1000.0 / double(osd_ticks_per_second()));
+	std::ostringstream report;
+	report.imbue(std::locale::classic());
+	util::stream_format(report, "{\n\t\"system\": \"%s\",\n\t\"first_frame_ms\": %.3f,\n\t\"phases\": [", system, double(end - m_origin) * scale);
+	for (size_t i = 0; i < m_phases.size(); i++)
+	{
+		osd_ticks_t const next((i + 1) < m_phases.size() ? m_phases[i + 1].start : end);
+		util::stream_format(report, "%s\n\t\t{ \"name\": \"%s\", \"start_ms\": %.3f, \"duration_ms\": %.3f }",
+				i ? "," : "",
+				m_phases[i].name,
+				double(m_phases[i].start - m_origin) * scale,
+				double(next - m_phases[i].start) * scale);
+	}
+	report << "\n\t],\n\t\"devices\": [";
+	for (size_t i = 0; i < m_devices.size(); i++)
+	{
+		util::stream_format(report, "%s\n\t\t{ \"tag\": \"%s\", \"type\": \"%s\", \"action\": \"%s\", \"duration_ms\": %.3f }",
+				i ? "," : "",
+				m_devices[i].tag,
+				m_devices[i].type,
+				m_devices[i].action,
+				double(m_devices[i].ticks) * scale);
+	}
+	report << "\n\t]\n}\n";
+
+	std::string const data(report.str());
+	emu_file file(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	std::error_condition const filerr(file.open(m_filename));
+	if (filerr || (file.write(data.c_str(), data.length()) != data.length()))
+		osd_printf_error("Error writing startup profile %s\n", m_filename);
+	else
+		osd_printf_verbose("Startup profile written to %s (%.3f ms to first frame)\n", m_filename, double(end - m_origin) * scale);
+
+	m_phases.clear();
+	m_devices.clear();
+}
@@ -16,8 +16,10 @@
 #ifndef MAME_EMU_MAIN_H
 #define MAME_EMU_MAIN_H
 
-#include <thread>
 #include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
 
 //**************************************************************************
 //    CONSTANTS
@@ -64,6 +66,44 @@ public:
 };
 
 
+// ======================> startup_profiler
+
+// records where the time goes between launching and the first frame
+class startup_profiler
+{
+public:
+	startup_profiler();
+
+	// phases are recorded unconditionally as they're cheap; devices only when a report is wanted
+	bool active() const { return !m_filename.empty() && !m_finished; }
+	void set_filename(std::string_view filename) { m_filename = filename; }
+	void phase(const char *name);
+	void device(const device_t &device, const char *action, osd_ticks_t ticks);
+	void finish(const char *system);
+
+private:
+	struct phase_entry
+	{
+		const char *    name;
+		osd_ticks_t     start;
+	};
+
+	struct device_entry
+	{
+		std::string     tag;
+		const char *    type;
+		const char *    action;
+		osd_ticks_t     ticks;
+	};
+
+	osd_ticks_t                 m_origin;
+	std::vector<phase_entry>    m_phases;
+	std::vector<device_entry>   m_devices;
+	std::string                 m_filename;
+	bool                        m_finished;
+};
+
+
 class machine_manager
 {
 	DISABLE_COPYING(machine_manager);
@@ -91,11 +131,14 @@ public:
 	http_manager *http();
 	void start_http_server();
 
+	startup_profiler &startup_profile() { return m_startup_profile; }
+
 protected:
 	osd_interface &               m_osd;                  // reference to OSD system
 	emu_options &                 m_options;              // reference to options
 	running_machine *             m_machine;
 	std::unique_ptr<http_manager> m_http;
+	startup_profiler              m_startup_profile;
 };
 
 #endif // MAME_EMU_MAIN_H
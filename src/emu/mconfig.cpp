@@ -46,6 +46,7 @@ machine_config::machine_config(const game_driver &gamedrv, emu_options &options)
 	, m_current_device(nullptr)
 	, m_maximum_quantums([] (char const *a, char const *b) { return 0 > std::strcmp(a, b); })
 	, m_perfect_quantum_device(nullptr, "")
+	, m_adaptive_quantum(attotime::zero)
 {
 	// add the root device
 	device_add("root", gamedrv.type, 0);
@@ -190,6 +191,18 @@ void machine_config::set_maximum_quantum(attotime const &quantum)
 }
 
 
+//-------------------------------------------------
+//  set_adaptive_quantum - enable adaptive
+//  scheduling with the given minimum quantum
+//-------------------------------------------------
+
+void machine_config::set_adaptive_quantum(attotime const &minimum)
+{
+	assert(minimum.seconds() == 0);
+	m_adaptive_quantum = minimum;
+}
+
+
 //-------------------------------------------------
 //  device_add - configuration helper to add a
 //  new device
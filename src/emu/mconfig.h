@@ -113,6 +113,7 @@ public:
 	template <class DeviceClass> DeviceClass *device(const char *tag) const { return downcast<DeviceClass *>(device(tag)); }
 	attotime maximum_quantum(attotime const &default_quantum) const;
 	device_execute_interface *perfect_quantum_device() const;
+	attotime const &adaptive_quantum() const { return m_adaptive_quantum; }
 
 	/// \brief Apply visitor to internal layouts
 	///
@@ -156,6 +157,16 @@ public:
 	/// \param [in] quantum Maximum scheduling quantum in attoseconds.
 	void set_maximum_quantum(attotime const &quantum);
 
+	/// \brief Enable adaptive scheduling quantum
+	///
+	/// Allow the scheduler to shrink the quantum down to the specified
+	/// minimum whenever devices synchronise with each other, widening
+	/// it again while they run independently.  This is an alternative
+	/// to a permanent perfect quantum for systems where devices only
+	/// interact in bursts.
+	/// \param [in] minimum Smallest quantum used after an interaction.
+	void set_adaptive_quantum(attotime const &minimum);
+
 	template <typename T>
 	void set_perfect_quantum(T &&tag)
 	{
@@ -247,6 +258,7 @@ private:
 	device_t *                          m_current_device;
 	maximum_quantum_map                 m_maximum_quantums;
 	std::pair<device_t *, std::string>  m_perfect_quantum_device;
+	attotime                            m_adaptive_quantum;
 };
 
 #endif // MAME_EMU_MCONFIG_H
@@ -0,0 +1,606 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    netplay.cpp
+
+    Two-player rollback netplay over UDP.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "netplay.h"
+
+#include "emuopts.h"
+
+#include "asio.h"
+
+#include <algorithm>
+
+
+//**************************************************************************
+//  PACKET HELPERS
+//**************************************************************************
+
+namespace {
+
+constexpr u8 PACKET_MAGIC[4] = { 'M', 'N', 'P', '1' };
+constexpr size_t PACKET_HEADER = sizeof(PACKET_MAGIC) + 1;
+
+void put_u32(std::vector<u8> &packet, u32 value)
+{
+	packet.push_back(u8(value));
+	packet.push_back(u8(value >> 8));
+	packet.push_back(u8(value >> 16));
+	packet.push_back(u8(value >> 24));
+}
+
+u32 get_u32(u8 const *data)
+{
+	return u32(data[0]) | (u32(data[1]) << 8) | (u32(data[2]) << 16) | (u32(data[3]) << 24);
+}
+
+std::vector<u8> begin_packet(u8 type)
+{
+	std::vector<u8> packet(std::begin(PACKET_MAGIC), std::end(PACKET_MAGIC));
+	packet.push_back(type);
+	return packet;
+}
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  SOCKET
+//**************************************************************************
+
+struct netplay_manager::socket
+{
+	socket(u16 port, std::string const &peer)
+		: udp(context)
+	{
+		udp.open(asio::ip::udp::v4());
+		udp.bind(asio::ip::udp::endpoint(asio::ip::udp::v4(), port));
+		udp.non_blocking(true);
+
+		// without a peer address, answer whoever contacts us first
+		if (!peer.empty())
+		{
+			std::string::size_type const colon(peer.rfind(':'));
+			if ((std::string::npos == colon) || !colon || ((peer.length() - 1) == colon))
+				throw emu_fatalerror("Netplay peer \"%s\" should be host:port", peer);
+			asio::ip::udp::resolver resolver(context);
+			remote = *resolver.resolve(asio::ip::udp::v4(), peer.substr(0, colon), peer.substr(colon + 1)).begin();
+			connected = true;
+		}
+	}
+
+	void send(std::vector<u8> const &packet)
+	{
+		if (connected)
+		{
+			std::error_code err;
+			udp.send_to(asio::buffer(packet), remote, 0, err);
+		}
+	}
+
+	asio::io_context            context;
+	asio::ip::udp::socket       udp;
+	asio::ip::udp::endpoint     remote;
+	bool                        connected = false;
+};
+
+
+
+//**************************************************************************
+//  NETPLAY MANAGER
+//**************************************************************************
+
+//-------------------------------------------------
+//  requested - true if the options enable
+//  netplay or its benchmark
+//-------------------------------------------------
+
+bool netplay_manager::requested(emu_options const &options)
+{
+	return options.netplay_port() || options.netplay_benchmark();
+}
+
+
+//-------------------------------------------------
+//  netplay_manager - constructor
+//-------------------------------------------------
+
+netplay_manager::netplay_manager(running_machine &machine)
+	: m_machine(machine)
+	, m_player(std::clamp(machine.options().netplay_player(), 0, 1))
+	, m_delay(std::clamp(machine.options().netplay_delay(), 0, 8))
+	, m_window(std::clamp(machine.options().netplay_rollback(), 1, 15))
+	, m_benchmark(std::clamp(machine.options().netplay_benchmark(), 0, 15))
+	, m_frame(0)
+	, m_latched(0)
+	, m_remote_confirmed(0)
+	, m_peer_ack(0)
+	, m_rollback_to(~u32(0))
+	, m_resim_frame(0)
+	, m_resimulating(false)
+	, m_stalled(false)
+	, m_diverged(false)
+	, m_rollback_start(0)
+	, m_rollbacks(0)
+	, m_rollback_frames(0)
+	, m_rollback_ticks(0)
+	, m_rollback_worst(0)
+{
+	if (m_benchmark)
+		m_window = m_benchmark;
+
+	// fields of player 2 are supplied by player 1 of the netplay session, all others by player 0
+	for (auto &port : machine.ioport().ports())
+	{
+		ioport_value mask = 0;
+		for (ioport_field const &field : port.second->fields())
+			if (field.player() == 1)
+				mask |= field.mask();
+		m_ports.emplace_back(port.second.get());
+		m_guest_mask.emplace_back(mask);
+	}
+	m_last_remote.resize(m_ports.size(), 0);
+
+	// inputs are kept from the oldest frame the peer may still need to the newest delayed one
+	m_frames.resize(2 * (m_window + m_delay) + 4);
+	m_states.resize(m_window + 1);
+	for (state_slot &state : m_states)
+		state.data.resize(machine.save().snapshot_size());
+
+	if (!m_benchmark)
+	{
+		u16 const port(u16(std::clamp(machine.options().netplay_port(), 1, 65535)));
+		try
+		{
+			m_socket = std::make_unique<socket>(port, machine.options().netplay_peer());
+		}
+		catch (std::system_error const &err)
+		{
+			throw emu_fatalerror("Unable to start netplay on UDP port %u: %s", port, err.what());
+		}
+		osd_printf_info("Netplay: player %u on UDP port %u, %u frame(s) of input delay, rolling back up to %u frame(s)\n", m_player, port, m_delay, m_window);
+	}
+}
+
+
+//-------------------------------------------------
+//  ~netplay_manager - destructor
+//-------------------------------------------------
+
+netplay_manager::~netplay_manager()
+{
+	if (m_rollbacks)
+	{
+		double const ms = 1000.0 / double(osd_ticks_per_second());
+		osd_printf_info(
+				"Rollback: %u rollbacks, %.2f frames average, %.3f ms average, %.3f ms worst, %.3f ms per frame\n",
+				m_rollbacks,
+				double(m_rollback_frames) / double(m_rollbacks),
+				double(m_rollback_ticks) * ms / double(m_rollbacks),
+				double(m_rollback_worst) * ms,
+				m_rollback_frames ? (double(m_rollback_ticks) * ms / double(m_rollback_frames)) : 0.0);
+	}
+}
+
+
+//-------------------------------------------------
+//  frame_input - called by the input manager
+//  when it latches the inputs for the next frame
+//-------------------------------------------------
+
+void netplay_manager::frame_input()
+{
+	// re-emulated frames take their inputs from the history instead
+	if (m_resimulating)
+		return;
+
+	// read our own input for use a few frames from now
+	u32 const frame = m_frame + 1;
+	frame_slot &future(slot(frame + m_delay));
+	for (size_t i = 0; m_ports.size() > i; ++i)
+		future.local[i] = m_ports[i]->live().digital & (m_player ? m_guest_mask[i] : ~m_guest_mask[i]);
+
+	// the input manager calls the write handlers once we're done
+	apply(frame, false);
+	m_latched = frame;
+}
+
+
+//-------------------------------------------------
+//  update - exchange inputs, save snapshots and
+//  step through rollbacks between timeslices
+//-------------------------------------------------
+
+void netplay_manager::update()
+{
+	bool const completed(m_machine.video().frame_completed());
+	if (m_socket)
+		receive();
+
+	// waiting for the peer to catch up
+	if (m_machine.paused())
+	{
+		if (m_stalled && !must_stall())
+		{
+			m_stalled = false;
+			m_machine.popmessage();
+			m_machine.resume();
+		}
+		else if (completed && m_socket)
+		{
+			send_inputs();
+		}
+		return;
+	}
+	m_stalled = false;
+
+	if (!completed)
+		return;
+
+	if (m_resimulating)
+	{
+		// latch the next frame's inputs as though the input manager had done it
+		apply(++m_resim_frame, true);
+		save_state(m_resim_frame);
+		if (m_resim_frame == m_frame)
+		{
+			end_rollback();
+			finish_frame();
+		}
+		return;
+	}
+
+	// ignore frames completed before we were told about their inputs
+	if (m_latched != (m_frame + 1))
+		return;
+	m_frame = m_latched;
+	save_state(m_frame);
+
+	// the benchmark rolls back over frames that were already right
+	if (m_benchmark && (m_frame > m_benchmark))
+		m_rollback_to = m_frame - m_benchmark;
+
+	finish_frame();
+}
+
+
+//-------------------------------------------------
+//  slot - get the inputs for a frame, clearing
+//  them if the slot last held an older frame
+//-------------------------------------------------
+
+netplay_manager::frame_slot &netplay_manager::slot(u32 frame)
+{
+	frame_slot &result(m_frames[frame % m_frames.size()]);
+	if (result.frame != frame)
+	{
+		result.frame = frame;
+		result.local.assign(m_ports.size(), 0);
+		result.remote.assign(m_ports.size(), 0);
+		result.confirmed = m_benchmark;
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  apply - set the digital inputs for a frame
+//  from our own and the peer's inputs
+//-------------------------------------------------
+
+void netplay_manager::apply(u32 frame, bool write)
+{
+	frame_slot &inputs(slot(frame));
+	if (!inputs.confirmed)
+		inputs.remote = m_last_remote;
+
+	std::vector<ioport_value> const &host(m_player ? inputs.remote : inputs.local);
+	std::vector<ioport_value> const &guest(m_player ? inputs.local : inputs.remote);
+	for (size_t i = 0; m_ports.size() > i; ++i)
+	{
+		m_ports[i]->live().digital = (host[i] & ~m_guest_mask[i]) | (guest[i] & m_guest_mask[i]);
+		if (write)
+			m_machine.ioport().update_port_writes(*m_ports[i]);
+	}
+}
+
+
+//-------------------------------------------------
+//  save_state - take the snapshot that a
+//  rollback to this frame starts from
+//-------------------------------------------------
+
+void netplay_manager::save_state(u32 frame)
+{
+	state_slot &state(m_states[frame % m_states.size()]);
+	state.frame = frame;
+	state.valid = m_machine.scheduler().can_save() && (m_machine.save().save_snapshot(state.data.data(), state.data.size()) == STATERR_NONE);
+
+	// hash at fixed frames so both sides compare the same point
+	if (m_socket && !(frame % HASH_INTERVAL))
+	{
+		m_local_hashes[frame] = m_machine.save().state_hash();
+		while (!m_local_hashes.empty() && ((m_local_hashes.begin()->first + HASH_HISTORY) < frame))
+			m_local_hashes.erase(m_local_hashes.begin());
+	}
+}
+
+
+//-------------------------------------------------
+//  finish_frame - roll back if a prediction was
+//  wrong, otherwise talk to the peer and wait
+//  for it if we're too far ahead
+//-------------------------------------------------
+
+void netplay_manager::finish_frame()
+{
+	if (m_rollback_to <= m_frame)
+	{
+		begin_rollback(std::exchange(m_rollback_to, ~u32(0)));
+		if (m_resimulating)
+			return;
+	}
+
+	if (m_socket)
+	{
+		send_inputs();
+		send_hash();
+
+		if (must_stall())
+		{
+			m_stalled = true;
+			m_machine.popmessage("Waiting for netplay peer...");
+			m_machine.pause();
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  must_stall - true if running another frame
+//  would predict further than we can roll back
+//-------------------------------------------------
+
+bool netplay_manager::must_stall() const
+{
+	return m_socket && ((m_frame - m_remote_confirmed) >= m_window);
+}
+
+
+//-------------------------------------------------
+//  begin_rollback - restore the snapshot for a
+//  frame and start re-emulating from there
+//-------------------------------------------------
+
+void netplay_manager::begin_rollback(u32 frame)
+{
+	state_slot const &state(m_states[frame % m_states.size()]);
+	if ((state.frame != frame) || !state.valid)
+	{
+		osd_printf_error("Netplay: no snapshot to roll back to frame %u, the machines may diverge\n", frame);
+		return;
+	}
+
+	m_rollback_start = osd_ticks();
+	if (m_machine.save().load_snapshot(state.data.data(), state.data.size()) != STATERR_NONE)
+		throw emu_fatalerror("netplay_manager::begin_rollback: unable to restore frame %u", frame);
+
+	// ports aren't part of the state, so latch the corrected inputs again
+	apply(frame, true);
+	m_rollback_frames += m_frame - frame;
+	if (frame == m_frame)
+	{
+		end_rollback();
+		return;
+	}
+
+	m_resim_frame = frame;
+	m_resimulating = true;
+	m_machine.sound().set_output_suppressed(true);
+	m_machine.video().set_runahead(video_manager::runahead_phase::AHEAD);
+}
+
+
+//-------------------------------------------------
+//  end_rollback - back at the newest frame, so
+//  sound and video are wanted again
+//-------------------------------------------------
+
+void netplay_manager::end_rollback()
+{
+	if (m_resimulating)
+	{
+		m_resimulating = false;
+		m_machine.sound().set_output_suppressed(false);
+		m_machine.video().set_runahead(video_manager::runahead_phase::NONE);
+	}
+
+	osd_ticks_t const elapsed(osd_ticks() - m_rollback_start);
+	m_rollback_ticks += elapsed;
+	m_rollback_worst = std::max(m_rollback_worst, elapsed);
+	++m_rollbacks;
+}
+
+
+//-------------------------------------------------
+//  receive - handle everything that has arrived
+//-------------------------------------------------
+
+void netplay_manager::receive()
+{
+	u8 buffer[65536];
+	while (true)
+	{
+		asio::ip::udp::endpoint sender;
+		std::error_code err;
+		size_t const length(m_socket->udp.receive_from(asio::buffer(buffer), sender, 0, err));
+		if (err)
+			break;
+
+		// the first peer to contact us is the one we play with
+		if (!m_socket->connected)
+		{
+			m_socket->remote = sender;
+			m_socket->connected = true;
+			osd_printf_info("Netplay: peer connected from %s:%u\n", sender.address().to_string(), sender.port());
+		}
+		if ((sender != m_socket->remote) || (PACKET_HEADER > length) || !std::equal(std::begin(PACKET_MAGIC), std::end(PACKET_MAGIC), buffer))
+			continue;
+
+		switch (buffer[sizeof(PACKET_MAGIC)])
+		{
+		case PACKET_INPUT:
+			receive_inputs(buffer + PACKET_HEADER, length - PACKET_HEADER);
+			break;
+		case PACKET_HASH:
+			receive_hash(buffer + PACKET_HEADER, length - PACKET_HEADER);
+			break;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  receive_inputs - take the peer's inputs for
+//  a range of frames and note mispredictions
+//-------------------------------------------------
+
+void netplay_manager::receive_inputs(u8 const *data, size_t length)
+{
+	if (13 > length)
+		return;
+	u32 const ack(get_u32(data));
+	u32 const first(get_u32(data + 4));
+	u32 const count(data[8]);
+	u32 const ports(get_u32(data + 9));
+	if (ports != m_ports.size())
+	{
+		osd_printf_error("Netplay: peer has %u input ports, we have %u; is it running the same system?\n", ports, m_ports.size());
+		return;
+	}
+	if ((13 + (count * ports * 4)) > length)
+		return;
+	m_peer_ack = std::max(m_peer_ack, ack);
+
+	// inputs applied to a frame already emulated are compared against the prediction
+	u32 const emulated(m_resimulating ? m_resim_frame : m_latched);
+	for (u32 i = 0; count > i; ++i)
+	{
+		u32 const frame(first + i);
+		if (frame != (m_remote_confirmed + 1))
+			continue;
+		if (frame > (m_frame + (m_frames.size() / 2)))
+			break;
+
+		frame_slot &inputs(slot(frame));
+		u8 const *values(data + 13 + (i * ports * 4));
+		bool mispredicted(false);
+		for (u32 j = 0; ports > j; ++j)
+		{
+			ioport_value const value(get_u32(values + (j * 4)) & (m_player ? ~m_guest_mask[j] : m_guest_mask[j]));
+			mispredicted = mispredicted || (inputs.remote[j] != value);
+			inputs.remote[j] = value;
+		}
+		if (mispredicted && (frame <= emulated))
+			m_rollback_to = std::min(m_rollback_to, frame);
+		inputs.confirmed = true;
+		m_last_remote = inputs.remote;
+		m_remote_confirmed = frame;
+	}
+}
+
+
+//-------------------------------------------------
+//  receive_hash - take the peer's state hash for
+//  a frame it has confirmed
+//-------------------------------------------------
+
+void netplay_manager::receive_hash(u8 const *data, size_t length)
+{
+	if (8 > length)
+		return;
+	u32 const frame(get_u32(data));
+	if (m_peer_hashes.emplace(frame, get_u32(data + 4)).second)
+	{
+		while ((m_peer_hashes.begin()->first + HASH_HISTORY) < m_frame)
+			m_peer_hashes.erase(m_peer_hashes.begin());
+		compare_hash(frame);
+	}
+}
+
+
+//-------------------------------------------------
+//  send_inputs - send every input the peer hasn't
+//  acknowledged yet, so lost packets don't matter
+//-------------------------------------------------
+
+void netplay_manager::send_inputs()
+{
+	u32 const last(m_frame + m_delay);
+	u32 const size(m_frames.size());
+	u32 const first(std::max<u32>(m_peer_ack + 1, (last > size) ? (last - size + 1) : 1));
+	if (first > last)
+		return;
+	u32 const count(std::min(last - first + 1, MAX_INPUTS_PER_PACKET));
+
+	std::vector<u8> packet(begin_packet(PACKET_INPUT));
+	put_u32(packet, m_remote_confirmed);
+	put_u32(packet, first);
+	packet.push_back(u8(count));
+	put_u32(packet, m_ports.size());
+	for (u32 frame = first; (first + count) > frame; ++frame)
+	{
+		for (ioport_value value : slot(frame).local)
+			put_u32(packet, value);
+	}
+	m_socket->send(packet);
+}
+
+
+//-------------------------------------------------
+//  send_hash - send the newest hash of a frame
+//  whose inputs are confirmed on both sides
+//-------------------------------------------------
+
+void netplay_manager::send_hash()
+{
+	auto const found(m_local_hashes.upper_bound(m_remote_confirmed));
+	if (m_local_hashes.begin() == found)
+		return;
+
+	auto const &latest(*std::prev(found));
+	std::vector<u8> packet(begin_packet(PACKET_HASH));
+	put_u32(packet, latest.first);
+	put_u32(packet, latest.second);
+	m_socket->send(packet);
+	compare_hash(latest.first);
+}
+
+
+//-------------------------------------------------
+//  compare_hash - report the first frame where
+//  the machines no longer agree
+//-------------------------------------------------
+
+void netplay_manager::compare_hash(u32 frame)
+{
+	// our hash is only final once no rollback can change the frame
+	if (m_diverged || (frame > m_remote_confirmed) || (m_rollback_to <= frame) || (m_resimulating && (m_resim_frame < frame)))
+		return;
+
+	auto const local(m_local_hashes.find(frame));
+	auto const peer(m_peer_hashes.find(frame));
+	if ((m_local_hashes.end() != local) && (m_peer_hashes.end() != peer) && (local->second != peer->second))
+	{
+		m_diverged = true;
+		osd_printf_error("Netplay: machines diverged by frame %u (state hash %08x here, %08x on the peer)\n", frame, local->second, peer->second);
+		m_machine.popmessage("Netplay desync detected at frame %u", frame);
+	}
+}
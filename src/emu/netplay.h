@@ -0,0 +1,139 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    netplay.h
+
+    Two-player rollback netplay over UDP.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef MAME_EMU_NETPLAY_H
+#define MAME_EMU_NETPLAY_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> netplay_manager
+
+// Each instance supplies the digital inputs of one side: player 0 owns
+// every field except those of player 2, which belong to player 1.  Inputs
+// are exchanged for every frame, the peer's inputs are predicted until
+// they arrive, and a late input that differs from the prediction rolls the
+// machine back to a snapshot and re-emulates the frames since then with
+// sound and video suppressed.
+class netplay_manager
+{
+public:
+	// construction/destruction
+	netplay_manager(running_machine &machine);
+	~netplay_manager();
+
+	// true if the options ask for netplay or its benchmark
+	static bool requested(emu_options const &options);
+
+	// getters
+	running_machine &machine() const { return m_machine; }
+	bool resimulating() const { return m_resimulating; }
+
+	// replace the live digital inputs with the ones agreed for the next frame
+	void frame_input();
+
+	// exchange inputs and step through rollbacks between timeslices
+	void update();
+
+private:
+	struct socket;
+
+	// packet types
+	enum : u8
+	{
+		PACKET_INPUT = 1,   // ack, first frame, count, ports, inputs
+		PACKET_HASH = 2     // frame, state hash
+	};
+
+	static constexpr u32 HASH_INTERVAL = 60;        // frames between state hashes
+	static constexpr u32 HASH_HISTORY = 600;        // frames of hashes kept for comparison
+	static constexpr u32 MAX_INPUTS_PER_PACKET = 32;
+
+	// inputs for one frame
+	struct frame_slot
+	{
+		u32                         frame = ~u32(0);
+		std::vector<ioport_value>   local;          // our inputs
+		std::vector<ioport_value>   remote;         // peer's inputs, predicted until confirmed
+		bool                        confirmed = false;
+	};
+
+	// machine state with the inputs for a frame latched
+	struct state_slot
+	{
+		u32                         frame = ~u32(0);
+		bool                        valid = false;
+		std::vector<u8>             data;
+	};
+
+	// frame bookkeeping
+	frame_slot &slot(u32 frame);
+	void apply(u32 frame, bool write);
+	void save_state(u32 frame);
+	void finish_frame();
+	bool must_stall() const;
+
+	// rollback
+	void begin_rollback(u32 frame);
+	void end_rollback();
+
+	// network
+	void receive();
+	void receive_inputs(u8 const *data, size_t length);
+	void receive_hash(u8 const *data, size_t length);
+	void send_inputs();
+	void send_hash();
+	void compare_hash(u32 frame);
+
+	// internal state
+	running_machine &           m_machine;
+	std::unique_ptr<socket>     m_socket;               // nullptr when benchmarking
+	u32                         m_player;               // which side we supply
+	u32                         m_delay;                // frames between reading and using local input
+	u32                         m_window;               // maximum number of frames to roll back
+	u32                         m_benchmark;            // forced rollback depth (0 = play over the network)
+
+	std::vector<ioport_port *>  m_ports;                // ports in a fixed order shared with the peer
+	std::vector<ioport_value>   m_guest_mask;           // bits of each port that belong to player 1
+	std::vector<frame_slot>     m_frames;               // ring of inputs
+	std::vector<state_slot>     m_states;               // ring of snapshots
+	std::vector<ioport_value>   m_last_remote;          // latest confirmed peer input, used for prediction
+
+	u32                         m_frame;                // last frame whose inputs were latched and saved
+	u32                         m_latched;              // last frame whose inputs were latched
+	u32                         m_remote_confirmed;     // last frame of contiguous peer input received
+	u32                         m_peer_ack;             // last frame of our input the peer has
+	u32                         m_rollback_to;          // earliest mispredicted frame (~0 = none)
+	u32                         m_resim_frame;          // frame being re-emulated
+	bool                        m_resimulating;         // re-emulating frames after a rollback
+	bool                        m_stalled;              // paused waiting for the peer
+	bool                        m_diverged;             // divergence already reported
+
+	std::map<u32, u32>          m_local_hashes;         // our state hashes by frame
+	std::map<u32, u32>          m_peer_hashes;          // peer's state hashes by frame
+
+	// rollback statistics
+	osd_ticks_t                 m_rollback_start;
+	u64                         m_rollbacks;
+	u64                         m_rollback_frames;
+	osd_ticks_t                 m_rollback_ticks;
+	osd_ticks_t                 m_rollback_worst;
+};
+
+#endif // MAME_EMU_NETPLAY_H
@@ -31,12 +31,16 @@ output_manager::output_item::output_item(
 	, m_name(std::move(name))
 	, m_id(id)
 	, m_value(value)
+	, m_delivered(value)
+	, m_pending(false)
+	, m_force(false)
 	, m_notifylist()
+	, m_deferred_notifylist()
 {
 }
 
 
-void output_manager::output_item::notify(s32 value)
+void output_manager::output_item::notify(s32 value, bool force)
 {
 	if (OUTPUT_VERBOSE)
 		m_manager.machine().logerror("Output %s = %d (was %d)\n", m_name, value, m_value);
@@ -49,6 +53,31 @@ void output_manager::output_item::notify(s32 value)
 	// call the global notifiers next
 	for (auto const &notify : m_manager.m_global_notifylist)
 		notify(m_name.c_str(), value);
+
+	// queue once for the deferred notifiers
+	m_force = m_force || force;
+	if (!m_pending)
+	{
+		m_pending = true;
+		m_manager.m_changed.emplace_back(this);
+	}
+}
+
+
+void output_manager::output_item::deliver()
+{
+	// changes that cancelled out since the last delivery are dropped
+	m_pending = false;
+	if ((m_value == m_delivered) && !m_force)
+		return;
+	m_delivered = m_value;
+	m_force = false;
+
+	for (auto const &notify : m_deferred_notifylist)
+		notify(m_name.c_str(), m_delivered);
+
+	for (auto const &notify : m_manager.m_deferred_global_notifylist)
+		notify(m_name.c_str(), m_delivered);
 }
 
 
@@ -197,7 +226,7 @@ void output_manager::set_value(std::string_view outname, s32 value)
 
 	// if no item of that name, create a new one and force notification
 	if (!item)
-		create_new_item(outname, value).notify(value);
+		create_new_item(outname, value).notify(value, true);
 	else
 		item->set(value); // set the new value (notifies on change)
 }
@@ -217,16 +246,27 @@ s32 output_manager::get_value(std::string_view outname)
 }
 
 
+//-------------------------------------------------
+//  get_handle - find or create an output and
+//  return a handle for setting it directly
+//-------------------------------------------------
+
+output_manager::handle output_manager::get_handle(std::string_view outname)
+{
+	return handle(find_or_create_item(outname, 0));
+}
+
+
 //-------------------------------------------------
 //  set_notifier - sets a notifier callback for a
 //  particular output
 //-------------------------------------------------
 
-void output_manager::set_notifier(std::string_view outname, notifier_func callback, void *param)
+void output_manager::set_notifier(std::string_view outname, notifier_func callback, void *param, bool immediate)
 {
 	// if an item is specified, find/create it
 	output_item *const item = find_item(outname);
-	(item ? *item : create_new_item(outname, 0)).set_notifier(callback, param);
+	(item ? *item : create_new_item(outname, 0)).set_notifier(callback, param, immediate);
 }
 
 
@@ -235,9 +275,25 @@ void output_manager::set_notifier(std::string_view outname, notifier_func callba
 //  for all outputs
 //-------------------------------------------------
 
-void output_manager::set_global_notifier(notifier_func callback, void *param)
+void output_manager::set_global_notifier(notifier_func callback, void *param, bool immediate)
+{
+	(immediate ? m_global_notifylist : m_deferred_global_notifylist).emplace_back(callback, param);
+}
+
+
+//-------------------------------------------------
+//  update - deliver the latest value of every
+//  output that changed since the last call to
+//  the deferred notifiers
+//-------------------------------------------------
+
+void output_manager::update()
 {
-	m_global_notifylist.emplace_back(callback, param);
+	// notifiers may set outputs; those changes wait for the next update
+	m_delivering.swap(m_changed);
+	for (output_item *item : m_delivering)
+		item->deliver();
+	m_delivering.clear();
 }
 
 
@@ -68,17 +68,25 @@ private:
 		std::string const &name() const { return m_name; }
 		u32 id() const { return m_id; }
 		s32 get() const { return m_value; }
-		void set(s32 value) { if (m_value != value) { notify(value); } }
-		void notify(s32 value);
+		void set(s32 value) { if (m_value != value) { notify(value, false); } }
+		void notify(s32 value, bool force);
+		void deliver();
 
-		void set_notifier(notifier_func callback, void *param) { m_notifylist.emplace_back(callback, param); }
+		void set_notifier(notifier_func callback, void *param, bool immediate)
+		{
+			(immediate ? m_notifylist : m_deferred_notifylist).emplace_back(callback, param);
+		}
 
 	private:
 		output_manager      &m_manager;     // parent output manager
 		std::string const   m_name;         // string name of the item
 		u32 const           m_id;           // unique ID for this item
 		s32                 m_value;        // current value
-		notify_vector       m_notifylist;   // list of notifier callbacks
+		s32                 m_delivered;    // value last passed to deferred notifiers
+		bool                m_pending;      // queued for deferred delivery
+		bool                m_force;        // deliver even if the value is unchanged
+		notify_vector       m_notifylist;   // notifiers called on every change
+		notify_vector       m_deferred_notifylist; // notifiers called once per frame
 	};
 
 	class item_proxy
@@ -96,6 +104,23 @@ private:
 	template <unsigned... N> using item_proxy_array_t = typename item_proxy_array<N...>::type;
 
 public:
+	// reference to an output that can be set without a name lookup
+	class handle
+	{
+	public:
+		handle() = default;
+
+		explicit operator bool() const { return m_item != nullptr; }
+		s32 get() const { return m_item->get(); }
+		void set(s32 value) const { m_item->set(value); }
+
+	private:
+		friend class output_manager;
+		handle(output_item &item) : m_item(&item) { }
+
+		output_item *m_item = nullptr;
+	};
+
 	template <typename X, unsigned... N> class output_finder
 	{
 	public:
@@ -175,11 +200,18 @@ public:
 	// return the current value for a given output
 	s32 get_value(std::string_view outname);
 
-	// set a notifier on a particular output
-	void set_notifier(std::string_view outname, notifier_func callback, void *param);
+	// find or create an output for repeated access
+	handle get_handle(std::string_view outname);
+
+	// set a notifier on a particular output; unless immediate is set,
+	// changes are coalesced and delivered once per frame by update()
+	void set_notifier(std::string_view outname, notifier_func callback, void *param, bool immediate = false);
 
 	// set a notifier globally
-	void set_global_notifier(notifier_func callback, void *param);
+	void set_global_notifier(notifier_func callback, void *param, bool immediate = false);
+
+	// deliver changes collected since the last update to deferred notifiers
+	void update();
 
 	// immdediately call a notifier for all outputs
 	template <typename T> void notify_all(T &&notifier) const
@@ -209,6 +241,9 @@ private:
 	running_machine &m_machine;                  // reference to our machine
 	std::unordered_map<std::string, output_item> m_itemtable;
 	notify_vector m_global_notifylist;
+	notify_vector m_deferred_global_notifylist;
+	std::vector<output_item *> m_changed;        // items waiting for deferred delivery
+	std::vector<output_item *> m_delivering;     // items being delivered by update()
 	std::vector<std::reference_wrapper<output_item> > m_save_order;
 	std::unique_ptr<s32 []> m_save_data;
 	u32 m_uniqueid;
@@ -24,6 +24,12 @@
 #include "emu.h"
 #include "profiler.h"
 
+#include "fileio.h"
+#include "screen.h"
+
+#include <algorithm>
+#include <iterator>
+
 
 
 //**************************************************************************
@@ -42,7 +48,8 @@ struct profile_string
 //  GLOBAL VARIABLES
 //**************************************************************************
 
-profiler_state g_profiler;
+// each emulation thread keeps its own profile
+thread_local profiler_state g_profiler;
 
 
 
@@ -52,18 +59,76 @@ profiler_state g_profiler;
 
 #define TEXT_UPDATE_TIME        0.5
 
+static const profile_string s_names[] =
+{
+	{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
+	{ PROFILER_MEM_REMAP,        "Memory Remapping" },
+	{ PROFILER_MEMREAD,          "Memory Read" },
+	{ PROFILER_MEMWRITE,         "Memory Write" },
+	{ PROFILER_VIDEO,            "Video Update" },
+	{ PROFILER_DRAWGFX,          "drawgfx" },
+	{ PROFILER_COPYBITMAP,       "copybitmap" },
+	{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
+	{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
+	{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
+	{ PROFILER_BLIT,             "OSD Blitting" },
+	{ PROFILER_SOUND,            "Sound Generation" },
+	{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
+	{ PROFILER_INPUT,            "Input Processing" },
+	{ PROFILER_MOVIE_REC,        "Movie Recording" },
+	{ PROFILER_LOGERROR,         "Error Logging" },
+	{ PROFILER_LUA,              "LUA" },
+	{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
+	{ PROFILER_USER1,            "User 1" },
+	{ PROFILER_USER2,            "User 2" },
+	{ PROFILER_USER3,            "User 3" },
+	{ PROFILER_USER4,            "User 4" },
+	{ PROFILER_USER5,            "User 5" },
+	{ PROFILER_USER6,            "User 6" },
+	{ PROFILER_USER7,            "User 7" },
+	{ PROFILER_USER8,            "User 8" },
+	{ PROFILER_PROFILER,         "Profiler" },
+	{ PROFILER_IDLE,             "Idle" }
+};
 
 
-//**************************************************************************
-//  DUMMY PROFILER STATE
-//**************************************************************************
 
 //-------------------------------------------------
-//  dummy_profiler_state - constructor
+//  category_name - name of a profile type for the
+//  display and traces
 //-------------------------------------------------
 
-dummy_profiler_state::dummy_profiler_state()
+static std::string category_name(device_enumerator &iter, int type)
 {
+	if (type >= PROFILER_DEVICE_FIRST && type <= PROFILER_DEVICE_MAX)
+	{
+		device_t *const device(iter.byindex(type - PROFILER_DEVICE_FIRST));
+		return device ? std::string(device->tag()) : util::string_format("device %d", type - PROFILER_DEVICE_FIRST);
+	}
+	for (auto &name : s_names)
+		if (name.type == type)
+			return name.string;
+	return util::string_format("type %d", type);
+}
+
+
+//-------------------------------------------------
+//  json_escape - quote a string for the trace
+//-------------------------------------------------
+
+static void json_escape(std::ostream &stream, std::string_view str)
+{
+	stream << '"';
+	for (char const ch : str)
+	{
+		if ((ch == '"') || (ch == '\\'))
+			stream << '\\' << ch;
+		else if (u8(ch) < 0x20)
+			util::stream_format(stream, "\\u%04x", unsigned(u8(ch)));
+		else
+			stream << ch;
+	}
+	stream << '"';
 }
 
 
@@ -80,6 +145,12 @@ real_profiler_state::real_profiler_state()
 {
 	memset(m_filo, 0, sizeof(m_filo));
 	memset(m_data, 0, sizeof(m_data));
+	memset(m_frame_mark, 0, sizeof(m_frame_mark));
+	m_overlay = false;
+	m_capture = false;
+	m_frames = 0;
+	m_capture_profile_ticks = 0;
+	m_capture_osd_ticks = 0;
 	reset(false);
 }
 
@@ -92,6 +163,7 @@ real_profiler_state::real_profiler_state()
 void real_profiler_state::reset(bool enabled)
 {
 	m_text_time = attotime::never;
+	m_text_timeslices = 0;
 
 	if (enabled)
 	{
@@ -100,7 +172,9 @@ void real_profiler_state::reset(bool enabled)
 
 		// set up dummy entry
 		m_filoptr->start = 0;
+		m_filoptr->origin = 0;
 		m_filoptr->type = PROFILER_TOTAL;
+		m_filoptr->label = nullptr;
 	}
 	else
 	{
@@ -141,38 +215,6 @@ const char *real_profiler_state::text(running_machine &machine)
 
 void real_profiler_state::update_text(running_machine &machine)
 {
-	static const profile_string names[] =
-	{
-		{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
-		{ PROFILER_MEM_REMAP,        "Memory Remapping" },
-		{ PROFILER_MEMREAD,          "Memory Read" },
-		{ PROFILER_MEMWRITE,         "Memory Write" },
-		{ PROFILER_VIDEO,            "Video Update" },
-		{ PROFILER_DRAWGFX,          "drawgfx" },
-		{ PROFILER_COPYBITMAP,       "copybitmap" },
-		{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
-		{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
-		{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
-		{ PROFILER_BLIT,             "OSD Blitting" },
-		{ PROFILER_SOUND,            "Sound Generation" },
-		{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
-		{ PROFILER_INPUT,            "Input Processing" },
-		{ PROFILER_MOVIE_REC,        "Movie Recording" },
-		{ PROFILER_LOGERROR,         "Error Logging" },
-		{ PROFILER_LUA,              "LUA" },
-		{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
-		{ PROFILER_USER1,            "User 1" },
-		{ PROFILER_USER2,            "User 2" },
-		{ PROFILER_USER3,            "User 3" },
-		{ PROFILER_USER4,            "User 4" },
-		{ PROFILER_USER5,            "User 5" },
-		{ PROFILER_USER6,            "User 6" },
-		{ PROFILER_USER7,            "User 7" },
-		{ PROFILER_USER8,            "User 8" },
-		{ PROFILER_PROFILER,         "Profiler" },
-		{ PROFILER_IDLE,             "Idle" }
-	};
-
 	// compute the total time for all bits, not including profiler or idle
 	u64 computed = 0;
 	profile_type curtype;
@@ -212,21 +254,175 @@ void real_profiler_state::update_text(running_machine &machine)
 
 			// and then the text
 			if (curtype >= PROFILER_DEVICE_FIRST && curtype <= PROFILER_DEVICE_MAX)
-				util::stream_format(stream, "'%s'", iter.byindex(curtype - PROFILER_DEVICE_FIRST)->tag());
+				util::stream_format(stream, "'%s'", category_name(iter, curtype));
 			else
-				for (auto & name : names)
-					if (name.type == curtype)
-					{
-						stream << name.string;
-						break;
-					}
+				stream << category_name(iter, curtype);
 
 			// followed by a carriage return
 			stream << '\n';
 		}
 	}
 
-	// reset data set to 0
+	// append scheduler statistics for the interval since the last update
+	device_scheduler &scheduler = machine.scheduler();
+	attotime const current_time = scheduler.time();
+	if (!m_text_time.is_never() && (current_time > m_text_time) && (scheduler.timeslices() > m_text_timeslices))
+	{
+		u64 const slices = scheduler.timeslices() - m_text_timeslices;
+		double const interval = (current_time - m_text_time).as_double();
+		util::stream_format(stream, "%u timeslices, average %.2f us", slices, interval * 1.0e6 / double(slices));
+		screen_device *const screen = screen_device_enumerator(machine.root_device()).first();
+		if (screen)
+			util::stream_format(stream, ", %.1f per frame", double(slices) * screen->frame_period().as_double() / interval);
+		stream << '\n';
+		if (scheduler.adaptive_quantum_enabled())
+			util::stream_format(stream, "Adaptive quantum %.2f us, %u shrunk slices\n", scheduler.adaptive_quantum().as_double() * 1.0e6, scheduler.quantum_shrinks());
+	}
+	m_text_timeslices = scheduler.timeslices();
+
+	// reset data set to 0, keeping the frame histograms' reference points relative to it
+	for (int i = 0; i <= PROFILER_TOTAL; i++)
+		m_frame_mark[i] -= m_data[i];
 	memset(m_data, 0, sizeof(m_data));
 	m_text = stream.str();
 }
+
+
+
+//-------------------------------------------------
+//  start_capture - begin recording scopes and
+//  frame histograms
+//-------------------------------------------------
+
+void real_profiler_state::start_capture()
+{
+	if (m_capture)
+		return;
+
+	m_capture = true;
+	update_enabled();
+
+	m_trace.clear();
+	m_histograms.assign(PROFILER_TOTAL, std::array<u32, HISTOGRAM_BUCKETS>{ });
+	std::copy(std::begin(m_data), std::end(m_data), std::begin(m_frame_mark));
+	m_frames = 0;
+	m_capture_osd_ticks = osd_ticks();
+	m_capture_profile_ticks = get_profile_ticks();
+}
+
+
+
+//-------------------------------------------------
+//  real_frame - note a frame boundary in the
+//  trace and histograms
+//-------------------------------------------------
+
+void real_profiler_state::real_frame()
+{
+	// the profile tick rate isn't known yet, so bucket by raw ticks and convert when writing
+	for (int type = 0; type < PROFILER_TOTAL; type++)
+	{
+		osd_ticks_t const delta(m_data[type] - m_frame_mark[type]);
+		m_frame_mark[type] = m_data[type];
+		if (delta)
+		{
+			unsigned bucket(0);
+			while ((bucket < (HISTOGRAM_BUCKETS - 1)) && (delta >> bucket) > 1)
+				bucket++;
+			m_histograms[type][bucket]++;
+		}
+	}
+	m_frames++;
+
+	if (m_trace.size() < MAX_TRACE_EVENTS)
+	{
+		osd_ticks_t const now(get_profile_ticks());
+		m_trace.push_back(trace_event{ nullptr, now, now, PROFILER_TOTAL, 0 });
+	}
+}
+
+
+
+//-------------------------------------------------
+//  stop_capture - stop recording and write the
+//  trace as JSON
+//-------------------------------------------------
+
+bool real_profiler_state::stop_capture(running_machine &machine, std::string_view filename)
+{
+	if (!m_capture)
+		return false;
+
+	osd_ticks_t const profile_end(get_profile_ticks());
+	osd_ticks_t const osd_end(osd_ticks());
+	m_capture = false;
+	update_enabled();
+
+	// calibrate profile ticks against the OSD clock over the length of the capture
+	double const osd_us(double(osd_end - m_capture_osd_ticks) * 1.0e6 / double(osd_ticks_per_second()));
+	osd_ticks_t const profile_span(profile_end - m_capture_profile_ticks);
+	double const scale(profile_span ? (osd_us / double(profile_span)) : 0.0);
+
+	device_enumerator iter(machine.root_device());
+	std::ostringstream report;
+	report.imbue(std::locale::classic());
+	report << "{\n\"displayTimeUnit\": \"ns\",\n\"otherData\": { \"system\": ";
+	json_escape(report, machine.system().name);
+	util::stream_format(report, ", \"frames\": %u, \"truncated\": %s },\n\"traceEvents\": [", m_frames, (m_trace.size() >= MAX_TRACE_EVENTS) ? "true" : "false");
+	bool first(true);
+	for (trace_event const &event : m_trace)
+	{
+		double const ts(double(event.start - m_capture_profile_ticks) * scale);
+		report << (first ? "\n" : ",\n");
+		first = false;
+		if (event.type == PROFILER_TOTAL)
+		{
+			util::stream_format(report, "{ \"name\": \"frame\", \"ph\": \"i\", \"s\": \"g\", \"ts\": %.3f, \"pid\": 1, \"tid\": 1 }", ts);
+		}
+		else
+		{
+			std::string const category(category_name(iter, event.type));
+			report << "{ \"name\": ";
+			json_escape(report, event.label ? std::string_view(event.label) : std::string_view(category));
+			report << ", \"cat\": ";
+			json_escape(report, category);
+			util::stream_format(report, ", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": 1 }", ts, double(event.end - event.start) * scale);
+		}
+	}
+
+	// histogram bucket n counts frames that spent less than 2^(n+1) ticks in a type
+	report << "\n],\n\"mameFrameHistograms\": {\n\t\"bucket_upper_us\": [";
+	for (unsigned bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+		util::stream_format(report, "%s%.3f", bucket ? ", " : "", double(u64(2) << bucket) * scale);
+	report << "],\n\t\"types\": {";
+	first = true;
+	for (int type = 0; type < PROFILER_TOTAL; type++)
+	{
+		auto const &histogram(m_histograms[type]);
+		if (std::find_if(histogram.begin(), histogram.end(), [] (u32 count) { return count != 0; }) == histogram.end())
+			continue;
+		report << (first ? "\n\t\t" : ",\n\t\t");
+		first = false;
+		json_escape(report, category_name(iter, type));
+		report << ": [";
+		for (unsigned bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+			util::stream_format(report, "%s%u", bucket ? ", " : "", histogram[bucket]);
+		report << ']';
+	}
+	report << "\n\t}\n}\n}\n";
+
+	m_trace.clear();
+	m_trace.shrink_to_fit();
+	m_histograms.clear();
+
+	std::string const data(report.str());
+	emu_file file(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	std::error_condition const filerr(file.open(filename));
+	if (filerr || (file.write(data.c_str(), data.length()) != data.length()))
+	{
+		osd_printf_error("Error writing profiler trace %s\n", filename);
+		return false;
+	}
+	osd_printf_verbose("Profiler trace written to %s (%u frames)\n", filename, m_frames);
+	return true;
+}
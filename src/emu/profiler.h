@@ -19,6 +19,13 @@
 
     the profiler handles a FILO list so calls may be nested.
 
+    A scope can carry a label (a device tag, handler or timer name) that
+    must stay valid until the profile is written.  While a capture is
+    running, every closed scope is also recorded with its start time and
+    duration, and the time spent in each type during each frame is
+    counted in a histogram.  stop_capture writes both to a JSON file
+    that Chrome's about:tracing and Perfetto can open.
+
 ***************************************************************************/
 
 #ifndef MAME_EMU_PROFILER_H
@@ -26,6 +33,10 @@
 
 #pragma once
 
+#include <array>
+#include <string_view>
+#include <vector>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -91,30 +102,43 @@ public:
 	{
 		return m_filoptr != nullptr;
 	}
+	bool capturing() const { return m_capture; }
 	const char *text(running_machine &machine);
 
-	// enable/disable
+	// enable/disable the on-screen display; a capture keeps the profiler running regardless
 	void enable(bool state = true)
 	{
-		if (state != enabled())
-		{
-			reset(state);
-		}
+		m_overlay = state;
+		update_enabled();
 	}
 
 	// start/stop
-	void start(profile_type type) { if (enabled()) real_start(type); }
+	void start(profile_type type, const char *label = nullptr) { if (enabled()) real_start(type, label); }
 	void stop() { if (enabled()) real_stop(); }
 
+	// capture a trace and per-frame histograms
+	void start_capture();
+	bool stop_capture(running_machine &machine, std::string_view filename);
+	void frame() { if (m_capture) real_frame(); }
+
 private:
+	static constexpr unsigned HISTOGRAM_BUCKETS = 24;      // < 1 us, then powers of two up to several seconds
+	static constexpr size_t MAX_TRACE_EVENTS = 1 << 21;    // stop recording scopes beyond this
+
 	void reset(bool enabled);
+	void update_enabled()
+	{
+		if ((m_overlay || m_capture) != enabled())
+			reset(m_overlay || m_capture);
+	}
 	void update_text(running_machine &machine);
+	void real_frame();
 
 	//-------------------------------------------------
 	//  real_start - mark the beginning of a
 	//  profiler entry
 	//-------------------------------------------------
-	ATTR_FORCE_INLINE void real_start(profile_type type)
+	ATTR_FORCE_INLINE void real_start(profile_type type, const char *label)
 	{
 		// fail if we overflow
 		if (m_filoptr >= &m_filo[std::size(m_filo) - 1])
@@ -131,7 +155,9 @@ private:
 
 		// fill in this entry
 		m_filoptr->type = type;
+		m_filoptr->label = label;
 		m_filoptr->start = curticks;
+		m_filoptr->origin = curticks;
 	}
 
 	//-------------------------------------------------
@@ -149,6 +175,10 @@ private:
 		// account for the time taken
 		m_data[m_filoptr->type] += curticks - m_filoptr->start;
 
+		// record the whole scope if capturing
+		if (UNEXPECTED(m_capture) && (m_trace.size() < MAX_TRACE_EVENTS))
+			m_trace.push_back(trace_event{ m_filoptr->label, m_filoptr->origin, curticks, m_filoptr->type, int(m_filoptr - m_filo) });
+
 		// move back an entry
 		m_filoptr--;
 
@@ -160,15 +190,38 @@ private:
 	struct filo_entry
 	{
 		int             type;                       // type of entry
+		const char *    label;                      // optional label
+		osd_ticks_t     start;                      // start time, moved on while nested entries run
+		osd_ticks_t     origin;                     // time the entry was started
+	};
+
+	// a closed scope recorded during a capture
+	struct trace_event
+	{
+		const char *    label;                      // label, or nullptr to use the type name
 		osd_ticks_t     start;                      // start time
+		osd_ticks_t     end;                        // end time
+		int             type;                       // type of entry, PROFILER_TOTAL for a frame marker
+		int             depth;                      // nesting depth
 	};
 
 	// internal state
 	filo_entry *        m_filoptr;                  // current FILO index
 	std::string         m_text;                     // profiler text
 	attotime            m_text_time;                // profiler text last update
+	u64                 m_text_timeslices;          // scheduler timeslice count at last update
 	filo_entry          m_filo[32];                 // array of FILO entries
 	osd_ticks_t         m_data[PROFILER_TOTAL + 1]; // array of data
+	bool                m_overlay;                  // the on-screen display wants data
+	bool                m_capture;                  // a capture is running
+
+	// capture state
+	std::vector<trace_event> m_trace;               // recorded scopes
+	std::vector<std::array<u32, HISTOGRAM_BUCKETS> > m_histograms; // per-type counts of frames by time spent
+	osd_ticks_t         m_frame_mark[PROFILER_TOTAL + 1]; // m_data at the last frame boundary
+	u32                 m_frames;                   // frames seen during the capture
+	osd_ticks_t         m_capture_profile_ticks;    // profile ticks when the capture started
+	osd_ticks_t         m_capture_osd_ticks;        // OSD ticks at the same moment, to calibrate profile ticks
 };
 
 
@@ -178,7 +231,7 @@ class dummy_profiler_state
 {
 public:
 	// construction/destruction
-	dummy_profiler_state();
+	constexpr dummy_profiler_state() { }
 
 	// getters
 	bool enabled() const { return false; }
@@ -186,10 +239,16 @@ public:
 
 	// enable/disable
 	void enable(bool state = true) { }
+	bool capturing() const { return false; }
 
 	// start/stop
-	void start(profile_type type) { }
+	void start(profile_type type, const char *label = nullptr) { }
 	void stop() { }
+
+	// capture a trace and per-frame histograms
+	void start_capture() { }
+	bool stop_capture(running_machine &machine, std::string_view filename) { return false; }
+	void frame() { }
 };
 
 
@@ -207,7 +266,21 @@ typedef dummy_profiler_state profiler_state;
 //  GLOBAL VARIABLES
 //**************************************************************************
 
-extern profiler_state g_profiler;
+extern thread_local profiler_state g_profiler;
+
+
+// ======================> profiler_scope
+
+// profiles the enclosing scope
+class profiler_scope
+{
+public:
+	profiler_scope(profile_type type, const char *label = nullptr) { g_profiler.start(type, label); }
+	~profiler_scope() { g_profiler.stop(); }
+
+	profiler_scope(const profiler_scope &) = delete;
+	profiler_scope &operator=(const profiler_scope &) = delete;
+};
 
 
 #endif  /* MAME_EMU_PROFILER_H */
@@ -26,12 +26,13 @@ namespace
 			: movie_recording(screen)
 		{
 		}
+		~avi_movie_recording();
 
 		bool initialize(running_machine &machine, std::unique_ptr<emu_file> &&file, int32_t width, int32_t height);
-		virtual bool add_sound_to_recording(const s16 *sound, int numsamples) override;
 
 	protected:
 		virtual bool append_single_video_frame(bitmap_rgb32 &bitmap, const rgb_t *palette, int palette_entries) override;
+		virtual bool append_sound_samples(const s16 *sound, int numsamples) override;
 
 	private:
 		avi_file::ptr m_avi_file; // handle to the open movie file
@@ -45,10 +46,10 @@ namespace
 		~mng_movie_recording();
 
 		bool initialize(std::unique_ptr<emu_file> &&file, bitmap_t &snap_bitmap);
-		virtual bool add_sound_to_recording(const s16 *sound, int numsamples) override;
 
 	protected:
 		virtual bool append_single_video_frame(bitmap_rgb32 &bitmap, const rgb_t *palette, int palette_entries) override;
+		virtual bool append_sound_samples(const s16 *sound, int numsamples) override;
 
 	private:
 		std::unique_ptr<emu_file> m_mng_file; // handle to the open movie file
@@ -70,6 +71,11 @@ movie_recording::movie_recording(screen_device *screen)
 	, m_frame_period(attotime::zero)
 	, m_next_frame_time(attotime::zero)
 	, m_frame(0)
+	, m_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO))
+	, m_frames_allocated(0)
+	, m_failed(false)
+	, m_stalls(0)
+	, m_stall_ticks(0)
 {
 }
 
@@ -80,32 +86,188 @@ movie_recording::movie_recording(screen_device *screen)
 
 movie_recording::~movie_recording()
 {
+	finish_encoding();
+	if (m_queue)
+		osd_work_queue_free(m_queue);
+
+	if (m_stalls)
+		osd_printf_info("Movie recording: encoder fell behind %u times, stalling emulation for %.1f ms in total\n",
+				m_stalls, double(m_stall_ticks) * 1000.0 / double(osd_ticks_per_second()));
 }
 
 
 //-------------------------------------------------
-//  movie_recording::append_video_frame
+//  movie_recording::append_video_frame - copy the
+//  frame into the pool and hand it to the encoder
 //-------------------------------------------------
 
 bool movie_recording::append_video_frame(bitmap_rgb32 &bitmap, attotime curtime)
 {
-	// identify the palette
-	bool has_palette = screen() && screen()->has_palette();
-	const rgb_t *palette = has_palette ? screen()->palette().palette()->entry_list_adjusted() : nullptr;
-	int palette_entries = has_palette ? screen()->palette().entries() : 0;
-
-	// keep appending frames until we're at curtime
+	// count the movie frames this bitmap covers
+	unsigned repeat = 0;
 	while (next_frame_time() <= curtime)
 	{
-		// append this bitmap as a single frame
-		if (!append_single_video_frame(bitmap, palette, palette_entries))
-			return false;
-		m_frame++;
-
-		// advance time
+		repeat++;
 		set_next_frame_time(next_frame_time() + frame_period());
 	}
-	return true;
+	if (!repeat)
+		return !m_failed.load(std::memory_order_relaxed);
+
+	// get a frame from the pool, waiting for the encoder if it has all of them
+	std::unique_ptr<pending_item> item;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (m_free_frames.empty() && m_frames_allocated >= FRAME_POOL_SIZE)
+		{
+			osd_ticks_t const start = osd_ticks();
+			m_frame_freed.wait(lock, [this] () { return !m_free_frames.empty(); });
+			m_stalls++;
+			m_stall_ticks += osd_ticks() - start;
+		}
+		if (!m_free_frames.empty())
+		{
+			item = std::move(m_free_frames.back());
+			m_free_frames.pop_back();
+		}
+	}
+	if (!item)
+	{
+		item = std::make_unique<pending_item>();
+		item->video = true;
+		m_frames_allocated++;
+	}
+
+	// copy the frame and the palette, which may both change before it is encoded
+	if (item->bitmap.width() != bitmap.width() || item->bitmap.height() != bitmap.height())
+		item->bitmap.allocate(bitmap.width(), bitmap.height());
+	copybitmap(item->bitmap, bitmap, 0, 0, 0, 0, bitmap.cliprect());
+	item->palette.clear();
+	if (screen() && screen()->has_palette())
+	{
+		const rgb_t *palette = screen()->palette().palette()->entry_list_adjusted();
+		item->palette.assign(palette, palette + screen()->palette().entries());
+	}
+	item->repeat = repeat;
+
+	queue_item(std::move(item));
+	return !m_failed.load(std::memory_order_relaxed);
+}
+
+
+//-------------------------------------------------
+//  movie_recording::add_sound_to_recording -
+//  queue samples behind the frames already queued
+//-------------------------------------------------
+
+bool movie_recording::add_sound_to_recording(const s16 *sound, int numsamples)
+{
+	auto item = std::make_unique<pending_item>();
+	item->video = false;
+	item->repeat = 0;
+	item->sound.assign(sound, sound + numsamples * 2);
+
+	queue_item(std::move(item));
+	return !m_failed.load(std::memory_order_relaxed);
+}
+
+
+//-------------------------------------------------
+//  movie_recording::finish_encoding - wait for
+//  the encoder to write everything queued
+//-------------------------------------------------
+
+void movie_recording::finish_encoding()
+{
+	if (m_queue)
+		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
+}
+
+
+//-------------------------------------------------
+//  movie_recording::queue_item - pass an item to
+//  the encoder thread, or encode it now if there
+//  is no thread
+//-------------------------------------------------
+
+void movie_recording::queue_item(std::unique_ptr<pending_item> &&item)
+{
+	if (m_queue)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_pending.emplace_back(std::move(item));
+		}
+
+		// the queue has a single thread, so items are encoded in order
+		if (osd_work_item_queue(m_queue, &movie_recording::encode_callback, this, WORK_ITEM_FLAG_AUTO_RELEASE))
+			return;
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		item = std::move(m_pending.back());
+		m_pending.pop_back();
+	}
+
+	encode_item(*item);
+	if (item->video)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_free_frames.emplace_back(std::move(item));
+	}
+}
+
+
+//-------------------------------------------------
+//  movie_recording::encode_item - write a frame
+//  or block of samples to the file
+//-------------------------------------------------
+
+void movie_recording::encode_item(pending_item &item)
+{
+	// once a write has failed the recording is ended, so drop anything else
+	if (m_failed.load(std::memory_order_relaxed))
+		return;
+
+	bool ok = true;
+	if (item.video)
+	{
+		const rgb_t *palette = item.palette.empty() ? nullptr : &item.palette[0];
+		for (unsigned i = 0; ok && i < item.repeat; i++)
+		{
+			ok = append_single_video_frame(item.bitmap, palette, item.palette.size());
+			m_frame++;
+		}
+	}
+	else
+	{
+		ok = append_sound_samples(&item.sound[0], item.sound.size() / 2);
+	}
+
+	if (!ok)
+		m_failed.store(true, std::memory_order_relaxed);
+}
+
+void *movie_recording::encode_callback(void *param, int threadid)
+{
+	auto &recording = *reinterpret_cast<movie_recording *>(param);
+
+	std::unique_ptr<pending_item> item;
+	{
+		std::lock_guard<std::mutex> lock(recording.m_mutex);
+		item = std::move(recording.m_pending.front());
+		recording.m_pending.pop_front();
+	}
+
+	recording.encode_item(*item);
+
+	if (item->video)
+	{
+		{
+			std::lock_guard<std::mutex> lock(recording.m_mutex);
+			recording.m_free_frames.emplace_back(std::move(item));
+		}
+		recording.m_frame_freed.notify_one();
+	}
+	return nullptr;
 }
 
 
@@ -165,6 +327,16 @@ const char *movie_recording::format_file_extension(movie_recording::format fmt)
 }
 
 
+//-------------------------------------------------
+//  avi_movie_recording - destructor
+//-------------------------------------------------
+
+avi_movie_recording::~avi_movie_recording()
+{
+	finish_encoding();
+}
+
+
 //-------------------------------------------------
 //  avi_movie_recording::initialize
 //-------------------------------------------------
@@ -216,19 +388,15 @@ bool avi_movie_recording::append_single_video_frame(bitmap_rgb32 &bitmap, const
 
 
 //-------------------------------------------------
-//  avi_movie_recording::append_video_frame
+//  avi_movie_recording::append_sound_samples
 //-------------------------------------------------
 
-bool avi_movie_recording::add_sound_to_recording(const s16 *sound, int numsamples)
+bool avi_movie_recording::append_sound_samples(const s16 *sound, int numsamples)
 {
-	g_profiler.start(PROFILER_MOVIE_REC);
-
 	// write the next frame
 	avi_file::error avierr = m_avi_file->append_sound_samples(0, sound + 0, numsamples, 1);
 	if (avierr == avi_file::error::NONE)
 		avierr = m_avi_file->append_sound_samples(1, sound + 1, numsamples, 1);
-
-	g_profiler.stop();
 	return avierr == avi_file::error::NONE;
 }
 
@@ -250,6 +418,7 @@ mng_movie_recording::mng_movie_recording(screen_device *screen, std::map<std::st
 
 mng_movie_recording::~mng_movie_recording()
 {
+	finish_encoding();
 	if (m_mng_file)
 		util::mng_capture_stop(*m_mng_file);
 }
@@ -294,10 +463,10 @@ bool mng_movie_recording::append_single_video_frame(bitmap_rgb32 &bitmap, const
 
 
 //-------------------------------------------------
-//  mng_movie_recording::add_sound_to_recording
+//  mng_movie_recording::append_sound_samples
 //-------------------------------------------------
 
-bool mng_movie_recording::add_sound_to_recording(const s16 *sound, int numsamples)
+bool mng_movie_recording::append_sound_samples(const s16 *sound, int numsamples)
 {
 	// not supported; do nothing
 	return true;
@@ -17,7 +17,12 @@
 #ifndef MAME_EMU_RECORDING_H
 #define MAME_EMU_RECORDING_H
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "attotime.h"
 #include "palette.h"
@@ -54,9 +59,7 @@ public:
 
 	// methods
 	bool append_video_frame(bitmap_rgb32 &bitmap, attotime curtime);
-
-	// virtuals
-	virtual bool add_sound_to_recording(const s16 *sound, int numsamples) = 0;
+	bool add_sound_to_recording(const s16 *sound, int numsamples);
 
 	// statics
 	static movie_recording::ptr create(running_machine &machine, screen_device *screen, format fmt, std::unique_ptr<emu_file> &&file, bitmap_rgb32 &snap_bitmap);
@@ -68,18 +71,50 @@ protected:
 	movie_recording(const movie_recording &) = delete;
 	movie_recording(movie_recording &&) = delete;
 
-	// virtuals
+	// virtuals, called from the encoder thread
 	virtual bool append_single_video_frame(bitmap_rgb32 &bitmap, const rgb_t *palette, int palette_entries) = 0;
+	virtual bool append_sound_samples(const s16 *sound, int numsamples) = 0;
 
 	// accessors
 	int current_frame() const { return m_frame; }
 	void set_frame_period(attotime time) { m_frame_period = time; }
 
+	// wait for everything queued to be written; must be called by derived destructors
+	void finish_encoding();
+
 private:
+	// frames in the pool; the emulation waits when the encoder falls this far behind
+	static constexpr unsigned FRAME_POOL_SIZE = 8;
+
+	// a frame or block of samples waiting for the encoder
+	struct pending_item
+	{
+		bool                video;          // true for a frame, false for sound
+		unsigned            repeat;         // number of movie frames this bitmap covers
+		bitmap_rgb32        bitmap;         // copy of the frame
+		std::vector<rgb_t>  palette;        // copy of the adjusted palette
+		std::vector<s16>    sound;          // interleaved stereo samples
+	};
+
+	void queue_item(std::unique_ptr<pending_item> &&item);
+	void encode_item(pending_item &item);
+	static void *encode_callback(void *param, int threadid);
+
 	screen_device * m_screen;               // screen associated with this movie (can be nullptr)
 	attotime        m_frame_period;         // duration of movie frame
 	attotime        m_next_frame_time;      // time of next frame
 	int             m_frame;                // current movie frame number
+
+	// background encoding
+	osd_work_queue *m_queue;                // encoder thread, or nullptr to encode synchronously
+	std::mutex      m_mutex;                // protects the lists below
+	std::condition_variable m_frame_freed;  // signalled when a frame returns to the pool
+	std::deque<std::unique_ptr<pending_item>> m_pending; // items waiting for the encoder, oldest first
+	std::vector<std::unique_ptr<pending_item>> m_free_frames; // frame pool
+	unsigned        m_frames_allocated;     // frames allocated to the pool so far
+	std::atomic<bool> m_failed;             // set by the encoder when a write fails
+	u32             m_stalls;               // times the emulation waited for the encoder
+	osd_ticks_t     m_stall_ticks;          // total time spent waiting
 };
 
 
@@ -193,6 +193,7 @@ void render_primitive::reset()
 //-------------------------------------------------
 
 render_primitive_list::render_primitive_list()
+	: m_references_sorted(true)
 {
 }
 
@@ -213,14 +214,13 @@ render_primitive_list::~render_primitive_list()
 
 inline void render_primitive_list::add_reference(void *refptr)
 {
-	// skip if we already have one
-	if (has_reference(refptr))
-		return;
-
-	// set the refptr and link us into the list
-	reference *ref = m_reference_allocator.alloc();
-	ref->m_refptr = refptr;
-	m_reflist.append(*ref);
+	// layouts can have thousands of items, so duplicates are only weeded
+	// out when the references are searched rather than on every add
+	if (m_references.empty() || (m_references.back() != refptr))
+	{
+		m_references.push_back(refptr);
+		m_references_sorted = false;
+	}
 }
 
 
@@ -231,11 +231,13 @@ inline void render_primitive_list::add_reference(void *refptr)
 
 inline bool render_primitive_list::has_reference(void *refptr) const
 {
-	// skip if we already have one
-	for (reference &ref : m_reflist)
-		if (ref.m_refptr == refptr)
-			return true;
-	return false;
+	if (!m_references_sorted)
+	{
+		std::sort(m_references.begin(), m_references.end());
+		m_references.erase(std::unique(m_references.begin(), m_references.end()), m_references.end());
+		m_references_sorted = true;
+	}
+	return std::binary_search(m_references.begin(), m_references.end(), refptr);
 }
 
 
@@ -261,7 +263,8 @@ void render_primitive_list::release_all()
 {
 	// release all the live items while under the lock
 	m_primitive_allocator.reclaim_all(m_primlist);
-	m_reference_allocator.reclaim_all(m_reflist);
+	m_references.clear();
+	m_references_sorted = true;
 }
 
 
@@ -296,9 +299,15 @@ render_texture::render_texture()
 		m_format(TEXFORMAT_ARGB32),
 		m_id(~0ULL),
 		m_old_id(~0ULL),
+		m_explicit_updates(false),
+		m_bitmap_seqid(0),
+		m_palette(nullptr),
+		m_palette_seqid(0),
+		m_damage_seqid(0),
 		m_scaler(nullptr),
 		m_param(nullptr),
-		m_curseq(0)
+		m_curseq(0),
+		m_curuse(0)
 {
 	m_sbounds.set(0, -1, 0, -1);
 	memset(m_scaled, 0, sizeof(m_scaled));
@@ -346,6 +355,7 @@ void render_texture::release()
 		m_manager->invalidate_all(elem.bitmap.get());
 		elem.bitmap.reset();
 		elem.seqid = 0;
+		elem.lastuse = 0;
 	}
 
 	// invalidate references to the original bitmap as well
@@ -353,7 +363,13 @@ void render_texture::release()
 	m_bitmap = nullptr;
 	m_sbounds.set(0, -1, 0, -1);
 	m_format = TEXFORMAT_ARGB32;
+	m_explicit_updates = false;
+	m_bitmap_seqid = 0;
+	m_palette = nullptr;
+	m_palette_seqid = 0;
+	m_damage_seqid = 0;
 	m_curseq = 0;
+	m_curuse = 0;
 }
 
 
@@ -361,7 +377,7 @@ void render_texture::release()
 //  set_bitmap - set a new source bitmap
 //-------------------------------------------------
 
-void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, texture_format format)
+void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, texture_format format, const rectangle *damage)
 {
 	assert(bitmap.cliprect().contains(sbounds));
 
@@ -369,6 +385,19 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 	if (format == TEXFORMAT_PALETTE16)
 		assert(bitmap.palette() != nullptr);
 
+	// the damaged area only means something relative to the same bitmap and bounds
+	if (damage && m_explicit_updates && m_bitmap_seqid && &bitmap == m_bitmap && sbounds == m_sbounds && format == m_format)
+	{
+		m_damage = *damage;
+		m_damage &= sbounds;
+		m_damage.offset(-sbounds.left(), -sbounds.top());
+		m_damage_seqid = m_bitmap_seqid;
+	}
+	else
+	{
+		m_damage_seqid = 0;
+	}
+
 	// invalidate references to the old bitmap
 	if (&bitmap != m_bitmap && m_bitmap != nullptr)
 		m_manager->invalidate_all(m_bitmap);
@@ -377,6 +406,7 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 	m_bitmap = &bitmap;
 	m_sbounds = sbounds;
 	m_format = format;
+	m_bitmap_seqid = ++m_curseq;
 
 	// invalidate all scaled versions
 	for (auto & elem : m_scaled)
@@ -385,6 +415,7 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 			m_manager->invalidate_all(elem.bitmap.get());
 		elem.bitmap.reset();
 		elem.seqid = 0;
+		elem.lastuse = 0;
 	}
 }
 
@@ -432,8 +463,11 @@ void render_texture::get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo
 		texinfo.rowpixels = m_bitmap->rowpixels();
 		texinfo.width = swidth;
 		texinfo.height = sheight;
-		// palette will be set later
-		texinfo.seqid = ++m_curseq;
+		// palette will be set later; unless the owner promises to call set_bitmap for every
+		// change, the contents may have been modified in place, so always report them as new
+		texinfo.seqid = m_explicit_updates ? m_bitmap_seqid : ++m_curseq;
+		texinfo.damage_seqid = m_explicit_updates ? m_damage_seqid : 0;
+		texinfo.damage = m_damage;
 	}
 	else
 	{
@@ -458,9 +492,9 @@ void render_texture::get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo
 		{
 			int lowest = -1;
 
-			// didn't find one -- take the entry with the lowest seqnum
+			// didn't find one -- take the least recently used entry
 			for (scalenum = 0; scalenum < std::size(m_scaled); scalenum++)
-				if ((lowest == -1 || m_scaled[scalenum].seqid < m_scaled[lowest].seqid) && !primlist.has_reference(m_scaled[scalenum].bitmap.get()))
+				if ((lowest == -1 || m_scaled[scalenum].lastuse < m_scaled[lowest].lastuse) && !primlist.has_reference(m_scaled[scalenum].bitmap.get()))
 					lowest = scalenum;
 			if (-1 == lowest)
 				throw emu_fatalerror("render_texture::get_scaled: Too many live texture instances!");
@@ -482,6 +516,7 @@ void render_texture::get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo
 		}
 
 		// finally fill out the new info
+		scaled->lastuse = ++m_curuse;
 		primlist.add_reference(scaled->bitmap.get());
 		texinfo.base = &scaled->bitmap->pix(0);
 		texinfo.rowpixels = scaled->bitmap->rowpixels();
@@ -489,6 +524,7 @@ void render_texture::get_scaled(u32 dwidth, u32 dheight, render_texinfo &texinfo
 		texinfo.height = dheight;
 		// palette will be set later
 		texinfo.seqid = scaled->seqid;
+		texinfo.damage_seqid = 0;
 	}
 }
 
@@ -541,6 +577,8 @@ render_container::render_container(render_manager &manager, screen_device *scree
 	, m_screen(screen)
 	, m_overlaybitmap(nullptr)
 	, m_overlaytexture(nullptr)
+	, m_palette_seqid(0)
+	, m_generation(0)
 {
 	// make sure it is empty
 	empty();
@@ -640,6 +678,29 @@ void render_container::add_char(float x0, float y0, float height, float aspect,
 	render_bounds bounds;
 	bounds.x0 = x0;
 	bounds.y0 = y0;
+
+	// the UI container is only drawn by the UI target, so its text can come
+	// from a font atlas rasterised at the size it will be displayed at; this
+	// lets a whole run of characters share one texture
+	if (this == &m_manager.ui_container())
+	{
+		render_target &target = m_manager.ui_target();
+		bool const swap = target.orientation() & ORIENTATION_SWAP_XY;
+		render_bounds texbounds;
+		render_texture *const texture = font.get_char_atlas_texture_and_bounds(
+				height, aspect, ch,
+				swap ? target.height() : target.width(), swap ? target.width() : target.height(),
+				bounds, texbounds);
+		if (texture)
+		{
+			item &newitem = add_generic(CONTAINER_ITEM_QUAD, bounds.x0, bounds.y0, bounds.x1, bounds.y1, argb);
+			newitem.m_texture = texture;
+			newitem.m_texbounds = texbounds;
+			newitem.m_flags = PRIMFLAG_TEXORIENT(ROT0) | PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA);
+			newitem.m_internal = INTERNAL_FLAG_CHAR;
+			return;
+		}
+	}
 	render_texture *texture = font.get_char_texture_and_bounds(height, aspect, ch, bounds);
 
 	// add it like a quad
@@ -760,6 +821,7 @@ render_container::item &render_container::add_generic(u8 type, float x0, float y
 	newitem->m_internal = 0;
 	newitem->m_width = 0;
 	newitem->m_texture = nullptr;
+	newitem->m_texbounds.set_xy(0.0f, 0.0f, 1.0f, 1.0f);
 
 	// add the item to the container
 	return m_itemlist.append(*newitem);
@@ -773,6 +835,8 @@ render_container::item &render_container::add_generic(u8 type, float x0, float y
 
 void render_container::recompute_lookups()
 {
+	m_palette_seqid++;
+
 	// recompute the 256 entry lookup table
 	for (int i = 0; i < 0x100; i++)
 	{
@@ -825,6 +889,7 @@ void render_container::update_palette()
 	// iterate over dirty items and update them
 	if (dirty != nullptr)
 	{
+		m_palette_seqid++;
 		palette_t &palette = m_palclient->palette();
 		const rgb_t *adjusted_palette = palette.entry_list_adjusted();
 
@@ -897,6 +962,11 @@ template <typename T> render_target::render_target(render_manager &manager, T &&
 	, m_curview(0U)
 	, m_flags(flags)
 	, m_listindex(0)
+	, m_prepared(nullptr)
+	, m_prepared_width(0)
+	, m_prepared_height(0)
+	, m_prepared_orientation(0)
+	, m_prepare_pending(false)
 	, m_width(640)
 	, m_height(480)
 	, m_keepaspect(false)
@@ -1010,6 +1080,8 @@ int render_target::index() const
 
 void render_target::set_bounds(s32 width, s32 height, float pixel_aspect)
 {
+	if (width != m_width || height != m_height)
+		m_manager.wait_primitives();
 	m_width = width;
 	m_height = height;
 	m_bounds.x0 = m_bounds.y0 = 0;
@@ -1028,6 +1100,8 @@ void render_target::set_view(unsigned viewindex)
 {
 	if (m_views.size() > viewindex)
 	{
+		m_manager.wait_primitives();
+		m_prepared = nullptr;
 		m_curview = viewindex;
 		current_view().recompute(visibility_mask(), m_layerconfig.zoom_to_screen());
 		current_view().preload();
@@ -1378,6 +1452,55 @@ void render_target::compute_minimum_size(s32 &minwidth, s32 &minheight)
 //-------------------------------------------------
 
 render_primitive_list &render_target::get_primitives()
+{
+	// use the list built by the render thread if it still matches the target
+	m_manager.wait_primitives();
+	render_primitive_list *const prepared = std::exchange(m_prepared, nullptr);
+	if (prepared && (m_prepared_width == m_width) && (m_prepared_height == m_height) && (m_prepared_orientation == m_orientation))
+		return *prepared;
+
+	// otherwise sample the items and build it now
+	snapshot_items();
+	return build_primitives();
+}
+
+
+//-------------------------------------------------
+//  snapshot_items - sample the state of all the
+//  visible items; this may call back into the
+//  emulation so it must be done on its thread
+//-------------------------------------------------
+
+void render_target::snapshot_items()
+{
+	m_item_states.clear();
+	if (m_manager.machine().phase() >= machine_phase::RESET)
+	{
+		current_view().prepare_items();
+		for (layout_view_item &curitem : current_view().visible_items())
+		{
+			item_state &state = m_item_states.emplace_back();
+			state.bounds = curitem.bounds();
+			state.color = curitem.color();
+			if (curitem.element())
+			{
+				state.state = (std::max)(curitem.element_state(), 0);
+				state.scroll_size_x = curitem.scroll_size_x();
+				state.scroll_size_y = curitem.scroll_size_y();
+				state.scroll_pos_x = curitem.scroll_pos_x();
+				state.scroll_pos_y = curitem.scroll_pos_y();
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  build_primitives - build a primitive list from
+//  the sampled item state
+//-------------------------------------------------
+
+render_primitive_list &render_target::build_primitives()
 {
 	// switch to the next primitive list
 	render_primitive_list &list = m_primlist[m_listindex];
@@ -1404,11 +1527,14 @@ render_primitive_list &render_target::get_primitives()
 	if (m_manager.machine().phase() >= machine_phase::RESET)
 	{
 		// we're running - iterate over items in the view
-		current_view().prepare_items();
-		for (layout_view_item &curitem : current_view().visible_items())
+		auto const &items = current_view().visible_items();
+		for (size_t index = 0; index < m_item_states.size(); index++)
 		{
+			layout_view_item &curitem = items[index];
+			item_state const &state = m_item_states[index];
+
 			// first apply orientation to the bounds
-			render_bounds bounds = curitem.bounds();
+			render_bounds bounds = state.bounds;
 			apply_orientation(bounds, root_xform.orientation);
 			normalize_bounds(bounds);
 
@@ -1418,7 +1544,7 @@ render_primitive_list &render_target::get_primitives()
 			item_xform.yoffs = root_xform.yoffs + bounds.y0 * root_xform.yscale;
 			item_xform.xscale = (bounds.x1 - bounds.x0) * root_xform.xscale;
 			item_xform.yscale = (bounds.y1 - bounds.y0) * root_xform.yscale;
-			item_xform.color = curitem.color() * root_xform.color;
+			item_xform.color = state.color * root_xform.color;
 			item_xform.orientation = orientation_add(curitem.orientation(), root_xform.orientation);
 			item_xform.no_center = false;
 
@@ -1426,7 +1552,7 @@ render_primitive_list &render_target::get_primitives()
 			if (curitem.screen())
 				add_container_primitives(list, root_xform, item_xform, curitem.screen()->container(), curitem.blend_mode());
 			else
-				add_element_primitives(list, item_xform, curitem);
+				add_element_primitives(list, item_xform, curitem, state);
 		}
 	}
 	else
@@ -1642,6 +1768,8 @@ void render_target::resolve_tags()
 
 void render_target::update_layer_config()
 {
+	m_manager.wait_primitives();
+	m_prepared = nullptr;
 	current_view().recompute(visibility_mask(), m_layerconfig.zoom_to_screen());
 }
 
@@ -2372,19 +2500,49 @@ void render_target::add_container_primitives(render_primitive_list &list, const
 					// determine the final orientation
 					int finalorient = orientation_add(PRIMFLAG_GET_TEXORIENT(curitem.flags()), container_xform.orientation);
 
-					// based on the swap values, get the scaled final texture
+					// based on the swap values, get the scaled final texture; when only part of
+					// the texture is drawn, the whole texture is scaled by the same factor
+					render_bounds const &texbounds = curitem.texbounds();
+					bool const subrect = (texbounds.x0 != 0.0f) || (texbounds.y0 != 0.0f) || (texbounds.x1 != 1.0f) || (texbounds.y1 != 1.0f);
 					int width = (finalorient & ORIENTATION_SWAP_XY) ? (prim->bounds.y1 - prim->bounds.y0) : (prim->bounds.x1 - prim->bounds.x0);
 					int height = (finalorient & ORIENTATION_SWAP_XY) ? (prim->bounds.x1 - prim->bounds.x0) : (prim->bounds.y1 - prim->bounds.y0);
+					if (subrect)
+					{
+						width = int(float(width) / (texbounds.x1 - texbounds.x0) + 0.5f);
+						height = int(float(height) / (texbounds.y1 - texbounds.y0) + 0.5f);
+					}
 					width = std::min(width, m_maxtexwidth);
 					height = std::min(height, m_maxtexheight);
 
 					curitem.texture()->get_scaled(width, height, prim->texture, list, curitem.flags());
 
-					// set the palette
-					prim->texture.palette = curitem.texture()->get_adjusted_palette(container, prim->texture.palette_length);
+					// set the palette; the OSD applies it while uploading, so the contents are new
+					// whenever the adjusted palette has changed since they were last reported
+					render_texture &texture = *curitem.texture();
+					prim->texture.palette = texture.get_adjusted_palette(container, prim->texture.palette_length);
+					if (prim->texture.palette && texture.m_explicit_updates)
+					{
+						if (prim->texture.palette != texture.m_palette || container.m_palette_seqid != texture.m_palette_seqid)
+						{
+							texture.m_palette = prim->texture.palette;
+							texture.m_palette_seqid = container.m_palette_seqid;
+							texture.m_bitmap_seqid = ++texture.m_curseq;
+							texture.m_damage_seqid = 0;
+						}
+						prim->texture.seqid = texture.m_bitmap_seqid;
+						prim->texture.damage_seqid = texture.m_damage_seqid;
+					}
 
 					// determine UV coordinates
 					prim->texcoords = oriented_texcoords[finalorient];
+					if (subrect)
+					{
+						for (render_texuv *uv : { &prim->texcoords.tl, &prim->texcoords.tr, &prim->texcoords.bl, &prim->texcoords.br })
+						{
+							uv->u = texbounds.x0 + uv->u * (texbounds.x1 - texbounds.x0);
+							uv->v = texbounds.y0 + uv->v * (texbounds.y1 - texbounds.y0);
+						}
+					}
 
 					// apply clipping
 					clipped = render_clip_quad(prim->bounds, cliprect, &prim->texcoords);
@@ -2509,16 +2667,13 @@ void render_target::add_container_primitives(render_primitive_list &list, const
 //  for an element in the current state
 //-------------------------------------------------
 
-void render_target::add_element_primitives(render_primitive_list &list, const object_transform &xform, layout_view_item &item)
+void render_target::add_element_primitives(render_primitive_list &list, const object_transform &xform, layout_view_item &item, const item_state &state)
 {
 	layout_element &element(*item.element());
 	int const blendmode(item.blend_mode());
 
-	// limit state range to non-negative values
-	int const state((std::max)(item.element_state(), 0));
-
 	// get a pointer to the relevant texture
-	render_texture *texture = element.state_texture(state);
+	render_texture *texture = element.state_texture(state.state);
 	if (texture)
 	{
 		render_primitive *prim = list.alloc(render_primitive::QUAD);
@@ -2538,8 +2693,8 @@ void render_target::add_element_primitives(render_primitive_list &list, const ob
 		prim->full_bounds = prim->bounds;
 
 		// get the scaled texture and append it
-		float const xsize(item.scroll_size_x());
-		float const ysize(item.scroll_size_y());
+		float const xsize(state.scroll_size_x);
+		float const ysize(state.scroll_size_y);
 		s32 texwidth = render_round_nearest(((xform.orientation & ORIENTATION_SWAP_XY) ? primheight : primwidth) / xsize);
 		s32 texheight = render_round_nearest(((xform.orientation & ORIENTATION_SWAP_XY) ? primwidth : primheight) / ysize);
 		texwidth = (std::min)(texwidth, m_maxtexwidth);
@@ -2554,8 +2709,8 @@ void render_target::add_element_primitives(render_primitive_list &list, const ob
 		float const ywindow((xform.orientation & ORIENTATION_SWAP_XY) ? primwidth : primheight);
 		float const xrange(float(texwidth) - (item.scroll_wrap_x() ? 0.0f : xwindow));
 		float const yrange(float(texheight) - (item.scroll_wrap_y() ? 0.0f : ywindow));
-		float const xoffset(render_round_nearest(item.scroll_pos_x() * xrange) / float(texwidth));
-		float const yoffset(render_round_nearest(item.scroll_pos_y() * yrange) / float(texheight));
+		float const xoffset(render_round_nearest(state.scroll_pos_x * xrange) / float(texwidth));
+		float const yoffset(render_round_nearest(state.scroll_pos_y * yrange) / float(texheight));
 		float const xend(xoffset + (xwindow / float(texwidth)));
 		float const yend(yoffset + (ywindow / float(texheight)));
 		switch (xform.orientation)
@@ -3099,6 +3254,7 @@ done:
 render_manager::render_manager(running_machine &machine)
 	: m_machine(machine)
 	, m_ui_target(nullptr)
+	, m_prepare_queue(nullptr)
 	, m_live_textures(0)
 	, m_texture_id(0)
 	, m_ui_container(std::make_unique<render_container>(*this))
@@ -3112,6 +3268,14 @@ render_manager::render_manager(running_machine &machine)
 	// create one container per screen
 	for (screen_device &screen : screen_device_enumerator(machine.root_device()))
 		screen.set_container(m_screen_container_list.emplace_back(*this, &screen));
+
+	// screens that add to their container while emulating can't be drawn ahead
+	bool render_thread = machine.options().render_thread();
+	for (screen_device &screen : screen_device_enumerator(machine.root_device()))
+		if ((screen.screen_type() == SCREEN_TYPE_VECTOR) || (screen.video_attributes() & VIDEO_SELF_RENDER))
+			render_thread = false;
+	if (render_thread)
+		m_prepare_queue = osd_work_queue_alloc(0);
 }
 
 
@@ -3121,6 +3285,13 @@ render_manager::render_manager(running_machine &machine)
 
 render_manager::~render_manager()
 {
+	// the render thread may still be using targets and textures
+	if (m_prepare_queue)
+	{
+		wait_primitives();
+		osd_work_queue_free(m_prepare_queue);
+	}
+
 	// free all the containers since they may own textures
 	m_ui_container.reset();
 	m_screen_container_list.clear();
@@ -3194,7 +3365,10 @@ render_target *render_manager::target_alloc(util::xml::data_node const &layout,
 void render_manager::target_free(render_target *target)
 {
 	if (target != nullptr)
+	{
+		wait_primitives();
 		m_targetlist.remove(*target);
+	}
 }
 
 
@@ -3289,6 +3463,7 @@ void render_manager::texture_free(render_texture *texture)
 {
 	if (texture != nullptr)
 	{
+		wait_primitives();
 		m_live_textures--;
 		texture->release();
 	}
@@ -3323,6 +3498,66 @@ void render_manager::invalidate_all(void *refptr)
 }
 
 
+//-------------------------------------------------
+//  prepare_primitives - start building primitive
+//  lists for all visible targets on the render
+//  thread, so the OSD can pick them up with the
+//  next get_primitives while emulation continues
+//-------------------------------------------------
+
+void render_manager::prepare_primitives()
+{
+	if (!m_prepare_queue)
+		return;
+
+	// item state is sampled here, the rest happens on the render thread
+	wait_primitives();
+	for (render_target &target : m_targetlist)
+	{
+		target.m_prepared = nullptr;
+		target.m_prepare_pending = !target.hidden() && (target.m_width > 0) && (target.m_height > 0);
+		if (target.m_prepare_pending)
+			target.snapshot_items();
+	}
+	osd_work_item_queue(m_prepare_queue, &render_manager::prepare_callback, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+}
+
+
+//-------------------------------------------------
+//  wait_primitives - wait for the render thread
+//  to finish building primitive lists
+//-------------------------------------------------
+
+void render_manager::wait_primitives()
+{
+	if (m_prepare_queue)
+		osd_work_queue_wait(m_prepare_queue, osd_ticks_per_second() * 10);
+}
+
+
+//-------------------------------------------------
+//  prepare_callback - build primitive lists on
+//  the render thread
+//-------------------------------------------------
+
+void *render_manager::prepare_callback(void *param, int threadid)
+{
+	render_manager &manager = *reinterpret_cast<render_manager *>(param);
+	for (render_target &target : manager.m_targetlist)
+	{
+		if (target.m_prepare_pending)
+		{
+			target.m_prepare_pending = false;
+			target.m_prepared_width = target.m_width;
+			target.m_prepared_height = target.m_height;
+			target.m_prepared_orientation = target.m_orientation;
+			target.m_prepared = &target.build_primitives();
+		}
+	}
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  resolve_tags - resolve tag lookups
 //-------------------------------------------------
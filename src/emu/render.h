@@ -56,6 +56,9 @@
 #include <vector>
 
 
+struct osd_work_queue;
+
+
 //**************************************************************************
 //  CONSTANTS
 //**************************************************************************
@@ -159,6 +162,8 @@ struct render_texinfo
 	u32                 width;              // width of the image
 	u32                 height;             // height of the image
 	u32                 seqid;              // sequence ID
+	u32                 damage_seqid;       // sequence ID the damaged area is relative to, 0 if everything changed
+	rectangle           damage;             // area changed since damage_seqid, relative to base
 	u64                 unique_id;          // unique identifier to pass to osd
 	u64                 old_id;             // previously allocated id, if applicable
 	const rgb_t *       palette;            // palette for PALETTE16 textures, bcg lookup table for RGB32/YUY16
@@ -280,21 +285,12 @@ private:
 	void append(render_primitive &prim) { append_or_return(prim, false); }
 	void append_or_return(render_primitive &prim, bool clipped);
 
-	// a reference is an abstract reference to an internal object of some sort
-	class reference
-	{
-	public:
-		reference *next() const { return m_next; }
-		reference *         m_next;             // link to the next reference
-		void *              m_refptr;           // reference pointer
-	};
-
 	// internal state
 	simple_list<render_primitive> m_primlist;               // list of primitives
-	simple_list<reference> m_reflist;                       // list of references
+	mutable std::vector<void *> m_references;               // abstract references to internal objects
+	mutable bool            m_references_sorted;            // references are sorted and unique
 
-	fixed_allocator<render_primitive> m_primitive_allocator;// allocator for primitives
-	fixed_allocator<reference> m_reference_allocator;       // allocator for references
+	block_allocator<render_primitive> m_primitive_allocator;// allocator for primitives
 
 	std::recursive_mutex     m_lock;                             // lock to protect list accesses
 };
@@ -325,12 +321,15 @@ public:
 	int format() const { return m_format; }
 	render_manager *manager() const { return m_manager; }
 
-	// configure the texture bitmap
-	void set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, texture_format format);
+	// configure the texture bitmap; damage optionally limits what changed since the last call
+	void set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, texture_format format, const rectangle *damage = nullptr);
 
 	// set a unique identifier
 	void set_id(u64 id) { m_old_id = m_id; m_id = id; }
 
+	// only report new contents to the OSD when set_bitmap is called
+	void set_explicit_updates(bool explicit_updates) { m_explicit_updates = explicit_updates; }
+
 	// generic high-quality bitmap scaler
 	static void hq_scale(bitmap_argb32 &dest, bitmap_argb32 &source, const rectangle &sbounds, void *param);
 
@@ -346,6 +345,7 @@ private:
 	{
 		std::unique_ptr<bitmap_argb32>  bitmap;     // final bitmap
 		u32                             seqid;      // sequence number
+		u32                             lastuse;    // use counter value when last requested
 	};
 
 	// internal state
@@ -356,11 +356,18 @@ private:
 	texture_format      m_format;                   // format of the texture data
 	u64                 m_id;                       // unique id to pass to osd
 	u64                 m_old_id;                   // previous id, if applicable
+	bool                m_explicit_updates;         // contents only change through set_bitmap
+	u32                 m_bitmap_seqid;             // sequence number of the last set_bitmap
+	const rgb_t *       m_palette;                  // adjusted palette the contents were last reported with
+	u32                 m_palette_seqid;            // sequence number of that palette
+	u32                 m_damage_seqid;             // sequence number m_damage is relative to, 0 if none
+	rectangle           m_damage;                   // area changed by the last set_bitmap, relative to m_sbounds
 
 	// scaling state (ARGB32 only)
 	texture_scaler_func m_scaler;                   // scaling callback
 	void *              m_param;                    // scaling callback parameter
 	u32                 m_curseq;                   // current sequence number
+	u32                 m_curuse;                   // current use counter
 	scaled_texture      m_scaled[MAX_TEXTURE_SCALES];// array of scaled variants of this texture
 };
 
@@ -405,6 +412,7 @@ public:
 	float xoffset() const { return m_user.m_xoffset; }
 	float yoffset() const { return m_user.m_yoffset; }
 	bool is_empty() const { return m_itemlist.empty(); }
+	u32 generation() const { return m_generation; }
 	const user_settings &get_user_settings() const { return m_user; }
 
 	// setters
@@ -412,7 +420,7 @@ public:
 	void set_user_settings(const user_settings &settings);
 
 	// empty the item list
-	void empty() { m_item_allocator.reclaim_all(m_itemlist); }
+	void empty() { m_item_allocator.reclaim_all(m_itemlist); m_generation++; }
 
 	// add items to the list
 	void add_line(float x0, float y0, float x1, float y1, float width, rgb_t argb, u32 flags);
@@ -446,6 +454,7 @@ private:
 		u32 internal() const { return m_internal; }
 		float width() const { return m_width; }
 		render_texture *texture() const { return m_texture; }
+		const render_bounds &texbounds() const { return m_texbounds; }
 
 	private:
 		// internal state
@@ -457,6 +466,7 @@ private:
 		u32                 m_internal;         // internal flags
 		float               m_width;            // width of the line (lines only)
 		render_texture *    m_texture;          // pointer to the source texture (quads only)
+		render_bounds       m_texbounds;        // normalised part of the texture to draw (quads only)
 	};
 
 	// generic screen overlay scaler
@@ -471,7 +481,7 @@ private:
 	// internal state
 	render_manager &        m_manager;              // reference back to the owning manager
 	simple_list<item>       m_itemlist;             // head of the item list
-	fixed_allocator<item>   m_item_allocator;       // free container items
+	block_allocator<item>   m_item_allocator;       // free container items
 	screen_device *         m_screen;               // the screen device
 	user_settings           m_user;                 // user settings
 	bitmap_argb32 *         m_overlaybitmap;        // overlay bitmap
@@ -479,6 +489,8 @@ private:
 	std::unique_ptr<palette_client> m_palclient;    // client to the screen palette
 	std::vector<rgb_t>      m_bcglookup;            // copy of screen palette with bcg adjustment
 	rgb_t                   m_bcglookup256[0x400];  // lookup table for brightness/contrast/gamma
+	u32                     m_palette_seqid;        // bumped whenever the adjusted palette changes
+	u32                     m_generation;           // bumped whenever the item list is emptied
 };
 
 
@@ -564,6 +576,16 @@ private:
 	// private classes declared in render.cpp
 	struct object_transform;
 
+	// item values sampled on the emulation thread before building primitives
+	struct item_state
+	{
+		render_bounds   bounds;
+		render_color    color;
+		int             state;
+		float           scroll_size_x, scroll_size_y;
+		float           scroll_pos_x, scroll_pos_y;
+	};
+
 	// internal helpers
 	enum constructor_impl_t { CONSTRUCTOR_IMPL };
 	template <typename T> render_target(render_manager &manager, T&& layout, u32 flags, constructor_impl_t);
@@ -575,7 +597,9 @@ private:
 	bool load_layout_file(const char *dirname, const internal_layout &layout_data, device_t *device = nullptr);
 	bool load_layout_file(device_t &device, util::xml::data_node const &rootnode, const char *searchpath, const char *dirname);
 	void add_container_primitives(render_primitive_list &list, const object_transform &root_xform, const object_transform &xform, render_container &container, int blendmode);
-	void add_element_primitives(render_primitive_list &list, const object_transform &xform, layout_view_item &item);
+	void add_element_primitives(render_primitive_list &list, const object_transform &xform, layout_view_item &item, const item_state &state);
+	void snapshot_items();
+	render_primitive_list &build_primitives();
 	std::pair<float, float> map_point_internal(s32 target_x, s32 target_y);
 
 	// config callbacks
@@ -605,6 +629,12 @@ private:
 	u32                     m_flags;                    // creation flags
 	render_primitive_list   m_primlist[NUM_PRIMLISTS];  // list of primitives
 	int                     m_listindex;                // index of next primlist to use
+	std::vector<item_state> m_item_states;              // sampled state of the visible items
+	render_primitive_list * m_prepared;                 // list built ahead by the render thread, or nullptr
+	s32                     m_prepared_width;           // width the prepared list was built for
+	s32                     m_prepared_height;          // height the prepared list was built for
+	int                     m_prepared_orientation;     // orientation the prepared list was built for
+	bool                    m_prepare_pending;          // list should be built by the render thread
 	s32                     m_width;                    // width in pixels
 	s32                     m_height;                   // height in pixels
 	render_bounds           m_bounds;                   // bounds of the target
@@ -679,7 +709,13 @@ public:
 	// resolve tag lookups
 	void resolve_tags();
 
+	// render thread
+	void prepare_primitives();
+	void wait_primitives();
+
 private:
+	static void *prepare_callback(void *param, int threadid);
+
 	// config callbacks
 	void config_load(config_type cfg_type, config_level cfg_lvl, util::xml::data_node const *parentnode);
 	void config_save(config_type cfg_type, util::xml::data_node *parentnode);
@@ -690,6 +726,7 @@ private:
 	// array of live targets
 	simple_list<render_target>      m_targetlist;       // list of targets
 	render_target *                 m_ui_target;        // current UI target
+	osd_work_queue *                m_prepare_queue;    // queue for building primitive lists ahead, or nullptr
 
 	// texture lists
 	u32                             m_live_textures;    // number of live textures
@@ -14,6 +14,16 @@
 #include "video/rgbutil.h"
 #include "render.h"
 
+#include <algorithm>
+
+#if (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && (defined(__SSE2__) || defined(_M_X64))
+#define MAME_RENDERSW_SSE2
+#include <emmintrin.h>
+#elif (!defined(MAME_DEBUG) || defined(__OPTIMIZE__)) && defined(__aarch64__) && defined(__ARM_NEON)
+#define MAME_RENDERSW_NEON
+#include <arm_neon.h>
+#endif
+
 
 template <typename PixelType, int SrcShiftR, int SrcShiftG, int SrcShiftB, int DstShiftR, int DstShiftG, int DstShiftB, bool NoDestRead = false, bool BilinearFilter = false>
 class software_renderer
@@ -657,6 +667,161 @@ private:
 	//  16-BIT PALETTE RASTERIZERS
 	//**************************************************************************
 
+	//-------------------------------------------------
+	//  use_rows - axis-aligned quads without
+	//  filtering read each destination row from a
+	//  single texture row, so source row lookup and
+	//  clamping only need to be done once per row
+	//-------------------------------------------------
+
+	static constexpr bool is_standard_dest()
+	{
+		return (sizeof(PixelType) == 4) && (SrcShiftR == 0) && (SrcShiftG == 0) && (SrcShiftB == 0) && (DstShiftR == 16) && (DstShiftG == 8) && (DstShiftB == 0);
+	}
+
+	static inline bool use_rows(quad_setup_data const &setup)
+	{
+		return !BilinearFilter && (setup.dvdx == 0);
+	}
+
+
+	//-------------------------------------------------
+	//  draw_row_palette16 - copy a row of a 16bpp
+	//  palettized texture
+	//-------------------------------------------------
+
+	static void draw_row_palette16(render_texinfo const &texture, PixelType *dest, s32 count, s32 curu, s32 curv, s32 dudx)
+	{
+		rgb_t const *const palbase = texture.palette;
+		u16 const *const rowbase = reinterpret_cast<u16 const *>(texture.base) + (curv >> 16) * texture.rowpixels;
+		for (s32 x = 0; x < count; x++, curu += dudx)
+			dest[x] = source32_to_dest(palbase[rowbase[curu >> 16]]);
+	}
+
+
+	//-------------------------------------------------
+	//  draw_row_rgb32 - copy a row of a 32bpp RGB
+	//  texture without wrapping
+	//-------------------------------------------------
+
+	static void draw_row_rgb32(render_texinfo const &texture, PixelType *dest, s32 count, s32 curu, s32 curv, s32 dudx)
+	{
+		u32 const *const rowbase = reinterpret_cast<u32 const *>(texture.base) + std::clamp<s32>(curv >> 16, 0, texture.height - 1) * texture.rowpixels;
+		s32 const maxu = texture.width - 1;
+
+		// unscaled rows entirely within the texture are a straight copy
+		if (is_standard_dest() && (dudx == 0x10000) && ((curu >> 16) >= 0) && (((curu >> 16) + count - 1) <= maxu))
+		{
+			std::copy_n(&rowbase[curu >> 16], count, dest);
+			return;
+		}
+
+		for (s32 x = 0; x < count; x++, curu += dudx)
+			dest[x] = source32_to_dest(rowbase[std::clamp<s32>(curu >> 16, 0, maxu)]);
+	}
+
+
+	//-------------------------------------------------
+	//  blend4_argb32 - alpha blend four ARGB source
+	//  pixels over four standard format destination
+	//  pixels
+	//-------------------------------------------------
+
+#if defined(MAME_RENDERSW_SSE2)
+	static inline void blend4_argb32(u32 *dest, u32 const *src)
+	{
+		__m128i const zero = _mm_setzero_si128();
+		__m128i const s = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src));
+		__m128i const d = _mm_loadu_si128(reinterpret_cast<__m128i const *>(dest));
+
+		// spread each pixel's alpha over its four 16-bit channels
+		__m128i const a32 = _mm_srli_epi32(s, 24);
+		__m128i const a16 = _mm_or_si128(a32, _mm_slli_epi32(a32, 16));
+		__m128i const alo = _mm_unpacklo_epi32(a16, a16);
+		__m128i const ahi = _mm_unpackhi_epi32(a16, a16);
+		__m128i const inv = _mm_set1_epi16(0x100);
+
+		// (s * a + d * (0x100 - a)) >> 8 never exceeds 16 bits
+		__m128i const lo = _mm_srli_epi16(_mm_add_epi16(
+				_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), alo),
+				_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(inv, alo))), 8);
+		__m128i const hi = _mm_srli_epi16(_mm_add_epi16(
+				_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), ahi),
+				_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(inv, ahi))), 8);
+		__m128i const blended = _mm_and_si128(_mm_packus_epi16(lo, hi), _mm_set1_epi32(0x00ffffff));
+
+		// fully transparent source pixels leave the destination untouched
+		__m128i const keep = _mm_cmpeq_epi32(a32, zero);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, blended)));
+	}
+#elif defined(MAME_RENDERSW_NEON)
+	static inline void blend4_argb32(u32 *dest, u32 const *src)
+	{
+		uint32x4_t const s32 = vld1q_u32(src);
+		uint32x4_t const d32 = vld1q_u32(dest);
+		uint8x16_t const s = vreinterpretq_u8_u32(s32);
+		uint8x16_t const d = vreinterpretq_u8_u32(d32);
+
+		// spread each pixel's alpha over its four channels
+		uint32x4_t const a32 = vshrq_n_u32(s32, 24);
+		uint8x16_t const a8 = vreinterpretq_u8_u32(vmulq_n_u32(a32, 0x01010101));
+		uint16x8_t const alo = vmovl_u8(vget_low_u8(a8));
+		uint16x8_t const ahi = vmovl_u8(vget_high_u8(a8));
+		uint16x8_t const inv = vdupq_n_u16(0x100);
+
+		// (s * a + d * (0x100 - a)) >> 8 never exceeds 16 bits
+		uint16x8_t const lo = vshrq_n_u16(vmlaq_u16(vmulq_u16(vmovl_u8(vget_low_u8(s)), alo), vmovl_u8(vget_low_u8(d)), vsubq_u16(inv, alo)), 8);
+		uint16x8_t const hi = vshrq_n_u16(vmlaq_u16(vmulq_u16(vmovl_u8(vget_high_u8(s)), ahi), vmovl_u8(vget_high_u8(d)), vsubq_u16(inv, ahi)), 8);
+		uint32x4_t const blended = vandq_u32(vreinterpretq_u32_u8(vcombine_u8(vmovn_u16(lo), vmovn_u16(hi))), vdupq_n_u32(0x00ffffff));
+
+		// fully transparent source pixels leave the destination untouched
+		vst1q_u32(dest, vbslq_u32(vceqq_u32(a32, vdupq_n_u32(0)), d32, blended));
+	}
+#endif
+
+
+	//-------------------------------------------------
+	//  draw_row_argb32_alpha - alpha blend a row of a
+	//  32bpp ARGB texture without wrapping
+	//-------------------------------------------------
+
+	static void draw_row_argb32_alpha(render_texinfo const &texture, PixelType *dest, s32 count, s32 curu, s32 curv, s32 dudx)
+	{
+		u32 const *const rowbase = reinterpret_cast<u32 const *>(texture.base) + std::clamp<s32>(curv >> 16, 0, texture.height - 1) * texture.rowpixels;
+		s32 const maxu = texture.width - 1;
+		s32 x = 0;
+
+#if defined(MAME_RENDERSW_SSE2) || defined(MAME_RENDERSW_NEON)
+		if constexpr (is_standard_dest() && !NoDestRead)
+		{
+			for ( ; (x + 4) <= count; x += 4)
+			{
+				u32 src[4];
+				for (int i = 0; i < 4; i++, curu += dudx)
+					src[i] = rowbase[std::clamp<s32>(curu >> 16, 0, maxu)];
+				blend4_argb32(reinterpret_cast<u32 *>(&dest[x]), src);
+			}
+		}
+#endif
+
+		for ( ; x < count; x++, curu += dudx)
+		{
+			u32 const pix = rowbase[std::clamp<s32>(curu >> 16, 0, maxu)];
+			u32 const ta = pix >> 24;
+			if (ta != 0)
+			{
+				u32 const dpix = NoDestRead ? 0 : dest[x];
+				u32 const invta = 0x100 - ta;
+				u32 const r = (source32_r(pix) * ta + dest_r(dpix) * invta) >> 8;
+				u32 const g = (source32_g(pix) * ta + dest_g(dpix) * invta) >> 8;
+				u32 const b = (source32_b(pix) * ta + dest_b(dpix) * invta) >> 8;
+
+				dest[x] = dest_assemble_rgb(r, g, b);
+			}
+		}
+	}
+
+
 	//-------------------------------------------------
 	//  draw_quad_palette16_none - perform
 	//  rasterization of a 16bpp palettized texture
@@ -678,6 +843,12 @@ private:
 				s32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
+				if (use_rows(setup))
+				{
+					draw_row_palette16(prim.texture, dest, setup.endx - setup.startx, curu, curv, setup.dudx);
+					continue;
+				}
+
 				// loop over cols
 				for (s32 x = setup.startx; x < setup.endx; x++)
 				{
@@ -1033,7 +1204,12 @@ private:
 				s32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
-				if (!palbase)
+				if (!palbase && !Wrap && use_rows(setup))
+				{
+					// axis-aligned no lookup case
+					draw_row_rgb32(prim.texture, dest, setup.endx - setup.startx, curu, curv, setup.dudx);
+				}
+				else if (!palbase)
 				{
 					// no lookup case
 
@@ -1449,7 +1625,12 @@ private:
 				s32 curu = setup.startu + (y - setup.starty) * setup.dudy;
 				s32 curv = setup.startv + (y - setup.starty) * setup.dvdy;
 
-				if (!palbase)
+				if (!palbase && !Wrap && use_rows(setup))
+				{
+					// axis-aligned no lookup case
+					draw_row_argb32_alpha(prim.texture, dest, setup.endx - setup.startx, curu, curv, setup.dudx);
+				}
+				else if (!palbase)
 				{
 					// no lookup case
 
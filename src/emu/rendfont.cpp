@@ -612,6 +612,10 @@ render_font::render_font(render_manager &manager, const char *filename)
 
 render_font::~render_font()
 {
+	// free the atlas textures
+	for (auto &atlas : m_atlases)
+		free_atlas(*atlas);
+
 	// free all the subtables
 	for (auto & elem : m_glyphs)
 		if (elem)
@@ -806,6 +810,160 @@ render_texture *render_font::get_char_texture_and_bounds(float height, float asp
 }
 
 
+//-------------------------------------------------
+//  get_char_atlas_texture_and_bounds - return the
+//  atlas page holding a character rasterised for
+//  a target of the given size, and compute the
+//  bounds of the character and the part of the
+//  page it occupies; returns nullptr if the
+//  character can't be drawn from an atlas
+//-------------------------------------------------
+
+render_texture *render_font::get_char_atlas_texture_and_bounds(float height, float aspect, char32_t chnum, s32 targetwidth, s32 targetheight, render_bounds &bounds, render_bounds &texbounds)
+{
+	// rasters are cached by the size of a character cell in target pixels
+	s32 const cellheight = s32(height * float(targetheight) + 0.5f);
+	s32 const emwidth = s32(height * aspect * float(targetwidth) + 0.5f);
+	if ((0 >= cellheight) || (0 >= emwidth) || ((ATLAS_PAGE_SIZE - (2 * ATLAS_PADDING)) < cellheight))
+		return nullptr;
+
+	glyph &gl = get_char(chnum);
+	if (!gl.texture)
+		return nullptr;
+
+	glyph_atlas &atlas = *find_atlas(cellheight, emwidth);
+	glyph_atlas::entry const &entry = atlas_entry(atlas, chnum, gl);
+	if (0 > entry.page)
+		return nullptr;
+
+	// the character occupies the same bounds as it does with its own texture
+	float scale = m_scale * height;
+	bounds.x0 += float(gl.xoffs) * scale * aspect;
+	bounds.x1 = bounds.x0 + float(gl.bmwidth) * scale * aspect;
+	bounds.y1 = bounds.y0 + float(m_height) * scale;
+
+	float const texscale = 1.0f / float(ATLAS_PAGE_SIZE);
+	texbounds.set_xy(
+			float(entry.rect.left()) * texscale,
+			float(entry.rect.top()) * texscale,
+			float(entry.rect.right() + 1) * texscale,
+			float(entry.rect.bottom() + 1) * texscale);
+	return atlas.pages[entry.page]->texture;
+}
+
+
+//-------------------------------------------------
+//  find_atlas - find or create the atlas for a
+//  pixel size, freeing the least recently used
+//  ones beyond the limit
+//-------------------------------------------------
+
+render_font::glyph_atlas *render_font::find_atlas(s32 cellheight, s32 emwidth)
+{
+	u32 const generation = m_manager.ui_container().generation();
+	auto const found = std::find_if(
+			m_atlases.begin(),
+			m_atlases.end(),
+			[cellheight, emwidth] (std::unique_ptr<glyph_atlas> const &atlas) { return (atlas->cellheight == cellheight) && (atlas->emwidth == emwidth); });
+	if (m_atlases.end() != found)
+	{
+		std::rotate(m_atlases.begin(), found, std::next(found));
+	}
+	else
+	{
+		// an atlas used since the UI container was last emptied may still be referenced by its items
+		for (auto it = m_atlases.end(); (MAX_ATLASES <= m_atlases.size()) && (m_atlases.begin() != it); )
+		{
+			--it;
+			if ((*it)->stamp != generation)
+			{
+				free_atlas(**it);
+				it = m_atlases.erase(it);
+			}
+		}
+		m_atlases.emplace(m_atlases.begin(), std::make_unique<glyph_atlas>(cellheight, emwidth));
+	}
+	m_atlases.front()->stamp = generation;
+	return m_atlases.front().get();
+}
+
+
+//-------------------------------------------------
+//  atlas_entry - find a character in an atlas,
+//  rasterising it into a page the first time
+//-------------------------------------------------
+
+render_font::glyph_atlas::entry const &render_font::atlas_entry(glyph_atlas &atlas, char32_t chnum, glyph &gl)
+{
+	auto const found = atlas.entries.emplace(chnum, glyph_atlas::entry());
+	glyph_atlas::entry &entry = found.first->second;
+	if (!found.second)
+		return entry;
+
+	s32 const width = s32(float(gl.bmwidth * atlas.emwidth) * m_scale + 0.5f);
+	s32 const height = atlas.cellheight;
+	if ((ATLAS_PAGE_SIZE - (2 * ATLAS_PADDING)) < width)
+		return entry;
+
+	// start a new shelf or a new page if the current one is full
+	glyph_atlas::page *page = atlas.pages.empty() ? nullptr : atlas.pages.back().get();
+	if (page && (0 < width))
+	{
+		if ((page->x + width + ATLAS_PADDING) > ATLAS_PAGE_SIZE)
+		{
+			page->x = ATLAS_PADDING;
+			page->y += page->shelf + ATLAS_PADDING;
+			page->shelf = 0;
+		}
+		if ((page->y + height + ATLAS_PADDING) > ATLAS_PAGE_SIZE)
+			page = nullptr;
+	}
+	if (!page)
+	{
+		if (MAX_ATLAS_PAGES <= atlas.pages.size())
+			return entry;
+		page = atlas.pages.emplace_back(std::make_unique<glyph_atlas::page>()).get();
+		page->bitmap.allocate(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+		page->bitmap.fill(0);
+		page->texture = m_manager.texture_alloc();
+		page->texture->set_explicit_updates(true);
+		page->texture->set_bitmap(page->bitmap, page->bitmap.cliprect(), TEXFORMAT_ARGB32);
+		page->x = ATLAS_PADDING;
+		page->y = ATLAS_PADDING;
+	}
+	entry.page = atlas.pages.size() - 1;
+
+	// characters with nothing to draw point at the transparent corner of the page
+	if (0 >= width)
+	{
+		entry.rect.set(0, 0, 0, 0);
+		return entry;
+	}
+
+	// scale the character into place and let the OSD know which part changed
+	entry.rect.set(page->x, page->x + width - 1, page->y, page->y + height - 1);
+	bitmap_argb32 dest(&page->bitmap.pix(page->y, page->x), width, height, page->bitmap.rowpixels());
+	render_texture::hq_scale(dest, gl.bitmap, gl.bitmap.cliprect(), nullptr);
+	page->x += width + ATLAS_PADDING;
+	page->shelf = std::max(page->shelf, height);
+	page->texture->set_bitmap(page->bitmap, page->bitmap.cliprect(), TEXFORMAT_ARGB32, &entry.rect);
+	return entry;
+}
+
+
+//-------------------------------------------------
+//  free_atlas - release the textures of an atlas
+//-------------------------------------------------
+
+void render_font::free_atlas(glyph_atlas &atlas)
+{
+	for (auto &page : atlas.pages)
+		m_manager.texture_free(page->texture);
+	atlas.pages.clear();
+	atlas.entries.clear();
+}
+
+
 //-------------------------------------------------
 //  get_scaled_bitmap_and_bounds - return a
 //  scaled bitmap and bounding rect for a char
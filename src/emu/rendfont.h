@@ -13,6 +13,10 @@
 
 #include "render.h"
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
@@ -42,6 +46,7 @@ public:
 
 	// texture/bitmap queries
 	render_texture *get_char_texture_and_bounds(float height, float aspect, char32_t ch, render_bounds &bounds);
+	render_texture *get_char_atlas_texture_and_bounds(float height, float aspect, char32_t ch, s32 targetwidth, s32 targetheight, render_bounds &bounds, render_bounds &texbounds);
 	void get_scaled_bitmap_and_bounds(bitmap_argb32 &dest, float height, float aspect, char32_t chnum, rectangle &bounds);
 
 private:
@@ -70,6 +75,34 @@ private:
 		rgb_t               color;
 	};
 
+	// glyphs rasterised at one pixel size and packed into shared pages
+	class glyph_atlas
+	{
+	public:
+		struct page
+		{
+			bitmap_argb32       bitmap;             // packed glyph rasters
+			render_texture *    texture = nullptr;  // texture wrapped around the bitmap
+			s32                 x = 0;              // next free column on the current shelf
+			s32                 y = 0;              // top of the current shelf
+			s32                 shelf = 0;          // height of the current shelf
+		};
+
+		struct entry
+		{
+			s32                 page = -1;          // page holding the raster (-1 = could not be placed)
+			rectangle           rect;               // location within the page
+		};
+
+		glyph_atlas(s32 cellheight, s32 emwidth) : cellheight(cellheight), emwidth(emwidth), stamp(0) { }
+
+		s32                 cellheight;         // height of a character cell in pixels
+		s32                 emwidth;            // width of one font height in pixels
+		u32                 stamp;              // UI container generation it was last used in
+		std::vector<std::unique_ptr<page> > pages;
+		std::unordered_map<char32_t, entry> entries;
+	};
+
 	// internal format
 	enum class format
 	{
@@ -82,6 +115,9 @@ private:
 	// helpers
 	glyph &get_char(char32_t chnum);
 	void char_expand(char32_t chnum, glyph &ch);
+	glyph_atlas *find_atlas(s32 cellheight, s32 emwidth);
+	glyph_atlas::entry const &atlas_entry(glyph_atlas &atlas, char32_t chnum, glyph &gl);
+	void free_atlas(glyph_atlas &atlas);
 	bool load_cached_bdf(std::string_view filename);
 	bool load_bdf();
 	bool load_cached(util::random_read &file, u64 length, u32 hash);
@@ -106,8 +142,14 @@ private:
 	EQUIVALENT_ARRAY(m_glyphs, glyph *) m_glyphs_cmd; // array of glyph subtables
 	std::vector<char>   m_rawdata_cmd;      // pointer to the raw data for the font
 
+	std::vector<std::unique_ptr<glyph_atlas> > m_atlases; // atlases by pixel size, most recently used first
+
 	// constants
 	static const u64 CACHED_BDF_HASH_SIZE   = 1024;
+	static constexpr s32 ATLAS_PAGE_SIZE    = 512;  // width and height of an atlas page
+	static constexpr s32 ATLAS_PADDING      = 1;    // empty pixels around each raster so filtering doesn't bleed
+	static constexpr size_t MAX_ATLAS_PAGES = 8;    // pages per pixel size before falling back to glyph textures
+	static constexpr size_t MAX_ATLASES     = 4;    // pixel sizes kept before the least recently used is freed
 };
 
 std::string convert_command_glyph(std::string_view str);
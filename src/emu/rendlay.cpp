@@ -1696,13 +1696,28 @@ public:
 protected:
 	virtual void draw_aligned(running_machine &machine, bitmap_argb32 &dest, rectangle const &bounds, int state) override
 	{
+		// a reduced copy is only good for sizes up to the largest drawn before
+		m_drawwidth = (std::max)(m_drawwidth, bounds.width());
+		m_drawheight = (std::max)(m_drawheight, bounds.height());
+		if (m_reduced && ((m_bitmap.width() < m_drawwidth) || (m_bitmap.height() < m_drawheight)))
+		{
+			LOGMASKED(LOG_IMAGE_LOAD, "Image component reloading image to draw at %dx%d\n", m_drawwidth, m_drawheight);
+			m_bitmap.reset();
+			m_reduced = false;
+		}
+
 		if (!m_bitmap.valid() && !m_svg)
 			load_image(machine);
 
 		if (m_bitmap.valid())
+		{
 			draw_bitmap(dest, bounds, state);
+			reduce_bitmap();
+		}
 		else if (m_svg)
+		{
 			draw_svg(dest, bounds, state);
+		}
 	}
 
 private:
@@ -1723,6 +1738,21 @@ private:
 		}
 	}
 
+	void reduce_bitmap()
+	{
+		// large artwork is usually drawn far smaller than its native size, so
+		// keep a copy at the largest size needed so far if that saves a lot of
+		// memory - it can always be loaded again if a bigger size is needed
+		if (!m_reduced && (!m_imagefile.empty() || !m_data.empty()) && ((u64(m_bitmap.width()) * m_bitmap.height()) > (u64(m_drawwidth) * m_drawheight * 4)))
+		{
+			LOGMASKED(LOG_IMAGE_LOAD, "Image component reducing %dx%d image to %dx%d\n", m_bitmap.width(), m_bitmap.height(), m_drawwidth, m_drawheight);
+			bitmap_argb32 reduced(m_drawwidth, m_drawheight);
+			render_resample_argb_bitmap_hq(reduced, m_bitmap, render_color{ 1.0F, 1.0F, 1.0F, 1.0F });
+			m_bitmap = std::move(reduced);
+			m_reduced = true;
+		}
+	}
+
 	void draw_svg(bitmap_argb32 &dest, rectangle const &bounds, int state)
 	{
 		// rasterise into a temporary bitmap
@@ -1899,14 +1929,20 @@ private:
 				osd_printf_warning("Unable to load component image '%s'/'%s'\n", m_imagefile, m_alphafile);
 		}
 
-		// clear out this stuff in case it's large
+		// clear out this stuff in case it's large - keep what's needed to
+		// load a bitmap image again after reducing it
 		if (!m_svg)
+		{
 			m_rasterizer.reset();
-		m_searchpath.clear();
-		m_dirname.clear();
-		m_imagefile.clear();
-		m_alphafile.clear();
-		m_data.clear();
+		}
+		else
+		{
+			m_searchpath.clear();
+			m_dirname.clear();
+			m_imagefile.clear();
+			m_alphafile.clear();
+			m_data.clear();
+		}
 	}
 
 	void load_image_data()
@@ -1920,7 +1956,7 @@ private:
 				"\t\n\v\f\r =";
 		std::string::size_type const tail(m_data.find_first_not_of(base64chars));
 		std::string::size_type const end(m_data.find_first_not_of(base64tail, tail));
-		if (std::string::npos == end)
+		if (!m_datadecoded && (std::string::npos == end))
 		{
 			LOGMASKED(LOG_IMAGE_LOAD, "Image component decoding Base64 image data\n");
 			char *dst(&m_data[0]);
@@ -1952,6 +1988,7 @@ private:
 			}
 			m_data.resize(dst - &m_data[0]);
 		}
+		m_datadecoded = true;
 
 		// make a file wrapper for the data and see if it looks like a bitmap
 		util::core_file::ptr file;
@@ -2077,6 +2114,9 @@ private:
 	std::shared_ptr<NSVGrasterizer> m_rasterizer;       // SVG rasteriser
 	bitmap_argb32                   m_bitmap;           // source bitmap for images
 	bool                            m_hasalpha = false; // is there any alpha component present?
+	bool                            m_reduced = false;  // is the bitmap a reduced copy of the image?
+	s32                             m_drawwidth = 0;    // largest width drawn at
+	s32                             m_drawheight = 0;   // largest height drawn at
 
 	// cold state
 	std::string                     m_searchpath;       // asset search path (for lazy loading)
@@ -2084,6 +2124,7 @@ private:
 	std::string                     m_imagefile;        // name of the image file (for lazy loading)
 	std::string                     m_alphafile;        // name of the alpha file (for lazy loading)
 	std::string                     m_data;             // embedded image data
+	bool                            m_datadecoded = false; // has Base64 decoding been done in place?
 };
 
 
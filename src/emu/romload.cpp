@@ -17,10 +17,17 @@
 #include "softlist_dev.h"
 #include "ui/uimain.h"
 
+#include "../osd/modules/lib/osdlib.h"
+
 #include "corestr.h"
+#include "hashing.h"
+#include "path.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdarg>
+#include <cstdio>
+#include <deque>
 #include <set>
 
 
@@ -34,6 +41,12 @@
 
 #define TEMPBUFFER_MAX_SIZE     (1024 * 1024 * 1024)
 
+// number of ROM files to locate and decompress ahead of the one being loaded
+#define PREFETCH_DEPTH          8
+
+// number of pieces to split derived data into when computing it
+#define DERIVE_CHUNKS           64
+
 /***************************************************************************
     HELPERS
 ****************************************************************************/
@@ -635,36 +648,76 @@ void rom_load_manager::region_post_process(memory_region *region, bool invert)
 
 
 /*-------------------------------------------------
-    open_rom_file - open a ROM file, searching
-    up the parent and loading by checksum
+    rom_prefetch - queue a ROM to be located,
+    decompressed and hashed ahead of time
 -------------------------------------------------*/
 
-std::unique_ptr<emu_file> rom_load_manager::open_rom_file(std::initializer_list<std::reference_wrapper<const std::vector<std::string> > > searchpath, const rom_entry *romp, std::vector<std::string> &tried_file_names, bool from_list)
+rom_load_manager::rom_prefetch::rom_prefetch(rom_load_manager &manager, const search_path_list &searchpath, const rom_entry *romp)
+	: m_manager(manager)
+	, m_searchpath(searchpath)
+	, m_romp(romp)
+	, m_item(nullptr)
+	, m_filerr(std::errc::no_such_file_or_directory)
 {
-	std::error_condition filerr = std::errc::no_such_file_or_directory;
-	u32 const romsize = rom_file_size(romp);
-	tried_file_names.clear();
+	if (manager.m_prefetch_queue)
+		m_item = osd_work_item_queue(manager.m_prefetch_queue, &rom_load_manager::prefetch_rom, this, 0);
+	if (!m_item)
+		prefetch_rom(this, 0);
+}
 
-	// update status display
-	display_loading_rom_message(ROM_GETNAME(romp), from_list);
+
+rom_load_manager::rom_prefetch::~rom_prefetch()
+{
+	// the worker refers to the search path, so it must finish even if loading was aborted
+	if (m_item)
+	{
+		while (!osd_work_item_wait(m_item, osd_ticks_per_second() * 100)) { }
+		osd_work_item_release(m_item);
+	}
+}
+
+
+/*-------------------------------------------------
+    prefetch_rom - worker callback to locate a ROM,
+    and get it decompressed and verified while
+    earlier ROMs are being copied into place
+-------------------------------------------------*/
+
+void *rom_load_manager::prefetch_rom(void *param, int threadid)
+{
+	rom_prefetch &prefetch = *reinterpret_cast<rom_prefetch *>(param);
+	prefetch.m_file = prefetch.m_manager.find_rom_file(prefetch.m_searchpath, prefetch.m_romp, prefetch.m_tried, prefetch.m_filerr);
+	if (prefetch.m_file)
+		prefetch.m_file->hashes(util::hash_collection(prefetch.m_romp->hashdata()).hash_types());
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    find_rom_file - locate a ROM file, searching
+    up the parent and loading by checksum; this
+    may be called from worker threads
+-------------------------------------------------*/
+
+std::unique_ptr<emu_file> rom_load_manager::find_rom_file(const search_path_list &searchpath, const rom_entry *romp, std::vector<std::string> &tried_file_names, std::error_condition &filerr)
+{
+	filerr = std::errc::no_such_file_or_directory;
+	tried_file_names.clear();
 
 	// extract CRC to use for searching
+	util::hash_collection const hashes(romp->hashdata());
 	u32 crc = 0;
-	bool const has_crc = util::hash_collection(romp->hashdata()).crc(crc);
+	bool const has_crc = hashes.crc(crc);
+
+	// a previously decompressed copy saves unpacking the archive again
+	std::unique_ptr<emu_file> result = open_cached_rom(hashes, rom_file_size(romp));
+	if (result)
+		filerr = std::error_condition();
 
 	// attempt reading up the chain through the parents
 	// it also automatically attempts any kind of load by checksum supported by the archives.
-	std::unique_ptr<emu_file> result;
-	for (const std::vector<std::string> &paths : searchpath)
-	{
-		result = open_rom_file(paths, tried_file_names, has_crc, crc, ROM_GETNAME(romp), filerr);
-		if (result)
-			break;
-	}
-
-	// update counters
-	m_romsloaded++;
-	m_romsloadedsize += romsize;
+	for (auto it = searchpath.begin(); !result && (searchpath.end() != it); ++it)
+		result = open_rom_file(*it, tried_file_names, has_crc, crc, ROM_GETNAME(romp), filerr);
 
 	// return the result
 	if (filerr)
@@ -674,6 +727,33 @@ std::unique_ptr<emu_file> rom_load_manager::open_rom_file(std::initializer_list<
 }
 
 
+/*-------------------------------------------------
+    open_rom_file - collect a ROM file that was
+    queued for prefetching
+-------------------------------------------------*/
+
+std::unique_ptr<emu_file> rom_load_manager::open_rom_file(rom_prefetch &prefetch, std::vector<std::string> &tried_file_names, bool from_list)
+{
+	// update status display
+	display_loading_rom_message(ROM_GETNAME(prefetch.m_romp), from_list);
+
+	// wait for the worker to finish with it
+	if (prefetch.m_item)
+	{
+		while (!osd_work_item_wait(prefetch.m_item, osd_ticks_per_second() * 100)) { }
+		osd_work_item_release(prefetch.m_item);
+		prefetch.m_item = nullptr;
+	}
+	tried_file_names = std::move(prefetch.m_tried);
+
+	// update counters
+	m_romsloaded++;
+	m_romsloadedsize += rom_file_size(prefetch.m_romp);
+
+	return std::move(prefetch.m_file);
+}
+
+
 std::unique_ptr<emu_file> rom_load_manager::open_rom_file(const std::vector<std::string> &paths, std::vector<std::string> &tried, bool has_crc, u32 crc, std::string_view name, std::error_condition &filerr)
 {
 	// record the set names we search
@@ -695,6 +775,111 @@ std::unique_ptr<emu_file> rom_load_manager::open_rom_file(const std::vector<std:
 }
 
 
+/*-------------------------------------------------
+    open_cached_rom - open a decompressed ROM from
+    the cache, if it's there and still matches
+    the expected hashes
+-------------------------------------------------*/
+
+std::unique_ptr<emu_file> rom_load_manager::open_cached_rom(const util::hash_collection &hashes, u32 length)
+{
+	util::sha1_t sha1;
+	if (!*machine().options().romcache_directory() || hashes.flag(util::hash_collection::FLAG_NO_DUMP) || !hashes.sha1(sha1))
+		return nullptr;
+
+	std::string const name = sha1.as_string() + ".bin";
+	auto result = std::make_unique<emu_file>(machine().options().romcache_directory(), OPEN_FLAG_READ);
+	if (result->open(name))
+		return nullptr;
+
+	// throw away anything that's been damaged or truncated
+	if ((result->size() != length) || (result->hashes(hashes.hash_types()) != hashes))
+	{
+		LOG("Discarding stale cached ROM %s\n", name.c_str());
+		std::string const path = result->fullpath();
+		result.reset();
+		osd_file::remove(path);
+		return nullptr;
+	}
+
+	// the modification time records when this entry was last used; the hashes stay cached for verification
+	osd_file::touch(result->fullpath());
+	return result;
+}
+
+
+/*-------------------------------------------------
+    store_cached_rom - save the contents of a ROM
+    that was decompressed from an archive and
+    passed verification
+-------------------------------------------------*/
+
+void rom_load_manager::store_cached_rom(emu_file &file, const util::hash_collection &hashes)
+{
+	util::sha1_t sha1;
+	if (!*machine().options().romcache_directory() || !file.archived() || !hashes.sha1(sha1))
+		return;
+
+	// a partial entry must never be picked up
+	auto const copy = [&file] (emu_file &cached)
+	{
+		std::vector<u8> buffer(1024 * 1024);
+		bool written = !file.seek(0, SEEK_SET);
+		while (written)
+		{
+			u32 const actual = file.read(&buffer[0], buffer.size());
+			if (!actual)
+				break;
+			written = cached.write(&buffer[0], actual) == actual;
+		}
+		return written;
+	};
+	if (!emu_file::write_replacing(machine().options().romcache_directory(), sha1.as_string() + ".bin", copy))
+		m_romcache_stored = true;
+}
+
+
+/*-------------------------------------------------
+    prune_rom_cache - remove the least recently
+    used entries until the cache fits within the
+    configured size
+-------------------------------------------------*/
+
+void rom_load_manager::prune_rom_cache()
+{
+	if (!m_romcache_stored)
+		return;
+	m_romcache_stored = false;
+
+	std::string const directory = machine().options().romcache_directory();
+	osd::directory::ptr const dir = osd::directory::open(directory);
+	if (!dir)
+		return;
+
+	// gather the cached entries
+	std::vector<std::pair<std::chrono::system_clock::time_point, std::pair<std::string, u64> > > entries;
+	u64 total = 0;
+	for (const osd::directory::entry *entry = dir->read(); entry; entry = dir->read())
+	{
+		if ((entry->type == osd::directory::entry::entry_type::FILE) && core_filename_ends_with(entry->name, ".bin"))
+		{
+			entries.emplace_back(entry->last_modified, std::make_pair(std::string(entry->name), entry->size));
+			total += entry->size;
+		}
+	}
+
+	// delete the oldest ones
+	u64 const limit = u64(std::max(machine().options().romcache_size(), 0)) << 20;
+	std::sort(entries.begin(), entries.end(), [] (auto const &a, auto const &b) { return a.first < b.first; });
+	for (auto it = entries.begin(); (total > limit) && (entries.end() != it); ++it)
+	{
+		LOG("Evicting cached ROM %s\n", it->second.first.c_str());
+		osd_file::remove(directory + PATH_SEPARATOR + it->second.first);
+		total -= it->second.second;
+	}
+}
+
+
 /*-------------------------------------------------
     rom_fread - cheesy fread that fills with
     random data for a nullptr file
@@ -903,6 +1088,25 @@ void rom_load_manager::process_rom_entries(std::initializer_list<std::reference_
 	u32 lastflags = 0;
 	std::vector<std::string> tried_file_names;
 
+	// find the files this region needs
+	search_path_list const paths(searchpath);
+	std::vector<const rom_entry *> files;
+	for (const rom_entry *scan = romp; !ROMENTRY_ISREGIONEND(scan); scan++)
+	{
+		if (ROMENTRY_ISFILE(scan) && (!ROM_GETBIOSFLAGS(scan) || (ROM_GETBIOSFLAGS(scan) == bios)))
+			files.emplace_back(scan);
+	}
+
+	// keep a bounded number of them being decompressed and hashed ahead of the copy into the region
+	std::deque<std::unique_ptr<rom_prefetch> > prefetched;
+	auto nextfile = files.begin();
+	auto const prefetch = [this, &paths, &files, &nextfile, &prefetched] ()
+	{
+		while ((prefetched.size() < PREFETCH_DEPTH) && (files.end() != nextfile))
+			prefetched.emplace_back(std::make_unique<rom_prefetch>(*this, paths, *nextfile++));
+	};
+	prefetch();
+
 	// loop until we hit the end of this region
 	while (!ROMENTRY_ISREGIONEND(romp))
 	{
@@ -940,7 +1144,10 @@ void rom_load_manager::process_rom_entries(std::initializer_list<std::reference_
 			std::unique_ptr<emu_file> file;
 			if (!irrelevantbios)
 			{
-				file = open_rom_file(searchpath, romp, tried_file_names, from_list);
+				assert(!prefetched.empty() && (prefetched.front()->m_romp == romp));
+				file = open_rom_file(*prefetched.front(), tried_file_names, from_list);
+				prefetched.pop_front();
+				prefetch();
 				if (!file)
 					handle_missing_file(romp, tried_file_names, std::error_condition());
 			}
@@ -972,8 +1179,14 @@ void rom_load_manager::process_rom_entries(std::initializer_list<std::reference_
 				if (baserom)
 				{
 					LOG("Verifying length (%X) and checksums\n", explength);
-					verify_length_and_hash(file.get(), baserom->name(), explength, util::hash_collection(baserom->hashdata()));
+					util::hash_collection const hashes(baserom->hashdata());
+					int const warnings = m_warnings;
+					verify_length_and_hash(file.get(), baserom->name(), explength, hashes);
 					LOG("Verify finished\n");
+
+					// keep a decompressed copy if it checked out
+					if (file && (warnings == m_warnings) && !hashes.flag(util::hash_collection::FLAG_NO_DUMP))
+						store_cached_rom(*file, hashes);
 				}
 
 				// re-seek to the start and clear the baserom so we don't reverify
@@ -1223,6 +1436,7 @@ void rom_load_manager::load_software_part_region(device_t &device, software_list
 	m_romstotal = 0;
 	m_romstotalsize = 0;
 	m_romsloadedsize = 0;
+	m_prefetch_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO | WORK_QUEUE_FLAG_MULTI);
 
 	std::vector<const software_info *> parents;
 	std::vector<std::string> swsearch, disksearch, devsearch;
@@ -1282,6 +1496,7 @@ void rom_load_manager::load_software_part_region(device_t &device, software_list
 			// clear old region (TODO: should be moved to an image unload function)
 			machine().memory().region_free(memregion->name());
 		}
+		m_verified_regions.erase(regiontag);
 
 		// remember the base and length
 		m_region = machine().memory().region_alloc(regiontag, regionlength, width, endianness);
@@ -1332,10 +1547,292 @@ void rom_load_manager::load_software_part_region(device_t &device, software_list
 		region_post_process(device.memregion(region->name()), ROMREGION_ISINVERTED(region));
 
 	// display the results and exit
+	osd_work_queue_free(m_prefetch_queue);
+	m_prefetch_queue = nullptr;
+	prune_rom_cache();
 	display_rom_load_results(true);
 }
 
 
+/*-------------------------------------------------
+    append_region_definition - add everything
+    that determines a ROM region's loaded and
+    post-processed contents to a hash, or return
+    false if they aren't fully determined by it
+-------------------------------------------------*/
+
+bool rom_load_manager::append_region_definition(util::sha1_creator &sha1, const rom_entry *region, u8 bios, u8 width, endianness_t endianness)
+{
+	auto const append_value = [&sha1] (u32 value) { sha1.append(&value, sizeof(value)); };
+	auto const append_string = [&sha1, &append_value] (std::string const &str)
+	{
+		append_value(str.length());
+		sha1.append(str.data(), str.length());
+	};
+
+	// the layout of the region, and the BIOS that selects which entries apply
+	append_value(ROMREGION_GETLENGTH(region));
+	append_value(ROMREGION_GETFLAGS(region));
+	append_value(width);
+	append_value(u32(endianness));
+	append_value(u32(ENDIANNESS_NATIVE));
+	append_value(bios);
+
+	// every entry must be fully described by its own definition and SHA1
+	for (const rom_entry *romp = region + 1; !ROMENTRY_ISREGIONEND(romp); romp++)
+	{
+		if (ROMENTRY_ISCOPY(romp))
+			return false;
+		if (ROMENTRY_ISFILE(romp))
+		{
+			util::hash_collection const hashes(romp->hashdata());
+			util::sha1_t digest;
+			if (hashes.flag(util::hash_collection::FLAG_NO_DUMP) || !hashes.sha1(digest))
+				return false;
+		}
+		append_string(romp->name());
+		append_string(romp->hashdata());
+		append_value(romp->get_offset());
+		append_value(romp->get_length());
+		append_value(romp->get_flags());
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    shared_region_key - identify the contents a
+    ROM region will have once loaded and post-
+    processed, or return an empty string if it
+    can't be shared
+-------------------------------------------------*/
+
+std::string rom_load_manager::shared_region_key(const rom_entry *region, u8 bios, u8 width, endianness_t endianness) const
+{
+	if (!*machine().options().sharedrom_directory())
+		return std::string();
+
+	util::sha1_creator sha1;
+	if (!append_region_definition(sha1, region, bios, width, endianness))
+		return std::string();
+	return sha1.finish().as_string();
+}
+
+
+/*-------------------------------------------------
+    verify_region_files - check that every ROM a
+    region needs is present and matches its
+    length and hashes without loading it
+-------------------------------------------------*/
+
+bool rom_load_manager::verify_region_files(const std::vector<std::string> &searchpath, u8 bios, const rom_entry *region)
+{
+	search_path_list const paths{ searchpath };
+	std::vector<std::string> tried_file_names;
+	for (const rom_entry *rom = rom_first_file(region); rom != nullptr; rom = rom_next_file(rom))
+	{
+		if (ROM_GETBIOSFLAGS(rom) && (ROM_GETBIOSFLAGS(rom) != bios))
+			continue;
+
+		util::hash_collection const hashes(rom->hashdata());
+		std::error_condition filerr;
+		std::unique_ptr<emu_file> const file = find_rom_file(paths, rom, tried_file_names, filerr);
+		if (!file || (file->size() != rom_file_size(rom)) || (file->hashes(hashes.hash_types()) != hashes))
+			return false;
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    shared_region_path - get the path of the
+    cache file for a shared region
+-------------------------------------------------*/
+
+std::string rom_load_manager::shared_region_path(std::string_view key) const
+{
+	return util::string_format("%s" PATH_SEPARATOR "%s.bin", machine().options().sharedrom_directory(), key);
+}
+
+
+/*-------------------------------------------------
+    store_cache_file - write <key>.bin to a cache
+    directory without ever exposing a partial file
+-------------------------------------------------*/
+
+bool rom_load_manager::store_cache_file(const char *directory, std::string_view key, const void *data, size_t length)
+{
+	// other instances must never see a partial file
+	return !emu_file::write_replacing(directory, std::string(key) + ".bin", [data, length] (emu_file &file) { return file.write(data, length) == length; });
+}
+
+
+/*-------------------------------------------------
+    store_shared_region - save a loaded region so
+    other instances can map it
+-------------------------------------------------*/
+
+void rom_load_manager::store_shared_region(memory_region &region, std::string_view key)
+{
+	store_cache_file(machine().options().sharedrom_directory(), key, region.base(), region.bytes());
+}
+
+
+/*-------------------------------------------------
+    append_region_source - add what a region was
+    loaded from to a hash, or its contents if it
+    wasn't loaded from ROMs that all verified
+-------------------------------------------------*/
+
+void rom_load_manager::append_region_source(util::sha1_creator &sha1, const memory_region &region) const
+{
+	sha1.append(region.name().data(), region.name().length() + 1);
+
+	// the definition only identifies the contents if every ROM matched its hashes
+	if (m_verified_regions.count(region.name()))
+	{
+		for (device_t &device : device_enumerator(machine().root_device()))
+		{
+			for (const rom_entry *romp = rom_first_region(device); romp != nullptr; romp = rom_next_region(romp))
+			{
+				if (ROMREGION_ISROMDATA(romp) && (device.subtag(romp->name()) == region.name()))
+				{
+					util::sha1_creator definition;
+					if (append_region_definition(definition, romp, device.system_bios(), region.bytewidth(), region.endianness()))
+					{
+						util::sha1_t const digest = definition.finish();
+						sha1.append(digest.m_raw, sizeof(digest.m_raw));
+						return;
+					}
+				}
+			}
+		}
+	}
+
+	// fall back to hashing what's there
+	sha1.append(const_cast<memory_region &>(region).base(), region.bytes());
+}
+
+
+/*-------------------------------------------------
+    derived_key - identify data derived from ROM
+    regions by how it's computed and what from,
+    or return an empty string if it isn't cached
+-------------------------------------------------*/
+
+std::string rom_load_manager::derived_key(std::string_view method, u32 version, std::initializer_list<std::reference_wrapper<const memory_region> > inputs, const void *params, size_t paramlength, size_t length) const
+{
+	if (!*machine().options().derivedcache_directory())
+		return std::string();
+
+	util::sha1_creator sha1;
+	u32 const header[] = { u32(method.length()), version, u32(ENDIANNESS_NATIVE), u32(length), u32(u64(length) >> 32), u32(paramlength) };
+	sha1.append(header, sizeof(header));
+	sha1.append(method.data(), method.length());
+	sha1.append(params, paramlength);
+	for (const memory_region &input : inputs)
+		append_region_source(sha1, input);
+	return sha1.finish().as_string();
+}
+
+
+/*-------------------------------------------------
+    compute_derived - run a derive function over
+    all work units, on all processors
+-------------------------------------------------*/
+
+void rom_load_manager::compute_derived(u32 units, const derive_func &derive)
+{
+	// split the work so every processor gets a share
+	struct derive_chunk
+	{
+		const derive_func *derive;
+		u32 begin, end;
+	};
+	std::vector<derive_chunk> chunks;
+	u32 const count = std::clamp<u32>(units, 1, DERIVE_CHUNKS);
+	for (u32 i = 0; i < count; i++)
+		chunks.push_back(derive_chunk{ &derive, u32(u64(units) * i / count), u32(u64(units) * (i + 1) / count) });
+
+	auto const callback = [] (void *param, int threadid) -> void *
+	{
+		auto const &chunk = *reinterpret_cast<const derive_chunk *>(param);
+		if (chunk.begin != chunk.end)
+			(*chunk.derive)(chunk.begin, chunk.end);
+		return nullptr;
+	};
+	osd_work_queue *const queue = (count > 1) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr;
+	if (queue)
+	{
+		osd_work_item_queue_multiple(queue, callback, count - 1, &chunks[1], sizeof(chunks[1]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		callback(&chunks[0], 0);
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second()))
+		{
+		}
+		osd_work_queue_free(queue);
+	}
+	else
+	{
+		callback(&chunks[0], 0);
+	}
+}
+
+
+/*-------------------------------------------------
+    load_derived - fill a buffer with data derived
+    from ROM regions, from the cache if possible,
+    otherwise by computing it on all processors
+-------------------------------------------------*/
+
+bool rom_load_manager::load_derived(std::string_view method, u32 version, std::initializer_list<std::reference_wrapper<const memory_region> > inputs, const void *params, size_t paramlength, void *output, size_t length, u32 units, const derive_func &derive)
+{
+	char const *const directory = machine().options().derivedcache_directory();
+	std::string const key = derived_key(method, version, inputs, params, paramlength, length);
+	if (!key.empty())
+	{
+		emu_file file(directory, OPEN_FLAG_READ);
+		if (!file.open(key + ".bin") && (file.size() == length) && (file.read(output, length) == length))
+		{
+			LOG("Loaded derived %.*s data %s\n", int(method.length()), method.data(), key.c_str());
+			return true;
+		}
+	}
+
+	compute_derived(units, derive);
+	if (!key.empty() && store_cache_file(directory, key, output, length))
+		LOG("Stored derived %.*s data %s\n", int(method.length()), method.data(), key.c_str());
+	return false;
+}
+
+
+/*-------------------------------------------------
+    map_derived - map cached data derived from ROM
+    regions, or compute it into a buffer and cache
+    it if it isn't there
+-------------------------------------------------*/
+
+std::unique_ptr<osd::file_mapping> rom_load_manager::map_derived(std::string_view method, u32 version, std::initializer_list<std::reference_wrapper<const memory_region> > inputs, const void *params, size_t paramlength, void *output, size_t length, u32 units, const derive_func &derive)
+{
+	char const *const directory = machine().options().derivedcache_directory();
+	std::string const key = derived_key(method, version, inputs, params, paramlength, length);
+	if (!key.empty())
+	{
+		// the mapping fails unless the file is exactly the right size
+		auto mapping = std::make_unique<osd::file_mapping>(util::string_format("%s" PATH_SEPARATOR "%s.bin", directory, key), length);
+		if (*mapping)
+		{
+			LOG("Mapped derived %.*s data %s\n", int(method.length()), method.data(), key.c_str());
+			return mapping;
+		}
+	}
+
+	compute_derived(units, derive);
+	if (!key.empty() && store_cache_file(directory, key, output, length))
+		LOG("Stored derived %.*s data %s\n", int(method.length()), method.data(), key.c_str());
+	return nullptr;
+}
+
+
 /*-------------------------------------------------
     process_region_list - process a region list
 -------------------------------------------------*/
@@ -1345,6 +1842,7 @@ void rom_load_manager::process_region_list()
 	// loop until we hit the end
 	device_enumerator deviter(machine().root_device());
 	std::vector<std::string> searchpath;
+	std::vector<std::pair<memory_region *, std::string> > shared;
 	for (device_t &device : deviter)
 	{
 		searchpath.clear();
@@ -1370,6 +1868,27 @@ void rom_load_manager::process_region_list()
 				m_region = machine().memory().region_alloc(regiontag, regionlength, width, endianness);
 				LOG("Allocated %X bytes @ %p\n", m_region->bytes(), m_region->base());
 
+				// if another instance has already loaded identical contents and our ROMs match, map them instead
+				if (searchpath.empty())
+					searchpath = device.searchpath();
+				assert(!searchpath.empty());
+				std::string sharedkey = shared_region_key(region, device.system_bios(), width, endianness);
+				std::string const sharedpath = sharedkey.empty() ? std::string() : shared_region_path(sharedkey);
+				if (!sharedkey.empty() && osd_stat(sharedpath) && verify_region_files(searchpath, device.system_bios(), region) && m_region->map_file(sharedpath))
+				{
+					m_verified_regions.emplace(regiontag);
+					LOG("Mapped shared region %s @ %p\n", sharedkey.c_str(), m_region->base());
+					for (const rom_entry *rom = rom_first_file(region); rom != nullptr; rom = rom_next_file(rom))
+					{
+						if (ROM_GETBIOSFLAGS(rom) == 0 || ROM_GETBIOSFLAGS(rom) == device.system_bios())
+						{
+							m_romsloaded++;
+							m_romsloadedsize += rom_file_size(rom);
+						}
+					}
+					continue;
+				}
+
 				if (ROMREGION_ISERASE(region)) // clear the region if it's requested
 					memset(m_region->base(), ROMREGION_GETERASEVAL(region), m_region->bytes());
 				else if (m_region->bytes() <= 0x400000) // or if it's sufficiently small (<= 4MB)
@@ -1380,10 +1899,16 @@ void rom_load_manager::process_region_list()
 #endif
 
 				// now process the entries in the region
-				if (searchpath.empty())
-					searchpath = device.searchpath();
-				assert(!searchpath.empty());
+				int const errors = m_errors, warnings = m_warnings;
 				process_rom_entries({ searchpath }, device.system_bios(), region, region + 1, false);
+
+				// only share regions that loaded cleanly
+				if ((errors == m_errors) && (warnings == m_warnings))
+				{
+					m_verified_regions.emplace(regiontag);
+					if (!sharedkey.empty())
+						shared.emplace_back(m_region, std::move(sharedkey));
+				}
 			}
 			else if (ROMREGION_ISDISKDATA(region))
 			{
@@ -1403,10 +1928,21 @@ void rom_load_manager::process_region_list()
 		}
 	}
 
-	// now go back and post-process all the regions
+	// now go back and post-process all the regions, except shared ones that were cached post-processed
 	for (device_t &device : deviter)
+	{
 		for (const rom_entry *region = rom_first_region(device); region != nullptr; region = rom_next_region(region))
-			region_post_process(device.memregion(region->name()), ROMREGION_ISINVERTED(region));
+		{
+			memory_region *const memregion = device.memregion(region->name());
+			if (!memregion || !memregion->mapped())
+				region_post_process(memregion, ROMREGION_ISINVERTED(region));
+		}
+	}
+
+	// save newly loaded shareable regions before anything gets a chance to modify them
+	for (auto &entry : shared)
+		store_shared_region(*entry.first, entry.second);
+	prune_rom_cache();
 
 	// and finally register all per-game parameters
 	for (device_t &device : deviter)
@@ -1435,7 +1971,9 @@ rom_load_manager::rom_load_manager(running_machine &machine)
 	, m_romsloadedsize(0)
 	, m_romstotalsize(0)
 	, m_chd_list()
+	, m_prefetch_queue(nullptr)
 	, m_region(nullptr)
+	, m_romcache_stored(false)
 	, m_errorstring()
 	, m_softwarningstring()
 {
@@ -1479,13 +2017,28 @@ rom_load_manager::rom_load_manager(running_machine &machine)
 	m_chd_list.clear();
 
 	// process the ROM entries we were passed
+	m_prefetch_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO | WORK_QUEUE_FLAG_MULTI);
 	process_region_list();
+	osd_work_queue_free(m_prefetch_queue);
+	m_prefetch_queue = nullptr;
 
 	// display the results and exit
 	display_rom_load_results(false);
 }
 
 
+/*-------------------------------------------------
+    ~rom_load_manager - destructor
+-------------------------------------------------*/
+
+rom_load_manager::~rom_load_manager()
+{
+	// loading may have been abandoned with an error
+	if (m_prefetch_queue)
+		osd_work_queue_free(m_prefetch_queue);
+}
+
+
 // -------------------------------------------------
 // rom_build_entries - builds a rom_entry vector
 // from a tiny_rom_entry array
@@ -17,12 +17,18 @@
 
 #include <functional>
 #include <initializer_list>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <system_error>
 #include <type_traits>
+#include <unordered_set>
 #include <vector>
 
 
+namespace osd { class file_mapping; }
+
+
 /***************************************************************************
     TYPE DEFINITIONS
 ***************************************************************************/
@@ -399,9 +405,27 @@ class rom_load_manager
 		chd_file            m_diffchd;              /* handle to the diff CHD */
 	};
 
+	using search_path_list = std::vector<std::reference_wrapper<const std::vector<std::string> > >;
+
+	// a ROM file being located, decompressed and hashed on a worker thread
+	struct rom_prefetch
+	{
+		rom_prefetch(rom_load_manager &manager, const search_path_list &searchpath, const rom_entry *romp);
+		~rom_prefetch();
+
+		rom_load_manager &          m_manager;
+		const search_path_list &    m_searchpath;
+		const rom_entry *           m_romp;
+		osd_work_item *             m_item;
+		std::unique_ptr<emu_file>   m_file;
+		std::vector<std::string>    m_tried;
+		std::error_condition        m_filerr;
+	};
+
 public:
 	// construction/destruction
 	rom_load_manager(running_machine &machine);
+	~rom_load_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
@@ -431,6 +455,23 @@ public:
 	static std::error_condition open_disk_image(const emu_options &options, const device_t &device, const rom_entry *romp, chd_file &image_chd);
 	static std::error_condition open_disk_image(const emu_options &options, software_list_device &swlist, const software_info &swinfo, const rom_entry *romp, chd_file &image_chd);
 
+	/* ----- derived data ----- */
+
+	/* fills the part of the output for a range of work units; may be called on several threads at once */
+	using derive_func = std::function<void (u32 begin, u32 end)>;
+
+	/* fill a buffer with data computed from ROM regions (typically by decryption),
+	   reading it from the derived data cache instead if it's there; returns true
+	   if it was; inputs must not have been modified since they were loaded */
+	bool load_derived(std::string_view method, u32 version, std::initializer_list<std::reference_wrapper<const memory_region> > inputs, const void *params, size_t paramlength, void *output, size_t length, u32 units, const derive_func &derive);
+
+	/* as above, but return a copy-on-write mapping of the cached data instead of
+	   copying it into the buffer, or null if it had to be computed there */
+	std::unique_ptr<osd::file_mapping> map_derived(std::string_view method, u32 version, std::initializer_list<std::reference_wrapper<const memory_region> > inputs, const void *params, size_t paramlength, void *output, size_t length, u32 units, const derive_func &derive);
+
+	/* run a derive function over all work units without caching the result */
+	static void compute_derived(u32 units, const derive_func &derive);
+
 private:
 	void determine_bios_rom(device_t &device, const char *specbios);
 	void count_roms();
@@ -441,8 +482,13 @@ private:
 	void display_loading_rom_message(const char *name, bool from_list);
 	void display_rom_load_results(bool from_list);
 	void region_post_process(memory_region *region, bool invert);
-	std::unique_ptr<emu_file> open_rom_file(std::initializer_list<std::reference_wrapper<const std::vector<std::string> > > searchpath, const rom_entry *romp, std::vector<std::string> &tried_file_names, bool from_list);
+	static void *prefetch_rom(void *param, int threadid);
+	std::unique_ptr<emu_file> find_rom_file(const search_path_list &searchpath, const rom_entry *romp, std::vector<std::string> &tried_file_names, std::error_condition &filerr);
+	std::unique_ptr<emu_file> open_rom_file(rom_prefetch &prefetch, std::vector<std::string> &tried_file_names, bool from_list);
 	std::unique_ptr<emu_file> open_rom_file(const std::vector<std::string> &paths, std::vector<std::string> &tried, bool has_crc, u32 crc, std::string_view name, std::error_condition &filerr);
+	std::unique_ptr<emu_file> open_cached_rom(const util::hash_collection &hashes, u32 length);
+	void store_cached_rom(emu_file &file, const util::hash_collection &hashes);
+	void prune_rom_cache();
 	int rom_fread(emu_file *file, u8 *buffer, int length, const rom_entry *parent_region);
 	int read_rom_data(emu_file *file, const rom_entry *parent_region, const rom_entry *romp);
 	void fill_rom_data(const rom_entry *romp);
@@ -451,6 +497,14 @@ private:
 	std::error_condition open_disk_diff(emu_options &options, const rom_entry *romp, chd_file &source, chd_file &diff_chd);
 	void process_disk_entries(std::initializer_list<std::reference_wrapper<const std::vector<std::string> > > searchpath, std::string_view regiontag, const rom_entry *romp, std::function<const rom_entry * ()> next_parent);
 	void normalize_flags_for_device(std::string_view rgntag, u8 &width, endianness_t &endian);
+	static bool append_region_definition(util::sha1_creator &sha1, const rom_entry *region, u8 bios, u8 width, endianness_t endianness);
+	std::string shared_region_key(const rom_entry *region, u8 bios, u8 width, endianness_t endianness) const;
+	bool verify_region_files(const std::vector<std::string> &searchpath, u8 bios, const rom_entry *region);
+	void append_region_source(util::sha1_creator &sha1, const memory_region &region) const;
+	std::string derived_key(std::string_view method, u32 version, std::initializer_list<std::reference_wrapper<const memory_region> > inputs, const void *params, size_t paramlength, size_t length) const;
+	std::string shared_region_path(std::string_view key) const;
+	static bool store_cache_file(const char *directory, std::string_view key, const void *data, size_t length);
+	void store_shared_region(memory_region &region, std::string_view key);
 	void process_region_list();
 
 	// internal state
@@ -467,7 +521,10 @@ private:
 
 	std::vector<std::unique_ptr<open_chd>> m_chd_list;     /* disks */
 
+	osd_work_queue *    m_prefetch_queue;     // work queue for locating and decompressing ROMs
 	memory_region *     m_region;             // info about current region
+	bool                m_romcache_stored;    // decompressed ROMs were added to the cache
+	std::unordered_set<std::string> m_verified_regions; // regions where every ROM matched its hashes
 
 	std::string         m_errorstring;        // error string
 	std::string         m_softwarningstring;  // software warning string
@@ -29,6 +29,10 @@
 #include "util/ioprocs.h"
 #include "util/ioprocsfilter.h"
 
+#include <zlib.h>
+
+#include <algorithm>
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -44,9 +48,13 @@
 //  CONSTANTS
 //**************************************************************************
 
-const int SAVE_VERSION      = 2;
+const int SAVE_VERSION      = 3;
+const int SAVE_VERSION_STREAM = 2;  // data compressed as a single zlib stream, still readable
 const int HEADER_SIZE       = 32;
 
+// data is compressed in independent chunks of this size so they can be handled in parallel
+const u32 CHUNK_SIZE        = 1024 * 1024;
+
 // Available flags
 enum
 {
@@ -55,6 +63,64 @@ enum
 
 #define STATE_MAGIC_NUM         "MAMESAVE"
 
+
+namespace {
+
+//**************************************************************************
+//  CHUNKED COMPRESSION
+//**************************************************************************
+
+struct state_chunk
+{
+	const u8 *      raw;                    // uncompressed data to compress, or nullptr
+	u8 *            dest;                   // where to decompress to, or nullptr
+	u32             raw_size;               // uncompressed size
+	std::vector<u8> compressed;             // compressed data
+	bool            ok;                     // true if the chunk was processed successfully
+};
+
+void *compress_chunk(void *param, int threadid)
+{
+	auto &chunk = *reinterpret_cast<state_chunk *>(param);
+	uLongf length = compressBound(chunk.raw_size);
+	chunk.compressed.resize(length);
+	chunk.ok = compress2(&chunk.compressed[0], &length, chunk.raw, chunk.raw_size, 6) == Z_OK;
+	chunk.compressed.resize(length);
+	return nullptr;
+}
+
+void *decompress_chunk(void *param, int threadid)
+{
+	auto &chunk = *reinterpret_cast<state_chunk *>(param);
+	uLongf length = chunk.raw_size;
+	chunk.ok = (uncompress(chunk.dest, &length, &chunk.compressed[0], chunk.compressed.size()) == Z_OK) && (length == chunk.raw_size);
+	return nullptr;
+}
+
+bool process_chunks(std::vector<state_chunk> &chunks, osd_work_callback callback)
+{
+	// hand all but the first chunk to the work queue and do the first one here
+	osd_work_queue *const queue = (chunks.size() > 1) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr;
+	if (queue)
+	{
+		osd_work_item_queue_multiple(queue, callback, chunks.size() - 1, &chunks[1], sizeof(chunks[1]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		callback(&chunks[0], 0);
+
+		// the chunks belong to the caller, so every item must be finished before returning
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+		osd_work_queue_free(queue);
+	}
+	else
+	{
+		for (auto &chunk : chunks)
+			callback(&chunk, 0);
+	}
+
+	return std::all_of(chunks.begin(), chunks.end(), [] (const state_chunk &chunk) { return chunk.ok; });
+}
+
+} // anonymous namespace
+
 //**************************************************************************
 //  INITIALIZATION
 //**************************************************************************
@@ -67,6 +133,9 @@ save_manager::save_manager(running_machine &machine)
 	: m_machine(machine)
 	, m_reg_allowed(true)
 	, m_illegal_regs(0)
+	, m_snapshot_size(0)
+	, m_hashes_valid(false)
+	, m_incremental_hashing(false)
 {
 	m_rewind = std::make_unique<rewinder>(*this);
 }
@@ -101,6 +170,7 @@ void save_manager::allow_registration(bool allowed)
 			fatalerror("%d duplicate save state entries found.\n", dupes_found);
 
 		dump_registry();
+		build_snapshot_plan();
 
 		// everything is registered by now, evaluate the savestate size
 		m_rewind->clamp_capacity();
@@ -260,30 +330,37 @@ void save_manager::dispatch_presave()
 
 save_error save_manager::write_file(util::core_file &file)
 {
-	util::write_stream::ptr writer;
-	save_error err = do_write(
-			[] (size_t total_size) { return true; },
-			[&writer] (const void *data, size_t size)
-			{
-				size_t written;
-				std::error_condition filerr = writer->write(data, size, written);
-				return !filerr && (size == written);
-			},
-			[&file, &writer] ()
-			{
-				if (file.seek(0, SEEK_SET))
-					return false;
-				util::core_file::ptr proxy;
-				std::error_condition filerr = util::core_file::open_proxy(file, proxy);
-				writer = std::move(proxy);
-				return !filerr && writer;
-			},
-			[&file, &writer] ()
-			{
-				writer = util::zlib_write(file, 6, 16384);
-				return bool(writer);
-			});
-	return (STATERR_NONE != err) ? err : writer->finalize() ? STATERR_WRITE_ERROR : STATERR_NONE;
+	// take a copy of the state first, so the machine is only held up for the copy and the compression
+	std::vector<u8> raw(ram_state::get_size(*this));
+	save_error err = write_buffer(&raw[0], raw.size());
+	if (err != STATERR_NONE)
+		return err;
+
+	// compress the data after the header in parallel
+	std::vector<state_chunk> chunks;
+	for (size_t offset = HEADER_SIZE; offset < raw.size(); offset += CHUNK_SIZE)
+		chunks.emplace_back(state_chunk{ &raw[offset], nullptr, u32(std::min<size_t>(raw.size() - offset, CHUNK_SIZE)), { }, false });
+	if (!process_chunks(chunks, &compress_chunk))
+		return STATERR_WRITE_ERROR;
+
+	// the header is followed by the chunk count and the size of each chunk
+	std::vector<u32> table(1 + chunks.size() * 2);
+	table[0] = little_endianize_int32(chunks.size());
+	for (size_t i = 0; i < chunks.size(); i++)
+	{
+		table[1 + i * 2] = little_endianize_int32(chunks[i].raw_size);
+		table[2 + i * 2] = little_endianize_int32(chunks[i].compressed.size());
+	}
+
+	size_t written;
+	if (file.seek(0, SEEK_SET) || file.write(&raw[0], HEADER_SIZE, written) || (written != HEADER_SIZE))
+		return STATERR_WRITE_ERROR;
+	if (file.write(&table[0], table.size() * sizeof(table[0]), written) || (written != table.size() * sizeof(table[0])))
+		return STATERR_WRITE_ERROR;
+	for (auto &chunk : chunks)
+		if (file.write(&chunk.compressed[0], chunk.compressed.size(), written) || (written != chunk.compressed.size()))
+			return STATERR_WRITE_ERROR;
+	return STATERR_NONE;
 }
 
 
@@ -292,6 +369,70 @@ save_error save_manager::write_file(util::core_file &file)
 //-------------------------------------------------
 
 save_error save_manager::read_file(util::core_file &file)
+{
+	// check the version to see how the data is stored
+	u8 header[HEADER_SIZE];
+	size_t actual;
+	if (file.seek(0, SEEK_SET) || file.read(header, sizeof(header), actual) || (actual != sizeof(header)))
+		return STATERR_READ_ERROR;
+	if (header[8] == SAVE_VERSION_STREAM)
+		return read_file_stream(file);
+
+	// reject foreign and outdated files before trusting any sizes they contain
+	if (validate_header(header, machine().system().name, signature(), nullptr, "Error: ") != STATERR_NONE)
+		return STATERR_INVALID_HEADER;
+
+	// read the chunk table; a state of the size we expect never needs more chunks than this
+	const size_t expected = ram_state::get_size(*this);
+	const size_t max_count = (expected - HEADER_SIZE) / CHUNK_SIZE + 1;
+	u32 count;
+	if (file.read(&count, sizeof(count), actual) || (actual != sizeof(count)))
+		return STATERR_READ_ERROR;
+	count = little_endianize_int32(count);
+	if (count > max_count)
+		return STATERR_READ_ERROR;
+	std::vector<u32> table(count * 2);
+	if (count && (file.read(&table[0], table.size() * sizeof(table[0]), actual) || (actual != table.size() * sizeof(table[0]))))
+		return STATERR_READ_ERROR;
+
+	// work out where each chunk goes, making sure the state is the size we expect
+	const uLong max_compressed = compressBound(CHUNK_SIZE);
+	std::vector<u8> raw(expected);
+	std::vector<state_chunk> chunks(count);
+	size_t offset = HEADER_SIZE;
+	for (u32 i = 0; i < count; i++)
+	{
+		const u32 raw_size = little_endianize_int32(table[i * 2]);
+		const u32 compressed_size = little_endianize_int32(table[i * 2 + 1]);
+		if ((raw_size > CHUNK_SIZE) || ((expected - offset) < raw_size) || !compressed_size || (compressed_size > max_compressed))
+			return STATERR_READ_ERROR;
+
+		chunks[i].raw = nullptr;
+		chunks[i].dest = &raw[offset];
+		chunks[i].raw_size = raw_size;
+		chunks[i].compressed.resize(compressed_size);
+		chunks[i].ok = false;
+		if (file.read(&chunks[i].compressed[0], compressed_size, actual) || (actual != compressed_size))
+			return STATERR_READ_ERROR;
+		offset += raw_size;
+	}
+	if (offset != expected)
+		return STATERR_READ_ERROR;
+
+	// decompress in parallel and load the result
+	if (!process_chunks(chunks, &decompress_chunk))
+		return STATERR_READ_ERROR;
+	memcpy(&raw[0], header, HEADER_SIZE);
+	return read_buffer(&raw[0], raw.size());
+}
+
+
+//-------------------------------------------------
+//  read_file_stream - read the data from a file
+//  compressed as a single zlib stream
+//-------------------------------------------------
+
+save_error save_manager::read_file_stream(util::core_file &file)
 {
 	util::read_stream::ptr reader;
 	return do_read(
@@ -399,6 +540,269 @@ save_error save_manager::read_buffer(const void *buf, size_t size)
 }
 
 
+//-------------------------------------------------
+//  save_snapshot - copy the current machine state
+//  to a buffer of snapshot_size() bytes
+//-------------------------------------------------
+
+save_error save_manager::save_snapshot(void *buf, size_t size)
+{
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+	if (size != m_snapshot_size)
+		return STATERR_WRITE_ERROR;
+
+	dispatch_presave();
+
+	u8 *ptr = reinterpret_cast<u8 *>(buf);
+	for (const snapshot_run &run : m_snapshot_plan)
+	{
+		memcpy(ptr, run.m_data, run.m_size);
+		ptr += run.m_size;
+	}
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  load_snapshot - restore the machine state from
+//  a buffer filled by save_snapshot
+//-------------------------------------------------
+
+save_error save_manager::load_snapshot(const void *buf, size_t size)
+{
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+	if (size != m_snapshot_size)
+		return STATERR_READ_ERROR;
+
+	const u8 *ptr = reinterpret_cast<const u8 *>(buf);
+	for (const snapshot_run &run : m_snapshot_plan)
+	{
+		memcpy(run.m_data, ptr, run.m_size);
+		ptr += run.m_size;
+	}
+
+	// loading bypasses dirty tracking
+	invalidate_hashes();
+
+	dispatch_postload();
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  build_snapshot_plan - work out the runs of
+//  memory a snapshot copies, merging adjacent or
+//  overlapping registrations
+//-------------------------------------------------
+
+void save_manager::build_snapshot_plan()
+{
+	std::vector<snapshot_run> runs;
+	for (const auto &entry : m_entry_list)
+	{
+		const size_t blocksize = entry->m_typesize * entry->m_typecount;
+		u8 *data = reinterpret_cast<u8 *>(entry->m_data);
+		if (!blocksize || !entry->m_blockcount)
+			continue;
+		if (entry->m_stride == blocksize)
+			runs.emplace_back(snapshot_run{ data, blocksize * entry->m_blockcount });
+		else
+			for (u32 b = 0; entry->m_blockcount > b; ++b, data += entry->m_stride)
+				runs.emplace_back(snapshot_run{ data, blocksize });
+	}
+
+	std::sort(runs.begin(), runs.end(), [] (const snapshot_run &a, const snapshot_run &b) { return a.m_data < b.m_data; });
+
+	m_snapshot_plan.clear();
+	m_snapshot_size = 0;
+	for (const snapshot_run &run : runs)
+	{
+		if (!m_snapshot_plan.empty() && (run.m_data <= (m_snapshot_plan.back().m_data + m_snapshot_plan.back().m_size)))
+		{
+			snapshot_run &last = m_snapshot_plan.back();
+			const size_t end = std::max<size_t>(last.m_size, (run.m_data - last.m_data) + run.m_size);
+			m_snapshot_size += end - last.m_size;
+			last.m_size = end;
+		}
+		else
+		{
+			m_snapshot_plan.emplace_back(run);
+			m_snapshot_size += run.m_size;
+		}
+	}
+	m_snapshot_plan.shrink_to_fit();
+}
+
+
+//-------------------------------------------------
+//  state_hash - return a hash of the whole
+//  registered state
+//-------------------------------------------------
+
+u32 save_manager::state_hash()
+{
+	update_hashes();
+
+	u32 crc = 0;
+	for (const entry_hash &hash : m_entry_hashes)
+	{
+		const u32 value = little_endianize_int32(hash.m_hash);
+		crc = core_crc32(crc, reinterpret_cast<const u8 *>(&value), sizeof(value));
+	}
+	return crc;
+}
+
+
+//-------------------------------------------------
+//  device_state_hashes - return a hash of the
+//  registered state of each device, with global
+//  items listed under their module name
+//-------------------------------------------------
+
+std::vector<std::pair<std::string, u32>> save_manager::device_state_hashes()
+{
+	update_hashes();
+
+	std::vector<std::pair<std::string, u32>> result;
+	std::map<std::string, size_t> indices;
+	for (size_t i = 0; i < m_entry_list.size(); i++)
+	{
+		const state_entry &entry = *m_entry_list[i];
+		std::string name = entry.m_device ? std::string(entry.m_device->tag()) : entry.m_module;
+		auto const found = indices.emplace(std::move(name), result.size());
+		if (found.second)
+			result.emplace_back(found.first->first, 0);
+
+		const u32 value = little_endianize_int32(m_entry_hashes[i].m_hash);
+		u32 &crc = result[found.first->second].second;
+		crc = core_crc32(crc, reinterpret_cast<const u8 *>(&value), sizeof(value));
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  set_incremental_hashing - only rehash the
+//  pages of shares written since the last hash;
+//  this enables dirty tracking on shares, and is
+//  only reliable if drivers that write to shares
+//  directly call mark_dirty
+//-------------------------------------------------
+
+void save_manager::set_incremental_hashing(bool enable)
+{
+	if (enable == m_incremental_hashing)
+		return;
+
+	m_incremental_hashing = enable;
+	for (auto &share : machine().memory().shares())
+		share.second->set_dirty_tracking(enable);
+	m_entry_hashes.clear();
+	invalidate_hashes();
+}
+
+
+//-------------------------------------------------
+//  update_hashes - bring the entry hashes up to
+//  date with the current state
+//-------------------------------------------------
+
+void save_manager::update_hashes()
+{
+	// let devices bring their registered items up to date, as for a save
+	dispatch_presave();
+
+	// work out which entries can be hashed incrementally the first time through
+	if (m_entry_hashes.size() != m_entry_list.size())
+	{
+		m_entry_hashes.clear();
+		m_entry_hashes.resize(m_entry_list.size());
+		for (size_t i = 0; i < m_entry_list.size(); i++)
+		{
+			const state_entry &entry = *m_entry_list[i];
+			const size_t blocksize = entry.m_typesize * entry.m_typecount;
+			const size_t size = blocksize * entry.m_blockcount;
+			entry_hash &hash = m_entry_hashes[i];
+			hash.m_chunks.resize((size + HASH_CHUNK_SIZE - 1) / HASH_CHUNK_SIZE);
+			hash.m_share = nullptr;
+			hash.m_offset = 0;
+			if (m_incremental_hashing && (entry.m_stride == blocksize) && size)
+			{
+				for (auto &share : machine().memory().shares())
+				{
+					const u8 *const base = reinterpret_cast<const u8 *>(share.second->ptr());
+					const u8 *const data = reinterpret_cast<const u8 *>(entry.m_data);
+					if (share.second->contains(data) && ((data - base) + size <= share.second->bytes()))
+					{
+						hash.m_share = share.second.get();
+						hash.m_offset = data - base;
+						break;
+					}
+				}
+			}
+		}
+		m_hashes_valid = false;
+	}
+
+	for (size_t i = 0; i < m_entry_list.size(); i++)
+	{
+		const state_entry &entry = *m_entry_list[i];
+		entry_hash &hash = m_entry_hashes[i];
+		const u32 blocksize = entry.m_typesize * entry.m_typecount;
+		const size_t size = size_t(blocksize) * entry.m_blockcount;
+		const u8 *const data = reinterpret_cast<const u8 *>(entry.m_data);
+		const bool partial = m_hashes_valid && hash.m_share;
+
+		for (size_t chunk = 0; chunk < hash.m_chunks.size(); chunk++)
+		{
+			const size_t start = chunk * HASH_CHUNK_SIZE;
+			const size_t length = std::min(size - start, HASH_CHUNK_SIZE);
+
+			// skip chunks whose share pages haven't been written
+			if (partial)
+			{
+				const size_t first = (hash.m_offset + start) >> memory_share::DIRTY_PAGE_SHIFT;
+				const size_t last = (hash.m_offset + start + length - 1) >> memory_share::DIRTY_PAGE_SHIFT;
+				bool dirty = false;
+				for (size_t page = first; !dirty && (page <= last); page++)
+					dirty = hash.m_share->page_dirty(page);
+				if (!dirty)
+					continue;
+			}
+
+			if (entry.m_stride == blocksize)
+			{
+				hash.m_chunks[chunk] = little_endianize_int32(core_crc32(0, data + start, length));
+			}
+			else
+			{
+				// gather the strided blocks that make up this chunk
+				u32 crc = 0;
+				for (size_t pos = start; pos < start + length; )
+				{
+					const size_t block = pos / blocksize;
+					const size_t offset = pos % blocksize;
+					const size_t count = std::min<size_t>(blocksize - offset, start + length - pos);
+					crc = core_crc32(crc, data + block * entry.m_stride + offset, count);
+					pos += count;
+				}
+				hash.m_chunks[chunk] = little_endianize_int32(crc);
+			}
+		}
+
+		hash.m_hash = hash.m_chunks.empty() ? 0 : core_crc32(0, reinterpret_cast<const u8 *>(&hash.m_chunks[0]), hash.m_chunks.size() * sizeof(u32));
+	}
+
+	// the dirty maps have been consumed
+	if (m_incremental_hashing)
+		for (auto &share : machine().memory().shares())
+			share.second->clear_dirty();
+	m_hashes_valid = true;
+}
+
+
 //-------------------------------------------------
 //  do_write - serialisation logic
 //-------------------------------------------------
@@ -491,6 +895,9 @@ inline save_error save_manager::do_read(T check_length, U read_block, V start_he
 			entry->flip_data();
 	}
 
+	// loading bypasses dirty tracking
+	invalidate_hashes();
+
 	// call the post-load functions
 	dispatch_postload();
 
@@ -553,7 +960,7 @@ save_error save_manager::validate_header(const u8 *header, const char *gamename,
 	}
 
 	// check save state version
-	if (header[8] != SAVE_VERSION)
+	if ((header[8] != SAVE_VERSION) && (header[8] != SAVE_VERSION_STREAM))
 	{
 		if (errormsg != nullptr)
 			(*errormsg)("%sWrong version in save file (version %d, expected %d)", error_prefix, header[8], SAVE_VERSION);
@@ -679,7 +1086,8 @@ rewinder::rewinder(save_manager &save)
 	, m_enabled(save.machine().options().rewind())
 	, m_capacity(save.machine().options().rewind_capacity())
 	, m_current_index(REWIND_INDEX_NONE)
-	, m_first_invalid_index(REWIND_INDEX_NONE)
+	, m_keyframe_index(REWIND_INDEX_NONE)
+	, m_used(0)
 	, m_first_time_warning(true)
 	, m_first_time_note(true)
 {
@@ -715,9 +1123,9 @@ void rewinder::clamp_capacity()
 
 
 //-------------------------------------------------
-//  invalidate - mark all the future states as
-//  invalid to prevent loading them, as the
-//  current input might have changed
+//  invalidate - drop all the future states to
+//  prevent loading them, as the current input
+//  might have changed
 //-------------------------------------------------
 
 void rewinder::invalidate()
@@ -727,23 +1135,17 @@ void rewinder::invalidate()
 
 	// is there anything to invalidate?
 	if (!current_index_is_last())
-	{
-		// all states starting from the current one will be invalid
-		m_first_invalid_index = m_current_index;
-
-		// actually invalidate
-		for (auto it = m_state_list.begin() + m_first_invalid_index; it < m_state_list.end(); ++it)
-			it->get()->m_valid = false;
-	}
+		discard_after(m_current_index + 1);
 }
 
 
 //-------------------------------------------------
 //  capture - record a single state, returns true
-//  on success
+//  on success; the position is kept with the state
+//  so it can be found again by seek
 //-------------------------------------------------
 
-bool rewinder::capture()
+bool rewinder::capture(u64 position)
 {
 	if (!m_enabled)
 	{
@@ -751,54 +1153,54 @@ bool rewinder::capture()
 		return false;
 	}
 
-	if (current_index_is_last())
+	// when we have stepped back, the new state replaces the one we loaded and everything after it,
+	// except that a positioned state was taken after execution moved on from the loaded one
+	if (!current_index_is_last())
+		discard_after((position == NO_POSITION) ? m_current_index : (m_current_index + 1));
+
+	// get the uncompressed state
+	const size_t size = ram_state::get_size(m_save);
+	m_buffer.resize(size);
+	save_error error = m_save.write_buffer(&m_buffer[0], size);
+	if (error != STATERR_NONE)
 	{
-		// we need to create a new state
-		std::unique_ptr<ram_state> state = std::make_unique<ram_state>(m_save);
-		const save_error error = state->save();
-
-		// validate the state
-		if (error == STATERR_NONE)
-			// it's safe to append
-			m_state_list.push_back(std::move(state));
-		else
-		{
-			// internal error, complain and evacuate
-			report_error(error, rewind_operation::SAVE);
-			return false;
-		}
+		// internal error, complain and evacuate
+		report_error(error, rewind_operation::SAVE);
+		return false;
 	}
-	else
-	{
-		// invalidate the future states
-		invalidate();
-
-		// update the existing state
-		ram_state *state = m_state_list.at(m_current_index).get();
-		const save_error error = state->save();
 
-		// validate the state
-		if (error != STATERR_NONE)
-		{
-			// internal error, complain and evacuate
-			report_error(error, rewind_operation::SAVE);
-			return false;
-		}
+	// store it whole every so often, and as the difference from the last keyframe otherwise
+	rewind_state state;
+	state.position = position;
+	state.keyframe = (m_keyframe_index == REWIND_INDEX_NONE) || (m_keyframe.size() != size) ||
+			((m_state_list.size() - m_keyframe_index) >= KEYFRAME_INTERVAL);
+	if (!state.keyframe)
+	{
+		m_delta.resize(size);
+		for (size_t i = 0; i < size; i++)
+			m_delta[i] = m_buffer[i] ^ m_keyframe[i];
+	}
+	if (!compress_state(state.keyframe ? m_buffer : m_delta, state))
+	{
+		report_error(STATERR_WRITE_ERROR, rewind_operation::SAVE);
+		return false;
+	}
+	if (state.keyframe)
+	{
+		m_keyframe.swap(m_buffer);
+		m_keyframe_index = m_state_list.size();
 	}
 
-	// make sure we will fit in
-	if (!check_size())
-		// the list keeps growing
-		m_current_index++;
+	m_used += state.data.size();
+	m_state_list.emplace_back(std::move(state));
+	m_current_index = m_state_list.size() - 1;
 
-	// update first invalid index
-	if (current_index_is_last())
-		m_first_invalid_index = REWIND_INDEX_NONE;
-	else
-		m_first_invalid_index = m_current_index + 1;
+	// make sure we fit in
+	check_size();
 
-	// success
-	report_error(STATERR_NONE, rewind_operation::SAVE);
+	// success, periodic positioned states are taken quietly
+	if (position == NO_POSITION)
+		report_error(STATERR_NONE, rewind_operation::SAVE);
 	return true;
 }
 
@@ -817,22 +1219,15 @@ bool rewinder::step()
 	}
 
 	// do we have states to load?
-	if (m_current_index <= REWIND_INDEX_FIRST || m_first_invalid_index == REWIND_INDEX_FIRST)
+	if (m_current_index <= REWIND_INDEX_FIRST)
 	{
 		// no valid states, complain and evacuate
 		report_error(STATERR_NOT_FOUND, rewind_operation::LOAD);
 		return false;
 	}
 
-	// prepare to load the last valid index if we're too far ahead
-	if (m_first_invalid_index > REWIND_INDEX_NONE && m_current_index > m_first_invalid_index)
-		m_current_index = m_first_invalid_index;
-
-	// step back and obtain the state pointer
-	ram_state *state = m_state_list.at(--m_current_index).get();
-
-	// try to load and report the result
-	const save_error error = state->load();
+	// step back, try to load and report the result
+	const save_error error = load_state(--m_current_index);
 	report_error(error, rewind_operation::LOAD);
 
 	if (error == save_error::STATERR_NONE)
@@ -843,64 +1238,166 @@ bool rewinder::step()
 
 
 //-------------------------------------------------
-//  check_size - shrink the state list if it is
-//  about to hit the capacity. returns true if
-//  the list got shrank
+//  seek - load the newest state captured before
+//  the given position, returns true on success
 //-------------------------------------------------
 
-bool rewinder::check_size()
+bool rewinder::seek(u64 position, u64 &found)
 {
 	if (!m_enabled)
+	{
+		report_error(STATERR_DISABLED, rewind_operation::LOAD);
 		return false;
+	}
 
-	// state sizes in bytes
-	const size_t singlesize = ram_state::get_size(m_save);
-	size_t totalsize = m_state_list.size() * singlesize;
+	const s32 index = find_before(position);
+	if (index == REWIND_INDEX_NONE)
+	{
+		report_error(STATERR_NOT_FOUND, rewind_operation::LOAD);
+		return false;
+	}
 
-	// convert our limit from megabytes
-	const size_t capsize = m_capacity * 1024 * 1024;
+	const save_error error = load_state(index);
+	report_error(error, rewind_operation::LOAD);
+	if (error != save_error::STATERR_NONE)
+		return false;
 
-	// safety check that shouldn't be allowed to trigger
-	if (totalsize > capsize)
-	{
-		// states to remove
-		const u32 count = (totalsize - capsize) / singlesize;
+	m_current_index = index;
+	found = m_state_list[index].position;
+	return true;
+}
 
-		// drop everything that's beyond capacity
-		m_state_list.erase(m_state_list.begin(), m_state_list.begin() + count);
+
+//-------------------------------------------------
+//  find_before - find the newest state captured
+//  before the given position
+//-------------------------------------------------
+
+s32 rewinder::find_before(u64 position) const
+{
+	for (s32 index = s32(m_state_list.size()) - 1; index >= REWIND_INDEX_FIRST; index--)
+	{
+		const u64 statepos = m_state_list[index].position;
+		if ((statepos != NO_POSITION) && (statepos < position))
+			return index;
 	}
+	return REWIND_INDEX_NONE;
+}
+
 
-	// update before new check
-	totalsize = m_state_list.size() * singlesize;
+//-------------------------------------------------
+//  discard_after - drop the states starting at
+//  the given index
+//-------------------------------------------------
+
+void rewinder::discard_after(s32 index)
+{
+	for (auto it = m_state_list.begin() + index; it != m_state_list.end(); ++it)
+		m_used -= it->data.size();
+	m_state_list.erase(m_state_list.begin() + index, m_state_list.end());
+
+	// the next state needs a new keyframe if we dropped this one
+	if (m_keyframe_index >= index)
+		m_keyframe_index = REWIND_INDEX_NONE;
+	m_current_index = std::min<s32>(m_current_index, m_state_list.size() - 1);
+}
+
+
+//-------------------------------------------------
+//  check_size - drop the oldest states while the
+//  list is over capacity
+//-------------------------------------------------
+
+void rewinder::check_size()
+{
+	// convert our limit from megabytes
+	const size_t capsize = m_capacity * 1024 * 1024;
 
-	// check if capacity will be hit by the newly captured state
-	if (totalsize + singlesize >= capsize)
+	while (m_used > capsize)
 	{
-		// check if we have spare states ahead
-		if (!current_index_is_last())
-			// no need to move states around
-			return false;
+		// states depend on their keyframe, so drop the oldest keyframe along with them
+		size_t count = 1;
+		while ((count < m_state_list.size()) && !m_state_list[count].keyframe)
+			count++;
 
-		// we can now get the first state and invalidate it
-		std::unique_ptr<ram_state> first(std::move(m_state_list.front()));
-		first->m_valid = false;
+		// never drop the states the newest one depends on
+		if (count >= m_state_list.size())
+			break;
 
-		// move it to the end for future use
-		m_state_list.push_back(std::move(first));
-		m_state_list.erase(m_state_list.begin());
+		for (size_t i = 0; i < count; i++)
+			m_used -= m_state_list[i].data.size();
+		m_state_list.erase(m_state_list.begin(), m_state_list.begin() + count);
+		m_current_index -= count;
+		m_keyframe_index -= count;
 
 		if (m_first_time_note)
 		{
 			m_save.machine().logerror("Rewind note: Capacity has been reached. Old savestates will be erased.\n");
 			m_save.machine().logerror("Capacity: %d bytes. Savestate size: %d bytes. Savestate count: %d.\n",
-				totalsize, singlesize, m_state_list.size());
+				capsize, ram_state::get_size(m_save), m_state_list.size());
 			m_first_time_note = false;
 		}
+	}
+}
 
-		return true;
+
+//-------------------------------------------------
+//  compress_state - store a zlib compressed copy
+//  of an uncompressed state
+//-------------------------------------------------
+
+bool rewinder::compress_state(const std::vector<u8> &source, rewind_state &state)
+{
+	uLongf length = compressBound(source.size());
+	state.data.resize(length);
+	if (compress2(&state.data[0], &length, &source[0], source.size(), Z_BEST_SPEED) != Z_OK)
+		return false;
+	state.data.resize(length);
+	state.data.shrink_to_fit();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  decompress_state - expand a compressed state
+//  to the current state size
+//-------------------------------------------------
+
+bool rewinder::decompress_state(const rewind_state &state, std::vector<u8> &dest)
+{
+	dest.resize(ram_state::get_size(m_save));
+	uLongf length = dest.size();
+	return (uncompress(&dest[0], &length, &state.data[0], state.data.size()) == Z_OK) && (length == dest.size());
+}
+
+
+//-------------------------------------------------
+//  load_state - restore the machine state from
+//  the given entry in the list
+//-------------------------------------------------
+
+save_error rewinder::load_state(s32 index)
+{
+	// if we have illegal registrations, return an error
+	if (m_save.m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// find the keyframe and apply the difference to it
+	s32 keyframe = index;
+	while (!m_state_list[keyframe].keyframe)
+		keyframe--;
+	if (!decompress_state(m_state_list[keyframe], m_buffer))
+		return STATERR_READ_ERROR;
+	if (keyframe != index)
+	{
+		if (!decompress_state(m_state_list[index], m_delta))
+			return STATERR_READ_ERROR;
+		for (size_t i = 0; i < m_buffer.size(); i++)
+			m_buffer[i] ^= m_delta[i];
 	}
 
-	return false;
+	// get the save manager to load state
+	return m_save.read_buffer(&m_buffer[0], m_buffer.size());
 }
 
 
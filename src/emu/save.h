@@ -19,9 +19,11 @@
 
 #include <array>
 #include <cassert>
+#include <deque>
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 
@@ -88,6 +90,7 @@ typedef named_delegate<void ()> save_prepost_delegate;
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+class memory_share;
 class ram_state;
 class rewinder;
 
@@ -310,6 +313,17 @@ public:
 	save_error write_buffer(void *buf, size_t size);
 	save_error read_buffer(const void *buf, size_t size);
 
+	// fast snapshots in native format with no header, only valid for this session
+	size_t snapshot_size() const { return m_snapshot_size; }
+	save_error save_snapshot(void *buf, size_t size);
+	save_error load_snapshot(const void *buf, size_t size);
+
+	// state hashes for comparing machines, e.g. to detect netplay desyncs
+	u32 state_hash();
+	std::vector<std::pair<std::string, u32>> device_state_hashes();
+	bool incremental_hashing() const { return m_incremental_hashing; }
+	void set_incremental_hashing(bool enable);
+
 private:
 	// state callback item
 	class state_callback
@@ -321,11 +335,33 @@ private:
 		save_prepost_delegate m_func;                 // delegate
 	};
 
+	// cached hash of a registered entry, split into chunks so that
+	// entries backed by a dirty-tracked share can be rehashed in part
+	static constexpr size_t HASH_CHUNK_SIZE = 4096;
+	struct entry_hash
+	{
+		std::vector<u32>      m_chunks;               // CRC of each chunk
+		memory_share *        m_share;                // share containing the entry when hashing incrementally
+		size_t                m_offset;               // offset of the entry in the share
+		u32                   m_hash;                 // CRC of the chunk CRCs
+	};
+
+	// contiguous run of registered memory copied by snapshots
+	struct snapshot_run
+	{
+		u8 *                  m_data;                 // start of the run
+		size_t                m_size;                 // length in bytes
+	};
+
 	// internal helpers
 	template <typename T, typename U, typename V, typename W>
 	save_error do_write(T check_space, U write_block, V start_header, W start_data);
 	template <typename T, typename U, typename V, typename W>
 	save_error do_read(T check_length, U read_block, V start_header, W start_data);
+	save_error read_file_stream(util::core_file &file);
+	void build_snapshot_plan();
+	void update_hashes();
+	void invalidate_hashes() { m_hashes_valid = false; }
 	u32 signature() const;
 	void dump_registry() const;
 	static save_error validate_header(const u8 *header, const char *gamename, u32 signature, void (CLIB_DECL *errormsg)(const char *fmt, ...), const char *error_prefix);
@@ -337,6 +373,11 @@ private:
 	s32                       m_illegal_regs;         // number of illegal registrations
 
 	std::vector<std::unique_ptr<state_entry>>    m_entry_list;       // list of registered entries
+	std::vector<snapshot_run>                     m_snapshot_plan;    // merged memory runs for snapshots
+	size_t                                        m_snapshot_size;    // total size of a snapshot
+	std::vector<entry_hash>                       m_entry_hashes;     // hash of each registered entry
+	bool                                          m_hashes_valid;     // true if unchanged chunks can be trusted
+	bool                                          m_incremental_hashing; // use dirty page tracking for shares
 	std::vector<std::unique_ptr<ram_state>>      m_ramstate_list;    // list of ram states
 	std::vector<std::unique_ptr<state_callback>> m_presave_list;     // list of pre-save functions
 	std::vector<std::unique_ptr<state_callback>> m_postload_list;    // list of post-load functions
@@ -359,14 +400,29 @@ public:
 
 class rewinder
 {
+	// a keyframe is stored whole; the states after it are stored XORed with it
+	static constexpr u32 KEYFRAME_INTERVAL = 16;
+
+	// a zlib compressed state
+	struct rewind_state
+	{
+		bool           keyframe;                      // true if data doesn't depend on an earlier state
+		u64            position;                      // caller-defined position in the execution, or NO_POSITION
+		std::vector<u8> data;                         // compressed state, or compressed XOR with the keyframe
+	};
+
 	save_manager & m_save;                            // reference to save_manager
 	bool           m_enabled;                         // enable rewind savestates
 	size_t         m_capacity;                        // total memory rewind states can occupy (MB, limited to 1-2048 in options)
 	s32            m_current_index;                   // where we are in time
-	s32            m_first_invalid_index;             // all states before this one are guarateed to be valid
+	s32            m_keyframe_index;                  // the keyframe new states are stored against, or REWIND_INDEX_NONE
+	size_t         m_used;                            // total size of the compressed states
 	bool           m_first_time_warning;              // keep track of warnings we report
 	bool           m_first_time_note;                 // keep track of notes
-	std::vector<std::unique_ptr<ram_state>> m_state_list; // rewinder's own ram states
+	std::deque<rewind_state> m_state_list;            // rewinder's own states, oldest first
+	std::vector<u8> m_keyframe;                       // uncompressed copy of the current keyframe
+	std::vector<u8> m_buffer;                         // uncompressed state being saved or loaded
+	std::vector<u8> m_delta;                          // XOR of a state with its keyframe
 
 	// load/save management
 	enum class rewind_operation
@@ -381,17 +437,28 @@ class rewinder
 		REWIND_INDEX_FIRST
 	};
 
-	bool check_size();
-	bool current_index_is_last() { return m_current_index == m_state_list.size() - 1; }
+	void discard_after(s32 index);
+	s32 find_before(u64 position) const;
+	void check_size();
+	bool compress_state(const std::vector<u8> &source, rewind_state &state);
+	bool decompress_state(const rewind_state &state, std::vector<u8> &dest);
+	save_error load_state(s32 index);
+	bool current_index_is_last() { return m_current_index == s32(m_state_list.size()) - 1; }
 	void report_error(save_error type, rewind_operation operation);
 
 public:
+	static constexpr u64 NO_POSITION = ~u64(0);
+
 	rewinder(save_manager &save);
 	bool enabled() { return m_enabled; }
 	void clamp_capacity();
 	void invalidate();
-	bool capture();
+	bool capture(u64 position = NO_POSITION);
 	bool step();
+
+	// positioned states, used by the debugger for reverse execution
+	u64 state_before(u64 position) const { const s32 index = find_before(position); return (index != REWIND_INDEX_NONE) ? m_state_list[index].position : NO_POSITION; }
+	bool seek(u64 position, u64 &found);
 };
 
 
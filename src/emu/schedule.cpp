@@ -10,6 +10,9 @@
 
 #include "emu.h"
 #include "debugger.h"
+#include "fileio.h"
+
+#include <algorithm>
 
 //**************************************************************************
 //  DEBUGGING
@@ -34,6 +37,158 @@ enum
 	TRIGGER_SUSPENDTIME = -4000
 };
 
+// number of events that can be posted between timeslices without allocating
+constexpr u32 POST_RING_SIZE = 256;
+
+// number of timeslices executed serially after a worker thread touches the timer lists
+constexpr int PARALLEL_FALLBACK_SLICES = 16;
+
+// number of children per node in the active timer heap
+constexpr u32 TIMER_HEAP_ARITY = 4;
+
+
+
+//**************************************************************************
+//  SCHEDULER TRACING
+//**************************************************************************
+
+/*
+    Trace files are little-endian and laid out as follows:
+
+    header (32 bytes)
+        char[8]     magic "MAMESTRC"
+        u32         version (1)
+        u32         record size (24)
+        u32         number of device tags
+        u32         number of timer names
+        u64         number of records
+
+    device tags, then timer names
+        u16         length in bytes
+        char[]      UTF-8 text, not terminated
+
+    records (24 bytes each, oldest first)
+        u8          event type (trace_event)
+        u8          reserved (0)
+        u16         device or timer name index
+        u32         seconds
+        u64         attoseconds
+        u64         event-specific value
+
+    See src/tools/schedtrace.cpp for a converter to Chrome trace JSON.
+*/
+
+class device_scheduler::trace_recorder
+{
+public:
+	trace_recorder(std::string_view filename, u32 capacity) :
+		m_filename(filename),
+		m_records(std::max<u32>(capacity, 1)),
+		m_next(0),
+		m_count(0)
+	{
+	}
+
+	// add a record, overwriting the oldest once the ring is full
+	void add(trace_event type, u16 index, const attotime &time, u64 value) noexcept
+	{
+		record &rec = m_records[m_next];
+		rec.type = u8(type);
+		rec.index = index;
+		rec.seconds = u32(time.seconds());
+		rec.attoseconds = u64(time.attoseconds());
+		rec.value = value;
+		if (++m_next == m_records.size())
+			m_next = 0;
+		if (m_count < m_records.size())
+			m_count++;
+	}
+
+	// get the index for a timer callback name
+	u16 name_index(const char *name)
+	{
+		auto const found = m_name_map.find(name);
+		if (found != m_name_map.end())
+			return found->second;
+		u16 const index = u16(m_names.size());
+		m_names.emplace_back(name ? name : "unnamed");
+		m_name_map.emplace(name, index);
+		return index;
+	}
+
+	// write everything out
+	std::error_condition write(running_machine &machine) const
+	{
+		std::vector<std::string> tags;
+		for (device_t &device : device_enumerator(machine.root_device()))
+			tags.emplace_back(device.tag());
+
+		std::vector<u8> data;
+		auto const put = [&data] (u64 value, int bytes)
+		{
+			for (int i = 0; i < bytes; i++)
+				data.push_back(u8(value >> (i * 8)));
+		};
+		auto const put_string = [&data, &put] (std::string_view str)
+		{
+			str = str.substr(0, 0xffff);
+			put(str.length(), 2);
+			data.insert(data.end(), str.begin(), str.end());
+		};
+
+		for (char ch : std::string_view("MAMESTRC"))
+			data.push_back(u8(ch));
+		put(1, 4);
+		put(24, 4);
+		put(tags.size(), 4);
+		put(m_names.size(), 4);
+		put(m_count, 8);
+		for (std::string const &tag : tags)
+			put_string(tag);
+		for (std::string const &name : m_names)
+			put_string(name);
+
+		size_t index = (m_count < m_records.size()) ? 0 : m_next;
+		for (size_t i = 0; i < m_count; i++)
+		{
+			record const &rec = m_records[index];
+			put(rec.type, 1);
+			put(0, 1);
+			put(rec.index, 2);
+			put(rec.seconds, 4);
+			put(rec.attoseconds, 8);
+			put(rec.value, 8);
+			if (++index == m_records.size())
+				index = 0;
+		}
+
+		emu_file file(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		std::error_condition const filerr = file.open(m_filename);
+		if (filerr)
+			return filerr;
+		if (file.write(&data[0], data.size()) != data.size())
+			return std::errc::io_error;
+		return std::error_condition();
+	}
+
+private:
+	struct record
+	{
+		u8              type;
+		u16             index;
+		u32             seconds;
+		u64             attoseconds;
+		u64             value;
+	};
+
+	std::string const                       m_filename;
+	std::vector<record>                     m_records;
+	size_t                                  m_next;
+	size_t                                  m_count;
+	std::vector<std::string>                m_names;
+	std::unordered_map<const char *, u16>   m_name_map;
+};
+
 
 
 //**************************************************************************
@@ -48,6 +203,8 @@ inline emu_timer::emu_timer() noexcept :
 	m_scheduler(nullptr),
 	m_next(nullptr),
 	m_prev(nullptr),
+	m_heap_index(NOT_QUEUED),
+	m_sequence(0),
 	m_param(0),
 	m_enabled(false),
 	m_temporary(false),
@@ -83,6 +240,7 @@ inline emu_timer &emu_timer::init(
 	m_scheduler = &machine.scheduler();
 	m_next = nullptr;
 	m_prev = nullptr;
+	m_heap_index = NOT_QUEUED;
 	m_callback = std::move(callback);
 	m_param = param;
 	m_temporary = temporary;
@@ -98,7 +256,7 @@ inline emu_timer &emu_timer::init(
 
 	// insert into the list
 	m_scheduler->timer_list_insert(*this);
-	if (this == m_scheduler->first_timer())
+	if (m_heap_index == 0)
 		m_scheduler->abort_timeslice();
 
 	return *this;
@@ -112,6 +270,7 @@ inline emu_timer &emu_timer::init(
 bool emu_timer::enable(bool enable) noexcept
 {
 	assert(m_scheduler);
+	const auto lock = m_scheduler->parallel_lock();
 
 	// reschedule only if the state has changed
 	const bool old = m_enabled;
@@ -120,9 +279,8 @@ bool emu_timer::enable(bool enable) noexcept
 		// set the enable flag
 		m_enabled = enable;
 
-		// remove the timer and insert back into the list
-		m_scheduler->timer_list_remove(*this);
-		m_scheduler->timer_list_insert(*this);
+		// move the timer between the active heap and the inactive list
+		m_scheduler->timer_list_update(*this);
 	}
 	return old;
 }
@@ -137,6 +295,7 @@ bool emu_timer::enable(bool enable) noexcept
 void emu_timer::adjust(attotime start_delay, s32 param, const attotime &period) noexcept
 {
 	assert(m_scheduler);
+	const auto lock = m_scheduler->parallel_lock();
 
 	// if this is the callback timer, mark it modified
 	if (m_scheduler->m_callback_timer == this)
@@ -155,12 +314,11 @@ void emu_timer::adjust(attotime start_delay, s32 param, const attotime &period)
 	m_enabled = true;
 	m_period = period;
 
-	// remove and re-insert the timer in its new order
-	m_scheduler->timer_list_remove(*this);
-	m_scheduler->timer_list_insert(*this);
+	// move the timer to its new position
+	m_scheduler->timer_list_update(*this);
 
 	// if this was inserted as the head, abort the current timeslice and resync
-	if (this == m_scheduler->first_timer())
+	if (m_heap_index == 0)
 		m_scheduler->abort_timeslice();
 }
 
@@ -204,7 +362,7 @@ void emu_timer::register_save(save_manager &manager)
 	// determine our instance number - timers are indexed based on the callback function name
 	int index = 0;
 	std::string name = m_callback.name() ? m_callback.name() : "unnamed";
-	for (const emu_timer *curtimer = m_scheduler->first_timer(); curtimer; curtimer = curtimer->m_next)
+	for (const emu_timer *curtimer : m_scheduler->m_timer_heap)
 	{
 		if (!curtimer->m_temporary)
 		{
@@ -246,9 +404,8 @@ inline void emu_timer::schedule_next_period() noexcept
 	m_start = m_expire;
 	m_expire += m_period;
 
-	// remove and re-insert us
-	m_scheduler->timer_list_remove(*this);
-	m_scheduler->timer_list_insert(*this);
+	// move us to our new position
+	m_scheduler->timer_list_update(*this);
 }
 
 
@@ -274,6 +431,9 @@ void emu_timer::dump() const
 //  DEVICE SCHEDULER
 //**************************************************************************
 
+thread_local device_execute_interface *device_scheduler::s_domain_executing = nullptr;
+
+
 //-------------------------------------------------
 //  device_scheduler - constructor
 //-------------------------------------------------
@@ -283,21 +443,40 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_executing_device(nullptr),
 	m_execute_list(nullptr),
 	m_basetime(attotime::zero),
-	m_timer_list(nullptr),
+	m_timer_sequence(0),
 	m_inactive_timers(nullptr),
 	m_callback_timer(nullptr),
 	m_callback_timer_modified(false),
 	m_callback_timer_expire_time(attotime::zero),
 	m_suspend_changes_pending(true),
-	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
+	m_post_ring(std::make_unique<posted_slot []>(POST_RING_SIZE)),
+	m_post_tail(0),
+	m_post_head(0),
+	m_posted_events(nullptr),
+	m_trace_exit_registered(false),
+	m_domain_queue(nullptr),
+	m_parallel_active(false),
+	m_serial_slices(0),
+	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000),
+	m_adaptive_minimum(0),
+	m_adaptive_current(0),
+	m_timeslices(0),
+	m_quantum_shrinks(0),
+	m_host_timing(false)
 {
-	// append a single never-expiring timer so there is always one in the list
+	// each ring slot starts out ready for the first pass
+	for (u32 index = 0; index < POST_RING_SIZE; index++)
+		m_post_ring[index].m_sequence.store(index, std::memory_order_relaxed);
+
+	// append a single never-expiring timer so there is always one in the heap
 	// need to subvert it because it would naturally be inserted in the inactive list
-	m_timer_list = &timer_list_remove(m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), attotime::never, 0, true));
+	emu_timer &sentinel = timer_list_remove(m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), attotime::never, 0, true));
+	sentinel.m_sequence = m_timer_sequence++;
+	sentinel.m_heap_index = 0;
+	m_timer_heap.push_back(&sentinel);
 
-	assert(m_timer_list);
-	assert(!m_timer_list->m_prev);
-	assert(!m_timer_list->m_next);
+	assert(!sentinel.m_prev);
+	assert(!sentinel.m_next);
 	assert(!m_inactive_timers);
 
 	// register global states
@@ -313,11 +492,19 @@ device_scheduler::device_scheduler(running_machine &machine) :
 
 device_scheduler::~device_scheduler()
 {
+	// release the worker queue
+	if (m_domain_queue)
+		osd_work_queue_free(m_domain_queue);
+
+	// discard anything that was posted but never run
+	for (posted_event *event = m_posted_events.exchange(nullptr); event; )
+		delete std::exchange(event, event->m_next);
+
 	// remove all timers
 	while (m_inactive_timers)
 		m_timer_allocator.reclaim(timer_list_remove(*m_inactive_timers));
-	while (m_timer_list)
-		m_timer_allocator.reclaim(timer_list_remove(*m_timer_list));
+	while (!m_timer_heap.empty())
+		m_timer_allocator.reclaim(timer_list_remove(*m_timer_heap.back()));
 }
 
 
@@ -333,7 +520,8 @@ attotime device_scheduler::time() const noexcept
 
 	// if we're executing as a particular CPU, use its local time as a base
 	// otherwise, return the global base time
-	return (m_executing_device != nullptr) ? m_executing_device->local_time() : m_basetime;
+	device_execute_interface *const executing = currently_executing();
+	return (executing != nullptr) ? executing->local_time() : m_basetime;
 }
 
 
@@ -345,7 +533,7 @@ attotime device_scheduler::time() const noexcept
 bool device_scheduler::can_save() const
 {
 	// if any live temporary timers exit, fail
-	for (emu_timer *timer = m_timer_list; timer; timer = timer->m_next)
+	for (emu_timer *timer : m_timer_heap)
 	{
 		if (timer->m_temporary && !timer->expire().is_never())
 		{
@@ -384,6 +572,175 @@ inline void device_scheduler::apply_suspend_changes()
 }
 
 
+//-------------------------------------------------
+//  execute_device - execute a single device up to
+//  the given target, pulling the target back if
+//  the device stopped short of it
+//-------------------------------------------------
+
+inline void device_scheduler::execute_device(device_execute_interface &exec, attotime &target, bool call_debugger, bool profile)
+{
+	// only process if this CPU is executing or truly halted (not yielding)
+	// and if our target is later than the CPU's current time (coarse check)
+	if (EXPECTED((exec.m_suspend == 0 || exec.m_eatcycles) && target.seconds() >= exec.m_localtime.seconds()))
+	{
+		// compute how many attoseconds to execute this CPU
+		attoseconds_t delta = target.attoseconds() - exec.m_localtime.attoseconds();
+		if (delta < 0 && target.seconds() > exec.m_localtime.seconds())
+			delta += ATTOSECONDS_PER_SECOND;
+		assert(delta == (target - exec.m_localtime).as_attoseconds());
+
+		if (exec.m_attoseconds_per_cycle == 0)
+		{
+			exec.m_localtime = target;
+		}
+		// if we have enough for at least 1 cycle, do the math
+		else if (delta >= exec.m_attoseconds_per_cycle)
+		{
+			// compute how many cycles we want to execute
+			int ran = exec.m_cycles_running = divu_64x32(u64(delta) >> exec.m_divshift, exec.m_divisor);
+			LOG("  cpu '%s': %d (%d cycles)\n", exec.device().tag(), delta, exec.m_cycles_running);
+
+			// if we're not suspended, actually execute
+			if (exec.m_suspend == 0)
+			{
+				if (profile)
+					g_profiler.start(exec.m_profiler);
+
+				// note that this global variable cycles_stolen can be modified
+				// via the call to cpu_execute
+				exec.m_cycles_stolen = 0;
+				if (m_parallel_active)
+					s_domain_executing = &exec;
+				else
+					m_executing_device = &exec;
+				*exec.m_icountptr = exec.m_cycles_running;
+				osd_ticks_t const host_start = UNEXPECTED(m_host_timing) ? osd_ticks() : 0;
+				if (!call_debugger)
+					exec.run();
+				else
+				{
+					exec.debugger_start_cpu_hook(target);
+					exec.run();
+					exec.debugger_stop_cpu_hook();
+				}
+				if (UNEXPECTED(m_host_timing))
+					exec.m_host_ticks += osd_ticks() - host_start;
+
+				// adjust for any cycles we took back
+				assert(ran >= *exec.m_icountptr);
+				ran -= *exec.m_icountptr;
+				assert(ran >= exec.m_cycles_stolen);
+				ran -= exec.m_cycles_stolen;
+				if (profile)
+					g_profiler.stop();
+			}
+
+			// account for these cycles
+			exec.m_totalcycles += ran;
+
+			// update the local time for this CPU
+			attotime deltatime;
+			if (ran < exec.m_cycles_per_second)
+				deltatime = attotime(0, exec.m_attoseconds_per_cycle * ran);
+			else
+			{
+				u32 remainder;
+				s32 secs = divu_64x32_rem(ran, exec.m_cycles_per_second, remainder);
+				deltatime = attotime(secs, u64(remainder) * exec.m_attoseconds_per_cycle);
+			}
+			assert(deltatime >= attotime::zero);
+			if (UNEXPECTED(m_trace))
+				trace(trace_event::EXECUTE, exec.m_profiler - PROFILER_DEVICE_FIRST, exec.m_localtime, deltatime.as_attoseconds());
+			exec.m_localtime += deltatime;
+			LOG("         %d ran, %d total, time = %s\n", ran, s32(exec.m_totalcycles), exec.m_localtime.as_string(PRECISION));
+
+			// if the new local CPU time is less than our target, move the target up, but not before the base
+			if (exec.m_localtime < target)
+			{
+				target = std::max(exec.m_localtime, m_basetime);
+				LOG("         (new target)\n");
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  execute_domains - execute the main thread's
+//  devices while worker threads execute the other
+//  domains, then rendezvous at the earliest time
+//  reached by any of them
+//-------------------------------------------------
+
+void device_scheduler::execute_domains(attotime &target)
+{
+	// hand each worker domain the same target
+	for (execution_domain &domain : m_domains)
+		domain.m_target = target;
+
+	m_parallel_active = true;
+	osd_work_item_queue_multiple(m_domain_queue, &device_scheduler::execute_domain_callback, m_domains.size(), &m_domains[0], sizeof(m_domains[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+
+	// run everything that lives in the main domain on this thread
+	for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+		if (exec->m_execution_domain == 0)
+			execute_device(*exec, target, false, true);
+	s_domain_executing = nullptr;
+
+	// wait for the workers to reach the quantum boundary; they can't be
+	// abandoned because they're still using the devices
+	while (!osd_work_queue_wait(m_domain_queue, osd_ticks_per_second())) { }
+	m_parallel_active = false;
+
+	// the slice ends at the earliest time reached by any domain
+	for (execution_domain const &domain : m_domains)
+		target = std::min(target, domain.m_target);
+}
+
+
+//-------------------------------------------------
+//  execute_domain_callback - work item callback
+//  that executes a single domain's devices
+//-------------------------------------------------
+
+void *device_scheduler::execute_domain_callback(void *param, int threadid)
+{
+	execution_domain &domain = *reinterpret_cast<execution_domain *>(param);
+	for (device_execute_interface *exec : domain.m_devices)
+		domain.m_scheduler->execute_device(*exec, domain.m_target, false, false);
+	s_domain_executing = nullptr;
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  parallel_lock - acquire the timer list lock if
+//  domains are executing concurrently; a timer
+//  operation from a worker domain, or a handshake
+//  from any domain, ends the caller's timeslice
+//  at that point and forces the following
+//  timeslices to execute serially so the domains
+//  see a consistent ordering
+//-------------------------------------------------
+
+std::unique_lock<std::mutex> device_scheduler::parallel_lock(bool handshake) noexcept
+{
+	if (!m_parallel_active)
+		return std::unique_lock<std::mutex>();
+
+	// the main domain's own timers are only consumed between timeslices,
+	// so they don't need the fallback
+	device_execute_interface *const exec = s_domain_executing;
+	if (exec && (handshake || (exec->m_execution_domain != 0)))
+	{
+		m_serial_slices.store(PARALLEL_FALLBACK_SLICES, std::memory_order_relaxed);
+		exec->abort_timeslice();
+	}
+	return std::unique_lock<std::mutex>(m_parallel_mutex);
+}
+
+
 //-------------------------------------------------
 //  timeslice - execute all devices for a single
 //  timeslice
@@ -397,103 +754,58 @@ void device_scheduler::timeslice()
 	if (UNEXPECTED(m_execute_list == nullptr))
 		rebuild_execute_list();
 
+	// pick up anything other threads have posted
+	if (UNEXPECTED(posted_events_pending()))
+		drain_posted_events();
+
 	// if the current quantum has expired, find a new one
 	while (m_basetime >= m_quantum_list.first()->m_expire)
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < first_timer()->m_expire)
 	{
 		// by default, assume our target is the end of the next quantum
-		attotime target(m_basetime + attotime(0, m_quantum_list.first()->m_actual));
+		attoseconds_t quantum = m_quantum_list.first()->m_actual;
+		if (m_adaptive_minimum != 0)
+		{
+			// devices recently interacted, so shrink the quantum, then widen it again each slice they don't
+			if (m_adaptive_current < quantum)
+			{
+				quantum = m_adaptive_current;
+				m_adaptive_current *= 2;
+				m_quantum_shrinks++;
+			}
+		}
+		attotime target(m_basetime + attotime(0, quantum));
+		m_timeslices++;
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (first_timer()->m_expire < target)
+			target = first_timer()->m_expire;
 
 		LOG("------------------\n");
 		LOG("cpu_timeslice: target = %s\n", target.as_string(PRECISION));
+		if (UNEXPECTED(m_trace))
+			trace(trace_event::TIMESLICE, 0, m_basetime, (target - m_basetime).as_attoseconds());
 
 		// do we have pending suspension changes?
 		if (m_suspend_changes_pending)
 			apply_suspend_changes();
 
-		// loop over all CPUs
-		for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+		// run the worker thread domains alongside the main thread where possible
+		if (m_domain_queue && !m_domains.empty() && !call_debugger && !m_trace && (m_serial_slices.load(std::memory_order_relaxed) == 0))
 		{
-			// only process if this CPU is executing or truly halted (not yielding)
-			// and if our target is later than the CPU's current time (coarse check)
-			if (EXPECTED((exec->m_suspend == 0 || exec->m_eatcycles) && target.seconds() >= exec->m_localtime.seconds()))
-			{
-				// compute how many attoseconds to execute this CPU
-				attoseconds_t delta = target.attoseconds() - exec->m_localtime.attoseconds();
-				if (delta < 0 && target.seconds() > exec->m_localtime.seconds())
-					delta += ATTOSECONDS_PER_SECOND;
-				assert(delta == (target - exec->m_localtime).as_attoseconds());
+			execute_domains(target);
+		}
+		else
+		{
+			if (m_serial_slices.load(std::memory_order_relaxed) != 0)
+				m_serial_slices.fetch_sub(1, std::memory_order_relaxed);
 
-				if (exec->m_attoseconds_per_cycle == 0)
-				{
-					exec->m_localtime = target;
-				}
-				// if we have enough for at least 1 cycle, do the math
-				else if (delta >= exec->m_attoseconds_per_cycle)
-				{
-					// compute how many cycles we want to execute
-					int ran = exec->m_cycles_running = divu_64x32(u64(delta) >> exec->m_divshift, exec->m_divisor);
-					LOG("  cpu '%s': %d (%d cycles)\n", exec->device().tag(), delta, exec->m_cycles_running);
-
-					// if we're not suspended, actually execute
-					if (exec->m_suspend == 0)
-					{
-						g_profiler.start(exec->m_profiler);
-
-						// note that this global variable cycles_stolen can be modified
-						// via the call to cpu_execute
-						exec->m_cycles_stolen = 0;
-						m_executing_device = exec;
-						*exec->m_icountptr = exec->m_cycles_running;
-						if (!call_debugger)
-							exec->run();
-						else
-						{
-							exec->debugger_start_cpu_hook(target);
-							exec->run();
-							exec->debugger_stop_cpu_hook();
-						}
-
-						// adjust for any cycles we took back
-						assert(ran >= *exec->m_icountptr);
-						ran -= *exec->m_icountptr;
-						assert(ran >= exec->m_cycles_stolen);
-						ran -= exec->m_cycles_stolen;
-						g_profiler.stop();
-					}
-
-					// account for these cycles
-					exec->m_totalcycles += ran;
-
-					// update the local time for this CPU
-					attotime deltatime;
-					if (ran < exec->m_cycles_per_second)
-						deltatime = attotime(0, exec->m_attoseconds_per_cycle * ran);
-					else
-					{
-						u32 remainder;
-						s32 secs = divu_64x32_rem(ran, exec->m_cycles_per_second, remainder);
-						deltatime = attotime(secs, u64(remainder) * exec->m_attoseconds_per_cycle);
-					}
-					assert(deltatime >= attotime::zero);
-					exec->m_localtime += deltatime;
-					LOG("         %d ran, %d total, time = %s\n", ran, s32(exec->m_totalcycles), exec->m_localtime.as_string(PRECISION));
-
-					// if the new local CPU time is less than our target, move the target up, but not before the base
-					if (exec->m_localtime < target)
-					{
-						target = std::max(exec->m_localtime, m_basetime);
-						LOG("         (new target)\n");
-					}
-				}
-			}
+			// loop over all CPUs
+			for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
+				execute_device(*exec, target, call_debugger, true);
 		}
 		m_executing_device = nullptr;
 
@@ -513,8 +825,9 @@ void device_scheduler::timeslice()
 
 void device_scheduler::abort_timeslice() noexcept
 {
-	if (m_executing_device != nullptr)
-		m_executing_device->abort_timeslice();
+	device_execute_interface *const executing = currently_executing();
+	if (executing != nullptr)
+		executing->abort_timeslice();
 }
 
 
@@ -528,6 +841,9 @@ void device_scheduler::trigger(int trigid, const attotime &after)
 	if (m_execute_list == nullptr)
 		rebuild_execute_list();
 
+	if (UNEXPECTED(m_trace))
+		trace(trace_event::TRIGGER, 0, time(), u64(s64(trigid)));
+
 	if (after != attotime::zero)
 	{
 		// if we have a non-zero time, schedule a timer
@@ -604,6 +920,7 @@ void device_scheduler::perfect_quantum(const attotime &duration)
 
 emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback)
 {
+	const auto lock = parallel_lock();
 	return &m_timer_allocator.alloc()->init(machine(), std::move(callback), attotime::never, 0, false);
 }
 
@@ -616,6 +933,7 @@ emu_timer *device_scheduler::timer_alloc(timer_expired_delegate callback)
 
 void device_scheduler::timer_set(const attotime &duration, timer_expired_delegate callback, int param)
 {
+	const auto lock = parallel_lock();
 	[[maybe_unused]] emu_timer &timer = m_timer_allocator.alloc()->init(
 			machine(),
 			std::move(callback),
@@ -633,6 +951,8 @@ void device_scheduler::timer_set(const attotime &duration, timer_expired_delegat
 
 void device_scheduler::synchronize(timer_expired_delegate callback, int param)
 {
+	const auto lock = parallel_lock(true);
+	note_interaction();
 	m_timer_allocator.alloc()->init(
 			machine(),
 			std::move(callback),
@@ -642,6 +962,107 @@ void device_scheduler::synchronize(timer_expired_delegate callback, int param)
 }
 
 
+//-------------------------------------------------
+//  post - queue a callback to run on the
+//  emulation thread at the given time or the next
+//  timeslice boundary, whichever is later; this
+//  is lock-free and may be called from any thread
+//-------------------------------------------------
+
+void device_scheduler::post(timer_expired_delegate callback, s32 param, const attotime &when)
+{
+	// claim the next free ring slot
+	u32 pos = m_post_tail.load(std::memory_order_relaxed);
+	while (true)
+	{
+		posted_slot &slot = m_post_ring[pos % POST_RING_SIZE];
+		s32 const diff = s32(slot.m_sequence.load(std::memory_order_acquire) - pos);
+		if (!diff)
+		{
+			if (m_post_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				slot.m_event.m_callback = std::move(callback);
+				slot.m_event.m_param = param;
+				slot.m_event.m_when = when;
+				slot.m_sequence.store(pos + 1, std::memory_order_release);
+				return;
+			}
+		}
+		else if (diff < 0)
+		{
+			break;
+		}
+		else
+		{
+			pos = m_post_tail.load(std::memory_order_relaxed);
+		}
+	}
+
+	// the ring is full, so this one has to be allocated; it runs after
+	// everything already in the ring
+	posted_event *const event = new posted_event{ nullptr, std::move(callback), param, when };
+	event->m_next = m_posted_events.load(std::memory_order_relaxed);
+	while (!m_posted_events.compare_exchange_weak(event->m_next, event, std::memory_order_release, std::memory_order_relaxed)) { }
+}
+
+
+//-------------------------------------------------
+//  posted_events_pending - check whether anything
+//  has been posted since the last drain
+//-------------------------------------------------
+
+bool device_scheduler::posted_events_pending() const noexcept
+{
+	return (m_post_ring[m_post_head % POST_RING_SIZE].m_sequence.load(std::memory_order_relaxed) == (m_post_head + 1)) ||
+			(m_posted_events.load(std::memory_order_relaxed) != nullptr);
+}
+
+
+//-------------------------------------------------
+//  drain_posted_events - turn events posted by
+//  other threads into timers, in posting order
+//-------------------------------------------------
+
+void device_scheduler::drain_posted_events()
+{
+	// consume the ring up to the first slot that isn't fully written yet
+	while (true)
+	{
+		posted_slot &slot = m_post_ring[m_post_head % POST_RING_SIZE];
+		if (slot.m_sequence.load(std::memory_order_acquire) != (m_post_head + 1))
+			break;
+
+		posted_event &event = slot.m_event;
+		attotime const delay = (event.m_when > m_basetime) ? (event.m_when - m_basetime) : attotime::zero;
+		m_timer_allocator.alloc()->init(machine(), std::move(event.m_callback), delay, event.m_param, true);
+		event.m_callback = timer_expired_delegate();
+
+		// hand the slot back for the next pass around the ring
+		slot.m_sequence.store(m_post_head + POST_RING_SIZE, std::memory_order_release);
+		m_post_head++;
+	}
+
+	// take the whole overflow stack at once and reverse it
+	posted_event *events = m_posted_events.exchange(nullptr, std::memory_order_acquire);
+	posted_event *ordered = nullptr;
+	while (events)
+	{
+		posted_event *const event = events;
+		events = event->m_next;
+		event->m_next = ordered;
+		ordered = event;
+	}
+
+	// schedule each one relative to the current time
+	while (ordered)
+	{
+		std::unique_ptr<posted_event> const event(std::exchange(ordered, ordered->m_next));
+		attotime const delay = (event->m_when > m_basetime) ? (event->m_when - m_basetime) : attotime::zero;
+		m_timer_allocator.alloc()->init(machine(), std::move(event->m_callback), delay, event->m_param, true);
+	}
+}
+
+
 //-------------------------------------------------
 //  eat_all_cycles - eat a ton of cycles on all
 //  CPUs to force a quick exit
@@ -686,46 +1107,48 @@ void device_scheduler::presave()
 void device_scheduler::postload()
 {
 	// remove all timers and make a private list of permanent ones
-	emu_timer *private_list = nullptr;
+	std::vector<emu_timer *> private_list;
+	private_list.reserve(m_timer_heap.size());
 	while (m_inactive_timers)
 	{
 		emu_timer &timer = *m_inactive_timers;
 		assert(!timer.m_temporary);
 
-		timer_list_remove(timer).m_next = private_list;
-		private_list = &timer;
+		private_list.push_back(&timer_list_remove(timer));
 	}
-	while (m_timer_list->m_next)
+	emu_timer *sentinel = nullptr;
+	while (!m_timer_heap.empty())
 	{
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = timer_list_remove(*m_timer_heap.back());
 
 		if (timer.m_temporary)
 		{
-			assert(!timer.expire().is_never());
-
 			// temporary timers go away entirely (except our special never-expiring one)
-			m_timer_allocator.reclaim(timer_list_remove(timer));
+			if (timer.expire().is_never())
+				sentinel = &timer;
+			else
+				m_timer_allocator.reclaim(timer);
 		}
 		else
 		{
 			// permanent ones get added to our private list
-			timer_list_remove(timer).m_next = private_list;
-			private_list = &timer;
+			private_list.push_back(&timer);
 		}
 	}
 
 	// special dummy timer
-	assert(!m_timer_list->m_enabled);
-	assert(m_timer_list->m_temporary);
-	assert(m_timer_list->m_expire.is_never());
+	assert(sentinel);
+	assert(!sentinel->m_enabled);
+	sentinel->m_heap_index = 0;
+	m_timer_heap.push_back(sentinel);
 
 	// now re-insert them; this effectively re-sorts them by time
-	while (private_list)
-	{
-		emu_timer &timer = *private_list;
-		private_list = timer.m_next;
-		timer_list_insert(timer);
-	}
+	std::sort(
+			private_list.begin(),
+			private_list.end(),
+			[] (emu_timer const *a, emu_timer const *b) { return timer_heap_before(*a, *b); });
+	for (emu_timer *timer : private_list)
+		timer_list_insert(*timer);
 
 	m_suspend_changes_pending = true;
 	rebuild_execute_list();
@@ -802,6 +1225,11 @@ void device_scheduler::rebuild_execute_list()
 
 		// inform the timer system of our decision
 		add_quantum(min_quantum, attotime::never);
+
+		// pick up the adaptive quantum limit if the system wants one
+		attotime const &adaptive = machine().config().adaptive_quantum();
+		m_adaptive_minimum = adaptive.is_zero() ? 0 : std::max(adaptive.attoseconds(), m_quantum_minimum);
+		m_adaptive_current = min_quantum.attoseconds();
 	}
 
 	// start with an empty list
@@ -831,48 +1259,131 @@ void device_scheduler::rebuild_execute_list()
 
 	// append the suspend list to the end of the active list
 	*active_tailptr = suspend_list;
+
+	// regroup devices that have asked to execute on worker threads
+	rebuild_execution_domains();
 }
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  rebuild_execution_domains - group devices with
+//  non-zero execution domains, preserving the
+//  execute list order within each group
 //-------------------------------------------------
 
-inline emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+void device_scheduler::rebuild_execution_domains()
 {
-	// disabled timers never expire
-	if (!timer.m_expire.is_never() && timer.m_enabled)
+	std::map<int, std::vector<device_execute_interface *> > groups;
+	for (device_execute_interface *exec = m_execute_list; exec != nullptr; exec = exec->m_nextexec)
 	{
-		// loop over the timer list
-		emu_timer *prevtimer = nullptr;
-		for (emu_timer *curtimer = m_timer_list; curtimer; prevtimer = curtimer, curtimer = curtimer->m_next)
-		{
-			// if the current list entry expires after us, we should be inserted before it
-			if (curtimer->m_expire > timer.m_expire)
-			{
-				// link the new guy in before the current list entry
-				timer.m_prev = prevtimer;
-				timer.m_next = curtimer;
+		if (exec->m_execution_domain != 0)
+			groups[exec->m_execution_domain].push_back(exec);
+	}
 
-				if (prevtimer)
-					prevtimer->m_next = &timer;
-				else
-					m_timer_list = &timer;
+	m_domains.clear();
+	for (auto &group : groups)
+		m_domains.emplace_back(execution_domain{ this, std::move(group.second), attotime::zero });
 
-				curtimer->m_prev = &timer;
-				return timer;
-			}
+	// allocate the worker queue the first time we need it
+	if (!m_domains.empty() && !m_domain_queue)
+		m_domain_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+}
+
+
+//-------------------------------------------------
+//  timer_heap_before - returns true if the first
+//  timer should fire before the second; timers
+//  with equal expiry times fire in the order they
+//  were scheduled
+//-------------------------------------------------
+
+inline bool device_scheduler::timer_heap_before(const emu_timer &a, const emu_timer &b) noexcept
+{
+	if (a.m_expire != b.m_expire)
+		return a.m_expire < b.m_expire;
+	else
+		return a.m_sequence < b.m_sequence;
+}
+
+
+//-------------------------------------------------
+//  timer_heap_sift_up - move a timer towards the
+//  head of the heap until its parent is earlier
+//-------------------------------------------------
+
+inline void device_scheduler::timer_heap_sift_up(u32 index) noexcept
+{
+	emu_timer *const timer = m_timer_heap[index];
+	while (index > 0)
+	{
+		u32 const parent = (index - 1) / TIMER_HEAP_ARITY;
+		emu_timer *const parenttimer = m_timer_heap[parent];
+		if (!timer_heap_before(*timer, *parenttimer))
+			break;
+
+		m_timer_heap[index] = parenttimer;
+		parenttimer->m_heap_index = index;
+		index = parent;
+	}
+	m_timer_heap[index] = timer;
+	timer->m_heap_index = index;
+}
+
+
+//-------------------------------------------------
+//  timer_heap_sift_down - move a timer away from
+//  the head of the heap until all its children
+//  are later
+//-------------------------------------------------
+
+inline void device_scheduler::timer_heap_sift_down(u32 index) noexcept
+{
+	u32 const count = m_timer_heap.size();
+	emu_timer *const timer = m_timer_heap[index];
+	while (true)
+	{
+		// find the earliest child
+		u32 const first = (index * TIMER_HEAP_ARITY) + 1;
+		if (first >= count)
+			break;
+		u32 const last = std::min(first + TIMER_HEAP_ARITY, count);
+		u32 best = first;
+		for (u32 child = first + 1; child < last; child++)
+		{
+			if (timer_heap_before(*m_timer_heap[child], *m_timer_heap[best]))
+				best = child;
 		}
 
-		// need to insert after the last one
-		if (prevtimer)
-			prevtimer->m_next = &timer;
-		else
-			m_timer_list = &timer;
+		// stop if we're earlier than all of them
+		emu_timer *const childtimer = m_timer_heap[best];
+		if (!timer_heap_before(*childtimer, *timer))
+			break;
+
+		m_timer_heap[index] = childtimer;
+		childtimer->m_heap_index = index;
+		index = best;
+	}
+	m_timer_heap[index] = timer;
+	timer->m_heap_index = index;
+}
+
+
+//-------------------------------------------------
+//  timer_list_insert - insert a new timer into
+//  the heap, or the inactive list if it will
+//  never fire
+//-------------------------------------------------
 
-		timer.m_prev = prevtimer;
-		timer.m_next = nullptr;
+inline emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
+{
+	// disabled timers never expire
+	if (!timer.m_expire.is_never() && timer.m_enabled)
+	{
+		// add to the end of the heap and let it bubble up
+		timer.m_sequence = m_timer_sequence++;
+		timer.m_heap_index = m_timer_heap.size();
+		m_timer_heap.push_back(&timer);
+		timer_heap_sift_up(timer.m_heap_index);
 	}
 	else
 	{
@@ -891,46 +1402,88 @@ inline emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  heap or the inactive list
 //-------------------------------------------------
 
 inline emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 {
-	// remove it from the list
-	if (timer.m_prev)
-	{
-		timer.m_prev->m_next = timer.m_next;
-	}
-	else if (&timer == m_timer_list)
+	if (timer.m_heap_index != emu_timer::NOT_QUEUED)
 	{
-		m_timer_list = timer.m_next;
+		// fill the hole with the last timer in the heap and restore the ordering
+		u32 const index = timer.m_heap_index;
+		emu_timer *const last = m_timer_heap.back();
+		m_timer_heap.pop_back();
+		timer.m_heap_index = emu_timer::NOT_QUEUED;
+		if (last != &timer)
+		{
+			m_timer_heap[index] = last;
+			last->m_heap_index = index;
+			if ((index > 0) && timer_heap_before(*last, *m_timer_heap[(index - 1) / TIMER_HEAP_ARITY]))
+				timer_heap_sift_up(index);
+			else
+				timer_heap_sift_down(index);
+		}
 	}
 	else
 	{
-		assert(&timer == m_inactive_timers);
-		m_inactive_timers = timer.m_next;
-	}
+		// remove it from the inactive list
+		if (timer.m_prev)
+		{
+			timer.m_prev->m_next = timer.m_next;
+		}
+		else
+		{
+			assert(&timer == m_inactive_timers);
+			m_inactive_timers = timer.m_next;
+		}
 
-	if (timer.m_next)
-		timer.m_next->m_prev = timer.m_prev;
+		if (timer.m_next)
+			timer.m_next->m_prev = timer.m_prev;
+	}
 
 	return timer;
 }
 
 
+//-------------------------------------------------
+//  timer_list_update - move a timer to the right
+//  place after its expiry time or enable state
+//  changed
+//-------------------------------------------------
+
+inline emu_timer &device_scheduler::timer_list_update(emu_timer &timer)
+{
+	if ((timer.m_heap_index != emu_timer::NOT_QUEUED) && !timer.m_expire.is_never() && timer.m_enabled)
+	{
+		// still active - reorder in place, behind any timers already due at the same time
+		u32 const index = timer.m_heap_index;
+		timer.m_sequence = m_timer_sequence++;
+		if ((index > 0) && timer_heap_before(timer, *m_timer_heap[(index - 1) / TIMER_HEAP_ARITY]))
+			timer_heap_sift_up(index);
+		else
+			timer_heap_sift_down(index);
+		return timer;
+	}
+	else
+	{
+		return timer_list_insert(timer_list_remove(timer));
+	}
+}
+
+
 //-------------------------------------------------
 //  execute_timers - execute timers that are due
 //-------------------------------------------------
 
 inline void device_scheduler::execute_timers()
 {
-	LOG("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), m_timer_list->m_expire.as_string(PRECISION));
+	LOG("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(PRECISION), first_timer()->m_expire.as_string(PRECISION));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (first_timer()->m_expire <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = *first_timer();
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -943,7 +1496,10 @@ inline void device_scheduler::execute_timers()
 		// call the callback
 		if (was_enabled)
 		{
-			g_profiler.start(PROFILER_TIMER_CALLBACK);
+			if (UNEXPECTED(m_trace))
+				trace(trace_event::TIMER, m_trace->name_index(timer.m_callback.name()), timer.m_expire, u64(s64(timer.m_param)));
+
+			g_profiler.start(PROFILER_TIMER_CALLBACK, timer.m_callback.name());
 
 			if (!timer.m_callback.isnull())
 			{
@@ -975,6 +1531,63 @@ inline void device_scheduler::execute_timers()
 }
 
 
+//-------------------------------------------------
+//  start_trace - begin recording scheduler
+//  activity into a ring buffer of the given
+//  number of records
+//-------------------------------------------------
+
+void device_scheduler::start_trace(std::string_view filename, u32 capacity)
+{
+	stop_trace();
+	m_trace = std::make_unique<trace_recorder>(filename, capacity);
+
+	// make sure the trace gets written if the machine exits first
+	if (!m_trace_exit_registered)
+	{
+		machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&device_scheduler::trace_exit, this));
+		m_trace_exit_registered = true;
+	}
+}
+
+
+//-------------------------------------------------
+//  stop_trace - stop recording and write the
+//  trace file
+//-------------------------------------------------
+
+void device_scheduler::stop_trace()
+{
+	if (m_trace)
+	{
+		std::error_condition const filerr = m_trace->write(machine());
+		if (filerr)
+			osd_printf_error("Error writing scheduler trace (%s:%d %s)\n", filerr.category().name(), filerr.value(), filerr.message());
+		m_trace.reset();
+	}
+}
+
+
+//-------------------------------------------------
+//  trace - add a record to the trace
+//-------------------------------------------------
+
+void device_scheduler::trace(trace_event type, u16 index, const attotime &time, u64 value) noexcept
+{
+	m_trace->add(type, index, time, value);
+}
+
+
+//-------------------------------------------------
+//  trace_exit - write the trace on machine exit
+//-------------------------------------------------
+
+void device_scheduler::trace_exit()
+{
+	stop_trace();
+}
+
+
 //-------------------------------------------------
 //  dump_timers - dump the current timer state
 //-------------------------------------------------
@@ -983,7 +1596,12 @@ void device_scheduler::dump_timers() const
 {
 	machine().logerror("=============================================\n");
 	machine().logerror("Timer Dump: Time = %15s\n", time().as_string(PRECISION));
-	for (emu_timer *timer = m_timer_list; timer; timer = timer->m_next)
+	std::vector<emu_timer *> active(m_timer_heap);
+	std::sort(
+			active.begin(),
+			active.end(),
+			[] (emu_timer const *a, emu_timer const *b) { return timer_heap_before(*a, *b); });
+	for (emu_timer *timer : active)
 		timer->dump();
 	for (emu_timer *timer = m_inactive_timers; timer; timer = timer->m_next)
 		timer->dump();
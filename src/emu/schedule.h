@@ -75,10 +75,15 @@ private:
 	void schedule_next_period() noexcept;
 	void dump() const;
 
+	// marker for timers that are not in the active heap
+	static constexpr u32 NOT_QUEUED = ~u32(0);
+
 	// internal state
 	device_scheduler *  m_scheduler;    // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the inactive list
+	emu_timer *         m_prev;         // previous timer in the inactive list
+	u32                 m_heap_index;   // position in the active heap, or NOT_QUEUED
+	u64                 m_sequence;     // insertion order, used to break ties between equal expiry times
 	timer_expired_delegate m_callback;  // callback function
 	s32                 m_param;        // integer parameter
 	bool                m_enabled;      // is the timer enabled?
@@ -108,8 +113,8 @@ public:
 	// getters
 	running_machine &machine() const noexcept { return m_machine; }
 	attotime time() const noexcept;
-	emu_timer *first_timer() const noexcept { return m_timer_list; }
-	device_execute_interface *currently_executing() const noexcept { return m_executing_device; }
+	emu_timer *first_timer() const noexcept { return m_timer_heap.front(); }
+	device_execute_interface *currently_executing() const noexcept { return m_parallel_active ? s_domain_executing : m_executing_device; }
 	bool can_save() const;
 
 	// execution
@@ -119,6 +124,14 @@ public:
 	void add_quantum(const attotime &quantum, const attotime &duration);
 	void perfect_quantum(const attotime &duration);
 	void suspend_resume_changed() { m_suspend_changes_pending = true; }
+	void note_interaction() noexcept { m_adaptive_current = m_adaptive_minimum; }
+
+	// statistics
+	u64 timeslices() const noexcept { return m_timeslices; }
+	u64 quantum_shrinks() const noexcept { return m_quantum_shrinks; }
+	bool adaptive_quantum_enabled() const noexcept { return m_adaptive_minimum != 0; }
+	attotime adaptive_quantum() const noexcept { return attotime(0, m_adaptive_current); }
+	void set_host_timing(bool enable) noexcept { m_host_timing = enable; }
 
 	// timers, specified by callback/name
 	emu_timer *timer_alloc(timer_expired_delegate callback);
@@ -126,8 +139,14 @@ public:
 	void timer_set(const attotime &duration, timer_expired_delegate callback, int param = 0);
 	void synchronize(timer_expired_delegate callback = timer_expired_delegate(), int param = 0);
 
+	// callbacks posted from other threads, run at the next timeslice boundary
+	void post(timer_expired_delegate callback, s32 param = 0, const attotime &when = attotime::zero);
+
 	// debugging
 	void dump_timers() const;
+	void start_trace(std::string_view filename, u32 capacity = 1 << 20);
+	void stop_trace();
+	bool tracing() const noexcept { return bool(m_trace); }
 
 	// for emergencies only!
 	void eat_all_cycles();
@@ -142,10 +161,56 @@ private:
 	void compute_perfect_interleave();
 	void rebuild_execute_list();
 	void apply_suspend_changes();
+	void execute_device(device_execute_interface &exec, attotime &target, bool call_debugger, bool profile);
+
+	// parallel execution domain helpers
+	struct execution_domain
+	{
+		device_scheduler *                      m_scheduler;    // owning scheduler
+		std::vector<device_execute_interface *> m_devices;      // devices in this domain, in execution order
+		attotime                                m_target;       // target for the current timeslice
+	};
+	void rebuild_execution_domains();
+	void execute_domains(attotime &target);
+	static void *execute_domain_callback(void *param, int threadid);
+	std::unique_lock<std::mutex> parallel_lock(bool handshake = false) noexcept;
+
+	// tracing
+	class trace_recorder;
+	enum class trace_event : u8
+	{
+		TIMESLICE = 1,  // time = slice start, value = slice length in attoseconds
+		EXECUTE,        // index = device, time = device local time, value = attoseconds executed
+		TIMER,          // index = timer name, time = expiry time, value = parameter
+		ABORT,          // index = device, time = device local time, value = cycles abandoned
+		TRIGGER         // time = current time, value = trigger ID
+	};
+	void trace(trace_event type, u16 index, const attotime &time, u64 value) noexcept;
+	void trace_exit();
+
+	// posted callbacks
+	struct posted_event
+	{
+		posted_event *          m_next;                     // next (older) event
+		timer_expired_delegate  m_callback;                 // callback function
+		s32                     m_param;                    // integer parameter
+		attotime                m_when;                     // earliest time to run at
+	};
+	struct posted_slot
+	{
+		std::atomic<u32>        m_sequence;                 // ring position this slot is ready for
+		posted_event            m_event;                    // the event itself
+	};
+	bool posted_events_pending() const noexcept;
+	void drain_posted_events();
 
 	// timer helpers
+	static bool timer_heap_before(const emu_timer &a, const emu_timer &b) noexcept;
+	void timer_heap_sift_up(u32 index) noexcept;
+	void timer_heap_sift_down(u32 index) noexcept;
 	emu_timer &timer_list_insert(emu_timer &timer);
 	emu_timer &timer_list_remove(emu_timer &timer);
+	emu_timer &timer_list_update(emu_timer &timer);
 	void execute_timers();
 
 	// internal state
@@ -154,8 +219,9 @@ private:
 	device_execute_interface *  m_execute_list;             // list of devices to be executed
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
-	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	// active timers, kept as a 4-ary min-heap ordered by expiry time
+	std::vector<emu_timer *>    m_timer_heap;               // active timer heap; the head is the next to expire
+	u64                         m_timer_sequence;           // sequence number for the next insertion
 	emu_timer *                 m_inactive_timers;          // head of the inactive timer list
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
@@ -165,6 +231,24 @@ private:
 	attotime                    m_callback_timer_expire_time; // the original expiration time
 	bool                        m_suspend_changes_pending;  // suspend/resume changes are pending
 
+	// events posted from other threads
+	std::unique_ptr<posted_slot []> m_post_ring;            // preallocated ring of posted events
+	std::atomic<u32>            m_post_tail;                // next ring position to claim for posting
+	u32                         m_post_head;                // next ring position to drain
+	std::atomic<posted_event *> m_posted_events;            // events that found the ring full, newest first
+
+	// binary trace of scheduler activity (null when not tracing)
+	std::unique_ptr<trace_recorder> m_trace;
+	bool                        m_trace_exit_registered;    // true once the exit notifier is registered
+
+	// parallel execution domains
+	std::vector<execution_domain> m_domains;                // domains executed on worker threads
+	osd_work_queue *            m_domain_queue;             // work queue for executing domains
+	bool                        m_parallel_active;          // true while domains are executing concurrently
+	std::atomic<int>            m_serial_slices;            // timeslices to execute serially after a cross-domain event
+	std::mutex                  m_parallel_mutex;           // protects the timer lists while domains are executing
+	static thread_local device_execute_interface *s_domain_executing; // device executing on the current thread
+
 	// scheduling quanta
 	class quantum_slot
 	{
@@ -181,6 +265,15 @@ private:
 	simple_list<quantum_slot>   m_quantum_list;             // list of active quanta
 	fixed_allocator<quantum_slot> m_quantum_allocator;      // allocator for quanta
 	attoseconds_t               m_quantum_minimum;          // duration of minimum quantum
+
+	// adaptive quantum
+	attoseconds_t               m_adaptive_minimum;         // smallest adaptive quantum (0 = disabled)
+	attoseconds_t               m_adaptive_current;         // current adaptive quantum
+
+	// statistics
+	u64                         m_timeslices;               // total timeslices executed
+	u64                         m_quantum_shrinks;          // timeslices shortened by interactions
+	bool                        m_host_timing;              // accumulate host time spent in each device
 };
 
 
@@ -15,11 +15,13 @@
 #include "fileio.h"
 #include "render.h"
 #include "rendutil.h"
+#include "tilemap.h"
 
 #include "nanosvg.h"
 #include "png.h"
 
 #include <set>
+#include <thread>
 
 
 //**************************************************************************
@@ -570,6 +572,7 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 	, m_scanline_timer(nullptr)
 	, m_frame_number(0)
 	, m_partial_updates_this_frame(0)
+	, m_update_queue(nullptr)
 {
 	m_unique_id = m_id_counter;
 	m_id_counter++;
@@ -584,6 +587,8 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 screen_device::~screen_device()
 {
 	destroy_scan_bitmaps();
+	if (m_update_queue)
+		osd_work_queue_free(m_update_queue);
 }
 
 
@@ -821,10 +826,14 @@ void screen_device::device_start()
 	register_screen_bitmap(m_priority);
 
 	// allocate raw textures
+	// update_quads hands over a new bitmap whenever the screen changes, so unchanged frames needn't be uploaded again
 	m_texture[0] = machine().render().texture_alloc();
 	m_texture[0]->set_id(u64(m_unique_id) << 57);
+	m_texture[0]->set_explicit_updates(true);
 	m_texture[1] = machine().render().texture_alloc();
 	m_texture[1]->set_id((u64(m_unique_id) << 57) | 1);
+	m_texture[1]->set_explicit_updates(true);
+	m_damage[0] = m_damage[1] = rectangle(0, -1, 0, -1);
 
 	// configure the default cliparea
 	render_container::user_settings settings = m_container->get_user_settings();
@@ -891,6 +900,17 @@ void screen_device::device_start()
 		logerror("%s: Deprecated legacy Old Style screen configured (MCFG_SCREEN_VBLANK_TIME), please use MCFG_SCREEN_RAW_PARAMS instead.\n",this->tag());
 
 	m_is_primary_screen = (this == screen_device_enumerator(machine().root_device()).first());
+
+	// set up banded updates; a band is only worth it with a decent number of scanlines
+	if ((m_video_attributes & VIDEO_UPDATE_PARALLEL) && !(m_video_attributes & VIDEO_VARIABLE_WIDTH) && m_type != SCREEN_TYPE_SVG)
+	{
+		unsigned const bands = std::min(std::thread::hardware_concurrency(), 8U);
+		if (bands > 1)
+		{
+			m_update_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+			m_update_bands.resize(bands);
+		}
+	}
 }
 
 
@@ -1106,6 +1126,7 @@ void screen_device::realloc_screen_bitmaps()
 	}
 	m_texture[0]->set_bitmap(m_bitmap[0], m_visarea, m_bitmap[0].texformat());
 	m_texture[1]->set_bitmap(m_bitmap[1], m_visarea, m_bitmap[1].texformat());
+	m_damage[0] = m_damage[1] = rectangle(0, -1, 0, -1);
 
 	allocate_scan_bitmaps();
 }
@@ -1182,7 +1203,7 @@ bool screen_device::update_partial(int scanline)
 
 	// otherwise, render
 	LOG_PARTIAL_UPDATES(("updating %d-%d\n", clip.top(), clip.bottom()));
-	g_profiler.start(PROFILER_VIDEO);
+	g_profiler.start(PROFILER_VIDEO, tag());
 
 	u32 flags = 0;
 	if (m_video_attributes & VIDEO_VARIABLE_WIDTH)
@@ -1206,7 +1227,11 @@ bool screen_device::update_partial(int scanline)
 	}
 	else
 	{
-		if (m_type != SCREEN_TYPE_SVG)
+		if (m_update_queue && clip.height() >= 2 * MIN_BAND_HEIGHT && !g_profiler.enabled())
+		{
+			flags = update_bands(clip);
+		}
+		else if (m_type != SCREEN_TYPE_SVG)
 		{
 			screen_bitmap &curbitmap = m_bitmap[m_curbitmap];
 			switch (curbitmap.format())
@@ -1226,7 +1251,7 @@ bool screen_device::update_partial(int scanline)
 	g_profiler.stop();
 
 	// if we modified the bitmap, we have to commit
-	m_changed |= ~flags & UPDATE_HAS_NOT_CHANGED;
+	note_update(clip, flags);
 
 	// remember where we left off
 	m_last_partial_scan = scanline + 1;
@@ -1235,6 +1260,73 @@ bool screen_device::update_partial(int scanline)
 }
 
 
+//-------------------------------------------------
+//  note_update - record the area a screen update
+//  callback drew into the current bitmap
+//-------------------------------------------------
+
+void screen_device::note_update(const rectangle &clip, u32 flags)
+{
+	if (flags & UPDATE_HAS_NOT_CHANGED)
+		return;
+
+	m_changed = true;
+	rectangle &damage = m_damage[m_curbitmap];
+	if (damage.empty())
+		damage = clip;
+	else
+		damage |= clip;
+}
+
+
+//-------------------------------------------------
+//  update_bands - render a range of scanlines as
+//  horizontal bands on worker threads
+//-------------------------------------------------
+
+u32 screen_device::update_bands(const rectangle &clip)
+{
+	// bring all tilemaps up to date so drawing them only reads shared state
+	machine().tilemap().update_all();
+
+	// split the range into bands of at least MIN_BAND_HEIGHT scanlines
+	int const count = std::min<int>(m_update_bands.size(), clip.height() / MIN_BAND_HEIGHT);
+	for (int band = 0; band < count; band++)
+	{
+		update_band &cur = m_update_bands[band];
+		cur.screen = this;
+		cur.clip = clip;
+		cur.clip.sety(clip.top() + clip.height() * band / count, clip.top() + clip.height() * (band + 1) / count - 1);
+		cur.flags = 0;
+	}
+
+	// render the first band on this thread while the others run on the queue
+	osd_work_item_queue_multiple(m_update_queue, &screen_device::update_band_callback, count - 1, &m_update_bands[1], sizeof(m_update_bands[1]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	update_band_callback(&m_update_bands[0], 0);
+	while (!osd_work_queue_wait(m_update_queue, osd_ticks_per_second())) { }
+
+	// the bitmap is unchanged only if no band changed it
+	u32 flags = UPDATE_HAS_NOT_CHANGED;
+	for (int band = 0; band < count; band++)
+		flags &= m_update_bands[band].flags;
+	return flags;
+}
+
+void *screen_device::update_band_callback(void *param, int threadid)
+{
+	update_band &band = *reinterpret_cast<update_band *>(param);
+	screen_device &screen = *band.screen;
+	screen_bitmap &curbitmap = screen.m_bitmap[screen.m_curbitmap];
+	switch (curbitmap.format())
+	{
+		default:
+		case BITMAP_FORMAT_IND16:   band.flags = screen.m_screen_update_ind16(screen, curbitmap.as_ind16(), band.clip);   break;
+		case BITMAP_FORMAT_RGB32:   band.flags = screen.m_screen_update_rgb32(screen, curbitmap.as_rgb32(), band.clip);   break;
+	}
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  update_now - perform an update from the last
 //  beam position up to the current beam position
@@ -1295,7 +1387,7 @@ void screen_device::update_now()
 			// if there's something to draw, do it
 			if (!clip.empty())
 			{
-				g_profiler.start(PROFILER_VIDEO);
+				g_profiler.start(PROFILER_VIDEO, tag());
 
 				u32 flags = 0;
 				screen_bitmap &curbitmap = m_bitmap[m_curbitmap];
@@ -1323,7 +1415,7 @@ void screen_device::update_now()
 				m_partial_updates_this_frame++;
 
 				// if we modified the bitmap, we have to commit
-				m_changed |= ~flags & UPDATE_HAS_NOT_CHANGED;
+				note_update(clip, flags);
 			}
 
 			m_partial_scan_hpos = 0;
@@ -1348,7 +1440,7 @@ void screen_device::update_now()
 		// and if there's something to draw, do it
 		if (!clip.empty())
 		{
-			g_profiler.start(PROFILER_VIDEO);
+			g_profiler.start(PROFILER_VIDEO, tag());
 
 			LOG_PARTIAL_UPDATES(("doing scanline partial draw: Y %d X %d-%d\n", clip.bottom(), clip.left(), clip.right()));
 
@@ -1378,7 +1470,7 @@ void screen_device::update_now()
 			g_profiler.stop();
 
 			// if we modified the bitmap, we have to commit
-			m_changed |= ~flags & UPDATE_HAS_NOT_CHANGED;
+			note_update(clip, flags);
 		}
 	}
 
@@ -1750,11 +1842,14 @@ bool screen_device::update_quads()
 			// if we're not skipping the frame and if the screen actually changed, then update the texture
 			if (!machine().video().skip_this_frame() && m_changed)
 			{
-				if (m_video_attributes & VIDEO_VARIABLE_WIDTH)
+				// the composited bitmap is rebuilt in full, otherwise only what was drawn since the last hand-over changed
+				const bool composited = m_video_attributes & VIDEO_VARIABLE_WIDTH;
+				if (composited)
 				{
 					create_composited_bitmap();
 				}
-				m_texture[m_curbitmap]->set_bitmap(m_bitmap[m_curbitmap], m_visarea, m_bitmap[m_curbitmap].texformat());
+				m_texture[m_curbitmap]->set_bitmap(m_bitmap[m_curbitmap], m_visarea, m_bitmap[m_curbitmap].texformat(), composited ? nullptr : &m_damage[m_curbitmap]);
+				m_damage[m_curbitmap] = rectangle(0, -1, 0, -1);
 				m_curtexture = m_curbitmap;
 				m_curbitmap = 1 - m_curbitmap;
 			}
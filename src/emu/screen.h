@@ -60,6 +60,10 @@ constexpr u32 UPDATE_HAS_NOT_CHANGED = 0x0001;   // the video has not changed
  @def VIDEO_VARIABLE_WIDTH
  causes the screen to construct its final bitmap from a composite upscale of individual scanline bitmaps
 
+ @def VIDEO_UPDATE_PARALLEL
+ lets the screen split large updates into horizontal bands rendered concurrently on worker threads;
+ the screen update must only depend on emulated state and only write inside its cliprect
+
  @}
  */
 
@@ -70,6 +74,7 @@ constexpr u32 VIDEO_SELF_RENDER             = 0x0008;
 constexpr u32 VIDEO_ALWAYS_UPDATE           = 0x0080;
 constexpr u32 VIDEO_UPDATE_SCANLINE         = 0x0100;
 constexpr u32 VIDEO_VARIABLE_WIDTH          = 0x0200;
+constexpr u32 VIDEO_UPDATE_PARALLEL         = 0x0400;
 
 
 //**************************************************************************
@@ -184,6 +189,7 @@ public:
 
 	// configuration readers
 	screen_type_enum screen_type() const { return m_type; }
+	u32 video_attributes() const { return m_video_attributes; }
 	int orientation() const { assert(configured()); return m_orientation; }
 	std::pair<unsigned, unsigned> physical_aspect() const;
 	int width() const { return m_width; }
@@ -419,6 +425,7 @@ public:
 
 	// globally accessible constants
 	static constexpr int DEFAULT_FRAME_RATE = 60;
+	static constexpr int MIN_BAND_HEIGHT = 16;
 	static const attotime DEFAULT_FRAME_PERIOD;
 
 private:
@@ -447,6 +454,9 @@ private:
 	void create_composited_bitmap();
 	void destroy_scan_bitmaps();
 	void allocate_scan_bitmaps();
+	void note_update(const rectangle &clip, u32 flags);
+	u32 update_bands(const rectangle &clip);
+	static void *update_band_callback(void *param, int threadid);
 
 	// inline configuration data
 	screen_type_enum    m_type;                     // type of screen
@@ -485,6 +495,7 @@ private:
 	u8                  m_curbitmap;                // current bitmap index
 	u8                  m_curtexture;               // current texture index
 	bool                m_changed;                  // has this bitmap changed?
+	rectangle           m_damage[2];                // area drawn into each bitmap since it was last handed to its texture
 	s32                 m_last_partial_scan;        // scanline of last partial update
 	s32                 m_partial_scan_hpos;        // horizontal pixel last rendered on this partial scanline
 	bitmap_argb32       m_screen_overlay_bitmap;    // screen overlay bitmap
@@ -506,6 +517,16 @@ private:
 	u64                 m_frame_number;             // the current frame number
 	u32                 m_partial_updates_this_frame;// partial update counter this frame
 
+	// parallel updates
+	struct update_band
+	{
+		screen_device *     screen;                     // screen being updated
+		rectangle           clip;                       // scanlines of this band
+		u32                 flags;                      // flags returned by the screen update
+	};
+	osd_work_queue *    m_update_queue;             // work queue for VIDEO_UPDATE_PARALLEL, or nullptr
+	std::vector<update_band> m_update_bands;        // bands of the current update
+
 	bool                m_is_primary_screen;
 
 	// VBLANK callbacks
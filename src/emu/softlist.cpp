@@ -18,6 +18,7 @@
 #include <array>
 #include <cstring>
 #include <regex>
+#include <unordered_map>
 
 
 
@@ -920,6 +921,297 @@ void parse_software_list(
 }
 
 
+//**************************************************************************
+//  COMPILED SOFTWARE LIST CACHE
+//**************************************************************************
+
+/*
+    The cache is a flat little-endian image that can be mapped straight
+    from disk.  It starts with a fixed header recording the XML file it
+    was built from, followed by a table of every distinct string in the
+    list (feature names, interfaces and region names repeat a lot), and
+    then the software entries themselves with strings stored as indices
+    into that table:
+
+        char[8]     "MAMESWLC"
+        u32         format version
+        u32         number of strings
+        u64         source modification time
+        u64         source size
+        string      (u32 length, bytes) x number of strings
+
+        u32         source path, list name, description, errors
+        u32         software count
+        software    short name, parent, support, long name, year,
+                    publisher, info items, shared features, parts
+
+    Name/value lists and parts are each prefixed with a u32 count, and
+    ROM entries are stored as name, hash, offset, length and flags.
+*/
+
+namespace detail {
+
+class softlist_cache
+{
+public:
+	static std::vector<u8> write(
+			std::string_view source,
+			u64 modified,
+			u64 size,
+			std::string_view listname,
+			std::string_view description,
+			std::string_view errors,
+			const std::list<software_info> &infolist)
+	{
+		softlist_cache cache;
+		cache.put_string(source);
+		cache.put_string(listname);
+		cache.put_string(description);
+		cache.put_string(errors);
+		cache.put_u32(infolist.size());
+		for (software_info const &info : infolist)
+		{
+			cache.put_string(info.m_shortname);
+			cache.put_string(info.m_parentname);
+			cache.put_u32(u32(info.m_supported));
+			cache.put_string(info.m_longname);
+			cache.put_string(info.m_year);
+			cache.put_string(info.m_publisher);
+			cache.put_items(info.m_info);
+			cache.put_items(info.m_shared_features);
+			cache.put_u32(info.m_partdata.size());
+			for (software_part const &part : info.m_partdata)
+			{
+				cache.put_string(part.m_name);
+				cache.put_string(part.m_interface);
+				cache.put_items(part.m_features);
+				cache.put_u32(part.m_romdata.size());
+				for (rom_entry const &rom : part.m_romdata)
+				{
+					cache.put_string(rom.name());
+					cache.put_string(rom.hashdata());
+					cache.put_u32(rom.get_offset());
+					cache.put_u32(rom.get_length());
+					cache.put_u32(rom.get_flags());
+				}
+			}
+		}
+
+		// now that all the strings are known, assemble the header and string table
+		std::vector<u8> result;
+		result.insert(result.end(), MAGIC, MAGIC + sizeof(MAGIC));
+		append(result, VERSION, 4);
+		append(result, cache.m_strings.size(), 4);
+		append(result, modified, 8);
+		append(result, size, 8);
+		for (std::string_view const &str : cache.m_strings)
+		{
+			append(result, str.length(), 4);
+			result.insert(result.end(), str.begin(), str.end());
+		}
+		result.insert(result.end(), cache.m_data.begin(), cache.m_data.end());
+		return result;
+	}
+
+	static bool read(
+			const void *data,
+			std::size_t length,
+			std::string_view source,
+			u64 modified,
+			u64 size,
+			std::string &listname,
+			std::string &description,
+			std::string &errors,
+			std::list<software_info> &infolist)
+	{
+		softlist_cache cache(reinterpret_cast<u8 const *>(data), length);
+		if (!cache.read_header(modified, size) || (cache.get_view() != source))
+			return false;
+
+		listname = cache.get_string();
+		description = cache.get_string();
+		errors = cache.get_string();
+		infolist.clear();
+		for (u32 count = cache.get_u32(); cache.m_ok && count; count--)
+		{
+			std::string name(cache.get_string());
+			std::string parent(cache.get_string());
+			u32 const supported(cache.get_u32());
+			software_info &info(infolist.emplace_back(std::move(name), std::move(parent), std::string_view()));
+			if (supported > u32(software_support::UNSUPPORTED))
+				cache.m_ok = false;
+			info.m_supported = software_support(supported);
+			info.m_longname = cache.get_string();
+			info.m_year = cache.get_string();
+			info.m_publisher = cache.get_string();
+			cache.get_items([&info] (std::string &&name, std::string &&value) { info.m_info.emplace_back(std::move(name), std::move(value)); });
+			cache.get_items([&info] (std::string &&name, std::string &&value) { info.m_shared_features.emplace(std::move(name), std::move(value)); });
+			for (u32 parts = cache.get_u32(); cache.m_ok && parts; parts--)
+			{
+				std::string partname(cache.get_string());
+				std::string interface(cache.get_string());
+				software_part &part(info.m_partdata.emplace_back(info, std::move(partname), std::move(interface)));
+				cache.get_items([&part] (std::string &&name, std::string &&value) { part.m_features.emplace(std::move(name), std::move(value)); });
+				for (u32 roms = cache.get_u32(); cache.m_ok && roms; roms--)
+				{
+					std::string romname(cache.get_string());
+					std::string hashdata(cache.get_string());
+					u32 const offset(cache.get_u32());
+					u32 const romlength(cache.get_u32());
+					u32 const flags(cache.get_u32());
+					part.m_romdata.emplace_back(std::move(romname), std::move(hashdata), offset, romlength, flags);
+				}
+			}
+		}
+
+		// anything left over means the file doesn't match what we expect
+		if (!cache.m_ok || (cache.m_ptr != cache.m_end))
+		{
+			listname.clear();
+			description.clear();
+			errors.clear();
+			infolist.clear();
+			return false;
+		}
+		return true;
+	}
+
+private:
+	static constexpr char MAGIC[8] = { 'M', 'A', 'M', 'E', 'S', 'W', 'L', 'C' };
+	static constexpr u32 VERSION = 1;
+
+	softlist_cache() { }
+	softlist_cache(u8 const *data, std::size_t length) : m_ptr(data), m_end(data + length) { }
+
+	static void append(std::vector<u8> &dest, u64 value, int bytes)
+	{
+		for (int i = 0; i < bytes; i++)
+			dest.push_back(u8(value >> (i * 8)));
+	}
+
+	// writing
+	void put_u32(u64 value) { append(m_data, u32(value), 4); }
+
+	void put_string(std::string_view str)
+	{
+		auto const ins(m_index.emplace(str, u32(m_strings.size())));
+		if (ins.second)
+			m_strings.emplace_back(str);
+		put_u32(ins.first->second);
+	}
+
+	template <typename T> void put_items(T const &items)
+	{
+		put_u32(items.size());
+		for (software_info_item const &item : items)
+		{
+			put_string(item.name());
+			put_string(item.value());
+		}
+	}
+
+	// reading
+	u64 get(int bytes)
+	{
+		if ((m_end - m_ptr) < bytes)
+		{
+			m_ok = false;
+			return 0;
+		}
+		u64 result = 0;
+		for (int i = bytes - 1; i >= 0; i--)
+			result = (result << 8) | m_ptr[i];
+		m_ptr += bytes;
+		return result;
+	}
+
+	u32 get_u32() { return u32(get(4)); }
+
+	std::string_view get_view()
+	{
+		u32 const index(get_u32());
+		if (index >= m_strings.size())
+		{
+			m_ok = false;
+			return std::string_view();
+		}
+		return m_strings[index];
+	}
+
+	std::string get_string() { return std::string(get_view()); }
+
+	template <typename T> void get_items(T &&add)
+	{
+		for (u32 count = get_u32(); m_ok && count; count--)
+		{
+			std::string name(get_string());
+			std::string value(get_string());
+			add(std::move(name), std::move(value));
+		}
+	}
+
+	bool read_header(u64 modified, u64 size)
+	{
+		if (((m_end - m_ptr) < std::ptrdiff_t(sizeof(MAGIC))) || std::memcmp(m_ptr, MAGIC, sizeof(MAGIC)))
+			return false;
+		m_ptr += sizeof(MAGIC);
+		u32 const version(get_u32());
+		u32 const count(get_u32());
+		if (!m_ok || (version != VERSION) || (get(8) != modified) || (get(8) != size))
+			return false;
+
+		// string contents are used in place from the mapped data
+		m_strings.reserve((std::min<std::size_t>)(count, (m_end - m_ptr) / 4));
+		for (u32 i = 0; m_ok && (i < count); i++)
+		{
+			u32 const len(get_u32());
+			if (!m_ok || (std::size_t(m_end - m_ptr) < len))
+				return false;
+			m_strings.emplace_back(reinterpret_cast<char const *>(m_ptr), len);
+			m_ptr += len;
+		}
+		return m_ok;
+	}
+
+	std::vector<u8> m_data;
+	std::vector<std::string_view> m_strings;
+	std::unordered_map<std::string_view, u32> m_index;
+	u8 const *m_ptr = nullptr;
+	u8 const *m_end = nullptr;
+	bool m_ok = true;
+};
+
+} // namespace detail
+
+
+std::vector<u8> write_software_list_cache(
+		std::string_view source,
+		u64 modified,
+		u64 size,
+		std::string_view listname,
+		std::string_view description,
+		std::string_view errors,
+		const std::list<software_info> &infolist)
+{
+	return detail::softlist_cache::write(source, modified, size, listname, description, errors, infolist);
+}
+
+
+bool read_software_list_cache(
+		const void *data,
+		std::size_t length,
+		std::string_view source,
+		u64 modified,
+		u64 size,
+		std::string &listname,
+		std::string &description,
+		std::string &errors,
+		std::list<software_info> &infolist)
+{
+	return detail::softlist_cache::read(data, length, source, modified, size, listname, description, errors, infolist);
+}
+
+
 //-------------------------------------------------
 //  software_name_parse - helper that splits a
 //  software identifier (software_list:software:part)
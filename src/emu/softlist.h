@@ -22,13 +22,14 @@
 #include <set>
 #include <string>
 #include <string_view>
+#include <vector>
 
 
 //**************************************************************************
 //  FORWARD DECLARATIONS
 //**************************************************************************
 
-namespace detail { class softlist_parser; }
+namespace detail { class softlist_parser; class softlist_cache; }
 
 
 //**************************************************************************
@@ -84,6 +85,7 @@ private:
 class software_part
 {
 	friend class detail::softlist_parser;
+	friend class detail::softlist_cache;
 
 public:
 	// construction/destruction
@@ -118,6 +120,7 @@ private:
 class software_info
 {
 	friend class detail::softlist_parser;
+	friend class detail::softlist_cache;
 
 public:
 	// construction/destruction
@@ -168,6 +171,28 @@ void parse_software_list(
 		std::list<software_info> &infolist,
 		std::ostream &errors);
 
+// serialises a parsed software list into the compiled cache format
+std::vector<u8> write_software_list_cache(
+		std::string_view source,
+		u64 modified,
+		u64 size,
+		std::string_view listname,
+		std::string_view description,
+		std::string_view errors,
+		const std::list<software_info> &infolist);
+
+// rebuilds a software list from compiled cache data (returns false if stale or damaged)
+bool read_software_list_cache(
+		const void *data,
+		std::size_t length,
+		std::string_view source,
+		u64 modified,
+		u64 size,
+		std::string &listname,
+		std::string &description,
+		std::string &errors,
+		std::list<software_info> &infolist);
+
 // parses a software identifier (e.g. - 'apple2e:agentusa:flop1') into its constituent parts (returns false if cannot parse)
 bool software_name_parse(std::string_view identifier, std::string *list_name = nullptr, std::string *software_name = nullptr, std::string *part_name = nullptr);
 
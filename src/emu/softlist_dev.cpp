@@ -20,7 +20,10 @@
 #include "corestr.h"
 #include "unicode.h"
 
+#include "../osd/modules/lib/osdlib.h"
+
 #include <cctype>
+#include <cstdio>
 
 
 //**************************************************************************
@@ -293,11 +296,21 @@ void software_list_device::parse()
 	m_filename = file.filename();
 	if (!filerr)
 	{
-		// parse if no error
-		std::ostringstream errs;
-		parse_software_list(file, m_filename, m_shortname, m_description, m_infolist, errs);
+		// use the compiled cache if it was built from this exact file
+		std::string const source(file.fullpath());
+		auto const entry(file.archived() ? nullptr : osd_stat(source));
+		u64 const modified(entry ? u64(entry->last_modified.time_since_epoch().count()) : 0);
+		u64 const size(entry ? entry->size : 0);
+		if (!entry || !load_cache(source, modified, size))
+		{
+			// parse if no error
+			std::ostringstream errs;
+			parse_software_list(file, m_filename, m_shortname, m_description, m_infolist, errs);
+			m_errors = errs.str();
+			if (entry)
+				save_cache(source, modified, size);
+		}
 		file.close();
-		m_errors = errs.str();
 	}
 	else if (std::errc::no_such_file_or_directory == filerr)
 	{
@@ -313,6 +326,48 @@ void software_list_device::parse()
 }
 
 
+//-------------------------------------------------
+//  load_cache - try to populate the list from
+//  the compiled cache
+//-------------------------------------------------
+
+bool software_list_device::load_cache(const std::string &source, u64 modified, u64 size)
+{
+	if (!*mconfig().options().softlistcache_directory())
+		return false;
+
+	std::string const path(util::string_format("%s" PATH_SEPARATOR "%s.swc", mconfig().options().softlistcache_directory(), m_list_name));
+	auto const entry(osd_stat(path));
+	if (!entry || !entry->size)
+		return false;
+
+	// the strings are copied out, so the mapping only needs to live while we read it
+	osd::file_mapping mapping(path, entry->size);
+	if (!mapping || !read_software_list_cache(mapping.get(), mapping.size(), source, modified, size, m_shortname, m_description, m_errors, m_infolist))
+		return false;
+
+	osd_printf_verbose("%s: Loaded %s from compiled cache\n", tag(), m_filename);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  save_cache - write the freshly parsed list to
+//  the compiled cache
+//-------------------------------------------------
+
+void software_list_device::save_cache(const std::string &source, u64 modified, u64 size)
+{
+	if (!*mconfig().options().softlistcache_directory() || !m_errors.empty())
+		return;
+
+	std::vector<u8> const data(write_software_list_cache(source, modified, size, m_shortname, m_description, m_errors, m_infolist));
+
+	// a partial cache must never be picked up
+	emu_file::write_replacing(mconfig().options().softlistcache_directory(), m_list_name + ".swc", [&data] (emu_file &cached) { return cached.write(data.data(), data.size()) == data.size(); });
+}
+
+
 //-------------------------------------------------
 //  is_compatible - determine if we are compatible
 //  with the given software_list_device
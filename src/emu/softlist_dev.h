@@ -140,6 +140,8 @@ protected:
 private:
 	// internal helpers
 	void parse();
+	bool load_cache(const std::string &source, u64 modified, u64 size);
+	void save_cache(const std::string &source, u64 modified, u64 size);
 	void internal_validity_check(validity_checker &valid) ATTR_COLD;
 
 	// configuration state
@@ -14,11 +14,17 @@
 #include "emuopts.h"
 #include "speaker.h"
 
+#include "corefile.h"
+#include "flac.h"
+#include "path.h"
 #include "wavwrite.h"
 #include "xmlfile.h"
 
 #include "osdepend.h"
 
+#include <atomic>
+#include <numeric>
+
 
 //**************************************************************************
 //  DEBUGGING
@@ -523,6 +529,23 @@ read_stream_view sound_stream_input::update(attotime start, attotime end)
 }
 
 
+//-------------------------------------------------
+//  active_resampler - return the resampler stream
+//  an update would pull from, or nullptr if the
+//  native source will be read directly
+//-------------------------------------------------
+
+sound_stream *sound_stream_input::active_resampler()
+{
+	if (!valid() || m_resampler_source == nullptr)
+		return nullptr;
+
+	// this is the same choice update() will make
+	sound_stream_output &source = m_native_source->optimize_resampler(m_resampler_source);
+	return (&source != m_native_source) ? &source.stream() : nullptr;
+}
+
+
 //-------------------------------------------------
 //  apply_sample_rate_changes - tell our sources
 //  to apply any sample rate changes, informing
@@ -713,56 +736,83 @@ read_stream_view sound_stream::update_view(attotime start, attotime end, u32 out
 
 	g_profiler.start(PROFILER_SOUND);
 
+	// bring the inputs up to date and generate if there's anything to do
+	if (prepare_update(end, outputnum))
+		generate();
+	g_profiler.stop();
+
+	// return the requested view
+	return read_stream_view(m_output_view[outputnum], start);
+}
+
+
+//-------------------------------------------------
+//  prepare_update - create output views up to
+//  the given end time, and update the inputs to
+//  match; returns true if there are samples to
+//  generate
+//-------------------------------------------------
+
+bool sound_stream::prepare_update(attotime end, u32 outputnum)
+{
 	// reposition our start to coincide with the current buffer end
 	attotime update_start = m_output[outputnum].end_time();
-	if (update_start <= end)
+	if (update_start > end)
+		return false;
+
+	// create views for all the outputs
+	for (unsigned int outindex = 0; outindex < m_output.size(); outindex++)
+		m_output_view[outindex] = m_output[outindex].view(update_start, end);
+
+	// skip if nothing to do
+	u32 samples = m_output_view[0].samples();
+	sound_assert(samples >= 0);
+	if (samples == 0 || m_sample_rate < SAMPLE_RATE_MINIMUM)
+		return false;
+
+	sound_assert(!synchronous() || samples == 1);
+
+	// ensure all input streams are up to date, and create views for them as well
+	for (unsigned int inputnum = 0; inputnum < m_input.size(); inputnum++)
 	{
-		// create views for all the outputs
-		for (unsigned int outindex = 0; outindex < m_output.size(); outindex++)
-			m_output_view[outindex] = m_output[outindex].view(update_start, end);
-
-		// skip if nothing to do
-		u32 samples = m_output_view[0].samples();
-		sound_assert(samples >= 0);
-		if (samples != 0 && m_sample_rate >= SAMPLE_RATE_MINIMUM)
-		{
-			sound_assert(!synchronous() || samples == 1);
+		if (m_input[inputnum].valid())
+			m_input_view[inputnum] = m_input[inputnum].update(update_start, end);
+		else
+			m_input_view[inputnum] = empty_view(update_start, end);
+		sound_assert(m_input_view[inputnum].samples() > 0);
+		sound_assert(m_resampling_disabled || m_input_view[inputnum].sample_rate() == m_sample_rate);
+	}
+	return true;
+}
 
-			// ensure all input streams are up to date, and create views for them as well
-			for (unsigned int inputnum = 0; inputnum < m_input.size(); inputnum++)
-			{
-				if (m_input[inputnum].valid())
-					m_input_view[inputnum] = m_input[inputnum].update(update_start, end);
-				else
-					m_input_view[inputnum] = empty_view(update_start, end);
-				sound_assert(m_input_view[inputnum].samples() > 0);
-				sound_assert(m_resampling_disabled || m_input_view[inputnum].sample_rate() == m_sample_rate);
-			}
 
+//-------------------------------------------------
+//  generate - call the update callback over the
+//  views created by prepare_update; this touches
+//  nothing but this stream's own buffers and may
+//  run on a worker thread
+//-------------------------------------------------
+
+void sound_stream::generate()
+{
 #if (SOUND_DEBUG)
-			// clear each output view to NANs before we call the callback
-			for (unsigned int outindex = 0; outindex < m_output.size(); outindex++)
-				m_output_view[outindex].fill(NAN);
+	// clear each output view to NANs before we call the callback
+	for (unsigned int outindex = 0; outindex < m_output.size(); outindex++)
+		m_output_view[outindex].fill(NAN);
 #endif
 
-			// if we have an extended callback, that's all we need
-			m_callback_ex(*this, m_input_view, m_output_view);
+	// if we have an extended callback, that's all we need
+	m_callback_ex(*this, m_input_view, m_output_view);
 
 #if (SOUND_DEBUG)
-			// make sure everything was overwritten
-			for (unsigned int outindex = 0; outindex < m_output.size(); outindex++)
-				for (int sampindex = 0; sampindex < m_output_view[outindex].samples(); sampindex++)
-					m_output_view[outindex].get(sampindex);
+	// make sure everything was overwritten
+	for (unsigned int outindex = 0; outindex < m_output.size(); outindex++)
+		for (int sampindex = 0; sampindex < m_output_view[outindex].samples(); sampindex++)
+			m_output_view[outindex].get(sampindex);
 
-			for (unsigned int outindex = 0; outindex < m_output.size(); outindex++)
-				m_output[outindex].m_buffer.flush_wav();
+	for (unsigned int outindex = 0; outindex < m_output.size(); outindex++)
+		m_output[outindex].m_buffer.flush_wav();
 #endif
-		}
-	}
-	g_profiler.stop();
-
-	// return the requested view
-	return read_stream_view(m_output_view[outputnum], start);
 }
 
 
@@ -932,6 +982,54 @@ read_stream_view sound_stream::empty_view(attotime start, attotime end)
 //  RESAMPLER STREAM
 //**************************************************************************
 
+//-------------------------------------------------
+//  resampler_filter - build a Blackman-windowed
+//  sinc low-pass filter, tabulated at PHASES + 1
+//  fractional offsets
+//-------------------------------------------------
+
+resampler_filter::resampler_filter(u32 inrate, u32 outrate)
+{
+	// zero crossings either side of the centre, and how much of the
+	// output Nyquist band to keep
+	constexpr int ZERO_CROSSINGS = 8;
+	constexpr double ROLLOFF = 0.9;
+
+	// cut off at the lower of the two Nyquist frequencies, in input samples
+	double const cutoff = ROLLOFF * std::min(1.0, double(outrate) / double(inrate));
+	u32 const half = (u32(std::ceil(ZERO_CROSSINGS / cutoff)) + 1) & ~1;
+	m_taps = half * 2;
+	m_coeffs.resize((PHASES + 1) * m_taps);
+
+	for (u32 phase = 0; phase <= PHASES; phase++)
+	{
+		// tap 0 is half - 1 samples before the sample at or before the point
+		sample_t *const row = &m_coeffs[phase * m_taps];
+		double const frac = double(phase) / double(PHASES);
+		double sum = 0;
+		for (u32 tap = 0; tap < m_taps; tap++)
+		{
+			double const x = double(tap) - double(half - 1) - frac;
+			double const t = x / double(half);
+			double value = 0;
+			if (std::abs(t) < 1.0)
+			{
+				double const window = 0.42 + 0.5 * cos(M_PI * t) + 0.08 * cos(2.0 * M_PI * t);
+				double const arg = M_PI * cutoff * x;
+				value = window * ((arg == 0) ? cutoff : (cutoff * sin(arg) / arg));
+			}
+			row[tap] = sample_t(value);
+			sum += value;
+		}
+
+		// normalize each phase to unity gain at DC
+		for (u32 tap = 0; tap < m_taps; tap++)
+			row[tap] = sample_t(row[tap] / sum);
+	}
+}
+
+
+
 //-------------------------------------------------
 //  default_resampler_stream - derived sound_stream
 //  class that handles resampling
@@ -939,7 +1037,10 @@ read_stream_view sound_stream::empty_view(attotime start, attotime end)
 
 default_resampler_stream::default_resampler_stream(device_t &device) :
 	sound_stream(device, 1, 1, 0, SAMPLE_RATE_OUTPUT_ADAPTIVE, stream_update_delegate(&default_resampler_stream::resampler_sound_update, this), STREAM_DISABLE_INPUT_RESAMPLING),
-	m_max_latency(0)
+	m_max_latency(0),
+	m_filter(nullptr),
+	m_filter_inrate(0),
+	m_filter_outrate(0)
 {
 	// create a name
 	m_name = "Default Resampler '";
@@ -976,10 +1077,25 @@ void default_resampler_stream::resampler_sound_update(sound_stream &stream, std:
 	stream_buffer::sample_t step = stream_buffer::sample_t(input.sample_rate()) / stream_buffer::sample_t(output.sample_rate());
 	stream_buffer::sample_t stepinv = 1.0 / step;
 
+	// moderate ratios go through the polyphase filter; heavily oversampled
+	// inputs would need too many taps, so they just sum the energy
+	if (step <= MAX_FILTER_STEP)
+	{
+		if (!m_filter || (m_filter_inrate != input.sample_rate()) || (m_filter_outrate != output.sample_rate()))
+		{
+			m_filter = &device().machine().sound().resampler_filter_for(input.sample_rate(), output.sample_rate());
+			m_filter_inrate = input.sample_rate();
+			m_filter_outrate = output.sample_rate();
+		}
+	}
+	else
+		m_filter = nullptr;
+
 	// determine the latency we need to introduce, in input samples:
 	//    1 input sample for undersampled inputs
 	//    1 + step input samples for oversampled inputs
-	s64 latency_samples = 1 + ((step < 1.0) ? 0 : s32(step));
+	//    1 + the filter length when filtering
+	s64 latency_samples = 1 + (m_filter ? m_filter->taps() : (step < 1.0) ? 0 : s32(step));
 	if (latency_samples <= m_max_latency)
 		latency_samples = m_max_latency;
 	else
@@ -1008,9 +1124,48 @@ void default_resampler_stream::resampler_sound_update(sound_stream &stream, std:
 	stream_buffer::sample_t srcpos = stream_buffer::sample_t(double(delta.attoseconds()) / double(rebased.sample_period_attoseconds()));
 	sound_assert(srcpos <= 1.0f);
 
-	// input is undersampled: point sample except where our sample period covers a boundary
+	// filtering: centre the filter on each output's position
 	s32 srcindex = 0;
-	if (step < 1.0)
+	if (m_filter)
+	{
+		// copy the input somewhere contiguous, with room for the last taps
+		u32 const taps = m_filter->taps();
+		m_history.resize(rebased.samples() + taps);
+		stream_buffer::sample_t *dest = &m_history[0];
+		stream_buffer::sample_t const gain = rebased.gain();
+		rebased.for_each_run(0, rebased.samples(), [&dest, gain] (stream_buffer::sample_t const *src, s32 run)
+		{
+			for (s32 sampindex = 0; sampindex < run; sampindex++)
+				dest[sampindex] = src[sampindex] * gain;
+			dest += run;
+		});
+		std::fill_n(dest, taps, 0);
+
+		// the latency puts the filter's centre half its length into the input
+		double const startpos = double(latency_samples - taps / 2) + srcpos - double(dstindex) * step;
+		for ( ; dstindex < numsamples; dstindex++)
+		{
+			double const pos = startpos + double(dstindex) * step;
+			s32 const base = s32(pos);
+			stream_buffer::sample_t const *const coeffs = m_filter->coefficients(pos - double(base));
+			stream_buffer::sample_t const *const src = &m_history[base - s32(taps / 2 - 1)];
+			sound_assert(base + taps / 2 < m_history.size());
+
+			// separate accumulators let the compiler vectorise the loop
+			stream_buffer::sample_t sum[4] = { 0, 0, 0, 0 };
+			for (u32 tap = 0; tap < taps; tap += 4)
+			{
+				sum[0] += src[tap + 0] * coeffs[tap + 0];
+				sum[1] += src[tap + 1] * coeffs[tap + 1];
+				sum[2] += src[tap + 2] * coeffs[tap + 2];
+				sum[3] += src[tap + 3] * coeffs[tap + 3];
+			}
+			output.put(dstindex, (sum[0] + sum[1]) + (sum[2] + sum[3]));
+		}
+	}
+
+	// input is undersampled: point sample except where our sample period covers a boundary
+	else if (step < 1.0)
 	{
 		stream_buffer::sample_t cursample = rebased.get(srcindex++);
 		for ( ; dstindex < numsamples; dstindex++)
@@ -1065,6 +1220,215 @@ void default_resampler_stream::resampler_sound_update(sound_stream &stream, std:
 
 
 
+//**************************************************************************
+//  SOUND RECORDER
+//**************************************************************************
+
+// ======================> sound_manager::recorder
+
+// records the final mix to a WAV or FLAC file; the emulation thread only
+// copies samples into a lock-free ring, encoding and disk I/O happen on an
+// I/O work queue in large blocks
+class sound_manager::recorder
+{
+public:
+	static std::unique_ptr<recorder> open(std::string_view filename, u32 sample_rate);
+	~recorder();
+
+	// append interleaved stereo samples
+	void add(const s16 *samples, u32 frames);
+
+private:
+	recorder(u32 sample_rate);
+
+	size_t available() const { return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire); }
+	size_t push(const s16 *samples, size_t frames);
+	void queue_write();
+	void write_pending();
+	static void *write_callback(void *param, int threadid);
+
+	// ring of interleaved stereo samples, pushed by the emulation thread
+	// and popped by the writer
+	size_t const m_size;                  // ring size in frames, a power of 2
+	size_t const m_block;                 // frames collected before a write is started
+	std::unique_ptr<s16 []> const m_ring; // ring buffer
+	std::atomic<size_t> m_read;           // frames popped so far
+	std::atomic<size_t> m_write;          // frames pushed so far
+	std::atomic<bool> m_writing;          // a write work item is pending
+
+	// writer state, only touched from the write work item or when it is idle
+	osd_work_queue *m_queue;              // I/O queue for the writes
+	std::vector<s16> m_buffer;            // contiguous block handed to the writer
+	util::wav_file_ptr m_wavfile;         // WAV file, or
+	util::core_file::ptr m_file;          // FLAC file
+	std::unique_ptr<flac_encoder> m_encoder; // and its encoder
+	bool m_failed;                        // the encoder reported an error
+};
+
+
+//-------------------------------------------------
+//  recorder - constructor
+//-------------------------------------------------
+
+sound_manager::recorder::recorder(u32 sample_rate) :
+	m_size(1 << (32 - count_leading_zeros_32(sample_rate * 4 - 1))),
+	m_block(sample_rate / 2),
+	m_ring(std::make_unique<s16 []>(m_size * 2)),
+	m_read(0),
+	m_write(0),
+	m_writing(false),
+	m_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO)),
+	m_buffer(8192 * 2),
+	m_failed(false)
+{
+}
+
+
+//-------------------------------------------------
+//  open - create a recorder writing FLAC when the
+//  file name ends in .flac, WAV otherwise
+//-------------------------------------------------
+
+std::unique_ptr<sound_manager::recorder> sound_manager::recorder::open(std::string_view filename, u32 sample_rate)
+{
+	std::unique_ptr<recorder> result(new recorder(sample_rate));
+	if (!result->m_queue)
+		return nullptr;
+
+	if (core_filename_ends_with(filename, ".flac"))
+	{
+		if (util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, result->m_file))
+			return nullptr;
+		result->m_encoder = std::make_unique<flac_encoder>();
+		result->m_encoder->set_sample_rate(sample_rate);
+		result->m_encoder->set_num_channels(2);
+		if (!result->m_encoder->reset(*result->m_file))
+			return nullptr;
+	}
+	else
+	{
+		result->m_wavfile = util::wav_open(filename, sample_rate, 2);
+		if (!result->m_wavfile)
+			return nullptr;
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  ~recorder - write what is left and close the
+//  file
+//-------------------------------------------------
+
+sound_manager::recorder::~recorder()
+{
+	if (m_queue)
+	{
+		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
+		osd_work_queue_free(m_queue);
+	}
+	write_pending();
+	if (m_encoder)
+		m_encoder->finish();
+}
+
+
+//-------------------------------------------------
+//  add - append samples, waiting for the writer
+//  only when it has fallen a whole ring behind
+//-------------------------------------------------
+
+void sound_manager::recorder::add(const s16 *samples, u32 frames)
+{
+	while (true)
+	{
+		size_t const pushed = push(samples, frames);
+		samples += pushed * 2;
+		frames -= pushed;
+		if (frames == 0)
+			break;
+		queue_write();
+		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 10);
+	}
+	if (available() >= m_block)
+		queue_write();
+}
+
+
+//-------------------------------------------------
+//  push - copy as many frames into the ring as fit
+//-------------------------------------------------
+
+size_t sound_manager::recorder::push(const s16 *samples, size_t frames)
+{
+	size_t const write = m_write.load(std::memory_order_relaxed);
+	frames = std::min(frames, m_size - (write - m_read.load(std::memory_order_acquire)));
+	for (size_t i = 0; i < frames; i++)
+	{
+		size_t const index = ((write + i) & (m_size - 1)) * 2;
+		m_ring[index + 0] = samples[i * 2 + 0];
+		m_ring[index + 1] = samples[i * 2 + 1];
+	}
+	m_write.store(write + frames, std::memory_order_release);
+	return frames;
+}
+
+
+//-------------------------------------------------
+//  queue_write - start a write unless one is
+//  already pending
+//-------------------------------------------------
+
+void sound_manager::recorder::queue_write()
+{
+	if (!m_writing.exchange(true, std::memory_order_acq_rel))
+		if (!osd_work_item_queue(m_queue, &recorder::write_callback, this, WORK_ITEM_FLAG_AUTO_RELEASE))
+			m_writing.store(false, std::memory_order_release);
+}
+
+
+//-------------------------------------------------
+//  write_pending - drain the ring into the file
+//-------------------------------------------------
+
+void sound_manager::recorder::write_pending()
+{
+	size_t const frames_per_buffer = m_buffer.size() / 2;
+	while (size_t frames = std::min(available(), frames_per_buffer))
+	{
+		size_t const read = m_read.load(std::memory_order_relaxed);
+		for (size_t i = 0; i < frames; i++)
+		{
+			size_t const index = ((read + i) & (m_size - 1)) * 2;
+			m_buffer[i * 2 + 0] = m_ring[index + 0];
+			m_buffer[i * 2 + 1] = m_ring[index + 1];
+		}
+		m_read.store(read + frames, std::memory_order_release);
+
+		if (m_wavfile)
+			util::wav_add_data_16(*m_wavfile, &m_buffer[0], frames * 2);
+		else if (!m_failed && !m_encoder->encode_interleaved(&m_buffer[0], frames))
+		{
+			osd_printf_error("Error encoding FLAC audio recording\n");
+			m_failed = true;
+		}
+	}
+}
+
+void *sound_manager::recorder::write_callback(void *param, int threadid)
+{
+	auto &rec = *reinterpret_cast<recorder *>(param);
+	rec.write_pending();
+	rec.m_writing.store(false, std::memory_order_release);
+
+	// samples may have arrived after the ring was seen empty
+	if (rec.available() >= rec.m_block)
+		rec.queue_write();
+	return nullptr;
+}
+
+
+
 //**************************************************************************
 //  SOUND MANAGER
 //**************************************************************************
@@ -1076,6 +1440,7 @@ void default_resampler_stream::resampler_sound_update(sound_stream &stream, std:
 sound_manager::sound_manager(running_machine &machine) :
 	m_machine(machine),
 	m_update_timer(nullptr),
+	m_update_frequency(std::max(machine.osd().audio_update_frequency(), int(STREAMS_UPDATE_FREQUENCY))),
 	m_update_number(0),
 	m_last_update(attotime::zero),
 	m_finalmix_leftover(0),
@@ -1085,13 +1450,16 @@ sound_manager::sound_manager(running_machine &machine) :
 	m_rightmix(machine.sample_rate()),
 	m_compressor_scale(1.0),
 	m_compressor_counter(0),
+	m_compressor_recovery(pow(1.01, double(STREAMS_UPDATE_FREQUENCY) / double(m_update_frequency))),
 	m_compressor_enabled(machine.options().compressor()),
 	m_muted(0),
-	m_nosound_mode(machine.osd().no_sound()),
+	m_nosound_mode(machine.osd().no_sound() || machine.options().batch()),
+	m_output_suppressed(false),
 	m_attenuation(0),
 	m_unique_id(0),
-	m_wavfile(),
-	m_first_reset(true)
+	m_recorder(),
+	m_first_reset(true),
+	m_generate_queue(nullptr)
 {
 	// count the mixers
 #if VERBOSE
@@ -1115,9 +1483,15 @@ sound_manager::sound_manager(running_machine &machine) :
 	// set the starting attenuation
 	set_attenuation(machine.options().volume());
 
-	// start the periodic update flushing timer
+	// start the periodic update flushing timer; low-latency sound modules
+	// may ask for samples more often than the default
+	attotime const period = (m_update_frequency != STREAMS_UPDATE_FREQUENCY) ? attotime::from_hz(m_update_frequency) : STREAMS_UPDATE_ATTOTIME;
 	m_update_timer = machine.scheduler().timer_alloc(timer_expired_delegate(FUNC(sound_manager::update), this));
-	m_update_timer->adjust(STREAMS_UPDATE_ATTOTIME, 0, STREAMS_UPDATE_ATTOTIME);
+	m_update_timer->adjust(period, 0, period);
+
+	// allocate a work queue if streams are to be generated in parallel
+	if (machine.options().sound_threads())
+		m_generate_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
 }
 
 
@@ -1127,6 +1501,8 @@ sound_manager::sound_manager(running_machine &machine) :
 
 sound_manager::~sound_manager()
 {
+	if (m_generate_queue)
+		osd_work_queue_free(m_generate_queue);
 }
 
 
@@ -1154,15 +1530,15 @@ sound_stream *sound_manager::stream_alloc(device_t &device, u32 inputs, u32 outp
 
 bool sound_manager::start_recording(std::string_view filename)
 {
-	if (m_wavfile)
+	if (m_recorder)
 		return false;
-	m_wavfile = util::wav_open(filename, machine().sample_rate(), 2);
-	return bool(m_wavfile);
+	m_recorder = recorder::open(filename, machine().sample_rate());
+	return bool(m_recorder);
 }
 
 bool sound_manager::start_recording()
 {
-	// open the output WAV file if specified
+	// open the output WAV or FLAC file if specified
 	char const *const filename = machine().options().wav_write();
 	return *filename ? start_recording(filename) : false;
 }
@@ -1174,8 +1550,8 @@ bool sound_manager::start_recording()
 
 void sound_manager::stop_recording()
 {
-	// close any open WAV file
-	m_wavfile.reset();
+	// flush and close any open audio file
+	m_recorder.reset();
 }
 
 
@@ -1231,6 +1607,34 @@ void sound_manager::samples(s16 *buffer)
 }
 
 
+//-------------------------------------------------
+//  output_latency - return how much audio the OSD
+//  has queued ahead of the output, or zero if it
+//  can't tell
+//-------------------------------------------------
+
+attotime sound_manager::output_latency() const
+{
+	int const samples = machine().osd().audio_latency_samples();
+	return (samples > 0) ? attotime(0, samples * HZ_TO_ATTOSECONDS(machine().sample_rate())) : attotime::zero;
+}
+
+
+//-------------------------------------------------
+//  resampler_filter_for - return the filter for
+//  a rate ratio, creating it on first use
+//-------------------------------------------------
+
+resampler_filter const &sound_manager::resampler_filter_for(u32 inrate, u32 outrate)
+{
+	u32 const divisor = std::gcd(inrate, outrate);
+	auto &filter = m_resampler_filters[std::make_pair(inrate / divisor, outrate / divisor)];
+	if (!filter)
+		filter = std::make_unique<resampler_filter>(inrate, outrate);
+	return *filter;
+}
+
+
 //-------------------------------------------------
 //  mute - mute sound output
 //-------------------------------------------------
@@ -1322,6 +1726,14 @@ void sound_manager::reset()
 			m_speakers.emplace_back(speaker);
 		}
 
+		// group the streams by how deep they sit in the graph
+		if (m_generate_queue)
+		{
+			std::map<sound_stream *, int> levels;
+			for (auto &stream : m_stream_list)
+				schedule_stream(*stream, nullptr, levels);
+		}
+
 #if (SOUND_DEBUG)
 		// dump the sound graph when we start up
 		for (speaker_device &speaker : speaker_device_enumerator(machine().root_device()))
@@ -1344,6 +1756,89 @@ void sound_manager::reset()
 }
 
 
+//-------------------------------------------------
+//  schedule_stream - place a stream in the first
+//  group after all the streams it reads from,
+//  returning its group number; synchronous
+//  streams are left for their readers to update
+//  on the calling thread
+//-------------------------------------------------
+
+int sound_manager::schedule_stream(sound_stream &stream, sound_stream_input *resampled, std::map<sound_stream *, int> &levels)
+{
+	auto const found = levels.find(&stream);
+	if (found != levels.end())
+		return found->second;
+
+	// one group past the deepest source, counting resamplers as a group of their own
+	int level = 0;
+	for (sound_stream_input &input : stream.m_input)
+	{
+		if (!input.valid())
+			continue;
+		int source = schedule_stream(input.source().stream(), nullptr, levels) + 1;
+		sound_stream *const resampler = input.resampler_stream();
+		if (resampler)
+			source = std::max(source, schedule_stream(*resampler, &input, levels) + 1);
+		level = std::max(level, source);
+	}
+	levels.emplace(&stream, level);
+
+	if (!stream.synchronous())
+	{
+		if (m_stream_levels.size() <= level)
+			m_stream_levels.resize(level + 1);
+		m_stream_levels[level].push_back(scheduled_stream{ &stream, resampled });
+	}
+	return level;
+}
+
+
+//-------------------------------------------------
+//  generate_streams - bring every scheduled
+//  stream up to the current time one group at a
+//  time; the groups' inputs and views are set up
+//  on this thread, and only the callbacks run in
+//  parallel
+//-------------------------------------------------
+
+void sound_manager::generate_streams()
+{
+	attotime const end = machine().time();
+	for (auto &level : m_stream_levels)
+	{
+		// a resampler only runs if its input isn't reading the source directly
+		m_generate_list.clear();
+		for (scheduled_stream &entry : level)
+		{
+			sound_stream *stream = entry.stream;
+			if (entry.resampled)
+			{
+				stream = entry.resampled->active_resampler();
+				if (!stream || (std::find(m_generate_list.begin(), m_generate_list.end(), stream) != m_generate_list.end()))
+					continue;
+			}
+			if (stream->prepare_update(end))
+				m_generate_list.push_back(stream);
+		}
+
+		// hand all but the first to the workers, and do that one ourselves
+		if (m_generate_list.size() > 1)
+			osd_work_item_queue_multiple(m_generate_queue, &sound_manager::generate_stream_callback, m_generate_list.size() - 1, &m_generate_list[1], sizeof(m_generate_list[1]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		if (!m_generate_list.empty())
+			m_generate_list[0]->generate();
+		if (m_generate_list.size() > 1)
+			osd_work_queue_wait(m_generate_queue, osd_ticks_per_second() * 10);
+	}
+}
+
+void *sound_manager::generate_stream_callback(void *param, int threadid)
+{
+	(*reinterpret_cast<sound_stream **>(param))->generate();
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  pause - pause sound output
 //-------------------------------------------------
@@ -1494,6 +1989,10 @@ void sound_manager::update(int param)
 	// recompute the end time to an even sample boundary
 	attotime endtime = m_last_update + attotime(0, m_samples_this_update * sample_rate_attos);
 
+	// generate independent streams in parallel before the speakers pull on them
+	if (m_generate_queue)
+		generate_streams();
+
 	// clear out the mix bufers
 	std::fill_n(&m_leftmix[0], m_samples_this_update, 0);
 	std::fill_n(&m_rightmix[0], m_samples_this_update, 0);
@@ -1502,106 +2001,111 @@ void sound_manager::update(int param)
 	for (speaker_device &speaker : m_speakers)
 		speaker.mix(&m_leftmix[0], &m_rightmix[0], m_last_update, endtime, m_samples_this_update, (m_muted & MUTE_REASON_SYSTEM));
 
-	// determine the maximum in this section
-	stream_buffer::sample_t curmax = 0;
-	for (int sampindex = 0; sampindex < m_samples_this_update; sampindex++)
+	// speculative run-ahead frames are generated but never heard
+	if (!m_output_suppressed)
 	{
-		auto sample = m_leftmix[sampindex];
-		if (sample < 0)
-			sample = -sample;
-		if (sample > curmax)
-			curmax = sample;
-
-		sample = m_rightmix[sampindex];
-		if (sample < 0)
-			sample = -sample;
-		if (sample > curmax)
-			curmax = sample;
-	}
+		// determine the maximum in this section
+		stream_buffer::sample_t curmax = 0;
+		for (int sampindex = 0; sampindex < m_samples_this_update; sampindex++)
+		{
+			auto sample = m_leftmix[sampindex];
+			if (sample < 0)
+				sample = -sample;
+			if (sample > curmax)
+				curmax = sample;
+
+			sample = m_rightmix[sampindex];
+			if (sample < 0)
+				sample = -sample;
+			if (sample > curmax)
+				curmax = sample;
+		}
 
-	// pull in current compressor scale factor before modifying
-	stream_buffer::sample_t lscale = m_compressor_scale;
-	stream_buffer::sample_t rscale = m_compressor_scale;
+		// pull in current compressor scale factor before modifying
+		stream_buffer::sample_t lscale = m_compressor_scale;
+		stream_buffer::sample_t rscale = m_compressor_scale;
 
-	// if we're above what the compressor will handle, adjust the compression
-	if (curmax * m_compressor_scale > 1.0)
-	{
-		m_compressor_scale = 1.0 / curmax;
-		m_compressor_counter = STREAMS_UPDATE_FREQUENCY / 5;
-	}
+		// if we're above what the compressor will handle, adjust the compression
+		if (curmax * m_compressor_scale > 1.0)
+		{
+			m_compressor_scale = 1.0 / curmax;
+			m_compressor_counter = m_update_frequency / 5;
+		}
 
-	// if we're currently scaled, wait a bit to see if we can trend back toward 1.0
-	else if (m_compressor_counter != 0)
-		m_compressor_counter--;
+		// if we're currently scaled, wait a bit to see if we can trend back toward 1.0
+		else if (m_compressor_counter != 0)
+			m_compressor_counter--;
 
-	// try to migrate toward 0 unless we're going to introduce clipping
-	else if (m_compressor_scale < 1.0 && curmax * 1.01 * m_compressor_scale < 1.0)
-	{
-		m_compressor_scale *= 1.01f;
-		if (m_compressor_scale > 1.0)
-			m_compressor_scale = 1.0;
-	}
+		// try to migrate toward 0 unless we're going to introduce clipping
+		else if (m_compressor_scale < 1.0 && curmax * m_compressor_recovery * m_compressor_scale < 1.0)
+		{
+			m_compressor_scale *= m_compressor_recovery;
+			if (m_compressor_scale > 1.0)
+				m_compressor_scale = 1.0;
+		}
 
 #if (SOUND_DEBUG)
-	if (lscale != m_compressor_scale)
-	printf("scale=%.5f\n", m_compressor_scale);
+		if (lscale != m_compressor_scale)
+		printf("scale=%.5f\n", m_compressor_scale);
 #endif
 
-	// track whether there are pending scale changes in left/right
-	stream_buffer::sample_t lprev = 0, rprev = 0;
+		// track whether there are pending scale changes in left/right
+		stream_buffer::sample_t lprev = 0, rprev = 0;
 
-	// now downmix the final result
-	u32 finalmix_step = machine().video().speed_factor();
-	u32 finalmix_offset = 0;
-	s16 *finalmix = &m_finalmix[0];
-	int sample;
-	for (sample = m_finalmix_leftover; sample < m_samples_this_update * 1000; sample += finalmix_step)
-	{
-		int sampindex = sample / 1000;
-
-		// ensure that changing the compression won't reverse direction to reduce "pops"
-		stream_buffer::sample_t lsamp = m_leftmix[sampindex];
-		if (lscale != m_compressor_scale && sample != m_finalmix_leftover)
-			lscale = adjust_toward_compressor_scale(lscale, lprev, lsamp);
-
-		lprev = lsamp * lscale;
-		if (m_compressor_enabled)
-			lsamp = lprev;
-
-		// clamp the left side
-		if (lsamp > 1.0)
-			lsamp = 1.0;
-		else if (lsamp < -1.0)
-			lsamp = -1.0;
-		finalmix[finalmix_offset++] = s16(lsamp * 32767.0);
-
-		// ensure that changing the compression won't reverse direction to reduce "pops"
-		stream_buffer::sample_t rsamp = m_rightmix[sampindex];
-		if (rscale != m_compressor_scale && sample != m_finalmix_leftover)
-			rscale = adjust_toward_compressor_scale(rscale, rprev, rsamp);
-
-		rprev = rsamp * rscale;
-		if (m_compressor_enabled)
-			rsamp = rprev;
-
-		// clamp the right side
-		if (rsamp > 1.0)
-			rsamp = 1.0;
-		else if (rsamp < -1.0)
-			rsamp = -1.0;
-		finalmix[finalmix_offset++] = s16(rsamp * 32767.0);
-	}
-	m_finalmix_leftover = sample - m_samples_this_update * 1000;
+		// now downmix the final result
+		u32 finalmix_step = machine().video().speed_factor();
+		u32 finalmix_offset = 0;
+		s16 *finalmix = &m_finalmix[0];
+		int sample;
+		for (sample = m_finalmix_leftover; sample < m_samples_this_update * 1000; sample += finalmix_step)
+		{
+			int sampindex = sample / 1000;
+
+			// ensure that changing the compression won't reverse direction to reduce "pops"
+			stream_buffer::sample_t lsamp = m_leftmix[sampindex];
+			if (lscale != m_compressor_scale && sample != m_finalmix_leftover)
+				lscale = adjust_toward_compressor_scale(lscale, lprev, lsamp);
+
+			lprev = lsamp * lscale;
+			if (m_compressor_enabled)
+				lsamp = lprev;
+
+			// clamp the left side
+			if (lsamp > 1.0)
+				lsamp = 1.0;
+			else if (lsamp < -1.0)
+				lsamp = -1.0;
+			finalmix[finalmix_offset++] = s16(lsamp * 32767.0);
+
+			// ensure that changing the compression won't reverse direction to reduce "pops"
+			stream_buffer::sample_t rsamp = m_rightmix[sampindex];
+			if (rscale != m_compressor_scale && sample != m_finalmix_leftover)
+				rscale = adjust_toward_compressor_scale(rscale, rprev, rsamp);
+
+			rprev = rsamp * rscale;
+			if (m_compressor_enabled)
+				rsamp = rprev;
+
+			// clamp the right side
+			if (rsamp > 1.0)
+				rsamp = 1.0;
+			else if (rsamp < -1.0)
+				rsamp = -1.0;
+			finalmix[finalmix_offset++] = s16(rsamp * 32767.0);
+		}
+		m_finalmix_leftover = sample - m_samples_this_update * 1000;
 
-	// play the result
-	if (finalmix_offset > 0)
-	{
-		if (!m_nosound_mode)
-			machine().osd().update_audio_stream(finalmix, finalmix_offset / 2);
-		machine().osd().add_audio_to_recording(finalmix, finalmix_offset / 2);
-		machine().video().add_sound_to_recording(finalmix, finalmix_offset / 2);
-		if (m_wavfile)
-			util::wav_add_data_16(*m_wavfile, finalmix, finalmix_offset);
+		// play the result
+		if (finalmix_offset > 0)
+		{
+			if (!m_nosound_mode)
+				machine().osd().update_audio_stream(finalmix, finalmix_offset / 2);
+			machine().osd().add_audio_to_recording(finalmix, finalmix_offset / 2);
+			machine().video().add_sound_to_recording(finalmix, finalmix_offset / 2);
+			machine().video().add_sound_to_framehash(finalmix, finalmix_offset / 2);
+			if (m_recorder)
+				m_recorder->add(finalmix, finalmix_offset / 2);
+		}
 	}
 
 	// update any orphaned streams so they don't get too far behind
@@ -328,6 +328,25 @@ public:
 		return m_buffer->get(index);
 	}
 
+	// call func(samples, count) on each contiguous run of raw samples covering
+	// part of the view; there are at most two because of wraparound, and the
+	// gain is not applied
+	template <typename T>
+	void for_each_run(s32 start, s32 count, T &&func) const
+	{
+		sound_assert(u32(start + count) <= samples());
+		u32 index = start + m_start;
+		if (index >= m_buffer->size())
+			index -= m_buffer->size();
+		while (count > 0)
+		{
+			s32 const run = std::min<s32>(count, m_buffer->size() - index);
+			func(&m_buffer->m_buffer[index], run);
+			count -= run;
+			index = 0;
+		}
+	}
+
 protected:
 	// normalize start/end
 	void normalize_start_end()
@@ -416,12 +435,7 @@ public:
 	{
 		if (start + count > samples())
 			count = samples() - start;
-		u32 index = index_to_buffer_index(start);
-		for (s32 sampindex = 0; sampindex < count; sampindex++)
-		{
-			m_buffer->put(index, value);
-			index = m_buffer->next_index(index);
-		}
+		for_each_run(start, count, [value] (sample_t *dest, s32 run) { std::fill_n(dest, run, value); });
 	}
 	void fill(sample_t value, s32 start) { fill(value, start, samples() - start); }
 	void fill(sample_t value) { fill(value, 0, samples()); }
@@ -431,12 +445,12 @@ public:
 	{
 		if (start + count > samples())
 			count = samples() - start;
-		u32 index = index_to_buffer_index(start);
-		for (s32 sampindex = 0; sampindex < count; sampindex++)
+		sample_t const gain = src.gain();
+		for_each_span(src, start, count, [gain] (sample_t *dest, sample_t const *source, s32 run)
 		{
-			m_buffer->put(index, src.get(start + sampindex));
-			index = m_buffer->next_index(index);
-		}
+			for (s32 sampindex = 0; sampindex < run; sampindex++)
+				dest[sampindex] = source[sampindex] * gain;
+		});
 	}
 	void copy(read_stream_view const &src, s32 start) { copy(src, start, samples() - start); }
 	void copy(read_stream_view const &src) { copy(src, 0, samples()); }
@@ -446,17 +460,34 @@ public:
 	{
 		if (start + count > samples())
 			count = samples() - start;
-		u32 index = index_to_buffer_index(start);
-		for (s32 sampindex = 0; sampindex < count; sampindex++)
+		sample_t const gain = src.gain();
+		for_each_span(src, start, count, [gain] (sample_t *dest, sample_t const *source, s32 run)
 		{
-			m_buffer->put(index, m_buffer->get(index) + src.get(start + sampindex));
-			index = m_buffer->next_index(index);
-		}
+			for (s32 sampindex = 0; sampindex < run; sampindex++)
+				dest[sampindex] += source[sampindex] * gain;
+		});
 	}
 	void add(read_stream_view const &src, s32 start) { add(src, start, samples() - start); }
 	void add(read_stream_view const &src) { add(src, 0, samples()); }
 
 private:
+	// call func(dest, source, count) on runs of samples that are contiguous
+	// in both our buffer and the source's, so the loop in func can be
+	// vectorised
+	template <typename T>
+	void for_each_span(read_stream_view const &src, s32 start, s32 count, T &&func)
+	{
+		for_each_run(start, count, [&src, &start, &func] (sample_t *dest, s32 run)
+		{
+			src.for_each_run(start, run, [&dest, &func] (sample_t *source, s32 part)
+			{
+				func(dest, source, part);
+				dest += part;
+			});
+			start += run;
+		});
+	}
+
 	// given a stream starting offset, return the buffer index
 	u32 index_to_buffer_index(s32 start) const
 	{
@@ -565,6 +596,12 @@ public:
 	// tell inputs to apply sample rate changes
 	void apply_sample_rate_changes(u32 updatenum, u32 downstream_rate);
 
+	// return our resampler's stream, or nullptr if it won't be used
+	sound_stream *active_resampler();
+
+	// return the stream this input will pull from, before any resampling choice
+	sound_stream *resampler_stream() const { return m_resampler_source ? &m_resampler_source->stream() : nullptr; }
+
 private:
 	// internal state
 	sound_stream *m_owner;                   // pointer to the owning stream
@@ -682,6 +719,13 @@ private:
 	// return a view of 0 data covering the given time period
 	read_stream_view empty_view(attotime start, attotime end);
 
+	// bring inputs up to date and set up views for an update; returns true
+	// if the callback needs to be run
+	bool prepare_update(attotime end, u32 outputnum = 0);
+
+	// run the callback over the views set up by prepare_update
+	void generate();
+
 	// linking information
 	device_t &m_device;                            // owning device
 	sound_stream *m_next;                          // next stream in the chain
@@ -714,6 +758,34 @@ private:
 };
 
 
+// ======================> resampler_filter
+
+// precomputed polyphase windowed-sinc filter for converting between two
+// sample rates; shared by all resamplers with the same rate ratio
+class resampler_filter
+{
+public:
+	using sample_t = stream_buffer::sample_t;
+
+	// number of fractional positions the filter is tabulated at
+	static constexpr u32 PHASES = 256;
+
+	// construction/destruction
+	resampler_filter(u32 inrate, u32 outrate);
+
+	// return the number of input samples each output is computed from
+	u32 taps() const { return m_taps; }
+
+	// return the coefficients for the phase nearest a fractional position
+	sample_t const *coefficients(double frac) const { return &m_coeffs[u32(frac * PHASES + 0.5) * m_taps]; }
+
+private:
+	// internal state
+	u32 m_taps;                           // taps per phase, a multiple of 4
+	std::vector<sample_t> m_coeffs;       // PHASES + 1 rows of coefficients
+};
+
+
 // ======================> default_resampler_stream
 
 class default_resampler_stream : public sound_stream
@@ -726,8 +798,15 @@ public:
 	void resampler_sound_update(sound_stream &stream, std::vector<read_stream_view> const &inputs, std::vector<write_stream_view> &outputs);
 
 private:
+	// largest input:output ratio the polyphase filter is used for
+	static constexpr stream_buffer::sample_t MAX_FILTER_STEP = 4.0;
+
 	// internal state
 	u32 m_max_latency;
+	resampler_filter const *m_filter;     // filter for the current rates, or nullptr
+	u32 m_filter_inrate;                  // input rate the filter was fetched for
+	u32 m_filter_outrate;                 // output rate the filter was fetched for
+	std::vector<stream_buffer::sample_t> m_history; // contiguous, gain-scaled copy of the input
 };
 
 
@@ -767,14 +846,16 @@ public:
 	const std::vector<std::unique_ptr<sound_stream>> &streams() const { return m_stream_list; }
 	attotime last_update() const { return m_last_update; }
 	int sample_count() const { return m_samples_this_update; }
+	int update_frequency() const { return m_update_frequency; }
+	attotime output_latency() const;
 	int unique_id() { return m_unique_id++; }
 	stream_buffer::sample_t compressor_scale() const { return m_compressor_scale; }
 
 	// allocate a new stream with a new-style callback
 	sound_stream *stream_alloc(device_t &device, u32 inputs, u32 outputs, u32 sample_rate, stream_update_delegate callback, sound_stream_flags flags);
 
-	// WAV recording
-	bool is_recording() const { return bool(m_wavfile); }
+	// WAV or FLAC recording, chosen by the file extension
+	bool is_recording() const { return bool(m_recorder); }
 	bool start_recording();
 	bool start_recording(std::string_view filename);
 	void stop_recording();
@@ -791,12 +872,18 @@ public:
 	void debugger_mute(bool turn_off) { mute(turn_off, MUTE_REASON_DEBUGGER); }
 	void system_mute(bool turn_off) { mute(turn_off, MUTE_REASON_SYSTEM); }
 
+	// keep generating samples without passing them on to the OSD or recordings
+	void set_output_suppressed(bool suppressed) { m_output_suppressed = suppressed; }
+
 	// return information about the given mixer input, by index
 	bool indexed_mixer_input(int index, mixer_input &info) const;
 
 	// fill the given buffer with 16-bit stereo audio samples
 	void samples(s16 *buffer);
 
+	// return the shared resampling filter for a pair of rates
+	resampler_filter const &resampler_filter_for(u32 inrate, u32 outrate);
+
 private:
 	// set/reset the mute state for the given reason
 	void mute(bool mute, u8 reason);
@@ -821,12 +908,20 @@ private:
 	// helper to adjust scale factor toward a goal
 	stream_buffer::sample_t adjust_toward_compressor_scale(stream_buffer::sample_t curscale, stream_buffer::sample_t prevsample, stream_buffer::sample_t rawsample);
 
-	// periodic sound update, called STREAMS_UPDATE_FREQUENCY per second
+	// periodic sound update, called update_frequency() times per second
 	void update(s32 param = 0);
 
+	// build the dependency levels used to generate streams in parallel
+	int schedule_stream(sound_stream &stream, sound_stream_input *resampled, std::map<sound_stream *, int> &levels);
+
+	// bring every scheduled stream up to date, using worker threads
+	void generate_streams();
+	static void *generate_stream_callback(void *param, int threadid);
+
 	// internal state
 	running_machine &m_machine;           // reference to the running machine
 	emu_timer *m_update_timer;            // timer that runs the update function
+	int m_update_frequency;               // number of updates per second
 	std::vector<std::reference_wrapper<speaker_device> > m_speakers;
 
 	u32 m_update_number;                  // current update index; used for sample rate updates
@@ -839,18 +934,32 @@ private:
 
 	stream_buffer::sample_t m_compressor_scale; // current compressor scale factor
 	int m_compressor_counter;             // compressor update counter for backoff
+	stream_buffer::sample_t m_compressor_recovery; // per-update factor for recovering toward 1.0
 	bool m_compressor_enabled;            // enable compressor (it will still be calculated for detecting overdrive)
 
 	u8 m_muted;                           // bitmask of muting reasons
 	bool m_nosound_mode;                  // true if we're in "nosound" mode
+	bool m_output_suppressed;             // true while run-ahead frames are being generated
 	int m_attenuation;                    // current attentuation level (at the OSD)
 	int m_unique_id;                      // unique ID used for stream identification
-	util::wav_file_ptr m_wavfile;         // WAV file for streaming
+	class recorder;
+	std::unique_ptr<recorder> m_recorder; // audio file for streaming, written in the background
 
 	// streams data
 	std::vector<std::unique_ptr<sound_stream>> m_stream_list; // list of streams
 	std::map<sound_stream *, u8> m_orphan_stream_list; // list of orphaned streams
+	std::map<std::pair<u32, u32>, std::unique_ptr<resampler_filter>> m_resampler_filters; // resampling filters by reduced rate ratio
 	bool m_first_reset;                   // is this our first reset?
+
+	// parallel generation
+	struct scheduled_stream
+	{
+		sound_stream *stream;             // stream to generate
+		sound_stream_input *resampled;    // input a resampler stream belongs to, or nullptr
+	};
+	osd_work_queue *m_generate_queue;     // work queue for generating streams, or nullptr
+	std::vector<std::vector<scheduled_stream>> m_stream_levels; // streams grouped so each depends only on earlier groups
+	std::vector<sound_stream *> m_generate_list; // streams with work to do in the current group
 };
 
 
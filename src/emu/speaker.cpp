@@ -89,24 +89,32 @@ void speaker_device::mix(stream_buffer::sample_t *leftmix, stream_buffer::sample
 	// mix if sound is enabled
 	if (!suppress)
 	{
-		// if the speaker is centered, send to both left and right
-		if (m_x == 0)
-			for (int sample = 0; sample < expected_samples; sample++)
-			{
-				stream_buffer::sample_t cursample = view.get(sample);
-				leftmix[sample] += cursample;
-				rightmix[sample] += cursample;
-			}
+		// work on contiguous runs of the stream buffer so the loops vectorise
+		stream_buffer::sample_t const gain = view.gain();
+		view.for_each_run(0, expected_samples, [this, gain, &leftmix, &rightmix] (stream_buffer::sample_t const *src, s32 run)
+		{
+			// if the speaker is centered, send to both left and right
+			if (m_x == 0)
+				for (int sample = 0; sample < run; sample++)
+				{
+					stream_buffer::sample_t cursample = src[sample] * gain;
+					leftmix[sample] += cursample;
+					rightmix[sample] += cursample;
+				}
+
+			// if the speaker is to the left, send only to the left
+			else if (m_x < 0)
+				for (int sample = 0; sample < run; sample++)
+					leftmix[sample] += src[sample] * gain;
 
-		// if the speaker is to the left, send only to the left
-		else if (m_x < 0)
-			for (int sample = 0; sample < expected_samples; sample++)
-				leftmix[sample] += view.get(sample);
+			// if the speaker is to the right, send only to the right
+			else
+				for (int sample = 0; sample < run; sample++)
+					rightmix[sample] += src[sample] * gain;
 
-		// if the speaker is to the right, send only to the right
-		else
-			for (int sample = 0; sample < expected_samples; sample++)
-				rightmix[sample] += view.get(sample);
+			leftmix += run;
+			rightmix += run;
+		});
 	}
 }
 
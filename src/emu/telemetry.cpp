@@ -0,0 +1,207 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    telemetry.cpp
+
+    Per-frame performance telemetry (-telemetry, -telemetryoutputs).
+
+    Each finished frame produces one record with the emulated and host
+    time it took, the time spent presenting it and throttling, how far
+    the throttle overslept, the scheduler timeslices, sound underflows
+    and the cycles and host time of every executing device.  Records are
+    written as JSON lines, or as CSV with a header row if the file name
+    ends in .csv, and can also be published through the output manager
+    (and so the network output provider) as telemetry_* values, with
+    times in microseconds and the speed in tenths of a percent.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "telemetry.h"
+
+#include "fileio.h"
+#include "osdepend.h"
+
+#include "path.h"
+
+
+
+//**************************************************************************
+//  FRAME TELEMETRY
+//**************************************************************************
+
+//-------------------------------------------------
+//  frame_telemetry - constructor
+//-------------------------------------------------
+
+frame_telemetry::frame_telemetry(running_machine &machine, bool outputs)
+	: m_machine(machine)
+	, m_csv(false)
+	, m_outputs(outputs)
+	, m_frames(0)
+	, m_last_ticks(0)
+	, m_last_emutime(attotime::zero)
+	, m_last_timeslices(0)
+	, m_last_underflows(-1)
+	, m_render_ticks(0)
+	, m_throttle_ticks(0)
+	, m_overshoot_ticks(0)
+{
+}
+
+
+//-------------------------------------------------
+//  ~frame_telemetry - destructor
+//-------------------------------------------------
+
+frame_telemetry::~frame_telemetry()
+{
+	m_machine.scheduler().set_host_timing(false);
+	if (m_file)
+		osd_printf_verbose("Telemetry: wrote %u frames\n", m_frames);
+}
+
+
+//-------------------------------------------------
+//  create - start reporting telemetry; returns
+//  nullptr after reporting the problem on failure
+//-------------------------------------------------
+
+frame_telemetry::ptr frame_telemetry::create(running_machine &machine, std::string_view filename, bool outputs)
+{
+	ptr result(new frame_telemetry(machine, outputs));
+
+	if (!filename.empty())
+	{
+		result->m_file = std::make_unique<emu_file>(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		std::error_condition const filerr(result->m_file->open(filename));
+		if (filerr)
+		{
+			osd_printf_error("Error opening telemetry file %s (%s)\n", filename, filerr.message());
+			return nullptr;
+		}
+		result->m_csv = core_filename_ends_with(filename, ".csv");
+	}
+
+	for (device_execute_interface &exec : execute_interface_enumerator(machine.root_device()))
+	{
+		output_manager::handle output;
+		if (outputs)
+			output = machine.output().get_handle(std::string("telemetry_us") + exec.device().tag());
+		result->m_devices.push_back(telemetry_device{ &exec, exec.total_cycles(), exec.host_ticks(), output });
+	}
+
+	result->m_last_ticks = osd_ticks();
+	result->m_last_emutime = machine.time();
+	result->m_last_timeslices = machine.scheduler().timeslices();
+	result->m_last_underflows = machine.osd().audio_underflows();
+	machine.scheduler().set_host_timing(true);
+
+	if (result->m_file && result->m_csv)
+		result->write_header();
+	return result;
+}
+
+
+//-------------------------------------------------
+//  write_header - write the CSV column names
+//-------------------------------------------------
+
+void frame_telemetry::write_header()
+{
+	m_line = "frame,emu_time,emu_us,host_us,speed,timeslices,render_us,throttle_us,overshoot_us,underflows";
+	for (telemetry_device const &device : m_devices)
+		m_line.append(util::string_format(",%s cycles,%s us", device.exec->device().tag(), device.exec->device().tag()));
+	m_line.append("\n");
+	m_file->puts(m_line);
+}
+
+
+//-------------------------------------------------
+//  frame - report the frame that just finished
+//-------------------------------------------------
+
+void frame_telemetry::frame(attotime const &emutime)
+{
+	double const us_per_tick(1.0e6 / double(osd_ticks_per_second()));
+	osd_ticks_t const now(osd_ticks());
+	u64 const timeslices(m_machine.scheduler().timeslices());
+	int const underflows(m_machine.osd().audio_underflows());
+
+	// a save state load or reset can move emulated time backwards
+	double const emu_us((emutime >= m_last_emutime) ? ((emutime - m_last_emutime).as_double() * 1.0e6) : 0.0);
+	double const host_us(double(now - m_last_ticks) * us_per_tick);
+	double const speed(host_us ? (emu_us * 100.0 / host_us) : 0.0);
+	double const render_us(double(m_render_ticks) * us_per_tick);
+	double const throttle_us(double(m_throttle_ticks) * us_per_tick);
+	double const overshoot_us(double(m_overshoot_ticks) * us_per_tick);
+	int const new_underflows(((underflows >= 0) && (m_last_underflows >= 0)) ? (underflows - m_last_underflows) : -1);
+	m_frames++;
+
+	if (m_file)
+	{
+		if (m_csv)
+		{
+			m_line = util::string_format("%u,%.6f,%.1f,%.1f,%.2f,%u,%.1f,%.1f,%.1f,",
+					m_frames, emutime.as_double(), emu_us, host_us, speed, timeslices - m_last_timeslices, render_us, throttle_us, overshoot_us);
+			if (new_underflows >= 0)
+				m_line.append(util::string_format("%d", new_underflows));
+		}
+		else
+		{
+			m_line = util::string_format("{\"frame\":%u,\"emu_time\":%.6f,\"emu_us\":%.1f,\"host_us\":%.1f,\"speed\":%.2f,\"timeslices\":%u,\"render_us\":%.1f,\"throttle_us\":%.1f,\"overshoot_us\":%.1f,\"underflows\":",
+					m_frames, emutime.as_double(), emu_us, host_us, speed, timeslices - m_last_timeslices, render_us, throttle_us, overshoot_us);
+			m_line.append((new_underflows >= 0) ? util::string_format("%d", new_underflows) : std::string("null"));
+			m_line.append(",\"devices\":{");
+		}
+	}
+
+	bool first(true);
+	for (telemetry_device &device : m_devices)
+	{
+		u64 const cycles(device.exec->total_cycles());
+		osd_ticks_t const host_ticks(device.exec->host_ticks());
+		double const device_us(double(host_ticks - device.host_ticks) * us_per_tick);
+		if (m_file)
+		{
+			if (m_csv)
+				m_line.append(util::string_format(",%u,%.1f", cycles - device.cycles, device_us));
+			else
+				m_line.append(util::string_format("%s\"%s\":{\"cycles\":%u,\"us\":%.1f}", first ? "" : ",", device.exec->device().tag(), cycles - device.cycles, device_us));
+		}
+		if (m_outputs)
+			device.output.set(s32(device_us + 0.5));
+		device.cycles = cycles;
+		device.host_ticks = host_ticks;
+		first = false;
+	}
+
+	if (m_file)
+	{
+		m_line.append(m_csv ? "\n" : "}}\n");
+		m_file->puts(m_line);
+	}
+
+	if (m_outputs)
+	{
+		output_manager &output(m_machine.output());
+		output.set_value("telemetry_frame", s32(m_frames));
+		output.set_value("telemetry_emu_us", s32(emu_us + 0.5));
+		output.set_value("telemetry_host_us", s32(host_us + 0.5));
+		output.set_value("telemetry_speed", s32(speed * 10.0 + 0.5));
+		output.set_value("telemetry_timeslices", s32(timeslices - m_last_timeslices));
+		output.set_value("telemetry_render_us", s32(render_us + 0.5));
+		output.set_value("telemetry_throttle_us", s32(throttle_us + 0.5));
+		output.set_value("telemetry_overshoot_us", s32(overshoot_us + 0.5));
+		output.set_value("telemetry_underflows", new_underflows);
+	}
+
+	m_last_ticks = now;
+	m_last_emutime = emutime;
+	m_last_timeslices = timeslices;
+	m_last_underflows = underflows;
+	m_render_ticks = 0;
+	m_throttle_ticks = 0;
+	m_overshoot_ticks = 0;
+}
@@ -0,0 +1,80 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    telemetry.h
+
+    Per-frame performance telemetry (-telemetry, -telemetryoutputs).
+
+***************************************************************************/
+
+#ifndef MAME_EMU_TELEMETRY_H
+#define MAME_EMU_TELEMETRY_H
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> frame_telemetry
+
+class frame_telemetry
+{
+public:
+	typedef std::unique_ptr<frame_telemetry> ptr;
+
+	// dtor
+	~frame_telemetry();
+
+	// host time spent presenting and throttling during the current frame
+	void add_render(osd_ticks_t ticks) { m_render_ticks += ticks; }
+	void add_throttle(osd_ticks_t slept, osd_ticks_t overshoot) { m_throttle_ticks += slept; m_overshoot_ticks += overshoot; }
+
+	// report a finished frame
+	void frame(attotime const &emutime);
+
+	// statics
+	static ptr create(running_machine &machine, std::string_view filename, bool outputs);
+
+private:
+	// an executing device and its counters at the last frame
+	struct telemetry_device
+	{
+		device_execute_interface *exec;
+		u64                 cycles;         // total cycles at the last frame
+		osd_ticks_t         host_ticks;     // host ticks at the last frame
+		output_manager::handle output;      // output for the per-device time
+	};
+
+	// ctor
+	frame_telemetry(running_machine &machine, bool outputs);
+	frame_telemetry(frame_telemetry const &) = delete;
+	frame_telemetry &operator=(frame_telemetry const &) = delete;
+
+	// internal helpers
+	void write_header();
+
+	running_machine &   m_machine;
+	std::unique_ptr<emu_file> m_file;       // stream being written, null if only publishing outputs
+	bool                m_csv;              // write CSV rather than JSON lines
+	bool const          m_outputs;          // publish values through the output manager
+	std::vector<telemetry_device> m_devices;
+	std::string         m_line;             // record being built
+	u64                 m_frames;           // frames reported
+	osd_ticks_t         m_last_ticks;       // host time at the last frame
+	attotime            m_last_emutime;     // emulated time at the last frame
+	u64                 m_last_timeslices;  // scheduler timeslices at the last frame
+	int                 m_last_underflows;  // sound underflows at the last frame, -1 if unknown
+	osd_ticks_t         m_render_ticks;     // time spent in the OSD update this frame
+	osd_ticks_t         m_throttle_ticks;   // time spent throttling this frame
+	osd_ticks_t         m_overshoot_ticks;  // time the throttle slept past its target this frame
+};
+
+#endif // MAME_EMU_TELEMETRY_H
@@ -380,6 +380,7 @@ void tilemap_t::init_common(
 	m_attributes = 0;
 	m_all_tiles_dirty = true;
 	m_all_tiles_clean = false;
+	m_all_changed = true;
 	m_palette_offset = 0;
 	m_gfx_used = 0;
 	memset(m_gfx_dirtyseq, 0, sizeof(m_gfx_dirtyseq));
@@ -506,6 +507,7 @@ void tilemap_t::mark_tile_dirty(tilemap_memory_index memindex)
 		if (logindex != INVALID_LOGICAL_INDEX)
 		{
 			m_tileflags[logindex] = TILE_FLAG_DIRTY;
+			m_tilechanged[logindex] = 1;
 			m_all_tiles_clean = false;
 		}
 	}
@@ -701,6 +703,7 @@ void tilemap_t::mappings_create()
 	m_memory_to_logical.resize(max_memory_index);
 	m_logical_to_memory.resize(max_logical_index);
 	m_tileflags.resize(max_logical_index);
+	m_tilechanged.resize(max_logical_index);
 
 	// update the mappings
 	mappings_update();
@@ -754,6 +757,7 @@ inline void tilemap_t::realize_all_dirty_tiles()
 	{
 		memset(&m_tileflags[0], TILE_FLAG_DIRTY, m_tileflags.size());
 		m_all_tiles_dirty = false;
+		m_all_changed = true;
 		m_gfx_used = 0;
 	}
 }
@@ -1105,6 +1109,116 @@ void tilemap_t::draw(screen_device &screen, bitmap_rgb32 &dest, const rectangle
 { draw_common(screen, dest, cliprect, flags, priority, priority_mask); }
 
 
+//-------------------------------------------------
+//  changed_regions - append the parts of cliprect
+//  that may look different from the previous
+//  call, for screen updates that keep their
+//  bitmap between frames
+//-------------------------------------------------
+
+bool tilemap_t::view_state::operator==(const view_state &rhs) const
+{
+	return cliprect == rhs.cliprect && visarea == rhs.visarea && enable == rhs.enable && attributes == rhs.attributes &&
+		palette_offset == rhs.palette_offset && rowscroll == rhs.rowscroll && colscroll == rhs.colscroll;
+}
+
+void tilemap_t::changed_regions(screen_device &screen, const rectangle &cliprect, std::vector<rectangle> &regions)
+{
+	// more regions than this are reported as the whole cliprect
+	static constexpr size_t MAX_REGIONS = 64;
+
+	// flush the dirty state to all tiles as appropriate
+	realize_all_dirty_tiles();
+
+	// capture everything that decides where the pixels end up, the same way draw_common does
+	rectangle const visarea = screen.visible_area();
+	u32 const xextent = visarea.right() + visarea.left() + 1;
+	u32 const yextent = visarea.bottom() + visarea.top() + 1;
+	view_state view;
+	view.cliprect = cliprect;
+	view.visarea = visarea;
+	view.enable = m_enable;
+	view.attributes = m_attributes;
+	view.palette_offset = m_palette_offset;
+	for (int index = 0; index < m_scrollrows; index++)
+		view.rowscroll.push_back(effective_rowscroll(index, xextent));
+	for (int index = 0; index < m_scrollcols; index++)
+		view.colscroll.push_back(effective_colscroll(index, yextent));
+
+	bool const moved = !(view == m_view);
+	m_view = std::move(view);
+
+	if (m_all_changed || moved)
+	{
+		// everything moved or changed
+		regions.push_back(cliprect);
+	}
+	else if (m_enable && (m_scrollrows == 1 || m_scrollcols == 1))
+	{
+		size_t const first = regions.size();
+		bool const rowscroll = m_scrollrows > 1;
+		bool const colscroll = m_scrollcols > 1;
+		int const scrollx = m_view.rowscroll[0];
+		int const scrolly = m_view.colscroll[0];
+
+		// gather runs of changed tiles in each row
+		logical_index logindex = 0;
+		for (u32 row = 0; row < m_rows && regions.size() - first <= MAX_REGIONS; row++)
+		{
+			for (u32 col = 0; col < m_cols; )
+			{
+				if (!m_tilechanged[logindex + col])
+				{
+					col++;
+					continue;
+				}
+				u32 endcol = col + 1;
+				while (endcol < m_cols && m_tilechanged[logindex + endcol])
+					endcol++;
+
+				// tilemap pixels covered by the run; rows scrolled independently
+				// cover the full width, columns scrolled independently the full height
+				rectangle const tiles(col * m_tilewidth, endcol * m_tilewidth - 1, row * m_tileheight, (row + 1) * m_tileheight - 1);
+				for (int ypos = colscroll ? 0 : scrolly - int(m_height); ypos <= cliprect.bottom(); ypos += m_height)
+				{
+					for (int xpos = rowscroll ? 0 : scrollx - int(m_width); xpos <= cliprect.right(); xpos += m_width)
+					{
+						rectangle region(tiles.left() + xpos, tiles.right() + xpos, tiles.top() + ypos, tiles.bottom() + ypos);
+						if (rowscroll)
+							region.setx(cliprect.left(), cliprect.right());
+						if (colscroll)
+							region.sety(cliprect.top(), cliprect.bottom());
+						region &= cliprect;
+						if (!region.empty())
+							regions.push_back(region);
+						if (rowscroll)
+							break;
+					}
+					if (colscroll)
+						break;
+				}
+				col = endcol;
+			}
+			logindex += m_cols;
+		}
+
+		// too fragmented to be worth it
+		if (regions.size() - first > MAX_REGIONS)
+		{
+			regions.resize(first);
+			regions.push_back(cliprect);
+		}
+	}
+	else if (m_enable && std::find(m_tilechanged.begin(), m_tilechanged.end(), 1) != m_tilechanged.end())
+	{
+		regions.push_back(cliprect);
+	}
+
+	m_all_changed = false;
+	std::fill(m_tilechanged.begin(), m_tilechanged.end(), 0);
+}
+
+
 //-------------------------------------------------
 //  draw_roz - draw a tilemap to the destination
 //  with clipping and arbitrary rotate/zoom; pixels
@@ -1344,6 +1458,23 @@ do {                                                                        \
 		*dest = alpha_blend_r32(*dest, clut[INPUT_VAL], alpha);             \
 } while (0)
 
+// narrow [first, last] to the columns where start + column * inc, which
+// mustn't wrap round, is below limit
+static inline void roz_clip_span(u32 start, int inc, s64 limit, int &first, int &last)
+{
+	if (inc >= 0)
+	{
+		if (s64(start) >= limit)
+			last = -1;
+		else if (inc > 0)
+			last = std::min<s64>(last, (limit - s64(start) + inc - 1) / inc - 1);
+	}
+	else if (s64(start) >= limit)
+	{
+		first = std::max<s64>(first, (s64(start) - limit) / -s64(inc) + 1);
+	}
+}
+
 template<class _BitmapClass>
 void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, const blit_parameters &blit,
 		u32 startx, u32 starty, int incxx, int incxy, int incyx, int incyy, bool wraparound)
@@ -1430,6 +1561,11 @@ void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, c
 	// wraparound case
 	else if (wraparound)
 	{
+		const u16 *const srcbase = &m_pixmap.pix(0);
+		const u8 *const maskbase = &m_flagsmap.pix(0);
+		const int srcrow = m_pixmap.rowpixels();
+		const int maskrow = m_flagsmap.rowpixels();
+
 		// loop over rows
 		while (sy <= ey)
 		{
@@ -1446,9 +1582,11 @@ void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, c
 			while (x <= ex)
 			{
 				// plot if we match the mask
-				if ((m_flagsmap.pix((cy >> 16) & ymask, (cx >> 16) & xmask) & mask) == value)
+				const int px = (cx >> 16) & xmask;
+				const int py = (cy >> 16) & ymask;
+				if ((maskbase[py * maskrow + px] & mask) == value)
 				{
-					ROZ_PLOT_PIXEL(m_pixmap.pix((cy >> 16) & ymask, (cx >> 16) & xmask));
+					ROZ_PLOT_PIXEL(srcbase[py * srcrow + px]);
 					if (priority != 0xff00)
 						*pri = (*pri & (priority >> 8)) | priority;
 				}
@@ -1472,37 +1610,86 @@ void tilemap_t::draw_roz_core(screen_device &screen, _BitmapClass &destbitmap, c
 	// non-wraparound case
 	else
 	{
+		const u16 *const srcbase = &m_pixmap.pix(0);
+		const u8 *const maskbase = &m_flagsmap.pix(0);
+		const int srcrow = m_pixmap.rowpixels();
+		const int maskrow = m_flagsmap.rowpixels();
+		const int count = ex - sx + 1;
+
 		// loop over rows
 		while (sy <= ey)
 		{
-			// initialize X counters
-			int x = sx;
-			u32 cx = startx;
-			u32 cy = starty;
-
-			// get dest and priority pointers
-			typename _BitmapClass::pixel_t *dest = &destbitmap.pix(sy, sx);
-			u8 *pri = (priority != 0xff00) ? &priority_bitmap.pix(sy, sx) : nullptr;
-
-			// loop over columns
-			while (x <= ex)
+			// work out which columns fall within the bitmap so only they are visited,
+			// with no bounds checks; this is only exact if the coordinates don't
+			// wrap round within the row, as they could then come back into it
+			const s64 lastx = s64(startx) + s64(count - 1) * incxx;
+			const s64 lasty = s64(starty) + s64(count - 1) * incxy;
+			if (lastx >= 0 && lastx <= 0xffffffff && lasty >= 0 && lasty <= 0xffffffff)
 			{
-				// plot if we're within the bitmap and we match the mask
-				if (cx < widthshifted && cy < heightshifted)
-					if ((m_flagsmap.pix(cy >> 16, cx >> 16) & mask) == value)
+				int first = 0, last = count - 1;
+				roz_clip_span(startx, incxx, widthshifted, first, last);
+				roz_clip_span(starty, incxy, heightshifted, first, last);
+				if (first <= last)
+				{
+					// get dest and priority pointers
+					typename _BitmapClass::pixel_t *dest = &destbitmap.pix(sy, sx + first);
+					u8 *pri = (priority != 0xff00) ? &priority_bitmap.pix(sy, sx + first) : nullptr;
+					u32 cx = startx + u32(first) * u32(incxx);
+					u32 cy = starty + u32(first) * u32(incxy);
+
+					// loop over columns
+					for (int x = first; x <= last; x++)
 					{
-						ROZ_PLOT_PIXEL(m_pixmap.pix(cy >> 16, cx >> 16));
+						// plot if we match the mask
+						const int px = cx >> 16;
+						const int py = cy >> 16;
+						if ((maskbase[py * maskrow + px] & mask) == value)
+						{
+							ROZ_PLOT_PIXEL(srcbase[py * srcrow + px]);
+							if (priority != 0xff00)
+								*pri = (*pri & (priority >> 8)) | priority;
+						}
+
+						// advance in X
+						cx += incxx;
+						cy += incxy;
+						++dest;
 						if (priority != 0xff00)
-							*pri = (*pri & (priority >> 8)) | priority;
+							pri++;
 					}
+				}
+			}
+			else
+			{
+				// initialize X counters
+				int x = sx;
+				u32 cx = startx;
+				u32 cy = starty;
 
-				// advance in X
-				cx += incxx;
-				cy += incxy;
-				x++;
-				++dest;
-				if (priority != 0xff00)
-					pri++;
+				// get dest and priority pointers
+				typename _BitmapClass::pixel_t *dest = &destbitmap.pix(sy, sx);
+				u8 *pri = (priority != 0xff00) ? &priority_bitmap.pix(sy, sx) : nullptr;
+
+				// loop over columns
+				while (x <= ex)
+				{
+					// plot if we're within the bitmap and we match the mask
+					if (cx < widthshifted && cy < heightshifted)
+						if ((m_flagsmap.pix(cy >> 16, cx >> 16) & mask) == value)
+						{
+							ROZ_PLOT_PIXEL(m_pixmap.pix(cy >> 16, cx >> 16));
+							if (priority != 0xff00)
+								*pri = (*pri & (priority >> 8)) | priority;
+						}
+
+					// advance in X
+					cx += incxx;
+					cy += incxy;
+					x++;
+					++dest;
+					if (priority != 0xff00)
+						pri++;
+				}
 			}
 
 			// advance in Y
@@ -1647,6 +1834,19 @@ void tilemap_manager::mark_all_dirty()
 }
 
 
+//-------------------------------------------------
+//  update_all - render all dirty tiles into the
+//  pixmaps of all the tilemaps, so that drawing
+//  them afterwards does not modify them
+//-------------------------------------------------
+
+void tilemap_manager::update_all()
+{
+	for (tilemap_t &tmap : m_tilemap_list)
+		tmap.pixmap_update();
+}
+
+
 
 //**************************************************************************
 //  TILEMAP DEVICE
@@ -296,6 +296,26 @@
         a single pen in a group, pass a mask of ~0. The helper function
         tilemap_t::map_pen_to_layer() does this for you.
 
+    * Screens with mostly static tilemaps can keep their bitmap between
+        frames and only redraw what changed. tilemap_t::changed_regions()
+        appends the screen rectangles whose pixels may differ from the
+        previous call: the tiles marked dirty since then, or the whole
+        cliprect if scrolling, flipping, enabling, the palette offset or
+        the gfx changed. Redraw every layer clipped to each rectangle,
+        in the usual order. This is only valid if nothing else drew into
+        the bitmap (or the priority bitmap) in between, and if the draw
+        flags are the same every frame. Collect the regions of all
+        tilemaps on the screen before drawing any of them:
+
+            std::vector<rectangle> regions;
+            m_bg->changed_regions(screen, cliprect, regions);
+            m_fg->changed_regions(screen, cliprect, regions);
+            for (const rectangle &clip : regions)
+            {
+                m_bg->draw(screen, bitmap, clip, TILEMAP_DRAW_OPAQUE);
+                m_fg->draw(screen, bitmap, clip, 0);
+            }
+
 ***************************************************************************/
 
 #ifndef MAME_EMU_TILEMAP_H
@@ -486,6 +506,9 @@ public:
 	void set_transmask(int group, u32 fgmask, u32 bgmask);
 	void configure_groups(gfx_element &gfx, indirect_pen_t transcolor);
 
+	// change tracking
+	void changed_regions(screen_device &screen, const rectangle &cliprect, std::vector<rectangle> &regions);
+
 	// drawing
 	void draw(screen_device &screen, bitmap_ind16 &dest, const rectangle &cliprect, u32 flags = TILEMAP_DRAW_ALL_CATEGORIES, u8 priority = 0, u8 priority_mask = 0xff);
 	void draw(screen_device &screen, bitmap_rgb32 &dest, const rectangle &cliprect, u32 flags = TILEMAP_DRAW_ALL_CATEGORIES, u8 priority = 0, u8 priority_mask = 0xff);
@@ -608,6 +631,23 @@ private:
 	bitmap_ind8                 m_flagsmap;             // per-pixel flags
 	std::vector<u8>             m_tileflags;            // per-tile flags
 	u8                          m_pen_to_flags[MAX_PEN_TO_FLAGS * TILEMAP_NUM_GROUPS]; // mapping of pens to flags
+
+	// change tracking for changed_regions()
+	struct view_state
+	{
+		bool operator==(const view_state &rhs) const;
+
+		rectangle                   cliprect;               // cliprect of the last call
+		rectangle                   visarea;                // visible area of the last call
+		bool                        enable;                 // enable state
+		u8                          attributes;             // flip state
+		u32                         palette_offset;         // palette offset
+		std::vector<s32>            rowscroll;              // effective rowscroll values
+		std::vector<s32>            colscroll;              // effective colscroll values
+	};
+	std::vector<u8>             m_tilechanged;          // per-tile flag, set when a tile was dirtied
+	bool                        m_all_changed;          // true if everything must be reported
+	view_state                  m_view;                 // view at the last changed_regions() call
 };
 
 
@@ -641,6 +681,7 @@ public:
 	// global operations on all tilemaps
 	void mark_all_dirty();
 	void set_flip_all(u32 attributes);
+	void update_all();
 
 private:
 	// tilemap creation
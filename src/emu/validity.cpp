@@ -20,7 +20,11 @@
 #include "path.h"
 #include "unicode.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <future>
+#include <thread>
 #include <type_traits>
 #include <typeinfo>
 
@@ -1682,6 +1686,14 @@ void validate_delegates_functoid()
 		osd_printf_error("Error testing delegate with functoid requiring adapter %p (expected %p)\n", addr, static_cast<void const *>(&cb1));
 }
 
+
+//-------------------------------------------------
+//  worker checker validating on this thread, so
+//  output can be routed to it
+//-------------------------------------------------
+
+thread_local validity_checker *t_worker = nullptr;
+
 } // anonymous namespace
 
 
@@ -1772,6 +1784,8 @@ validity_checker::validity_checker(emu_options &options, bool quick)
 	, m_current_ioport(nullptr)
 	, m_checking_card(false)
 	, m_quick(quick)
+	, m_parent(nullptr)
+	, m_buffered_output(nullptr)
 {
 	// pre-populate the defstr map with all the default strings
 	for (int strnum = 1; strnum < INPUT_STRING_COUNT; strnum++)
@@ -1782,13 +1796,38 @@ validity_checker::validity_checker(emu_options &options, bool quick)
 	}
 }
 
+//-------------------------------------------------
+//  validity_checker - construct a worker that
+//  validates drivers on another thread
+//-------------------------------------------------
+
+validity_checker::validity_checker(validity_checker &parent)
+	: m_drivlist(parent.m_drivlist.options())
+	, m_errors(0)
+	, m_warnings(0)
+	, m_print_verbose(parent.m_print_verbose)
+	, m_names_map(parent.m_names_map)
+	, m_descriptions_map(parent.m_descriptions_map)
+	, m_defstr_map(parent.m_defstr_map)
+	, m_current_driver(nullptr)
+	, m_current_device(nullptr)
+	, m_current_ioport(nullptr)
+	, m_checking_card(false)
+	, m_quick(parent.m_quick)
+	, m_parent(&parent)
+	, m_buffered_output(nullptr)
+{
+}
+
 //-------------------------------------------------
 //  validity_checker - destructor
 //-------------------------------------------------
 
 validity_checker::~validity_checker()
 {
-	validate_end();
+	// workers never take over the output callbacks
+	if (!m_parent)
+		validate_end();
 }
 
 //-------------------------------------------------
@@ -1814,11 +1853,17 @@ void validity_checker::check_shared_source(const game_driver &driver)
 	// initialize
 	validate_begin();
 
-	// then iterate over all drivers and check the ones that share the same source file
-	m_drivlist.reset();
-	while (m_drivlist.next())
-		if (strcmp(driver.type.source(), m_drivlist.driver().type.source()) == 0)
-			validate_one(m_drivlist.driver());
+	// then check all the drivers that share the same source file
+	int const index = driver_list::find(driver);
+	if (index >= 0)
+	{
+		auto const shared(driver_list::same_source(index));
+		for (int const *scan = shared.first; shared.second != scan; ++scan)
+		{
+			if (m_drivlist.included(*scan))
+				validate_one(m_drivlist.driver(*scan));
+		}
+	}
 
 	// cleanup
 	validate_end();
@@ -1855,16 +1900,15 @@ bool validity_checker::check_all_matching(const char *string)
 	}
 
 	// then iterate over all drivers and check them
+	std::vector<std::size_t> drivers;
 	m_drivlist.reset();
-	bool validated_any = false;
 	while (m_drivlist.next())
 	{
 		if (driver_list::matches(string, m_drivlist.driver().name))
-		{
-			validate_one(m_drivlist.driver());
-			validated_any = true;
-		}
+			drivers.emplace_back(m_drivlist.current());
 	}
+	bool const validated_any = !drivers.empty();
+	validate_drivers(drivers);
 
 	// validate devices
 	if (!string)
@@ -1899,7 +1943,6 @@ void validity_checker::validate_begin()
 	m_defstr_map.clear();
 	m_region_map.clear();
 	m_ioport_set.clear();
-	m_slotcard_set.clear();
 
 	// reset internal state
 	m_errors = 0;
@@ -1920,6 +1963,100 @@ void validity_checker::validate_end()
 }
 
 
+//-------------------------------------------------
+//  already_checked - returns true if the given
+//  item has already been checked, and records
+//  it otherwise; shared between workers
+//-------------------------------------------------
+
+bool validity_checker::already_checked(const char *string)
+{
+	if (m_parent)
+		return m_parent->already_checked(string);
+
+	std::lock_guard<std::mutex> lock(m_already_checked_mutex);
+	return !m_already_checked.insert(string).second;
+}
+
+
+//-------------------------------------------------
+//  validate_drivers - validate a list of drivers,
+//  spreading the work over multiple threads and
+//  reporting results in list order
+//-------------------------------------------------
+
+void validity_checker::validate_drivers(std::vector<std::size_t> const &drivers)
+{
+	// verbose output is for finding crashes, so keep that on one thread
+	constexpr std::size_t DRIVERS_PER_THREAD = 32;
+	std::size_t const threads(std::min<std::size_t>(std::thread::hardware_concurrency(), drivers.size() / DRIVERS_PER_THREAD));
+	if (m_print_verbose || (threads <= 1))
+	{
+		for (std::size_t index : drivers)
+			validate_one(m_drivlist.driver(index));
+		return;
+	}
+
+	// register names and descriptions in order beforehand, so duplicates are reported against the same driver
+	for (std::size_t index : drivers)
+	{
+		game_driver const &driver(m_drivlist.driver(index));
+		m_names_map.emplace(driver.name, &driver);
+		m_descriptions_map.emplace(driver.type.fullname(), &driver);
+	}
+
+	// workers take drivers in order and collect each one's output separately
+	struct driver_result
+	{
+		std::string text;
+		int errors = 0;
+		int warnings = 0;
+	};
+	std::vector<driver_result> results(drivers.size());
+	std::atomic<std::size_t> next(0);
+	auto const task_proc = [this, &drivers, &results, &next] ()
+			{
+				validity_checker worker(*this);
+				t_worker = &worker;
+				try
+				{
+					for (std::size_t i = next++; i < drivers.size(); i = next++)
+					{
+						driver_result &result(results[i]);
+						int const start_errors(worker.m_errors);
+						int const start_warnings(worker.m_warnings);
+						worker.m_buffered_output = &result.text;
+						worker.validate_one(driver_list::driver(drivers[i]));
+						worker.m_buffered_output = nullptr;
+						result.errors = worker.m_errors - start_errors;
+						result.warnings = worker.m_warnings - start_warnings;
+					}
+				}
+				catch (...)
+				{
+					t_worker = nullptr;
+					throw;
+				}
+				t_worker = nullptr;
+			};
+	std::vector<std::future<void> > tasks;
+	tasks.reserve(threads);
+	for (std::size_t i = 0; i < threads; i++)
+		tasks.emplace_back(std::async(std::launch::async, task_proc));
+	for (auto &task : tasks)
+		task.get();
+
+	// now emit everything in order
+	for (driver_result const &result : results)
+	{
+		m_errors += result.errors;
+		m_warnings += result.warnings;
+		if (!result.text.empty())
+			chain_output(OSD_OUTPUT_CHANNEL_ERROR, util::make_format_argument_pack("%s", result.text));
+	}
+}
+
+
 //-------------------------------------------------
 //  validate_drivers - master validity checker
 //-------------------------------------------------
@@ -1991,19 +2128,15 @@ void validity_checker::validate_one(const game_driver &driver)
 
 void validity_checker::validate_driver(device_t &root)
 {
-	// check for duplicate names
-	if (!m_names_map.insert(std::make_pair(m_current_driver->name, m_current_driver)).second)
-	{
-		const game_driver *match = m_names_map.find(m_current_driver->name)->second;
+	// check for duplicate names (the maps may already have been populated for parallel validation)
+	const game_driver *match = m_names_map.emplace(m_current_driver->name, m_current_driver).first->second;
+	if (match != m_current_driver)
 		osd_printf_error("Driver name is a duplicate of %s(%s)\n", core_filename_extract_base(match->type.source()), match->name);
-	}
 
 	// check for duplicate descriptions
-	if (!m_descriptions_map.insert(std::make_pair(m_current_driver->type.fullname(), m_current_driver)).second)
-	{
-		const game_driver *match = m_descriptions_map.find(m_current_driver->type.fullname())->second;
+	match = m_descriptions_map.emplace(m_current_driver->type.fullname(), m_current_driver).first->second;
+	if (match != m_current_driver)
 		osd_printf_error("Driver description is a duplicate of %s(%s)\n", core_filename_extract_base(match->type.source()), match->name);
-	}
 
 	// determine if we are a clone
 	bool is_clone = (strcmp(m_current_driver->parent, "0") != 0);
@@ -2578,7 +2711,7 @@ void validity_checker::validate_devices(machine_config &config)
 					continue;
 
 				// if we need to save time, instantiate and validate each slot card type at most once
-				if (m_quick && !m_slotcard_set.insert(option.second->devtype().shortname()).second)
+				if (m_quick && already_checked(std::string("slotcard/").append(option.second->devtype().shortname()).c_str()))
 					continue;
 
 				m_checking_card = true;
@@ -2808,6 +2941,13 @@ void validity_checker::build_output_prefix(std::ostream &str) const
 
 void validity_checker::output_callback(osd_output_channel channel, const util::format_argument_pack<std::ostream> &args)
 {
+	// messages from worker threads belong to the worker's current driver
+	if (t_worker && (t_worker != this))
+	{
+		t_worker->output_callback(channel, args);
+		return;
+	}
+
 	std::ostringstream output;
 	switch (channel)
 	{
@@ -2848,7 +2988,10 @@ void validity_checker::output_callback(osd_output_channel channel, const util::f
 		break;
 
 	default:
-		chain_output(channel, args);
+		if (m_parent)
+			m_parent->chain_output(channel, args);
+		else
+			chain_output(channel, args);
 		break;
 	}
 }
@@ -2862,8 +3005,11 @@ void validity_checker::output_callback(osd_output_channel channel, const util::f
 template <typename Format, typename... Params>
 void validity_checker::output_via_delegate(osd_output_channel channel, Format &&fmt, Params &&...args)
 {
-	// call through to the delegate with the proper parameters
-	chain_output(channel, util::make_format_argument_pack(std::forward<Format>(fmt), std::forward<Params>(args)...));
+	// workers collect output so it can be emitted in driver order
+	if (m_buffered_output)
+		m_buffered_output->append(util::string_format(std::forward<Format>(fmt), std::forward<Params>(args)...));
+	else
+		chain_output(channel, util::make_format_argument_pack(std::forward<Format>(fmt), std::forward<Params>(args)...));
 }
 
 //-------------------------------------------------
@@ -16,6 +16,12 @@
 #include "drivenum.h"
 #include "emuopts.h"
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -47,7 +53,7 @@ public:
 	bool ioport_missing(const char *tag) { return !m_checking_card && (m_ioport_set.find(tag) == m_ioport_set.end()); }
 
 	// generic registry of already-checked stuff
-	bool already_checked(const char *string) { return !m_already_checked.insert(string).second; }
+	bool already_checked(const char *string);
 
 protected:
 	// osd_output interface
@@ -59,6 +65,9 @@ private:
 	using int_map = std::unordered_map<std::string, uintptr_t>;
 	using string_set = std::unordered_set<std::string>;
 
+	// worker construction
+	validity_checker(validity_checker &parent);
+
 	// internal helpers
 	int get_defstr_index(const char *string, bool suppress_error = false);
 
@@ -66,6 +75,7 @@ private:
 	void validate_begin();
 	void validate_end();
 	void validate_one(const game_driver &driver);
+	void validate_drivers(std::vector<std::size_t> const &drivers);
 
 	// internal sub-checks
 	void validate_driver(device_t &root);
@@ -109,9 +119,13 @@ private:
 	int_map                 m_region_map;
 	string_set              m_ioport_set;
 	string_set              m_already_checked;
-	string_set              m_slotcard_set;
+	std::mutex              m_already_checked_mutex;
 	bool                    m_checking_card;
 	bool const              m_quick;
+
+	// parallel validation
+	validity_checker *const m_parent;               // checker that owns the shared state, for workers
+	std::string *           m_buffered_output;      // where workers collect output for a driver
 };
 
 #endif // MAME_EMU_VALIDITY_H
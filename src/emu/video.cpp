@@ -12,6 +12,9 @@
 #include "emuopts.h"
 #include "debugger.h"
 #include "fileio.h"
+#include "frameexport.h"
+#include "framehash.h"
+#include "telemetry.h"
 #include "ui/uimain.h"
 #include "crsshair.h"
 #include "rendersw.hxx"
@@ -84,6 +87,13 @@ video_manager::video_manager(running_machine &machine)
 	, m_speed_last_realtime(0)
 	, m_speed_last_emutime(attotime::zero)
 	, m_speed_percent(1.0)
+	, m_present_last_ticks(0)
+	, m_present_last_emutime(attotime::zero)
+	, m_present_frames(0)
+	, m_present_missed(0)
+	, m_present_total_ticks(0)
+	, m_present_max_ticks(0)
+	, m_present_error_ticks(0)
 	, m_overall_real_seconds(0)
 	, m_overall_real_ticks(0)
 	, m_overall_emutime(attotime::zero)
@@ -102,6 +112,11 @@ video_manager::video_manager(running_machine &machine)
 	, m_frameskip_adjust(0)
 	, m_skipping_this_frame(false)
 	, m_average_oversleep(0)
+	, m_runahead_phase(runahead_phase::NONE)
+	, m_runahead_skip(false)
+	, m_frame_completed(false)
+	, m_batch(machine.options().batch())
+	, m_frames_remaining(std::max(machine.options().batch_frames(), 0))
 	, m_snap_target(nullptr)
 	, m_snap_native(true)
 	, m_snap_width(0)
@@ -177,6 +192,15 @@ video_manager::video_manager(running_machine &machine)
 }
 
 
+//-------------------------------------------------
+//  ~video_manager - destructor
+//-------------------------------------------------
+
+video_manager::~video_manager()
+{
+}
+
+
 //-------------------------------------------------
 //  set_frameskip - set the current actual
 //  frameskip (-1 means autoframeskip)
@@ -200,6 +224,22 @@ void video_manager::set_frameskip(int frameskip)
 }
 
 
+//-------------------------------------------------
+//  set_runahead - tell the video manager what
+//  the next frame is used for
+//-------------------------------------------------
+
+void video_manager::set_runahead(runahead_phase phase)
+{
+	// the frameskip decision made at the end of a real frame applies to the frame that gets shown
+	if (m_runahead_phase == runahead_phase::HIDDEN)
+		m_runahead_skip = m_skipping_this_frame;
+
+	m_runahead_phase = phase;
+	m_skipping_this_frame = (phase == runahead_phase::HIDDEN) || (phase == runahead_phase::AHEAD) || m_runahead_skip;
+}
+
+
 //-------------------------------------------------
 //  frame_update - handle frameskipping and UI,
 //  plus updating the screen during normal
@@ -208,10 +248,33 @@ void video_manager::set_frameskip(int frameskip)
 
 void video_manager::frame_update(bool from_debugger)
 {
+	// speculative run-ahead frames are thrown away again
+	if (!from_debugger && ((m_runahead_phase == runahead_phase::AHEAD) || (m_runahead_phase == runahead_phase::LAST)))
+	{
+		runahead_frame_update();
+		return;
+	}
+
+	// pass output changes collected since the last frame on to layouts, plugins and the OSD
+	machine().output().update();
+
+	// batch frames only do what the emulation and automation can observe
+	if (!from_debugger && m_batch)
+	{
+		batch_frame_update();
+		return;
+	}
+
+	// a hidden run-ahead frame is paced and reads input, but the last speculative frame is drawn in its place
+	bool const hidden = (m_runahead_phase == runahead_phase::HIDDEN);
+
 	// only render sound and video if we're in the running phase
 	machine_phase const phase = machine().phase();
 	bool skipped_it = m_skipping_this_frame;
-	bool const update_screens = (phase == machine_phase::RUNNING) && (!machine().paused() || machine().options().update_in_pause());
+	bool const update_screens = (phase == machine_phase::RUNNING) && (!machine().paused() || machine().options().update_in_pause()) && !hidden;
+
+	// screen textures and containers are about to change under the render thread
+	machine().render().wait_primitives();
 	bool anything_changed = update_screens && finish_screen_updates();
 
 	// draw the user interface
@@ -223,23 +286,35 @@ void video_manager::frame_update(bool from_debugger)
 	// if none of the screens changed and we haven't skipped too many frames in a row,
 	// mark this frame as skipped to prevent throttling; this helps for games that
 	// don't update their screen at the monitor refresh rate
-	if (!anything_changed && !m_auto_frameskip && (m_frameskip_level == 0) && (m_empty_skip_count++ < 3))
+	if (!hidden && !anything_changed && !m_auto_frameskip && (m_frameskip_level == 0) && (m_empty_skip_count++ < 3))
 		skipped_it = true;
 	else
 		m_empty_skip_count = 0;
+	bool const paced = hidden ? !m_runahead_skip : !skipped_it;
 
 	// if we're throttling, synchronize before rendering
 	attotime current_time = machine().time();
-	if (!from_debugger && !skipped_it && phase > machine_phase::INIT && !m_low_latency && effective_throttle())
+	if (!from_debugger && paced && phase > machine_phase::INIT && !m_low_latency && effective_throttle())
 		update_throttle(current_time);
 
 	// ask the OSD to update
 	g_profiler.start(PROFILER_BLIT);
+	osd_ticks_t const present_start = osd_ticks();
 	machine().osd().update(!from_debugger && skipped_it);
 	g_profiler.stop();
+	if (m_telemetry)
+		m_telemetry->add_render(osd_ticks() - present_start);
+
+	// measure when the frame actually went out
+	if (!from_debugger && !skipped_it && (phase == machine_phase::RUNNING))
+		update_present_stats(present_start, current_time);
+
+	// the first frame actually presented marks the end of startup
+	if (!skipped_it && (phase == machine_phase::RUNNING))
+		machine().manager().startup_profile().finish(machine().system().name);
 
 	// we synchronize after rendering instead of before, if low latency mode is enabled
-	if (!from_debugger && !skipped_it && phase > machine_phase::INIT && m_low_latency && effective_throttle())
+	if (!from_debugger && paced && phase > machine_phase::INIT && m_low_latency && effective_throttle())
 		update_throttle(current_time);
 
 	// get most recent input now
@@ -249,7 +324,16 @@ void video_manager::frame_update(bool from_debugger)
 
 	if (!from_debugger)
 	{
+		// hand the finished frame to export consumers before anything else sees it
+		if (m_export && update_screens)
+			m_export->publish();
+
 		// perform tasks for this frame
+		g_profiler.frame();
+		if (m_telemetry && (phase == machine_phase::RUNNING))
+			m_telemetry->frame(current_time);
+		if (m_framehash && (phase == machine_phase::RUNNING) && !machine().paused())
+			m_framehash->frame();
 		machine().call_notifiers(MACHINE_NOTIFY_FRAME);
 
 		// update frameskipping
@@ -257,8 +341,14 @@ void video_manager::frame_update(bool from_debugger)
 			update_frameskip();
 
 		// update speed computations
-		if (!skipped_it && phase > machine_phase::INIT)
+		if (paced && phase > machine_phase::INIT)
 			recompute_speed(current_time);
+
+		m_frame_completed = true;
+
+		// count down towards the end of a run_frames request
+		if ((phase == machine_phase::RUNNING) && !machine().paused())
+			count_frame();
 	}
 
 	// call the end-of-frame callback
@@ -270,7 +360,123 @@ void video_manager::frame_update(bool from_debugger)
 		bool const within_instruction_hook = debugger_enabled && machine().debugger().within_instruction_hook();
 		if (screen && ((machine().paused() && machine().options().update_in_pause()) || from_debugger || within_instruction_hook))
 			screen->reset_partial_updates();
+
+		// build the primitives for the next frame while emulation continues
+		if (!from_debugger && !m_skipping_this_frame && (m_runahead_phase == runahead_phase::NONE))
+			machine().render().prepare_primitives();
+	}
+}
+
+
+//-------------------------------------------------
+//  batch_frame_update - finish a frame in batch
+//  mode, skipping the user interface, render
+//  primitives, throttling and input
+//-------------------------------------------------
+
+void video_manager::batch_frame_update()
+{
+	machine_phase const phase = machine().phase();
+	bool const running = (phase == machine_phase::RUNNING) && !machine().paused();
+
+	// screens still have to finish drawing for snapshots, recordings and exports
+	if (running)
+		finish_screen_updates();
+
+	// the OSD resets its watchdog here; with skip_redraw set no window builds primitives
+	g_profiler.start(PROFILER_BLIT);
+	osd_ticks_t const present_start = osd_ticks();
+	machine().osd().update(true);
+	g_profiler.stop();
+	if (m_telemetry)
+		m_telemetry->add_render(osd_ticks() - present_start);
+
+	// only idle while paused, otherwise run flat out
+	attotime const current_time = machine().time();
+	if (machine().paused() && (phase > machine_phase::INIT))
+		update_throttle(current_time);
+
+	emulator_info::periodic_check();
+
+	if (running)
+	{
+		if (m_export)
+			m_export->publish();
+
+		g_profiler.frame();
+		if (m_telemetry)
+			m_telemetry->frame(current_time);
+		if (m_framehash)
+			m_framehash->frame();
+		machine().call_notifiers(MACHINE_NOTIFY_FRAME);
+		recompute_speed(current_time);
+	}
+	m_frame_completed = true;
+
+	if (running)
+		count_frame();
+}
+
+
+//-------------------------------------------------
+//  run_frames - arm a frame budget
+//-------------------------------------------------
+
+void video_manager::run_frames(u64 frames, std::function<void ()> &&done)
+{
+	m_frames_remaining = frames;
+	m_frames_done = std::move(done);
+	if (!frames)
+		m_frames_done = nullptr;
+}
+
+
+//-------------------------------------------------
+//  count_frame - count a finished frame against
+//  the budget set by run_frames
+//-------------------------------------------------
+
+void video_manager::count_frame()
+{
+	if (!m_frames_remaining || --m_frames_remaining)
+		return;
+
+	// the callback may ask for more frames, otherwise we're done
+	std::function<void ()> done(std::move(m_frames_done));
+	m_frames_done = nullptr;
+	if (done)
+		done();
+	if (!m_frames_remaining)
+		machine().schedule_exit();
+}
+
+
+//-------------------------------------------------
+//  runahead_frame_update - finish a speculative
+//  run-ahead frame, presenting it if it is the
+//  last one
+//-------------------------------------------------
+
+void video_manager::runahead_frame_update()
+{
+	// the UI, input and frame notifiers were already handled by the real frame
+	if ((m_runahead_phase == runahead_phase::LAST) && !m_skipping_this_frame && (machine().phase() == machine_phase::RUNNING))
+	{
+		machine().render().wait_primitives();
+		finish_screen_updates();
+
+		g_profiler.start(PROFILER_BLIT);
+		osd_ticks_t const present_start = osd_ticks();
+		machine().osd().update(false);
+		g_profiler.stop();
+		if (m_telemetry)
+			m_telemetry->add_render(osd_ticks() - present_start);
+
+		update_present_stats(present_start, machine().time());
+		machine().manager().startup_profile().finish(machine().system().name);
 	}
+
+	m_frame_completed = true;
 }
 
 
@@ -494,6 +700,11 @@ void video_manager::exit()
 	// stop recording any movie
 	m_movie_recordings.clear();
 
+	// release the export; consumers still attached keep their view
+	m_export.reset();
+	m_telemetry.reset();
+	m_framehash.reset();
+
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
@@ -505,6 +716,18 @@ void video_manager::exit()
 		double final_real_time = (double)m_overall_real_seconds + (double)m_overall_real_ticks / (double)tps;
 		double final_emu_time = m_overall_emutime.as_double();
 		osd_printf_info("Average speed: %.2f%% (%d seconds)\n", 100 * final_emu_time / final_real_time, (m_overall_emutime + attotime(0, ATTOSECONDS_PER_SECOND / 2)).seconds());
+		if (m_present_frames)
+		{
+			double const ms_per_tick = 1000.0 / double(tps);
+			osd_printf_info(
+					"Frame pacing: %u frames, %u late (%.2f%%), present %.3f ms average (%.3f ms max), deviation %.3f ms average\n",
+					m_present_frames,
+					m_present_missed,
+					100.0 * m_present_missed / m_present_frames,
+					ms_per_tick * m_present_total_ticks / m_present_frames,
+					ms_per_tick * m_present_max_ticks,
+					ms_per_tick * m_present_error_ticks / m_present_frames);
+		}
 	}
 }
 
@@ -528,6 +751,10 @@ void video_manager::screenless_update_callback(int param)
 
 void video_manager::postload()
 {
+	// run-ahead restores the state every frame, and the measurements follow the real frames
+	if ((m_runahead_phase == runahead_phase::AHEAD) || (m_runahead_phase == runahead_phase::LAST))
+		return;
+
 	attotime const emutime = machine().time();
 	for (const auto &x : m_movie_recordings)
 		x->set_next_frame_time(emutime);
@@ -804,7 +1031,8 @@ osd_ticks_t video_manager::throttle_until_ticks(osd_ticks_t target_ticks)
 
 	// loop until we reach our target
 	g_profiler.start(PROFILER_IDLE);
-	osd_ticks_t current_ticks = osd_ticks();
+	osd_ticks_t const start_ticks = osd_ticks();
+	osd_ticks_t current_ticks = start_ticks;
 	while (current_ticks < target_ticks)
 	{
 		// compute how much time to sleep for, taking into account the average oversleep
@@ -841,10 +1069,55 @@ osd_ticks_t video_manager::throttle_until_ticks(osd_ticks_t target_ticks)
 	}
 	g_profiler.stop();
 
+	if (m_telemetry)
+		m_telemetry->add_throttle(current_ticks - start_ticks, (current_ticks > target_ticks) ? (current_ticks - target_ticks) : 0);
+
 	return current_ticks;
 }
 
 
+//-------------------------------------------------
+//  update_present_stats - compare the real time
+//  between presented frames against the emulated
+//  frame time to track pacing and missed frames
+//-------------------------------------------------
+
+void video_manager::update_present_stats(osd_ticks_t present_start, const attotime &emutime)
+{
+	osd_ticks_t const present_end = osd_ticks();
+	osd_ticks_t const real_ticks = present_end - m_present_last_ticks;
+	attoseconds_t emu_delta_attoseconds = (emutime - m_present_last_emutime).as_attoseconds();
+	bool const valid = m_present_last_ticks && !machine().paused() && effective_throttle();
+
+	m_present_last_ticks = present_end;
+	m_present_last_emutime = emutime;
+
+	// skip anything the throttle would treat as a resync
+	if (!valid || emu_delta_attoseconds <= 0 || emu_delta_attoseconds > ATTOSECONDS_PER_SECOND / 10)
+		return;
+
+	// convert the emulated interval to the real time it should have taken
+	if (m_speed != 0 && m_speed != 1000)
+		emu_delta_attoseconds = emu_delta_attoseconds / m_speed * 1000;
+	attoseconds_t const attoseconds_per_tick = ATTOSECONDS_PER_SECOND / osd_ticks_per_second() * m_throttle_rate;
+	osd_ticks_t const expected_ticks = emu_delta_attoseconds / attoseconds_per_tick;
+
+	osd_ticks_t const present_ticks = present_end - present_start;
+	m_present_frames++;
+	m_present_total_ticks += present_ticks;
+	m_present_max_ticks = std::max(m_present_max_ticks, present_ticks);
+	m_present_error_ticks += (real_ticks > expected_ticks) ? (real_ticks - expected_ticks) : (expected_ticks - real_ticks);
+
+	// a frame that went out more than half a frame late was visibly missed
+	if ((real_ticks * 2) > (expected_ticks * 3))
+	{
+		m_present_missed++;
+		if (LOG_THROTTLE)
+			machine().logerror("Late frame: %d ticks, expected %d ticks\n", (int)real_ticks, (int)expected_ticks);
+	}
+}
+
+
 //-------------------------------------------------
 //  update_frameskip - update frameskipping
 //  counters and periodically update autoframeskip
@@ -1275,3 +1548,67 @@ void video_manager::end_recording()
 {
 	m_movie_recordings.clear();
 }
+
+
+//-------------------------------------------------
+//  begin_export - start publishing frames to the
+//  named shared memory object
+//-------------------------------------------------
+
+bool video_manager::begin_export(const char *name)
+{
+	emu_options &options(machine().options());
+	m_export = frame_export::create(machine(), name, options.export_memory(), options.export_slots(), options.export_lockstep());
+	return bool(m_export);
+}
+
+
+//-------------------------------------------------
+//  begin_telemetry - start reporting per-frame
+//  performance figures
+//-------------------------------------------------
+
+bool video_manager::begin_telemetry(const char *filename, bool outputs)
+{
+	m_telemetry = frame_telemetry::create(machine(), filename, outputs);
+	return bool(m_telemetry);
+}
+
+
+//-------------------------------------------------
+//  begin_framehash - start writing and/or
+//  checking per-frame output hashes
+//-------------------------------------------------
+
+bool video_manager::begin_framehash(const char *record, const char *check)
+{
+	m_framehash = frame_hasher::create(machine(), record, check);
+	return bool(m_framehash);
+}
+
+
+//-------------------------------------------------
+//  end_framehash - stop hashing and return a
+//  description of any mismatch
+//-------------------------------------------------
+
+std::string video_manager::end_framehash()
+{
+	if (!m_framehash)
+		return std::string();
+	std::string result(m_framehash->finish());
+	m_framehash.reset();
+	return result;
+}
+
+
+//-------------------------------------------------
+//  add_sound_to_framehash - add mixed sound to
+//  the current frame's hash
+//-------------------------------------------------
+
+void video_manager::add_sound_to_framehash(const s16 *sound, int numsamples)
+{
+	if (m_framehash)
+		m_framehash->add_sound(sound, numsamples);
+}
@@ -19,7 +19,15 @@
 
 #include "recording.h"
 
+#include <functional>
+#include <memory>
 #include <system_error>
+#include <utility>
+
+
+class frame_export;
+class frame_hasher;
+class frame_telemetry;
 
 
 //**************************************************************************
@@ -42,8 +50,18 @@ class video_manager
 	friend class screen_device;
 
 public:
+	// run-ahead frame types
+	enum class runahead_phase : u8
+	{
+		NONE,       // ordinary frame
+		HIDDEN,     // real frame, paced and fed input but not drawn
+		AHEAD,      // speculative frame, thrown away again
+		LAST        // last speculative frame, drawn and presented
+	};
+
 	// construction/destruction
 	video_manager(running_machine &machine);
+	~video_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
@@ -53,6 +71,10 @@ public:
 	bool throttled() const { return m_throttled; }
 	float throttle_rate() const { return m_throttle_rate; }
 	bool fastforward() const { return m_fastforward; }
+	runahead_phase runahead() const { return m_runahead_phase; }
+	bool frame_completed() { return std::exchange(m_frame_completed, false); }
+	bool batch() const { return m_batch; }
+	u64 frames_remaining() const { return m_frames_remaining; }
 
 	// setters
 	void set_frameskip(int frameskip);
@@ -60,6 +82,7 @@ public:
 	void set_throttle_rate(float throttle_rate) { m_throttle_rate = throttle_rate; }
 	void set_fastforward(bool ffwd) { m_fastforward = ffwd; }
 	void set_output_changed() { m_output_changed = true; }
+	void set_runahead(runahead_phase phase);
 
 	// misc
 	void toggle_record_movie(movie_recording::format format);
@@ -70,6 +93,9 @@ public:
 	// render a frame
 	void frame_update(bool from_debugger = false);
 
+	// run the given number of frames, then call done or exit if it doesn't ask for more (0 for no limit)
+	void run_frames(u64 frames, std::function<void ()> &&done = nullptr);
+
 	// current speed helpers
 	std::string speed_text();
 	double speed_percent() const { return m_speed_percent; }
@@ -87,6 +113,19 @@ public:
 	void add_sound_to_recording(const s16 *sound, int numsamples);
 	bool is_recording() const { return !m_movie_recordings.empty(); }
 
+	// shared memory export
+	bool begin_export(const char *name);
+	bool is_exporting() const { return bool(m_export); }
+
+	// per-frame telemetry
+	bool begin_telemetry(const char *filename, bool outputs);
+
+	// per-frame output hashing
+	bool begin_framehash(const char *record, const char *check);
+	std::string end_framehash();
+	bool is_hashing() const { return bool(m_framehash); }
+	void add_sound_to_framehash(const s16 *sound, int numsamples);
+
 private:
 	// internal helpers
 	void exit();
@@ -105,6 +144,10 @@ private:
 	void update_frameskip();
 	void update_refresh_speed();
 	void recompute_speed(const attotime &emutime);
+	void runahead_frame_update();
+	void batch_frame_update();
+	void count_frame();
+	void update_present_stats(osd_ticks_t present_start, const attotime &emutime);
 
 	// snapshot/movie helpers
 	void create_snapshot_bitmap(screen_device *screen);
@@ -131,6 +174,15 @@ private:
 	attotime            m_speed_last_emutime;       // emulated time at the last speed calculation
 	double              m_speed_percent;            // most recent speed percentage
 
+	// presentation timing
+	osd_ticks_t         m_present_last_ticks;       // osd_ticks when the last presented frame completed
+	attotime            m_present_last_emutime;     // emulated time of the last presented frame
+	u32                 m_present_frames;           // number of frame intervals measured
+	u32                 m_present_missed;           // number of intervals well over the emulated frame time
+	osd_ticks_t         m_present_total_ticks;      // accumulated time spent in the OSD update
+	osd_ticks_t         m_present_max_ticks;        // longest time spent in the OSD update
+	osd_ticks_t         m_present_error_ticks;      // accumulated deviation from the emulated frame time
+
 	// overall speed computation
 	u32                 m_overall_real_seconds;     // accumulated real seconds at normal speed
 	osd_ticks_t         m_overall_real_ticks;       // accumulated real ticks at normal speed
@@ -155,6 +207,16 @@ private:
 	bool                m_skipping_this_frame;      // flag: true if we are skipping the current frame
 	osd_ticks_t         m_average_oversleep;        // average number of ticks the OSD oversleeps
 
+	// run-ahead
+	runahead_phase      m_runahead_phase;           // what the current frame is used for
+	bool                m_runahead_skip;            // frameskip decision for the frame that will be shown
+	bool                m_frame_completed;          // flag: true once frame_update has run for a frame
+
+	// batch mode
+	bool const          m_batch;                    // flag: true if frames are never drawn
+	u64                 m_frames_remaining;         // frames left before done is called, 0 == no limit
+	std::function<void ()> m_frames_done;           // called when the frame budget runs out
+
 	// snapshot stuff
 	render_target *     m_snap_target;              // screen shapshot target
 	bitmap_rgb32        m_snap_bitmap;              // screen snapshot bitmap
@@ -165,6 +227,15 @@ private:
 	// movie recordings
 	std::vector<movie_recording::ptr> m_movie_recordings;
 
+	// shared memory export
+	std::unique_ptr<frame_export> m_export;
+
+	// per-frame telemetry
+	std::unique_ptr<frame_telemetry> m_telemetry;
+
+	// per-frame output hashing
+	std::unique_ptr<frame_hasher> m_framehash;
+
 	static const bool   s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS];
 
 	static const attoseconds_t ATTOSECONDS_PER_SPEED_UPDATE = ATTOSECONDS_PER_SECOND / 4;
@@ -20,9 +20,12 @@
 #include "softlist_dev.h"
 
 #include "chd.h"
+#include "corestr.h"
 #include "path.h"
 
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
 
 //#define VERBOSE 1
 #define LOG_OUTPUT_FUNC osd_printf_verbose
@@ -167,9 +170,10 @@ public:
 //  media_auditor - constructor
 //-------------------------------------------------
 
-media_auditor::media_auditor(const driver_enumerator &enumerator)
+media_auditor::media_auditor(const driver_enumerator &enumerator, media_audit_cache *cache)
 	: m_enumerator(enumerator)
 	, m_validation(AUDIT_VALIDATE_FULL)
+	, m_cache(cache)
 {
 }
 
@@ -601,7 +605,7 @@ media_auditor::audit_record &media_auditor::audit_one_rom(const std::vector<std:
 
 	// if it worked, get the actual length and hashes, then stop
 	if (!filerr)
-		record.set_actual(file.hashes(m_validation), file.size());
+		record.set_actual(m_cache ? m_cache->hashes(file, m_validation) : file.hashes(m_validation), file.size());
 
 	// compute the final status
 	compute_status(record, rom, record.actual_length() != 0);
@@ -704,3 +708,199 @@ media_auditor::audit_record::audit_record(const char *name, media_type type)
 	, m_shared_device(nullptr)
 {
 }
+
+
+
+//**************************************************************************
+//  AUDIT CACHE
+//**************************************************************************
+
+namespace {
+
+// name of the cache file within the audit cache directory
+constexpr char AUDIT_CACHE_FILENAME[] = "audit.cache";
+constexpr char AUDIT_CACHE_HEADER[] = "MAMEAUDIT 1";
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  media_audit_cache - constructor
+//-------------------------------------------------
+
+media_audit_cache::media_audit_cache(emu_options const &options)
+	: m_path(options.auditcache_directory())
+	, m_dirty(false)
+{
+	if (enabled())
+		load();
+}
+
+
+//-------------------------------------------------
+//  ~media_audit_cache - destructor
+//-------------------------------------------------
+
+media_audit_cache::~media_audit_cache()
+{
+	save();
+}
+
+
+//-------------------------------------------------
+//  hashes - get hashes for an open file, only
+//  computing them if they aren't in the cache
+//-------------------------------------------------
+
+util::hash_collection media_audit_cache::hashes(emu_file &file, const char *types)
+{
+	if (!enabled())
+		return file.hashes(types);
+
+	// archive members are keyed on the archive, loose files on their own path
+	std::string const container(*file.archive_path() ? file.archive_path() : file.fullpath());
+	std::string const &member(file.archive_member());
+	uint64_t const length(file.size());
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		container_info &info(find_container(container));
+		auto const found(info.members.find(member));
+		if ((info.members.end() != found) && (found->second.length == length))
+		{
+			std::string const have(found->second.hashes.hash_types());
+			if (std::all_of(types, types + std::strlen(types), [&have] (char type) { return have.find(type) != std::string::npos; }))
+				return found->second.hashes;
+		}
+	}
+
+	// hash outside the lock so other auditing threads aren't held up
+	util::hash_collection const result(file.hashes(types));
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		container_info &info(find_container(container));
+		if (info.size || info.modified)
+		{
+			member_info &entry(info.members[member]);
+			entry.length = length;
+			entry.hashes = result;
+			m_dirty = true;
+		}
+	}
+	return result;
+}
+
+
+//-------------------------------------------------
+//  save - write the cache out atomically if it
+//  has been changed
+//-------------------------------------------------
+
+void media_audit_cache::save()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!enabled() || !m_dirty)
+		return;
+
+	auto const write = [this] (emu_file &file)
+	{
+		file.printf("%s\n", AUDIT_CACHE_HEADER);
+		for (auto const &container : m_containers)
+		{
+			if (container.second.members.empty())
+				continue;
+			file.printf("C\t%d\t%u\t%s\n", container.second.modified, container.second.size, container.first);
+			for (auto const &member : container.second.members)
+				file.printf("M\t%u\t%s\t%s\n", member.second.length, member.second.hashes.internal_string(), member.first);
+		}
+		return true;
+	};
+	if (emu_file::write_replacing(m_path, AUDIT_CACHE_FILENAME, write))
+		osd_printf_verbose("Unable to write audit cache to %s\n", m_path);
+	else
+		m_dirty = false;
+}
+
+
+//-------------------------------------------------
+//  load - read the cache file; anything that
+//  doesn't parse is ignored and will be rehashed
+//-------------------------------------------------
+
+void media_audit_cache::load()
+{
+	emu_file file(m_path, OPEN_FLAG_READ);
+	if (file.open(AUDIT_CACHE_FILENAME))
+		return;
+
+	char buffer[4096 + 256];
+	if (!file.gets(buffer, std::size(buffer)) || strtrimrightspace(buffer) != AUDIT_CACHE_HEADER)
+		return;
+
+	container_info *current(nullptr);
+	while (file.gets(buffer, std::size(buffer)))
+	{
+		// split the line into tab-separated fields, the last of which is the name
+		std::string_view line(buffer);
+		if (!line.empty() && (line.back() == '\n'))
+			line.remove_suffix(1);
+		if (!line.empty() && (line.back() == '\r'))
+			line.remove_suffix(1);
+		std::string_view fields[4];
+		unsigned count(0);
+		while ((count < 3) && !line.empty())
+		{
+			auto const tab(line.find('\t'));
+			if (std::string_view::npos == tab)
+				break;
+			fields[count++] = line.substr(0, tab);
+			line.remove_prefix(tab + 1);
+		}
+		if (3 != count)
+		{
+			current = nullptr;
+			continue;
+		}
+		fields[3] = line;
+
+		if (fields[0] == "C")
+		{
+			current = &m_containers[std::string(fields[3])];
+			current->modified = std::strtoll(std::string(fields[1]).c_str(), nullptr, 10);
+			current->size = std::strtoull(std::string(fields[2]).c_str(), nullptr, 10);
+		}
+		else if ((fields[0] == "M") && current)
+		{
+			member_info &entry(current->members[std::string(fields[3])]);
+			entry.length = std::strtoull(std::string(fields[1]).c_str(), nullptr, 10);
+			if (!entry.hashes.from_internal_string(fields[2]))
+				current->members.erase(std::string(fields[3]));
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  find_container - look up a container, and
+//  throw away its members the first time it's
+//  seen if it changed since they were recorded
+//-------------------------------------------------
+
+media_audit_cache::container_info &media_audit_cache::find_container(std::string const &path)
+{
+	container_info &info(m_containers[path]);
+	if (!info.checked)
+	{
+		info.checked = true;
+		auto const entry(osd_stat(path));
+		int64_t const modified(entry ? int64_t(entry->last_modified.time_since_epoch().count()) : 0);
+		uint64_t const size(entry ? entry->size : 0);
+		if ((modified != info.modified) || (size != info.size))
+		{
+			m_dirty = m_dirty || !info.members.empty();
+			info.members.clear();
+			info.modified = modified;
+			info.size = size;
+		}
+	}
+	return info;
+}
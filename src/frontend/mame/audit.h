@@ -12,8 +12,12 @@
 
 #pragma once
 
+#include <chrono>
 #include <iosfwd>
 #include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <utility>
 
 
@@ -39,6 +43,54 @@ class software_list_device;
 
 
 
+// ======================> media_audit_cache
+
+// persistent record of hashes computed for media files, so unchanged
+// files don't need to be hashed again on the next audit
+class media_audit_cache
+{
+public:
+	// construction/destruction
+	media_audit_cache(emu_options const &options);
+	~media_audit_cache();
+
+	// getters
+	bool enabled() const { return !m_path.empty(); }
+
+	// hash an open file, using cached results if the file is unchanged
+	util::hash_collection hashes(emu_file &file, const char *types);
+
+	// write out the cache if anything was added
+	void save();
+
+private:
+	struct member_info
+	{
+		uint64_t                    length;
+		util::hash_collection       hashes;
+	};
+
+	struct container_info
+	{
+		int64_t                     modified = 0;
+		uint64_t                    size = 0;
+		bool                        checked = false;
+		std::unordered_map<std::string, member_info> members;
+	};
+
+	// internal helpers
+	void load();
+	container_info &find_container(std::string const &path);
+
+	// internal state
+	std::string                 m_path;
+	std::unordered_map<std::string, container_info> m_containers;
+	std::mutex                  m_mutex;
+	bool                        m_dirty;
+};
+
+
+
 // ======================> media_auditor
 
 // class which manages auditing of items
@@ -148,7 +200,7 @@ public:
 	using record_list = std::list<audit_record>;
 
 	// construction/destruction
-	media_auditor(const driver_enumerator &enumerator);
+	media_auditor(const driver_enumerator &enumerator, media_audit_cache *cache = nullptr);
 
 	// getters
 	const record_list &records() const { return m_record_list; }
@@ -171,6 +223,7 @@ private:
 	record_list                 m_record_list;
 	const driver_enumerator &   m_enumerator;
 	const char *                m_validation;
+	media_audit_cache *         m_cache;
 };
 
 
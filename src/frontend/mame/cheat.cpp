@@ -323,6 +323,7 @@ cheat_script::cheat_script(
 		std::string const &filename,
 		util::xml::data_node const &scriptnode)
 	: m_state(SCRIPT_STATE_RUN)
+	, m_bound(false)
 {
 	// read the core attributes
 	char const *const state(scriptnode.get_attribute_string("state", "run"));
@@ -358,6 +359,14 @@ void cheat_script::execute(cheat_manager &manager, uint64_t &argindex)
 	if (!manager.enabled())
 		return;
 
+	// look up fixed memory addresses the first time the script runs
+	if (!m_bound)
+	{
+		for (auto &entry : m_entrylist)
+			entry->bind();
+		m_bound = true;
+	}
+
 	// iterate over entries
 	for (auto &entry : m_entrylist)
 		entry->execute(manager, argindex);
@@ -410,7 +419,11 @@ cheat_script::script_entry::script_entry(
 		// read the condition if present
 		expression = entrynode.get_attribute_string("condition", nullptr);
 		if (expression)
+		{
 			m_condition.parse(expression);
+			if (m_condition.is_constant())
+				m_fixed_condition = m_condition.execute() != 0;
+		}
 
 		if (isaction)
 		{
@@ -470,14 +483,33 @@ cheat_script::script_entry::script_entry(
 }
 
 
+//-------------------------------------------------
+//  bind - bind fixed memory accesses in all the
+//  expressions of a script entry
+//-------------------------------------------------
+
+void cheat_script::script_entry::bind()
+{
+	m_condition.bind();
+	m_expression.bind();
+	for (auto &arg : m_arglist)
+		arg->bind();
+}
+
+
 //-------------------------------------------------
 //  execute - execute a single script entry
 //-------------------------------------------------
 
 void cheat_script::script_entry::execute(cheat_manager &manager, uint64_t &argindex)
 {
-	// evaluate the condition
-	if (!m_condition.is_empty())
+	// evaluate the condition, unless it folded to a constant when parsed
+	if (m_fixed_condition)
+	{
+		if (!*m_fixed_condition)
+			return;
+	}
+	else if (!m_condition.is_empty())
 	{
 		try
 		{
@@ -17,6 +17,8 @@
 #include "ui/text.h"
 #include "xmlfile.h"
 
+#include <optional>
+
 
 //**************************************************************************
 //  CONSTANTS
@@ -176,6 +178,7 @@ private:
 				bool isaction);
 
 		// actions
+		void bind();
 		void execute(cheat_manager &manager, uint64_t &argindex);
 		void save(util::core_file &cheatfile) const;
 
@@ -196,6 +199,7 @@ private:
 			int values(uint64_t &argindex, uint64_t *result);
 
 			// actions
+			void bind() { m_expression.bind(); }
 			void save(util::core_file &cheatfile) const;
 
 		private:
@@ -209,6 +213,7 @@ private:
 
 		// internal state
 		parsed_expression                               m_condition;    // condition under which this is executed
+		std::optional<bool>                             m_fixed_condition; // result of a condition that folded to a constant
 		parsed_expression                               m_expression;   // expression to execute
 		std::string                                     m_format;       // string format to print
 		std::vector<std::unique_ptr<output_argument>>   m_arglist;      // list of arguments
@@ -222,6 +227,7 @@ private:
 	// internal state
 	std::vector<std::unique_ptr<script_entry>>  m_entrylist;    // list of actions to perform
 	script_state                                m_state;        // which state this script is for
+	bool                                        m_bound;        // memory accesses have been bound
 };
 
 
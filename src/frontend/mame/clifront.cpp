@@ -238,6 +238,7 @@ void cli_frontend::start_execution(mame_machine_manager *manager, const std::vec
 		throw emu_fatalerror(EMU_ERR_INVALID_CONFIG, "%s", ex.message());
 	}
 	m_osd.set_verbose(m_options.verbose());
+	manager->startup_profile().set_filename(m_options.startup_profile());
 
 	// determine the base name of the EXE
 	std::string_view exename = core_filename_extract_base(args[0], true);
@@ -259,6 +260,7 @@ void cli_frontend::start_execution(mame_machine_manager *manager, const std::vec
 	// otherwise, check for a valid system
 	load_translation(m_options);
 
+	manager->startup_profile().phase("plugins");
 	manager->start_http_server();
 
 	manager->start_luaengine();
@@ -267,6 +269,7 @@ void cli_frontend::start_execution(mame_machine_manager *manager, const std::vec
 		osd_printf_error("Error in command line:\n%s\n", strtrimspace(option_errors.str()));
 
 	// if we can't find it, give an appropriate error
+	manager->startup_profile().phase("driver list");
 	const game_driver *system = mame_options::system(m_options);
 	if (system == nullptr && *(m_options.system_name()) != 0)
 		throw emu_fatalerror(EMU_ERR_NO_SUCH_SYSTEM, "Unknown system '%s'", m_options.system_name());
@@ -504,11 +507,9 @@ void cli_frontend::listbrothers(const std::vector<std::string> &args)
 		if (drivlist.included(initial_drivlist.current()))
 			continue;
 
-		// otherwise, walk excluded items in the final list and mark any that match
-		drivlist.reset();
-		while (drivlist.next_excluded())
-			if (strcmp(drivlist.driver().type.source(), initial_drivlist.driver().type.source()) == 0)
-				drivlist.include();
+		// otherwise, mark everything from the same source file
+		auto const brothers(driver_list::same_source(initial_drivlist.current()));
+		std::for_each(brothers.first, brothers.second, [&drivlist] (int index) { drivlist.include(index); });
 	}
 
 	// print the header
@@ -943,7 +944,8 @@ void cli_frontend::verifyroms(const std::vector<std::string> &args)
 
 	// iterate over drivers
 	driver_enumerator drivlist(m_options);
-	media_auditor auditor(drivlist);
+	media_audit_cache cache(m_options);
+	media_auditor auditor(drivlist, &cache);
 	util::ovectorstream summary_string;
 	while (drivlist.next())
 	{
@@ -1325,7 +1327,8 @@ void cli_frontend::verifysoftware(const std::vector<std::string> &args)
 	if (drivlist.count() == 0)
 		throw emu_fatalerror(EMU_ERR_NO_SUCH_SYSTEM, "No matching systems found for '%s'", gamename);
 
-	media_auditor auditor(drivlist);
+	media_audit_cache cache(m_options);
+	media_auditor auditor(drivlist, &cache);
 	util::ovectorstream summary_string;
 	while (drivlist.next())
 	{
@@ -1433,7 +1436,8 @@ void cli_frontend::verifysoftlist(const std::vector<std::string> &args)
 	unsigned matched = 0;
 
 	driver_enumerator drivlist(m_options);
-	media_auditor auditor(drivlist);
+	media_audit_cache cache(m_options);
+	media_auditor auditor(drivlist, &cache);
 	util::ovectorstream summary_string;
 
 	while (drivlist.next())
@@ -32,6 +32,8 @@
 #include <future>
 #include <locale>
 #include <queue>
+#include <sstream>
+#include <thread>
 #include <type_traits>
 #include <unordered_set>
 #include <utility>
@@ -449,8 +451,8 @@ void info_xml_creator::output(std::ostream &out, const std::function<bool(const
 	};
 
 	// TODO: maybe not the best place for this as it affects the stream passed in
-	// if the device part is threaded, the local streams used by the tasks can be
-	// imbued and the stream passed in can be left alone
+	// all the output is generated in local streams imbued by the tasks, so the
+	// stream passed in could be left alone
 	out.imbue(std::locale::classic());
 
 	// prepare a driver enumerator and the queue
@@ -891,37 +893,62 @@ void output_one_device(std::ostream &out, machine_config &config, device_t &devi
 
 void output_devices(std::ostream &out, emu_options &lookup_options, device_type_set const *filter)
 {
-	// get config for empty machine
-	machine_config config(GAME_NAME(___empty), lookup_options);
+	// gather the device types up front so they can be split between tasks
+	std::vector<std::add_pointer_t<device_type> > types;
+	if (filter)
+	{
+		types.assign(filter->begin(), filter->end());
+	}
+	else
+	{
+		for (device_type type : registered_device_types)
+			types.emplace_back(&type);
+	}
 
-	auto const action = [&config, &out] (device_type type)
+	// each task adds its devices to its own empty machine config
+	auto const task_proc = [&lookup_options, &types] (std::size_t start, std::size_t end)
 			{
-				// add it at the root of the machine config
-				device_t *dev;
+				std::ostringstream stream;
+				stream.imbue(std::locale::classic());
+				machine_config config(GAME_NAME(___empty), lookup_options);
+				for (std::size_t index = start; index < end; index++)
 				{
-					machine_config::token const tok(config.begin_configuration(config.root_device()));
-					dev = config.device_add("_tmp", type, 0);
-				}
+					// add it at the root of the machine config
+					device_t *dev;
+					{
+						machine_config::token const tok(config.begin_configuration(config.root_device()));
+						dev = config.device_add("_tmp", *types[index], 0);
+					}
 
-				// notify this device and all its subdevices that they are now configured
-				for (device_t &device : device_enumerator(*dev))
-					if (!device.configured())
-						device.config_complete();
+					// notify this device and all its subdevices that they are now configured
+					for (device_t &device : device_enumerator(*dev))
+						if (!device.configured())
+							device.config_complete();
 
-				// print details and remove it
-				output_one_device(out, config, *dev, dev->tag());
-				machine_config::token const tok(config.begin_configuration(config.root_device()));
-				config.device_remove("_tmp");
+					// print details and remove it
+					output_one_device(stream, config, *dev, dev->tag());
+					machine_config::token const tok(config.begin_configuration(config.root_device()));
+					config.device_remove("_tmp");
+				}
+				return stream.str();
 			};
 
-	// run through devices
-	if (filter)
+	// keep a bounded number of tasks in flight, and emit their output in order
+	std::size_t const packet_size = 20;
+	std::size_t const maximum_outstanding_task_count = std::thread::hardware_concurrency() + 10;
+	std::queue<std::future<std::string> > tasks;
+	std::size_t next = 0;
+	while ((next < types.size()) || !tasks.empty())
 	{
-		for (std::add_pointer_t<device_type> type : *filter) action(*type);
-	}
-	else
-	{
-		for (device_type type : registered_device_types) action(type);
+		while ((next < types.size()) && (tasks.size() < maximum_outstanding_task_count))
+		{
+			std::size_t const end = std::min(next + packet_size, types.size());
+			tasks.emplace(std::async(std::launch::async, task_proc, next, end));
+			next = end;
+		}
+
+		out << tasks.front().get();
+		tasks.pop();
 	}
 }
 
@@ -16,6 +16,7 @@
 #include "ui/pluginopt.h"
 #include "ui/ui.h"
 
+#include "cpu/drcuml.h"
 #include "imagedev/cassette.h"
 
 #include "debugger.h"
@@ -691,7 +692,10 @@ void lua_engine::initialize()
 	emu["print_info"] = [] (const char *str) { osd_printf_info("%s\n", str); };
 	emu["print_debug"] = [] (const char *str) { osd_printf_debug("%s\n", str); };
 	emu["osd_ticks"] = &osd_ticks;
+	emu["drc_statistics"] = [] (std::optional<int> count) { return drcuml_state::profile_report(count ? *count : 20); };
 	emu["osd_ticks_per_second"] = &osd_ticks_per_second;
+	emu["profiler_start"] = [] () { g_profiler.start_capture(); };
+	emu["profiler_stop"] = [this] (std::string const &filename) { return g_profiler.stop_capture(machine(), filename); };
 	emu["driver_find"] =
 		[] (sol::this_state s, const char *driver) -> sol::object
 		{
@@ -1239,6 +1243,45 @@ void lua_engine::initialize()
 					return false;
 				}
 			});
+	machine_type.set_function("snapshot_save",
+			[] (running_machine &m, sol::this_state s)
+			{
+				lua_State *L = s;
+				luaL_Buffer buff;
+				size_t size = m.save().snapshot_size();
+				u8 *ptr = (u8 *)luaL_buffinitsize(L, &buff, size);
+				save_error error = m.save().save_snapshot(ptr, size);
+				if (error == STATERR_NONE)
+				{
+					luaL_pushresultsize(&buff, size);
+					return sol::make_reference(L, sol::stack_reference(L, -1));
+				}
+				luaL_error(L, "Snapshot save error.");
+				return sol::make_reference(L, nullptr);
+			});
+	machine_type.set_function("snapshot_load",
+			[] (running_machine &m, sol::this_state s, std::string_view str)
+			{
+				save_error error = m.save().load_snapshot(str.data(), str.size());
+				if (error != STATERR_NONE)
+				{
+					luaL_error(s, "Snapshot load error.");
+					return false;
+				}
+				return true;
+			});
+	machine_type.set_function("state_hash", [] (running_machine &m) { return m.save().state_hash(); });
+	machine_type.set_function("device_state_hashes",
+			[] (running_machine &m, sol::this_state s)
+			{
+				sol::table result = sol::state_view(s).create_table();
+				for (auto const &hash : m.save().device_state_hashes())
+					result[hash.first] = hash.second;
+				return result;
+			});
+	machine_type["incremental_state_hashing"] = sol::property(
+			[] (running_machine &m) { return m.save().incremental_hashing(); },
+			[] (running_machine &m, bool enable) { m.save().set_incremental_hashing(enable); });
 	machine_type.set_function("popmessage",
 			[] (running_machine &m, std::optional<const char *> str)
 			{
@@ -1249,6 +1292,7 @@ void lua_engine::initialize()
 			});
 	machine_type.set_function("logerror", [] (running_machine &m, char const *str) { m.logerror("[luaengine] %s\n", str); });
 	machine_type["time"] = sol::property(&running_machine::time);
+	machine_type["scheduler"] = sol::property(&running_machine::scheduler);
 	machine_type["system"] = sol::property(&running_machine::system);
 	machine_type["parameters"] = sol::property(&running_machine::parameters);
 	machine_type["video"] = sol::property(&running_machine::video);
@@ -1760,6 +1804,21 @@ void lua_engine::initialize()
 	parameters_type["lookup"] = &parameters_manager::lookup;
 
 
+	auto scheduler_type = sol().registry().new_usertype<device_scheduler>("scheduler", sol::no_constructor);
+	scheduler_type["start_trace"] =
+		[] (device_scheduler &sched, std::string const &filename, std::optional<u32> capacity)
+		{
+			sched.start_trace(filename, capacity ? *capacity : (1 << 20));
+		};
+	scheduler_type["stop_trace"] = &device_scheduler::stop_trace;
+	scheduler_type["time"] = sol::property(&device_scheduler::time);
+	scheduler_type["tracing"] = sol::property(&device_scheduler::tracing);
+	scheduler_type["timeslices"] = sol::property(&device_scheduler::timeslices);
+	scheduler_type["quantum_shrinks"] = sol::property(&device_scheduler::quantum_shrinks);
+	scheduler_type["adaptive_quantum_enabled"] = sol::property(&device_scheduler::adaptive_quantum_enabled);
+	scheduler_type["adaptive_quantum"] = sol::property(&device_scheduler::adaptive_quantum);
+
+
 	auto video_type = sol().registry().new_usertype<video_manager>("video", sol::no_constructor);
 	video_type["frame_update"] = [] (video_manager &vm) { vm.frame_update(true); };
 	video_type["snapshot"] = &video_manager::save_active_screen_snapshots;
@@ -1776,6 +1835,16 @@ void lua_engine::initialize()
 			vm.begin_recording(filename ? fn.c_str() : nullptr, format);
 		};
 	video_type["end_recording"] = &video_manager::end_recording;
+	video_type["run_frames"] =
+		[] (video_manager &vm, u64 frames, sol::object done)
+		{
+			if (done.is<sol::protected_function>())
+				vm.run_frames(frames, [cb = done.as<sol::protected_function>()] () { invoke(cb); });
+			else if (done == sol::lua_nil)
+				vm.run_frames(frames);
+			else
+				luaL_error(done.lua_state(), "run_frames: callback must be a function");
+		};
 	video_type["snapshot_size"] =
 		[] (video_manager &vm)
 		{
@@ -1805,6 +1874,8 @@ void lua_engine::initialize()
 	video_type["skip_this_frame"] = sol::property(&video_manager::skip_this_frame);
 	video_type["snap_native"] = sol::property(&video_manager::snap_native);
 	video_type["is_recording"] = sol::property(&video_manager::is_recording);
+	video_type["batch"] = sol::property(&video_manager::batch);
+	video_type["frames_remaining"] = sol::property(&video_manager::frames_remaining);
 	video_type["snapshot_target"] = sol::property(&video_manager::snapshot_target);
 
 
@@ -1839,6 +1910,8 @@ void lua_engine::initialize()
 			&sound_manager::attenuation,
 			&sound_manager::set_attenuation);
 	sound_type["recording"] = sol::property(&sound_manager::is_recording);
+	sound_type["update_frequency"] = sol::property(&sound_manager::update_frequency);
+	sound_type["output_latency"] = sol::property(&sound_manager::output_latency);
 
 
 	auto ui_type = sol().registry().new_usertype<mame_ui_manager>("ui", sol::no_constructor);
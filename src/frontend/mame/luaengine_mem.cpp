@@ -11,6 +11,8 @@
 #include "emu.h"
 #include "luaengine.ipp"
 
+#include "debug/memstats.h"
+
 
 namespace {
 
@@ -116,6 +118,45 @@ void share_write(memory_share &share, offs_t address, T val)
 				val >>= 8;
 		}
 	}
+	share.mark_dirty(address, sizeof(T));
+}
+
+//-------------------------------------------------
+//  raw_read_range - copy bytes out of a region or
+//  share as they are stored in host memory
+//  -> manager:machine():memory().shares[":mainram"]:read_range(0x0000, 0x07ff)
+//-------------------------------------------------
+
+sol::object raw_read_range(sol::this_state s, u8 const *base, size_t size, u64 first, u64 last)
+{
+	if ((first >= size) || (last >= size) || (last < first))
+	{
+		luaL_error(s, "Invalid offset");
+		return sol::lua_nil;
+	}
+
+	lua_pushlstring(s, reinterpret_cast<char const *>(&base[first]), last - first + 1);
+	return sol::make_reference(s, sol::stack_reference(s, -1));
+}
+
+//-------------------------------------------------
+//  raw_write_range - copy bytes into a region or
+//  share as they are stored in host memory,
+//  returns the number of bytes written
+//  -> manager:machine():memory().shares[":mainram"]:write_range(0x0000, data)
+//-------------------------------------------------
+
+size_t raw_write_range(sol::this_state s, u8 *base, size_t size, u64 first, std::string_view data)
+{
+	if (first >= size)
+	{
+		luaL_error(s, "Invalid offset");
+		return 0;
+	}
+
+	size_t const count = std::min<size_t>(data.length(), size - first);
+	std::copy_n(data.data(), count, &base[first]);
+	return count;
 }
 
 } // anonymous namespace
@@ -191,6 +232,16 @@ int sol_lua_push(sol::types<endianness_t>, lua_State *L, endianness_t &&value)
 class lua_engine::tap_helper
 {
 public:
+	// the callback is only invoked for accesses where (offset & address_mask) == address
+	// and (data & data_mask) == data, so uninteresting accesses never reach Lua
+	struct filter
+	{
+		offs_t address_mask = 0;
+		offs_t address = 0;
+		u64 data_mask = 0;
+		u64 data = 0;
+	};
+
 	tap_helper(tap_helper const &) = delete;
 	tap_helper(tap_helper &&) = delete;
 
@@ -200,7 +251,8 @@ public:
 			offs_t start,
 			offs_t end,
 			std::string &&name,
-			sol::protected_function &&callback)
+			sol::protected_function &&callback,
+			filter const &filt)
 		: m_callback(std::move(callback))
 		, m_space(space)
 		, m_handler()
@@ -208,11 +260,26 @@ public:
 		, m_start(start)
 		, m_end(end)
 		, m_mode(mode)
+		, m_filter(filt)
 		, m_installing(0U)
 	{
 		reinstall();
 	}
 
+	static filter make_filter(sol::object const &table)
+	{
+		filter result;
+		if (table.is<sol::table>())
+		{
+			sol::table const t = table.as<sol::table>();
+			result.address_mask = t.get_or<offs_t>("address_mask", 0);
+			result.address = t.get_or<offs_t>("address", 0) & result.address_mask;
+			result.data_mask = t.get_or<u64>("data_mask", 0);
+			result.data = t.get_or<u64>("data", 0) & result.data_mask;
+		}
+		return result;
+	}
+
 	~tap_helper()
 	{
 		remove();
@@ -268,6 +335,8 @@ private:
 						m_name,
 						[this] (offs_t offset, T &data, T mem_mask)
 						{
+							if (!matches(offset, data))
+								return;
 							auto result = invoke(m_callback, offset, data, mem_mask).template get<std::optional<T> >();
 							if (result)
 								data = *result;
@@ -281,6 +350,8 @@ private:
 						m_name,
 						[this] (offs_t offset, T &data, T mem_mask)
 						{
+							if (!matches(offset, data))
+								return;
 							auto result = invoke(m_callback, offset, data, mem_mask).template get<std::optional<T> >();
 							if (result)
 								data = *result;
@@ -300,6 +371,11 @@ private:
 		--m_installing;
 	};
 
+	bool matches(offs_t offset, u64 data) const
+	{
+		return ((offset & m_filter.address_mask) == m_filter.address) && ((data & m_filter.data_mask) == m_filter.data);
+	}
+
 	sol::protected_function m_callback;
 	address_space &m_space;
 	memory_passthrough_handler m_handler;
@@ -307,6 +383,7 @@ private:
 	offs_t const m_start;
 	offs_t const m_end;
 	read_or_write const m_mode;
+	filter const m_filter;
 	unsigned m_installing;
 };
 
@@ -642,6 +719,54 @@ void lua_engine::initialize_memory(sol::table &emu)
 				luaL_pushresultsize(&buff, byte_count);
 				return sol::make_reference(s, sol::stack_reference(s, -1));
 			});
+	addr_space_type.set_function("write_range",
+			[] (addr_space &sp, sol::this_state s, u64 first, int width, std::string_view data, sol::object opt_step) -> u64
+			{
+				// data is packed like the result of read_range, returns the number of items written
+				u64 step = 1;
+				if (opt_step.is<u64>())
+				{
+					step = opt_step.as<u64>();
+					if (step < 1)
+					{
+						luaL_error(s, "Invalid step");
+						return 0;
+					}
+				}
+
+				offs_t space_size = sp.space.addrmask();
+				if (first > space_size)
+				{
+					luaL_error(s, "Invalid offset");
+					return 0;
+				}
+
+				u64 count;
+				switch (width)
+				{
+				case 8:  count = data.length();     break;
+				case 16: count = data.length() / 2; break;
+				case 32: count = data.length() / 4; break;
+				case 64: count = data.length() / 8; break;
+				default:
+					luaL_error(s, "Invalid width. Must be 8/16/32/64");
+					return 0;
+				}
+				count = std::min<u64>(count, (space_size - first) / step + 1);
+
+				char const *src = data.data();
+				for (u64 i = 0; i < count; i++, first += step)
+				{
+					switch (width)
+					{
+					case 8:  { u8  val; std::memcpy(&val, src, sizeof(val)); sp.mem_write<u8>(first, val);  src += sizeof(val); break; }
+					case 16: { u16 val; std::memcpy(&val, src, sizeof(val)); sp.mem_write<u16>(first, val); src += sizeof(val); break; }
+					case 32: { u32 val; std::memcpy(&val, src, sizeof(val)); sp.mem_write<u32>(first, val); src += sizeof(val); break; }
+					case 64: { u64 val; std::memcpy(&val, src, sizeof(val)); sp.mem_write<u64>(first, val); src += sizeof(val); break; }
+					}
+				}
+				return count;
+			});
 	addr_space_type.set_function("add_change_notifier",
 			[] (addr_space &sp, sol::protected_function &&cb)
 			{
@@ -659,14 +784,19 @@ void lua_engine::initialize_memory(sol::table &emu)
 						});
 			});
 	addr_space_type.set_function("install_read_tap",
-			[] (addr_space &sp, offs_t start, offs_t end, std::string &&name, sol::protected_function &&cb)
+			[] (addr_space &sp, offs_t start, offs_t end, std::string &&name, sol::protected_function &&cb, sol::object opt_filter)
 			{
-				return std::make_unique<tap_helper>(sp.space, read_or_write::READ, start, end, std::move(name), std::move(cb));
+				return std::make_unique<tap_helper>(sp.space, read_or_write::READ, start, end, std::move(name), std::move(cb), tap_helper::make_filter(opt_filter));
 			});
 	addr_space_type.set_function("install_write_tap",
-			[] (addr_space &sp, offs_t start, offs_t end, std::string &&name, sol::protected_function &&cb)
+			[] (addr_space &sp, offs_t start, offs_t end, std::string &&name, sol::protected_function &&cb, sol::object opt_filter)
 			{
-				return std::make_unique<tap_helper>(sp.space, read_or_write::WRITE, start, end, std::move(name), std::move(cb));
+				return std::make_unique<tap_helper>(sp.space, read_or_write::WRITE, start, end, std::move(name), std::move(cb), tap_helper::make_filter(opt_filter));
+			});
+	addr_space_type.set_function("access_stats",
+			[] (addr_space &sp)
+			{
+				return std::make_unique<memory_access_stats>(sp.space);
 			});
 	addr_space_type["name"] = sol::property([] (addr_space &sp) { return sp.space.name(); });
 	addr_space_type["shift"] = sol::property([] (addr_space &sp) { return sp.space.addr_shift(); });
@@ -685,6 +815,45 @@ void lua_engine::initialize_memory(sol::table &emu)
 	tap_type["name"] = sol::property(&tap_helper::name);
 
 
+	auto stats_type = sol().registry().new_usertype<memory_access_stats>("memaccessstats", sol::no_constructor);
+	stats_type.set_function("reset", &memory_access_stats::reset);
+	stats_type["reads"] = sol::property(&memory_access_stats::reads);
+	stats_type["writes"] = sol::property(&memory_access_stats::writes);
+	stats_type["handlers"] = sol::property(
+			[this] (memory_access_stats const &stats)
+			{
+				sol::table result = sol().create_table();
+				int index = 1;
+				for (memory_access_stats::handler_stats const &handler : stats.handlers())
+				{
+					sol::table entry = sol().create_table();
+					entry["address_start"] = handler.start;
+					entry["address_end"] = handler.end;
+					entry["name"] = handler.name;
+					entry["reads"] = handler.reads;
+					entry["writes"] = handler.writes;
+					result[index++] = entry;
+				}
+				return result;
+			});
+	stats_type["pages"] = sol::property(
+			[this] (memory_access_stats const &stats)
+			{
+				sol::table result = sol().create_table();
+				int index = 1;
+				for (memory_access_stats::page_stats const &page : stats.pages())
+				{
+					sol::table entry = sol().create_table();
+					entry["address_start"] = page.start;
+					entry["address_end"] = page.end;
+					entry["reads"] = page.reads;
+					entry["writes"] = page.writes;
+					result[index++] = entry;
+				}
+				return result;
+			});
+
+
 	auto addrmap_type = sol().registry().new_usertype<address_map>("addrmap", sol::no_constructor);
 	addrmap_type["spacenum"] = sol::readonly(&address_map::m_spacenum);
 	addrmap_type["device"] = sol::readonly(&address_map::m_device);
@@ -742,6 +911,16 @@ void lua_engine::initialize_memory(sol::table &emu)
 	region_type.set_function("write_u32", &region_write<u32>);
 	region_type.set_function("write_i64", &region_write<s64>);
 	region_type.set_function("write_u64", &region_write<u64>);
+	region_type.set_function("read_range",
+			[] (memory_region &r, sol::this_state s, u64 first, u64 last)
+			{
+				return raw_read_range(s, r.base(), r.bytes(), first, last);
+			});
+	region_type.set_function("write_range",
+			[] (memory_region &r, sol::this_state s, u64 first, std::string_view data)
+			{
+				return raw_write_range(s, r.base(), r.bytes(), first, data);
+			});
 	region_type["tag"] = sol::property(&memory_region::name);
 	region_type["size"] = sol::property(&memory_region::bytes);
 	region_type["length"] = sol::property([] (memory_region &r) { return r.bytes() / r.bytewidth(); });
@@ -767,6 +946,32 @@ void lua_engine::initialize_memory(sol::table &emu)
 	share_type.set_function("write_u32", &share_write<u32>);
 	share_type.set_function("write_i64", &share_write<s64>);
 	share_type.set_function("write_u64", &share_write<u64>);
+	share_type.set_function("read_range",
+			[] (memory_share &sh, sol::this_state s, u64 first, u64 last)
+			{
+				return raw_read_range(s, reinterpret_cast<u8 const *>(sh.ptr()), sh.bytes(), first, last);
+			});
+	share_type.set_function("write_range",
+			[] (memory_share &sh, sol::this_state s, u64 first, std::string_view data)
+			{
+				size_t const count = raw_write_range(s, reinterpret_cast<u8 *>(sh.ptr()), sh.bytes(), first, data);
+				if (count)
+					sh.mark_dirty(first, count);
+				return count;
+			});
+	share_type.set_function("clear_dirty", &memory_share::clear_dirty);
+	share_type["dirty_tracking"] = sol::property(&memory_share::dirty_tracking, &memory_share::set_dirty_tracking);
+	share_type["dirty_pages"] = sol::property(
+			[this] (memory_share const &s)
+			{
+				// byte offsets of the pages written since the last clear
+				sol::table result = sol().create_table();
+				int index = 1;
+				for (size_t page : s.dirty_pages())
+					result[index++] = page << memory_share::DIRTY_PAGE_SHIFT;
+				return result;
+			});
+	share_type["page_size"] = sol::property([] (memory_share const &s) { return size_t(1) << memory_share::DIRTY_PAGE_SHIFT; });
 	share_type["tag"] = sol::property(&memory_share::name);
 	share_type["size"] = sol::property(&memory_share::bytes);
 	share_type["length"] = sol::property([] (memory_share &s) { return s.bytes() / s.bytewidth(); });
@@ -22,6 +22,7 @@
 #include "fileio.h"
 #include "luaengine.h"
 #include "mameopts.h"
+#include "nativeplugin.h"
 #include "pluginopts.h"
 #include "rendlay.h"
 #include "validity.h"
@@ -61,6 +62,7 @@ mame_machine_manager::mame_machine_manager(emu_options &options,osd_interface &o
 	machine_manager(options, osd),
 	m_plugins(std::make_unique<plugin_options>()),
 	m_lua(std::make_unique<lua_engine>()),
+	m_native_plugins(std::make_unique<native_plugin_manager>()),
 	m_new_driver_pending(nullptr),
 	m_firstrun(true),
 	m_autoboot_timer(nullptr)
@@ -74,6 +76,7 @@ mame_machine_manager::mame_machine_manager(emu_options &options,osd_interface &o
 
 mame_machine_manager::~mame_machine_manager()
 {
+	m_native_plugins.reset();
 	m_lua.reset();
 	s_manager = nullptr;
 }
@@ -106,6 +109,7 @@ void mame_machine_manager::update_machine()
 {
 	m_lua->set_machine(m_machine);
 	m_lua->attach_notifiers();
+	m_native_plugins->attach(*m_machine);
 }
 
 
@@ -195,6 +199,9 @@ void mame_machine_manager::start_luaengine()
 		p->m_start = true;
 	}
 
+	// native plugins don't depend on Lua, but load them alongside it
+	m_native_plugins->load(options().native_plugin());
+
 	m_lua->initialize();
 
 	{
@@ -273,15 +280,18 @@ int mame_machine_manager::execute()
 		bool is_empty = (system == &GAME_NAME(___empty));
 		if (!is_empty)
 		{
+			m_startup_profile.phase("validity");
 			validity_checker valid(m_options, true);
 			valid.set_verbose(false);
 			valid.check_shared_source(*system);
 		}
 
 		// create the machine configuration
+		m_startup_profile.phase("machine config");
 		machine_config config(*system, m_options);
 
 		// create the machine structure and driver
+		m_startup_profile.phase("machine");
 		running_machine machine(config, *this);
 
 		set_machine(&machine);
@@ -373,15 +383,13 @@ void mame_machine_manager::before_load_settings(running_machine& machine)
 
 void mame_machine_manager::create_custom(running_machine &machine)
 {
-	// start the inifile manager
-	m_inifile = std::make_unique<inifile_manager>(m_ui->options());
+	// the category and favourite managers are only needed by the menus, so they're created on first use
+	m_inifile.reset();
+	m_favorite.reset();
 
 	// allocate autoboot timer
 	m_autoboot_timer = machine.scheduler().timer_alloc(timer_expired_delegate(FUNC(mame_machine_manager::autoboot_callback), this));
 
-	// start favorite manager
-	m_favorite = std::make_unique<favorite_manager>(m_ui->options());
-
 	// attempt to load the autoboot script if configured
 	m_autoboot_script.reset();
 	if (*options().autoboot_script())
@@ -404,8 +412,49 @@ void mame_machine_manager::create_custom(running_machine &machine)
 
 void mame_machine_manager::load_cheatfiles(running_machine& machine)
 {
-	// set up the cheat engine
-	m_cheat = std::make_unique<cheat_manager>(machine);
+	// set up the cheat engine now if it's enabled, otherwise wait until something asks for it
+	m_cheat.reset();
+	if (machine.options().cheat())
+		m_cheat = std::make_unique<cheat_manager>(machine);
+}
+
+//-------------------------------------------------
+//  cheat - get the cheat engine, creating it if
+//  this is the first time it's been needed
+//-------------------------------------------------
+
+cheat_manager &mame_machine_manager::cheat()
+{
+	if (!m_cheat)
+	{
+		assert(machine() != nullptr);
+		m_cheat = std::make_unique<cheat_manager>(*machine());
+	}
+	return *m_cheat;
+}
+
+//-------------------------------------------------
+//  inifile - get the category INI index,
+//  scanning for category files on first use
+//-------------------------------------------------
+
+inifile_manager &mame_machine_manager::inifile()
+{
+	if (!m_inifile)
+		m_inifile = std::make_unique<inifile_manager>(ui().options());
+	return *m_inifile;
+}
+
+//-------------------------------------------------
+//  favorite - get the favourites list, loading it
+//  on first use
+//-------------------------------------------------
+
+favorite_manager &mame_machine_manager::favorite()
+{
+	if (!m_favorite)
+		m_favorite = std::make_unique<favorite_manager>(ui().options());
+	return *m_favorite;
 }
 
 //-------------------------------------------------
@@ -467,12 +516,16 @@ void emulator_info::draw_user_interface(running_machine& machine)
 
 void emulator_info::periodic_check()
 {
-	return mame_machine_manager::instance()->lua()->on_periodic();
+	mame_machine_manager *const manager = mame_machine_manager::instance();
+	manager->native_plugins().on_periodic();
+	manager->lua()->on_periodic();
 }
 
 bool emulator_info::frame_hook()
 {
-	return mame_machine_manager::instance()->lua()->frame_hook();
+	mame_machine_manager *const manager = mame_machine_manager::instance();
+	bool const native = manager->native_plugins().frame_hook();
+	return manager->lua()->frame_hook() || native;
 }
 
 void emulator_info::sound_hook()
@@ -22,6 +22,7 @@ class plugin_options;
 class osd_interface;
 
 class lua_engine;
+class native_plugin_manager;
 class cheat_manager;
 class inifile_manager;
 class favorite_manager;
@@ -42,6 +43,7 @@ public:
 
 	plugin_options &plugins() const { return *m_plugins; }
 	lua_engine *lua() { return m_lua.get(); }
+	native_plugin_manager &native_plugins() { return *m_native_plugins; }
 
 	virtual void update_machine() override;
 
@@ -65,9 +67,11 @@ public:
 	void start_luaengine();
 	void schedule_new_driver(const game_driver &driver);
 	mame_ui_manager& ui() const { assert(m_ui != nullptr); return *m_ui; }
-	cheat_manager &cheat() const { assert(m_cheat != nullptr); return *m_cheat; }
-	inifile_manager &inifile() const { assert(m_inifile != nullptr); return *m_inifile; }
-	favorite_manager &favorite() const { assert(m_favorite != nullptr); return *m_favorite; }
+
+	// these are only brought up the first time they're needed
+	cheat_manager &cheat();
+	inifile_manager &inifile();
+	favorite_manager &favorite();
 
 private:
 	// construction
@@ -79,6 +83,7 @@ private:
 
 	std::unique_ptr<plugin_options>    m_plugins;           // pointer to plugin options
 	std::unique_ptr<lua_engine>        m_lua;
+	std::unique_ptr<native_plugin_manager> m_native_plugins;
 
 	const game_driver *     m_new_driver_pending;           // pointer to the next pending driver
 	bool                    m_firstrun;
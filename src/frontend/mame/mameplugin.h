@@ -0,0 +1,136 @@
+/* license:BSD-3-Clause
+   copyright-holders:MAMEdev Team */
+/***************************************************************************
+
+    mameplugin.h
+
+    C interface for native plugins.
+
+    A native plugin is a shared library named with -native_plugin.  It
+    exports mame_plugin_init, which is called once at startup with a table
+    of host functions, and optionally mame_plugin_exit, which is called
+    before the library is unloaded.  Callbacks run on the emulation thread
+    with no Lua in the path, so they are suitable for work that has to be
+    done every frame or on every access to a memory range.
+
+    Output notifiers see the latest value of each output that changed,
+    delivered once per frame rather than on every write.
+
+    Event registrations last for the whole session.  Address spaces, taps
+    and other handles obtained from a running machine are only valid until
+    that machine stops: taps are removed automatically after the STOP event
+    has been delivered.
+
+    This header must remain valid C.  New host functions are only ever
+    appended to mame_plugin_host; check the size member before using one
+    newer than the ABI version the plugin was built against.
+
+***************************************************************************/
+
+#ifndef MAME_FRONTEND_MAME_MAMEPLUGIN_H
+#define MAME_FRONTEND_MAME_MAMEPLUGIN_H
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#define MAME_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define MAME_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+#define MAME_PLUGIN_ABI_VERSION     1
+
+#define MAME_PLUGIN_INIT_SYMBOL     "mame_plugin_init"
+#define MAME_PLUGIN_EXIT_SYMBOL     "mame_plugin_exit"
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+/* opaque handles */
+typedef struct mame_plugin_context mame_plugin_context;     /* one per loaded plugin */
+typedef struct mame_plugin_space mame_plugin_space;         /* an address space of the running machine */
+typedef struct mame_plugin_tap mame_plugin_tap;             /* an installed memory tap */
+
+/* events a plugin can register for */
+typedef enum mame_plugin_event
+{
+	MAME_PLUGIN_EVENT_START = 0,        /* machine started or was reset */
+	MAME_PLUGIN_EVENT_STOP,             /* machine is stopping */
+	MAME_PLUGIN_EVENT_PAUSE,            /* emulation paused */
+	MAME_PLUGIN_EVENT_RESUME,           /* emulation resumed */
+	MAME_PLUGIN_EVENT_FRAME,            /* start of each emulated frame */
+	MAME_PLUGIN_EVENT_FRAME_DONE,       /* frame finished, before it is drawn */
+	MAME_PLUGIN_EVENT_PERIODIC,         /* regular update, also while paused */
+
+	MAME_PLUGIN_EVENT_COUNT
+} mame_plugin_event;
+
+/* tap directions */
+typedef enum mame_plugin_tap_type
+{
+	MAME_PLUGIN_TAP_READ = 1,
+	MAME_PLUGIN_TAP_WRITE = 2,
+	MAME_PLUGIN_TAP_READWRITE = 3
+} mame_plugin_tap_type;
+
+/* callbacks */
+typedef void (*mame_plugin_event_func)(void *param);
+typedef void (*mame_plugin_tap_func)(void *param, int write, uint64_t offset, uint64_t *data, uint64_t mem_mask);
+typedef void (*mame_plugin_output_func)(void *param, const char *name, int32_t value);
+
+
+/* functions supplied by the host; all return negative or NULL on failure */
+typedef struct mame_plugin_host
+{
+	uint32_t abi_version;               /* MAME_PLUGIN_ABI_VERSION of the host */
+	uint32_t size;                      /* sizeof(mame_plugin_host) of the host */
+
+	/* events */
+	int (*add_event)(mame_plugin_context *ctx, mame_plugin_event event, mame_plugin_event_func func, void *param);
+	void (*log)(mame_plugin_context *ctx, const char *message);
+
+	/* machine; NULL or zero when no machine is running */
+	const char *(*system_name)(mame_plugin_context *ctx);
+	uint64_t (*frame_number)(mame_plugin_context *ctx);
+
+	/* address spaces: tag is absolute, e.g. ":maincpu", spacenum 0 is program */
+	mame_plugin_space *(*find_space)(mame_plugin_context *ctx, const char *tag, int spacenum);
+	int (*space_data_width)(mame_plugin_space *space);
+	uint64_t (*read)(mame_plugin_space *space, uint64_t address, int bytes);
+	void (*write)(mame_plugin_space *space, uint64_t address, int bytes, uint64_t value);
+	void *(*get_pointer)(mame_plugin_space *space, uint64_t address, int write);
+
+	/* data width taps: data is in the space's native width */
+	mame_plugin_tap *(*install_tap)(mame_plugin_space *space, mame_plugin_tap_type type, uint64_t start, uint64_t end, mame_plugin_tap_func func, void *param);
+	void (*remove_tap)(mame_plugin_tap *tap);
+
+	/* inputs: tag is the absolute port tag */
+	int (*read_port)(mame_plugin_context *ctx, const char *tag, uint32_t *value);
+	int (*set_field)(mame_plugin_context *ctx, const char *tag, uint32_t mask, uint32_t value);
+	int (*clear_field)(mame_plugin_context *ctx, const char *tag, uint32_t mask);
+
+	/* outputs */
+	int32_t (*get_output)(mame_plugin_context *ctx, const char *name);
+	void (*set_output)(mame_plugin_context *ctx, const char *name, int32_t value);
+	int (*add_output_notifier)(mame_plugin_context *ctx, mame_plugin_output_func func, void *param);
+} mame_plugin_host;
+
+
+/* exported by the plugin; return zero to stay loaded */
+typedef int (*mame_plugin_init_func)(const mame_plugin_host *host, mame_plugin_context *ctx);
+typedef void (*mame_plugin_exit_func)(mame_plugin_context *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MAME_FRONTEND_MAME_MAMEPLUGIN_H */
@@ -78,6 +78,7 @@ void media_identifier::identify(const char *filename)
 {
 	std::vector<file_info> info;
 	collect_files(info, filename);
+	digest_pending(info);
 	match_hashes(info);
 	print_results(info);
 }
@@ -91,6 +92,7 @@ void media_identifier::identify_file(const char *name)
 {
 	std::vector<file_info> info;
 	digest_file(info, name);
+	digest_pending(info);
 	match_hashes(info);
 	print_results(info);
 }
@@ -259,32 +261,89 @@ void media_identifier::digest_file(std::vector<file_info> &info, char const *pat
 			}
 		}
 
-		// load the file and process if it opens and has a valid length
-		util::core_file::ptr file;
-		std::error_condition err = util::core_file::open(path, OPEN_FLAG_READ, file);
-		if (err || !file)
-		{
-			osd_printf_error("%s: error opening file (%s)\n", path, err ? err.message() : std::string("could not allocate pointer"));
-			return;
-		}
-		std::uint64_t length;
-		err = file->length(length);
-		if (err)
+		// hash raw files later, several at a time, keeping a place for the result in the list
+		m_pending.emplace_back(raw_digest{ path, info.size(), 0U, util::hash_collection(), std::string() });
+		info.emplace_back(path, 0U, util::hash_collection(), file_flavour::RAW);
+	}
+}
+
+
+//-------------------------------------------------
+//  digest_raw - work queue callback to hash a
+//  raw file
+//-------------------------------------------------
+
+void *media_identifier::digest_raw(void *param, int threadid)
+{
+	raw_digest &digest = *reinterpret_cast<raw_digest *>(param);
+
+	// load the file and process if it opens and has a valid length
+	util::core_file::ptr file;
+	std::error_condition err = util::core_file::open(digest.m_path, OPEN_FLAG_READ, file);
+	if (err || !file)
+	{
+		digest.m_error = util::string_format("%s: error opening file (%s)\n", digest.m_path, err ? err.message() : std::string("could not allocate pointer"));
+		return nullptr;
+	}
+	err = file->length(digest.m_length);
+	if (err)
+	{
+		digest.m_error = util::string_format("%s: error getting file length (%s)\n", digest.m_path, err.message());
+		return nullptr;
+	}
+	std::size_t actual;
+	err = digest.m_hashes.compute(*file, 0U, digest.m_length, actual, util::hash_collection::HASH_TYPES_CRC_SHA1);
+	if (err)
+		digest.m_error = util::string_format("%s: error reading file (%s)\n", digest.m_path, err.message());
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  digest_pending - hash queued raw files in
+//  parallel and fill in their results
+//-------------------------------------------------
+
+void media_identifier::digest_pending(std::vector<file_info> &info)
+{
+	if (m_pending.empty())
+		return;
+
+	// hashing is mostly bound by I/O and CPU in equal measure, so let the work queue spread it out
+	osd_work_queue *const queue = (m_pending.size() > 1) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_IO | WORK_QUEUE_FLAG_MULTI) : nullptr;
+	if (queue)
+	{
+		osd_work_item_queue_multiple(queue, &media_identifier::digest_raw, m_pending.size(), &m_pending[0], sizeof(m_pending[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 100)) { }
+		osd_work_queue_free(queue);
+	}
+	else
+	{
+		for (raw_digest &digest : m_pending)
+			digest_raw(&digest, 0);
+	}
+
+	// report in the order the files were found
+	for (raw_digest &digest : m_pending)
+	{
+		if (!digest.m_error.empty())
 		{
-			osd_printf_error("%s: error getting file length (%s)\n", path, err.message());
-			return;
+			osd_printf_error("%s", digest.m_error);
 		}
-		util::hash_collection hashes;
-		std::size_t actual;
-		err = hashes.compute(*file, 0U, length, actual, util::hash_collection::HASH_TYPES_CRC_SHA1);
-		if (err)
+		else
 		{
-			osd_printf_error("%s: error reading file (%s)\n", path, err.message());
-			return;
+			info[digest.m_index] = file_info(std::move(digest.m_path), digest.m_length, std::move(digest.m_hashes), file_flavour::RAW);
+			m_total++;
 		}
-		info.emplace_back(path, length, std::move(hashes), file_flavour::RAW);
-		m_total++;
 	}
+
+	// drop the placeholders for files that couldn't be read, working backwards so indices stay valid
+	for (auto it = m_pending.rbegin(); m_pending.rend() != it; ++it)
+	{
+		if (!it->m_error.empty())
+			info.erase(info.begin() + it->m_index);
+	}
+	m_pending.clear();
 }
 
 
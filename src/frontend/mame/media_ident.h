@@ -116,13 +116,27 @@ private:
 		std::vector<match_data> m_matches;
 	};
 
+	// a raw file waiting to be hashed on a worker thread
+	struct raw_digest
+	{
+		std::string             m_path;
+		std::size_t             m_index;
+		std::uint64_t           m_length;
+		util::hash_collection   m_hashes;
+		std::string             m_error;
+	};
+
+	static void *digest_raw(void *param, int threadid);
+
 	void collect_files(std::vector<file_info> &info, char const *path);
 	void digest_file(std::vector<file_info> &info, char const *path);
+	void digest_pending(std::vector<file_info> &info);
 	void digest_data(std::vector<file_info> &info, char const *name, void const *data, std::uint64_t length);
 	void match_hashes(std::vector<file_info> &info);
 	void print_results(std::vector<file_info> const &info);
 
 	driver_enumerator       m_drivlist;
+	std::vector<raw_digest> m_pending;
 	unsigned                m_total;
 	unsigned                m_matches;
 	unsigned                m_nonroms;
@@ -0,0 +1,591 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    nativeplugin.cpp
+
+    Host side of the native plugin interface.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "nativeplugin.h"
+
+#include "screen.h"
+
+#include "path.h"
+
+#include "../osd/modules/lib/osdlib.h"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+
+
+//**************************************************************************
+//  HANDLE TYPES
+//**************************************************************************
+
+struct mame_plugin_context
+{
+	native_plugin_manager &manager;
+	std::string path;
+	osd::dynamic_module::ptr module;
+	mame_plugin_exit_func exit;
+};
+
+struct mame_plugin_space
+{
+	native_plugin_manager &manager;
+	address_space &space;
+};
+
+struct mame_plugin_tap
+{
+	mame_plugin_space &space;
+	mame_plugin_tap_func func;
+	void *param;
+	memory_passthrough_handler handler;
+};
+
+
+namespace {
+
+//-------------------------------------------------
+//  install_tap - install a passthrough handler
+//  of the space's data width
+//-------------------------------------------------
+
+template <typename T>
+void install_tap(mame_plugin_tap &tap, mame_plugin_tap_type type, offs_t start, offs_t end)
+{
+	address_space &space(tap.space.space);
+	auto const call =
+			[&tap] (int write, offs_t offset, T &data, T mem_mask)
+			{
+				uint64_t value = data;
+				tap.func(tap.param, write, offset, &value, mem_mask);
+				data = T(value);
+			};
+	std::function<void (offs_t, T &, T)> const reader = [call] (offs_t offset, T &data, T mem_mask) { call(0, offset, data, mem_mask); };
+	std::function<void (offs_t, T &, T)> const writer = [call] (offs_t offset, T &data, T mem_mask) { call(1, offset, data, mem_mask); };
+
+	switch (type)
+	{
+	case MAME_PLUGIN_TAP_READ:
+		tap.handler = space.install_read_tap(start, end, "native plugin", reader, &tap.handler);
+		break;
+	case MAME_PLUGIN_TAP_WRITE:
+		tap.handler = space.install_write_tap(start, end, "native plugin", writer, &tap.handler);
+		break;
+	case MAME_PLUGIN_TAP_READWRITE:
+		tap.handler = space.install_readwrite_tap(start, end, "native plugin", reader, writer, &tap.handler);
+		break;
+	}
+}
+
+} // anonymous namespace
+
+
+
+//**************************************************************************
+//  HOST FUNCTION TABLE
+//**************************************************************************
+
+mame_plugin_host const native_plugin_manager::s_host =
+{
+	MAME_PLUGIN_ABI_VERSION,
+	sizeof(mame_plugin_host),
+
+	&native_plugin_manager::host_add_event,
+	&native_plugin_manager::host_log,
+
+	&native_plugin_manager::host_system_name,
+	&native_plugin_manager::host_frame_number,
+
+	&native_plugin_manager::host_find_space,
+	&native_plugin_manager::host_space_data_width,
+	&native_plugin_manager::host_read,
+	&native_plugin_manager::host_write,
+	&native_plugin_manager::host_get_pointer,
+
+	&native_plugin_manager::host_install_tap,
+	&native_plugin_manager::host_remove_tap,
+
+	&native_plugin_manager::host_read_port,
+	&native_plugin_manager::host_set_field,
+	&native_plugin_manager::host_clear_field,
+
+	&native_plugin_manager::host_get_output,
+	&native_plugin_manager::host_set_output,
+	&native_plugin_manager::host_add_output_notifier
+};
+
+
+
+//**************************************************************************
+//  NATIVE PLUGIN MANAGER
+//**************************************************************************
+
+//-------------------------------------------------
+//  native_plugin_manager - constructor
+//-------------------------------------------------
+
+native_plugin_manager::native_plugin_manager() :
+	m_machine(nullptr)
+{
+}
+
+
+//-------------------------------------------------
+//  ~native_plugin_manager - destructor
+//-------------------------------------------------
+
+native_plugin_manager::~native_plugin_manager()
+{
+	// let plugins clean up in reverse order of loading before their code goes away
+	for (auto it = m_plugins.rbegin(); m_plugins.rend() != it; ++it)
+	{
+		if ((*it)->exit)
+			(*it)->exit(it->get());
+	}
+	for (auto &events : m_events)
+		events.clear();
+	m_outputs.clear();
+	m_plugins.clear();
+}
+
+
+//-------------------------------------------------
+//  load - load and initialise plugin libraries
+//-------------------------------------------------
+
+void native_plugin_manager::load(std::string_view libraries)
+{
+	while (!libraries.empty())
+	{
+		auto const sep = libraries.find(';');
+		std::string path(libraries.substr(0, sep));
+		libraries.remove_prefix((std::string_view::npos != sep) ? (sep + 1) : libraries.size());
+		if (path.empty())
+			continue;
+
+		path = osd_subst_env(path);
+		auto plugin = std::make_unique<mame_plugin_context>(mame_plugin_context{ *this, path, osd::dynamic_module::open({ path }), nullptr });
+		auto const init = plugin->module->bind<mame_plugin_init_func>(MAME_PLUGIN_INIT_SYMBOL);
+		if (!init)
+			fatalerror("Fatal error: Could not load native plugin: %s\n", path);
+		plugin->exit = plugin->module->bind<mame_plugin_exit_func>(MAME_PLUGIN_EXIT_SYMBOL);
+
+		mame_plugin_context *const ctx = plugin.get();
+		m_plugins.emplace_back(std::move(plugin));
+		int const result = init(&s_host, ctx);
+		if (result)
+		{
+			// drop anything it registered before giving up
+			osd_printf_error("Native plugin %s failed to initialize (%d)\n", path, result);
+			auto const owned = [ctx] (auto const &entry) { return entry.context == ctx; };
+			for (auto &events : m_events)
+				events.erase(std::remove_if(events.begin(), events.end(), owned), events.end());
+			m_outputs.erase(std::remove_if(m_outputs.begin(), m_outputs.end(), owned), m_outputs.end());
+			m_plugins.pop_back();
+		}
+		else
+		{
+			osd_printf_verbose("Loaded native plugin %s\n", path);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  attach - hook up to a machine that has
+//  finished starting
+//-------------------------------------------------
+
+void native_plugin_manager::attach(running_machine &machine)
+{
+	if (m_plugins.empty())
+		return;
+
+	m_machine = &machine;
+	machine.add_notifier(MACHINE_NOTIFY_RESET, machine_notify_delegate(&native_plugin_manager::on_machine_start, this));
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(&native_plugin_manager::on_machine_stop, this));
+	machine.add_notifier(MACHINE_NOTIFY_PAUSE, machine_notify_delegate(&native_plugin_manager::on_machine_pause, this));
+	machine.add_notifier(MACHINE_NOTIFY_RESUME, machine_notify_delegate(&native_plugin_manager::on_machine_resume, this));
+	if (!m_events[MAME_PLUGIN_EVENT_FRAME].empty())
+		machine.add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&native_plugin_manager::on_machine_frame, this));
+	if (!m_outputs.empty())
+		machine.output().set_global_notifier(&native_plugin_manager::on_output, this);
+}
+
+
+//-------------------------------------------------
+//  on_periodic - periodic frontend update
+//-------------------------------------------------
+
+void native_plugin_manager::on_periodic()
+{
+	if (m_machine)
+		dispatch(MAME_PLUGIN_EVENT_PERIODIC);
+}
+
+
+//-------------------------------------------------
+//  frame_hook - frame is complete; returns true
+//  if anybody was interested
+//-------------------------------------------------
+
+bool native_plugin_manager::frame_hook()
+{
+	if (!m_machine || m_events[MAME_PLUGIN_EVENT_FRAME_DONE].empty())
+		return false;
+
+	dispatch(MAME_PLUGIN_EVENT_FRAME_DONE);
+	return true;
+}
+
+
+//-------------------------------------------------
+//  machine notifiers
+//-------------------------------------------------
+
+void native_plugin_manager::on_machine_start()
+{
+	dispatch(MAME_PLUGIN_EVENT_START);
+}
+
+void native_plugin_manager::on_machine_stop()
+{
+	dispatch(MAME_PLUGIN_EVENT_STOP);
+	release_machine();
+}
+
+void native_plugin_manager::on_machine_pause()
+{
+	dispatch(MAME_PLUGIN_EVENT_PAUSE);
+}
+
+void native_plugin_manager::on_machine_resume()
+{
+	dispatch(MAME_PLUGIN_EVENT_RESUME);
+}
+
+void native_plugin_manager::on_machine_frame()
+{
+	dispatch(MAME_PLUGIN_EVENT_FRAME);
+}
+
+void native_plugin_manager::on_output(char const *outname, s32 value, void *param)
+{
+	native_plugin_manager &manager(*reinterpret_cast<native_plugin_manager *>(param));
+	for (output_entry const &entry : manager.m_outputs)
+		entry.func(entry.param, outname, value);
+}
+
+
+//-------------------------------------------------
+//  dispatch - call everything registered for an
+//  event
+//-------------------------------------------------
+
+void native_plugin_manager::dispatch(mame_plugin_event event)
+{
+	// indexed so a callback can register more without invalidating the iteration
+	std::vector<event_entry> const &events(m_events[event]);
+	for (size_t i = 0; events.size() > i; ++i)
+		events[i].func(events[i].param);
+}
+
+
+//-------------------------------------------------
+//  find_port - look up an I/O port of the
+//  current machine
+//-------------------------------------------------
+
+ioport_port *native_plugin_manager::find_port(char const *tag) const
+{
+	if (!m_machine || !tag)
+		return nullptr;
+
+	auto const found = m_machine->ioport().ports().find(tag);
+	return (m_machine->ioport().ports().end() != found) ? found->second.get() : nullptr;
+}
+
+
+//-------------------------------------------------
+//  release_machine - remove taps and forget
+//  handles belonging to the stopping machine
+//-------------------------------------------------
+
+void native_plugin_manager::release_machine()
+{
+	for (auto &tap : m_taps)
+		tap->handler.remove();
+	m_taps.clear();
+	m_spaces.clear();
+	m_machine = nullptr;
+}
+
+
+//-------------------------------------------------
+//  host functions - events
+//-------------------------------------------------
+
+int native_plugin_manager::host_add_event(mame_plugin_context *ctx, mame_plugin_event event, mame_plugin_event_func func, void *param)
+{
+	if (!ctx || !func || (0 > event) || (MAME_PLUGIN_EVENT_COUNT <= event))
+		return -1;
+
+	native_plugin_manager &manager(ctx->manager);
+	bool const first_frame = (MAME_PLUGIN_EVENT_FRAME == event) && manager.m_events[event].empty();
+	manager.m_events[event].emplace_back(event_entry{ ctx, func, param });
+
+	// frame notifications are only requested from the machine if somebody wants them
+	if (first_frame && manager.m_machine)
+		manager.m_machine->add_notifier(MACHINE_NOTIFY_FRAME, machine_notify_delegate(&native_plugin_manager::on_machine_frame, &manager));
+	return 0;
+}
+
+void native_plugin_manager::host_log(mame_plugin_context *ctx, char const *message)
+{
+	if (ctx && message)
+		osd_printf_info("[%s] %s\n", core_filename_extract_base(ctx->path, true), message);
+}
+
+
+//-------------------------------------------------
+//  host functions - machine
+//-------------------------------------------------
+
+char const *native_plugin_manager::host_system_name(mame_plugin_context *ctx)
+{
+	running_machine *const machine = ctx ? ctx->manager.m_machine : nullptr;
+	return machine ? machine->system().name : nullptr;
+}
+
+uint64_t native_plugin_manager::host_frame_number(mame_plugin_context *ctx)
+{
+	running_machine *const machine = ctx ? ctx->manager.m_machine : nullptr;
+	screen_device *const screen = machine ? screen_device_enumerator(machine->root_device()).first() : nullptr;
+	return screen ? screen->frame_number() : 0;
+}
+
+
+//-------------------------------------------------
+//  host functions - address spaces
+//-------------------------------------------------
+
+mame_plugin_space *native_plugin_manager::host_find_space(mame_plugin_context *ctx, char const *tag, int spacenum)
+{
+	running_machine *const machine = ctx ? ctx->manager.m_machine : nullptr;
+	if (!machine || !tag)
+		return nullptr;
+
+	device_t *const device = machine->root_device().subdevice(tag);
+	device_memory_interface *memory = nullptr;
+	if (!device || !device->interface(memory) || !memory->has_space(spacenum))
+		return nullptr;
+
+	// hand out the same wrapper every time so plugins can compare handles
+	address_space &space(memory->space(spacenum));
+	native_plugin_manager &manager(ctx->manager);
+	for (auto const &existing : manager.m_spaces)
+	{
+		if (&existing->space == &space)
+			return existing.get();
+	}
+	return manager.m_spaces.emplace_back(std::make_unique<mame_plugin_space>(mame_plugin_space{ manager, space })).get();
+}
+
+int native_plugin_manager::host_space_data_width(mame_plugin_space *space)
+{
+	return space ? space->space.data_width() : -1;
+}
+
+uint64_t native_plugin_manager::host_read(mame_plugin_space *space, uint64_t address, int bytes)
+{
+	if (!space)
+		return 0;
+
+	address_space &s(space->space);
+	offs_t const addr(address);
+	switch (bytes)
+	{
+	case 1:
+		return s.read_byte(addr);
+	case 2:
+		return WORD_ALIGNED(addr) ? s.read_word(addr) : s.read_word_unaligned(addr);
+	case 4:
+		return DWORD_ALIGNED(addr) ? s.read_dword(addr) : s.read_dword_unaligned(addr);
+	case 8:
+		return QWORD_ALIGNED(addr) ? s.read_qword(addr) : s.read_qword_unaligned(addr);
+	default:
+		return 0;
+	}
+}
+
+void native_plugin_manager::host_write(mame_plugin_space *space, uint64_t address, int bytes, uint64_t value)
+{
+	if (!space)
+		return;
+
+	address_space &s(space->space);
+	offs_t const addr(address);
+	switch (bytes)
+	{
+	case 1:
+		s.write_byte(addr, u8(value));
+		break;
+	case 2:
+		if (WORD_ALIGNED(addr))
+			s.write_word(addr, u16(value));
+		else
+			s.write_word_unaligned(addr, u16(value));
+		break;
+	case 4:
+		if (DWORD_ALIGNED(addr))
+			s.write_dword(addr, u32(value));
+		else
+			s.write_dword_unaligned(addr, u32(value));
+		break;
+	case 8:
+		if (QWORD_ALIGNED(addr))
+			s.write_qword(addr, value);
+		else
+			s.write_qword_unaligned(addr, value);
+		break;
+	}
+}
+
+void *native_plugin_manager::host_get_pointer(mame_plugin_space *space, uint64_t address, int write)
+{
+	if (!space)
+		return nullptr;
+	return write ? space->space.get_write_ptr(offs_t(address)) : space->space.get_read_ptr(offs_t(address));
+}
+
+
+//-------------------------------------------------
+//  host functions - taps
+//-------------------------------------------------
+
+mame_plugin_tap *native_plugin_manager::host_install_tap(mame_plugin_space *space, mame_plugin_tap_type type, uint64_t start, uint64_t end, mame_plugin_tap_func func, void *param)
+{
+	if (!space || !func || (MAME_PLUGIN_TAP_READ > type) || (MAME_PLUGIN_TAP_READWRITE < type) || (start > end))
+		return nullptr;
+
+	auto tap = std::make_unique<mame_plugin_tap>(mame_plugin_tap{ *space, func, param, memory_passthrough_handler() });
+	switch (space->space.data_width())
+	{
+	case 8:
+		install_tap<u8>(*tap, type, offs_t(start), offs_t(end));
+		break;
+	case 16:
+		install_tap<u16>(*tap, type, offs_t(start), offs_t(end));
+		break;
+	case 32:
+		install_tap<u32>(*tap, type, offs_t(start), offs_t(end));
+		break;
+	case 64:
+		install_tap<u64>(*tap, type, offs_t(start), offs_t(end));
+		break;
+	default:
+		return nullptr;
+	}
+	return space->manager.m_taps.emplace_back(std::move(tap)).get();
+}
+
+void native_plugin_manager::host_remove_tap(mame_plugin_tap *tap)
+{
+	if (!tap)
+		return;
+
+	auto &taps(tap->space.manager.m_taps);
+	auto const found = std::find_if(taps.begin(), taps.end(), [tap] (auto const &t) { return t.get() == tap; });
+	if (taps.end() != found)
+	{
+		tap->handler.remove();
+		taps.erase(found);
+	}
+}
+
+
+//-------------------------------------------------
+//  host functions - inputs
+//-------------------------------------------------
+
+int native_plugin_manager::host_read_port(mame_plugin_context *ctx, char const *tag, uint32_t *value)
+{
+	ioport_port *const port = ctx ? ctx->manager.find_port(tag) : nullptr;
+	if (!port || !value)
+		return -1;
+
+	*value = port->read();
+	return 0;
+}
+
+int native_plugin_manager::host_set_field(mame_plugin_context *ctx, char const *tag, uint32_t mask, uint32_t value)
+{
+	ioport_port *const port = ctx ? ctx->manager.find_port(tag) : nullptr;
+	if (!port)
+		return -1;
+
+	for (ioport_field &field : port->fields())
+	{
+		if (field.mask() & mask)
+		{
+			field.set_value(value);
+			return 0;
+		}
+	}
+	return -1;
+}
+
+int native_plugin_manager::host_clear_field(mame_plugin_context *ctx, char const *tag, uint32_t mask)
+{
+	ioport_port *const port = ctx ? ctx->manager.find_port(tag) : nullptr;
+	if (!port)
+		return -1;
+
+	for (ioport_field &field : port->fields())
+	{
+		if (field.mask() & mask)
+		{
+			field.clear_value();
+			return 0;
+		}
+	}
+	return -1;
+}
+
+
+//-------------------------------------------------
+//  host functions - outputs
+//-------------------------------------------------
+
+int32_t native_plugin_manager::host_get_output(mame_plugin_context *ctx, char const *name)
+{
+	running_machine *const machine = ctx ? ctx->manager.m_machine : nullptr;
+	return (machine && name) ? machine->output().get_value(name) : 0;
+}
+
+void native_plugin_manager::host_set_output(mame_plugin_context *ctx, char const *name, int32_t value)
+{
+	running_machine *const machine = ctx ? ctx->manager.m_machine : nullptr;
+	if (machine && name)
+		machine->output().set_value(name, value);
+}
+
+int native_plugin_manager::host_add_output_notifier(mame_plugin_context *ctx, mame_plugin_output_func func, void *param)
+{
+	if (!ctx || !func)
+		return -1;
+
+	native_plugin_manager &manager(ctx->manager);
+	bool const first = manager.m_outputs.empty();
+	manager.m_outputs.emplace_back(output_entry{ ctx, func, param });
+	if (first && manager.m_machine)
+		manager.m_machine->output().set_global_notifier(&native_plugin_manager::on_output, &manager);
+	return 0;
+}
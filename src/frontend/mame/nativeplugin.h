@@ -0,0 +1,104 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    nativeplugin.h
+
+    Host side of the native plugin interface.
+
+***************************************************************************/
+
+#ifndef MAME_FRONTEND_MAME_NATIVEPLUGIN_H
+#define MAME_FRONTEND_MAME_NATIVEPLUGIN_H
+
+#pragma once
+
+#include "mameplugin.h"
+
+#include <list>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> native_plugin_manager
+
+class native_plugin_manager
+{
+public:
+	// construction/destruction
+	native_plugin_manager();
+	~native_plugin_manager();
+
+	// load a semicolon-separated list of libraries
+	void load(std::string_view libraries);
+
+	// hook up to a machine that has finished starting
+	void attach(running_machine &machine);
+
+	// hooks called from the frontend
+	void on_periodic();
+	bool frame_hook();
+
+private:
+	struct event_entry
+	{
+		mame_plugin_context *context;
+		mame_plugin_event_func func;
+		void *param;
+	};
+
+	struct output_entry
+	{
+		mame_plugin_context *context;
+		mame_plugin_output_func func;
+		void *param;
+	};
+
+	// host function table
+	static mame_plugin_host const s_host;
+
+	static int host_add_event(mame_plugin_context *ctx, mame_plugin_event event, mame_plugin_event_func func, void *param);
+	static void host_log(mame_plugin_context *ctx, char const *message);
+	static char const *host_system_name(mame_plugin_context *ctx);
+	static uint64_t host_frame_number(mame_plugin_context *ctx);
+	static mame_plugin_space *host_find_space(mame_plugin_context *ctx, char const *tag, int spacenum);
+	static int host_space_data_width(mame_plugin_space *space);
+	static uint64_t host_read(mame_plugin_space *space, uint64_t address, int bytes);
+	static void host_write(mame_plugin_space *space, uint64_t address, int bytes, uint64_t value);
+	static void *host_get_pointer(mame_plugin_space *space, uint64_t address, int write);
+	static mame_plugin_tap *host_install_tap(mame_plugin_space *space, mame_plugin_tap_type type, uint64_t start, uint64_t end, mame_plugin_tap_func func, void *param);
+	static void host_remove_tap(mame_plugin_tap *tap);
+	static int host_read_port(mame_plugin_context *ctx, char const *tag, uint32_t *value);
+	static int host_set_field(mame_plugin_context *ctx, char const *tag, uint32_t mask, uint32_t value);
+	static int host_clear_field(mame_plugin_context *ctx, char const *tag, uint32_t mask);
+	static int32_t host_get_output(mame_plugin_context *ctx, char const *name);
+	static void host_set_output(mame_plugin_context *ctx, char const *name, int32_t value);
+	static int host_add_output_notifier(mame_plugin_context *ctx, mame_plugin_output_func func, void *param);
+
+	// machine notifiers
+	void on_machine_start();
+	void on_machine_stop();
+	void on_machine_pause();
+	void on_machine_resume();
+	void on_machine_frame();
+	static void on_output(char const *outname, s32 value, void *param);
+
+	// helpers
+	void dispatch(mame_plugin_event event);
+	ioport_port *find_port(char const *tag) const;
+	void release_machine();
+
+	running_machine *                                   m_machine;
+	std::vector<std::unique_ptr<mame_plugin_context> >  m_plugins;
+	std::vector<event_entry>                            m_events[MAME_PLUGIN_EVENT_COUNT];
+	std::vector<output_entry>                           m_outputs;
+	std::vector<std::unique_ptr<mame_plugin_space> >    m_spaces;   // wrappers handed out for the current machine
+	std::list<std::unique_ptr<mame_plugin_tap> >        m_taps;     // taps installed in the current machine
+};
+
+#endif // MAME_FRONTEND_MAME_NATIVEPLUGIN_H
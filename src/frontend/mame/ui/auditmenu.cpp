@@ -48,6 +48,7 @@ menu_audit::menu_audit(mame_ui_manager &mui, render_container &container)
 				m_availablesorted.end(),
 				std::size_t(0),
 				[] (std::size_t n, ui_system_info const &info) { return n + (info.available ? 0 : 1);  }))
+	, m_cache()
 	, m_future()
 	, m_next(0)
 	, m_audited(0)
@@ -155,6 +156,7 @@ void menu_audit::handle(event const *ev)
 				m_phase = phase::AUDIT;
 				m_fast = ITEMREF_START_FAST == ev->itemref;
 				m_prompt = util::string_format(_("Press %1$s to cancel\n"), ui().get_general_input_setting(IPT_UI_CANCEL));
+				m_cache = std::make_unique<media_audit_cache>(machine().options());
 				m_future.resize(std::thread::hardware_concurrency());
 				for (auto &future : m_future)
 					future = std::async(std::launch::async, [this] () { return do_audit(); });
@@ -170,6 +172,7 @@ void menu_audit::handle(event const *ev)
 			for (auto &future : m_future)
 				done = future.get() && done;
 			m_future.clear();
+			m_cache.reset();
 			if (done)
 			{
 				save_available_machines();
@@ -209,7 +212,7 @@ bool menu_audit::do_audit()
 			m_current.store(&info);
 			driver_enumerator enumerator(machine().options(), info.driver->name);
 			enumerator.next();
-			media_auditor auditor(enumerator);
+			media_auditor auditor(enumerator, m_cache.get());
 			media_auditor::summary const summary(auditor.audit_media(AUDIT_VALIDATE_FAST));
 			info.available = (summary == media_auditor::CORRECT) || (summary == media_auditor::BEST_AVAILABLE) || (summary == media_auditor::NONE_NEEDED);
 
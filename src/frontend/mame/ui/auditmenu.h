@@ -17,9 +17,12 @@
 
 #include <atomic>
 #include <future>
+#include <memory>
 #include <vector>
 
 
+class media_audit_cache;
+
 namespace ui {
 
 class menu_audit : public menu
@@ -44,6 +47,7 @@ private:
 	std::string m_prompt;
 	std::vector<std::reference_wrapper<ui_system_info> > const &m_availablesorted;
 	std::size_t const m_unavailable;
+	std::unique_ptr<media_audit_cache> m_cache;
 	std::vector<std::future<bool> > m_future;
 	std::atomic<std::size_t> m_next;
 	std::atomic<std::size_t> m_audited;
@@ -30,13 +30,26 @@
 
 namespace ui {
 
+namespace {
+
+ui_system_info const &current_system_info(mame_ui_manager &mui)
+{
+	// the system list is only built on demand
+	system_list &systems(system_list::instance());
+	systems.cache_data(mui.options());
+	return systems.systems()[driver_list::find(mui.machine().system().name)];
+}
+
+} // anonymous namespace
+
+
 //-------------------------------------------------
 //  ctor / dtor
 //-------------------------------------------------
 
 menu_dats_view::menu_dats_view(mame_ui_manager &mui, render_container &container, const ui_system_info *system)
 	: menu_textbox(mui, container)
-	, m_system(!system ? &system_list::instance().systems()[driver_list::find(mui.machine().system().name)] : system)
+	, m_system(!system ? &current_system_info(mui) : system)
 	, m_swinfo(nullptr)
 	, m_issoft(false)
 	, m_actual(0)
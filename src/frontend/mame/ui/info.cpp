@@ -365,6 +365,7 @@ std::string machine_info::game_info_string() const
 	std::ostringstream buf;
 
 	// print description, manufacturer, and CPU:
+	system_list::instance().cache_data(dynamic_cast<mame_ui_manager &>(m_machine.ui()).options());
 	std::string_view src(m_machine.system().type.source());
 	auto prefix(src.find("src/mame/"));
 	if (std::string_view::npos == prefix)
@@ -910,26 +910,48 @@ render_texture *menu_select_game::get_icon_texture(int linenum, void *selectedre
 				cloneof = false;
 		}
 
-		bitmap_argb32 tmp;
-		emu_file snapfile(std::string(m_icon_paths), OPEN_FLAG_READ);
-		if (!snapfile.open(std::string(driver->name) + ".ico"))
-		{
-			render_load_ico_highest_detail(snapfile, tmp);
-			snapfile.close();
-		}
-		if (!tmp.valid() && cloneof && !snapfile.open(std::string(driver->parent) + ".ico"))
-		{
-			render_load_ico_highest_detail(snapfile, tmp);
-			snapfile.close();
-		}
-
-		scale_icon(std::move(tmp), icon->second);
+		// decode it in the background and show nothing until it arrives
+		request_icon(
+				driver,
+				[paths = m_icon_paths, name = std::string(driver->name), parent = cloneof ? std::string(driver->parent) : std::string()] (bitmap_argb32 &bitmap)
+				{
+					emu_file snapfile(std::string(paths), OPEN_FLAG_READ);
+					if (!snapfile.open(name + ".ico"))
+					{
+						render_load_ico_highest_detail(snapfile, bitmap);
+						snapfile.close();
+					}
+					if (!bitmap.valid() && !parent.empty() && !snapfile.open(parent + ".ico"))
+					{
+						render_load_ico_highest_detail(snapfile, bitmap);
+						snapfile.close();
+					}
+				});
+		icon->second.bitmap.reset();
 	}
 
 	return icon->second.bitmap.valid() ? icon->second.texture.get() : nullptr;
 }
 
 
+//-------------------------------------------------
+//  icon_loaded - an icon has been decoded
+//-------------------------------------------------
+
+void menu_select_game::icon_loaded(void const *key, bitmap_argb32 *bitmap)
+{
+	icon_cache::iterator const icon(m_icons.find(reinterpret_cast<game_driver const *>(key)));
+	if (m_icons.end() == icon)
+		return;
+
+	// a dropped request is forgotten so the icon is asked for again when it's next needed
+	if (!bitmap)
+		m_icons.erase(icon);
+	else if (icon->second.texture)
+		scale_icon(std::move(*bitmap), icon->second);
+}
+
+
 void menu_select_game::inkey_export()
 {
 	std::vector<game_driver const *> list;
@@ -61,6 +61,7 @@ private:
 	// drawing
 	virtual float draw_left_panel(float x1, float y1, float x2, float y2) override;
 	virtual render_texture *get_icon_texture(int linenum, void *selectedref) override;
+	virtual void icon_loaded(void const *key, bitmap_argb32 *bitmap) override;
 
 	// get selected software and/or driver
 	virtual void get_selection(ui_software_info const *&software, ui_system_info const *&system) const override;
@@ -41,7 +41,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 
@@ -193,6 +197,46 @@ private:
 	s_bios      m_bios;
 };
 
+// finds and decodes images on a worker thread; textures are still made on the UI thread
+class menu_select_launch::image_loader
+{
+public:
+	// icons use a view of -1
+	struct result
+	{
+		int             view;
+		void const      *key;
+		bool            loaded;         // false if the request was dropped
+		bitmap_argb32   bitmap;
+	};
+
+	image_loader();
+	~image_loader();
+
+	void request(int view, void const *key, image_load_func &&loader, bool prefetch);
+	std::vector<result> take_results();
+
+private:
+	// requests beyond this are dropped, oldest first
+	static constexpr std::size_t MAX_PENDING = MAX_ICONS_RENDER * 2;
+
+	struct job
+	{
+		int             view;
+		void const      *key;
+		image_load_func loader;
+	};
+
+	void run();
+
+	std::mutex                      m_mutex;
+	std::condition_variable         m_condition;
+	std::deque<job>                 m_jobs;         // newest wanted-now requests at the back, prefetches at the front
+	std::vector<result>             m_results;
+	std::unique_ptr<std::thread>    m_thread;
+	bool                            m_exit;
+};
+
 std::string menu_select_launch::reselect_last::s_driver;
 std::string menu_select_launch::reselect_last::s_software;
 std::string menu_select_launch::reselect_last::s_swlist;
@@ -475,6 +519,82 @@ void menu_select_launch::cache::cache_toolbar(running_machine &machine, float wi
 }
 
 
+menu_select_launch::image_loader::image_loader()
+	: m_exit(false)
+{
+}
+
+
+menu_select_launch::image_loader::~image_loader()
+{
+	if (m_thread)
+	{
+		{
+			std::lock_guard<std::mutex> guard(m_mutex);
+			m_exit = true;
+		}
+		m_condition.notify_all();
+		m_thread->join();
+	}
+}
+
+
+void menu_select_launch::image_loader::request(int view, void const *key, image_load_func &&loader, bool prefetch)
+{
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+
+		// the most recent request is what's on screen now, so it's served first
+		if (prefetch)
+			m_jobs.emplace_front(job{ view, key, std::move(loader) });
+		else
+			m_jobs.emplace_back(job{ view, key, std::move(loader) });
+
+		// when scrolling quickly, give up on requests nobody is likely to need
+		while (m_jobs.size() > MAX_PENDING)
+		{
+			m_results.emplace_back(result{ m_jobs.front().view, m_jobs.front().key, false, bitmap_argb32() });
+			m_jobs.pop_front();
+		}
+
+		if (!m_thread)
+			m_thread = std::make_unique<std::thread>([this] () { run(); });
+	}
+	m_condition.notify_one();
+}
+
+
+std::vector<menu_select_launch::image_loader::result> menu_select_launch::image_loader::take_results()
+{
+	std::vector<result> results;
+	std::lock_guard<std::mutex> guard(m_mutex);
+	results.swap(m_results);
+	return results;
+}
+
+
+void menu_select_launch::image_loader::run()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		m_condition.wait(lock, [this] () { return m_exit || !m_jobs.empty(); });
+		if (m_exit)
+			return;
+
+		job current(std::move(m_jobs.back()));
+		m_jobs.pop_back();
+		lock.unlock();
+
+		bitmap_argb32 bitmap;
+		current.loader(bitmap);
+
+		lock.lock();
+		m_results.emplace_back(result{ current.view, current.key, true, std::move(bitmap) });
+	}
+}
+
+
 menu_select_launch::~menu_select_launch()
 {
 }
@@ -504,6 +624,9 @@ menu_select_launch::menu_select_launch(mame_ui_manager &mui, render_container &c
 	, m_default_image(true)
 	, m_image_view(FIRST_VIEW)
 	, m_flags(256)
+	, m_image_loader(std::make_unique<image_loader>())
+	, m_arts(MAX_ARTS_CACHED)
+	, m_prefetching(false)
 {
 	set_needs_prev_menu_item(false);
 	set_process_flags(PROCESS_LR_REPEAT);
@@ -1169,6 +1292,84 @@ bool menu_select_launch::scale_icon(bitmap_argb32 &&src, texture_and_bitmap &dst
 }
 
 
+//-------------------------------------------------
+//  request_icon - decode an icon in the
+//  background; icon_loaded gets the result
+//-------------------------------------------------
+
+void menu_select_launch::request_icon(void const *key, image_load_func &&loader)
+{
+	m_image_loader->request(-1, key, std::move(loader), m_prefetching);
+}
+
+
+//-------------------------------------------------
+//  get_art - get decoded artwork for the current
+//  view, starting a background load if it isn't
+//  cached; returns false while it is pending
+//-------------------------------------------------
+
+bool menu_select_launch::get_art(void const *item, bitmap_argb32 &bitmap, image_load_func &&loader)
+{
+	art_cache::key_type const key(m_image_view, item);
+	art_cache::iterator const found(m_arts.find(key));
+	if (m_arts.end() == found)
+	{
+		m_arts.emplace(key, art_entry());
+		m_image_loader->request(m_image_view, item, std::move(loader), false);
+		return false;
+	}
+	else if (!found->second.ready)
+	{
+		return false;
+	}
+
+	// hand out a copy so the decoded image stays cached
+	bitmap_argb32 const &src(found->second.bitmap);
+	bitmap.reset();
+	if (src.valid())
+	{
+		bitmap.allocate(src.width(), src.height());
+		for (int y = 0; src.height() > y; ++y)
+			std::copy_n(&src.pix(y), src.width(), &bitmap.pix(y));
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  handle_loaded_images - swap in icons and
+//  artwork decoded since the last frame
+//-------------------------------------------------
+
+void menu_select_launch::handle_loaded_images()
+{
+	for (image_loader::result &result : m_image_loader->take_results())
+	{
+		if (0 > result.view)
+		{
+			icon_loaded(result.key, result.loaded ? &result.bitmap : nullptr);
+		}
+		else
+		{
+			art_cache::iterator const found(m_arts.find(art_cache::key_type(result.view, result.key)));
+			if (m_arts.end() != found)
+			{
+				if (result.loaded)
+				{
+					found->second.ready = true;
+					found->second.bitmap = std::move(result.bitmap);
+				}
+				else
+				{
+					m_arts.erase(found);
+				}
+			}
+		}
+	}
+}
+
+
 template <typename T> bool menu_select_launch::select_bios(T const &driver, bool inlist)
 {
 	s_bios biosname;
@@ -1329,6 +1530,26 @@ void menu_select_launch::draw_icon(int linenum, void *selectedref, float x0, flo
 }
 
 
+//-------------------------------------------------
+//  prefetch_icons - queue icons for lines just
+//  outside the visible area behind the visible
+//  ones
+//-------------------------------------------------
+
+void menu_select_launch::prefetch_icons(int first, int count)
+{
+	m_prefetching = true;
+	int const last(std::min(first + count, m_available_items));
+	for (int itemnum = std::max(first, 0); last > itemnum; ++itemnum)
+	{
+		menu_item const &pitem(item(itemnum));
+		if (pitem.ref() && (pitem.type() != menu_item_type::SEPARATOR))
+			get_icon_texture(itemnum - top_line, pitem.ref());
+	}
+	m_prefetching = false;
+}
+
+
 //-------------------------------------------------
 //  get title and search path for right panel
 //-------------------------------------------------
@@ -1882,6 +2103,9 @@ void menu_select_launch::draw(uint32_t flags)
 
 	draw_background();
 
+	// pick up anything decoded in the background since the last frame
+	handle_loaded_images();
+
 	clear_hover();
 	m_available_items = item_count() - skip_main_items;
 	float extra_height = skip_main_items * line_height;
@@ -2083,6 +2307,14 @@ void menu_select_launch::draw(uint32_t flags)
 		}
 	}
 
+	// queue icons for the lines either side so they're ready when scrolled into view
+	if (m_has_icons)
+	{
+		int const ahead((std::min)(m_visible_lines, (int(MAX_ICONS_RENDER) - n_loop) / 2));
+		prefetch_icons(top_line + n_loop, ahead);
+		prefetch_icons(top_line - ahead, ahead);
+	}
+
 	for (size_t count = m_available_items; count < item_count(); count++)
 	{
 		const menu_item &pitem = item(count);
@@ -2305,27 +2537,41 @@ void menu_select_launch::arts_render(float origx1, float origy1, float origx2, f
 		// loads the image if necessary
 		if (!m_cache.snapx_software_is(software) || !snapx_valid() || m_switch_image)
 		{
-			emu_file snapfile(searchstr.c_str(), OPEN_FLAG_READ);
 			bitmap_argb32 tmp_bitmap;
-
-			if (software->startempty == 1)
+			bool const ready = get_art(
+					software,
+					tmp_bitmap,
+					[searchstr, driver = software->driver, startempty = software->startempty, list = software->listname, part = software->driver->name + software->part, shortname = software->shortname] (bitmap_argb32 &bitmap)
+					{
+						emu_file snapfile(searchstr, OPEN_FLAG_READ);
+						if (startempty == 1)
+						{
+							// Load driver snapshot
+							load_driver_image(bitmap, snapfile, *driver);
+						}
+						else
+						{
+							// First attempt from name list
+							load_image(bitmap, snapfile, util::path_concat(list, shortname));
+
+							// Second attempt from driver name + part name
+							if (!bitmap.valid())
+								load_image(bitmap, snapfile, util::path_concat(part, shortname));
+						}
+					});
+
+			if (ready)
 			{
-				// Load driver snapshot
-				load_driver_image(tmp_bitmap, snapfile, *software->driver);
+				m_cache.set_snapx_software(software);
+				m_switch_image = false;
+				arts_render_images(std::move(tmp_bitmap), origx1, origy1, origx2, origy2);
 			}
 			else
 			{
-				// First attempt from name list
-				load_image(tmp_bitmap, snapfile, util::path_concat(software->listname, software->shortname));
-
-				// Second attempt from driver name + part name
-				if (!tmp_bitmap.valid())
-					load_image(tmp_bitmap, snapfile, util::path_concat(software->driver->name + software->part, software->shortname));
+				// leave the panel empty until it has been decoded
+				m_cache.set_snapx_software(nullptr);
+				m_cache.snapx_bitmap().reset();
 			}
-
-			m_cache.set_snapx_software(software);
-			m_switch_image = false;
-			arts_render_images(std::move(tmp_bitmap), origx1, origy1, origx2, origy2);
 		}
 
 		// if the image is available, loaded and valid, display it
@@ -2343,13 +2589,28 @@ void menu_select_launch::arts_render(float origx1, float origy1, float origx2, f
 		// loads the image if necessary
 		if (!m_cache.snapx_driver_is(system->driver) || !snapx_valid() || m_switch_image)
 		{
-			emu_file snapfile(searchstr, OPEN_FLAG_READ);
 			bitmap_argb32 tmp_bitmap;
-			load_driver_image(tmp_bitmap, snapfile, *system->driver);
+			bool const ready = get_art(
+					system->driver,
+					tmp_bitmap,
+					[searchstr, driver = system->driver] (bitmap_argb32 &bitmap)
+					{
+						emu_file snapfile(searchstr, OPEN_FLAG_READ);
+						load_driver_image(bitmap, snapfile, *driver);
+					});
 
-			m_cache.set_snapx_driver(system->driver);
-			m_switch_image = false;
-			arts_render_images(std::move(tmp_bitmap), origx1, origy1, origx2, origy2);
+			if (ready)
+			{
+				m_cache.set_snapx_driver(system->driver);
+				m_switch_image = false;
+				arts_render_images(std::move(tmp_bitmap), origx1, origy1, origx2, origy2);
+			}
+			else
+			{
+				// leave the panel empty until it has been decoded
+				m_cache.set_snapx_driver(nullptr);
+				m_cache.snapx_bitmap().reset();
+			}
 		}
 
 		// if the image is available, loaded and valid, display it
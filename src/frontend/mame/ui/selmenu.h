@@ -18,9 +18,11 @@
 
 #include "lrucache.h"
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 
@@ -41,6 +43,7 @@ public:
 protected:
 	static constexpr std::size_t MAX_ICONS_RENDER = 128;
 	static constexpr std::size_t MAX_VISIBLE_SEARCH = 200;
+	static constexpr std::size_t MAX_ARTS_CACHED = 16;
 
 	// tab navigation
 	enum class focused_menu
@@ -145,9 +148,11 @@ protected:
 			float x1, float y1, float x2, float y2);
 
 	// icon helpers
+	using image_load_func = std::function<void (bitmap_argb32 &)>;
 	void check_for_icons(char const *listname);
 	std::string make_icon_paths(char const *listname) const;
 	bool scale_icon(bitmap_argb32 &&src, texture_and_bitmap &dst) const;
+	void request_icon(void const *key, image_load_func &&loader);
 
 	// forcing refresh
 	void set_switch_image() { m_switch_image = true; }
@@ -185,6 +190,15 @@ private:
 
 	class software_parts;
 	class bios_selection;
+	class image_loader;
+
+	// decoded artwork by view and item, waiting to be scaled for the right panel
+	struct art_entry
+	{
+		bool            ready = false;
+		bitmap_argb32   bitmap;
+	};
+	using art_cache = util::lru_cache_map<std::pair<int, void const *>, art_entry>;
 
 	class cache
 	{
@@ -270,7 +284,13 @@ private:
 	void draw_toolbar(float x1, float y1, float x2, float y2);
 	void draw_star(float x0, float y0);
 	void draw_icon(int linenum, void *selectedref, float x1, float y1);
+	void prefetch_icons(int first, int count);
 	virtual render_texture *get_icon_texture(int linenum, void *selectedref) = 0;
+	virtual void icon_loaded(void const *key, bitmap_argb32 *bitmap) = 0;
+
+	// background image loading
+	bool get_art(void const *item, bitmap_argb32 &bitmap, image_load_func &&loader);
+	void handle_loaded_images();
 
 	void get_title_search(std::string &title, std::string &search);
 
@@ -327,6 +347,10 @@ private:
 	bool                    m_default_image;
 	uint8_t                 m_image_view;
 	flags_cache             m_flags;
+
+	std::unique_ptr<image_loader>   m_image_loader;     // decodes icons and artwork off the UI thread
+	art_cache               m_arts;
+	bool                    m_prefetching;          // icon requests are for lines scrolled out of view
 };
 
 } // namespace ui
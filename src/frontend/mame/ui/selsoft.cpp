@@ -670,26 +670,48 @@ render_texture *menu_select_software::get_icon_texture(int linenum, void *select
 			icon->second.texture.reset(machine().render().texture_alloc());
 		}
 
-		bitmap_argb32 tmp;
-		emu_file snapfile(std::string(paths->second), OPEN_FLAG_READ);
-		if (!snapfile.open(std::string(swinfo->shortname) + ".ico"))
-		{
-			render_load_ico_highest_detail(snapfile, tmp);
-			snapfile.close();
-		}
-		if (!tmp.valid() && !swinfo->parentname.empty() && !snapfile.open(std::string(swinfo->parentname) + ".ico"))
-		{
-			render_load_ico_highest_detail(snapfile, tmp);
-			snapfile.close();
-		}
-
-		scale_icon(std::move(tmp), icon->second);
+		// decode it in the background and show nothing until it arrives
+		request_icon(
+				swinfo,
+				[paths = paths->second, name = swinfo->shortname, parent = swinfo->parentname] (bitmap_argb32 &bitmap)
+				{
+					emu_file snapfile(std::string(paths), OPEN_FLAG_READ);
+					if (!snapfile.open(name + ".ico"))
+					{
+						render_load_ico_highest_detail(snapfile, bitmap);
+						snapfile.close();
+					}
+					if (!bitmap.valid() && !parent.empty() && !snapfile.open(parent + ".ico"))
+					{
+						render_load_ico_highest_detail(snapfile, bitmap);
+						snapfile.close();
+					}
+				});
+		icon->second.bitmap.reset();
 	}
 
 	return icon->second.bitmap.valid() ? icon->second.texture.get() : nullptr;
 }
 
 
+//-------------------------------------------------
+//  icon_loaded - an icon has been decoded
+//-------------------------------------------------
+
+void menu_select_software::icon_loaded(void const *key, bitmap_argb32 *bitmap)
+{
+	icon_cache::iterator const icon(m_data->icons().find(reinterpret_cast<ui_software_info const *>(key)));
+	if (m_data->icons().end() == icon)
+		return;
+
+	// a dropped request is forgotten so the icon is asked for again when it's next needed
+	if (!bitmap)
+		m_data->icons().erase(icon);
+	else if (icon->second.texture)
+		scale_icon(std::move(*bitmap), icon->second);
+}
+
+
 //-------------------------------------------------
 //  get selected software and/or driver
 //-------------------------------------------------
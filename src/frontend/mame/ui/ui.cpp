@@ -203,8 +203,10 @@ void mame_ui_manager::init()
 {
 	load_ui_options();
 
-	// start loading system names as early as possible
-	ui::system_list::instance().cache_data(options());
+	// start loading system names as early as possible if we're going to show the system selection menu,
+	// otherwise they'll be loaded the first time something needs them
+	if (&machine().system() == &GAME_NAME(___empty))
+		ui::system_list::instance().cache_data(options());
 
 	// initialize the other UI bits
 	m_ui_colors.refresh(options());
@@ -664,7 +666,7 @@ void mame_ui_manager::update_and_render(render_container &container)
 	}
 
 	// render any cheat stuff at the bottom
-	if (machine().phase() >= machine_phase::RESET)
+	if ((machine().phase() >= machine_phase::RESET) && machine().options().cheat())
 		mame_machine_manager::instance()->cheat().render_text(*this, container);
 
 	// call the current UI handler
@@ -47,7 +47,7 @@ void floppy_image::get_actual_geometry(int &_tracks, int &_heads)
 
 	while(maxt >= 0) {
 		for(int i=0; i<=maxh; i++)
-			if(!track_array[maxt][i].cell_data.empty())
+			if(!track_array[maxt][i].cell_data.empty() || track_array[maxt][i].pending)
 				goto track_done;
 		maxt--;
 	}
@@ -55,7 +55,7 @@ void floppy_image::get_actual_geometry(int &_tracks, int &_heads)
 	if(maxt >= 0)
 		while(maxh >= 0) {
 			for(int i=0; i<=maxt; i++)
-				if(!track_array[i][maxh].cell_data.empty())
+				if(!track_array[i][maxh].cell_data.empty() || track_array[i][maxh].pending)
 					goto head_done;
 			maxh--;
 		}
@@ -72,7 +72,7 @@ int floppy_image::get_resolution() const
 	int mask = 0;
 	for(int i=0; i<=(tracks-1)*4; i++)
 		for(int j=0; j<heads; j++)
-			if(!track_array[i][j].cell_data.empty())
+			if(!track_array[i][j].cell_data.empty() || track_array[i][j].pending)
 				mask |= 1 << (i & 3);
 	if(mask & 0xa)
 		return 2;
@@ -88,6 +88,8 @@ bool floppy_image::track_is_formatted(int track, int head, int subtrack)
 		return false;
 	if(int(track_array[idx].size()) <= head)
 		return false;
+	if(track_array[idx][head].pending)
+		return true; // sector images only describe formatted tracks
 	const auto &data = track_array[idx][head].cell_data;
 	if(data.empty())
 		return false;
@@ -97,6 +99,22 @@ bool floppy_image::track_is_formatted(int track, int head, int subtrack)
 	return false;
 }
 
+void floppy_image::set_track_source(std::unique_ptr<track_source> &&_source, int _tracks, int _heads)
+{
+	assert(_tracks <= tracks && _heads <= heads);
+	source = std::move(_source);
+	for(int track=0; track < tracks; track++)
+		for(int head=0; head < heads; head++)
+			track_array[track*4][head].pending = source && track < _tracks && head < _heads;
+}
+
+void floppy_image::generate_pending(int track, int head)
+{
+	// clear the flag first, as generating the track gets its buffer
+	track_array[track*4][head].pending = false;
+	source->generate(*this, track, head);
+}
+
 const char *floppy_image::get_variant_name(uint32_t form_factor, uint32_t variant)
 {
 	switch(variant) {
@@ -542,6 +542,18 @@ public:
 		M2FM = 0x4D32464D  //!< "M2FM", modified modified frequency modulation
 	};
 
+	//! Source of track data that is only generated the first time a
+	//! track is accessed.  Formats for sector images can install one
+	//! instead of converting every track when the image is loaded.
+	class track_source
+	{
+	public:
+		virtual ~track_source() = default;
+
+		//! Generate the data for a whole track into the image.
+		virtual void generate(floppy_image &image, int track, int head) const = 0;
+	};
+
 	// construction/destruction
 
 
@@ -569,7 +581,25 @@ public:
 	  @param head head number
 	  @return a pointer to the data buffer for this track and head
 	*/
-	std::vector<uint32_t> &get_buffer(int track, int head, int subtrack = 0) { assert(track < tracks && head < heads); return track_array[track*4+subtrack][head].cell_data; }
+	std::vector<uint32_t> &get_buffer(int track, int head, int subtrack = 0) {
+		assert(track < tracks && head < heads);
+		track_info &info = track_array[track*4+subtrack][head];
+		if(info.pending)
+			generate_pending(track, head);
+		return info.cell_data;
+	}
+
+	//! Defers generating whole tracks up to the given geometry to a source.
+	//! Each track is generated the first time its buffer is requested.
+	/*! @param source the source
+	    @param tracks number of tracks the source provides
+	    @param heads number of heads the source provides
+	*/
+	void set_track_source(std::unique_ptr<track_source> &&source, int tracks, int heads);
+	//! @return the source for tracks not generated yet, if any.
+	const track_source *get_track_source() const { return source.get(); }
+	//! @return whether a track has not been generated from the source yet.
+	bool track_is_pending(int track, int head, int subtrack = 0) const { assert(track < tracks && head < heads); return track_array[track*4+subtrack][head].pending; }
 
 	//! Sets the write splice position.
 	//! The "track splice" information indicates where to start writing
@@ -613,13 +643,19 @@ private:
 	{
 		std::vector<uint32_t> cell_data;
 		uint32_t write_splice;
+		bool pending;
 
-		track_info() { write_splice = 0; }
+		track_info() { write_splice = 0; pending = false; }
 	};
 
 	// track number multiplied by 4 then head
 	// last array size may be bigger than actual track size
 	std::vector<std::vector<track_info> > track_array;
+
+	// generates pending tracks on first access
+	std::unique_ptr<track_source> source;
+
+	void generate_pending(int track, int head);
 };
 
 #endif // MAME_FORMATS_FLOPIMG_H
@@ -14,7 +14,9 @@
 
 #include "osdcore.h" // osd_printf_*
 
+#include <algorithm>
 #include <cstring>
+#include <memory>
 
 
 upd765_format::upd765_format(const format *_formats) : formats(_formats)
@@ -184,6 +186,27 @@ floppy_image_format_t::desc_e* upd765_format::get_desc_mfm(const format &f, int
 	return desc;
 }
 
+// Keeps the sector data of a loaded image, and generates tracks from it
+// as they are accessed
+class upd765_format::image_source : public floppy_image::track_source
+{
+public:
+	image_source(const upd765_format &fmt, int type, std::vector<uint8_t> &&data) : m_format(fmt), m_type(type), m_data(std::move(data)) { }
+
+	virtual void generate(floppy_image &image, int track, int head) const override
+	{
+		m_format.generate_track_from_data(m_format.formats[m_type], &m_data[0], track, head, &image);
+	}
+
+	bool is_from(const upd765_format &fmt, int type) const { return (&fmt == &m_format) && (type == m_type); }
+	const uint8_t *data() const { return &m_data[0]; }
+
+private:
+	const upd765_format &m_format;
+	const int m_type;
+	const std::vector<uint8_t> m_data;
+};
+
 bool upd765_format::load(util::random_read &io, uint32_t form_factor, const std::vector<uint32_t> &variants, floppy_image *image) const
 {
 	int type = find_size(io, form_factor, variants);
@@ -197,6 +220,42 @@ bool upd765_format::load(util::random_read &io, uint32_t form_factor, const std:
 	if (f.track_count > img_tracks || f.head_count > img_heads)
 		return false;
 
+	// check the track layout fits before deferring anything
+	int current_size;
+	int end_gap_index;
+	switch(f.encoding) {
+	case floppy_image::FM:
+		get_desc_fm(f, current_size, end_gap_index);
+		break;
+	case floppy_image::MFM:
+	default:
+		get_desc_mfm(f, current_size, end_gap_index);
+		break;
+	}
+
+	int total_size = 200000000/f.cell_size;
+	int remaining_size = total_size - current_size;
+	if(remaining_size < 0) {
+		osd_printf_error("upd765_format: Incorrect track layout, max_size=%d, current_size=%d\n", total_size, current_size);
+		return false;
+	}
+
+	// read the sector data now, but only generate tracks when they're accessed
+	int track_size = compute_track_size(f);
+	std::vector<uint8_t> data;
+	try { data.resize(size_t(track_size) * f.track_count * f.head_count, 0); }
+	catch(...) { return false; }
+	size_t actual;
+	io.read_at(0, &data[0], data.size(), actual);
+	image->set_track_source(std::make_unique<image_source>(*this, type, std::move(data)), f.track_count, f.head_count);
+
+	image->set_form_variant(f.form_factor, f.variant);
+
+	return true;
+}
+
+bool upd765_format::generate_track_from_data(const format &f, const uint8_t *data, int track, int head, floppy_image *image) const
+{
 	floppy_image_format_t::desc_e *desc;
 	int current_size;
 	int end_gap_index;
@@ -213,10 +272,8 @@ bool upd765_format::load(util::random_read &io, uint32_t form_factor, const std:
 
 	int total_size = 200000000/f.cell_size;
 	int remaining_size = total_size - current_size;
-	if(remaining_size < 0) {
-		osd_printf_error("upd765_format: Incorrect track layout, max_size=%d, current_size=%d\n", total_size, current_size);
+	if(remaining_size < 0)
 		return false;
-	}
 
 	// Fixup the end gap
 	desc[end_gap_index].p2 = remaining_size / 16;
@@ -228,15 +285,9 @@ bool upd765_format::load(util::random_read &io, uint32_t form_factor, const std:
 	uint8_t sectdata[40*512];
 	desc_s sectors[40];
 
-	for(int track=0; track < f.track_count; track++)
-		for(int head=0; head < f.head_count; head++) {
-			build_sector_description(f, sectdata, sectors, track, head);
-			size_t actual;
-			io.read_at((track*f.head_count + head)*track_size, sectdata, track_size, actual);
-			generate_track(desc, track, head, sectors, f.sector_count, total_size, image);
-		}
-
-	image->set_form_variant(f.form_factor, f.variant);
+	build_sector_description(f, sectdata, sectors, track, head);
+	std::copy_n(&data[(track*f.head_count + head)*track_size], track_size, sectdata);
+	generate_track(desc, track, head, sectors, f.sector_count, total_size, image);
 
 	return true;
 }
@@ -349,15 +400,24 @@ bool upd765_format::save(util::random_read_write &io, const std::vector<uint32_t
 	const format &f = formats[chosen_candidate];
 	int track_size = compute_track_size(f);
 
+	// tracks never accessed since loading can be written straight from the sector data
+	const image_source *const source = dynamic_cast<const image_source *>(image->get_track_source());
+	bool const unchanged = source && source->is_from(*this, chosen_candidate);
+
 	uint8_t sectdata[40*512];
 	desc_s sectors[40];
 
 	for(int track=0; track < f.track_count; track++)
 		for(int head=0; head < f.head_count; head++) {
+			int const offset = (track*f.head_count + head)*track_size;
+			size_t actual;
+			if(unchanged && image->track_is_pending(track, head)) {
+				io.write_at(offset, source->data() + offset, track_size, actual);
+				continue;
+			}
 			build_sector_description(f, sectdata, sectors, track, head);
 			extract_sectors(image, f, sectors, track, head);
-			size_t actual;
-			io.write_at((track*f.head_count + head)*track_size, sectdata, track_size, actual);
+			io.write_at(offset, sectdata, track_size, actual);
 		}
 
 	return true;
@@ -52,8 +52,11 @@ protected:
 	virtual void build_sector_description(const format &d, uint8_t *sectdata, desc_s *sectors, int track, int head) const;
 	void check_compatibility(floppy_image *image, std::vector<int> &candidates) const;
 	void extract_sectors(floppy_image *image, const format &f, desc_s *sdesc, int track, int head) const;
+	bool generate_track_from_data(const format &f, const uint8_t *data, int track, int head, floppy_image *image) const;
 
 private:
+	class image_source;
+
 	format const *const formats;
 };
 
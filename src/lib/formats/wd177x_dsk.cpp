@@ -14,7 +14,9 @@
 
 #include "osdcore.h" // osd_printf_*
 
+#include <algorithm>
 #include <cstring>
+#include <memory>
 
 
 wd177x_format::wd177x_format(const format *_formats)
@@ -208,6 +210,28 @@ floppy_image_format_t::desc_e* wd177x_format::get_desc_mfm(const format &f, int
 	return desc;
 }
 
+// Keeps the sector data of a loaded image, and generates tracks from it
+// as they are accessed
+class wd177x_format::image_source : public floppy_image::track_source
+{
+public:
+	image_source(const wd177x_format &fmt, int type, std::vector<uint8_t> &&data) : m_format(fmt), m_type(type), m_data(std::move(data)) { }
+
+	virtual void generate(floppy_image &image, int track, int head) const override
+	{
+		m_format.generate_track_from_data(m_format.formats[m_type], &m_data[0], track, head, &image);
+	}
+
+	bool is_from(const wd177x_format &fmt, int type) const { return (&fmt == &m_format) && (type == m_type); }
+	const uint8_t *data() const { return &m_data[0]; }
+	size_t size() const { return m_data.size(); }
+
+private:
+	const wd177x_format &m_format;
+	const int m_type;
+	const std::vector<uint8_t> m_data;
+};
+
 bool wd177x_format::load(util::random_read &io, uint32_t form_factor, const std::vector<uint32_t> &variants, floppy_image *image) const
 {
 	int const type = find_size(io, form_factor, variants);
@@ -223,11 +247,10 @@ bool wd177x_format::load(util::random_read &io, uint32_t form_factor, const std:
 		return false;
 	}
 
+	// check every track layout fits before deferring anything
+	size_t image_size = 0;
 	for(int track=0; track < f.track_count; track++)
 		for(int head=0; head < f.head_count; head++) {
-			uint8_t sectdata[40*512];
-			desc_s sectors[40];
-			floppy_image_format_t::desc_e *desc;
 			int current_size;
 			int end_gap_index;
 			const format &tf = get_track_format(f, head, track);
@@ -235,11 +258,11 @@ bool wd177x_format::load(util::random_read &io, uint32_t form_factor, const std:
 			switch (tf.encoding)
 			{
 			case floppy_image::FM:
-				desc = get_desc_fm(tf, current_size, end_gap_index);
+				get_desc_fm(tf, current_size, end_gap_index);
 				break;
 			case floppy_image::MFM:
 			default:
-				desc = get_desc_mfm(tf, current_size, end_gap_index);
+				get_desc_mfm(tf, current_size, end_gap_index);
 				break;
 			}
 
@@ -250,28 +273,65 @@ bool wd177x_format::load(util::random_read &io, uint32_t form_factor, const std:
 				return false;
 			}
 
-			// Fixup the end gap
-			desc[end_gap_index].p2 = remaining_size / 16;
-			desc[end_gap_index + 1].p2 = remaining_size & 15;
-			desc[end_gap_index + 1].p1 >>= 16-(remaining_size & 15);
-
-			if (tf.encoding == floppy_image::FM)
-				desc[14].p1 = get_track_dam_fm(tf, head, track);
-			else
-				desc[16].p1 = get_track_dam_mfm(tf, head, track);
-
-			build_sector_description(tf, sectdata, sectors, track, head);
-			int track_size = compute_track_size(tf);
-			size_t actual;
-			io.read_at(get_image_offset(f, head, track), sectdata, track_size, actual);
-			generate_track(desc, track, head, sectors, tf.sector_count, total_size, image);
+			image_size = std::max<size_t>(image_size, get_image_offset(f, head, track) + compute_track_size(tf));
 		}
 
+	// read the sector data now, but only generate tracks when they're accessed
+	std::vector<uint8_t> data;
+	try { data.resize(image_size, 0); }
+	catch(...) { return false; }
+	size_t actual;
+	io.read_at(0, &data[0], data.size(), actual);
+	image->set_track_source(std::make_unique<image_source>(*this, type, std::move(data)), f.track_count, f.head_count);
+
 	image->set_form_variant(f.form_factor, f.variant);
 
 	return true;
 }
 
+bool wd177x_format::generate_track_from_data(const format &f, const uint8_t *data, int track, int head, floppy_image *image) const
+{
+	uint8_t sectdata[40*512];
+	desc_s sectors[40];
+	floppy_image_format_t::desc_e *desc;
+	int current_size;
+	int end_gap_index;
+	const format &tf = get_track_format(f, head, track);
+
+	switch (tf.encoding)
+	{
+	case floppy_image::FM:
+		desc = get_desc_fm(tf, current_size, end_gap_index);
+		break;
+	case floppy_image::MFM:
+	default:
+		desc = get_desc_mfm(tf, current_size, end_gap_index);
+		break;
+	}
+
+	int total_size = 200000000/tf.cell_size;
+	int remaining_size = total_size - current_size;
+	if(remaining_size < 0)
+		return false;
+
+	// Fixup the end gap
+	desc[end_gap_index].p2 = remaining_size / 16;
+	desc[end_gap_index + 1].p2 = remaining_size & 15;
+	desc[end_gap_index + 1].p1 >>= 16-(remaining_size & 15);
+
+	if (tf.encoding == floppy_image::FM)
+		desc[14].p1 = get_track_dam_fm(tf, head, track);
+	else
+		desc[16].p1 = get_track_dam_mfm(tf, head, track);
+
+	build_sector_description(tf, sectdata, sectors, track, head);
+	int track_size = compute_track_size(tf);
+	std::copy_n(&data[get_image_offset(f, head, track)], track_size, sectdata);
+	generate_track(desc, track, head, sectors, tf.sector_count, total_size, image);
+
+	return true;
+}
+
 bool wd177x_format::supports_save() const
 {
 	return true;
@@ -380,17 +440,26 @@ bool wd177x_format::save(util::random_read_write &io, const std::vector<uint32_t
 
 	const format &f = formats[chosen_candidate];
 
+	// tracks never accessed since loading can be written straight from the sector data
+	const image_source *const source = dynamic_cast<const image_source *>(image->get_track_source());
+	bool const unchanged = source && source->is_from(*this, chosen_candidate);
+
 	uint8_t sectdata[40*512];
 	desc_s sectors[40];
 
 	for(int track=0; track < f.track_count; track++) {
 		for(int head=0; head < f.head_count; head++) {
 			const format &tf = get_track_format(f, head, track);
-			build_sector_description(tf, sectdata, sectors, track, head);
-			extract_sectors(image, tf, sectors, track, head);
+			int const offset = get_image_offset(f, head, track);
 			int track_size = compute_track_size(tf);
 			size_t actual;
-			io.write_at(get_image_offset(f, head, track), sectdata, track_size, actual);
+			if(unchanged && image->track_is_pending(track, head) && (source->size() >= size_t(offset + track_size))) {
+				io.write_at(offset, source->data() + offset, track_size, actual);
+				continue;
+			}
+			build_sector_description(tf, sectdata, sectors, track, head);
+			extract_sectors(image, tf, sectors, track, head);
+			io.write_at(offset, sectdata, track_size, actual);
 		}
 	}
 
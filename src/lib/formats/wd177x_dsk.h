@@ -60,6 +60,10 @@ protected:
 	virtual void build_sector_description(const format &d, uint8_t *sectdata, desc_s *sectors, int track, int head) const;
 	virtual void check_compatibility(floppy_image *image, std::vector<int> &candidates) const;
 	static void extract_sectors(floppy_image *image, const format &f, desc_s *sdesc, int track, int head);
+	bool generate_track_from_data(const format &f, const uint8_t *data, int track, int head, floppy_image *image) const;
+
+private:
+	class image_source;
 };
 
 #endif // MAME_FORMATS_WD177X_DSK_H
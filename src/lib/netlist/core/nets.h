@@ -194,7 +194,7 @@ namespace netlist
 		inline void net_t::push_to_queue(const netlist_time &delay) noexcept
 		{
 			if (is_queued())
-				exec().queue_remove(this);
+				exec().queue_remove(detail::queue_t::entry_t(m_next_scheduled_time, this));
 
 			m_next_scheduled_time = exec().time() + delay;
 			if constexpr (config::avoid_noop_queue_pushes::value)
@@ -310,7 +310,7 @@ namespace netlist
 					// the if statement in and enabled it for all code paths
 					if (is_queued())
 					{
-						exec().queue_remove(this);
+						exec().queue_remove(detail::queue_t::entry_t(m_next_scheduled_time, this));
 						m_in_queue = queue_status::DELAYED_DUE_TO_INACTIVE;
 					}
 				}
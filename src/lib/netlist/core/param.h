@@ -325,6 +325,7 @@ namespace netlist
 	param_rom_t<ST, AW, DW>::param_rom_t(core_device_t &device,
 		const pstring &                                 name)
 	: param_data_t(device, name)
+	, m_data()
 	{
 		auto f = this->stream();
 		if (!f.empty())
@@ -51,6 +51,19 @@
 	#define NL_USE_ACADEMIC_SOLVERS (1)
 #endif
 
+/// \brief  Solve independent matrix solvers on worker threads
+///
+/// Set to 0 for targets without thread support. The Solver.PARALLEL
+/// parameter is ignored in this case.
+///
+#ifndef NL_USE_SOLVER_THREADS
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+	#define NL_USE_SOLVER_THREADS (0)
+#else
+	#define NL_USE_SOLVER_THREADS (1)
+#endif
+#endif
+
 /// \brief Use backward Euler integration
 ///
 /// This will use backward Euler instead of trapezoidal integration.
@@ -203,6 +216,21 @@ namespace netlist
 		using max_solver_queue_size = std::integral_constant<std::size_t,
 															 512>; // NOLINT
 
+		/// \brief Minimum estimated cost for a solver to run on a worker thread
+		///
+		/// The estimate is the number of multiplications and additions of one
+		/// solve, multiplied for solvers doing Newton-Raphson iterations.
+		/// Cheaper solvers are always solved on the netlist thread since
+		/// handing them over costs more than solving them.
+		///
+		using parallel_solver_min_ops = std::integral_constant<std::size_t,
+															   256>; // NOLINT
+
+		/// \brief Maximum number of threads used for automatic parallel solving
+		///
+		using parallel_solver_max_threads = std::integral_constant<std::size_t,
+																   4>; // NOLINT
+
 		/// \brief Support float type for matrix calculations.
 		///
 		/// Defaults to NL_USE_ACADEMIC_SOLVERS to provide faster build times
@@ -259,11 +287,18 @@ namespace netlist
 		/// linear processing queue. This slows down execution by about 35%
 		/// on a Kaby Lake.
 		///
+		/// Use timed_queue_wheel for a timing wheel, which doesn't slow down
+		/// with the number of pending events. Use `nltool -c queue-bench` to
+		/// compare the queues.
+		///
 		/// The default is the  linear queue.
 
 		// template <class A, class T>
 		// using timed_queue = plib::timed_queue_heap<A, T>;
 
+		// template <class A, class T>
+		// using timed_queue = plib::timed_queue_wheel<A, T>;
+
 		template <typename A, typename T>
 		using timed_queue = plib::timed_queue_linear<A, T>;
 	};
@@ -1,18 +1,26 @@
 #!/bin/sh
 
-GENERATED=src/lib/netlist/generated/static_solvers.cpp
-FILES=`find src/mame -name "nl_*.cpp" | grep -v pongdoubles`
+# Regenerate the precompiled static solvers for all MAME netlists.
+#
+# Must be run from the MAME root directory. The nltool binary to use can be
+# given in NLTOOL, e.g. NLTOOL=src/lib/netlist/build/nltool.
 
-OUTDIR=/tmp/static_syms
+GENERATED=src/lib/netlist/generated/static_solvers.cpp
 
-if [ _$OS = "_Windows_NT" ]; then
-	NLTOOL=./nltool.exe
-else
-	NLTOOL=./nltool
+if [ ! -d src/mame ] || [ ! -f ${GENERATED} ]; then
+	echo "$0: must be run from the MAME root directory" >&2
+	exit 1
 fi
 
-rm -rf ${OUTDIR}
-mkdir ${OUTDIR}
+FILES=`find src/mame -name "nl_*.cpp" | grep -v pongdoubles | sort`
+
+if [ -z "${NLTOOL}" ]; then
+	if [ _$OS = "_Windows_NT" ]; then
+		NLTOOL=./nltool.exe
+	else
+		NLTOOL=./nltool
+	fi
+fi
 
 #--dir src/lib/netlist/generated/static --static-include
 
@@ -20,5 +28,7 @@ if ${NLTOOL} --cmd static --output=${GENERATED}.tmp --include=src/mame/audio ${F
 	mv -f ${GENERATED}.tmp ${GENERATED}
 	echo Created ${GENERATED} file
 else
-	echo Failed to create ${GENERATED}
+	rm -f ${GENERATED}.tmp
+	echo Failed to create ${GENERATED} >&2
+	exit 1
 fi
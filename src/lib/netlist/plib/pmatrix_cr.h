@@ -19,6 +19,7 @@
 #include "pomp.h"
 #include "ptypes.h"
 #include "putil.h"              // <- container::contains
+#include "vector_ops.h"
 
 #include <algorithm>
 #include <array>
@@ -325,13 +326,18 @@ namespace plib
 					// subtract row i from j
 					// fill-in available assumed, i.e. matrix was prepared
 
-					for (std::size_t pii = pi; pii<piie && pj < pje; pii++)
-					{
-						while (base_type::col_idx[pj] < base_type::col_idx[pii])
-							pj++;
-						if (base_type::col_idx[pj] == base_type::col_idx[pii])
-							base_type::A[pj++] += base_type::A[pii] * f1;
-					}
+					// fill-in makes row j a superset of row i right of column i,
+					// so equal lengths mean the same columns and a plain axpy
+					if (pje - pj == piie - pi)
+						vec_add_mult_scalar_p(piie - pi, &base_type::A[pj], &base_type::A[pi], f1);
+					else
+						for (std::size_t pii = pi; pii<piie && pj < pje; pii++)
+						{
+							while (base_type::col_idx[pj] < base_type::col_idx[pii])
+								pj++;
+							if (base_type::col_idx[pj] == base_type::col_idx[pii])
+								base_type::A[pj++] += base_type::A[pii] * f1;
+						}
 
 					RHS[j] += f1 * RHS[i];
 				}
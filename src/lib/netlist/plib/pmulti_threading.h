@@ -13,9 +13,12 @@
 #include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
+#include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace plib {
 
@@ -83,6 +86,149 @@ namespace plib {
 		long m_count;
 	};
 
+	/// \brief Worker threads for short, fine grained parallel loops
+	///
+	/// The calling thread takes part in the work and returns once all
+	/// items are done. Work is claimed item by item, so a loop never waits
+	/// for a worker which isn't running: the caller simply does the work
+	/// itself. Idle workers spin for a while before going to sleep so loops
+	/// issued in quick succession, e.g. every time step, don't pay for
+	/// waking up threads.
+	///
+	class pworker_pool
+	{
+	public:
+		explicit pworker_pool(std::size_t workers)
+		{
+			for (std::size_t i = 0; i < workers; i++)
+				m_threads.emplace_back([this]() { worker_loop(); });
+		}
+
+		pworker_pool(const pworker_pool &) = delete;
+		pworker_pool &operator=(const pworker_pool &) = delete;
+		pworker_pool(pworker_pool &&) = delete;
+		pworker_pool &operator=(pworker_pool &&) = delete;
+
+		~pworker_pool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stop.store(true);
+				m_cv.notify_all();
+			}
+			for (auto &t : m_threads)
+				t.join();
+		}
+
+		std::size_t workers() const noexcept { return m_threads.size(); }
+
+		static std::size_t hardware_threads() noexcept
+		{
+			return std::max(std::size_t(1), std::size_t(std::thread::hardware_concurrency()));
+		}
+
+		/// \brief Call f(i) for i in [0, count) and wait until all are done
+		///
+		/// Must only be called from one thread at a time.
+		///
+		template <typename F>
+		void for_each(std::size_t count, F &f)
+		{
+			if (count < 2 || count > MAX_COUNT || m_threads.empty())
+			{
+				for (std::size_t i = 0; i < count; i++)
+					f(i);
+				return;
+			}
+			m_func = [](void *ctx, std::size_t i) { (*static_cast<F *>(ctx))(i); };
+			m_ctx = &f;
+			m_done.store(0, std::memory_order_relaxed);
+			m_generation++;
+			m_work.store((m_generation << GEN_SHIFT) | (std::uint64_t(count) << COUNT_SHIFT));
+			if (m_sleeping.load() > 0)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_cv.notify_all();
+			}
+			while (claim_and_run())
+				{ }
+			// a worker may have been preempted while working on an item
+			for (std::size_t spins = 0; m_done.load(std::memory_order_acquire) != count; spins++)
+				if (spins >= SPIN_COUNT)
+					std::this_thread::yield();
+		}
+
+	private:
+		static constexpr const std::size_t SPIN_COUNT = 4096;
+		static constexpr const std::size_t YIELD_COUNT = 256;
+
+		// m_work packs generation, item count and next item
+		static constexpr const unsigned COUNT_SHIFT = 16;
+		static constexpr const unsigned GEN_SHIFT = 32;
+		static constexpr const std::uint64_t FIELD_MASK = 0xffff;
+		static constexpr const std::size_t MAX_COUNT = FIELD_MASK;
+
+		static bool has_work(std::uint64_t w) noexcept
+		{
+			return (w & FIELD_MASK) < ((w >> COUNT_SHIFT) & FIELD_MASK);
+		}
+
+		// A successful claim belongs to the loop currently running: the
+		// caller can't start another one before the claimed item is done.
+		bool claim_and_run()
+		{
+			std::uint64_t w = m_work.load(std::memory_order_acquire);
+			while (has_work(w))
+			{
+				if (m_work.compare_exchange_weak(w, w + 1, std::memory_order_acq_rel))
+				{
+					m_func(m_ctx, static_cast<std::size_t>(w & FIELD_MASK));
+					m_done.fetch_add(1, std::memory_order_release);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void worker_loop()
+		{
+			std::size_t spins = 0;
+			while (!m_stop.load(std::memory_order_relaxed))
+			{
+				if (claim_and_run())
+				{
+					spins = 0;
+					continue;
+				}
+				if (++spins < SPIN_COUNT)
+					continue;
+				if (spins < SPIN_COUNT + YIELD_COUNT)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_sleeping.fetch_add(1);
+				m_cv.wait(lock, [this]() { return has_work(m_work.load()) || m_stop.load(); });
+				m_sleeping.fetch_sub(1);
+				spins = 0;
+			}
+		}
+
+		std::vector<std::thread> m_threads;
+		void (*m_func)(void *, std::size_t) = nullptr;
+		void *m_ctx = nullptr;
+		std::uint64_t m_generation = 0;
+
+		PALIGNAS_CACHELINE()
+		std::atomic<std::uint64_t> m_work = 0;
+		PALIGNAS_CACHELINE()
+		std::atomic<std::size_t> m_done = 0;
+		std::atomic<std::size_t> m_sleeping = 0;
+		std::atomic<bool> m_stop = false;
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+	};
 
 } // namespace plib
 
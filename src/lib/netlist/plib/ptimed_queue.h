@@ -352,6 +352,257 @@ namespace plib {
 		pperfcount_t<true> m_prof_remove; // NOLINT
 	};
 
+	/// \brief Timing wheel queue
+	///
+	/// Events due within the next `1 << (SlotShift + SlotBits)` ticks are
+	/// kept in a ring of `1 << SlotBits` buckets, each covering
+	/// `1 << SlotShift` ticks. Each bucket is sorted the same way the linear
+	/// queue is. Events further out go to a second level, a linear queue,
+	/// and move into the ring once the ring has advanced far enough.
+	///
+	/// With the defaults a bucket covers 6.4ns and the ring 13us at the
+	/// default netlist resolution. Typical gate delays land a few buckets
+	/// ahead, so push and pop no longer depend on the number of pending
+	/// events.
+	///
+	/// Entries with equal times come out in the order the linear queue
+	/// returns them only if they share a bucket from the start. Entries
+	/// moved in from the second level are only ordered by time, as with
+	/// the heap queue.
+	///
+	template <class A, class T, unsigned SlotShift = 6, unsigned SlotBits = 11>
+	class timed_queue_wheel
+	{
+	public:
+		static constexpr std::size_t num_slots = std::size_t(1) << SlotBits;
+		static constexpr std::size_t slot_mask = num_slots - 1;
+
+		explicit timed_queue_wheel(A &arena, const std::size_t list_size)
+		: m_cursor(0)
+		, m_wheel_count(0)
+		, m_slots(num_slots)
+		, m_far(arena, list_size)
+		, m_never(T::never())
+		{
+			clear();
+		}
+		~timed_queue_wheel() = default;
+
+		PCOPYASSIGNMOVE(timed_queue_wheel, delete)
+
+		std::size_t capacity() const noexcept { return m_far.capacity(); }
+		bool empty() const noexcept { return m_wheel_count == 0 && m_far.empty(); }
+
+		template <bool KEEPSTAT, typename... Args>
+		void emplace(Args&&... args) noexcept
+		{
+			push<KEEPSTAT>(T(std::forward<Args>(args)...));
+		}
+
+		template <bool KEEPSTAT>
+		void push(T &&e) noexcept
+		{
+			if constexpr (KEEPSTAT)
+				m_prof_call.inc();
+
+			const std::int64_t slot = slot_of(e);
+			if (m_wheel_count == 0)
+			{
+				// nothing in the ring - start it at this event
+				m_cursor = m_far.empty() ? slot : std::min(slot, slot_of(m_far.top()));
+				pull_far();
+			}
+			else if (slot < m_cursor)
+			{
+				// earlier than anything in the ring (e.g. a main clock edge
+				// ahead of the queue top) - move the ring back
+				move_back(slot);
+			}
+			else if (slot >= m_cursor + std::int64_t(num_slots))
+			{
+				m_far.template push<KEEPSTAT>(std::move(e));
+				return;
+			}
+			insert<KEEPSTAT>(m_slots[std::size_t(slot) & slot_mask], std::move(e));
+			++m_wheel_count;
+		}
+
+		void pop() noexcept
+		{
+			if (m_wheel_count == 0)
+			{
+				m_far.pop();
+				return;
+			}
+			auto &bucket(m_slots[std::size_t(m_cursor) & slot_mask]);
+			bucket.pop_back();
+			--m_wheel_count;
+			if (bucket.empty())
+				advance();
+		}
+
+		const T &top() const noexcept
+		{
+			if (m_wheel_count == 0)
+				return m_far.empty() ? m_never : m_far.top();
+			return m_slots[std::size_t(m_cursor) & slot_mask].back();
+		}
+
+		bool exists(const typename T::element_type &elem) const noexcept
+		{
+			if (m_wheel_count != 0)
+				for (const auto &bucket : m_slots)
+					if (std::find(bucket.begin(), bucket.end(), elem) != bucket.end())
+						return true;
+			return m_far.exists(elem);
+		}
+
+		template <bool KEEPSTAT>
+		void remove(const T &elem) noexcept
+		{
+			// the time narrows the search down to one bucket; if the
+			// entry isn't there, look for the object everywhere
+			if constexpr (KEEPSTAT)
+				m_prof_remove.inc();
+			const std::int64_t slot = slot_of(elem);
+			if (m_wheel_count != 0 && slot >= m_cursor && slot < m_cursor + std::int64_t(num_slots))
+				if (remove_from(std::size_t(slot) & slot_mask, elem.object()))
+					return;
+			remove<false>(elem.object());
+		}
+
+		template <bool KEEPSTAT>
+		void remove(const typename T::element_type &elem) noexcept
+		{
+			if constexpr (KEEPSTAT)
+				m_prof_remove.inc();
+			if (m_wheel_count != 0)
+				for (std::size_t i = 0; i < num_slots; i++)
+					if (remove_from(i, elem))
+						return;
+			m_far.template remove<false>(elem);
+		}
+
+		void clear()
+		{
+			for (auto &bucket : m_slots)
+				bucket.clear();
+			m_far.clear();
+			m_cursor = 0;
+			m_wheel_count = 0;
+		}
+
+		// save state support & mame disassembler
+
+		const T *list_pointer() const
+		{
+			m_flat.clear();
+			for (const auto &bucket : m_slots)
+				m_flat.insert(m_flat.end(), bucket.begin(), bucket.end());
+			for (std::size_t i = 0; i < m_far.size(); i++)
+				m_flat.push_back(m_far[i]);
+			return m_flat.data();
+		}
+		std::size_t size() const noexcept { return m_wheel_count + m_far.size(); }
+		const T & operator[](const std::size_t index) const { return list_pointer()[index]; }
+
+	private:
+		using bucket_type = std::vector<T>;
+
+		static std::int64_t slot_of(const T &e) noexcept
+		{
+			return narrow_cast<std::int64_t>(e.exec_time().as_raw() >> SlotShift);
+		}
+
+		// sorted insert, earliest entry at the back like the linear queue
+		template <bool KEEPSTAT>
+		void insert(bucket_type &bucket, T &&e) noexcept
+		{
+			bucket.push_back(std::move(e));
+			for (auto i = bucket.end() - 1; i != bucket.begin() && *(i-1) < *i; --i)
+			{
+				std::swap(*(i-1), *i);
+				if constexpr (KEEPSTAT)
+					m_prof_sort_move.inc();
+			}
+		}
+
+		bool remove_from(std::size_t index, const typename T::element_type &elem) noexcept
+		{
+			auto &bucket(m_slots[index]);
+			auto it = std::find(bucket.begin(), bucket.end(), elem);
+			if (it == bucket.end())
+				return false;
+			bucket.erase(it);
+			--m_wheel_count;
+			if (index == (std::size_t(m_cursor) & slot_mask) && bucket.empty())
+				advance();
+			return true;
+		}
+
+		// move events from the second level into the ring as it covers them
+		void pull_far() noexcept
+		{
+			const std::int64_t end = m_cursor + std::int64_t(num_slots);
+			while (!m_far.empty() && slot_of(m_far.top()) < end)
+			{
+				T e(m_far.top());
+				m_far.pop();
+				insert<false>(m_slots[std::size_t(slot_of(e)) & slot_mask], std::move(e));
+				++m_wheel_count;
+			}
+		}
+
+		// step the cursor to the next occupied bucket
+		void advance() noexcept
+		{
+			if (m_wheel_count == 0)
+			{
+				if (!m_far.empty())
+				{
+					m_cursor = slot_of(m_far.top());
+					pull_far();
+				}
+				return;
+			}
+			do
+			{
+				++m_cursor;
+				if (!m_far.empty() && slot_of(m_far.top()) < m_cursor + std::int64_t(num_slots))
+					pull_far();
+			} while (m_slots[std::size_t(m_cursor) & slot_mask].empty());
+		}
+
+		// make the ring start at an earlier slot, pushing whatever falls
+		// off its far end to the second level
+		void move_back(std::int64_t slot) noexcept
+		{
+			const std::int64_t end = slot + std::int64_t(num_slots);
+			for (std::int64_t s = std::max(end, m_cursor); s < m_cursor + std::int64_t(num_slots); s++)
+			{
+				auto &bucket(m_slots[std::size_t(s) & slot_mask]);
+				for (auto &e : bucket)
+					m_far.template push<false>(std::move(e));
+				m_wheel_count -= bucket.size();
+				bucket.clear();
+			}
+			m_cursor = slot;
+		}
+
+		std::int64_t             m_cursor;       // absolute slot of the earliest bucket
+		std::size_t              m_wheel_count;  // entries held in the ring
+		std::vector<bucket_type> m_slots;
+		timed_queue_linear<A, T> m_far;
+		T                        m_never;
+		mutable std::vector<T>   m_flat;         // for list_pointer()
+
+	public:
+		// profiling
+		pperfcount_t<true> m_prof_sort_move; // NOLINT
+		pperfcount_t<true> m_prof_call; // NOLINT
+		pperfcount_t<true> m_prof_remove; // NOLINT
+	};
+
 } // namespace plib
 
 #endif // PTIMED_QUEUE_H_
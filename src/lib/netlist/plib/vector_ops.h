@@ -110,6 +110,31 @@ namespace plib
 			result[i] += scalar * v[i];
 	}
 
+	template<typename T>
+	T vec_mult_p(const std::size_t n, const T * v1, const T * v2) noexcept
+	{
+		T ret(plib::constants<T>::zero());
+		for ( std::size_t i = 0; i < n; i++ )
+			ret += v1[i] * v2[i];
+		return ret;
+	}
+
+	/// \brief Should a sparse row be processed as one dense span?
+	///
+	/// Rows of a cleared matrix hold zeros outside their non-zero pattern,
+	/// so the span between the first and last entry can be processed with
+	/// the contiguous kernels above without changing the result. This pays
+	/// off unless the pattern is mostly gaps.
+	///
+	/// \param count number of non-zero entries
+	/// \param first column of the first entry
+	/// \param last column of the last entry
+	///
+	constexpr bool vec_use_dense_span(std::size_t count, std::size_t first, std::size_t last) noexcept
+	{
+		return count >= 4 && (last - first + 1) <= 2 * count;
+	}
+
 	template<typename R, typename V>
 	void vec_add_ip(R & result, const V & v) noexcept
 	{
@@ -62,7 +62,7 @@ public:
 		m_errors(0),
 
 		opt_grp1(*this,     "General options",              "The following options apply to all commands."),
-		opt_cmd (*this,     "c", "cmd",         0,          std::vector<pstring>({"run","validate","convert","list-devices","list-models","static","header","doc-header","tests"}), "run|validate|convert|list-devices|list-models|static|header|doc-header|tests"),
+		opt_cmd (*this,     "c", "cmd",         0,          std::vector<pstring>({"run","validate","convert","list-devices","list-models","static","header","doc-header","tests","queue-bench"}), "run|validate|convert|list-devices|list-models|static|header|doc-header|tests|queue-bench"),
 		opt_includes(*this, "I", "include",                 "Add the directory to the list of directories to be searched for header files. This option may be specified repeatedly."),
 		opt_defines(*this,  "D", "define",                  "predefine value as macro, e.g. -Dname=value. If '=value' is omitted predefine it as 1. This option may be specified repeatedly."),
 		opt_data_folders(*this, "d", "data",                    "where to look for data files"),
@@ -105,6 +105,10 @@ public:
 		opt_line_width(*this,"", "line-width", 72,          "Line width for output."),
 		opt_pattern(*this, "", "pattern",                   "Pattern to match against device names. If the device name contains pattern, the device will be included in the output. Multiple patterns can be specified, if none is given, all devices will be output."),
 
+		opt_grp8(*this,     "Options for queue-bench command", "These options are only used by the queue-bench command."),
+		opt_bench_events(*this, "", "events", 20000000,     "number of events to process with each queue."),
+		opt_bench_pending(*this, "", "pending", 200,        "number of events pending at any time, i.e. the number of active nets."),
+
 		opt_ex1(*this,     "nltool -c run -t 3.5 -n cap_delay nl_examples/cdelay.c",
 				"Run netlist \"cap_delay\" from file nl_examples/cdelay.c for 3.5 seconds"),
 		opt_ex2(*this,     "nltool --cmd=list-devices",
@@ -116,7 +120,9 @@ public:
 		opt_ex5(*this,     "nltool --cmd static --output src/lib/netlist/generated/static_solvers.cpp --dir src/lib/netlist/generated/static --static_include src/mame/audio/nl_*.cpp src/mame/machine/nl_*.cpp",
 				"Create static solvers for the MAME project using a single source file which includes generated solvers written to --dir folder."),
 		opt_ex6(*this,     "nltool --cmd tests",
-			"Run unit tests. In case the unit tests are not linked in, this will do nothing.")
+			"Run unit tests. In case the unit tests are not linked in, this will do nothing."),
+		opt_ex7(*this,     "nltool --cmd queue-bench --pending 1000",
+			"Compare the event queue implementations on a synthetic workload with 1000 nets changing state.")
 		{}
 
 	int execute() override;
@@ -176,12 +182,16 @@ private:
 	plib::option_num<unsigned> opt_tab_width;
 	plib::option_num<unsigned> opt_line_width;
 	plib::option_vec     opt_pattern;
+	plib::option_group  opt_grp8;
+	plib::option_num<unsigned> opt_bench_events;
+	plib::option_num<unsigned> opt_bench_pending;
 	plib::option_example opt_ex1;
 	plib::option_example opt_ex2;
 	plib::option_example opt_ex3;
 	plib::option_example opt_ex4;
 	plib::option_example opt_ex5;
 	plib::option_example opt_ex6;
+	plib::option_example opt_ex7;
 
 	struct compile_map_entry
 	{
@@ -219,6 +229,8 @@ private:
 	void list_models();
 	void list_devices();
 
+	void queue_bench();
+
 	std::vector<pstring> m_defines;
 
 };
@@ -1266,6 +1278,106 @@ void tool_app_t::list_models()
 	}
 }
 
+// -------------------------------------------------
+//    queue_bench - compare the event queues
+// -------------------------------------------------
+
+namespace
+{
+	// stand-in for a net; the queues only look at its address
+	struct bench_net_t
+	{
+		std::size_t m_id;
+	};
+
+	using bench_entry_t = plib::queue_entry_t<netlist::netlist_time_ext, bench_net_t *>;
+
+	// Every processed event reschedules its net after a gate delay of
+	// 5-40ns. Every 8th event also reschedules another pending net, as a
+	// net changing again before its last change went through does, and
+	// every 256th delay is a slow one beyond 50us.
+	template <typename Q>
+	netlist::netlist_time_ext run_queue_bench(Q &queue, std::vector<bench_net_t> &nets, std::size_t events)
+	{
+		std::vector<netlist::netlist_time_ext> scheduled(nets.size());
+		std::uint32_t seed = 0x12345678;
+		auto random = [&seed]() { seed = seed * 1664525U + 1013904223U; return seed >> 8; };
+		auto delay = [&random]()
+		{
+			const std::uint32_t r = random();
+			return (r & 0xff) == 0
+				? netlist::netlist_time_ext::from_nsec(50'000 + (r >> 8) % 50'000)
+				: netlist::netlist_time_ext::from_raw((50 + (r >> 8) % 350));
+		};
+
+		queue.clear();
+		for (std::size_t i = 0; i < nets.size(); i++)
+		{
+			scheduled[i] = delay();
+			queue.template emplace<false>(scheduled[i], &nets[i]);
+		}
+
+		netlist::netlist_time_ext now(netlist::netlist_time_ext::zero());
+		for (std::size_t n = 0; n < events; n++)
+		{
+			now = queue.top().exec_time();
+			bench_net_t *const net = queue.top().object();
+			queue.pop();
+
+			scheduled[net->m_id] = now + delay();
+			queue.template emplace<false>(scheduled[net->m_id], net);
+
+			if ((n & 7) == 0)
+			{
+				const std::size_t other = random() % nets.size();
+				if (other != net->m_id)
+				{
+					queue.template remove<false>(bench_entry_t(scheduled[other], &nets[other]));
+					scheduled[other] = now + delay();
+					queue.template emplace<false>(scheduled[other], &nets[other]);
+				}
+			}
+		}
+		return now;
+	}
+} // anonymous namespace
+
+void tool_app_t::queue_bench()
+{
+	const std::size_t events = opt_bench_events();
+	const std::size_t pending = std::max(opt_bench_pending(), 1U);
+
+	std::vector<bench_net_t> nets(pending);
+	for (std::size_t i = 0; i < pending; i++)
+		nets[i].m_id = i;
+
+	auto bench = [this, &nets, events, pending](const char *name, auto &queue)
+	{
+		plib::chrono::timer<plib::chrono::system_ticks> t;
+		t.start();
+		const netlist::netlist_time_ext end = run_queue_bench(queue, nets, events);
+		t.stop();
+		const auto seconds = t.as_seconds<netlist::nl_fptype>();
+		std_out("{1:-8} {2:5} nets: {3:8.3f} Mevents/s, reached {4:.6f}s\n", name, pending,
+			netlist::nl_fptype(events) / seconds / netlist::nlconst::magic(1'000'000.0),
+			end.as_double());
+	};
+
+	auto &arena(netlist::host_arena::instance());
+	{
+		plib::timed_queue_linear<netlist::host_arena, bench_entry_t> queue(arena, pending + 1);
+		bench("linear", queue);
+	}
+	{
+		plib::timed_queue_heap<netlist::host_arena, bench_entry_t> queue(arena, pending + 1);
+		bench("heap", queue);
+	}
+	{
+		plib::timed_queue_wheel<netlist::host_arena, bench_entry_t> queue(arena, pending + 1);
+		bench("wheel", queue);
+	}
+}
+
 // -------------------------------------------------
 //    convert - convert spice et al to netlist
 // -------------------------------------------------
@@ -1397,6 +1509,8 @@ int tool_app_t::execute()
 			create_doc_header();
 		else if (cmd == "convert")
 			convert();
+		else if (cmd == "queue-bench")
+			queue_bench();
 		else if (cmd == "tests")
 		{
 			return PRUN_ALL_TESTS(opt_verb() ? ::plib::testing::loglevel::INFO
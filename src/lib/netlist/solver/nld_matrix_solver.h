@@ -101,7 +101,8 @@ namespace netlist::solver
 		{
 			return netlist_time::quantum().as_fp<nl_fptype>();
 		}
-		static constexpr int m_parallel() { return 0; }
+		// -1: automatic, 0 or 1: single threaded, n: use n threads
+		static constexpr int m_parallel() { return -1; }
 
 		static constexpr nl_fptype m_min_ts_ts()
 		{
@@ -168,7 +169,12 @@ namespace netlist::solver
 							defaults.m_nr_recalc_delay()) //!< Delay to next
 														  //!< solve attempt if
 														  //!< nr loops exceeded
-		, m_parallel(parent, prefix + "PARALLEL", defaults.m_parallel())
+		, m_parallel(parent, prefix + "PARALLEL", defaults.m_parallel()) //!< Threads
+																		 //!< used to
+																		 //!< solve
+																		 //!< independent
+																		 //!< solvers,
+																		 //!< -1: auto
 		, m_min_ts_ts(parent, prefix + "MIN_TS_TS",
 					  defaults.m_min_ts_ts()) //!< The minimum time step for
 											  //!< solvers with time stepping
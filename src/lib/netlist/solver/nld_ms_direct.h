@@ -71,12 +71,20 @@ namespace netlist::solver
 				const auto &nzrd = this->m_terms[i].m_nzrd;
 				const auto &nzbd = this->m_terms[i].m_nzbd;
 
+				// dense enough rows are eliminated as one contiguous span
+				const std::size_t first = nzrd.empty() ? 0 : nzrd.front();
+				const std::size_t span = nzrd.empty() ? 0 : (nzrd.back() - first + 1);
+				const bool dense = plib::vec_use_dense_span(nzrd.size(), first, first + span - 1);
+
 				for (auto &j : nzbd)
 				{
 					auto &Aj = m_A[j];
 					const FT f1 = -f * Aj[i];
-					for (auto &k : nzrd)
-						Aj[k] += Ai[k] * f1;
+					if (dense)
+						plib::vec_add_mult_scalar_p(span, &Aj[first], &Ai[first], f1);
+					else
+						for (auto &k : nzrd)
+							Aj[k] += Ai[k] * f1;
 					this->m_RHS[j] += this->m_RHS[i] * f1;
 				}
 			}
@@ -161,8 +169,11 @@ namespace netlist::solver
 				const auto & Aj(m_A[j]);
 				const auto e = nzrd.size();
 
-				for ( std::size_t k = 0; k < e; k++)
-					tmp += Aj[nzrd[k]] * x[nzrd[k]];
+				if (e > 0 && plib::vec_use_dense_span(e, nzrd.front(), nzrd.back()))
+					tmp = plib::vec_mult_p<FT>(nzrd.back() - nzrd.front() + 1, &Aj[nzrd.front()], &x[nzrd.front()]);
+				else
+					for ( std::size_t k = 0; k < e; k++)
+						tmp += Aj[nzrd[k]] * x[nzrd[k]];
 				x[j] = (this->m_RHS[j] - tmp) / Aj[j];
 			}
 		}
@@ -44,6 +44,7 @@ namespace netlist::devices
 		  this->state().pool(), config::max_solver_queue_size(),
 		  queue_type::id_delegate(&NETLIB_NAME(solver)::get_solver_id, this),
 		  queue_type::obj_delegate(&NETLIB_NAME(solver)::solver_by_id, this))
+	, m_parallel_window(netlist_time_ext::zero())
 	{
 		// internal stuff
 		state().save(*this,
@@ -75,16 +76,7 @@ namespace netlist::devices
 	NETLIB_HANDLER(solver, fb_step)
 	{
 		const netlist_time_ext now(exec().time());
-		const std::size_t      nthreads = m_params.m_parallel() < 2
-											  ? 1
-											  : std::min(
-											 static_cast<std::size_t>(
-												 m_params.m_parallel()),
-											 plib::omp::get_max_threads());
-		const netlist_time_ext sched(
-			now
-			+ (nthreads <= 1 ? netlist_time_ext::zero()
-							 : netlist_time_ext::from_nsec(100)));
+		const netlist_time_ext sched(now + m_parallel_window);
 		plib::uninitialised_array<solver::matrix_solver_t *,
 								  config::max_solver_queue_size::value>
 			tmp; // NOLINT
@@ -104,47 +96,56 @@ namespace netlist::devices
 			m_queue.pop();
 		}
 
-		// FIXME: Disabled for now since parallel processing will decrease
-		// performance
-		//        for tested applications. More testing required here
-		if (true || nthreads < 2)
+		if (KEEP_STATS)
 		{
-			if (!KEEP_STATS)
+			stats()->m_stat_total_time.stop();
+			for (std::size_t i = 0; i < p; i++)
 			{
-				for (std::size_t i = 0; i < p; i++)
-					nt[i] = tmp[i]->solve(now, "no-parallel");
+				tmp[i]->stats()->m_stat_call_count.inc();
+				auto g(tmp[i]->stats()->m_stat_total_time.guard());
+				nt[i] = tmp[i]->solve(now, "no-parallel");
 			}
-			else
+			stats()->m_stat_total_time.start();
+		}
+		else
+		{
+			// Expensive solvers are handed out first, cheap ones are picked
+			// up by whoever is free. Only worth it with two expensive ones.
+			plib::uninitialised_array<std::size_t,
+									  config::max_solver_queue_size::value>
+						order; // NOLINT
+			std::size_t np = 0;
+			if (m_workers)
+				for (std::size_t i = 0; i < p; i++)
+					if (is_expensive(*tmp[i]))
+						order[np++] = i;
+
+			if (np < 2)
 			{
-				stats()->m_stat_total_time.stop();
 				for (std::size_t i = 0; i < p; i++)
-				{
-					tmp[i]->stats()->m_stat_call_count.inc();
-					auto g(tmp[i]->stats()->m_stat_total_time.guard());
 					nt[i] = tmp[i]->solve(now, "no-parallel");
-				}
-				stats()->m_stat_total_time.start();
 			}
-
-			for (std::size_t i = 0; i < p; i++)
+			else
 			{
-				if (nt[i] != netlist_time::zero())
-					m_queue.push<false>({now + nt[i], tmp[i]});
-				tmp[i]->update_inputs();
+				for (std::size_t i = 0, k = np; i < p; i++)
+					if (!is_expensive(*tmp[i]))
+						order[k++] = i;
+				auto solve_one = [&tmp, &nt, &order, now](std::size_t j)
+				{
+					const std::size_t i = order[j];
+					nt[i] = tmp[i]->solve(now, "parallel");
+				};
+				m_workers->for_each(p, solve_one);
 			}
 		}
-		else
+
+		// inputs are updated in queue order to keep results independent
+		// of threading
+		for (std::size_t i = 0; i < p; i++)
 		{
-			plib::omp::set_num_threads(nthreads);
-			plib::omp::for_static(static_cast<std::size_t>(0), p,
-								  [&tmp, &nt, now](std::size_t i)
-								  { nt[i] = tmp[i]->solve(now, "parallel"); });
-			for (std::size_t i = 0; i < p; i++)
-			{
-				if (nt[i] != netlist_time::zero())
-					m_queue.push<false>({now + nt[i], tmp[i]});
-				tmp[i]->update_inputs();
-			}
+			if (nt[i] != netlist_time::zero())
+				m_queue.push<false>({now + nt[i], tmp[i]});
+			tmp[i]->update_inputs();
 		}
 		if (!m_queue.empty())
 			m_Q_step.net().toggle_and_push_to_queue(
@@ -218,6 +219,51 @@ namespace netlist::devices
 	}
 #endif
 
+	bool NETLIB_NAME(solver)::is_expensive(
+		const solver::matrix_solver_t &s) noexcept
+	{
+		// Newton-Raphson loops repeat the solve
+		const std::size_t cost = s.ops()
+								 * (s.dynamic_device_count() > 0 ? 3 : 1);
+		return cost >= config::parallel_solver_min_ops::value;
+	}
+
+	void NETLIB_NAME(solver)::create_workers()
+	{
+		const int         parallel = m_params.m_parallel();
+		const std::size_t expensive = static_cast<std::size_t>(
+			std::count_if(m_mat_solvers.begin(), m_mat_solvers.end(),
+						  [](const solver_ptr &s)
+						  { return is_expensive(*s); }));
+		const std::size_t hw = plib::pworker_pool::hardware_threads();
+
+		// Automatic mode only solves solvers due at exactly the same time
+		// together, results are identical to single threaded operation.
+		// With an explicit thread count, solvers due within 100ns are
+		// gathered as well.
+		std::size_t threads = 1;
+		if (parallel < 0)
+			threads = std::min(
+				{expensive, config::parallel_solver_max_threads::value, hw});
+		else if (parallel > 1)
+			threads = std::min(static_cast<std::size_t>(parallel), hw);
+
+		if (NL_USE_SOLVER_THREADS && threads > 1 && expensive > 1)
+		{
+			m_workers = std::make_unique<plib::pworker_pool>(threads - 1);
+			m_parallel_window = parallel > 1
+									? netlist_time_ext::from_nsec(100)
+									: netlist_time_ext::zero();
+			log().verbose("Solving {1} of {2} solvers on {3} threads",
+						  expensive, m_mat_solvers.size(), threads);
+		}
+		else
+		{
+			m_workers.reset();
+			m_parallel_window = netlist_time_ext::zero();
+		}
+	}
+
 	// FIXME: should be created in device space
 	template <class C, class A>
 	NETLIB_NAME(solver)::solver_ptr
@@ -573,6 +619,8 @@ namespace netlist::devices
 			m_mat_params.push_back(std::move(params));
 			m_mat_solvers.push_back(std::move(ms));
 		}
+
+		create_workers();
 	}
 
 	solver::static_compile_container NETLIB_NAME(solver)::create_solver_code(
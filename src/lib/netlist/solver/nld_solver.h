@@ -14,6 +14,7 @@
 #include "core/logic.h"
 #include "core/state_var.h"
 
+#include "../plib/pmulti_threading.h"
 #include "../plib/pstream.h"
 
 #include <map>
@@ -72,6 +73,13 @@ namespace netlist::devices
 		solver::solver_parameters_t m_params;
 		queue_type                  m_queue;
 
+		// worker threads for expensive solvers falling due together
+		std::unique_ptr<plib::pworker_pool> m_workers;
+		netlist_time_ext                    m_parallel_window;
+
+		void create_workers();
+		static bool is_expensive(const solver::matrix_solver_t &s) noexcept;
+
 		template <typename FT, int SIZE>
 		solver_ptr create_solver(std::size_t size, const pstring &solver_name,
 								 const solver::solver_parameters_t *params,
@@ -0,0 +1,81 @@
+// license:BSD-3-Clause
+// copyright-holders:Couriersud
+
+///
+/// \file test_ptimed_queue.cpp
+///
+/// tests for the timed queues
+///
+
+#include "plib/ptests.h"
+
+#include "plib/palloc.h"
+#include "plib/ptime.h"
+#include "plib/ptimed_queue.h"
+
+#include <cstdint>
+#include <vector>
+
+using test_time = plib::ptime<std::int64_t, 10'000'000'000LL>;
+using test_entry = plib::queue_entry_t<test_time, int *>;
+using test_arena = plib::aligned_arena<>;
+
+// Run the same pushes, removes and pops through a linear queue and a timing
+// wheel. Entries with equal times may come out in a different order, so the
+// wheel decides which entry is processed and only the times are compared.
+PTEST(ptimed_queue, wheel_matches_linear)
+{
+	auto &arena(test_arena::instance());
+	plib::timed_queue_linear<test_arena, test_entry> linear(arena, 512);
+	plib::timed_queue_wheel<test_arena, test_entry> wheel(arena, 512);
+
+	std::vector<int> objs(256);
+	std::vector<test_time> scheduled(objs.size());
+	std::uint32_t seed = 1;
+	auto random = [&seed]() { seed = seed * 1664525U + 1013904223U; return seed >> 8; };
+	auto delay = [&random]()
+	{
+		// mostly near events, some beyond the wheel's horizon
+		const std::uint32_t r = random();
+		return test_time::from_raw((r & 0x3f) == 0 ? (r >> 6) % 1'000'000 : (r >> 6) % 500);
+	};
+
+	for (std::size_t i = 0; i < objs.size(); i++)
+	{
+		scheduled[i] = delay();
+		linear.emplace<false>(scheduled[i], &objs[i]);
+		wheel.emplace<false>(scheduled[i], &objs[i]);
+	}
+
+	bool same(true);
+	for (int n = 0; n < 100'000 && same; n++)
+	{
+		same = linear.size() == wheel.size() && linear.top().exec_time() == wheel.top().exec_time();
+		const test_time now(wheel.top().exec_time());
+		int *obj(wheel.top().object());
+		wheel.pop();
+		linear.remove<false>(obj);
+
+		const auto index(std::size_t(obj - &objs[0]));
+		scheduled[index] = now + delay();
+		linear.emplace<false>(scheduled[index], obj);
+		wheel.emplace<false>(scheduled[index], obj);
+
+		// reschedule another entry, sometimes to before the current top
+		const std::size_t other(random() % objs.size());
+		if ((n % 5) == 0 && other != index)
+		{
+			linear.remove<false>(&objs[other]);
+			wheel.remove<false>(test_entry(scheduled[other], &objs[other]));
+			scheduled[other] = now + delay();
+			linear.emplace<false>(scheduled[other], &objs[other]);
+			wheel.emplace<false>(scheduled[other], &objs[other]);
+		}
+	}
+	PEXPECT_TRUE(same);
+	PEXPECT_EQ(linear.size(), wheel.size());
+
+	wheel.clear();
+	PEXPECT_TRUE(wheel.empty());
+	PEXPECT_TRUE(wheel.top().exec_time() == test_time::never());
+}
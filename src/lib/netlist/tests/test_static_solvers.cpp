@@ -0,0 +1,198 @@
+// license:BSD-3-Clause
+// copyright-holders:Couriersud
+
+///
+/// \file test_static_solvers.cpp
+///
+/// tests for the precompiled solvers in generated/static_solvers.cpp
+///
+/// Every MAME netlist is set up once using the builtin static solvers and
+/// once using the generic solvers. The test checks that all solvers the
+/// netlist needs are present in the builtin library and that both runs
+/// end up with the same analog net voltages after a short run.
+///
+/// The MAME sources are searched for in the directory given by the
+/// NL_MAME_SOURCES environment variable, defaulting to the location
+/// relative to the netlist build directory. If they can not be found, the
+/// test does nothing.
+///
+
+#include "plib/ptests.h"
+
+#include "core/analog.h"
+#include "core/nets.h"
+#include "core/setup.h"
+#include "nl_parser.h"
+#include "nl_setup.h"
+#include "solver/nld_solver.h"
+
+#include "plib/pdynlib.h"
+#include "plib/pstrutil.h"
+#include "plib/putil.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <vector>
+
+extern const plib::static_library::symbol nl_static_solver_syms[];
+
+namespace
+{
+	class quiet_logger
+	{
+	public:
+		void log(plib::plog_level l, const pstring &ls)
+		{
+			plib::unused_var(l, ls);
+		}
+	};
+
+	class include_folder_t : public netlist::source_data_t
+	{
+	public:
+		explicit include_folder_t(const pstring &folder)
+		: m_folder(folder)
+		{
+		}
+
+		plib::istream_uptr stream(const pstring &file) override
+		{
+			pstring name = m_folder + "/" + file;
+			plib::istream_uptr strm(std::make_unique<plib::ifstream>(plib::filesystem::u8path(name)), plib::filesystem::u8path(name));
+			if (strm->fail())
+				return plib::istream_uptr();
+			strm->imbue(std::locale::classic());
+			return strm;
+		}
+
+	private:
+		pstring m_folder;
+	};
+
+	class static_verify_state : public netlist::netlist_state_t
+	{
+	public:
+		static_verify_state(quiet_logger &logger, bool builtin)
+		: netlist::netlist_state_t("netlist", plib::plog_delegate(&quiet_logger::log, &logger))
+		{
+			set_static_solver_lib(std::make_unique<plib::static_library>(builtin ? nl_static_solver_syms : nullptr));
+			log().verbose.set_enabled(false);
+			log().info.set_enabled(false);
+			log().warning.set_enabled(false);
+		}
+
+		void load(const pstring &filename, const pstring &name)
+		{
+			parser().add_include<include_folder_t>(plib::util::path(filename));
+			parser().register_source<netlist::source_file_t>(filename);
+			parser().include(name);
+			setup().prepare_to_run();
+			free_setup_resources();
+			exec().reset();
+		}
+	};
+
+	// netlists contained in a MAME source file, see tool_app_t::static_compile
+
+	std::vector<pstring> netlist_names(const pstring &filename)
+	{
+		std::vector<pstring> names;
+		plib::putf8_reader r = plib::putf8_reader(std::make_unique<plib::ifstream>(plib::filesystem::u8path(filename)));
+		r.stream().imbue(std::locale::classic());
+		putf8string line;
+		while (r.read_line(line))
+		{
+			if (plib::startsWith(line, "//NL_CONTAINS "))
+			{
+				for (auto &e : plib::psplit(pstring(plib::trim(line.substr(13))), ' ', true))
+					names.push_back(e);
+			}
+		}
+		if (names.empty())
+		{
+			pstring name = plib::util::basename(filename, ".cpp");
+			if (plib::startsWith(name, "nl_"))
+				name = name.substr(3);
+			names.push_back(name);
+		}
+		return names;
+	}
+
+	std::vector<pstring> mame_netlist_files()
+	{
+		std::vector<pstring> files;
+		const pstring root = plib::util::environment("NL_MAME_SOURCES", "../../../mame");
+		std::error_code ec;
+		if (!std::filesystem::is_directory(putf8string(root).c_str(), ec))
+			return files;
+		for (const auto &e : std::filesystem::recursive_directory_iterator(putf8string(root).c_str(), ec))
+		{
+			const auto fname = e.path().filename().string();
+			// pongdoubles is excluded from static_solvers.cpp, see nl_create_mame_solvers.sh
+			if (e.is_regular_file() && plib::startsWith(fname, "nl_") && plib::endsWith(fname, ".cpp")
+				&& fname != "nl_pongdoubles.cpp")
+				files.emplace_back(e.path().string());
+		}
+		std::sort(files.begin(), files.end());
+		return files;
+	}
+
+	bool has_static_solver(const pstring &name)
+	{
+		for (const auto *p = nl_static_solver_syms; p->name[0] != 0; p++)
+			if (name == pstring(p->name))
+				return true;
+		return false;
+	}
+} // namespace
+
+PTEST(static_solvers, mame_netlists)
+{
+	static constexpr const netlist::nl_fptype tolerance = 1e-6;
+
+	quiet_logger logger;
+	pstring missing;
+	pstring mismatch;
+
+	for (const auto &file : mame_netlist_files())
+	{
+		for (const auto &name : netlist_names(file))
+		{
+			static_verify_state builtin(logger, true);
+			static_verify_state generic(logger, false);
+
+			builtin.load(file, name);
+			generic.load(file, name);
+
+			for (const auto &e : builtin.exec().solver()->create_solver_code(netlist::solver::CXX_STATIC))
+				if (!has_static_solver(e.first))
+					missing += plib::pfmt("{1}:{2} ")(name, e.first);
+
+			// Static and generic solvers only differ in rounding. In netlists
+			// driven by logic this moves edges slightly and the runs drift
+			// apart over time, so only a short window is compared.
+			const auto duration = netlist::netlist_time_ext::from_usec(100);
+			builtin.exec().process_queue(duration);
+			generic.exec().process_queue(duration);
+
+			PEXPECT_EQ(builtin.nets().size(), generic.nets().size());
+			for (std::size_t i = 0; i < std::min(builtin.nets().size(), generic.nets().size()); i++)
+			{
+				if (!builtin.nets()[i]->is_analog())
+					continue;
+				const auto &bn = static_cast<const netlist::analog_net_t &>(*builtin.nets()[i]);
+				const auto &gn = static_cast<const netlist::analog_net_t &>(*generic.nets()[i]);
+				const auto d = plib::abs(bn.Q_Analog() - gn.Q_Analog());
+				if (d > tolerance * std::max(netlist::nlconst::one(), plib::abs(gn.Q_Analog())))
+				{
+					mismatch += plib::pfmt("{1}:{2} {3} {4} ")(name, bn.name(), bn.Q_Analog(), gn.Q_Analog());
+					break;
+				}
+			}
+		}
+	}
+
+	PEXPECT_EQ(missing, pstring(""));
+	PEXPECT_EQ(mismatch, pstring(""));
+}
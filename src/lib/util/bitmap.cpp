@@ -12,20 +12,40 @@
 
 #include <cassert>
 #include <cstring>
+#include <mutex>
 #include <new>
+#include <vector>
 
 
 //**************************************************************************
 //  INLINE HELPERS
 //**************************************************************************
 
+//-------------------------------------------------
+//  compute_xpad - compute the padding to the left
+//  of pixel (0,0), rounding the slop up to keep
+//  it aligned if requested
+//-------------------------------------------------
+
+inline int32_t bitmap_t::compute_xpad(int xslop) const
+{
+	if (!m_aligned_rows)
+		return xslop;
+	int32_t const align = ROW_ALIGNMENT * 8 / m_bpp;
+	return (xslop + align - 1) / align * align;
+}
+
+
 //-------------------------------------------------
 //  compute_rowpixels - compute a rowpixels value
 //-------------------------------------------------
 
 inline int32_t bitmap_t::compute_rowpixels(int width, int xslop)
 {
-	return width + 2 * xslop;
+	if (!m_aligned_rows)
+		return width + 2 * xslop;
+	int32_t const align = ROW_ALIGNMENT * 8 / m_bpp;
+	return (compute_xpad(xslop) + width + xslop + align - 1) / align * align;
 }
 
 
@@ -36,7 +56,31 @@ inline int32_t bitmap_t::compute_rowpixels(int width, int xslop)
 
 inline void bitmap_t::compute_base(int xslop, int yslop)
 {
-	m_base = &m_alloc[(m_rowpixels * yslop + xslop) * (m_bpp / 8)];
+	m_base = alloc_base() + (m_rowpixels * yslop + compute_xpad(xslop)) * (m_bpp / 8);
+}
+
+
+//-------------------------------------------------
+//  alloc_base - get the start of the allocation,
+//  rounded up to the alignment boundary
+//-------------------------------------------------
+
+inline uint8_t *bitmap_t::alloc_base() const
+{
+	uintptr_t const ptr = reinterpret_cast<uintptr_t>(m_alloc.get());
+	return reinterpret_cast<uint8_t *>((ptr + ROW_ALIGNMENT - 1) & ~uintptr_t(ROW_ALIGNMENT - 1));
+}
+
+
+//-------------------------------------------------
+//  clear_memory - zero all allocated pixel memory
+//  including the slop
+//-------------------------------------------------
+
+void bitmap_t::clear_memory()
+{
+	if (m_alloc)
+		memset(alloc_base(), 0, m_allocbytes);
 }
 
 
@@ -90,6 +134,7 @@ bitmap_t::bitmap_t(bitmap_t &&that)
 	, m_height(that.m_height)
 	, m_format(that.m_format)
 	, m_bpp(that.m_bpp)
+	, m_aligned_rows(that.m_aligned_rows)
 	, m_palette(nullptr)
 	, m_cliprect(that.m_cliprect)
 {
@@ -117,6 +162,7 @@ bitmap_t::bitmap_t(bitmap_format format, uint8_t bpp, int width, int height, int
 	, m_allocbytes(0)
 	, m_format(format)
 	, m_bpp(bpp)
+	, m_aligned_rows(false)
 	, m_palette(nullptr)
 {
 	assert(valid_format());
@@ -147,6 +193,7 @@ bitmap_t::bitmap_t(bitmap_format format, uint8_t bpp, void *base, int width, int
 	, m_height(height)
 	, m_format(format)
 	, m_bpp(bpp)
+	, m_aligned_rows(false)
 	, m_palette(nullptr)
 	, m_cliprect(0, width - 1, 0, height - 1)
 {
@@ -173,6 +220,7 @@ bitmap_t::bitmap_t(bitmap_format format, uint8_t bpp, bitmap_t &source, const re
 	, m_height(subrect.height())
 	, m_format(format)
 	, m_bpp(bpp)
+	, m_aligned_rows(false)
 	, m_palette(nullptr)
 	, m_cliprect(0, subrect.width() - 1, 0, subrect.height() - 1)
 {
@@ -205,6 +253,7 @@ bitmap_t &bitmap_t::operator=(bitmap_t &&that)
 	m_height = that.m_height;
 	m_format = that.m_format;
 	m_bpp = that.m_bpp;
+	m_aligned_rows = that.m_aligned_rows;
 	set_palette(that.m_palette);
 	m_cliprect = that.m_cliprect;
 	that.reset();
@@ -239,7 +288,7 @@ void bitmap_t::allocate(int width, int height, int xslop, int yslop)
 		// allocate memory for the bitmap itself
 		int32_t const new_rowpixels = compute_rowpixels(width, xslop);
 		uint32_t const new_allocbytes = new_rowpixels * (height + 2 * yslop) * m_bpp / 8;
-		m_alloc.reset(new (std::nothrow) uint8_t[new_allocbytes]);
+		m_alloc.reset(new (std::nothrow) uint8_t[new_allocbytes + ROW_ALIGNMENT - 1]);
 		if (m_alloc)
 		{
 			// initialize fields
@@ -250,7 +299,7 @@ void bitmap_t::allocate(int width, int height, int xslop, int yslop)
 			m_cliprect.set(0, width - 1, 0, height - 1);
 
 			// clear to 0 by default
-			memset(m_alloc.get(), 0, m_allocbytes);
+			clear_memory();
 
 			// compute the base
 			compute_base(xslop, yslop);
@@ -348,7 +397,7 @@ void bitmap_t::reset()
 void bitmap_t::wrap(void *base, int width, int height, int rowpixels)
 {
 	assert(base || (!width && !height));
-	assert(!m_alloc || (&m_alloc[0] > base) || (&m_alloc[m_allocbytes] <= base));
+	assert(!m_alloc || (alloc_base() > base) || ((alloc_base() + m_allocbytes) <= base));
 
 	// delete any existing stuff
 	reset();
@@ -460,6 +509,111 @@ void bitmap_t::fill(uint64_t color, const rectangle &bounds)
 }
 
 
+//**************************************************************************
+//  BITMAP POOL
+//**************************************************************************
+
+struct bitmap_pool::state
+{
+	state(std::size_t l) : limit(l) { }
+
+	std::mutex                                      mutex;
+	std::vector<std::pair<key, owned_bitmap> >      free;
+	std::size_t const                               limit;
+};
+
+
+//-------------------------------------------------
+//  bitmap_pool - constructor
+//-------------------------------------------------
+
+bitmap_pool::bitmap_pool(std::size_t limit)
+	: m_state(std::make_shared<state>(limit))
+{
+}
+
+
+//-------------------------------------------------
+//  ~bitmap_pool - destructor; bitmaps still
+//  checked out are freed when they're released
+//-------------------------------------------------
+
+bitmap_pool::~bitmap_pool()
+{
+}
+
+
+//-------------------------------------------------
+//  purge - free all idle bitmaps
+//-------------------------------------------------
+
+void bitmap_pool::purge()
+{
+	std::vector<std::pair<key, owned_bitmap> > doomed;
+	{
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		doomed.swap(m_state->free);
+	}
+}
+
+
+//-------------------------------------------------
+//  free_count - get the number of idle bitmaps
+//-------------------------------------------------
+
+std::size_t bitmap_pool::free_count() const
+{
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	return m_state->free.size();
+}
+
+
+//-------------------------------------------------
+//  take - remove a matching idle bitmap from the
+//  pool and clear it so it looks freshly allocated
+//-------------------------------------------------
+
+bitmap_pool::owned_bitmap bitmap_pool::take(const key &k)
+{
+	owned_bitmap result(nullptr, nullptr);
+	{
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		auto const found = std::find_if(
+				m_state->free.begin(),
+				m_state->free.end(),
+				[&k] (const std::pair<key, owned_bitmap> &entry) { return entry.first == k; });
+		if (m_state->free.end() == found)
+			return result;
+		result = std::move(found->second);
+		m_state->free.erase(found);
+	}
+	result->clear_memory();
+	return result;
+}
+
+
+//-------------------------------------------------
+//  releaser - return a bitmap to the pool if it
+//  still has the shape it was handed out with
+//-------------------------------------------------
+
+void bitmap_pool::releaser::operator()(bitmap_t *bitmap) const
+{
+	owned_bitmap owned(bitmap, m_destroy);
+	bitmap->set_palette(nullptr);
+	if (!bitmap->valid() || (bitmap->width() != m_key.width) || (bitmap->height() != m_key.height) || (bitmap->aligned_rows() != m_key.aligned))
+		return;
+
+	std::shared_ptr<state> const pool = m_pool.lock();
+	if (pool)
+	{
+		std::lock_guard<std::mutex> lock(pool->mutex);
+		if (pool->free.size() < pool->limit)
+			pool->free.emplace_back(m_key, std::move(owned));
+	}
+}
+
+
 //**************************************************************************
 //  EXPLICIT TEMPLATE INSTANTIATIONS
 //**************************************************************************
@@ -147,6 +147,9 @@ protected:
 	bitmap_t &operator=(bitmap_t &&that);
 
 public:
+	// pixel memory always starts on this boundary; with aligned rows, pixel (0,0) and every row do too
+	static constexpr int32_t ROW_ALIGNMENT = 64;
+
 	// allocation/deallocation
 	void reset();
 
@@ -160,10 +163,12 @@ public:
 	bool valid() const { return (m_base != nullptr); }
 	palette_t *palette() const { return m_palette; }
 	const rectangle &cliprect() const { return m_cliprect; }
+	bool aligned_rows() const { return m_aligned_rows; }
 
 	// allocation/sizing
 	void allocate(int width, int height, int xslop = 0, int yslop = 0);
 	void resize(int width, int height, int xslop = 0, int yslop = 0);
+	void set_aligned_rows(bool aligned) { m_aligned_rows = aligned; } // takes effect on the next allocate/resize
 
 	// operations
 	void set_palette(palette_t *palette);
@@ -186,9 +191,14 @@ protected:
 	void wrap(bitmap_t &source, const rectangle &subrect);
 
 private:
+	friend class bitmap_pool;
+
 	// internal helpers
+	int32_t compute_xpad(int xslop) const;
 	int32_t compute_rowpixels(int width, int xslop);
 	void compute_base(int xslop, int yslop);
+	uint8_t *alloc_base() const;
+	void clear_memory();
 	bool valid_format() const;
 
 	// internal state
@@ -200,6 +210,7 @@ private:
 	int32_t                     m_height;       // height of the bitmap
 	bitmap_format               m_format;       // format of the bitmap
 	uint8_t                     m_bpp;          // bits per pixel
+	bool                        m_aligned_rows; // pad rows so each one starts on a ROW_ALIGNMENT boundary
 	palette_t *                 m_palette;      // optional palette
 	rectangle                   m_cliprect;     // a clipping rectangle covering the full bitmap
 };
@@ -272,9 +283,9 @@ extern template class bitmap_specific<uint64_t>;
 // BITMAP_FORMAT_IND8 bitmaps
 class bitmap_ind8 : public bitmap8_t
 {
-	static const bitmap_format k_bitmap_format = BITMAP_FORMAT_IND8;
-
 public:
+	static constexpr bitmap_format k_bitmap_format = BITMAP_FORMAT_IND8;
+
 	// construction/destruction
 	bitmap_ind8(bitmap_ind8 &&) = default;
 	bitmap_ind8(int width = 0, int height = 0, int xslop = 0, int yslop = 0) : bitmap8_t(k_bitmap_format, width, height, xslop, yslop) { }
@@ -292,9 +303,9 @@ public:
 // BITMAP_FORMAT_IND16 bitmaps
 class bitmap_ind16 : public bitmap16_t
 {
-	static const bitmap_format k_bitmap_format = BITMAP_FORMAT_IND16;
-
 public:
+	static constexpr bitmap_format k_bitmap_format = BITMAP_FORMAT_IND16;
+
 	// construction/destruction
 	bitmap_ind16(bitmap_ind16 &&) = default;
 	bitmap_ind16(int width = 0, int height = 0, int xslop = 0, int yslop = 0) : bitmap16_t(k_bitmap_format, width, height, xslop, yslop) { }
@@ -312,9 +323,9 @@ public:
 // BITMAP_FORMAT_IND32 bitmaps
 class bitmap_ind32 : public bitmap32_t
 {
-	static const bitmap_format k_bitmap_format = BITMAP_FORMAT_IND32;
-
 public:
+	static constexpr bitmap_format k_bitmap_format = BITMAP_FORMAT_IND32;
+
 	// construction/destruction
 	bitmap_ind32(bitmap_ind32 &&) = default;
 	bitmap_ind32(int width = 0, int height = 0, int xslop = 0, int yslop = 0) : bitmap32_t(k_bitmap_format, width, height, xslop, yslop) { }
@@ -332,9 +343,9 @@ public:
 // BITMAP_FORMAT_IND64 bitmaps
 class bitmap_ind64 : public bitmap64_t
 {
-	static const bitmap_format k_bitmap_format = BITMAP_FORMAT_IND64;
-
 public:
+	static constexpr bitmap_format k_bitmap_format = BITMAP_FORMAT_IND64;
+
 	// construction/destruction
 	bitmap_ind64(bitmap_ind64 &&) = default;
 	bitmap_ind64(int width = 0, int height = 0, int xslop = 0, int yslop = 0) : bitmap64_t(k_bitmap_format, width, height, xslop, yslop) { }
@@ -355,9 +366,9 @@ public:
 // BITMAP_FORMAT_YUY16 bitmaps
 class bitmap_yuy16 : public bitmap16_t
 {
-	static const bitmap_format k_bitmap_format = BITMAP_FORMAT_YUY16;
-
 public:
+	static constexpr bitmap_format k_bitmap_format = BITMAP_FORMAT_YUY16;
+
 	// construction/destruction
 	bitmap_yuy16(bitmap_yuy16 &&) = default;
 	bitmap_yuy16(int width = 0, int height = 0, int xslop = 0, int yslop = 0) : bitmap16_t(k_bitmap_format, width, height, xslop, yslop) { }
@@ -375,9 +386,9 @@ public:
 // BITMAP_FORMAT_RGB32 bitmaps
 class bitmap_rgb32 : public bitmap32_t
 {
-	static const bitmap_format k_bitmap_format = BITMAP_FORMAT_RGB32;
-
 public:
+	static constexpr bitmap_format k_bitmap_format = BITMAP_FORMAT_RGB32;
+
 	// construction/destruction
 	bitmap_rgb32(bitmap_rgb32 &&) = default;
 	bitmap_rgb32(int width = 0, int height = 0, int xslop = 0, int yslop = 0) : bitmap32_t(k_bitmap_format, width, height, xslop, yslop) { }
@@ -395,9 +406,9 @@ public:
 // BITMAP_FORMAT_ARGB32 bitmaps
 class bitmap_argb32 : public bitmap32_t
 {
-	static const bitmap_format k_bitmap_format = BITMAP_FORMAT_ARGB32;
-
 public:
+	static constexpr bitmap_format k_bitmap_format = BITMAP_FORMAT_ARGB32;
+
 	// construction/destruction
 	bitmap_argb32(bitmap_argb32 &&) = default;
 	bitmap_argb32(int width = 0, int height = 0, int xslop = 0, int yslop = 0) : bitmap32_t(k_bitmap_format, width, height, xslop, yslop) { }
@@ -412,4 +423,81 @@ public:
 	bitmap_argb32 &operator=(bitmap_argb32 &&) = default;
 };
 
+
+
+// ======================> bitmap_pool
+
+// recycles bitmaps that are repeatedly created and destroyed at the same size
+class bitmap_pool
+{
+	struct state;
+
+	struct key
+	{
+		bitmap_format   format;
+		int             width;
+		int             height;
+		int             xslop;
+		int             yslop;
+		bool            aligned;
+
+		bool operator==(const key &that) const
+		{
+			return (format == that.format) && (width == that.width) && (height == that.height) && (xslop == that.xslop) && (yslop == that.yslop) && (aligned == that.aligned);
+		}
+	};
+
+	using destroy_func = void (*)(bitmap_t *);
+	using owned_bitmap = std::unique_ptr<bitmap_t, destroy_func>;
+
+public:
+	// deleter that hands the bitmap back to its pool, or frees it if the pool is gone or full
+	class releaser
+	{
+	public:
+		releaser() = default;
+		void operator()(bitmap_t *bitmap) const;
+
+	private:
+		friend class bitmap_pool;
+		releaser(const std::shared_ptr<state> &pool, const key &k, destroy_func destroy) : m_pool(pool), m_key(k), m_destroy(destroy) { }
+
+		std::weak_ptr<state>    m_pool;
+		key                     m_key = { BITMAP_FORMAT_INVALID, 0, 0, 0, 0, false };
+		destroy_func            m_destroy = nullptr;
+	};
+
+	template <typename BitmapType> using ptr = std::unique_ptr<BitmapType, releaser>;
+
+	// construction/destruction
+	bitmap_pool(std::size_t limit = 16);
+	~bitmap_pool();
+
+	// get a cleared bitmap; don't resize or re-allocate it while it's checked out
+	template <typename BitmapType>
+	ptr<BitmapType> acquire(int width, int height, int xslop = 0, int yslop = 0, bool aligned = false)
+	{
+		key const k = { BitmapType::k_bitmap_format, width, height, xslop, yslop, aligned };
+		destroy_func const destroy = [] (bitmap_t *bitmap) { delete static_cast<BitmapType *>(bitmap); };
+		owned_bitmap bitmap = take(k);
+		if (!bitmap)
+		{
+			auto fresh = std::make_unique<BitmapType>();
+			fresh->set_aligned_rows(aligned);
+			fresh->allocate(width, height, xslop, yslop);
+			bitmap = owned_bitmap(fresh.release(), destroy);
+		}
+		return ptr<BitmapType>(static_cast<BitmapType *>(bitmap.release()), releaser(m_state, k, destroy));
+	}
+
+	// free everything that isn't checked out
+	void purge();
+	std::size_t free_count() const;
+
+private:
+	owned_bitmap take(const key &k);
+
+	std::shared_ptr<state> m_state;
+};
+
 #endif // MAME_UTIL_BITMAP_H
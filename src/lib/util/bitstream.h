@@ -39,7 +39,7 @@ public:
 
 private:
 	// internal state
-	uint32_t          m_buffer;       // current bit accumulator
+	uint64_t          m_buffer;       // current bit accumulator
 	int             m_bits;         // number of bits in the accumulator
 	const uint8_t *   m_read;         // read pointer
 	uint32_t          m_doffset;      // byte offset within the data
@@ -103,17 +103,34 @@ inline uint32_t bitstream_in::peek(int numbits)
 	// fetch data if we need more
 	if (numbits > m_bits)
 	{
-		while (m_bits <= 24)
+		if ((m_doffset + 8) <= m_dlength)
 		{
-			if (m_doffset < m_dlength)
-				m_buffer |= m_read[m_doffset] << (24 - m_bits);
-			m_doffset++;
-			m_bits += 8;
+			// away from the end, load eight bytes at once and keep as many
+			// whole bytes as fit; bits below m_bits are the same data, so
+			// reloading them later does no harm
+			const uint8_t *const src = &m_read[m_doffset];
+			uint64_t const data =
+					(uint64_t(src[0]) << 56) | (uint64_t(src[1]) << 48) | (uint64_t(src[2]) << 40) | (uint64_t(src[3]) << 32) |
+					(uint64_t(src[4]) << 24) | (uint64_t(src[5]) << 16) | (uint64_t(src[6]) << 8) | uint64_t(src[7]);
+			m_buffer |= data >> m_bits;
+			int const bytes = (63 - m_bits) >> 3;
+			m_doffset += bytes;
+			m_bits += bytes << 3;
+		}
+		else
+		{
+			while (m_bits <= 56)
+			{
+				if (m_doffset < m_dlength)
+					m_buffer |= uint64_t(m_read[m_doffset]) << (56 - m_bits);
+				m_doffset++;
+				m_bits += 8;
+			}
 		}
 	}
 
 	// return the data
-	return m_buffer >> (32 - numbits);
+	return uint32_t(m_buffer >> (64 - numbits));
 }
 
 
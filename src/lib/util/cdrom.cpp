@@ -270,6 +270,9 @@ cdrom_file::cdrom_file(chd_file *_chd)
 	if (err)
 		throw nullptr;
 
+	/* data and audio are streamed, so decompress hunks ahead of the drive */
+	chd->set_hunk_cache(64, 16);
+
 	LOG(("CD has %d tracks\n", cdtoc.numtrks));
 
 	/* calculate the starting frame for each track, keeping in mind that CHDMAN
@@ -576,6 +579,41 @@ bool cdrom_file::read_subcode(uint32_t lbasector, void *buffer, bool phys)
 }
 
 
+/*-------------------------------------------------
+    prefetch - start decompressing sectors
+    that are about to be read
+-------------------------------------------------*/
+
+/**
+ * @fn  void prefetch(uint32_t lbasector, uint32_t count, bool phys)
+ *
+ * @brief   Queue background decompression of the CHD hunks holding a
+ *          range of sectors, so a later read_data() doesn't block on them.
+ *          Call it when a seek or read command is issued.
+ *
+ * @param   lbasector       The first sector.
+ * @param   count           The number of sectors.
+ * @param   phys            true to physical.
+ */
+
+void cdrom_file::prefetch(uint32_t lbasector, uint32_t count, bool phys)
+{
+	if (chd == nullptr || count == 0)
+		return;
+
+	// compute CHD sector and tracknumber, as read_partial_sector would
+	uint32_t tracknum = 0;
+	uint32_t chdsector = phys ? physical_to_chd_lba(lbasector, tracknum) : logical_to_chd_lba(lbasector, tracknum);
+	if (!phys && cdtoc.tracks[tracknum].pgdatasize != 0)
+		chdsector += cdtoc.tracks[tracknum].pregap;
+
+	uint32_t const framesperhunk = chd->hunk_bytes() / FRAME_SIZE;
+	uint32_t const first = chdsector / framesperhunk;
+	uint32_t const last = (uint64_t(chdsector) + count - 1) / framesperhunk;
+	chd->prefetch(first, last - first + 1);
+}
+
+
 
 /***************************************************************************
     HANDY UTILITIES
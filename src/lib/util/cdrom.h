@@ -123,6 +123,7 @@ public:
 	/* core read access */
 	bool read_data(uint32_t lbasector, void *buffer, uint32_t datatype, bool phys=false);
 	bool read_subcode(uint32_t lbasector, void *buffer, bool phys=false);
+	void prefetch(uint32_t lbasector, uint32_t count, bool phys=false);
 
 	/* handy utilities */
 	uint32_t get_track(uint32_t frame) const;
@@ -21,6 +21,7 @@
 
 #include <zlib.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdlib>
@@ -194,6 +195,7 @@ inline void chd_file::file_read(uint64_t offset, void *dest, uint32_t length)
 		throw std::error_condition(error::NOT_OPEN);
 
 	// seek and read
+	std::lock_guard<std::mutex> lock(m_file_mutex);
 	m_file->seek(offset, SEEK_SET);
 	size_t count;
 	std::error_condition err = m_file->read(dest, length, count);
@@ -216,6 +218,7 @@ inline void chd_file::file_write(uint64_t offset, const void *source, uint32_t l
 		throw std::error_condition(error::NOT_OPEN);
 
 	// seek and write
+	std::lock_guard<std::mutex> lock(m_file_mutex);
 	m_file->seek(offset, SEEK_SET);
 	size_t count;
 	std::error_condition err = m_file->write(source, length, count);
@@ -241,6 +244,7 @@ inline uint64_t chd_file::file_append(const void *source, uint32_t length, uint3
 		throw std::error_condition(error::NOT_OPEN);
 
 	// seek to the end and align if necessary
+	std::lock_guard<std::mutex> lock(m_file_mutex);
 	err = m_file->seek(0, SEEK_END);
 	if (err)
 		throw err;
@@ -830,6 +834,15 @@ std::error_condition chd_file::open(util::random_read_write::ptr &&file, bool wr
 
 void chd_file::close()
 {
+	// the read-ahead workers need the file
+	stop_read_ahead();
+	m_hunk_cache_map.clear();
+	m_hunk_cache.clear();
+	m_hunk_decoders.clear();
+	m_read_ahead = 0;
+	m_last_hunk = ~0U;
+	m_sequential = 0;
+
 	// reset file characteristics
 	m_file.reset();
 	m_allow_reads = false;
@@ -893,6 +906,326 @@ void chd_file::close()
  */
 
 std::error_condition chd_file::read_hunk(uint32_t hunknum, void *buffer)
+{
+	// without a cache, go straight to the file
+	if (m_hunk_cache.empty() || !buffer || (hunknum >= m_hunkcount))
+		return read_hunk_uncached(hunknum, buffer);
+
+	std::error_condition err;
+	if (!hunk_cache_lookup(hunknum, buffer))
+	{
+		err = read_hunk_uncached(hunknum, buffer);
+		if (!err)
+			hunk_cache_store(hunknum, buffer);
+	}
+	queue_read_ahead(hunknum);
+	return err;
+}
+
+/**
+ * @fn  void chd_file::set_hunk_cache(uint32_t hunks, uint32_t readahead)
+ *
+ * @brief   -------------------------------------------------
+ *            set_hunk_cache - keep the given number of
+ *            decompressed hunks, and when hunks are read
+ *            sequentially, decompress the following ones
+ *            on worker threads
+ *          -------------------------------------------------.
+ *
+ * @param   hunks       Number of hunks to cache, or 0 to disable the cache.
+ * @param   readahead   Number of hunks to read ahead, limited to half the cache.
+ */
+
+void chd_file::set_hunk_cache(uint32_t hunks, uint32_t readahead)
+{
+	stop_read_ahead();
+	m_hunk_cache_map.clear();
+	m_hunk_cache.clear();
+	m_hunk_decoders.clear();
+	m_read_ahead = 0;
+	m_last_hunk = ~0U;
+	m_sequential = 0;
+	if (!m_file || !hunks)
+		return;
+
+	m_hunk_cache.resize(hunks);
+	for (hunk_cache_entry &entry : m_hunk_cache)
+	{
+		entry.owner = this;
+		entry.hunknum = ~0U;
+		entry.status = hunk_cache_entry::state::EMPTY;
+		entry.lastuse = 0;
+		entry.data.resize(m_hunkbytes);
+	}
+
+	// read-ahead decodes v5 hunks with its own decompressors; it always decodes to a buffer, so A/V
+	// hunks come out in the raw layout, which doesn't depend on any reader's codec configuration
+	if (readahead && (m_version == 5) && !m_allow_writes)
+	{
+		m_read_ahead_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+		if (m_read_ahead_queue)
+			m_read_ahead = std::min(readahead, hunks / 2);
+	}
+}
+
+//-------------------------------------------------
+//  hunk_cache_lookup - copy a hunk from the cache,
+//  waiting for it if it is being read ahead
+//-------------------------------------------------
+
+bool chd_file::hunk_cache_lookup(uint32_t hunknum, void *buffer)
+{
+	std::unique_lock<std::mutex> lock(m_hunk_cache_mutex);
+	auto const found = m_hunk_cache_map.find(hunknum);
+	if (found == m_hunk_cache_map.end())
+		return false;
+
+	hunk_cache_entry &entry = *found->second;
+	m_hunk_cache_ready.wait(lock, [&entry] () { return entry.status != hunk_cache_entry::state::PENDING; });
+	if (entry.status != hunk_cache_entry::state::READY)
+	{
+		// the read-ahead failed, so read it the usual way and report the error properly
+		m_hunk_cache_map.erase(found);
+		entry.status = hunk_cache_entry::state::EMPTY;
+		return false;
+	}
+
+	memcpy(buffer, &entry.data[0], m_hunkbytes);
+	entry.lastuse = ++m_hunk_cache_clock;
+	return true;
+}
+
+//-------------------------------------------------
+//  hunk_cache_victim - find the least recently
+//  used entry that isn't being read ahead; the
+//  cache mutex must be held
+//-------------------------------------------------
+
+chd_file::hunk_cache_entry *chd_file::hunk_cache_victim()
+{
+	hunk_cache_entry *victim = nullptr;
+	for (hunk_cache_entry &entry : m_hunk_cache)
+	{
+		if (entry.status == hunk_cache_entry::state::EMPTY)
+			return &entry;
+		if ((entry.status != hunk_cache_entry::state::PENDING) && (!victim || (entry.lastuse < victim->lastuse)))
+			victim = &entry;
+	}
+	if (victim)
+		m_hunk_cache_map.erase(victim->hunknum);
+	return victim;
+}
+
+//-------------------------------------------------
+//  hunk_cache_store - add a freshly read hunk to
+//  the cache
+//-------------------------------------------------
+
+void chd_file::hunk_cache_store(uint32_t hunknum, const void *buffer)
+{
+	std::lock_guard<std::mutex> lock(m_hunk_cache_mutex);
+	if (m_hunk_cache_map.find(hunknum) != m_hunk_cache_map.end())
+		return;
+
+	hunk_cache_entry *const entry = hunk_cache_victim();
+	if (!entry)
+		return;
+	entry->hunknum = hunknum;
+	entry->status = hunk_cache_entry::state::READY;
+	entry->lastuse = ++m_hunk_cache_clock;
+	memcpy(&entry->data[0], buffer, m_hunkbytes);
+	m_hunk_cache_map.emplace(hunknum, entry);
+}
+
+//-------------------------------------------------
+//  hunk_cache_invalidate - drop a hunk that is
+//  about to be overwritten
+//-------------------------------------------------
+
+void chd_file::hunk_cache_invalidate(uint32_t hunknum)
+{
+	std::unique_lock<std::mutex> lock(m_hunk_cache_mutex);
+	auto const found = m_hunk_cache_map.find(hunknum);
+	if (found == m_hunk_cache_map.end())
+		return;
+
+	hunk_cache_entry &entry = *found->second;
+	m_hunk_cache_ready.wait(lock, [&entry] () { return entry.status != hunk_cache_entry::state::PENDING; });
+	m_hunk_cache_map.erase(found);
+	entry.status = hunk_cache_entry::state::EMPTY;
+}
+
+//-------------------------------------------------
+//  queue_read_ahead - once reads look sequential,
+//  start decompressing the hunks that follow
+//-------------------------------------------------
+
+void chd_file::queue_read_ahead(uint32_t hunknum)
+{
+	if (!m_read_ahead)
+		return;
+
+	// only read ahead for a run of sequential reads
+	if (hunknum == m_last_hunk + 1)
+		m_sequential++;
+	else if (hunknum != m_last_hunk)
+		m_sequential = 0;
+	m_last_hunk = hunknum;
+	if (m_sequential < 2)
+		return;
+
+	prefetch(hunknum + 1, m_read_ahead);
+}
+
+//-------------------------------------------------
+//  prefetch - queue background decompression of
+//  a range of hunks, as far as the cache allows;
+//  does nothing without a read-ahead pool
+//-------------------------------------------------
+
+void chd_file::prefetch(uint32_t hunknum, uint32_t count)
+{
+	if (!m_read_ahead || !count || hunknum >= m_hunkcount)
+		return;
+
+	uint32_t const last = std::min<uint64_t>(uint64_t(hunknum) + std::min(count, m_read_ahead) - 1, m_hunkcount - 1);
+	for (uint32_t next = hunknum; next <= last; next++)
+	{
+		hunk_cache_entry *entry;
+		{
+			std::lock_guard<std::mutex> lock(m_hunk_cache_mutex);
+			if (m_hunk_cache_map.find(next) != m_hunk_cache_map.end())
+				continue;
+			entry = hunk_cache_victim();
+			if (!entry)
+				break;
+			entry->hunknum = next;
+			entry->status = hunk_cache_entry::state::PENDING;
+			entry->lastuse = m_hunk_cache_clock;
+			m_hunk_cache_map.emplace(next, entry);
+		}
+		if (!osd_work_item_queue(m_read_ahead_queue, &chd_file::read_ahead_callback, entry, WORK_ITEM_FLAG_AUTO_RELEASE))
+		{
+			std::lock_guard<std::mutex> lock(m_hunk_cache_mutex);
+			m_hunk_cache_map.erase(next);
+			entry->status = hunk_cache_entry::state::EMPTY;
+			break;
+		}
+	}
+}
+
+//-------------------------------------------------
+//  stop_read_ahead - wait for outstanding reads
+//  and shut down the worker pool
+//-------------------------------------------------
+
+void chd_file::stop_read_ahead()
+{
+	if (m_read_ahead_queue)
+	{
+		osd_work_queue_wait(m_read_ahead_queue, osd_ticks_per_second() * 100);
+		osd_work_queue_free(m_read_ahead_queue);
+		m_read_ahead_queue = nullptr;
+	}
+}
+
+//-------------------------------------------------
+//  read_ahead_hunk - decompress a v5 hunk on a
+//  worker thread; hunks that refer to other hunks
+//  or the parent are left for the reader
+//-------------------------------------------------
+
+bool chd_file::read_ahead_hunk(hunk_decoder &decoder, uint32_t hunknum, uint8_t *dest)
+{
+	try
+	{
+		uint8_t const *const rawmap = &m_rawmap[m_mapentrybytes * hunknum];
+		if (!compressed())
+		{
+			uint64_t const blockoffs = uint64_t(be_read(rawmap, 4)) * uint64_t(m_hunkbytes);
+			if (blockoffs == 0)
+				return false;
+			file_read(blockoffs, dest, m_hunkbytes);
+			return true;
+		}
+
+		uint32_t const blocklen = be_read(&rawmap[1], 3);
+		uint64_t const blockoffs = be_read(&rawmap[4], 6);
+		util::crc16_t const blockcrc = be_read(&rawmap[10], 2);
+		switch (rawmap[0])
+		{
+			case COMPRESSION_TYPE_0:
+			case COMPRESSION_TYPE_1:
+			case COMPRESSION_TYPE_2:
+			case COMPRESSION_TYPE_3:
+				file_read(blockoffs, &decoder.compressed[0], blocklen);
+				decoder.decompressor[rawmap[0]]->decompress(&decoder.compressed[0], blocklen, dest, m_hunkbytes);
+				if (decoder.decompressor[rawmap[0]]->lossy())
+					return util::crc16_creator::simple(&decoder.compressed[0], blocklen) == blockcrc;
+				return util::crc16_creator::simple(dest, m_hunkbytes) == blockcrc;
+
+			case COMPRESSION_NONE:
+				file_read(blockoffs, dest, m_hunkbytes);
+				return util::crc16_creator::simple(dest, m_hunkbytes) == blockcrc;
+		}
+	}
+	catch (...)
+	{
+	}
+	return false;
+}
+
+void *chd_file::read_ahead_callback(void *param, int threadid)
+{
+	hunk_cache_entry &entry = *reinterpret_cast<hunk_cache_entry *>(param);
+	chd_file &chd = *entry.owner;
+
+	// get an idle set of decompressors, or make a new one
+	std::unique_ptr<hunk_decoder> decoder;
+	{
+		std::lock_guard<std::mutex> lock(chd.m_hunk_cache_mutex);
+		if (!chd.m_hunk_decoders.empty())
+		{
+			decoder = std::move(chd.m_hunk_decoders.back());
+			chd.m_hunk_decoders.pop_back();
+		}
+	}
+	if (!decoder)
+	{
+		decoder = std::make_unique<hunk_decoder>();
+		for (int decompnum = 0; decompnum < std::size(chd.m_compression); decompnum++)
+			if (chd.m_compression[decompnum] != 0)
+				decoder->decompressor[decompnum] = chd_codec_list::new_decompressor(chd.m_compression[decompnum], chd);
+		decoder->compressed.resize(chd.m_hunkbytes);
+	}
+
+	// the entry is left alone while it is pending, so it can be filled without the lock
+	bool const ok = chd.read_ahead_hunk(*decoder, entry.hunknum, &entry.data[0]);
+
+	{
+		std::lock_guard<std::mutex> lock(chd.m_hunk_cache_mutex);
+		entry.status = ok ? hunk_cache_entry::state::READY : hunk_cache_entry::state::FAILED;
+		chd.m_hunk_decoders.emplace_back(std::move(decoder));
+	}
+	chd.m_hunk_cache_ready.notify_all();
+	return nullptr;
+}
+
+/**
+ * @fn  std::error_condition chd_file::read_hunk_uncached(uint32_t hunknum, void *buffer)
+ *
+ * @brief   -------------------------------------------------
+ *            read_hunk_uncached - decompress a single hunk
+ *            from the CHD file
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum         The hunknum.
+ * @param [in,out]  buffer  If non-null, the buffer.
+ *
+ * @return  The hunk.
+ */
+
+std::error_condition chd_file::read_hunk_uncached(uint32_t hunknum, void *buffer)
 {
 	// wrap this for clean reporting
 	try
@@ -1057,6 +1390,10 @@ std::error_condition chd_file::write_hunk(uint32_t hunknum, const void *buffer)
 		if (compressed())
 			throw std::error_condition(error::FILE_NOT_WRITEABLE);
 
+		// don't let the hunk cache return the old data
+		if (!m_hunk_cache.empty())
+			hunk_cache_invalidate(hunknum);
+
 		// see if we have allocated the space on disk for this hunk
 		uint8_t *rawmap = &m_rawmap[hunknum * 4];
 		uint32_t rawentry = be_read(rawmap, 4);
@@ -2773,11 +3110,15 @@ chd_file_compressor::chd_file_compressor()
 	: m_walking_parent(false),
 		m_total_in(0),
 		m_total_out(0),
+		m_self_hunks(0),
+		m_parent_hunks(0),
 		m_read_queue(nullptr),
 		m_read_queue_offset(0),
 		m_read_done_offset(0),
 		m_read_error(false),
 		m_work_queue(nullptr),
+		m_work_hunks(0),
+		m_read_hunks(0),
 		m_write_hunk(0)
 {
 	// zap arrays
@@ -2822,6 +3163,8 @@ void chd_file_compressor::compress_begin()
 	m_total_in = 0;
 	m_total_out = 0;
 	m_compsha1.reset();
+	m_self_hunks = 0;
+	m_parent_hunks = 0;
 
 	// reset our maps
 	m_parent_map.reset();
@@ -2832,16 +3175,23 @@ void chd_file_compressor::compress_begin()
 	m_read_done_offset = 0;
 	m_read_error = false;
 
+	// size the work buffer by bytes rather than hunks, so small hunks still
+	// keep every thread busy and large ones don't run away with memory
+	m_work_hunks = std::clamp<uint32_t>(WORK_BUFFER_BYTES / hunk_bytes(), WORK_BUFFER_MIN_HUNKS, WORK_BUFFER_MAX_HUNKS);
+	m_work_hunks -= m_work_hunks % READ_CHUNKS;
+	m_read_hunks = m_work_hunks / READ_CHUNKS;
+
 	// reset work item state
-	m_work_buffer.resize(hunk_bytes() * (WORK_BUFFER_HUNKS + 1));
+	m_work_buffer.resize(size_t(hunk_bytes()) * (m_work_hunks + 1));
 	memset(&m_work_buffer[0], 0, m_work_buffer.size());
-	m_compressed_buffer.resize(hunk_bytes() * WORK_BUFFER_HUNKS);
-	for (int itemnum = 0; itemnum < WORK_BUFFER_HUNKS; itemnum++)
+	m_compressed_buffer.resize(size_t(hunk_bytes()) * m_work_hunks);
+	m_work_item = std::make_unique<work_item []>(m_work_hunks);
+	for (uint32_t itemnum = 0; itemnum < m_work_hunks; itemnum++)
 	{
 		work_item &item = m_work_item[itemnum];
 		item.m_compressor = this;
-		item.m_data = &m_work_buffer[hunk_bytes() * itemnum];
-		item.m_compressed = &m_compressed_buffer[hunk_bytes() * itemnum];
+		item.m_data = &m_work_buffer[size_t(hunk_bytes()) * itemnum];
+		item.m_compressed = &m_compressed_buffer[size_t(hunk_bytes()) * itemnum];
 		item.m_hash.resize(hunk_bytes() / unit_bytes());
 	}
 
@@ -2875,15 +3225,16 @@ std::error_condition chd_file_compressor::compress_continue(double &progress, do
 	if (m_read_error)
 		return std::errc::io_error;
 
-	// if done reading, queue some more
-	while (m_read_queue_offset < m_logicalbytes && osd_work_queue_items(m_read_queue) < 2)
+	// queue reads for as many chunks of the work buffer as are free; the
+	// buffer size bounds how much data can be in flight
+	while (m_read_queue_offset < source_bytes())
 	{
-		// see if we have enough free work items to read the next half of a buffer
+		// see if we have enough free work items to read the next chunk
 		uint32_t startitem = m_read_queue_offset / hunk_bytes();
-		uint32_t enditem = startitem + WORK_BUFFER_HUNKS / 2;
+		uint32_t enditem = startitem + m_read_hunks;
 		uint32_t curitem;
 		for (curitem = startitem; curitem < enditem; curitem++)
-			if (m_work_item[curitem % WORK_BUFFER_HUNKS].m_status != WS_READY)
+			if (m_work_item[curitem % m_work_hunks].m_status != WS_READY)
 				break;
 
 		// if it's not all clear, defer
@@ -2892,33 +3243,42 @@ std::error_condition chd_file_compressor::compress_continue(double &progress, do
 
 		// if we're walking the parent, we want one more item to have cleared so we
 		// can read an extra hunk there
-		if (m_walking_parent && m_work_item[curitem % WORK_BUFFER_HUNKS].m_status != WS_READY)
+		if (m_walking_parent && m_work_item[curitem % m_work_hunks].m_status != WS_READY)
 			break;
 
 		// queue the next read
 		for (curitem = startitem; curitem < enditem; curitem++)
-			m_work_item[curitem % WORK_BUFFER_HUNKS].m_status = WS_READING;
+			m_work_item[curitem % m_work_hunks].m_status = WS_READING;
 		osd_work_item_queue(m_read_queue, async_read_static, this, WORK_ITEM_FLAG_AUTO_RELEASE);
-		m_read_queue_offset += WORK_BUFFER_HUNKS * hunk_bytes() / 2;
+		m_read_queue_offset += uint64_t(m_read_hunks) * hunk_bytes();
 	}
 
 	// flush out any finished items
-	while (m_work_item[m_write_hunk % WORK_BUFFER_HUNKS].m_status == WS_COMPLETE)
+	while (m_work_item[m_write_hunk % m_work_hunks].m_status == WS_COMPLETE)
 	{
-		work_item &item = m_work_item[m_write_hunk % WORK_BUFFER_HUNKS];
+		work_item &item = m_work_item[m_write_hunk % m_work_hunks];
 
 		// free any OSD work item
 		if (item.m_osd != nullptr)
 			osd_work_item_release(item.m_osd);
 		item.m_osd = nullptr;
 
+		// continue the running SHA-1 here rather than on the read thread, so
+		// reading never waits on it
+		if (!m_walking_parent)
+		{
+			uint64_t offset = uint64_t(item.m_hunknum) * hunk_bytes();
+			uint32_t length = std::min<uint64_t>(hunk_bytes(), logical_bytes() - offset);
+			if (compressed())
+				m_compsha1.append(item.m_data, length);
+			m_total_in += length;
+		}
+
 		// for parent walking, just add to the hashmap
 		if (m_walking_parent)
 		{
 			uint32_t uph = hunk_bytes() / unit_bytes();
-			uint32_t units = uph;
-			if (item.m_hunknum == hunk_count() - 1 || !compressed())
-				units = 1;
+			uint32_t units = parent_units(item.m_hunknum);
 			for (uint32_t unit = 0; unit < units; unit++)
 				if (m_parent_map.find(item.m_hash[unit].m_crc16, item.m_hash[unit].m_sha1) == hashmap::NOT_FOUND)
 					m_parent_map.add(item.m_hunknum * uph + unit, item.m_hash[unit].m_crc16, item.m_hash[unit].m_sha1);
@@ -2947,6 +3307,7 @@ std::error_condition chd_file_compressor::compress_continue(double &progress, do
 			if (selfhunk != hashmap::NOT_FOUND)
 			{
 				hunk_copy_from_self(item.m_hunknum, selfhunk);
+				m_self_hunks++;
 				break;
 			}
 
@@ -2957,6 +3318,7 @@ std::error_condition chd_file_compressor::compress_continue(double &progress, do
 				if (parentunit != hashmap::NOT_FOUND)
 				{
 					hunk_copy_from_parent(item.m_hunknum, parentunit);
+					m_parent_hunks++;
 					break;
 				}
 			}
@@ -2972,7 +3334,7 @@ std::error_condition chd_file_compressor::compress_continue(double &progress, do
 		m_write_hunk++;
 
 		// if we hit the end, finalize
-		if (m_write_hunk == m_hunkcount)
+		if (m_write_hunk == source_hunks())
 		{
 			// if this is just walking the parent, reset and get ready for compression
 			if (m_walking_parent)
@@ -2980,8 +3342,8 @@ std::error_condition chd_file_compressor::compress_continue(double &progress, do
 				m_walking_parent = false;
 				m_read_queue_offset = m_read_done_offset = 0;
 				m_write_hunk = 0;
-				for (auto & elem : m_work_item)
-					elem.m_status = WS_READY;
+				for (uint32_t itemnum = 0; itemnum < m_work_hunks; itemnum++)
+					m_work_item[itemnum].m_status = WS_READY;
 			}
 
 			// wait for all reads to finish and if we're compressed, write the final SHA1 and map
@@ -2998,17 +3360,17 @@ std::error_condition chd_file_compressor::compress_continue(double &progress, do
 
 	// update progress and ratio
 	if (m_walking_parent)
-		progress = double(m_read_done_offset) / double(logical_bytes());
+		progress = double(m_read_done_offset) / double(source_bytes());
 	else
 		progress = double(m_write_hunk) / double(m_hunkcount);
 	ratio = (m_total_in == 0) ? 1.0 : double(m_total_out) / double(m_total_in);
 
 	// if we're waiting for work, wait
 	// sometimes code can get here with .m_status == WS_READY and .m_osd != nullptr, TODO find out why this happens
-	while (m_work_item[m_write_hunk % WORK_BUFFER_HUNKS].m_status != WS_READY &&
-		m_work_item[m_write_hunk % WORK_BUFFER_HUNKS].m_status != WS_COMPLETE &&
-		m_work_item[m_write_hunk % WORK_BUFFER_HUNKS].m_osd != nullptr)
-		osd_work_item_wait(m_work_item[m_write_hunk % WORK_BUFFER_HUNKS].m_osd, osd_ticks_per_second());
+	while (m_work_item[m_write_hunk % m_work_hunks].m_status != WS_READY &&
+		m_work_item[m_write_hunk % m_work_hunks].m_status != WS_COMPLETE &&
+		m_work_item[m_write_hunk % m_work_hunks].m_osd != nullptr)
+		osd_work_item_wait(m_work_item[m_write_hunk % m_work_hunks].m_osd, osd_ticks_per_second());
 
 	return m_walking_parent ? error::WALKING_PARENT : error::COMPRESSING;
 }
@@ -3043,10 +3405,8 @@ void *chd_file_compressor::async_walk_parent_static(void *param, int threadid)
 
 void chd_file_compressor::async_walk_parent(work_item &item)
 {
-	// compute CRC-16 and SHA-1 hashes for each unit, unless we're the last one or we're uncompressed
-	uint32_t units = hunk_bytes() / unit_bytes();
-	if (item.m_hunknum == m_hunkcount - 1 || !compressed())
-		units = 1;
+	// compute CRC-16 and SHA-1 hashes for each unit a hunk can start at
+	uint32_t units = parent_units(item.m_hunknum);
 	for (uint32_t unit = 0; unit < units; unit++)
 	{
 		item.m_hash[unit].m_crc16 = util::crc16_creator::simple(item.m_data + unit * unit_bytes(), hunk_bytes());
@@ -3055,6 +3415,34 @@ void chd_file_compressor::async_walk_parent(work_item &item)
 	item.m_status = WS_COMPLETE;
 }
 
+/**
+ * @fn  uint32_t chd_file_compressor::parent_units(uint32_t hunknum) const
+ *
+ * @brief   -------------------------------------------------
+ *            parent_units - number of units in a parent
+ *            hunk that can start a full hunk of parent data
+ *          -------------------------------------------------.
+ *
+ * @param   hunknum The hunk number, in our hunk size.
+ *
+ * @return  The number of units to hash.
+ */
+
+uint32_t chd_file_compressor::parent_units(uint32_t hunknum) const
+{
+	// uncompressed CHDs only ever match whole hunks
+	if (!compressed())
+		return 1;
+
+	// otherwise, any unit whose hunk-sized window lies within the parent's
+	// hunks; the tail of its last hunk reads back as stored, so it counts
+	uint64_t base = uint64_t(hunknum) * hunk_bytes();
+	uint64_t parentbytes = uint64_t(m_parent->hunk_count()) * m_parent->hunk_bytes();
+	if (base + hunk_bytes() > parentbytes)
+		return 0;
+	return std::min<uint64_t>(hunk_bytes() / unit_bytes(), (parentbytes - base - hunk_bytes()) / unit_bytes() + 1);
+}
+
 /**
  * @fn  void *chd_file_compressor::async_compress_hunk_static(void *param, int threadid)
  *
@@ -3096,7 +3484,6 @@ void chd_file_compressor::async_compress_hunk(work_item &item, int threadid)
 
 	// find the best compression scheme, unless we already have a self or parent match
 	// (note we may miss a self match from blocks not yet added, but this just results in extra work)
-	// TODO: data race
 	if (m_current_map.find(item.m_hash[0].m_crc16, item.m_hash[0].m_sha1) == hashmap::NOT_FOUND &&
 		m_parent_map.find(item.m_hash[0].m_crc16, item.m_hash[0].m_sha1) == hashmap::NOT_FOUND)
 		item.m_compression = item.m_codecs->find_best_compressor(item.m_data, item.m_compressed, item.m_complen);
@@ -3137,28 +3524,30 @@ void chd_file_compressor::async_read()
 		return;
 
 	// determine parameters for the read
-	uint32_t work_buffer_bytes = WORK_BUFFER_HUNKS * hunk_bytes();
-	uint32_t numbytes = work_buffer_bytes / 2;
-	if (m_read_done_offset + numbytes > logical_bytes())
-		numbytes = logical_bytes() - m_read_done_offset;
+	uint64_t work_buffer_bytes = uint64_t(m_work_hunks) * hunk_bytes();
+	uint32_t numbytes = m_read_hunks * hunk_bytes();
+	if (m_read_done_offset + numbytes > source_bytes())
+		numbytes = source_bytes() - m_read_done_offset;
 
 	// catch any exceptions coming out of here
 	try
 	{
 		// do the read
 		uint8_t *dest = &m_work_buffer[0] + (m_read_done_offset % work_buffer_bytes);
-		assert(dest == &m_work_buffer[0] || dest == &m_work_buffer[work_buffer_bytes/2]);
+		assert((dest - &m_work_buffer[0]) % (m_read_hunks * hunk_bytes()) == 0);
 		uint64_t end_offset = m_read_done_offset + numbytes;
 
-		// if walking the parent, read in hunks from the parent CHD
+		// if walking the parent, read its data in our own hunk size, plus one
+		// extra hunk so hashes starting at any unit have the full window; the
+		// parent's hunk layout doesn't need to match ours
 		if (m_walking_parent)
 		{
-			uint8_t *curdest = dest;
-			for (uint64_t curoffs = m_read_done_offset; curoffs < end_offset + 1; curoffs += hunk_bytes())
-			{
-				m_parent->read_hunk(curoffs / hunk_bytes(), curdest);
-				curdest += hunk_bytes();
-			}
+			uint32_t wantbytes = ((numbytes + hunk_bytes() - 1) / hunk_bytes() + 1) * hunk_bytes();
+			uint32_t readbytes = std::min<uint64_t>(wantbytes, uint64_t(m_parent->hunk_count()) * m_parent->hunk_bytes() - m_read_done_offset);
+			std::error_condition err = m_parent->read_bytes(m_read_done_offset, dest, readbytes);
+			if (err)
+				throw err;
+			memset(dest + readbytes, 0, wantbytes - readbytes);
 		}
 
 		// otherwise, call the virtual function
@@ -3169,21 +3558,13 @@ void chd_file_compressor::async_read()
 		for (uint64_t curoffs = m_read_done_offset; curoffs < end_offset; curoffs += hunk_bytes())
 		{
 			uint32_t hunknum = curoffs / hunk_bytes();
-			work_item &item = m_work_item[hunknum % WORK_BUFFER_HUNKS];
+			work_item &item = m_work_item[hunknum % m_work_hunks];
 			assert(item.m_status == WS_READING);
 			item.m_status = WS_QUEUED;
 			item.m_hunknum = hunknum;
 			item.m_osd = osd_work_item_queue(m_work_queue, m_walking_parent ? async_walk_parent_static : async_compress_hunk_static, &item, 0);
 		}
 
-		// continue the running SHA-1
-		if (!m_walking_parent)
-		{
-			if (compressed())
-				m_compsha1.append(dest, numbytes);
-			m_total_in += numbytes;
-		}
-
 		// advance the read pointer
 		m_read_done_offset += numbytes;
 	}
@@ -3273,6 +3654,7 @@ void chd_file_compressor::hashmap::reset()
 uint64_t chd_file_compressor::hashmap::find(util::crc16_t crc16, util::sha1_t sha1)
 {
 	// look up the entry in the map
+	std::lock_guard<std::mutex> lock(m_mutex);
 	for (entry_t *entry = m_map[crc16]; entry != nullptr; entry = entry->m_next)
 		if (entry->m_sha1 == sha1)
 			return entry->m_itemnum;
@@ -3294,6 +3676,7 @@ uint64_t chd_file_compressor::hashmap::find(util::crc16_t crc16, util::sha1_t sh
 void chd_file_compressor::hashmap::add(uint64_t itemnum, util::crc16_t crc16, util::sha1_t sha1)
 {
 	// add to the appropriate map
+	std::lock_guard<std::mutex> lock(m_mutex);
 	if (m_block_list->m_nextalloc == std::size(m_block_list->m_array))
 		m_block_list = new entry_block(m_block_list);
 	entry_t *entry = &m_block_list->m_array[m_block_list->m_nextalloc++];
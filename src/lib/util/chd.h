@@ -19,9 +19,14 @@
 #include "osdcore.h"
 
 #include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <unordered_map>
+#include <vector>
 
 
 /***************************************************************************
@@ -327,6 +332,12 @@ public:
 	// file close
 	void close();
 
+	// keep the most recently used hunks, decompressing the next ones ahead of sequential reads
+	void set_hunk_cache(uint32_t hunks, uint32_t readahead = 0);
+
+	// start decompressing a range of hunks in the background ahead of a known read
+	void prefetch(uint32_t hunknum, uint32_t count);
+
 	// read/write
 	std::error_condition read_hunk(uint32_t hunknum, void *buffer);
 	std::error_condition write_hunk(uint32_t hunknum, const void *buffer);
@@ -356,6 +367,25 @@ private:
 	struct metadata_entry;
 	struct metadata_hash;
 
+	// a decompressed hunk in the LRU cache
+	struct hunk_cache_entry
+	{
+		enum class state : uint8_t { EMPTY, PENDING, READY, FAILED };
+
+		chd_file *              owner;          // file the hunk belongs to
+		uint32_t                hunknum;        // which hunk this is
+		state                   status;         // whether the data can be used
+		uint64_t                lastuse;        // cache clock at the last use
+		std::vector<uint8_t>    data;           // decompressed hunk
+	};
+
+	// decompressors for reading ahead on a worker thread
+	struct hunk_decoder
+	{
+		chd_decompressor::ptr   decompressor[4];
+		std::vector<uint8_t>    compressed;
+	};
+
 	// inline helpers
 	uint64_t be_read(const uint8_t *base, int numbytes);
 	void be_write(uint8_t *base, uint64_t value, int numbytes);
@@ -371,6 +401,15 @@ private:
 	void parse_v3_header(uint8_t *rawheader, util::sha1_t &parentsha1);
 	void parse_v4_header(uint8_t *rawheader, util::sha1_t &parentsha1);
 	void parse_v5_header(uint8_t *rawheader, util::sha1_t &parentsha1);
+	std::error_condition read_hunk_uncached(uint32_t hunknum, void *buffer);
+	bool hunk_cache_lookup(uint32_t hunknum, void *buffer);
+	void hunk_cache_store(uint32_t hunknum, const void *buffer);
+	void hunk_cache_invalidate(uint32_t hunknum);
+	hunk_cache_entry *hunk_cache_victim();
+	void queue_read_ahead(uint32_t hunknum);
+	void stop_read_ahead();
+	bool read_ahead_hunk(hunk_decoder &decoder, uint32_t hunknum, uint8_t *dest);
+	static void *read_ahead_callback(void *param, int threadid);
 	std::error_condition compress_v5_map();
 	void decompress_v5_map();
 	std::error_condition create_common();
@@ -421,6 +460,19 @@ private:
 	// caching
 	std::vector<uint8_t>    m_cache;            // single-hunk cache for partial reads/writes
 	uint32_t                m_cachehunk;        // which hunk is in the cache?
+
+	// LRU hunk cache and read-ahead
+	std::mutex              m_file_mutex;       // serialises file access with read-ahead
+	std::mutex              m_hunk_cache_mutex; // protects the hunk cache
+	std::condition_variable m_hunk_cache_ready; // signalled when a read-ahead completes
+	std::vector<hunk_cache_entry> m_hunk_cache; // cached hunks
+	std::unordered_map<uint32_t, hunk_cache_entry *> m_hunk_cache_map; // cached hunks by number
+	uint64_t                m_hunk_cache_clock = 0; // incremented on each use
+	uint32_t                m_read_ahead = 0;   // number of hunks to read ahead
+	uint32_t                m_last_hunk = ~0U;  // last hunk read
+	uint32_t                m_sequential = 0;   // number of consecutive sequential reads
+	osd_work_queue *        m_read_ahead_queue = nullptr; // worker pool for reading ahead
+	std::vector<std::unique_ptr<hunk_decoder>> m_hunk_decoders; // idle read-ahead decompressors
 };
 
 
@@ -438,6 +490,10 @@ public:
 	void compress_begin();
 	std::error_condition compress_continue(double &progress, double &ratio);
 
+	// deduplication statistics for the last compression
+	uint32_t self_hunks() const { return m_self_hunks; }
+	uint32_t parent_hunks() const { return m_parent_hunks; }
+
 protected:
 	// required override: read more data
 	virtual uint32_t read_data(void *dest, uint64_t offset, uint32_t length) = 0;
@@ -481,6 +537,7 @@ private:
 		// internal state
 		entry_t *           m_map[65536];           // map, hashed by CRC-16
 		entry_block *       m_block_list;           // list of allocated blocks
+		std::mutex          m_mutex;                // compressor threads look up while the writer adds
 	};
 
 	// status of a given work item
@@ -535,12 +592,17 @@ private:
 	void async_compress_hunk(work_item &item, int threadid);
 	static void *async_read_static(void *param, int threadid);
 	void async_read();
+	uint64_t source_bytes() const { return m_walking_parent ? m_parent->logical_bytes() : m_logicalbytes; }
+	uint32_t source_hunks() const { return (source_bytes() + hunk_bytes() - 1) / hunk_bytes(); }
+	uint32_t parent_units(uint32_t hunknum) const;
 
 	// current compression status
 	bool                    m_walking_parent;   // are we building the parent map?
 	uint64_t                m_total_in;         // total bytes in
 	uint64_t                m_total_out;        // total bytes out
 	util::sha1_creator      m_compsha1;         // running SHA-1 on raw data
+	uint32_t                m_self_hunks;       // hunks stored as copies of earlier hunks
+	uint32_t                m_parent_hunks;     // hunks stored as copies of parent data
 
 	// hash lookup maps
 	hashmap                 m_parent_map;       // hash map for parent
@@ -553,11 +615,16 @@ private:
 	bool                    m_read_error;       // error during reading?
 
 	// work item thread
-	static constexpr int WORK_BUFFER_HUNKS = 256;
+	static constexpr uint32_t WORK_BUFFER_BYTES = 32 * 1024 * 1024; // bound on raw data in flight
+	static constexpr uint32_t WORK_BUFFER_MIN_HUNKS = 64;
+	static constexpr uint32_t WORK_BUFFER_MAX_HUNKS = 16384;
+	static constexpr uint32_t READ_CHUNKS = 8;  // reads in flight per work buffer
 	osd_work_queue *        m_work_queue;       // queue for doing work on other threads
 	std::vector<uint8_t>    m_work_buffer;      // buffer containing hunk data to work on
 	std::vector<uint8_t>    m_compressed_buffer;// buffer containing compressed data
-	work_item               m_work_item[WORK_BUFFER_HUNKS]; // status of each hunk
+	std::unique_ptr<work_item []> m_work_item;  // status of each hunk
+	uint32_t                m_work_hunks;       // number of hunks in the work buffer
+	uint32_t                m_read_hunks;       // number of hunks per read
 	chd_compressor_group *  m_codecs[WORK_MAX_THREADS]; // codecs to use
 
 	// output state
@@ -61,6 +61,7 @@ public:
 	virtual int getc() override { return m_file.getc(); }
 	virtual int ungetc(int c) override { return m_file.ungetc(c); }
 	virtual char *gets(char *s, int n) override { return m_file.gets(s, n); }
+	virtual void const *view() const noexcept override { return m_file.view(); }
 
 	virtual int puts(std::string_view s) override { return m_file.puts(s); }
 	virtual int vprintf(util::format_argument_pack<std::ostream> const &args) override { return m_file.vprintf(args); }
@@ -165,6 +166,14 @@ public:
 		}
 	}
 
+	core_in_memory_file(std::uint32_t openflags, std::shared_ptr<void const> &&mapping, std::size_t length) noexcept
+		: core_basic_file(openflags, length)
+		, m_data_allocated(false)
+		, m_data(mapping.get())
+		, m_mapping(std::move(mapping))
+	{
+	}
+
 	~core_in_memory_file() override { purge(); }
 
 	virtual std::error_condition read(void *buffer, std::size_t length, std::size_t &actual) noexcept override;
@@ -176,6 +185,7 @@ public:
 	virtual std::error_condition write_at(std::uint64_t offset, void const *buffer, std::size_t length, std::size_t &actual) noexcept override { actual = 0; return std::errc::bad_file_descriptor; }
 
 	void const *buffer() const { return m_data; }
+	virtual void const *view() const noexcept override { return m_data; }
 
 	virtual std::error_condition truncate(std::uint64_t offset) override;
 
@@ -199,11 +209,13 @@ protected:
 			free(const_cast<void *>(m_data));
 		m_data_allocated = false;
 		m_data = nullptr;
+		m_mapping.reset();
 	}
 
 private:
 	bool            m_data_allocated;   // was the data allocated by us?
 	void const *    m_data;             // file data, if RAM-based
+	std::shared_ptr<void const> m_mapping; // keeps mapped file data alive
 };
 
 
@@ -227,6 +239,8 @@ public:
 
 	virtual std::error_condition truncate(std::uint64_t offset) override;
 
+	virtual void const *view() const noexcept override { return nullptr; }
+
 protected:
 	bool is_buffered(std::uint64_t offset) const noexcept { return (offset >= m_bufferbase) && (offset < (m_bufferbase + m_bufferbytes)); }
 
@@ -937,6 +951,39 @@ std::error_condition core_file::open_ram_copy(void const *data, std::size_t leng
 }
 
 
+//-------------------------------------------------
+//  open_mapped - open a file read-only, mapping
+//  it into memory if the OSD layer supports it
+//  and falling back to regular file access if not
+//-------------------------------------------------
+
+std::error_condition core_file::open_mapped(std::string_view filename, ptr &file) noexcept
+{
+	// attempt to open the file
+	osd_file::ptr f;
+	std::uint64_t length = 0;
+	auto const filerr = osd_file::open(std::string(filename), OPEN_FLAG_READ, f, length); // FIXME: allow osd_file to accept std::string_view
+	if (filerr)
+		return filerr;
+
+	// map the whole thing if we can address it
+	std::shared_ptr<void const> mapping;
+	if (length && (std::size_t(length) == length) && !f->map(0, std::size_t(length), mapping))
+	{
+		ptr result(new (std::nothrow) core_in_memory_file(OPEN_FLAG_READ, std::move(mapping), std::size_t(length)));
+		if (!result)
+			return std::errc::not_enough_memory;
+		file = std::move(result);
+		return std::error_condition();
+	}
+
+	try { file = std::make_unique<core_osd_file>(OPEN_FLAG_READ, std::move(f), length); }
+	catch (...) { return std::errc::not_enough_memory; }
+
+	return std::error_condition();
+}
+
+
 //-------------------------------------------------
 //  open_proxy - open a proxy to an existing file
 //  object and return an error code
@@ -52,6 +52,9 @@ public:
 	// open a RAM-based "file" using the given data and length (read-only), copying the data
 	static std::error_condition open_ram_copy(const void *data, std::size_t length, std::uint32_t openflags, ptr &file) noexcept;
 
+	// open a file with the specified filename read-only, mapping it into memory where possible
+	static std::error_condition open_mapped(std::string_view filename, ptr &file) noexcept;
+
 	// open a proxy "file" that forwards requests to another file object
 	static std::error_condition open_proxy(core_file &file, ptr &proxy) noexcept;
 
@@ -76,6 +79,9 @@ public:
 	// read a full line of text from the file
 	virtual char *gets(char *s, int n) = 0;
 
+	// get the full contents without copying if the file is held in memory, or nullptr
+	virtual void const *view() const noexcept = 0;
+
 	// open a file with the specified filename, read it into memory, and return a pointer
 	static std::error_condition load(std::string_view filename, void **data, std::uint32_t &length) noexcept;
 	static std::error_condition load(std::string_view filename, std::vector<uint8_t> &data) noexcept;
@@ -18,11 +18,13 @@
 #include <array>
 #include <cstddef>
 #include <iterator>
+#include <memory>
 #include <numeric>
 #include <stdexcept>
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 // ======================> simple_list
 
@@ -314,6 +316,53 @@ private:
 };
 
 
+// ======================> block_allocator
+
+// a block_allocator is like a fixed_allocator, except that objects are carved
+// out of contiguous blocks it owns, so lists churned every frame stay close
+// together in memory; everything it handed out must have been reclaimed by
+// the time it is destroyed
+template<class ItemType, int BlockSize = 256>
+class block_allocator
+{
+	// we don't support deep copying
+	block_allocator(const block_allocator &) = delete;
+	block_allocator &operator=(const block_allocator &) = delete;
+
+public:
+	// construction/destruction
+	block_allocator() { }
+	~block_allocator() { m_freelist.detach_all(); }
+
+	// allocate a new item, recycling an old one if possible and growing by a block if not
+	ItemType *alloc()
+	{
+		ItemType *result = m_freelist.detach_head();
+		if (result == nullptr)
+		{
+			m_blocks.emplace_back(new ItemType[BlockSize]);
+			ItemType *const block = m_blocks.back().get();
+			for (int i = 1; i < BlockSize; i++)
+				m_freelist.append(block[i]);
+			result = &block[0];
+		}
+		return result;
+	}
+
+	// reclaim an item by adding it to the free list
+	void reclaim(ItemType *item) { if (item != nullptr) m_freelist.prepend(*item); }
+	void reclaim(ItemType &item) { m_freelist.prepend(item); }
+
+	// reclaim all items from a list
+	void reclaim_all(simple_list<ItemType> &_list) { m_freelist.prepend_list(_list); }
+
+private:
+	// internal state
+	std::vector<std::unique_ptr<ItemType []> > m_blocks;   // storage for all objects
+	simple_list<ItemType>   m_freelist;     // list of free objects
+};
+
+
 // ======================> contiguous_sequence_wrapper
 
 namespace util {
@@ -13,6 +13,7 @@
 #include "ioprocs.h"
 
 #include <cstdlib>
+#include <cstring>
 
 
 /*-------------------------------------------------
@@ -41,6 +42,11 @@ hard_disk_file::hard_disk_file(chd_file *_chd)
 	/* parse the metadata */
 	if (sscanf(metadata.c_str(), HARD_DISK_METADATA_FORMAT, &hdinfo.cylinders, &hdinfo.heads, &hdinfo.sectors, &hdinfo.sectorbytes) != 4)
 		throw nullptr;
+
+	/* keep recently used hunks, and read ahead of sequential transfers */
+	chd->set_hunk_cache(32, 4);
+
+	m_write_back_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
 }
 
 hard_disk_file::hard_disk_file(util::random_read_write &corefile, uint32_t skipoffs)
@@ -57,6 +63,7 @@ hard_disk_file::hard_disk_file(util::random_read_write &corefile, uint32_t skipo
 	hdinfo.heads = 0;
 	hdinfo.sectors = 0;
 	fileoffset = skipoffs;
+	m_write_back_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
 
 	// attempt to guess geometry in case this is an ATA situation
 	for (uint32_t totalsectors = (length - skipoffs) / hdinfo.sectorbytes; ; totalsectors++)
@@ -83,6 +90,26 @@ hard_disk_file::hard_disk_file(util::random_read_write &corefile, uint32_t skipo
 
 hard_disk_file::~hard_disk_file()
 {
+	flush();
+	if (m_write_back_queue)
+		osd_work_queue_free(m_write_back_queue);
+}
+
+
+/*-------------------------------------------------
+    flush - store everything in the write-back
+    cache and flush the underlying file
+-------------------------------------------------*/
+
+void hard_disk_file::flush()
+{
+	if (m_write_back_queue)
+		while (!osd_work_queue_wait(m_write_back_queue, osd_ticks_per_second() * 10)) { }
+
+	// anything left over was never queued
+	while (write_back_one()) { }
+
+	std::lock_guard<std::mutex> lock(m_io_mutex);
 	if (fhandle)
 		fhandle->flush();
 }
@@ -104,6 +131,24 @@ hard_disk_file::~hard_disk_file()
  */
 
 bool hard_disk_file::read(uint32_t lbasector, void *buffer)
+{
+	// sectors that haven't been stored yet are read back from the cache
+	{
+		std::lock_guard<std::mutex> lock(m_cache_mutex);
+		auto const found = m_dirty.find(lbasector);
+		if (found != m_dirty.end())
+		{
+			std::memcpy(buffer, found->second.data(), found->second.size());
+			return true;
+		}
+	}
+
+	// a sector taken from the cache is only stored with the I/O lock held, so it's seen here
+	std::lock_guard<std::mutex> lock(m_io_mutex);
+	return read_sector(lbasector, buffer);
+}
+
+bool hard_disk_file::read_sector(uint32_t lbasector, void *buffer)
 {
 	if (chd)
 	{
@@ -137,6 +182,81 @@ bool hard_disk_file::read(uint32_t lbasector, void *buffer)
  */
 
 bool hard_disk_file::write(uint32_t lbasector, const void *buffer)
+{
+	// without a worker to store them, sectors are written straight through
+	if (!m_write_back_queue)
+	{
+		std::lock_guard<std::mutex> lock(m_io_mutex);
+		return write_sector(lbasector, buffer);
+	}
+
+	// don't let the cache grow without bound if the host can't keep up
+	bool full;
+	{
+		std::lock_guard<std::mutex> lock(m_cache_mutex);
+		full = m_dirty.size() >= WRITE_BACK_LIMIT;
+	}
+	if (full)
+		while (!osd_work_queue_wait(m_write_back_queue, osd_ticks_per_second() * 10)) { }
+
+	// errors storing sectors are reported when they happen, as the disk has accepted the data
+	std::lock_guard<std::mutex> lock(m_cache_mutex);
+	uint8_t const *const src = reinterpret_cast<uint8_t const *>(buffer);
+	m_dirty[lbasector].assign(src, src + sector_bytes());
+	if (!m_write_back_queued)
+	{
+		m_write_back_queued = osd_work_item_queue(m_write_back_queue, &hard_disk_file::write_back_callback, this, WORK_ITEM_FLAG_AUTO_RELEASE) != nullptr;
+		if (!m_write_back_queued)
+			osd_printf_verbose("hard_disk_file: unable to queue write-back, sectors will be stored on flush\n");
+	}
+	return true;
+}
+
+
+/*-------------------------------------------------
+    write_back_one - store the lowest numbered
+    dirty sector, returning false if none
+-------------------------------------------------*/
+
+bool hard_disk_file::write_back_one()
+{
+	std::lock_guard<std::mutex> io_lock(m_io_mutex);
+	uint32_t lbasector;
+	std::vector<uint8_t> data;
+	{
+		std::lock_guard<std::mutex> cache_lock(m_cache_mutex);
+		auto const first = m_dirty.begin();
+		if (first == m_dirty.end())
+			return false;
+		lbasector = first->first;
+		data = std::move(first->second);
+		m_dirty.erase(first);
+	}
+
+	if (!write_sector(lbasector, data.data()))
+		osd_printf_error("hard_disk_file: error writing sector %u\n", lbasector);
+	return true;
+}
+
+void *hard_disk_file::write_back_callback(void *param, int threadid)
+{
+	hard_disk_file &disk = *reinterpret_cast<hard_disk_file *>(param);
+	while (true)
+	{
+		// check and clear the queued flag together so no write is missed
+		{
+			std::lock_guard<std::mutex> lock(disk.m_cache_mutex);
+			if (disk.m_dirty.empty())
+			{
+				disk.m_write_back_queued = false;
+				return nullptr;
+			}
+		}
+		disk.write_back_one();
+	}
+}
+
+bool hard_disk_file::write_sector(uint32_t lbasector, const void *buffer)
 {
 	if (chd)
 	{
@@ -173,6 +293,9 @@ bool hard_disk_file::write(uint32_t lbasector, const void *buffer)
 
 bool hard_disk_file::set_block_size(uint32_t blocksize)
 {
+	// cached sectors have the old size
+	flush();
+
 	if (chd)
 	{
 		// if the CHD block size matches our block size, we're OK.
@@ -192,6 +315,12 @@ bool hard_disk_file::set_block_size(uint32_t blocksize)
 }
 
 
+uint32_t hard_disk_file::sector_bytes() const
+{
+	return chd ? chd->unit_bytes() : hdinfo.sectorbytes;
+}
+
+
 std::error_condition hard_disk_file::get_inquiry_data(std::vector<uint8_t> &data) const
 {
 	if(chd)
@@ -18,6 +18,10 @@
 
 #include "osdcore.h"
 
+#include <map>
+#include <mutex>
+#include <vector>
+
 
 class hard_disk_file {
 public:
@@ -41,15 +45,33 @@ public:
 	bool read(uint32_t lbasector, void *buffer);
 	bool write(uint32_t lbasector, const void *buffer);
 
+	// store sectors still held by the write-back cache
+	void flush();
+
 	std::error_condition get_inquiry_data(std::vector<uint8_t> &data) const;
 	std::error_condition get_cis_data(std::vector<uint8_t> &data) const;
 	std::error_condition get_disk_key_data(std::vector<uint8_t> &data) const;
 
 private:
+	// sectors waiting to be stored before writes wait for the cache to drain
+	static constexpr size_t WRITE_BACK_LIMIT = 4096;
+
+	uint32_t sector_bytes() const;
+	bool read_sector(uint32_t lbasector, void *buffer);
+	bool write_sector(uint32_t lbasector, const void *buffer);
+	bool write_back_one();
+	static void *write_back_callback(void *param, int threadid);
+
 	chd_file *                  chd;        // CHD file
 	util::random_read_write *   fhandle;    // file if not a CHD
 	info                        hdinfo;     // hard disk info
 	uint32_t                    fileoffset; // offset in the file where the HDD image starts.  not valid for CHDs.
+
+	std::mutex                  m_io_mutex;             // serialises access to the CHD or file
+	std::mutex                  m_cache_mutex;          // protects the write-back cache
+	std::map<uint32_t, std::vector<uint8_t> > m_dirty;  // sectors written but not yet stored
+	bool                        m_write_back_queued = false;
+	osd_work_queue *            m_write_back_queue = nullptr; // stores dirty sectors in the background
 };
 
 #endif // MAME_LIB_UTIL_HARDDISK_H
@@ -18,6 +18,18 @@
 #include <iomanip>
 #include <sstream>
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define SHA1_HW_X86 1
+#define SHA1_HW_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#elif (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#define SHA1_HW_X86 1
+#define SHA1_HW_TARGET
+#endif
+
 
 namespace util {
 
@@ -101,6 +113,117 @@ inline void sha1_process(std::array<uint32_t, 5> &st, uint32_t *data)
 		st[i] += d[i];
 }
 
+
+#if defined(SHA1_HW_X86)
+
+//-------------------------------------------------
+//  sha1_hw_supported - check for the SHA
+//  extensions and the SSE levels they need
+//-------------------------------------------------
+
+bool sha1_hw_supported()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	int regs[4];
+	__cpuid(regs, 0);
+	if (regs[0] < 7)
+		return false;
+	__cpuid(regs, 1);
+	bool const sse = (regs[2] & (1 << 9)) && (regs[2] & (1 << 19));
+	__cpuidex(regs, 7, 0);
+	return sse && (regs[1] & (1 << 29));
+#else
+	unsigned eax, ebx, ecx, edx;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return false;
+	bool const sse = (ecx & (1U << 9)) && (ecx & (1U << 19));
+	if (!sse || !__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+		return false;
+	return ebx & (1U << 29);
+#endif
+}
+
+bool const f_sha1_hw = sha1_hw_supported();
+
+
+//-------------------------------------------------
+//  sha1_hw_group - four rounds using the SHA
+//  extensions, with message schedule updates
+//  interleaved
+//-------------------------------------------------
+
+template <unsigned G>
+SHA1_HW_TARGET inline void sha1_hw_group(__m128i &abcd, __m128i &e0, __m128i &e1, __m128i (&msg)[4])
+{
+	__m128i &enext = (G & 1) ? e1 : e0;
+	__m128i &ecur = (G & 1) ? e0 : e1;
+	if constexpr (G == 0)
+		enext = _mm_add_epi32(enext, msg[0]);
+	else
+		enext = _mm_sha1nexte_epu32(enext, msg[G % 4]);
+	ecur = abcd;
+	if constexpr ((G >= 3) && (G <= 18))
+		msg[(G + 1) % 4] = _mm_sha1msg2_epu32(msg[(G + 1) % 4], msg[G % 4]);
+	abcd = _mm_sha1rnds4_epu32(abcd, enext, G / 5);
+	if constexpr ((G >= 1) && (G <= 16))
+		msg[(G + 3) % 4] = _mm_sha1msg1_epu32(msg[(G + 3) % 4], msg[G % 4]);
+	if constexpr ((G >= 2) && (G <= 17))
+		msg[(G + 2) % 4] = _mm_xor_si128(msg[(G + 2) % 4], msg[G % 4]);
+}
+
+
+//-------------------------------------------------
+//  sha1_hw_process - digest whole blocks straight
+//  from the source data
+//-------------------------------------------------
+
+SHA1_HW_TARGET void sha1_hw_process(std::array<uint32_t, 5> &st, const uint8_t *data, uint32_t blocks)
+{
+	// state is kept as E, D, C, B, A, which conveniently puts A in the top lane
+	__m128i const mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+	__m128i abcd = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&st[1]));
+	__m128i e0 = _mm_set_epi32(st[0], 0, 0, 0);
+	__m128i e1;
+
+	for ( ; blocks; blocks--, data += 64)
+	{
+		__m128i const abcd_save = abcd;
+		__m128i const e0_save = e0;
+		__m128i msg[4];
+		for (int i = 0; i < 4; i++)
+			msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + (i * 16))), mask);
+
+		sha1_hw_group<0>(abcd, e0, e1, msg);
+		sha1_hw_group<1>(abcd, e0, e1, msg);
+		sha1_hw_group<2>(abcd, e0, e1, msg);
+		sha1_hw_group<3>(abcd, e0, e1, msg);
+		sha1_hw_group<4>(abcd, e0, e1, msg);
+		sha1_hw_group<5>(abcd, e0, e1, msg);
+		sha1_hw_group<6>(abcd, e0, e1, msg);
+		sha1_hw_group<7>(abcd, e0, e1, msg);
+		sha1_hw_group<8>(abcd, e0, e1, msg);
+		sha1_hw_group<9>(abcd, e0, e1, msg);
+		sha1_hw_group<10>(abcd, e0, e1, msg);
+		sha1_hw_group<11>(abcd, e0, e1, msg);
+		sha1_hw_group<12>(abcd, e0, e1, msg);
+		sha1_hw_group<13>(abcd, e0, e1, msg);
+		sha1_hw_group<14>(abcd, e0, e1, msg);
+		sha1_hw_group<15>(abcd, e0, e1, msg);
+		sha1_hw_group<16>(abcd, e0, e1, msg);
+		sha1_hw_group<17>(abcd, e0, e1, msg);
+		sha1_hw_group<18>(abcd, e0, e1, msg);
+		sha1_hw_group<19>(abcd, e0, e1, msg);
+
+		e0 = _mm_sha1nexte_epu32(e0, e0_save);
+		abcd = _mm_add_epi32(abcd, abcd_save);
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(&st[1]), abcd);
+	st[0] = uint32_t(_mm_extract_epi32(e0, 3));
+}
+
+#endif // defined(SHA1_HW_X86)
+
 } // anonymous namespace
 
 
@@ -198,6 +321,14 @@ void sha1_creator::append(const void *data, uint32_t length)
 				reinterpret_cast<uint8_t *>(m_buf)[(offset + residual) ^ swizzle] = reinterpret_cast<const uint8_t *>(data)[offset];
 			sha1_process(m_st, m_buf);
 		}
+#if defined(SHA1_HW_X86)
+		if (f_sha1_hw)
+		{
+			uint32_t const blocks = (length - offset) >> 6;
+			sha1_hw_process(m_st, reinterpret_cast<const uint8_t *>(data) + offset, blocks);
+			offset += blocks << 6;
+		}
+#endif
 		while ((length - offset) >= 64U)
 		{
 			for (residual = 0U; residual < 64U; residual++, offset++)
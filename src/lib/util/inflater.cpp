@@ -0,0 +1,537 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles, Vas Crabb
+/***************************************************************************
+
+    inflater.cpp
+
+    Whole-buffer decoder for raw deflate streams.
+
+***************************************************************************/
+
+#include "inflater.h"
+
+#include "osdcomm.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+
+
+namespace util {
+
+namespace {
+
+
+// table entries: value << 16 | type << 8 | extra bits << 4 | code length
+enum : std::uint32_t { INFLATE_LITERAL = 0, INFLATE_LENGTH, INFLATE_END, INFLATE_SUBTABLE, INFLATE_INVALID };
+
+constexpr std::uint32_t inflate_entry(std::uint32_t value, std::uint32_t type, std::uint32_t extra) noexcept
+{
+	return (value << 16) | (type << 8) | (extra << 4);
+}
+
+constexpr std::array<std::uint32_t, 288> make_inflate_litlen_symbols() noexcept
+{
+	constexpr std::uint16_t base[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	constexpr std::uint8_t extra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	std::array<std::uint32_t, 288> result{};
+	for (unsigned i = 0; i < 256; i++)
+		result[i] = inflate_entry(i, INFLATE_LITERAL, 0);
+	result[256] = inflate_entry(0, INFLATE_END, 0);
+	for (unsigned i = 0; i < 29; i++)
+		result[257 + i] = inflate_entry(base[i], INFLATE_LENGTH, extra[i]);
+	result[286] = result[287] = inflate_entry(0, INFLATE_INVALID, 0);
+	return result;
+}
+
+constexpr std::array<std::uint32_t, 32> make_inflate_dist_symbols() noexcept
+{
+	constexpr std::uint16_t base[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	constexpr std::uint8_t extra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+	std::array<std::uint32_t, 32> result{};
+	for (unsigned i = 0; i < 30; i++)
+		result[i] = inflate_entry(base[i], INFLATE_LENGTH, extra[i]);
+	result[30] = result[31] = inflate_entry(0, INFLATE_INVALID, 0);
+	return result;
+}
+
+constexpr std::array<std::uint32_t, 19> make_inflate_precode_symbols() noexcept
+{
+	std::array<std::uint32_t, 19> result{};
+	for (unsigned i = 0; i < 19; i++)
+		result[i] = inflate_entry(i, INFLATE_LITERAL, 0);
+	return result;
+}
+
+constexpr std::array<std::uint32_t, 288> f_inflate_litlen_symbols = make_inflate_litlen_symbols();
+constexpr std::array<std::uint32_t, 32> f_inflate_dist_symbols = make_inflate_dist_symbols();
+constexpr std::array<std::uint32_t, 19> f_inflate_precode_symbols = make_inflate_precode_symbols();
+
+constexpr std::uint32_t entry_value(std::uint32_t e) noexcept { return e >> 16; }
+constexpr std::uint32_t entry_type(std::uint32_t e) noexcept { return (e >> 8) & 0xff; }
+constexpr unsigned entry_extra(std::uint32_t e) noexcept { return (e >> 4) & 0x0f; }
+constexpr unsigned entry_length(std::uint32_t e) noexcept { return e & 0x0f; }
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  inflate - decode a raw deflate stream
+//  that must produce exactly dstlen bytes
+//-------------------------------------------------
+
+bool fast_inflater::inflate(std::uint8_t const *src, std::size_t srclen, std::uint8_t *dst, std::size_t dstlen) noexcept
+{
+	m_in = src;
+	m_end = src + srclen;
+	m_bitbuf = 0;
+	m_bitcount = 0;
+	m_pad = 0;
+
+	std::uint8_t *out = dst;
+	std::uint8_t *const outend = dst + dstlen;
+	bool final;
+	do
+	{
+		refill();
+		final = bool(getbits(1));
+		switch (getbits(2))
+		{
+		case 0:
+			if (!stored_block(out, outend))
+				return false;
+			break;
+		case 1:
+			if (!fixed_tables() || !huffman_block(dst, out, outend))
+				return false;
+			break;
+		case 2:
+			if (!dynamic_tables() || !huffman_block(dst, out, outend))
+				return false;
+			break;
+		default:
+			return false;
+		}
+	}
+	while (!final);
+
+	// everything must be produced without reading past the end of the input
+	return (out == outend) && ((m_pad * 8) <= m_bitcount);
+}
+
+
+//-------------------------------------------------
+//  refill - keep at least 56 bits buffered,
+//  padding with zeroes past the end of the input
+//-------------------------------------------------
+
+inline void fast_inflater::refill() noexcept
+{
+	if ((m_end - m_in) >= 8)
+	{
+		std::uint64_t word;
+		std::memcpy(&word, m_in, 8);
+		m_bitbuf |= little_endianize_int64(word) << m_bitcount;
+		m_in += (63 - m_bitcount) >> 3;
+		m_bitcount |= 56;
+	}
+	else
+	{
+		while (m_bitcount <= 56)
+		{
+			if (m_in < m_end)
+				m_bitbuf |= std::uint64_t(*m_in++) << m_bitcount;
+			else
+				m_pad++;
+			m_bitcount += 8;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  consume - discard bits from the buffer
+//-------------------------------------------------
+
+inline void fast_inflater::consume(unsigned bits) noexcept
+{
+	m_bitbuf >>= bits;
+	m_bitcount -= bits;
+}
+
+
+//-------------------------------------------------
+//  getbits - take bits from the buffer
+//-------------------------------------------------
+
+inline std::uint32_t fast_inflater::getbits(unsigned bits) noexcept
+{
+	std::uint32_t const result = std::uint32_t(m_bitbuf & ((std::uint64_t(1) << bits) - 1));
+	consume(bits);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  decode - look up the next code in a table
+//-------------------------------------------------
+
+inline std::uint32_t fast_inflater::decode(std::uint32_t const *table, unsigned tablebits) noexcept
+{
+	std::uint32_t e = table[m_bitbuf & ((1U << tablebits) - 1)];
+	if (entry_type(e) == INFLATE_SUBTABLE)
+	{
+		consume(tablebits);
+		e = table[entry_value(e) + (m_bitbuf & ((1U << entry_extra(e)) - 1))];
+	}
+	consume(entry_length(e));
+	return e;
+}
+
+
+//-------------------------------------------------
+//  stored_block - copy a stored block
+//-------------------------------------------------
+
+bool fast_inflater::stored_block(std::uint8_t *&out, std::uint8_t *outend) noexcept
+{
+	// skip to a byte boundary and hand any whole buffered bytes back to the input
+	consume(m_bitcount & 7);
+	if ((m_bitcount >> 3) < m_pad)
+		return false;
+	m_in -= (m_bitcount >> 3) - m_pad;
+	m_bitbuf = 0;
+	m_bitcount = 0;
+	m_pad = 0;
+
+	if ((m_end - m_in) < 4)
+		return false;
+	std::size_t const len = m_in[0] | (m_in[1] << 8);
+	std::size_t const nlen = m_in[2] | (m_in[3] << 8);
+	m_in += 4;
+	if ((len != (~nlen & 0xffff)) || (std::size_t(m_end - m_in) < len) || (std::size_t(outend - out) < len))
+		return false;
+	std::memcpy(out, m_in, len);
+	m_in += len;
+	out += len;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  fixed_tables - set up the fixed Huffman codes
+//-------------------------------------------------
+
+bool fast_inflater::fixed_tables() noexcept
+{
+	std::uint8_t lengths[288 + 32];
+	std::fill_n(&lengths[0], 144, 8);
+	std::fill_n(&lengths[144], 112, 9);
+	std::fill_n(&lengths[256], 24, 7);
+	std::fill_n(&lengths[280], 8, 8);
+	std::fill_n(&lengths[288], 32, 5);
+	return
+			build(m_litlen, LITLEN_SIZE, LITLEN_BITS, &lengths[0], 288, &f_inflate_litlen_symbols[0]) &&
+			build(m_dist, DIST_SIZE, DIST_BITS, &lengths[288], 32, &f_inflate_dist_symbols[0]);
+}
+
+
+//-------------------------------------------------
+//  dynamic_tables - read the Huffman codes for
+//  a dynamic block
+//-------------------------------------------------
+
+bool fast_inflater::dynamic_tables() noexcept
+{
+	static constexpr std::uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+	refill();
+	unsigned const hlit = getbits(5) + 257;
+	unsigned const hdist = getbits(5) + 1;
+	unsigned const hclen = getbits(4) + 4;
+	if ((hlit > 286) || (hdist > 30))
+		return false;
+
+	// read the code length code
+	std::uint8_t precode[19] = { 0 };
+	for (unsigned i = 0; i < hclen; i++)
+	{
+		refill();
+		precode[order[i]] = getbits(3);
+	}
+	if (!build(m_precode, std::size(m_precode), PRECODE_BITS, precode, 19, &f_inflate_precode_symbols[0]))
+		return false;
+
+	// use it to read the literal/length and distance code lengths
+	std::uint8_t lengths[288 + 32];
+	for (unsigned i = 0; i < (hlit + hdist); )
+	{
+		refill();
+		std::uint32_t const e = decode(m_precode, PRECODE_BITS);
+		if (entry_type(e) != INFLATE_LITERAL)
+			return false;
+		unsigned const sym = entry_value(e);
+		if (sym < 16)
+		{
+			lengths[i++] = sym;
+			continue;
+		}
+
+		std::uint8_t value = 0;
+		unsigned repeat;
+		if (sym == 16)
+		{
+			if (!i)
+				return false;
+			value = lengths[i - 1];
+			repeat = 3 + getbits(2);
+		}
+		else if (sym == 17)
+		{
+			repeat = 3 + getbits(3);
+		}
+		else
+		{
+			repeat = 11 + getbits(7);
+		}
+		if ((i + repeat) > (hlit + hdist))
+			return false;
+		std::fill_n(&lengths[i], repeat, value);
+		i += repeat;
+	}
+
+	// there has to be an end of block code
+	if (!lengths[256])
+		return false;
+	return
+			build(m_litlen, LITLEN_SIZE, LITLEN_BITS, &lengths[0], hlit, &f_inflate_litlen_symbols[0]) &&
+			build(m_dist, DIST_SIZE, DIST_BITS, &lengths[hlit], hdist, &f_inflate_dist_symbols[0]);
+}
+
+
+//-------------------------------------------------
+//  huffman_block - decode a block of literals
+//  and matches
+//-------------------------------------------------
+
+bool fast_inflater::huffman_block(std::uint8_t const *dst, std::uint8_t *&out, std::uint8_t *outend) noexcept
+{
+	// work on local copies, as stores through the output pointer could alias members
+	std::uint8_t const *in = m_in;
+	std::uint8_t const *const inend = m_end;
+	std::uint64_t bitbuf = m_bitbuf;
+	unsigned bitcount = m_bitcount;
+	unsigned pad = m_pad;
+	std::uint8_t *cur = out;
+	std::uint32_t const *const litlen = m_litlen;
+	std::uint32_t const *const disttab = m_dist;
+
+	auto const refill =
+			[&in, inend, &bitbuf, &bitcount, &pad] ()
+			{
+				if ((inend - in) >= 8)
+				{
+					std::uint64_t word;
+					std::memcpy(&word, in, 8);
+					bitbuf |= little_endianize_int64(word) << bitcount;
+					in += (63 - bitcount) >> 3;
+					bitcount |= 56;
+				}
+				else
+				{
+					while (bitcount <= 56)
+					{
+						if (in < inend)
+							bitbuf |= std::uint64_t(*in++) << bitcount;
+						else
+							pad++;
+						bitcount += 8;
+					}
+				}
+			};
+	auto const getbits =
+			[&bitbuf, &bitcount] (unsigned bits) -> std::uint32_t
+			{
+				std::uint32_t const result = std::uint32_t(bitbuf & ((std::uint64_t(1) << bits) - 1));
+				bitbuf >>= bits;
+				bitcount -= bits;
+				return result;
+			};
+	auto const decode =
+			[&bitbuf, &bitcount] (std::uint32_t const *table, unsigned tablebits) -> std::uint32_t
+			{
+				std::uint32_t e = table[bitbuf & ((1U << tablebits) - 1)];
+				if (entry_type(e) == INFLATE_SUBTABLE)
+				{
+					bitbuf >>= tablebits;
+					bitcount -= tablebits;
+					e = table[entry_value(e) + (bitbuf & ((1U << entry_extra(e)) - 1))];
+				}
+				bitbuf >>= entry_length(e);
+				bitcount -= entry_length(e);
+				return e;
+			};
+
+	bool result = false;
+	while (true)
+	{
+		// a literal/length code, its extra bits, a distance code and its extra bits all fit in 56 bits
+		refill();
+		std::uint32_t e = decode(litlen, LITLEN_BITS);
+		std::uint32_t const type = entry_type(e);
+		if (type == INFLATE_LITERAL)
+		{
+			if (cur == outend)
+				break;
+			*cur++ = std::uint8_t(entry_value(e));
+			continue;
+		}
+		else if (type != INFLATE_LENGTH)
+		{
+			result = (type == INFLATE_END);
+			break;
+		}
+		std::size_t const length = entry_value(e) + getbits(entry_extra(e));
+
+		e = decode(disttab, DIST_BITS);
+		if (entry_type(e) != INFLATE_LENGTH)
+			break;
+		std::size_t const dist = entry_value(e) + getbits(entry_extra(e));
+		if ((dist > std::size_t(cur - dst)) || (length > std::size_t(outend - cur)))
+			break;
+
+		// copy the match, which may overlap the data being written; with
+		// room to spare, copy whole words and let the last one run over
+		std::uint8_t const *src = cur - dist;
+		std::uint8_t *const end = cur + length;
+		if ((dist >= 8) && (std::size_t(outend - end) >= 8))
+		{
+			do
+			{
+				std::memcpy(cur, src, 8);
+				cur += 8;
+				src += 8;
+			}
+			while (cur < end);
+		}
+		else if (dist == 1)
+		{
+			std::memset(cur, *src, length);
+		}
+		else
+		{
+			while (cur < end)
+				*cur++ = *src++;
+		}
+		cur = end;
+	}
+
+	m_in = in;
+	m_bitbuf = bitbuf;
+	m_bitcount = bitcount;
+	m_pad = pad;
+	out = cur;
+	return result;
+}
+
+
+//-------------------------------------------------
+//  build - build a decoding table from a set
+//  of code lengths
+//-------------------------------------------------
+
+bool fast_inflater::build(std::uint32_t *table, std::size_t capacity, unsigned tablebits, std::uint8_t const *lengths, unsigned count, std::uint32_t const *symbols) noexcept
+{
+	// count code lengths and make sure the code isn't over-subscribed
+	unsigned counts[MAX_CODE_BITS + 1] = { 0 };
+	for (unsigned i = 0; i < count; i++)
+		counts[lengths[i]]++;
+	counts[0] = 0;
+	int left = 1;
+	unsigned maxlen = 0;
+	for (unsigned len = 1; len <= MAX_CODE_BITS; len++)
+	{
+		left = (left << 1) - int(counts[len]);
+		if (left < 0)
+			return false;
+		if (counts[len])
+			maxlen = len;
+	}
+
+	// sort symbols by code length, keeping them in order within each length
+	unsigned offsets[MAX_CODE_BITS + 1];
+	offsets[1] = 0;
+	for (unsigned len = 1; len < MAX_CODE_BITS; len++)
+		offsets[len + 1] = offsets[len] + counts[len];
+	std::uint16_t sorted[288];
+	for (unsigned i = 0; i < count; i++)
+		if (lengths[i])
+			sorted[offsets[lengths[i]]++] = i;
+
+	// anything not covered by a code is invalid
+	std::uint32_t const primary = 1U << tablebits;
+	std::fill_n(table, primary, inflate_entry(0, INFLATE_INVALID, 0));
+
+	// assign canonical codes, filling in every table slot each one covers
+	unsigned remaining[MAX_CODE_BITS + 1];
+	std::copy(std::begin(counts), std::end(counts), std::begin(remaining));
+	std::size_t next = primary;
+	std::uint32_t prefix = ~std::uint32_t(0);
+	std::size_t subbase = 0;
+	unsigned subbits = 0;
+	std::uint32_t code = 0;
+	unsigned index = 0;
+	for (unsigned len = 1; len <= maxlen; len++, code <<= 1)
+	{
+		for (unsigned n = 0; n < counts[len]; n++, code++)
+		{
+			std::uint32_t const e = symbols[sorted[index++]];
+
+			// codes are stored most significant bit first, but read least significant bit first
+			std::uint32_t rev = 0;
+			for (unsigned bit = 0; bit < len; bit++)
+				rev |= ((code >> bit) & 1) << (len - 1 - bit);
+
+			if (len <= tablebits)
+			{
+				for (std::uint32_t i = rev; i < primary; i += 1U << len)
+					table[i] = e | len;
+			}
+			else
+			{
+				// start a new subtable, big enough for the remaining codes sharing this prefix
+				std::uint32_t const low = rev & (primary - 1);
+				if (low != prefix)
+				{
+					subbits = len - tablebits;
+					int avail = 1 << subbits;
+					while ((subbits + tablebits) < maxlen)
+					{
+						avail -= int(remaining[subbits + tablebits]);
+						if (avail <= 0)
+							break;
+						subbits++;
+						avail <<= 1;
+					}
+					if ((next + (std::size_t(1) << subbits)) > capacity)
+						return false;
+					prefix = low;
+					subbase = next;
+					next += std::size_t(1) << subbits;
+					std::fill_n(table + subbase, std::size_t(1) << subbits, inflate_entry(0, INFLATE_INVALID, 0));
+					table[low] = inflate_entry(subbase, INFLATE_SUBTABLE, subbits) | tablebits;
+				}
+				unsigned const sublen = len - tablebits;
+				if (sublen > subbits)
+					return false;
+				for (std::uint32_t i = rev >> tablebits; i < (1U << subbits); i += 1U << sublen)
+					table[subbase + i] = e | sublen;
+			}
+			remaining[len]--;
+		}
+	}
+	return true;
+}
+
+} // namespace util
@@ -0,0 +1,74 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles, Vas Crabb
+/***************************************************************************
+
+    inflater.h
+
+    Whole-buffer decoder for raw deflate streams.
+
+***************************************************************************/
+
+#ifndef MAME_UTIL_INFLATER_H
+#define MAME_UTIL_INFLATER_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace util {
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+// Decodes a complete raw deflate stream straight into a buffer of known
+// size.  It never has to stop for input or output, so it can keep a
+// 64-bit bit buffer topped up with one unaligned load and resolve most
+// codes with a single table lookup.  Anything it doesn't like makes it
+// give up, and the caller falls back to zlib to report the error.
+//
+// The decoding tables make this fairly large, so allocate it rather than
+// putting it on the stack.
+
+class fast_inflater
+{
+public:
+	// inflate a raw deflate stream that must produce exactly dstlen bytes
+	bool inflate(std::uint8_t const *src, std::size_t srclen, std::uint8_t *dst, std::size_t dstlen) noexcept;
+
+private:
+	static constexpr unsigned LITLEN_BITS = 11;
+	static constexpr unsigned DIST_BITS = 8;
+	static constexpr unsigned PRECODE_BITS = 7;
+	static constexpr unsigned MAX_CODE_BITS = 15;
+
+	// primary table plus room for the largest possible set of subtables
+	static constexpr std::size_t LITLEN_SIZE = (1 << LITLEN_BITS) + (288 << (MAX_CODE_BITS - LITLEN_BITS));
+	static constexpr std::size_t DIST_SIZE = (1 << DIST_BITS) + (32 << (MAX_CODE_BITS - DIST_BITS));
+
+	void refill() noexcept;
+	void consume(unsigned bits) noexcept;
+	std::uint32_t getbits(unsigned bits) noexcept;
+	std::uint32_t decode(std::uint32_t const *table, unsigned tablebits) noexcept;
+	bool stored_block(std::uint8_t *&out, std::uint8_t *outend) noexcept;
+	bool fixed_tables() noexcept;
+	bool dynamic_tables() noexcept;
+	bool huffman_block(std::uint8_t const *dst, std::uint8_t *&out, std::uint8_t *outend) noexcept;
+	static bool build(std::uint32_t *table, std::size_t capacity, unsigned tablebits, std::uint8_t const *lengths, unsigned count, std::uint32_t const *symbols) noexcept;
+
+	std::uint8_t const *m_in = nullptr;     // next input byte
+	std::uint8_t const *m_end = nullptr;    // end of input
+	std::uint64_t m_bitbuf = 0;             // buffered input bits
+	unsigned m_bitcount = 0;                // number of valid bits in the buffer
+	unsigned m_pad = 0;                     // bytes of zero padding in the buffer
+
+	std::uint32_t m_litlen[LITLEN_SIZE];    // literal/length decoding table
+	std::uint32_t m_dist[DIST_SIZE];        // distance decoding table
+	std::uint32_t m_precode[1 << PRECODE_BITS]; // code length code decoding table
+};
+
+} // namespace util
+
+#endif // MAME_UTIL_INFLATER_H
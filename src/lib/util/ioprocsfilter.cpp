@@ -477,20 +477,84 @@ class zlib_read_filter : public read_stream, protected filter_base<Stream>, prot
 public:
 	zlib_read_filter(std::unique_ptr<Stream> &&stream, std::size_t read_chunk) noexcept :
 		filter_base<Stream>(std::move(stream)),
-		inflate_data(read_chunk)
+		inflate_data(read_chunk),
+		m_output_size(read_chunk)
 	{
 	}
 
 	zlib_read_filter(Stream &stream, std::size_t read_chunk) noexcept :
 		filter_base<Stream>(stream),
-		inflate_data(read_chunk)
+		inflate_data(read_chunk),
+		m_output_size(read_chunk)
 	{
 	}
 
 	virtual std::error_condition read(void *buffer, std::size_t length, std::size_t &actual) noexcept override
+	{
+		// hand out anything left over from the last buffered read first
+		// a read still stops at the end of a block of compressed data
+		actual = take_output(buffer, length);
+		if (!m_output_avail && m_output_end)
+		{
+			m_output_end = false;
+			return std::error_condition();
+		}
+		else if (length == actual)
+		{
+			return std::error_condition();
+		}
+
+		// large reads decompress directly into the caller's buffer
+		std::size_t const remaining = length - actual;
+		std::uint8_t *const dest = reinterpret_cast<std::uint8_t *>(buffer) + actual;
+		if (remaining >= (m_output_size >> 1))
+		{
+			std::size_t produced;
+			bool stream_end;
+			std::error_condition const err = decompress(dest, remaining, produced, stream_end);
+			actual += produced;
+			return err;
+		}
+
+		// small reads (e.g. INP playback) would spend most of their time
+		// setting up inflate calls, so decompress a chunk and serve them
+		// from that
+		if (!m_output)
+		{
+			m_output.reset(new (std::nothrow) std::uint8_t [m_output_size]);
+			if (!m_output)
+				return std::errc::not_enough_memory;
+		}
+		std::size_t produced;
+		bool stream_end;
+		std::error_condition const err = decompress(m_output.get(), m_output_size, produced, stream_end);
+		m_output_ptr = m_output.get();
+		m_output_avail = produced;
+		m_output_end = stream_end && !err;
+		actual += take_output(dest, remaining);
+		if (!m_output_avail)
+			m_output_end = false;
+		return err;
+	}
+
+private:
+	std::size_t take_output(void *buffer, std::size_t length) noexcept
+	{
+		std::size_t const result = std::min(length, m_output_avail);
+		if (result)
+		{
+			std::copy_n(m_output_ptr, result, reinterpret_cast<std::uint8_t *>(buffer));
+			m_output_ptr += result;
+			m_output_avail -= result;
+		}
+		return result;
+	}
+
+	std::error_condition decompress(void *buffer, std::size_t length, std::size_t &actual, bool &stream_end) noexcept
 	{
 		std::error_condition err;
 		actual = 0U;
+		stream_end = false;
 
 		if (!stream_initialized())
 			err = initialize_z_stream();
@@ -512,7 +576,6 @@ public:
 				if (!err && !input_empty())
 				{
 					set_output(reinterpret_cast<std::uint8_t *>(buffer) + actual, length - actual);
-					bool stream_end;
 					err = decompress_some(stream_end);
 					actual += output_produced();
 
@@ -540,6 +603,12 @@ public:
 
 		return err;
 	}
+
+	std::unique_ptr<std::uint8_t []> m_output;
+	std::size_t const m_output_size;
+	std::uint8_t const *m_output_ptr = nullptr;
+	std::size_t m_output_avail = 0U;
+	bool m_output_end = false;
 };
 
 
@@ -14,6 +14,7 @@
 #include "unicode.h"
 
 #include "osdcomm.h"
+#include "osdcore.h"
 
 #include <zlib.h>
 
@@ -24,6 +25,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <new>
+#include <vector>
 
 
 namespace util {
@@ -89,6 +91,9 @@ constexpr std::uint8_t  PNG_PF_Up       = 2;
 constexpr std::uint8_t  PNG_PF_Average  = 3;
 constexpr std::uint8_t  PNG_PF_Paeth    = 4;
 
+// Images are filtered and compressed in bands of about this many bytes
+constexpr std::uint32_t PNG_BAND_BYTES  = 256 * 1024;
+
 
 /***************************************************************************
     INLINE FUNCTIONS
@@ -104,6 +109,101 @@ inline void put_8bit(uint8_t *v, uint8_t data) { *v = data; }
 inline void put_16bit(uint8_t *v, uint16_t data) { *reinterpret_cast<uint16_t *>(v) = big_endianize_int16(data); }
 inline void put_32bit(uint8_t *v, uint32_t data) { *reinterpret_cast<uint32_t *>(v) = big_endianize_int32(data); }
 
+inline std::int32_t paeth_predict(std::int32_t a, std::int32_t b, std::int32_t c)
+{
+	// a = left, b = above, c = above left; selecting with masks rather than
+	// branches matters, as the choice is close to random on natural images
+	std::int32_t const pa(std::abs(b - c));
+	std::int32_t const pb(std::abs(a - c));
+	std::int32_t const pc(std::abs(a + b - (2 * c)));
+	std::int32_t const useb(-std::int32_t(pb <= pc));
+	std::int32_t const usea(-std::int32_t((pa <= pb) & (pa <= pc)));
+	return (a & usea) | (((b & useb) | (c & ~useb)) & ~usea);
+}
+
+
+// The filters that depend on the pixel to the left can only work across
+// the channels of a pixel at a time.  Instantiating them for the common
+// pixel sizes (Bpp != 0) lets the compiler vectorise the channel loop.
+
+template <unsigned Bpp>
+inline void unfilter_sub(uint8_t const *src, uint8_t *dst, unsigned bpp, std::uint32_t rowbytes)
+{
+	if constexpr (Bpp != 0)
+	{
+		// keep the left pixel in locals
+		std::uint8_t a[Bpp];
+		for (unsigned i = 0; Bpp > i; ++i)
+			a[i] = dst[i] = src[i];
+		for (std::uint32_t x = Bpp; rowbytes > x; x += Bpp)
+		{
+			for (unsigned i = 0; Bpp > i; ++i)
+				a[i] = dst[x + i] = src[x + i] + a[i];
+		}
+	}
+	else
+	{
+		std::copy_n(src, bpp, dst);
+		for (std::uint32_t x = bpp; rowbytes > x; ++x)
+			dst[x] = src[x] + dst[x - bpp];
+	}
+}
+
+template <unsigned Bpp>
+inline void unfilter_average(uint8_t const *src, uint8_t *dst, uint8_t const *prev, unsigned bpp, std::uint32_t rowbytes)
+{
+	if constexpr (Bpp != 0)
+	{
+		// keep the left pixel in locals
+		std::uint8_t a[Bpp];
+		for (unsigned i = 0; Bpp > i; ++i)
+			a[i] = dst[i] = src[i] + (prev[i] >> 1);
+		for (std::uint32_t x = Bpp; rowbytes > x; x += Bpp)
+		{
+			for (unsigned i = 0; Bpp > i; ++i)
+				a[i] = dst[x + i] = src[x + i] + ((prev[x + i] + a[i]) >> 1);
+		}
+	}
+	else
+	{
+		for (unsigned i = 0; bpp > i; ++i)
+			dst[i] = src[i] + (prev[i] >> 1);
+		for (std::uint32_t x = bpp; rowbytes > x; ++x)
+			dst[x] = src[x] + ((prev[x] + dst[x - bpp]) >> 1);
+	}
+}
+
+template <unsigned Bpp>
+inline void unfilter_paeth(uint8_t const *src, uint8_t *dst, uint8_t const *prev, unsigned bpp, std::uint32_t rowbytes)
+{
+	if constexpr (Bpp != 0)
+	{
+		// keep the left and above left pixels in locals
+		std::int32_t a[Bpp], c[Bpp];
+		for (unsigned i = 0; Bpp > i; ++i)
+		{
+			c[i] = prev[i];
+			a[i] = dst[i] = std::uint8_t(src[i] + prev[i]);
+		}
+		for (std::uint32_t x = Bpp; rowbytes > x; x += Bpp)
+		{
+			for (unsigned i = 0; Bpp > i; ++i)
+			{
+				std::int32_t const b(prev[x + i]);
+				a[i] = dst[x + i] = std::uint8_t(src[x + i] + paeth_predict(a[i], b, c[i]));
+				c[i] = b;
+			}
+		}
+	}
+	else
+	{
+		for (unsigned i = 0; bpp > i; ++i)
+			dst[i] = src[i] + prev[i];
+		for (std::uint32_t x = bpp; rowbytes > x; ++x)
+			dst[x] = src[x] + paeth_predict(dst[x - bpp], prev[x], prev[x - bpp]);
+	}
+}
+
 
 /***************************************************************************
     TYPE DEFINITIONS
@@ -254,6 +354,36 @@ private:
 			return png_error::DECOMPRESS_ERROR; // TODO: refactor this function for more fine-grained error reporting?
 	}
 
+	static void unfilter_sub(uint8_t const *src, uint8_t *dst, int bpp, std::uint32_t rowbytes)
+	{
+		switch (bpp)
+		{
+		case 3:     util::unfilter_sub<3>(src, dst, bpp, rowbytes); break;
+		case 4:     util::unfilter_sub<4>(src, dst, bpp, rowbytes); break;
+		default:    util::unfilter_sub<0>(src, dst, bpp, rowbytes); break;
+		}
+	}
+
+	static void unfilter_average(uint8_t const *src, uint8_t *dst, uint8_t const *dstprev, int bpp, std::uint32_t rowbytes)
+	{
+		switch (bpp)
+		{
+		case 3:     util::unfilter_average<3>(src, dst, dstprev, bpp, rowbytes); break;
+		case 4:     util::unfilter_average<4>(src, dst, dstprev, bpp, rowbytes); break;
+		default:    util::unfilter_average<0>(src, dst, dstprev, bpp, rowbytes); break;
+		}
+	}
+
+	static void unfilter_paeth(uint8_t const *src, uint8_t *dst, uint8_t const *dstprev, int bpp, std::uint32_t rowbytes)
+	{
+		switch (bpp)
+		{
+		case 3:     util::unfilter_paeth<3>(src, dst, dstprev, bpp, rowbytes); break;
+		case 4:     util::unfilter_paeth<4>(src, dst, dstprev, bpp, rowbytes); break;
+		default:    util::unfilter_paeth<0>(src, dst, dstprev, bpp, rowbytes); break;
+		}
+	}
+
 	std::error_condition unfilter_row(std::uint8_t type, uint8_t const *src, uint8_t *dst, uint8_t const *dstprev, int bpp, std::uint32_t rowbytes)
 	{
 		if (0 != pnginfo.filter_method)
@@ -266,10 +396,7 @@ private:
 			return std::error_condition();
 
 		case PNG_PF_Sub: // SUB = previous pixel
-			dst = std::copy_n(src, bpp, dst);
-			src += bpp;
-			for (std::uint32_t x = bpp; rowbytes > x; ++x, ++src, ++dst)
-				*dst = *src + dst[-bpp];
+			unfilter_sub(src, dst, bpp, rowbytes);
 			return std::error_condition();
 
 		case PNG_PF_Up: // UP = pixel above
@@ -287,10 +414,7 @@ private:
 		case PNG_PF_Average: // AVERAGE = average of pixel above and previous pixel
 			if (dstprev)
 			{
-				for (std::uint32_t x = 0; bpp > x; ++x, ++src, ++dst, ++dstprev)
-					*dst = *src + (*dstprev >> 1);
-				for (std::uint32_t x = bpp; rowbytes > x; ++x, ++src, ++dst, ++dstprev)
-					*dst = *src + ((*dstprev + dst[-bpp]) >> 1);
+				unfilter_average(src, dst, dstprev, bpp, rowbytes);
 			}
 			else
 			{
@@ -302,17 +426,10 @@ private:
 			return std::error_condition();
 
 		case PNG_PF_Paeth: // PAETH = special filter
-			for (std::uint32_t x = 0; rowbytes > x; ++x, ++src, ++dst)
-			{
-				int32_t const pa((x < bpp) ? 0 : dst[-bpp]);
-				int32_t const pc(((x < bpp) || !dstprev) ? 0 : dstprev[-bpp]);
-				int32_t const pb(!dstprev ? 0 : *dstprev++);
-				int32_t const prediction(pa + pb - pc);
-				int32_t const da(std::abs(prediction - pa));
-				int32_t const db(std::abs(prediction - pb));
-				int32_t const dc(std::abs(prediction - pc));
-				*dst = ((da <= db) && (da <= dc)) ? (*src + pa) : (db <= dc) ? (*src + pb) : (*src + pc);
-			}
+			if (dstprev)
+				unfilter_paeth(src, dst, dstprev, bpp, rowbytes);
+			else
+				unfilter_sub(src, dst, bpp, rowbytes); // with nothing above, the left pixel is always chosen
 			return std::error_condition();
 
 		default: // unknown filter type
@@ -1097,6 +1214,212 @@ static std::error_condition write_deflated_chunk(random_write &fp, uint8_t *data
 }
 
 
+/*-------------------------------------------------
+    filter_row - apply a prediction filter to a
+    row of pixels
+-------------------------------------------------*/
+
+static void filter_row(std::uint8_t type, uint8_t const *src, uint8_t const *prev, uint8_t *dst, unsigned bpp, std::uint32_t rowbytes)
+{
+	// the first pixel has nothing to the left
+	std::uint32_t const first((std::min)(bpp, rowbytes));
+	switch (type)
+	{
+	case PNG_PF_Sub:
+		std::copy_n(src, first, dst);
+		for (std::uint32_t x = first; rowbytes > x; ++x)
+			dst[x] = src[x] - src[x - bpp];
+		break;
+
+	case PNG_PF_Up:
+		for (std::uint32_t x = 0; rowbytes > x; ++x)
+			dst[x] = src[x] - (prev ? prev[x] : 0);
+		break;
+
+	case PNG_PF_Average:
+		for (std::uint32_t x = 0; first > x; ++x)
+			dst[x] = src[x] - ((prev ? prev[x] : 0) >> 1);
+		for (std::uint32_t x = first; rowbytes > x; ++x)
+			dst[x] = src[x] - (((prev ? prev[x] : 0) + src[x - bpp]) >> 1);
+		break;
+
+	case PNG_PF_Paeth:
+		for (std::uint32_t x = 0; first > x; ++x)
+			dst[x] = src[x] - (prev ? prev[x] : 0);
+		for (std::uint32_t x = first; rowbytes > x; ++x)
+			dst[x] = src[x] - (prev ? paeth_predict(src[x - bpp], prev[x], prev[x - bpp]) : src[x - bpp]);
+		break;
+
+	default:
+		std::copy_n(src, rowbytes, dst);
+		break;
+	}
+}
+
+
+/*-------------------------------------------------
+    filter_rows - choose a filter for each row of
+    an RGB image, using the usual heuristic of the
+    smallest sum of absolute signed differences
+-------------------------------------------------*/
+
+struct png_filter_band
+{
+	png_info const *pnginfo;            // image with unfiltered rows
+	std::uint8_t *filtered;             // destination image
+	std::uint32_t first_row;            // first row to filter
+	std::uint32_t rows;                 // number of rows to filter
+};
+
+static void *filter_rows(void *param, int threadid)
+{
+	png_filter_band const &band(*reinterpret_cast<png_filter_band const *>(param));
+	png_info const &pnginfo(*band.pnginfo);
+	unsigned const bpp(samples[pnginfo.color_type]);
+	std::uint32_t const rowbytes(compute_rowbytes(pnginfo));
+
+	std::unique_ptr<std::uint8_t []> candidate(new (std::nothrow) std::uint8_t [rowbytes]);
+	for (std::uint32_t y = band.first_row; (band.first_row + band.rows) > y; ++y)
+	{
+		uint8_t const *const src(&pnginfo.image[(y * (rowbytes + 1)) + 1]);
+		uint8_t const *const prev(y ? (src - (rowbytes + 1)) : nullptr);
+		uint8_t *const dst(&band.filtered[y * (rowbytes + 1)]);
+
+		// without scratch space, just store the row unfiltered
+		dst[0] = PNG_PF_None;
+		std::copy_n(src, rowbytes, dst + 1);
+		if (!candidate)
+			continue;
+
+		std::uint64_t best(~std::uint64_t(0));
+		for (std::uint8_t type = PNG_PF_None; PNG_PF_Paeth >= type; ++type)
+		{
+			filter_row(type, src, prev, candidate.get(), bpp, rowbytes);
+			std::uint64_t sum(0);
+			for (std::uint32_t x = 0; (rowbytes > x) && (best > sum); ++x)
+				sum += std::abs(std::int8_t(candidate[x]));
+			if (best > sum)
+			{
+				best = sum;
+				dst[0] = type;
+				std::copy_n(candidate.get(), rowbytes, dst + 1);
+			}
+		}
+	}
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    deflate_band - compress one band of a large
+    image as part of a single zlib stream
+-------------------------------------------------*/
+
+struct png_deflate_band
+{
+	std::uint8_t const *data;           // data to compress
+	std::uint32_t length;               // length of data
+	std::uint32_t dictlength;           // length of preceding data to prime the dictionary with
+	bool last;                          // whether this band finishes the stream
+	std::vector<std::uint8_t> output;   // raw deflate data
+	uLong adler;                        // Adler-32 of the uncompressed data
+	int zerr;                           // result
+};
+
+static void *deflate_band(void *param, int threadid)
+{
+	png_deflate_band &band(*reinterpret_cast<png_deflate_band *>(param));
+
+	z_stream stream;
+	std::memset(&stream, 0, sizeof(stream));
+	band.zerr = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+	if (Z_OK != band.zerr)
+		return nullptr;
+	if (band.dictlength)
+		band.zerr = deflateSetDictionary(&stream, band.data - band.dictlength, band.dictlength);
+	if (Z_OK == band.zerr)
+	{
+		// allow for the worst case and the flush marker, so one call consumes everything
+		try { band.output.resize(deflateBound(&stream, band.length) + 16); }
+		catch (...) { band.zerr = Z_MEM_ERROR; }
+	}
+	if (Z_OK == band.zerr)
+	{
+		stream.next_in = const_cast<Bytef *>(band.data);
+		stream.avail_in = band.length;
+		stream.next_out = &band.output[0];
+		stream.avail_out = band.output.size();
+		band.zerr = deflate(&stream, band.last ? Z_FINISH : Z_SYNC_FLUSH);
+		if (band.last ? (Z_STREAM_END == band.zerr) : ((Z_OK == band.zerr) && !stream.avail_in && stream.avail_out))
+			band.zerr = Z_OK;
+		else if ((Z_OK == band.zerr) || (Z_STREAM_END == band.zerr))
+			band.zerr = Z_BUF_ERROR;
+		band.output.resize(stream.total_out);
+		band.adler = adler32(adler32(0, Z_NULL, 0), band.data, band.length);
+	}
+	deflateEnd(&stream);
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    write_banded_chunk - write a large in-memory
+    chunk to the given file by deflating bands of
+    it in parallel and joining them up
+-------------------------------------------------*/
+
+static std::error_condition write_banded_chunk(random_write &fp, osd_work_queue *queue, uint8_t const *data, uint32_t type, uint32_t length, uint32_t bandlength)
+{
+	// each band is primed with the end of the one before, so little is lost
+	std::vector<png_deflate_band> bands;
+	try
+	{
+		bands.resize((length + bandlength - 1) / bandlength);
+		for (std::size_t i = 0; bands.size() > i; ++i)
+		{
+			png_deflate_band &band(bands[i]);
+			band.data = data + (i * bandlength);
+			band.length = (std::min)(bandlength, length - std::uint32_t(i * bandlength));
+			band.dictlength = i ? (std::min<std::uint32_t>)(bandlength, 1U << MAX_WBITS) : 0;
+			band.last = (bands.size() - 1) == i;
+			band.adler = 0;
+			band.zerr = Z_OK;
+		}
+	}
+	catch (...)
+	{
+		return std::errc::not_enough_memory;
+	}
+	osd_work_item_queue_multiple(queue, &deflate_band, bands.size(), &bands[0], sizeof(bands[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+
+	// zlib header, the bands, and the Adler-32 of the whole lot
+	std::vector<std::uint8_t> zdata;
+	uLong adler(adler32(0, Z_NULL, 0));
+	try
+	{
+		zdata.push_back(0x78);
+		zdata.push_back(0x9c);
+		for (png_deflate_band const &band : bands)
+		{
+			if (Z_MEM_ERROR == band.zerr)
+				return std::errc::not_enough_memory;
+			else if (Z_OK != band.zerr)
+				return png_error::COMPRESS_ERROR;
+			zdata.insert(zdata.end(), band.output.begin(), band.output.end());
+			adler = adler32_combine(adler, band.adler, band.length);
+		}
+		zdata.resize(zdata.size() + 4);
+	}
+	catch (...)
+	{
+		return std::errc::not_enough_memory;
+	}
+	put_32bit(&zdata[zdata.size() - 4], adler);
+	return write_chunk(fp, &zdata[0], type, zdata.size());
+}
+
+
 /*-------------------------------------------------
     convert_bitmap_to_image_palette - convert a
     bitmap to a palettized image
@@ -1246,7 +1569,40 @@ static std::error_condition write_png_stream(random_write &fp, png_info &pnginfo
 	if (error)
 		return error;
 
-	// if we wanted to get clever and do filtering, we would do it here
+	// large images are filtered and compressed in bands on a work queue
+	std::uint32_t const rowbytes(compute_rowbytes(pnginfo));
+	std::uint32_t const imagebytes(pnginfo.height * (rowbytes + 1));
+	std::uint32_t const bandrows((std::max<std::uint32_t>)(1, PNG_BAND_BYTES / (rowbytes + 1)));
+	osd_work_queue *const queue((imagebytes >= (2 * PNG_BAND_BYTES)) ? osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI) : nullptr);
+
+	// choose prediction filters for RGB images - palette images compress better without
+	std::unique_ptr<std::uint8_t []> filtered;
+	if ((2 == pnginfo.color_type) || (6 == pnginfo.color_type))
+		filtered.reset(new (std::nothrow) std::uint8_t [imagebytes]);
+	if (filtered)
+	{
+		std::vector<png_filter_band> bands;
+		try
+		{
+			for (std::uint32_t y = 0; pnginfo.height > y; y += bandrows)
+				bands.emplace_back(png_filter_band{ &pnginfo, filtered.get(), y, (std::min)(bandrows, pnginfo.height - y) });
+		}
+		catch (...)
+		{
+			filtered.reset();
+		}
+		if (filtered && queue)
+		{
+			osd_work_item_queue_multiple(queue, &filter_rows, bands.size(), &bands[0], sizeof(bands[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+			while (!osd_work_queue_wait(queue, osd_ticks_per_second())) { }
+		}
+		else if (filtered)
+		{
+			for (png_filter_band &band : bands)
+				filter_rows(&band, 0);
+		}
+	}
+	std::uint8_t const *const imagedata(filtered ? filtered.get() : pnginfo.image.get());
 
 	// write the IHDR chunk
 	put_32bit(tempbuff + 0, pnginfo.width);
@@ -1267,7 +1623,15 @@ static std::error_condition write_png_stream(random_write &fp, png_info &pnginfo
 		return error;
 
 	// write a single IDAT chunk
-	error = write_deflated_chunk(fp, pnginfo.image.get(), PNG_CN_IDAT, pnginfo.height * (compute_rowbytes(pnginfo) + 1));
+	if (queue)
+	{
+		error = write_banded_chunk(fp, queue, imagedata, PNG_CN_IDAT, imagebytes, bandrows * (rowbytes + 1));
+		osd_work_queue_free(queue);
+	}
+	else
+	{
+		error = write_deflated_chunk(fp, const_cast<std::uint8_t *>(imagedata), PNG_CN_IDAT, imagebytes);
+	}
 	if (error)
 		return error;
 
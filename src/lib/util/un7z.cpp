@@ -127,8 +127,7 @@ public:
 
 	virtual ~m7z_file_impl()
 	{
-		if (m_out_buffer)
-			IAlloc_Free(&m_alloc_imp, m_out_buffer);
+		trim_blocks(0);
 		if (m_inited)
 			SzArEx_Free(&m_db, &m_alloc_imp);
 	}
@@ -211,8 +210,19 @@ private:
 			bool partialpath) noexcept;
 	void make_utf8_name(int index);
 	void set_curr_modified() noexcept;
+	void select_block(UInt32 folder_index) noexcept;
+	std::size_t trim_blocks(std::size_t limit) noexcept;
+
+	// a decoded solid block other than the current one
+	struct decoded_block
+	{
+		UInt32                              index;
+		Byte *                              data;
+		std::size_t                         size;
+	};
 
 	static constexpr std::size_t            CACHE_SIZE = 8;
+	static constexpr std::size_t            BLOCK_CACHE_BYTES = 256 * 1024 * 1024; // decoded solid block data to keep
 	static std::array<ptr, CACHE_SIZE>      s_cache;
 	static std::mutex                       s_cache_mutex;
 
@@ -240,6 +250,7 @@ private:
 	UInt32                                  m_block_index;
 	Byte *                                  m_out_buffer;
 	std::size_t                             m_out_buffer_size;
+	std::vector<decoded_block>              m_blocks;               // earlier decoded blocks, most recently used first
 };
 
 
@@ -272,6 +283,7 @@ public:
 	virtual std::uint32_t current_crc() const noexcept override { return m_impl->current_crc(); }
 
 	virtual std::error_condition decompress(void *buffer, std::size_t length) noexcept override { return m_impl->decompress(buffer, length); }
+	virtual std::error_condition view(std::shared_ptr<void const> &data) noexcept override { return std::errc::not_supported; }
 
 private:
 	m7z_file_impl::ptr m_impl;
@@ -412,6 +424,14 @@ void m7z_file_impl::close(ptr &&archive) noexcept
 		for ( ; cachenum > 0; cachenum--)
 			s_cache[cachenum] = std::move(s_cache[cachenum - 1]);
 		s_cache[0] = std::move(archive);
+
+		// keep decoded blocks of the most recently used archives within budget
+		std::size_t remaining(BLOCK_CACHE_BYTES);
+		for (auto &cached : s_cache)
+		{
+			if (cached)
+				remaining -= cached->trim_blocks(remaining);
+		}
 	}
 
 	// make sure it's cleaned up
@@ -455,6 +475,9 @@ std::error_condition m7z_file_impl::decompress(void *buffer, std::size_t length)
 		osd_printf_verbose("un7z: reopened archive file %s\n", m_filename);
 	}
 
+	// make the member's solid block current if it was decoded before
+	select_block(m_db.FileToFolder[m_curr_file_idx]);
+
 	std::size_t offset(0);
 	std::size_t out_size_processed(0);
 	SRes const res = SzArEx_Extract(
@@ -480,6 +503,83 @@ std::error_condition m7z_file_impl::decompress(void *buffer, std::size_t length)
 }
 
 
+/*-------------------------------------------------
+    select_block - swap in a previously decoded
+    solid block, or set the current one aside
+    before another is decoded
+-------------------------------------------------*/
+
+void m7z_file_impl::select_block(UInt32 folder_index) noexcept
+{
+	if ((folder_index == UInt32(-1)) || (m_out_buffer && (m_block_index == folder_index)))
+		return;
+
+	auto const found = std::find_if(
+			m_blocks.begin(),
+			m_blocks.end(),
+			[folder_index] (decoded_block const &block) { return block.index == folder_index; });
+	if (found != m_blocks.end())
+	{
+		// swap it with the current block, which becomes the most recently used
+		decoded_block const wanted(*found);
+		m_blocks.erase(found);
+		if (m_out_buffer)
+			m_blocks.insert(m_blocks.begin(), decoded_block{ m_block_index, m_out_buffer, m_out_buffer_size }); // erasing left room, so this can't throw
+		m_block_index = wanted.index;
+		m_out_buffer = wanted.data;
+		m_out_buffer_size = wanted.size;
+	}
+	else if (m_out_buffer)
+	{
+		// the SDK frees the current block before decoding another, so take it
+		std::size_t const needed(std::size_t(std::min<UInt64>(SzAr_GetFolderUnpackSize(&m_db.db, folder_index), BLOCK_CACHE_BYTES)));
+		try
+		{
+			m_blocks.insert(m_blocks.begin(), decoded_block{ m_block_index, m_out_buffer, m_out_buffer_size });
+			m_out_buffer = nullptr;
+			m_out_buffer_size = 0;
+		}
+		catch (...)
+		{
+		}
+		trim_blocks(BLOCK_CACHE_BYTES - needed);
+	}
+}
+
+
+/*-------------------------------------------------
+    trim_blocks - free decoded solid blocks past
+    a size limit, returning the size kept
+-------------------------------------------------*/
+
+std::size_t m7z_file_impl::trim_blocks(std::size_t limit) noexcept
+{
+	std::size_t kept(0);
+	if (m_out_buffer)
+	{
+		if (m_out_buffer_size <= limit)
+		{
+			kept = m_out_buffer_size;
+		}
+		else
+		{
+			IAlloc_Free(&m_alloc_imp, m_out_buffer);
+			m_out_buffer = nullptr;
+			m_out_buffer_size = 0;
+		}
+	}
+
+	auto it = m_blocks.begin();
+	while ((it != m_blocks.end()) && ((limit - kept) >= it->size))
+		kept += (it++)->size;
+	for (auto dropped = it; m_blocks.end() != dropped; ++dropped)
+		IAlloc_Free(&m_alloc_imp, dropped->data);
+	m_blocks.erase(it, m_blocks.end());
+
+	return kept;
+}
+
+
 int m7z_file_impl::search(
 		int i,
 		std::uint32_t search_crc,
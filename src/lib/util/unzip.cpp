@@ -12,6 +12,7 @@
 
 #include "corestr.h"
 #include "hashing.h"
+#include "inflater.h"
 #include "ioprocs.h"
 #include "timeconv.h"
 
@@ -30,9 +31,11 @@
 #include <cstring>
 #include <cstdlib>
 #include <ctime>
+#include <list>
 #include <mutex>
 #include <optional>
 #include <ratio>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -108,7 +111,7 @@ public:
 
 	static void cache_clear() noexcept
 	{
-		// clear call cache entries
+		// clear call cache entries - the directory index holds no files open, so it stays
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
 		for (auto &cached : s_cache)
 			cached.reset();
@@ -116,6 +119,16 @@ public:
 
 	std::error_condition initialize() noexcept
 	{
+		// a central directory seen before can be reused if the file hasn't changed since
+		std::unique_ptr<osd::directory::entry> stat;
+		if (!m_filename.empty())
+		{
+			try { stat = osd_stat(m_filename); }
+			catch (...) { }
+			if (stat && find_index(stat->size, stat->last_modified))
+				return std::error_condition();
+		}
+
 		// read ecd data
 		auto const ziperr = read_ecd();
 		if (ziperr)
@@ -171,6 +184,9 @@ public:
 		}
 		osd_printf_verbose("unzip: read %s central directory\n", m_filename);
 
+		if (stat && (stat->size == m_length))
+			add_index(stat->last_modified);
+
 		return std::error_condition();
 	}
 
@@ -219,6 +235,7 @@ public:
 	std::uint32_t current_crc() const noexcept { return m_header.crc; }
 
 	std::error_condition decompress(void *buffer, std::size_t length) noexcept;
+	std::error_condition view(std::shared_ptr<void const> &data) noexcept;
 
 private:
 	zip_file_impl(const zip_file_impl &) = delete;
@@ -240,6 +257,10 @@ private:
 				//osd_printf_error("unzip: error reopening archive file %s (%s:%d %s)\n", m_filename, filerr.category().name(), filerr.value(), filerr.message());
 				return filerr;
 			}
+			// map the whole archive if possible so stored members can be used in place
+			m_mapping.reset();
+			if (m_length && (std::size_t(m_length) == m_length))
+				file->map(0, std::size_t(m_length), m_mapping);
 			m_file = osd_file_read(std::move(file));
 			if (!m_file)
 			{
@@ -327,13 +348,34 @@ private:
 		std::uint64_t   cd_start_disk_offset;   // offset of start of central directory with respect to the starting disk number
 	};
 
+	// central directory of a closed archive, kept for as long as the file is unchanged
+	struct directory_index_entry
+	{
+		std::string                             filename;   // archive path
+		std::uint64_t                           length;     // archive size when read
+		std::chrono::system_clock::time_point   modified;   // archive modification time when read
+		ecd                                     dir;        // end of central directory
+		std::vector<std::uint8_t>               cd;         // central directory raw data
+	};
+	using directory_index = std::list<directory_index_entry>;
+
+	bool find_index(std::uint64_t length, std::chrono::system_clock::time_point modified) noexcept;
+	void add_index(std::chrono::system_clock::time_point modified) noexcept;
+
 	static constexpr std::size_t        DECOMPRESS_BUFSIZE = 16384;
+	static constexpr std::uint64_t      FAST_INFLATE_MAX = 64 * 1024 * 1024; // largest member to read whole for inflating
 	static constexpr std::size_t        CACHE_SIZE = 8; // number of open files to cache
 	static std::array<ptr, CACHE_SIZE>  s_cache;
 	static std::mutex                   s_cache_mutex;
+	static constexpr std::size_t        INDEX_BYTES = 32 * 1024 * 1024; // central directory data to keep in the index
+	static directory_index              s_index;        // most recently used first
+	static std::unordered_map<std::string_view, directory_index::iterator> s_index_map;
+	static std::size_t                  s_index_bytes;
+	static std::mutex                   s_index_mutex;
 
 	const std::string           m_filename;                 // copy of ZIP filename (for caching)
 	random_read::ptr            m_file;                     // file handle
+	std::shared_ptr<void const> m_mapping;                  // archive mapped into memory, if supported
 	std::uint64_t               m_length = 0;               // length of zip file
 
 	ecd                         m_ecd;                      // end of central directory
@@ -344,6 +386,7 @@ private:
 	bool                        m_curr_is_dir = false;      // current file is directory
 
 	std::array<std::uint8_t, DECOMPRESS_BUFSIZE> m_buffer;  // buffer for decompression
+	std::unique_ptr<fast_inflater> m_inflater;              // whole-buffer inflater, allocated on first use
 };
 
 
@@ -376,6 +419,7 @@ public:
 	virtual std::uint32_t current_crc() const noexcept override { return m_impl->current_crc(); }
 
 	virtual std::error_condition decompress(void *buffer, std::size_t length) noexcept override { return m_impl->decompress(buffer, length); }
+	virtual std::error_condition view(std::shared_ptr<void const> &data) noexcept override { return m_impl->view(data); }
 
 private:
 	zip_file_impl::ptr m_impl;
@@ -719,6 +763,88 @@ archive_category_impl const f_archive_category_instance;
 
 std::array<zip_file_impl::ptr, zip_file_impl::CACHE_SIZE> zip_file_impl::s_cache;
 std::mutex zip_file_impl::s_cache_mutex;
+zip_file_impl::directory_index zip_file_impl::s_index;
+std::unordered_map<std::string_view, zip_file_impl::directory_index::iterator> zip_file_impl::s_index_map;
+std::size_t zip_file_impl::s_index_bytes = 0;
+std::mutex zip_file_impl::s_index_mutex;
+
+
+
+/*-------------------------------------------------
+    find_index - take the central directory from
+    the index if the archive is unchanged
+-------------------------------------------------*/
+
+bool zip_file_impl::find_index(std::uint64_t length, std::chrono::system_clock::time_point modified) noexcept
+{
+	std::lock_guard<std::mutex> guard(s_index_mutex);
+	auto const found = s_index_map.find(m_filename);
+	if (found == s_index_map.end())
+		return false;
+
+	directory_index_entry &entry = *found->second;
+	if ((entry.length != length) || (entry.modified != modified))
+	{
+		// the file has changed, so the entry is no good any more
+		osd_printf_verbose("unzip: %s changed since its central directory was indexed\n", m_filename);
+		directory_index::iterator const stale = found->second;
+		s_index_bytes -= stale->cd.size();
+		s_index_map.erase(found);
+		s_index.erase(stale);
+		return false;
+	}
+
+	try { m_cd = entry.cd; }
+	catch (...) { return false; }
+	m_ecd = entry.dir;
+	m_length = entry.length;
+	s_index.splice(s_index.begin(), s_index, found->second);
+	osd_printf_verbose("unzip: found %s central directory in index\n", m_filename);
+	return true;
+}
+
+
+/*-------------------------------------------------
+    add_index - remember the central directory of
+    an archive that was just read
+-------------------------------------------------*/
+
+void zip_file_impl::add_index(std::chrono::system_clock::time_point modified) noexcept
+{
+	if (m_cd.size() > (INDEX_BYTES / 4))
+		return;
+
+	std::lock_guard<std::mutex> guard(s_index_mutex);
+	try
+	{
+		auto const found = s_index_map.find(m_filename);
+		if (found != s_index_map.end())
+		{
+			s_index_bytes -= found->second->cd.size();
+			directory_index::iterator const existing = found->second;
+			s_index_map.erase(found);
+			s_index.erase(existing);
+		}
+
+		s_index.emplace_front(directory_index_entry{ m_filename, m_length, modified, m_ecd, m_cd });
+		try { s_index_map.emplace(s_index.front().filename, s_index.begin()); }
+		catch (...) { s_index.pop_front(); throw; }
+		s_index_bytes += m_cd.size();
+	}
+	catch (...)
+	{
+		return;
+	}
+
+	// drop the least recently used entries to stay within budget
+	while (s_index_bytes > INDEX_BYTES)
+	{
+		directory_index_entry const &oldest = s_index.back();
+		s_index_bytes -= oldest.cd.size();
+		s_index_map.erase(oldest.filename);
+		s_index.pop_back();
+	}
+}
 
 
 
@@ -735,6 +861,7 @@ void zip_file_impl::close(ptr &&zip) noexcept
 		// close the open files
 		osd_printf_verbose("unzip: closing archive file %s and sending to cache\n", zip->m_filename);
 		zip->m_file.reset();
+		zip->m_mapping.reset();
 
 		// find the first nullptr entry in the cache
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
@@ -1201,6 +1328,47 @@ std::error_condition zip_file_impl::get_compressed_data_offset(std::uint64_t &of
 
 
 
+/*-------------------------------------------------
+    zip_file_view - get a stored file from a
+    mapped ZIP without copying it
+-------------------------------------------------*/
+
+std::error_condition zip_file_impl::view(std::shared_ptr<void const> &data) noexcept
+{
+	// only uncompressed data can be used in place
+	if ((m_header.compression != 0) || !m_header.uncompressed_length)
+		return std::errc::not_supported;
+
+	// make sure the info in the header aligns with what we know
+	if (m_header.start_disk_number != m_ecd.disk_number)
+	{
+		osd_printf_error("unzip: %s does not reside in segment %s\n", m_header.file_name, m_filename);
+		return archive_file::error::UNSUPPORTED;
+	}
+
+	// get the compressed data offset, which also reopens the archive
+	std::uint64_t offset;
+	auto const ziperr = get_compressed_data_offset(offset);
+	if (ziperr)
+		return ziperr;
+	if (!m_mapping)
+		return std::errc::not_supported;
+
+	// the data has to be entirely within the archive
+	if ((m_header.compressed_length != m_header.uncompressed_length) || (offset > m_length) || ((m_length - offset) < m_header.compressed_length))
+	{
+		osd_printf_error(
+				"unzip: unexpectedly reached end-of-file while reading %s from %s\n",
+				m_header.file_name, m_filename);
+		return archive_file::error::FILE_TRUNCATED;
+	}
+
+	data = std::shared_ptr<void const>(m_mapping, reinterpret_cast<std::uint8_t const *>(m_mapping.get()) + offset);
+	return std::error_condition();
+}
+
+
+
 /***************************************************************************
     DECOMPRESSION INTERFACES
 ***************************************************************************/
@@ -1258,6 +1426,30 @@ std::error_condition zip_file_impl::decompress_data_type_8(std::uint64_t offset,
 					return archive_file::error::DECOMPRESS_ERROR;
 				}
 			};
+	// with the whole member at hand, inflate it in one go; if anything goes
+	// wrong, fall through to zlib, which reports any errors
+	if (!m_inflater)
+		m_inflater.reset(new (std::nothrow) fast_inflater);
+	if (m_inflater)
+	{
+		std::uint8_t const *src = nullptr;
+		std::vector<std::uint8_t> data;
+		if (m_mapping && (offset <= m_length) && ((m_length - offset) >= m_header.compressed_length))
+		{
+			src = reinterpret_cast<std::uint8_t const *>(m_mapping.get()) + offset;
+		}
+		else if (m_header.compressed_length <= FAST_INFLATE_MAX)
+		{
+			std::size_t read_length(0);
+			try { data.resize(std::size_t(m_header.compressed_length)); }
+			catch (...) { }
+			if ((data.size() == m_header.compressed_length) && !m_file->read_at(offset, data.data(), data.size(), read_length) && (read_length == data.size()))
+				src = data.data();
+		}
+		if (src && m_inflater->inflate(src, std::size_t(m_header.compressed_length), reinterpret_cast<std::uint8_t *>(buffer), std::size_t(m_header.uncompressed_length)))
+			return std::error_condition();
+	}
+
 	std::uint64_t input_remaining = m_header.compressed_length;
 	int zerr;
 
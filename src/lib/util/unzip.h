@@ -85,6 +85,9 @@ public:
 
 	// decompress the most recently found file in the ZIP
 	virtual std::error_condition decompress(void *buffer, std::size_t length) noexcept = 0;
+
+	// get the most recently found file's data in place, if it's stored uncompressed and the archive can be mapped
+	virtual std::error_condition view(std::shared_ptr<void const> &data) noexcept = 0;
 };
 
 
@@ -609,6 +609,7 @@ void _1942_state::_1942(machine_config &config)
 
 	Z80(config, m_audiocpu, SOUND_CPU_CLOCK);  /* 3 MHz */
 	m_audiocpu->set_addrmap(AS_PROGRAM, &_1942_state::sound_map);
+	m_audiocpu->set_execution_domain(1); // only talks to the main CPU through the sound latch
 
 	/* video hardware */
 	GFXDECODE(config, m_gfxdecode, m_palette, gfx_1942);
@@ -617,6 +618,7 @@ void _1942_state::_1942(machine_config &config)
 
 	SCREEN(config, m_screen, SCREEN_TYPE_RASTER);
 	m_screen->set_raw(MASTER_CLOCK/2, 384, 128, 0, 262, 22, 246);   // hsync is 50..77, vsync is 257..259
+	m_screen->set_video_attributes(VIDEO_UPDATE_PARALLEL); // only reads video RAM, draws inside the cliprect
 	m_screen->set_screen_update(FUNC(_1942_state::screen_update));
 	m_screen->set_palette(m_palette);
 
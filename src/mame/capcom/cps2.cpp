@@ -10810,7 +10810,7 @@ void cps2_state::init_cps2crypt()
 		logerror("cps2 decrypt 0x%08x,0x%08x,0x%08x,0x%08x\n", key[0], key[1], lower, upper);
 
 		// we have a proper key so use it to decrypt
-		cps2_decrypt(machine(), (uint16_t *)memregion("maincpu")->base(), m_decrypted_opcodes, memregion("maincpu")->bytes(), key, lower / 2, upper / 2);
+		cps2_decrypt(machine(), *memregion("maincpu"), m_decrypted_opcodes, key, lower / 2, upper / 2);
 	}
 }
 
@@ -117,6 +117,7 @@ the decryption keys.
 
 #include "cpu/m68000/m68000.h"
 
+#include "romload.h"
 #include "ui/uimain.h"
 
 
@@ -632,8 +633,11 @@ void optimise_sboxes(optimised_sbox* out, const sbox* in)
 } // anonymous namespace
 
 
-void cps2_decrypt(running_machine &machine, uint16_t *rom, uint16_t *dec, int length, const uint32_t *master_key, uint32_t lower_limit, uint32_t upper_limit)
+void cps2_decrypt(running_machine &machine, memory_region &region, uint16_t *dec, const uint32_t *master_key, uint32_t lower_limit, uint32_t upper_limit)
 {
+	uint16_t const *const rom = reinterpret_cast<uint16_t const *>(region.base());
+	int const length = region.bytes();
+
 	optimised_sbox sboxes1[4*4];
 	optimise_sboxes(&sboxes1[0*4], fn1_r1_boxes);
 	optimise_sboxes(&sboxes1[1*4], fn1_r2_boxes);
@@ -660,58 +664,59 @@ void cps2_decrypt(running_machine &machine, uint16_t *rom, uint16_t *dec, int le
 	key1[2] ^= BIT(key1[2], 1) <<  5;
 	key1[2] ^= BIT(key1[2], 8) << 11;
 
-	for (int i = 0; i < 0x10000; ++i)
+	// every FN1 input decrypts its own set of words, so the work can be split across processors
+	auto const decrypt = [&] (uint32_t begin, uint32_t end)
 	{
-		if ((i & 0xff) == 0)
+		for (uint32_t i = begin; i < end; ++i)
 		{
-			char loadingMessage[256]; // for displaying with UI
-			sprintf(loadingMessage, "Decrypting %d%%", i*100/0x10000);
-			machine.ui().set_startup_text(loadingMessage, false);
-		}
-
+			// pass the address through FN1
+			uint16_t const seed = feistel(i, fn1_groupA, fn1_groupB,
+					&sboxes1[0*4], &sboxes1[1*4], &sboxes1[2*4], &sboxes1[3*4],
+					key1[0], key1[1], key1[2], key1[3]);
 
-		// pass the address through FN1
-		uint16_t const seed = feistel(i, fn1_groupA, fn1_groupB,
-				&sboxes1[0*4], &sboxes1[1*4], &sboxes1[2*4], &sboxes1[3*4],
-				key1[0], key1[1], key1[2], key1[3]);
 
+			// expand the result to 64-bit
+			uint32_t subkey[2];
+			expand_subkey(subkey, seed);
 
-		// expand the result to 64-bit
-		uint32_t subkey[2];
-		expand_subkey(subkey, seed);
+			// XOR with the master key
+			subkey[0] ^= master_key[0];
+			subkey[1] ^= master_key[1];
 
-		// XOR with the master key
-		subkey[0] ^= master_key[0];
-		subkey[1] ^= master_key[1];
+			// expand key to 2nd FN 96-bit key
+			uint32_t key2[4];
+			expand_2nd_key(key2, subkey);
 
-		// expand key to 2nd FN 96-bit key
-		uint32_t key2[4];
-		expand_2nd_key(key2, subkey);
+			// add extra bits for s-boxes with less than 6 inputs
+			key2[0] ^= BIT(key2[0], 0) <<  5;
+			key2[0] ^= BIT(key2[0], 6) << 11;
+			key2[1] ^= BIT(key2[1], 0) <<  5;
+			key2[1] ^= BIT(key2[1], 1) <<  4;
+			key2[2] ^= BIT(key2[2], 2) <<  5;
+			key2[2] ^= BIT(key2[2], 3) <<  4;
+			key2[2] ^= BIT(key2[2], 7) << 11;
+			key2[3] ^= BIT(key2[3], 1) <<  5;
 
-		// add extra bits for s-boxes with less than 6 inputs
-		key2[0] ^= BIT(key2[0], 0) <<  5;
-		key2[0] ^= BIT(key2[0], 6) << 11;
-		key2[1] ^= BIT(key2[1], 0) <<  5;
-		key2[1] ^= BIT(key2[1], 1) <<  4;
-		key2[2] ^= BIT(key2[2], 2) <<  5;
-		key2[2] ^= BIT(key2[2], 3) <<  4;
-		key2[2] ^= BIT(key2[2], 7) << 11;
-		key2[3] ^= BIT(key2[3], 1) <<  5;
 
-
-		// decrypt the opcodes
-		for (int a = i; a < length/2; a += 0x10000)
-		{
-			if (a >= lower_limit && a <= upper_limit)
+			// decrypt the opcodes
+			for (int a = i; a < length/2; a += 0x10000)
 			{
-				dec[a] = feistel(rom[a], fn2_groupA, fn2_groupB,
-					&sboxes2[0 * 4], &sboxes2[1 * 4], &sboxes2[2 * 4], &sboxes2[3 * 4],
-					key2[0], key2[1], key2[2], key2[3]);
-			}
-			else
-			{
-				dec[a] = rom[a];
+				if (a >= lower_limit && a <= upper_limit)
+				{
+					dec[a] = feistel(rom[a], fn2_groupA, fn2_groupB,
+						&sboxes2[0 * 4], &sboxes2[1 * 4], &sboxes2[2 * 4], &sboxes2[3 * 4],
+						key2[0], key2[1], key2[2], key2[3]);
+				}
+				else
+				{
+					dec[a] = rom[a];
+				}
 			}
 		}
-	}
+	};
+
+	// reuse the result of an earlier run with the same ROM and key if there is one
+	uint32_t const params[] = { master_key[0], master_key[1], lower_limit, upper_limit };
+	machine.ui().set_startup_text("Decrypting...", false);
+	machine.rom_load().load_derived("cps2crypt", 1, { region }, params, sizeof(params), dec, length & ~1, 0x10000, decrypt);
 }
@@ -10,6 +10,6 @@ CPS-2 Encryption
 
 #pragma once
 
-void cps2_decrypt(running_machine &machine, uint16_t *rom, uint16_t *dec, int length, const uint32_t *master_key, uint32_t lower_limit, uint32_t upper_limit);
+void cps2_decrypt(running_machine &machine, memory_region &region, uint16_t *dec, const uint32_t *master_key, uint32_t lower_limit, uint32_t upper_limit);
 
 #endif // MAME_MACHINE_CPS2CRYPT_H
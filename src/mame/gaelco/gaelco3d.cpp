@@ -177,6 +177,9 @@ WRITE_LINE_MEMBER(gaelco3d_state::ser_irq)
 
 void gaelco3d_state::machine_start()
 {
+	// program RAM is only loaded at reset, and the ROM bank is data space
+	m_adsp->enable_recompiler();
+
 	// Save state support
 	save_item(NAME(m_sound_status));
 	save_item(NAME(m_analog_ports));
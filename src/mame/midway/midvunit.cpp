@@ -65,6 +65,9 @@ void midvunit_state::machine_reset()
 	m_dcs->reset_w(0);
 	m_dcs->reset_w(1);
 
+	// the code copied here is flushed by the reset; War Gods copies it
+	// again while running (see midvplus_xf1_w), so it can't opt in
+	m_maincpu->enable_recompiler();
 	memcpy(m_ram_base, memregion("user1")->base(), 0x20000*4);
 	m_maincpu->reset();
 }
@@ -345,6 +345,10 @@ void homedata_state::reikaids_upd7807_portc_w(uint8_t data)
 	  */
 //  logerror("%s: port C wr %02x (STATUS %d DATA %d)\n", machine().describe_context(), data, BIT(data, 2), BIT(data, 6));
 
+	// the main CPU polls these, so keep the CPUs close together while they change
+	if ((m_upd7807_portc ^ data) & 0x44)
+		machine().scheduler().synchronize();
+
 	m_audiobank->set_entry(data & 0x03);
 
 	machine().bookkeeping().coin_counter_w(0, ~data & 0x80);
@@ -1307,7 +1311,7 @@ void homedata_state::reikaids(machine_config &config)
 	audiocpu.pc_out_cb().set(FUNC(homedata_state::reikaids_upd7807_portc_w));
 	audiocpu.pt_in_cb().set(m_soundlatch, FUNC(generic_latch_8_device::read));
 
-	config.set_maximum_quantum(attotime::from_hz(30000)); // very high interleave required to sync for startup tests
+	config.set_adaptive_quantum(attotime::from_hz(30000)); // very high interleave required to sync for startup tests
 
 	MCFG_MACHINE_START_OVERRIDE(homedata_state,reikaids)
 	MCFG_MACHINE_RESET_OVERRIDE(homedata_state,reikaids)
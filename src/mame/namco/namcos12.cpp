@@ -1716,6 +1716,8 @@ void namcos12_state::init_namcos12()
 	m_mainbank->set_entry( 0 );
 	m_alt_bank = 0;
 
+	m_maincpu->enable_recompiler();
+
 	save_item( NAME(m_n_dmaoffset) );
 	save_item( NAME(m_n_bankoffset) );
 }
@@ -126,6 +126,10 @@ void n64_periphs::device_start()
 	dp_delay_timer = timer_alloc(FUNC(n64_periphs::dp_delay_callback), this);
 	reset_timer = timer_alloc(FUNC(n64_periphs::reset_timer_callback), this);
 	m_n64 = machine().driver_data<n64_state>();
+
+	// the RSP recompiler has to forget anything built from IMEM the CPU overwrites
+	m_vr4300->space(AS_PROGRAM).install_write_tap(0x04001000, 0x04001fff, "rsp_imem_w",
+			[this] (offs_t offset, u32 &data, u32 mem_mask) { m_rsp->rspdrc_flush_drc_cache(); });
 }
 
 void n64_periphs::device_reset()
@@ -599,6 +603,9 @@ void n64_periphs::sp_dma(int direction)
 			if (c != sp_dma_count)
 				sp_dram_addr += sp_dma_skip;
 		}
+
+		if (sp_mem_page == 1)
+			m_rsp->rspdrc_flush_drc_cache();
 	}
 	else                    // I/DMEM -> RDRAM
 	{
@@ -87,7 +87,7 @@ int32_t n64_rdp::get_alpha_cvg(int32_t comb_alpha, rdp_span_aux* userdata, const
 	}
 	if (object.m_other_modes.alpha_cvg_select)
 	{
-		temp = (m_other_modes.cvg_times_alpha) ? (temp3 >> 3) : (temp2 << 5);
+		temp = (object.m_other_modes.cvg_times_alpha) ? (temp3 >> 3) : (temp2 << 5);
 	}
 	if (temp > 0xff)
 	{
@@ -159,6 +159,7 @@ uint32_t n64_state::screen_update_n64(screen_device &screen, bitmap_rgb32 &bitma
 	}
 	*/
 
+	m_rdp->flush("VI update");
 	m_rdp->mark_frame();
 
 	if (m_rcp_periphs->vi_blank)
@@ -2003,6 +2004,12 @@ void n64_rdp::draw_triangle(uint64_t *cmd_buf, bool shade, bool texture, bool zb
 	memset(spans, 0xcc, sizeof(spans));
 #endif
 
+	// make sure the aux buffer can take a full set of spans for this primitive
+	if (m_aux_buf_ptr + std::size(spans) * sizeof(rdp_span_aux) > EXTENT_AUX_COUNT)
+	{
+		flush("aux buffer full");
+	}
+
 	m_span_base.m_span_drdy = drdy;
 	m_span_base.m_span_dgdy = dgdy;
 	m_span_base.m_span_dbdy = dbdy;
@@ -2143,7 +2150,12 @@ void n64_rdp::draw_triangle(uint64_t *cmd_buf, bool shade, bool texture, bool zb
 				if(new_object)
 				{
 					object = &object_data().next();
-					memcpy(object->m_tmem, m_tmem.get(), 0x1000);
+					if (m_tmem_dirty || !m_tmem_snapshot)
+					{
+						memcpy(object->m_tmem, m_tmem.get(), 0x1000);
+						m_tmem_snapshot = object->m_tmem;
+						m_tmem_dirty = false;
+					}
 					new_object = false;
 				}
 
@@ -2158,7 +2170,7 @@ void n64_rdp::draw_triangle(uint64_t *cmd_buf, bool shade, bool texture, bool zb
 
 				rdp_span_aux* userdata = (rdp_span_aux*)spans[spanidx].userdata;
 				memcpy(&userdata->m_combine, &m_combine, sizeof(combine_modes_t));
-				userdata->m_tmem = object->m_tmem;
+				userdata->m_tmem = m_tmem_snapshot;
 
 				userdata->m_blend_color = m_blend_color;
 				userdata->m_prim_color = m_prim_color;
@@ -2239,8 +2251,6 @@ void n64_rdp::draw_triangle(uint64_t *cmd_buf, bool shade, bool texture, bool zb
 	{
 		render_spans(yh >> 2, yl >> 2, tilenum, flip ? true : false, spans, rect, object);
 	}
-	m_aux_buf_ptr = 0;  // Spans can be reused once render completes
-	//wait("draw_triangle");
 }
 
 /*****************************************************************************/
@@ -2252,7 +2262,6 @@ void n64_rdp::draw_triangle(uint64_t *cmd_buf, bool shade, bool texture, bool zb
 void n64_rdp::triangle(uint64_t *cmd_buf, bool shade, bool texture, bool zbuffer)
 {
 	draw_triangle(cmd_buf, shade, texture, zbuffer, false);
-	m_pipe_clean = false;
 }
 
 void n64_rdp::cmd_tex_rect(uint64_t *cmd_buf)
@@ -2357,7 +2366,7 @@ void n64_rdp::cmd_sync_tile(uint64_t *cmd_buf)
 
 void n64_rdp::cmd_sync_full(uint64_t *cmd_buf)
 {
-	//wait("SyncFull");
+	flush("SyncFull");
 	m_n64_periphs->dp_full_sync();
 }
 
@@ -2382,7 +2391,7 @@ void n64_rdp::cmd_set_convert(uint64_t *cmd_buf)
 {
 	const uint64_t w1 = cmd_buf[0];
 
-	if(!m_pipe_clean) { m_pipe_clean = true; wait("SetConvert"); }
+	flush("SetConvert");
 	int32_t k0 = int32_t(w1 >> 45) & 0x1ff;
 	int32_t k1 = int32_t(w1 >> 36) & 0x1ff;
 	int32_t k2 = int32_t(w1 >> 27) & 0x1ff;
@@ -2463,7 +2472,6 @@ void n64_rdp::cmd_set_other_modes(uint64_t *cmd_buf)
 
 void n64_rdp::cmd_load_tlut(uint64_t *cmd_buf)
 {
-	//wait("LoadTLUT");
 	n64_tile_t* tile = m_tiles;
 	const uint64_t w1 = cmd_buf[0];
 
@@ -2494,6 +2502,9 @@ void n64_rdp::cmd_load_tlut(uint64_t *cmd_buf)
 			int32_t dststart = tile[tilenum].tmem << 2;
 			uint16_t* dst = get_tmem16();
 
+			flush_if_pending(srcstart << 1, (count >> 2) << 1, "LoadTLUT");
+			m_tmem_dirty = true;
+
 			for (int32_t i = 0; i < count; i += 4)
 			{
 				if (dststart < 2048)
@@ -2535,7 +2546,6 @@ void n64_rdp::cmd_set_tile_size(uint64_t *cmd_buf)
 
 void n64_rdp::cmd_load_block(uint64_t *cmd_buf)
 {
-	//wait("LoadBlock");
 	n64_tile_t* tile = m_tiles;
 	const uint64_t w1 = cmd_buf[0];
 
@@ -2581,6 +2591,9 @@ void n64_rdp::cmd_load_block(uint64_t *cmd_buf)
 
 	const uint32_t src = (m_misc_state.m_ti_address >> 1) + (tl * tiwinwords) + slinwords;
 
+	flush_if_pending(src << 1, width << 3, "LoadBlock");
+	m_tmem_dirty = true;
+
 	m_capture.data_begin();
 
 	if (dxt != 0)
@@ -2748,7 +2761,6 @@ void n64_rdp::cmd_load_block(uint64_t *cmd_buf)
 
 void n64_rdp::cmd_load_tile(uint64_t *cmd_buf)
 {
-	//wait("LoadTile");
 	n64_tile_t* tile = m_tiles;
 	const uint64_t w1 = cmd_buf[0];
 	const int32_t tilenum = int32_t(w1 >> 24) & 0x7;
@@ -2765,6 +2777,10 @@ void n64_rdp::cmd_load_tile(uint64_t *cmd_buf)
 
 	const int32_t width = (sh - sl) + 1;
 	const int32_t height = (th - tl) + 1;
+
+	const uint32_t ti_row = (m_misc_state.m_ti_width << m_misc_state.m_ti_size) >> 1;
+	flush_if_pending(m_misc_state.m_ti_address + tl * ti_row, height * ti_row, "LoadTile");
+	m_tmem_dirty = true;
 /*
     int32_t topad;
     if (m_misc_state.m_ti_size < 3)
@@ -3039,15 +3055,22 @@ void n64_rdp::cmd_set_texture_image(uint64_t *cmd_buf)
 
 void n64_rdp::cmd_set_mask_image(uint64_t *cmd_buf)
 {
-	//wait("SetMaskImage");
 	const uint64_t w1 = cmd_buf[0];
+	if ((uint32_t(w1) & 0x01ffffff) != m_misc_state.m_zb_address)
+	{
+		flush("SetMaskImage");
+	}
 	m_misc_state.m_zb_address = uint32_t(w1) & 0x01ffffff;
 }
 
 void n64_rdp::cmd_set_color_image(uint64_t *cmd_buf)
 {
-	//wait("SetColorImage");
 	const uint64_t w1 = cmd_buf[0];
+	// queued spans in different buckets only stay ordered when they share a framebuffer
+	if ((uint32_t(w1) & 0x01ffffff) != m_misc_state.m_fb_address || ((uint32_t(w1 >> 32) & 0x3ff) + 1) != m_misc_state.m_fb_width)
+	{
+		flush("SetColorImage");
+	}
 	m_misc_state.m_fb_format  = uint32_t(w1 >> 53) & 0x7;
 	m_misc_state.m_fb_size    = uint32_t(w1 >> 51) & 0x3;
 	m_misc_state.m_fb_width   = (uint32_t(w1 >> 32) & 0x3ff) + 1;
@@ -3175,6 +3198,10 @@ n64_rdp::n64_rdp(n64_state &state, uint32_t* rdram, uint32_t* dmem) : poly_manag
 	m_aux_buf_ptr = 0;
 	m_aux_buf = nullptr;
 	m_pipe_clean = true;
+	m_pending_fb[0] = m_pending_fb[1] = 0;
+	m_pending_zb[0] = m_pending_zb[1] = 0;
+	m_tmem_snapshot = nullptr;
+	m_tmem_dirty = true;
 
 	m_pending_mode_block = false;
 
@@ -3319,7 +3346,61 @@ void n64_rdp::render_spans(int32_t start, int32_t end, int32_t tilenum, bool fli
 			render_extents<8>(clip, render_delegate(&n64_rdp::span_draw_fill, this), start, (end - start) + 1, spans + offset);
 			break;
 	}
-	wait("render spans");
+
+	// the spans are left queued; remember what they will write so that
+	// anything reading RDRAM back can wait for them
+	const uint32_t fb_row = (m_misc_state.m_fb_width << m_misc_state.m_fb_size) >> 1;
+	const uint32_t fb_start = (m_misc_state.m_fb_address & 0xffffff) + start * fb_row;
+	const uint32_t fb_end = (m_misc_state.m_fb_address & 0xffffff) + (end + 1) * fb_row;
+	const uint32_t zb_row = m_misc_state.m_fb_width << 1;
+	const uint32_t zb_start = (m_misc_state.m_zb_address & 0xffffff) + start * zb_row;
+	const uint32_t zb_end = (m_misc_state.m_zb_address & 0xffffff) + (end + 1) * zb_row;
+
+	if (m_pipe_clean)
+	{
+		m_pending_fb[0] = fb_start;
+		m_pending_fb[1] = fb_end;
+		m_pending_zb[0] = zb_start;
+		m_pending_zb[1] = zb_end;
+		m_pipe_clean = false;
+	}
+	else
+	{
+		m_pending_fb[0] = std::min(m_pending_fb[0], fb_start);
+		m_pending_fb[1] = std::max(m_pending_fb[1], fb_end);
+		m_pending_zb[0] = std::min(m_pending_zb[0], zb_start);
+		m_pending_zb[1] = std::max(m_pending_zb[1], zb_end);
+	}
+}
+
+void n64_rdp::flush(const char *reason)
+{
+	if (!m_pipe_clean)
+	{
+		wait(reason);
+
+		// the per-primitive state, including the TMEM snapshot, went with the wait
+		m_pipe_clean = true;
+		m_tmem_snapshot = nullptr;
+	}
+
+	// nothing queued refers to the aux buffer any more
+	m_aux_buf_ptr = 0;
+}
+
+void n64_rdp::flush_if_pending(uint32_t start, uint32_t length, const char *reason)
+{
+	if (m_pipe_clean)
+	{
+		return;
+	}
+
+	start &= 0xffffff;
+	const uint32_t end = start + length;
+	if ((start < m_pending_fb[1] && end > m_pending_fb[0]) || (start < m_pending_zb[1] && end > m_pending_zb[0]))
+	{
+		flush(reason);
+	}
 }
 
 void n64_rdp::rgbaz_clip(int32_t sr, int32_t sg, int32_t sb, int32_t sa, int32_t* sz, rdp_span_aux* userdata)
@@ -300,6 +300,10 @@ public:
 
 	void            draw_triangle(uint64_t *cmd_buf, bool shade, bool texture, bool zbuffer, bool rect);
 
+	// Deferred rendering: spans stay queued across primitives until something needs their results
+	void            flush(const char *reason);
+	void            flush_if_pending(uint32_t start, uint32_t length, const char *reason);
+
 	std::unique_ptr<uint8_t[]>  m_aux_buf;
 	uint32_t          m_aux_buf_ptr;
 	uint32_t          m_aux_buf_index;
@@ -354,6 +358,11 @@ private:
 	bool            m_pending_mode_block;
 	bool            m_pipe_clean;
 
+	uint32_t        m_pending_fb[2];        // RDRAM byte range [start, end) written by queued spans
+	uint32_t        m_pending_zb[2];        // same, for the depth buffer
+	uint8_t*        m_tmem_snapshot;        // TMEM copy shared by queued primitives until the next load
+	bool            m_tmem_dirty;
+
 	cv_mask_derivative_t cvarray[(1 << 8)];
 
 	uint16_t  m_z_com_table[0x40000]; //precalced table of compressed z values, 18b: 512 KB array!
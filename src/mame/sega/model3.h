@@ -394,8 +394,8 @@ private:
 	void draw_layer(bitmap_rgb32 &bitmap, const rectangle &cliprect, int layer, int sx, int sy, int prio);
 	void invalidate_texture(int page, int texx, int texy, int texwidth, int texheight);
 	cached_texture *get_texture(int page, int texx, int texy, int texwidth, int texheight, int format);
-	inline void write_texture16(int xpos, int ypos, int width, int height, int page, uint16_t *data);
-	inline void write_texture8(int xpos, int ypos, int width, int height, int page, int upper, int lower, uint16_t *data);
+	inline bool write_texture16(int xpos, int ypos, int width, int height, int page, uint16_t *data);
+	inline bool write_texture8(int xpos, int ypos, int width, int height, int page, int upper, int lower, uint16_t *data);
 	void real3d_upload_texture(uint32_t header, uint32_t *data);
 	void init_matrix_stack();
 	void get_top_matrix(MATRIX *out);
@@ -988,9 +988,10 @@ static const uint8_t texture_decode8[32] =
 	24, 26, 28, 30
 };
 
-inline void model3_state::write_texture16(int xpos, int ypos, int width, int height, int page, uint16_t *data)
+inline bool model3_state::write_texture16(int xpos, int ypos, int width, int height, int page, uint16_t *data)
 {
 	int x,y,i,j;
+	uint16_t diff = 0;
 
 	for(y=ypos; y < ypos+height; y+=8)
 	{
@@ -1000,7 +1001,9 @@ inline void model3_state::write_texture16(int xpos, int ypos, int width, int hei
 			int b = 0;
 			for(j=y; j < y+8; j++) {
 				for(i=x; i < x+8; i++) {
-					*texture++ = data[texture_decode16[b^1]];
+					uint16_t const d = data[texture_decode16[b^1]];
+					diff |= *texture ^ d;
+					*texture++ = d;
 					++b;
 				}
 				texture += 2048-8;
@@ -1008,11 +1011,14 @@ inline void model3_state::write_texture16(int xpos, int ypos, int width, int hei
 			data += 64;
 		}
 	}
+
+	return diff != 0;
 }
 
-inline void model3_state::write_texture8(int xpos, int ypos, int width, int height, int page, int upper, int lower, uint16_t *data)
+inline bool model3_state::write_texture8(int xpos, int ypos, int width, int height, int page, int upper, int lower, uint16_t *data)
 {
 	int x,y,i,j;
+	uint16_t diff = 0;
 
 	for(y=ypos; y < ypos+height; y+=8)
 	{
@@ -1025,6 +1031,8 @@ inline void model3_state::write_texture8(int xpos, int ypos, int width, int heig
 				for(i=x; i < x+8; i+=2)
 				{
 					uint16_t d = data[texture_decode8[b]];
+					uint16_t const old0 = texture[0];
+					uint16_t const old1 = texture[1];
 
 					if (upper)
 						*texture = (*texture & 0xff) | (d & 0xff00);
@@ -1038,6 +1046,7 @@ inline void model3_state::write_texture8(int xpos, int ypos, int width, int heig
 						*texture = (*texture & 0xff00) | (d & 0xff);
 					texture++;
 
+					diff |= (texture[-2] ^ old0) | (texture[-1] ^ old1);
 					++b;
 				}
 				texture += 2048-8;
@@ -1045,6 +1054,8 @@ inline void model3_state::write_texture8(int xpos, int ypos, int width, int heig
 			data += 32;
 		}
 	}
+
+	return diff != 0;
 }
 
 /*
@@ -1092,6 +1103,10 @@ void model3_state::real3d_upload_texture(uint32_t header, uint32_t *data)
 	int upper_byte = (header >> 22) & 0x1;
 	int lower_byte = (header >> 21) & 0x1;
 
+	// games re-upload the same textures every frame, so the decoded cache
+	// entries are only thrown away when the upload actually changes texture RAM
+	bool changed = false;
+
 	//printf("write tex: %08X, w %d, h %d, x %d, y %d, p %d, b %d\n", header, width, height, xpos, ypos, page, bitdepth);
 
 	switch(header >> 24)
@@ -1109,12 +1124,12 @@ void model3_state::real3d_upload_texture(uint32_t header, uint32_t *data)
 			{
 				if (bitdepth)
 				{
-					write_texture16(x, y, w, h, page, (uint16_t*)data);
+					changed |= write_texture16(x, y, w, h, page, (uint16_t*)data);
 				}
 				else
 				{
 					//printf("write tex8: %08X, w %d, h %d, x %d, y %d, p %d, b %d\n", header, width, height, xpos, ypos, page, bitdepth);
-					write_texture8(x, y, w, h, page, upper_byte, lower_byte, (uint16_t*)data);
+					changed |= write_texture8(x, y, w, h, page, upper_byte, lower_byte, (uint16_t*)data);
 				}
 
 				data += (w * h * (bitdepth ? 2 : 1)) / 4;
@@ -1126,22 +1141,24 @@ void model3_state::real3d_upload_texture(uint32_t header, uint32_t *data)
 				mipmap++;
 			}
 
-			invalidate_texture(page, header & 0x3f, (header >> 7) & 0x1f, (header >> 14) & 0x7, (header >> 17) & 0x7);
+			if (changed)
+				invalidate_texture(page, header & 0x3f, (header >> 7) & 0x1f, (header >> 14) & 0x7, (header >> 17) & 0x7);
 			break;
 		}
 		case 0x01:      /* Texture without mipmaps */
 		{
 			if (bitdepth)
 			{
-				write_texture16(xpos, ypos, width, height, page, (uint16_t*)data);
+				changed |= write_texture16(xpos, ypos, width, height, page, (uint16_t*)data);
 			}
 			else
 			{
 				//printf("write tex8: %08X, w %d, h %d, x %d, y %d, p %d, b %d\n", header, width, height, xpos, ypos, page, bitdepth);
-				write_texture8(xpos, ypos, width, height, page, upper_byte, lower_byte, (uint16_t*)data);
+				changed |= write_texture8(xpos, ypos, width, height, page, upper_byte, lower_byte, (uint16_t*)data);
 			}
 
-			invalidate_texture(page, header & 0x3f, (header >> 7) & 0x1f, (header >> 14) & 0x7, (header >> 17) & 0x7);
+			if (changed)
+				invalidate_texture(page, header & 0x3f, (header >> 7) & 0x1f, (header >> 14) & 0x7, (header >> 17) & 0x7);
 			break;
 		}
 		case 0x02:      /* Only mipmaps */
@@ -1157,12 +1174,12 @@ void model3_state::real3d_upload_texture(uint32_t header, uint32_t *data)
 			{
 				if (bitdepth)
 				{
-					write_texture16(x, y, w, h, page, (uint16_t*)data);
+					changed |= write_texture16(x, y, w, h, page, (uint16_t*)data);
 				}
 				else
 				{
 					//printf("write tex8: %08X, w %d, h %d, x %d, y %d, p %d, b %d\n", header, width, height, xpos, ypos, page, bitdepth);
-					write_texture8(x, y, w, h, page, upper_byte, lower_byte, (uint16_t*)data);
+					changed |= write_texture8(x, y, w, h, page, upper_byte, lower_byte, (uint16_t*)data);
 				}
 
 				data += (w * h * (bitdepth ? 2 : 1)) / 4;
@@ -1174,7 +1191,8 @@ void model3_state::real3d_upload_texture(uint32_t header, uint32_t *data)
 				mipmap++;
 			}
 
-			invalidate_texture(page, header & 0x3f, (header >> 7) & 0x1f, (header >> 14) & 0x7, (header >> 17) & 0x7);
+			if (changed)
+				invalidate_texture(page, header & 0x3f, (header >> 7) & 0x1f, (header >> 14) & 0x7, (header >> 17) & 0x7);
 			break;
 		}
 		case 0x80:      /* Gamma-table ? */
@@ -2492,16 +2492,17 @@ inline void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti,
 									float dvldy, float dvrdy,
 									float dwldy, float dwrdy,
 									float const dbldy[4], float const dbrdy[4],
-									float const doldy[4], float const dordy[4])
+									float const doldy[4], float const dordy[4],
+									const rectangle &cliprect)
 {
 	int idx;
 	float dy;
 	int yy0, yy1;
 
-	if(y1 <= 0)
+	if(y1 <= cliprect.top())
 		return;
-	if(y1 > 480)
-		y1 = 480;
+	if(y1 > cliprect.bottom() + 1)
+		y1 = cliprect.bottom() + 1;
 
 	float bl[4], br[4], offl[4], offr[4];
 	memcpy(bl, bl_in, sizeof(bl));
@@ -2509,23 +2510,24 @@ inline void powervr2_device::render_span(bitmap_rgb32 &bitmap, texinfo *ti,
 	memcpy(offl, offl_in, sizeof(offl));
 	memcpy(offr, offr_in, sizeof(offr));
 
-	if(y0 < 0) {
-		xl += -dxldy*y0;
-		xr += -dxrdy*y0;
-		ul += -duldy*y0;
-		ur += -durdy*y0;
-		vl += -dvldy*y0;
-		vr += -dvrdy*y0;
-		wl += -dwldy*y0;
-		wr += -dwrdy*y0;
+	if(y0 < cliprect.top()) {
+		float const skip = cliprect.top() - y0;
+		xl += dxldy*skip;
+		xr += dxrdy*skip;
+		ul += duldy*skip;
+		ur += durdy*skip;
+		vl += dvldy*skip;
+		vr += dvrdy*skip;
+		wl += dwldy*skip;
+		wr += dwrdy*skip;
 
 		for (idx = 0; idx < 4; idx++) {
-			bl[idx] += -dbldy[idx] * y0;
-			br[idx] += -dbrdy[idx] * y0;
-			offl[idx] += -doldy[idx] * y0;
-			offr[idx] += -dordy[idx] * y0;
+			bl[idx] += dbldy[idx] * skip;
+			br[idx] += dbrdy[idx] * skip;
+			offl[idx] += doldy[idx] * skip;
+			offr[idx] += dordy[idx] * skip;
 		}
-		y0 = 0;
+		y0 = cliprect.top();
 	}
 
 	yy0 = round(y0);
@@ -2610,13 +2612,13 @@ void powervr2_device::sort_vertices(const vert *v, int *i0, int *i1, int *i2)
 
 
 template <powervr2_device::pix_sample_fn sample_fn, int group_no>
-inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v0, const vert *v1, const vert *v2)
+inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v0, const vert *v1, const vert *v2, const rectangle &cliprect)
 {
 	float dy01, dy02, dy12;
 
 	float dx01dy, dx02dy, dx12dy, du01dy, du02dy, du12dy, dv01dy, dv02dy, dv12dy, dw01dy, dw02dy, dw12dy;
 
-	if(v0->y >= 480 || v2->y < 0)
+	if(v0->y >= cliprect.bottom() + 1 || v2->y < cliprect.top())
 		return;
 
 	float db01[4] = {
@@ -2728,15 +2730,15 @@ inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti
 			return;
 
 		if(v1->x > v0->x)
-			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y, v0->x, v1->x, v0->u, v1->u, v0->v, v1->v, v0->w, v1->w, v0->b, v1->b, v0->o, v1->o, dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy, db02dy, db12dy, do02dy, do12dy);
+			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y, v0->x, v1->x, v0->u, v1->u, v0->v, v1->v, v0->w, v1->w, v0->b, v1->b, v0->o, v1->o, dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy, db02dy, db12dy, do02dy, do12dy, cliprect);
 		else
-			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y, v1->x, v0->x, v1->u, v0->u, v1->v, v0->v, v1->w, v0->w, v1->b, v0->b, v1->o, v0->o, dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy, db12dy, db02dy, do12dy, do02dy);
+			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y, v1->x, v0->x, v1->u, v0->u, v1->v, v0->v, v1->w, v0->w, v1->b, v0->b, v1->o, v0->o, dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy, db12dy, db02dy, do12dy, do02dy, cliprect);
 
 	} else if(!dy12) {
 		if(v2->x > v1->x)
-			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o, dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy, db01dy, db02dy, do01dy, do02dy);
+			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o, dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy, db01dy, db02dy, do01dy, do02dy, cliprect);
 		else
-			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o, dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy, db02dy, db01dy, do02dy, do01dy);
+			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y, v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o, dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy, db02dy, db01dy, do02dy, do01dy, cliprect);
 
 	} else {
 			float idk_b[4] = {
@@ -2754,23 +2756,23 @@ inline void powervr2_device::render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti
 		if(dx01dy < dx02dy) {
 			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y,
 						v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o,
-						dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy, db01dy, db02dy, do01dy, do02dy);
+						dx01dy, dx02dy, du01dy, du02dy, dv01dy, dv02dy, dw01dy, dw02dy, db01dy, db02dy, do01dy, do02dy, cliprect);
 			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y,
 						v1->x, v0->x + dx02dy*dy01, v1->u, v0->u + du02dy*dy01, v1->v, v0->v + dv02dy*dy01, v1->w, v0->w + dw02dy*dy01, v1->b, idk_b, v1->o, idk_o,
-						dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy, db12dy, db02dy, do12dy, do02dy);
+						dx12dy, dx02dy, du12dy, du02dy, dv12dy, dv02dy, dw12dy, dw02dy, db12dy, db02dy, do12dy, do02dy, cliprect);
 		} else {
 			render_span<sample_fn, group_no>(bitmap, ti, v0->y, v1->y,
 						v0->x, v0->x, v0->u, v0->u, v0->v, v0->v, v0->w, v0->w, v0->b, v0->b, v0->o, v0->o,
-						dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy, db02dy, db01dy, do02dy, do01dy);
+						dx02dy, dx01dy, du02dy, du01dy, dv02dy, dv01dy, dw02dy, dw01dy, db02dy, db01dy, do02dy, do01dy, cliprect);
 			render_span<sample_fn, group_no>(bitmap, ti, v1->y, v2->y,
 						v0->x + dx02dy*dy01, v1->x, v0->u + du02dy*dy01, v1->u, v0->v + dv02dy*dy01, v1->v, v0->w + dw02dy*dy01, v1->w, idk_b, v1->b, idk_o, v1->o,
-						dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy, db02dy, db12dy, do02dy, do12dy);
+						dx02dy, dx12dy, du02dy, du12dy, dv02dy, dv12dy, dw02dy, dw12dy, db02dy, db12dy, do02dy, do12dy, cliprect);
 		}
 	}
 }
 
 template <int group_no>
-void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v)
+void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v, const rectangle &cliprect)
 {
 	int i0, i1, i2;
 
@@ -2783,16 +2785,16 @@ void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *
 		if (bilinear) {
 			switch (ti->tsinstruction) {
 			case 0:
-				render_tri_sorted<&powervr2_device::sample_textured<0,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<0,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2, cliprect);
 				break;
 			case 1:
-				render_tri_sorted<&powervr2_device::sample_textured<1,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<1,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2, cliprect);
 				break;
 			case 2:
-				render_tri_sorted<&powervr2_device::sample_textured<2,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<2,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2, cliprect);
 				break;
 			case 3:
-				render_tri_sorted<&powervr2_device::sample_textured<3,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<3,true>, group_no>(bitmap, ti, v+i0, v+i1, v+i2, cliprect);
 				break;
 			default:
 				/*
@@ -2800,21 +2802,21 @@ void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *
 				 * AND'd with 3
 				 */
 				logerror("%s - tsinstruction is 0x%08x\n", (unsigned)ti->tsinstruction);
-				render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, ti, v+i0, v+i1, v+i2, cliprect);
 			}
 		} else {
 			switch (ti->tsinstruction) {
 			case 0:
-				render_tri_sorted<&powervr2_device::sample_textured<0,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<0,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2, cliprect);
 				break;
 			case 1:
-				render_tri_sorted<&powervr2_device::sample_textured<1,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<1,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2, cliprect);
 				break;
 			case 2:
-				render_tri_sorted<&powervr2_device::sample_textured<2,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<2,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2, cliprect);
 				break;
 			case 3:
-				render_tri_sorted<&powervr2_device::sample_textured<3,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_textured<3,false>, group_no>(bitmap, ti, v+i0, v+i1, v+i2, cliprect);
 				break;
 			default:
 				/*
@@ -2822,11 +2824,11 @@ void powervr2_device::render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *
 				 * AND'd with 3
 				 */
 				logerror("%s - tsinstruction is 0x%08x\n", (unsigned)ti->tsinstruction);
-				render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+				render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, ti, v+i0, v+i1, v+i2, cliprect);
 			}
 		}
 	} else {
-			render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, ti, v+i0, v+i1, v+i2);
+			render_tri_sorted<&powervr2_device::sample_nontextured, group_no>(bitmap, ti, v+i0, v+i1, v+i2, cliprect);
 	}
 }
 
@@ -2860,44 +2862,108 @@ void powervr2_device::render_group_to_accumulation_buffer(bitmap_rgb32 &bitmap,c
 		if(ev == -1)
 			continue;
 
-		for(i=sv; i <= ev; i++)
-		{
-			vert *tv = grab[rs].verts + i;
-			tv->u = tv->u * ts->ti.sizex * tv->w;
-			tv->v = tv->v * ts->ti.sizey * tv->w;
-		}
-
 		for(i=sv; i <= ev-2; i++)
 		{
 			if (!(debug_dip_status&0x2))
-				render_tri<group_no>(bitmap, &ts->ti, grab[rs].verts + i);
+				render_tri<group_no>(bitmap, &ts->ti, grab[rs].verts + i, cliprect);
 
 		}
 	}
 }
 
+// scale the texture coordinates by the texture size and w, once per frame
+// before any band starts rendering
+void powervr2_device::prepare_group_vertices(int group_no)
+{
+	int rs=renderselect;
+
+	struct poly_group *grp = grab[rs].groups + group_no;
+
+	int ns=grp->strips_size;
+
+	for (int cs=0;cs < ns;cs++)
+	{
+		strip *ts = &grp->strips[cs];
+		int sv = ts->svert;
+		int ev = ts->evert;
+		if(ev == -1)
+			continue;
+
+		for(int i=sv; i <= ev; i++)
+		{
+			vert *tv = grab[rs].verts + i;
+			tv->u = tv->u * ts->ti.sizex * tv->w;
+			tv->v = tv->v * ts->ti.sizey * tv->w;
+		}
+	}
+}
+
 void powervr2_device::render_to_accumulation_buffer(bitmap_rgb32 &bitmap, const rectangle &cliprect) {
 	if (renderselect < 0)
 		return;
 
-	memset(wbuffer, 0x00, sizeof(wbuffer));
-
 	dc_state *state = machine().driver_data<dc_state>();
 	address_space &space = state->m_maincpu->space(AS_PROGRAM);
 
 	// TODO: read ISP/TSP command from isp_background_t instead of assuming Gourad-shaded
 	// full-screen polygon.
 	uint32_t c=space.read_dword(0x05000000+(param_base&0xf00000)+((isp_backgnd_t&0xfffff8)>>1)+(3+3)*4);
-	bitmap.fill(c, cliprect);
 
-	// TODO: modifier volumes
-	render_group_to_accumulation_buffer<DISPLAY_LIST_OPAQUE>(bitmap, cliprect);
-	render_group_to_accumulation_buffer<DISPLAY_LIST_TRANS>(bitmap, cliprect);
-	render_group_to_accumulation_buffer<DISPLAY_LIST_PUNCH_THROUGH>(bitmap, cliprect);
+	prepare_group_vertices(DISPLAY_LIST_OPAQUE);
+	prepare_group_vertices(DISPLAY_LIST_TRANS);
+	prepare_group_vertices(DISPLAY_LIST_PUNCH_THROUGH);
+
+	// the bands are fixed so the output doesn't depend on the number of threads
+	for (int band = 0; band < int(std::size(m_render_bands)); band++)
+	{
+		render_band &cur = m_render_bands[band];
+		cur.device = this;
+		cur.bitmap = &bitmap;
+		cur.clip = cliprect;
+		cur.clip &= rectangle(cliprect.left(), cliprect.right(), band * RENDER_BAND_HEIGHT, (band + 1) * RENDER_BAND_HEIGHT - 1);
+		cur.background = c;
+	}
+
+	// rows below the bands never get any polygons, only the background
+	rectangle rest(cliprect.left(), cliprect.right(), std::size(m_render_bands) * RENDER_BAND_HEIGHT, cliprect.bottom());
+	rest &= cliprect;
+	if (!rest.empty())
+		bitmap.fill(c, rest);
+
+	// render the first band on this thread while the others run on the queue
+	if (m_render_queue)
+	{
+		osd_work_item_queue_multiple(m_render_queue, &powervr2_device::render_band_callback, std::size(m_render_bands) - 1, &m_render_bands[1], sizeof(m_render_bands[1]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		render_band_callback(&m_render_bands[0], 0);
+		osd_work_queue_wait(m_render_queue, osd_ticks_per_second() * 10);
+	}
+	else
+	{
+		for (render_band &cur : m_render_bands)
+			render_band_callback(&cur, 0);
+	}
 
 	grab[renderselect].busy=0;
 }
 
+void *powervr2_device::render_band_callback(void *param, int threadid)
+{
+	render_band &band = *reinterpret_cast<render_band *>(param);
+	powervr2_device &pvr = *band.device;
+	if (band.clip.empty())
+		return nullptr;
+
+	// each band clears its own part of the w buffer
+	memset(&pvr.wbuffer[band.clip.top()][0], 0x00, sizeof(pvr.wbuffer[0]) * band.clip.height());
+	band.bitmap->fill(band.background, band.clip);
+
+	// TODO: modifier volumes
+	pvr.render_group_to_accumulation_buffer<DISPLAY_LIST_OPAQUE>(*band.bitmap, band.clip);
+	pvr.render_group_to_accumulation_buffer<DISPLAY_LIST_TRANS>(*band.bitmap, band.clip);
+	pvr.render_group_to_accumulation_buffer<DISPLAY_LIST_PUNCH_THROUGH>(*band.bitmap, band.clip);
+	return nullptr;
+}
+
 // copies the accumulation buffer into the framebuffer, converting to the specified format
 // not accurate, ignores field stuff and just uses SOF1 for now
 // also ignores scale effects (can scale accumulation buffer to half size with filtering etc.)
@@ -3911,6 +3977,8 @@ void powervr2_device::device_start()
 
 	grab = std::make_unique<receiveddata[]>(NUM_BUFFERS);
 
+	m_render_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+
 	pvr_build_parameterconfig();
 
 	computedilated();
@@ -4048,6 +4116,13 @@ void powervr2_device::device_start()
 	save_item(NAME(next_y));
 }
 
+void powervr2_device::device_stop()
+{
+	if (m_render_queue)
+		osd_work_queue_free(m_render_queue);
+	m_render_queue = nullptr;
+}
+
 void powervr2_device::device_reset()
 {
 	softreset =                 0x00000007;
@@ -59,6 +59,21 @@ public:
 	//  our implementation is not currently tile based, and thus the accumulation buffer is screen sized
 	std::unique_ptr<bitmap_rgb32> fake_accumulationbuffer_bitmap;
 
+	// the accumulation buffer is rendered in bands one tile high, each on its own
+	// thread and each owning its rows of the bitmap and the w buffer
+	static constexpr int RENDER_BAND_HEIGHT = 32;
+
+	struct render_band
+	{
+		powervr2_device *device = nullptr;
+		bitmap_rgb32 *bitmap = nullptr;
+		rectangle clip;
+		uint32_t background = 0;
+	};
+
+	osd_work_queue *m_render_queue = nullptr;
+	render_band m_render_bands[480 / RENDER_BAND_HEIGHT];
+
 	/*
 	 * Per-polygon base and offset colors.  These are scaled by per-vertex
 	 * weights.
@@ -339,6 +354,7 @@ public:
 
 protected:
 	virtual void device_start() override;
+	virtual void device_stop() override;
 	virtual void device_reset() override;
 	ioport_constructor device_input_ports() const override;
 
@@ -525,21 +541,25 @@ private:
 								float dvldy, float dvrdy,
 								float dwldy, float dwrdy,
 								float const dbldy[4], float const dbrdy[4],
-								float const doldy[4], float const dordy[4]);
+								float const doldy[4], float const dordy[4],
+								const rectangle &cliprect);
 
 	template <pix_sample_fn sample_fn, int group_no>
 		inline void render_tri_sorted(bitmap_rgb32 &bitmap, texinfo *ti,
 										const vert *v0,
-										const vert *v1, const vert *v2);
+										const vert *v1, const vert *v2,
+										const rectangle &cliprect);
 
 	template <int group_no>
-		void render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v);
+		void render_tri(bitmap_rgb32 &bitmap, texinfo *ti, const vert *v, const rectangle &cliprect);
 
 	template <int group_no>
 		void render_group_to_accumulation_buffer(bitmap_rgb32 &bitmap, const rectangle &cliprect);
 
 	void sort_vertices(const vert *v, int *i0, int *i1, int *i2);
+	void prepare_group_vertices(int group_no);
 	void render_to_accumulation_buffer(bitmap_rgb32 &bitmap, const rectangle &cliprect);
+	static void *render_band_callback(void *param, int threadid);
 	void pvr_accumulationbuffer_to_framebuffer(address_space &space, int x, int y);
 	void pvr_drawframebuffer(bitmap_rgb32 &bitmap,const rectangle &cliprect);
 	static uint32_t dilate0(uint32_t value,int bits);
@@ -188,6 +188,7 @@ protected:
 	void drawpixel_4bpp_notrans(int x, int y, int patterndata, int offsetcnt);
 	void drawpixel_4bpp_trans(int x, int y, int patterndata, int offsetcnt);
 	void drawpixel_generic(int x, int y, int patterndata, int offsetcnt);
+	void vdp1_fill_span(int32_t y, int xx1, int xx2, int patterndata, int xsize, int32_t u, int32_t v, int32_t slux, int32_t slvx);
 	void vdp1_fill_slope(const rectangle &cliprect, int patterndata, int xsize,
 							int32_t x1, int32_t x2, int32_t sl1, int32_t sl2, int32_t *nx1, int32_t *nx2,
 							int32_t u1, int32_t u2, int32_t slu1, int32_t slu2, int32_t *nu1, int32_t *nu2,
@@ -1120,6 +1120,42 @@ void saturn_state::stv_vdp1_set_drawpixel( void )
 }
 
 
+/* the plain modes are drawn a span at a time into the framebuffer line,
+   anything else goes through drawpixel for every pixel */
+void saturn_state::vdp1_fill_span(int32_t y, int xx1, int xx2, int patterndata, int xsize, int32_t u, int32_t v, int32_t slux, int32_t slvx)
+{
+	if(drawpixel == &saturn_state::drawpixel_poly) {
+		/* same limits as drawpixel_poly */
+		xx2 = std::min(xx2, 1023);
+		if(y >= 512 || xx1 > xx2)
+			return;
+		uint16_t *const line = m_vdp1.framebuffer_draw_lines[y];
+		std::fill(line + xx1, line + xx2 + 1, uint16_t(stv2_current_sprite.CMDCOLR));
+	} else if(drawpixel == &saturn_state::drawpixel_8bpp_trans) {
+		uint16_t *const line = m_vdp1.framebuffer_draw_lines[y];
+		uint8_t const *const gfx = m_vdp1.gfx_decode.get();
+		for(; xx1 <= xx2; xx1++, u += slux, v += slvx) {
+			uint16_t const pix = gfx[patterndata+(v>>FRAC_SHIFT)*xsize+(u>>FRAC_SHIFT)];
+			if(pix != 0)
+				line[xx1] = pix | m_sprite_colorbank;
+		}
+	} else if(drawpixel == &saturn_state::drawpixel_4bpp_trans || drawpixel == &saturn_state::drawpixel_4bpp_notrans) {
+		bool const trans = drawpixel == &saturn_state::drawpixel_4bpp_trans;
+		uint16_t *const line = m_vdp1.framebuffer_draw_lines[y];
+		uint8_t const *const gfx = m_vdp1.gfx_decode.get();
+		for(; xx1 <= xx2; xx1++, u += slux, v += slvx) {
+			int const offsetcnt = (v>>FRAC_SHIFT)*xsize+(u>>FRAC_SHIFT);
+			uint16_t pix = gfx[patterndata+offsetcnt/2];
+			pix = offsetcnt&1 ? (pix & 0x0f) : ((pix & 0xf0)>>4);
+			if(pix != 0 || !trans)
+				line[xx1] = pix | m_sprite_colorbank;
+		}
+	} else {
+		for(; xx1 <= xx2; xx1++, u += slux, v += slvx)
+			(this->*drawpixel)(xx1, y, patterndata, (v>>FRAC_SHIFT)*xsize+(u>>FRAC_SHIFT));
+	}
+}
+
 void saturn_state::vdp1_fill_slope(const rectangle &cliprect, int patterndata, int xsize,
 							int32_t x1, int32_t x2, int32_t sl1, int32_t sl2, int32_t *nx1, int32_t *nx2,
 							int32_t u1, int32_t u2, int32_t slu1, int32_t slu2, int32_t *nu1, int32_t *nu2,
@@ -1209,12 +1245,7 @@ void saturn_state::vdp1_fill_slope(const rectangle &cliprect, int patterndata, i
 				if(xx2 > cliprect.max_x)
 					xx2 = cliprect.max_x;
 
-				while(xx1 <= xx2) {
-					(this->*drawpixel)(xx1,_y1, patterndata, (v>>FRAC_SHIFT)*xsize+(u>>FRAC_SHIFT));
-					xx1++;
-					u += slux;
-					v += slvx;
-				}
+				vdp1_fill_span(_y1, xx1, xx2, patterndata, xsize, u, v, slux, slvx);
 			}
 		}
 
@@ -1261,12 +1292,7 @@ void saturn_state::vdp1_fill_line(const rectangle &cliprect, int patterndata, in
 		if(xx2 > cliprect.max_x)
 			xx2 = cliprect.max_x;
 
-		while(xx1 <= xx2) {
-			(this->*drawpixel)(xx1,y,patterndata,(v>>FRAC_SHIFT)*xsize+(u>>FRAC_SHIFT));
-			xx1++;
-			u += slux;
-			v += slvx;
-		}
+		vdp1_fill_span(y, xx1, xx2, patterndata, xsize, u, v, slux, slvx);
 	}
 }
 
@@ -57,7 +57,8 @@ uint32_t segas16a_state::screen_update(screen_device &screen, bitmap_ind16 &bitm
 	m_segaic16vid->tilemap_draw( screen, bitmap, cliprect, 0, segaic16_video_device::TILEMAP_TEXT, 0, 0x04);
 	m_segaic16vid->tilemap_draw( screen, bitmap, cliprect, 0, segaic16_video_device::TILEMAP_TEXT, 1, 0x08);
 
-	// mix in sprites
+	// mix in sprites; those with all color bits set trigger shadow/hilight
+	sprite_line_buffer::mix_params const params{ 0x400, 0x3ff, 10, 3, 0x3f0, 0x3f0, uint16_t(m_palette_entries) };
 	bitmap_ind16 &sprites = m_sprites->bitmap();
 	for (const sparse_dirty_rect *rect = m_sprites->first_dirty_rect(cliprect); rect != nullptr; rect = rect->next())
 		for (int y = rect->min_y; y <= rect->max_y; y++)
@@ -65,26 +66,7 @@ uint32_t segas16a_state::screen_update(screen_device &screen, bitmap_ind16 &bitm
 			uint16_t *dest = &bitmap.pix(y);
 			uint16_t *src = &sprites.pix(y);
 			uint8_t *pri = &screen.priority().pix(y);
-			for (int x = rect->min_x; x <= rect->max_x; x++)
-			{
-				// only process written pixels
-				uint16_t pix = src[x];
-				if (pix != 0xffff)
-				{
-					// compare sprite priority against tilemap priority
-					int priority = pix >> 10;
-					if ((1 << priority) > pri[x])
-					{
-						// if color bits are all 1, this triggers shadow/hilight
-						if ((pix & 0x3f0) == 0x3f0)
-							dest[x] += m_palette_entries;
-
-						// otherwise, just add in sprite palette base
-						else
-							dest[x] = 0x400 | (pix & 0x3ff);
-					}
-				}
-			}
+			sprite_line_buffer::mix_row(dest, src, pri, rect->min_x, rect->max_x, params);
 		}
 
 	return 0;
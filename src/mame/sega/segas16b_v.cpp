@@ -60,6 +60,9 @@ uint32_t segas16b_state::screen_update(screen_device &screen, bitmap_ind16 &bitm
 
 	// mix in sprites
 	if (!m_sprites.found()) return 0;
+
+	// sprites with the color set to maximum shadow the pixels underneath them
+	sprite_line_buffer::mix_params const params{ uint16_t(m_spritepalbase), 0x3ff, 10, 3, 0x03f0, 0x03f0, uint16_t(m_palette_entries) };
 	bitmap_ind16 &sprites = m_sprites->bitmap();
 	for (const sparse_dirty_rect *rect = m_sprites->first_dirty_rect(cliprect); rect != nullptr; rect = rect->next())
 		for (int y = rect->min_y; y <= rect->max_y; y++)
@@ -67,26 +70,7 @@ uint32_t segas16b_state::screen_update(screen_device &screen, bitmap_ind16 &bitm
 			uint16_t *dest = &bitmap.pix(y);
 			uint16_t *src = &sprites.pix(y);
 			uint8_t *pri = &screen.priority().pix(y);
-			for (int x = rect->min_x; x <= rect->max_x; x++)
-			{
-				// only process written pixels
-				uint16_t pix = src[x];
-				if (pix != 0xffff)
-				{
-					// compare sprite priority against tilemap priority
-					int priority = (pix >> 10) & 3;
-					if ((1 << priority) > pri[x])
-					{
-						// if the color is set to maximum, shadow pixels underneath us
-						if ((pix & 0x03f0) == 0x03f0)
-							dest[x] += m_palette_entries;
-
-						// otherwise, just add in sprite palette base
-						else
-							dest[x] = m_spritepalbase | (pix & 0x3ff);
-					}
-				}
-			}
+			sprite_line_buffer::mix_row(dest, src, pri, rect->min_x, rect->max_x, params);
 		}
 
 	return 0;
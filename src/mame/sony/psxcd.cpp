@@ -1129,6 +1129,7 @@ void psxcd_device::start_read()
 	}
 	send_result(INTR_COMPLETE);
 	status |= STATUS_READING;
+	m_cdrom_handle->prefetch(sector, 75);
 
 	m_cursec=sectail=0;
 
@@ -60,6 +60,11 @@
 #include <sys/stat.h>
 #include <cstdlib>
 #include <unistd.h>
+#include <utime.h>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
 
 
 
@@ -160,6 +165,40 @@ public:
 		return std::error_condition();
 	}
 
+#if !defined(_WIN32)
+	virtual std::error_condition map(std::uint64_t offset, std::size_t length, std::shared_ptr<void const> &data) noexcept override
+	{
+		if (!length)
+			return std::errc::invalid_argument;
+
+		// mappings have to start on a page boundary
+		std::uint64_t const pagesize = std::uint64_t(sysconf(_SC_PAGESIZE));
+		std::uint64_t const base = offset - (offset % pagesize);
+		std::size_t const size = length + std::size_t(offset - base);
+
+		void *mem;
+#if defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__bsdi__) || defined(__DragonFly__) || defined(__EMSCRIPTEN__) || defined(__ANDROID__) || defined(SDLMAME_NO64BITIO)
+		mem = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, m_fd, off_t(std::make_unsigned_t<off_t>(base)));
+#else
+		mem = ::mmap64(nullptr, size, PROT_READ, MAP_SHARED, m_fd, off64_t(base));
+#endif
+		if (MAP_FAILED == mem)
+			return std::error_condition(errno, std::generic_category());
+
+		// if allocating the control block throws, the deleter has already unmapped it
+		try
+		{
+			std::shared_ptr<void const> const mapping(mem, [size] (void const *p) { ::munmap(const_cast<void *>(p), size); });
+			data = std::shared_ptr<void const>(mapping, reinterpret_cast<std::uint8_t const *>(mem) + (offset - base));
+		}
+		catch (...)
+		{
+			return std::errc::not_enough_memory;
+		}
+		return std::error_condition();
+	}
+#endif
+
 private:
 	int m_fd;
 };
@@ -355,6 +394,36 @@ std::error_condition osd_file::remove(std::string const &filename) noexcept
 }
 
 
+//============================================================
+//  osd_file::rename
+//============================================================
+
+std::error_condition osd_file::rename(std::string const &from, std::string const &to) noexcept
+{
+#if defined(_WIN32)
+	// the C library won't replace an existing file on Windows
+	::unlink(to.c_str());
+#endif
+	if (::rename(from.c_str(), to.c_str()) < 0)
+		return std::error_condition(errno, std::generic_category());
+	else
+		return std::error_condition();
+}
+
+
+//============================================================
+//  osd_file::touch
+//============================================================
+
+std::error_condition osd_file::touch(std::string const &filename) noexcept
+{
+	if (::utime(filename.c_str(), nullptr) < 0)
+		return std::error_condition(errno, std::generic_category());
+	else
+		return std::error_condition();
+}
+
+
 //============================================================
 //  osd_get_physical_drive_geometry
 //============================================================
@@ -111,6 +111,40 @@ public:
 		return std::error_condition();
 	}
 
+	virtual std::error_condition map(std::uint64_t offset, std::size_t length, std::shared_ptr<void const> &data) noexcept override
+	{
+		if (!length)
+			return std::errc::invalid_argument;
+
+		// views have to start on an allocation granularity boundary
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		std::uint64_t const base = offset - (offset % info.dwAllocationGranularity);
+		std::size_t const size = length + std::size_t(offset - base);
+
+		// the view keeps the mapping object alive, so the handle can be closed straight away
+		HANDLE const mapping = CreateFileMapping(m_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping)
+			return win_error_to_error_condition(GetLastError());
+		void *const mem = MapViewOfFile(mapping, FILE_MAP_READ, DWORD(base >> 32), DWORD(base), size);
+		DWORD const err = mem ? ERROR_SUCCESS : GetLastError();
+		CloseHandle(mapping);
+		if (!mem)
+			return win_error_to_error_condition(err);
+
+		// if allocating the control block throws, the deleter has already unmapped it
+		try
+		{
+			std::shared_ptr<void const> const view(mem, [] (void const *p) { UnmapViewOfFile(p); });
+			data = std::shared_ptr<void const>(view, reinterpret_cast<std::uint8_t const *>(mem) + (offset - base));
+		}
+		catch (...)
+		{
+			return std::errc::not_enough_memory;
+		}
+		return std::error_condition();
+	}
+
 private:
 	HANDLE m_handle;
 };
@@ -306,6 +340,58 @@ std::error_condition osd_file::remove(std::string const &filename) noexcept
 
 
 
+//============================================================
+//  osd_file::rename
+//============================================================
+
+std::error_condition osd_file::rename(std::string const &from, std::string const &to) noexcept
+{
+	osd::text::tstring fromstr, tostr;
+	try
+	{
+		fromstr = osd::text::to_tstring(from);
+		tostr = osd::text::to_tstring(to);
+	}
+	catch (...)
+	{
+		return std::errc::not_enough_memory;
+	}
+
+	std::error_condition filerr;
+	if (!MoveFileEx(fromstr.c_str(), tostr.c_str(), MOVEFILE_REPLACE_EXISTING))
+		filerr = win_error_to_error_condition(GetLastError());
+
+	return filerr;
+}
+
+
+
+//============================================================
+//  osd_file::touch
+//============================================================
+
+std::error_condition osd_file::touch(std::string const &filename) noexcept
+{
+	osd::text::tstring tempstr;
+	try { tempstr = osd::text::to_tstring(filename); }
+	catch (...) { return std::errc::not_enough_memory; }
+
+	HANDLE const h = CreateFile(tempstr.c_str(), FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (INVALID_HANDLE_VALUE == h)
+		return win_error_to_error_condition(GetLastError());
+
+	FILETIME now;
+	GetSystemTimeAsFileTime(&now);
+	std::error_condition filerr;
+	if (!SetFileTime(h, nullptr, nullptr, &now))
+		filerr = win_error_to_error_condition(GetLastError());
+	CloseHandle(h);
+
+	return filerr;
+}
+
+
+
 //============================================================
 //  osd_get_physical_drive_geometry
 //============================================================
@@ -17,11 +17,12 @@
 #include "interface/inputman.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
 
 
 //============================================================
@@ -241,47 +242,67 @@ public:
 //  event_based_device
 //============================================================
 
-#define DEFAULT_EVENT_QUEUE_SIZE 20
+// must be a power of two
+#define DEFAULT_EVENT_QUEUE_SIZE 64
 
+// Events are queued by the thread receiving them from the OS and applied
+// by poll(), so the device state only changes for items that changed.
+// The queue is a single-producer single-consumer ring, so neither side
+// ever blocks the other.
 template <class TEvent>
 class event_based_device : public device_info
 {
 private:
-	std::queue<TEvent>   m_event_queue;
+	static_assert(!(DEFAULT_EVENT_QUEUE_SIZE & (DEFAULT_EVENT_QUEUE_SIZE - 1)), "event queue size must be a power of two");
 
-protected:
-	std::mutex           m_device_lock;
+	std::array<TEvent, DEFAULT_EVENT_QUEUE_SIZE> m_events;
+	std::atomic<unsigned>   m_head;         // next slot to fill, only written by the producer
+	std::atomic<unsigned>   m_tail;         // next slot to process, only written by poll()
+	std::atomic<unsigned>   m_dropped;      // events lost because poll() fell behind
 
+protected:
 	virtual void process_event(TEvent &ev) = 0;
 
 public:
 	event_based_device(running_machine &machine, std::string &&name, std::string &&id, input_device_class deviceclass, input_module &module) :
-		device_info(machine, std::move(name), std::move(id), deviceclass, module)
+		device_info(machine, std::move(name), std::move(id), deviceclass, module),
+		m_head(0),
+		m_tail(0),
+		m_dropped(0)
 	{
 	}
 
 	void queue_events(const TEvent *events, int count)
 	{
-		std::lock_guard<std::mutex> scope_lock(m_device_lock);
+		unsigned head = m_head.load(std::memory_order_relaxed);
+		unsigned const tail = m_tail.load(std::memory_order_acquire);
 		for (int i = 0; i < count; i++)
-			m_event_queue.push(events[i]);
-
-		// If we've gone over the size, remove old events from the queue
-		while (m_event_queue.size() > DEFAULT_EVENT_QUEUE_SIZE)
-			m_event_queue.pop();
+		{
+			// if the ring is full, newer events are dropped until poll() catches up
+			if ((head - tail) >= DEFAULT_EVENT_QUEUE_SIZE)
+			{
+				m_dropped.fetch_add(count - i, std::memory_order_relaxed);
+				break;
+			}
+			m_events[head & (DEFAULT_EVENT_QUEUE_SIZE - 1)] = events[i];
+			head++;
+		}
+		m_head.store(head, std::memory_order_release);
 	}
 
 	void virtual poll() override
 	{
-		std::lock_guard<std::mutex> scope_lock(m_device_lock);
+		unsigned const head = m_head.load(std::memory_order_acquire);
+		unsigned tail = m_tail.load(std::memory_order_relaxed);
 
 		// Process each event until the queue is empty
-		while (!m_event_queue.empty())
-		{
-			TEvent &next_event = m_event_queue.front();
-			process_event(next_event);
-			m_event_queue.pop();
-		}
+		while (tail != head)
+			process_event(m_events[tail++ & (DEFAULT_EVENT_QUEUE_SIZE - 1)]);
+		m_tail.store(tail, std::memory_order_release);
+
+		unsigned const dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+		if (dropped)
+			osd_printf_verbose("Input: %s dropped %u events\n", name(), dropped);
 	}
 };
 
@@ -174,6 +174,10 @@ public:
 		if (devinfo == nullptr)
 			goto exit;
 
+		// read key changes rather than the whole keyboard if we can
+		if (devinfo->enable_buffering() != DI_OK)
+			osd_printf_verbose("DirectInput: Unable to buffer events for %s, reading full keyboard state\n", devinfo->name());
+
 		// populate it
 		for (keynum = 0; keynum < MAX_KEYS; keynum++)
 		{
@@ -354,15 +358,49 @@ HRESULT dinput_device::poll_dinput(LPVOID pState) const
 
 dinput_keyboard_device::dinput_keyboard_device(running_machine &machine, std::string &&name, std::string &&id, input_module &module)
 	: dinput_device(machine, std::move(name), std::move(id), DEVICE_CLASS_KEYBOARD, module),
+		m_buffered(false),
 		keyboard({{0}})
 {
 }
 
-// Polls the direct input immediate state
+// Asks DirectInput to queue key changes; must be called before the device is acquired
+HRESULT dinput_keyboard_device::enable_buffering()
+{
+	HRESULT const result = dinput_set_dword_property(dinput.device, DIPROP_BUFFERSIZE, 0, DIPH_DEVICE, BUFFER_SIZE);
+	m_buffered = (result == DI_OK);
+	return result;
+}
+
+// Applies the buffered key changes, or polls the direct input immediate state
 void dinput_keyboard_device::poll()
 {
 	std::lock_guard<std::mutex> scope_lock(m_device_lock);
 
+	if (m_buffered)
+	{
+		DIDEVICEOBJECTDATA events[BUFFER_SIZE];
+		DWORD count;
+		HRESULT result;
+
+		dinput.device->Poll();
+		do
+		{
+			count = BUFFER_SIZE;
+			result = dinput.device->GetDeviceData(sizeof(events[0]), events, &count, 0);
+			if (result == DI_OK)
+			{
+				for (DWORD i = 0; i < count; i++)
+					if (events[i].dwOfs < MAX_KEYS)
+						keyboard.state[events[i].dwOfs] = std::uint8_t(events[i].dwData & 0x80);
+			}
+		}
+		while ((result == DI_OK) && (count == BUFFER_SIZE));
+
+		// after an overflow, or if the device needs reacquiring, the buffer doesn't tell the whole story
+		if (result == DI_OK)
+			return;
+	}
+
 	// Poll the state
 	dinput_device::poll_dinput(&keyboard.state);
 }
@@ -197,13 +197,18 @@ protected:
 class dinput_keyboard_device : public dinput_device
 {
 private:
+	// key events DirectInput holds for us between polls
+	static constexpr DWORD BUFFER_SIZE = 64;
+
 	std::mutex m_device_lock;
+	bool       m_buffered;
 
 public:
 	keyboard_state  keyboard;
 
 	dinput_keyboard_device(running_machine &machine, std::string &&name, std::string &&id, input_module &module);
 
+	HRESULT enable_buffering();
 	void poll() override;
 	void reset() override;
 };
@@ -127,6 +127,15 @@ public:
 			return do_set_access(reinterpret_cast<std::uint8_t *>(m_memory) + start, size, access);
 	}
 
+	// ask for huge pages where the OS can back a mapping with them on demand
+	bool advise_large_pages(std::size_t start, std::size_t size)
+	{
+		if ((start % m_page_size) || (size % m_page_size) || (start > m_size) || ((m_size - start) < size))
+			return false;
+		else
+			return do_advise_large_pages(reinterpret_cast<std::uint8_t *>(m_memory) + start, size);
+	}
+
 	virtual_memory_allocation &operator=(std::nullptr_t)
 	{
 		if (m_memory)
@@ -155,12 +164,184 @@ private:
 	static void *do_alloc(std::initializer_list<std::size_t> blocks, unsigned intent, std::size_t &size, std::size_t &page_size);
 	static void do_free(void *start, std::size_t size);
 	static bool do_set_access(void *start, std::size_t size, unsigned access);
+	static bool do_advise_large_pages(void *start, std::size_t size);
 
 	void *m_memory = nullptr;
 	std::size_t m_size = 0U, m_page_size = 0U;
 };
 
 
+/*-----------------------------------------------------------------------------
+    file_mapping: copy-on-write mapping of an existing file
+
+    Notes:
+
+        - Pages are shared with every other process mapping the same
+          file until they are written to, at which point the writer gets a
+          private copy; the file itself is never modified
+        - The mapping fails unless the file is exactly the expected size
+-----------------------------------------------------------------------------*/
+
+class file_mapping
+{
+public:
+	file_mapping(file_mapping const &) = delete;
+	file_mapping &operator=(file_mapping const &) = delete;
+
+	file_mapping(std::string const &path, std::size_t size)
+	{
+		m_memory = do_map(path, size);
+		if (m_memory)
+			m_size = size;
+	}
+	~file_mapping()
+	{
+		if (m_memory)
+			do_unmap(m_memory, m_size);
+	}
+
+	explicit operator bool() const { return bool(m_memory); }
+	void *get() { return m_memory; }
+	std::size_t size() const { return m_size; }
+
+private:
+	static void *do_map(std::string const &path, std::size_t size);
+	static void do_unmap(void *start, std::size_t size);
+
+	void *m_memory = nullptr;
+	std::size_t m_size = 0U;
+};
+
+
+/*-----------------------------------------------------------------------------
+    private_mapping: page-aligned, zero-filled anonymous private memory
+
+    Notes:
+
+        - Pages are not backed by anything until they are first written,
+          so untouched memory costs nothing
+        - After fork() parent and child share every page copy-on-write
+        - The size is rounded up to a whole number of pages
+        - With large_pages set the OS is asked to use huge pages: Linux
+          aligns the mapping and enables transparent huge pages for it,
+          Windows uses explicit large pages if the process may lock memory
+          (these are committed immediately, so the first note no longer
+          holds); otherwise ordinary pages are used
+-----------------------------------------------------------------------------*/
+
+class private_mapping
+{
+public:
+	private_mapping(private_mapping const &) = delete;
+	private_mapping &operator=(private_mapping const &) = delete;
+
+	private_mapping(std::size_t size, bool large_pages = false)
+	{
+		m_memory = do_map(size, large_pages, m_size, m_page_size, m_large_pages);
+	}
+	~private_mapping()
+	{
+		if (m_memory)
+			do_unmap(m_memory, m_size);
+	}
+
+	explicit operator bool() const { return bool(m_memory); }
+	void *get() { return m_memory; }
+	std::size_t size() const { return m_size; }
+	std::size_t page_size() const { return m_page_size; }
+	bool large_pages() const { return m_large_pages; }
+
+private:
+	static void *do_map(std::size_t size, bool large_pages, std::size_t &mapped, std::size_t &page_size, bool &large);
+	static void do_unmap(void *start, std::size_t size);
+
+	void *m_memory = nullptr;
+	std::size_t m_size = 0U, m_page_size = 0U;
+	bool m_large_pages = false;
+};
+
+
+/*-----------------------------------------------------------------------------
+    shared_mapping: named read/write memory shared with other processes
+
+    Notes:
+
+        - Other processes open the memory by name (shm_open on POSIX
+          systems, OpenFileMapping on Windows); on POSIX systems a stale
+          object with the same name is replaced, on Windows creation fails
+          while the name is still in use
+        - The memory is zero-filled when created
+        - The name is removed again when the mapping is destroyed, but
+          processes that still have it mapped keep their view
+-----------------------------------------------------------------------------*/
+
+class shared_mapping
+{
+public:
+	shared_mapping(shared_mapping const &) = delete;
+	shared_mapping &operator=(shared_mapping const &) = delete;
+
+	shared_mapping(std::string const &name, std::size_t size) : m_name(name)
+	{
+		m_memory = do_map(m_name, size, m_handle);
+		if (m_memory)
+			m_size = size;
+	}
+	~shared_mapping()
+	{
+		if (m_memory)
+			do_unmap(m_memory, m_size, m_name, m_handle);
+	}
+
+	explicit operator bool() const { return bool(m_memory); }
+	void *get() { return m_memory; }
+	std::size_t size() const { return m_size; }
+	std::string const &name() const { return m_name; }
+
+private:
+	static void *do_map(std::string &name, std::size_t size, void *&handle);
+	static void do_unmap(void *start, std::size_t size, std::string const &name, void *handle);
+
+	void *m_memory = nullptr;
+	void *m_handle = nullptr;
+	std::size_t m_size = 0U;
+	std::string m_name;
+};
+
+
+/*-----------------------------------------------------------------------------
+    processor_info: a logical processor the process is allowed to run on
+
+    Notes:
+
+        - A higher performance class is faster; hybrid CPUs (performance
+          and efficiency cores, big.LITTLE) have more than one class,
+          other CPUs report class 0 for every processor
+        - Logical processors sharing a physical core (SMT siblings) have
+          the same core number
+        - Processors can't be chosen on Mac OS X, so set_thread_affinity
+          sets the quality of service class of the calling thread instead:
+          the scheduler then prefers performance cores for a thread limited
+          to the fastest class and efficiency cores for a thread limited to
+          slower classes
+-----------------------------------------------------------------------------*/
+
+struct processor_info
+{
+	unsigned id;                    // logical processor number
+	unsigned core;                  // physical core it belongs to
+	unsigned performance_class;     // relative speed, higher is faster
+};
+
+// processors the process may run on, in ascending order of id
+std::vector<processor_info> get_processors();
+
+// limit the calling thread to the given processors; an empty list allows
+// every processor the process could run on when get_processors was first
+// called
+bool set_thread_affinity(std::vector<unsigned> const &processors);
+
+
 /*-----------------------------------------------------------------------------
     dynamic_module: load functions from optional shared libraries
 
@@ -12,6 +12,7 @@
 #include "osdcore.h"
 #include "osdlib.h"
 
+#include <algorithm>
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
@@ -19,7 +20,10 @@
 #include <memory>
 
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <pthread.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/sysctl.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -279,6 +283,16 @@ private:
 	void *                   m_module = nullptr;
 };
 
+
+unsigned sysctl_unsigned(std::string const &name, unsigned fallback)
+{
+	int value;
+	size_t size = sizeof(value);
+	if (sysctlbyname(name.c_str(), &value, &size, nullptr, 0) || (value < 0))
+		return fallback;
+	return unsigned(value);
+}
+
 } // anonymous namespace
 
 
@@ -327,6 +341,138 @@ bool virtual_memory_allocation::do_set_access(void *start, std::size_t size, uns
 	return mprotect(start, size, prot) == 0;
 }
 
+bool virtual_memory_allocation::do_advise_large_pages(void *start, std::size_t size)
+{
+	// superpages can only be requested when memory is allocated
+	return false;
+}
+
+
+void *file_mapping::do_map(std::string const &path, std::size_t size)
+{
+	int const fd(::open(path.c_str(), O_RDONLY));
+	if (fd < 0)
+		return nullptr;
+
+	// the mapping remains valid after the descriptor is closed
+	struct stat st;
+	void *result(nullptr);
+	if (!fstat(fd, &st) && (std::size_t(st.st_size) == size) && size)
+	{
+		result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if (result == (void *)-1)
+			result = nullptr;
+	}
+	close(fd);
+	return result;
+}
+
+void file_mapping::do_unmap(void *start, std::size_t size)
+{
+	munmap(reinterpret_cast<char *>(start), size);
+}
+
+
+void *private_mapping::do_map(std::size_t size, bool large_pages, std::size_t &mapped, std::size_t &page_size, bool &large)
+{
+	long const p(sysconf(_SC_PAGE_SIZE));
+	if ((0 >= p) || !size)
+		return nullptr;
+	std::size_t const s(((size + p - 1) / p) * p);
+	void *const result(mmap(nullptr, s, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0));
+	if (result == (void *)-1)
+		return nullptr;
+	mapped = s;
+	page_size = p;
+	large = false;
+	return result;
+}
+
+void private_mapping::do_unmap(void *start, std::size_t size)
+{
+	munmap(reinterpret_cast<char *>(start), size);
+}
+
+void *shared_mapping::do_map(std::string &name, std::size_t size, void *&handle)
+{
+	// POSIX shared memory object names start with a slash
+	if (name.empty() || (name[0] != '/'))
+		name.insert(0, 1, '/');
+	if (!size)
+		return nullptr;
+
+	// never attach to a stale object left behind by another instance
+	shm_unlink(name.c_str());
+	int const fd(shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR));
+	if (fd < 0)
+		return nullptr;
+
+	// the mapping remains valid after the descriptor is closed
+	void *result(nullptr);
+	if (!ftruncate(fd, off_t(size)))
+	{
+		result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (result == (void *)-1)
+			result = nullptr;
+	}
+	close(fd);
+	if (!result)
+		shm_unlink(name.c_str());
+	return result;
+}
+
+void shared_mapping::do_unmap(void *start, std::size_t size, std::string const &name, void *handle)
+{
+	munmap(reinterpret_cast<char *>(start), size);
+	shm_unlink(name.c_str());
+}
+
+std::vector<processor_info> get_processors()
+{
+	// performance level 0 is the fastest; older systems have only one level
+	unsigned const levels = std::max(sysctl_unsigned("hw.nperflevels", 1), 1U);
+	std::vector<processor_info> result;
+	unsigned id = 0, core = 0;
+	for (unsigned level = 0; level < levels; level++)
+	{
+		std::string const prefix("hw.perflevel" + std::to_string(level) + ".");
+		unsigned const logical = sysctl_unsigned(prefix + "logicalcpu", (levels == 1) ? sysctl_unsigned("hw.logicalcpu", 1) : 0);
+		unsigned const physical = std::max(sysctl_unsigned(prefix + "physicalcpu", (levels == 1) ? sysctl_unsigned("hw.physicalcpu", logical) : logical), 1U);
+		unsigned const threads = std::max(logical / physical, 1U);
+		for (unsigned i = 0; i < logical; i++, id++)
+			result.emplace_back(processor_info{ id, core + (i / threads), levels - 1 - level });
+		core += physical;
+	}
+	return result;
+}
+
+bool set_thread_affinity(std::vector<unsigned> const &processors)
+{
+	// threads can't be bound to processors, but quality of service steers
+	// them towards performance or efficiency cores
+	std::vector<processor_info> const available(get_processors());
+	unsigned top = 0;
+	for (processor_info const &info : available)
+		top = std::max(top, info.performance_class);
+
+	bool fast = false, slow = false;
+	for (unsigned id : processors)
+	{
+		auto const found = std::find_if(
+				available.begin(),
+				available.end(),
+				[id] (processor_info const &info) { return info.id == id; });
+		if (found != available.end())
+			((found->performance_class == top) ? fast : slow) = true;
+	}
+
+	qos_class_t qos = QOS_CLASS_DEFAULT;
+	if (fast && !slow)
+		qos = QOS_CLASS_USER_INTERACTIVE;
+	else if (slow && !fast)
+		qos = QOS_CLASS_UTILITY;
+	return !pthread_set_qos_class_self_np(qos, 0);
+}
 
 dynamic_module::ptr dynamic_module::open(std::vector<std::string> &&names)
 {
@@ -14,14 +14,22 @@
 
 #include <SDL2/SDL.h>
 
+#include <algorithm>
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
+#include <functional>
 #include <iomanip>
 #include <memory>
+#include <thread>
 
 #include <dlfcn.h>
+#include <fcntl.h>
+#if defined(__linux__)
+#include <sched.h>
+#endif
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -196,6 +204,91 @@ private:
 	void *                   m_module = nullptr;
 };
 
+
+#if defined(__linux__)
+
+// processors the process could run on before any thread was restricted
+cpu_set_t const &process_affinity()
+{
+	static cpu_set_t const mask = [] ()
+	{
+		cpu_set_t result;
+		CPU_ZERO(&result);
+		if (sched_getaffinity(0, sizeof(result), &result))
+		{
+			for (unsigned id = 0; id < std::thread::hardware_concurrency(); id++)
+				CPU_SET(id, &result);
+		}
+		return result;
+	}();
+	return mask;
+}
+
+bool read_sysfs_number(std::string const &path, unsigned long &value)
+{
+	std::FILE *const file = std::fopen(path.c_str(), "r");
+	if (!file)
+		return false;
+	bool const result = std::fscanf(file, "%lu", &value) == 1;
+	std::fclose(file);
+	return result;
+}
+
+// reads a processor list such as "0-7,16"
+bool read_sysfs_cpulist(std::string const &path, std::vector<bool> &cpus)
+{
+	std::FILE *const file = std::fopen(path.c_str(), "r");
+	if (!file)
+		return false;
+	unsigned first, last;
+	int separator;
+	bool result = false;
+	while (std::fscanf(file, "%u", &first) == 1)
+	{
+		last = first;
+		separator = std::fgetc(file);
+		if ((separator == '-') && (std::fscanf(file, "%u", &last) == 1))
+			separator = std::fgetc(file);
+		if ((last >= first) && (last < CPU_SETSIZE))
+		{
+			if (cpus.size() <= last)
+				cpus.resize(last + 1, false);
+			std::fill(cpus.begin() + first, cpus.begin() + last + 1, true);
+			result = true;
+		}
+		if (separator != ',')
+			break;
+	}
+	std::fclose(file);
+	return result;
+}
+
+#endif // defined(__linux__)
+
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+
+// size of a transparent huge page, or zero if the kernel doesn't have them
+std::size_t huge_page_size()
+{
+	static std::size_t const size = []
+	{
+		std::size_t result(0);
+		FILE *const file(std::fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r"));
+		if (file)
+		{
+			unsigned long value;
+			if ((std::fscanf(file, "%lu", &value) == 1) && value && !(value & (value - 1)))
+				result = value;
+			std::fclose(file);
+		}
+		return result;
+	}();
+	return size;
+}
+
+#endif // defined(__linux__) && defined(MADV_HUGEPAGE)
+
 } // anonymous namespace
 
 
@@ -264,6 +357,209 @@ bool virtual_memory_allocation::do_set_access(void *start, std::size_t size, uns
 	return mprotect(reinterpret_cast<char *>(start), size, prot) == 0;
 }
 
+bool virtual_memory_allocation::do_advise_large_pages(void *start, std::size_t size)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	// shared anonymous memory only gets huge pages if the kernel's shmem policy allows it
+	return huge_page_size() && !madvise(start, size, MADV_HUGEPAGE);
+#else
+	return false;
+#endif
+}
+
+
+void *file_mapping::do_map(std::string const &path, std::size_t size)
+{
+	int const fd(::open(path.c_str(), O_RDONLY));
+	if (fd < 0)
+		return nullptr;
+
+	// the mapping remains valid after the descriptor is closed
+	struct stat st;
+	void *result(nullptr);
+	if (!fstat(fd, &st) && (std::size_t(st.st_size) == size) && size)
+	{
+		result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		if (result == (void *)-1)
+			result = nullptr;
+	}
+	close(fd);
+	return result;
+}
+
+void file_mapping::do_unmap(void *start, std::size_t size)
+{
+	munmap(reinterpret_cast<char *>(start), size);
+}
+
+
+void *private_mapping::do_map(std::size_t size, bool large_pages, std::size_t &mapped, std::size_t &page_size, bool &large)
+{
+	long const p(sysconf(_SC_PAGE_SIZE));
+	if ((0 >= p) || !size)
+		return nullptr;
+	std::size_t const s(((size + p - 1) / p) * p);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	// huge pages need huge-page-aligned addresses: map a little extra and trim it
+	std::size_t const h(large_pages ? huge_page_size() : 0);
+	if (h > std::size_t(p))
+	{
+		std::size_t const hs(((s + h - 1) / h) * h);
+		void *const reserved(mmap(nullptr, hs + h, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0));
+		if (reserved != (void *)-1)
+		{
+			char *const base(reinterpret_cast<char *>(reserved));
+			char *const aligned(reinterpret_cast<char *>((reinterpret_cast<std::uintptr_t>(base) + h - 1) & ~std::uintptr_t(h - 1)));
+			if (aligned != base)
+				munmap(base, aligned - base);
+			if ((base + hs + h) != (aligned + hs))
+				munmap(aligned + hs, (base + hs + h) - (aligned + hs));
+			mapped = hs;
+			page_size = p;
+			large = !madvise(aligned, hs, MADV_HUGEPAGE);
+			return aligned;
+		}
+	}
+#endif
+	void *const result(mmap(nullptr, s, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0));
+	if (result == (void *)-1)
+		return nullptr;
+	mapped = s;
+	page_size = p;
+	large = false;
+	return result;
+}
+
+void private_mapping::do_unmap(void *start, std::size_t size)
+{
+	munmap(reinterpret_cast<char *>(start), size);
+}
+
+void *shared_mapping::do_map(std::string &name, std::size_t size, void *&handle)
+{
+	// POSIX shared memory object names start with a slash
+	if (name.empty() || (name[0] != '/'))
+		name.insert(0, 1, '/');
+	if (!size)
+		return nullptr;
+
+	// never attach to a stale object left behind by another instance
+	shm_unlink(name.c_str());
+	int const fd(shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR));
+	if (fd < 0)
+		return nullptr;
+
+	// the mapping remains valid after the descriptor is closed
+	void *result(nullptr);
+	if (!ftruncate(fd, off_t(size)))
+	{
+		result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (result == (void *)-1)
+			result = nullptr;
+	}
+	close(fd);
+	if (!result)
+		shm_unlink(name.c_str());
+	return result;
+}
+
+void shared_mapping::do_unmap(void *start, std::size_t size, std::string const &name, void *handle)
+{
+	munmap(reinterpret_cast<char *>(start), size);
+	shm_unlink(name.c_str());
+}
+
+#if defined(__linux__)
+
+std::vector<processor_info> get_processors()
+{
+	cpu_set_t const &allowed(process_affinity());
+
+	// Intel hybrid parts list their performance cores under the core PMU;
+	// otherwise use the capacity the scheduler sees on ARM, or the
+	// highest clock, where speeds within 15% count as the same class
+	std::vector<bool> big;
+	bool const hybrid = read_sysfs_cpulist("/sys/devices/cpu_core/cpus", big);
+
+	std::vector<processor_info> result;
+	std::vector<unsigned long> speeds;
+	for (unsigned id = 0; id < CPU_SETSIZE; id++)
+	{
+		if (!CPU_ISSET(id, &allowed))
+			continue;
+
+		std::string const base("/sys/devices/system/cpu/cpu" + std::to_string(id) + "/");
+		unsigned long package = 0, core = id, speed = 0;
+		read_sysfs_number(base + "topology/physical_package_id", package);
+		read_sysfs_number(base + "topology/core_id", core);
+		if (hybrid)
+			speed = ((id < big.size()) && big[id]) ? 1 : 0;
+		else if (!read_sysfs_number(base + "cpu_capacity", speed))
+			read_sysfs_number(base + "cpufreq/cpuinfo_max_freq", speed);
+
+		result.emplace_back(processor_info{ id, unsigned((package << 16) | core), 0U });
+		speeds.emplace_back(speed);
+	}
+
+	std::vector<unsigned long> levels(speeds);
+	std::sort(levels.begin(), levels.end(), std::greater<unsigned long>());
+	levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+	std::vector<unsigned> groups(levels.size());
+	unsigned count = 0;
+	unsigned long top = levels.empty() ? 0 : levels[0];
+	for (std::size_t i = 0; i < levels.size(); i++)
+	{
+		if ((levels[i] * 100) < (top * 85))
+		{
+			top = levels[i];
+			count++;
+		}
+		groups[i] = count;
+	}
+	for (std::size_t i = 0; i < result.size(); i++)
+	{
+		auto const level = std::lower_bound(levels.begin(), levels.end(), speeds[i], std::greater<unsigned long>());
+		result[i].performance_class = count - groups[level - levels.begin()];
+	}
+	return result;
+}
+
+bool set_thread_affinity(std::vector<unsigned> const &processors)
+{
+	cpu_set_t mask;
+	if (processors.empty())
+	{
+		mask = process_affinity();
+	}
+	else
+	{
+		CPU_ZERO(&mask);
+		for (unsigned id : processors)
+		{
+			if (id < CPU_SETSIZE)
+				CPU_SET(id, &mask);
+		}
+	}
+	return !sched_setaffinity(0, sizeof(mask), &mask);
+}
+
+#else // defined(__linux__)
+
+std::vector<processor_info> get_processors()
+{
+	std::vector<processor_info> result;
+	for (unsigned id = 0; id < std::thread::hardware_concurrency(); id++)
+		result.emplace_back(processor_info{ id, id, 0U });
+	return result;
+}
+
+bool set_thread_affinity(std::vector<unsigned> const &processors)
+{
+	// there's no portable way to choose processors
+	return processors.empty();
+}
+
+#endif // defined(__linux__)
 
 dynamic_module::ptr dynamic_module::open(std::vector<std::string> &&names)
 {
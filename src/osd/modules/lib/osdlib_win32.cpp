@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <cstdio>
 #include <cstdlib>
+#include <new>
 
 #include <windows.h>
 #include <memoryapi.h>
@@ -321,6 +322,29 @@ private:
 	HMODULE                  m_module = nullptr;
 };
 
+
+// large page size, or zero if the process isn't allowed to lock memory
+std::size_t large_page_size()
+{
+	static std::size_t const size = []
+	{
+		// the privilege must be granted to the user and then enabled for the process
+		HANDLE token;
+		if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+			return std::size_t(0);
+		TOKEN_PRIVILEGES privileges;
+		privileges.PrivilegeCount = 1;
+		privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+		bool const enabled(
+				LookupPrivilegeValueW(nullptr, L"SeLockMemoryPrivilege", &privileges.Privileges[0].Luid) &&
+				AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+				(GetLastError() == ERROR_SUCCESS));
+		CloseHandle(token);
+		return enabled ? std::size_t(GetLargePageMinimum()) : std::size_t(0);
+	}();
+	return size;
+}
+
 } // anonymous namespace
 
 
@@ -364,6 +388,185 @@ bool virtual_memory_allocation::do_set_access(void *start, std::size_t size, uns
 	return VirtualProtect(start, size, p, &o) != 0;
 }
 
+bool virtual_memory_allocation::do_advise_large_pages(void *start, std::size_t size)
+{
+	// large pages must be requested up front and can't have their protection changed
+	return false;
+}
+
+
+void *file_mapping::do_map(std::string const &path, std::size_t size)
+{
+	HANDLE const file(CreateFileW(osd::text::to_wstring(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	// the view keeps the mapping object alive, and the mapping object keeps the file open
+	void *result(nullptr);
+	LARGE_INTEGER filesize;
+	if (GetFileSizeEx(file, &filesize) && (std::uint64_t(filesize.QuadPart) == size) && size)
+	{
+		HANDLE const mapping(CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr));
+		if (mapping)
+		{
+			result = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, size);
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+	return result;
+}
+
+void file_mapping::do_unmap(void *start, std::size_t size)
+{
+	UnmapViewOfFile(start);
+}
+
+
+void *private_mapping::do_map(std::size_t size, bool large_pages, std::size_t &mapped, std::size_t &page_size, bool &large)
+{
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	if (!size)
+		return nullptr;
+	// large pages are locked in memory, so fall back quietly when they're scarce
+	std::size_t const l(large_pages ? large_page_size() : 0);
+	if (l > info.dwPageSize)
+	{
+		std::size_t const ls(((size + l - 1) / l) * l);
+		void *const result(VirtualAlloc(nullptr, ls, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE));
+		if (result)
+		{
+			mapped = ls;
+			page_size = info.dwPageSize;
+			large = true;
+			return result;
+		}
+	}
+	std::size_t const s(((size + info.dwPageSize - 1) / info.dwPageSize) * info.dwPageSize);
+	void *const result(VirtualAlloc(nullptr, s, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+	if (!result)
+		return nullptr;
+	mapped = s;
+	page_size = info.dwPageSize;
+	large = false;
+	return result;
+}
+
+void private_mapping::do_unmap(void *start, std::size_t size)
+{
+	VirtualFree(start, 0, MEM_RELEASE);
+}
+
+void *shared_mapping::do_map(std::string &name, std::size_t size, void *&handle)
+{
+	if (name.empty() || !size)
+		return nullptr;
+
+	// a pagefile-backed section lives as long as a handle or view to it remains
+	HANDLE const mapping(CreateFileMappingW(
+			INVALID_HANDLE_VALUE,
+			nullptr,
+			PAGE_READWRITE,
+			DWORD(std::uint64_t(size) >> 32),
+			DWORD(size),
+			osd::text::to_wstring(name).c_str()));
+	if (!mapping)
+		return nullptr;
+	if (GetLastError() == ERROR_ALREADY_EXISTS)
+	{
+		// another process still holds an object with this name open
+		CloseHandle(mapping);
+		return nullptr;
+	}
+
+	void *const result(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+	if (!result)
+	{
+		CloseHandle(mapping);
+		return nullptr;
+	}
+	handle = mapping;
+	return result;
+}
+
+void shared_mapping::do_unmap(void *start, std::size_t size, std::string const &name, void *handle)
+{
+	UnmapViewOfFile(start);
+	CloseHandle(HANDLE(handle));
+}
+
+std::vector<processor_info> get_processors()
+{
+	DWORD_PTR process_mask, system_mask;
+	if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+		process_mask = 1;
+
+	// efficiency classes are reported per core, higher classes being faster
+	DWORD length = 0;
+	std::unique_ptr<std::uint8_t []> buffer;
+	if (!GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length) && (GetLastError() == ERROR_INSUFFICIENT_BUFFER))
+	{
+		buffer.reset(new (std::nothrow) std::uint8_t [length]);
+		if (!buffer || !GetLogicalProcessorInformationEx(RelationProcessorCore, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.get()), &length))
+			length = 0;
+	}
+	else
+	{
+		length = 0;
+	}
+
+	std::vector<processor_info> result;
+	unsigned core = 0;
+	for (DWORD offset = 0; offset < length; core++)
+	{
+		auto const &info(*reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX const *>(&buffer[offset]));
+		offset += info.Size;
+
+		// thread affinity masks can only select processors in the first group
+		for (WORD group = 0; group < info.Processor.GroupCount; group++)
+		{
+			if (info.Processor.GroupMask[group].Group)
+				continue;
+			KAFFINITY const mask(info.Processor.GroupMask[group].Mask & process_mask);
+			for (unsigned id = 0; id < (sizeof(mask) * 8); id++)
+			{
+				if ((mask >> id) & 1)
+					result.emplace_back(processor_info{ id, core, info.Processor.EfficiencyClass });
+			}
+		}
+	}
+
+	if (result.empty())
+	{
+		for (unsigned id = 0; id < (sizeof(process_mask) * 8); id++)
+		{
+			if ((process_mask >> id) & 1)
+				result.emplace_back(processor_info{ id, id, 0U });
+		}
+	}
+	std::sort(
+			result.begin(),
+			result.end(),
+			[] (processor_info const &a, processor_info const &b) { return a.id < b.id; });
+	return result;
+}
+
+bool set_thread_affinity(std::vector<unsigned> const &processors)
+{
+	DWORD_PTR process_mask, system_mask;
+	if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+		return false;
+
+	DWORD_PTR mask = 0;
+	for (unsigned id : processors)
+	{
+		if (id < (sizeof(mask) * 8))
+			mask |= DWORD_PTR(1) << id;
+	}
+	mask = processors.empty() ? process_mask : (mask & process_mask);
+	return mask && SetThreadAffinityMask(GetCurrentThread(), mask);
+}
 
 dynamic_module::ptr dynamic_module::open(std::vector<std::string> &&names)
 {
@@ -18,6 +18,7 @@
 #include "modules/midi/midi_module.h"
 #include "modules/monitor/monitor_module.h"
 #include "osdnet.h"
+#include "osdsync.h"
 #include "watchdog.h"
 
 #include "emu.h"
@@ -60,6 +61,9 @@ const options_entry osd_options::s_option_entries[] =
 
 	{ nullptr,                                nullptr,          core_options::option_type::HEADER,    "OSD PERFORMANCE OPTIONS" },
 	{ OSDOPTION_NUMPROCESSORS ";np",          OSDOPTVAL_AUTO,   core_options::option_type::STRING,    "number of processors; this overrides the number the system reports" },
+	{ OSDOPTION_THREADAFFINITY,               OSDOPTVAL_AUTO,   core_options::option_type::STRING,    "keep the emulation thread on a fast core of its own: auto (hybrid CPUs only), on or off" },
+	{ OSDOPTION_EMULATIONCPUS,                OSDOPTVAL_AUTO,   core_options::option_type::STRING,    "processors the emulation thread may run on (e.g. 2 or 2-3)" },
+	{ OSDOPTION_WORKERCPUS,                   OSDOPTVAL_AUTO,   core_options::option_type::STRING,    "processors worker, I/O and sound threads may run on (e.g. 0-1,4-7)" },
 	{ OSDOPTION_BENCH,                        "0",              core_options::option_type::INTEGER,   "benchmark for the given number of emulated seconds; implies -video none -sound none -nothrottle" },
 
 	{ nullptr,                                nullptr,          core_options::option_type::HEADER,    "OSD VIDEO OPTIONS" },
@@ -236,6 +240,7 @@ void osd_common_t::register_options()
 #ifndef NO_USE_PORTAUDIO
 	REGISTER_MODULE(m_mod_man, SOUND_PORTAUDIO);
 #endif
+	REGISTER_MODULE(m_mod_man, SOUND_PIPEWIRE);
 #ifndef NO_USE_PULSEAUDIO
 	REGISTER_MODULE(m_mod_man, SOUND_PULSEAUDIO);
 #endif
@@ -570,6 +575,42 @@ void osd_common_t::set_mastervolume(int attenuation)
 }
 
 
+//-------------------------------------------------
+//  audio_update_frequency - return how many times
+//  per second the sound module wants new samples,
+//  or 0 to leave it up to the core
+//-------------------------------------------------
+
+int osd_common_t::audio_update_frequency()
+{
+	return m_sound ? m_sound->update_frequency() : 0;
+}
+
+
+//-------------------------------------------------
+//  audio_latency_samples - return the number of
+//  samples queued ahead of the output, or -1 if
+//  the sound module can't tell
+//-------------------------------------------------
+
+int osd_common_t::audio_latency_samples()
+{
+	return m_sound ? m_sound->latency_samples() : -1;
+}
+
+
+//-------------------------------------------------
+//  audio_underflows - return the number of times
+//  the sound output ran dry, or -1 if the sound
+//  module doesn't count them
+//-------------------------------------------------
+
+int osd_common_t::audio_underflows()
+{
+	return m_sound ? m_sound->underflows() : -1;
+}
+
+
 //-------------------------------------------------
 //  customize_input_type_list - provide OSD
 //  additions/modifications to the input list
@@ -657,6 +698,9 @@ static void output_notifier_callback(const char *outname, int32_t value, void *p
 
 void osd_common_t::init_subsystems()
 {
+	// threads started from here on are placed by their own role
+	osd::thread_affinity_configure(options().thread_affinity(), options().emulation_cpus(), options().worker_cpus());
+
 	// monitors have to be initialized before video init
 	m_monitor_module = select_module_options<monitor_module *>(options(), OSD_MONITOR_PROVIDER);
 	assert(m_monitor_module != nullptr);
@@ -697,6 +741,9 @@ void osd_common_t::init_subsystems()
 	// we need pause callbacks
 	machine().add_notifier(MACHINE_NOTIFY_PAUSE, machine_notify_delegate(&osd_common_t::input_pause, this));
 	machine().add_notifier(MACHINE_NOTIFY_RESUME, machine_notify_delegate(&osd_common_t::input_resume, this));
+
+	// last, so threads the subsystems started don't inherit it
+	osd::thread_affinity_apply(osd::thread_role::EMULATION);
 }
 
 bool osd_common_t::video_init()
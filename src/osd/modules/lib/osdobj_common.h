@@ -37,6 +37,9 @@
 #define OSDOPTION_WATCHDOG              "watchdog"
 
 #define OSDOPTION_NUMPROCESSORS         "numprocessors"
+#define OSDOPTION_THREADAFFINITY        "threadaffinity"
+#define OSDOPTION_EMULATIONCPUS         "emulationcpus"
+#define OSDOPTION_WORKERCPUS            "workercpus"
 #define OSDOPTION_BENCH                 "bench"
 
 #define OSDOPTION_VIDEO                 "video"
@@ -108,6 +111,9 @@ public:
 
 	// performance options
 	const char *numprocessors() const { return value(OSDOPTION_NUMPROCESSORS); }
+	const char *thread_affinity() const { return value(OSDOPTION_THREADAFFINITY); }
+	const char *emulation_cpus() const { return value(OSDOPTION_EMULATIONCPUS); }
+	const char *worker_cpus() const { return value(OSDOPTION_WORKERCPUS); }
 	int bench() const { return int_value(OSDOPTION_BENCH); }
 
 	// video options
@@ -205,6 +211,9 @@ public:
 	virtual void update_audio_stream(const int16_t *buffer, int samples_this_frame) override;
 	virtual void set_mastervolume(int attenuation) override;
 	virtual bool no_sound() override;
+	virtual int audio_update_frequency() override;
+	virtual int audio_latency_samples() override;
+	virtual int audio_underflows() override;
 
 	// input overridables
 	virtual void customize_input_type_list(std::vector<input_type_entry> &typelist) override;
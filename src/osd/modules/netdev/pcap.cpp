@@ -16,8 +16,6 @@
 #define LIB_NAME    "wpcap.dll"
 
 #elif defined(SDLMAME_MACOSX)
-#include <pthread.h>
-#include <libkern/OSAtomic.h>
 #define LIB_NAME    "libpcap.dylib"
 
 #else
@@ -26,6 +24,8 @@
 
 #include <pcap.h>
 
+#include <mutex>
+
 // Typedefs for dynamically loaded functions
 typedef int (*pcap_findalldevs_fn)(pcap_if_t **, char *);
 typedef pcap_t *(*pcap_open_live_fn)(const char *, int, int, int, char *);
@@ -93,19 +93,6 @@ public:
 // FIXME: bridge between pcap_module and netdev_pcap
 static pcap_module *module = nullptr;
 
-#ifdef SDLMAME_MACOSX
-struct netdev_pcap_context {
-	uint8_t *pkt;
-	int len;
-	pcap_t *p;
-
-	uint8_t packets[32][1600];
-	int packetlens[32];
-	int head;
-	int tail;
-};
-#endif
-
 class netdev_pcap : public osd_netdev
 {
 public:
@@ -115,41 +102,16 @@ public:
 	virtual int send(uint8_t *buf, int len) override;
 	virtual void set_mac(const char *mac) override;
 protected:
+#if defined(SDLMAME_WIN32) || defined(OSD_WINDOWS)
 	virtual int recv_dev(uint8_t **buf) override;
+#else
+	virtual int recv_wait(uint8_t *buf, int len) override;
+#endif
 private:
 	pcap_t *m_p;
-#ifdef SDLMAME_MACOSX
-	struct netdev_pcap_context m_ctx;
-	pthread_t m_thread;
-#endif
+	std::mutex m_lock; // the filter can be changed while the receive thread is reading
 };
 
-#ifdef SDLMAME_MACOSX
-static void netdev_pcap_handler(u_char *user, const struct pcap_pkthdr *h, const u_char *bytes) {
-	struct netdev_pcap_context *ctx = (struct netdev_pcap_context*)user;
-
-	if(!ctx->p) return;
-
-	if(OSAtomicCompareAndSwapInt((ctx->head+1) & 0x1F, ctx->tail, &ctx->tail)) {
-		printf("buffer full, dropping packet\n");
-		return;
-	}
-	memcpy(ctx->packets[ctx->head], bytes, h->len);
-	ctx->packetlens[ctx->head] = h->len;
-	OSAtomicCompareAndSwapInt(ctx->head, (ctx->head+1) & 0x1F, &ctx->head);
-}
-
-static void *netdev_pcap_blocker(void *arg) {
-	struct netdev_pcap_context *ctx = (struct netdev_pcap_context*)arg;
-
-	while(ctx && ctx->p) {
-		(*module->pcap_dispatch_dl)(ctx->p, 1, netdev_pcap_handler, (u_char*)ctx);
-	}
-
-	return 0;
-}
-#endif
-
 netdev_pcap::netdev_pcap(const char *name, class device_network_interface *ifdev, int rate)
 	: osd_netdev(ifdev, rate)
 {
@@ -173,11 +135,9 @@ netdev_pcap::netdev_pcap(const char *name, class device_network_interface *ifdev
 	}
 	netdev_pcap::set_mac(get_mac());
 
-#ifdef SDLMAME_MACOSX
-	m_ctx.head = 0;
-	m_ctx.tail = 0;
-	m_ctx.p = m_p;
-	pthread_create(&m_thread, nullptr, netdev_pcap_blocker, &m_ctx);
+#if !defined(SDLMAME_WIN32) && !defined(OSD_WINDOWS)
+	// the capture times out every millisecond, so it can be read on a thread of its own
+	start_receive_thread();
 #endif
 }
 
@@ -186,6 +146,7 @@ void netdev_pcap::set_mac(const char *mac)
 	char filter[256];
 	struct bpf_program fp;
 	if(!m_p) return;
+	std::lock_guard<std::mutex> lock(m_lock);
 #ifdef SDLMAME_MACOSX
 	sprintf(filter, "not ether src %.2X:%.2X:%.2X:%.2X:%.2X:%.2X and (ether dst %.2X:%.2X:%.2X:%.2X:%.2X:%.2X or ether multicast or ether broadcast or ether dst 09:00:07:ff:ff:ff)", (unsigned char)mac[0], (unsigned char)mac[1], (unsigned char)mac[2],(unsigned char)mac[3], (unsigned char)mac[4], (unsigned char)mac[5], (unsigned char)mac[0], (unsigned char)mac[1], (unsigned char)mac[2],(unsigned char)mac[3], (unsigned char)mac[4], (unsigned char)mac[5]);
 #else
@@ -207,44 +168,39 @@ int netdev_pcap::send(uint8_t *buf, int len)
 		return 0;
 	}
 	ret = (*module->pcap_sendpacket_dl)(m_p, buf, len);
-	printf("sent packet length %d, returned %d\n", len, ret);
-	return ret ? len : 0;
-	//return (!pcap_sendpacket_dl(m_p, buf, len))?len:0;
+	return ret ? 0 : len;
 }
 
+#if defined(SDLMAME_WIN32) || defined(OSD_WINDOWS)
 int netdev_pcap::recv_dev(uint8_t **buf)
 {
-#ifdef SDLMAME_MACOSX
-	uint8_t pktbuf[2048];
-	int ret;
-
-	// no device open?
+	struct pcap_pkthdr *header;
 	if(!m_p) return 0;
+	return ((*module->pcap_next_ex_dl)(m_p, &header, (const u_char **)buf) == 1)?header->len:0;
+}
+#else
+int netdev_pcap::recv_wait(uint8_t *buf, int len)
+{
+	struct pcap_pkthdr *header;
+	const u_char *data;
 
-	// Empty
-	if(OSAtomicCompareAndSwapInt(m_ctx.head, m_ctx.tail, &m_ctx.tail)) {
+	std::lock_guard<std::mutex> lock(m_lock);
+	int const ret = (*module->pcap_next_ex_dl)(m_p, &header, &data);
+	if (ret < 0)
+		return -1;
+	else if (ret == 0)
 		return 0;
-	}
 
-	memcpy(pktbuf, m_ctx.packets[m_ctx.tail], m_ctx.packetlens[m_ctx.tail]);
-	ret = m_ctx.packetlens[m_ctx.tail];
-	OSAtomicCompareAndSwapInt(m_ctx.tail, (m_ctx.tail+1) & 0x1F, &m_ctx.tail);
-	*buf = pktbuf;
-	return ret;
-#else
-	struct pcap_pkthdr *header;
-	if(!m_p) return 0;
-	return ((*module->pcap_next_ex_dl)(m_p, &header, (const u_char **)buf) == 1)?header->len:0;
-#endif
+	// the capture buffer is only valid until the next read, so copy it into the ring
+	int const length = std::min<int>(header->caplen, len);
+	memcpy(buf, data, length);
+	return length;
 }
+#endif
 
 netdev_pcap::~netdev_pcap()
 {
-#ifdef SDLMAME_MACOSX
-	m_ctx.p = nullptr;
-	pthread_cancel(m_thread);
-	pthread_join(m_thread, nullptr);
-#endif
+	stop_receive_thread();
 	if(m_p) (*module->pcap_close_dl)(m_p);
 	m_p = nullptr;
 }
@@ -8,6 +8,7 @@
 #else
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <net/if.h>
 #include <cerrno>
@@ -61,18 +62,22 @@ public:
 	int send(uint8_t *buf, int len) override;
 	void set_mac(const char *mac) override;
 protected:
+#if defined(_WIN32)
 	int recv_dev(uint8_t **buf) override;
+#else
+	int recv_wait(uint8_t *buf, int len) override;
+#endif
 private:
 #if defined(_WIN32)
 	HANDLE m_handle = INVALID_HANDLE_VALUE;
 	OVERLAPPED m_overlapped;
 	bool m_receive_pending;
+	uint8_t m_buf[2048];
 #else
 	int m_fd = -1;
 	char m_ifname[10];
 #endif
 	char m_mac[6];
-	uint8_t m_buf[2048];
 };
 
 netdev_tap::netdev_tap(const char *name, class device_network_interface *ifdev, int rate)
@@ -99,6 +104,7 @@ netdev_tap::netdev_tap(const char *name, class device_network_interface *ifdev,
 	osd_printf_verbose("netdev_tap: network up!\n");
 	strncpy(m_ifname, ifr.ifr_name, 10);
 	fcntl(m_fd, F_SETFL, O_NONBLOCK);
+	start_receive_thread();
 #elif defined(_WIN32)
 	std::wstring device_path(L"" USERMODEDEVICEDIR);
 	device_path.append(wstring_from_utf8(name));
@@ -131,7 +137,9 @@ netdev_tap::~netdev_tap()
 		CloseHandle(m_handle);
 	}
 #else
-	close(m_fd);
+	stop_receive_thread();
+	if (m_fd != -1)
+		close(m_fd);
 #endif
 }
 
@@ -319,21 +327,23 @@ int netdev_tap::send(uint8_t *buf, int len)
 	return (len == -1)?0:len;
 }
 
-int netdev_tap::recv_dev(uint8_t **buf)
+int netdev_tap::recv_wait(uint8_t *buf, int len)
 {
-	int len;
-	if(m_fd == -1) return 0;
-	// exit if we didn't receive anything, got an error, got a broadcast or multicast packet,
-	// are in promiscuous mode or got a packet with our mac.
-	do {
-		len = read(m_fd, m_buf, sizeof(m_buf));
-	} while((len > 0) && memcmp(get_mac(), m_buf, 6) && !get_promisc() && !(m_buf[0] & 1));
+	// wake up regularly so the thread can be stopped
+	pollfd pfd = { m_fd, POLLIN, 0 };
+	if (poll(&pfd, 1, 100) <= 0)
+		return 0;
+
+	// leave room for padding and the frame check sequence
+	int const received = read(m_fd, buf, len - 4);
+	if (received <= 0)
+		return 0;
 
-	if (len > 0)
-		len = finalise_frame(m_buf, len);
+	// only keep broadcast or multicast packets and packets with our mac unless promiscuous
+	if (memcmp(get_mac(), buf, 6) && !get_promisc() && !(buf[0] & 1))
+		return 0;
 
-	*buf = m_buf;
-	return (len == -1)?0:len;
+	return finalise_frame(buf, received);
 }
 #endif
 
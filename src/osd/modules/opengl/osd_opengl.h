@@ -1631,7 +1631,7 @@
 	OSD_GL_UNUSED(void,glColor4usv,(const GLushort *v))
 	OSD_GL_UNUSED(void,glColorMask,(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha))
 	OSD_GL_UNUSED(void,glColorMaterial,(GLenum face, GLenum mode))
-	OSD_GL_UNUSED(void,glColorPointer,(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer))
+	OSD_GL(void,glColorPointer,(GLint size, GLenum type, GLsizei stride, const GLvoid *pointer))
 	OSD_GL_UNUSED(void,glCopyPixels,(GLint x, GLint y, GLsizei width, GLsizei height, GLenum type))
 	OSD_GL_UNUSED(void,glCopyTexImage1D,(GLenum target, GLint level, GLenum internalFormat, GLint x, GLint y, GLsizei width, GLint border))
 	OSD_GL_UNUSED(void,glCopyTexImage2D,(GLenum target, GLint level, GLenum internalFormat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border))
@@ -77,12 +77,16 @@ private:
 		int id = atoi(msg_name);
 		int value = atoi(msg_value);
 
+		// this runs on the network thread, so hand requests to the emulation
+		// thread; posted callbacks don't run while paused, so resuming can't
+		// go through the scheduler
+		running_machine *const m = m_machine;
 		switch(id)
 		{
 		case IM_MAME_PAUSE:
-			if (value == 1 && !machine().paused())
+			if (value == 1)
 			{
-				machine().pause();
+				machine().scheduler().post(timer_expired_delegate([m] (s32) { if (!m->paused()) m->pause(); }, "output_network_pause"));
 			}
 			else if (value == 0 && machine().paused())
 			{
@@ -92,11 +96,11 @@ private:
 		case IM_MAME_SAVESTATE:
 			if (value == 0)
 			{
-				machine().schedule_load("auto");
+				machine().scheduler().post(timer_expired_delegate([m] (s32) { m->schedule_load("auto"); }, "output_network_load"));
 			}
 			else if (value == 1)
 			{
-				machine().schedule_save("auto");
+				machine().scheduler().post(timer_expired_delegate([m] (s32) { m->schedule_save("auto"); }, "output_network_save"));
 			}
 			break;
 		}
@@ -15,6 +15,8 @@
 
 #include <bx/timer.h>
 
+#include <set>
+
 #include "slider.h"
 #include "parameter.h"
 #include "entryuniform.h"
@@ -107,10 +109,13 @@ void bgfx_chain::process(chain_manager::screen_prim &prim, int view, int screen,
 		screen_offset_y = -screen_container.yoffset();
 	}
 
+	update_live_entries();
+
 	int current_view = view;
-	for (bgfx_chain_entry* entry : m_entries)
+	for (size_t i = 0; i < m_entries.size(); i++)
 	{
-		if (!entry->skip())
+		bgfx_chain_entry* entry = m_entries[i];
+		if (m_live_entries[i])
 		{
 			entry->submit(current_view, prim, textures, screen_count, screen_width, screen_height, screen_scale_x, screen_scale_y, screen_offset_x, screen_offset_y, rotation_type, swap_xy, blend, screen);
 			current_view++;
@@ -133,10 +138,12 @@ void bgfx_chain::process(chain_manager::screen_prim &prim, int view, int screen,
 
 uint32_t bgfx_chain::applicable_passes()
 {
+	update_live_entries();
+
 	int applicable_passes = 0;
-	for (bgfx_chain_entry* entry : m_entries)
+	for (bool live : m_live_entries)
 	{
-		if (!entry->skip())
+		if (live)
 		{
 			applicable_passes++;
 		}
@@ -145,6 +152,47 @@ uint32_t bgfx_chain::applicable_passes()
 	return applicable_passes;
 }
 
+void bgfx_chain::update_live_entries()
+{
+	// Walk the passes backwards and drop any whose output nothing reads, e.g. when a slider
+	// points a later pass at a different input. Outputs outside the chain and double-buffered
+	// targets always count as used. The walk is repeated until nothing changes, so a pass
+	// whose output is read by an earlier pass on the next frame is kept as well.
+	m_live_entries.assign(m_entries.size(), false);
+	std::set<std::string> needed;
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (size_t i = m_entries.size(); i-- > 0; )
+		{
+			bgfx_chain_entry* entry = m_entries[i];
+			if (m_live_entries[i] || entry->skip())
+			{
+				continue;
+			}
+
+			const std::string& output = entry->output();
+			bool live = m_target_map.find(output) == m_target_map.end() || needed.find(output) != needed.end();
+			if (!live)
+			{
+				bgfx_target* target = m_targets.target(m_screen_index, output);
+				live = target == nullptr || target->double_buffered();
+			}
+
+			if (live)
+			{
+				m_live_entries[i] = true;
+				changed = true;
+				for (bgfx_input_pair* input : entry->inputs())
+				{
+					needed.insert(input->texture());
+				}
+			}
+		}
+	}
+}
+
 void bgfx_chain::insert_effect(uint32_t index, bgfx_effect *effect, std::string name, std::string source, chain_manager &chains)
 {
 	auto *clear = new clear_state(BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH | BGFX_CLEAR_STENCIL, 0, 1.0f, 0);
@@ -47,6 +47,8 @@ public:
 	void insert_effect(uint32_t index, bgfx_effect *effect, std::string name, std::string source, chain_manager &chains);
 
 private:
+	void update_live_entries();
+
 	std::string                         m_name;
 	std::string                         m_author;
 	bool                                m_transform;
@@ -54,6 +56,7 @@ private:
 	std::vector<bgfx_slider*>           m_sliders;
 	std::vector<bgfx_parameter*>        m_params;
 	std::vector<bgfx_chain_entry*>      m_entries;
+	std::vector<bool>                   m_live_entries;
 	std::vector<bgfx_target*>           m_target_list;
 	std::vector<std::string>            m_target_names;
 	std::map<std::string, bgfx_target*> m_target_map;
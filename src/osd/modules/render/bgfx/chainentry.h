@@ -42,6 +42,7 @@ public:
 	// Getters
 	std::string name() const { return m_name; }
 	std::vector<bgfx_input_pair*>& inputs() { return m_inputs; }
+	const std::string& output() const { return m_output; }
 	bool skip();
 
 private:
@@ -476,12 +476,40 @@ uint32_t chain_manager::update_screen_textures(uint32_t view, render_primitive *
 			}
 		}
 
+		// skip the upload if the core reports the same contents as last frame
+		while (screen >= m_screen_texture_ids.size())
+		{
+			m_screen_texture_ids.push_back(~0ULL);
+			m_screen_texture_seqids.push_back(0);
+		}
+		const render_texinfo &texinfo = prim.m_prim->texture;
+		const bool same_texture = texture != nullptr && m_screen_texture_ids[screen] == texinfo.unique_id;
+		const bool unchanged = same_texture && m_screen_texture_seqids[screen] == texinfo.seqid;
+
+		// if only part of the texture we already have changed, just upload the rows covering it
+		int first_row = 0;
+		int num_rows = tex_height;
+		if (!unchanged && same_texture && texinfo.damage_seqid && m_screen_texture_seqids[screen] == texinfo.damage_seqid)
+		{
+			first_row = std::max(texinfo.damage.top(), 0);
+			num_rows = std::min(texinfo.damage.bottom() + 1, int(tex_height)) - first_row;
+		}
+		m_screen_texture_ids[screen] = texinfo.unique_id;
+		m_screen_texture_seqids[screen] = texinfo.seqid;
+
 		bgfx::TextureFormat::Enum dst_format = bgfx::TextureFormat::BGRA8;
 		uint16_t pitch = prim.m_rowpixels;
 		int width_div_factor = 1;
 		int width_mul_factor = 1;
-		const bgfx::Memory* mem = bgfx_util::mame_texture_data_to_bgfx_texture_data(dst_format, prim.m_flags & PRIMFLAG_TEXFORMAT_MASK,
-			prim.m_rowpixels, tex_height, prim.m_prim->texture.palette, prim.m_prim->texture.base, pitch, width_div_factor, width_mul_factor);
+		const bgfx::Memory* mem = nullptr;
+		if (!unchanged && num_rows > 0)
+		{
+			const uint32_t texformat = prim.m_flags & PRIMFLAG_TEXFORMAT_MASK;
+			const int bytes_per_pixel = (texformat == PRIMFLAG_TEXFORMAT(TEXFORMAT_PALETTE16) || texformat == PRIMFLAG_TEXFORMAT(TEXFORMAT_YUY16)) ? 2 : 4;
+			uint8_t *const base = reinterpret_cast<uint8_t *>(texinfo.base) + first_row * prim.m_rowpixels * bytes_per_pixel;
+			mem = bgfx_util::mame_texture_data_to_bgfx_texture_data(dst_format, texformat,
+				prim.m_rowpixels, num_rows, texinfo.palette, base, pitch, width_div_factor, width_mul_factor);
+		}
 
 		if (texture == nullptr)
 		{
@@ -519,7 +547,8 @@ uint32_t chain_manager::update_screen_textures(uint32_t view, render_primitive *
 		}
 		else
 		{
-			texture->update(mem, pitch);
+			if (mem)
+				texture->update(mem, pitch, first_row, num_rows);
 
 			if (prim.m_prim->texture.palette)
 			{
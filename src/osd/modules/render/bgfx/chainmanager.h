@@ -133,6 +133,8 @@ private:
 	std::vector<int32_t>        m_current_chain;
 	std::vector<bgfx_texture*>  m_screen_textures;
 	std::vector<bgfx_texture*>  m_screen_palettes;
+	std::vector<uint64_t>       m_screen_texture_ids;
+	std::vector<uint32_t>       m_screen_texture_seqids;
 	std::vector<bgfx_effect*>   m_converters;
 	bgfx_effect *               m_adjuster;
 	std::vector<screen_prim>    m_screen_prims;
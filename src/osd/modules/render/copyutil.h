@@ -30,11 +30,17 @@ public:
 
 	static inline void copyline_palette16_to_bgra(uint32_t *dst, const uint16_t *src, int width, const rgb_t *palette)
 	{
-		for (int x = 0; x < width; x++)
+		// rgb_t is already laid out as 0xAARRGGBB, so only the alpha needs forcing
+		int x = 0;
+		for ( ; x + 4 <= width; x += 4, src += 4, dst += 4)
 		{
-			rgb_t srcpixel = palette[*src++];
-			*dst++ = 0xff000000 | (srcpixel.r() << 16) | (srcpixel.g() << 8) | srcpixel.b();
+			dst[0] = uint32_t(palette[src[0]]) | 0xff000000;
+			dst[1] = uint32_t(palette[src[1]]) | 0xff000000;
+			dst[2] = uint32_t(palette[src[2]]) | 0xff000000;
+			dst[3] = uint32_t(palette[src[3]]) | 0xff000000;
 		}
+		for ( ; x < width; x++)
+			*dst++ = uint32_t(palette[*src++]) | 0xff000000;
 	}
 
 	static inline void copyline_rgb32(uint32_t *dst, const uint32_t *src, int width, const rgb_t *palette)
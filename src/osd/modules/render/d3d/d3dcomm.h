@@ -116,7 +116,7 @@ public:
 
 	uint32_t                get_flags() const { return m_flags; }
 
-	void                    set_data(const render_texinfo *texsource, uint32_t flags);
+	void                    set_data(const render_texinfo *texsource, uint32_t flags, bool damage_only = false);
 
 	uint32_t                get_hash() const { return m_hash; }
 
@@ -606,7 +606,9 @@ void d3d_texture_manager::update_textures()
 				// if there is one, but with a different seqid, copy the data
 				if (texture->get_texinfo().seqid != prim.texture.seqid)
 				{
-					texture->set_data(&prim.texture, prim.flags);
+					// the core may say only part of it changed since the contents we have
+					const bool damage_only = prim.texture.damage_seqid && (texture->get_texinfo().seqid == prim.texture.damage_seqid);
+					texture->set_data(&prim.texture, prim.flags, damage_only);
 					texture->get_texinfo().seqid = prim.texture.seqid;
 				}
 			}
@@ -2343,16 +2345,31 @@ inline void texture_info::copyline_yuy16_to_argb(uint32_t *dst, const uint16_t *
 //  texture_set_data
 //============================================================
 
-void texture_info::set_data(const render_texinfo *texsource, uint32_t flags)
+void texture_info::set_data(const render_texinfo *texsource, uint32_t flags, bool damage_only)
 {
 	D3DLOCKED_RECT rect;
 	HRESULT result;
 
+	// plain textures keep their contents, so only the damaged rows (and the border duplicating them) need updating
+	int miny = 0 - m_yborderpix;
+	int maxy = texsource->height + m_yborderpix;
+	const bool partial = damage_only && (m_type == TEXTURE_TYPE_PLAIN);
+	if (partial)
+	{
+		if (texsource->damage.top() > 0)
+			miny = texsource->damage.top();
+		if (texsource->damage.bottom() + 1 < int(texsource->height))
+			maxy = texsource->damage.bottom() + 1;
+		if (miny >= maxy)
+			return;
+	}
+	RECT const lockrect = { 0, miny + m_yborderpix, LONG(m_rawdims.c.x), maxy + m_yborderpix };
+
 	// lock the texture
 	switch (m_type)
 	{
 		default:
-		case TEXTURE_TYPE_PLAIN:    result = m_d3dtex->LockRect(0, &rect, nullptr, 0);                 break;
+		case TEXTURE_TYPE_PLAIN:    result = m_d3dtex->LockRect(0, &rect, partial ? &lockrect : nullptr, 0); break;
 		case TEXTURE_TYPE_DYNAMIC:  result = m_d3dtex->LockRect(0, &rect, nullptr, D3DLOCK_DISCARD);   break;
 		case TEXTURE_TYPE_SURFACE:  result = m_d3dsurface->LockRect(&rect, nullptr, D3DLOCK_DISCARD);  break;
 	}
@@ -2371,14 +2388,11 @@ void texture_info::set_data(const render_texinfo *texsource, uint32_t flags)
 	else
 #endif
 	{
-		int miny = 0 - m_yborderpix;
-		int maxy = texsource->height + m_yborderpix;
-
 		for (int dsty = miny; dsty < maxy; dsty++)
 		{
 			int srcy = (dsty < 0) ? 0 : (dsty >= texsource->height) ? texsource->height - 1 : dsty;
 
-			void *dst = (BYTE *)rect.pBits + (dsty + m_yborderpix) * rect.Pitch;
+			void *dst = (BYTE *)rect.pBits + (dsty - miny) * rect.Pitch;
 
 			switch (tex_format)
 			{
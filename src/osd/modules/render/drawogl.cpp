@@ -277,7 +277,7 @@ static int glsl_shader_feature = GLSL_SHADER_FEAT_PLAIN;
 //  Textures
 //============================================================
 
-static void texture_set_data(ogl_texture_info *texture, const render_texinfo *texsource, uint32_t flags);
+static void texture_set_data(ogl_texture_info *texture, const render_texinfo *texsource, uint32_t flags, bool damage_only = false);
 
 //============================================================
 //  Static Variables
@@ -1212,6 +1212,8 @@ int renderer_ogl::draw(const int update)
 			 * since entering and leaving one is most expensive..
 			 */
 			case render_primitive::LINE:
+				flush_quad_batch();
+
 				#if !USE_WIN32_STYLE_LINES
 				// check if it's really a point
 				if (((prim.bounds.x1 - prim.bounds.x0) == 0) && ((prim.bounds.y1 - prim.bounds.y0) == 0))
@@ -1337,6 +1339,14 @@ int renderer_ogl::draw(const int update)
 					pendingPrimitive=GL_NO_PRIMITIVE;
 				}
 
+				// UI boxes and layout rectangles come in runs, so collect them rather than drawing each one
+				if (prim.texture.base == nullptr)
+				{
+					batch_quad(prim, hofs, vofs);
+					break;
+				}
+				flush_quad_batch();
+
 				glColor4f(prim.color.r, prim.color.g, prim.color.b, prim.color.a);
 
 				set_blendmode(PRIMFLAG_GET_BLENDMODE(prim.flags));
@@ -1401,6 +1411,8 @@ int renderer_ogl::draw(const int update)
 		}
 	}
 
+	flush_quad_batch();
+
 	if(pendingPrimitive!=GL_NO_PRIMITIVE)
 	{
 		glEnd();
@@ -1415,6 +1427,56 @@ int renderer_ogl::draw(const int update)
 	return 0;
 }
 
+//============================================================
+//  batch_quad - queue an untextured quad
+//============================================================
+
+void renderer_ogl::batch_quad(const render_primitive &prim, float hofs, float vofs)
+{
+	const int blendmode = PRIMFLAG_GET_BLENDMODE(prim.flags);
+	if (!m_batch_vertices.empty() && blendmode != m_batch_blendmode)
+		flush_quad_batch();
+	m_batch_blendmode = blendmode;
+
+	const GLfloat vertices[8] = {
+			prim.bounds.x0 + hofs, prim.bounds.y0 + vofs,
+			prim.bounds.x1 + hofs, prim.bounds.y0 + vofs,
+			prim.bounds.x1 + hofs, prim.bounds.y1 + vofs,
+			prim.bounds.x0 + hofs, prim.bounds.y1 + vofs };
+	m_batch_vertices.insert(m_batch_vertices.end(), std::begin(vertices), std::end(vertices));
+	for (int i = 0; i < 4; i++)
+	{
+		m_batch_colors.push_back(prim.color.r);
+		m_batch_colors.push_back(prim.color.g);
+		m_batch_colors.push_back(prim.color.b);
+		m_batch_colors.push_back(prim.color.a);
+	}
+}
+
+
+//============================================================
+//  flush_quad_batch - draw the queued quads
+//============================================================
+
+void renderer_ogl::flush_quad_batch()
+{
+	if (m_batch_vertices.empty())
+		return;
+
+	set_blendmode(m_batch_blendmode);
+
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 0, &m_batch_vertices[0]);
+	glColorPointer(4, GL_FLOAT, 0, &m_batch_colors[0]);
+	glDrawArrays(GL_QUADS, 0, m_batch_vertices.size() / 2);
+	glDisableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 0, m_texVerticex);
+
+	m_batch_vertices.clear();
+	m_batch_colors.clear();
+}
+
+
 //============================================================
 //  texture handling
 //============================================================
@@ -2327,8 +2389,20 @@ static inline void copyline_yuy16_to_argb(uint32_t *dst, const uint16_t *src, in
 //  texture_set_data
 //============================================================
 
-static void texture_set_data(ogl_texture_info *texture, const render_texinfo *texsource, uint32_t flags)
+static void texture_set_data(ogl_texture_info *texture, const render_texinfo *texsource, uint32_t flags, bool damage_only)
 {
+	// plain textures keep their contents, so only the damaged rows need converting and uploading
+	int miny = 0;
+	int maxy = texsource->height;
+	const bool partial = damage_only && (texture->type == TEXTURE_TYPE_PLAIN);
+	if (partial)
+	{
+		miny = std::max(texsource->damage.top(), 0);
+		maxy = std::min(texsource->damage.bottom() + 1, int(texsource->height));
+		if (miny >= maxy)
+			return;
+	}
+
 	if ( texture->type == TEXTURE_TYPE_DYNAMIC )
 	{
 		assert(texture->pbo);
@@ -2346,7 +2420,7 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 	}
 
 	// always fill non-wrapping textures with an extra pixel on the top
-	if (texture->borderpix)
+	if (texture->borderpix && !partial)
 	{
 		memset(texture->data, 0,
 				(texsource->width * texture->xprescale + 2) * sizeof(uint32_t));
@@ -2358,7 +2432,7 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 		int y, y2;
 		uint8_t *dst;
 
-		for (y = 0; y < texsource->height; y++)
+		for (y = miny; y < maxy; y++)
 		{
 			for (y2 = 0; y2 < texture->yprescale; y2++)
 			{
@@ -2391,7 +2465,7 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 	}
 
 	// always fill non-wrapping textures with an extra pixel on the bottom
-	if (texture->borderpix)
+	if (texture->borderpix && !partial)
 	{
 		memset((uint8_t *)texture->data +
 				(texsource->height + 1) * texture->rawwidth * sizeof(uint32_t),
@@ -2431,14 +2505,21 @@ static void texture_set_data(ogl_texture_info *texture, const render_texinfo *te
 		glBindTexture(texture->texTarget, texture->texture);
 
 		// give the card a hint
-		if (texture->nocopy)
-			glPixelStorei(GL_UNPACK_ROW_LENGTH, texture->texinfo.rowpixels);
-		else
-			glPixelStorei(GL_UNPACK_ROW_LENGTH, texture->rawwidth);
+		const int rowlength = texture->nocopy ? texture->texinfo.rowpixels : texture->rawwidth;
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, rowlength);
 
 		// and upload the image
-		glTexSubImage2D(texture->texTarget, 0, 0, 0, texture->rawwidth, texture->rawheight,
-						GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data);
+		if (partial)
+		{
+			const int first = miny * texture->yprescale + texture->borderpix;
+			glTexSubImage2D(texture->texTarget, 0, 0, first, texture->rawwidth, (maxy - miny) * texture->yprescale,
+							GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data + first * rowlength);
+		}
+		else
+		{
+			glTexSubImage2D(texture->texTarget, 0, 0, 0, texture->rawwidth, texture->rawheight,
+							GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texture->data);
+		}
 	}
 }
 
@@ -2700,10 +2781,12 @@ ogl_texture_info * renderer_ogl::texture_update(const render_primitive *prim, in
 		{
 			if (prim->texture.base != nullptr && texture->texinfo.seqid != prim->texture.seqid)
 			{
+				// the core may say only part of it changed since the contents we have
+				const bool damage_only = prim->texture.damage_seqid && (texture->texinfo.seqid == prim->texture.damage_seqid);
 				texture->texinfo.seqid = prim->texture.seqid;
 
 				// if we found it, but with a different seqid, copy the data
-				texture_set_data(texture, &prim->texture, prim->flags);
+				texture_set_data(texture, &prim->texture, prim->flags, damage_only);
 				texBound=1;
 			}
 		}
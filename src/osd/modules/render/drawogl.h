@@ -37,6 +37,8 @@ typedef uint64_t HashT;
 #include "emucore.h"
 #include "render.h"
 
+#include <vector>
+
 //============================================================
 //  Textures
 //============================================================
@@ -127,6 +129,7 @@ public:
 		, m_last_vofs(0.0f)
 		, m_surf_w(0)
 		, m_surf_h(0)
+		, m_batch_blendmode(0)
 	{
 		for (int i=0; i < HASH_SIZE + OVERFLOW_SIZE; i++)
 			m_texhash[i] = nullptr;
@@ -180,6 +183,8 @@ private:
 	void loadGLExtensions();
 	void initialize_gl();
 	void set_blendmode(int blendmode);
+	void batch_quad(const render_primitive &prim, float hofs, float vofs);
+	void flush_quad_batch();
 	HashT texture_compute_hash(const render_texinfo *texture, uint32_t flags);
 	void texture_compute_type_subroutine(const render_texinfo *texsource, ogl_texture_info *texture, uint32_t flags);
 	void texture_compute_size_subroutine(ogl_texture_info *texture, uint32_t flags,
@@ -237,6 +242,11 @@ private:
 	int32_t           m_surf_h;
 	GLfloat         m_texVerticex[8];
 
+	// consecutive untextured quads, drawn with a single call
+	std::vector<GLfloat> m_batch_vertices;
+	std::vector<GLfloat> m_batch_colors;
+	int             m_batch_blendmode;
+
 	static bool     s_shown_video_info;
 	static bool     s_dll_loaded;
 };
@@ -19,6 +19,7 @@
 #include <CoreFoundation/CoreFoundation.h>
 #include <CoreServices/CoreServices.h>
 
+#include <atomic>
 #include <memory>
 #include <new>
 #include <cstring>
@@ -66,6 +67,7 @@ public:
 
 	virtual void update_audio_stream(bool is_throttled, int16_t const *buffer, int samples_this_frame) override;
 	virtual void set_mastervolume(int attenuation) override;
+	virtual int underflows() const override { return int(m_underflows.load(std::memory_order_relaxed)); }
 
 private:
 	struct node_detail
@@ -182,7 +184,7 @@ private:
 	bool        m_in_underrun;
 	int32_t       m_scale;
 	unsigned    m_overflows;
-	unsigned    m_underflows;
+	std::atomic<unsigned> m_underflows;
 };
 
 
@@ -285,7 +287,7 @@ void sound_coreaudio::exit()
 	}
 	m_buffer.reset();
 	if (m_overflows || m_underflows)
-		osd_printf_verbose("Sound buffer: overflows=%u underflows=%u\n", m_overflows, m_underflows);
+		osd_printf_verbose("Sound buffer: overflows=%u underflows=%u\n", m_overflows, m_underflows.load());
 	osd_printf_verbose("Audio: End deinitialization\n");
 }
 
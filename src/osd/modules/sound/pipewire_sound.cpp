@@ -0,0 +1,313 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    pipewire_sound.cpp
+
+    Native PipeWire interface.
+
+    Samples are pulled straight from the ring by the stream's process
+    callback, which runs on the PipeWire graph's realtime thread.  The
+    node asks the graph for a small quantum in low-latency mode, so there
+    is no extra buffering layer between the ring and the device.
+
+    The module needs libpipewire-0.3, so it's only built with
+    USE_PIPEWIRE=1.
+
+***************************************************************************/
+
+#include "sound_module.h"
+#include "modules/osdmodule.h"
+
+#if defined(USE_PIPEWIRE)
+
+#include <pipewire/pipewire.h>
+#include <spa/param/audio/format-utils.h>
+#include <spa/param/props.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+#include "modules/lib/osdobj_common.h"
+#include "osdcore.h"
+
+using osd::s16;
+using osd::u32;
+
+class sound_pipewire : public osd_module, public sound_module
+{
+public:
+	sound_pipewire()
+		: osd_module(OSD_SOUND_PROVIDER, "pipewire"), sound_module(),
+		m_loop(nullptr),
+		m_stream(nullptr),
+		m_state(PW_STREAM_STATE_UNCONNECTED),
+		m_quantum(0),
+		m_ring_target(0),
+		m_last_sample(0),
+		m_primed(false),
+		m_underflows(0)
+	{
+	}
+	virtual ~sound_pipewire() { }
+
+	virtual int init(osd_options const &options) override;
+	virtual void exit() override;
+	virtual void update_audio_stream(bool is_throttled, const s16 *buffer, int samples_this_frame) override;
+	virtual void set_mastervolume(int attenuation) override;
+	virtual int update_frequency() const override { return (m_audio_latency == 0) ? LOW_LATENCY_UPDATE_FREQUENCY : 0; }
+	virtual int latency_samples() const override { return m_ring ? int(m_ring->available() + m_quantum) : -1; }
+	virtual int underflows() const override { return m_underflows.load(std::memory_order_relaxed); }
+
+private:
+	// updates per second requested when audio_latency is 0
+	static constexpr int LOW_LATENCY_UPDATE_FREQUENCY = 1000;
+
+	// seconds to wait for the stream to connect
+	static constexpr int CONNECT_TIMEOUT = 2;
+
+	static void i_state_changed(void *self, pw_stream_state old, pw_stream_state state, const char *error);
+	void state_changed(pw_stream_state state, const char *error);
+	static void i_process(void *self);
+	void process();
+
+	pw_thread_loop *m_loop;
+	pw_stream *m_stream;
+	pw_stream_events m_events;
+	pw_stream_state m_state;
+
+	std::unique_ptr<sample_ring> m_ring;
+	u32 m_quantum;
+	size_t m_ring_target;
+
+	// only touched by the process callback
+	u32 m_last_sample;
+	bool m_primed;
+
+	std::atomic<int> m_underflows;
+};
+
+void sound_pipewire::i_state_changed(void *self, pw_stream_state old, pw_stream_state state, const char *error)
+{
+	static_cast<sound_pipewire *>(self)->state_changed(state, error);
+}
+
+void sound_pipewire::state_changed(pw_stream_state state, const char *error)
+{
+	if(state == PW_STREAM_STATE_ERROR)
+		osd_printf_error("PipeWire: stream error: %s\n", error ? error : "unknown");
+
+	m_state = state;
+	pw_thread_loop_signal(m_loop, false);
+}
+
+void sound_pipewire::i_process(void *self)
+{
+	static_cast<sound_pipewire *>(self)->process();
+}
+
+void sound_pipewire::process()
+{
+	pw_buffer *const b = pw_stream_dequeue_buffer(m_stream);
+	if(!b)
+		return;
+
+	spa_data &data = b->buffer->datas[0];
+	s16 *const dst = reinterpret_cast<s16 *>(data.data);
+	if(!dst) {
+		pw_stream_queue_buffer(m_stream, b);
+		return;
+	}
+
+	// fill exactly what the graph asked for this cycle when it says
+	size_t frames = data.maxsize / 4;
+#if PW_CHECK_VERSION(0, 3, 49)
+	if(b->requested)
+		frames = std::min<size_t>(frames, b->requested);
+#endif
+
+	// drain the ring, and repeat the last sample if it runs dry; running
+	// dry before the first samples arrive is not an underflow
+	size_t got = m_ring->pop(dst, frames);
+	if(got) {
+		memcpy(&m_last_sample, &dst[(got - 1) * 2], 4);
+		m_primed = true;
+	}
+	if(got != frames) {
+		if(m_primed)
+			m_underflows.fetch_add(1, std::memory_order_relaxed);
+		for(; got != frames; got++)
+			memcpy(&dst[got * 2], &m_last_sample, 4);
+	}
+
+	data.chunk->offset = 0;
+	data.chunk->stride = 4;
+	data.chunk->size = frames * 4;
+	pw_stream_queue_buffer(m_stream, b);
+}
+
+int sound_pipewire::init(osd_options const &options)
+{
+	m_last_sample = 0;
+	m_primed = false;
+	m_underflows = 0;
+
+	// ask for about 2.7 ms per graph cycle (128 samples at 48 kHz) and keep
+	// about 5 ms in the ring in low-latency mode; otherwise behave like the
+	// other modules with a 10 ms quantum and 0.1 s of queued sound
+	if(m_audio_latency == 0) {
+		m_quantum = std::max(sample_rate() * 8 / 3000, 32);
+		m_ring_target = sample_rate() / 200;
+	} else {
+		m_quantum = sample_rate() / 100;
+		m_ring_target = sample_rate() / 10;
+	}
+	m_ring = std::make_unique<sample_ring>(std::max<size_t>(m_ring_target * 2, sample_rate() / 5));
+
+	pw_init(nullptr, nullptr);
+
+	m_loop = pw_thread_loop_new("MAME sound", nullptr);
+	if(!m_loop) {
+		osd_printf_error("PipeWire: unable to create thread loop\n");
+		pw_deinit();
+		m_ring.reset();
+		return 1;
+	}
+
+	pw_properties *const props = pw_properties_new(
+			PW_KEY_MEDIA_TYPE, "Audio",
+			PW_KEY_MEDIA_CATEGORY, "Playback",
+			PW_KEY_MEDIA_ROLE, "Game",
+			PW_KEY_APP_NAME, "MAME",
+			nullptr);
+	pw_properties_setf(props, PW_KEY_NODE_LATENCY, "%u/%u", m_quantum, sample_rate());
+	pw_properties_setf(props, PW_KEY_NODE_RATE, "1/%u", sample_rate());
+
+	std::memset(&m_events, 0, sizeof(m_events));
+	m_events.version = PW_VERSION_STREAM_EVENTS;
+	m_events.state_changed = &sound_pipewire::i_state_changed;
+	m_events.process = &sound_pipewire::i_process;
+
+	pw_thread_loop_lock(m_loop);
+	m_state = PW_STREAM_STATE_UNCONNECTED;
+	m_stream = pw_stream_new_simple(pw_thread_loop_get_loop(m_loop), "main output", props, &m_events, this);
+	if(!m_stream) {
+		pw_thread_loop_unlock(m_loop);
+		osd_printf_error("PipeWire: unable to create stream\n");
+		exit();
+		return 1;
+	}
+
+	spa_audio_info_raw info;
+	std::memset(&info, 0, sizeof(info));
+	info.format = SPA_AUDIO_FORMAT_S16;
+	info.rate = sample_rate();
+	info.channels = 2;
+	info.position[0] = SPA_AUDIO_CHANNEL_FL;
+	info.position[1] = SPA_AUDIO_CHANNEL_FR;
+
+	uint8_t podbuf[1024];
+	spa_pod_builder builder = SPA_POD_BUILDER_INIT(podbuf, sizeof(podbuf));
+	const spa_pod *params[1];
+	params[0] = spa_format_audio_raw_build(&builder, SPA_PARAM_EnumFormat, &info);
+
+	int err = pw_stream_connect(
+			m_stream,
+			PW_DIRECTION_OUTPUT,
+			PW_ID_ANY,
+			pw_stream_flags(PW_STREAM_FLAG_AUTOCONNECT | PW_STREAM_FLAG_MAP_BUFFERS | PW_STREAM_FLAG_RT_PROCESS),
+			params, 1);
+	if(err < 0) {
+		pw_thread_loop_unlock(m_loop);
+		osd_printf_error("PipeWire: unable to connect stream: %s\n", spa_strerror(err));
+		exit();
+		return 1;
+	}
+
+	if(pw_thread_loop_start(m_loop) < 0) {
+		pw_thread_loop_unlock(m_loop);
+		osd_printf_error("PipeWire: unable to start thread loop\n");
+		exit();
+		return 1;
+	}
+
+	// wait for the stream to be linked to a sink
+	while((m_state == PW_STREAM_STATE_UNCONNECTED) || (m_state == PW_STREAM_STATE_CONNECTING)) {
+		if(pw_thread_loop_timed_wait(m_loop, CONNECT_TIMEOUT) != 0)
+			break;
+	}
+	bool const connected = (m_state == PW_STREAM_STATE_PAUSED) || (m_state == PW_STREAM_STATE_STREAMING);
+	pw_thread_loop_unlock(m_loop);
+
+	if(!connected) {
+		osd_printf_error("PipeWire: stream did not connect\n");
+		exit();
+		return 1;
+	}
+
+	osd_printf_verbose("PipeWire: requested quantum %u/%d\n", m_quantum, sample_rate());
+	return 0;
+}
+
+void sound_pipewire::update_audio_stream(bool is_throttled, const s16 *buffer, int samples_this_frame)
+{
+	if(!m_ring)
+		return;
+
+	// If we're over the target, drop a few samples per update to slowly
+	// resync and reduce latency; the process callback only ever drains
+	// the ring, so no locking is needed here
+	size_t queued = m_ring->available();
+	if(queued > m_ring_target) {
+		size_t skip = std::min<size_t>(std::max(samples_this_frame / 64, 1), samples_this_frame);
+		buffer += skip * 2;
+		samples_this_frame -= skip;
+	}
+
+	// Whatever doesn't fit is lost
+	m_ring->push(buffer, samples_this_frame);
+}
+
+void sound_pipewire::set_mastervolume(int attenuation)
+{
+	if(!m_stream)
+		return;
+
+	// attenuation is in dB, channel volumes are linear
+	float const volume = (attenuation <= -32) ? 0.0f : std::pow(10.0f, float(attenuation) / 20.0f);
+	float values[2] = { volume, volume };
+
+	pw_thread_loop_lock(m_loop);
+	pw_stream_set_control(m_stream, SPA_PROP_channelVolumes, 2, values, 0);
+	pw_thread_loop_unlock(m_loop);
+}
+
+void sound_pipewire::exit()
+{
+	if(m_loop)
+		pw_thread_loop_stop(m_loop);
+
+	if(m_stream) {
+		if(m_underflows)
+			osd_printf_verbose("Sound buffer: underflows=%d\n", m_underflows.load());
+		pw_stream_destroy(m_stream);
+		m_stream = nullptr;
+	}
+
+	if(m_loop) {
+		pw_thread_loop_destroy(m_loop);
+		m_loop = nullptr;
+		pw_deinit();
+	}
+
+	m_ring.reset();
+}
+
+#else
+	MODULE_NOT_SUPPORTED(sound_pipewire, OSD_SOUND_PROVIDER, "pipewire")
+#endif
+
+MODULE_DEFINITION(SOUND_PIPEWIRE, sound_pipewire)
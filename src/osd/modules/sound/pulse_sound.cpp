@@ -20,11 +20,15 @@
 #include <stdlib.h>
 #include <poll.h>
 
+#include <algorithm>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 #include <pulse/pulseaudio.h>
 
 #include "modules/lib/osdobj_common.h"
+#include "osdsync.h"
 
 using osd::s16;
 using osd::u32;
@@ -42,12 +46,12 @@ public:
 	virtual void exit() override;
 	virtual void update_audio_stream(bool is_throttled, const s16 *buffer, int samples_this_frame) override;
 	virtual void set_mastervolume(int attenuation) override;
+	virtual int update_frequency() const override { return (m_audio_latency == 0) ? LOW_LATENCY_UPDATE_FREQUENCY : 0; }
+	virtual int latency_samples() const override { return m_ring ? int(m_ring->available()) : -1; }
 
 private:
-	struct abuffer {
-		size_t cpos;
-		std::vector<u32> data;
-	};
+	// updates per second requested when audio_latency is 0
+	static constexpr int LOW_LATENCY_UPDATE_FREQUENCY = 1000;
 
 	std::thread *m_thread;
 	pa_mainloop *m_mainloop;
@@ -55,7 +59,9 @@ private:
 	pa_stream *m_stream;
 	std::mutex m_mutex;
 
-	std::vector<abuffer> m_buffers;
+	std::unique_ptr<sample_ring> m_ring;
+	std::vector<s16> m_write_buffer;
+	size_t m_ring_target;
 
 	u32 m_last_sample;
 	int m_new_volume_value;
@@ -227,31 +233,17 @@ void sound_pulse::stream_write_request(size_t size)
 	}
 	size >>= 2;
 
-	std::unique_lock<std::mutex> lock(m_mutex);
-	while(size) {
-		if(m_buffers.empty()) {
-			std::vector<u32> zero(size, m_last_sample);
-			int err = pa_stream_write(m_stream, zero.data(), size << 2, nullptr, 0, PA_SEEK_RELATIVE);
-			if(err)
-				generic_pa_error("stream write", err);
-			size = 0;
-
-		} else {
-			auto &buf = m_buffers[0];
-			size_t csz = size;
-			size_t cur = buf.data.size() - buf.cpos;
-			if(csz > cur)
-				csz = cur;
-			int err = pa_stream_write(m_stream, buf.data.data() + buf.cpos, csz << 2, nullptr, 0, PA_SEEK_RELATIVE);
-			if(err)
-				generic_pa_error("stream write", err);
-			if(csz == cur)
-				m_buffers.erase(m_buffers.begin());
-			else
-				buf.cpos += csz;
-			size -= csz;
-		}
-	}
+	// drain the ring, and repeat the last sample if it runs dry
+	m_write_buffer.resize(size * 2);
+	size_t got = m_ring->pop(m_write_buffer.data(), size);
+	if(got)
+		memcpy(&m_last_sample, &m_write_buffer[(got - 1) * 2], 4);
+	for(; got != size; got++)
+		memcpy(&m_write_buffer[got * 2], &m_last_sample, 4);
+
+	int err = pa_stream_write(m_stream, m_write_buffer.data(), size << 2, nullptr, 0, PA_SEEK_RELATIVE);
+	if(err)
+		generic_pa_error("stream write", err);
 }
 
 void sound_pulse::i_stream_write_request(pa_stream *, size_t size, void *self)
@@ -262,6 +254,8 @@ void sound_pulse::i_stream_write_request(pa_stream *, size_t size, void *self)
 
 void sound_pulse::mainloop_thread()
 {
+	osd::thread_affinity_apply(osd::thread_role::WORKER);
+
 	int err = 0;
 	pa_mainloop_run(m_mainloop, &err);
 	if(err)
@@ -280,6 +274,10 @@ int sound_pulse::init(osd_options const &options)
 	m_new_volume = false;
 	m_new_volume_value = 0;
 
+	// hold about 5 ms in low-latency mode, and 0.1 s otherwise
+	m_ring_target = (m_audio_latency == 0) ? (sample_rate() / 200) : (sample_rate() / 10);
+	m_ring = std::make_unique<sample_ring>(std::max<size_t>(m_ring_target * 2, sample_rate() / 5));
+
 	m_mainloop = pa_mainloop_new();
 	m_context = pa_context_new(pa_mainloop_get_api(m_mainloop), "MAME");
 	pa_context_set_state_callback(m_context, i_context_notify, this);
@@ -327,23 +325,21 @@ int sound_pulse::init(osd_options const &options)
 
 void sound_pulse::update_audio_stream(bool is_throttled, const s16 *buffer, int samples_this_frame)
 {
-	std::unique_lock<std::mutex> lock(m_mutex);
-	m_buffers.resize(m_buffers.size() + 1);
-	auto &buf = m_buffers.back();
-	buf.cpos = 0;
-	buf.data.resize(samples_this_frame);
-	memcpy(buf.data.data(), buffer, samples_this_frame*4);
-	m_last_sample = buf.data.back();
-
-	if(m_buffers.size() > 10)
-		// If there way too many buffers, drop some so only 10 are left (roughly 0.2s)
-		m_buffers.erase(m_buffers.begin(), m_buffers.begin() + m_buffers.size() - 10);
-
-	else if(m_buffers.size() >= 5)
-		// If there are too many buffers, remove five sample per buffer
-		// to slowly resync to reduce latency (4 seconds to
-		// compensate one buffer roughly)
-		buf.cpos = 5;
+	if(!m_ring)
+		return;
+
+	// If we're over the target, drop a few samples per update to slowly
+	// resync and reduce latency; the write callback only ever drains the
+	// ring, so no locking is needed here
+	size_t queued = m_ring->available();
+	if(queued > m_ring_target) {
+		size_t skip = std::min<size_t>(std::max(samples_this_frame / 64, 1), samples_this_frame);
+		buffer += skip * 2;
+		samples_this_frame -= skip;
+	}
+
+	// Whatever doesn't fit is lost
+	m_ring->push(buffer, samples_this_frame);
 }
 
 void sound_pulse::volume_set_notify(int success)
@@ -403,7 +399,7 @@ void sound_pulse::exit()
 	m_mainloop = nullptr;
 	m_context = nullptr;
 	m_stream = nullptr;
-	m_buffers.clear();
+	m_ring.reset();
 }
 
 #else
@@ -23,6 +23,7 @@
 #include "../../sdl/osdsdl.h"
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <memory>
 
@@ -43,10 +44,13 @@ public:
 	// number of samples per SDL callback
 	static const int SDL_XFER_SAMPLES = 512;
 
+	// updates per second requested when audio_latency is 0
+	static const int LOW_LATENCY_UPDATE_FREQUENCY = 1000;
+
 	sound_sdl() :
 		osd_module(OSD_SOUND_PROVIDER, "sdl"), sound_module(),
 		stream_in_initialized(0),
-		attenuation(0), buf_locked(0), stream_buffer(nullptr), stream_buffer_size(0), buffer_underflows(0), buffer_overflows(0)
+		attenuation(0), stream_buffer(nullptr), stream_buffer_size(0), buffer_underflows(0), buffer_overflows(0)
 {
 		sdl_xfer_samples = SDL_XFER_SAMPLES;
 	}
@@ -59,30 +63,14 @@ public:
 
 	virtual void update_audio_stream(bool is_throttled, const int16_t *buffer, int samples_this_frame) override;
 	virtual void set_mastervolume(int attenuation) override;
+	virtual int update_frequency() const override { return (m_audio_latency == 0) ? LOW_LATENCY_UPDATE_FREQUENCY : 0; }
+	virtual int latency_samples() const override { return stream_buffer ? int(stream_buffer->available() + sdl_xfer_samples) : -1; }
+	virtual int underflows() const override { return buffer_underflows.load(std::memory_order_relaxed); }
 
 private:
-	class ring_buffer
-	{
-	public:
-		ring_buffer(size_t size);
-
-		size_t data_size() const { return (tail - head + buffer_size) % buffer_size; }
-		size_t free_size() const { return (head - tail - 1 + buffer_size) % buffer_size; }
-		int append(const void *data, size_t size);
-		int pop(void *data, size_t size);
-
-	private:
-		std::unique_ptr<int8_t []> const buffer;
-		size_t const buffer_size;
-		int head = 0, tail = 0;
-	};
-
 	static void sdl_callback(void *userdata, Uint8 *stream, int len);
 
-	void lock_buffer();
-	void unlock_buffer();
 	void attenuate(int16_t *data, int bytes);
-	void copy_sample_data(bool is_throttled, const int16_t *data, int bytes_to_copy);
 	int sdl_create_buffers();
 	void sdl_destroy_buffers();
 
@@ -90,13 +78,13 @@ private:
 	int stream_in_initialized;
 	int attenuation;
 
-	int              buf_locked;
-	std::unique_ptr<ring_buffer> stream_buffer;
-	uint32_t         stream_buffer_size;
+	std::unique_ptr<sample_ring> stream_buffer;
+	uint32_t         stream_buffer_size;    // in stereo samples
+	uint32_t         stream_buffer_target;  // most samples to hold before dropping new ones
 
 
 	// diagnostics
-	int              buffer_underflows;
+	std::atomic<int> buffer_underflows;
 	int              buffer_overflows;
 	std::unique_ptr<std::ofstream> sound_log;
 };
@@ -109,98 +97,6 @@ private:
 // maximum audio latency
 #define MAX_AUDIO_LATENCY       5
 
-//============================================================
-//  ring_buffer - constructor
-//============================================================
-
-sound_sdl::ring_buffer::ring_buffer(size_t size)
-	: buffer(std::make_unique<int8_t []>(size + 1)), buffer_size(size + 1)
-{
-	// A size+1 bytes buffer is allocated because it can never be full.
-	// Otherwise the case head == tail couldn't be distinguished between a
-	// full buffer and an empty buffer.
-	std::fill_n(buffer.get(), size + 1, 0);
-}
-
-//============================================================
-//  ring_buffer::append
-//============================================================
-
-int sound_sdl::ring_buffer::append(const void *data, size_t size)
-{
-	if (free_size() < size)
-		return -1;
-
-	int8_t const *const data8 = reinterpret_cast<int8_t const *>(data);
-	size_t sz = buffer_size - tail;
-	if (size <= sz)
-		sz = size;
-	else
-		std::copy_n(&data8[sz], size - sz, &buffer[0]);
-
-	std::copy_n(data8, sz, &buffer[tail]);
-	tail = (tail + size) % buffer_size;
-
-	return 0;
-}
-
-//============================================================
-//  ring_buffer::pop
-//============================================================
-
-int sound_sdl::ring_buffer::pop(void *data, size_t size)
-{
-	if (data_size() < size)
-		return -1;
-
-	int8_t *const data8 = reinterpret_cast<int8_t *>(data);
-	size_t sz = buffer_size - head;
-	if (size <= sz)
-		sz = size;
-	else
-	{
-		std::copy_n(&buffer[0], size - sz, &data8[sz]);
-		std::fill_n(&buffer[0], size - sz, 0);
-	}
-
-	std::copy_n(&buffer[head], sz, data8);
-	std::fill_n(&buffer[head], sz, 0);
-	head = (head + size) % buffer_size;
-
-	return 0;
-}
-
-//============================================================
-//  sound_sdl - destructor
-//============================================================
-
-//============================================================
-//  lock_buffer
-//============================================================
-void sound_sdl::lock_buffer()
-{
-	if (!buf_locked)
-		SDL_LockAudio();
-	buf_locked++;
-
-	if (LOG_SOUND)
-		*sound_log << "locking\n";
-}
-
-//============================================================
-//  unlock_buffer
-//============================================================
-void sound_sdl::unlock_buffer()
-{
-	buf_locked--;
-	if (!buf_locked)
-		SDL_UnlockAudio();
-
-	if (LOG_SOUND)
-		*sound_log << "unlocking\n";
-
-}
-
 //============================================================
 //  Apply attenuation
 //============================================================
@@ -217,21 +113,6 @@ void sound_sdl::attenuate(int16_t *data, int bytes_to_copy)
 	}
 }
 
-//============================================================
-//  copy_sample_data
-//============================================================
-
-void sound_sdl::copy_sample_data(bool is_throttled, const int16_t *data, int bytes_to_copy)
-{
-	lock_buffer();
-	int const err = stream_buffer->append(data, bytes_to_copy);
-	unlock_buffer();
-
-	if (LOG_SOUND && err)
-		*sound_log << "Late detection of overflow. This shouldn't happen.\n";
-}
-
-
 //============================================================
 //  update_audio_stream
 //============================================================
@@ -246,33 +127,31 @@ void sound_sdl::update_audio_stream(bool is_throttled, const int16_t *buffer, in
 	if (!stream_in_initialized)
 	{
 		// Fill in some zeros to prevent an initial buffer underflow
-		int8_t zero = 0;
-		size_t zsize = stream_buffer->free_size() / 2;
-		while (zsize--)
-			stream_buffer->append(&zero, 1);
+		int16_t const zero[2] = { 0, 0 };
+		for (uint32_t zsize = stream_buffer_target / 2; zsize; zsize--)
+			stream_buffer->push(zero, 1);
 
 		// start playing
 		SDL_PauseAudio(0);
 		stream_in_initialized = 1;
 	}
 
-	size_t bytes_this_frame = samples_this_frame * sizeof(*buffer) * 2;
-	size_t free_size = stream_buffer->free_size();
-	size_t data_size = stream_buffer->data_size();
+	size_t const data_size = stream_buffer->available();
+	size_t const wanted = (data_size < stream_buffer_target) ? (stream_buffer_target - data_size) : 0;
 
-	if (stream_buffer->free_size() < bytes_this_frame) {
+	if (wanted < samples_this_frame) {
 		if (LOG_SOUND)
-			util::stream_format(*sound_log, "Overflow: DS=%u FS=%u BTF=%u\n", data_size, free_size, bytes_this_frame);
+			util::stream_format(*sound_log, "Overflow: DS=%u target=%u samples=%d\n", data_size, stream_buffer_target, samples_this_frame);
 		buffer_overflows++;
-		return;
+		if (!wanted)
+			return;
 	}
 
-	copy_sample_data(is_throttled, buffer, bytes_this_frame);
+	// only the callback ever removes samples, so no locking is needed
+	size_t const appended = stream_buffer->push(buffer, std::min<size_t>(samples_this_frame, wanted));
 
-	size_t nfree_size = stream_buffer->free_size();
-	size_t ndata_size = stream_buffer->data_size();
 	if (LOG_SOUND)
-		util::stream_format(*sound_log, "Appended data: DS=%u(%u) FS=%u(%u) BTF=%u\n", data_size, ndata_size, free_size, nfree_size, bytes_this_frame);
+		util::stream_format(*sound_log, "Appended data: DS=%u(%u) samples=%u\n", data_size, stream_buffer->available(), appended);
 }
 
 
@@ -301,28 +180,22 @@ void sound_sdl::set_mastervolume(int _attenuation)
 void sound_sdl::sdl_callback(void *userdata, Uint8 *stream, int len)
 {
 	sound_sdl *thiz = reinterpret_cast<sound_sdl *>(userdata);
-	size_t const free_size = thiz->stream_buffer->free_size();
-	size_t const data_size = thiz->stream_buffer->data_size();
+	size_t const frames = len / (2 * sizeof(int16_t));
 
-	if (data_size < len)
+	// play whatever we have, and pad with silence if it isn't enough
+	size_t const popped = thiz->stream_buffer->pop(reinterpret_cast<int16_t *>(stream), frames);
+	if (popped < frames)
 	{
 		thiz->buffer_underflows++;
 		if (LOG_SOUND)
-			util::stream_format(*thiz->sound_log, "Underflow at sdl_callback: DS=%u FS=%u Len=%d\n", data_size, free_size, len);
-
-		// Maybe read whatever is left in the stream_buffer anyway?
-		memset(stream, 0, len);
-		return;
+			util::stream_format(*thiz->sound_log, "Underflow at sdl_callback: DS=%u Len=%d\n", popped, len);
+		memset(stream + popped * 2 * sizeof(int16_t), 0, (frames - popped) * 2 * sizeof(int16_t));
 	}
 
-	int err = thiz->stream_buffer->pop((void *)stream, len);
-	if (LOG_SOUND && err)
-		*thiz->sound_log << "Late detection of underflow. This shouldn't happen.\n";
-
 	thiz->attenuate((int16_t *)stream, len);
 
 	if (LOG_SOUND)
-		util::stream_format(*thiz->sound_log, "callback: xfer DS=%u FS=%u Len=%d\n", data_size, free_size, len);
+		util::stream_format(*thiz->sound_log, "callback: xfer DS=%u Len=%d\n", popped, len);
 }
 
 
@@ -352,7 +225,14 @@ int sound_sdl::init(const osd_options &options)
 		char const *const audio_driver = SDL_GetCurrentAudioDriver();
 		osd_printf_verbose("Audio: Driver is %s\n", audio_driver ? audio_driver : "not initialized");
 
+		// in low-latency mode, ask for callbacks every 2-3 ms
 		sdl_xfer_samples = SDL_XFER_SAMPLES;
+		if (m_audio_latency == 0)
+		{
+			sdl_xfer_samples = 64;
+			while (sdl_xfer_samples * 400 < sample_rate())
+				sdl_xfer_samples <<= 1;
+		}
 		stream_in_initialized = 0;
 
 		// set up the audio specs
@@ -371,14 +251,22 @@ int sound_sdl::init(const osd_options &options)
 
 		sdl_xfer_samples = obtained.samples;
 
-		// pin audio latency
-		audio_latency = std::clamp(m_audio_latency, 1, MAX_AUDIO_LATENCY);
-
-		// compute the buffer sizes
-		stream_buffer_size = (sample_rate() * 2 * sizeof(int16_t) * (2 + audio_latency)) / 30;
-		stream_buffer_size = (stream_buffer_size / 1024) * 1024;
-		if (stream_buffer_size < 1024)
-			stream_buffer_size = 1024;
+		// compute the buffer sizes; in low-latency mode keep no more than two
+		// callbacks' worth queued on top of what SDL holds
+		if (m_audio_latency == 0)
+		{
+			stream_buffer_target = sdl_xfer_samples * 2;
+		}
+		else
+		{
+			audio_latency = std::clamp(m_audio_latency, 1, MAX_AUDIO_LATENCY);
+			stream_buffer_target = (sample_rate() * (2 + audio_latency)) / 30;
+			stream_buffer_target = (stream_buffer_target / 256) * 256;
+			if (stream_buffer_target < 256)
+				stream_buffer_target = 256;
+		}
+		stream_buffer_size = std::max<uint32_t>(stream_buffer_target, sdl_xfer_samples * 2);
+		osd_printf_verbose("Audio: target latency %d ms\n", int((stream_buffer_target + sdl_xfer_samples) * 1000 / sample_rate()));
 
 		// create the buffers
 		if (sdl_create_buffers())
@@ -422,11 +310,11 @@ void sound_sdl::exit()
 
 	// print out over/underflow stats
 	if (buffer_overflows || buffer_underflows)
-		osd_printf_verbose("Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
+		osd_printf_verbose("Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows.load());
 
 	if (LOG_SOUND)
 	{
-		util::stream_format(*sound_log, "Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
+		util::stream_format(*sound_log, "Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows.load());
 		sound_log.reset();
 	}
 }
@@ -439,10 +327,8 @@ void sound_sdl::exit()
 
 int sound_sdl::sdl_create_buffers()
 {
-	osd_printf_verbose("sdl_create_buffers: creating stream buffer of %u bytes\n", stream_buffer_size);
-
-	stream_buffer = std::make_unique<ring_buffer>(stream_buffer_size);
-	buf_locked = 0;
+	stream_buffer = std::make_unique<sample_ring>(stream_buffer_size);
+	osd_printf_verbose("sdl_create_buffers: creating stream buffer of %u samples\n", unsigned(stream_buffer->capacity()));
 	return 0;
 }
 
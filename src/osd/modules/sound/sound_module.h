@@ -8,7 +8,10 @@
 #ifndef SOUND_MODULE_H_
 #define SOUND_MODULE_H_
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <memory>
 
 //============================================================
 //  CONSTANTS
@@ -26,10 +29,83 @@ public:
 	virtual void update_audio_stream(bool is_throttled, const int16_t *buffer, int samples_this_frame) = 0;
 	virtual void set_mastervolume(int attenuation) = 0;
 
+	// how many times per second the module would like new samples, or 0 for the core's default
+	virtual int update_frequency() const { return 0; }
+
+	// number of samples queued ahead of the output, or -1 if unknown
+	virtual int latency_samples() const { return -1; }
+
+	// number of times the output ran out of samples since it was opened, or -1 if unknown
+	virtual int underflows() const { return -1; }
+
 	int sample_rate() const { return m_sample_rate; }
 
 	int m_sample_rate;
 	int m_audio_latency;
+
+protected:
+	// lock-free ring of interleaved stereo samples, filled by the emulation
+	// thread and drained by the output callback; only one thread may push
+	// and only one may pop
+	class sample_ring
+	{
+	public:
+		sample_ring(size_t frames) :
+			m_size(capacity_for(frames)),
+			m_buffer(std::make_unique<int16_t []>(m_size * 2)),
+			m_read(0),
+			m_write(0)
+		{
+		}
+
+		size_t capacity() const { return m_size; }
+		size_t available() const { return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire); }
+		size_t space() const { return m_size - available(); }
+
+		// append up to frames stereo samples, returning how many fit
+		size_t push(const int16_t *data, size_t frames)
+		{
+			size_t const write = m_write.load(std::memory_order_relaxed);
+			frames = std::min(frames, m_size - (write - m_read.load(std::memory_order_acquire)));
+			for (size_t i = 0; i < frames; i++)
+			{
+				size_t const index = ((write + i) & (m_size - 1)) * 2;
+				m_buffer[index + 0] = data[i * 2 + 0];
+				m_buffer[index + 1] = data[i * 2 + 1];
+			}
+			m_write.store(write + frames, std::memory_order_release);
+			return frames;
+		}
+
+		// remove up to frames stereo samples, returning how many were read
+		size_t pop(int16_t *data, size_t frames)
+		{
+			size_t const read = m_read.load(std::memory_order_relaxed);
+			frames = std::min(frames, m_write.load(std::memory_order_acquire) - read);
+			for (size_t i = 0; i < frames; i++)
+			{
+				size_t const index = ((read + i) & (m_size - 1)) * 2;
+				data[i * 2 + 0] = m_buffer[index + 0];
+				data[i * 2 + 1] = m_buffer[index + 1];
+			}
+			m_read.store(read + frames, std::memory_order_release);
+			return frames;
+		}
+
+	private:
+		static size_t capacity_for(size_t frames)
+		{
+			size_t size = 1;
+			while (size < frames)
+				size <<= 1;
+			return size;
+		}
+
+		size_t const m_size;
+		std::unique_ptr<int16_t []> const m_buffer;
+		std::atomic<size_t> m_read;
+		std::atomic<size_t> m_write;
+	};
 };
 
 #endif /* FONT_MODULE_H_ */
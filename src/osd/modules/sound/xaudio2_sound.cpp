@@ -31,6 +31,7 @@
 // MAME headers
 #include "osdcore.h"
 #include "osdepend.h"
+#include "osdsync.h"
 
 #include "winutil.h"
 
@@ -553,6 +554,8 @@ HRESULT sound_xaudio2::create_voices(const WAVEFORMATEX &format)
 // submits audio events on another thread in a loop
 void sound_xaudio2::process_audio()
 {
+	osd::thread_affinity_apply(osd::thread_role::WORKER);
+
 	BOOL exiting = FALSE;
 	HANDLE hEvents[] = { m_hEventBufferCompleted, m_hEventDataAvailable, m_hEventExiting };
 	while (!exiting)
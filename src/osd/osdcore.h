@@ -186,6 +186,14 @@ typedef void *(*osd_work_callback)(void *param, int threadid);
         A work queue abstracts the notion of how potentially threaded work
         can be performed. If no threading support is available, it is a
         simple matter to execute the work items as they are queued.
+
+        Queues don't own threads: their items run on the process-wide task
+        pool (see osd::task_group in osdsync.h), with at most as many items
+        running at once as the flags above would have given the queue
+        threads.  Items on a queue without WORK_QUEUE_FLAG_MULTI therefore
+        still run one at a time in the order they were queued, and the
+        threadid passed to callbacks is unique among the queue's running
+        items and less than WORK_MAX_THREADS.
 -----------------------------------------------------------------------------*/
 osd_work_queue *osd_work_queue_alloc(int flags);
 
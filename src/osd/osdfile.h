@@ -151,11 +151,45 @@ public:
 	/// \return Result of the operation.
 	virtual std::error_condition flush() noexcept = 0;
 
+	/// \brief Map part of an open file into memory
+	///
+	/// Maps a range of the file read-only into the address space, so
+	/// it can be accessed without copying.  The mapping remains valid
+	/// for as long as a reference to it is held, even after the file
+	/// is closed.  Writes to the file through other means may or may
+	/// not be visible through the mapping.  The default implementation
+	/// reports that mapping is not supported.
+	/// \param [in] offset Byte offset within the file to map.  Need not
+	///   be aligned.
+	/// \param [in] length Number of bytes to map.  Must be non-zero and
+	///   must not extend beyond the end of the file.
+	/// \param [out] data Receives a pointer to the mapped data if the
+	///   operation succeeds.  Not valid if the operation fails.
+	/// \return Result of the operation.
+	virtual std::error_condition map(std::uint64_t offset, std::size_t length, std::shared_ptr<void const> &data) noexcept
+	{
+		return std::errc::not_supported;
+	}
+
 	/// \brief Delete a file
 	///
 	/// \param [in] filename Path to the file to delete.
 	/// \return Result of the operation.
 	static std::error_condition remove(std::string const &filename) noexcept;
+
+	/// \brief Rename a file, replacing any existing file
+	///
+	/// \param [in] from Path to the file to rename.
+	/// \param [in] to New path for the file.  If a file already exists
+	///   at this path, it is replaced.
+	/// \return Result of the operation.
+	static std::error_condition rename(std::string const &from, std::string const &to) noexcept;
+
+	/// \brief Set a file's modification time to the current time
+	///
+	/// \param [in] filename Path to the file to update.
+	/// \return Result of the operation.
+	static std::error_condition touch(std::string const &filename) noexcept;
 };
 
 
@@ -6,6 +6,8 @@
 
 #include "dinetwork.h"
 
+#include <chrono>
+
 static class std::vector<std::unique_ptr<osd_netdev::entry_t>> netdev_list;
 
 void add_netdev(const char *name, const char *description, create_netdev func)
@@ -39,24 +41,92 @@ class osd_netdev *open_netdev(int id, class device_network_interface *ifdev, int
 }
 
 osd_netdev::osd_netdev(class device_network_interface *ifdev, int rate)
+	: m_ring_head(0)
+	, m_ring_tail(0)
+	, m_notify_pending(false)
+	, m_thread_exit(false)
 {
 	m_dev = ifdev;
+	m_receiving = true;
 	m_timer = ifdev->device().timer_alloc(FUNC(osd_netdev::recv), this);
 	m_timer->adjust(attotime::from_hz(rate), 0, attotime::from_hz(rate));
 }
 
 osd_netdev::~osd_netdev()
 {
+	// modules must stop the thread before they release what it reads from
+	assert(!m_thread.joinable());
 }
 
 void osd_netdev::start()
 {
-	m_timer->enable(true);
+	m_receiving = true;
+	if (m_thread.joinable())
+		m_timer->adjust(attotime::zero); // deliver anything that arrived while stopped
+	else
+		m_timer->enable(true);
 }
 
 void osd_netdev::stop()
 {
-	m_timer->enable(false);
+	m_receiving = false;
+	if (!m_thread.joinable())
+		m_timer->enable(false);
+}
+
+void osd_netdev::start_receive_thread()
+{
+	assert(!m_thread.joinable());
+
+	// packets are now pushed rather than polled for
+	m_timer->adjust(attotime::never);
+	m_ring = std::make_unique<packet_slot []>(RING_SLOTS);
+	m_thread_exit = false;
+	m_thread = std::thread([this] () { receive_thread(); });
+}
+
+void osd_netdev::stop_receive_thread()
+{
+	if (m_thread.joinable())
+	{
+		m_thread_exit = true;
+		m_thread.join();
+	}
+}
+
+void osd_netdev::receive_thread()
+{
+	while (!m_thread_exit.load(std::memory_order_relaxed))
+	{
+		// leave packets with the host while the emulated device catches up
+		unsigned const head = m_ring_head.load(std::memory_order_relaxed);
+		if ((head - m_ring_tail.load(std::memory_order_acquire)) == RING_SLOTS)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+
+		packet_slot &slot = m_ring[head % RING_SLOTS];
+		int const len = recv_wait(slot.data, sizeof(slot.data));
+		if (len < 0)
+			break;
+		if (!len)
+			continue;
+
+		slot.len = len;
+		m_ring_head.store(head + 1, std::memory_order_release);
+
+		// the interface outlives any netdev it opens, so stale notifications are harmless
+		if (!m_notify_pending.exchange(true, std::memory_order_acq_rel))
+			m_dev->device().machine().scheduler().post(timer_expired_delegate(FUNC(device_network_interface::netdev_receive_ready), m_dev));
+	}
+}
+
+void osd_netdev::receive_ready()
+{
+	// clear first so anything committed while draining posts again
+	m_notify_pending.store(false, std::memory_order_release);
+	recv(0);
 }
 
 int osd_netdev::send(uint8_t *buf, int len)
@@ -66,10 +136,26 @@ int osd_netdev::send(uint8_t *buf, int len)
 
 void osd_netdev::recv(int param)
 {
+	if (m_thread.joinable())
+	{
+		// hand each packet to the device straight from the ring
+		while (m_receiving)
+		{
+			unsigned const tail = m_ring_tail.load(std::memory_order_relaxed);
+			if (m_ring_head.load(std::memory_order_acquire) == tail)
+				break;
+
+			packet_slot &slot = m_ring[tail % RING_SLOTS];
+			m_dev->recv_cb(slot.data, slot.len);
+			m_ring_tail.store(tail + 1, std::memory_order_release);
+		}
+		return;
+	}
+
 	uint8_t *buf;
 	int len;
 	//const char atalkmac[] = { 0x09, 0x00, 0x07, 0xff, 0xff, 0xff };
-	while(m_timer->enabled() && (len = recv_dev(&buf)))
+	while(m_receiving && (len = recv_dev(&buf)))
 	{
 #if 0
 		if(buf[0] & 1)
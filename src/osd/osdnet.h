@@ -6,6 +6,9 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
 
 class osd_netdev;
 
@@ -40,14 +43,41 @@ public:
 	const char *get_mac();
 	bool get_promisc();
 
+	// packets received on the module's thread are ready to deliver
+	void receive_ready();
+
 protected:
 	virtual int recv_dev(uint8_t **buf);
 
+	// modules that can block waiting for a packet receive on a thread of
+	// their own, straight into a ring shared with the emulation thread;
+	// recv_wait returns the length, 0 on timeout or -1 to give up
+	virtual int recv_wait(uint8_t *buf, int len) { return -1; }
+	void start_receive_thread();
+	void stop_receive_thread();
+
 private:
+	static constexpr unsigned RING_SLOTS = 64;
+
+	struct packet_slot
+	{
+		int len;
+		uint8_t data[2048];
+	};
+
 	void recv(int param);
+	void receive_thread();
 
 	class device_network_interface *m_dev;
 	emu_timer *m_timer;
+	bool m_receiving;
+
+	std::unique_ptr<packet_slot []> m_ring;
+	std::atomic<unsigned> m_ring_head;      // next slot to fill, advanced by the receive thread
+	std::atomic<unsigned> m_ring_tail;      // next slot to deliver, advanced by the emulation thread
+	std::atomic<bool> m_notify_pending;
+	std::atomic<bool> m_thread_exit;
+	std::thread m_thread;
 };
 
 class osd_netdev *open_netdev(int id, class device_network_interface *ifdev, int rate);
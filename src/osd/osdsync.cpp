@@ -20,11 +20,18 @@
 #include <atomic>
 #include <thread>
 #include <vector>
+#include <deque>
+#include <memory>
 #include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
 // MAME headers
 #include "osdcore.h"
 #include "osdsync.h"
 
+#include "modules/lib/osdlib.h"
+
 #include "eminline.h"
 
 #if defined(SDLMAME_LINUX) || defined(SDLMAME_BSD) || defined(SDLMAME_HAIKU) || defined(SDLMAME_EMSCRIPTEN) || defined(SDLMAME_MACOSX)
@@ -46,18 +53,17 @@
 
 #define SPIN_LOOP_TIME          (osd_ticks_per_second() / 10000)
 
+// how long a thread waiting for work it can't help with sleeps before looking for tasks again
+#define HELP_POLL_TIME          std::chrono::milliseconds(1)
+
 //============================================================
 //  MACROS
 //============================================================
 
 #if KEEP_STATISTICS
 #define add_to_stat(v,x)        do { (v) += (x); } while (0)
-#define begin_timing(v)         do { (v) -= get_profile_ticks(); } while (0)
-#define end_timing(v)           do { (v) += get_profile_ticks(); } while (0)
 #else
 #define add_to_stat(v,x)        do { } while (0)
-#define begin_timing(v)         do { } while (0)
-#define end_timing(v)           do { } while (0)
 #endif
 
 template<typename _AtomType, typename _MainType>
@@ -97,84 +103,112 @@ int osd_get_num_processors(bool heavy_mt)
 #endif
 }
 
+//============================================================
+//  GLOBAL VARIABLES
+//============================================================
+
+int osd_num_processors = 0;
+
+//============================================================
+//  FUNCTION PROTOTYPES
+//============================================================
+
+static int effective_num_processors(bool heavy_mt);
+
 //============================================================
 //  TYPE DEFINITIONS
 //============================================================
 
-struct work_thread_info
+namespace osd {
+
+// priorities run by the worker threads; I/O tasks have their own threads
+constexpr int WORKER_PRIORITIES = int(task_priority::IO);
+
+
+// a unit of work on the pool; the pool never owns or copies tasks
+struct pool_task
 {
-	work_thread_info(uint32_t aid, osd_work_queue &aqueue)
-	: queue(aqueue)
-	, handle(nullptr)
-	, wakeevent(true, false)  // manual reset, not signalled
-	, id(aid)
-#if KEEP_STATISTICS
-	, itemsdone(0)
-	, actruntime(0)
-	, runtime(0)
-	, spintime(0)
-	, waittime(0)
-#endif
-	{
-	}
-	osd_work_queue &    queue;          // pointer back to the queue
-	std::thread *       handle;         // handle to the thread
-	osd_event           wakeevent;      // wake event for the thread
-	uint32_t              id;
+	void (*execute)(pool_task &task);
+};
 
-#if KEEP_STATISTICS
-	int32_t               itemsdone;
-	osd_ticks_t         actruntime;
-	osd_ticks_t         runtime;
-	osd_ticks_t         spintime;
-	osd_ticks_t         waittime;
-#endif
+
+// a heap-allocated task wrapping a function, optionally in a group
+struct function_task : pool_task
+{
+	std::function<void ()>  function;
+	task_group *            group;
 };
 
 
-struct osd_work_queue
+class task_pool
 {
-	osd_work_queue()
-	: list(nullptr)
-	, tailptr(nullptr)
-	, free(nullptr)
-	, items(0)
-	, livethreads(0)
-	, waiting(0)
-	, exiting(0)
-	, threads(0)
-	, flags(0)
-	, doneevent(true, true)     // manual reset, signalled
-#if KEEP_STATISTICS
-	, itemsqueued(0)
-	, setevents(0)
-	, extraitems(0)
-	, spinloops(0)
-#endif
-	{
-	}
+public:
+	task_pool();
+	~task_pool();
 
-	std::mutex          lock;           // lock for protecting the queue
-	std::atomic<osd_work_item *> list;  // list of items in the queue
-	osd_work_item ** volatile tailptr;  // pointer to the tail pointer of work items in the queue
-	std::atomic<osd_work_item *> free;  // free list of work items
-	std::atomic<int32_t>  items;          // items in the queue
-	std::atomic<int32_t>  livethreads;    // number of live threads
-	std::atomic<int32_t>  waiting;        // is someone waiting on the queue to complete?
-	std::atomic<int32_t>  exiting;        // should the threads exit on their next opportunity?
-	uint32_t              threads;        // number of threads in this queue
-	uint32_t              flags;          // creation flags
-	std::vector<work_thread_info *>  thread;         // array of thread information
-	osd_event           doneevent;      // event signalled when work is complete
+	static task_pool &instance();
+
+	// add a task; with no worker threads it runs before returning
+	void submit(pool_task &task, task_priority priority);
+
+	// run one pending task of at least the given priority on the calling thread
+	bool run_one(task_priority lowest);
+
+	int worker_count() const { return int(m_workers.size()); }
+	static int current_worker();
+
+	// executing function tasks
+	static void execute_function(pool_task &task);
+
+private:
+	struct worker
+	{
+		std::mutex                  lock;                           // protects the deques
+		std::deque<pool_task *>     tasks[WORKER_PRIORITIES];       // owner pushes and pops the back, thieves take the front
+		std::thread                 thread;
+		int                         index;
+	};
+
+	pool_task *find_task(worker *self, int lowest, int &priority);
+	bool any_queued() const;
+	void worker_main(worker &self);
+	void io_main();
+
+	std::vector<std::unique_ptr<worker> > m_workers;
+	std::mutex                  m_inject_lock;                      // protects tasks from threads outside the pool
+	std::deque<pool_task *>     m_inject[WORKER_PRIORITIES];
+	std::atomic<int>            m_queued[WORKER_PRIORITIES];        // queued tasks at each priority, never less than the real count
+	std::atomic<int>            m_sleeping;                         // workers waiting for m_wake
+	std::mutex                  m_sleep_lock;
+	std::condition_variable     m_wake;
+	std::atomic<bool>           m_exiting;
+
+	std::mutex                  m_io_lock;                          // protects the I/O lane
+	std::condition_variable     m_io_wake;
+	std::deque<pool_task *>     m_io_tasks;
+	std::vector<std::thread>    m_io_threads;                       // created as blocking work needs them
+	unsigned                    m_io_idle;
 
 #if KEEP_STATISTICS
-	std::atomic<int32_t>  itemsqueued;    // total items queued
-	std::atomic<int32_t>  setevents;      // number of times we called SetEvent
-	std::atomic<int32_t>  extraitems;     // how many extra items we got after the first in the queue loop
-	std::atomic<int32_t>  spinloops;      // how many times spinning bought us more items
+	std::atomic<int32_t>        m_tasksrun;                         // tasks executed
+	std::atomic<int32_t>        m_steals;                           // tasks taken from another worker's deque
+	std::atomic<int32_t>        m_sleeps;                           // times a worker went to sleep
 #endif
+
+	static thread_local worker *s_current;
 };
 
+thread_local task_pool::worker *task_pool::s_current = nullptr;
+
+
+// processors chosen for each thread role; an empty list means any processor
+std::mutex                  s_affinity_lock;
+std::vector<unsigned>       s_affinity[2];
+bool                        s_affinity_enabled = false;
+std::atomic<unsigned>       s_affinity_generation(0);                   // bumped whenever the choice changes
+
+} // namespace osd
+
 
 struct osd_work_item
 {
@@ -184,7 +218,6 @@ struct osd_work_item
 	, callback(nullptr)
 	, param(nullptr)
 	, result(nullptr)
-	, event(nullptr)                // manual reset, not signalled
 	, flags(0)
 	, done(false)
 	{
@@ -195,25 +228,56 @@ struct osd_work_item
 	osd_work_callback   callback;       // callback function
 	void *              param;          // callback parameter
 	void *              result;         // callback result
-	osd_event *         event;          // event signalled when complete
 	uint32_t              flags;          // creation flags
 	std::atomic<int32_t>  done;           // is the item done?
 };
 
-//============================================================
-//  GLOBAL VARIABLES
-//============================================================
 
-int osd_num_processors = 0;
+// the pool task that drains a queue; it can be pending on the pool several times at once
+struct queue_runner : osd::pool_task
+{
+	osd_work_queue *    queue;
+};
+
+
+struct osd_work_queue
+{
+	osd_work_queue(uint32_t aflags, uint32_t alimit)
+	: list(nullptr)
+	, tailptr(&list)
+	, free(nullptr)
+	, items(0)
+	, limit(alimit)
+	, runners(0)
+	, slots(0)
+	, waiters(0)
+	, flags(aflags)
+	, priority((aflags & WORK_QUEUE_FLAG_IO) ? osd::task_priority::IO : (aflags & WORK_QUEUE_FLAG_HIGH_FREQ) ? osd::task_priority::HIGH : osd::task_priority::NORMAL)
+	{
+	}
+
+	std::mutex          lock;           // lock for protecting the queue
+	std::condition_variable idle;       // notified as work finishes while someone is waiting
+	osd_work_item *     list;           // list of items in the queue
+	osd_work_item **    tailptr;        // pointer to the tail pointer of work items in the queue
+	osd_work_item *     free;           // free list of work items
+	std::atomic<int32_t>  items;          // items queued or running
+	uint32_t              limit;          // most pool threads working on this queue at once
+	uint32_t              runners;        // runner tasks pending or running on the pool
+	uint32_t              slots;          // thread IDs currently handed to callbacks
+	int32_t               waiters;        // threads waiting on idle
+	uint32_t              flags;          // creation flags
+	osd::task_priority    priority;       // priority of the runner tasks
+	queue_runner        runner;         // pool task that processes items
+};
 
 //============================================================
 //  FUNCTION PROTOTYPES
 //============================================================
 
-static int effective_num_processors(bool heavy_mt);
-static void * worker_thread_entry(void *param);
-static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread);
-static bool queue_has_list_items(osd_work_queue *queue);
+static void queue_runner_execute(osd::pool_task &task);
+static void queue_process(osd_work_queue &queue, std::unique_lock<std::mutex> &lock);
+static bool queue_wait_until(osd_work_queue &queue, std::unique_lock<std::mutex> &lock, osd_work_item *item, osd_ticks_t timeout);
 
 //============================================================
 //  osd_thread_adjust_priority
@@ -243,229 +307,794 @@ int thread_adjust_priority(std::thread *thread, int adjust)
 	return true;
 }
 
+
+namespace osd {
+
 //============================================================
-//  osd_work_queue_alloc
+//  task_pool::task_pool
 //============================================================
 
-osd_work_queue *osd_work_queue_alloc(int flags)
+task_pool::task_pool()
+	: m_sleeping(0)
+	, m_exiting(false)
+	, m_io_idle(0)
+#if KEEP_STATISTICS
+	, m_tasksrun(0)
+	, m_steals(0)
+	, m_sleeps(0)
+#endif
 {
-	int threadnum;
-	int numprocs = effective_num_processors(!(flags & WORK_QUEUE_FLAG_HIGH_FREQ));
-	osd_work_queue *queue;
-	int osdthreadnum = 0;
-	int allocthreadnum;
-	const char *osdworkqueuemaxthreads = osd_getenv(ENV_WORKQUEUEMAXTHREADS);
+	for (auto &queued : m_queued)
+		queued = 0;
 
-	// allocate a new queue
-	queue = new osd_work_queue();
+	// one worker per processor besides the one creating work; the calling thread helps when it waits
+	int workers = std::max(osd_get_num_processors(true), effective_num_processors(true)) - 1;
+#if defined(SDLMAME_EMSCRIPTEN)
+	// threads are not supported at all
+	workers = 0;
+#endif
+	workers = std::clamp(workers, 0, WORK_MAX_THREADS);
 
-	// initialize basic queue members
-	queue->tailptr = (osd_work_item **)&queue->list;
-	queue->flags = flags;
+	for (int index = 0; index < workers; index++)
+	{
+		m_workers.emplace_back(std::make_unique<worker>());
+		m_workers.back()->index = index;
+	}
+	for (auto &w : m_workers)
+	{
+		worker &self = *w;
+		self.thread = std::thread([this, &self] () { worker_main(self); });
+		thread_adjust_priority(&self.thread, 0);
+	}
+}
 
-	// determine how many threads to create...
-	// on a single-CPU system, create 1 thread for I/O queues, and 0 threads for everything else
-	if (numprocs == 1)
-		threadnum = (flags & WORK_QUEUE_FLAG_IO) ? 1 : 0;
-	// on an n-CPU system, create n-1 threads for multi queues, and 1 thread for everything else
-	else
-		threadnum = (flags & WORK_QUEUE_FLAG_MULTI) ? (numprocs - 1) : 1;
 
-	if (osdworkqueuemaxthreads != nullptr && sscanf(osdworkqueuemaxthreads, "%d", &osdthreadnum) == 1 && threadnum > osdthreadnum)
-		threadnum = osdthreadnum;
+//============================================================
+//  task_pool::~task_pool
+//============================================================
 
+task_pool::~task_pool()
+{
+	// wake everything up and wait for it to go away
+	{
+		std::lock_guard<std::mutex> lock(m_sleep_lock);
+		m_exiting = true;
+		m_wake.notify_all();
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_io_lock);
+		m_io_wake.notify_all();
+	}
+	for (auto &w : m_workers)
+		w->thread.join();
+	for (std::thread &thread : m_io_threads)
+		thread.join();
+
+#if KEEP_STATISTICS
+	printf("Pool workers   = %9d (+%d I/O)\n", int(m_workers.size()), int(m_io_threads.size()));
+	printf("Tasks run      = %9d\n", m_tasksrun.load());
+	printf("Steals         = %9d\n", m_steals.load());
+	printf("Sleeps         = %9d\n", m_sleeps.load());
+#endif
+}
+
+
+//============================================================
+//  task_pool::instance
+//============================================================
+
+task_pool &task_pool::instance()
+{
+	static task_pool pool;
+	return pool;
+}
+
+
+//============================================================
+//  task_pool::current_worker
+//============================================================
+
+int task_pool::current_worker()
+{
+	return s_current ? s_current->index : -1;
+}
+
+
+//============================================================
+//  task_pool::submit
+//============================================================
+
+void task_pool::submit(pool_task &task, task_priority priority)
+{
+	if (priority == task_priority::IO)
+	{
 #if defined(SDLMAME_EMSCRIPTEN)
-	// threads are not supported at all
-	threadnum = 0;
+		task.execute(task);
+#else
+		// blocking work gets a thread of its own rather than waiting behind other blocking work
+		std::lock_guard<std::mutex> lock(m_io_lock);
+		m_io_tasks.push_back(&task);
+		if ((m_io_tasks.size() > m_io_idle) && (m_io_threads.size() < unsigned(WORK_MAX_THREADS)))
+		{
+			m_io_threads.emplace_back([this] () { io_main(); });
+			thread_adjust_priority(&m_io_threads.back(), 1);
+		}
+		else
+		{
+			m_io_wake.notify_one();
+		}
 #endif
+		return;
+	}
 
-	// clamp to the maximum
-	queue->threads = std::min(threadnum, WORK_MAX_THREADS);
+	// with no workers, just do it now
+	if (m_workers.empty())
+	{
+		task.execute(task);
+		return;
+	}
 
-	// allocate memory for thread array (+1 to count the calling thread if WORK_QUEUE_FLAG_MULTI)
-	if (flags & WORK_QUEUE_FLAG_MULTI)
-		allocthreadnum = queue->threads + 1;
+	// count it first so nothing can take it before it's counted
+	int const index = int(priority);
+	m_queued[index]++;
+	if (s_current)
+	{
+		std::lock_guard<std::mutex> lock(s_current->lock);
+		s_current->tasks[index].push_back(&task);
+	}
 	else
-		allocthreadnum = queue->threads;
+	{
+		std::lock_guard<std::mutex> lock(m_inject_lock);
+		m_inject[index].push_back(&task);
+	}
 
-#if KEEP_STATISTICS
-	printf("osdprocs: %d effecprocs: %d threads: %d allocthreads: %d osdthreads: %d maxthreads: %d queuethreads: %d\n", osd_num_processors, numprocs, threadnum, allocthreadnum, osdthreadnum, WORK_MAX_THREADS, queue->threads);
-#endif
+	// a sleeping worker either sees the count or is waiting for this
+	if (m_sleeping)
+	{
+		std::lock_guard<std::mutex> lock(m_sleep_lock);
+		m_wake.notify_one();
+	}
+}
+
+
+//============================================================
+//  task_pool::run_one
+//============================================================
+
+bool task_pool::run_one(task_priority lowest)
+{
+	int priority;
+	pool_task *const task = find_task(s_current, std::min(int(lowest), WORKER_PRIORITIES - 1), priority);
+	if (!task)
+		return false;
+	add_to_stat(m_tasksrun, 1);
+	task->execute(*task);
+	return true;
+}
 
-	for (threadnum = 0; threadnum < allocthreadnum; threadnum++)
-		queue->thread.push_back(new work_thread_info(threadnum, *queue));
 
-	// iterate over threads
-	for (threadnum = 0; threadnum < queue->threads; threadnum++)
+//============================================================
+//  task_pool::find_task
+//============================================================
+
+pool_task *task_pool::find_task(worker *self, int lowest, int &priority)
+{
+	for (priority = 0; priority <= lowest; priority++)
 	{
-		work_thread_info *thread = queue->thread[threadnum];
+		if (!m_queued[priority])
+			continue;
 
-		// create the thread
-		thread->handle = new std::thread(worker_thread_entry, thread);
-		if (thread->handle == nullptr)
-			goto error;
+		pool_task *task = nullptr;
 
-		// set its priority: I/O threads get high priority because they are assumed to be
-		// blocked most of the time; other threads just match the creator's priority
-		if (flags & WORK_QUEUE_FLAG_IO)
-			thread_adjust_priority(thread->handle, 1);
-		else
-			thread_adjust_priority(thread->handle, 0);
+		// newest work of our own first, since its data is most likely to still be cached
+		if (self)
+		{
+			std::lock_guard<std::mutex> lock(self->lock);
+			std::deque<pool_task *> &tasks(self->tasks[priority]);
+			if (!tasks.empty())
+			{
+				task = tasks.back();
+				tasks.pop_back();
+			}
+		}
+
+		// then work from outside the pool, oldest first
+		if (!task)
+		{
+			std::lock_guard<std::mutex> lock(m_inject_lock);
+			std::deque<pool_task *> &tasks(m_inject[priority]);
+			if (!tasks.empty())
+			{
+				task = tasks.front();
+				tasks.pop_front();
+			}
+		}
+
+		// then steal the oldest work from other workers, starting after ourselves
+		if (!task)
+		{
+			int const count = int(m_workers.size());
+			int const start = self ? (self->index + 1) : 0;
+			for (int i = 0; !task && (i < count); i++)
+			{
+				worker &victim = *m_workers[(start + i) % count];
+				if (&victim == self)
+					continue;
+				std::lock_guard<std::mutex> lock(victim.lock);
+				std::deque<pool_task *> &tasks(victim.tasks[priority]);
+				if (!tasks.empty())
+				{
+					task = tasks.front();
+					tasks.pop_front();
+					add_to_stat(m_steals, 1);
+				}
+			}
+		}
+
+		if (task)
+		{
+			m_queued[priority]--;
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+
+//============================================================
+//  task_pool::any_queued
+//============================================================
+
+bool task_pool::any_queued() const
+{
+	for (auto const &queued : m_queued)
+		if (queued)
+			return true;
+	return false;
+}
+
+
+//============================================================
+//  task_pool::worker_main
+//============================================================
+
+void task_pool::worker_main(worker &self)
+{
+	s_current = &self;
+	bool spin = false;
+	unsigned affinity = 0;
+	while (true)
+	{
+		if (affinity != s_affinity_generation)
+		{
+			affinity = s_affinity_generation;
+			thread_affinity_apply(thread_role::WORKER);
+		}
+
+		int priority;
+		pool_task *const task = find_task(&self, WORKER_PRIORITIES - 1, priority);
+		if (task)
+		{
+			add_to_stat(m_tasksrun, 1);
+			task->execute(*task);
+
+			// latency sensitive work tends to come in bursts, so look for more before sleeping
+			spin = (priority == int(task_priority::HIGH));
+			continue;
+		}
+
+		if (m_exiting)
+			break;
+
+		if (spin)
+		{
+			osd_ticks_t const stopspin = osd_ticks() + SPIN_LOOP_TIME;
+			while (!any_queued() && (osd_ticks() < stopspin) && !m_exiting)
+				std::this_thread::yield();
+			spin = false;
+			continue;
+		}
+
+		// sleep until something is queued
+		std::unique_lock<std::mutex> lock(m_sleep_lock);
+		m_sleeping++;
+		add_to_stat(m_sleeps, 1);
+		while (!m_exiting && !any_queued())
+			m_wake.wait(lock);
+		m_sleeping--;
 	}
+	s_current = nullptr;
+}
+
 
-	// start a timer going for "waittime" on the main thread
-	if (flags & WORK_QUEUE_FLAG_MULTI)
+//============================================================
+//  task_pool::io_main
+//============================================================
+
+void task_pool::io_main()
+{
+	unsigned affinity = 0;
+	std::unique_lock<std::mutex> lock(m_io_lock);
+	while (true)
 	{
-		begin_timing(queue->thread[queue->threads]->waittime);
+		if (affinity != s_affinity_generation)
+		{
+			affinity = s_affinity_generation;
+			lock.unlock();
+			thread_affinity_apply(thread_role::WORKER);
+			lock.lock();
+		}
+
+		while (m_io_tasks.empty() && !m_exiting)
+		{
+			m_io_idle++;
+			m_io_wake.wait(lock);
+			m_io_idle--;
+		}
+		if (m_io_tasks.empty())
+			break;
+
+		pool_task *const task = m_io_tasks.front();
+		m_io_tasks.pop_front();
+		lock.unlock();
+		add_to_stat(m_tasksrun, 1);
+		task->execute(*task);
+		lock.lock();
 	}
-	return queue;
+}
 
-error:
-	osd_work_queue_free(queue);
-	return nullptr;
+
+//============================================================
+//  task_pool::execute_function
+//============================================================
+
+void task_pool::execute_function(pool_task &task)
+{
+	function_task *const ftask = static_cast<function_task *>(&task);
+	ftask->function();
+	task_group *const group = ftask->group;
+	delete ftask;
+	if (group)
+		group->task_done();
 }
 
 
 //============================================================
-//  osd_work_queue_items
+//  task_group::task_group
 //============================================================
 
-int osd_work_queue_items(osd_work_queue *queue)
+task_group::task_group(task_priority priority)
+	: m_priority(priority)
+	, m_pending(0)
 {
-	// return the number of items currently in the queue
-	return queue->items;
 }
 
 
 //============================================================
-//  osd_work_queue_wait
+//  task_group::~task_group
 //============================================================
 
-bool osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
+task_group::~task_group()
 {
-	// if no threads, no waiting
-	if (queue->threads == 0)
-		return true;
+	wait();
+}
 
-	// if no items, we're done
-	if (queue->items == 0)
-		return true;
 
-	// if this is a multi queue, help out rather than doing nothing
-	if (queue->flags & WORK_QUEUE_FLAG_MULTI)
+//============================================================
+//  task_group::run
+//============================================================
+
+void task_group::run(std::function<void ()> &&task)
+{
 	{
-		work_thread_info *thread = queue->thread[queue->threads];
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_pending++;
+	}
+	submit(std::move(task));
+}
 
-		end_timing(thread->waittime);
 
-		// process what we can as a worker thread
-		worker_thread_process(queue, thread);
+//============================================================
+//  task_group::then
+//============================================================
 
-		// if we're a high frequency queue, spin until done
-		if (queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue->items != 0)
+void task_group::then(std::function<void ()> &&continuation)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_pending++;
+		if (m_pending > int(m_continuations.size() + 1))
 		{
-			// spin until we're done
-			begin_timing(thread->spintime);
-			spin_while_not<std::atomic<int>,int>(&queue->items, 0, timeout);
-			end_timing(thread->spintime);
+			m_continuations.emplace_back(std::move(continuation));
+			return;
+		}
+	}
+	submit(std::move(continuation));
+}
 
-			begin_timing(thread->waittime);
-			return (queue->items == 0);
+
+//============================================================
+//  task_group::wait
+//============================================================
+
+bool task_group::wait(osd_ticks_t timeout)
+{
+	task_pool &pool(task_pool::instance());
+	bool const infinite(timeout == OSD_EVENT_WAIT_INFINITE);
+	osd_ticks_t const stop(infinite ? 0 : (osd_ticks() + timeout));
+
+	// blocking work can't be helped with, but a worker still has to keep the pool moving
+	task_priority const help((m_priority == task_priority::IO) ? task_priority::NORMAL : m_priority);
+
+	std::unique_lock<std::mutex> lock(m_lock);
+	while (m_pending)
+	{
+		lock.unlock();
+		bool const ran(pool.run_one(help));
+		lock.lock();
+		if (ran)
+			continue;
+		if (!infinite && (osd_ticks() >= stop))
+			break;
+		m_idle.wait_for(lock, HELP_POLL_TIME);
+	}
+	return !m_pending;
+}
+
+
+//============================================================
+//  task_group::pending
+//============================================================
+
+int task_group::pending() const
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return m_pending;
+}
+
+
+//============================================================
+//  task_group::submit
+//============================================================
+
+void task_group::submit(std::function<void ()> &&task)
+{
+	function_task *const ftask = new function_task;
+	ftask->execute = &task_pool::execute_function;
+	ftask->function = std::move(task);
+	ftask->group = this;
+	task_pool::instance().submit(*ftask, m_priority);
+}
+
+
+//============================================================
+//  task_group::task_done
+//============================================================
+
+void task_group::task_done()
+{
+	std::vector<std::function<void ()> > continuations;
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_pending--;
+
+		// once only continuations are left, start them
+		if (!m_continuations.empty() && (m_pending == int(m_continuations.size())))
+			continuations.swap(m_continuations);
+		else if (!m_pending)
+			m_idle.notify_all();
+	}
+	for (std::function<void ()> &continuation : continuations)
+		submit(std::move(continuation));
+}
+
+
+//============================================================
+//  task_run
+//============================================================
+
+void task_run(std::function<void ()> &&task, task_priority priority)
+{
+	function_task *const ftask = new function_task;
+	ftask->execute = &task_pool::execute_function;
+	ftask->function = std::move(task);
+	ftask->group = nullptr;
+	task_pool::instance().submit(*ftask, priority);
+}
+
+
+//============================================================
+//  task_worker_count
+//============================================================
+
+int task_worker_count()
+{
+	return task_pool::instance().worker_count();
+}
+
+
+//============================================================
+//  task_current_worker
+//============================================================
+
+int task_current_worker()
+{
+	return task_pool::current_worker();
+}
+
+
+//============================================================
+//  parse_processor_list - read a list such as
+//  "0,2-3"; returns false if it's malformed
+//============================================================
+
+static bool parse_processor_list(std::string_view text, std::vector<unsigned> &result)
+{
+	result.clear();
+	std::string const list(text);
+	char const *start = list.c_str();
+	while (*start)
+	{
+		char *end;
+		unsigned long const first = std::strtoul(start, &end, 10);
+		unsigned long last = first;
+		if (end == start)
+			return false;
+		if (*end == '-')
+		{
+			start = end + 1;
+			last = std::strtoul(start, &end, 10);
+			if (end == start)
+				return false;
 		}
-		begin_timing(thread->waittime);
+		if ((last < first) || (last >= 1024) || (*end && (*end != ',')))
+			return false;
+		for (unsigned long id = first; id <= last; id++)
+			result.emplace_back(unsigned(id));
+		start = *end ? (end + 1) : end;
 	}
+	std::sort(result.begin(), result.end());
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+	return !result.empty();
+}
+
+
+//============================================================
+//  format_processor_list
+//============================================================
 
-	// reset our done event and double-check the items before waiting
-	queue->doneevent.reset();
-	queue->waiting = true;
-	if (queue->items != 0)
-		queue->doneevent.wait(timeout);
-	queue->waiting = false;
+static std::string format_processor_list(std::vector<unsigned> const &list)
+{
+	if (list.empty())
+		return "any processor";
 
-	// return true if we actually hit 0
-	return (queue->items == 0);
+	std::string result;
+	for (std::size_t i = 0; i < list.size(); )
+	{
+		std::size_t last = i;
+		while (((last + 1) < list.size()) && (list[last + 1] == (list[last] + 1)))
+			last++;
+		if (!result.empty())
+			result += ',';
+		result += std::to_string(list[i]);
+		if (last != i)
+			result += '-' + std::to_string(list[last]);
+		i = last + 1;
+	}
+	return result;
 }
 
 
 //============================================================
-//  osd_work_queue_free
+//  thread_affinity_configure
 //============================================================
 
-void osd_work_queue_free(osd_work_queue *queue)
+void thread_affinity_configure(std::string_view mode, std::string_view emulation, std::string_view workers)
 {
-	// stop the timer for "waittime" on the main thread
-	if (queue->flags & WORK_QUEUE_FLAG_MULTI)
+	std::string_view const names[2] = { "emulation", "worker" };
+	std::string_view const lists[2] = { emulation, workers };
+	std::vector<unsigned> chosen[2];
+	bool given[2] = { false, false };
+	for (int role = 0; role < 2; role++)
 	{
-		end_timing(queue->thread[queue->threads]->waittime);
+		if (lists[role] != "auto")
+		{
+			given[role] = parse_processor_list(lists[role], chosen[role]);
+			if (!given[role])
+				osd_printf_warning("Invalid %s processor list '%s', choosing automatically\n", names[role], lists[role]);
+		}
 	}
 
-	// signal all the threads to exit
-	queue->exiting = true;
-	for (int threadnum = 0; threadnum < queue->threads; threadnum++)
+	if ((mode != "auto") && (mode != "on") && (mode != "off"))
 	{
-		work_thread_info *thread = queue->thread[threadnum];
-		thread->wakeevent.set();
+		osd_printf_warning("Invalid thread affinity mode '%s', assuming auto\n", mode);
+		mode = "auto";
 	}
 
-	// wait for all the threads to go away
-	for (int threadnum = 0; threadnum < queue->threads; threadnum++)
+	// this is also where the processors available to the process are noted, before any thread is restricted
+	std::vector<processor_info> const processors(get_processors());
+	unsigned top = 0;
+	bool hybrid = false;
+	for (processor_info const &info : processors)
 	{
-		work_thread_info *thread = queue->thread[threadnum];
+		top = std::max(top, info.performance_class);
+		hybrid = hybrid || (info.performance_class != processors.front().performance_class);
+	}
 
-		// block on the thread going away, then close the handle
-		if (thread->handle != nullptr)
+	// by default it's only worth it when the processors aren't all the same
+	if ((!given[0] || !given[1]) && ((mode == "on") || ((mode == "auto") && hybrid)))
+	{
+		// take the last of the fastest cores, as the first one tends to get the most interrupts
+		auto const fastest = std::find_if(
+				processors.rbegin(),
+				processors.rend(),
+				[top] (processor_info const &info) { return info.performance_class == top; });
+		std::vector<unsigned> automatic_lists[2];
+		if (fastest != processors.rend())
 		{
-			thread->handle->join();
-			delete thread->handle;
+			for (processor_info const &info : processors)
+				automatic_lists[(info.core == fastest->core) ? 0 : 1].emplace_back(info.id);
 		}
 
+		// with nothing left over for the other threads, don't restrict anything
+		if (!automatic_lists[1].empty())
+		{
+			for (int role = 0; role < 2; role++)
+			{
+				if (!given[role])
+					chosen[role] = std::move(automatic_lists[role]);
+			}
+		}
 	}
 
-#if KEEP_STATISTICS
-	// output per-thread statistics
-	for (work_thread_info *thread : queue->thread)
-	{
-		osd_ticks_t total = thread->runtime + thread->waittime + thread->spintime;
-		printf("Thread %d:  items=%9d run=%5.2f%% (%5.2f%%)  spin=%5.2f%%  wait/other=%5.2f%% total=%9d\n",
-				thread->id, thread->itemsdone,
-				(double)thread->runtime * 100.0 / (double)total,
-				(double)thread->actruntime * 100.0 / (double)total,
-				(double)thread->spintime * 100.0 / (double)total,
-				(double)thread->waittime * 100.0 / (double)total,
-				(uint32_t) total);
+	{
+		// once anything has been restricted, threads need to be released again too
+		std::lock_guard<std::mutex> lock(s_affinity_lock);
+		s_affinity_enabled = s_affinity_enabled || !chosen[0].empty() || !chosen[1].empty();
+		for (int role = 0; role < 2; role++)
+			s_affinity[role] = std::move(chosen[role]);
+		if (!s_affinity[0].empty() || !s_affinity[1].empty())
+		{
+			osd_printf_verbose("Thread affinity: emulation on %s, other threads on %s\n",
+					format_processor_list(s_affinity[0]),
+					format_processor_list(s_affinity[1]));
+		}
 	}
+	s_affinity_generation++;
+}
+
+
+//============================================================
+//  thread_affinity_apply
+//============================================================
+
+void thread_affinity_apply(thread_role role)
+{
+	std::vector<unsigned> processors;
+	{
+		std::lock_guard<std::mutex> lock(s_affinity_lock);
+		if (!s_affinity_enabled)
+			return;
+		processors = s_affinity[int(role)];
+	}
+	if (!set_thread_affinity(processors))
+		osd_printf_verbose("Thread affinity: couldn't restrict thread to %s\n", format_processor_list(processors));
+}
+
+} // namespace osd
+
+
+//============================================================
+//  osd_work_queue_alloc
+//============================================================
+
+osd_work_queue *osd_work_queue_alloc(int flags)
+{
+	int threadnum;
+	int numprocs = effective_num_processors(!(flags & WORK_QUEUE_FLAG_HIGH_FREQ));
+	int osdthreadnum = 0;
+	const char *osdworkqueuemaxthreads = osd_getenv(ENV_WORKQUEUEMAXTHREADS);
+
+	// determine how many threads can work on the queue at once...
+	// on a single-CPU system, use 1 thread for I/O queues, and 0 threads for everything else
+	if (numprocs == 1)
+		threadnum = (flags & WORK_QUEUE_FLAG_IO) ? 1 : 0;
+	// on an n-CPU system, use n-1 threads for multi queues, and 1 thread for everything else
+	else
+		threadnum = (flags & WORK_QUEUE_FLAG_MULTI) ? (numprocs - 1) : 1;
+
+	if (osdworkqueuemaxthreads != nullptr && sscanf(osdworkqueuemaxthreads, "%d", &osdthreadnum) == 1 && threadnum > osdthreadnum)
+		threadnum = osdthreadnum;
+
+#if defined(SDLMAME_EMSCRIPTEN)
+	// threads are not supported at all
+	threadnum = 0;
 #endif
 
-	// free the list
-	for (auto & th : queue->thread)
-		delete th;
-	queue->thread.clear();
+	// clamp to the maximum, leaving a thread ID for the caller to help with multi queues
+	threadnum = std::min(threadnum, (flags & WORK_QUEUE_FLAG_MULTI) ? (WORK_MAX_THREADS - 1) : WORK_MAX_THREADS);
+
+	// the queue's threads come from the shared pool, started with the first queue
+	osd::task_pool::instance();
+	osd_work_queue *const queue = new osd_work_queue(flags, std::max(threadnum, 0));
+	queue->runner.execute = &queue_runner_execute;
+	queue->runner.queue = queue;
+	return queue;
+}
+
+
+//============================================================
+//  osd_work_queue_items
+//============================================================
+
+int osd_work_queue_items(osd_work_queue *queue)
+{
+	// return the number of items currently in the queue
+	return queue->items;
+}
+
+
+//============================================================
+//  osd_work_queue_wait
+//============================================================
+
+bool osd_work_queue_wait(osd_work_queue *queue, osd_ticks_t timeout)
+{
+	// if no threads or no items, we're done
+	if ((queue->limit == 0) || (queue->items == 0))
+		return true;
+
+	std::unique_lock<std::mutex> lock(queue->lock);
+
+	// if this is a multi queue, help out rather than doing nothing
+	if (queue->flags & WORK_QUEUE_FLAG_MULTI)
+	{
+		queue_process(*queue, lock);
+
+		// if we're a high frequency queue, spin until done
+		if ((queue->flags & WORK_QUEUE_FLAG_HIGH_FREQ) && (queue->items != 0))
+		{
+			lock.unlock();
+			spin_while_not<std::atomic<int>,int>(&queue->items, 0, timeout);
+			return (queue->items == 0);
+		}
+	}
+
+	return queue_wait_until(*queue, lock, nullptr, timeout);
+}
+
+
+//============================================================
+//  osd_work_queue_free
+//============================================================
+
+void osd_work_queue_free(osd_work_queue *queue)
+{
+	// wait for queued items and any runners still on the pool
+	{
+		std::unique_lock<std::mutex> lock(queue->lock);
+		queue->waiters++;
+		while (queue->items || queue->runners)
+			queue->idle.wait(lock);
+		queue->waiters--;
+	}
 
 	// free all items in the free list
-	while (queue->free.load() != nullptr)
+	while (queue->free != nullptr)
 	{
-		auto *item = (osd_work_item *)queue->free;
+		osd_work_item *item = queue->free;
 		queue->free = item->next;
-		delete item->event;
 		delete item;
 	}
 
 	// free all items in the active list
-	while (queue->list.load() != nullptr)
+	while (queue->list != nullptr)
 	{
-		auto *item = (osd_work_item *)queue->list;
+		osd_work_item *item = queue->list;
 		queue->list = item->next;
-		delete item->event;
 		delete item;
 	}
 
-#if KEEP_STATISTICS
-	printf("Items queued   = %9d\n", queue->itemsqueued.load());
-	printf("SetEvent calls = %9d\n", queue->setevents.load());
-	printf("Extra items    = %9d\n", queue->extraitems.load());
-	printf("Spin loops     = %9d\n", queue->spinloops.load());
-#endif
-
 	// free the queue itself
 	delete queue;
 }
@@ -482,30 +1111,19 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 	int itemnum;
 
 	// loop over items, building up a local list of work
+	std::unique_lock<std::mutex> lock(queue->lock);
 	for (itemnum = 0; itemnum < numitems; itemnum++)
 	{
-		osd_work_item *item;
-
 		// first allocate a new work item; try the free list first
+		osd_work_item *item = queue->free;
+		if (item != nullptr)
 		{
-			std::lock_guard<std::mutex> lock(queue->lock);
-			do
-			{
-				item = (osd_work_item *)queue->free;
-			} while (item != nullptr && !queue->free.compare_exchange_weak(item, item->next, std::memory_order_release, std::memory_order_relaxed));
-		}
-
-		// if nothing, allocate something new
-		if (item == nullptr)
-		{
-			// allocate the item
-			item = new osd_work_item(*queue);
-			if (item == nullptr)
-				return nullptr;
+			queue->free = item->next;
+			item->done = false;
 		}
 		else
 		{
-			item->done = false; // needs to be set this way to prevent data race/usage of uninitialized memory on Linux
+			item = new osd_work_item(*queue);
 		}
 
 		// fill in the basics
@@ -522,46 +1140,27 @@ osd_work_item *osd_work_item_queue_multiple(osd_work_queue *queue, osd_work_call
 		parambase = (uint8_t *)parambase + paramstep;
 	}
 
-	// enqueue the whole thing within the critical section
-	{
-		std::lock_guard<std::mutex> lock(queue->lock);
-		*queue->tailptr = itemlist;
-		queue->tailptr = item_tailptr;
-	}
-
-	// increment the number of items in the queue
+	// enqueue the whole thing
+	*queue->tailptr = itemlist;
+	queue->tailptr = item_tailptr;
 	queue->items += numitems;
-	add_to_stat(queue->itemsqueued, numitems);
 
-	// look for free threads to do the work
-	if (queue->livethreads < queue->threads)
+	// if no threads, run the queue now on this thread
+	if (queue->limit == 0)
 	{
-		int threadnum;
-
-		// iterate over all the threads
-		for (threadnum = 0; threadnum < queue->threads; threadnum++)
-		{
-			work_thread_info *thread = queue->thread[threadnum];
-
-			// Attempt to wake the thread
-			if (thread->wakeevent.set())
-			{
-				add_to_stat(queue->setevents, 1);
-
-				// for non-shared, the first one we find is good enough
-				if (--numitems == 0)
-					break;
-			}
-		}
+		queue_process(*queue, lock);
 	}
-
-	// if no threads, run the queue now on this thread
-	if (queue->threads == 0)
+	else
 	{
-		end_timing(queue->thread[0]->waittime);
-		worker_thread_process(queue, queue->thread[0]);
-		begin_timing(queue->thread[0]->waittime);
+		// get enough runners onto the pool to cover the new items
+		uint32_t const wanted = std::min<uint32_t>(numitems, queue->limit - queue->runners);
+		queue->runners += wanted;
+		lock.unlock();
+		osd::task_pool &pool(osd::task_pool::instance());
+		for (uint32_t runner = 0; runner < wanted; runner++)
+			pool.submit(queue->runner, queue->priority);
 	}
+
 	// only return the item if it won't get released automatically
 	return (flags & WORK_ITEM_FLAG_AUTO_RELEASE) ? nullptr : lastitem;
 }
@@ -577,28 +1176,14 @@ bool osd_work_item_wait(osd_work_item *item, osd_ticks_t timeout)
 	if (item->done)
 		return true;
 
-	// if we don't have an event, create one
-	if (item->event == nullptr)
-	{
-		std::lock_guard<std::mutex> lock(item->queue.lock);
-		item->event = new osd_event(true, false);     // manual reset, not signalled
-	}
-	else
-		item->event->reset();
-
-	// if we don't have an event, we need to spin (shouldn't ever really happen)
-	if (item->event == nullptr)
-	{
-		// TODO: do we need to measure the spin time here as well? and how can we do it?
-		spin_while<std::atomic<int>,int>(&item->done, 0, timeout);
-	}
+	osd_work_queue &queue(item->queue);
+	std::unique_lock<std::mutex> lock(queue.lock);
 
-	// otherwise, block on the event until done
-	else if (!item->done)
-		item->event->wait(timeout);
+	// a multi queue can be helped along from here
+	if ((queue.flags & WORK_QUEUE_FLAG_MULTI) && queue.limit)
+		queue_process(queue, lock);
 
-	// return true if the refcount actually hit 0
-	return item->done;
+	return queue_wait_until(queue, lock, item, timeout);
 }
 
 
@@ -618,18 +1203,13 @@ void *osd_work_item_result(osd_work_item *item)
 
 void osd_work_item_release(osd_work_item *item)
 {
-	osd_work_item *next;
-
 	// make sure we're done first
 	osd_work_item_wait(item, 100 * osd_ticks_per_second());
 
 	// add us to the free list on our queue
 	std::lock_guard<std::mutex> lock(item->queue.lock);
-	do
-	{
-		next = (osd_work_item *) item->queue.free;
-		item->next = next;
-	} while (!item->queue.free.compare_exchange_weak(next, item, std::memory_order_release, std::memory_order_relaxed));
+	item->next = item->queue.free;
+	item->queue.free = item;
 }
 
 
@@ -663,154 +1243,104 @@ static int effective_num_processors(bool heavy_mt)
 
 
 //============================================================
-//  worker_thread_entry
+//  queue_runner_execute
 //============================================================
 
-static void *worker_thread_entry(void *param)
+static void queue_runner_execute(osd::pool_task &task)
 {
-	auto *thread = (work_thread_info *)param;
-	osd_work_queue &queue = thread->queue;
-
-	// loop until we exit
-	for ( ;; )
-	{
-		// block waiting for work or exit
-		// bail on exit, and only wait if there are no pending items in queue
-		if (queue.exiting)
-			break;
+	osd_work_queue &queue(*static_cast<queue_runner &>(task).queue);
 
-		if (!queue_has_list_items(&queue))
-		{
-			begin_timing(thread->waittime);
-			thread->wakeevent.wait( OSD_EVENT_WAIT_INFINITE);
-			end_timing(thread->waittime);
-		}
+	std::unique_lock<std::mutex> lock(queue.lock);
+	queue_process(queue, lock);
 
-		if (queue.exiting)
-			break;
+	// the queue may be freed as soon as the lock is released
+	queue.runners--;
+	if (queue.waiters)
+		queue.idle.notify_all();
+}
 
-		// indicate that we are live
-		++queue.livethreads;
 
-		// process work items
-		for ( ;; )
-		{
-			// process as much as we can
-			worker_thread_process(&queue, thread);
+//============================================================
+//  queue_process - run items until the queue is
+//  empty; called and returns with the lock held
+//============================================================
 
-			// if we're a high frequency queue, spin for a while before giving up
-			if (queue.flags & WORK_QUEUE_FLAG_HIGH_FREQ && queue.list.load() == nullptr)
-			{
-				// spin for a while looking for more work
-				begin_timing(thread->spintime);
-				spin_while<std::atomic<osd_work_item *>, osd_work_item *>(&queue.list, (osd_work_item *)nullptr, SPIN_LOOP_TIME);
-				end_timing(thread->spintime);
-			}
+static void queue_process(osd_work_queue &queue, std::unique_lock<std::mutex> &lock)
+{
+	// callbacks get the lowest thread ID not in use on this queue
+	int threadid = 0;
+	while (queue.slots & (1U << threadid))
+		threadid++;
+	queue.slots |= 1U << threadid;
 
-			// if nothing more, release the processor
-			if (!queue_has_list_items(&queue))
-				break;
-			add_to_stat(queue.spinloops, 1);
+	while (queue.list != nullptr)
+	{
+		// pull the item from the queue
+		osd_work_item *const item = queue.list;
+		queue.list = item->next;
+		if (queue.list == nullptr)
+			queue.tailptr = &queue.list;
+
+		// call the callback and stash the result
+		lock.unlock();
+		item->result = (*item->callback)(item->param, threadid);
+		lock.lock();
+
+		// decrement the item count after we are done
+		--queue.items;
+		item->done = true;
+
+		// if it's an auto-release item, release it
+		if (item->flags & WORK_ITEM_FLAG_AUTO_RELEASE)
+		{
+			item->next = queue.free;
+			queue.free = item;
 		}
 
-		// decrement the live thread count
-		thread->wakeevent.reset();
-		--queue.livethreads;
+		if (queue.waiters)
+			queue.idle.notify_all();
 	}
 
-	return nullptr;
+	queue.slots &= ~(1U << threadid);
 }
 
 
 //============================================================
-//  worker_thread_process
+//  queue_wait_until - wait for an item or the
+//  whole queue to finish; called with the lock
+//  held
 //============================================================
 
-static void worker_thread_process(osd_work_queue *queue, work_thread_info *thread)
+static bool queue_wait_until(osd_work_queue &queue, std::unique_lock<std::mutex> &lock, osd_work_item *item, osd_ticks_t timeout)
 {
-	int threadid = thread->id;
+	bool const infinite(timeout == OSD_EVENT_WAIT_INFINITE);
+	osd_ticks_t const stop(infinite ? 0 : (osd_ticks() + timeout));
+	bool const worker(osd::task_pool::current_worker() >= 0);
+	auto const finished = [&queue, item] () { return item ? bool(item->done) : (queue.items == 0); };
 
-	begin_timing(thread->runtime);
-
-	// loop until everything is processed
-	while (true)
+	queue.waiters++;
+	while (!finished())
 	{
-		osd_work_item *item = nullptr;
-
-		bool end_loop = false;
-
-		// use a critical section to synchronize the removal of items
+		// a pool worker that blocks could be holding up the work it's waiting for, so it helps instead
+		if (worker)
 		{
-			std::lock_guard<std::mutex> lock(queue->lock);
-
-			if (queue->list.load() == nullptr)
-			{
-				end_loop = true;
-			}
-			else
-			{
-				// pull the item from the queue
-				item = (osd_work_item *)queue->list;
-				if (item != nullptr)
-				{
-					queue->list = item->next;
-					if (queue->list.load() == nullptr)
-						queue->tailptr = (osd_work_item **)&queue->list;
-				}
-			}
+			lock.unlock();
+			bool const ran(osd::task_pool::instance().run_one(osd::task_priority::NORMAL));
+			lock.lock();
+			if (ran)
+				continue;
 		}
 
-		if (end_loop)
+		osd_ticks_t const now(osd_ticks());
+		if (!infinite && (now >= stop))
 			break;
-
-		// process non-NULL items
-		if (item != nullptr)
-		{
-			// call the callback and stash the result
-			begin_timing(thread->actruntime);
-			item->result = (*item->callback)(item->param, threadid);
-			end_timing(thread->actruntime);
-
-			// decrement the item count after we are done
-			--queue->items;
-			item->done = true;
-			add_to_stat(thread->itemsdone, 1);
-
-			// if it's an auto-release item, release it
-			if (item->flags & WORK_ITEM_FLAG_AUTO_RELEASE)
-				osd_work_item_release(item);
-
-			// set the result and signal the event
-			else
-			{
-				std::lock_guard<std::mutex> lock(queue->lock);
-
-				if (item->event != nullptr)
-				{
-					item->event->set();
-					add_to_stat(item->queue.setevents, 1);
-				}
-			}
-
-			// if we removed an item and there's still work to do, bump the stats
-			if (queue_has_list_items(queue))
-				add_to_stat(queue->extraitems, 1);
-		}
-	}
-
-	// we don't need to set the doneevent for multi queues because they spin
-	if (queue->waiting)
-	{
-		queue->doneevent.set();
-		add_to_stat(queue->setevents, 1);
+		if (worker)
+			queue.idle.wait_for(lock, HELP_POLL_TIME);
+		else if (infinite)
+			queue.idle.wait(lock);
+		else
+			queue.idle.wait_for(lock, std::chrono::microseconds((stop - now) * 1000000 / osd_ticks_per_second()));
 	}
-
-	end_timing(thread->runtime);
-}
-
-bool queue_has_list_items(osd_work_queue *queue)
-{
-	std::lock_guard<std::mutex> lock(queue->lock);
-	bool has_list_items = (queue->list.load() != nullptr);
-	return has_list_items;
+	queue.waiters--;
+	return finished();
 }
@@ -14,6 +14,9 @@
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
+#include <functional>
+#include <string_view>
+#include <vector>
 
 #include "osdcore.h"
 
@@ -166,4 +169,113 @@ private:
 
 };
 
+
+/***************************************************************************
+    TASK INTERFACES
+***************************************************************************/
+
+/*
+    All threaded work in the process runs on one shared pool: a worker
+    thread per processor, each with its own deques that idle workers steal
+    from, plus a lane of threads for work that blocks on I/O.  The
+    osd_work_queue functions are built on it, and new code can use task
+    groups directly.
+*/
+
+namespace osd {
+
+class task_pool;
+
+/* task priorities; higher priority tasks are always picked first */
+enum class task_priority
+{
+	HIGH,       // latency sensitive work the caller is about to wait for
+	NORMAL,     // general background work
+	LOW,        // work that can wait until nothing else is pending
+	IO          // work that blocks on I/O; runs on the I/O threads
+};
+
+
+/*-----------------------------------------------------------------------------
+    task_group: a set of tasks that can be waited for together
+
+    Tasks added with run() may run on any worker, in any order, and may add
+    further tasks to their own group.  Continuations added with then() run
+    once every task added before them has finished.  Waiting helps by
+    running pending tasks on the calling thread.  The destructor waits for
+    everything in the group to finish.
+-----------------------------------------------------------------------------*/
+class task_group
+{
+public:
+	task_group(task_priority priority = task_priority::NORMAL);
+	~task_group();
+
+	task_group(task_group const &) = delete;
+	task_group &operator=(task_group const &) = delete;
+
+	// add a task to the group
+	void run(std::function<void ()> &&task);
+
+	// add a task to run after everything currently in the group is done
+	void then(std::function<void ()> &&continuation);
+
+	// wait for the group to finish; returns false on timeout
+	bool wait(osd_ticks_t timeout = OSD_EVENT_WAIT_INFINITE);
+
+	// number of tasks not yet finished, including continuations
+	int pending() const;
+
+private:
+	friend class task_pool;
+
+	void submit(std::function<void ()> &&task);
+	void task_done();
+
+	task_priority const                 m_priority;
+	mutable std::mutex                  m_lock;
+	std::condition_variable             m_idle;
+	int                                 m_pending;
+	std::vector<std::function<void ()> > m_continuations;
+};
+
+
+/* run a task on the pool without waiting for it */
+void task_run(std::function<void ()> &&task, task_priority priority = task_priority::NORMAL);
+
+/* number of worker threads in the pool, not counting the I/O threads */
+int task_worker_count();
+
+/* index of the pool worker running the calling thread, or -1 */
+int task_current_worker();
+
+
+/*-----------------------------------------------------------------------------
+    Thread affinity
+
+    The emulation thread can be kept apart from everything else: pool
+    workers, I/O threads and sound threads.  Automatically this is only
+    done on hybrid CPUs, where the emulation thread gets one of the
+    fastest cores to itself and every other thread runs on the remaining
+    processors, so the operating system can't move it to an efficiency
+    core.  Threads started by the emulation thread inherit its affinity
+    until they apply their own.
+-----------------------------------------------------------------------------*/
+
+enum class thread_role
+{
+	EMULATION,  // the thread running the emulated machine
+	WORKER      // everything else
+};
+
+/* choose processors for each role; mode is "auto" (hybrid CPUs only), "on" or
+   "off", and a list of processors such as "0,2-3" for a role is used instead
+   of the automatic choice, "auto" meaning no list */
+void thread_affinity_configure(std::string_view mode, std::string_view emulation, std::string_view workers);
+
+/* restrict the calling thread to the processors chosen for its role */
+void thread_affinity_apply(thread_role role);
+
+} // namespace osd
+
 #endif // MAME_OSD_OSDSYNC_H
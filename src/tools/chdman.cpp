@@ -1283,6 +1283,8 @@ static void compress_common(chd_file_compressor &chd)
 
 	// final progress update
 	progress(true, "Compression complete ... final ratio = %.1f%%            \n", 100.0 * ratio);
+	if (chd.self_hunks() != 0 || chd.parent_hunks() != 0)
+		printf("Deduplicated: %s hunks from self, %s from parent\n", big_int_string(chd.self_hunks()).c_str(), big_int_string(chd.parent_hunks()).c_str());
 }
 
 
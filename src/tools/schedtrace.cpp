@@ -0,0 +1,217 @@
+// license:BSD-3-Clause
+// copyright-holders:MAMEdev Team
+/***************************************************************************
+
+    schedtrace.cpp
+
+    Converts binary scheduler traces recorded with -schedtrace into Chrome
+    trace event JSON, which can be loaded into Perfetto or chrome://tracing.
+
+    The file format is described in src/emu/schedule.cpp.
+
+***************************************************************************/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+// event types, matching device_scheduler::trace_event
+enum
+{
+	EVENT_TIMESLICE = 1,
+	EVENT_EXECUTE,
+	EVENT_TIMER,
+	EVENT_ABORT,
+	EVENT_TRIGGER
+};
+
+constexpr uint32_t RECORD_SIZE = 24;
+
+
+class trace_reader
+{
+public:
+	trace_reader(std::FILE *file) : m_file(file), m_ok(true) { }
+
+	bool ok() const { return m_ok; }
+
+	uint64_t get(int bytes)
+	{
+		uint8_t buf[8];
+		if (std::fread(buf, 1, bytes, m_file) != size_t(bytes))
+		{
+			m_ok = false;
+			return 0;
+		}
+		uint64_t result = 0;
+		for (int i = bytes - 1; i >= 0; i--)
+			result = (result << 8) | buf[i];
+		return result;
+	}
+
+	std::string get_string()
+	{
+		std::string result(size_t(get(2)), '\0');
+		if (!result.empty() && (std::fread(&result[0], 1, result.length(), m_file) != result.length()))
+			m_ok = false;
+		return result;
+	}
+
+private:
+	std::FILE *const m_file;
+	bool m_ok;
+};
+
+
+std::string json_escape(std::string const &str)
+{
+	std::string result;
+	for (char const ch : str)
+	{
+		if ((ch == '"') || (ch == '\\'))
+		{
+			result.push_back('\\');
+			result.push_back(ch);
+		}
+		else if (uint8_t(ch) < 0x20)
+		{
+			char buf[8];
+			std::snprintf(buf, sizeof(buf), "\\u%04x", uint8_t(ch));
+			result.append(buf);
+		}
+		else
+		{
+			result.push_back(ch);
+		}
+	}
+	return result;
+}
+
+
+// emulated time in microseconds, which is what the trace viewers expect
+double to_us(uint64_t seconds, uint64_t attoseconds)
+{
+	return (double(seconds) * 1.0e6) + (double(attoseconds) * 1.0e-12);
+}
+
+} // anonymous namespace
+
+
+int main(int argc, char *argv[])
+{
+	if (argc != 3)
+	{
+		std::fprintf(stderr, "Usage:\n  schedtrace <trace file> <output.json>\n");
+		return 1;
+	}
+
+	std::FILE *const infile = std::fopen(argv[1], "rb");
+	if (!infile)
+	{
+		std::fprintf(stderr, "Error opening %s\n", argv[1]);
+		return 2;
+	}
+
+	// read and check the header
+	trace_reader reader(infile);
+	char magic[8];
+	if ((std::fread(magic, 1, sizeof(magic), infile) != sizeof(magic)) || std::memcmp(magic, "MAMESTRC", sizeof(magic)))
+	{
+		std::fprintf(stderr, "%s is not a scheduler trace\n", argv[1]);
+		std::fclose(infile);
+		return 3;
+	}
+	uint32_t const version = uint32_t(reader.get(4));
+	uint32_t const recsize = uint32_t(reader.get(4));
+	uint32_t const devcount = uint32_t(reader.get(4));
+	uint32_t const namecount = uint32_t(reader.get(4));
+	uint64_t const reccount = reader.get(8);
+	if (!reader.ok() || (version != 1) || (recsize != RECORD_SIZE))
+	{
+		std::fprintf(stderr, "%s: unsupported trace version %u\n", argv[1], version);
+		std::fclose(infile);
+		return 3;
+	}
+
+	std::vector<std::string> devices, names;
+	for (uint32_t i = 0; reader.ok() && (i < devcount); i++)
+		devices.emplace_back(reader.get_string());
+	for (uint32_t i = 0; reader.ok() && (i < namecount); i++)
+		names.emplace_back(reader.get_string());
+
+	std::FILE *const outfile = std::fopen(argv[2], "w");
+	if (!outfile)
+	{
+		std::fprintf(stderr, "Error creating %s\n", argv[2]);
+		std::fclose(infile);
+		return 2;
+	}
+
+	// thread 0 is the scheduler itself, devices are numbered from 1
+	std::fprintf(outfile, "{\"traceEvents\":[\n");
+	std::fprintf(outfile, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"scheduler\"}}");
+	std::set<uint32_t> seen;
+	uint64_t converted = 0;
+	for (uint64_t i = 0; i < reccount; i++)
+	{
+		unsigned const type = unsigned(reader.get(1));
+		reader.get(1);
+		uint32_t const index = uint32_t(reader.get(2));
+		uint64_t const seconds = reader.get(4);
+		uint64_t const attoseconds = reader.get(8);
+		uint64_t const value = reader.get(8);
+		if (!reader.ok())
+		{
+			std::fprintf(stderr, "%s: truncated after %llu records\n", argv[1], (unsigned long long)i);
+			break;
+		}
+		double const ts = to_us(seconds, attoseconds);
+
+		// name each device's track the first time we see it
+		if (((type == EVENT_EXECUTE) || (type == EVENT_ABORT)) && seen.insert(index).second)
+		{
+			std::string const tag = (index < devices.size()) ? devices[index] : "unknown";
+			std::fprintf(outfile, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", index + 1, json_escape(tag).c_str());
+		}
+
+		switch (type)
+		{
+		case EVENT_TIMESLICE:
+			std::fprintf(outfile, ",\n{\"name\":\"timeslice\",\"cat\":\"scheduler\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":%.6f,\"dur\":%.6f}", ts, double(value) * 1.0e-12);
+			break;
+
+		case EVENT_EXECUTE:
+			std::fprintf(outfile, ",\n{\"name\":\"execute\",\"cat\":\"device\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.6f,\"dur\":%.6f}", index + 1, ts, double(value) * 1.0e-12);
+			break;
+
+		case EVENT_TIMER:
+			std::fprintf(outfile, ",\n{\"name\":\"%s\",\"cat\":\"timer\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":0,\"ts\":%.6f,\"args\":{\"param\":%lld}}",
+					json_escape((index < names.size()) ? names[index] : "unknown").c_str(), ts, (long long)int64_t(value));
+			break;
+
+		case EVENT_ABORT:
+			std::fprintf(outfile, ",\n{\"name\":\"abort_timeslice\",\"cat\":\"device\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.6f,\"args\":{\"cycles\":%llu}}", index + 1, ts, (unsigned long long)value);
+			break;
+
+		case EVENT_TRIGGER:
+			std::fprintf(outfile, ",\n{\"name\":\"trigger\",\"cat\":\"scheduler\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":0,\"ts\":%.6f,\"args\":{\"id\":%lld}}", ts, (long long)int64_t(value));
+			break;
+
+		default:
+			continue;
+		}
+		converted++;
+	}
+	std::fprintf(outfile, "\n]}\n");
+
+	std::fclose(outfile);
+	std::fclose(infile);
+	std::printf("Converted %llu of %llu records\n", (unsigned long long)converted, (unsigned long long)reccount);
+	return 0;
+}
@@ -204,6 +204,7 @@ using util::BIT;
 #include "eminline.h"
 #include "endianness.h"
 #include "ioprocs.h"
+#include "ioprocsfilter.h"
 #include "osdfile.h"
 #include "strformat.h"
 
@@ -369,6 +370,7 @@ struct options
 	uint32_t                skip;
 	uint32_t                count;
 	bool                    octal;
+	bool                    trace;
 };
 
 static const dasm_table_entry dasm_table[] =
@@ -1150,6 +1152,8 @@ static int parse_options(int argc, char *argv[], options *opts)
 				opts->xchbytes = true;
 			else if(tolower((uint8_t)curarg[1]) == 'o')
 				opts->octal = true;
+			else if(tolower((uint8_t)curarg[1]) == 't')
+				opts->trace = true;
 			else
 				goto usage;
 
@@ -1231,7 +1235,7 @@ static int parse_options(int argc, char *argv[], options *opts)
 usage:
 	printf("Usage: %s <filename> -arch <architecture> [-basepc <pc>] \n", argv[0]);
 	printf("   [-norawbytes] [-xchbytes] [-flipped] [-upper] [-lower]\n");
-	printf("   [-skip <n>] [-count <n>] [-octal]\n");
+	printf("   [-skip <n>] [-count <n>] [-octal] [-trace]\n");
 	printf("\n");
 	printf("Supported architectures:");
 	const int colwidth = 1 + std::strlen(std::max_element(std::begin(dasm_table), std::end(dasm_table), [](const dasm_table_entry &a, const dasm_table_entry &b) { return std::strlen(a.name) < std::strlen(b.name); })->name);
@@ -1613,6 +1617,85 @@ int disasm_file(util::random_read &file, u64 length, options &opts)
 }
 
 
+int disasm_trace(util::random_read &file, options &opts)
+{
+	// binary traces written by the debugger's trace command are zlib
+	// compressed, with PCs and opcodes recorded as the CPU executed them
+	util::read_stream::ptr stream = util::zlib_read(file, 65536);
+	if(!stream) {
+		std::fprintf(stderr, "Error allocating decompression buffer\n");
+		return 1;
+	}
+
+	auto const read = [&stream](void *buffer, std::size_t length) -> bool {
+		std::size_t actual;
+		return !stream->read(buffer, length, actual) && (actual == length);
+	};
+
+	u8 header[8];
+	if(!read(header, sizeof(header)) || std::memcmp(header, "MTRC", 4) || (header[4] != 1)) {
+		std::fprintf(stderr, "File '%s' is not a supported binary trace\n", opts.filename);
+		return 1;
+	}
+	int const pcdigits = opts.octal ? ((header[5] + 2) / 3) : ((header[5] + 3) / 4);
+
+	std::unique_ptr<util::disasm_interface> disasm(opts.dasm->alloc());
+	if(disasm->interface_flags() & (util::disasm_interface::NONLINEAR_PC | util::disasm_interface::INTERNAL_DECRYPTION)) {
+		std::fprintf(stderr, "Binary traces are not supported for architecture '%s'\n", opts.dasm->name);
+		return 1;
+	}
+
+	// opcodes are recorded as little-endian bus-sized units
+	offs_t const unit = opts.dasm->pcshift < 0 ? (1 << -opts.dasm->pcshift) : 1;
+
+	unidasm_data_buffer buffer(disasm.get(), opts.dasm);
+	u32 count = 0;
+	u8 type;
+	while(read(&type, 1) && (!opts.count || (count < opts.count))) {
+		if(type == 'T') {
+			// text from tracelog/tracesym actions and logerror output
+			u8 length[4];
+			if(!read(length, 4))
+				break;
+			std::string text(length[0] | (length[1] << 8) | (length[2] << 16) | (u32(length[3]) << 24), '\0');
+			if(!read(text.data(), text.size()))
+				break;
+			std::cout << text;
+
+		} else if(type == 'I') {
+			u8 record[5];
+			if(!read(record, 5))
+				break;
+			offs_t const pc = record[0] | (record[1] << 8) | (record[2] << 16) | (offs_t(record[3]) << 24);
+			buffer.data.assign(record[4] + 16, 0x00);
+			if(!read(buffer.data.data(), record[4]))
+				break;
+			if(opts.dasm->endian == be && unit > 1)
+				for(offs_t offset = 0; (offset + unit) <= record[4]; offset += unit)
+					std::reverse(&buffer.data[offset], &buffer.data[offset + unit]);
+			buffer.size = buffer.data.size();
+			buffer.base_pc = pc;
+
+			std::ostringstream line;
+			disasm->disassemble(line, pc, buffer, buffer);
+			std::string text = util::string_format(opts.octal ? "%0*o: %s" : "%0*X: %s", pcdigits, pc, line.str());
+			if(opts.lower)
+				std::transform(text.begin(), text.end(), text.begin(), [](char c) { return tolower(c); });
+			else if(opts.upper)
+				std::transform(text.begin(), text.end(), text.begin(), [](char c) { return toupper(c); });
+			std::cout << text << '\n';
+			count++;
+
+		} else {
+			std::fprintf(stderr, "Invalid record in binary trace '%s'\n", opts.filename);
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+
 int main(int argc, char *argv[])
 {
 	// Parse options first
@@ -1674,7 +1757,7 @@ int main(int argc, char *argv[])
 		}
 	}
 
-	int result = disasm_file(*file, length, opts);
+	int result = opts.trace ? disasm_trace(*file, opts) : disasm_file(*file, length, opts);
 
 	file.reset();
 	std::free(data);
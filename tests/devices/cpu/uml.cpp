@@ -0,0 +1,377 @@
+#include "catch.hpp"
+
+#include "emu.h"
+#include "emuopts.h"
+#include "main.h"
+#include "cpu/drcuml.h"
+#include "cpu/drcumlsh.h"
+#include "drivenum.h"
+#include "osdepend.h"
+#include "ui/menuitem.h"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Runs the same UML instructions on the C back-end and the native back-end
+// and requires identical results and flags.  The C back-end is the reference
+// for what UML means, so this catches native back-ends drifting from it.
+
+namespace {
+
+// just enough of an OSD for a machine that never starts
+class test_osd : public osd_interface
+{
+public:
+   virtual void init(running_machine &machine) override { }
+   virtual void update(bool skip_redraw) override { }
+   virtual void input_update() override { }
+   virtual void set_verbose(bool print_verbose) override { }
+   virtual void init_debugger() override { }
+   virtual void wait_for_debugger(device_t &device, bool firststop) override { }
+   virtual void update_audio_stream(const int16_t *buffer, int samples_this_frame) override { }
+   virtual void set_mastervolume(int attenuation) override { }
+   virtual bool no_sound() override { return true; }
+   virtual int audio_update_frequency() override { return 0; }
+   virtual int audio_latency_samples() override { return 0; }
+   virtual int audio_underflows() override { return 0; }
+   virtual void customize_input_type_list(std::vector<input_type_entry> &typelist) override { }
+   virtual void add_audio_to_recording(const int16_t *buffer, int samples_this_frame) override { }
+   virtual std::vector<ui::menu_item> get_slider_list() override { return std::vector<ui::menu_item>(); }
+   virtual osd_font::ptr font_alloc() override { return nullptr; }
+   virtual bool get_font_families(std::string const &font_path, std::vector<std::pair<std::string, std::string> > &result) override { return false; }
+   virtual bool execute_command(const char *command) override { return false; }
+   virtual std::unique_ptr<osd_midi_device> create_midi_device() override { return nullptr; }
+};
+
+class test_manager : public machine_manager
+{
+public:
+   test_manager(emu_options &options, osd_interface &osd) : machine_manager(options, osd) { }
+};
+
+// what an instruction produces
+enum class result_kind { NONE, INT32, INT64, FLOAT32, FLOAT64 };
+
+// operands and results, in the near cache so every back-end can address them directly
+struct test_data
+{
+   u64 src[3];       // loaded into I1, I2 and I0
+   u32 carry;        // carry flag going in
+   float fsrc[2];    // loaded into F1 and F2 for single precision
+   double dsrc[2];   // loaded into F1 and F2 for double precision
+   u64 out[2];       // I0 and I3 afterwards
+   float fout;       // F0 afterwards
+   double dout;
+   u32 flags;        // the flags the instruction defines
+};
+
+class backend
+{
+public:
+   backend(bool use_c)
+   {
+      std::string error;
+      m_options.set_value(OPTION_DRC_USE_C, use_c, OPTION_PRIORITY_CMDLINE);
+      m_config = std::make_unique<machine_config>(GAME_NAME(___empty), m_options);
+      m_manager = std::make_unique<test_manager>(m_options, m_osd);
+      m_machine = std::make_unique<running_machine>(*m_config, *m_manager);
+      m_cache = std::make_unique<drc_cache>(4 * 1024 * 1024);
+      m_uml = std::make_unique<drcuml_state>(m_config->root_device(), *m_cache, 0, 1, 32, 0);
+      m_data = reinterpret_cast<test_data *>(m_cache->alloc_near(sizeof(test_data)));
+      m_entry = m_uml->handle_alloc("entry");
+   }
+
+   // compile and run one instruction on the given operands
+   test_data run(std::function<void (uml::instruction &)> const &op, result_kind kind, bool single, test_data const &input)
+   {
+      using namespace uml;
+
+      m_uml->reset();
+      *m_data = input;
+
+      drcuml_block &block(m_uml->begin_block(32));
+      UML_HANDLE(block, *m_entry);
+      UML_DMOV(block, I1, mem(&m_data->src[0]));
+      UML_DMOV(block, I2, mem(&m_data->src[1]));
+      UML_DMOV(block, I0, mem(&m_data->src[2]));
+      UML_DMOV(block, I3, 0);
+      if (single)
+      {
+         UML_FSMOV(block, F1, mem(&m_data->fsrc[0]));
+         UML_FSMOV(block, F2, mem(&m_data->fsrc[1]));
+      }
+      else
+      {
+         UML_FDMOV(block, F1, mem(&m_data->dsrc[0]));
+         UML_FDMOV(block, F2, mem(&m_data->dsrc[1]));
+      }
+      UML_CARRY(block, mem(&m_data->carry), 0);
+
+      instruction &inst(block.append());
+      op(inst);
+      u8 const flags = inst.output_flags();
+      m_disasm = inst.disasm(m_uml.get());
+
+      if (flags)
+         UML_GETFLGS(block, mem(&m_data->flags), flags);
+      switch (kind)
+      {
+      case result_kind::NONE:
+         break;
+      case result_kind::INT32:
+         UML_MOV(block, mem(&m_data->out[0]), I0);
+         UML_MOV(block, mem(&m_data->out[1]), I3);
+         break;
+      case result_kind::INT64:
+         UML_DMOV(block, mem(&m_data->out[0]), I0);
+         UML_DMOV(block, mem(&m_data->out[1]), I3);
+         break;
+      case result_kind::FLOAT32:
+         UML_FSMOV(block, mem(&m_data->fout), F0);
+         break;
+      case result_kind::FLOAT64:
+         UML_FDMOV(block, mem(&m_data->dout), F0);
+         break;
+      }
+      UML_EXIT(block, 0);
+      block.end();
+
+      m_uml->execute(*m_entry);
+      return *m_data;
+   }
+
+   std::string const &disasm() const { return m_disasm; }
+
+private:
+   test_osd m_osd;
+   emu_options m_options;
+   std::unique_ptr<machine_config> m_config;
+   std::unique_ptr<test_manager> m_manager;
+   std::unique_ptr<running_machine> m_machine;
+   std::unique_ptr<drc_cache> m_cache;
+   std::unique_ptr<drcuml_state> m_uml;
+   test_data *m_data;
+   uml::code_handle *m_entry;
+   std::string m_disasm;
+};
+
+// the back-ends being compared, shared by all the test cases
+backend &reference()
+{
+   static backend instance(true);
+   return instance;
+}
+
+backend &native()
+{
+   static backend instance(false);
+   return instance;
+}
+
+u64 const s_int32_values[] = { 0, 1, 2, 31, 32, 33, 0x7fff'ffff, 0x8000'0000, 0xffff'fffe, 0xffff'ffff, 0x1234'5678, 0xdead'beef };
+u64 const s_int64_values[] = { 0, 1, 63, 64, 65, 0x7fff'ffff, 0x8000'0000, 0xffff'ffff, 0x1'0000'0000, 0x7fff'ffff'ffff'ffff, 0x8000'0000'0000'0000, 0xffff'ffff'ffff'ffff, 0x0123'4567'89ab'cdef };
+double const s_float_values[] = { 0.0, -0.0, 1.0, -1.0, 0.25, 3.75, -2.3, 1.0e10, -7.0e-5, 123456.7 };
+
+// zero the parts of the results the instruction doesn't define
+void mask_results(test_data &data, result_kind kind)
+{
+   if (kind == result_kind::INT32)
+   {
+      data.out[0] &= 0xffff'ffff;
+      data.out[1] &= 0xffff'ffff;
+   }
+}
+
+// run an integer instruction over every combination of operands and carry
+void check_integer(std::function<void (uml::instruction &)> const &op, result_kind kind, bool wide, bool (*valid)(u64, u64) = nullptr)
+{
+   std::vector<u64> values;
+   if (wide)
+      values.assign(std::begin(s_int64_values), std::end(s_int64_values));
+   else
+      values.assign(std::begin(s_int32_values), std::end(s_int32_values));
+
+   for (u64 const a : values)
+   {
+      for (u64 const b : values)
+      {
+         if (valid && !valid(a, b))
+            continue;
+         for (u32 carry = 0; carry < 2; carry++)
+         {
+            test_data input;
+            std::memset(&input, 0, sizeof(input));
+            input.src[0] = a;
+            input.src[1] = b;
+            input.src[2] = a ^ b;
+            input.carry = carry;
+
+            test_data expected(reference().run(op, kind, false, input));
+            test_data actual(native().run(op, kind, false, input));
+            mask_results(expected, kind);
+            mask_results(actual, kind);
+
+            INFO(native().disasm() << " with I1=" << std::hex << a << " I2=" << b << " C=" << carry);
+            REQUIRE(actual.out[0] == expected.out[0]);
+            REQUIRE(actual.out[1] == expected.out[1]);
+            REQUIRE(actual.flags == expected.flags);
+         }
+      }
+   }
+}
+
+// run a floating point instruction over every pair of operands
+void check_float(std::function<void (uml::instruction &)> const &op, result_kind kind, bool single, bool (*valid)(double, double) = nullptr)
+{
+   for (double const a : s_float_values)
+   {
+      for (double const b : s_float_values)
+      {
+         if (valid && !valid(a, b))
+            continue;
+
+         test_data input;
+         std::memset(&input, 0, sizeof(input));
+         input.fsrc[0] = float(a);
+         input.fsrc[1] = float(b);
+         input.dsrc[0] = a;
+         input.dsrc[1] = b;
+
+         test_data expected(reference().run(op, kind, single, input));
+         test_data actual(native().run(op, kind, single, input));
+         mask_results(expected, kind);
+         mask_results(actual, kind);
+
+         INFO(native().disasm() << " with F1=" << a << " F2=" << b);
+         REQUIRE(std::memcmp(&actual.fout, &expected.fout, sizeof(actual.fout)) == 0);
+         REQUIRE(std::memcmp(&actual.dout, &expected.dout, sizeof(actual.dout)) == 0);
+         REQUIRE(actual.out[0] == expected.out[0]);
+         REQUIRE(actual.flags == expected.flags);
+      }
+   }
+}
+
+bool nonzero_divisor(u64 a, u64 b) { return b != 0; }
+bool signed_divisor32(u64 a, u64 b) { return u32(b) && !((u32(a) == 0x8000'0000) && (u32(b) == 0xffff'ffff)); }
+bool signed_divisor64(u64 a, u64 b) { return b && !((a == 0x8000'0000'0000'0000) && (b == ~u64(0))); }
+// shifts leave the flags alone for a zero count, so there'd be nothing defined to compare
+bool shift_count32(u64 a, u64 b) { return b & 31; }
+bool shift_count64(u64 a, u64 b) { return b & 63; }
+bool nonnegative(double a, double b) { return a >= 0.0; }
+bool nonzero_float(double a, double b) { return b != 0.0; }
+bool int32_range(double a, double b) { return (a > -2.0e9) && (a < 2.0e9); }
+
+} // anonymous namespace
+
+
+#if defined(NATIVE_DRC)
+
+using namespace uml;
+
+TEST_CASE("UML 32-bit arithmetic matches the C back-end", "[uml]")
+{
+   check_integer([] (instruction &i) { i.add(I0, I1, I2); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i.addc(I0, I1, I2); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i.sub(I0, I1, I2); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i.subb(I0, I1, I2); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i.cmp(I1, I2); }, result_kind::NONE, false);
+   check_integer([] (instruction &i) { i.mulu(I0, I3, I1, I2); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i.muls(I0, I3, I1, I2); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i.divu(I0, I3, I1, I2); }, result_kind::INT32, false, nonzero_divisor);
+   check_integer([] (instruction &i) { i.divs(I0, I3, I1, I2); }, result_kind::INT32, false, signed_divisor32);
+}
+
+TEST_CASE("UML 32-bit logic and shifts match the C back-end", "[uml]")
+{
+   check_integer([] (instruction &i) { i._and(I0, I1, I2); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i._or(I0, I1, I2); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i._xor(I0, I1, I2); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i.test(I1, I2); }, result_kind::NONE, false);
+   check_integer([] (instruction &i) { i.lzcnt(I0, I1); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i.tzcnt(I0, I1); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i.bswap(I0, I1); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i.sext(I0, I1, SIZE_BYTE); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i.sext(I0, I1, SIZE_WORD); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i.shl(I0, I1, I2); }, result_kind::INT32, false, shift_count32);
+   check_integer([] (instruction &i) { i.shr(I0, I1, I2); }, result_kind::INT32, false, shift_count32);
+   check_integer([] (instruction &i) { i.sar(I0, I1, I2); }, result_kind::INT32, false, shift_count32);
+   check_integer([] (instruction &i) { i.rol(I0, I1, I2); }, result_kind::INT32, false, shift_count32);
+   check_integer([] (instruction &i) { i.ror(I0, I1, I2); }, result_kind::INT32, false, shift_count32);
+   check_integer([] (instruction &i) { i.rolc(I0, I1, I2); }, result_kind::INT32, false, shift_count32);
+   check_integer([] (instruction &i) { i.rorc(I0, I1, I2); }, result_kind::INT32, false, shift_count32);
+   check_integer([] (instruction &i) { i.roland(I0, I1, 7, I2); }, result_kind::INT32, false);
+   check_integer([] (instruction &i) { i.rolins(I0, I1, 12, I2); }, result_kind::INT32, false);
+}
+
+TEST_CASE("UML 64-bit arithmetic matches the C back-end", "[uml]")
+{
+   check_integer([] (instruction &i) { i.dadd(I0, I1, I2); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.daddc(I0, I1, I2); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.dsub(I0, I1, I2); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.dsubb(I0, I1, I2); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.dcmp(I1, I2); }, result_kind::NONE, true);
+   check_integer([] (instruction &i) { i.dmulu(I0, I3, I1, I2); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.dmuls(I0, I3, I1, I2); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.ddivu(I0, I3, I1, I2); }, result_kind::INT64, true, nonzero_divisor);
+   check_integer([] (instruction &i) { i.ddivs(I0, I3, I1, I2); }, result_kind::INT64, true, signed_divisor64);
+}
+
+TEST_CASE("UML 64-bit logic and shifts match the C back-end", "[uml]")
+{
+   check_integer([] (instruction &i) { i.dand(I0, I1, I2); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.dor(I0, I1, I2); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.dxor(I0, I1, I2); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.dtest(I1, I2); }, result_kind::NONE, true);
+   check_integer([] (instruction &i) { i.dlzcnt(I0, I1); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.dtzcnt(I0, I1); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.dbswap(I0, I1); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.dsext(I0, I1, SIZE_DWORD); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.dshl(I0, I1, I2); }, result_kind::INT64, true, shift_count64);
+   check_integer([] (instruction &i) { i.dshr(I0, I1, I2); }, result_kind::INT64, true, shift_count64);
+   check_integer([] (instruction &i) { i.dsar(I0, I1, I2); }, result_kind::INT64, true, shift_count64);
+   check_integer([] (instruction &i) { i.drol(I0, I1, I2); }, result_kind::INT64, true, shift_count64);
+   check_integer([] (instruction &i) { i.dror(I0, I1, I2); }, result_kind::INT64, true, shift_count64);
+   check_integer([] (instruction &i) { i.drolc(I0, I1, I2); }, result_kind::INT64, true, shift_count64);
+   check_integer([] (instruction &i) { i.drorc(I0, I1, I2); }, result_kind::INT64, true, shift_count64);
+   check_integer([] (instruction &i) { i.droland(I0, I1, 13, I2); }, result_kind::INT64, true);
+   check_integer([] (instruction &i) { i.drolins(I0, I1, 40, I2); }, result_kind::INT64, true);
+}
+
+TEST_CASE("UML single precision matches the C back-end", "[uml]")
+{
+   check_float([] (instruction &i) { i.fsadd(F0, F1, F2); }, result_kind::FLOAT32, true);
+   check_float([] (instruction &i) { i.fssub(F0, F1, F2); }, result_kind::FLOAT32, true);
+   check_float([] (instruction &i) { i.fsmul(F0, F1, F2); }, result_kind::FLOAT32, true);
+   check_float([] (instruction &i) { i.fsdiv(F0, F1, F2); }, result_kind::FLOAT32, true, nonzero_float);
+   check_float([] (instruction &i) { i.fscmp(F1, F2); }, result_kind::NONE, true);
+   check_float([] (instruction &i) { i.fsneg(F0, F1); }, result_kind::FLOAT32, true);
+   check_float([] (instruction &i) { i.fsabs(F0, F1); }, result_kind::FLOAT32, true);
+   check_float([] (instruction &i) { i.fssqrt(F0, F1); }, result_kind::FLOAT32, true, nonnegative);
+   check_float([] (instruction &i) { i.fsfrflt(F0, F1, SIZE_QWORD); }, result_kind::FLOAT32, true);
+   for (auto const round : { ROUND_TRUNC, ROUND_ROUND, ROUND_CEIL, ROUND_FLOOR })
+      check_float([round] (instruction &i) { i.fstoint(I0, F1, SIZE_DWORD, round); }, result_kind::INT32, true, int32_range);
+}
+
+TEST_CASE("UML double precision matches the C back-end", "[uml]")
+{
+   check_float([] (instruction &i) { i.fdadd(F0, F1, F2); }, result_kind::FLOAT64, false);
+   check_float([] (instruction &i) { i.fdsub(F0, F1, F2); }, result_kind::FLOAT64, false);
+   check_float([] (instruction &i) { i.fdmul(F0, F1, F2); }, result_kind::FLOAT64, false);
+   check_float([] (instruction &i) { i.fddiv(F0, F1, F2); }, result_kind::FLOAT64, false, nonzero_float);
+   check_float([] (instruction &i) { i.fdcmp(F1, F2); }, result_kind::NONE, false);
+   check_float([] (instruction &i) { i.fdneg(F0, F1); }, result_kind::FLOAT64, false);
+   check_float([] (instruction &i) { i.fdabs(F0, F1); }, result_kind::FLOAT64, false);
+   check_float([] (instruction &i) { i.fdsqrt(F0, F1); }, result_kind::FLOAT64, false, nonnegative);
+   check_float([] (instruction &i) { i.fdrnds(F0, F1); }, result_kind::FLOAT64, false);
+   for (auto const round : { ROUND_TRUNC, ROUND_ROUND, ROUND_CEIL, ROUND_FLOOR })
+   {
+      check_float([round] (instruction &i) { i.fdtoint(I0, F1, SIZE_DWORD, round); }, result_kind::INT32, false, int32_range);
+      check_float([round] (instruction &i) { i.fdtoint(I0, F1, SIZE_QWORD, round); }, result_kind::INT64, false);
+   }
+}
+
+#endif // NATIVE_DRC
@@ -9,3 +9,42 @@ TEST_CASE("convert 1 sec to attotime", "[emu]")
    attotime value = attotime::from_seconds(1);
    REQUIRE(value.as_attoseconds() == 1000000000000000000);
 }
+
+TEST_CASE("multiply attotime by an integer", "[emu]")
+{
+   attotime value = attotime(1, 500'000'000'000'000'000) * 3;
+   REQUIRE(value.seconds() == 4);
+   REQUIRE(value.attoseconds() == 500'000'000'000'000'000);
+
+   value = attotime(0, 333'333'333'333'333'333) * 3;
+   REQUIRE(value.seconds() == 0);
+   REQUIRE(value.attoseconds() == 999'999'999'999'999'999);
+
+   REQUIRE((attotime(1, 0) * 0).is_zero());
+   REQUIRE((attotime(2, 0) * 500'000'000) == attotime::never);
+   REQUIRE((attotime(0, 999'999'999'999'999'999) * 0xffff'ffffU) == attotime::never);
+}
+
+TEST_CASE("divide attotime by an integer", "[emu]")
+{
+   attotime value = attotime(1, 0) / 4;
+   REQUIRE(value.seconds() == 0);
+   REQUIRE(value.attoseconds() == 250'000'000'000'000'000);
+
+   // the quotient is rounded to the nearest attosecond
+   value = attotime(10, 0) / 3;
+   REQUIRE(value.seconds() == 3);
+   REQUIRE(value.attoseconds() == 333'333'333'333'333'334);
+}
+
+TEST_CASE("convert between attotime and ticks", "[emu]")
+{
+   REQUIRE(attotime(1, 500'000'000'000'000'000).as_ticks(44'100) == 66'150);
+
+   // partial ticks are truncated
+   REQUIRE(attotime::from_hz(3).as_ticks(3) == 0);
+
+   attotime value = attotime::from_ticks(66'150, 44'100);
+   REQUIRE(value.seconds() == 1);
+   REQUIRE(value.attoseconds() == 499'999'999'999'994'550);
+}
@@ -0,0 +1,58 @@
+#include "catch.hpp"
+
+#include "bitmap.h"
+
+#include <cstdint>
+
+TEST_CASE("Bitmap aligned rows", "[util]")
+{
+   bitmap_ind16 bitmap;
+   bitmap.set_aligned_rows(true);
+   bitmap.allocate(100, 20, 3, 2);
+   REQUIRE((reinterpret_cast<std::uintptr_t>(&bitmap.pix(0)) % bitmap_t::ROW_ALIGNMENT) == 0);
+   REQUIRE((bitmap.rowbytes() % bitmap_t::ROW_ALIGNMENT) == 0);
+   REQUIRE(bitmap.pix(-2, -3) == 0);
+
+   bitmap.resize(50, 10, 5, 1);
+   REQUIRE(bitmap.aligned_rows());
+   REQUIRE((reinterpret_cast<std::uintptr_t>(&bitmap.pix(0)) % bitmap_t::ROW_ALIGNMENT) == 0);
+   REQUIRE((bitmap.rowbytes() % bitmap_t::ROW_ALIGNMENT) == 0);
+}
+
+TEST_CASE("Bitmap unaligned rows keep their pitch", "[util]")
+{
+   bitmap_rgb32 bitmap(33, 7, 1, 1);
+   REQUIRE(bitmap.rowpixels() == 35);
+   REQUIRE((reinterpret_cast<std::uintptr_t>(&bitmap.pix(-1, -1)) % bitmap_t::ROW_ALIGNMENT) == 0);
+}
+
+TEST_CASE("Bitmap pool recycles cleared bitmaps", "[util]")
+{
+   bitmap_pool pool;
+   void const *first;
+   {
+      auto bitmap = pool.acquire<bitmap_ind16>(64, 64, 0, 0, true);
+      first = &bitmap->pix(0);
+      bitmap->pix(3, 3) = 7;
+   }
+   REQUIRE(pool.free_count() == 1);
+
+   auto bitmap = pool.acquire<bitmap_ind16>(64, 64, 0, 0, true);
+   REQUIRE(pool.free_count() == 0);
+   REQUIRE(&bitmap->pix(0) == first);
+   REQUIRE(bitmap->pix(3, 3) == 0);
+
+   auto other = pool.acquire<bitmap_ind16>(32, 64);
+   REQUIRE(&other->pix(0) != first);
+}
+
+TEST_CASE("Bitmap pool outlived by its bitmaps", "[util]")
+{
+   bitmap_pool::ptr<bitmap_rgb32> bitmap;
+   {
+      bitmap_pool pool;
+      bitmap = pool.acquire<bitmap_rgb32>(8, 8);
+   }
+   REQUIRE(bitmap->width() == 8);
+   bitmap.reset();
+}
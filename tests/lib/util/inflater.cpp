@@ -0,0 +1,208 @@
+#include "catch.hpp"
+
+#include "inflater.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace {
+
+std::vector<std::uint8_t> make_text(std::size_t length, std::uint32_t seed)
+{
+   // words drawn from a small vocabulary give a skewed alphabet and plenty of matches
+   static char const *const words[] = { "the ", "quick ", "brown ", "fox ", "jumps ", "over ", "lazy ", "dog ", "\n", "0123456789", "MAME " };
+   std::vector<std::uint8_t> result;
+   while (result.size() < length)
+   {
+      seed = seed * 1664525 + 1013904223;
+      char const *const word = words[(seed >> 16) % std::size(words)];
+      result.insert(result.end(), word, word + std::strlen(word));
+   }
+   result.resize(length);
+   return result;
+}
+
+std::vector<std::uint8_t> make_noise(std::size_t length, std::uint32_t seed)
+{
+   std::vector<std::uint8_t> result(length);
+   for (auto &b : result)
+   {
+      seed = seed * 1664525 + 1013904223;
+      b = std::uint8_t(seed >> 24);
+   }
+   return result;
+}
+
+std::vector<std::uint8_t> deflate_raw(std::vector<std::uint8_t> const &data, int level, int strategy)
+{
+   z_stream stream;
+   std::memset(&stream, 0, sizeof(stream));
+   REQUIRE(deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, strategy) == Z_OK);
+   std::vector<std::uint8_t> result(deflateBound(&stream, uLong(data.size())));
+   stream.next_in = const_cast<Bytef *>(data.data());
+   stream.avail_in = uInt(data.size());
+   stream.next_out = result.data();
+   stream.avail_out = uInt(result.size());
+   REQUIRE(deflate(&stream, Z_FINISH) == Z_STREAM_END);
+   result.resize(stream.total_out);
+   deflateEnd(&stream);
+   return result;
+}
+
+// returns true and fills result if zlib decodes exactly length bytes and reaches the end of the stream
+bool inflate_zlib(std::vector<std::uint8_t> const &src, std::size_t length, std::vector<std::uint8_t> &result)
+{
+   z_stream stream;
+   std::memset(&stream, 0, sizeof(stream));
+   REQUIRE(inflateInit2(&stream, -MAX_WBITS) == Z_OK);
+   result.assign(length + 1, 0);
+   stream.next_in = const_cast<Bytef *>(src.data());
+   stream.avail_in = uInt(src.size());
+   stream.next_out = result.data();
+   stream.avail_out = uInt(result.size());
+   int const err = inflate(&stream, Z_FINISH);
+   bool const ok = (err == Z_STREAM_END) && (stream.total_out == length);
+   inflateEnd(&stream);
+   result.resize(length);
+   return ok;
+}
+
+bool inflate_fast(std::vector<std::uint8_t> const &src, std::size_t length, std::vector<std::uint8_t> &result)
+{
+   auto inflater = std::make_unique<util::fast_inflater>();
+   result.assign(length, 0);
+   return inflater->inflate(src.data(), src.size(), result.data(), result.size());
+}
+
+void check_round_trip(std::vector<std::uint8_t> const &data, int level, int strategy)
+{
+   std::vector<std::uint8_t> const compressed = deflate_raw(data, level, strategy);
+   std::vector<std::uint8_t> expected, actual;
+   REQUIRE(inflate_zlib(compressed, data.size(), expected));
+   REQUIRE(expected == data);
+   REQUIRE(inflate_fast(compressed, data.size(), actual));
+   REQUIRE(actual == data);
+}
+
+} // anonymous namespace
+
+TEST_CASE("Inflate stored blocks", "[util]")
+{
+   // more than 64K needs several stored blocks
+   check_round_trip(make_noise(0, 1), 0, Z_DEFAULT_STRATEGY);
+   check_round_trip(make_noise(1, 2), 0, Z_DEFAULT_STRATEGY);
+   check_round_trip(make_noise(65535, 3), 0, Z_DEFAULT_STRATEGY);
+   check_round_trip(make_noise(200000, 4), 0, Z_DEFAULT_STRATEGY);
+}
+
+TEST_CASE("Inflate fixed Huffman blocks", "[util]")
+{
+   check_round_trip(make_text(1, 5), 6, Z_FIXED);
+   check_round_trip(make_text(1000, 6), 6, Z_FIXED);
+   check_round_trip(make_text(300000, 7), 9, Z_FIXED);
+   check_round_trip(make_noise(5000, 8), 6, Z_FIXED);
+}
+
+TEST_CASE("Inflate dynamic Huffman blocks", "[util]")
+{
+   check_round_trip(make_text(100, 9), 9, Z_DEFAULT_STRATEGY);
+   check_round_trip(make_text(500000, 10), 9, Z_DEFAULT_STRATEGY);
+   check_round_trip(make_text(500000, 11), 1, Z_DEFAULT_STRATEGY);
+   check_round_trip(make_text(100000, 12), 6, Z_HUFFMAN_ONLY);
+   check_round_trip(make_noise(100000, 13), 9, Z_DEFAULT_STRATEGY);
+}
+
+TEST_CASE("Inflate overlapping matches", "[util]")
+{
+   // runs give distance 1 matches, short periods give overlapping copies shorter than a word
+   std::vector<std::uint8_t> data(100000, 0x55);
+   check_round_trip(data, 9, Z_RLE);
+   for (std::size_t period = 2; period <= 9; period++)
+   {
+      for (std::size_t i = 0; i < data.size(); i++)
+         data[i] = std::uint8_t((i % period) * 37);
+      check_round_trip(data, 9, Z_DEFAULT_STRATEGY);
+   }
+}
+
+TEST_CASE("Inflate mixed block types", "[util]")
+{
+   // noise makes zlib fall back to stored blocks between the compressed ones
+   std::vector<std::uint8_t> data;
+   for (std::uint32_t i = 0; i < 8; i++)
+   {
+      auto const part = (i & 1) ? make_noise(40000, i) : make_text(40000, i);
+      data.insert(data.end(), part.begin(), part.end());
+   }
+   check_round_trip(data, 6, Z_DEFAULT_STRATEGY);
+   check_round_trip(data, 6, Z_FIXED);
+}
+
+TEST_CASE("Inflate rejects the wrong output length", "[util]")
+{
+   std::vector<std::uint8_t> const data = make_text(10000, 14);
+   std::vector<std::uint8_t> const compressed = deflate_raw(data, 9, Z_DEFAULT_STRATEGY);
+   std::vector<std::uint8_t> result;
+   REQUIRE(!inflate_fast(compressed, data.size() - 1, result));
+   REQUIRE(!inflate_fast(compressed, data.size() + 1, result));
+}
+
+TEST_CASE("Inflate rejects truncated input", "[util]")
+{
+   for (int level : { 0, 6 })
+   {
+      std::vector<std::uint8_t> const data = make_text(20000, 15);
+      std::vector<std::uint8_t> compressed = deflate_raw(data, level, Z_DEFAULT_STRATEGY);
+      std::vector<std::uint8_t> result;
+      for (std::size_t length : { std::size_t(0), std::size_t(1), compressed.size() / 2, compressed.size() - 1 })
+      {
+         std::vector<std::uint8_t> const truncated(compressed.begin(), compressed.begin() + length);
+         REQUIRE(!inflate_fast(truncated, data.size(), result));
+      }
+   }
+}
+
+TEST_CASE("Inflate rejects malformed headers", "[util]")
+{
+   std::vector<std::uint8_t> result;
+
+   // final block with the reserved type 3
+   REQUIRE(!inflate_fast(std::vector<std::uint8_t>{ 0x07, 0x00 }, 0, result));
+
+   // stored block whose length and complement don't match
+   REQUIRE(!inflate_fast(std::vector<std::uint8_t>{ 0x01, 0x01, 0x00, 0xff, 0xfe, 0x42 }, 1, result));
+   REQUIRE(inflate_fast(std::vector<std::uint8_t>{ 0x01, 0x01, 0x00, 0xfe, 0xff, 0x42 }, 1, result));
+   REQUIRE(result[0] == 0x42);
+}
+
+TEST_CASE("Inflate agrees with zlib on corrupt input", "[util]")
+{
+   // whatever the damage, the inflater either gives up or produces what zlib does
+   std::vector<std::uint8_t> const data = make_text(30000, 16);
+   for (int strategy : { Z_DEFAULT_STRATEGY, Z_FIXED })
+   {
+      std::vector<std::uint8_t> const compressed = deflate_raw(data, 9, strategy);
+      std::uint32_t seed = 17;
+      for (int trial = 0; trial < 500; trial++)
+      {
+         std::vector<std::uint8_t> corrupt = compressed;
+         seed = seed * 1664525 + 1013904223;
+         std::size_t const pos = (seed >> 8) % ((trial < 250) ? std::min<std::size_t>(corrupt.size(), 64) : corrupt.size());
+         corrupt[pos] ^= std::uint8_t(1 << ((seed >> 4) & 7));
+
+         std::vector<std::uint8_t> expected, actual;
+         bool const zlib_ok = inflate_zlib(corrupt, data.size(), expected);
+         if (inflate_fast(corrupt, data.size(), actual))
+         {
+            REQUIRE(zlib_ok);
+            REQUIRE(actual == expected);
+         }
+      }
+   }
+}